@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_ALLOCATIONTRACKER_HH_
+#define IGNITION_GAZEBO_ALLOCATIONTRACKER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+/// \brief Counts the heap allocations made by the process, and charges
+/// them to the scopes marked with the `GZ_TRACE` macro, so that the
+/// allocations of each subsystem can be told apart without a heap
+/// profiler.
+///
+/// Counting requires replacing the global `operator new`, so it's only
+/// compiled in when the project is configured with
+/// `-DENABLE_ALLOCATION_TRACKING=ON`, which is meant for profiling builds
+/// on Linux and macOS. Otherwise Enabled returns false, nothing is counted
+/// and the scopes compile to nothing.
+///
+/// Allocations are counted per thread, so counting doesn't contend. A scope
+/// is charged what its thread allocates between entering and leaving it,
+/// including what nested scopes allocate. Work handed over to other threads
+/// is charged to the scopes of those threads.
+///
+/// Scope names are kept as pointers, so they must outlive the process, as
+/// the string literals used with the macros do. Only the first 1024
+/// distinct names are tracked.
+///
+/// All functions are safe to call from several threads.
+class IGNITION_GAZEBO_VISIBLE AllocationTracker
+{
+  /// \brief Allocation counters.
+  public: struct Counts
+  {
+    /// \brief Number of allocations.
+    uint64_t count{0u};
+
+    /// \brief Number of bytes requested.
+    uint64_t bytes{0u};
+  };
+
+  /// \brief Charges the allocations of the current thread to a scope while
+  /// it's alive. Used by `GZ_TRACE`.
+  public: class IGNITION_GAZEBO_VISIBLE Scope
+  {
+    /// \brief Constructor.
+    /// \param[in] _name Name of the scope.
+    public: explicit Scope(const char *_name);
+
+    /// \brief Destructor. Charges the allocations made since construction.
+    public: ~Scope();
+
+    /// \brief Scopes can't be copied.
+    public: Scope(const Scope &) = delete;
+
+    /// \brief Scopes can't be copied.
+    public: Scope &operator=(const Scope &) = delete;
+
+    /// \brief Name of the scope.
+    private: const char *name;
+
+    /// \brief Counters of the thread when the scope was entered.
+    private: Counts start;
+  };
+
+  /// \brief Whether allocation tracking was compiled in.
+  /// \return True if allocations are counted.
+  public: static bool Enabled();
+
+  /// \brief Get the allocations made by the current thread since it
+  /// started. Differences between two calls give the allocations made in
+  /// between.
+  /// \return Counters of the current thread, zero if tracking is disabled.
+  public: static Counts ThreadCounts();
+
+  /// \brief Get the allocations charged to each scope since the process
+  /// started, added up over all threads.
+  /// \return Counters keyed by scope name.
+  public: static std::map<std::string, Counts> ScopeCounts();
+
+  /// \brief Count an allocation on the current thread. Called by the
+  /// replacement `operator new`, and doesn't allocate.
+  /// \param[in] _bytes Size of the allocation.
+  public: static void Record(std::size_t _bytes);
+};
+}
+}
+}
+
+#define IGN_GAZEBO_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define IGN_GAZEBO_ALLOCATION_CONCAT(a, b) \
+  IGN_GAZEBO_ALLOCATION_CONCAT_IMPL(a, b)
+
+#ifdef IGNITION_GAZEBO_ALLOCATION_TRACKING
+/// \brief Charge the allocations of the rest of the current scope to name.
+#define IGN_GAZEBO_ALLOCATION_SCOPE(name) \
+  ::ignition::gazebo::AllocationTracker::Scope \
+      IGN_GAZEBO_ALLOCATION_CONCAT(ignGazeboAllocationScope, __LINE__)(name)
+#else
+/// \brief Charge the allocations of the rest of the current scope to name.
+#define IGN_GAZEBO_ALLOCATION_SCOPE(name)
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_BATCHEDENVIRONMENT_HH_
+#define IGNITION_GAZEBO_BATCHEDENVIRONMENT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+//
+class IGNITION_GAZEBO_HIDDEN BatchedEnvironmentPrivate;
+
+/// \brief Steps many instances of the same world in lockstep, in a single
+/// process, for applications such as reinforcement learning which need a
+/// large number of environment steps.
+///
+/// Each environment is an instance of the world created through
+/// ServerConfig::SetWorldInstances, so the SDF should hold a single world.
+/// All environments are stepped concurrently on a shared thread pool.
+/// Observations are gathered into contiguous arrays laid out environment
+/// by environment, and actions are given the same way, so they can be
+/// exchanged with tensor libraries without copying element by element.
+///
+/// ## Usage
+///
+/// ignition::gazebo::ServerConfig config;
+/// config.SetSdfFile("cartpole.sdf");
+/// ignition::gazebo::BatchedEnvironment envs(config, 64);
+/// envs.AddModel("cartpole");
+/// envs.AddJoint("cartpole", "slider");
+///
+/// std::vector<double> forces(envs.Size() * envs.JointCount());
+/// envs.Reset();
+/// for (int i = 0; i < 1000; ++i)
+/// {
+///   envs.SetJointForces(forces);
+///   envs.Step();
+///   const auto &positions = envs.JointPositions();
+/// }
+class IGNITION_GAZEBO_VISIBLE BatchedEnvironment
+{
+  /// \brief Number of values of each model pose in ModelPoses: position x,
+  /// y, z followed by quaternion w, x, y, z.
+  public: static constexpr std::size_t kPoseSize{7u};
+
+  /// \brief Constructor
+  /// \param[in] _config Server config of a single environment.
+  /// \param[in] _count Number of environments, at least 1.
+  public: BatchedEnvironment(const ServerConfig &_config,
+              const unsigned int _count);
+
+  /// \brief Destructor
+  public: ~BatchedEnvironment();
+
+  /// \brief Get the number of environments.
+  /// \return Number of environments.
+  public: std::size_t Size() const;
+
+  /// \brief Observe the world pose of a top level model in every
+  /// environment. Observations must be added before the first call to
+  /// Step or Reset.
+  /// \param[in] _model Model name.
+  /// \return Index of the model in ModelPoses, or std::nullopt if the
+  /// environments have already started.
+  public: std::optional<std::size_t> AddModel(const std::string &_model);
+
+  /// \brief Observe the state of a joint, and actuate it, in every
+  /// environment. Only the first axis of the joint is used. Joints must be
+  /// added before the first call to Step or Reset.
+  /// \param[in] _model Name of the top level model holding the joint.
+  /// \param[in] _joint Joint name.
+  /// \return Index of the joint in JointPositions, JointVelocities and
+  /// SetJointForces, or std::nullopt if the environments have already
+  /// started.
+  public: std::optional<std::size_t> AddJoint(const std::string &_model,
+              const std::string &_joint);
+
+  /// \brief Get the number of observed models.
+  /// \return Number of models.
+  public: std::size_t ModelCount() const;
+
+  /// \brief Get the number of observed joints.
+  /// \return Number of joints.
+  public: std::size_t JointCount() const;
+
+  /// \brief Set the force or torque applied to every observed joint of
+  /// every environment, on every iteration until the next call.
+  /// \param[in] _forces Size() * JointCount() values, environment by
+  /// environment.
+  /// \return False if the size doesn't match.
+  public: bool SetJointForces(const std::vector<double> &_forces);
+
+  /// \brief Step all environments, then update the observations.
+  /// \param[in] _iterations Number of iterations, at least 1.
+  /// \return False if any environment failed to step.
+  public: bool Step(const uint64_t _iterations = 1);
+
+  /// \brief Reset all environments to their initial state, then update
+  /// the observations. The initial state is saved in memory the first time
+  /// the environments start, see Server::Checkpoint.
+  /// \return False if any environment failed to reset.
+  public: bool Reset();
+
+  /// \brief Reset a single environment to its initial state, and update
+  /// its observations.
+  /// \param[in] _env Index of the environment.
+  /// \return False if _env is invalid or the reset failed.
+  public: bool Reset(const std::size_t _env);
+
+  /// \brief Get the world pose of every observed model, laid out as
+  /// Size() * ModelCount() * kPoseSize values.
+  /// \return Model poses.
+  public: const std::vector<double> &ModelPoses() const;
+
+  /// \brief Get the position of every observed joint, laid out as
+  /// Size() * JointCount() values.
+  /// \return Joint positions.
+  public: const std::vector<double> &JointPositions() const;
+
+  /// \brief Get the velocity of every observed joint, laid out as
+  /// Size() * JointCount() values.
+  /// \return Joint velocities.
+  public: const std::vector<double> &JointVelocities() const;
+
+  /// \brief Get the server running all the environments.
+  /// \return Pointer to the server.
+  public: std::shared_ptr<gazebo::Server> Server() const;
+
+  /// \brief Pointer to private data.
+  private: std::unique_ptr<BatchedEnvironmentPrivate> dataPtr;
+};
+}
+}
+}
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_COMPONENTHANDLE_HH_
+#define IGNITION_GAZEBO_COMPONENTHANDLE_HH_
+
+#include <cstdint>
+#include <type_traits>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class EntityComponentManager;
+
+    /// \class ComponentHandle ComponentHandle.hh
+    /// ignition/gazebo/ComponentHandle.hh
+    /// \brief Cached access to a component of an entity, so that systems
+    /// which access the same component on every step don't have to look it
+    /// up every time.
+    ///
+    /// Handles are created by EntityComponentManager::Handle, usually once
+    /// when a system is configured:
+    ///
+    ///     this->velHandle = _ecm.Handle<components::JointVelocity>(joint);
+    ///     ...
+    ///     if (this->velHandle)
+    ///       double vel = this->velHandle->Data()[0];
+    ///
+    /// Dereferencing a handle costs a comparison against the generation of
+    /// the component type's storage, which changes whenever a component of
+    /// that type is created or removed. The component is only looked up
+    /// again when the generation changed, so a handle never points to a
+    /// component which has been removed, and picks up the component if it's
+    /// created again later.
+    ///
+    /// The component may be modified through mutable handles, so every
+    /// access through them invalidates the manager's caches which depend on
+    /// the component, such as the name index for components::Name and world
+    /// poses for components::Pose. Handles to const components don't.
+    ///
+    /// A handle must not outlive the manager which created it, and is as
+    /// thread safe as EntityComponentManager::Component.
+    /// \tparam ComponentTypeT Component type. Handles to const components
+    /// are obtained from const managers.
+    template<typename ComponentTypeT>
+    class ComponentHandle
+    {
+      /// \brief Manager type, which is const for const components.
+      public: using ManagerType = std::conditional_t<
+          std::is_const_v<ComponentTypeT>,
+          const EntityComponentManager, EntityComponentManager>;
+
+      /// \brief Constructor of an empty handle, which never points to a
+      /// component.
+      public: ComponentHandle() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _ecm Manager which holds the component.
+      /// \param[in] _entity Entity which owns the component.
+      public: ComponentHandle(ManagerType &_ecm, const Entity _entity);
+
+      /// \brief Get the component.
+      /// \return The component, or nullptr if the entity doesn't have it.
+      public: ComponentTypeT *Get() const;
+
+      /// \brief Access the component. The handle must point to a component.
+      /// \return The component.
+      public: ComponentTypeT *operator->() const;
+
+      /// \brief Check whether the handle points to a component.
+      /// \return True if the entity has the component.
+      public: explicit operator bool() const;
+
+      /// \brief Get the entity which owns the component.
+      /// \return The entity, or kNullEntity for empty handles.
+      public: Entity Owner() const;
+
+      /// \brief Look up the component and the generation of its storage.
+      private: void Resolve() const;
+
+      /// \brief Manager which holds the component.
+      private: ManagerType *ecm{nullptr};
+
+      /// \brief Entity which owns the component.
+      private: Entity entity{kNullEntity};
+
+      /// \brief Cached component, valid while the generation matches.
+      private: mutable ComponentTypeT *component{nullptr};
+
+      /// \brief Generation of the component type's storage, or nullptr if
+      /// there was no storage when the component was last looked up.
+      private: mutable const uint64_t *generation{nullptr};
+
+      /// \brief Generation at which the component was last looked up.
+      private: mutable uint64_t resolvedGeneration{0u};
+    };
+    }
+  }
+}
+#endif
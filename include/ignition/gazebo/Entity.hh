@@ -18,6 +18,7 @@
 #define IGNITION_GAZEBO_ENTITY_HH_
 
 #include <cstdint>
+#include <limits>
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/Export.hh>
 
@@ -60,6 +61,59 @@ namespace ignition
 
     /// \brief Indicates a non-existant or invalid Entity.
     const Entity kNullEntity{0};
+
+    /// \brief Compact index of an entity within its EntityComponentManager.
+    ///
+    /// Entity ids grow for as long as simulation runs and are never reused,
+    /// while indices are reused once their entity is removed. The indices of
+    /// the entities that exist at any time are therefore close to each
+    /// other, starting at zero, so they can be used to index arrays of
+    /// per-entity data directly instead of maps keyed by Entity.
+    ///
+    /// The generation of an index is increased each time its entity is
+    /// removed, so that data kept for a removed entity can be told apart
+    /// from data for the entity which later reuses its index.
+    ///
+    /// Indices are local to a manager and aren't serialized, so they must
+    /// not be sent to other processes or kept across a manager's reset.
+    /// \sa EntityComponentManager::IndexOf
+    struct EntityIndex
+    {
+      /// \brief Marks an invalid index.
+      static constexpr uint32_t kInvalid{
+          std::numeric_limits<uint32_t>::max()};
+
+      /// \brief Position of the entity in dense per-entity arrays.
+      uint32_t index{kInvalid};
+
+      /// \brief Number of times the index was freed before being given to
+      /// the entity.
+      uint32_t generation{0u};
+
+      /// \brief Get whether the index was given to an entity.
+      /// \return True if the index is valid.
+      bool Valid() const
+      {
+        return this->index != kInvalid;
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _other Index to compare to.
+      /// \return True if both the index and the generation are equal.
+      bool operator==(const EntityIndex &_other) const
+      {
+        return this->index == _other.index &&
+            this->generation == _other.generation;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _other Index to compare to.
+      /// \return True if the index or the generation differ.
+      bool operator!=(const EntityIndex &_other) const
+      {
+        return !(*this == _other);
+      }
+    };
     }
   }
 }
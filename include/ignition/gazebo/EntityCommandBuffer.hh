@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYCOMMANDBUFFER_HH_
+#define IGNITION_GAZEBO_ENTITYCOMMANDBUFFER_HH_
+
+#include <functional>
+#include <memory>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class EntityComponentManager;
+    class IGNITION_GAZEBO_HIDDEN EntityCommandBufferPrivate;
+
+    /// \class EntityCommandBuffer EntityCommandBuffer.hh
+    /// ignition/gazebo/EntityCommandBuffer.hh
+    /// \brief Records structural changes to an EntityComponentManager, such
+    /// as creating entities and components, so that they can be applied
+    /// later, at a point where nothing else is accessing the manager.
+    ///
+    /// Each thread gets its own buffer through
+    /// EntityComponentManager::Deferred, so systems can record commands
+    /// concurrently, including from PostUpdate, where the manager is const:
+    ///
+    ///     auto &deferred = _ecm.Deferred();
+    ///     auto entity = deferred.CreateEntity();
+    ///     deferred.CreateComponent(entity, components::Name("box"));
+    ///
+    /// The simulation runner applies all buffers once all systems have been
+    /// updated. Commands recorded by one thread are applied in the order
+    /// they were recorded. Buffers are applied in the order in which their
+    /// threads first used them.
+    class IGNITION_GAZEBO_VISIBLE EntityCommandBuffer
+    {
+      /// \brief Constructor. Buffers are created by the
+      /// EntityComponentManager.
+      /// \param[in] _ecm Manager the commands will be applied to.
+      private: explicit EntityCommandBuffer(EntityComponentManager &_ecm);
+
+      /// \brief Destructor. Pending commands are discarded.
+      public: ~EntityCommandBuffer();
+
+      /// \brief Record the creation of an entity. The entity id is reserved
+      /// right away, so it can be used by the following commands, but the
+      /// entity only exists in the manager once the buffer is applied.
+      /// \return Id of the entity that will be created.
+      public: Entity CreateEntity();
+
+      /// \brief Record the creation of a component. This will copy the _data
+      /// parameter. If the entity already has a component of this type when
+      /// the command is applied, its data is replaced.
+      /// \param[in] _entity The entity that will be associated with the
+      /// component.
+      /// \param[in] _data Data used to construct the component.
+      public: template<typename ComponentTypeT>
+              void CreateComponent(const Entity _entity,
+                  const ComponentTypeT &_data);
+
+      /// \brief Record the removal of a component.
+      /// \param[in] _entity The entity.
+      /// \param[in] _typeId Id of the component type.
+      public: void RemoveComponent(const Entity _entity,
+                  const ComponentTypeId &_typeId);
+
+      /// \brief Record the removal of a component.
+      /// \param[in] _entity The entity.
+      public: template<typename ComponentTypeT>
+              void RemoveComponent(const Entity _entity);
+
+      /// \brief Record a request to remove an entity. The entity is removed
+      /// along with other removal requests, after the buffer is applied.
+      /// \param[in] _entity Entity to be removed.
+      /// \param[in] _recursive Whether to recursively remove all child
+      /// entities.
+      public: void RequestRemoveEntity(const Entity _entity,
+                  bool _recursive = true);
+
+      /// \brief Get whether there are commands waiting to be applied.
+      /// \return True if no commands have been recorded since the buffer was
+      /// last applied.
+      public: bool Empty() const;
+
+      /// \brief Record a command.
+      /// \param[in] _command Function which applies the command.
+      private: void Record(
+                   std::function<void(EntityComponentManager &)> _command);
+
+      /// \brief Apply all recorded commands to the manager, in order, and
+      /// clear them.
+      private: void Apply();
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<EntityCommandBufferPrivate> dataPtr;
+
+      // The manager creates and applies the buffers.
+      friend class EntityComponentManager;
+    };
+    }
+  }
+}
+
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+#endif
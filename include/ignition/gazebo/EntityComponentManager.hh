@@ -20,6 +20,7 @@
 #include <ignition/msgs/serialized.pb.h>
 #include <ignition/msgs/serialized_map.pb.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -33,9 +34,13 @@
 #include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/graph/Graph.hh>
+#include "ignition/gazebo/ComponentHandle.hh"
 #include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityCommandBuffer.hh"
 #include "ignition/gazebo/Export.hh"
+#include "ignition/gazebo/QueryFilters.hh"
 #include "ignition/gazebo/Types.hh"
 
 #include "ignition/gazebo/components/Component.hh"
@@ -49,6 +54,9 @@ namespace ignition
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     // Forward declarations.
     class IGNITION_GAZEBO_HIDDEN EntityComponentManagerPrivate;
+    class EntityComponentSnapshot;
+    class SpatialIndex;
+    class ThreadPool;
 
     /// \brief Type alias for the graph that holds entities.
     /// Each vertex is an entity, and the direction points from the parent to
@@ -56,6 +64,70 @@ namespace ignition
     /// All edges are positive booleans.
     using EntityGraph = math::graph::DirectedGraph<Entity, bool>;
 
+    /// \brief Memory used by all the components of one type.
+    /// \sa EntityComponentManagerMemoryStats
+    struct ComponentMemoryStats
+    {
+      /// \brief Component type id.
+      ComponentTypeId typeId{0};
+
+      /// \brief Component type name, as registered in the factory.
+      std::string name;
+
+      /// \brief Number of component instances.
+      uint64_t count{0};
+
+      /// \brief Bytes used by the instances and by their storage.
+      uint64_t bytes{0};
+    };
+
+    /// \brief Memory used by an EntityComponentManager, as returned by
+    /// EntityComponentManager::MemoryStats. The sizes of containers are
+    /// estimated from their size and capacity, and memory allocated by the
+    /// component data itself, such as the characters of a string, isn't
+    /// counted.
+    struct EntityComponentManagerMemoryStats
+    {
+      /// \brief Memory used by each component type, largest first.
+      std::vector<ComponentMemoryStats> components;
+
+      /// \brief Bytes used by all components.
+      uint64_t componentBytes{0};
+
+      /// \brief Number of entities.
+      uint64_t entityCount{0};
+
+      /// \brief Number of cached views.
+      uint64_t viewCount{0};
+
+      /// \brief Number of entities held by all views. An entity is counted
+      /// once per view it belongs to.
+      uint64_t viewEntityCount{0};
+
+      /// \brief Bytes used by the cached views.
+      uint64_t viewBytes{0};
+
+      /// \brief Bytes used by the entity hierarchy, including the graph
+      /// returned by Entities() if it has been built.
+      uint64_t graphBytes{0};
+
+      /// \brief Bytes used by the maps which index components by entity and
+      /// by the change tracking sets.
+      uint64_t indexBytes{0};
+
+      /// \brief Bytes used by the hierarchy, pose and name caches.
+      uint64_t cacheBytes{0};
+
+      /// \brief Sum of all the above.
+      uint64_t totalBytes{0};
+
+      /// \brief Bytes reclaimed by compaction since the manager was
+      /// created, estimated the same way as the other fields. This isn't
+      /// part of totalBytes.
+      /// \sa EntityComponentManager::Compact
+      uint64_t reclaimedBytes{0};
+    };
+
     /** \class EntityComponentManager EntityComponentManager.hh \
      * ignition/gazebo/EntityComponentManager.hh
     **/
@@ -75,6 +147,92 @@ namespace ignition
       /// \return An id for the Entity, or kNullEntity on failure.
       public: Entity CreateEntity();
 
+      /// \brief Creates multiple new entities at once. This is faster than
+      /// calling CreateEntity multiple times, because internal containers
+      /// are grown only once.
+      /// \param[in] _count Number of entities to create.
+      /// \return Ids of the new entities, which may be fewer than _count if
+      /// the maximum number of entities is reached.
+      public: std::vector<Entity> CreateEntities(const std::size_t _count);
+
+      /// \brief Get the command buffer of the calling thread, used to record
+      /// structural changes which are applied once all systems have been
+      /// updated. This can be called from any thread, including from
+      /// PostUpdate, where the manager is const. The returned buffer must
+      /// only be used by the calling thread.
+      /// \return Command buffer of the calling thread.
+      /// \sa EntityCommandBuffer
+      public: EntityCommandBuffer &Deferred() const;
+
+      /// \brief Get an index of all models by their bounding box in the
+      /// world frame, shared by all systems. Models with a
+      /// components::AxisAlignedBox are indexed by it, others by the point
+      /// at their world pose. The index is built on first use and then
+      /// updated once per iteration, after all systems have been updated,
+      /// from the models whose pose, box or ancestors changed.
+      /// Include ignition/gazebo/SpatialIndex.hh to use it.
+      /// \return The spatial index.
+      public: const gazebo::SpatialIndex &ModelSpatialIndex() const;
+
+      /// \brief Take an immutable snapshot of all entities and components,
+      /// which other threads can read while simulation keeps stepping.
+      /// Components which haven't been created, removed or marked as changed
+      /// since the previous snapshot are shared with it instead of being
+      /// copied, so taking a snapshot every iteration only copies what
+      /// changed. The manager keeps the latest snapshot to share components
+      /// with the next one.
+      /// Include ignition/gazebo/EntityComponentSnapshot.hh to use it.
+      /// \return The snapshot.
+      public: std::shared_ptr<const EntityComponentSnapshot> Snapshot() const;
+
+      /// \brief Bring the entities and components back to the state they
+      /// had when a snapshot was taken. This doesn't go through serialized
+      /// messages: components are copied straight from the snapshot, and
+      /// only those which were created, removed or marked as changed since
+      /// the snapshot are touched. Restored components are marked as
+      /// one-time changes.
+      ///
+      /// Entities which aren't in the snapshot are requested to be removed,
+      /// and entities which are missing are created again with the same id,
+      /// so systems see both through the usual new and removed entity
+      /// queries. Component types which can't be copied, because they
+      /// weren't registered with the factory, are left untouched.
+      /// \param[in] _snapshot Snapshot taken from this manager.
+      public: void RestoreSnapshot(const EntityComponentSnapshot &_snapshot);
+
+      /// \brief Estimate the memory used by the manager, broken down by
+      /// component type and by internal data structure. This visits every
+      /// component storage and view, so it's meant for diagnostics rather
+      /// than for every iteration.
+      /// \return Memory statistics.
+      public: EntityComponentManagerMemoryStats MemoryStats() const;
+
+      /// \brief Release memory held by internal containers which are much
+      /// larger than their contents, such as after unloading a level with
+      /// many entities. Hash maps using less than a quarter of their buckets
+      /// are rehashed, vectors using less than a quarter of their capacity
+      /// are shrunk, and pooled component memory which holds no components
+      /// is released. This is also done automatically when removing entities
+      /// brings their number below a quarter of its peak.
+      ///
+      /// This must not be called while other threads use the manager.
+      /// \return Estimated number of bytes reclaimed, which is also added to
+      /// EntityComponentManagerMemoryStats::reclaimedBytes.
+      public: uint64_t Compact();
+
+      /// \brief Start a batch of entity and component creation. Until the
+      /// matching call to EndBatchCreation, views aren't updated every time
+      /// a component is created. Instead, each entity which got new
+      /// components is checked against the views once, when the batch ends.
+      /// Views are also brought up to date before they're used, so querying
+      /// entities within a batch is still correct, just slower.
+      /// Batches can be nested, in which case views are updated when the
+      /// outermost batch ends.
+      public: void BeginBatchCreation();
+
+      /// \brief End a batch started by BeginBatchCreation.
+      public: void EndBatchCreation();
+
       /// \brief Clone an entity and its components. If the entity has any child
       /// entities, they will also be cloned.
       /// When cloning entities, the following rules apply:
@@ -110,6 +268,44 @@ namespace ignition
       public: Entity Clone(Entity _entity, Entity _parent,
                   const std::string &_name, bool _allowRename);
 
+      /// \brief Clone an entity and its descendants many times at once. This
+      /// is much faster than calling Clone repeatedly for mass spawning: all
+      /// entity ids are allocated up front, components are copied directly
+      /// from the originals, and views are updated once per entity.
+      ///
+      /// Unlike Clone, only the root of each copy is renamed, to a unique
+      /// name made of the original name and a numeric suffix. Descendants
+      /// keep their names, which stay unique within their cloned parent, so
+      /// the link names referenced by cloned joints remain valid. Entity
+      /// references held by components::ParentEntity and
+      /// components::ModelCanonicalLink are remapped to the cloned entities.
+      /// Other components are copied unchanged.
+      /// \param[in] _entity The entity to clone.
+      /// \param[in] _parent The parent of each cloned root. Set this to
+      /// kNullEntity if the clones should not have a parent.
+      /// \param[in] _count Number of copies to make.
+      /// \return The root of each copy, or an empty vector if _entity
+      /// doesn't exist or not enough entity ids are left.
+      /// \sa Clone
+      public: std::vector<Entity> CloneMany(Entity _entity, Entity _parent,
+                  std::size_t _count);
+
+      /// \brief Copy all entities and components of another manager into
+      /// this one. The copies get new ids, allocated in the order of the
+      /// original ids, and views are updated once for all of them. This is
+      /// used to build entities concurrently in separate managers and then
+      /// add them all at once.
+      ///
+      /// Like CloneMany, entity references held by components::ParentEntity
+      /// and components::ModelCanonicalLink are remapped to the copies.
+      /// Other components are copied unchanged. Entities that don't have a
+      /// parent in _other don't have a parent in this manager either.
+      /// \param[in] _other Manager to copy from.
+      /// \return The id of each copy, keyed by the id of its original, or
+      /// an empty map if not enough entity ids are left.
+      public: std::unordered_map<Entity, Entity> CopyEntities(
+                  const EntityComponentManager &_other);
+
       /// \brief Get the number of entities on the server.
       /// \return Entity count.
       public: size_t EntityCount() const;
@@ -167,6 +363,28 @@ namespace ignition
       /// \return True if the Entity exists.
       public: bool HasEntity(const Entity _entity) const;
 
+      /// \brief Get the compact index of an entity, which is reused once the
+      /// entity is removed, see EntityIndex. Systems can keep per-entity
+      /// data in arrays of IndexCount() elements indexed by it.
+      /// \param[in] _entity Entity.
+      /// \return The entity's index, or an invalid index if the entity
+      /// doesn't exist.
+      public: EntityIndex IndexOf(const Entity _entity) const;
+
+      /// \brief Get the entity which has a compact index.
+      /// \param[in] _index Compact index.
+      /// \return The entity, or kNullEntity if no entity has the index,
+      /// including when the generation doesn't match because the entity
+      /// which had the index was removed.
+      public: Entity EntityAt(const EntityIndex &_index) const;
+
+      /// \brief Get the number of compact indices given so far, including
+      /// the ones of removed entities which haven't been reused yet. All
+      /// indices are smaller than this, and it only grows when more entities
+      /// exist at once than ever before.
+      /// \return Number of indices.
+      public: std::size_t IndexCount() const;
+
       /// \brief Get the first parent of the given entity.
       /// \details Entities are not expected to have multiple parents.
       /// TODO(louise) Either prevent multiple parents or provide full support
@@ -192,6 +410,26 @@ namespace ignition
       /// \return True if the provided _typeId has been created.
       public: bool HasComponentType(const ComponentTypeId _typeId) const;
 
+      /// \brief Get the generation of a component type, which changes
+      /// whenever components of that type are created or removed. Systems
+      /// which keep pointers to components across updates can compare it
+      /// with the generation they last saw to know when the pointers need to
+      /// be looked up again.
+      /// \param[in] _typeId ID of the component type.
+      /// \return The generation, or zero if no component of that type was
+      /// ever created.
+      public: uint64_t ComponentTypeGeneration(
+                  const ComponentTypeId _typeId) const;
+
+      /// \brief Get the number of components of a type held by the manager.
+      /// This is a constant time query, which systems can use to skip the
+      /// work related to a component type, such as a command, when no entity
+      /// has it. Components removed from an entity are kept until the entity
+      /// itself is removed, so they're still counted.
+      /// \param[in] _typeId ID of the component type to check.
+      /// \return Number of components of the type.
+      public: std::size_t ComponentCount(const ComponentTypeId _typeId) const;
+
       /// \brief Check whether an entity has a specific component.
       /// \param[in] _entity The entity to check.
       /// \param[in] _key The component to check.
@@ -255,6 +493,29 @@ namespace ignition
                   const Entity _entity,
                   const ComponentTypeT &_data);
 
+      /// \brief Create a component of a particular type on multiple entities
+      /// at once. This copies the _data parameters. Storage is grown only
+      /// once and views are updated in a single pass at the end, as if the
+      /// calls were made within BeginBatchCreation / EndBatchCreation.
+      /// \param[in] _entities The entities that will be associated with the
+      /// components.
+      /// \param[in] _data Data used to construct each component, in the same
+      /// order as _entities. Nothing is created if the sizes don't match.
+      public: template<typename ComponentTypeT>
+              void CreateComponents(
+                  const std::vector<Entity> &_entities,
+                  const std::vector<ComponentTypeT> &_data);
+
+      /// \brief Create a component of a particular type on multiple entities
+      /// at once, all with the same data. See the overload above.
+      /// \param[in] _entities The entities that will be associated with the
+      /// components.
+      /// \param[in] _data Data used to construct all the components.
+      public: template<typename ComponentTypeT>
+              void CreateComponents(
+                  const std::vector<Entity> &_entities,
+                  const ComponentTypeT &_data);
+
       /// \brief Get a component assigned to an entity based on a
       /// component type.
       /// \param[in] _entity The entity.
@@ -271,6 +532,24 @@ namespace ignition
       public: template<typename ComponentTypeT>
               ComponentTypeT *Component(const Entity _entity);
 
+      /// \brief Get a handle to a component assigned to an entity, which
+      /// caches the component between accesses. This is meant for systems
+      /// which access the same component on every step.
+      /// \param[in] _entity The entity.
+      /// \return Handle to the component. It's valid even if the entity
+      /// doesn't have the component yet.
+      /// \sa ComponentHandle
+      public: template<typename ComponentTypeT>
+              ComponentHandle<const ComponentTypeT> Handle(
+                  const Entity _entity) const;
+
+      /// \brief Get a handle to a mutable component assigned to an entity.
+      /// See the const overload above.
+      /// \param[in] _entity The entity.
+      /// \return Handle to the component.
+      public: template<typename ComponentTypeT>
+              ComponentHandle<ComponentTypeT> Handle(const Entity _entity);
+
       /// \brief Get a component based on a key.
       /// \param[in] _key A key that uniquely identifies a component.
       /// \return The component associated with the key, or nullptr if the
@@ -316,7 +595,8 @@ namespace ignition
       /// * If the component type doesn't hold any data, this won't compile.
       /// * If the entity doesn't have that component, the component will be
       ///   created.
-      /// * If the entity has the component, its data will be updated.
+      /// * If the entity has the component, its data will be updated, as
+      ///   well as its change tick if the data changed.
       /// \param[in] _entity The entity.
       /// \param[in] _data New component data
       /// \tparam ComponentTypeT Component type
@@ -375,6 +655,20 @@ namespace ignition
               std::vector<Entity> EntitiesByComponents(
                    const ComponentTypeTs &..._desiredComponents) const;
 
+      /// \brief Get all entities which have a components::Name equal to the
+      /// given name. Names are kept in an index, so this doesn't visit other
+      /// entities. EntityByComponents and EntitiesByComponents also use the
+      /// index when one of the desired components is a components::Name.
+      ///
+      /// The index is updated when a name component is created, removed or
+      /// marked as changed, or accessed through a mutable ComponentHandle.
+      /// Names modified in place through other pointers without calling
+      /// SetChanged are not reflected.
+      /// \param[in] _name Name to look for.
+      /// \return All entities with that name, sorted by id.
+      public: std::vector<Entity> EntitiesByName(const std::string &_name)
+                  const;
+
       /// \brief Get all entities which match the value of all the given
       /// components and are immediate children of a given parent entity.
       /// For example, the following will return a child of entity `parent`
@@ -451,6 +745,14 @@ namespace ignition
       /// as the components. Note that an entity marked for removal (but not
       /// processed yet) will be included in the list of entities iterated by
       /// this call.
+      ///
+      /// Component types can be wrapped in Without, to skip entities which
+      /// have that component, or in Optional, to also visit entities which
+      /// don't have it, in which case the callback gets a null pointer.
+      /// Excluded components aren't passed to the callback. Filters are
+      /// applied once when the cached view is built and when the filtered
+      /// components are added or removed, not on every call. This applies to
+      /// all the cached versions of Each.
       /// \param[in] _f Callback function to be called for each matching entity.
       /// The function parameter are all the desired component types, in the
       /// order they're listed on the template. The callback function can
@@ -459,10 +761,11 @@ namespace ignition
       /// \tparam ComponentTypeTs All the desired component types.
       /// \warning This function should not be called outside of System's
       /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa Without
+      /// \sa Optional
       public: template<typename ...ComponentTypeTs>
-              void Each(typename identity<std::function<
-                  bool(const Entity &_entity,
-                       const ComponentTypeTs *...)>>::type _f) const;
+              void Each(
+                  detail::QueryCallback<true, ComponentTypeTs...> _f) const;
 
       /// \brief Get all entities which contain given component types, as well
       /// as the mutable components. Note that an entity marked for removal (but
@@ -477,9 +780,141 @@ namespace ignition
       /// \warning This function should not be called outside of System's
       /// PreUpdate, Update, or PostUpdate callbacks.
       public: template<typename ...ComponentTypeTs>
-              void Each(typename identity<std::function<
-                  bool(const Entity &_entity,
-                       ComponentTypeTs *...)>>::type _f);
+              void Each(
+                  detail::QueryCallback<false, ComponentTypeTs...> _f);
+
+      /// \brief Parallel version of Each(). Get all entities which contain
+      /// given component types, as well as the components, and call the
+      /// callback for each of them concurrently from multiple threads.
+      ///
+      /// The entities are split in chunks which are distributed over a worker
+      /// pool shared by the whole EntityComponentManager, so there are no
+      /// guarantees on the order in which entities are visited. Returning
+      /// false from the callback stops processing further entities, but
+      /// callbacks already running on other threads will still complete.
+      ///
+      /// The callback may read and modify the components it's given, and read
+      /// other components through the const Component() and ComponentData()
+      /// functions. Any function that changes the structure of the ECM or its
+      /// change tracking, such as CreateEntity, CreateComponent,
+      /// RemoveComponent, RequestRemoveEntity, SetChanged, SetComponentData
+      /// or Each, must not be called from the callback. Writes to shared
+      /// state outside of the given components must be synchronized by the
+      /// caller.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa Each
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(
+                  detail::QueryCallback<true, ComponentTypeTs...> _f) const;
+
+      /// \brief Parallel version of Each(), with mutable components. See the
+      /// const version for the operations which are safe to call from the
+      /// callback.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      /// \warning This function should not be called outside of System's
+      /// PreUpdate, Update, or PostUpdate callbacks.
+      /// \sa Each
+      public: template<typename ...ComponentTypeTs>
+              void EachParallel(
+                  detail::QueryCallback<false, ComponentTypeTs...> _f);
+
+      /// \brief Call a function over the range [0, _count), split in chunks
+      /// that are processed concurrently by the worker pool used by
+      /// EachParallel. Blocks until the whole range has been processed.
+      ///
+      /// This is useful to split loops over entities gathered by the caller.
+      /// The same restrictions as EachParallel apply to the operations that
+      /// can be called from _func.
+      /// \param[in] _count Number of elements in the range.
+      /// \param[in] _func Function called with the [begin, end) indices of
+      /// each chunk.
+      /// \param[in] _minChunkSize Minimum number of elements per chunk.
+      /// Ranges with fewer elements than this are processed on the calling
+      /// thread.
+      /// \sa EachParallel
+      public: void ParallelFor(std::size_t _count,
+                  const std::function<void(std::size_t, std::size_t)> &_func,
+                  std::size_t _minChunkSize = 1u) const;
+
+      /// \brief Get all entities which contain given component types, and
+      /// call a function with chunks of them, with the data of each component
+      /// type packed in a contiguous array. This lets the function process
+      /// many entities in a tight loop which compilers can vectorize, instead
+      /// of being called once per entity.
+      ///
+      /// Component instances aren't stored next to each other, so the data
+      /// of each chunk is copied into arrays before calling the function.
+      /// The arrays of a chunk hold the data of the same entity at the same
+      /// index, and entities are visited in the same order as Each. Only
+      /// component types with data can be used, without filters, and the
+      /// data type can't be bool.
+      ///
+      /// The function is called as
+      /// `_f(std::size_t _count, const Entity *_entities, DataTs *..._data)`,
+      /// where each `_data` points to `_count` values of the type held by the
+      /// corresponding component, in the same order as ComponentTypeTs. If
+      /// the function takes the data as non-const pointers, the values are
+      /// copied back into the components after each call, without marking
+      /// them as changed. The function must not change the structure of the
+      /// ECM.
+      /// \param[in] _f Function to call for each chunk of entities.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \tparam FuncT Type of the function.
+      /// \sa Each
+      public: template<typename ...ComponentTypeTs, typename FuncT>
+              void EachSpan(FuncT &&_f);
+
+      /// \brief Const version of EachSpan, which passes the data as const
+      /// pointers.
+      /// \param[in] _f Function to call for each chunk of entities.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \tparam FuncT Type of the function.
+      /// \sa EachSpan
+      public: template<typename ...ComponentTypeTs, typename FuncT>
+              void EachSpan(FuncT &&_f) const;
+
+      /// \brief Get all entities which contain given component types and had
+      /// at least one of these components changed after a given change tick,
+      /// as well as the components.
+      ///
+      /// A component's change tick is updated whenever it's created,
+      /// removed, marked as changed through SetChanged, or given different
+      /// data through SetComponentData. Modifying a component's data
+      /// directly without calling SetChanged doesn't update its tick.
+      ///
+      /// A consumer that runs periodically can store ChangeTick() after
+      /// processing the changes and pass it on the next call, so it only
+      /// visits what changed in between, even if it skipped several
+      /// iterations.
+      /// \param[in] _tick Only components changed after this tick are
+      /// considered. Use zero to visit all matching entities.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity. The callback function can return false to stop subsequent
+      /// calls to the callback, otherwise a true value should be returned.
+      /// \tparam ComponentTypeTs All the desired component types.
+      /// \sa ChangeTick
+      /// \sa ComponentChangeTick
+      public: template<typename ...ComponentTypeTs>
+              void EachChangedSince(uint64_t _tick,
+                  detail::QueryCallback<true, ComponentTypeTs...> _f) const;
+
+      /// \brief Mutable version of EachChangedSince. Modifying the given
+      /// components doesn't update their change ticks; call SetChanged for
+      /// that.
+      /// \param[in] _tick Only components changed after this tick are
+      /// considered. Use zero to visit all matching entities.
+      /// \param[in] _f Callback function to be called for each matching
+      /// entity.
+      /// \tparam ComponentTypeTs All the desired mutable component types.
+      public: template<typename ...ComponentTypeTs>
+              void EachChangedSince(uint64_t _tick,
+                  detail::QueryCallback<false, ComponentTypeTs...> _f);
 
       /// \brief Call a function for each parameter in a pack.
       /// \param[in] _f Function to be called.
@@ -503,9 +938,8 @@ namespace ignition
       /// function in a system's PostUpdate callback, you should use the const
       /// version of this method.
       public: template <typename... ComponentTypeTs>
-              void EachNew(typename identity<std::function<
-                           bool(const Entity &_entity,
-                                ComponentTypeTs *...)>>::type _f);
+              void EachNew(
+                  detail::QueryCallback<false, ComponentTypeTs...> _f);
 
       /// \brief Get all newly created entities which contain given component
       /// types, as well as the components. This "newness" is cleared at the end
@@ -520,9 +954,8 @@ namespace ignition
       /// should not be called in a System's PreUpdate callback (it's okay to
       /// call this function in the Update or PostUpdate callback).
       public: template <typename... ComponentTypeTs>
-              void EachNew(typename identity<std::function<
-                           bool(const Entity &_entity,
-                                const ComponentTypeTs *...)>>::type _f) const;
+              void EachNew(
+                  detail::QueryCallback<true, ComponentTypeTs...> _f) const;
 
       /// \brief Get all entities which contain given component types and are
       /// about to be removed, as well as the components.
@@ -535,15 +968,30 @@ namespace ignition
       /// \warning This function should not be called outside of System's
       /// PostUpdate callback.
       public: template<typename ...ComponentTypeTs>
-              void EachRemoved(typename identity<std::function<
-                  bool(const Entity &_entity,
-                       const ComponentTypeTs *...)>>::type _f) const;
+              void EachRemoved(
+                  detail::QueryCallback<true, ComponentTypeTs...> _f) const;
 
       /// \brief Get a graph with all the entities. Entities are vertices and
       /// edges point from parent to children.
-      /// \return Entity graph.
+      ///
+      /// The ECM keeps the hierarchy in a compact form, and the graph is
+      /// only built on demand, when it's requested after the hierarchy
+      /// changed. Building it is costly on large worlds, so prefer
+      /// AllEntities, ParentEntity, Children and Descendants.
+      /// \return Entity graph. It's updated by later calls, after the
+      /// hierarchy changes.
       public: const EntityGraph &Entities() const;
 
+      /// \brief Get all entities.
+      /// \return All entities, sorted by id.
+      public: std::vector<Entity> AllEntities() const;
+
+      /// \brief Get the immediate children of an entity.
+      /// \param[in] _parent Parent entity.
+      /// \return Children sorted by id. It will be empty if the entity has
+      /// no children or doesn't exist.
+      public: std::vector<Entity> Children(const Entity _parent) const;
+
       /// \brief Get all entities which are descendants of a given entity,
       /// including the entity itself.
       /// \param[in] _entity Entity whose descendants we want.
@@ -551,6 +999,31 @@ namespace ignition
       /// empty if the entity doesn't exist.
       public: std::unordered_set<Entity> Descendants(Entity _entity) const;
 
+      /// \brief Get the ancestors of an entity, following its
+      /// components::ParentEntity component up to the root. The result is
+      /// cached until the hierarchy changes.
+      /// \param[in] _entity Entity whose ancestors we want.
+      /// \return Ancestors, starting with the parent of _entity. It will be
+      /// empty if the entity has no parent.
+      public: std::vector<Entity> Ancestors(const Entity _entity) const;
+
+      /// \brief Get the pose of an entity expressed in the world frame,
+      /// composing the components::Pose of the entity and its ancestors up
+      /// to the first ancestor without a pose. Intermediate results are
+      /// cached for the rest of the iteration, so querying many siblings
+      /// only composes their common ancestors once.
+      ///
+      /// The cache is invalidated when a Pose or ParentEntity component is
+      /// created, removed, marked as changed, set with SetComponentData or
+      /// accessed through a mutable accessor or query, so pointers to poses
+      /// which are kept and modified later, after other queries, won't be
+      /// reflected until the next iteration. Use the uncached
+      /// gazebo::worldPose in that case.
+      /// \param[in] _entity Entity whose world pose we want.
+      /// \return World pose of the entity, or identity if the entity doesn't
+      /// have a pose.
+      public: math::Pose3d WorldPose(const Entity _entity) const;
+
       /// \brief Get a message with the serialized state of the given entities
       /// and components.
       /// \details The header of the message will not be populated, it is the
@@ -638,6 +1111,89 @@ namespace ignition
       /// responsibility of the caller to timestamp it before use.
       public: void ChangedState(msgs::SerializedStateMap &_state) const;
 
+      /// \brief Get a message with the serialized state of the entities and
+      /// components that are changing in the current iteration, like
+      /// ChangedState, leaving out the ones rejected by the given filters.
+      /// Rejected components are never serialized, so this is cheaper than
+      /// removing them from the message afterwards.
+      /// \param[out] _state New serialized state.
+      /// \param[in] _entityFilter Returns true for entities to serialize. An
+      /// empty function accepts all entities.
+      /// \param[in] _typeFilter Returns true for component types to
+      /// serialize. An empty function accepts all types. Removed components
+      /// of accepted entities are always flagged.
+      /// \details The header of the message will not be populated, it is the
+      /// responsibility of the caller to timestamp it before use.
+      public: void ChangedState(msgs::SerializedStateMap &_state,
+                  const std::function<bool(const Entity)> &_entityFilter,
+                  const std::function<bool(const ComponentTypeId)>
+                  &_typeFilter) const;
+
+      /// \brief Get a message with the serialized state of all entities and
+      /// components that changed after a given change tick. Unlike the
+      /// version without a tick, this isn't limited to the current
+      /// iteration, so a consumer which doesn't run every iteration can catch
+      /// up with all the changes it missed.
+      ///
+      /// This includes:
+      /// * Components created or marked as changed after _sinceTick
+      /// * Components removed after _sinceTick, flagged as removed
+      /// * Entities marked for removal, or removed after _sinceTick, flagged
+      /// as removed
+      ///
+      /// Removals are only remembered for a limited number of ticks. Callers
+      /// that fall further behind should request the full state instead.
+      /// \param[out] _state The serialized state message to populate.
+      /// \param[in] _sinceTick Only changes after this tick are serialized.
+      /// \param[in] _entities Only changes to these entities are serialized.
+      /// Leave empty to get changes to all entities.
+      /// \param[in] _types Only changes to components of these types are
+      /// serialized. Leave empty to get changes to all types.
+      /// \details The header of the message will not be populated, it is the
+      /// responsibility of the caller to timestamp it before use.
+      /// \sa ChangeTick
+      public: void ChangedState(msgs::SerializedStateMap &_state,
+                  uint64_t _sinceTick,
+                  const std::unordered_set<Entity> &_entities = {},
+                  const std::unordered_set<ComponentTypeId> &_types = {})
+                  const;
+
+      /// \brief Get the current change tick. All changes made from now on
+      /// will be stamped with a tick greater than this one. The tick is
+      /// advanced once per simulation iteration, including paused
+      /// iterations, and it never goes back, even when simulation is
+      /// rewound.
+      /// \return The current change tick.
+      public: uint64_t ChangeTick() const;
+
+      /// \brief Get the change tick at which a component was last created,
+      /// removed or marked as changed.
+      /// \param[in] _entity Entity that contains the component.
+      /// \param[in] _typeId Component type ID.
+      /// \return The component's change tick, or zero if the entity never had
+      /// a component of this type.
+      public: uint64_t ComponentChangeTick(const Entity _entity,
+                  const ComponentTypeId _typeId) const;
+
+      /// \brief Get whether any component of a given type was created or
+      /// marked as changed after a given change tick.
+      /// \param[in] _tick Only components changed after this tick are
+      /// considered.
+      /// \param[in] _typeId Component type ID.
+      /// \return True if a component of this type changed.
+      /// \sa ChangeTick
+      public: bool ComponentTypeChangedSince(uint64_t _tick,
+                  const ComponentTypeId _typeId) const;
+
+      /// \brief Get the number of memory allocations made so far to store
+      /// component instances. Components are constructed in memory pooled
+      /// per component type, which is reused once components are removed, so
+      /// this count stops growing once the number of components of each
+      /// type stops growing. Allocations made by the data held by
+      /// components, such as strings, aren't counted.
+      /// \return Number of allocations.
+      public: uint64_t ComponentAllocationCount() const;
+
       /// \brief Set the absolute state of the ECM from a serialized message.
       /// Entities / components that are in the new state but not in the old
       /// one will be created.
@@ -690,6 +1246,30 @@ namespace ignition
       /// \brief Mark all components as not changed.
       protected: void SetAllComponentsUnchanged();
 
+      /// \brief Advance the change tick, so that all following changes are
+      /// stamped as newer than the ones made so far. This function is
+      /// protected to facilitate testing.
+      protected: void AdvanceChangeTick();
+
+      /// \brief Apply the commands recorded in the buffers returned by
+      /// Deferred, and clear them. This must not be called while other
+      /// threads may be recording commands. This function is protected to
+      /// facilitate testing.
+      protected: void ApplyDeferredCommands();
+
+      /// \brief Update the spatial index with the models that moved or were
+      /// removed since the last update. Does nothing until the index has
+      /// been requested through ModelSpatialIndex. This function is
+      /// protected to facilitate testing.
+      protected: void UpdateSpatialIndex();
+
+      /// \brief Use a thread pool shared with other managers for parallel
+      /// iteration, instead of creating one on first use. Must not be called
+      /// while a parallel iteration is running.
+      /// \param[in] _pool Pool to use, or nullptr to go back to creating a
+      /// pool of its own on first use.
+      protected: void SetThreadPool(const std::shared_ptr<ThreadPool> &_pool);
+
       /// \brief Get whether an Entity exists and is new.
       ///
       /// Entities are considered new in the time between their creation and a
@@ -703,6 +1283,28 @@ namespace ignition
       /// \return True if the Entity has been marked to be removed.
       private: bool IsMarkedForRemoval(const Entity _entity) const;
 
+      /// \brief Reserve an entity id, to be used later by
+      /// CreateReservedEntity. This is safe to call from any thread.
+      /// \return The reserved id.
+      private: Entity ReserveEntity() const;
+
+      /// \brief Create an entity whose id was obtained from ReserveEntity.
+      /// \param[in] _entity Reserved entity.
+      /// \return The created entity.
+      private: Entity CreateReservedEntity(const Entity _entity);
+
+      /// \brief Grow the storage of a component type so that it can hold
+      /// more components without reallocating.
+      /// \param[in] _typeId Id of the component type.
+      /// \param[in] _count Number of components that are about to be
+      /// created.
+      private: void ReserveComponents(const ComponentTypeId _typeId,
+                   const std::size_t _count);
+
+      /// \brief Add the entities which got new components during a batch to
+      /// the views they match. The caller must hold the views mutex.
+      private: void UpdateViewsForBatchedEntities() const;
+
       /// \brief Implementation of CreateComponent.
       /// \param[in] _entity The entity that will be associated with
       /// the component.
@@ -733,6 +1335,15 @@ namespace ignition
                    const Entity _entity,
                    const ComponentTypeId _type);
 
+      /// \brief Get the generation of the storage of a component type,
+      /// which changes whenever components of that type are created or
+      /// removed.
+      /// \param[in] _type Id of the component type.
+      /// \return Pointer to the generation, valid for the lifetime of the
+      /// manager, or nullptr if no component of that type was ever created.
+      private: const uint64_t *ComponentGeneration(
+                   const ComponentTypeId _type) const;
+
       /// \brief Find a View that matches the set of ComponentTypeIds. If
       /// a match is not found, then a new view is created.
       /// \tparam ComponentTypeTs All the component types that define a view.
@@ -740,7 +1351,35 @@ namespace ignition
       private: template<typename ...ComponentTypeTs>
           detail::View *FindView() const;
 
-      /// \brief Find a view based on the provided component type ids.
+      /// \brief Check whether an entity belongs to a view: it must have all
+      /// the view's required components and none of its excluded ones.
+      /// \param[in] _entity The entity.
+      /// \param[in] _view The view.
+      /// \return True if the entity matches the view.
+      private: bool EntityMatchesView(const Entity _entity,
+                   const detail::BaseView &_view) const;
+
+      /// \brief Update the views with filters after a component of an
+      /// entity was added or removed. Since the filters are applied when
+      /// entities are added to a view, the entity is added again to each
+      /// filtered view which depends on the component type.
+      /// \param[in] _entity The entity.
+      /// \param[in] _typeId Type of the added or removed component.
+      private: void UpdateFilteredViews(const Entity _entity,
+                   const ComponentTypeId _typeId);
+
+      /// \brief Find the view which was cached for a query slot, without
+      /// locking the views.
+      /// \param[in] _slot Slot of the query.
+      /// \return A pair containing a the view itself and a mutex that can be
+      /// used for locking the view while entities are being added to it.
+      /// If no view was cached for _slot, the pair will contain nullptrs.
+      /// \sa detail::QueryViewSlot
+      private: std::pair<detail::BaseView *, std::mutex *> CachedView(
+                   const std::size_t _slot) const;
+
+      /// \brief Find a view based on the provided component type ids,
+      /// without caching it for a query slot.
       /// \param[in] _types The component type ids that serve as a key into
       /// a map of views.
       /// \return A pair containing a the view itself and a mutex that can be
@@ -750,7 +1389,21 @@ namespace ignition
       private: std::pair<detail::BaseView *, std::mutex *> FindView(
                    const std::vector<ComponentTypeId> &_types) const;
 
-      /// \brief Add a new view to the set of stored views.
+      /// \brief Find a view based on the provided component type ids.
+      /// \param[in] _types The component type ids that serve as a key into
+      /// a map of views.
+      /// \param[in] _slot Slot of the query, where the view is cached if it
+      /// is found.
+      /// \return A pair containing a the view itself and a mutex that can be
+      /// used for locking the view while entities are being added to it.
+      /// If a view defined by _types does not exist, the pair will contain
+      /// nullptrs.
+      private: std::pair<detail::BaseView *, std::mutex *> FindView(
+                   const std::vector<ComponentTypeId> &_types,
+                   const std::size_t _slot) const;
+
+      /// \brief Add a new view to the set of stored views, without caching
+      /// it for a query slot.
       /// \param[in] _types The set of component type ids that act as the key
       /// for the view.
       /// \param[in] _view The view to add.
@@ -759,6 +1412,93 @@ namespace ignition
                    const detail::ComponentTypeKey &_types,
                    std::unique_ptr<detail::BaseView> _view) const;
 
+      /// \brief Add a new view to the set of stored views.
+      /// \param[in] _types The set of component type ids that act as the key
+      /// for the view.
+      /// \param[in] _view The view to add.
+      /// \param[in] _slot Slot of the query, where the view is cached.
+      /// \return A pointer to the view.
+      private: detail::BaseView *AddView(
+                   const detail::ComponentTypeKey &_types,
+                   std::unique_ptr<detail::BaseView> _view,
+                   const std::size_t _slot) const;
+
+      /// \brief Get all entities with a component of any of the given types
+      /// that changed after _tick, and isn't currently removed.
+      /// \param[in] _tick Only components changed after this tick are
+      /// considered.
+      /// \param[in] _types Component types to check.
+      /// \return Entities with changed components, sorted by id.
+      private: std::vector<Entity> EntitiesChangedSince(uint64_t _tick,
+                   const std::vector<ComponentTypeId> &_types) const;
+
+      /// \brief Update the spatial index with the models that changed after
+      /// a given tick. The caller must hold the spatial index mutex.
+      /// \param[in] _sinceTick Models whose pose, box or model component
+      /// changed after this tick, or which were removed after it, are
+      /// updated.
+      private: void RefreshSpatialIndex(uint64_t _sinceTick) const;
+
+      /// \brief Update the name index with the entities whose name changed
+      /// since it was last refreshed. The caller must hold the name index
+      /// mutex.
+      private: void RefreshNameIndex() const;
+
+      /// \brief Get the candidate entities for a desired component from an
+      /// index, if there's one for that component type.
+      /// \param[in] _component Desired component.
+      /// \param[out] _entities Entities which have a component equal to
+      /// _component.
+      /// \return True if the component type is indexed.
+      private: bool IndexedEntities(
+                   const components::BaseComponent &_component,
+                   std::vector<Entity> &_entities) const;
+
+      /// \brief Check whether an entity has components equal to all the
+      /// desired components.
+      /// \param[in] _entity Entity to check.
+      /// \param[in] _desiredComponents All the components which must match.
+      /// \return True if all components match.
+      private: template<typename ...ComponentTypeTs>
+               bool MatchesComponentValues(const Entity _entity,
+                   const ComponentTypeTs &..._desiredComponents) const;
+
+      /// \brief Get the candidate entities for a set of desired components
+      /// from the index of the first indexed one.
+      /// \param[in] _desiredComponents All the components which must match.
+      /// \return The candidates, or nullopt if none of the components is
+      /// indexed, in which case all entities have to be visited.
+      private: template<typename ...ComponentTypeTs>
+               std::optional<std::vector<Entity>> IndexedCandidates(
+                   const ComponentTypeTs &..._desiredComponents) const;
+
+      /// \brief Implementation of Ancestors. The caller must hold the
+      /// hierarchy mutex.
+      /// \param[in] _entity Entity whose ancestors we want.
+      /// \return Ancestors, starting with the parent of _entity.
+      private: const std::vector<Entity> &AncestorsUnlocked(
+                   const Entity _entity) const;
+
+      /// \brief Invalidate the caches which depend on any component of a
+      /// type, after a query handed out mutable pointers to them.
+      /// \param[in] _typeId Type of the components.
+      private: void InvalidateCachesForType(const ComponentTypeId _typeId);
+
+      /// \brief Invalidate the caches which depend on a component of an
+      /// entity, after a handle handed out a mutable pointer to it.
+      /// \param[in] _entity Entity which owns the component.
+      /// \param[in] _typeId Type of the component.
+      private: void InvalidateCachesFor(const Entity _entity,
+                   const ComponentTypeId _typeId);
+
+      /// \brief Stamp a component with the current change tick, after its
+      /// data was modified through SetComponentData.
+      /// \param[in] _entity Entity which owns the component.
+      /// \param[in] _typeId Type of the component.
+      /// \sa ComponentChangeTick
+      private: void StampChange(const Entity _entity,
+                   const ComponentTypeId _typeId);
+
       /// \brief Add an entity and its components to a serialized state message.
       /// \param[out] _msg The state message.
       /// \param[in] _entity The entity to be added.
@@ -778,12 +1518,16 @@ namespace ignition
       /// components.
       /// \param[in] _full True to get all the entities and components.
       /// False will get only components and entities that have changed.
+      /// \param[in] _typeFilter Returns false for component types to leave
+      /// out. An empty function accepts all types.
       /// \note This function will mark `Changed` components as not changed.
       /// See the todo in the implementation.
       private: void AddEntityToMessage(msgs::SerializedStateMap &_msg,
           Entity _entity,
           const std::unordered_set<ComponentTypeId> &_types = {},
-          bool _full = false) const;
+          bool _full = false,
+          const std::function<bool(const ComponentTypeId)> &_typeFilter =
+          {}) const;
 
       /// \brief Set whether views should be locked when entities are being
       /// added to them. This can be used to prevent race conditions in
@@ -811,11 +1555,21 @@ namespace ignition
       // states. Like the runners, the managers are internal.
       friend class NetworkManagerPrimary;
       friend class NetworkManagerSecondary;
+
+      // Make command buffers friends so they can create reserved entities.
+      friend class EntityCommandBuffer;
+
+      // Make component handles friends so they can check the generation of
+      // the storage.
+      template<typename ComponentTypeT>
+      friend class ComponentHandle;
     };
     }
   }
 }
 
 #include "ignition/gazebo/detail/EntityComponentManager.hh"
+#include "ignition/gazebo/detail/EntityCommandBuffer.hh"
+#include "ignition/gazebo/detail/ComponentHandle.hh"
 
 #endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYCOMPONENTSNAPSHOT_HH_
+#define IGNITION_GAZEBO_ENTITYCOMPONENTSNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/components/Component.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/QueryFilters.hh>
+#include <ignition/gazebo/Types.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN EntityComponentSnapshotPrivate;
+
+    /// \class EntityComponentSnapshot EntityComponentSnapshot.hh
+    /// ignition/gazebo/EntityComponentSnapshot.hh
+    /// \brief Immutable copy of the entities and components of an
+    /// EntityComponentManager at one point in time, created through
+    /// EntityComponentManager::Snapshot.
+    ///
+    /// A snapshot is never modified once created, so it can be read from
+    /// any number of threads while simulation keeps stepping, for example
+    /// by a rendering thread. Snapshots are copy-on-write: a component which
+    /// hasn't changed since the previous snapshot is shared with it instead
+    /// of being copied, and so are all the components of a type if none
+    /// of them changed. Changes are detected through the components' change
+    /// ticks, so modifications which aren't followed by
+    /// EntityComponentManager::SetChanged aren't picked up.
+    class IGNITION_GAZEBO_VISIBLE EntityComponentSnapshot
+    {
+      /// \brief Constructor. Creates an empty snapshot.
+      public: EntityComponentSnapshot();
+
+      /// \brief Destructor
+      public: ~EntityComponentSnapshot();
+
+      /// \brief Get the change tick of the manager when the snapshot was
+      /// taken.
+      /// \return Change tick.
+      /// \sa EntityComponentManager::ChangeTick
+      public: uint64_t ChangeTick() const;
+
+      /// \brief Get all entities in the snapshot.
+      /// \return Entities, sorted by id.
+      public: const std::vector<Entity> &Entities() const;
+
+      /// \brief Get whether an entity is in the snapshot.
+      /// \param[in] _entity Entity.
+      /// \return True if the entity is in the snapshot.
+      public: bool HasEntity(const Entity _entity) const;
+
+      /// \brief Get all entities which have a component of a given type.
+      /// \param[in] _typeId Component type id.
+      /// \return Entities, sorted by id.
+      public: const std::vector<Entity> &EntitiesWithComponent(
+                  const ComponentTypeId _typeId) const;
+
+      /// \brief Get the component of a given type of an entity.
+      /// \param[in] _entity Entity.
+      /// \param[in] _typeId Component type id.
+      /// \return The component, or nullptr if the entity doesn't have it.
+      public: const components::BaseComponent *ComponentImplementation(
+                  const Entity _entity, const ComponentTypeId _typeId) const;
+
+      /// \brief Get the component of a given type of an entity.
+      /// \param[in] _entity Entity.
+      /// \return The component, or nullptr if the entity doesn't have it.
+      /// \tparam ComponentTypeT Component type.
+      public: template<typename ComponentTypeT>
+              const ComponentTypeT *Component(const Entity _entity) const
+      {
+        return static_cast<const ComponentTypeT *>(
+            this->ComponentImplementation(_entity, ComponentTypeT::typeId));
+      }
+
+      /// \brief Get the data of a component of an entity.
+      /// \param[in] _entity Entity.
+      /// \return A copy of the data, or std::nullopt if the entity doesn't
+      /// have the component.
+      /// \tparam ComponentTypeT Component type.
+      public: template<typename ComponentTypeT>
+              std::optional<typename ComponentTypeT::Type> ComponentData(
+                  const Entity _entity) const
+      {
+        auto comp = this->Component<ComponentTypeT>(_entity);
+        if (nullptr == comp)
+          return std::nullopt;
+        return std::make_optional(comp->Data());
+      }
+
+      /// \brief Call a function for each entity which has all the given
+      /// components, in increasing entity order.
+      /// \param[in] _f Function to call. It can return false to stop the
+      /// iteration.
+      /// \tparam FirstComponentT First required component type.
+      /// \tparam ComponentTypeTs Other required component types.
+      public: template<typename FirstComponentT, typename ...ComponentTypeTs>
+              void Each(const typename detail::QueryCallbackImpl<
+                  std::tuple<FirstComponentT, ComponentTypeTs...>, true>::type
+                  &_f) const
+      {
+        for (const Entity entity :
+            this->EntitiesWithComponent(FirstComponentT::typeId))
+        {
+          const std::tuple<const FirstComponentT *,
+              const ComponentTypeTs *...> comps{
+              this->Component<FirstComponentT>(entity),
+              this->Component<ComponentTypeTs>(entity)...};
+          if (!std::apply([](auto *..._comps)
+              {
+                return ((nullptr != _comps) && ...);
+              }, comps))
+          {
+            continue;
+          }
+          if (!std::apply([&](auto *..._comps)
+              {
+                return _f(entity, _comps...);
+              }, comps))
+          {
+            break;
+          }
+        }
+      }
+
+      /// \brief Serialize a range of the snapshot's entities, with all their
+      /// components, into a state message. The result is the same as
+      /// EntityComponentManager::State with _full set, restricted to the
+      /// range, so a large snapshot can be serialized in bounded chunks, from
+      /// any thread.
+      /// \param[out] _state The serialized state message to populate.
+      /// \param[in] _begin Index in Entities() of the first entity.
+      /// \param[in] _end Index in Entities() past the last entity. Clamped to
+      /// the number of entities.
+      public: void State(msgs::SerializedStateMap &_state,
+                  const std::size_t _begin, const std::size_t _end) const;
+
+      /// \brief Get the number of components in the snapshot.
+      /// \return Number of components.
+      public: std::size_t ComponentCount() const;
+
+      /// \brief Get the number of components which were copied from the
+      /// manager when the snapshot was taken, as opposed to shared with the
+      /// previous snapshot.
+      /// \return Number of copied components.
+      public: std::size_t CopiedComponentCount() const;
+
+      /// \brief Only the manager fills snapshots.
+      private: friend class EntityComponentManager;
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<EntityComponentSnapshotPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
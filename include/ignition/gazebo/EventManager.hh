@@ -19,6 +19,7 @@
 
 #include <functional>
 #include <memory>
+#include <tuple>
 #include <typeinfo>
 #include <unordered_map>
 #include <utility>
@@ -68,11 +69,7 @@ namespace ignition
               ignition::common::ConnectionPtr
               Connect(const typename E::CallbackT &_subscriber)
               {
-                if (this->events.find(typeid(E)) == this->events.end()) {
-                  this->events[typeid(E)] = std::make_unique<E>();
-                }
-
-                E *eventPtr = dynamic_cast<E *>(this->events[typeid(E)].get());
+                E *eventPtr = this->EventPtr<E>();
                 // All values in the map should be derived from Event,
                 // so this shouldn't be an issue, but it doesn't hurt to check.
                 if (eventPtr != nullptr)
@@ -93,18 +90,10 @@ namespace ignition
       public: template <typename E, typename ... Args>
               void Emit(Args && ... _args)
               {
-                if (this->events.find(typeid(E)) == this->events.end())
-                {
-                  // If there are no events of type E in the map, create it.
-                  // But it also means there is nothing to signal.
-                  //
-                  // This is also needed to suppress unused function warnings
-                  // for Events that are purely emitted, with no connections.
-                  this->events[typeid(E)] = std::make_unique<E>();
-                  return;
-                }
-
-                E *eventPtr = dynamic_cast<E *>(this->events[typeid(E)].get());
+                // The event is created if it isn't in the map yet. This is
+                // also needed to suppress unused function warnings for
+                // Events that are purely emitted, with no connections.
+                E *eventPtr = this->EventPtr<E>();
                 // All values in the map should be derived from Event,
                 // so this shouldn't be an issue, but it doesn't hurt to check.
                 if (eventPtr != nullptr)
@@ -118,6 +107,106 @@ namespace ignition
                 }
               }
 
+      /// \brief Typed handle to a single event, which emits straight to
+      /// its connections without looking the event up. Resolve it once
+      /// through Channel and keep it for events emitted at high rates, such
+      /// as once per contact. A channel is valid for as long as the
+      /// EventManager which created it.
+      public: template <typename E>
+              class EventChannel
+              {
+                /// \brief Constructor of an invalid channel, which emits
+                /// nothing.
+                public: EventChannel() = default;
+
+                /// \brief Constructor
+                /// \param[in] _event Event to emit.
+                public: explicit EventChannel(E *_event)
+                        : event(_event)
+                        {
+                        }
+
+                /// \brief Whether the channel is bound to an event.
+                /// \return True if valid.
+                public: bool Valid() const
+                        {
+                          return nullptr != this->event;
+                        }
+
+                /// \brief Whether emitting would call anything. This is
+                /// cheap enough to skip building the arguments of an event
+                /// nobody listens to.
+                /// \return True if the event has connections.
+                public: bool Connected() const
+                        {
+                          return nullptr != this->event &&
+                              this->event->ConnectionCount() > 0u;
+                        }
+
+                /// \brief Emit the event to its connections.
+                /// \param[in] _args Arguments passed to the callbacks. Must
+                /// match the signature of the event type E.
+                public: template <typename ... Args>
+                        void Emit(Args && ... _args) const
+                        {
+                          if (nullptr != this->event)
+                            this->event->Signal(std::forward<Args>(_args) ...);
+                        }
+
+                /// \brief Emit the event once per element of a range, for
+                /// example once per contact of a physics step. Connections
+                /// are only checked once for the whole batch.
+                /// \param[in] _begin First element. Each element is a tuple
+                /// holding the arguments of one emission, which are passed
+                /// to the callbacks as lvalues, so callbacks may modify
+                /// arguments taken by reference.
+                /// \param[in] _end One past the last element.
+                public: template <typename Iterator>
+                        void EmitBatch(Iterator _begin, Iterator _end) const
+                        {
+                          if (!this->Connected())
+                            return;
+
+                          for (auto it = _begin; it != _end; ++it)
+                          {
+                            std::apply([this](auto && ... _args)
+                            {
+                              this->event->Signal(_args ...);
+                            }, *it);
+                          }
+                        }
+
+                /// \brief Event to emit, owned by the EventManager.
+                private: E *event{nullptr};
+              };
+
+      /// \brief Get a typed handle to an event, creating the event if
+      /// needed.
+      /// \return Channel of event E, which is invalid if the event with the
+      /// same type in the manager isn't an E.
+      public: template <typename E>
+              EventChannel<E> Channel()
+              {
+                E *eventPtr = this->EventPtr<E>();
+                if (nullptr == eventPtr)
+                {
+                  ignerr << "Failed to get channel of event: "
+                    << typeid(E).name() << std::endl;
+                }
+                return EventChannel<E>(eventPtr);
+              }
+
+      /// \brief Get an event, creating it if it isn't in the map yet.
+      /// \return Pointer to the event, or nullptr if the event in the map
+      /// isn't an E.
+      private: template <typename E>
+               E *EventPtr()
+               {
+                 auto &event = this->events[typeid(E)];
+                 if (!event)
+                   event = std::make_unique<E>();
+                 return dynamic_cast<E *>(event.get());
+               }
 
       /// \brief Convenience type for storing typeinfo references.
       private: using TypeInfoRef = std::reference_wrapper<const std::type_info>;
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_MESHCACHE_HH_
+#define IGNITION_GAZEBO_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/common/Mesh.hh>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Environment variable holding the directory of the mesh cache.
+    /// Defaults to `${IGN_HOMEDIR}/.ignition/gazebo/mesh_cache`. Setting it
+    /// to `0` disables the cache.
+    const std::string kMeshCachePathEnv{"IGN_GAZEBO_MESH_CACHE_PATH"};
+
+    /// \brief Load a mesh file through common::MeshManager, going through
+    /// an on-disk cache of binary meshes.
+    ///
+    /// The first time a mesh file is loaded, it's parsed by the mesh
+    /// manager and a binary copy is written to the cache, keyed by a hash
+    /// of the file's contents. Later loads, including loads by other
+    /// processes, map the binary copy instead of parsing the file. Editing
+    /// or moving the file changes its hash, so stale copies are never used.
+    /// Copies aren't deleted, so the cache directory can be cleared
+    /// whenever needed.
+    ///
+    /// Either way, the mesh is added to the mesh manager under _fullPath, so
+    /// later calls to common::MeshManager::Load with the same path return
+    /// it without going to disk.
+    ///
+    /// Meshes with skeletons or PBR materials aren't cached, and are always
+    /// parsed.
+    /// \param[in] _fullPath Absolute path to the mesh file.
+    /// \return The mesh, owned by the mesh manager, or nullptr if it
+    /// couldn't be loaded.
+    IGNITION_GAZEBO_VISIBLE
+    const common::Mesh *loadCachedMesh(const std::string &_fullPath);
+
+    /// \brief Hash a mesh file. The hash covers the directory of the file,
+    /// because textures are resolved relative to it, and the version of the
+    /// cache layout, so caches written by other versions don't match.
+    /// \param[in] _fullPath Absolute path to the mesh file.
+    /// \param[in] _contents Contents of the mesh file.
+    /// \return Hash of the file.
+    IGNITION_GAZEBO_VISIBLE
+    uint64_t meshCacheHash(const std::string &_fullPath,
+        const std::string &_contents);
+
+    /// \brief Check whether a mesh can be written to the cache.
+    /// \param[in] _mesh Mesh to check.
+    /// \return False if the mesh has a skeleton, skinned vertices, missing
+    /// materials or PBR materials, which aren't stored.
+    IGNITION_GAZEBO_VISIBLE
+    bool isMeshCacheable(const common::Mesh &_mesh);
+
+    /// \brief Write a mesh cache file. The file is replaced atomically, so
+    /// readers never see a partial cache.
+    /// \param[in] _path Path to the cache file.
+    /// \param[in] _mesh Mesh to write, see isMeshCacheable.
+    /// \param[in] _sourceHash Hash of the mesh file, from meshCacheHash.
+    /// \return True if the file was written.
+    IGNITION_GAZEBO_VISIBLE
+    bool saveMeshCache(const std::string &_path, const common::Mesh &_mesh,
+        uint64_t _sourceHash);
+
+    /// \brief Read a mesh cache file. The file is memory mapped where
+    /// supported.
+    /// \param[in] _path Path to the cache file.
+    /// \param[in] _sourceHash Expected hash of the mesh file, from
+    /// meshCacheHash.
+    /// \return The mesh, or nullptr if the file doesn't exist, is invalid or
+    /// was written for another source.
+    IGNITION_GAZEBO_VISIBLE
+    std::unique_ptr<common::Mesh> loadMeshCache(const std::string &_path,
+        uint64_t _sourceHash);
+    }
+  }
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_POSESTREAMCODEC_HH_
+#define IGNITION_GAZEBO_POSESTREAMCODEC_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN PoseStreamEncoderPrivate;
+    class IGNITION_GAZEBO_HIDDEN PoseStreamDecoderPrivate;
+
+    /// \brief Pose of an entity, as carried by a pose stream.
+    using EntityPose = std::pair<Entity, math::Pose3d>;
+
+    /// \brief Options of a quantized pose stream.
+    struct PoseStreamOptions
+    {
+      /// \brief Resolution of positions, in meters.
+      double positionResolution{1e-4};
+
+      /// \brief Number of frames between keyframes, including the keyframe.
+      /// One makes every frame a keyframe.
+      unsigned int keyframeInterval{60u};
+    };
+
+    /// \class PoseStreamEncoder PoseStreamCodec.hh
+    /// ignition/gazebo/PoseStreamCodec.hh
+    /// \brief Encodes a stream of entity poses in a compact binary format,
+    /// meant for links with little bandwidth.
+    ///
+    /// Positions are quantized to a fixed resolution and orientations are
+    /// stored as their three smallest quaternion components, quantized to
+    /// 16 bits. Every few frames a keyframe holds the quantized poses of all
+    /// entities; the frames in between only hold the difference of each
+    /// pose to the keyframe, which is small for entities that move slowly
+    /// and is stored as a variable length integer. Since frames don't depend
+    /// on each other, only on their keyframe, a dropped frame doesn't affect
+    /// the following ones.
+    ///
+    /// Entity names aren't part of the stream, entities are only identified
+    /// by their id.
+    class IGNITION_GAZEBO_VISIBLE PoseStreamEncoder
+    {
+      /// \brief Constructor
+      /// \param[in] _options Stream options.
+      public: explicit PoseStreamEncoder(
+                  const PoseStreamOptions &_options = PoseStreamOptions());
+
+      /// \brief Destructor
+      public: ~PoseStreamEncoder();
+
+      /// \brief Get the stream options.
+      /// \return Options.
+      public: const PoseStreamOptions &Options() const;
+
+      /// \brief Encode a frame.
+      /// \param[in] _poses Poses of the frame.
+      /// \param[in] _simTime Simulation time of the frame.
+      /// \param[out] _buffer Buffer which will hold the encoded frame. Its
+      /// previous contents are replaced.
+      /// \return True if the frame is a keyframe.
+      public: bool Encode(const std::vector<EntityPose> &_poses,
+                  const std::chrono::steady_clock::duration &_simTime,
+                  std::string &_buffer);
+
+      /// \brief Make the next encoded frame a keyframe, for example because a
+      /// new decoder joined the stream.
+      public: void RequestKeyframe();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseStreamEncoderPrivate> dataPtr;
+    };
+
+    /// \class PoseStreamDecoder PoseStreamCodec.hh
+    /// ignition/gazebo/PoseStreamCodec.hh
+    /// \brief Decodes frames produced by a PoseStreamEncoder.
+    class IGNITION_GAZEBO_VISIBLE PoseStreamDecoder
+    {
+      /// \brief Constructor
+      public: PoseStreamDecoder();
+
+      /// \brief Destructor
+      public: ~PoseStreamDecoder();
+
+      /// \brief Decode a frame.
+      /// \param[in] _buffer Encoded frame.
+      /// \param[out] _simTime Simulation time of the frame.
+      /// \param[out] _poses Poses of the frame. Its previous contents are
+      /// replaced.
+      /// \return False if the frame is malformed, or if it refers to a
+      /// keyframe which wasn't decoded, as happens until the first keyframe
+      /// is received.
+      public: bool Decode(const std::string &_buffer,
+                  std::chrono::steady_clock::duration &_simTime,
+                  std::vector<EntityPose> &_poses);
+
+      /// \brief Get whether a keyframe has been decoded, so that the
+      /// following frames can be decoded.
+      /// \return True if a keyframe has been decoded.
+      public: bool HasKeyframe() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseStreamDecoderPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_PROFILER_HH_
+#define IGNITION_GAZEBO_PROFILER_HH_
+
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gazebo/AllocationTracker.hh"
+#include "ignition/gazebo/Tracer.hh"
+
+/// \file
+/// \brief Tracing macros which feed the built-in ignition::gazebo::Tracer,
+/// and the ignition::gazebo::AllocationTracker when it's compiled in, on top
+/// of the ignition-common profiler. Each GZ_TRACE macro also expands to its
+/// IGN_PROFILE counterpart, so samples are still sent to the ignition-common
+/// profiler when it's enabled at compile time.
+
+#define IGN_GAZEBO_TRACER_CONCAT_IMPL(a, b) a##b
+#define IGN_GAZEBO_TRACER_CONCAT(a, b) IGN_GAZEBO_TRACER_CONCAT_IMPL(a, b)
+
+/// \brief Trace the rest of the current scope.
+#define GZ_TRACE(name) \
+  IGN_PROFILE(name); \
+  IGN_GAZEBO_ALLOCATION_SCOPE(name); \
+  ::ignition::gazebo::Tracer::Scope \
+      IGN_GAZEBO_TRACER_CONCAT(ignGazeboTracerScope, __LINE__)(name)
+
+/// \brief Start a sample, finished by GZ_TRACE_END.
+#define GZ_TRACE_BEGIN(name) \
+  IGN_PROFILE_BEGIN(name); \
+  ::ignition::gazebo::Tracer::Instance().Begin(name)
+
+/// \brief Finish the last sample started by GZ_TRACE_BEGIN.
+#define GZ_TRACE_END() \
+  IGN_PROFILE_END(); \
+  ::ignition::gazebo::Tracer::Instance().End()
+
+/// \brief Name the current thread.
+#define GZ_TRACE_THREAD_NAME(name) \
+  IGN_PROFILE_THREAD_NAME(name); \
+  ::ignition::gazebo::Tracer::Instance().SetThreadName(name)
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_QUERYFILTERS_HH_
+#define IGNITION_GAZEBO_QUERYFILTERS_HH_
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Types.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Query filter which only matches entities that don't have a
+    /// component of the given type. It can be listed with the component
+    /// types of EntityComponentManager::Each and related functions, and
+    /// doesn't add a parameter to the callback. For example, this visits all
+    /// links which aren't static:
+    ///
+    ///   _ecm.Each<components::Link, components::Pose,
+    ///       Without<components::Static>>(
+    ///     [&](const Entity &_entity, const components::Link *_link,
+    ///         const components::Pose *_pose) -> bool
+    ///     {
+    ///       return true;
+    ///     });
+    ///
+    /// \tparam ComponentTypeT Type of the excluded component.
+    template<typename ComponentTypeT>
+    struct Without
+    {
+    };
+
+    /// \brief Query filter which matches entities whether or not they have a
+    /// component of the given type. The callback is passed a pointer to the
+    /// component, which is null if the entity doesn't have it. For example,
+    /// this visits all links, with their velocity if they have one:
+    ///
+    ///   _ecm.Each<components::Link, Optional<components::LinearVelocity>>(
+    ///     [&](const Entity &_entity, const components::Link *_link,
+    ///         const components::LinearVelocity *_vel) -> bool
+    ///     {
+    ///       return true;
+    ///     });
+    ///
+    /// \tparam ComponentTypeT Type of the optional component.
+    template<typename ComponentTypeT>
+    struct Optional
+    {
+    };
+
+    namespace detail
+    {
+    /// \brief Marker which precedes an excluded type in a view key.
+    constexpr ComponentTypeId kViewKeyWithout{
+        std::numeric_limits<ComponentTypeId>::max()};
+
+    /// \brief Marker which precedes an optional type in a view key.
+    constexpr ComponentTypeId kViewKeyOptional{
+        std::numeric_limits<ComponentTypeId>::max() - 1u};
+
+    /// \brief Traits of one of the types listed in a query, which is a
+    /// required component unless it's wrapped in Without or Optional.
+    /// \tparam T Listed type.
+    template<typename T>
+    struct QueryTerm
+    {
+      /// \brief Component type.
+      using ComponentType = T;
+
+      /// \brief True if entities must not have the component.
+      static constexpr bool kExcluded{false};
+
+      /// \brief True if entities may or may not have the component.
+      static constexpr bool kOptional{false};
+    };
+
+    /// \brief Traits of an excluded component.
+    /// \tparam T Component type.
+    template<typename T>
+    struct QueryTerm<Without<T>>
+    {
+      /// \brief Component type.
+      using ComponentType = T;
+
+      /// \brief True if entities must not have the component.
+      static constexpr bool kExcluded{true};
+
+      /// \brief True if entities may or may not have the component.
+      static constexpr bool kOptional{false};
+    };
+
+    /// \brief Traits of an optional component.
+    /// \tparam T Component type.
+    template<typename T>
+    struct QueryTerm<Optional<T>>
+    {
+      /// \brief Component type.
+      using ComponentType = T;
+
+      /// \brief True if entities must not have the component.
+      static constexpr bool kExcluded{false};
+
+      /// \brief True if entities may or may not have the component.
+      static constexpr bool kOptional{true};
+    };
+
+    /// \brief Tuple of the component types passed to the callback of a
+    /// query, which are all the listed types except excluded ones, in the
+    /// order they're listed.
+    /// \tparam Ts Listed types.
+    template<typename ...Ts>
+    using QueryComponents = decltype(std::tuple_cat(std::declval<
+        std::conditional_t<QueryTerm<Ts>::kExcluded, std::tuple<>,
+        std::tuple<typename QueryTerm<Ts>::ComponentType>>>()...));
+
+    /// \brief Helper to build the callback type of a query.
+    /// \tparam Tuple Tuple of the component types passed to the callback.
+    /// \tparam Const True if the components are passed as const.
+    template<typename Tuple, bool Const>
+    struct QueryCallbackImpl;
+
+    /// \brief Callback with const components.
+    /// \tparam Cs Component types passed to the callback.
+    template<typename ...Cs>
+    struct QueryCallbackImpl<std::tuple<Cs...>, true>
+    {
+      /// \brief Callback type.
+      using type = std::function<bool(const Entity &, const Cs *...)>;
+    };
+
+    /// \brief Callback with mutable components.
+    /// \tparam Cs Component types passed to the callback.
+    template<typename ...Cs>
+    struct QueryCallbackImpl<std::tuple<Cs...>, false>
+    {
+      /// \brief Callback type.
+      using type = std::function<bool(const Entity &, Cs *...)>;
+    };
+
+    /// \brief Callback type of a query. Without filters, this is a function
+    /// taking the entity followed by a pointer to each listed component.
+    /// \tparam Const True if the components are passed as const.
+    /// \tparam Ts Listed types.
+    template<bool Const, typename ...Ts>
+    using QueryCallback =
+        typename QueryCallbackImpl<QueryComponents<Ts...>, Const>::type;
+
+    /// \brief Number of required components of a query.
+    /// \tparam Ts Listed types.
+    template<typename ...Ts>
+    constexpr std::size_t kQueryRequiredCount{
+        (std::size_t{0} + ... + ((QueryTerm<Ts>::kExcluded ||
+                                  QueryTerm<Ts>::kOptional) ? 0u : 1u))};
+
+    /// \brief Get the key of the view which holds the entities matching a
+    /// query. Without filters, this is the list of component type ids.
+    /// \tparam Ts Listed types.
+    /// \return View key.
+    template<typename ...Ts>
+    std::vector<ComponentTypeId> QueryViewKey()
+    {
+      std::vector<ComponentTypeId> key;
+      key.reserve(sizeof...(Ts) * 2u);
+      auto append = [&key](const bool _excluded, const bool _optional,
+          const ComponentTypeId _typeId)
+      {
+        if (_excluded)
+          key.push_back(kViewKeyWithout);
+        else if (_optional)
+          key.push_back(kViewKeyOptional);
+        key.push_back(_typeId);
+      };
+      (append(QueryTerm<Ts>::kExcluded, QueryTerm<Ts>::kOptional,
+          QueryTerm<Ts>::ComponentType::typeId), ...);
+      return key;
+    }
+
+    /// \brief Get the type ids of the components passed to the callback of
+    /// a query.
+    /// \tparam Ts Listed types.
+    /// \return Component type ids, in the order they're listed.
+    template<typename ...Ts>
+    std::vector<ComponentTypeId> QueryComponentTypeIds()
+    {
+      std::vector<ComponentTypeId> ids;
+      ids.reserve(sizeof...(Ts));
+      ((QueryTerm<Ts>::kExcluded ? void() :
+          ids.push_back(QueryTerm<Ts>::ComponentType::typeId)), ...);
+      return ids;
+    }
+
+    /// \brief Get the required, excluded and optional component types of a
+    /// query.
+    /// \tparam Ts Listed types.
+    /// \param[out] _required Required component types.
+    /// \param[out] _excluded Excluded component types.
+    /// \param[out] _optional Optional component types.
+    template<typename ...Ts>
+    void QueryComponentSets(std::set<ComponentTypeId> &_required,
+        std::set<ComponentTypeId> &_excluded,
+        std::set<ComponentTypeId> &_optional)
+    {
+      auto insert = [&](const bool _isExcluded, const bool _isOptional,
+          const ComponentTypeId _typeId)
+      {
+        if (_isExcluded)
+          _excluded.insert(_typeId);
+        else if (_isOptional)
+          _optional.insert(_typeId);
+        else
+          _required.insert(_typeId);
+      };
+      (insert(QueryTerm<Ts>::kExcluded, QueryTerm<Ts>::kOptional,
+          QueryTerm<Ts>::ComponentType::typeId), ...);
+    }
+    }  // namespace detail
+    }
+  }
+}
+#endif
@@ -18,6 +18,9 @@
 #define IGNITION_GAZEBO_CREATEREMOVE_HH_
 
 #include <memory>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
 
 #include <sdf/Actor.hh>
 #include <sdf/Collision.hh>
@@ -155,6 +158,29 @@ namespace ignition
       /// \sa CreateEntities(const sdf::Link *)
       public: Entity CreateEntities(const sdf::ParticleEmitter *_emitter);
 
+      /// \brief Build the entities of a model once, in a manager owned by
+      /// this creator, so that they can be used as a template by
+      /// CreateFromTemplate. This is useful for models which are spawned many
+      /// times, such as breadcrumbs, since copies of the template don't go
+      /// through the SDF DOM. The template entities aren't simulated.
+      /// \param[in] _model SDF model object.
+      /// \return Id of the template.
+      public: std::size_t CreateTemplate(const sdf::Model *_model);
+
+      /// \brief Create a copy of a template built by CreateTemplate. The
+      /// components of the copy are copied straight from the template, which
+      /// is much faster than calling CreateEntities with the same model. The
+      /// plugins of the model are loaded for each copy, as with
+      /// CreateEntities.
+      /// \param[in] _template Id returned by CreateTemplate.
+      /// \param[in] _name Name of the copied model.
+      /// \param[in] _pose Pose of the copied model, which replaces the pose
+      /// of the template.
+      /// \return Model entity, which has no parent, or kNullEntity if
+      /// _template isn't a valid id.
+      public: Entity CreateFromTemplate(std::size_t _template,
+                  const std::string &_name, const math::Pose3d &_pose);
+
       /// \brief Request an entity deletion. This will insert the request
       /// into a queue. The queue is processed toward the end of a simulation
       /// update step.
@@ -179,6 +205,14 @@ namespace ignition
       private: Entity CreateEntities(const sdf::Model *_model,
                                      bool _staticParent);
 
+      /// \brief Create the entities of all models of a world. Each model is
+      /// built concurrently in a separate manager, and then all models are
+      /// copied into the manager in one batch.
+      /// \param[in] _world SDF world object.
+      /// \param[in] _worldEntity World entity, parent of the models.
+      private: void CreateModelsInParallel(const sdf::World *_world,
+                   Entity _worldEntity);
+
       /// \brief Pointer to private data.
       private: std::unique_ptr<SdfEntityCreatorPrivate> dataPtr;
     };
@@ -17,7 +17,10 @@
 #ifndef IGNITION_GAZEBO_SERVER_HH_
 #define IGNITION_GAZEBO_SERVER_HH_
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -93,6 +96,14 @@ namespace ignition
     ///         ignition::msgs::Boolean
     ///     + Control the simulation server.
     ///
+    ///   5. `/gazebo/trace`(ignition::msgs::Param) :
+    ///         ignition::msgs::StringMsg
+    ///     + Start or stop the built-in tracer, see Tracer. The `enable`
+    ///       boolean parameter starts or stops it. When starting, the
+    ///       optional `path` string sets the trace file and the optional
+    ///       `duration` double stops the tracer after that many seconds.
+    ///       Returns the path of the trace file when starting.
+    ///
     /// ## Topics
     ///
     /// The following are topics provided by the Server.
@@ -158,6 +169,76 @@ namespace ignition
       /// not being initialized, or if the server is already running.
       public: bool RunOnce(const bool _paused = true);
 
+      /// \brief Step a single world, leaving the other worlds untouched. This
+      /// is a blocking call, meant for applications that drive many
+      /// instances of a world independently, see
+      /// ServerConfig::SetWorldInstances. The world is unpaused.
+      /// \param[in] _iterations Number of steps to perform, at least 1.
+      /// \param[in] _worldIndex Index of the world to step.
+      /// \return True if the world completed the steps, false if the server
+      /// or the world is already running, or std::nullopt if _worldIndex is
+      /// invalid.
+      public: std::optional<bool> Step(const uint64_t _iterations = 1,
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Step all worlds, each by the same number of iterations. The
+      /// worlds are stepped concurrently on the thread pool they share. This
+      /// is a blocking call. All worlds are unpaused.
+      /// \param[in] _iterations Number of steps to perform, at least 1.
+      /// \return True if all worlds completed the steps, false if the server
+      /// or any of the worlds is already running.
+      public: bool StepAll(const uint64_t _iterations = 1);
+
+      /// \brief Step a single world without blocking, for applications that
+      /// interleave simulation with other work, such as a co-simulation
+      /// master. Requests are run in order on a single background thread,
+      /// so a request for a world which is still stepping waits for it
+      /// instead of failing. The world is unpaused.
+      /// \param[in] _iterations Number of steps to perform, at least 1.
+      /// \param[in] _worldIndex Index of the world to step.
+      /// \return Future holding the same result as Step, with false if
+      /// _worldIndex is invalid, or if the server is destroyed before the
+      /// request is run.
+      public: std::future<bool> StepAsync(const uint64_t _iterations = 1,
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Step a single world without blocking, calling a function
+      /// once done. See StepAsync above.
+      /// \param[in] _iterations Number of steps to perform, at least 1.
+      /// \param[in] _done Function called from the background thread with
+      /// the result of the steps. It must not destroy the server.
+      /// \param[in] _worldIndex Index of the world to step.
+      /// \return False if _worldIndex is invalid, in which case _done isn't
+      /// called.
+      public: bool StepAsync(const uint64_t _iterations,
+                  const std::function<void(bool)> &_done,
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Set functions called on every iteration of a world, so that
+      /// an application can exchange data with simulation on each step
+      /// without writing a system. The functions are called from the thread
+      /// stepping the world, before and after its systems update, however
+      /// the world is run. Calling this again replaces both functions.
+      /// \param[in] _input Function called on PreUpdate, which can modify
+      /// the entity component manager, for example to apply inputs. May be
+      /// empty.
+      /// \param[in] _output Function called on PostUpdate, for example to
+      /// read outputs. May be empty.
+      /// \param[in] _worldIndex Index of the world.
+      /// \return False if _worldIndex is invalid.
+      public: bool SetStepHooks(
+                  const std::function<void(const UpdateInfo &,
+                      EntityComponentManager &)> &_input,
+                  const std::function<void(const UpdateInfo &,
+                      const EntityComponentManager &)> &_output,
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Get the number of worlds on the server, including the extra
+      /// instances requested through ServerConfig::SetWorldInstances.
+      /// \return Number of worlds. Valid world indices are in the range
+      /// [0, WorldCount()).
+      public: std::size_t WorldCount() const;
+
       /// \brief Get whether the server is running. The server can have zero
       /// or more simulation worlds, each of which may or may not be
       /// running. See Running(const unsigned int) to get the running status
@@ -207,6 +288,40 @@ namespace ignition
       public: std::optional<size_t> EntityCount(
                   const unsigned int _worldIndex = 0) const;
 
+      /// \brief Save the state of a world in memory, to reset the world to
+      /// it later through Restore. This is much faster than reloading the
+      /// world or setting a serialized state: components are kept as
+      /// copy-on-write copies, so consecutive checkpoints share the
+      /// components which didn't change in between. If the world is
+      /// running, the checkpoint is taken at the end of the current
+      /// iteration.
+      /// \param[in] _worldIndex Index of the world.
+      /// \return Id of the checkpoint, or std::nullopt if _worldIndex is
+      /// invalid.
+      public: std::optional<uint64_t> Checkpoint(
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Reset a world to a checkpoint: entities, components and
+      /// simulation time go back to what they were when the checkpoint was
+      /// taken, and systems implementing ISystemReset, such as physics, are
+      /// told to bring their own state in line. If the world is running, the
+      /// reset happens at the end of the current iteration. A checkpoint can
+      /// be restored any number of times.
+      /// \param[in] _id Id returned by Checkpoint.
+      /// \param[in] _worldIndex Index of the world.
+      /// \return False if _worldIndex is invalid or if the world has no
+      /// checkpoint with that id.
+      public: bool Restore(const uint64_t _id,
+                  const unsigned int _worldIndex = 0);
+
+      /// \brief Release the memory held by a checkpoint.
+      /// \param[in] _id Id returned by Checkpoint.
+      /// \param[in] _worldIndex Index of the world.
+      /// \return False if _worldIndex is invalid or if the world has no
+      /// checkpoint with that id.
+      public: bool RemoveCheckpoint(const uint64_t _id,
+                  const unsigned int _worldIndex = 0);
+
       /// \brief Get the number of systems on the server.
       /// \param[in] _worldIndex Index of the world to query.
       /// \return System count, or std::nullopt if _worldIndex is invalid.
@@ -18,6 +18,7 @@
 #define IGNITION_GAZEBO_SERVERCONFIG_HH_
 
 #include <chrono>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <optional> // NOLINT(*)
@@ -60,6 +61,26 @@ namespace ignition
         kSdfString,
       };
 
+      /// \brief Group of threads run by the server, which can be restricted
+      /// to a set of CPU cores.
+      /// \sa SetThreadAffinity
+      public: enum class ThreadGroup
+      {
+        /// \brief The thread which runs the simulation loop and the
+        /// PreUpdate and Update of systems.
+        kSimulation,
+
+        /// \brief The threads which run the PostUpdate of systems.
+        kPostUpdate,
+
+        /// \brief The threads of the pool used to run parallel work, such
+        /// as the parallel stages of each step.
+        kWorkers,
+
+        /// \brief The thread which renders sensors.
+        kRendering,
+      };
+
 
       class PluginInfoPrivate;
       /// \brief Information about a plugin that should be loaded by the
@@ -358,6 +379,110 @@ namespace ignition
       /// \param[in] _seed The seed.
       public: void SetSeed(unsigned int _seed);
 
+      /// \brief Get the number of times threads waiting on the step loop
+      /// barriers poll before blocking.
+      /// \return Spin count. Zero, the default, blocks right away.
+      public: unsigned int BarrierSpinCount() const;
+
+      /// \brief Set the number of times threads waiting on the step loop
+      /// barriers poll before blocking. Spinning lowers the latency of each
+      /// step at high update rates, at the cost of burning CPU time while
+      /// waiting, so it's best used when there's a core for each thread.
+      /// \param[in] _spinCount Spin count. Zero blocks right away.
+      public: void SetBarrierSpinCount(unsigned int _spinCount);
+
+      /// \brief Get the CPU cores a group of threads is restricted to.
+      /// \param[in] _group Thread group.
+      /// \return Core numbers, empty if the group isn't restricted.
+      /// \sa SetThreadAffinity
+      public: const std::vector<unsigned int> &ThreadAffinity(
+                  ThreadGroup _group) const;
+
+      /// \brief Restrict a group of threads to a set of CPU cores, so that
+      /// they don't migrate between cores and compete with each other.
+      /// On machines with multiple NUMA nodes, keeping the simulation thread
+      /// on the cores of one node also keeps the entity data, which is
+      /// created by that thread, on that node's memory. Only supported on
+      /// Linux.
+      ///
+      /// When the workers are restricted, their pool has one worker thread
+      /// per core, besides the thread which runs each parallel loop.
+      /// Groups without cores of their own aren't restricted, even when
+      /// their threads are started by a restricted thread.
+      /// \param[in] _group Thread group.
+      /// \param[in] _cores Core numbers. Empty lets the threads run on any
+      /// core, which is the default.
+      public: void SetThreadAffinity(ThreadGroup _group,
+                  const std::vector<unsigned int> &_cores);
+
+      /// \brief Get whether the server runs in throughput mode.
+      /// \return True if throughput mode is enabled.
+      /// \sa SetThroughputMode
+      public: bool ThroughputMode() const;
+
+      /// \brief Set whether the server runs in throughput mode, for batch
+      /// runs that step as fast as possible. In this mode:
+      /// * The simulation never sleeps to match the real time factor.
+      /// * World statistics and clock messages are only published, and world
+      ///   control requests and GUI state updates are only processed, once
+      ///   every ThroughputInterval iterations.
+      /// Systems still run on every iteration, so that none of them misses
+      /// entities being created or removed. Publishers such as the scene
+      /// broadcaster throttle their own messages.
+      /// \param[in] _throughput True to enable throughput mode.
+      public: void SetThroughputMode(bool _throughput);
+
+      /// \brief Get the number of iterations between periodic work in
+      /// throughput mode.
+      /// \return Number of iterations, 1000 by default.
+      public: uint64_t ThroughputInterval() const;
+
+      /// \brief Set the number of iterations between periodic work in
+      /// throughput mode.
+      /// \param[in] _iterations Number of iterations, at least 1.
+      public: void SetThroughputInterval(uint64_t _iterations);
+
+      /// \brief Get the number of independent instances created for each
+      /// world in the SDF.
+      /// \return Number of instances, 1 by default.
+      public: unsigned int WorldInstances() const;
+
+      /// \brief Set the number of independent instances created for each
+      /// world in the SDF. Each instance has its own entity component
+      /// manager, systems and transport topics, but all instances share the
+      /// parsed SDF, the loaded plugin libraries and a single thread pool.
+      /// The first instance keeps the world's name, later instances are
+      /// named "<world>_<instance>". Instances can be stepped individually
+      /// with Server::Step, or all at once with Server::StepAll.
+      /// \param[in] _instances Number of instances, at least 1.
+      public: void SetWorldInstances(unsigned int _instances);
+
+      /// \brief Get the path to the world cache file.
+      /// \return Path to the cache file, empty if no cache is used.
+      public: const std::string &WorldCache() const;
+
+      /// \brief Set the path to a world cache file. If the file holds a
+      /// world generated from the same SDF file or string, the server loads
+      /// that world instead, which has all includes expanded and all
+      /// resources resolved to local paths, so neither included models nor
+      /// Fuel need to be looked up. Otherwise the server loads the SDF as
+      /// usual and writes the cache file once the world has been created.
+      /// Only single-world SDFs are cached.
+      /// \param[in] _path Path to the cache file, empty to disable the
+      /// cache.
+      public: void SetWorldCache(const std::string &_path);
+
+      /// \brief Get the path to the startup trace file.
+      /// \return Path to the trace file, empty if no file is written.
+      public: const std::string &StartupTracePath() const;
+
+      /// \brief Set the path to a JSON file where the timeline of the server
+      /// startup is written once the first simulation step is done. See
+      /// StartupTrace for its contents. A summary of the timeline is always
+      /// printed at debug level.
+      /// \param[in] _path Path to the trace file, empty to not write one.
+      public: void SetStartupTracePath(const std::string &_path);
+
       /// \brief Get the update period duration.
       /// \return The desired update period, or nullopt if
       /// an UpdateRate has not been set.
@@ -0,0 +1,643 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SMALLVECTOR_HH_
+#define IGNITION_GAZEBO_SMALLVECTOR_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class SmallVector SmallVector.hh ignition/gazebo/SmallVector.hh
+    /// \brief A sequence container with the interface of std::vector which
+    /// holds up to N elements inline, without allocating. Larger sizes move
+    /// the elements to the heap.
+    ///
+    /// It converts implicitly from and to std::vector, so that it can be
+    /// used where a std::vector was used before, at the cost of a copy.
+    /// Iterators and references are invalidated whenever the capacity
+    /// changes, and by moves of inline containers.
+    /// \tparam T Element type, which must be trivially copyable.
+    /// \tparam N Number of elements held inline.
+    template<typename T, std::size_t N>
+    class SmallVector
+    {
+      static_assert(std::is_trivially_copyable_v<T>,
+          "SmallVector only holds trivially copyable types");
+      static_assert(N > 0, "SmallVector must hold at least one element");
+
+      /// \brief Category of an iterator, which only exists for iterators.
+      private: template<typename It>
+               using IteratorCategory =
+                   typename std::iterator_traits<It>::iterator_category;
+
+      /// \brief Element type.
+      public: using value_type = T;
+
+      /// \brief Size type.
+      public: using size_type = std::size_t;
+
+      /// \brief Difference type.
+      public: using difference_type = std::ptrdiff_t;
+
+      /// \brief Reference type.
+      public: using reference = T &;
+
+      /// \brief Const reference type.
+      public: using const_reference = const T &;
+
+      /// \brief Pointer type.
+      public: using pointer = T *;
+
+      /// \brief Const pointer type.
+      public: using const_pointer = const T *;
+
+      /// \brief Iterator type.
+      public: using iterator = T *;
+
+      /// \brief Const iterator type.
+      public: using const_iterator = const T *;
+
+      /// \brief Reverse iterator type.
+      public: using reverse_iterator = std::reverse_iterator<iterator>;
+
+      /// \brief Const reverse iterator type.
+      public: using const_reverse_iterator =
+          std::reverse_iterator<const_iterator>;
+
+      /// \brief Constructor of an empty container.
+      public: SmallVector() = default;
+
+      /// \brief Constructor with _count copies of a value.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _value Value of the elements.
+      public: explicit SmallVector(const size_type _count,
+                  const T &_value = T())
+      {
+        this->assign(_count, _value);
+      }
+
+      /// \brief Constructor from a list of values.
+      /// \param[in] _values Values.
+      public: SmallVector(std::initializer_list<T> _values)
+      {
+        this->assign(_values.begin(), _values.end());
+      }
+
+      /// \brief Constructor from a range of values.
+      /// \param[in] _first Iterator to the first value.
+      /// \param[in] _last Iterator past the last value.
+      public: template<typename InputIt, typename = IteratorCategory<InputIt>>
+              SmallVector(InputIt _first, InputIt _last)
+      {
+        this->assign(_first, _last);
+      }
+
+      /// \brief Constructor from a std::vector.
+      /// \param[in] _values Values.
+      // cppcheck-suppress noExplicitConstructor
+      public: SmallVector(const std::vector<T> &_values)  // NOLINT
+      {
+        this->assign(_values.begin(), _values.end());
+      }
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Container to copy.
+      public: SmallVector(const SmallVector &_other)
+      {
+        this->assign(_other.begin(), _other.end());
+      }
+
+      /// \brief Move constructor. Heap storage is taken over, while inline
+      /// elements are copied.
+      /// \param[in] _other Container to move. It's left empty.
+      public: SmallVector(SmallVector &&_other) noexcept
+      {
+        this->Take(_other);
+      }
+
+      /// \brief Copy assignment.
+      /// \param[in] _other Container to copy.
+      /// \return Reference to this.
+      public: SmallVector &operator=(const SmallVector &_other)
+      {
+        if (this != &_other)
+          this->assign(_other.begin(), _other.end());
+        return *this;
+      }
+
+      /// \brief Move assignment.
+      /// \param[in] _other Container to move. It's left empty.
+      /// \return Reference to this.
+      public: SmallVector &operator=(SmallVector &&_other) noexcept
+      {
+        if (this != &_other)
+        {
+          this->heap.reset();
+          this->capacityValue = N;
+          this->Take(_other);
+        }
+        return *this;
+      }
+
+      /// \brief Assignment from a list of values.
+      /// \param[in] _values Values.
+      /// \return Reference to this.
+      public: SmallVector &operator=(std::initializer_list<T> _values)
+      {
+        this->assign(_values.begin(), _values.end());
+        return *this;
+      }
+
+      /// \brief Assignment from a std::vector.
+      /// \param[in] _values Values.
+      /// \return Reference to this.
+      public: SmallVector &operator=(const std::vector<T> &_values)
+      {
+        this->assign(_values.begin(), _values.end());
+        return *this;
+      }
+
+      /// \brief Convert to a std::vector.
+      /// \return Copy of the elements.
+      public: operator std::vector<T>() const  // NOLINT
+      {
+        return std::vector<T>(this->begin(), this->end());
+      }
+
+      /// \brief Replace the contents with _count copies of a value.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _value Value of the elements.
+      public: void assign(const size_type _count, const T &_value)
+      {
+        this->Grow(_count);
+        std::fill_n(this->data(), _count, _value);
+        this->sizeValue = _count;
+      }
+
+      /// \brief Replace the contents with a range of values.
+      /// \param[in] _first Iterator to the first value.
+      /// \param[in] _last Iterator past the last value.
+      public: template<typename InputIt, typename = IteratorCategory<InputIt>>
+              void assign(InputIt _first, InputIt _last)
+      {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+            IteratorCategory<InputIt>>)
+        {
+          const auto count =
+              static_cast<size_type>(std::distance(_first, _last));
+          this->Grow(count);
+          std::copy(_first, _last, this->data());
+          this->sizeValue = count;
+        }
+        else
+        {
+          this->clear();
+          for (; _first != _last; ++_first)
+            this->push_back(*_first);
+        }
+      }
+
+      /// \brief Replace the contents with a list of values.
+      /// \param[in] _values Values.
+      public: void assign(std::initializer_list<T> _values)
+      {
+        this->assign(_values.begin(), _values.end());
+      }
+
+      /// \brief Access an element, checking bounds.
+      /// \param[in] _pos Index of the element.
+      /// \return Reference to the element.
+      /// \throws std::out_of_range if _pos is out of range.
+      public: reference at(const size_type _pos)
+      {
+        if (_pos >= this->sizeValue)
+          throw std::out_of_range("SmallVector::at");
+        return this->data()[_pos];
+      }
+
+      /// \brief Access an element, checking bounds.
+      /// \param[in] _pos Index of the element.
+      /// \return Reference to the element.
+      /// \throws std::out_of_range if _pos is out of range.
+      public: const_reference at(const size_type _pos) const
+      {
+        if (_pos >= this->sizeValue)
+          throw std::out_of_range("SmallVector::at");
+        return this->data()[_pos];
+      }
+
+      /// \brief Access an element.
+      /// \param[in] _pos Index of the element, which must be in range.
+      /// \return Reference to the element.
+      public: reference operator[](const size_type _pos)
+      {
+        return this->data()[_pos];
+      }
+
+      /// \brief Access an element.
+      /// \param[in] _pos Index of the element, which must be in range.
+      /// \return Reference to the element.
+      public: const_reference operator[](const size_type _pos) const
+      {
+        return this->data()[_pos];
+      }
+
+      /// \brief Access the first element of a non-empty container.
+      /// \return Reference to the element.
+      public: reference front()
+      {
+        return this->data()[0];
+      }
+
+      /// \brief Access the first element of a non-empty container.
+      /// \return Reference to the element.
+      public: const_reference front() const
+      {
+        return this->data()[0];
+      }
+
+      /// \brief Access the last element of a non-empty container.
+      /// \return Reference to the element.
+      public: reference back()
+      {
+        return this->data()[this->sizeValue - 1];
+      }
+
+      /// \brief Access the last element of a non-empty container.
+      /// \return Reference to the element.
+      public: const_reference back() const
+      {
+        return this->data()[this->sizeValue - 1];
+      }
+
+      /// \brief Get the contiguous storage of the elements.
+      /// \return Pointer to the first element.
+      public: pointer data() noexcept
+      {
+        return this->heap ? this->heap.get() : this->inlineData;
+      }
+
+      /// \brief Get the contiguous storage of the elements.
+      /// \return Pointer to the first element.
+      public: const_pointer data() const noexcept
+      {
+        return this->heap ? this->heap.get() : this->inlineData;
+      }
+
+      /// \brief Iterator to the first element.
+      /// \return Iterator.
+      public: iterator begin() noexcept
+      {
+        return this->data();
+      }
+
+      /// \brief Iterator to the first element.
+      /// \return Iterator.
+      public: const_iterator begin() const noexcept
+      {
+        return this->data();
+      }
+
+      /// \brief Iterator to the first element.
+      /// \return Iterator.
+      public: const_iterator cbegin() const noexcept
+      {
+        return this->data();
+      }
+
+      /// \brief Iterator past the last element.
+      /// \return Iterator.
+      public: iterator end() noexcept
+      {
+        return this->data() + this->sizeValue;
+      }
+
+      /// \brief Iterator past the last element.
+      /// \return Iterator.
+      public: const_iterator end() const noexcept
+      {
+        return this->data() + this->sizeValue;
+      }
+
+      /// \brief Iterator past the last element.
+      /// \return Iterator.
+      public: const_iterator cend() const noexcept
+      {
+        return this->data() + this->sizeValue;
+      }
+
+      /// \brief Reverse iterator to the last element.
+      /// \return Iterator.
+      public: reverse_iterator rbegin() noexcept
+      {
+        return reverse_iterator(this->end());
+      }
+
+      /// \brief Reverse iterator to the last element.
+      /// \return Iterator.
+      public: const_reverse_iterator rbegin() const noexcept
+      {
+        return const_reverse_iterator(this->end());
+      }
+
+      /// \brief Reverse iterator past the first element.
+      /// \return Iterator.
+      public: reverse_iterator rend() noexcept
+      {
+        return reverse_iterator(this->begin());
+      }
+
+      /// \brief Reverse iterator past the first element.
+      /// \return Iterator.
+      public: const_reverse_iterator rend() const noexcept
+      {
+        return const_reverse_iterator(this->begin());
+      }
+
+      /// \brief Check whether the container is empty.
+      /// \return True if there are no elements.
+      public: bool empty() const noexcept
+      {
+        return 0u == this->sizeValue;
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Number of elements.
+      public: size_type size() const noexcept
+      {
+        return this->sizeValue;
+      }
+
+      /// \brief Get the largest possible number of elements.
+      /// \return Number of elements.
+      public: size_type max_size() const noexcept
+      {
+        return std::numeric_limits<difference_type>::max() / sizeof(T);
+      }
+
+      /// \brief Make room for at least _capacity elements.
+      /// \param[in] _capacity Number of elements.
+      public: void reserve(const size_type _capacity)
+      {
+        this->Grow(_capacity);
+      }
+
+      /// \brief Get the number of elements which fit without allocating.
+      /// \return Number of elements.
+      public: size_type capacity() const noexcept
+      {
+        return this->capacityValue;
+      }
+
+      /// \brief Check whether the elements are held inline.
+      /// \return True if the container hasn't allocated.
+      public: bool IsInline() const noexcept
+      {
+        return !this->heap;
+      }
+
+      /// \brief Remove all elements. The capacity is kept.
+      public: void clear() noexcept
+      {
+        this->sizeValue = 0u;
+      }
+
+      /// \brief Append an element.
+      /// \param[in] _value Value of the element.
+      public: void push_back(const T &_value)
+      {
+        // Copy first, in case _value lives in this container
+        const T value = _value;
+        if (this->sizeValue == this->capacityValue)
+          this->Grow(this->capacityValue * 2u);
+        this->data()[this->sizeValue++] = value;
+      }
+
+      /// \brief Append an element constructed from arguments.
+      /// \param[in] _args Arguments of the constructor of T.
+      /// \return Reference to the new element.
+      public: template<typename ...Args>
+              reference emplace_back(Args &&..._args)
+      {
+        this->push_back(T(std::forward<Args>(_args)...));
+        return this->back();
+      }
+
+      /// \brief Remove the last element of a non-empty container.
+      public: void pop_back()
+      {
+        --this->sizeValue;
+      }
+
+      /// \brief Change the number of elements. New elements are value
+      /// initialized.
+      /// \param[in] _count Number of elements.
+      public: void resize(const size_type _count)
+      {
+        this->resize(_count, T());
+      }
+
+      /// \brief Change the number of elements.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _value Value of new elements.
+      public: void resize(const size_type _count, const T &_value)
+      {
+        if (_count > this->sizeValue)
+        {
+          const T value = _value;
+          this->Grow(_count);
+          std::fill(this->data() + this->sizeValue, this->data() + _count,
+              value);
+        }
+        this->sizeValue = _count;
+      }
+
+      /// \brief Erase the elements in a range.
+      /// \param[in] _first Iterator to the first element to erase.
+      /// \param[in] _last Iterator past the last element to erase.
+      /// \return Iterator following the last erased element.
+      public: iterator erase(const_iterator _first, const_iterator _last)
+      {
+        const auto first = this->begin() + (_first - this->cbegin());
+        const auto last = this->begin() + (_last - this->cbegin());
+        std::copy(last, this->end(), first);
+        this->sizeValue -= static_cast<size_type>(last - first);
+        return first;
+      }
+
+      /// \brief Erase an element.
+      /// \param[in] _pos Iterator to the element.
+      /// \return Iterator following the erased element.
+      public: iterator erase(const_iterator _pos)
+      {
+        return this->erase(_pos, _pos + 1);
+      }
+
+      /// \brief Insert an element.
+      /// \param[in] _pos Iterator to the element before which the value is
+      /// inserted.
+      /// \param[in] _value Value of the element.
+      /// \return Iterator to the inserted element.
+      public: iterator insert(const_iterator _pos, const T &_value)
+      {
+        const auto index = _pos - this->cbegin();
+        this->push_back(_value);
+        const auto pos = this->begin() + index;
+        std::rotate(pos, this->end() - 1, this->end());
+        return pos;
+      }
+
+      /// \brief Swap the contents with another container.
+      /// \param[in,out] _other Container to swap with.
+      public: void swap(SmallVector &_other) noexcept
+      {
+        SmallVector tmp(std::move(_other));
+        _other = std::move(*this);
+        *this = std::move(tmp);
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _a Container.
+      /// \param[in] _b Container.
+      /// \return True if both have the same elements.
+      public: friend bool operator==(const SmallVector &_a,
+                  const SmallVector &_b)
+      {
+        return std::equal(_a.begin(), _a.end(), _b.begin(), _b.end());
+      }
+
+      /// \brief Equality operator with a std::vector.
+      /// \param[in] _a Container.
+      /// \param[in] _b Vector.
+      /// \return True if both have the same elements.
+      public: friend bool operator==(const SmallVector &_a,
+                  const std::vector<T> &_b)
+      {
+        return std::equal(_a.begin(), _a.end(), _b.begin(), _b.end());
+      }
+
+      /// \brief Equality operator with a std::vector.
+      /// \param[in] _a Vector.
+      /// \param[in] _b Container.
+      /// \return True if both have the same elements.
+      public: friend bool operator==(const std::vector<T> &_a,
+                  const SmallVector &_b)
+      {
+        return _b == _a;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _a Container.
+      /// \param[in] _b Container.
+      /// \return True if the elements differ.
+      public: friend bool operator!=(const SmallVector &_a,
+                  const SmallVector &_b)
+      {
+        return !(_a == _b);
+      }
+
+      /// \brief Inequality operator with a std::vector.
+      /// \param[in] _a Container.
+      /// \param[in] _b Vector.
+      /// \return True if the elements differ.
+      public: friend bool operator!=(const SmallVector &_a,
+                  const std::vector<T> &_b)
+      {
+        return !(_a == _b);
+      }
+
+      /// \brief Inequality operator with a std::vector.
+      /// \param[in] _a Vector.
+      /// \param[in] _b Container.
+      /// \return True if the elements differ.
+      public: friend bool operator!=(const std::vector<T> &_a,
+                  const SmallVector &_b)
+      {
+        return !(_b == _a);
+      }
+
+      /// \brief Make sure there's room for _capacity elements, moving the
+      /// elements to a larger heap buffer if needed.
+      /// \param[in] _capacity Number of elements.
+      private: void Grow(const size_type _capacity)
+      {
+        if (_capacity <= this->capacityValue)
+          return;
+
+        const size_type capacity = std::max(_capacity,
+            this->capacityValue * 2u);
+        std::unique_ptr<T[]> buffer(new T[capacity]);
+        std::copy(this->begin(), this->end(), buffer.get());
+        this->heap = std::move(buffer);
+        this->capacityValue = capacity;
+      }
+
+      /// \brief Take the contents of another container, which must not own
+      /// heap storage already given to this one. It's left empty.
+      /// \param[in,out] _other Container to take from.
+      private: void Take(SmallVector &_other) noexcept
+      {
+        if (_other.heap)
+        {
+          this->heap = std::move(_other.heap);
+          this->capacityValue = _other.capacityValue;
+        }
+        else
+        {
+          std::copy(_other.begin(), _other.end(), this->inlineData);
+        }
+        this->sizeValue = _other.sizeValue;
+        _other.sizeValue = 0u;
+        _other.capacityValue = N;
+      }
+
+      /// \brief Inline storage, used while the elements fit.
+      private: T inlineData[N]{};
+
+      /// \brief Heap storage, used once the elements don't fit inline.
+      private: std::unique_ptr<T[]> heap;
+
+      /// \brief Number of elements.
+      private: size_type sizeValue{0u};
+
+      /// \brief Number of elements which fit in the current storage.
+      private: size_type capacityValue{N};
+    };
+
+    /// \brief Values of each axis of a joint, such as its positions. Joints
+    /// with up to two axes don't allocate. The joint components keep using
+    /// std::vector<double> until the next major version.
+    using JointAxisValues = SmallVector<double, 2>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SPATIALINDEX_HH_
+#define IGNITION_GAZEBO_SPATIALINDEX_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Entity.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class IGNITION_GAZEBO_HIDDEN SpatialIndexPrivate;
+
+    /// \class SpatialIndex SpatialIndex.hh ignition/gazebo/SpatialIndex.hh
+    /// \brief Index of entities by their axis aligned bounding box in the
+    /// world frame, used to find entities close to a region without visiting
+    /// all of them.
+    ///
+    /// The index is a loose uniform grid: each entity is stored in all the
+    /// cells its box overlaps, and moving an entity only touches the grid if
+    /// it crosses a cell boundary. Entities whose box spans too many cells
+    /// are kept aside and tested on every query.
+    ///
+    /// Queries are const and can run concurrently, as long as the index
+    /// isn't being updated at the same time.
+    class IGNITION_GAZEBO_VISIBLE SpatialIndex
+    {
+      /// \brief Constructor
+      /// \param[in] _cellSize Length of the side of each grid cell, in
+      /// meters. It should be close to the size of a typical entity.
+      public: explicit SpatialIndex(double _cellSize = 8.0);
+
+      /// \brief Destructor
+      public: ~SpatialIndex();
+
+      /// \brief Add an entity to the index, or update its box if it's
+      /// already there. An invalid box removes the entity.
+      /// \param[in] _entity Entity.
+      /// \param[in] _box Box of the entity in the world frame.
+      public: void Update(const Entity _entity,
+                  const math::AxisAlignedBox &_box);
+
+      /// \brief Remove an entity from the index.
+      /// \param[in] _entity Entity.
+      public: void Remove(const Entity _entity);
+
+      /// \brief Remove all entities.
+      public: void Clear();
+
+      /// \brief Get whether an entity is in the index.
+      /// \param[in] _entity Entity.
+      /// \return True if the entity is in the index.
+      public: bool HasEntity(const Entity _entity) const;
+
+      /// \brief Get the box an entity was last updated with.
+      /// \param[in] _entity Entity.
+      /// \return The box, or an empty box if the entity isn't in the index.
+      public: math::AxisAlignedBox Box(const Entity _entity) const;
+
+      /// \brief Get the number of entities in the index.
+      /// \return Number of entities.
+      public: std::size_t Size() const;
+
+      /// \brief Get all entities whose box intersects a box.
+      /// \param[in] _box Box in the world frame.
+      /// \return Entities, sorted by id.
+      public: std::vector<Entity> QueryBox(
+                  const math::AxisAlignedBox &_box) const;
+
+      /// \brief Get all entities whose box intersects a sphere.
+      /// \param[in] _center Center of the sphere in the world frame.
+      /// \param[in] _radius Radius of the sphere.
+      /// \return Entities, sorted by id.
+      public: std::vector<Entity> QuerySphere(const math::Vector3d &_center,
+                  double _radius) const;
+
+      /// \brief Get all entities whose box is at least partially inside a
+      /// frustum.
+      /// \param[in] _frustum Frustum in the world frame.
+      /// \return Entities, sorted by id.
+      public: std::vector<Entity> QueryFrustum(
+                  const math::Frustum &_frustum) const;
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<SpatialIndexPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
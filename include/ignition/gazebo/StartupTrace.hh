@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STARTUPTRACE_HH_
+#define IGNITION_GAZEBO_STARTUPTRACE_HH_
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+//
+class IGNITION_GAZEBO_HIDDEN StartupTracePrivate;
+
+/// \brief Timeline of the phases of a server startup, such as SDF loading,
+/// Fuel downloads, entity creation, system loading and the creation of
+/// physics entities, broken down per model and per system.
+///
+/// The trace is shared by the whole process. The server starts it before
+/// loading the world and finishes it once the first simulation step is
+/// done, at which point the timeline is written as JSON to the path given
+/// by ServerConfig::SetStartupTracePath and a summary is printed at debug
+/// level. Events added while no trace is running are ignored, so the
+/// instrumentation costs nearly nothing after startup.
+///
+/// The JSON document has the form:
+///
+///     {
+///       "total_ms": 1234.5,
+///       "phases": [
+///         {"phase": "sdf_load", "count": 1, "total_ms": 800.2}, ...
+///       ],
+///       "events": [
+///         {"phase": "model", "name": "box", "thread": 0,
+///          "start_ms": 802.1, "duration_ms": 3.4}, ...
+///       ]
+///     }
+///
+/// where times are relative to the start of the trace and threads are
+/// numbered in the order they first added an event. Phases may be nested,
+/// for example Fuel downloads happen while the SDF is loaded, so phase
+/// totals don't add up to the total time.
+///
+/// All functions are safe to call from several threads.
+class IGNITION_GAZEBO_VISIBLE StartupTrace
+{
+  /// \brief Records the time spent in a scope as an event of the trace.
+  public: class IGNITION_GAZEBO_VISIBLE Scope
+  {
+    /// \brief Constructor. Does nothing if no trace is running.
+    /// \param[in] _phase Phase of the event.
+    /// \param[in] _name Name of the element handled during the event, such
+    /// as a model or a plugin name. Can be empty.
+    public: explicit Scope(const char *_phase,
+                const std::string &_name = "");
+
+    /// \brief Destructor. Adds the event to the trace.
+    public: ~Scope();
+
+    /// \brief Scopes can't be copied.
+    public: Scope(const Scope &) = delete;
+
+    /// \brief Scopes can't be copied.
+    public: Scope &operator=(const Scope &) = delete;
+
+    /// \brief Phase of the event, null if no trace was running.
+    private: const char *phase{nullptr};
+
+    /// \brief Name of the element.
+    private: std::string name;
+
+    /// \brief Time at which the scope was entered.
+    private: std::chrono::steady_clock::time_point start;
+  };
+
+  /// \brief Get the trace of this process.
+  /// \return The trace.
+  public: static StartupTrace &Instance();
+
+  /// \brief Destructor
+  public: ~StartupTrace();
+
+  /// \brief Clear all events and start a new trace.
+  public: void Start();
+
+  /// \brief Whether a trace is running.
+  /// \return True between Start and the completion of Finish.
+  public: bool Active() const;
+
+  /// \brief Add an event to the running trace.
+  /// \param[in] _phase Phase of the event.
+  /// \param[in] _name Name of the element handled during the event.
+  /// \param[in] _start Time at which the event started.
+  /// \param[in] _end Time at which the event ended.
+  public: void Add(const std::string &_phase, const std::string &_name,
+              const std::chrono::steady_clock::time_point &_start,
+              const std::chrono::steady_clock::time_point &_end);
+
+  /// \brief Keep the trace running after Finish is called, until Release
+  /// is called. Used by phases which complete on another thread, such as
+  /// the creation of the rendering scene.
+  /// \return True if the trace is running and was held. Release must only
+  /// be called in that case.
+  public: bool Hold();
+
+  /// \brief Release a hold taken by Hold. Completes the trace if Finish
+  /// was called and this was the last hold.
+  public: void Release();
+
+  /// \brief Finish the trace once all holds are released. Completing the
+  /// trace writes it to _path and prints a summary at debug level. Only
+  /// the first call after Start has an effect.
+  /// \param[in] _path Path to write the JSON trace to, empty to only print
+  /// the summary.
+  public: void Finish(const std::string &_path);
+
+  /// \brief Get the trace as a JSON document.
+  /// \return JSON document.
+  public: std::string Json() const;
+
+  /// \brief Get a human readable summary of the trace, with the total time
+  /// of each phase and the slowest events which have a name.
+  /// \return Summary.
+  public: std::string Summary() const;
+
+  /// \brief Constructor. Use Instance to get the trace.
+  private: StartupTrace();
+
+  /// \brief Pointer to private data.
+  private: std::unique_ptr<StartupTracePrivate> dataPtr;
+};
+}
+}
+}
+#endif
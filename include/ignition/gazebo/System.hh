@@ -17,7 +17,9 @@
 #ifndef IGNITION_GAZEBO_SYSTEM_HH_
 #define IGNITION_GAZEBO_SYSTEM_HH_
 
+#include <chrono>
 #include <memory>
+#include <set>
 
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
@@ -114,12 +116,179 @@ namespace ignition
                                   EntityComponentManager &_ecm) = 0;
     };
 
+    /// \class SystemAccess System.hh ignition/gazebo/System.hh
+    /// \brief Component types that a system reads and writes during
+    /// PreUpdate and Update, as declared through ISystemAccess.
+    class SystemAccess
+    {
+      /// \brief Declare component types that are read.
+      /// \tparam ComponentTypeTs Component types.
+      /// \return This object, so that calls can be chained.
+      public: template <typename ...ComponentTypeTs>
+              SystemAccess &Read()
+      {
+        (this->Read(ComponentTypeTs::typeId), ...);
+        return *this;
+      }
+
+      /// \brief Declare component types that are written. Writing a type
+      /// includes reading it.
+      /// \tparam ComponentTypeTs Component types.
+      /// \return This object, so that calls can be chained.
+      public: template <typename ...ComponentTypeTs>
+              SystemAccess &Write()
+      {
+        (this->Write(ComponentTypeTs::typeId), ...);
+        return *this;
+      }
+
+      /// \brief Declare a component type that is read.
+      /// \param[in] _typeId Component type id.
+      /// \return This object, so that calls can be chained.
+      public: SystemAccess &Read(const ComponentTypeId _typeId)
+      {
+        this->reads.insert(_typeId);
+        return *this;
+      }
+
+      /// \brief Declare a component type that is written.
+      /// \param[in] _typeId Component type id.
+      /// \return This object, so that calls can be chained.
+      public: SystemAccess &Write(const ComponentTypeId _typeId)
+      {
+        this->writes.insert(_typeId);
+        return *this;
+      }
+
+      /// \brief Get the component types declared as read.
+      /// \return Component type ids.
+      public: const std::set<ComponentTypeId> &Reads() const
+      {
+        return this->reads;
+      }
+
+      /// \brief Get the component types that are written.
+      /// \return Component type ids.
+      public: const std::set<ComponentTypeId> &Writes() const
+      {
+        return this->writes;
+      }
+
+      /// \brief Check whether two systems may not run at the same time,
+      /// because one of them writes a type that the other one accesses.
+      /// \param[in] _other Access of the other system.
+      /// \return True if the accesses conflict.
+      public: bool ConflictsWith(const SystemAccess &_other) const
+      {
+        auto touches = [](const SystemAccess &_a, const ComponentTypeId _id)
+        {
+          return _a.reads.count(_id) > 0u || _a.writes.count(_id) > 0u;
+        };
+        for (const auto &id : this->writes)
+        {
+          if (touches(_other, id))
+            return true;
+        }
+        for (const auto &id : _other.writes)
+        {
+          if (touches(*this, id))
+            return true;
+        }
+        return false;
+      }
+
+      /// \brief Component types that are read.
+      private: std::set<ComponentTypeId> reads;
+
+      /// \brief Component types that are written.
+      private: std::set<ComponentTypeId> writes;
+    };
+
+    /// \class ISystemAccess ISystem.hh ignition/gazebo/System.hh
+    /// \brief Optional interface for a system that declares which component
+    /// types it accesses during PreUpdate and Update.
+    ///
+    /// Systems which implement this interface may run concurrently with
+    /// other systems that implement it, as long as neither of them writes a
+    /// type that the other one accesses. Systems that don't implement it
+    /// always run alone, so declaring access is only a promise about the
+    /// declaring system. Systems run in the order they were loaded whenever
+    /// their accesses conflict.
+    ///
+    /// While running, such a system must only access the declared types, and
+    /// must make structural changes, such as creating or removing entities
+    /// and components, through EntityComponentManager::Deferred.
+    ///
+    /// The access is queried once, after the system has been configured.
+    class ISystemAccess {
+      /// \brief Declare the accessed component types.
+      /// \param[out] _access Access to fill.
+      public: virtual void DeclareAccess(SystemAccess &_access) const = 0;
+    };
+
     /// \class ISystemPostUpdate ISystem.hh ignition/gazebo/System.hh
     /// \brief Interface for a system that uses the PostUpdate phase
     class ISystemPostUpdate{
       public: virtual void PostUpdate(const UpdateInfo &_info,
                                       const EntityComponentManager &_ecm) = 0;
     };
+
+    /// \class ISystemReset ISystem.hh ignition/gazebo/System.hh
+    /// \brief Interface for a system that keeps state outside of the
+    /// EntityComponentManager, and needs to be told when the world is reset
+    /// to a checkpoint, see Server::Restore.
+    ///
+    /// Reset is called once the entities and components have been restored,
+    /// before the next PreUpdate. Entities created after the checkpoint are
+    /// being removed, and entities removed after the checkpoint are being
+    /// recreated, so both show up as usual during the next iteration.
+    class ISystemReset {
+      /// \brief Called after the world has been reset to a checkpoint.
+      /// \param[in] _info Simulation time and iteration of the checkpoint.
+      /// \param[in] _ecm The restored entity component manager.
+      public: virtual void Reset(const UpdateInfo &_info,
+                                 EntityComponentManager &_ecm) = 0;
+    };
+
+    /// \class ISystemUpdatePeriod ISystem.hh ignition/gazebo/System.hh
+    /// \brief Optional interface for a system whose PostUpdate doesn't need
+    /// to run on every simulation step, such as a publisher.
+    ///
+    /// A system with a non-zero update period has its PostUpdate called on
+    /// the first step, and then on the first step after at least one period
+    /// of simulation time has passed since its last call. The `dt` it
+    /// receives is the simulation time since its last call. Since simulation
+    /// time doesn't advance while paused, PostUpdate isn't called while
+    /// paused. PreUpdate and Update are still called on every step.
+    ///
+    /// Entities created or removed on skipped steps aren't reported by
+    /// EachNew and EachRemoved in the next PostUpdate. Systems which need
+    /// them should track them in PreUpdate or Update.
+    ///
+    /// The period can also be set from SDF, through a `<post_update_rate>`
+    /// element, in Hz, inside the system's `<plugin>`. The SDF value takes
+    /// precedence. The interface is queried once, right after Configure.
+    class ISystemUpdatePeriod {
+      /// \brief Get the update period of the system.
+      /// \return Simulation time between calls, zero to run on every step.
+      public: virtual std::chrono::steady_clock::duration UpdatePeriod()
+                  const = 0;
+    };
+
+    /// \class ISystemPostUpdateAffinity ISystem.hh ignition/gazebo/System.hh
+    /// \brief Optional interface for a system whose PostUpdate must always
+    /// be called from the same thread.
+    ///
+    /// PostUpdate calls run as tasks on a thread pool sized to the hardware,
+    /// so consecutive calls to a system may happen on different threads.
+    /// Systems that hold thread-affine resources, such as a graphics context,
+    /// can implement this interface to keep a dedicated thread instead.
+    /// The interface is queried once, when the system is activated.
+    class ISystemPostUpdateAffinity {
+      /// \brief Whether PostUpdate needs a dedicated thread.
+      /// \return True to always call PostUpdate from the same thread.
+      public: virtual bool DedicatedPostUpdateThread() const = 0;
+    };
   }
   }
 }
@@ -39,6 +39,12 @@ namespace ignition
 
     /// \class SystemLoader SystemLoader.hh ignition/gazebo/SystemLoader.hh
     /// \brief Class for loading/unloading System plugins.
+    ///
+    /// Each plugin library is searched for and loaded once, the first time
+    /// a plugin from it is requested, and reused by later requests. Plugin
+    /// paths are only searched before a library is first found, so paths
+    /// added afterwards don't change which library a filename refers to.
+    /// All functions are safe to call from several threads.
     class IGNITION_GAZEBO_VISIBLE SystemLoader
     {
       /// \brief Constructor
@@ -51,6 +57,14 @@ namespace ignition
       /// \param[in] _path New path to be added.
       public: void AddSystemPluginPath(const std::string &_path);
 
+      /// \brief Find and load the library of a plugin ahead of time, so
+      /// that later calls to LoadPlugin for it don't need to wait on the
+      /// filesystem. This can run on another thread while entities are
+      /// being created.
+      /// \param[in] _filename Plugin filename, as given in SDF.
+      /// \return True if the library was found and loaded.
+      public: bool PreloadLibrary(const std::string &_filename);
+
       /// \brief Load and instantiate system plugin from an SDF element.
       /// \param[in] _sdf SDF Element describing plugin instance to be loaded.
       /// \returns Shared pointer to system instance or nullptr.
@@ -17,6 +17,9 @@
 #ifndef IGNITION_GAZEBO_TESTFIXTURE_HH_
 #define IGNITION_GAZEBO_TESTFIXTURE_HH_
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -52,6 +55,17 @@ class IGNITION_GAZEBO_HIDDEN TestFixturePrivate;
 /// // Run the server
 /// fixture.Server()->Run(true, 1000, false);
 ///
+/// Callbacks which only need to observe simulation every now and then can be
+/// registered with an iteration count or a sim time period. They're skipped
+/// without leaving C++ in between, which keeps the overhead of bindings such
+/// as Python's off the iterations that aren't observed.
+///
+/// // Called on iterations 100, 200, ...
+/// fixture.OnPostUpdate(100, [&](const gazebo::UpdateInfo &,
+///   const gazebo::EntityComponentManager &_ecm)
+///   {
+///   }).Finalize();
+///
 class IGNITION_GAZEBO_VISIBLE TestFixture
 {
   /// \brief Constructor
@@ -93,6 +107,65 @@ class IGNITION_GAZEBO_VISIBLE TestFixture
   public: TestFixture &OnPostUpdate(std::function<void(
       const UpdateInfo &, const EntityComponentManager &)> _cb);
 
+  /// \brief Wrapper around a system's pre-update callback which is only
+  /// called every few iterations.
+  /// \param[in] _iterations The callback is called on iterations which are
+  /// multiples of this. Zero or one call it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnPreUpdate(uint64_t _iterations,
+      std::function<void(const UpdateInfo &, EntityComponentManager &)> _cb);
+
+  /// \brief Wrapper around a system's pre-update callback which is only
+  /// called once per sim time period.
+  /// \param[in] _period The callback is called on the first iteration at or
+  /// after each multiple of this sim time. Zero calls it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnPreUpdate(
+      const std::chrono::steady_clock::duration &_period,
+      std::function<void(const UpdateInfo &, EntityComponentManager &)> _cb);
+
+  /// \brief Wrapper around a system's update callback which is only called
+  /// every few iterations.
+  /// \param[in] _iterations The callback is called on iterations which are
+  /// multiples of this. Zero or one call it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnUpdate(uint64_t _iterations,
+      std::function<void(const UpdateInfo &, EntityComponentManager &)> _cb);
+
+  /// \brief Wrapper around a system's update callback which is only called
+  /// once per sim time period.
+  /// \param[in] _period The callback is called on the first iteration at or
+  /// after each multiple of this sim time. Zero calls it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnUpdate(
+      const std::chrono::steady_clock::duration &_period,
+      std::function<void(const UpdateInfo &, EntityComponentManager &)> _cb);
+
+  /// \brief Wrapper around a system's post-update callback which is only
+  /// called every few iterations.
+  /// \param[in] _iterations The callback is called on iterations which are
+  /// multiples of this. Zero or one call it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnPostUpdate(uint64_t _iterations,
+      std::function<void(const UpdateInfo &,
+      const EntityComponentManager &)> _cb);
+
+  /// \brief Wrapper around a system's post-update callback which is only
+  /// called once per sim time period.
+  /// \param[in] _period The callback is called on the first iteration at or
+  /// after each multiple of this sim time. Zero calls it on every iteration.
+  /// \param[in] _cb Function to be called
+  /// \return Reference to self.
+  public: TestFixture &OnPostUpdate(
+      const std::chrono::steady_clock::duration &_period,
+      std::function<void(const UpdateInfo &,
+      const EntityComponentManager &)> _cb);
+
   /// \brief Finalize all the functions and add fixture to server.
   /// Finalize must be called before running the server, otherwise none of the
   /// `On*` functions will be called.
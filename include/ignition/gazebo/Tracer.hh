@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_TRACER_HH_
+#define IGNITION_GAZEBO_TRACER_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+//
+class IGNITION_GAZEBO_HIDDEN TracerPrivate;
+
+/// \brief Built-in tracer which records the scopes marked with the
+/// `GZ_TRACE` macros of ignition/gazebo/Profiler.hh, and writes them as a
+/// Chrome trace, which can be opened with Perfetto or `chrome://tracing`.
+///
+/// Unlike the ignition-common profiler, the tracer doesn't need to be
+/// enabled at compile time nor a connected browser, so it can be used on
+/// headless machines. It's stopped by default, in which case each macro
+/// costs a single atomic load. While it's running, each thread records its
+/// events in a ring buffer of its own, without locks, so only the most
+/// recent events of each thread are kept.
+///
+/// The tracer is shared by the whole process, and can be controlled with
+/// the server's `/gazebo/trace` service.
+///
+/// Event names are kept as pointers, so they must outlive the trace. This
+/// is the case for the string literals used with the macros.
+///
+/// All functions are safe to call from several threads.
+class IGNITION_GAZEBO_VISIBLE Tracer
+{
+  /// \brief Records the time spent in a scope as an event of the trace.
+  public: class IGNITION_GAZEBO_VISIBLE Scope
+  {
+    /// \brief Constructor. Does nothing if the tracer isn't running.
+    /// \param[in] _name Name of the event.
+    public: explicit Scope(const char *_name);
+
+    /// \brief Destructor. Adds the event to the trace.
+    public: ~Scope();
+
+    /// \brief Scopes can't be copied.
+    public: Scope(const Scope &) = delete;
+
+    /// \brief Scopes can't be copied.
+    public: Scope &operator=(const Scope &) = delete;
+
+    /// \brief Name of the event, null if the tracer wasn't running.
+    private: const char *name{nullptr};
+
+    /// \brief Time at which the scope was entered.
+    private: std::chrono::steady_clock::time_point start;
+  };
+
+  /// \brief Get the tracer of this process.
+  /// \return The tracer.
+  public: static Tracer &Instance();
+
+  /// \brief Destructor. Stops the tracer.
+  public: ~Tracer();
+
+  /// \brief Clear all events and start recording.
+  /// \param[in] _path Path of the file the trace is written to when it's
+  /// stopped. If empty, a file named after the current time is written to
+  /// the log directory, or to the working directory if there's no log
+  /// directory.
+  /// \param[in] _duration If greater than zero, the tracer stops by itself
+  /// after this much wall time.
+  /// \return Path of the trace file, or an empty string if the tracer was
+  /// already running.
+  public: std::string Start(const std::string &_path = "",
+              const std::chrono::steady_clock::duration &_duration =
+              std::chrono::steady_clock::duration::zero());
+
+  /// \brief Stop recording and write the trace file.
+  /// \return True if the tracer was running and the file was written.
+  public: bool Stop();
+
+  /// \brief Whether the tracer is running.
+  /// \return True between Start and Stop.
+  public: bool Active() const;
+
+  /// \brief Set the number of events kept per thread. Only affects buffers
+  /// created by later calls to Start. Defaults to 65536.
+  /// \param[in] _events Number of events.
+  public: void SetBufferSize(std::size_t _events);
+
+  /// \brief Start an event on the current thread, to be finished by End.
+  /// Used by `GZ_TRACE_BEGIN`.
+  /// \param[in] _name Name of the event.
+  public: void Begin(const char *_name);
+
+  /// \brief Finish the last event started on the current thread by Begin.
+  /// Used by `GZ_TRACE_END`.
+  public: void End();
+
+  /// \brief Name the current thread in the trace. Used by
+  /// `GZ_TRACE_THREAD_NAME`.
+  /// \param[in] _name Name of the thread.
+  public: void SetThreadName(const std::string &_name);
+
+  /// \brief Record an event on the current thread.
+  /// \param[in] _name Name of the event.
+  /// \param[in] _start Time at which the event started.
+  /// \param[in] _end Time at which the event ended.
+  public: void Add(const char *_name,
+              const std::chrono::steady_clock::time_point &_start,
+              const std::chrono::steady_clock::time_point &_end);
+
+  /// \brief Get the events recorded since the last Start, in the Chrome
+  /// trace event format.
+  /// \return JSON document.
+  public: std::string Json() const;
+
+  /// \brief Constructor. Use Instance to get the tracer.
+  private: Tracer();
+
+  /// \brief Pointer to private data.
+  private: std::unique_ptr<TracerPrivate> dataPtr;
+};
+}
+}
+}
+#endif
@@ -17,7 +17,9 @@
 #ifndef IGNITION_GAZEBO_UTIL_HH_
 #define IGNITION_GAZEBO_UTIL_HH_
 
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -35,10 +37,15 @@ namespace ignition
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     //
-    /// \brief Helper function to compute world pose of an entity
+    /// \brief Helper function to compute world pose of an entity. The pose
+    /// is composed from scratch on every call. Systems which query poses
+    /// on every iteration should prefer EntityComponentManager::WorldPose,
+    /// which is computed at most once per entity and iteration, and shared
+    /// by all systems.
     /// \param[in] _entity Entity to get the world pose for
     /// \param[in] _ecm Immutable reference to ECM.
     /// \return World pose of entity
+    /// \sa EntityComponentManager::WorldPose
     math::Pose3d IGNITION_GAZEBO_VISIBLE worldPose(const Entity &_entity,
         const EntityComponentManager &_ecm);
 
@@ -266,6 +273,36 @@ namespace ignition
     std::optional<math::Vector3d> IGNITION_GAZEBO_VISIBLE sphericalCoordinates(
         Entity _entity, const EntityComponentManager &_ecm);
 
+    /// \brief Parse a list of CPU cores made of comma separated core
+    /// numbers and ranges, such as `0-3,8,10-11`.
+    /// \param[in] _list List of cores.
+    /// \return Sorted core numbers without duplicates, or nullopt if the list
+    /// is invalid.
+    std::optional<std::vector<unsigned int>> IGNITION_GAZEBO_VISIBLE
+    parseCoreList(const std::string &_list);
+
+    /// \brief Restrict the calling thread to run on a set of CPU cores.
+    /// Threads created afterwards by the calling thread inherit the set.
+    /// Only supported on Linux.
+    /// \param[in] _cores Core numbers.
+    /// \return False if the affinity couldn't be set, for example because
+    /// _cores is empty or none of the cores exists.
+    bool IGNITION_GAZEBO_VISIBLE setThreadAffinity(
+        const std::vector<unsigned int> &_cores);
+
+    /// \brief Restrict a thread to run on a set of CPU cores.
+    /// Only supported on Linux.
+    /// \param[in] _thread Thread to restrict.
+    /// \param[in] _cores Core numbers.
+    /// \return False if the affinity couldn't be set.
+    bool IGNITION_GAZEBO_VISIBLE setThreadAffinity(std::thread &_thread,
+        const std::vector<unsigned int> &_cores);
+
+    /// \brief Get the set of CPU cores the calling thread may run on.
+    /// Only supported on Linux.
+    /// \return Core numbers, empty if unknown.
+    std::vector<unsigned int> IGNITION_GAZEBO_VISIBLE threadAffinity();
+
     /// \brief Environment variable holding resource paths.
     const std::string kResourcePathEnv{"IGN_GAZEBO_RESOURCE_PATH"};
 
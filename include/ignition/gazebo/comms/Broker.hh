@@ -125,7 +125,9 @@ namespace comms
     public: void OnUnbind(const ignition::msgs::StringMsg_V &_req);
 
     /// \brief Callback executed to process a communication request from one of
-    /// the clients.
+    /// the clients. The message is staged without locking the message
+    /// manager, and added to the outbound queue of its sender on the next
+    /// call to Lock().
     /// \param[in] _msg The message from the client.
     public: void OnMsg(const ignition::msgs::Dataframe &_msg);
 
@@ -137,7 +139,9 @@ namespace comms
     /// \return The mutable reference.
     public: MsgManager &DataManager();
 
-    /// \brief Lock the mutex to access the message manager.
+    /// \brief Lock the mutex to access the message manager. Messages
+    /// received since the last call are added to the outbound queues of
+    /// their senders.
     public: void Lock();
 
     /// \brief Unlock the mutex to access the message manager.
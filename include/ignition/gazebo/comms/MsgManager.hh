@@ -148,6 +148,13 @@ class IGNITION_GAZEBO_VISIBLE MsgManager
   /// \param[in] _newContent New content to be set.
   public: void Set(const Registry &_newContent);
 
+  /// \brief Exchange the data structure containing subscriptions and data
+  /// queues with another one, without copying any of them. This allows
+  /// double buffering the registry: the caller keeps the previous content,
+  /// and can reuse its memory on the next update.
+  /// \param[in,out] _other Registry to exchange the data with.
+  public: void Swap(Registry &_other);
+
   /// \brief Private data pointer.
   IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
 };
@@ -17,10 +17,13 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_COMPONENT_HH_
 #define IGNITION_GAZEBO_COMPONENTS_COMPONENT_HH_
 
+#include <charconv>
 #include <cstdint>
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 
 #include <ignition/common/Console.hh>
@@ -96,6 +99,97 @@ namespace traits
     public: static constexpr bool value =  // NOLINT
                 decltype(Test<Stream, DataType>(0))::value;
   };
+
+  /// \brief Type trait that determines if `Serializer` can write `DataType`
+  /// straight into a string buffer, i.e, it checks if the function
+  /// `static void Serializer::Serialize(std::string&, const DataType&)`
+  /// exists.
+  template <typename Serializer, typename DataType>
+  class HasBufferSerialize
+  {
+    private: template <typename SerializerArg, typename DataTypeArg>
+    static auto Test(int _test)
+      -> decltype(SerializerArg::Serialize(std::declval<std::string &>(),
+                      std::declval<const DataTypeArg &>()), std::true_type());
+
+    private: template <typename, typename>
+    static auto Test(...) -> std::false_type;
+
+    public: static constexpr bool value =  // NOLINT
+                decltype(Test<Serializer, DataType>(0))::value;
+  };
+
+  /// \brief Type trait that determines if `Serializer` can read `DataType`
+  /// straight from a string buffer, i.e, it checks if the function
+  /// `static void Serializer::Deserialize(const std::string&, DataType&)`
+  /// exists.
+  template <typename Serializer, typename DataType>
+  class HasBufferDeserialize
+  {
+    private: template <typename SerializerArg, typename DataTypeArg>
+    static auto Test(int _test)
+      -> decltype(SerializerArg::Deserialize(
+                      std::declval<const std::string &>(),
+                      std::declval<DataTypeArg &>()), std::true_type());
+
+    private: template <typename, typename>
+    static auto Test(...) -> std::false_type;
+
+    public: static constexpr bool value =  // NOLINT
+                decltype(Test<Serializer, DataType>(0))::value;
+  };
+
+  /// \brief Type trait that determines if the component type `T` can write
+  /// its data straight into a string buffer, i.e, it checks if the function
+  /// `void T::SerializeTo(std::string&) const` exists.
+  template <typename T>
+  class HasSerializeTo
+  {
+    private: template <typename TArg>
+    static auto Test(int _test)
+      -> decltype(std::declval<const TArg &>().SerializeTo(
+                      std::declval<std::string &>()), std::true_type());
+
+    private: template <typename>
+    static auto Test(...) -> std::false_type;
+
+    public: static constexpr bool value =  // NOLINT
+                decltype(Test<T>(0))::value;
+  };
+
+  /// \brief Type trait that determines if the component type `T` can read
+  /// its data straight from a string buffer, i.e, it checks if the function
+  /// `void T::DeserializeFrom(const std::string&)` exists.
+  template <typename T>
+  class HasDeserializeFrom
+  {
+    private: template <typename TArg>
+    static auto Test(int _test)
+      -> decltype(std::declval<TArg &>().DeserializeFrom(
+                      std::declval<const std::string &>()), std::true_type());
+
+    private: template <typename>
+    static auto Test(...) -> std::false_type;
+
+    public: static constexpr bool value =  // NOLINT
+                decltype(Test<T>(0))::value;
+  };
+
+  /// \brief Helper trait to determine if a type is a number which
+  /// `operator<<` prints with default formatting. Character types are
+  /// excluded, since they're printed as characters.
+  template <typename T>
+  struct IsPlainNumber : std::integral_constant<bool,
+      std::is_floating_point<T>::value || std::is_same<T, bool>::value ||
+      std::is_same<T, short>::value ||  // NOLINT
+      std::is_same<T, unsigned short>::value ||  // NOLINT
+      std::is_same<T, int>::value || std::is_same<T, unsigned int>::value ||
+      std::is_same<T, long>::value ||  // NOLINT
+      std::is_same<T, unsigned long>::value ||  // NOLINT
+      std::is_same<T, long long>::value ||  // NOLINT
+      std::is_same<T, unsigned long long>::value>  // NOLINT
+  {
+  };
 }
 
 namespace serializers
@@ -151,6 +245,40 @@ namespace serializers
       return _out;
     }
 
+    /// \brief Serialization of plain numbers straight into a buffer. This
+    /// writes the same text as `operator<<` on a stream with default
+    /// formatting, without the cost of creating a stream.
+    /// \param[in,out] _buffer Buffer to append the text to.
+    /// \param[in] _data Number to serialize.
+    public: template <typename T = DataType, typename = std::enable_if_t<
+                traits::IsPlainNumber<T>::value>>
+    static void Serialize(std::string &_buffer, const T &_data)
+    {
+      char text[64];
+      int size{0};
+      if constexpr (std::is_same<T, bool>::value)
+      {
+        text[0] = _data ? '1' : '0';
+        size = 1;
+      }
+      else if constexpr (std::is_same<T, long double>::value)
+      {
+        size = std::snprintf(text, sizeof(text), "%Lg", _data);
+      }
+      else if constexpr (std::is_floating_point<T>::value)
+      {
+        size = std::snprintf(text, sizeof(text), "%g",
+            static_cast<double>(_data));
+      }
+      else
+      {
+        size = static_cast<int>(
+            std::to_chars(text, text + sizeof(text), _data).ptr - text);
+      }
+      if (size > 0)
+        _buffer.append(text, static_cast<std::size_t>(size));
+    }
+
     /// \brief Deserialization
     /// \param[in] _in In stream.
     /// \param[in] _data Data resulting from deserialization.
@@ -358,6 +486,20 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    /// \brief Append a serialized version of the component to a buffer. The
+    /// bytes are the same as the ones written by Serialize. This writes into
+    /// the buffer directly if the serializer supports it, and goes through
+    /// a temporary stream otherwise.
+    /// \param[in,out] _buffer Buffer to append to.
+    public: void SerializeTo(std::string &_buffer) const;
+
+    /// \brief Fills the component based on a buffer with serialized data, as
+    /// written by Serialize or SerializeTo. This reads from the buffer
+    /// directly if the serializer supports it, and goes through a temporary
+    /// stream otherwise.
+    /// \param[in] _buffer Serialized data.
+    public: void DeserializeFrom(const std::string &_buffer);
+
     /// \brief Get the mutable component data. This function will be
     /// deprecated in Gazebo 3, replaced by const DataType &Data() const.
     /// Use void SetData(const DataType &) to modify data.
@@ -427,6 +569,11 @@ namespace components
     // Documentation inherited
     public: void Deserialize(std::istream &_in) override;
 
+    /// \brief Append a serialized version of the component to a buffer. The
+    /// bytes are the same as the ones written by Serialize.
+    /// \param[in,out] _buffer Buffer to append to.
+    public: void SerializeTo(std::string &_buffer) const;
+
     /// \brief Unique ID for this component type. This is set through the
     /// Factory registration.
     public: inline static ComponentTypeId typeId{0};
@@ -500,6 +647,39 @@ namespace components
     Serializer::Deserialize(_in, this->Data());
   }
 
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  void Component<DataType, Identifier, Serializer>::SerializeTo(
+      std::string &_buffer) const
+  {
+    if constexpr (traits::HasBufferSerialize<Serializer, DataType>::value)
+    {
+      Serializer::Serialize(_buffer, this->Data());
+    }
+    else
+    {
+      std::ostringstream ostr;
+      this->Serialize(ostr);
+      _buffer += ostr.str();
+    }
+  }
+
+  //////////////////////////////////////////////////
+  template <typename DataType, typename Identifier, typename Serializer>
+  void Component<DataType, Identifier, Serializer>::DeserializeFrom(
+      const std::string &_buffer)
+  {
+    if constexpr (traits::HasBufferDeserialize<Serializer, DataType>::value)
+    {
+      Serializer::Deserialize(_buffer, this->Data());
+    }
+    else
+    {
+      std::istringstream istr(_buffer);
+      this->Deserialize(istr);
+    }
+  }
+
   //////////////////////////////////////////////////
   template <typename DataType, typename Identifier, typename Serializer>
   std::unique_ptr<BaseComponent>
@@ -563,6 +743,24 @@ namespace components
   {
     Serializer::Deserialize(_in);
   }
+
+  //////////////////////////////////////////////////
+  template <typename Identifier, typename Serializer>
+  void Component<NoData, Identifier, Serializer>::SerializeTo(
+      std::string &_buffer) const
+  {
+    if constexpr (std::is_same<Serializer,
+        serializers::DefaultSerializer<NoData>>::value)
+    {
+      _buffer += '-';
+    }
+    else
+    {
+      std::ostringstream ostr;
+      this->Serialize(ostr);
+      _buffer += ostr.str();
+    }
+  }
 }
 }
 }
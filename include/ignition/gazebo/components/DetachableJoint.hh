@@ -96,6 +96,16 @@ namespace components
                 serializers::DetachableJointInfoSerializer>;
   IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.DetachableJoint",
                                 DetachableJoint)
+
+  /// \brief A component that sets whether a detachable joint is attached.
+  /// Toggling it attaches and detaches the links without creating or
+  /// removing the joint entity, which is cheaper when the same links are
+  /// connected and disconnected often. Detachable joints without this
+  /// component are always attached.
+  using DetachableJointEnabled =
+      Component<bool, class DetachableJointEnabledTag>;
+  IGN_GAZEBO_REGISTER_COMPONENT(
+      "ign_gazebo_components.DetachableJointEnabled", DetachableJointEnabled)
 }
 }
 }
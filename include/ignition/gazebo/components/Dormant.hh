@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_COMPONENTS_DORMANT_HH_
+#define IGNITION_GAZEBO_COMPONENTS_DORMANT_HH_
+
+#include <ignition/gazebo/components/Factory.hh>
+#include <ignition/gazebo/components/Component.hh>
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace components
+{
+  /// \brief A component set on top level models which are far from all
+  /// performers, according to the simulation level of detail policy.
+  /// The systems attached to a dormant model and its descendants are
+  /// skipped. When the model wakes up, their dt covers the time they were
+  /// skipped for, but entities created or removed in the meantime aren't
+  /// reported by EachNew and EachRemoved. The data is true if the physics
+  /// system also holds the model in place. The component is removed once a
+  /// performer approaches.
+  using Dormant = Component<bool, class DormantTag>;
+  IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.Dormant", Dormant)
+}
+}
+}
+}
+#endif
@@ -17,11 +17,14 @@
 #ifndef IGNITION_GAZEBO_COMPONENTS_FACTORY_HH_
 #define IGNITION_GAZEBO_COMPONENTS_FACTORY_HH_
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <ignition/common/SingletonT.hh>
@@ -78,6 +81,151 @@ namespace components
     }
   };
 
+  /// \brief How to construct and copy instances of a component type in memory
+  /// owned by the entity component manager. This is an internal registry,
+  /// filled when components are registered with the Factory, and kept apart
+  /// from ComponentDescriptorBase so that the descriptors don't change.
+  class IGNITION_GAZEBO_VISIBLE ComponentPoolTraits
+  {
+    /// \brief Size of an instance of the component, in bytes.
+    public: std::size_t size{0u};
+
+    /// \brief Alignment required by an instance of the component, in bytes.
+    public: std::size_t alignment{alignof(std::max_align_t)};
+
+    /// \brief Construct an instance of the component in memory of at least
+    /// `size` bytes aligned to `alignment`, copying some data. The instance
+    /// must be destroyed by calling its destructor, not deleted.
+    public: BaseComponent *(*construct)(void *_memory,
+                const BaseComponent *_data){nullptr};
+
+    /// \brief Copy the data of a component into an existing component of
+    /// the same type, without allocating. Null if the component type can't
+    /// be copy assigned.
+    public: void (*assign)(BaseComponent *_to,
+                const BaseComponent *_from){nullptr};
+
+    /// \brief Get the traits of a component type.
+    /// \tparam ComponentTypeT Type of component.
+    /// \return The traits.
+    public: template<typename ComponentTypeT>
+    static ComponentPoolTraits Make()
+    {
+      ComponentPoolTraits traits;
+      traits.size = sizeof(ComponentTypeT);
+      traits.alignment = alignof(ComponentTypeT);
+      traits.construct = [](void *_memory, const BaseComponent *_data)
+          -> BaseComponent *
+      {
+        return new (_memory) ComponentTypeT(
+            *static_cast<const ComponentTypeT *>(_data));
+      };
+      if constexpr (std::is_copy_assignable_v<ComponentTypeT>)
+      {
+        traits.assign = [](BaseComponent *_to, const BaseComponent *_from)
+        {
+          *static_cast<ComponentTypeT *>(_to) =
+              *static_cast<const ComponentTypeT *>(_from);
+        };
+      }
+      return traits;
+    }
+
+    /// \brief Store the traits of a component type.
+    /// \param[in] _typeId Component id.
+    /// \param[in] _traits The traits.
+    public: static void Register(const ComponentTypeId _typeId,
+                const ComponentPoolTraits &_traits);
+
+    /// \brief Forget the traits of a component type.
+    /// \param[in] _typeId Component id.
+    public: static void Unregister(const ComponentTypeId _typeId);
+
+    /// \brief Get the stored traits of a component type.
+    /// \param[in] _typeId Component id.
+    /// \return The traits, or nullptr if the component type was registered
+    /// without them, such as by a library built against older headers.
+    public: static const ComponentPoolTraits *Find(
+                const ComponentTypeId _typeId);
+  };
+
+  /// \brief How to serialize a component type into a string buffer and back
+  /// without going through a stream. Like ComponentPoolTraits, this is an
+  /// internal registry filled when components are registered with the
+  /// Factory, so that BaseComponent doesn't change.
+  class IGNITION_GAZEBO_VISIBLE ComponentBufferSerializer
+  {
+    /// \brief Append a serialized version of a component to a buffer. Null
+    /// if the component type doesn't support it.
+    public: void (*serialize)(const BaseComponent *_comp,
+                std::string &_buffer){nullptr};
+
+    /// \brief Fill a component based on a buffer with serialized data. Null
+    /// if the component type doesn't support it.
+    public: void (*deserialize)(BaseComponent *_comp,
+                const std::string &_buffer){nullptr};
+
+    /// \brief Get the buffer serializer of a component type.
+    /// \tparam ComponentTypeT Type of component.
+    /// \return The serializer.
+    public: template<typename ComponentTypeT>
+    static ComponentBufferSerializer Make()
+    {
+      ComponentBufferSerializer serializer;
+      if constexpr (traits::HasSerializeTo<ComponentTypeT>::value)
+      {
+        serializer.serialize = [](const BaseComponent *_comp,
+            std::string &_buffer)
+        {
+          static_cast<const ComponentTypeT *>(_comp)->SerializeTo(_buffer);
+        };
+      }
+      if constexpr (traits::HasDeserializeFrom<ComponentTypeT>::value)
+      {
+        serializer.deserialize = [](BaseComponent *_comp,
+            const std::string &_buffer)
+        {
+          static_cast<ComponentTypeT *>(_comp)->DeserializeFrom(_buffer);
+        };
+      }
+      return serializer;
+    }
+
+    /// \brief Store the buffer serializer of a component type.
+    /// \param[in] _typeId Component id.
+    /// \param[in] _serializer The serializer.
+    public: static void Register(const ComponentTypeId _typeId,
+                const ComponentBufferSerializer &_serializer);
+
+    /// \brief Forget the buffer serializer of a component type.
+    /// \param[in] _typeId Component id.
+    public: static void Unregister(const ComponentTypeId _typeId);
+
+    /// \brief Get the stored buffer serializer of a component type.
+    /// \param[in] _typeId Component id.
+    /// \return The serializer, or nullptr if the component type was
+    /// registered without one, such as by a library built against older
+    /// headers.
+    public: static const ComponentBufferSerializer *Find(
+                const ComponentTypeId _typeId);
+
+    /// \brief Append a serialized version of a component to a buffer. This
+    /// uses the registered serializer if there is one, and falls back to
+    /// BaseComponent::Serialize otherwise.
+    /// \param[in] _comp Component to serialize.
+    /// \param[in,out] _buffer Buffer to append to.
+    public: static void Serialize(const BaseComponent &_comp,
+                std::string &_buffer);
+
+    /// \brief Fill a component based on a buffer with serialized data. This
+    /// uses the registered serializer if there is one, and falls back to
+    /// BaseComponent::Deserialize otherwise.
+    /// \param[in] _comp Component to fill.
+    /// \param[in] _buffer Serialized data.
+    public: static void Deserialize(BaseComponent &_comp,
+                const std::string &_buffer);
+  };
+
   /// \brief A base class for an object responsible for creating storages.
   class StorageDescriptorBase
   {
@@ -187,6 +335,10 @@ namespace components
       this->compsById[ComponentTypeT::typeId] = _compDesc;
       namesById[ComponentTypeT::typeId] = ComponentTypeT::typeName;
       runtimeNamesById[ComponentTypeT::typeId] = runtimeName;
+      ComponentPoolTraits::Register(ComponentTypeT::typeId,
+          ComponentPoolTraits::Make<ComponentTypeT>());
+      ComponentBufferSerializer::Register(ComponentTypeT::typeId,
+          ComponentBufferSerializer::Make<ComponentTypeT>());
     }
 
     /// \brief Unregister a component so that the factory can't create instances
@@ -238,6 +390,9 @@ namespace components
           runtimeNamesById.erase(it);
         }
       }
+
+      ComponentPoolTraits::Unregister(_typeId);
+      ComponentBufferSerializer::Unregister(_typeId);
     }
 
     /// \brief Create a new instance of a component.
@@ -308,6 +463,19 @@ namespace components
       return nullptr;
     }
 
+    /// \brief Get the descriptor used to create instances of a component
+    /// type.
+    /// \param[in] _type Component id.
+    /// \return The descriptor, or nullptr if the type isn't registered.
+    public: const ComponentDescriptorBase *Descriptor(
+        const ComponentTypeId &_type) const
+    {
+      auto it = this->compsById.find(_type);
+      if (it == this->compsById.end())
+        return nullptr;
+      return it->second;
+    }
+
     /// \brief Get all the registered component types by ID.
     /// return Vector of component IDs.
     public: std::vector<ComponentTypeId> TypeIds() const
@@ -30,7 +30,9 @@
 
 #include <ignition/msgs/double_v.pb.h>
 
+#include <cstring>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <sdf/Sensor.hh>
 
@@ -89,6 +91,16 @@ namespace traits
 ///                                                DataType &_data)
 ///     };
 /// \endcode
+/// A serializer may also implement overloads which work on a string buffer,
+/// which are used by Component::SerializeTo and Component::DeserializeFrom
+/// to skip the cost of a stream. They must produce and accept the same bytes
+/// as the stream functions.
+/// \code
+///       public: static void Serialize(std::string &_buffer,
+///                                     const DataType &_data);
+///       public: static void Deserialize(const std::string &_buffer,
+///                                       DataType &_data)
+/// \endcode
 
 namespace serializers
 {
@@ -114,21 +126,19 @@ namespace serializers
     public: static std::ostream &Serialize(std::ostream &_out,
                                            const DataType &_data)
     {
-      MsgType msg;
-      // cppcheck-suppress syntaxError
-      if constexpr (traits::HasGazeboConvert<DataType, MsgType>::value)
-      {
-        msg = ignition::gazebo::convert<MsgType>(_data);
-      }
-      else
-      {
-        msg = ignition::msgs::Convert(_data);
-      }
-
-      msg.SerializeToOstream(&_out);
+      ToMsg(_data).SerializeToOstream(&_out);
       return _out;
     }
 
+    /// \brief Serialization into a buffer
+    /// \param[in,out] _buffer Buffer to append to.
+    /// \param[in] _data Data to serialize.
+    public: static void Serialize(std::string &_buffer,
+                                  const DataType &_data)
+    {
+      ToMsg(_data).AppendToString(&_buffer);
+    }
+
     /// \brief Deserialization
     /// \param[in] _in Input stream.
     /// \param[out] _data data to populate
@@ -138,16 +148,41 @@ namespace serializers
     {
       MsgType msg;
       msg.ParseFromIstream(&_in);
+      _data = FromMsg(msg);
+      return _in;
+    }
+
+    /// \brief Deserialization from a buffer
+    /// \param[in] _buffer Serialized data.
+    /// \param[out] _data data to populate
+    public: static void Deserialize(const std::string &_buffer,
+                                    DataType &_data)
+    {
+      MsgType msg;
+      msg.ParseFromString(_buffer);
+      _data = FromMsg(msg);
+    }
+
+    /// \brief Convert the data to a message.
+    /// \param[in] _data Data to convert.
+    /// \return The message.
+    private: static MsgType ToMsg(const DataType &_data)
+    {
+      if constexpr (traits::HasGazeboConvert<DataType, MsgType>::value)
+        return ignition::gazebo::convert<MsgType>(_data);
+      else
+        return ignition::msgs::Convert(_data);
+    }
 
+    /// \brief Convert a message to the data.
+    /// \param[in] _msg Message to convert.
+    /// \return The data.
+    private: static DataType FromMsg(const MsgType &_msg)
+    {
       if constexpr (traits::HasGazeboConvert<MsgType, DataType>::value)
-      {
-        _data = ignition::gazebo::convert<DataType>(msg);
-      }
+        return ignition::gazebo::convert<DataType>(_msg);
       else
-      {
-        _data = ignition::msgs::Convert(msg);
-      }
-      return _in;
+        return ignition::msgs::Convert(_msg);
     }
   };
 
@@ -183,6 +218,28 @@ namespace serializers
       _vec = {msg.data().begin(), msg.data().end()};
       return _in;
     }
+
+    /// \brief Serialization into a buffer
+    /// \param[in,out] _buffer Buffer to append to.
+    /// \param[in] _vec Vector to serialize.
+    public: static void Serialize(std::string &_buffer,
+                                  const std::vector<double> &_vec)
+    {
+      ignition::msgs::Double_V msg;
+      *msg.mutable_data() = {_vec.begin(), _vec.end()};
+      msg.AppendToString(&_buffer);
+    }
+
+    /// \brief Deserialization from a buffer
+    /// \param[in] _buffer Serialized data.
+    /// \param[in] _vec Vector to populate
+    public: static void Deserialize(const std::string &_buffer,
+                                    std::vector<double> &_vec)
+    {
+      ignition::msgs::Double_V msg;
+      msg.ParseFromString(_buffer);
+      _vec = {msg.data().begin(), msg.data().end()};
+    }
   };
 
   /// \brief Serializer for components that hold protobuf messages.
@@ -209,6 +266,24 @@ namespace serializers
       _msg.ParseFromIstream(&_in);
       return _in;
     }
+
+    /// \brief Serialization into a buffer
+    /// \param[in,out] _buffer Buffer to append to.
+    /// \param[in] _msg Message to serialize.
+    public: static void Serialize(std::string &_buffer,
+        const google::protobuf::Message &_msg)
+    {
+      _msg.AppendToString(&_buffer);
+    }
+
+    /// \brief Deserialization from a buffer
+    /// \param[in] _buffer Serialized data.
+    /// \param[in] _msg Message to populate
+    public: static void Deserialize(const std::string &_buffer,
+        google::protobuf::Message &_msg)
+    {
+      _msg.ParseFromString(_buffer);
+    }
   };
 
   /// \brief Serializer for components that hold std::string.
@@ -235,6 +310,89 @@ namespace serializers
       _data = std::string(std::istreambuf_iterator<char>(_in), {});
       return _in;
     }
+
+    /// \brief Serialization into a buffer
+    /// \param[in,out] _buffer Buffer to append to.
+    /// \param[in] _data Data to serialize.
+    public: static void Serialize(std::string &_buffer,
+        const std::string &_data)
+    {
+      _buffer += _data;
+    }
+
+    /// \brief Deserialization from a buffer
+    /// \param[in] _buffer Serialized data.
+    /// \param[in] _data Data to populate.
+    public: static void Deserialize(const std::string &_buffer,
+        std::string &_data)
+    {
+      _data = _buffer;
+    }
+  };
+
+  /// \brief Serializer which copies the bytes of trivially copyable data.
+  /// This is much cheaper than formatting text, but the format depends on
+  /// the memory layout of the type, so it's only meant for components which
+  /// are exchanged between processes built for the same platform. Note that
+  /// the format is different from the one of DefaultSerializer, so switching
+  /// an existing component to this serializer breaks previously recorded
+  /// logs.
+  /// \code
+  ///   using Counter = Component<uint64_t, class CounterTag,
+  ///           serializers::TriviallyCopyableSerializer<uint64_t>>;
+  /// \endcode
+  /// \tparam DataType Trivially copyable data type.
+  template <typename DataType>
+  class TriviallyCopyableSerializer
+  {
+    static_assert(std::is_trivially_copyable<DataType>::value,
+        "TriviallyCopyableSerializer requires a trivially copyable type");
+
+    /// \brief Serialization
+    /// \param[in] _out Output stream.
+    /// \param[in] _data Data to serialize.
+    /// \return The stream.
+    public: static std::ostream &Serialize(std::ostream &_out,
+        const DataType &_data)
+    {
+      _out.write(reinterpret_cast<const char *>(&_data), sizeof(DataType));
+      return _out;
+    }
+
+    /// \brief Deserialization. The data is left untouched if the stream
+    /// doesn't hold enough bytes.
+    /// \param[in] _in Input stream.
+    /// \param[out] _data Data to populate.
+    /// \return The stream.
+    public: static std::istream &Deserialize(std::istream &_in,
+        DataType &_data)
+    {
+      char bytes[sizeof(DataType)];
+      if (_in.read(bytes, sizeof(DataType)))
+        std::memcpy(&_data, bytes, sizeof(DataType));
+      return _in;
+    }
+
+    /// \brief Serialization into a buffer
+    /// \param[in,out] _buffer Buffer to append to.
+    /// \param[in] _data Data to serialize.
+    public: static void Serialize(std::string &_buffer,
+        const DataType &_data)
+    {
+      _buffer.append(reinterpret_cast<const char *>(&_data),
+          sizeof(DataType));
+    }
+
+    /// \brief Deserialization from a buffer. The data is left untouched if
+    /// the buffer doesn't have the size of the data.
+    /// \param[in] _buffer Serialized data.
+    /// \param[out] _data Data to populate.
+    public: static void Deserialize(const std::string &_buffer,
+        DataType &_data)
+    {
+      if (_buffer.size() == sizeof(DataType))
+        std::memcpy(&_data, _buffer.data(), sizeof(DataType));
+    }
   };
 
   template <typename T>
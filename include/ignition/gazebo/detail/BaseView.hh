@@ -17,12 +17,14 @@
 #ifndef IGNITION_GAZEBO_DETAIL_BASEVIEW_HH_
 #define IGNITION_GAZEBO_DETAIL_BASEVIEW_HH_
 
+#include <algorithm>
 #include <cstddef>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/Types.hh"
 #include "ignition/gazebo/config.hh"
 
@@ -32,6 +34,11 @@ namespace gazebo
 {
 // Inline bracket to help doxygen filtering.
 inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace components
+{
+  class BaseComponent;
+}
+
 namespace detail
 {
 /// \brief A key into the map of views
@@ -54,6 +61,119 @@ struct ComponentTypeHasher
   }
 };
 
+/// \brief Get a new query slot. Slots are unique in the process.
+/// \return The slot.
+/// \sa QueryViewSlot
+IGNITION_GAZEBO_VISIBLE std::size_t NextQueryViewSlot();
+
+/// \brief Get the slot of a query, which identifies its list of component
+/// types at compile time. The EntityComponentManager caches the view of
+/// each query by slot, so that queries don't need to look up their view by
+/// key every time.
+/// \tparam ComponentTypeTs The types listed in the query.
+/// \return The slot, which is the same on every call.
+template<typename ...ComponentTypeTs>
+std::size_t QueryViewSlot()
+{
+  static const std::size_t slot{NextQueryViewSlot()};
+  return slot;
+}
+
+/// \brief Data of a view which is kept apart from it, so that the layout of
+/// BaseView and View doesn't change. Each view's state is created on first
+/// use and destroyed with the view.
+/// \sa BaseView::State
+class ViewState
+{
+  /// \brief Get the index of an entity in `packedEntities`.
+  /// \param[in] _entity The entity
+  /// \return Index of the entity, or the size of `packedEntities` if the
+  /// entity isn't part of the view.
+  public: std::size_t IndexOf(const Entity _entity) const
+  {
+    auto iter = std::lower_bound(this->packedEntities.begin(),
+        this->packedEntities.end(), _entity);
+    if (iter == this->packedEntities.end() || *iter != _entity)
+      return this->packedEntities.size();
+    return static_cast<std::size_t>(iter - this->packedEntities.begin());
+  }
+
+  /// \brief Get the component data of the entity at a given index of
+  /// `packedEntities`.
+  /// \param[in] _index Index of the entity. It is assumed to be in range.
+  /// \return Pointer to the first of the entity's components, followed by
+  /// the rest of its components in the order of the view's component types.
+  public: components::BaseComponent *const *ComponentDataAt(
+              const std::size_t _index) const
+  {
+    return this->validData.data() + _index * this->stride;
+  }
+
+  /// \brief Get the component data of an entity in the view.
+  /// \param[in] _entity The entity
+  /// \return Pointer to the first of the entity's components, or null if
+  /// the entity isn't part of the view.
+  public: components::BaseComponent *const *ComponentDataFor(
+              const Entity _entity) const
+  {
+    const auto index = this->IndexOf(_entity);
+    if (index >= this->packedEntities.size())
+      return nullptr;
+    return this->ComponentDataAt(index);
+  }
+
+  /// \brief Get the index in `packedEntities` of the entity that follows a
+  /// given entity. This allows iterating over the view by index while the
+  /// view is modified, for example when a callback removes a component and
+  /// the entity is moved out of the view, shifting the entities after it.
+  /// \param[in] _index Index at which _entity was visited.
+  /// \param[in] _entity The visited entity.
+  /// \return Index of the next entity to visit, which may be equal to the
+  /// size of `packedEntities` if there are no more entities.
+  public: std::size_t NextIndex(const std::size_t _index,
+              const Entity _entity) const
+  {
+    // Nothing moved, which is the common case
+    if (_index < this->packedEntities.size() &&
+        this->packedEntities[_index] == _entity)
+    {
+      return _index + 1;
+    }
+
+    return static_cast<std::size_t>(std::upper_bound(
+        this->packedEntities.begin(), this->packedEntities.end(), _entity) -
+        this->packedEntities.begin());
+  }
+
+  /// \brief The entities of the view, sorted by id in contiguous storage,
+  /// so that iteration order is deterministic and lookups can use binary
+  /// search.
+  public: std::vector<Entity> packedEntities;
+
+  /// \brief Component data of all entities in the view, laid out as
+  /// `stride` consecutive pointers per entity, in the same order as
+  /// `packedEntities`. The pointers are non-const because calls to ECM::Each
+  /// can have a method signature that uses either non-const or const
+  /// pointers, and the const version only adds constness.
+  public: std::vector<components::BaseComponent *> validData;
+
+  /// \brief Number of component pointers held per entity, which is the
+  /// number of required and optional components of the view.
+  public: std::size_t stride{0};
+
+  /// \brief The component types that entities in the view must not have
+  public: std::set<ComponentTypeId> excludedTypes;
+
+  /// \brief The component types that the view holds if present
+  public: std::set<ComponentTypeId> optionalTypes;
+
+  /// \brief Entities which were added to the view through only one of
+  /// View::AddEntityWithComps and View::AddEntityWithConstComps, mapped to
+  /// whether it was the const one. Their data is in `validData`, but it
+  /// isn't considered cached until both were called.
+  public: std::unordered_map<Entity, bool> partialData;
+};
+
 /// \brief A view is a cache to entities, and their components, that
 /// match a set of component types. A cache is used because systems will
 /// frequently, potentially every iteration, query the
@@ -67,9 +187,21 @@ struct ComponentTypeHasher
 /// ignition::gazebo::detail) directly.
 class IGNITION_GAZEBO_VISIBLE BaseView
 {
+  /// \brief Constructor
+  public: BaseView();
+
+  /// \brief Copy constructor, which also copies the view's state.
+  /// \param[in] _view View to copy.
+  public: BaseView(const BaseView &_view);
+
   /// \brief Destructor
   public: virtual ~BaseView();
 
+  /// \brief Copy assignment, which also copies the view's state.
+  /// \param[in] _view View to copy.
+  /// \return Reference to this view.
+  public: BaseView &operator=(const BaseView &_view);
+
   /// \brief See if an entity is a part of the view
   /// \param[in] _entity The entity
   /// \return true if _entity is a part of the view, false otherwise
@@ -105,6 +237,17 @@ class IGNITION_GAZEBO_VISIBLE BaseView
   /// otherwise
   public: bool RequiresComponent(const ComponentTypeId _typeId) const;
 
+  /// \brief See if the view has excluded or optional component types, in
+  /// which case it must be updated when components of those types are
+  /// added to or removed from its entities.
+  /// \return True if the view has filters.
+  public: bool IsFiltered() const;
+
+  /// \brief See if a component type is excluded or optional in the view.
+  /// \param[in] _typeId The component type
+  /// \return True if _typeId is one of the view's filters.
+  public: bool FiltersComponent(const ComponentTypeId _typeId) const;
+
   /// \brief Update the internal data in the view because a component has been
   /// added to an entity. It is assumed that the entity is already associated
   /// with the view, and that the added component type is required by the view.
@@ -136,12 +279,23 @@ class IGNITION_GAZEBO_VISIBLE BaseView
   /// exist in the view.
   public: virtual bool RemoveEntity(const Entity _entity) = 0;
 
+  /// \brief Remove many entities from the view at once. For a View, this is
+  /// faster than calling RemoveEntity for each of them, because the view's
+  /// packed arrays are compacted only once.
+  /// \param[in] _entities The entities to remove, sorted by id. Entities
+  /// which aren't in the view are ignored.
+  public: void RemoveEntities(const std::vector<Entity> &_entities);
+
   /// \brief Add the entity to the list of entities to be removed
   /// \param[in] _entity The entity to add.
   /// \return True if the entity was added to the list, false if the entity
   /// was not associated with the view.
   public: bool MarkEntityToRemove(const Entity _entity);
 
+  /// \brief Add all the entities associated with the view, including the
+  /// ones marked to be added, to the list of entities to be removed.
+  public: void MarkAllEntitiesToRemove();
+
   /// \brief Update the entities in the view to no longer appear as newly
   /// created. This method should be called whenever a new simulation step is
   /// about to take place.
@@ -151,14 +305,46 @@ class IGNITION_GAZEBO_VISIBLE BaseView
   /// \return The set of component types.
   public: const std::set<ComponentTypeId> &ComponentTypes() const;
 
+  /// \brief Get the set of component types that entities in this view must
+  /// not have.
+  /// \return The set of component types.
+  public: const std::set<ComponentTypeId> &ExcludedComponentTypes() const;
+
+  /// \brief Get the set of component types that the view holds for the
+  /// entities which have them, without requiring them.
+  /// \return The set of component types.
+  public: const std::set<ComponentTypeId> &OptionalComponentTypes() const;
+
   /// \brief Clear all data from the view and reset it to its original, empty
   /// state.
   public: virtual void Reset() = 0;
 
+  /// \brief Estimate the memory used by the view's own data structures,
+  /// not counting the components it points to.
+  /// \return Number of bytes.
+  public: std::size_t MemoryUsage() const;
+
+  /// \brief Shrink the view's data structures if they use much less memory
+  /// than they hold, such as after many entities were removed.
+  public: void Compact();
+
   /// \brief Get all of the entities in the view
   /// \return The entities in the view
   public: const std::set<Entity> &Entities() const;
 
+  /// \brief Get all of the entities in the view, sorted by id. The
+  /// entities are stored contiguously, and the index of an entity in this
+  /// vector is also the index of its component data in the view, so this is
+  /// faster to iterate than Entities().
+  /// \return The entities in the view
+  public: const std::vector<Entity> &PackedEntities() const;
+
+  /// \brief Get the state of the view which is kept apart from it. Looking
+  /// it up takes a lock, so callers which visit many entities should get it
+  /// once.
+  /// \return The state, which is valid as long as the view.
+  public: const ViewState &State() const;
+
   /// \brief Get all of the entities in the view that are considered "newly
   /// created". While an entity may be new to the view, it may not be a newly
   /// created entity (perhaps this entity has existed for some time, and just
@@ -187,6 +373,11 @@ class IGNITION_GAZEBO_VISIBLE BaseView
   /// \sa ToAddEntities
   public: void ClearToAddEntities();
 
+  /// \brief Get the mutable state of the view which is kept apart from it.
+  /// \return The state, which is valid as long as the view.
+  /// \sa State
+  protected: ViewState &MutableState();
+
   // TODO(adlarkin) make this a std::unordered_set for better performance.
   // We need to make sure nothing else depends on the ordered preserved by
   // std::set first
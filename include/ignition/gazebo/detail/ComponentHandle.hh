@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_COMPONENTHANDLE_HH_
+#define IGNITION_GAZEBO_DETAIL_COMPONENTHANDLE_HH_
+
+#include <type_traits>
+
+#include "ignition/gazebo/ComponentHandle.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentHandle<ComponentTypeT>::ComponentHandle(ManagerType &_ecm,
+    const Entity _entity)
+  : ecm(&_ecm), entity(_entity)
+{
+  this->Resolve();
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentTypeT *ComponentHandle<ComponentTypeT>::Get() const
+{
+  if (nullptr == this->ecm)
+    return nullptr;
+
+  if (nullptr == this->generation ||
+      *this->generation != this->resolvedGeneration)
+  {
+    this->Resolve();
+  }
+
+  // The component may be modified through the pointer, like the ones
+  // returned by EntityComponentManager::Component
+  if constexpr (!std::is_const_v<ComponentTypeT>)
+  {
+    if (nullptr != this->component)
+      this->ecm->InvalidateCachesFor(this->entity, ComponentTypeT::typeId);
+  }
+  return this->component;
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentTypeT *ComponentHandle<ComponentTypeT>::operator->() const
+{
+  return this->Get();
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentHandle<ComponentTypeT>::operator bool() const
+{
+  return nullptr != this->Get();
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+Entity ComponentHandle<ComponentTypeT>::Owner() const
+{
+  return this->entity;
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void ComponentHandle<ComponentTypeT>::Resolve() const
+{
+  using BareT = std::remove_const_t<ComponentTypeT>;
+  this->generation = this->ecm->ComponentGeneration(BareT::typeId);
+  if (nullptr != this->generation)
+    this->resolvedGeneration = *this->generation;
+  this->component = this->ecm->template Component<BareT>(this->entity);
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_DETAIL_ENTITYCOMMANDBUFFER_HH_
+#define IGNITION_GAZEBO_DETAIL_ENTITYCOMMANDBUFFER_HH_
+
+#include "ignition/gazebo/EntityCommandBuffer.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityCommandBuffer::CreateComponent(const Entity _entity,
+    const ComponentTypeT &_data)
+{
+  this->Record([_entity, _data](EntityComponentManager &_ecm)
+  {
+    _ecm.CreateComponent(_entity, _data);
+  });
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityCommandBuffer::RemoveComponent(const Entity _entity)
+{
+  this->RemoveComponent(_entity, ComponentTypeT::typeId);
+}
+}
+}
+}
+
+#endif
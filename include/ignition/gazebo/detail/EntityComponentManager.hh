@@ -17,6 +17,9 @@
 #ifndef IGNITION_GAZEBO_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 #define IGNITION_GAZEBO_DETAIL_ENTITYCOMPONENTMANAGER_HH_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -104,6 +107,39 @@ ComponentTypeT *EntityComponentManager::CreateComponent(const Entity _entity,
   return comp;
 }
 
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityComponentManager::CreateComponents(
+    const std::vector<Entity> &_entities,
+    const std::vector<ComponentTypeT> &_data)
+{
+  if (_entities.size() != _data.size())
+  {
+    ignerr << "Trying to create [" << _data.size() << "] components of type ["
+           << ComponentTypeT::typeId << "] for [" << _entities.size()
+           << "] entities. No components will be created." << std::endl;
+    return;
+  }
+
+  this->BeginBatchCreation();
+  this->ReserveComponents(ComponentTypeT::typeId, _entities.size());
+  for (std::size_t i = 0; i < _entities.size(); ++i)
+    this->CreateComponent(_entities[i], _data[i]);
+  this->EndBatchCreation();
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+void EntityComponentManager::CreateComponents(
+    const std::vector<Entity> &_entities, const ComponentTypeT &_data)
+{
+  this->BeginBatchCreation();
+  this->ReserveComponents(ComponentTypeT::typeId, _entities.size());
+  for (const Entity entity : _entities)
+    this->CreateComponent(entity, _data);
+  this->EndBatchCreation();
+}
+
 //////////////////////////////////////////////////
 template<typename ComponentTypeT>
 const ComponentTypeT *EntityComponentManager::Component(
@@ -127,6 +163,22 @@ ComponentTypeT *EntityComponentManager::Component(const Entity _entity)
       this->ComponentImplementation(_entity, typeId));
 }
 
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentHandle<const ComponentTypeT> EntityComponentManager::Handle(
+    const Entity _entity) const
+{
+  return ComponentHandle<const ComponentTypeT>(*this, _entity);
+}
+
+//////////////////////////////////////////////////
+template<typename ComponentTypeT>
+ComponentHandle<ComponentTypeT> EntityComponentManager::Handle(
+    const Entity _entity)
+{
+  return ComponentHandle<ComponentTypeT>(*this, _entity);
+}
+
 //////////////////////////////////////////////////
 template<typename ComponentTypeT>
 const ComponentTypeT *EntityComponentManager::Component(
@@ -183,7 +235,11 @@ bool EntityComponentManager::SetComponentData(const Entity _entity,
     return true;
   }
 
-  return comp->SetData(_data, CompareData<typename ComponentTypeT::Type>);
+  if (!comp->SetData(_data, CompareData<typename ComponentTypeT::Type>))
+    return false;
+
+  this->StampChange(_entity, ComponentTypeT::typeId);
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -206,74 +262,107 @@ ComponentTypeT *EntityComponentManager::First()
 
 //////////////////////////////////////////////////
 template<typename ...ComponentTypeTs>
-Entity EntityComponentManager::EntityByComponents(
-    const ComponentTypeTs &..._desiredComponents) const
+bool EntityComponentManager::MatchesComponentValues(
+    const Entity _entity, const ComponentTypeTs &..._desiredComponents) const
 {
-  // Get all entities which have components of the desired types
-  const auto &view = this->FindView<ComponentTypeTs...>();
+  bool different{false};
 
-  // Iterate over entities
-  Entity result{kNullEntity};
-  for (const Entity entity : view->Entities())
+  // Iterate over desired components, comparing each of them to the
+  // equivalent component in the entity.
+  ForEach([&](const auto &_desiredComponent)
   {
-    bool different{false};
-
-    // Iterate over desired components, comparing each of them to the
-    // equivalent component in the entity.
-    ForEach([&](const auto &_desiredComponent)
-    {
-      auto entityComponent = this->Component<
-          std::remove_cv_t<std::remove_reference_t<
-              decltype(_desiredComponent)>>>(entity);
+    if (different)
+      return;
 
-      if (*entityComponent != _desiredComponent)
-      {
-        different = true;
-      }
-    }, _desiredComponents...);
+    auto entityComponent = this->Component<
+        std::remove_cv_t<std::remove_reference_t<
+            decltype(_desiredComponent)>>>(_entity);
 
-    if (!different)
+    if (nullptr == entityComponent || *entityComponent != _desiredComponent)
     {
-      result = entity;
-      break;
+      different = true;
     }
-  }
+  }, _desiredComponents...);
 
-  return result;
+  return !different;
 }
 
 //////////////////////////////////////////////////
 template<typename ...ComponentTypeTs>
-std::vector<Entity> EntityComponentManager::EntitiesByComponents(
+std::optional<std::vector<Entity>> EntityComponentManager::IndexedCandidates(
+    const ComponentTypeTs &..._desiredComponents) const
+{
+  std::optional<std::vector<Entity>> candidates;
+  ForEach([&](const auto &_desiredComponent)
+  {
+    if (candidates)
+      return;
+
+    std::vector<Entity> entities;
+    if (this->IndexedEntities(_desiredComponent, entities))
+      candidates = std::move(entities);
+  }, _desiredComponents...);
+
+  return candidates;
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+Entity EntityComponentManager::EntityByComponents(
     const ComponentTypeTs &..._desiredComponents) const
 {
+  // Only visit the entities which match an indexed component, if any
+  auto candidates = this->IndexedCandidates(_desiredComponents...);
+  if (candidates)
+  {
+    for (const Entity entity : *candidates)
+    {
+      if (this->MatchesComponentValues(entity, _desiredComponents...))
+        return entity;
+    }
+    return kNullEntity;
+  }
+
   // Get all entities which have components of the desired types
   const auto &view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over entities
-  std::vector<Entity> result;
-  for (const Entity entity : view->Entities())
+  for (const Entity entity : view->PackedEntities())
   {
-    bool different{false};
+    if (this->MatchesComponentValues(entity, _desiredComponents...))
+      return entity;
+  }
 
-    // Iterate over desired components, comparing each of them to the
-    // equivalent component in the entity.
-    ForEach([&](const auto &_desiredComponent)
-    {
-      auto entityComponent = this->Component<
-          std::remove_cv_t<std::remove_reference_t<
-              decltype(_desiredComponent)>>>(entity);
+  return kNullEntity;
+}
 
-      if (*entityComponent != _desiredComponent)
-      {
-        different = true;
-      }
-    }, _desiredComponents...);
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+std::vector<Entity> EntityComponentManager::EntitiesByComponents(
+    const ComponentTypeTs &..._desiredComponents) const
+{
+  std::vector<Entity> result;
 
-    if (!different)
+  // Only visit the entities which match an indexed component, if any
+  auto candidates = this->IndexedCandidates(_desiredComponents...);
+  if (candidates)
+  {
+    for (const Entity entity : *candidates)
     {
-      result.push_back(entity);
+      if (this->MatchesComponentValues(entity, _desiredComponents...))
+        result.push_back(entity);
     }
+    return result;
+  }
+
+  // Get all entities which have components of the desired types
+  const auto &view = this->FindView<ComponentTypeTs...>();
+
+  // Iterate over entities
+  for (const Entity entity : view->PackedEntities())
+  {
+    if (this->MatchesComponentValues(entity, _desiredComponents...))
+      result.push_back(entity);
   }
 
   return result;
@@ -288,13 +377,13 @@ std::vector<Entity> EntityComponentManager::ChildrenByComponents(Entity _parent,
   const auto &view = this->FindView<ComponentTypeTs...>();
 
   // Get all entities which are immediate children of the given parent
-  auto children = this->Entities().AdjacentsFrom(_parent);
+  const auto children = this->Children(_parent);
 
   // Iterate over entities
   std::vector<Entity> result;
-  for (const Entity entity : view->Entities())
+  for (const Entity entity : view->PackedEntities())
   {
-    if (children.find(entity) == children.end())
+    if (!std::binary_search(children.begin(), children.end(), entity))
     {
       continue;
     }
@@ -335,9 +424,8 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
 {
-  for (const auto &vertex : this->Entities().Vertices())
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
     auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
     if (this->EntityMatches(entity, types))
@@ -356,9 +444,8 @@ template<typename ...ComponentTypeTs>
 void EntityComponentManager::EachNoCache(typename identity<std::function<
     bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
 {
-  for (const auto &vertex : this->Entities().Vertices())
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
     auto types = std::set<ComponentTypeId>{ComponentTypeTs::typeId...};
 
     if (this->EntityMatches(entity, types))
@@ -384,13 +471,13 @@ namespace detail
 /// _data.
 /// \param[in] _f The callback function
 /// \param[in] _entity The entity associated with the components.
-/// \param[in] _data A vector of component pointers that will be expanded to
+/// \param[in] _data An array of component pointers that will be expanded to
 /// become the arguments of the callback function _f.
 /// \return The value of return by the function _f.
 template <typename... ComponentTypeTs, typename FuncT, typename BaseComponentT,
           std::size_t... Is>
 constexpr bool applyFunctionImpl(const FuncT &_f, const Entity &_entity,
-                       const std::vector<BaseComponentT *> &_data,
+                       BaseComponentT *const *_data,
                        std::index_sequence<Is...>)
 {
   return _f(_entity, static_cast<ComponentTypeTs *>(_data[Is])...);
@@ -404,58 +491,317 @@ constexpr bool applyFunctionImpl(const FuncT &_f, const Entity &_entity,
 /// \tparam BaseComponentT Either "BaseComponent" or "const BaseComponent"
 /// \param[in] _f The callback function
 /// \param[in] _entity The entity associated with the components.
-/// \param[in] _data A vector of component pointers that will be expanded to
+/// \param[in] _data An array of component pointers that will be expanded to
 /// become the arguments of the callback function _f.
 /// \return The value of return by the function _f.
 template <typename... ComponentTypeTs, typename FuncT, typename BaseComponentT>
 constexpr bool applyFunction(const FuncT &_f, const Entity &_entity,
-                   const std::vector<BaseComponentT *> &_data)
+                   BaseComponentT *const *_data)
 {
   return applyFunctionImpl<ComponentTypeTs...>(
       _f, _entity, _data, std::index_sequence_for<ComponentTypeTs...>{});
 }
+
+/// \brief Helper template to call the callback of a query, after deducing
+/// the component types passed to it.
+/// \tparam Const True if the components are passed as const.
+/// \tparam FuncT The type of the callback function.
+/// \tparam BaseComponentT Either "BaseComponent" or "const BaseComponent"
+/// \tparam Cs The component types passed to the callback.
+/// \param[in] _f The callback function
+/// \param[in] _entity The entity associated with the components.
+/// \param[in] _data An array of component pointers that will be expanded to
+/// become the arguments of the callback function _f.
+/// \return The value of return by the function _f.
+template <bool Const, typename FuncT, typename BaseComponentT,
+          typename... Cs>
+constexpr bool applyQueryImpl(std::tuple<Cs...> *, const FuncT &_f,
+                   const Entity &_entity, BaseComponentT *const *_data)
+{
+  return applyFunction<std::conditional_t<Const, const Cs, Cs>...>(
+      _f, _entity, _data);
+}
+
+/// \brief Helper template to call the callback of a query with the
+/// components in the _data array expanded as arguments. Components of
+/// excluded types aren't part of _data.
+/// \tparam Const True if the components are passed as const.
+/// \tparam ComponentTypeTs The types listed in the query, including filters.
+/// \tparam FuncT The type of the callback function.
+/// \tparam BaseComponentT Either "BaseComponent" or "const BaseComponent"
+/// \param[in] _f The callback function
+/// \param[in] _entity The entity associated with the components.
+/// \param[in] _data An array of component pointers that will be expanded to
+/// become the arguments of the callback function _f.
+/// \return The value of return by the function _f.
+template <bool Const, typename... ComponentTypeTs, typename FuncT,
+          typename BaseComponentT>
+constexpr bool applyQuery(const FuncT &_f, const Entity &_entity,
+                   BaseComponentT *const *_data)
+{
+  return applyQueryImpl<Const>(
+      static_cast<QueryComponents<ComponentTypeTs...> *>(nullptr),
+      _f, _entity, _data);
+}
 }  // namespace detail
 
 //////////////////////////////////////////////////
 template<typename ...ComponentTypeTs>
-void EntityComponentManager::Each(typename identity<std::function<
-    bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+void EntityComponentManager::Each(
+    detail::QueryCallback<true, ComponentTypeTs...> _f) const
 {
   // Get the view. This will create a new view if one does not already
   // exist.
   auto view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over the entities in the view, and invoke the callback
-  // function.
-  for (const Entity entity : view->Entities())
+  // function. Entities and their components are stored contiguously, so this
+  // doesn't need any lookup.
+  const auto &state = view->State();
+  const auto &entities = state.packedEntities;
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
+    const Entity entity = entities[i];
+    if (!detail::applyQuery<true, ComponentTypeTs...>(_f, entity,
+        state.ComponentDataAt(i)))
     {
       break;
     }
+    i = state.NextIndex(i, entity);
   }
 }
 
 //////////////////////////////////////////////////
 template<typename ...ComponentTypeTs>
-void EntityComponentManager::Each(typename identity<std::function<
-    bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
+void EntityComponentManager::Each(
+    detail::QueryCallback<false, ComponentTypeTs...> _f)
 {
   // Get the view. This will create a new view if one does not already
   // exist.
   auto view = this->FindView<ComponentTypeTs...>();
 
   // Iterate over the entities in the view, and invoke the callback
-  // function.
-  for (const Entity entity : view->Entities())
+  // function. Entities and their components are stored contiguously, so this
+  // doesn't need any lookup.
+  const auto &state = view->State();
+  const auto &entities = state.packedEntities;
+  for (std::size_t i = 0; i < entities.size();)
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<ComponentTypeTs...>(_f, entity, data))
+    const Entity entity = entities[i];
+    if (!detail::applyQuery<false, ComponentTypeTs...>(_f, entity,
+        state.ComponentDataAt(i)))
     {
       break;
     }
+    i = state.NextIndex(i, entity);
   }
+
+  // The callback may have modified the components in place
+  (this->InvalidateCachesForType(ComponentTypeTs::typeId), ...);
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(
+    detail::QueryCallback<true, ComponentTypeTs...> _f) const
+{
+  // Get the view and make sure all pending entities are added to it before
+  // splitting the work, since the view can't be modified concurrently.
+  auto view = this->FindView<ComponentTypeTs...>();
+  const auto &state = view->State();
+  const auto &entities = state.packedEntities;
+
+  std::atomic<bool> stop{false};
+  this->ParallelFor(entities.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end && !stop; ++i)
+    {
+      if (!detail::applyQuery<true, ComponentTypeTs...>(_f, entities[i],
+          state.ComponentDataAt(i)))
+      {
+        stop = true;
+      }
+    }
+  });
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachParallel(
+    detail::QueryCallback<false, ComponentTypeTs...> _f)
+{
+  // Get the view and make sure all pending entities are added to it before
+  // splitting the work, since the view can't be modified concurrently.
+  auto view = this->FindView<ComponentTypeTs...>();
+  const auto &state = view->State();
+  const auto &entities = state.packedEntities;
+
+  std::atomic<bool> stop{false};
+  this->ParallelFor(entities.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end && !stop; ++i)
+    {
+      if (!detail::applyQuery<false, ComponentTypeTs...>(_f, entities[i],
+          state.ComponentDataAt(i)))
+      {
+        stop = true;
+      }
+    }
+  });
+
+  // The callback may have modified the components in place
+  (this->InvalidateCachesForType(ComponentTypeTs::typeId), ...);
+}
+
+namespace detail
+{
+/// \brief Number of entities whose data is packed together by EachSpan.
+/// Chunks of this size fit in the L1 cache for small component types.
+constexpr std::size_t kEachSpanChunkSize{256u};
+
+/// \brief Helper template which gathers the data of the components of a
+/// view in chunks, calls a function with each chunk and optionally copies
+/// the data back into the components.
+/// \tparam WriteBack Whether the data is copied back into the components.
+/// \tparam ComponentTypeTs The component types of the view.
+/// \tparam FuncT The type of the function.
+/// \tparam Is Index sequence used to iterate over the component types.
+/// \param[in] _view View holding the components.
+/// \param[in] _f Function called with each chunk.
+template <bool WriteBack, typename... ComponentTypeTs, typename FuncT,
+          std::size_t... Is>
+void eachSpanImpl(const View &_view, FuncT &_f, std::index_sequence<Is...>)
+{
+  static_assert(sizeof...(ComponentTypeTs) > 0u,
+      "EachSpan needs at least one component type");
+  static_assert(((!std::is_same_v<typename ComponentTypeTs::Type, bool>) &&
+      ...), "EachSpan can't pack components which hold a bool");
+
+  const auto &state = _view.State();
+  const auto &entities = state.packedEntities;
+  if (entities.empty())
+    return;
+
+  std::tuple<std::vector<typename ComponentTypeTs::Type>...> buffers;
+  const std::size_t reserve = std::min(kEachSpanChunkSize, entities.size());
+  (std::get<Is>(buffers).reserve(reserve), ...);
+
+  for (std::size_t begin = 0; begin < entities.size();
+       begin += kEachSpanChunkSize)
+  {
+    const std::size_t end =
+        std::min(begin + kEachSpanChunkSize, entities.size());
+
+    (std::get<Is>(buffers).clear(), ...);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      auto data = state.ComponentDataAt(i);
+      (std::get<Is>(buffers).push_back(
+          static_cast<const ComponentTypeTs *>(data[Is])->Data()), ...);
+    }
+
+    if constexpr (WriteBack)
+    {
+      _f(end - begin, entities.data() + begin,
+          std::get<Is>(buffers).data()...);
+
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        auto data = state.ComponentDataAt(i);
+        ((static_cast<ComponentTypeTs *>(data[Is])->Data() =
+            std::move(std::get<Is>(buffers)[i - begin])), ...);
+      }
+    }
+    else
+    {
+      _f(end - begin, entities.data() + begin,
+          static_cast<const typename ComponentTypeTs::Type *>(
+              std::get<Is>(buffers).data())...);
+    }
+  }
+}
+}  // namespace detail
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs, typename FuncT>
+void EntityComponentManager::EachSpan(FuncT &&_f)
+{
+  // Functions which take the data as const pointers don't need it to be
+  // copied back
+  constexpr bool writeBack = !std::is_invocable_v<FuncT &, std::size_t,
+      const Entity *, const typename ComponentTypeTs::Type *...>;
+
+  auto view = this->FindView<ComponentTypeTs...>();
+  detail::eachSpanImpl<writeBack, ComponentTypeTs...>(*view, _f,
+      std::index_sequence_for<ComponentTypeTs...>{});
+
+  // The data copied back may have changed
+  if constexpr (writeBack)
+    (this->InvalidateCachesForType(ComponentTypeTs::typeId), ...);
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs, typename FuncT>
+void EntityComponentManager::EachSpan(FuncT &&_f) const
+{
+  auto view = this->FindView<ComponentTypeTs...>();
+  detail::eachSpanImpl<false, ComponentTypeTs...>(*view, _f,
+      std::index_sequence_for<ComponentTypeTs...>{});
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachChangedSince(uint64_t _tick,
+    detail::QueryCallback<true, ComponentTypeTs...> _f) const
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  auto view = this->FindView<ComponentTypeTs...>();
+
+  // Only visit the changed entities which are part of the view
+  const auto &state = view->State();
+  for (const Entity entity : this->EntitiesChangedSince(_tick,
+        detail::QueryComponentTypeIds<ComponentTypeTs...>()))
+  {
+    const auto data = state.ComponentDataFor(entity);
+    if (nullptr == data)
+      continue;
+
+    if (!detail::applyQuery<true, ComponentTypeTs...>(_f, entity, data))
+    {
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename ...ComponentTypeTs>
+void EntityComponentManager::EachChangedSince(uint64_t _tick,
+    detail::QueryCallback<false, ComponentTypeTs...> _f)
+{
+  // Get the view. This will create a new view if one does not already
+  // exist.
+  auto view = this->FindView<ComponentTypeTs...>();
+
+  // Only visit the changed entities which are part of the view
+  const auto &state = view->State();
+  for (const Entity entity : this->EntitiesChangedSince(_tick,
+        detail::QueryComponentTypeIds<ComponentTypeTs...>()))
+  {
+    const auto data = state.ComponentDataFor(entity);
+    if (nullptr == data)
+      continue;
+
+    if (!detail::applyQuery<false, ComponentTypeTs...>(_f, entity, data))
+    {
+      break;
+    }
+  }
+
+  // The callback may have modified the components in place
+  (this->InvalidateCachesForType(ComponentTypeTs::typeId), ...);
 }
 
 //////////////////////////////////////////////////
@@ -468,42 +814,61 @@ void EntityComponentManager::ForEach(Function _f,
 
 //////////////////////////////////////////////////
 template <typename... ComponentTypeTs>
-void EntityComponentManager::EachNew(typename identity<std::function<
-    bool(const Entity &_entity, ComponentTypeTs *...)>>::type _f)
+void EntityComponentManager::EachNew(
+    detail::QueryCallback<false, ComponentTypeTs...> _f)
 {
+  // Views only hold new entities while the ECM has newly created entities,
+  // so skip looking up the view in the common case where there are none.
+  if (!this->HasNewEntities())
+    return;
+
   // Get the view. This will create a new view if one does not already
   // exist.
   auto view = this->FindView<ComponentTypeTs...>();
 
-  // Iterate over the entities in the view and in the newly created
-  // entities list, and invoke the callback
-  // function.
+  // Iterate over the view's queue of newly created entities, and invoke the
+  // callback function.
+  const auto &state = view->State();
   for (const Entity entity : view->NewEntities())
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<ComponentTypeTs...>(_f, entity, data))
+    const auto data = state.ComponentDataFor(entity);
+    if (nullptr == data)
+      continue;
+
+    if (!detail::applyQuery<false, ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
   }
+
+  // The callback may have modified the components in place
+  (this->InvalidateCachesForType(ComponentTypeTs::typeId), ...);
 }
 
 //////////////////////////////////////////////////
 template <typename... ComponentTypeTs>
-void EntityComponentManager::EachNew(typename identity<std::function<
-    bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+void EntityComponentManager::EachNew(
+    detail::QueryCallback<true, ComponentTypeTs...> _f) const
 {
+  // Views only hold new entities while the ECM has newly created entities,
+  // so skip looking up the view in the common case where there are none.
+  if (!this->HasNewEntities())
+    return;
+
   // Get the view. This will create a new view if one does not already
   // exist.
   auto view = this->FindView<ComponentTypeTs...>();
 
-  // Iterate over the entities in the view and in the newly created
-  // entities list, and invoke the callback
-  // function.
+  // Iterate over the view's queue of newly created entities, and invoke the
+  // callback function.
+  const auto &state = view->State();
   for (const Entity entity : view->NewEntities())
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
+    const auto data = state.ComponentDataFor(entity);
+    if (nullptr == data)
+      continue;
+
+    if (!detail::applyQuery<true, ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
@@ -512,20 +877,29 @@ void EntityComponentManager::EachNew(typename identity<std::function<
 
 //////////////////////////////////////////////////
 template<typename ...ComponentTypeTs>
-void EntityComponentManager::EachRemoved(typename identity<std::function<
-    bool(const Entity &_entity, const ComponentTypeTs *...)>>::type _f) const
+void EntityComponentManager::EachRemoved(
+    detail::QueryCallback<true, ComponentTypeTs...> _f) const
 {
+  // Views only hold entities to be removed while the ECM has removal
+  // requests, so skip looking up the view in the common case where there are
+  // none.
+  if (!this->HasEntitiesMarkedForRemoval())
+    return;
+
   // Get the view. This will create a new view if one does not already
   // exist.
   auto view = this->FindView<ComponentTypeTs...>();
 
-  // Iterate over the entities in the view and in the newly created
-  // entities list, and invoke the callback
-  // function.
+  // Iterate over the view's queue of entities to be removed, and invoke the
+  // callback function.
+  const auto &state = view->State();
   for (const Entity entity : view->ToRemoveEntities())
   {
-    const auto &data = view->EntityComponentData(entity);
-    if (!detail::applyFunction<const ComponentTypeTs...>(_f, entity, data))
+    const auto data = state.ComponentDataFor(entity);
+    if (nullptr == data)
+      continue;
+
+    if (!detail::applyQuery<true, ComponentTypeTs...>(_f, entity, data))
     {
       break;
     }
@@ -536,9 +910,35 @@ void EntityComponentManager::EachRemoved(typename identity<std::function<
 template<typename ...ComponentTypeTs>
 detail::View *EntityComponentManager::FindView() const
 {
-  auto viewKey = std::vector<ComponentTypeId>{ComponentTypeTs::typeId...};
+  static_assert(detail::kQueryRequiredCount<ComponentTypeTs...> > 0u,
+      "A query needs at least one component type which isn't wrapped in "
+      "Without or Optional");
+
+  // Pointers to the components of an entity which are passed to callbacks.
+  // Optional components which the entity doesn't have are null.
+  constexpr std::size_t kStride =
+      std::tuple_size_v<detail::QueryComponents<ComponentTypeTs...>>;
+  auto self = const_cast<EntityComponentManager *>(this);
+  auto componentData = [self](const Entity _entity)
+  {
+    std::array<components::BaseComponent *, kStride> data;
+    std::size_t i{0};
+    ((detail::QueryTerm<ComponentTypeTs>::kExcluded ? void() :
+        void(data[i++] = self->ComponentImplementation(_entity,
+            detail::QueryTerm<ComponentTypeTs>::ComponentType::typeId))), ...);
+    return data;
+  };
 
-  auto baseViewMutexPair = this->FindView(viewKey);
+  // Each list of component types has its own slot, so the view is usually
+  // found without building its key or locking the views
+  const std::size_t slot = detail::QueryViewSlot<ComponentTypeTs...>();
+  auto baseViewMutexPair = this->CachedView(slot);
+  std::vector<ComponentTypeId> viewKey;
+  if (nullptr == baseViewMutexPair.first)
+  {
+    viewKey = detail::QueryViewKey<ComponentTypeTs...>();
+    baseViewMutexPair = this->FindView(viewKey, slot);
+  }
   auto baseViewPtr = baseViewMutexPair.first;
   if (nullptr != baseViewPtr)
   {
@@ -564,39 +964,37 @@ detail::View *EntityComponentManager::FindView() const
     // add any new entities to the view before using it
     for (const auto &[entity, isNew] : view->ToAddEntities())
     {
-      view->AddEntityWithConstComps(entity, isNew,
-          this->Component<ComponentTypeTs>(entity)...);
-      view->AddEntityWithComps(entity, isNew,
-          const_cast<EntityComponentManager*>(this)->Component<ComponentTypeTs>(
-            entity)...);
+      view->AddEntityWithData(entity, isNew, componentData(entity).data());
     }
     view->ClearToAddEntities();
 
     return view;
   }
 
-  // create a new view if one wasn't found
-  detail::View view(std::set<ComponentTypeId>{ComponentTypeTs::typeId...});
-
-  for (const auto &vertex : this->Entities().Vertices())
+  // create a new view if one wasn't found. Filters are applied here and
+  // whenever a filtered component changes, so iterating over the view
+  // doesn't need to check them.
+  std::set<ComponentTypeId> required;
+  std::set<ComponentTypeId> excluded;
+  std::set<ComponentTypeId> optional;
+  detail::QueryComponentSets<ComponentTypeTs...>(required, excluded,
+      optional);
+  auto view = std::make_unique<detail::View>(required, excluded, optional,
+      kStride);
+
+  for (const Entity entity : this->AllEntities())
   {
-    Entity entity = vertex.first;
-
-    // only add entities to the view that have all of the components in viewKey
-    if (!this->EntityMatches(entity, view.ComponentTypes()))
+    // only add entities to the view that match its component types
+    if (!this->EntityMatchesView(entity, *view))
       continue;
 
-    view.AddEntityWithConstComps(entity, this->IsNewEntity(entity),
-        this->Component<ComponentTypeTs>(entity)...);
-    view.AddEntityWithComps(entity, this->IsNewEntity(entity),
-        const_cast<EntityComponentManager*>(this)->Component<ComponentTypeTs>(
-            entity)...);
+    view->AddEntityWithData(entity, this->IsNewEntity(entity),
+        componentData(entity).data());
     if (this->IsMarkedForRemoval(entity))
-      view.MarkEntityToRemove(entity);
+      view->MarkEntityToRemove(entity);
   }
 
-  baseViewPtr = this->AddView(viewKey,
-      std::make_unique<detail::View>(std::move(view)));
+  baseViewPtr = this->AddView(viewKey, std::move(view), slot);
   return static_cast<detail::View *>(baseViewPtr);
 }
 
@@ -17,8 +17,11 @@
 #ifndef IGNITION_GAZEBO_DETAIL_VIEW_HH_
 #define IGNITION_GAZEBO_DETAIL_VIEW_HH_
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <set>
-#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -58,26 +61,81 @@ class IGNITION_GAZEBO_VISIBLE View : public BaseView
   /// \param[in] _compIds a set of IDs of the components cached by this View.
   public: explicit View(const std::set<ComponentTypeId> &_compIds);
 
+  /// \brief Constructor for a view with filters.
+  /// \param[in] _compIds IDs of the components required by this View.
+  /// \param[in] _excludedIds IDs of the components that entities in this
+  /// View must not have.
+  /// \param[in] _optionalIds IDs of the components cached by this View for
+  /// the entities that have them.
+  /// \param[in] _stride Number of component pointers held per entity, which
+  /// is the number of required and optional components of the query.
+  public: View(const std::set<ComponentTypeId> &_compIds,
+              const std::set<ComponentTypeId> &_excludedIds,
+              const std::set<ComponentTypeId> &_optionalIds,
+              const std::size_t _stride);
+
   /// \brief Documentation inherited
   public: bool HasCachedComponentData(const Entity _entity) const override;
 
   /// \brief Documentation inherited
   public: bool RemoveEntity(const Entity _entity) override;
 
+  /// \brief Remove many entities from the view at once. This is faster than
+  /// calling RemoveEntity for each of them, because the view's packed
+  /// arrays are compacted only once.
+  /// \param[in] _entities The entities to remove, sorted by id. Entities
+  /// which aren't in the view are ignored.
+  /// \sa BaseView::RemoveEntities
+  public: void RemoveEntities(const std::vector<Entity> &_entities);
+
   /// \brief Get an entity and its component data. It is assumed that the entity
   /// being requested exists in the view.
   /// \param[_in] _entity The entity
   /// \return The entity and its component data. Const pointers to the component
-  /// data are returned.
-  public: const ConstComponentData &EntityComponentConstData(
+  /// data are returned. The vector is a copy of the view's data, so prefer
+  /// ComponentDataFor, which doesn't copy.
+  /// \throws std::out_of_range if the entity isn't part of the view.
+  public: ConstComponentData EntityComponentConstData(
               const Entity _entity) const;
 
   /// \brief Get an entity and its component data. It is assumed that the entity
   /// being requested exists in the view.
   /// \param[_in] _entity The entity
   /// \return The entity and its component data. Mutable pointers to the
-  /// component data are returned.
-  public: const ComponentData &EntityComponentData(const Entity _entity) const;
+  /// component data are returned. The vector is a copy of the view's data,
+  /// so prefer ComponentDataFor, which doesn't copy.
+  /// \throws std::out_of_range if the entity isn't part of the view.
+  public: ComponentData EntityComponentData(const Entity _entity) const;
+
+  /// \brief Get the component data of an entity in the view.
+  /// \param[_in] _entity The entity
+  /// \return Pointer to the first of the entity's components, followed by
+  /// the rest of its components in the order of the view's component types.
+  /// Null if the entity isn't part of the view.
+  public: components::BaseComponent *const *ComponentDataFor(
+              const Entity _entity) const;
+
+  /// \brief Get the component data of the entity at a given index of
+  /// PackedEntities(). Loops over many entities should get the State() once
+  /// and use ViewState::ComponentDataAt instead.
+  /// \param[_in] _index Index of the entity in PackedEntities(). It is
+  /// assumed to be in range.
+  /// \return Pointer to the first of the entity's components, followed by
+  /// the rest of its components in the order of the view's component types.
+  public: components::BaseComponent *const *ComponentDataAt(
+              const std::size_t _index) const;
+
+  /// \brief Get the index in PackedEntities() of the entity that follows a
+  /// given entity. This allows iterating over the view by index while the
+  /// view is modified, for example when a callback removes a component and
+  /// the entity is moved out of the view, shifting the entities after it.
+  /// \param[in] _index Index at which _entity was visited.
+  /// \param[in] _entity The visited entity.
+  /// \return Index of the next entity to visit, which may be equal to the
+  /// size of PackedEntities() if there are no more entities.
+  /// \sa ViewState::NextIndex
+  public: std::size_t NextIndex(const std::size_t _index,
+              const Entity _entity) const;
 
   /// \brief Add an entity with its component data to the view. It is assumed
   /// that the entity to be added does not already exist in the view.
@@ -109,6 +167,16 @@ class IGNITION_GAZEBO_VISIBLE View : public BaseView
           void AddEntityWithComps(const Entity &_entity, const bool _new,
               ComponentTypeTs*... _compPtrs);
 
+  /// \brief Add an entity with its component data to the view. It is assumed
+  /// that the entity to be added does not already exist in the view.
+  /// \param[in] _entity The entity
+  /// \param[in] _new Whether to add the entity to the list of new entities.
+  /// \param[in] _data Pointers to the entity's components, in the order in
+  /// which they're passed to callbacks. There must be one per component
+  /// held by the view.
+  public: void AddEntityWithData(const Entity _entity, const bool _new,
+              components::BaseComponent *const *_data);
+
   /// \brief Documentation inherited
   public: bool NotifyComponentAddition(const Entity _entity, bool _newEntity,
               const ComponentTypeId _typeId) override;
@@ -120,10 +188,41 @@ class IGNITION_GAZEBO_VISIBLE View : public BaseView
   /// \brief Documentation inherited
   public: void Reset() override;
 
-  /// \brief A map of entities to their component data. Since tuples are defined
-  /// at compile time, we need separate containers that have tuples for both
-  /// non-const and const component pointers (calls to ECM::Each can have a
-  /// method signature that uses either non-const or const pointers)
+  /// \brief Estimate the memory used by the view's own data structures,
+  /// not counting the components it points to.
+  /// \return Number of bytes.
+  /// \sa BaseView::MemoryUsage
+  public: std::size_t MemoryUsage() const;
+
+  /// \brief Shrink the view's data structures if they use much less memory
+  /// than they hold, such as after many entities were removed.
+  /// \sa BaseView::Compact
+  public: void Compact();
+
+  /// \brief Insert an entity and its component data in `entities` and in
+  /// the packed arrays of the view's state, keeping them sorted by entity.
+  /// \param[in] _state The view's state.
+  /// \param[in] _entity The entity
+  /// \param[in] _data Pointers to the entity's components. There must be
+  /// `stride` of them.
+  private: void InsertValid(ViewState &_state, const Entity _entity,
+               components::BaseComponent *const *_data);
+
+  /// \brief Add or update an entity's component data through one of
+  /// AddEntityWithComps and AddEntityWithConstComps. The data is cached once
+  /// both were called, see ViewState::partialData.
+  /// \param[in] _entity The entity
+  /// \param[in] _new Whether to add the entity to the list of new entities.
+  /// \param[in] _data Pointers to the entity's components. There must be
+  /// `stride` of them.
+  /// \param[in] _const Whether the data was given as const pointers.
+  private: void AddEntityWithPartialData(const Entity _entity,
+               const bool _new, components::BaseComponent *const *_data,
+               const bool _const);
+
+  /// \brief Not used. The component data of the entities in the view is
+  /// packed in its state, see ViewState::validData. These members are
+  /// kept so that the layout of the class doesn't change.
   private: std::unordered_map<Entity, ComponentData> validData;
   private: std::unordered_map<Entity, ConstComponentData> validConstData;
 
@@ -140,12 +239,16 @@ class IGNITION_GAZEBO_VISIBLE View : public BaseView
   /// The reason for moving entities with missing components to invalidData
   /// instead of completely deleting them from the view is because if components
   /// are added back later and the entity needs to be re-added to the view,
-  /// tuple creation can be costly. So, this approach is used instead to
-  /// maintain runtime performance (the tradeoff of mainting performance is
-  /// increased complexity and memory usage).
+  /// looking up the components again can be costly. So, this approach is used
+  /// instead to maintain runtime performance (the tradeoff of mainting
+  /// performance is increased complexity and memory usage).
   ///
   /// \sa missingCompTracker
   private: std::unordered_map<Entity, ComponentData> invalidData;
+
+  /// \brief Not used, since invalidData holds mutable pointers which are
+  /// also used for const access. Kept so that the layout of the class
+  /// doesn't change.
   private: std::unordered_map<Entity, ConstComponentData> invalidConstData;
 
   /// \brief A map that keeps track of which component types for entities in
@@ -165,11 +268,20 @@ template <typename... ComponentTypeTs>
 void View::AddEntityWithConstComps(const Entity &_entity, const bool _new,
                                    const ComponentTypeTs *... _compPtrs)
 {
-  this->validConstData[_entity] =
-      std::vector<const components::BaseComponent *>{_compPtrs...};
-  this->entities.insert(_entity);
-  if (_new)
-    this->newEntities.insert(_entity);
+  // The view holds a single copy of the data, with mutable pointers which
+  // const callbacks only read
+  const std::size_t stride = this->State().stride;
+  if (sizeof...(ComponentTypeTs) != stride)
+  {
+    ignerr << "Trying to add entity [" << _entity << "] to a view of "
+           << stride << " component types with "
+           << sizeof...(ComponentTypeTs) << " components." << std::endl;
+    return;
+  }
+
+  const std::array<components::BaseComponent *, sizeof...(ComponentTypeTs)>
+      data{const_cast<ComponentTypeTs *>(_compPtrs)...};
+  this->AddEntityWithPartialData(_entity, _new, data.data(), true);
 }
 
 //////////////////////////////////////////////////
@@ -177,11 +289,18 @@ template <typename... ComponentTypeTs>
 void View::AddEntityWithComps(const Entity &_entity, const bool _new,
                               ComponentTypeTs *... _compPtrs)
 {
-  this->validData[_entity] =
-      std::vector<components::BaseComponent *>{_compPtrs...};
-  this->entities.insert(_entity);
-  if (_new)
-    this->newEntities.insert(_entity);
+  const std::size_t stride = this->State().stride;
+  if (sizeof...(ComponentTypeTs) != stride)
+  {
+    ignerr << "Trying to add entity [" << _entity << "] to a view of "
+           << stride << " component types with "
+           << sizeof...(ComponentTypeTs) << " components." << std::endl;
+    return;
+  }
+
+  const std::array<components::BaseComponent *, sizeof...(ComponentTypeTs)>
+      data{const_cast<std::remove_const_t<ComponentTypeTs> *>(_compPtrs)...};
+  this->AddEntityWithPartialData(_entity, _new, data.data(), false);
 }
 }  // namespace detail
 }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
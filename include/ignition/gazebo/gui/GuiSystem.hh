@@ -19,6 +19,8 @@
 
 #include <QtCore>
 
+#include <vector>
+
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
 #include <ignition/gazebo/gui/Export.hh>
@@ -41,6 +43,14 @@ namespace gazebo
   /// GUI systems are different from `ignition::gazebo::System`s because they
   /// don't run in the same process as the physics. Instead, they run in a
   /// separate process that is stepped by updates coming through the network
+  ///
+  /// By default, Update is called every time the GUI updates its plugins. A
+  /// system can instead ask to be updated only when components it's
+  /// interested in change, and / or at most at a given rate, see
+  /// setGuiSystemUpdateComponentTypes, setGuiSystemUpdateEntities and
+  /// setGuiSystemMaxUpdateRate. Entity creation and removal, as well as
+  /// component removal, are always dispatched to all systems, so that
+  /// EachNew and EachRemoved don't miss anything.
   class IGNITION_GAZEBO_GUI_VISIBLE GuiSystem : public ignition::gui::Plugin
   {
     Q_OBJECT
@@ -59,6 +69,55 @@ namespace gazebo
       (void)_ecm;
     }
   };
+
+  /// \brief Only update a GUI system when a component of one of these types
+  /// changes. This resets the system, so that it's updated on the next
+  /// frame.
+  /// \param[in] _system The GUI system.
+  /// \param[in] _types Component types. Leave empty to stop filtering by
+  /// component type.
+  void IGNITION_GAZEBO_GUI_VISIBLE setGuiSystemUpdateComponentTypes(
+      GuiSystem &_system, const std::vector<ComponentTypeId> &_types);
+
+  /// \brief Only update a GUI system when a component of one of these
+  /// entities changes. If component types are also set, the system is
+  /// updated when either changes. This resets the system, so that it's
+  /// updated on the next frame.
+  /// \param[in] _system The GUI system.
+  /// \param[in] _entities Entities. Leave empty to stop filtering by entity.
+  void IGNITION_GAZEBO_GUI_VISIBLE setGuiSystemUpdateEntities(
+      GuiSystem &_system, const std::vector<Entity> &_entities);
+
+  /// \brief Set the maximum rate at which a GUI system is updated.
+  /// \param[in] _system The GUI system.
+  /// \param[in] _rate Rate in Hz. Zero or less for no limit, which is the
+  /// default.
+  void IGNITION_GAZEBO_GUI_VISIBLE setGuiSystemMaxUpdateRate(
+      GuiSystem &_system, double _rate);
+
+  /// \brief Declare the component types a GUI system reads from the ECM. If
+  /// all the GUI systems declare their types, the GUI only receives
+  /// components of the declared types from the server, which saves
+  /// bandwidth and the cost of applying the state. The `Name` and
+  /// `ParentEntity` components are always received.
+  /// \param[in] _system The GUI system.
+  /// \param[in] _types Component types. Leave empty to receive all types,
+  /// which is the default.
+  void IGNITION_GAZEBO_GUI_VISIBLE setGuiSystemRequiredComponentTypes(
+      GuiSystem &_system, const std::vector<ComponentTypeId> &_types);
+
+  /// \brief Get the component types a GUI system reads from the ECM.
+  /// \param[in] _system The GUI system.
+  /// \return Component types, empty if the system needs all types.
+  /// \sa setGuiSystemRequiredComponentTypes
+  std::vector<ComponentTypeId> IGNITION_GAZEBO_GUI_VISIBLE
+      guiSystemRequiredComponentTypes(const GuiSystem &_system);
+
+  /// \brief Update a GUI system on the next frame, even if nothing it's
+  /// interested in changed, for example because it needs to display
+  /// something else. This may be called from any thread.
+  /// \param[in] _system The GUI system.
+  void IGNITION_GAZEBO_GUI_VISIBLE requestGuiSystemUpdate(GuiSystem &_system);
 }
 }
 }
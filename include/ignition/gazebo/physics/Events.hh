@@ -17,7 +17,9 @@
 #ifndef IGNITION_GAZEBO_PHYSICS_EVENTS_HH_
 #define IGNITION_GAZEBO_PHYSICS_EVENTS_HH_
 
+#include <functional>
 #include <optional>
+#include <string>
 
 #include <ignition/common/Event.hh>
 
@@ -57,6 +59,47 @@ namespace ignition
             ContactSurfaceParams<Policy>& /* params */
         ),
         struct CollectContactSurfacePropertiesTag>;
+
+      /// \brief Function which customizes the surface of a contact point.
+      /// It takes the same arguments as CollectContactSurfaceProperties.
+      using ContactSurfaceHandler = std::function<void(
+          const Entity& /* collision1 */,
+          const Entity& /* collision2 */,
+          const math::Vector3d &  /* point */,
+          const std::optional<math::Vector3d> /* force */,
+          const std::optional<math::Vector3d> /* normal */,
+          const std::optional<double> /* depth */,
+          const size_t /* numContactsOnCollision */,
+          physics::SetContactPropertiesCallbackFeature::
+            ContactSurfaceParams<Policy>& /* params */)>;
+
+      /// \brief Emit this event to register a handler which customizes the
+      /// contacts of a single collision. The physics system keeps a lookup
+      /// from collisions to handlers, and only calls the handlers of the
+      /// collisions which take part in each contact, instead of broadcasting
+      /// CollectContactSurfaceProperties to every subscriber. Contacts whose
+      /// collisions have handlers aren't broadcast. The collision still needs
+      /// a components::EnableContactSurfaceCustomization component set to
+      /// true. Events emitted before the physics system is configured are
+      /// lost, so handlers should be registered from an update callback.
+      /// Registering a handler with the same id again replaces it.
+      using AddContactSurfaceHandler = ignition::common::EventT<
+        void(
+          const Entity& /* collision */,
+          const std::string& /* id */,
+          ContactSurfaceHandler /* handler */
+        ),
+        struct AddContactSurfaceHandlerTag>;
+
+      /// \brief Emit this event to remove a handler registered with
+      /// AddContactSurfaceHandler. Handlers are also removed along with
+      /// their collision.
+      using RemoveContactSurfaceHandler = ignition::common::EventT<
+        void(
+          const Entity& /* collision */,
+          const std::string& /* id */
+        ),
+        struct RemoveContactSurfaceHandlerTag>;
       }
     }  // namespace events
   }  // namespace gazebo
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ASYNCVIDEOENCODER_HH_
+#define IGNITION_GAZEBO_ASYNCVIDEOENCODER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/gazebo/rendering/Export.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+// Forward declare private data class.
+class AsyncVideoEncoderPrivate;
+
+/// \brief Encodes video frames on a background thread, so that the thread
+/// which captures them, usually the rendering thread, only has to copy
+/// them. Frames are held in a bounded queue until they're encoded. When
+/// the queue is full, new frames are dropped, or the caller is blocked
+/// until there's room if frames must not be dropped, such as when
+/// recording in lockstep.
+///
+/// Frames which arrive faster than the video's frame rate are skipped
+/// before being copied, and aren't counted as dropped.
+class IGNITION_GAZEBO_RENDERING_VISIBLE AsyncVideoEncoder
+{
+  /// \brief Constructor
+  public: AsyncVideoEncoder();
+
+  /// \brief Destructor. Stops encoding, finishing the queued frames.
+  public: ~AsyncVideoEncoder();
+
+  /// \brief Set the hardware encoder to use for the next video.
+  /// \param[in] _encoder Name of the encoder, such as "nvenc" or "vaapi".
+  /// "auto" tries all the hardware encoders supported by FFmpeg, and "none"
+  /// or an empty string uses software encoding. Unsupported or unavailable
+  /// encoders fall back to software encoding.
+  /// \param[in] _device Device to use for the encoder, such as
+  /// "/dev/dri/renderD128" for VAAPI. Empty to pick one automatically.
+  public: void SetHardwareEncoder(const std::string &_encoder,
+              const std::string &_device = "");
+
+  /// \brief Set the maximum number of frames waiting to be encoded. Takes
+  /// effect on the next call to Start.
+  /// \param[in] _size Number of frames. Defaults to 8.
+  public: void SetQueueSize(const unsigned int _size);
+
+  /// \brief Set whether frames are dropped when the queue is full.
+  /// \param[in] _drop True to drop frames, false to block AddFrame until
+  /// there's room in the queue. Defaults to true.
+  public: void SetDropFrames(const bool _drop);
+
+  /// \brief Start encoding a video.
+  /// \param[in] _format Video format, such as "mp4".
+  /// \param[in] _filename Path of the video file.
+  /// \param[in] _width Width of the frames.
+  /// \param[in] _height Height of the frames.
+  /// \param[in] _fps Frame rate of the video.
+  /// \param[in] _bitRate Bit rate of the video.
+  /// \return True on success.
+  public: bool Start(const std::string &_format,
+              const std::string &_filename, const unsigned int _width,
+              const unsigned int _height, const unsigned int _fps,
+              const unsigned int _bitRate);
+
+  /// \brief Queue a frame for encoding. The frame data is copied.
+  /// \param[in] _frame RGB frame data.
+  /// \param[in] _width Width of the frame.
+  /// \param[in] _height Height of the frame.
+  /// \param[in] _timestamp Time of the frame.
+  /// \return True if the frame was queued, false if it was skipped
+  /// because it came too soon after the previous one, or dropped.
+  public: bool AddFrame(const unsigned char *_frame,
+              const unsigned int _width, const unsigned int _height,
+              const std::chrono::steady_clock::time_point &_timestamp);
+
+  /// \brief Stop encoding, after all the queued frames have been encoded.
+  /// \return True if a video was being encoded.
+  public: bool Stop();
+
+  /// \brief Get whether a video is being encoded.
+  /// \return True if encoding.
+  public: bool IsEncoding() const;
+
+  /// \brief Get the number of frames dropped since the video started
+  /// because the queue was full.
+  /// \return Number of frames.
+  public: uint64_t DroppedFrames() const;
+
+  /// \brief Get the number of frames encoded since the video started.
+  /// \return Number of frames.
+  public: uint64_t EncodedFrames() const;
+
+  /// \internal
+  /// \brief Private data pointer
+  private: std::unique_ptr<AsyncVideoEncoderPrivate> dataPtr;
+};
+}
+}
+}
+#endif
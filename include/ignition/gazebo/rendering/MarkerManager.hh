@@ -57,6 +57,13 @@ class IGNITION_GAZEBO_RENDERING_VISIBLE MarkerManager
   /// \brief Update MarkerManager
   public: void Update();
 
+  /// \brief Check whether the next Update would change the markers, which
+  /// is the case when marker messages were received, or when markers with
+  /// a lifetime exist and simulation time changed. This can be called from
+  /// any thread.
+  /// \return True if Update has changes to apply.
+  public: bool HasPendingChanges() const;
+
   /// \brief Initialize the marker manager.
   /// \param[in] _scene Reference to the scene.
   /// \return True on success
@@ -77,6 +77,18 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     public: void UpdateFromECM(const UpdateInfo &_info,
                                const EntityComponentManager &_ecm);
 
+    /// \brief Check if anything which affects the rendered scene, such as
+    /// poses, visuals, lights and entity creation or removal, changed in the
+    /// ECM. This lets callers skip updating and rendering the scene while it
+    /// is idle. Worlds with actors or particle emitters are never idle.
+    /// Markers aren't tracked, see MarkerManager::HasPendingChanges.
+    /// \param[in] _ecm Entity component manager
+    /// \param[in] _tick Only changes after this ECM change tick are
+    /// considered.
+    /// \return True if the scene changed.
+    public: bool SceneChangedSince(const EntityComponentManager &_ecm,
+                                   uint64_t _tick) const;
+
     /// \brief Helper function to create visuals for new entities created in
     /// ECM. This function is intended to be used by other GUI plugins when
     /// new entities are created on the GUI side.
@@ -214,6 +226,23 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _active True if active.
     public: void SetTransformActive(bool _active);
 
+    /// \brief Set whether Update should render the scene as of the last
+    /// completed ECM update, instead of waiting for an update which is in
+    /// progress on another thread. This lets rendering run at display rate
+    /// regardless of how long ECM updates take. The changes of the update in
+    /// progress are applied on a later frame. Defaults to false.
+    /// \param[in] _async True to not wait for ECM updates.
+    public: void SetAsyncUpdates(bool _async);
+
+    /// \brief Set whether entity poses received from the ECM should be
+    /// interpolated. When enabled, entities move smoothly towards each
+    /// received pose over the measured period between incoming states,
+    /// instead of jumping to it, at the cost of up to one state period of
+    /// latency. Actors and entities being manipulated aren't interpolated.
+    /// Defaults to false.
+    /// \param[in] _interpolate True to interpolate poses.
+    public: void SetPoseInterpolation(bool _interpolate);
+
     /// \brief Set the event manager to use
     /// \param[in] _mgr Event manager to set to.
     public: void SetEventManager(EventManager *_mgr);
@@ -310,6 +310,12 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _id Entity's unique id
     public: void RemoveEntity(Entity _id);
 
+    /// \brief Shrink the maps of entities to rendering objects if they're
+    /// much larger than their contents, such as after many entities were
+    /// removed. The rendering objects aren't affected.
+    /// \return True if any map was shrunk.
+    public: bool Compact();
+
     /// \brief Load a geometry
     /// \param[in] _geom Geometry sdf dom
     /// \param[out] _scale Geometry scale that will be set based on sdf
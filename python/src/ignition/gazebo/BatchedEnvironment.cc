@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "BatchedEnvironment.hh"
+
+#include "ignition/gazebo/BatchedEnvironment.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+namespace python
+{
+/// \brief View a buffer of the environments as a numpy array, without
+/// copying it. The array keeps the environments alive.
+/// \param[in] _self Python object holding the environments.
+/// \param[in] _data Buffer to view.
+/// \param[in] _shape Shape of the array.
+/// \return Read only numpy array.
+static pybind11::array_t<double>
+arrayView(pybind11::object _self, const std::vector<double> &_data,
+  const std::vector<pybind11::ssize_t> &_shape)
+{
+  pybind11::array_t<double> array(_shape, _data.data(), _self);
+  array.attr("setflags")(pybind11::arg("write") = false);
+  return array;
+}
+
+void
+defineGazeboBatchedEnvironment(pybind11::object module)
+{
+  pybind11::class_<BatchedEnvironment, std::shared_ptr<BatchedEnvironment>>(
+    module, "BatchedEnvironment")
+  .def(pybind11::init<const ServerConfig &, unsigned int>())
+  .def(
+    "size", &BatchedEnvironment::Size,
+    "Get the number of environments.")
+  .def(
+    "add_model", &BatchedEnvironment::AddModel,
+    "Observe the pose of a model in all environments.")
+  .def(
+    "add_joint", &BatchedEnvironment::AddJoint,
+    "Observe and actuate a joint in all environments.")
+  .def(
+    "model_count", &BatchedEnvironment::ModelCount,
+    "Get the number of observed models.")
+  .def(
+    "joint_count", &BatchedEnvironment::JointCount,
+    "Get the number of observed joints.")
+  .def(
+    "set_joint_forces", &BatchedEnvironment::SetJointForces,
+    "Set the forces applied to the joints of all environments.")
+  .def(
+    "step", &BatchedEnvironment::Step,
+    pybind11::call_guard<pybind11::gil_scoped_release>(),
+    pybind11::arg("iterations") = 1,
+    "Step all environments in lockstep.")
+  .def(
+    "reset", pybind11::overload_cast<>(&BatchedEnvironment::Reset),
+    pybind11::call_guard<pybind11::gil_scoped_release>(),
+    "Reset all environments to their initial state.")
+  .def(
+    "reset",
+    pybind11::overload_cast<const std::size_t>(&BatchedEnvironment::Reset),
+    pybind11::call_guard<pybind11::gil_scoped_release>(),
+    "Reset one environment to its initial state.")
+  .def(
+    "model_poses",
+    [](pybind11::object _self)
+    {
+      auto &envs = _self.cast<BatchedEnvironment &>();
+      return arrayView(_self, envs.ModelPoses(),
+        {static_cast<pybind11::ssize_t>(envs.Size()),
+         static_cast<pybind11::ssize_t>(envs.ModelCount()),
+         static_cast<pybind11::ssize_t>(BatchedEnvironment::kPoseSize)});
+    },
+    "Get the model poses as an (environments, models, 7) array.")
+  .def(
+    "joint_positions",
+    [](pybind11::object _self)
+    {
+      auto &envs = _self.cast<BatchedEnvironment &>();
+      return arrayView(_self, envs.JointPositions(),
+        {static_cast<pybind11::ssize_t>(envs.Size()),
+         static_cast<pybind11::ssize_t>(envs.JointCount())});
+    },
+    "Get the joint positions as an (environments, joints) array.")
+  .def(
+    "joint_velocities",
+    [](pybind11::object _self)
+    {
+      auto &envs = _self.cast<BatchedEnvironment &>();
+      return arrayView(_self, envs.JointVelocities(),
+        {static_cast<pybind11::ssize_t>(envs.Size()),
+         static_cast<pybind11::ssize_t>(envs.JointCount())});
+    },
+    "Get the joint velocities as an (environments, joints) array.")
+  .def(
+    "server", &BatchedEnvironment::Server,
+    "Get the server running all environments.");
+}
+}
+}
+}
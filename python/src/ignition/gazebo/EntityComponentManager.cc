@@ -15,20 +15,306 @@
  */
 #include <pybind11/pybind11.h>
 
+#include <pybind11/numpy.h>
+
+#include <limits>
+#include <vector>
+
 #include "EntityComponentManager.hh"
 
+#include "ignition/gazebo/components/AngularVelocity.hh"
+#include "ignition/gazebo/components/Joint.hh"
+#include "ignition/gazebo/components/JointForceCmd.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/Util.hh"
+
 namespace ignition
 {
 namespace gazebo
 {
 namespace python
 {
+/// \brief Array of entities passed from Python.
+using EntityArray = pybind11::array_t<Entity,
+    pybind11::array::c_style | pybind11::array::forcecast>;
+
+/// \brief Array of values passed from Python.
+using DoubleArray = pybind11::array_t<double,
+    pybind11::array::c_style | pybind11::array::forcecast>;
+
+/// \brief Value used for entities which lack a component.
+static constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+/// \brief Get all the entities which have a component, as a numpy array.
+/// \param[in] _ecm Entity component manager.
+/// \tparam ComponentTypeT Component type.
+/// \return Array of entities.
+template <typename ComponentTypeT>
+static EntityArray entitiesWith(const EntityComponentManager &_ecm)
+{
+  std::vector<Entity> entities;
+  _ecm.Each<ComponentTypeT>(
+      [&](const Entity &_entity, const ComponentTypeT *) -> bool
+      {
+        entities.push_back(_entity);
+        return true;
+      });
+  EntityArray array(static_cast<pybind11::ssize_t>(entities.size()));
+  std::copy(entities.begin(), entities.end(), array.mutable_data());
+  return array;
+}
+
+/// \brief Write a pose into a row of 7 values, as x, y, z, qw, qx, qy, qz.
+/// \param[in] _pose Pose.
+/// \param[out] _row Row to write to.
+static void poseToRow(const math::Pose3d &_pose, double *_row)
+{
+  _row[0] = _pose.Pos().X();
+  _row[1] = _pose.Pos().Y();
+  _row[2] = _pose.Pos().Z();
+  _row[3] = _pose.Rot().W();
+  _row[4] = _pose.Rot().X();
+  _row[5] = _pose.Rot().Y();
+  _row[6] = _pose.Rot().Z();
+}
+
+/// \brief Gather a value per entity into an array with one row of _cols
+/// values per entity. Rows of entities for which _func returns false are
+/// filled with NaN.
+/// \param[in] _entities Entities.
+/// \param[in] _cols Number of values per entity.
+/// \param[in] _func Function writing the row of an entity.
+/// \return Array of shape (entities,) for a single column, or
+/// (entities, _cols) otherwise.
+template <typename Func>
+static pybind11::array_t<double> gather(const EntityArray &_entities,
+    const pybind11::ssize_t _cols, Func _func)
+{
+  const auto count = _entities.size();
+  std::vector<pybind11::ssize_t> shape{count};
+  if (_cols > 1)
+    shape.push_back(_cols);
+  pybind11::array_t<double> array(shape);
+
+  // The Python callback holds the GIL, and no Python object is touched
+  // while gathering
+  auto entities = _entities.data();
+  double *row = array.mutable_data();
+  for (pybind11::ssize_t i = 0; i < count; ++i, row += _cols)
+  {
+    if (!_func(entities[i], row))
+      std::fill(row, row + _cols, kMissing);
+  }
+  return array;
+}
+
+/// \brief Check that an array of values has one row of _cols values per
+/// entity.
+/// \param[in] _entities Entities.
+/// \param[in] _values Values.
+/// \param[in] _cols Number of values per entity.
+static void checkShape(const EntityArray &_entities,
+    const DoubleArray &_values, const pybind11::ssize_t _cols)
+{
+  if (_values.size() != _entities.size() * _cols)
+  {
+    throw pybind11::value_error("Expected " + std::to_string(_cols) +
+        " value(s) per entity, got " + std::to_string(_values.size()) +
+        " values for " + std::to_string(_entities.size()) + " entities.");
+  }
+}
+
 /////////////////////////////////////////////////
 void defineGazeboEntityComponentManager(pybind11::object module)
 {
   pybind11::class_<ignition::gazebo::EntityComponentManager>(
       module, "EntityComponentManager")
-  .def(pybind11::init<>());
+  .def(pybind11::init<>())
+  .def(
+    "links", &entitiesWith<components::Link>,
+    "Get all the link entities as an array.")
+  .def(
+    "joints", &entitiesWith<components::Joint>,
+    "Get all the joint entities as an array.")
+  .def(
+    "models", &entitiesWith<components::Model>,
+    "Get all the model entities as an array.")
+  .def(
+    "poses",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 7, [&](Entity _entity, double *_row)
+      {
+        auto pose = _ecm.Component<components::Pose>(_entity);
+        if (nullptr == pose)
+          return false;
+        poseToRow(pose->Data(), _row);
+        return true;
+      });
+    },
+    "Get the poses of entities relative to their parents as an "
+    "(entities, 7) array of x, y, z, qw, qx, qy, qz. Rows of entities "
+    "without a pose are NaN.")
+  .def(
+    "world_poses",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 7, [&](Entity _entity, double *_row)
+      {
+        if (nullptr == _ecm.Component<components::Pose>(_entity))
+          return false;
+        poseToRow(worldPose(_entity, _ecm), _row);
+        return true;
+      });
+    },
+    "Get the world poses of entities as an (entities, 7) array of x, y, "
+    "z, qw, qx, qy, qz. Rows of entities without a pose are NaN.")
+  .def(
+    "world_linear_velocities",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 3, [&](Entity _entity, double *_row)
+      {
+        auto vel = _ecm.Component<components::WorldLinearVelocity>(_entity);
+        if (nullptr == vel)
+          return false;
+        _row[0] = vel->Data().X();
+        _row[1] = vel->Data().Y();
+        _row[2] = vel->Data().Z();
+        return true;
+      });
+    },
+    "Get the world linear velocities of links as an (entities, 3) array. "
+    "Velocities are only available for links whose velocities have been "
+    "enabled with enable_velocities. Other rows are NaN.")
+  .def(
+    "world_angular_velocities",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 3, [&](Entity _entity, double *_row)
+      {
+        auto vel = _ecm.Component<components::WorldAngularVelocity>(_entity);
+        if (nullptr == vel)
+          return false;
+        _row[0] = vel->Data().X();
+        _row[1] = vel->Data().Y();
+        _row[2] = vel->Data().Z();
+        return true;
+      });
+    },
+    "Get the world angular velocities of links as an (entities, 3) array. "
+    "Velocities are only available for links whose velocities have been "
+    "enabled with enable_velocities. Other rows are NaN.")
+  .def(
+    "enable_velocities",
+    [](EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      auto entities = _entities.data();
+      for (pybind11::ssize_t i = 0; i < _entities.size(); ++i)
+      {
+        enableComponent<components::WorldLinearVelocity>(_ecm, entities[i]);
+        enableComponent<components::WorldAngularVelocity>(_ecm,
+            entities[i]);
+      }
+    },
+    "Make physics fill the world velocities of links.")
+  .def(
+    "joint_positions",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 1, [&](Entity _entity, double *_row)
+      {
+        auto pos = _ecm.Component<components::JointPosition>(_entity);
+        if (nullptr == pos || pos->Data().empty())
+          return false;
+        _row[0] = pos->Data()[0];
+        return true;
+      });
+    },
+    "Get the positions of the first axis of joints as an array. Positions "
+    "are only available for joints whose states have been enabled with "
+    "enable_joint_states. Other values are NaN.")
+  .def(
+    "joint_velocities",
+    [](const EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      return gather(_entities, 1, [&](Entity _entity, double *_row)
+      {
+        auto vel = _ecm.Component<components::JointVelocity>(_entity);
+        if (nullptr == vel || vel->Data().empty())
+          return false;
+        _row[0] = vel->Data()[0];
+        return true;
+      });
+    },
+    "Get the velocities of the first axis of joints as an array. "
+    "Velocities are only available for joints whose states have been "
+    "enabled with enable_joint_states. Other values are NaN.")
+  .def(
+    "enable_joint_states",
+    [](EntityComponentManager &_ecm, const EntityArray &_entities)
+    {
+      auto entities = _entities.data();
+      for (pybind11::ssize_t i = 0; i < _entities.size(); ++i)
+      {
+        enableComponent<components::JointPosition>(_ecm, entities[i]);
+        enableComponent<components::JointVelocity>(_ecm, entities[i]);
+      }
+    },
+    "Make physics fill the positions and velocities of joints.")
+  .def(
+    "set_joint_force_cmds",
+    [](EntityComponentManager &_ecm, const EntityArray &_entities,
+       const DoubleArray &_forces)
+    {
+      checkShape(_entities, _forces, 1);
+      auto entities = _entities.data();
+      auto forces = _forces.data();
+      for (pybind11::ssize_t i = 0; i < _entities.size(); ++i)
+      {
+        _ecm.SetComponentData<components::JointForceCmd>(entities[i],
+            {forces[i]});
+      }
+    },
+    "Set the force commands of the first axis of joints.")
+  .def(
+    "set_joint_velocity_cmds",
+    [](EntityComponentManager &_ecm, const EntityArray &_entities,
+       const DoubleArray &_velocities)
+    {
+      checkShape(_entities, _velocities, 1);
+      auto entities = _entities.data();
+      auto velocities = _velocities.data();
+      for (pybind11::ssize_t i = 0; i < _entities.size(); ++i)
+      {
+        _ecm.SetComponentData<components::JointVelocityCmd>(entities[i],
+            {velocities[i]});
+      }
+    },
+    "Set the velocity commands of the first axis of joints.")
+  .def(
+    "set_world_pose_cmds",
+    [](EntityComponentManager &_ecm, const EntityArray &_entities,
+       const DoubleArray &_poses)
+    {
+      checkShape(_entities, _poses, 7);
+      auto entities = _entities.data();
+      const double *row = _poses.data();
+      for (pybind11::ssize_t i = 0; i < _entities.size(); ++i, row += 7)
+      {
+        _ecm.SetComponentData<components::WorldPoseCmd>(entities[i],
+            math::Pose3d(row[0], row[1], row[2],
+                         row[3], row[4], row[5], row[6]));
+      }
+    },
+    "Teleport models to world poses given as an (entities, 7) array of x, "
+    "y, z, qw, qx, qy, qz.");
 }
 }  // namespace python
 }  // namespace gazebo
@@ -39,7 +39,10 @@ void defineGazeboServer(pybind11::object module)
     "Run the server. By default this is a non-blocking call, "
     " which means the server runs simulation in a separate thread. Pass "
     " in true to the _blocking argument to run the server in the current "
-    " thread.")
+    " thread. The GIL is released while the server runs, and only "
+    " acquired again to call Python callbacks, so callbacks registered "
+    " with an iteration count or a period don't slow down the iterations "
+    " in between.")
   .def(
     "has_entity", &ignition::gazebo::Server::HasEntity,
     "Return true if the specified world has an entity with the provided name.")
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <pybind11/chrono.h>
 #include <pybind11/functional.h>
 #include <pybind11/stl.h>
 
@@ -78,6 +79,84 @@ defineGazeboTestFixture(pybind11::object module)
     ),
     pybind11::return_value_policy::reference,
     "Wrapper around a system's post-update callback"
+  )
+  .def(
+    "on_pre_update", WrapCallbacks(
+      [](TestFixture* self, uint64_t _iterations, std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+      {
+        self->OnPreUpdate(_iterations, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's pre-update callback which is only called on "
+    "iterations which are multiples of the given number"
+  )
+  .def(
+    "on_pre_update", WrapCallbacks(
+      [](TestFixture* self,
+          std::chrono::steady_clock::duration _period,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+      {
+        self->OnPreUpdate(_period, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's pre-update callback which is only called once "
+    "per sim time period"
+  )
+  .def(
+    "on_update", WrapCallbacks(
+      [](TestFixture* self, uint64_t _iterations, std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+      {
+        self->OnUpdate(_iterations, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's update callback which is only called on "
+    "iterations which are multiples of the given number"
+  )
+  .def(
+    "on_update", WrapCallbacks(
+      [](TestFixture* self,
+          std::chrono::steady_clock::duration _period,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+      {
+        self->OnUpdate(_period, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's update callback which is only called once "
+    "per sim time period"
+  )
+  .def(
+    "on_post_update", WrapCallbacks(
+      [](TestFixture* self, uint64_t _iterations, std::function<void(
+          const UpdateInfo &, const EntityComponentManager &)> _cb)
+      {
+        self->OnPostUpdate(_iterations, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's post-update callback which is only called on "
+    "iterations which are multiples of the given number"
+  )
+  .def(
+    "on_post_update", WrapCallbacks(
+      [](TestFixture* self,
+          std::chrono::steady_clock::duration _period,
+          std::function<void(
+          const UpdateInfo &, const EntityComponentManager &)> _cb)
+      {
+        self->OnPostUpdate(_period, _cb);
+      }
+    ),
+    pybind11::return_value_policy::reference,
+    "Wrapper around a system's post-update callback which is only called once "
+    "per sim time period"
   );
   // TODO(ahcorde): This method is not compiling for the following reason:
   // The EventManager class has an unordered_map which holds a unique_ptr
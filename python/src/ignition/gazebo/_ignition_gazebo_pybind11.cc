@@ -16,6 +16,7 @@
 
 #include <pybind11/pybind11.h>
 
+#include "BatchedEnvironment.hh"
 #include "EntityComponentManager.hh"
 #include "EventManager.hh"
 #include "Server.hh"
@@ -28,6 +29,7 @@
 PYBIND11_MODULE(gazebo, m) {
   m.doc() = "Ignition Gazebo Python Library.";
 
+  ignition::gazebo::python::defineGazeboBatchedEnvironment(m);
   ignition::gazebo::python::defineGazeboEntityComponentManager(m);
   ignition::gazebo::python::defineGazeboEventManager(m);
   ignition::gazebo::python::defineGazeboServer(m);
@@ -0,0 +1,63 @@
+# Copyright (C) 2026 Open Source Robotics Foundation
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#       http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import unittest
+
+import numpy as np
+
+from ignition.gazebo import TestFixture
+
+link_z = []
+link_vz = []
+
+
+class TestEntityComponentManager(unittest.TestCase):
+
+    def test_bulk_accessors(self):
+        file_path = os.path.dirname(os.path.realpath(__file__))
+        helper = TestFixture(os.path.join(file_path, 'gravity.sdf'))
+
+        def on_pre_update_cb(_info, _ecm):
+            links = _ecm.links()
+            self.assertEqual(1, len(links))
+            _ecm.enable_velocities(links)
+
+        def on_post_update_cb(_info, _ecm):
+            links = _ecm.links()
+            poses = _ecm.world_poses(links)
+            self.assertEqual((1, 7), poses.shape)
+            velocities = _ecm.world_linear_velocities(links)
+            self.assertEqual((1, 3), velocities.shape)
+            link_z.append(poses[0, 2])
+            link_vz.append(velocities[0, 2])
+
+            # Entities without the component give NaN
+            self.assertTrue(np.isnan(_ecm.joint_positions(links)[0]))
+
+        helper.on_pre_update(on_pre_update_cb)
+        helper.on_post_update(on_post_update_cb)
+        helper.finalize()
+
+        server = helper.server()
+        server.run(True, 100, False)
+
+        self.assertEqual(100, len(link_z))
+        # The link falls under gravity
+        self.assertLess(link_z[-1], link_z[0])
+        self.assertLess(link_vz[-1], 0.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from datetime import timedelta
 import os
 import unittest
 
@@ -60,6 +61,29 @@ class TestTestFixture(unittest.TestCase):
         self.assertEqual(1000, pre_iterations)
         self.assertEqual(1000, iterations)
         self.assertEqual(1000, post_iterations)
+    def test_interval_callbacks(self):
+        file_path = os.path.dirname(os.path.realpath(__file__))
+        helper = TestFixture(os.path.join(file_path, 'gravity.sdf'))
+
+        pre_calls = []
+        post_calls = []
+
+        def on_pre_udpate_cb(_info, _ecm):
+            pre_calls.append(_info.iterations)
+
+        def on_post_udpate_cb(_info, _ecm):
+            post_calls.append(_info.iterations)
+
+        # The default step size is 1 ms
+        helper.on_pre_update(100, on_pre_udpate_cb)
+        helper.on_post_update(timedelta(milliseconds=250), on_post_udpate_cb)
+        helper.finalize()
+
+        server = helper.server()
+        server.run(True, 1000, False)
+
+        self.assertEqual(list(range(100, 1001, 100)), pre_calls)
+        self.assertEqual([250, 500, 750, 1000], post_calls)
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/AllocationTracker.hh"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief Counters of a scope, added up over all threads.
+struct ScopeEntry
+{
+  /// \brief Name of the scope, null while the entry is free.
+  std::atomic<const char *> name{nullptr};
+
+  /// \brief Number of allocations.
+  std::atomic<uint64_t> count{0u};
+
+  /// \brief Number of bytes.
+  std::atomic<uint64_t> bytes{0u};
+};
+
+/// \brief Number of scope names which can be tracked.
+constexpr std::size_t kMaxScopes{1024u};
+
+/// \brief Open addressing table of scopes, keyed by name pointer. Entries
+/// are never freed, so it can be used without locks and without
+/// allocating.
+std::array<ScopeEntry, kMaxScopes> &scopeTable()
+{
+  static std::array<ScopeEntry, kMaxScopes> table;
+  return table;
+}
+
+/// \brief Allocations made by the current thread. Constant initialized, so
+/// it's usable from operator new at any time in the thread's life.
+thread_local AllocationTracker::Counts tThreadCounts;
+
+/// \brief Charge allocations to a scope.
+/// \param[in] _name Name of the scope.
+/// \param[in] _count Number of allocations.
+/// \param[in] _bytes Number of bytes.
+void chargeScope(const char *_name, uint64_t _count, uint64_t _bytes)
+{
+  auto &table = scopeTable();
+  const std::size_t hash = std::hash<const void *>()(_name);
+  for (std::size_t i = 0u; i < kMaxScopes; ++i)
+  {
+    auto &entry = table[(hash + i) % kMaxScopes];
+    const char *name = entry.name.load(std::memory_order_acquire);
+    if (nullptr == name &&
+        entry.name.compare_exchange_strong(name, _name,
+            std::memory_order_acq_rel))
+    {
+      name = _name;
+    }
+
+    if (name == _name)
+    {
+      entry.count.fetch_add(_count, std::memory_order_relaxed);
+      entry.bytes.fetch_add(_bytes, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+}
+
+/////////////////////////////////////////////////
+AllocationTracker::Scope::Scope(const char *_name)
+  : name(_name), start(tThreadCounts)
+{
+}
+
+/////////////////////////////////////////////////
+AllocationTracker::Scope::~Scope()
+{
+  const Counts end = tThreadCounts;
+  if (end.count != this->start.count)
+  {
+    chargeScope(this->name, end.count - this->start.count,
+        end.bytes - this->start.bytes);
+  }
+}
+
+/////////////////////////////////////////////////
+bool AllocationTracker::Enabled()
+{
+#ifdef IGNITION_GAZEBO_ALLOCATION_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+AllocationTracker::Counts AllocationTracker::ThreadCounts()
+{
+  return tThreadCounts;
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, AllocationTracker::Counts>
+    AllocationTracker::ScopeCounts()
+{
+  // Read the table before building the map, whose allocations would be
+  // charged to the scopes being read
+  std::array<std::pair<const char *, Counts>, kMaxScopes> entries;
+  std::size_t size{0u};
+  for (const auto &entry : scopeTable())
+  {
+    const char *name = entry.name.load(std::memory_order_acquire);
+    if (nullptr == name)
+      continue;
+    entries[size++] = {name, {entry.count.load(std::memory_order_relaxed),
+        entry.bytes.load(std::memory_order_relaxed)}};
+  }
+
+  // The same name may be at several addresses, one per library
+  std::map<std::string, Counts> result;
+  for (std::size_t i = 0u; i < size; ++i)
+  {
+    auto &counts = result[entries[i].first];
+    counts.count += entries[i].second.count;
+    counts.bytes += entries[i].second.bytes;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+void AllocationTracker::Record(std::size_t _bytes)
+{
+  ++tThreadCounts.count;
+  tThreadCounts.bytes += _bytes;
+}
+
+#if defined(IGNITION_GAZEBO_ALLOCATION_TRACKING) && !defined(_WIN32)
+namespace
+{
+/// \brief Allocate memory the way the default operator new does.
+/// \param[in] _size Size of the allocation.
+/// \param[in] _alignment Alignment, zero for the default one.
+/// \return Allocated memory, or null if allocation failed and there's no
+/// new handler.
+void *trackedAlloc(std::size_t _size, std::size_t _alignment = 0u)
+{
+  AllocationTracker::Record(_size);
+  if (0u == _size)
+    _size = 1u;
+
+  while (true)
+  {
+    void *ptr{nullptr};
+    if (_alignment > alignof(std::max_align_t))
+    {
+      if (0 != posix_memalign(&ptr, _alignment, _size))
+        ptr = nullptr;
+    }
+    else
+    {
+      ptr = std::malloc(_size);
+    }
+
+    if (nullptr != ptr)
+      return ptr;
+
+    auto handler = std::get_new_handler();
+    if (nullptr == handler)
+      return nullptr;
+    handler();
+  }
+}
+
+/// \brief Allocate memory, throwing if allocation failed.
+/// \param[in] _size Size of the allocation.
+/// \param[in] _alignment Alignment, zero for the default one.
+/// \return Allocated memory.
+void *trackedAllocOrThrow(std::size_t _size, std::size_t _alignment = 0u)
+{
+  void *ptr = trackedAlloc(_size, _alignment);
+  if (nullptr == ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+}
+
+// Replacements of the global allocation functions, which count every
+// allocation of the process. Memory from both malloc and posix_memalign is
+// released with free.
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  return trackedAllocOrThrow(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return trackedAllocOrThrow(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return trackedAlloc(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return trackedAlloc(_size);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, std::align_val_t _alignment)
+{
+  return trackedAllocOrThrow(_size, static_cast<std::size_t>(_alignment));
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size, std::align_val_t _alignment)
+{
+  return trackedAllocOrThrow(_size, static_cast<std::size_t>(_alignment));
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, std::align_val_t _alignment,
+    const std::nothrow_t &) noexcept
+{
+  return trackedAlloc(_size, static_cast<std::size_t>(_alignment));
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size, std::align_val_t _alignment,
+    const std::nothrow_t &) noexcept
+{
+  return trackedAlloc(_size, static_cast<std::size_t>(_alignment));
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::align_val_t,
+    const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::align_val_t,
+    const std::nothrow_t &) noexcept
+{
+  std::free(_ptr);
+}
+#endif
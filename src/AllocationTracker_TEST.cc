@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <new>
+#include <thread>
+
+#include "ignition/gazebo/AllocationTracker.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Allocate and free memory with explicit calls, which the compiler
+/// can't elide.
+/// \param[in] _bytes Size of the allocation.
+static void allocate(std::size_t _bytes)
+{
+  void *ptr = ::operator new(_bytes);
+  ::operator delete(ptr);
+}
+
+/////////////////////////////////////////////////
+TEST(AllocationTrackerTest, Disabled)
+{
+  if (AllocationTracker::Enabled())
+    GTEST_SKIP() << "Allocation tracking is compiled in";
+
+  allocate(64u);
+  EXPECT_EQ(0u, AllocationTracker::ThreadCounts().count);
+  EXPECT_EQ(0u, AllocationTracker::ThreadCounts().bytes);
+
+  {
+    AllocationTracker::Scope scope("AllocationTrackerTest::Disabled");
+    allocate(64u);
+  }
+  EXPECT_EQ(0u,
+      AllocationTracker::ScopeCounts().count(
+          "AllocationTrackerTest::Disabled"));
+}
+
+/////////////////////////////////////////////////
+TEST(AllocationTrackerTest, Scopes)
+{
+  if (!AllocationTracker::Enabled())
+    GTEST_SKIP() << "Allocation tracking isn't compiled in";
+
+  const auto start = AllocationTracker::ThreadCounts();
+  allocate(64u);
+  const auto end = AllocationTracker::ThreadCounts();
+  EXPECT_EQ(start.count + 1u, end.count);
+  EXPECT_EQ(start.bytes + 64u, end.bytes);
+
+  // Outer scopes are charged the allocations of nested ones
+  {
+    AllocationTracker::Scope outer("AllocationTrackerTest::Outer");
+    allocate(16u);
+    {
+      AllocationTracker::Scope inner("AllocationTrackerTest::Inner");
+      allocate(32u);
+      allocate(32u);
+    }
+  }
+
+  // Scopes of several threads add up
+  std::thread thread([]
+  {
+    AllocationTracker::Scope inner("AllocationTrackerTest::Inner");
+    allocate(8u);
+  });
+  thread.join();
+
+  auto counts = AllocationTracker::ScopeCounts();
+  ASSERT_EQ(1u, counts.count("AllocationTrackerTest::Outer"));
+  ASSERT_EQ(1u, counts.count("AllocationTrackerTest::Inner"));
+  EXPECT_EQ(3u, counts["AllocationTrackerTest::Outer"].count);
+  EXPECT_EQ(80u, counts["AllocationTrackerTest::Outer"].bytes);
+  EXPECT_EQ(3u, counts["AllocationTrackerTest::Inner"].count);
+  EXPECT_EQ(72u, counts["AllocationTrackerTest::Inner"].bytes);
+
+  // Scopes without allocations aren't listed
+  {
+    AllocationTracker::Scope scope("AllocationTrackerTest::Empty");
+  }
+  EXPECT_EQ(0u,
+      AllocationTracker::ScopeCounts().count("AllocationTrackerTest::Empty"));
+}
@@ -17,6 +17,12 @@
 
 #include "Barrier.hh"
 
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+
 class ignition::gazebo::BarrierPrivate
 {
   /// \brief Mutex for syncronization
@@ -31,20 +37,43 @@ class ignition::gazebo::BarrierPrivate
   /// \brief Number of participating threads
   public: unsigned int threadCount;
 
+  /// \brief Number of times a waiting thread polls before blocking
+  public: unsigned int spinCount{0};
+
   /// \brief Current remaining thread count (decrements from threadCount)
-  public: unsigned int count;
+  public: std::atomic<unsigned int> count;
 
   /// \brief Barrier generation, incremented when all threads report
-  public: unsigned int generation{0};
+  public: std::atomic<unsigned int> generation{0};
+
+  /// \brief Number of threads blocked on the condition variable. Protected
+  /// by the mutex.
+  public: unsigned int sleepers{0};
 };
 
 using namespace ignition::gazebo;
 
 //////////////////////////////////////////////////
-Barrier::Barrier(unsigned int _threadCount)
+/// \brief Hint the processor that the thread is busy waiting.
+static inline void cpuRelax()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+//////////////////////////////////////////////////
+Barrier::Barrier(unsigned int _threadCount, unsigned int _spinCount)
   : dataPtr(std::make_unique<BarrierPrivate>())
 {
   this->dataPtr->threadCount = _threadCount;
+  this->dataPtr->spinCount = _spinCount;
   this->dataPtr->count = _threadCount;
 }
 
@@ -59,23 +88,49 @@ Barrier::ExitStatus Barrier::Wait()
     return Barrier::ExitStatus::CANCELLED;
   }
 
-  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
-  unsigned int gen = this->dataPtr->generation;
+  // The generation can't change before this thread arrives, so it's safe to
+  // read it first
+  const unsigned int gen =
+      this->dataPtr->generation.load(std::memory_order_acquire);
 
-  if (--this->dataPtr->count == 0)
+  if (this->dataPtr->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
   {
-    // All threads have reached the wait, so reset the barrier.
-    this->dataPtr->generation++;
-    this->dataPtr->count = this->dataPtr->threadCount;
-    this->dataPtr->cv.notify_all();
+    // All threads have reached the wait, so reset the barrier. The count is
+    // reset before releasing the other threads, so they can't call Wait
+    // again before it's ready.
+    this->dataPtr->count.store(this->dataPtr->threadCount,
+        std::memory_order_relaxed);
+    bool wake;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->generation.fetch_add(1, std::memory_order_release);
+      wake = this->dataPtr->sleepers > 0;
+    }
+    if (wake)
+      this->dataPtr->cv.notify_all();
     return Barrier::ExitStatus::DONE_LAST;
   }
 
-  while (gen == this->dataPtr->generation && !this->dataPtr->cancelled)
+  auto released = [&]()
+  {
+    return gen != this->dataPtr->generation.load(std::memory_order_acquire) ||
+        this->dataPtr->cancelled;
+  };
+
+  for (unsigned int i = 0; i < this->dataPtr->spinCount && !released(); ++i)
+    cpuRelax();
+
+  if (!released())
   {
-    // All threads haven't reached, so wait until generation is reached
-    // or a cancel occurs
-    this->dataPtr->cv.wait(lock);
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    ++this->dataPtr->sleepers;
+    while (!released())
+    {
+      // All threads haven't reached, so wait until generation is reached
+      // or a cancel occurs
+      this->dataPtr->cv.wait(lock);
+    }
+    --this->dataPtr->sleepers;
   }
 
   if (this->dataPtr->cancelled)
@@ -97,4 +152,3 @@ void Barrier::Cancel()
   this->dataPtr->cancelled = true;
   this->dataPtr->cv.notify_all();
 }
-
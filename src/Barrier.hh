@@ -42,6 +42,11 @@ namespace ignition
     /// all required threads have reached the wait() method.  This is useful
     /// for syncronizing work across many threads.
     ///
+    /// Threads that aren't the last to arrive can spin for a while before
+    /// blocking, see the constructor. The last thread to arrive only wakes
+    /// up the threads that are blocked, so no system call is made when all
+    /// threads arrive while spinning.
+    ///
     /// Note that this can likely be replaced once the C++ concurrency TS
     /// is ratified: https://en.cppreference.com/w/cpp/experimental/barrier
     class IGNITION_GAZEBO_VISIBLE Barrier
@@ -51,7 +56,13 @@ namespace ignition
       /// Note: it is important to include a main thread (if used) in this
       ///       count.  For instance, controlling 10 worker threads from
       ///       1 main thread would require _threadCount=11.
-      public: explicit Barrier(unsigned int _threadCount);
+      /// \param[in] _spinCount Number of times a waiting thread polls the
+      /// barrier before blocking. Spinning avoids the cost of putting
+      /// threads to sleep and waking them up when all threads are expected
+      /// to arrive shortly, at the cost of burning CPU while waiting. Zero
+      /// blocks right away.
+      public: explicit Barrier(unsigned int _threadCount,
+                  unsigned int _spinCount = 0u);
 
       /// \brief Destructor
       public: ~Barrier();
@@ -17,7 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <thread>
+#include <vector>
 
 #include "Barrier.hh"
 
@@ -174,3 +176,50 @@ TEST(Barrier, Cancel)
 
   t.join();
 }
+
+//////////////////////////////////////////////////
+TEST(Barrier, SpinGenerations)
+{
+  // Threads that spin and threads that block can share a barrier across
+  // many generations, with exactly one DONE_LAST per generation
+  constexpr unsigned int threadCount{4};
+  constexpr unsigned int generations{500};
+
+  for (unsigned int spin : {0u, 1000u})
+  {
+    auto barrier = std::make_unique<gazebo::Barrier>(threadCount, spin);
+    std::atomic<unsigned int> lastCount{0};
+    std::atomic<unsigned int> arrived{0};
+    std::atomic<bool> inSync{true};
+
+    auto work = [&]()
+    {
+      for (unsigned int gen = 0; gen < generations; ++gen)
+      {
+        arrived++;
+        auto ret = barrier->Wait();
+        if (ret == gazebo::Barrier::ExitStatus::DONE_LAST)
+          lastCount++;
+        else if (ret != gazebo::Barrier::ExitStatus::DONE)
+          inSync = false;
+
+        // Nobody can be in the next generation before everybody is done
+        // with this one
+        if (arrived < (gen + 1) * threadCount)
+          inSync = false;
+        barrier->Wait();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i + 1 < threadCount; ++i)
+      threads.push_back(std::thread(work));
+    work();
+
+    for (auto &t : threads)
+      t.join();
+
+    EXPECT_TRUE(inSync) << spin;
+    EXPECT_EQ(generations, lastCount) << spin;
+  }
+}
@@ -16,15 +16,134 @@
 */
 #include "ignition/gazebo/detail/BaseView.hh"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "ignition/gazebo/detail/View.hh"
 #include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/Types.hh"
 
+#include "MemoryEstimate.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace detail;
 
+/// \brief Mutex which protects the map of view states.
+/// \return The mutex.
+static std::shared_mutex &StatesMutex()
+{
+  static std::shared_mutex mutex;
+  return mutex;
+}
+
+/// \brief States of all views, by view. Views can be created and used by
+/// several threads at once, so this must be accessed under StatesMutex.
+/// \return The states.
+static std::unordered_map<const BaseView *, std::unique_ptr<ViewState>>
+    &States()
+{
+  static std::unordered_map<const BaseView *, std::unique_ptr<ViewState>>
+      states;
+  return states;
+}
+
+//////////////////////////////////////////////////
+std::size_t detail::NextQueryViewSlot()
+{
+  static std::atomic<std::size_t> nextSlot{0u};
+  return nextSlot++;
+}
+
+//////////////////////////////////////////////////
+BaseView::BaseView() = default;
+
+//////////////////////////////////////////////////
+BaseView::BaseView(const BaseView &_view)
+  : entities(_view.entities),
+    newEntities(_view.newEntities),
+    toRemoveEntities(_view.toRemoveEntities),
+    toAddEntities(_view.toAddEntities),
+    componentTypes(_view.componentTypes)
+{
+  this->MutableState() = _view.State();
+}
+
+//////////////////////////////////////////////////
+BaseView::~BaseView()
+{
+  std::unique_lock<std::shared_mutex> lock(StatesMutex());
+  States().erase(this);
+}
+
+//////////////////////////////////////////////////
+BaseView &BaseView::operator=(const BaseView &_view)
+{
+  if (this == &_view)
+    return *this;
+
+  this->entities = _view.entities;
+  this->newEntities = _view.newEntities;
+  this->toRemoveEntities = _view.toRemoveEntities;
+  this->toAddEntities = _view.toAddEntities;
+  this->componentTypes = _view.componentTypes;
+  this->MutableState() = _view.State();
+  return *this;
+}
+
+//////////////////////////////////////////////////
+const ViewState &BaseView::State() const
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(StatesMutex());
+    auto it = States().find(this);
+    if (it != States().end())
+      return *it->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(StatesMutex());
+  auto &state = States()[this];
+  if (nullptr == state)
+    state = std::make_unique<ViewState>();
+  return *state;
+}
+
+//////////////////////////////////////////////////
+ViewState &BaseView::MutableState()
+{
+  return const_cast<ViewState &>(this->State());
+}
+
+//////////////////////////////////////////////////
+std::size_t BaseView::MemoryUsage() const
+{
+  if (auto view = dynamic_cast<const View *>(this))
+    return view->MemoryUsage();
+
+  const auto &state = this->State();
+  return sizeof(*this) + sizeof(state) + treeBytes(this->entities) +
+      vectorBytes(state.packedEntities) + vectorBytes(state.validData) +
+      treeBytes(this->newEntities) + treeBytes(this->toRemoveEntities) +
+      hashBytes(this->toAddEntities) + treeBytes(this->componentTypes) +
+      treeBytes(state.excludedTypes) + treeBytes(state.optionalTypes);
+}
+
 //////////////////////////////////////////////////
-BaseView::~BaseView() = default;
+void BaseView::Compact()
+{
+  if (auto view = dynamic_cast<View *>(this))
+  {
+    view->Compact();
+    return;
+  }
+
+  auto &state = this->MutableState();
+  compactVector(state.packedEntities);
+  compactVector(state.validData);
+  compactHash(this->toAddEntities);
+}
 
 //////////////////////////////////////////////////
 bool BaseView::HasEntity(const Entity _entity) const
@@ -54,6 +173,21 @@ bool BaseView::RequiresComponent(const ComponentTypeId _typeId) const
   return this->componentTypes.find(_typeId) != this->componentTypes.end();
 }
 
+//////////////////////////////////////////////////
+bool BaseView::IsFiltered() const
+{
+  const auto &state = this->State();
+  return !state.excludedTypes.empty() || !state.optionalTypes.empty();
+}
+
+//////////////////////////////////////////////////
+bool BaseView::FiltersComponent(const ComponentTypeId _typeId) const
+{
+  const auto &state = this->State();
+  return state.excludedTypes.find(_typeId) != state.excludedTypes.end() ||
+      state.optionalTypes.find(_typeId) != state.optionalTypes.end();
+}
+
 //////////////////////////////////////////////////
 bool BaseView::MarkEntityToRemove(const Entity _entity)
 {
@@ -66,6 +200,27 @@ bool BaseView::MarkEntityToRemove(const Entity _entity)
   return false;
 }
 
+//////////////////////////////////////////////////
+void BaseView::RemoveEntities(const std::vector<Entity> &_entities)
+{
+  if (auto view = dynamic_cast<View *>(this))
+  {
+    view->RemoveEntities(_entities);
+    return;
+  }
+
+  for (const Entity entity : _entities)
+    this->RemoveEntity(entity);
+}
+
+//////////////////////////////////////////////////
+void BaseView::MarkAllEntitiesToRemove()
+{
+  this->toRemoveEntities.insert(this->entities.begin(), this->entities.end());
+  for (const auto &entityNewPair : this->toAddEntities)
+    this->toRemoveEntities.insert(entityNewPair.first);
+}
+
 //////////////////////////////////////////////////
 void BaseView::ResetNewEntityState()
 {
@@ -82,11 +237,30 @@ const std::set<ComponentTypeId> &BaseView::ComponentTypes() const
   return this->componentTypes;
 }
 
+//////////////////////////////////////////////////
+const std::set<ComponentTypeId> &BaseView::ExcludedComponentTypes() const
+{
+  return this->State().excludedTypes;
+}
+
+//////////////////////////////////////////////////
+const std::set<ComponentTypeId> &BaseView::OptionalComponentTypes() const
+{
+  return this->State().optionalTypes;
+}
+
+//////////////////////////////////////////////////
 const std::set<Entity> &BaseView::Entities() const
 {
   return this->entities;
 }
 
+//////////////////////////////////////////////////
+const std::vector<Entity> &BaseView::PackedEntities() const
+{
+  return this->State().packedEntities;
+}
+
 //////////////////////////////////////////////////
 const std::set<Entity> &BaseView::NewEntities() const
 {
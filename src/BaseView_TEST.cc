@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 #include <ignition/common/Console.hh>
 
 #include "ignition/gazebo/Entity.hh"
@@ -173,6 +175,97 @@ TEST_F(BaseViewTest, AddEntities)
   ASSERT_EQ(2u, e2Data.size());
   EXPECT_EQ(&e2ModelComp, e2Data[0]);
   EXPECT_EQ(&e2NameComp, e2Data[1]);
+
+  // Adding the const data of an entity which is already in the view doesn't
+  // add it twice
+  EXPECT_EQ(2u, modelNameView.PackedEntities().size());
+
+  // Component data can also be accessed by index, in the order of
+  // PackedEntities()
+  ASSERT_EQ(e1, modelNameView.PackedEntities()[0]);
+  EXPECT_EQ(modelNameView.ComponentDataFor(e1),
+      modelNameView.ComponentDataAt(0));
+  EXPECT_EQ(&e1ModelComp, modelNameView.ComponentDataAt(0)[0]);
+  ASSERT_EQ(e2, modelNameView.PackedEntities()[1]);
+  EXPECT_EQ(modelNameView.ComponentDataFor(e2),
+      modelNameView.ComponentDataAt(1));
+  EXPECT_EQ(&e2ModelComp, modelNameView.ComponentDataAt(1)[0]);
+
+  // Entities not in the view have no data
+  EXPECT_EQ(nullptr, modelNameView.ComponentDataFor(3));
+  EXPECT_THROW(modelNameView.EntityComponentData(3), std::out_of_range);
+  EXPECT_THROW(modelNameView.EntityComponentConstData(3), std::out_of_range);
+
+  // The returned data are copies, which don't alias each other
+  const auto &e1DataRef = modelNameView.EntityComponentData(e1);
+  const auto &e2DataRef = modelNameView.EntityComponentData(e2);
+  EXPECT_EQ(&e1ModelComp, e1DataRef[0]);
+  EXPECT_EQ(&e2ModelComp, e2DataRef[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, EntitiesSorted)
+{
+  auto view = detail::View({components::Model::typeId});
+
+  auto e1ModelComp = components::Model();
+  auto e2ModelComp = components::Model();
+  auto e3ModelComp = components::Model();
+
+  // Entities are kept sorted regardless of insertion order, and their
+  // component data follows them
+  view.AddEntityWithComps(3, false, &e3ModelComp);
+  view.AddEntityWithConstComps(3, false, &e3ModelComp);
+  view.AddEntityWithComps(1, false, &e1ModelComp);
+  view.AddEntityWithConstComps(1, false, &e1ModelComp);
+  view.AddEntityWithComps(2, false, &e2ModelComp);
+  view.AddEntityWithConstComps(2, false, &e2ModelComp);
+  ASSERT_EQ(3u, view.PackedEntities().size());
+  EXPECT_EQ(1u, view.PackedEntities()[0]);
+  EXPECT_EQ(2u, view.PackedEntities()[1]);
+  EXPECT_EQ(3u, view.PackedEntities()[2]);
+  EXPECT_EQ(&e1ModelComp, view.ComponentDataAt(0)[0]);
+  EXPECT_EQ(&e2ModelComp, view.ComponentDataAt(1)[0]);
+  EXPECT_EQ(&e3ModelComp, view.ComponentDataAt(2)[0]);
+
+  // Removing an entity shifts the ones after it, and NextIndex accounts for
+  // that
+  EXPECT_EQ(2u, view.NextIndex(1, 2));
+  EXPECT_TRUE(view.NotifyComponentRemoval(2, components::Model::typeId));
+  EXPECT_EQ(1u, view.NextIndex(1, 2));
+  EXPECT_EQ(3u, view.PackedEntities()[1]);
+  EXPECT_EQ(&e3ModelComp, view.ComponentDataAt(1)[0]);
+
+  // Re-adding the component puts the entity back in place
+  EXPECT_TRUE(view.NotifyComponentAddition(2, false,
+      components::Model::typeId));
+  ASSERT_EQ(3u, view.PackedEntities().size());
+  EXPECT_EQ(2u, view.PackedEntities()[1]);
+  EXPECT_EQ(&e2ModelComp, view.ComponentDataAt(1)[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, Copy)
+{
+  auto view = detail::View({components::Model::typeId});
+
+  auto e1ModelComp = components::Model();
+  view.AddEntityWithComps(1, false, &e1ModelComp);
+  view.AddEntityWithConstComps(1, false, &e1ModelComp);
+
+  // The packed data is kept apart from the view, and copies get their own
+  detail::View copy(view);
+  ASSERT_EQ(1u, copy.PackedEntities().size());
+  EXPECT_EQ(&e1ModelComp, copy.ComponentDataAt(0)[0]);
+  EXPECT_NE(&view.State(), &copy.State());
+
+  EXPECT_TRUE(view.RemoveEntity(1));
+  EXPECT_TRUE(view.PackedEntities().empty());
+  EXPECT_EQ(1u, copy.PackedEntities().size());
+
+  copy = view;
+  EXPECT_TRUE(copy.PackedEntities().empty());
+  EXPECT_FALSE(copy.HasEntity(1));
 }
 
 /////////////////////////////////////////////////
@@ -320,6 +413,12 @@ TEST_F(BaseViewTest, CachedComponentData)
   view.AddEntityWithConstComps(e1, e1IsNew, &e1ModelComp);
   EXPECT_TRUE(view.HasCachedComponentData(e1));
 
+  // the data stays cached while the entity is not part of the view because
+  // of a missing component
+  EXPECT_TRUE(view.NotifyComponentRemoval(e1, components::Model::typeId));
+  EXPECT_FALSE(view.HasEntity(e1));
+  EXPECT_TRUE(view.HasCachedComponentData(e1));
+
   // reset the view and add only const component data this time
   view.Reset();
   EXPECT_FALSE(view.HasCachedComponentData(e1));
@@ -521,3 +620,20 @@ TEST_F(BaseViewTest, ComponentTypeHasher)
   uniqueVecs.insert(vec7);
   EXPECT_EQ(7u, uniqueVecs.size());
 }
+
+/////////////////////////////////////////////////
+TEST_F(BaseViewTest, QueryViewSlot)
+{
+  const auto modelSlot = detail::QueryViewSlot<components::Model>();
+  const auto modelNameSlot =
+      detail::QueryViewSlot<components::Model, components::Name>();
+  const auto nameModelSlot =
+      detail::QueryViewSlot<components::Name, components::Model>();
+
+  // Slots are stable, and unique per list of component types
+  EXPECT_EQ(modelSlot, detail::QueryViewSlot<components::Model>());
+  EXPECT_EQ(modelNameSlot,
+      (detail::QueryViewSlot<components::Model, components::Name>()));
+  EXPECT_NE(modelSlot, modelNameSlot);
+  EXPECT_NE(modelNameSlot, nameModelSlot);
+}
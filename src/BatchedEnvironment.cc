@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/BatchedEnvironment.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gazebo/components/Joint.hh"
+#include "ignition/gazebo/components/JointForceCmd.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/Model.hh"
+#include "ignition/gazebo/System.hh"
+#include "ignition/gazebo/Util.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief System inserted into each environment to apply the actions and
+/// gather the observations of that environment.
+class BatchedEnvironmentSystem :
+  public System,
+  public ISystemConfigure,
+  public ISystemPreUpdate,
+  public ISystemPostUpdate
+{
+  /// \brief Constructor
+  /// \param[in] _data Data shared by all environments.
+  /// \param[in] _env Index of this environment.
+  public: BatchedEnvironmentSystem(BatchedEnvironmentPrivate *_data,
+              std::size_t _env);
+
+  // Documentation inherited
+  public: void Configure(const Entity &_entity,
+                const std::shared_ptr<const sdf::Element> &_sdf,
+                EntityComponentManager &_ecm,
+                EventManager &_eventMgr) override;
+
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) override;
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+                const EntityComponentManager &_ecm) override;
+
+  /// \brief Find the observed entities, and create the state components
+  /// that physics fills for them.
+  /// \param[in] _ecm Entity component manager.
+  public: void Resolve(EntityComponentManager &_ecm);
+
+  /// \brief Write the observations of this environment.
+  /// \param[in] _ecm Entity component manager.
+  public: void Observe(const EntityComponentManager &_ecm);
+
+  /// \brief Manager of this environment, set on Configure.
+  public: EntityComponentManager *ecm{nullptr};
+
+  /// \brief Observed model entities, kNullEntity if not found.
+  public: std::vector<Entity> models;
+
+  /// \brief Observed joint entities, kNullEntity if not found.
+  public: std::vector<Entity> joints;
+
+  /// \brief Data shared by all environments.
+  private: BatchedEnvironmentPrivate *data;
+
+  /// \brief Index of this environment.
+  private: std::size_t env;
+};
+
+//////////////////////////////////////////////////
+class ignition::gazebo::BatchedEnvironmentPrivate
+{
+  /// \brief Find the observed entities and save the initial state of all
+  /// environments, the first time it's called.
+  public: void Start();
+
+  /// \brief Server running all environments.
+  public: std::shared_ptr<gazebo::Server> server;
+
+  /// \brief System of each environment.
+  public: std::vector<std::shared_ptr<BatchedEnvironmentSystem>> systems;
+
+  /// \brief Names of the observed models.
+  public: std::vector<std::string> modelNames;
+
+  /// \brief Model and joint names of the observed joints.
+  public: std::vector<std::pair<std::string, std::string>> jointNames;
+
+  /// \brief Id of the initial checkpoint of each environment.
+  public: std::vector<uint64_t> checkpoints;
+
+  /// \brief True once the environments have started.
+  public: bool started{false};
+
+  /// \brief Model poses, environment by environment.
+  public: std::vector<double> poses;
+
+  /// \brief Joint positions, environment by environment.
+  public: std::vector<double> positions;
+
+  /// \brief Joint velocities, environment by environment.
+  public: std::vector<double> velocities;
+
+  /// \brief Joint forces, environment by environment.
+  public: std::vector<double> forces;
+};
+
+//////////////////////////////////////////////////
+BatchedEnvironmentSystem::BatchedEnvironmentSystem(
+    BatchedEnvironmentPrivate *_data, std::size_t _env)
+  : data(_data), env(_env)
+{
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentSystem::Configure(const Entity &,
+    const std::shared_ptr<const sdf::Element> &,
+    EntityComponentManager &_ecm, EventManager &)
+{
+  this->ecm = &_ecm;
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentSystem::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("BatchedEnvironmentSystem::PreUpdate");
+  const std::size_t offset = this->env * this->joints.size();
+  for (std::size_t i = 0; i < this->joints.size(); ++i)
+  {
+    const Entity joint = this->joints[i];
+    if (kNullEntity == joint)
+      continue;
+
+    const double value = this->data->forces[offset + i];
+    auto force = _ecm.Component<components::JointForceCmd>(joint);
+    if (nullptr == force)
+      _ecm.CreateComponent(joint, components::JointForceCmd({value}));
+    else if (!force->Data().empty())
+      force->Data()[0] += value;
+  }
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentSystem::PostUpdate(const UpdateInfo &,
+    const EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("BatchedEnvironmentSystem::PostUpdate");
+  this->Observe(_ecm);
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentSystem::Resolve(EntityComponentManager &_ecm)
+{
+  const Entity world = _ecm.EntityByComponents(components::World());
+  auto findModel = [&](const std::string &_name)
+  {
+    return _ecm.EntityByComponents(components::Model(),
+        components::Name(_name), components::ParentEntity(world));
+  };
+
+  this->models.clear();
+  for (const auto &name : this->data->modelNames)
+  {
+    const Entity model = findModel(name);
+    if (kNullEntity == model)
+      ignwarn << "Failed to find model [" << name << "]." << std::endl;
+    this->models.push_back(model);
+  }
+
+  this->joints.clear();
+  for (const auto &[modelName, jointName] : this->data->jointNames)
+  {
+    Entity joint{kNullEntity};
+    const Entity model = findModel(modelName);
+    if (kNullEntity != model)
+      joint = Model(model).JointByName(_ecm, jointName);
+
+    if (kNullEntity == joint)
+    {
+      ignwarn << "Failed to find joint [" << jointName << "] in model ["
+              << modelName << "]." << std::endl;
+    }
+    else
+    {
+      // Physics only fills the state of joints that have these components
+      if (nullptr == _ecm.Component<components::JointPosition>(joint))
+        _ecm.CreateComponent(joint, components::JointPosition());
+      if (nullptr == _ecm.Component<components::JointVelocity>(joint))
+        _ecm.CreateComponent(joint, components::JointVelocity());
+    }
+    this->joints.push_back(joint);
+  }
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentSystem::Observe(const EntityComponentManager &_ecm)
+{
+  double *pose = this->data->poses.data() +
+      this->env * this->models.size() * BatchedEnvironment::kPoseSize;
+  for (const Entity model : this->models)
+  {
+    const math::Pose3d p = kNullEntity == model ? math::Pose3d::Zero :
+        worldPose(model, _ecm);
+    pose[0] = p.Pos().X();
+    pose[1] = p.Pos().Y();
+    pose[2] = p.Pos().Z();
+    pose[3] = p.Rot().W();
+    pose[4] = p.Rot().X();
+    pose[5] = p.Rot().Y();
+    pose[6] = p.Rot().Z();
+    pose += BatchedEnvironment::kPoseSize;
+  }
+
+  const std::size_t offset = this->env * this->joints.size();
+  for (std::size_t i = 0; i < this->joints.size(); ++i)
+  {
+    double position{0.0};
+    double velocity{0.0};
+    if (kNullEntity != this->joints[i])
+    {
+      auto positionComp =
+          _ecm.Component<components::JointPosition>(this->joints[i]);
+      if (nullptr != positionComp && !positionComp->Data().empty())
+        position = positionComp->Data()[0];
+
+      auto velocityComp =
+          _ecm.Component<components::JointVelocity>(this->joints[i]);
+      if (nullptr != velocityComp && !velocityComp->Data().empty())
+        velocity = velocityComp->Data()[0];
+    }
+    this->data->positions[offset + i] = position;
+    this->data->velocities[offset + i] = velocity;
+  }
+}
+
+//////////////////////////////////////////////////
+void BatchedEnvironmentPrivate::Start()
+{
+  if (this->started)
+    return;
+  this->started = true;
+
+  const std::size_t envs = this->systems.size();
+  this->poses.assign(
+      envs * this->modelNames.size() * BatchedEnvironment::kPoseSize, 0.0);
+  this->positions.assign(envs * this->jointNames.size(), 0.0);
+  this->velocities.assign(envs * this->jointNames.size(), 0.0);
+  this->forces.resize(envs * this->jointNames.size(), 0.0);
+
+  // The state components created here are part of the initial state, so
+  // they survive resets
+  for (std::size_t i = 0; i < envs; ++i)
+  {
+    auto &system = this->systems[i];
+    if (nullptr != system->ecm)
+    {
+      system->Resolve(*system->ecm);
+      system->Observe(*system->ecm);
+    }
+
+    // Zero is never a valid checkpoint id
+    this->checkpoints.push_back(
+        this->server->Checkpoint(static_cast<unsigned int>(i)).value_or(0u));
+  }
+}
+
+//////////////////////////////////////////////////
+BatchedEnvironment::BatchedEnvironment(const ServerConfig &_config,
+    const unsigned int _count)
+  : dataPtr(std::make_unique<BatchedEnvironmentPrivate>())
+{
+  ServerConfig config(_config);
+  config.SetWorldInstances(_count);
+  this->dataPtr->server = std::make_shared<gazebo::Server>(config);
+
+  const std::size_t envs = this->dataPtr->server->WorldCount();
+  for (std::size_t i = 0; i < envs; ++i)
+  {
+    auto system =
+        std::make_shared<BatchedEnvironmentSystem>(this->dataPtr.get(), i);
+    this->dataPtr->server->AddSystem(system, static_cast<unsigned int>(i));
+    this->dataPtr->systems.push_back(std::move(system));
+  }
+}
+
+//////////////////////////////////////////////////
+BatchedEnvironment::~BatchedEnvironment()
+{
+  // Stop the server before the systems' shared data goes away
+  this->dataPtr->server.reset();
+}
+
+//////////////////////////////////////////////////
+std::size_t BatchedEnvironment::Size() const
+{
+  return this->dataPtr->systems.size();
+}
+
+//////////////////////////////////////////////////
+std::optional<std::size_t> BatchedEnvironment::AddModel(
+    const std::string &_model)
+{
+  if (this->dataPtr->started)
+    return std::nullopt;
+
+  this->dataPtr->modelNames.push_back(_model);
+  return this->dataPtr->modelNames.size() - 1u;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::size_t> BatchedEnvironment::AddJoint(
+    const std::string &_model, const std::string &_joint)
+{
+  if (this->dataPtr->started)
+    return std::nullopt;
+
+  this->dataPtr->jointNames.push_back({_model, _joint});
+  return this->dataPtr->jointNames.size() - 1u;
+}
+
+//////////////////////////////////////////////////
+std::size_t BatchedEnvironment::ModelCount() const
+{
+  return this->dataPtr->modelNames.size();
+}
+
+//////////////////////////////////////////////////
+std::size_t BatchedEnvironment::JointCount() const
+{
+  return this->dataPtr->jointNames.size();
+}
+
+//////////////////////////////////////////////////
+bool BatchedEnvironment::SetJointForces(const std::vector<double> &_forces)
+{
+  if (_forces.size() != this->Size() * this->JointCount())
+    return false;
+
+  // Don't reallocate, the systems may hold on to the data
+  this->dataPtr->forces.resize(_forces.size());
+  std::copy(_forces.begin(), _forces.end(), this->dataPtr->forces.begin());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BatchedEnvironment::Step(const uint64_t _iterations)
+{
+  IGN_PROFILE("BatchedEnvironment::Step");
+  this->dataPtr->Start();
+  return this->dataPtr->server->StepAll(_iterations);
+}
+
+//////////////////////////////////////////////////
+bool BatchedEnvironment::Reset()
+{
+  bool result{true};
+  for (std::size_t i = 0; i < this->Size(); ++i)
+    result = this->Reset(i) && result;
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool BatchedEnvironment::Reset(const std::size_t _env)
+{
+  IGN_PROFILE("BatchedEnvironment::Reset");
+  this->dataPtr->Start();
+  if (_env >= this->dataPtr->checkpoints.size())
+    return false;
+
+  if (!this->dataPtr->server->Restore(this->dataPtr->checkpoints[_env],
+      static_cast<unsigned int>(_env)))
+  {
+    return false;
+  }
+
+  // The restore is immediate while the server isn't stepping
+  auto &system = this->dataPtr->systems[_env];
+  if (nullptr != system->ecm)
+    system->Observe(*system->ecm);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &BatchedEnvironment::ModelPoses() const
+{
+  return this->dataPtr->poses;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &BatchedEnvironment::JointPositions() const
+{
+  return this->dataPtr->positions;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &BatchedEnvironment::JointVelocities() const
+{
+  return this->dataPtr->velocities;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<gazebo::Server> BatchedEnvironment::Server() const
+{
+  return this->dataPtr->server;
+}
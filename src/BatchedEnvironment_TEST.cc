@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <ignition/common/Util.hh>
+
+#include "ignition/gazebo/BatchedEnvironment.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/test_config.hh"
+
+#include "../test/helpers/EnvTestFixture.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+class BatchedEnvironmentTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(BatchedEnvironmentTest, StepAndReset)
+{
+  ServerConfig config;
+  config.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "revolute_joint.sdf"));
+
+  BatchedEnvironment envs(config, 3u);
+  EXPECT_EQ(3u, envs.Size());
+  ASSERT_NE(nullptr, envs.Server());
+  EXPECT_EQ(3u, envs.Server()->WorldCount());
+
+  EXPECT_EQ(0u, envs.AddModel("revolute_demo"));
+  EXPECT_EQ(1u, envs.AddModel("missing"));
+  EXPECT_EQ(0u, envs.AddJoint("revolute_demo", "j2"));
+  EXPECT_EQ(2u, envs.ModelCount());
+  EXPECT_EQ(1u, envs.JointCount());
+
+  // Wrong number of forces
+  EXPECT_FALSE(envs.SetJointForces({1.0}));
+  EXPECT_TRUE(envs.SetJointForces({0.0, 5.0, -5.0}));
+
+  EXPECT_TRUE(envs.Step(100u));
+
+  // Nothing can be added once the environments have started
+  EXPECT_FALSE(envs.AddModel("ground_plane").has_value());
+  EXPECT_FALSE(envs.AddJoint("revolute_demo", "j1").has_value());
+
+  const auto &poses = envs.ModelPoses();
+  const auto &positions = envs.JointPositions();
+  const auto &velocities = envs.JointVelocities();
+  ASSERT_EQ(3u * 2u * BatchedEnvironment::kPoseSize, poses.size());
+  ASSERT_EQ(3u, positions.size());
+  ASSERT_EQ(3u, velocities.size());
+
+  // Each environment has its own state
+  EXPECT_NE(positions[1], positions[2]);
+  EXPECT_NE(velocities[1], velocities[2]);
+
+  // Missing models have a zero pose
+  for (std::size_t i = 0; i < BatchedEnvironment::kPoseSize; ++i)
+    EXPECT_DOUBLE_EQ(0.0, poses[BatchedEnvironment::kPoseSize + i]);
+
+  // The model isn't moving, so its orientation stays valid
+  EXPECT_NEAR(1.0, poses[3] * poses[3] + poses[4] * poses[4] +
+      poses[5] * poses[5] + poses[6] * poses[6], 1e-6);
+
+  // Resetting a single environment leaves the others untouched
+  const double position2 = positions[2];
+  EXPECT_TRUE(envs.Reset(1u));
+  EXPECT_DOUBLE_EQ(0.0, velocities[1]);
+  EXPECT_DOUBLE_EQ(position2, positions[2]);
+  EXPECT_FALSE(envs.Reset(3u));
+
+  EXPECT_TRUE(envs.Reset());
+  EXPECT_DOUBLE_EQ(positions[0], positions[1]);
+  EXPECT_DOUBLE_EQ(positions[0], positions[2]);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_BINARYSTREAM_HH_
+#define IGNITION_GAZEBO_BINARYSTREAM_HH_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Write the bytes of a trivially copyable value, as done by the
+    /// cache files.
+    /// \param[in] _out Stream to write to.
+    /// \param[in] _value Value to write.
+    template<typename T>
+    void writeValue(std::ostream &_out, const T &_value)
+    {
+      _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+    }
+
+    /// \brief Write a string as its size followed by its characters.
+    /// \param[in] _out Stream to write to.
+    /// \param[in] _value String to write.
+    inline void writeString(std::ostream &_out, const std::string &_value)
+    {
+      writeValue<uint64_t>(_out, _value.size());
+      _out.write(_value.data(), static_cast<std::streamsize>(_value.size()));
+    }
+    }
+  }
+}
+#endif
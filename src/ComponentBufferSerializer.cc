@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "ignition/gazebo/components/Factory.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace components;
+
+/// \brief Buffer serializers of all registered component types, by id.
+/// \return The serializers.
+static std::unordered_map<ComponentTypeId, ComponentBufferSerializer>
+    &Registry()
+{
+  static std::unordered_map<ComponentTypeId, ComponentBufferSerializer>
+      registry;
+  return registry;
+}
+
+//////////////////////////////////////////////////
+void ComponentBufferSerializer::Register(const ComponentTypeId _typeId,
+    const ComponentBufferSerializer &_serializer)
+{
+  Registry()[_typeId] = _serializer;
+}
+
+//////////////////////////////////////////////////
+void ComponentBufferSerializer::Unregister(const ComponentTypeId _typeId)
+{
+  Registry().erase(_typeId);
+}
+
+//////////////////////////////////////////////////
+const ComponentBufferSerializer *ComponentBufferSerializer::Find(
+    const ComponentTypeId _typeId)
+{
+  auto it = Registry().find(_typeId);
+  if (it == Registry().end())
+    return nullptr;
+  return &it->second;
+}
+
+//////////////////////////////////////////////////
+void ComponentBufferSerializer::Serialize(const BaseComponent &_comp,
+    std::string &_buffer)
+{
+  auto serializer = Find(_comp.TypeId());
+  if (nullptr != serializer && nullptr != serializer->serialize)
+  {
+    serializer->serialize(&_comp, _buffer);
+    return;
+  }
+
+  std::ostringstream ostr;
+  _comp.Serialize(ostr);
+  _buffer += ostr.str();
+}
+
+//////////////////////////////////////////////////
+void ComponentBufferSerializer::Deserialize(BaseComponent &_comp,
+    const std::string &_buffer)
+{
+  auto serializer = Find(_comp.TypeId());
+  if (nullptr != serializer && nullptr != serializer->deserialize)
+  {
+    serializer->deserialize(&_comp, _buffer);
+    return;
+  }
+
+  std::istringstream istr(_buffer);
+  _comp.Deserialize(istr);
+}
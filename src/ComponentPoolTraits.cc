@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <unordered_map>
+
+#include "ignition/gazebo/components/Factory.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace components;
+
+/// \brief Traits of all registered component types, by id. Like the
+/// factory's own maps, this is filled as types are registered, which happens
+/// while libraries are loaded, before the traits are needed.
+/// \return The traits.
+static std::unordered_map<ComponentTypeId, ComponentPoolTraits> &Registry()
+{
+  static std::unordered_map<ComponentTypeId, ComponentPoolTraits> registry;
+  return registry;
+}
+
+//////////////////////////////////////////////////
+void ComponentPoolTraits::Register(const ComponentTypeId _typeId,
+    const ComponentPoolTraits &_traits)
+{
+  Registry()[_typeId] = _traits;
+}
+
+//////////////////////////////////////////////////
+void ComponentPoolTraits::Unregister(const ComponentTypeId _typeId)
+{
+  Registry().erase(_typeId);
+}
+
+//////////////////////////////////////////////////
+const ComponentPoolTraits *ComponentPoolTraits::Find(
+    const ComponentTypeId _typeId)
+{
+  auto it = Registry().find(_typeId);
+  if (it == Registry().end())
+    return nullptr;
+  return &it->second;
+}
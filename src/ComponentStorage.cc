@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ComponentStorage.hh"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "ignition/gazebo/components/Factory.hh"
+
+#include "MemoryEstimate.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Maximum number of slots in a single chunk of pooled components.
+static constexpr std::size_t kMaxChunkSlots{1024u};
+
+//////////////////////////////////////////////////
+ComponentTypeStorage::~ComponentTypeStorage()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentTypeStorage::Add(const Entity _entity,
+    std::unique_ptr<components::BaseComponent> _component,
+    const uint64_t _tick)
+{
+  auto comp = _component.get();
+  return this->Push(_entity, comp, std::move(_component), _tick);
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentTypeStorage::Emplace(const Entity _entity,
+    const components::ComponentDescriptorBase &_descriptor,
+    const components::ComponentPoolTraits *_traits,
+    const components::BaseComponent *_data, const uint64_t _tick)
+{
+  if (nullptr != _traits && nullptr != _traits->construct &&
+      _traits->size > 0u && _traits->alignment <= alignof(std::max_align_t))
+  {
+    void *slot = this->AcquireSlot(_traits->size, _traits->alignment);
+    if (nullptr != slot)
+    {
+      auto comp = _traits->construct(slot, _data);
+      if (nullptr != comp)
+        return this->Push(_entity, comp, nullptr, _tick);
+      this->freeSlots.push_back(slot);
+    }
+  }
+
+  ++this->allocations;
+  return this->Add(_entity, _descriptor.Create(_data), _tick);
+}
+
+//////////////////////////////////////////////////
+void *ComponentTypeStorage::AcquireSlot(const std::size_t _size,
+    const std::size_t _alignment)
+{
+  // All instances of a type have the same size, so the slot size is fixed
+  // by the first one
+  if (this->slotSize == 0u)
+    this->slotSize = (_size + _alignment - 1u) / _alignment * _alignment;
+  else if (_size > this->slotSize || this->slotSize % _alignment != 0u)
+    return nullptr;
+
+  if (this->freeSlots.empty())
+  {
+    const std::size_t slots = this->nextChunkSlots;
+    const std::size_t words = (slots * this->slotSize +
+        sizeof(std::max_align_t) - 1u) / sizeof(std::max_align_t);
+    this->chunks.push_back(std::make_unique<std::max_align_t[]>(words));
+    this->chunkSlots.push_back(slots);
+    this->chunkBytes += words * sizeof(std::max_align_t);
+    ++this->allocations;
+
+    // Reserve room for every slot, so that releasing slots never allocates
+    const std::size_t capacity = this->freeSlots.capacity();
+    this->freeSlots.reserve(capacity + slots);
+    if (this->freeSlots.capacity() != capacity)
+      ++this->allocations;
+
+    auto memory = reinterpret_cast<char *>(this->chunks.back().get());
+    for (std::size_t i = slots; i > 0u; --i)
+      this->freeSlots.push_back(memory + (i - 1u) * this->slotSize);
+
+    this->nextChunkSlots = std::min(slots * 2u, kMaxChunkSlots);
+  }
+
+  void *slot = this->freeSlots.back();
+  this->freeSlots.pop_back();
+  return slot;
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentTypeStorage::Push(const Entity _entity,
+    components::BaseComponent *_component,
+    std::unique_ptr<components::BaseComponent> _owned,
+    const uint64_t _tick)
+{
+  // All packed arrays grow together
+  if (this->components.size() == this->components.capacity())
+    ++this->allocations;
+
+  const std::size_t index = this->components.size();
+  this->components.push_back(_component);
+  this->owned.push_back(std::move(_owned));
+  this->entities.push_back(_entity);
+  this->ticks.push_back(_tick);
+  ++this->generation;
+  return index;
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::Destroy(const std::size_t _index)
+{
+  if (this->owned[_index])
+  {
+    this->owned[_index].reset();
+    return;
+  }
+
+  // The slot starts at the most derived object, which isn't necessarily
+  // where the base class lives
+  auto comp = this->components[_index];
+  void *slot = dynamic_cast<void *>(comp);
+  comp->~BaseComponent();
+  this->freeSlots.push_back(slot);
+}
+
+//////////////////////////////////////////////////
+Entity ComponentTypeStorage::Remove(const std::size_t _index)
+{
+  if (_index >= this->components.size())
+    return kNullEntity;
+
+  this->Destroy(_index);
+  ++this->generation;
+
+  const std::size_t last = this->components.size() - 1;
+  Entity moved{kNullEntity};
+  if (_index != last)
+  {
+    this->owned[_index] = std::move(this->owned[last]);
+    this->components[_index] = this->components[last];
+    this->entities[_index] = this->entities[last];
+    this->ticks[_index] = this->ticks[last];
+    moved = this->entities[_index];
+  }
+
+  this->owned.pop_back();
+  this->components.pop_back();
+  this->entities.pop_back();
+  this->ticks.pop_back();
+
+  return moved;
+}
+
+//////////////////////////////////////////////////
+components::BaseComponent *ComponentTypeStorage::Component(
+    const std::size_t _index) const
+{
+  if (_index >= this->components.size())
+    return nullptr;
+  return this->components[_index];
+}
+
+//////////////////////////////////////////////////
+Entity ComponentTypeStorage::EntityAt(const std::size_t _index) const
+{
+  if (_index >= this->entities.size())
+    return kNullEntity;
+  return this->entities[_index];
+}
+
+//////////////////////////////////////////////////
+uint64_t ComponentTypeStorage::Tick(const std::size_t _index) const
+{
+  if (_index >= this->ticks.size())
+    return 0u;
+  return this->ticks[_index];
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::SetTick(const std::size_t _index,
+    const uint64_t _tick)
+{
+  if (_index < this->ticks.size())
+    this->ticks[_index] = _tick;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint64_t> &ComponentTypeStorage::Ticks() const
+{
+  return this->ticks;
+}
+
+//////////////////////////////////////////////////
+const std::vector<components::BaseComponent *>
+    &ComponentTypeStorage::Components() const
+{
+  return this->components;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &ComponentTypeStorage::Entities() const
+{
+  return this->entities;
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentTypeStorage::Size() const
+{
+  return this->components.size();
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::Reserve(const std::size_t _capacity)
+{
+  if (_capacity <= this->components.capacity())
+    return;
+
+  this->owned.reserve(_capacity);
+  this->components.reserve(_capacity);
+  this->entities.reserve(_capacity);
+  this->ticks.reserve(_capacity);
+  ++this->allocations;
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::Clear()
+{
+  for (std::size_t i = 0; i < this->components.size(); ++i)
+    this->Destroy(i);
+
+  this->components.clear();
+  this->entities.clear();
+  this->ticks.clear();
+  this->owned.clear();
+  ++this->generation;
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::Compact()
+{
+  // Find the free slots of each chunk, which are contiguous once sorted
+  if (!this->chunks.empty() && !this->freeSlots.empty())
+  {
+    std::less<void *> less;
+    std::sort(this->freeSlots.begin(), this->freeSlots.end(), less);
+
+    std::vector<std::unique_ptr<std::max_align_t[]>> keptChunks;
+    std::vector<std::size_t> keptSlots;
+    std::vector<void *> keptFree;
+    std::size_t slotCount{0u};
+    for (std::size_t i = 0; i < this->chunks.size(); ++i)
+    {
+      auto memory = reinterpret_cast<char *>(this->chunks[i].get());
+      const std::size_t slots = this->chunkSlots[i];
+      auto first = std::lower_bound(this->freeSlots.begin(),
+          this->freeSlots.end(), static_cast<void *>(memory), less);
+      auto last = std::lower_bound(first, this->freeSlots.end(),
+          static_cast<void *>(memory + slots * this->slotSize), less);
+      if (static_cast<std::size_t>(last - first) == slots)
+      {
+        const std::size_t words = (slots * this->slotSize +
+            sizeof(std::max_align_t) - 1u) / sizeof(std::max_align_t);
+        this->chunkBytes -= words * sizeof(std::max_align_t);
+        continue;
+      }
+
+      keptFree.insert(keptFree.end(), first, last);
+      keptChunks.push_back(std::move(this->chunks[i]));
+      keptSlots.push_back(slots);
+      slotCount += slots;
+    }
+
+    if (keptChunks.size() != this->chunks.size())
+    {
+      // Keep room for every slot, so that releasing slots never allocates
+      std::vector<void *> freed;
+      freed.reserve(slotCount);
+      freed.insert(freed.end(), keptFree.begin(), keptFree.end());
+      this->freeSlots = std::move(freed);
+      this->chunks = std::move(keptChunks);
+      this->chunkSlots = std::move(keptSlots);
+      ++this->allocations;
+    }
+  }
+
+  // The packed arrays grow together, so they're shrunk together
+  const std::size_t capacity = this->components.capacity();
+  compactVector(this->components);
+  if (this->components.capacity() != capacity)
+  {
+    this->owned.shrink_to_fit();
+    this->entities.shrink_to_fit();
+    this->ticks.shrink_to_fit();
+    ++this->allocations;
+  }
+}
+
+//////////////////////////////////////////////////
+uint64_t ComponentTypeStorage::AllocationCount() const
+{
+  return this->allocations;
+}
+
+//////////////////////////////////////////////////
+std::size_t ComponentTypeStorage::MemoryUsage(
+    const std::size_t _instanceSize) const
+{
+  // The packed arrays grow together, but may have been reserved separately
+  std::size_t bytes =
+      this->owned.capacity() * sizeof(this->owned[0]) +
+      this->components.capacity() * sizeof(this->components[0]) +
+      this->entities.capacity() * sizeof(this->entities[0]) +
+      this->ticks.capacity() * sizeof(this->ticks[0]) +
+      this->chunks.capacity() * sizeof(this->chunks[0]) +
+      this->chunkSlots.capacity() * sizeof(this->chunkSlots[0]) +
+      this->freeSlots.capacity() * sizeof(this->freeSlots[0]) +
+      this->chunkBytes;
+
+  for (const auto &comp : this->owned)
+  {
+    if (comp)
+      bytes += _instanceSize;
+  }
+  return bytes;
+}
+
+//////////////////////////////////////////////////
+const uint64_t *ComponentTypeStorage::Generation() const
+{
+  return &this->generation;
+}
+
+//////////////////////////////////////////////////
+void ComponentTypeStorage::BumpGeneration()
+{
+  ++this->generation;
+}
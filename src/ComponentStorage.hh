@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_COMPONENTSTORAGE_HH_
+#define IGNITION_GAZEBO_COMPONENTSTORAGE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    namespace components
+    {
+      class ComponentDescriptorBase;
+      class ComponentPoolTraits;
+    }
+
+    /// \class ComponentTypeStorage ComponentStorage.hh
+    /// \brief Dense storage for all the component instances of a single
+    /// component type.
+    ///
+    /// Components are kept in a packed array, side by side with a packed array
+    /// of the entities that own them, so that all components of a type can be
+    /// visited with a linear scan. Removing a component moves the last element
+    /// of the arrays into the freed slot, so an index is only valid until the
+    /// next call to Remove. Callers are responsible for updating their own
+    /// index for the entity returned by Remove.
+    ///
+    /// The address of each component instance is stable for the lifetime of
+    /// the instance, so views can safely cache component pointers.
+    ///
+    /// Instances created through Emplace are constructed in chunks of memory
+    /// owned by the storage. The slots of destroyed instances are reused by
+    /// later instances, so once the storage has grown to its peak size,
+    /// creating and removing components doesn't allocate. Note that the data
+    /// held by a component, such as a string, may still allocate on its own.
+    class IGNITION_GAZEBO_VISIBLE ComponentTypeStorage
+    {
+      /// \brief Constructor
+      public: ComponentTypeStorage() = default;
+
+      /// \brief Destructor. Destroys all components.
+      public: ~ComponentTypeStorage();
+
+      /// \brief The storage hands out pointers into its own memory, so it
+      /// can't be copied.
+      public: ComponentTypeStorage(const ComponentTypeStorage &) = delete;
+
+      /// \brief The storage can't be copied.
+      public: ComponentTypeStorage &operator=(const ComponentTypeStorage &)
+                  = delete;
+
+      /// \brief Construct a copy of a component in memory owned by the
+      /// storage. Falls back to a heap allocation through the descriptor if
+      /// there are no traits to construct instances in place.
+      /// \param[in] _entity Entity which owns the component.
+      /// \param[in] _descriptor Descriptor of the component type.
+      /// \param[in] _traits Traits of the component type, or nullptr.
+      /// \param[in] _data Component to copy.
+      /// \param[in] _tick Change tick of the new component.
+      /// \return Index of the new component in the storage.
+      public: std::size_t Emplace(const Entity _entity,
+                  const components::ComponentDescriptorBase &_descriptor,
+                  const components::ComponentPoolTraits *_traits,
+                  const components::BaseComponent *_data,
+                  const uint64_t _tick = 0u);
+
+      /// \brief Add a component instance to the storage.
+      /// \param[in] _entity Entity which owns the component.
+      /// \param[in] _component Component instance. The storage takes
+      /// ownership of it.
+      /// \param[in] _tick Change tick of the new component.
+      /// \return Index of the new component in the storage.
+      public: std::size_t Add(const Entity _entity,
+                  std::unique_ptr<components::BaseComponent> _component,
+                  const uint64_t _tick = 0u);
+
+      /// \brief Remove the component at the given index, destroying it.
+      /// \param[in] _index Index of the component to remove.
+      /// \return The entity whose component was moved into _index to keep
+      /// the storage packed, or kNullEntity if no component was moved.
+      public: Entity Remove(const std::size_t _index);
+
+      /// \brief Get the component at the given index.
+      /// \param[in] _index Index of the component.
+      /// \return Pointer to the component, or nullptr if _index is out of
+      /// range.
+      public: components::BaseComponent *Component(
+                  const std::size_t _index) const;
+
+      /// \brief Get the entity that owns the component at the given index.
+      /// \param[in] _index Index of the component.
+      /// \return The owning entity, or kNullEntity if _index is out of range.
+      public: Entity EntityAt(const std::size_t _index) const;
+
+      /// \brief Get the change tick of the component at the given index.
+      /// \param[in] _index Index of the component.
+      /// \return The simulation iteration at which the component was last
+      /// marked as changed, or zero if _index is out of range.
+      public: uint64_t Tick(const std::size_t _index) const;
+
+      /// \brief Set the change tick of the component at the given index.
+      /// \param[in] _index Index of the component.
+      /// \param[in] _tick The simulation iteration at which the component
+      /// changed.
+      public: void SetTick(const std::size_t _index, const uint64_t _tick);
+
+      /// \brief Get the change ticks of all components, packed in the same
+      /// order as Entities().
+      /// \return Change ticks.
+      public: const std::vector<uint64_t> &Ticks() const;
+
+      /// \brief Get all the component instances held by this storage, packed
+      /// in the same order as Entities().
+      /// \return Component instances.
+      public: const std::vector<components::BaseComponent *> &Components()
+                  const;
+
+      /// \brief Get all the entities that own a component in this storage,
+      /// packed in the same order as Components().
+      /// \return Owning entities.
+      public: const std::vector<Entity> &Entities() const;
+
+      /// \brief Get the number of components in the storage.
+      /// \return Number of components.
+      public: std::size_t Size() const;
+
+      /// \brief Grow the packed arrays so that they can hold at least
+      /// _capacity components without reallocating.
+      /// \param[in] _capacity Number of components.
+      public: void Reserve(const std::size_t _capacity);
+
+      /// \brief Remove and destroy all components. Memory used for pooled
+      /// components is kept, to be reused by later components.
+      public: void Clear();
+
+      /// \brief Release memory which isn't used by the current components.
+      /// Memory chunks whose slots are all free are released, and the packed
+      /// arrays are shrunk if they use less than a quarter of their capacity.
+      /// Component addresses and indices don't change.
+      public: void Compact();
+
+      /// \brief Get the number of memory allocations made by the storage
+      /// since it was created. This includes component memory chunks,
+      /// components that couldn't be pooled and the growth of the packed
+      /// arrays, but not allocations made by the components themselves.
+      /// \return Number of allocations.
+      public: uint64_t AllocationCount() const;
+
+      /// \brief Estimate the memory used by the storage. This includes the
+      /// packed arrays, the memory chunks and the components that couldn't be
+      /// pooled, but not memory allocated by the components themselves.
+      /// \param[in] _instanceSize Size of a heap allocated instance.
+      /// \return Number of bytes.
+      public: std::size_t MemoryUsage(const std::size_t _instanceSize) const;
+
+      /// \brief Get the generation of the storage, which is increased
+      /// whenever a component is added to or removed from it, so that
+      /// cached component pointers can be checked for validity.
+      /// \return Pointer to the generation, which is valid for the lifetime
+      /// of the storage.
+      public: const uint64_t *Generation() const;
+
+      /// \brief Increase the generation of the storage. This is used when
+      /// the validity of a component changes without the storage changing,
+      /// such as when a component is marked as removed.
+      public: void BumpGeneration();
+
+      /// \brief Append a component to the packed arrays.
+      /// \param[in] _entity Entity which owns the component.
+      /// \param[in] _component Component instance.
+      /// \param[in] _owned Owning handle of the component, or nullptr if the
+      /// component lives in a pooled slot.
+      /// \param[in] _tick Change tick of the component.
+      /// \return Index of the new component in the storage.
+      private: std::size_t Push(const Entity _entity,
+                   components::BaseComponent *_component,
+                   std::unique_ptr<components::BaseComponent> _owned,
+                   const uint64_t _tick);
+
+      /// \brief Destroy the component at the given index, without changing
+      /// the packed arrays.
+      /// \param[in] _index Index of the component.
+      private: void Destroy(const std::size_t _index);
+
+      /// \brief Get a free pooled slot, allocating a new chunk if needed.
+      /// \param[in] _size Size of an instance.
+      /// \param[in] _alignment Alignment of an instance.
+      /// \return Memory for one instance.
+      private: void *AcquireSlot(const std::size_t _size,
+                   const std::size_t _alignment);
+
+      /// \brief Owning handles of the component instances. This is kept
+      /// apart from `components` so that scans don't need to go through
+      /// the unique pointers. Null for components in pooled slots.
+      private: std::vector<std::unique_ptr<components::BaseComponent>> owned;
+
+      /// \brief Raw pointers to the component instances.
+      private: std::vector<components::BaseComponent *> components;
+
+      /// \brief Entity which owns the component at the same index in
+      /// `components`.
+      private: std::vector<Entity> entities;
+
+      /// \brief Change tick of the component at the same index in
+      /// `components`.
+      private: std::vector<uint64_t> ticks;
+
+      /// \brief Memory chunks holding pooled components.
+      private: std::vector<std::unique_ptr<std::max_align_t[]>> chunks;
+
+      /// \brief Number of slots in the chunk at the same index in `chunks`.
+      private: std::vector<std::size_t> chunkSlots;
+
+      /// \brief Pooled slots which don't hold a component.
+      private: std::vector<void *> freeSlots;
+
+      /// \brief Distance in bytes between pooled slots. Zero until the first
+      /// component is pooled.
+      private: std::size_t slotSize{0u};
+
+      /// \brief Number of slots in the next chunk.
+      private: std::size_t nextChunkSlots{16u};
+
+      /// \brief Number of allocations made so far.
+      private: uint64_t allocations{0u};
+
+      /// \brief Total size of the memory chunks, in bytes.
+      private: std::size_t chunkBytes{0u};
+
+      /// \brief Generation of the storage, see Generation().
+      private: uint64_t generation{0u};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/components/Factory.hh"
+#include "ComponentStorage.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+using IntComponent = components::Component<int, class IntComponentTag>;
+
+/////////////////////////////////////////////////
+TEST(ComponentTypeStorageTest, AddRemove)
+{
+  ComponentTypeStorage storage;
+  EXPECT_EQ(0u, storage.Size());
+  EXPECT_EQ(nullptr, storage.Component(0));
+  EXPECT_EQ(kNullEntity, storage.EntityAt(0));
+  EXPECT_EQ(kNullEntity, storage.Remove(0));
+
+  EXPECT_EQ(0u, storage.Add(10, std::make_unique<IntComponent>(100)));
+  EXPECT_EQ(1u, storage.Add(20, std::make_unique<IntComponent>(200)));
+  EXPECT_EQ(2u, storage.Add(30, std::make_unique<IntComponent>(300)));
+  EXPECT_EQ(3u, storage.Size());
+
+  auto third = storage.Component(2);
+  ASSERT_NE(nullptr, third);
+  EXPECT_EQ(300, static_cast<IntComponent *>(third)->Data());
+  EXPECT_EQ(30u, storage.EntityAt(2));
+
+  // Removing from the middle moves the last element into the freed slot,
+  // without changing its address
+  EXPECT_EQ(30u, storage.Remove(0));
+  EXPECT_EQ(2u, storage.Size());
+  EXPECT_EQ(third, storage.Component(0));
+  EXPECT_EQ(30u, storage.EntityAt(0));
+  EXPECT_EQ(20u, storage.EntityAt(1));
+
+  // Removing the last element doesn't move anything
+  EXPECT_EQ(kNullEntity, storage.Remove(1));
+  EXPECT_EQ(1u, storage.Size());
+  ASSERT_EQ(1u, storage.Entities().size());
+  ASSERT_EQ(1u, storage.Components().size());
+  EXPECT_EQ(30u, storage.Entities()[0]);
+  EXPECT_EQ(third, storage.Components()[0]);
+
+  storage.Clear();
+  EXPECT_EQ(0u, storage.Size());
+  EXPECT_TRUE(storage.Entities().empty());
+  EXPECT_TRUE(storage.Components().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ComponentTypeStorageTest, Ticks)
+{
+  ComponentTypeStorage storage;
+  EXPECT_EQ(0u, storage.Tick(0));
+
+  storage.Add(10, std::make_unique<IntComponent>(100), 3u);
+  storage.Add(20, std::make_unique<IntComponent>(200));
+  storage.Add(30, std::make_unique<IntComponent>(300), 5u);
+  EXPECT_EQ(3u, storage.Tick(0));
+  EXPECT_EQ(0u, storage.Tick(1));
+  EXPECT_EQ(5u, storage.Tick(2));
+
+  storage.SetTick(1, 7u);
+  EXPECT_EQ(7u, storage.Tick(1));
+
+  // Out of range is ignored
+  storage.SetTick(3, 9u);
+  EXPECT_EQ(0u, storage.Tick(3));
+
+  // Ticks follow their component when the storage is compacted
+  EXPECT_EQ(30u, storage.Remove(0));
+  ASSERT_EQ(2u, storage.Ticks().size());
+  EXPECT_EQ(5u, storage.Ticks()[0]);
+  EXPECT_EQ(7u, storage.Ticks()[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(ComponentTypeStorageTest, Pooled)
+{
+  components::ComponentDescriptor<IntComponent> descriptor;
+  const auto traits = components::ComponentPoolTraits::Make<IntComponent>();
+  ComponentTypeStorage storage;
+  EXPECT_EQ(0u, storage.AllocationCount());
+
+  IntComponent data(5);
+  EXPECT_EQ(0u, storage.Emplace(10, descriptor, &traits, &data, 2u));
+  EXPECT_EQ(1u, storage.Size());
+  EXPECT_EQ(2u, storage.Tick(0));
+  EXPECT_EQ(10u, storage.EntityAt(0));
+
+  auto first = storage.Component(0);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(5, static_cast<IntComponent *>(first)->Data());
+
+  EXPECT_GT(storage.AllocationCount(), 0u);
+  for (int i = 1; i < 8; ++i)
+  {
+    IntComponent other(i);
+    storage.Emplace(10 + i, descriptor, &traits, &other);
+  }
+  EXPECT_EQ(8u, storage.Size());
+  const auto allocations = storage.AllocationCount();
+
+  // Freed slots are reused
+  EXPECT_EQ(17u, storage.Remove(0));
+  IntComponent reused(9);
+  EXPECT_EQ(7u, storage.Emplace(30, descriptor, &traits, &reused));
+  EXPECT_EQ(first, storage.Component(7));
+  EXPECT_EQ(9, static_cast<IntComponent *>(storage.Component(7))->Data());
+  EXPECT_EQ(allocations, storage.AllocationCount());
+
+  // Clearing keeps the memory
+  storage.Clear();
+  EXPECT_EQ(0u, storage.Size());
+  for (int i = 0; i < 8; ++i)
+    storage.Emplace(50 + i, descriptor, &traits, &data);
+  EXPECT_EQ(allocations, storage.AllocationCount());
+
+  // Pooled and heap components can live in the same storage
+  storage.Add(60, std::make_unique<IntComponent>(6));
+  EXPECT_EQ(9u, storage.Size());
+  EXPECT_EQ(6, static_cast<IntComponent *>(storage.Component(8))->Data());
+
+  // Without traits, components are created by the descriptor
+  IntComponent unpooled(7);
+  EXPECT_EQ(9u, storage.Emplace(70, descriptor, nullptr, &unpooled));
+  EXPECT_EQ(7, static_cast<IntComponent *>(storage.Component(9))->Data());
+}
+
+/////////////////////////////////////////////////
+TEST(ComponentTypeStorageTest, Generation)
+{
+  ComponentTypeStorage storage;
+  const uint64_t *generation = storage.Generation();
+  ASSERT_NE(nullptr, generation);
+  uint64_t last = *generation;
+
+  // Adding and removing components changes the generation
+  storage.Add(10, std::make_unique<IntComponent>(1));
+  EXPECT_NE(last, *generation);
+  last = *generation;
+
+  storage.SetTick(0, 5u);
+  EXPECT_EQ(last, *generation);
+
+  storage.Remove(0);
+  EXPECT_NE(last, *generation);
+  last = *generation;
+
+  // Out of range removals don't
+  storage.Remove(0);
+  EXPECT_EQ(last, *generation);
+
+  storage.BumpGeneration();
+  EXPECT_NE(last, *generation);
+  last = *generation;
+
+  storage.Clear();
+  EXPECT_NE(last, *generation);
+
+  // The pointer stays the same
+  EXPECT_EQ(generation, storage.Generation());
+}
+
+/////////////////////////////////////////////////
+TEST(ComponentTypeStorageTest, Compact)
+{
+  components::ComponentDescriptor<IntComponent> descriptor;
+  const auto traits = components::ComponentPoolTraits::Make<IntComponent>();
+  ComponentTypeStorage storage;
+  for (int i = 0; i < 100; ++i)
+  {
+    IntComponent data(i);
+    storage.Emplace(10 + i, descriptor, &traits, &data);
+  }
+  auto first = storage.Component(0);
+  const auto peak = storage.MemoryUsage(sizeof(IntComponent));
+
+  // Nothing to release while the storage is full
+  storage.Compact();
+  EXPECT_EQ(peak, storage.MemoryUsage(sizeof(IntComponent)));
+
+  // Only the first chunk holds components after removing most of them
+  while (storage.Size() > 4u)
+    storage.Remove(storage.Size() - 1u);
+  storage.Compact();
+  EXPECT_LT(storage.MemoryUsage(sizeof(IntComponent)), peak / 2u);
+
+  // The remaining components are untouched
+  ASSERT_EQ(4u, storage.Size());
+  EXPECT_EQ(first, storage.Component(0));
+  for (std::size_t i = 0; i < 4u; ++i)
+  {
+    EXPECT_EQ(10u + i, storage.EntityAt(i));
+    EXPECT_EQ(static_cast<int>(i),
+        static_cast<IntComponent *>(storage.Component(i))->Data());
+  }
+
+  // And the storage can grow again
+  for (int i = 0; i < 100; ++i)
+  {
+    IntComponent data(i);
+    storage.Emplace(200 + i, descriptor, &traits, &data);
+  }
+  EXPECT_EQ(104u, storage.Size());
+  EXPECT_EQ(99, static_cast<IntComponent *>(storage.Component(103))->Data());
+}
@@ -19,13 +19,16 @@
 #include <ignition/msgs/int32.pb.h>
 #include <ignition/utilities/ExtraTestMacros.hh>
 
+#include <limits>
 #include <memory>
+#include <string>
 
 #include <sdf/Element.hh>
 #include <ignition/common/Console.hh>
 #include <ignition/math/Inertial.hh>
 
 #include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Serialization.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
@@ -594,3 +597,134 @@ TEST_F(ComponentTest, Clone)
     EXPECT_NE(&comp, derivedClone);
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(ComponentTest, BufferSerialization)
+{
+  // Writing to a buffer produces the same bytes as writing to a stream
+  auto expectSame = [](const auto &_comp)
+  {
+    std::ostringstream ostr;
+    _comp.Serialize(ostr);
+
+    std::string buffer;
+    _comp.SerializeTo(buffer);
+    EXPECT_EQ(ostr.str(), buffer);
+    return buffer;
+  };
+
+  // Plain numbers are formatted without a stream
+  {
+    using Custom = components::Component<double, class CustomTag>;
+    EXPECT_EQ("0.1", expectSame(Custom(0.1)));
+    EXPECT_EQ("-1.23457e+08", expectSame(Custom(-123456789.0)));
+    EXPECT_EQ("3", expectSame(Custom(3.0)));
+
+    Custom comp;
+    comp.DeserializeFrom("2.5");
+    EXPECT_DOUBLE_EQ(2.5, comp.Data());
+  }
+  {
+    using Custom = components::Component<int, class CustomTag>;
+    EXPECT_EQ("-42", expectSame(Custom(-42)));
+  }
+  {
+    using Custom = components::Component<uint64_t, class CustomTag>;
+    EXPECT_EQ("18446744073709551615",
+        expectSame(Custom(std::numeric_limits<uint64_t>::max())));
+  }
+  {
+    using Custom = components::Component<bool, class CustomTag>;
+    EXPECT_EQ("1", expectSame(Custom(true)));
+    EXPECT_EQ("0", expectSame(Custom(false)));
+  }
+
+  // Types without a buffer serializer go through a stream
+  {
+    using Custom = components::Component<math::Inertiald, class CustomTag>;
+    EXPECT_EQ("Mass: 0", expectSame(Custom(math::Inertiald())));
+  }
+  {
+    using Custom = components::Component<components::NoData, class CustomTag>;
+    EXPECT_EQ("-", expectSame(Custom()));
+  }
+
+  // Strings
+  {
+    using Custom = components::Component<std::string, class CustomTag,
+        serializers::StringSerializer>;
+    EXPECT_EQ("banana split", expectSame(Custom("banana split")));
+
+    Custom comp;
+    comp.DeserializeFrom("banana split");
+    EXPECT_EQ("banana split", comp.Data());
+  }
+
+  // Messages
+  {
+    using Custom = components::Component<msgs::Int32, class CustomTag,
+        serializers::MsgSerializer>;
+
+    msgs::Int32 data;
+    data.set_data(331);
+    auto buffer = expectSame(Custom(data));
+
+    Custom comp;
+    comp.DeserializeFrom(buffer);
+    EXPECT_EQ(331, comp.Data().data());
+  }
+
+  // Raw bytes
+  {
+    using Custom = components::Component<uint32_t, class CustomTag,
+        serializers::TriviallyCopyableSerializer<uint32_t>>;
+
+    auto buffer = expectSame(Custom(0xABCD1234u));
+    EXPECT_EQ(sizeof(uint32_t), buffer.size());
+
+    Custom comp;
+    comp.DeserializeFrom(buffer);
+    EXPECT_EQ(0xABCD1234u, comp.Data());
+
+    std::istringstream istr(buffer);
+    Custom streamed;
+    streamed.Deserialize(istr);
+    EXPECT_EQ(0xABCD1234u, streamed.Data());
+
+    // Truncated data is ignored
+    comp.DeserializeFrom("ab");
+    EXPECT_EQ(0xABCD1234u, comp.Data());
+  }
+
+  // Registered types use the serializer stored by the factory
+  {
+    EXPECT_NE(nullptr,
+        components::ComponentBufferSerializer::Find(components::Name::typeId));
+
+    components::Name comp("banana split");
+    const components::BaseComponent &base = comp;
+    std::string buffer;
+    components::ComponentBufferSerializer::Serialize(base, buffer);
+    EXPECT_EQ("banana split", buffer);
+
+    components::Name other;
+    components::ComponentBufferSerializer::Deserialize(other, buffer);
+    EXPECT_EQ("banana split", other.Data());
+  }
+
+  // Unregistered types fall back to the stream functions
+  {
+    using Custom = components::Component<double, class CustomTag>;
+    EXPECT_EQ(nullptr,
+        components::ComponentBufferSerializer::Find(Custom::typeId));
+
+    Custom comp(0.5);
+    std::string buffer;
+    components::ComponentBufferSerializer::Serialize(comp, buffer);
+    EXPECT_EQ("0.5", buffer);
+
+    Custom other;
+    components::ComponentBufferSerializer::Deserialize(other, "1.5");
+    EXPECT_DOUBLE_EQ(1.5, other.Data());
+  }
+}
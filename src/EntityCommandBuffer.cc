@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/EntityCommandBuffer.hh"
+
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+/// \brief Private data for EntityCommandBuffer
+class ignition::gazebo::EntityCommandBufferPrivate
+{
+  /// \brief Constructor
+  /// \param[in] _ecm Manager the commands will be applied to.
+  public: explicit EntityCommandBufferPrivate(EntityComponentManager &_ecm)
+      : ecm(_ecm)
+  {
+  }
+
+  /// \brief Manager the commands will be applied to.
+  public: EntityComponentManager &ecm;
+
+  /// \brief Recorded commands, in order.
+  public: std::vector<std::function<void(EntityComponentManager &)>>
+          commands;
+};
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+EntityCommandBuffer::EntityCommandBuffer(EntityComponentManager &_ecm)
+  : dataPtr(std::make_unique<EntityCommandBufferPrivate>(_ecm))
+{
+}
+
+//////////////////////////////////////////////////
+EntityCommandBuffer::~EntityCommandBuffer() = default;
+
+//////////////////////////////////////////////////
+Entity EntityCommandBuffer::CreateEntity()
+{
+  const Entity entity = this->dataPtr->ecm.ReserveEntity();
+  this->Record([entity](EntityComponentManager &_ecm)
+  {
+    _ecm.CreateReservedEntity(entity);
+  });
+  return entity;
+}
+
+//////////////////////////////////////////////////
+void EntityCommandBuffer::RemoveComponent(const Entity _entity,
+    const ComponentTypeId &_typeId)
+{
+  this->Record([_entity, _typeId](EntityComponentManager &_ecm)
+  {
+    _ecm.RemoveComponent(_entity, _typeId);
+  });
+}
+
+//////////////////////////////////////////////////
+void EntityCommandBuffer::RequestRemoveEntity(const Entity _entity,
+    bool _recursive)
+{
+  this->Record([_entity, _recursive](EntityComponentManager &_ecm)
+  {
+    _ecm.RequestRemoveEntity(_entity, _recursive);
+  });
+}
+
+//////////////////////////////////////////////////
+bool EntityCommandBuffer::Empty() const
+{
+  return this->dataPtr->commands.empty();
+}
+
+//////////////////////////////////////////////////
+void EntityCommandBuffer::Record(
+    std::function<void(EntityComponentManager &)> _command)
+{
+  this->dataPtr->commands.push_back(std::move(_command));
+}
+
+//////////////////////////////////////////////////
+void EntityCommandBuffer::Apply()
+{
+  if (this->dataPtr->commands.empty())
+    return;
+
+  IGN_PROFILE("EntityCommandBuffer::Apply");
+  for (auto &command : this->dataPtr->commands)
+    command(this->dataPtr->ecm);
+  this->dataPtr->commands.clear();
+}
@@ -17,41 +17,96 @@
 
 #include "ignition/gazebo/EntityComponentManager.hh"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
-#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <ignition/common/Profiler.hh>
-#include <ignition/math/graph/GraphAlgorithms.hh>
 
+#include "ignition/gazebo/components/AxisAlignedBox.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/ChildLinkName.hh"
 #include "ignition/gazebo/components/Component.hh"
 #include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Joint.hh"
 #include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/ParentLinkName.hh"
+#include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/Recreate.hh"
 #include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/EntityComponentSnapshot.hh"
+#include "ignition/gazebo/SpatialIndex.hh"
+#include "ignition/gazebo/Util.hh"
+
+#include "ComponentStorage.hh"
+#include "EntityComponentSnapshotPrivate.hh"
+#include "EntityHierarchy.hh"
+#include "MemoryEstimate.hh"
+#include "ThreadPool.hh"
 
 using namespace ignition;
 using namespace gazebo;
 
+/// \brief Number of query view slots which can be cached. Queries whose slot
+/// is beyond this are looked up by key.
+static constexpr std::size_t kViewSlotCount{1024u};
+
+/// \brief Number of change ticks for which entity removals are remembered,
+/// so that ChangedState can report them to consumers which lag behind.
+static constexpr uint64_t kRemovedEntityHistoryTicks{1000u};
+
+/// \brief Entity count below which removals don't trigger compaction.
+static constexpr std::size_t kCompactMinEntities{1024u};
+
+/// \brief Number of existing components updated by a state message above
+/// which they are deserialized in parallel.
+static constexpr std::size_t kParallelStateUpdateThreshold{512u};
+
+/// \brief Source of the ids which tell managers apart in thread local
+/// caches.
+static std::atomic<uint64_t> gNextManagerId{1u};
+
+/// \brief Update of an existing component by a state message.
+struct ComponentStateUpdate
+{
+  /// \brief Entity which owns the component.
+  Entity entity;
+
+  /// \brief Component type.
+  ComponentTypeId type;
+
+  /// \brief Component to update.
+  components::BaseComponent *component;
+
+  /// \brief Serialized data, owned by the state message.
+  const std::string *data;
+};
+
 class ignition::gazebo::EntityComponentManagerPrivate
 {
   /// \brief Implementation of the CreateEntity function, which takes a specific
   /// entity as input.
   /// \param[in] _entity Entity to be created.
+  /// \param[in] _trackNew True to add the entity to newlyCreatedEntities.
+  /// Callers creating many entities at once pass false and add them
+  /// themselves, to lock entityCreatedMutex only once.
   /// \return Created entity, which should match the input.
-  public: Entity CreateEntityImplementation(Entity _entity);
+  public: Entity CreateEntityImplementation(Entity _entity,
+      bool _trackNew = true);
 
   /// \brief Recursively insert an entity and all its descendants into a given
   /// set.
@@ -71,6 +126,16 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// `AddEntityToMessage`.
   public: void CalculateStateThreadLoad();
 
+  /// \brief Deserialize pending updates of existing components in place,
+  /// in parallel if there are many of them, then mark each component as
+  /// changed. Each update must target a different component.
+  /// \param[in, out] _updates Pending updates. Cleared when done.
+  /// \param[in] _markChanged Called serially for each update, after all
+  /// components have been deserialized.
+  public: void ApplyComponentUpdates(
+      std::vector<ComponentStateUpdate> &_updates,
+      const std::function<void(const ComponentStateUpdate &)> &_markChanged);
+
   /// \brief Create a message for the removed components
   /// \param[in] _entity Entity with the removed components
   /// \param[in, out] _msg Entity message
@@ -93,8 +158,22 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// modifiedComponents list. The entity is added to the list when it is not
   /// a newly created entity or is not an entity to be removed
   /// \param[in] _entity Entity that has component newly modified
+  /// This may be called concurrently from multiple threads, as long as
+  /// entities aren't created or removed at the same time. The entity is
+  /// only recorded in the calling thread's list, and it's added to
+  /// modifiedComponents by SyncModifiedComponents.
   public: void AddModifiedComponent(const Entity &_entity);
 
+  /// \brief Get the list of entities with modified components recorded by
+  /// the calling thread, creating it if needed.
+  /// \return The list.
+  public: std::vector<Entity> &ModifiedList();
+
+  /// \brief Merge the entities recorded by all threads into
+  /// modifiedComponents, skipping the ones that are newly created or being
+  /// removed. This must not be called while components are being modified.
+  public: void SyncModifiedComponents();
+
   /// \brief Check whether a component is marked as a component that is
   /// currently removed or not.
   /// \param[in] _entity The entity
@@ -104,6 +183,55 @@ class ignition::gazebo::EntityComponentManagerPrivate
   public: bool ComponentMarkedAsRemoved(const Entity _entity,
               const ComponentTypeId _typeId) const;
 
+  /// \brief Get all entities which may have something to serialize in a
+  /// state message that only contains changes: entities to be removed,
+  /// entities with removed components and entities with changed components of
+  /// the given types. This only visits the per-type change lists, so its cost
+  /// is proportional to the number of changes, not to the number of entities.
+  /// \param[in] _types Component types to consider. Leave empty for all
+  /// types.
+  /// \return Entities with changes.
+  public: std::unordered_set<Entity> ChangedEntities(
+      const std::unordered_set<ComponentTypeId> &_types) const;
+
+  /// \brief Destroy all the component instances of an entity, keeping the
+  /// per-type storages packed and their indices in `componentTypeIndex` up to
+  /// date. This doesn't erase the entity from `componentTypeIndex`.
+  /// \param[in] _entity The entity whose components will be destroyed.
+  public: void DestroyEntityComponents(const Entity _entity);
+
+  /// \brief Stamp a component with the current change tick.
+  /// \param[in] _entity Entity that contains the component.
+  /// \param[in] _typeId Type of the component.
+  public: void StampChange(const Entity _entity,
+      const ComponentTypeId _typeId);
+
+  /// \brief Invalidate the hierarchy caches, after entities were added,
+  /// removed or reparented.
+  public: void InvalidateHierarchy();
+
+  /// \brief Invalidate the caches which depend on a component, after it
+  /// was created, removed, changed, or handed out through a mutable
+  /// accessor. This may be called concurrently.
+  /// \param[in] _entity Entity which owns the component.
+  /// \param[in] _typeId Type of the component.
+  public: void InvalidateCachesFor(const Entity _entity,
+              const ComponentTypeId _typeId);
+
+  /// \brief Invalidate the caches which depend on any component of a type,
+  /// after a query handed out mutable pointers to them.
+  /// \param[in] _typeId Type of the components.
+  public: void InvalidateCachesForType(const ComponentTypeId _typeId);
+
+  /// \brief Remove an entity from the name index. The caller must hold
+  /// nameIndexMutex, or have exclusive access to the ECM.
+  /// \param[in] _entity Entity to remove.
+  public: void UnindexName(const Entity _entity) const;
+
+  /// \brief Rebuild the descendant spans if the hierarchy changed since
+  /// they were last built. The caller must hold hierarchyMutex.
+  public: void UpdateDescendantSpans() const;
+
   /// \brief Set a cloned joint's parent or child link name.
   /// \param[in] _joint The cloned joint.
   /// \param[in] _originalLink The original joint's parent or child link.
@@ -123,9 +251,18 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// \brief All component types that have ever been created.
   public: std::unordered_set<ComponentTypeId> createdCompTypes;
 
-  /// \brief A graph holding all entities, arranged according to their
-  /// parenting.
-  public: EntityGraph entities;
+  /// \brief All entities, arranged according to their parenting.
+  public: EntityHierarchy hierarchy;
+
+  /// \brief Graph returned by Entities(), built on demand from the
+  /// hierarchy.
+  public: mutable EntityGraph graph;
+
+  /// \brief Hierarchy version at which the graph was built.
+  public: mutable uint64_t graphVersion{0u};
+
+  /// \brief Protects the graph.
+  public: mutable std::mutex graphMutex;
 
   /// \brief Components that have been changed through a periodic change.
   /// The key is the type of component which has changed, and the value is the
@@ -148,9 +285,39 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// \brief Entities that have components newly modified
   /// (created/modified/removed) but are not entities that have been
   /// newly created or removed (ie. newlyCreatedEntities or toRemoveEntities).
-  /// This is used for the ChangedState functions
+  /// This is used for the ChangedState functions, after calling
+  /// SyncModifiedComponents.
   public: std::unordered_set<Entity> modifiedComponents;
 
+  /// \brief Whether each entity has been recorded as having modified
+  /// components since the last SetAllComponentsUnchanged, so that it's
+  /// only recorded once no matter how many of its components change.
+  /// Indexed by the entities' compact indices. Flags are only added when
+  /// entities are created, so they can be set concurrently.
+  public: std::deque<std::atomic<bool>> modifiedFlags;
+
+  /// \brief Get the modified flag of an entity.
+  /// \param[in] _entity Entity.
+  /// \return The flag, or nullptr if the entity doesn't exist.
+  public: std::atomic<bool> *ModifiedFlag(const Entity _entity);
+
+  /// \brief Entities with modified components recorded by each thread
+  /// which haven't been merged into modifiedComponents yet. Lists are kept
+  /// once merged, so their storage is reused.
+  public: std::vector<std::unique_ptr<std::vector<Entity>>> modifiedLists;
+
+  /// \brief List of each thread which recorded modifications.
+  public: std::unordered_map<std::thread::id, std::vector<Entity> *>
+          modifiedListsByThread;
+
+  /// \brief Protects modifiedLists and modifiedListsByThread, and
+  /// serializes SyncModifiedComponents.
+  public: std::mutex modifiedListsMutex;
+
+  /// \brief Id of this manager, used by threads to find their modified
+  /// list without locking.
+  public: const uint64_t managerId{gNextManagerId++};
+
   /// \brief Flag that indicates if all entities should be removed.
   public: bool removeAllEntities{false};
 
@@ -166,6 +333,10 @@ class ignition::gazebo::EntityComponentManagerPrivate
   /// \brief A mutex to protect removed components
   public: mutable std::mutex removedComponentsMutex;
 
+  /// \brief A mutex to protect the changed component sets and change ticks
+  /// from systems that mark different components as changed concurrently.
+  public: std::mutex changedComponentsMutex;
+
   /// \brief The set of all views.
   /// The value is a pair of the view itself and a mutex that can be used for
   /// locking the view to ensure thread safety when adding entities to the view.
@@ -173,18 +344,83 @@ class ignition::gazebo::EntityComponentManagerPrivate
           std::pair<std::unique_ptr<detail::BaseView>,
             std::unique_ptr<std::mutex>>, detail::ComponentTypeHasher> views;
 
+  /// \brief Entries of `views`, indexed by the slot of the query they were
+  /// found for. This lets queries find their view without building a key or
+  /// locking viewsMutex. Entries are stable until views are cleared.
+  public: mutable std::array<std::atomic<const std::pair<
+          std::unique_ptr<detail::BaseView>, std::unique_ptr<std::mutex>> *>,
+          kViewSlotCount> viewSlots{};
+
   /// \brief A flag that indicates whether views should be locked while adding
   /// new entities to them or not.
   public: bool lockAddEntitiesToViews{false};
 
-  /// \brief Cache of previously queried descendants. The key is the parent
-  /// entity for which descendants were queried, and the value are all its
-  /// descendants.
-  public: mutable std::unordered_map<Entity, std::unordered_set<Entity>>
-          descendantCache;
+  /// \brief Incremented whenever entities are added, removed or
+  /// reparented. Hierarchy caches built at an older version are stale.
+  /// Atomic because mutable component accessors may be called concurrently.
+  public: std::atomic<uint64_t> hierarchyVersion{1u};
+
+  /// \brief Incremented whenever a world pose may have changed: when the
+  /// hierarchy changes, when a Pose component is created, removed, marked
+  /// as changed or accessed mutably, and once per iteration.
+  public: std::atomic<uint64_t> poseVersion{1u};
+
+  /// \brief All entities in depth first order, so that the descendants of
+  /// each entity are contiguous.
+  public: mutable std::vector<Entity> descendantOrder;
+
+  /// \brief Span of each entity and its descendants in descendantOrder,
+  /// as [begin, end) indices.
+  public: mutable std::unordered_map<Entity,
+          std::pair<std::size_t, std::size_t>> descendantSpans;
+
+  /// \brief Hierarchy version at which the descendant spans were built.
+  public: mutable uint64_t descendantSpansVersion{
+          std::numeric_limits<uint64_t>::max()};
+
+  /// \brief Cached chain of ancestors of each entity, with the hierarchy
+  /// version it was built at.
+  public: mutable std::unordered_map<Entity,
+          std::pair<uint64_t, std::vector<Entity>>> ancestorCache;
+
+  /// \brief Cached world pose of each entity, with the pose version it was
+  /// computed at.
+  public: mutable std::unordered_map<Entity,
+          std::pair<uint64_t, math::Pose3d>> worldPoseCache;
+
+  /// \brief Protects the hierarchy caches, which are filled by const
+  /// queries that may run concurrently.
+  public: mutable std::mutex hierarchyMutex;
+
+  /// \brief Entities which have each name, sorted by id.
+  public: mutable std::unordered_map<std::string, std::vector<Entity>>
+          nameIndex;
+
+  /// \brief Name under which each entity is in nameIndex.
+  public: mutable std::unordered_map<Entity, std::string> indexedNames;
+
+  /// \brief Entities whose components::Name was created, removed, marked
+  /// as changed or accessed mutably since nameIndex was last refreshed.
+  public: mutable std::unordered_set<Entity> nameIndexDirty;
+
+  /// \brief Whether a query handed out mutable pointers to all
+  /// components::Name since nameIndex was last refreshed, in which case all
+  /// entities with a name are reindexed.
+  public: mutable bool nameIndexStale{false};
+
+  /// \brief Protects the name index, which is refreshed by const queries.
+  public: mutable std::mutex nameIndexMutex;
 
   /// \brief Keep track of entities already used to ensure uniqueness.
-  public: uint64_t entityCount{0};
+  /// Atomic so that command buffers can reserve ids from any thread.
+  public: std::atomic<uint64_t> entityCount{0};
+
+  /// \brief Largest number of entities seen before removals since the last
+  /// compaction.
+  public: std::size_t peakEntityCount{0u};
+
+  /// \brief Bytes reclaimed by all compactions.
+  public: uint64_t reclaimedBytes{0u};
 
   /// \brief Unordered map of removed components. The key is the entity to
   /// which belongs the component, and the value is a set of the component types
@@ -200,22 +436,19 @@ class ignition::gazebo::EntityComponentManagerPrivate
   public: std::unordered_map<Entity, std::unordered_set<ComponentTypeId>>
     componentsMarkedAsRemoved;
 
-  /// \brief A map of an entity to its components
-  public: std::unordered_map<Entity,
-           std::vector<std::unique_ptr<components::BaseComponent>>>
+  /// \brief A map of a component type to the dense storage holding all the
+  /// instances of that type, for all entities.
+  public: std::unordered_map<ComponentTypeId, ComponentTypeStorage>
              componentStorage;
 
-  /// \brief A map that keeps track of where each type of component is
-  /// located in the componentStorage vector. Since the componentStorage vector
-  /// is of type BaseComponent, we need to keep track of which component type
-  /// corresponds to a given index in the vector so that we can cast the
-  /// BaseComponent to this type if needed.
+  /// \brief A map that keeps track of where each component of an entity is
+  /// located in the componentStorage of its type.
   ///
   /// The key of this map is the Entity, and the value is a map of the
   /// component type to the corresponding index in the
-  /// componentStorage vector (a component of a particular type is
+  /// componentStorage of that type (a component of a particular type is
   /// only a key for the value map if a component of this type exists in
-  /// the componentStorage vector)
+  /// the componentStorage for that type)
   ///
   /// NOTE: Any modification of this data structure must be followed
   /// by setting `componentTypeIndexDirty` to true.
@@ -276,6 +509,72 @@ class ignition::gazebo::EntityComponentManagerPrivate
 
   /// \brief Set of entities that are prevented from removal.
   public: std::unordered_set<Entity> pinnedEntities;
+
+  /// \brief Tick stamped on components as they change. It starts at one so
+  /// that changes made while loading are newer than tick zero.
+  public: uint64_t changeTick{1u};
+
+  /// \brief Entities that have been removed, by the change tick at which
+  /// they were removed. Only the last kRemovedEntityHistoryTicks ticks are
+  /// kept.
+  public: std::map<uint64_t, std::vector<Entity>> removedEntityHistory;
+
+  /// \brief Get the worker pool, creating it on first use.
+  /// \return The worker pool.
+  public: ThreadPool &Pool();
+
+  /// \brief Worker pool used for parallel iteration. Created on
+  /// first use, so that managers which never iterate in parallel, such as
+  /// the ones in GUI plugins, don't spawn threads. May be shared with other
+  /// managers, see SetThreadPool.
+  public: std::shared_ptr<ThreadPool> pool;
+
+  /// \brief Protects the creation of the worker pool.
+  public: std::mutex poolMutex;
+
+  /// \brief Latest snapshot, which the next one shares unchanged
+  /// components with.
+  public: mutable std::shared_ptr<const EntityComponentSnapshot>
+          lastSnapshot;
+
+  /// \brief Hierarchy version at which the latest snapshot was taken.
+  public: mutable uint64_t lastSnapshotHierarchyVersion{0u};
+
+  /// \brief Protects the latest snapshot.
+  public: mutable std::mutex snapshotMutex;
+
+  /// \brief Number of nested BeginBatchCreation calls which haven't been
+  /// ended yet. Views are not updated for new components while this is
+  /// positive.
+  public: unsigned int batchCreationDepth{0u};
+
+  /// \brief Entities which got new components while views weren't being
+  /// updated, in the order they got their first one.
+  public: std::vector<Entity> batchedEntities;
+
+  /// \brief Same as batchedEntities, for fast lookup.
+  public: std::unordered_set<Entity> batchedEntitySet;
+
+  /// \brief Command buffers, in the order they were first requested.
+  /// Buffers are kept after being applied, so their storage is reused.
+  public: std::vector<std::unique_ptr<EntityCommandBuffer>> deferredBuffers;
+
+  /// \brief Command buffer of each thread which requested one.
+  public: std::unordered_map<std::thread::id, EntityCommandBuffer *>
+          deferredByThread;
+
+  /// \brief Protects deferredBuffers and deferredByThread.
+  public: std::mutex deferredMutex;
+
+  /// \brief Index of models by their bounding box. Null until requested.
+  public: mutable std::unique_ptr<SpatialIndex> spatialIndex;
+
+  /// \brief Changes after this tick haven't been added to the spatial index
+  /// yet.
+  public: uint64_t spatialIndexSince{0u};
+
+  /// \brief Protects the creation and update of the spatial index.
+  public: std::mutex spatialIndexMutex;
 };
 
 //////////////////////////////////////////////////
@@ -290,7 +589,7 @@ EntityComponentManager::~EntityComponentManager() = default;
 //////////////////////////////////////////////////
 size_t EntityComponentManager::EntityCount() const
 {
-  return this->dataPtr->entities.Vertices().size();
+  return this->dataPtr->hierarchy.Size();
 }
 
 /////////////////////////////////////////////////
@@ -309,191 +608,1006 @@ Entity EntityComponentManager::CreateEntity()
 }
 
 /////////////////////////////////////////////////
-Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity)
+std::vector<Entity> EntityComponentManager::CreateEntities(
+    const std::size_t _count)
 {
-  IGN_PROFILE("EntityComponentManager::CreateEntityImplementation");
-  this->entities.AddVertex(std::to_string(_entity), _entity, _entity);
+  IGN_PROFILE("EntityComponentManager::CreateEntities");
+  std::vector<Entity> created;
+  created.reserve(_count);
+  this->dataPtr->componentTypeIndex.reserve(
+      this->dataPtr->componentTypeIndex.size() + _count);
 
-  // Add entity to the list of newly created entities
+  for (std::size_t i = 0; i < _count; ++i)
   {
-    std::lock_guard<std::mutex> lock(this->entityCreatedMutex);
-    this->newlyCreatedEntities.insert(_entity);
+    if (this->dataPtr->entityCount == std::numeric_limits<uint64_t>::max())
+    {
+      ignwarn << "Reached maximum number of entities ["
+              << this->dataPtr->entityCount << "]" << std::endl;
+      break;
+    }
+
+    Entity entity = ++this->dataPtr->entityCount;
+    created.push_back(
+        this->dataPtr->CreateEntityImplementation(entity, false));
   }
 
-  // Reset descendants cache
-  this->descendantCache.clear();
+  // Add entities to the list of newly created entities
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
+  this->dataPtr->newlyCreatedEntities.reserve(
+      this->dataPtr->newlyCreatedEntities.size() + created.size());
+  this->dataPtr->newlyCreatedEntities.insert(created.begin(), created.end());
 
-  const auto result = this->componentStorage.insert({_entity,
-      std::vector<std::unique_ptr<components::BaseComponent>>()});
-  if (!result.second)
+  return created;
+}
+
+/////////////////////////////////////////////////
+Entity EntityComponentManager::ReserveEntity() const
+{
+  Entity entity = ++this->dataPtr->entityCount;
+
+  if (entity == std::numeric_limits<uint64_t>::max())
   {
-    ignwarn << "Attempted to add entity [" << _entity
-      << "] to component storage, but this entity is already in component "
-      << "storage.\n";
+    ignwarn << "Reached maximum number of entities [" << entity << "]"
+            << std::endl;
   }
 
-  const auto result2 = this->componentTypeIndex.insert({_entity,
-      std::unordered_map<ComponentTypeId, std::size_t>()});
-  if (!result2.second)
+  return entity;
+}
+
+/////////////////////////////////////////////////
+Entity EntityComponentManager::CreateReservedEntity(const Entity _entity)
+{
+  return this->dataPtr->CreateEntityImplementation(_entity);
+}
+
+/////////////////////////////////////////////////
+EntityCommandBuffer &EntityComponentManager::Deferred() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->deferredMutex);
+  auto &buffer =
+      this->dataPtr->deferredByThread[std::this_thread::get_id()];
+  if (nullptr == buffer)
   {
-    ignwarn << "Attempted to add entity [" << _entity
-      << "] to component type index, but this entity is already in component "
-      << "type index.\n";
+    // The buffer only ever applies commands through a non-const manager,
+    // when ApplyDeferredCommands is called
+    this->dataPtr->deferredBuffers.push_back(
+        std::unique_ptr<EntityCommandBuffer>(new EntityCommandBuffer(
+        const_cast<EntityComponentManager &>(*this))));
+    buffer = this->dataPtr->deferredBuffers.back().get();
   }
+  return *buffer;
+}
 
-  return _entity;
+/////////////////////////////////////////////////
+void EntityComponentManager::ApplyDeferredCommands()
+{
+  IGN_PROFILE("EntityComponentManager::ApplyDeferredCommands");
+  std::lock_guard<std::mutex> lock(this->dataPtr->deferredMutex);
+  for (auto &buffer : this->dataPtr->deferredBuffers)
+    buffer->Apply();
 }
 
 /////////////////////////////////////////////////
-Entity EntityComponentManager::Clone(Entity _entity, Entity _parent,
-    const std::string &_name, bool _allowRename)
+const SpatialIndex &EntityComponentManager::ModelSpatialIndex() const
 {
-  // Clear maps so they're populated for the entity being cloned
-  this->dataPtr->oldToClonedCanonicalLink.clear();
-  this->dataPtr->oldModelCanonicalLink.clear();
-  this->dataPtr->originalToClonedLink.clear();
-  this->dataPtr->clonedToOriginalJointLinks.clear();
+  std::lock_guard<std::mutex> lock(this->dataPtr->spatialIndexMutex);
+  if (nullptr == this->dataPtr->spatialIndex)
+  {
+    this->dataPtr->spatialIndex = std::make_unique<SpatialIndex>();
+    this->RefreshSpatialIndex(0u);
+  }
+  return *this->dataPtr->spatialIndex;
+}
 
-  auto clonedEntity = this->CloneImpl(_entity, _parent, _name, _allowRename);
+/////////////////////////////////////////////////
+std::shared_ptr<const EntityComponentSnapshot>
+    EntityComponentManager::Snapshot() const
+{
+  IGN_PROFILE("EntityComponentManager::Snapshot");
+  std::lock_guard<std::mutex> lock(this->dataPtr->snapshotMutex);
 
-  if (kNullEntity != clonedEntity)
+  auto snapshot = std::make_shared<EntityComponentSnapshot>();
+  auto &data = *snapshot->dataPtr;
+  data.changeTick = this->dataPtr->changeTick;
+
+  const EntityComponentSnapshotPrivate *base{nullptr};
+  if (nullptr != this->dataPtr->lastSnapshot)
+    base = this->dataPtr->lastSnapshot->dataPtr.get();
+
+  // Components stamped at the base tick may have changed after the base
+  // was taken, so only older ones are known to be unchanged
+  const uint64_t baseTick = nullptr == base ? 0u : base->changeTick;
+
+  if (nullptr != base && this->dataPtr->lastSnapshotHierarchyVersion ==
+      this->dataPtr->hierarchyVersion)
   {
-    // make sure that cloned models have their canonical link updated to the
-    // cloned canonical link
-    for (const auto &[clonedModel, oldCanonicalLink] :
-         this->dataPtr->oldModelCanonicalLink)
+    data.entities = base->entities;
+  }
+  else
+  {
+    data.entities = std::make_shared<std::vector<Entity>>(
+        this->dataPtr->hierarchy.Entities());
+  }
+
+  auto factory = components::Factory::Instance();
+  for (const auto &[typeId, storage] : this->dataPtr->componentStorage)
+  {
+    std::shared_ptr<const SnapshotComponentTable> baseTable;
+    if (nullptr != base)
     {
-      auto iter = this->dataPtr->oldToClonedCanonicalLink.find(
-          oldCanonicalLink);
-      if (iter == this->dataPtr->oldToClonedCanonicalLink.end())
-      {
-        ignerr << "Error: attempted to clone model(s) with canonical link(s), "
-          << "but entity [" << oldCanonicalLink << "] was not cloned as a "
-          << "canonical link." << std::endl;
-        continue;
-      }
-      const auto clonedCanonicalLink = iter->second;
-      this->SetComponentData<components::ModelCanonicalLink>(clonedModel,
-          clonedCanonicalLink);
+      auto baseIt = base->tables.find(typeId);
+      if (baseIt != base->tables.end())
+        baseTable = baseIt->second;
     }
 
-    // make sure that cloned joints have their parent/child links
-    // updated to the cloned parent/child links
-    for (const auto &[clonedJoint, originalJointLinks] :
-        this->dataPtr->clonedToOriginalJointLinks)
+    // Share the whole table if no component of this type was created,
+    // removed or changed
+    const auto &ticks = storage.Ticks();
+    if (nullptr != baseTable && baseTable->entities.size() == storage.Size()
+        && std::all_of(ticks.begin(), ticks.end(),
+        [&](const uint64_t _tick)
+        {
+          return _tick < baseTick;
+        }))
     {
-      auto originalParentLink = originalJointLinks.first;
-      if (!this->dataPtr->ClonedJointLinkName<components::ParentLinkName>(
-            clonedJoint, originalParentLink, this))
+      data.tables[typeId] = baseTable;
+      data.componentCount += baseTable->entities.size();
+      continue;
+    }
+
+    auto descriptor = factory->Descriptor(typeId);
+    if (nullptr == descriptor)
+      continue;
+
+    std::vector<std::size_t> order;
+    order.reserve(storage.Size());
+    for (std::size_t i = 0; i < storage.Size(); ++i)
+    {
+      if (!this->dataPtr->ComponentMarkedAsRemoved(storage.EntityAt(i),
+          typeId))
       {
-        ignerr << "Error updating the cloned parent link name for cloned "
-               << "joint [" << clonedJoint << "]\n";
-        continue;
+        order.push_back(i);
       }
+    }
+    if (order.empty())
+      continue;
 
-      auto originalChildLink = originalJointLinks.second;
-      if (!this->dataPtr->ClonedJointLinkName<components::ChildLinkName>(
-            clonedJoint, originalChildLink, this))
+    const auto &entities = storage.Entities();
+    std::sort(order.begin(), order.end(),
+        [&](const std::size_t _a, const std::size_t _b)
+        {
+          return entities[_a] < entities[_b];
+        });
+
+    auto table = std::make_shared<SnapshotComponentTable>();
+    table->entities.reserve(order.size());
+    table->components.reserve(order.size());
+    for (const std::size_t i : order)
+    {
+      const Entity entity = entities[i];
+      table->entities.push_back(entity);
+
+      if (nullptr != baseTable && ticks[i] < baseTick)
       {
-        ignerr << "Error updating the cloned child link name for cloned "
-               << "joint [" << clonedJoint << "]\n";
-        continue;
+        const std::size_t baseIndex = baseTable->IndexOf(entity);
+        if (baseIndex < baseTable->entities.size())
+        {
+          table->components.push_back(baseTable->components[baseIndex]);
+          continue;
+        }
       }
+      table->components.push_back(descriptor->Create(storage.Component(i)));
+      ++data.copiedCount;
     }
+    data.componentCount += table->entities.size();
+    data.tables[typeId] = std::move(table);
   }
 
-  return clonedEntity;
+  this->dataPtr->lastSnapshot = snapshot;
+  this->dataPtr->lastSnapshotHierarchyVersion =
+      this->dataPtr->hierarchyVersion;
+  return snapshot;
 }
 
 /////////////////////////////////////////////////
-Entity EntityComponentManager::CloneImpl(Entity _entity, Entity _parent,
-    const std::string &_name, bool _allowRename)
+void EntityComponentManager::RestoreSnapshot(
+    const EntityComponentSnapshot &_snapshot)
 {
-  auto uniqueNameGenerated = false;
+  IGN_PROFILE("EntityComponentManager::RestoreSnapshot");
+  const auto &data = *_snapshot.dataPtr;
+  auto factory = components::Factory::Instance();
+
+  // Both lists are sorted by id
+  static const std::vector<Entity> kNoEntities;
+  const auto &entities = nullptr == data.entities ? kNoEntities :
+      *data.entities;
+  auto inSnapshot = [&](const Entity _entity)
+  {
+    return std::binary_search(entities.begin(), entities.end(), _entity);
+  };
 
-  // Before cloning, we should make sure that:
-  //  1. The entity to be cloned exists
-  //  2. We can generate a unique name for the cloned entity
-  if (!this->HasEntity(_entity))
+  // Entities created since the snapshot go away, descendants included,
+  // since none of them can be in the snapshot
+  std::vector<Entity> toRemove;
+  for (const Entity entity : this->dataPtr->hierarchy.Entities())
   {
-    ignerr << "Requested to clone entity [" << _entity
-      << "], but this entity does not exist." << std::endl;
-    return kNullEntity;
+    if (!inSnapshot(entity))
+      toRemove.push_back(entity);
   }
-  else if (!_name.empty() && !_allowRename)
+  for (const Entity entity : toRemove)
+    this->RequestRemoveEntity(entity, false);
+
+  this->BeginBatchCreation();
+
+  for (const Entity entity : entities)
   {
-    // Get the entity's original parent. This is used to make sure we get
-    // the correct entity. For example, two different models may have a
-    // child with the name "link".
-    auto origParentComp =
-        this->Component<components::ParentEntity>(_entity);
+    if (!this->HasEntity(entity))
+      this->dataPtr->CreateEntityImplementation(entity);
+  }
 
-    // If there is an entity with the same name and user indicated renaming is
-    // not allowed then return null entity.
-    // If the entity or one of its ancestor has a Recreate component then carry
-    // on since the ECM is supposed to create a new entity with the same name.
-    Entity ent = this->EntityByComponents(components::Name(_name),
-        components::ParentEntity(origParentComp->Data()));
+  // Components added since the snapshot go away
+  std::vector<std::pair<Entity, ComponentTypeId>> toRemoveComps;
+  for (const Entity entity : entities)
+  {
+    auto typeMapIter = this->dataPtr->componentTypeIndex.find(entity);
+    if (typeMapIter == this->dataPtr->componentTypeIndex.end())
+      continue;
 
-    bool hasRecreateComp = false;
-    Entity recreateEnt = ent;
-    while (recreateEnt != kNullEntity && !hasRecreateComp)
+    for (const auto &typeIdx : typeMapIter->second)
     {
-      hasRecreateComp = this->Component<components::Recreate>(recreateEnt) !=
-        nullptr;
-      auto parentComp = this->Component<components::ParentEntity>(recreateEnt);
-      recreateEnt = parentComp ? parentComp->Data() : kNullEntity;
-    }
+      const ComponentTypeId typeId = typeIdx.first;
+      if (this->dataPtr->ComponentMarkedAsRemoved(entity, typeId) ||
+          nullptr == factory->Descriptor(typeId))
+      {
+        continue;
+      }
 
-    if (kNullEntity != ent && !hasRecreateComp)
-    {
-      ignerr << "Requested to clone entity [" << _entity
-        << "] with a name of [" << _name << "], but another entity already "
-        << "has this name." << std::endl;
-      return kNullEntity;
+      auto tableIt = data.tables.find(typeId);
+      if (tableIt == data.tables.end() ||
+          tableIt->second->IndexOf(entity) == tableIt->second->entities.size())
+      {
+        toRemoveComps.push_back({entity, typeId});
+      }
     }
-    uniqueNameGenerated = true;
   }
+  for (const auto &[entity, typeId] : toRemoveComps)
+    this->RemoveComponent(entity, typeId);
 
-  auto clonedEntity = this->CreateEntity();
-
-  if (_parent != kNullEntity)
+  auto copy = [&](const components::ComponentPoolTraits *_traits,
+      const Entity _entity, const ComponentTypeId _typeId,
+      components::BaseComponent *_to, const components::BaseComponent *_from)
   {
-    this->SetParentEntity(clonedEntity, _parent);
-    this->CreateComponent(clonedEntity, components::ParentEntity(_parent));
-  }
+    if (nullptr != _traits && nullptr != _traits->assign)
+    {
+      _traits->assign(_to, _from);
+    }
+    else
+    {
+      std::string buffer;
+      components::ComponentBufferSerializer::Serialize(*_from, buffer);
+      components::ComponentBufferSerializer::Deserialize(*_to, buffer);
+    }
 
-  // make sure that the cloned entity has a unique name
-  auto clonedName = _name;
-  if (!uniqueNameGenerated)
-  {
-    if (clonedName.empty())
+    if (_typeId == components::ParentEntity::typeId)
     {
-      auto originalNameComp = this->Component<components::Name>(_entity);
-      clonedName =
-        originalNameComp ? originalNameComp->Data() : "cloned_entity";
+      this->SetParentEntity(_entity,
+          static_cast<const components::ParentEntity *>(_from)->Data());
     }
-    uint64_t suffix = 1;
-    while (kNullEntity != this->EntityByComponents(
-          components::Name(clonedName + "_" + std::to_string(suffix))))
-      suffix++;
-    clonedName += "_" + std::to_string(suffix);
-  }
-  this->CreateComponent(clonedEntity, components::Name(clonedName));
+  };
 
-  // copy all components from _entity to clonedEntity
-  for (const auto &type : this->ComponentTypes(_entity))
+  // Components created, removed or changed since the snapshot get its data
+  // back. Components stamped at the snapshot's tick may have changed after
+  // it was taken, so only older ones are known to be unchanged.
+  for (const auto &[typeId, table] : data.tables)
   {
-    // skip the Name and ParentEntity components since those were already
-    // handled above
-    if ((type == components::Name::typeId) ||
-        (type == components::ParentEntity::typeId))
+    if (nullptr == factory->Descriptor(typeId))
       continue;
+    const auto traits = components::ComponentPoolTraits::Find(typeId);
 
-    auto originalComp = this->ComponentImplementation(_entity, type);
-    auto clonedComp = originalComp->Clone();
+    for (std::size_t i = 0; i < table->entities.size(); ++i)
+    {
+      const Entity entity = table->entities[i];
+      const components::BaseComponent *saved = table->components[i].get();
 
-    this->CreateComponentImplementation(clonedEntity, type, clonedComp.get());
+      auto comp = this->ComponentImplementation(entity, typeId);
+      if (nullptr == comp)
+      {
+        // A component which is added back over one marked as removed keeps
+        // its old data
+        if (this->CreateComponentImplementation(entity, typeId, saved))
+        {
+          copy(traits, entity, typeId,
+              this->ComponentImplementation(entity, typeId), saved);
+        }
+        continue;
+      }
+
+      if (this->ComponentChangeTick(entity, typeId) < data.changeTick)
+        continue;
+
+      copy(traits, entity, typeId, comp, saved);
+      this->SetChanged(entity, typeId, ComponentState::OneTimeChange);
+    }
+  }
+
+  this->EndBatchCreation();
+}
+
+/////////////////////////////////////////////////
+EntityComponentManagerMemoryStats EntityComponentManager::MemoryStats() const
+{
+  IGN_PROFILE("EntityComponentManager::MemoryStats");
+  EntityComponentManagerMemoryStats stats;
+  auto factory = components::Factory::Instance();
+
+  // Components, by type
+  for (const auto &[typeId, storage] : this->dataPtr->componentStorage)
+  {
+    ComponentMemoryStats compStats;
+    compStats.typeId = typeId;
+    compStats.name = factory->Name(typeId);
+    compStats.count = storage.Size();
+
+    // Components that couldn't be pooled are as large as the traits say,
+    // if there are traits
+    auto traits = components::ComponentPoolTraits::Find(typeId);
+    compStats.bytes = storage.MemoryUsage(
+        nullptr == traits ? 0u : traits->size);
+
+    stats.componentBytes += compStats.bytes;
+    stats.components.push_back(std::move(compStats));
+  }
+  std::sort(stats.components.begin(), stats.components.end(),
+      [](const ComponentMemoryStats &_a, const ComponentMemoryStats &_b)
+      {
+        return _a.bytes > _b.bytes;
+      });
+
+  // Views
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->viewsMutex);
+    stats.viewCount = this->dataPtr->views.size();
+    stats.viewBytes = hashBytes(this->dataPtr->views) +
+        this->dataPtr->views.size() * sizeof(std::mutex);
+    for (const auto &view : this->dataPtr->views)
+    {
+      stats.viewEntityCount += view.second.first->PackedEntities().size();
+      stats.viewBytes += view.second.first->MemoryUsage();
+    }
+  }
+
+  // Entity hierarchy
+  stats.entityCount = this->dataPtr->hierarchy.Size();
+  stats.graphBytes = this->dataPtr->hierarchy.MemoryUsage();
+
+  // Graph built for Entities(). Each vertex is a tree node, with an entry in
+  // the adjacency map, and each edge is a tree node, with an entry in the
+  // adjacency set of its source vertex.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->graphMutex);
+    const std::size_t vertexCount = this->dataPtr->graph.Vertices().size();
+    const std::size_t edgeCount = this->dataPtr->graph.Edges().size();
+    const std::size_t treeNode = 4u * sizeof(void *);
+    stats.graphBytes +=
+        vertexCount * (sizeof(math::graph::VertexId) +
+            sizeof(math::graph::Vertex<Entity>) + treeNode) +
+        vertexCount * (sizeof(math::graph::VertexId) +
+            sizeof(math::graph::EdgeId_S) + treeNode) +
+        edgeCount * (sizeof(math::graph::EdgeId) +
+            sizeof(math::graph::DirectedEdge<bool>) + treeNode) +
+        edgeCount * (sizeof(math::graph::EdgeId) + treeNode);
+  }
+
+  // Indices and change tracking
+  this->dataPtr->SyncModifiedComponents();
+  stats.indexBytes = hashBytes(this->dataPtr->componentTypeIndex) +
+      vectorBytes(this->dataPtr->componentTypeIndexIterators) +
+      hashBytes(this->dataPtr->componentStorage) +
+      hashBytes(this->dataPtr->periodicChangedComponents) +
+      hashBytes(this->dataPtr->oneTimeChangedComponents) +
+      hashBytes(this->dataPtr->newlyCreatedEntities) +
+      hashBytes(this->dataPtr->toRemoveEntities) +
+      hashBytes(this->dataPtr->modifiedComponents) +
+      this->dataPtr->modifiedFlags.size() * sizeof(std::atomic<bool>) +
+      hashBytes(this->dataPtr->removedComponents) +
+      hashBytes(this->dataPtr->componentsMarkedAsRemoved) +
+      treeBytes(this->dataPtr->removedEntityHistory);
+  for (const auto &types : this->dataPtr->componentTypeIndex)
+    stats.indexBytes += hashBytes(types.second);
+  for (const auto &entities : this->dataPtr->periodicChangedComponents)
+    stats.indexBytes += hashBytes(entities.second);
+  for (const auto &entities : this->dataPtr->oneTimeChangedComponents)
+    stats.indexBytes += hashBytes(entities.second);
+  for (const auto &types : this->dataPtr->removedComponents)
+    stats.indexBytes += hashBytes(types.second);
+  for (const auto &types : this->dataPtr->componentsMarkedAsRemoved)
+    stats.indexBytes += hashBytes(types.second);
+  for (const auto &removed : this->dataPtr->removedEntityHistory)
+    stats.indexBytes += vectorBytes(removed.second);
+  for (const auto &list : this->dataPtr->modifiedLists)
+    stats.indexBytes += vectorBytes(*list);
+
+  // Caches
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->hierarchyMutex);
+    stats.cacheBytes += vectorBytes(this->dataPtr->descendantOrder) +
+        hashBytes(this->dataPtr->descendantSpans) +
+        hashBytes(this->dataPtr->ancestorCache) +
+        hashBytes(this->dataPtr->worldPoseCache);
+    for (const auto &ancestors : this->dataPtr->ancestorCache)
+      stats.cacheBytes += vectorBytes(ancestors.second.second);
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->nameIndexMutex);
+    stats.cacheBytes += hashBytes(this->dataPtr->nameIndex) +
+        hashBytes(this->dataPtr->indexedNames) +
+        hashBytes(this->dataPtr->nameIndexDirty);
+    for (const auto &entities : this->dataPtr->nameIndex)
+      stats.cacheBytes += vectorBytes(entities.second);
+  }
+
+  stats.totalBytes = stats.componentBytes + stats.viewBytes +
+      stats.graphBytes + stats.indexBytes + stats.cacheBytes;
+  stats.reclaimedBytes = this->dataPtr->reclaimedBytes;
+  return stats;
+}
+
+/////////////////////////////////////////////////
+uint64_t EntityComponentManager::Compact()
+{
+  IGN_PROFILE("EntityComponentManager::Compact");
+  const uint64_t before = this->MemoryStats().totalBytes;
+
+  // Components and their indices
+  for (auto &storage : this->dataPtr->componentStorage)
+    storage.second.Compact();
+  const std::size_t buckets = this->dataPtr->componentTypeIndex.bucket_count();
+  compactHash(this->dataPtr->componentTypeIndex);
+  for (auto &types : this->dataPtr->componentTypeIndex)
+    compactHash(types.second);
+  if (this->dataPtr->componentTypeIndex.bucket_count() != buckets)
+  {
+    // Rehashing invalidated the iterators
+    this->dataPtr->componentTypeIndexIterators.clear();
+    this->dataPtr->componentTypeIndexIterators.shrink_to_fit();
+    this->dataPtr->componentTypeIndexDirty = true;
+  }
+
+  // Change tracking
+  compactHash(this->dataPtr->periodicChangedComponents);
+  for (auto &entities : this->dataPtr->periodicChangedComponents)
+    compactHash(entities.second);
+  compactHash(this->dataPtr->oneTimeChangedComponents);
+  for (auto &entities : this->dataPtr->oneTimeChangedComponents)
+    compactHash(entities.second);
+  compactHash(this->dataPtr->newlyCreatedEntities);
+  compactHash(this->dataPtr->toRemoveEntities);
+  compactHash(this->dataPtr->modifiedComponents);
+  compactHash(this->dataPtr->removedComponents);
+  compactHash(this->dataPtr->componentsMarkedAsRemoved);
+  for (auto &list : this->dataPtr->modifiedLists)
+    compactVector(*list);
+
+  // Views. Rehashing doesn't move entries, so view slots stay valid.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->viewsMutex);
+    compactHash(this->dataPtr->views);
+    for (auto &view : this->dataPtr->views)
+      view.second.first->Compact();
+  }
+
+  // Hierarchy and caches
+  this->dataPtr->hierarchy.Compact();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->hierarchyMutex);
+    compactVector(this->dataPtr->descendantOrder);
+    compactHash(this->dataPtr->descendantSpans);
+    compactHash(this->dataPtr->ancestorCache);
+    compactHash(this->dataPtr->worldPoseCache);
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->nameIndexMutex);
+    compactHash(this->dataPtr->nameIndex);
+    compactHash(this->dataPtr->indexedNames);
+    compactHash(this->dataPtr->nameIndexDirty);
+  }
+
+  const uint64_t after = this->MemoryStats().totalBytes;
+  const uint64_t reclaimed = before > after ? before - after : 0u;
+  this->dataPtr->reclaimedBytes += reclaimed;
+  this->dataPtr->peakEntityCount = this->dataPtr->hierarchy.Size();
+  return reclaimed;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::UpdateSpatialIndex()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->spatialIndexMutex);
+  if (nullptr == this->dataPtr->spatialIndex)
+    return;
+
+  this->RefreshSpatialIndex(this->dataPtr->spatialIndexSince);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::RefreshSpatialIndex(uint64_t _sinceTick) const
+{
+  IGN_PROFILE("EntityComponentManager::RefreshSpatialIndex");
+  auto &index = *this->dataPtr->spatialIndex;
+
+  for (auto it = this->dataPtr->removedEntityHistory.upper_bound(_sinceTick);
+       it != this->dataPtr->removedEntityHistory.end(); ++it)
+  {
+    for (const Entity entity : it->second)
+      index.Remove(entity);
+  }
+
+  auto updateModel = [&](const Entity _entity)
+  {
+    if (nullptr == this->Component<components::Model>(_entity) ||
+        nullptr == this->Component<components::Pose>(_entity))
+    {
+      index.Remove(_entity);
+      return;
+    }
+
+    auto box = this->Component<components::AxisAlignedBox>(_entity);
+    if (nullptr != box)
+    {
+      index.Update(_entity, box->Data());
+      return;
+    }
+
+    const auto position = worldPose(_entity, *this).Pos();
+    index.Update(_entity, math::AxisAlignedBox(position, position));
+  };
+
+  const auto changed = this->EntitiesChangedSince(_sinceTick,
+      {components::Model::typeId, components::Pose::typeId,
+      components::AxisAlignedBox::typeId});
+  for (const Entity entity : changed)
+  {
+    if (nullptr == this->Component<components::Model>(entity))
+      continue;
+
+    // Nested models move with their parent
+    for (const Entity descendant : this->Descendants(entity))
+      updateModel(descendant);
+  }
+
+  // Ticks only advance after systems are updated, so changes made by the
+  // next systems update are stamped with the current tick
+  this->dataPtr->spatialIndexSince = this->dataPtr->changeTick - 1u;
+}
+
+/////////////////////////////////////////////////
+Entity EntityComponentManagerPrivate::CreateEntityImplementation(Entity _entity,
+    bool _trackNew)
+{
+  IGN_PROFILE("EntityComponentManager::CreateEntityImplementation");
+  this->hierarchy.Add(_entity);
+
+  // Add entity to the list of newly created entities
+  if (_trackNew)
+  {
+    std::lock_guard<std::mutex> lock(this->entityCreatedMutex);
+    this->newlyCreatedEntities.insert(_entity);
+  }
+
+  this->InvalidateHierarchy();
+
+  const auto index = this->hierarchy.IndexOf(_entity).index;
+  while (this->modifiedFlags.size() <= index)
+    this->modifiedFlags.emplace_back(false);
+  this->modifiedFlags[index].store(false, std::memory_order_relaxed);
+
+  const auto result = this->componentTypeIndex.insert({_entity,
+      std::unordered_map<ComponentTypeId, std::size_t>()});
+  if (!result.second)
+  {
+    ignwarn << "Attempted to add entity [" << _entity
+      << "] to component type index, but this entity is already in component "
+      << "type index.\n";
+  }
+
+  return _entity;
+}
+
+/////////////////////////////////////////////////
+Entity EntityComponentManager::Clone(Entity _entity, Entity _parent,
+    const std::string &_name, bool _allowRename)
+{
+  // Clear maps so they're populated for the entity being cloned
+  this->dataPtr->oldToClonedCanonicalLink.clear();
+  this->dataPtr->oldModelCanonicalLink.clear();
+  this->dataPtr->originalToClonedLink.clear();
+  this->dataPtr->clonedToOriginalJointLinks.clear();
+
+  auto clonedEntity = this->CloneImpl(_entity, _parent, _name, _allowRename);
+
+  if (kNullEntity != clonedEntity)
+  {
+    // make sure that cloned models have their canonical link updated to the
+    // cloned canonical link
+    for (const auto &[clonedModel, oldCanonicalLink] :
+         this->dataPtr->oldModelCanonicalLink)
+    {
+      auto iter = this->dataPtr->oldToClonedCanonicalLink.find(
+          oldCanonicalLink);
+      if (iter == this->dataPtr->oldToClonedCanonicalLink.end())
+      {
+        ignerr << "Error: attempted to clone model(s) with canonical link(s), "
+          << "but entity [" << oldCanonicalLink << "] was not cloned as a "
+          << "canonical link." << std::endl;
+        continue;
+      }
+      const auto clonedCanonicalLink = iter->second;
+      this->SetComponentData<components::ModelCanonicalLink>(clonedModel,
+          clonedCanonicalLink);
+    }
+
+    // make sure that cloned joints have their parent/child links
+    // updated to the cloned parent/child links
+    for (const auto &[clonedJoint, originalJointLinks] :
+        this->dataPtr->clonedToOriginalJointLinks)
+    {
+      auto originalParentLink = originalJointLinks.first;
+      if (!this->dataPtr->ClonedJointLinkName<components::ParentLinkName>(
+            clonedJoint, originalParentLink, this))
+      {
+        ignerr << "Error updating the cloned parent link name for cloned "
+               << "joint [" << clonedJoint << "]\n";
+        continue;
+      }
+
+      auto originalChildLink = originalJointLinks.second;
+      if (!this->dataPtr->ClonedJointLinkName<components::ChildLinkName>(
+            clonedJoint, originalChildLink, this))
+      {
+        ignerr << "Error updating the cloned child link name for cloned "
+               << "joint [" << clonedJoint << "]\n";
+        continue;
+      }
+    }
+  }
+
+  return clonedEntity;
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::CloneMany(Entity _entity,
+    Entity _parent, std::size_t _count)
+{
+  IGN_PROFILE("EntityComponentManager::CloneMany");
+  std::vector<Entity> roots;
+  if (!this->HasEntity(_entity))
+  {
+    ignerr << "Requested to clone entity [" << _entity
+      << "], but this entity does not exist." << std::endl;
+    return roots;
+  }
+  if (_count == 0u)
+    return roots;
+
+  // Children of each entity, through their components::ParentEntity, like
+  // Clone finds them
+  std::unordered_map<Entity, std::vector<Entity>> children;
+  auto parentStorage =
+      this->dataPtr->componentStorage.find(components::ParentEntity::typeId);
+  if (parentStorage != this->dataPtr->componentStorage.end())
+  {
+    const auto &storage = parentStorage->second;
+    for (std::size_t i = 0; i < storage.Size(); ++i)
+    {
+      const Entity child = storage.EntityAt(i);
+      if (this->dataPtr->ComponentMarkedAsRemoved(child,
+          components::ParentEntity::typeId))
+      {
+        continue;
+      }
+      children[static_cast<const components::ParentEntity *>(
+          storage.Component(i))->Data()].push_back(child);
+    }
+  }
+
+  // The subtree to copy, with each entity before its descendants, and the
+  // index of each entity's parent in it
+  std::vector<Entity> subtree{_entity};
+  std::vector<std::size_t> parentIndex{0u};
+  std::unordered_map<Entity, std::size_t> subtreeIndex{{_entity, 0u}};
+  for (std::size_t i = 0; i < subtree.size(); ++i)
+  {
+    auto childrenIt = children.find(subtree[i]);
+    if (childrenIt == children.end())
+      continue;
+
+    for (const Entity child : childrenIt->second)
+    {
+      if (!subtreeIndex.insert({child, subtree.size()}).second)
+        continue;
+      subtree.push_back(child);
+      parentIndex.push_back(i);
+    }
+  }
+
+  std::unordered_map<ComponentTypeId, std::size_t> typeCounts;
+  for (const Entity entity : subtree)
+  {
+    for (const auto &[typeId, index] :
+        this->dataPtr->componentTypeIndex[entity])
+    {
+      if (!this->dataPtr->ComponentMarkedAsRemoved(entity, typeId))
+        ++typeCounts[typeId];
+    }
+  }
+
+  // Allocate everything up front
+  auto clones = this->CreateEntities(subtree.size() * _count);
+  if (clones.size() != subtree.size() * _count)
+  {
+    ignerr << "Not enough entity ids left to clone entity [" << _entity
+           << "] " << _count << " times." << std::endl;
+    for (const Entity clone : clones)
+      this->RequestRemoveEntity(clone, false);
+    return roots;
+  }
+  for (const auto &[typeId, count] : typeCounts)
+    this->ReserveComponents(typeId, count * _count);
+
+  auto originalNameComp = this->Component<components::Name>(_entity);
+  const std::string rootName =
+      originalNameComp ? originalNameComp->Data() : "cloned_entity";
+  uint64_t suffix{0u};
+
+  this->BeginBatchCreation();
+  roots.reserve(_count);
+  for (std::size_t c = 0; c < _count; ++c)
+  {
+    const Entity *cloned = clones.data() + c * subtree.size();
+    auto remap = [&](const Entity _original)
+    {
+      auto it = subtreeIndex.find(_original);
+      return it == subtreeIndex.end() ? _original : cloned[it->second];
+    };
+
+    for (std::size_t i = 0; i < subtree.size(); ++i)
+    {
+      const Entity original = subtree[i];
+      const Entity clone = cloned[i];
+      const Entity parent = i == 0u ? _parent : cloned[parentIndex[i]];
+      if (kNullEntity != parent)
+      {
+        this->dataPtr->hierarchy.SetParent(clone, parent);
+        this->CreateComponent(clone, components::ParentEntity(parent));
+      }
+
+      if (i == 0u)
+      {
+        std::string name;
+        do
+        {
+          name = rootName + "_" + std::to_string(++suffix);
+        }
+        while (!this->EntitiesByName(name).empty());
+        this->CreateComponent(clone, components::Name(name));
+      }
+
+      // Copy the components straight from the originals, remapping the
+      // ones which refer to other cloned entities
+      for (const auto &[typeId, index] :
+          this->dataPtr->componentTypeIndex[original])
+      {
+        if (typeId == components::ParentEntity::typeId ||
+            (i == 0u && typeId == components::Name::typeId) ||
+            this->dataPtr->ComponentMarkedAsRemoved(original, typeId))
+        {
+          continue;
+        }
+
+        auto originalComp = this->ComponentImplementation(original, typeId);
+        if (typeId == components::ModelCanonicalLink::typeId)
+        {
+          components::ModelCanonicalLink canonical(remap(
+              static_cast<const components::ModelCanonicalLink *>(
+              originalComp)->Data()));
+          this->CreateComponentImplementation(clone, typeId, &canonical);
+          continue;
+        }
+        this->CreateComponentImplementation(clone, typeId, originalComp);
+      }
+    }
+    roots.push_back(cloned[0]);
+  }
+  this->EndBatchCreation();
+  this->dataPtr->InvalidateHierarchy();
+
+  return roots;
+}
+
+/////////////////////////////////////////////////
+std::unordered_map<Entity, Entity> EntityComponentManager::CopyEntities(
+    const EntityComponentManager &_other)
+{
+  IGN_PROFILE("EntityComponentManager::CopyEntities");
+  std::unordered_map<Entity, Entity> copies;
+  if (&_other == this)
+    return copies;
+
+  // Entities are sorted by id
+  std::vector<Entity> originals = _other.dataPtr->hierarchy.Entities();
+  originals.erase(std::remove_if(originals.begin(), originals.end(),
+      [&](const Entity _entity)
+      {
+        return _other.IsMarkedForRemoval(_entity);
+      }), originals.end());
+  if (originals.empty())
+    return copies;
+
+  std::unordered_map<ComponentTypeId, std::size_t> typeCounts;
+  for (const Entity original : originals)
+  {
+    auto typesIt = _other.dataPtr->componentTypeIndex.find(original);
+    if (typesIt == _other.dataPtr->componentTypeIndex.end())
+      continue;
+    for (const auto &[typeId, index] : typesIt->second)
+    {
+      if (!_other.dataPtr->ComponentMarkedAsRemoved(original, typeId))
+        ++typeCounts[typeId];
+    }
+  }
+
+  // Allocate everything up front
+  auto created = this->CreateEntities(originals.size());
+  if (created.size() != originals.size())
+  {
+    ignerr << "Not enough entity ids left to copy " << originals.size()
+           << " entities." << std::endl;
+    for (const Entity entity : created)
+      this->RequestRemoveEntity(entity, false);
+    return copies;
+  }
+  for (const auto &[typeId, count] : typeCounts)
+    this->ReserveComponents(typeId, count);
+
+  copies.reserve(originals.size());
+  for (std::size_t i = 0; i < originals.size(); ++i)
+    copies[originals[i]] = created[i];
+  auto remap = [&](const Entity _original)
+  {
+    auto it = copies.find(_original);
+    return it == copies.end() ? _original : it->second;
+  };
+
+  this->BeginBatchCreation();
+  for (std::size_t i = 0; i < originals.size(); ++i)
+  {
+    const Entity original = originals[i];
+    const Entity copy = created[i];
+    auto typesIt = _other.dataPtr->componentTypeIndex.find(original);
+    if (typesIt == _other.dataPtr->componentTypeIndex.end())
+      continue;
+
+    for (const auto &[typeId, index] : typesIt->second)
+    {
+      if (_other.dataPtr->ComponentMarkedAsRemoved(original, typeId))
+        continue;
+
+      auto originalComp = _other.ComponentImplementation(original, typeId);
+      if (typeId == components::ParentEntity::typeId)
+      {
+        const Entity parent = remap(static_cast<
+            const components::ParentEntity *>(originalComp)->Data());
+        this->dataPtr->hierarchy.SetParent(copy, parent);
+        components::ParentEntity parentComp(parent);
+        this->CreateComponentImplementation(copy, typeId, &parentComp);
+        continue;
+      }
+      if (typeId == components::ModelCanonicalLink::typeId)
+      {
+        components::ModelCanonicalLink canonical(remap(
+            static_cast<const components::ModelCanonicalLink *>(
+            originalComp)->Data()));
+        this->CreateComponentImplementation(copy, typeId, &canonical);
+        continue;
+      }
+      this->CreateComponentImplementation(copy, typeId, originalComp);
+    }
+  }
+  this->EndBatchCreation();
+  this->dataPtr->InvalidateHierarchy();
+
+  return copies;
+}
+
+/////////////////////////////////////////////////
+Entity EntityComponentManager::CloneImpl(Entity _entity, Entity _parent,
+    const std::string &_name, bool _allowRename)
+{
+  auto uniqueNameGenerated = false;
+
+  // Before cloning, we should make sure that:
+  //  1. The entity to be cloned exists
+  //  2. We can generate a unique name for the cloned entity
+  if (!this->HasEntity(_entity))
+  {
+    ignerr << "Requested to clone entity [" << _entity
+      << "], but this entity does not exist." << std::endl;
+    return kNullEntity;
+  }
+  else if (!_name.empty() && !_allowRename)
+  {
+    // Get the entity's original parent. This is used to make sure we get
+    // the correct entity. For example, two different models may have a
+    // child with the name "link".
+    auto origParentComp =
+        this->Component<components::ParentEntity>(_entity);
+
+    // If there is an entity with the same name and user indicated renaming is
+    // not allowed then return null entity.
+    // If the entity or one of its ancestor has a Recreate component then carry
+    // on since the ECM is supposed to create a new entity with the same name.
+    Entity ent = this->EntityByComponents(components::Name(_name),
+        components::ParentEntity(origParentComp->Data()));
+
+    bool hasRecreateComp = false;
+    Entity recreateEnt = ent;
+    while (recreateEnt != kNullEntity && !hasRecreateComp)
+    {
+      hasRecreateComp = this->Component<components::Recreate>(recreateEnt) !=
+        nullptr;
+      auto parentComp = this->Component<components::ParentEntity>(recreateEnt);
+      recreateEnt = parentComp ? parentComp->Data() : kNullEntity;
+    }
+
+    if (kNullEntity != ent && !hasRecreateComp)
+    {
+      ignerr << "Requested to clone entity [" << _entity
+        << "] with a name of [" << _name << "], but another entity already "
+        << "has this name." << std::endl;
+      return kNullEntity;
+    }
+    uniqueNameGenerated = true;
+  }
+
+  auto clonedEntity = this->CreateEntity();
+
+  if (_parent != kNullEntity)
+  {
+    this->SetParentEntity(clonedEntity, _parent);
+    this->CreateComponent(clonedEntity, components::ParentEntity(_parent));
+  }
+
+  // make sure that the cloned entity has a unique name
+  auto clonedName = _name;
+  if (!uniqueNameGenerated)
+  {
+    if (clonedName.empty())
+    {
+      auto originalNameComp = this->Component<components::Name>(_entity);
+      clonedName =
+        originalNameComp ? originalNameComp->Data() : "cloned_entity";
+    }
+    uint64_t suffix = 1;
+    while (kNullEntity != this->EntityByComponents(
+          components::Name(clonedName + "_" + std::to_string(suffix))))
+      suffix++;
+    clonedName += "_" + std::to_string(suffix);
+  }
+  this->CreateComponent(clonedEntity, components::Name(clonedName));
+
+  // copy all components from _entity to clonedEntity
+  for (const auto &type : this->ComponentTypes(_entity))
+  {
+    // skip the Name and ParentEntity components since those were already
+    // handled above
+    if ((type == components::Name::typeId) ||
+        (type == components::ParentEntity::typeId))
+      continue;
+
+    auto originalComp = this->ComponentImplementation(_entity, type);
+    auto clonedComp = originalComp->Clone();
+
+    this->CreateComponentImplementation(clonedEntity, type, clonedComp.get());
   }
 
   // keep track of canonical link information (for clones of models, the cloned
@@ -596,6 +1710,7 @@ Entity EntityComponentManager::CloneImpl(Entity _entity, Entity _parent,
 /////////////////////////////////////////////////
 void EntityComponentManager::ClearNewlyCreatedEntities()
 {
+  this->dataPtr->SyncModifiedComponents();
   std::lock_guard<std::mutex> lock(this->dataPtr->entityCreatedMutex);
   this->dataPtr->newlyCreatedEntities.clear();
 
@@ -623,10 +1738,8 @@ void EntityComponentManager::ClearRemovedComponents()
 void EntityComponentManagerPrivate::InsertEntityRecursive(Entity _entity,
     std::unordered_set<Entity> &_set)
 {
-  for (const auto &vertex : this->entities.AdjacentsFrom(_entity))
-  {
-    this->InsertEntityRecursive(vertex.first, _set);
-  }
+  for (const Entity entity : this->hierarchy.Subtree(_entity))
+    _set.insert(entity);
   _set.insert(_entity);
 }
 
@@ -634,10 +1747,8 @@ void EntityComponentManagerPrivate::InsertEntityRecursive(Entity _entity,
 void EntityComponentManagerPrivate::EraseEntityRecursive(Entity _entity,
     std::unordered_set<Entity> &_set)
 {
-  for (const auto &vertex : this->entities.AdjacentsFrom(_entity))
-  {
-    this->EraseEntityRecursive(vertex.first, _set);
-  }
+  for (const Entity entity : this->hierarchy.Subtree(_entity))
+    _set.erase(entity);
   _set.erase(_entity);
 }
 
@@ -662,9 +1773,8 @@ void EntityComponentManager::RequestRemoveEntity(Entity _entity,
   for (auto iter = tmpToRemoveEntities.begin();
        iter != tmpToRemoveEntities.end();)
   {
-    if (std::find(this->dataPtr->pinnedEntities.begin(),
-                  this->dataPtr->pinnedEntities.end(), *iter) !=
-               this->dataPtr->pinnedEntities.end())
+    if (this->dataPtr->pinnedEntities.find(*iter) !=
+        this->dataPtr->pinnedEntities.end())
     {
       iter = tmpToRemoveEntities.erase(iter);
     }
@@ -674,6 +1784,7 @@ void EntityComponentManager::RequestRemoveEntity(Entity _entity,
     }
   }
 
+  this->dataPtr->SyncModifiedComponents();
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
     this->dataPtr->toRemoveEntities.insert(tmpToRemoveEntities.begin(),
@@ -698,7 +1809,11 @@ void EntityComponentManager::RequestRemoveEntities()
       std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
       this->dataPtr->removeAllEntities = true;
     }
-    this->RebuildViews();
+
+    // Views are cleared once the entities are removed, until then they
+    // only need to know that all their entities are going away
+    for (auto &view : this->dataPtr->views)
+      view.second.first->MarkAllEntitiesToRemove();
   }
   else
   {
@@ -706,16 +1821,16 @@ void EntityComponentManager::RequestRemoveEntities()
 
     // Store the to-be-removed entities in a temporary set so we can
     // mark each of them to be removed from views that contain them.
-    for (const auto &vertex : this->dataPtr->entities.Vertices())
+    for (const Entity entity : this->dataPtr->hierarchy.Entities())
     {
-      if (std::find(this->dataPtr->pinnedEntities.begin(),
-                    this->dataPtr->pinnedEntities.end(), vertex.first) ==
+      if (this->dataPtr->pinnedEntities.find(entity) ==
           this->dataPtr->pinnedEntities.end())
       {
-        tmpToRemoveEntities.insert(vertex.first);
+        tmpToRemoveEntities.insert(entity);
       }
     }
 
+    this->dataPtr->SyncModifiedComponents();
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
       this->dataPtr->toRemoveEntities.insert(tmpToRemoveEntities.begin(),
@@ -736,27 +1851,52 @@ void EntityComponentManager::RequestRemoveEntities()
 void EntityComponentManager::ProcessRemoveEntityRequests()
 {
   IGN_PROFILE("EntityComponentManager::ProcessRemoveEntityRequests");
+  this->dataPtr->SyncModifiedComponents();
   std::lock_guard<std::mutex> lock(this->dataPtr->entityRemoveMutex);
+  this->dataPtr->peakEntityCount = std::max(this->dataPtr->peakEntityCount,
+      this->dataPtr->hierarchy.Size());
+
   // Short-cut if erasing all entities
   if (this->dataPtr->removeAllEntities)
   {
     IGN_PROFILE("RemoveAll");
     this->dataPtr->removeAllEntities = false;
-    this->dataPtr->entities = EntityGraph();
+    auto &removedHistory =
+        this->dataPtr->removedEntityHistory[this->dataPtr->changeTick];
+    const auto entities = this->dataPtr->hierarchy.Entities();
+    removedHistory.insert(removedHistory.end(), entities.begin(),
+        entities.end());
+    this->dataPtr->hierarchy.Clear();
     this->dataPtr->toRemoveEntities.clear();
     this->dataPtr->componentsMarkedAsRemoved.clear();
 
-    // reset the entity component storage
-    this->dataPtr->componentStorage.clear();
+    // reset the entity component storage, keeping the memory pooled for
+    // each component type
+    for (auto &typeStorage : this->dataPtr->componentStorage)
+      typeStorage.second.Clear();
     this->dataPtr->componentTypeIndex.clear();
     this->dataPtr->componentTypeIndexDirty = true;
+    for (auto &flag : this->dataPtr->modifiedFlags)
+      flag.store(false, std::memory_order_relaxed);
 
     // All views are now invalid.
     this->dataPtr->views.clear();
+    for (auto &slot : this->dataPtr->viewSlots)
+      slot.store(nullptr);
+
+    this->dataPtr->ancestorCache.clear();
+    this->dataPtr->worldPoseCache.clear();
+    this->dataPtr->nameIndex.clear();
+    this->dataPtr->indexedNames.clear();
+    this->dataPtr->nameIndexDirty.clear();
+    this->dataPtr->nameIndexStale = false;
   }
   else
   {
     IGN_PROFILE("Remove");
+    std::vector<Entity> removed;
+    removed.reserve(this->dataPtr->toRemoveEntities.size());
+
     // Otherwise iterate through the list of entities to remove.
     for (const Entity entity : this->dataPtr->toRemoveEntities)
     {
@@ -764,26 +1904,41 @@ void EntityComponentManager::ProcessRemoveEntityRequests()
       if (!this->HasEntity(entity))
         continue;
 
-      // Remove from graph
-      this->dataPtr->entities.RemoveVertex(entity);
+      // Remove from the hierarchy
+      this->dataPtr->hierarchy.Remove(entity);
+      this->dataPtr->removedEntityHistory[this->dataPtr->changeTick].push_back(
+          entity);
 
       this->dataPtr->componentsMarkedAsRemoved.erase(entity);
-      this->dataPtr->componentStorage.erase(entity);
+      this->dataPtr->DestroyEntityComponents(entity);
       this->dataPtr->componentTypeIndex.erase(entity);
       this->dataPtr->componentTypeIndexDirty = true;
-
-      // Remove the entity from views.
-      for (auto &view : this->dataPtr->views)
-      {
-        view.second.first->RemoveEntity(entity);
-      }
+      this->dataPtr->ancestorCache.erase(entity);
+      this->dataPtr->worldPoseCache.erase(entity);
+      this->dataPtr->UnindexName(entity);
+      this->dataPtr->nameIndexDirty.erase(entity);
+      removed.push_back(entity);
     }
+
+    // Remove the entities from views all at once, so that each view is
+    // compacted only once no matter how many entities are removed
+    std::sort(removed.begin(), removed.end());
+    for (auto &view : this->dataPtr->views)
+      view.second.first->RemoveEntities(removed);
+
     // Clear the set of entities to remove.
     this->dataPtr->toRemoveEntities.clear();
   }
 
-  // Reset descendants cache
-  this->dataPtr->descendantCache.clear();
+  this->dataPtr->InvalidateHierarchy();
+
+  // Release the memory held for the removed entities once most are gone
+  if (this->dataPtr->peakEntityCount >= kCompactMinEntities &&
+      this->dataPtr->hierarchy.Size() <
+      this->dataPtr->peakEntityCount * kCompactOccupancy)
+  {
+    this->Compact();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -814,11 +1969,16 @@ bool EntityComponentManager::RemoveComponent(
   auto compPtr = this->ComponentImplementation(_entity, _typeId);
   if (compPtr)
   {
+    this->dataPtr->StampChange(_entity, _typeId);
     this->dataPtr->componentsMarkedAsRemoved[_entity].insert(_typeId);
 
+    // The instance is kept, so component handles need to be told
+    this->dataPtr->componentStorage[_typeId].BumpGeneration();
+
     // update views to reflect the component removal
     for (auto &viewPair : this->dataPtr->views)
       viewPair.second.first->NotifyComponentRemoval(_entity, _typeId);
+    this->UpdateFilteredViews(_entity, _typeId);
   }
 
   this->dataPtr->AddModifiedComponent(_entity);
@@ -950,42 +2110,39 @@ std::unordered_set<ComponentTypeId>
 /////////////////////////////////////////////////
 bool EntityComponentManager::HasEntity(const Entity _entity) const
 {
-  auto vertex = this->dataPtr->entities.VertexFromId(_entity);
-  return vertex.Id() != math::graph::kNullId;
+  return this->dataPtr->hierarchy.Has(_entity);
 }
 
 /////////////////////////////////////////////////
-Entity EntityComponentManager::ParentEntity(const Entity _entity) const
+EntityIndex EntityComponentManager::IndexOf(const Entity _entity) const
 {
-  auto parents = this->Entities().AdjacentsTo(_entity);
-  if (parents.empty())
-    return kNullEntity;
+  return this->dataPtr->hierarchy.IndexOf(_entity);
+}
 
-  // TODO(louise) Do we want to support multiple parents?
-  return parents.begin()->first;
+/////////////////////////////////////////////////
+Entity EntityComponentManager::EntityAt(const EntityIndex &_index) const
+{
+  return this->dataPtr->hierarchy.EntityAt(_index);
 }
 
 /////////////////////////////////////////////////
-bool EntityComponentManager::SetParentEntity(const Entity _child,
-    const Entity _parent)
+std::size_t EntityComponentManager::IndexCount() const
 {
-  // Remove current parent(s)
-  auto parents = this->Entities().AdjacentsTo(_child);
-  for (const auto &parent : parents)
-  {
-    auto edge = this->dataPtr->entities.EdgeFromVertices(parent.first, _child);
-    this->dataPtr->entities.RemoveEdge(edge);
-  }
+  return this->dataPtr->hierarchy.IndexCount();
+}
 
-  // Leave parent-less
-  if (_parent == kNullEntity)
-  {
-    return true;
-  }
+/////////////////////////////////////////////////
+Entity EntityComponentManager::ParentEntity(const Entity _entity) const
+{
+  return this->dataPtr->hierarchy.Parent(_entity);
+}
 
-  // Add edge
-  auto edge = this->dataPtr->entities.AddEdge({_parent, _child}, true);
-  return (math::graph::kNullId != edge.Id());
+/////////////////////////////////////////////////
+bool EntityComponentManager::SetParentEntity(const Entity _child,
+    const Entity _parent)
+{
+  this->dataPtr->InvalidateHierarchy();
+  return this->dataPtr->hierarchy.SetParent(_child, _parent);
 }
 
 /////////////////////////////////////////////////
@@ -1030,33 +2187,51 @@ bool EntityComponentManager::CreateComponentImplementation(
     return false;
   }
 
-  auto entityCompIter = this->dataPtr->componentStorage.find(_entity);
-  if (entityCompIter == this->dataPtr->componentStorage.end())
-  {
-    ignerr << "Attempt to create a component of type [" << _componentTypeId
-      << "] attached to entity [" << _entity
-      << "] failed: entity not in storage." << std::endl;
-    return false;
-  }
-
-  // Instantiate the new component.
-  auto newComp = components::Factory::Instance()->New(_componentTypeId, _data);
+  auto &typeStorage = this->dataPtr->componentStorage[_componentTypeId];
 
   const auto compIdxIter = typeMapIter->second.find(_componentTypeId);
   // If entity has never had a component of this type
   if (compIdxIter == typeMapIter->second.end())
   {
-    const auto vectorIdx = entityCompIter->second.size();
-    entityCompIter->second.push_back(std::move(newComp));
-    this->dataPtr->componentTypeIndex[_entity][_componentTypeId] = vectorIdx;
+    // Instantiate the new component, in memory pooled by the storage when
+    // possible. Invalid data goes through the factory, which reports it.
+    const auto descriptor =
+        components::Factory::Instance()->Descriptor(_componentTypeId);
+    std::size_t storageIdx;
+    if (nullptr != descriptor && nullptr != _data &&
+        _data->TypeId() == _componentTypeId)
+    {
+      storageIdx = typeStorage.Emplace(_entity, *descriptor,
+          components::ComponentPoolTraits::Find(_componentTypeId), _data,
+          this->dataPtr->changeTick);
+    }
+    else
+    {
+      auto newComp =
+          components::Factory::Instance()->New(_componentTypeId, _data);
+      storageIdx = typeStorage.Add(_entity, std::move(newComp),
+          this->dataPtr->changeTick);
+    }
+    typeMapIter->second[_componentTypeId] = storageIdx;
     this->dataPtr->componentTypeIndexDirty = true;
 
     updateData = false;
-    for (auto &viewPair : this->dataPtr->views)
+    if (this->dataPtr->batchCreationDepth > 0u)
     {
-      auto &view = viewPair.second.first;
-      if (this->EntityMatches(_entity, view->ComponentTypes()))
-        view->MarkEntityToAdd(_entity, this->IsNewEntity(_entity));
+      // Views are updated once per entity when the batch ends
+      if (this->dataPtr->batchedEntitySet.insert(_entity).second)
+        this->dataPtr->batchedEntities.push_back(_entity);
+    }
+    else
+    {
+      const bool isNew = this->IsNewEntity(_entity);
+      for (auto &viewPair : this->dataPtr->views)
+      {
+        auto &view = viewPair.second.first;
+        if (this->EntityMatchesView(_entity, *view))
+          view->MarkEntityToAdd(_entity, isNew);
+      }
+      this->UpdateFilteredViews(_entity, _componentTypeId);
     }
   }
   else
@@ -1070,7 +2245,7 @@ bool EntityComponentManager::CreateComponentImplementation(
     // of the data is done externally in a templated ECM method call, because we
     // need the derived component class in order to update the derived component
     // data)
-    auto existingCompPtr = entityCompIter->second.at(compIdxIter->second).get();
+    auto existingCompPtr = typeStorage.Component(compIdxIter->second);
     if (!existingCompPtr)
     {
       ignerr << "Internal error: entity [" << _entity << "] has a component of "
@@ -1079,19 +2254,25 @@ bool EntityComponentManager::CreateComponentImplementation(
         << std::endl;
       return false;
     }
-    else if (this->dataPtr->ComponentMarkedAsRemoved(_entity, _componentTypeId))
+
+    typeStorage.SetTick(compIdxIter->second, this->dataPtr->changeTick);
+    if (this->dataPtr->ComponentMarkedAsRemoved(_entity, _componentTypeId))
     {
       this->dataPtr->componentsMarkedAsRemoved[_entity].erase(_componentTypeId);
+      typeStorage.BumpGeneration();
 
+      const bool isNew = this->IsNewEntity(_entity);
       for (auto &viewPair : this->dataPtr->views)
       {
-        viewPair.second.first->NotifyComponentAddition(_entity,
-            this->IsNewEntity(_entity), _componentTypeId);
+        viewPair.second.first->NotifyComponentAddition(_entity, isNew,
+            _componentTypeId);
       }
+      this->UpdateFilteredViews(_entity, _componentTypeId);
     }
   }
 
   this->dataPtr->createdCompTypes.insert(_componentTypeId);
+  this->dataPtr->InvalidateCachesFor(_entity, _componentTypeId);
 
   // If the component is a components::ParentEntity, then make sure to
   // update the entities graph.
@@ -1129,7 +2310,57 @@ bool EntityComponentManager::EntityMatches(Entity _entity,
       return false;
   }
 
-  return true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool EntityComponentManager::EntityMatchesView(const Entity _entity,
+    const detail::BaseView &_view) const
+{
+  if (!this->EntityMatches(_entity, _view.ComponentTypes()))
+    return false;
+
+  for (const ComponentTypeId &type : _view.ExcludedComponentTypes())
+  {
+    if (nullptr != this->ComponentImplementation(_entity, type))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::UpdateFilteredViews(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  if (this->dataPtr->batchCreationDepth > 0u)
+  {
+    // Views are updated once per entity when the batch ends
+    if (this->dataPtr->batchedEntitySet.insert(_entity).second)
+      this->dataPtr->batchedEntities.push_back(_entity);
+    return;
+  }
+
+  const bool isNew = this->IsNewEntity(_entity);
+  for (auto &viewPair : this->dataPtr->views)
+  {
+    auto &view = viewPair.second.first;
+    if (!view->IsFiltered() || (!view->RequiresComponent(_typeId) &&
+        !view->FiltersComponent(_typeId)))
+    {
+      continue;
+    }
+
+    // Add the entity again, so that it's left out if it now has an excluded
+    // component, and its optional components are fetched again
+    view->RemoveEntity(_entity);
+    if (!this->EntityMatchesView(_entity, *view))
+      continue;
+
+    view->MarkEntityToAdd(_entity, isNew);
+    if (this->IsMarkedForRemoval(_entity))
+      view->MarkEntityToRemove(_entity);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -1150,16 +2381,16 @@ const components::BaseComponent
     return nullptr;
 
   // get the pointer to the component
-  const auto compVecIter = this->dataPtr->componentStorage.find(_entity);
-  if (compVecIter == this->dataPtr->componentStorage.end())
+  const auto storageIter = this->dataPtr->componentStorage.find(_type);
+  if (storageIter == this->dataPtr->componentStorage.end())
   {
-    ignerr << "Internal error: Entity [" << _entity
+    ignerr << "Internal error: Component type [" << _type
       << "] is missing in storage, but is in "
       << "componentTypeIndex. This should never happen!" << std::endl;
     return nullptr;
   }
 
-  auto compPtr = compVecIter->second.at(compIdxIter->second).get();
+  auto compPtr = storageIter->second.Component(compIdxIter->second);
   if (nullptr == compPtr)
   {
     ignerr << "Internal error: entity [" << _entity << "] has a component of "
@@ -1181,9 +2412,54 @@ components::BaseComponent *EntityComponentManager::ComponentImplementation(
     const Entity _entity, const ComponentTypeId _type)
 {
   // Call the const version of the function
-  return const_cast<components::BaseComponent *>(
+  auto comp = const_cast<components::BaseComponent *>(
       static_cast<const EntityComponentManager &>(
       *this).ComponentImplementation(_entity, _type));
+
+  // The caller may modify the component in place, or through
+  // SetComponentData, without marking it as changed
+  if (nullptr != comp)
+    this->dataPtr->InvalidateCachesFor(_entity, _type);
+  return comp;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::InvalidateCachesForType(
+    const ComponentTypeId _typeId)
+{
+  this->dataPtr->InvalidateCachesForType(_typeId);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::InvalidateCachesFor(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  this->dataPtr->InvalidateCachesFor(_entity, _typeId);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::StampChange(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  this->dataPtr->StampChange(_entity, _typeId);
+}
+
+/////////////////////////////////////////////////
+const uint64_t *EntityComponentManager::ComponentGeneration(
+    const ComponentTypeId _type) const
+{
+  const auto storageIter = this->dataPtr->componentStorage.find(_type);
+  if (storageIter == this->dataPtr->componentStorage.end())
+    return nullptr;
+  return storageIter->second.Generation();
+}
+
+/////////////////////////////////////////////////
+uint64_t EntityComponentManager::ComponentTypeGeneration(
+    const ComponentTypeId _typeId) const
+{
+  const auto *generation = this->ComponentGeneration(_typeId);
+  return nullptr == generation ? 0u : *generation;
 }
 
 /////////////////////////////////////////////////
@@ -1194,23 +2470,163 @@ bool EntityComponentManager::HasComponentType(
     this->dataPtr->createdCompTypes.end();
 }
 
+/////////////////////////////////////////////////
+std::size_t EntityComponentManager::ComponentCount(
+    const ComponentTypeId _typeId) const
+{
+  auto it = this->dataPtr->componentStorage.find(_typeId);
+  if (it == this->dataPtr->componentStorage.end())
+    return 0u;
+  return it->second.Size();
+}
+
 //////////////////////////////////////////////////
 const EntityGraph &EntityComponentManager::Entities() const
 {
-  return this->dataPtr->entities;
+  std::lock_guard<std::mutex> lock(this->dataPtr->graphMutex);
+  if (this->dataPtr->graphVersion == this->dataPtr->hierarchyVersion)
+    return this->dataPtr->graph;
+
+  IGN_PROFILE("EntityComponentManager::Entities");
+  auto &graph = this->dataPtr->graph;
+  graph = EntityGraph();
+  const auto entities = this->dataPtr->hierarchy.Entities();
+  for (const Entity entity : entities)
+    graph.AddVertex(std::to_string(entity), entity, entity);
+  for (const Entity entity : entities)
+  {
+    this->dataPtr->hierarchy.EachChild(entity, [&](const Entity _child)
+    {
+      graph.AddEdge({entity, _child}, true);
+    });
+  }
+  this->dataPtr->graphVersion = this->dataPtr->hierarchyVersion;
+  return graph;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::AllEntities() const
+{
+  return this->dataPtr->hierarchy.Entities();
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::Children(const Entity _parent)
+    const
+{
+  return this->dataPtr->hierarchy.Children(_parent);
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::BeginBatchCreation()
+{
+  ++this->dataPtr->batchCreationDepth;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::EndBatchCreation()
+{
+  if (this->dataPtr->batchCreationDepth == 0u)
+  {
+    ignwarn << "Called EndBatchCreation without a matching "
+            << "BeginBatchCreation." << std::endl;
+    return;
+  }
+
+  if (--this->dataPtr->batchCreationDepth > 0u)
+    return;
+
+  std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+  this->UpdateViewsForBatchedEntities();
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::UpdateViewsForBatchedEntities() const
+{
+  if (this->dataPtr->batchedEntities.empty())
+    return;
+
+  IGN_PROFILE("EntityComponentManager::UpdateViewsForBatchedEntities");
+  for (auto &viewPair : this->dataPtr->views)
+  {
+    auto &view = viewPair.second.first;
+    for (const Entity entity : this->dataPtr->batchedEntities)
+    {
+      // Filtered views may hold entities which now have an excluded
+      // component, or new optional ones
+      if (view->IsFiltered())
+        view->RemoveEntity(entity);
+
+      if (!this->EntityMatchesView(entity, *view))
+        continue;
+
+      view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
+
+      // The entity may have been requested for removal during the batch
+      if (this->IsMarkedForRemoval(entity))
+        view->MarkEntityToRemove(entity);
+    }
+  }
+
+  this->dataPtr->batchedEntities.clear();
+  this->dataPtr->batchedEntitySet.clear();
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::ReserveComponents(
+    const ComponentTypeId _typeId, const std::size_t _count)
+{
+  auto &typeStorage = this->dataPtr->componentStorage[_typeId];
+  typeStorage.Reserve(typeStorage.Size() + _count);
+}
+
+//////////////////////////////////////////////////
+std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::CachedView(
+    const std::size_t _slot) const
+{
+  // Views must see the entities created so far, even within a batch. Batches
+  // are only filled by non-const calls, so they can't grow concurrently.
+  if (!this->dataPtr->batchedEntities.empty())
+  {
+    std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+    this->UpdateViewsForBatchedEntities();
+  }
+
+  if (_slot >= kViewSlotCount)
+    return {nullptr, nullptr};
+
+  auto entry = this->dataPtr->viewSlots[_slot].load(std::memory_order_acquire);
+  if (nullptr == entry)
+    return {nullptr, nullptr};
+  return {entry->first.get(), entry->second.get()};
 }
 
 //////////////////////////////////////////////////
 std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::FindView(
     const std::vector<ComponentTypeId> &_types) const
+{
+  return this->FindView(_types, kViewSlotCount);
+}
+
+//////////////////////////////////////////////////
+std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::FindView(
+    const std::vector<ComponentTypeId> &_types, const std::size_t _slot) const
 {
   std::lock_guard<std::mutex> lockViews(this->dataPtr->viewsMutex);
+
+  // Views must see the entities created so far, even within a batch
+  this->UpdateViewsForBatchedEntities();
   std::pair<detail::BaseView *, std::mutex *> viewMutexPair(nullptr, nullptr);
   auto iter = this->dataPtr->views.find(_types);
   if (iter != this->dataPtr->views.end())
   {
     viewMutexPair.first = iter->second.first.get();
     viewMutexPair.second = iter->second.second.get();
+    if (_slot < kViewSlotCount)
+    {
+      this->dataPtr->viewSlots[_slot].store(&iter->second,
+          std::memory_order_release);
+    }
   }
   return viewMutexPair;
 }
@@ -1219,6 +2635,14 @@ std::pair<detail::BaseView *, std::mutex *> EntityComponentManager::FindView(
 detail::BaseView *EntityComponentManager::AddView(
     const detail::ComponentTypeKey &_types,
     std::unique_ptr<detail::BaseView> _view) const
+{
+  return this->AddView(_types, std::move(_view), kViewSlotCount);
+}
+
+//////////////////////////////////////////////////
+detail::BaseView *EntityComponentManager::AddView(
+    const detail::ComponentTypeKey &_types,
+    std::unique_ptr<detail::BaseView> _view, const std::size_t _slot) const
 {
   // If the view already exists, then the map will return the iterator to
   // the location that prevented the insertion.
@@ -1226,6 +2650,11 @@ detail::BaseView *EntityComponentManager::AddView(
   auto iter = this->dataPtr->views.insert(std::make_pair(_types,
         std::make_pair(std::move(_view),
           std::make_unique<std::mutex>()))).first;
+  if (_slot < kViewSlotCount)
+  {
+    this->dataPtr->viewSlots[_slot].store(&iter->second,
+        std::memory_order_release);
+  }
   return iter->second.first.get();
 }
 
@@ -1240,10 +2669,9 @@ void EntityComponentManager::RebuildViews()
 
     // Add all the entities that match the component types to the
     // view.
-    for (const auto &vertex : this->dataPtr->entities.Vertices())
+    for (const Entity entity : this->dataPtr->hierarchy.Entities())
     {
-      Entity entity = vertex.first;
-      if (this->EntityMatches(entity, view->ComponentTypes()))
+      if (this->EntityMatchesView(entity, *view))
       {
         view->MarkEntityToAdd(entity, this->IsNewEntity(entity));
 
@@ -1370,10 +2798,8 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedState &_msg,
     auto compMsg = entityMsg->add_components();
     compMsg->set_type(compBase->TypeId());
 
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
-
-    compMsg->set_component(ostr.str());
+    components::ComponentBufferSerializer::Serialize(*compBase,
+        *compMsg->mutable_component());
   }
 
   // Add a component to the message and set it to be removed if the component
@@ -1384,7 +2810,8 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedState &_msg,
 //////////////////////////////////////////////////
 void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
     Entity _entity, const std::unordered_set<ComponentTypeId> &_types,
-    bool _full) const
+    bool _full,
+    const std::function<bool(const ComponentTypeId)> &_typeFilter) const
 {
   auto iter = this->dataPtr->componentTypeIndex.find(_entity);
   if (iter == this->dataPtr->componentTypeIndex.end())
@@ -1432,6 +2859,9 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
       continue;
     }
 
+    if (_typeFilter && !_typeFilter(type))
+      continue;
+
     const components::BaseComponent *compBase =
       this->ComponentImplementation(_entity, type);
 
@@ -1488,9 +2918,9 @@ void EntityComponentManager::AddEntityToMessage(msgs::SerializedStateMap &_msg,
     }
 
     // Serialize and store the message
-    std::ostringstream ostr;
-    compBase->Serialize(ostr);
-    compIter->second.set_component(ostr.str());
+    compIter->second.clear_component();
+    components::ComponentBufferSerializer::Serialize(*compBase,
+        *compIter->second.mutable_component());
   }
 
   // Add a component to the message and set it to be removed if the component
@@ -1516,6 +2946,7 @@ ignition::msgs::SerializedState EntityComponentManager::ChangedState() const
   }
 
   // New / removed / changed components
+  this->dataPtr->SyncModifiedComponents();
   for (const auto &entity : this->dataPtr->modifiedComponents)
   {
     this->AddEntityToMessage(stateMsg, entity);
@@ -1541,12 +2972,210 @@ void EntityComponentManager::ChangedState(
   }
 
   // New / removed / changed components
+  this->dataPtr->SyncModifiedComponents();
   for (const auto &entity : this->dataPtr->modifiedComponents)
   {
     this->AddEntityToMessage(_state, entity);
   }
 }
 
+//////////////////////////////////////////////////
+void EntityComponentManager::ChangedState(
+    ignition::msgs::SerializedStateMap &_state,
+    const std::function<bool(const Entity)> &_entityFilter,
+    const std::function<bool(const ComponentTypeId)> &_typeFilter) const
+{
+  IGN_PROFILE("EntityComponentManager::ChangedState filtered");
+
+  auto add = [&](const Entity _entity)
+  {
+    if (!_entityFilter || _entityFilter(_entity))
+      this->AddEntityToMessage(_state, _entity, {}, false, _typeFilter);
+  };
+
+  // New entities
+  for (const auto &entity : this->dataPtr->newlyCreatedEntities)
+    add(entity);
+
+  // Entities being removed
+  for (const auto &entity : this->dataPtr->toRemoveEntities)
+    add(entity);
+
+  // New / removed / changed components
+  this->dataPtr->SyncModifiedComponents();
+  for (const auto &entity : this->dataPtr->modifiedComponents)
+    add(entity);
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::ChangedState(
+    ignition::msgs::SerializedStateMap &_state, uint64_t _sinceTick,
+    const std::unordered_set<Entity> &_entities,
+    const std::unordered_set<ComponentTypeId> &_types) const
+{
+  IGN_PROFILE("EntityComponentManager::ChangedState since tick");
+
+  auto included = [&_entities](const Entity _entity)
+  {
+    return _entities.empty() || _entities.find(_entity) != _entities.end();
+  };
+
+  auto entityMsg = [&_state](const Entity _entity)
+      -> msgs::SerializedEntityMap &
+  {
+    auto &ent = (*_state.mutable_entities())[static_cast<uint64_t>(_entity)];
+    ent.set_id(_entity);
+    return ent;
+  };
+
+  // Entities already removed after the tick, and entities being removed
+  for (auto historyIter =
+      this->dataPtr->removedEntityHistory.upper_bound(_sinceTick);
+      historyIter != this->dataPtr->removedEntityHistory.end(); ++historyIter)
+  {
+    for (const Entity entity : historyIter->second)
+    {
+      if (included(entity))
+        entityMsg(entity).set_remove(true);
+    }
+  }
+  for (const Entity entity : this->dataPtr->toRemoveEntities)
+  {
+    if (included(entity))
+      entityMsg(entity).set_remove(true);
+  }
+
+  // New / removed / changed components. Each storage is scanned linearly,
+  // which is cheap compared to serializing the components.
+  for (const auto &typeStorage : this->dataPtr->componentStorage)
+  {
+    const ComponentTypeId type = typeStorage.first;
+    if (!_types.empty() && _types.find(type) == _types.end())
+      continue;
+
+    const auto &storage = typeStorage.second;
+    const auto &ticks = storage.Ticks();
+    for (std::size_t i = 0; i < ticks.size(); ++i)
+    {
+      if (ticks[i] <= _sinceTick)
+        continue;
+
+      const Entity entity = storage.EntityAt(i);
+      if (!included(entity))
+        continue;
+
+      auto &compMsg = (*entityMsg(entity).mutable_components())[
+          static_cast<int64_t>(type)];
+      compMsg.set_type(type);
+
+      if (this->dataPtr->ComponentMarkedAsRemoved(entity, type))
+      {
+        compMsg.set_remove(true);
+        continue;
+      }
+
+      compMsg.clear_component();
+      components::ComponentBufferSerializer::Serialize(
+          *storage.Component(i), *compMsg.mutable_component());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+uint64_t EntityComponentManager::ChangeTick() const
+{
+  return this->dataPtr->changeTick;
+}
+
+//////////////////////////////////////////////////
+uint64_t EntityComponentManager::ComponentChangeTick(const Entity _entity,
+    const ComponentTypeId _typeId) const
+{
+  auto typeMapIter = this->dataPtr->componentTypeIndex.find(_entity);
+  if (typeMapIter == this->dataPtr->componentTypeIndex.end())
+    return 0u;
+
+  auto compIdxIter = typeMapIter->second.find(_typeId);
+  if (compIdxIter == typeMapIter->second.end())
+    return 0u;
+
+  auto storageIter = this->dataPtr->componentStorage.find(_typeId);
+  if (storageIter == this->dataPtr->componentStorage.end())
+    return 0u;
+
+  return storageIter->second.Tick(compIdxIter->second);
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::ComponentTypeChangedSince(uint64_t _tick,
+    const ComponentTypeId _typeId) const
+{
+  auto storageIter = this->dataPtr->componentStorage.find(_typeId);
+  if (storageIter == this->dataPtr->componentStorage.end())
+    return false;
+
+  const auto &ticks = storageIter->second.Ticks();
+  return std::any_of(ticks.begin(), ticks.end(), [_tick](uint64_t _t)
+  {
+    return _t > _tick;
+  });
+}
+
+//////////////////////////////////////////////////
+uint64_t EntityComponentManager::ComponentAllocationCount() const
+{
+  uint64_t count{0u};
+  for (const auto &storage : this->dataPtr->componentStorage)
+    count += storage.second.AllocationCount();
+  return count;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::AdvanceChangeTick()
+{
+  ++this->dataPtr->changeTick;
+
+  // World poses are only cached within an iteration
+  ++this->dataPtr->poseVersion;
+
+  // Forget old removals
+  if (this->dataPtr->changeTick > kRemovedEntityHistoryTicks)
+  {
+    auto &history = this->dataPtr->removedEntityHistory;
+    history.erase(history.begin(), history.lower_bound(
+        this->dataPtr->changeTick - kRemovedEntityHistoryTicks));
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::EntitiesChangedSince(
+    uint64_t _tick, const std::vector<ComponentTypeId> &_types) const
+{
+  IGN_PROFILE("EntityComponentManager::EntitiesChangedSince");
+  std::unordered_set<Entity> changed;
+  for (const ComponentTypeId type : _types)
+  {
+    auto storageIter = this->dataPtr->componentStorage.find(type);
+    if (storageIter == this->dataPtr->componentStorage.end())
+      continue;
+
+    const auto &ticks = storageIter->second.Ticks();
+    const auto &entities = storageIter->second.Entities();
+    for (std::size_t i = 0; i < ticks.size(); ++i)
+    {
+      if (ticks[i] > _tick &&
+          !this->dataPtr->ComponentMarkedAsRemoved(entities[i], type))
+      {
+        changed.insert(entities[i]);
+      }
+    }
+  }
+
+  std::vector<Entity> result(changed.begin(), changed.end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 //////////////////////////////////////////////////
 void EntityComponentManagerPrivate::CalculateStateThreadLoad()
 {
@@ -1560,9 +3189,8 @@ void EntityComponentManagerPrivate::CalculateStateThreadLoad()
   auto startIt = this->componentTypeIndex.begin();
   int numEntities = this->componentTypeIndex.size();
 
-  // Set the number of threads to spawn to the min of the calculated thread
-  // count or max threads that the hardware supports
-  int maxThreads = std::thread::hardware_concurrency();
+  // Split the entities in as many chunks as threads in the worker pool
+  int maxThreads = static_cast<int>(this->Pool().ThreadCount());
   uint64_t numThreads = std::min(numEntities, maxThreads);
 
   int entitiesPerThread = static_cast<int>(std::ceil(
@@ -1593,6 +3221,39 @@ void EntityComponentManagerPrivate::CalculateStateThreadLoad()
   }
 }
 
+//////////////////////////////////////////////////
+void EntityComponentManagerPrivate::ApplyComponentUpdates(
+    std::vector<ComponentStateUpdate> &_updates,
+    const std::function<void(const ComponentStateUpdate &)> &_markChanged)
+{
+  if (_updates.empty())
+    return;
+
+  // Every update writes to its own component, so they can be deserialized
+  // concurrently
+  if (_updates.size() >= kParallelStateUpdateThreshold)
+  {
+    IGN_PROFILE("EntityComponentManager::SetState Parallel deserialize");
+    this->Pool().ParallelFor(_updates.size(),
+        [&](std::size_t _begin, std::size_t _end)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+        components::ComponentBufferSerializer::Deserialize(
+            *_updates[i].component, *_updates[i].data);
+    }, 64u);
+  }
+  else
+  {
+    for (const auto &update : _updates)
+      components::ComponentBufferSerializer::Deserialize(*update.component,
+          *update.data);
+  }
+
+  for (const auto &update : _updates)
+    _markChanged(update);
+  _updates.clear();
+}
+
 //////////////////////////////////////////////////
 ignition::msgs::SerializedState EntityComponentManager::State(
     const std::unordered_set<Entity> &_entities,
@@ -1606,60 +3267,91 @@ ignition::msgs::SerializedState EntityComponentManager::State(
     {
       continue;
     }
-
-    this->AddEntityToMessage(stateMsg, entity, _types);
+
+    this->AddEntityToMessage(stateMsg, entity, _types);
+  }
+
+  return stateMsg;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::State(
+    msgs::SerializedStateMap  &_state,
+    const std::unordered_set<Entity> &_entities,
+    const std::unordered_set<ComponentTypeId> &_types,
+    bool _full) const
+{
+  IGN_PROFILE("EntityComponentManager::State Map");
+
+  // When only changes are requested, there's no need to go through all
+  // entities, just through the ones in the change lists
+  if (!_full)
+  {
+    std::vector<Entity> changed;
+    for (const auto &entity : this->dataPtr->ChangedEntities(_types))
+    {
+      if (_entities.empty() || _entities.find(entity) != _entities.end())
+        changed.push_back(entity);
+    }
+
+    const std::size_t numChunks = std::min<std::size_t>(changed.size(),
+        this->dataPtr->Pool().ThreadCount());
+    std::vector<msgs::SerializedStateMap> partialMaps(numChunks);
+    this->ParallelFor(numChunks, [&](std::size_t _begin, std::size_t _end)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        for (std::size_t e = i; e < changed.size(); e += numChunks)
+        {
+          this->AddEntityToMessage(partialMaps[i], changed[e], _types,
+              false);
+        }
+      }
+    });
+
+    for (auto &partialMap : partialMaps)
+    {
+      for (auto &entity : *partialMap.mutable_entities())
+      {
+        (*_state.mutable_entities())[entity.first].Swap(&entity.second);
+      }
+    }
+    return;
   }
 
-  return stateMsg;
-}
-
-//////////////////////////////////////////////////
-void EntityComponentManager::State(
-    msgs::SerializedStateMap  &_state,
-    const std::unordered_set<Entity> &_entities,
-    const std::unordered_set<ComponentTypeId> &_types,
-    bool _full) const
-{
-  std::mutex stateMapMutex;
-  std::vector<std::thread> workers;
-
   this->dataPtr->CalculateStateThreadLoad();
 
-  auto functor = [&](auto itStart, auto itEnd)
+  // Each chunk of entities is serialized into its own partial map, so the
+  // workers never write to shared data
+  const std::size_t numChunks =
+      this->dataPtr->componentTypeIndexIterators.size() - 1;
+  std::vector<msgs::SerializedStateMap> partialMaps(numChunks);
+
+  this->ParallelFor(numChunks, [&](std::size_t _begin, std::size_t _end)
   {
-    msgs::SerializedStateMap threadMap;
-    while (itStart != itEnd)
+    for (std::size_t i = _begin; i < _end; ++i)
     {
-      auto entity = (*itStart).first;
-      if (_entities.empty() || _entities.find(entity) != _entities.end())
+      auto itStart = this->dataPtr->componentTypeIndexIterators[i];
+      auto itEnd = this->dataPtr->componentTypeIndexIterators[i + 1];
+      for (; itStart != itEnd; ++itStart)
       {
-        this->AddEntityToMessage(threadMap, entity, _types, _full);
+        auto entity = itStart->first;
+        if (_entities.empty() || _entities.find(entity) != _entities.end())
+        {
+          this->AddEntityToMessage(partialMaps[i], entity, _types, _full);
+        }
       }
-      itStart++;
     }
-    std::lock_guard<std::mutex> lock(stateMapMutex);
+  });
 
-    for (const auto &entity : threadMap.entities())
+  // Stitch the partial maps together. Entities are unique across chunks.
+  for (auto &partialMap : partialMaps)
+  {
+    for (auto &entity : *partialMap.mutable_entities())
     {
-      (*_state.mutable_entities())[static_cast<uint64_t>(entity.first)] =
-          entity.second;
+      (*_state.mutable_entities())[entity.first].Swap(&entity.second);
     }
-  };
-
-  // Spawn workers
-  uint64_t numThreads = this->dataPtr->componentTypeIndexIterators.size() - 1;
-  for (uint64_t i = 0; i < numThreads; i++)
-  {
-    workers.push_back(std::thread(functor,
-        this->dataPtr->componentTypeIndexIterators[i],
-        this->dataPtr->componentTypeIndexIterators[i+1]));
   }
-
-  // Wait for each thread to finish processing its components
-  std::for_each(workers.begin(), workers.end(), [](std::thread &_t)
-  {
-    _t.join();
-  });
 }
 
 //////////////////////////////////////////////////
@@ -1667,6 +3359,35 @@ void EntityComponentManager::SetState(
     const ignition::msgs::SerializedState &_stateMsg)
 {
   IGN_PROFILE("EntityComponentManager::SetState Non-map");
+
+  // Match new entities and components against the views once the whole
+  // state has been applied, instead of once per component
+  this->BeginBatchCreation();
+
+  // Existing components are deserialized in place, all at once. The same
+  // component may be listed more than once, so pending updates are applied
+  // before the component is touched again, to keep the message order.
+  std::vector<ComponentStateUpdate> updates;
+  updates.reserve(_stateMsg.entities_size());
+  auto markChanged = [this](const ComponentStateUpdate &_update)
+  {
+    this->dataPtr->StampChange(_update.entity, _update.type);
+    this->dataPtr->AddModifiedComponent(_update.entity);
+  };
+  std::unordered_set<Entity> visited;
+  auto isPending = [&updates](const Entity _entity,
+      const ComponentTypeId _type)
+  {
+    // Updates of the current entity are at the back
+    for (auto it = updates.rbegin();
+        it != updates.rend() && it->entity == _entity; ++it)
+    {
+      if (it->type == _type)
+        return true;
+    }
+    return false;
+  };
+
   // Create / remove / update entities
   for (int e = 0; e < _stateMsg.entities_size(); ++e)
   {
@@ -1674,6 +3395,10 @@ void EntityComponentManager::SetState(
 
     Entity entity{entityMsg.id()};
 
+    // An entity listed twice may update the same component twice
+    if (!visited.insert(entity).second)
+      this->dataPtr->ApplyComponentUpdates(updates, markChanged);
+
     // Remove entity
     if (entityMsg.remove())
     {
@@ -1716,6 +3441,9 @@ void EntityComponentManager::SetState(
         continue;
       }
 
+      if (isPending(entity, type))
+        this->dataPtr->ApplyComponentUpdates(updates, markChanged);
+
       // Remove component
       if (compMsg.remove())
       {
@@ -1726,8 +3454,6 @@ void EntityComponentManager::SetState(
       // Get Component
       auto comp = this->ComponentImplementation(entity, type);
 
-      std::istringstream istr(compMsg.component());
-
       // Create if new
       if (nullptr == comp)
       {
@@ -1738,17 +3464,20 @@ void EntityComponentManager::SetState(
             << compMsg.type() << "]" << std::endl;
           continue;
         }
-        newComp->Deserialize(istr);
+        components::ComponentBufferSerializer::Deserialize(*newComp,
+            compMsg.component());
         this->CreateComponentImplementation(entity, type, newComp.get());
       }
       // Update component value
       else
       {
-        comp->Deserialize(istr);
-        this->dataPtr->AddModifiedComponent(entity);
+        updates.push_back({entity, type, comp, &compMsg.component()});
       }
     }
   }
+
+  this->dataPtr->ApplyComponentUpdates(updates, markChanged);
+  this->EndBatchCreation();
 }
 
 //////////////////////////////////////////////////
@@ -1756,6 +3485,24 @@ void EntityComponentManager::SetState(
     const ignition::msgs::SerializedStateMap &_stateMsg)
 {
   IGN_PROFILE("EntityComponentManager::SetState Map");
+
+  // Match new entities and components against the views once the whole
+  // state has been applied, instead of once per component
+  this->BeginBatchCreation();
+
+  // Existing components are deserialized in place, all at once. Entities and
+  // component types are unique in the map, so every update targets a
+  // different component.
+  std::vector<ComponentStateUpdate> updates;
+  updates.reserve(_stateMsg.entities_size());
+  const ComponentState changeState =
+      _stateMsg.has_one_time_component_changes() ?
+      ComponentState::OneTimeChange : ComponentState::PeriodicChange;
+  auto markChanged = [&](const ComponentStateUpdate &_update)
+  {
+    this->SetChanged(_update.entity, _update.type, changeState);
+  };
+
   // Create / remove / update entities
   for (const auto &iter : _stateMsg.entities())
   {
@@ -1809,8 +3556,6 @@ void EntityComponentManager::SetState(
       components::BaseComponent *comp =
         this->ComponentImplementation(entity, compIter.first);
 
-      std::istringstream istr(compMsg.component());
-
       // Create if new
       if (nullptr == comp)
       {
@@ -1824,7 +3569,8 @@ void EntityComponentManager::SetState(
           continue;
         }
 
-        newComp->Deserialize(istr);
+        components::ComponentBufferSerializer::Deserialize(*newComp,
+            compMsg.component());
 
         this->CreateComponentImplementation(entity,
             newComp->TypeId(), newComp.get());
@@ -1832,47 +3578,210 @@ void EntityComponentManager::SetState(
       // Update component value
       else
       {
-        comp->Deserialize(istr);
-        this->SetChanged(entity, compIter.first,
-            _stateMsg.has_one_time_component_changes() ?
-            ComponentState::OneTimeChange :
-            ComponentState::PeriodicChange);
+        updates.push_back({entity, compIter.first, comp,
+            &compMsg.component()});
       }
     }
   }
+
+  this->dataPtr->ApplyComponentUpdates(updates, markChanged);
+  this->EndBatchCreation();
 }
 
 //////////////////////////////////////////////////
 std::unordered_set<Entity> EntityComponentManager::Descendants(Entity _entity)
     const
 {
-  // Check cache
-  if (this->dataPtr->descendantCache.find(_entity) !=
-      this->dataPtr->descendantCache.end())
-  {
-    return this->dataPtr->descendantCache[_entity];
-  }
-
   std::unordered_set<Entity> descendants;
 
   if (!this->HasEntity(_entity))
     return descendants;
 
-  auto descVector = math::graph::BreadthFirstSort(this->dataPtr->entities,
-      _entity);
-  std::move(descVector.begin(), descVector.end(), std::inserter(descendants,
-      descendants.end()));
+  std::lock_guard<std::mutex> lock(this->dataPtr->hierarchyMutex);
+  this->dataPtr->UpdateDescendantSpans();
+
+  auto spanIt = this->dataPtr->descendantSpans.find(_entity);
+  if (spanIt != this->dataPtr->descendantSpans.end())
+  {
+    const auto &order = this->dataPtr->descendantOrder;
+    descendants.insert(order.begin() + spanIt->second.first,
+        order.begin() + spanIt->second.second);
+    return descendants;
+  }
 
-  this->dataPtr->descendantCache[_entity] = descendants;
+  // Entities in a cycle have no root, so they aren't in the spans
+  auto descVector = this->dataPtr->hierarchy.Subtree(_entity);
+  descendants.insert(descVector.begin(), descVector.end());
   return descendants;
 }
 
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::EntitiesByName(
+    const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->nameIndexMutex);
+  this->RefreshNameIndex();
+
+  auto indexIter = this->dataPtr->nameIndex.find(_name);
+  if (indexIter == this->dataPtr->nameIndex.end())
+    return {};
+  return indexIter->second;
+}
+
+//////////////////////////////////////////////////
+void EntityComponentManager::RefreshNameIndex() const
+{
+  if (this->dataPtr->nameIndexStale)
+  {
+    auto storageIter =
+        this->dataPtr->componentStorage.find(components::Name::typeId);
+    if (storageIter != this->dataPtr->componentStorage.end())
+    {
+      const auto &named = storageIter->second.Entities();
+      this->dataPtr->nameIndexDirty.insert(named.begin(), named.end());
+    }
+    this->dataPtr->nameIndexStale = false;
+  }
+
+  if (this->dataPtr->nameIndexDirty.empty())
+    return;
+
+  IGN_PROFILE("EntityComponentManager::RefreshNameIndex");
+  for (const Entity entity : this->dataPtr->nameIndexDirty)
+  {
+    this->dataPtr->UnindexName(entity);
+
+    auto nameComp = this->Component<components::Name>(entity);
+    if (nullptr == nameComp)
+      continue;
+
+    auto &entities = this->dataPtr->nameIndex[nameComp->Data()];
+    entities.insert(std::lower_bound(entities.begin(), entities.end(),
+        entity), entity);
+    this->dataPtr->indexedNames[entity] = nameComp->Data();
+  }
+  this->dataPtr->nameIndexDirty.clear();
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentManager::IndexedEntities(
+    const components::BaseComponent &_component,
+    std::vector<Entity> &_entities) const
+{
+  if (_component.TypeId() != components::Name::typeId)
+    return false;
+
+  _entities = this->EntitiesByName(
+      static_cast<const components::Name &>(_component).Data());
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityComponentManager::Ancestors(
+    const Entity _entity) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->hierarchyMutex);
+  return this->AncestorsUnlocked(_entity);
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &EntityComponentManager::AncestorsUnlocked(
+    const Entity _entity) const
+{
+  auto &cached = this->dataPtr->ancestorCache[_entity];
+  if (cached.first == this->dataPtr->hierarchyVersion)
+    return cached.second;
+
+  cached.first = this->dataPtr->hierarchyVersion;
+  cached.second.clear();
+
+  // A chain can't be longer than the number of entities, unless there's a
+  // cycle
+  const std::size_t maxLength = this->dataPtr->componentTypeIndex.size();
+  auto parentComp = this->Component<components::ParentEntity>(_entity);
+  while (nullptr != parentComp && parentComp->Data() != kNullEntity &&
+         cached.second.size() < maxLength)
+  {
+    cached.second.push_back(parentComp->Data());
+    parentComp = this->Component<components::ParentEntity>(parentComp->Data());
+  }
+
+  return cached.second;
+}
+
+//////////////////////////////////////////////////
+math::Pose3d EntityComponentManager::WorldPose(const Entity _entity) const
+{
+  auto poseComp = this->Component<components::Pose>(_entity);
+  if (nullptr == poseComp)
+  {
+    ignwarn << "Trying to get world pose from entity [" << _entity
+            << "], which doesn't have a pose component" << std::endl;
+    return math::Pose3d();
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->hierarchyMutex);
+  const uint64_t version = this->dataPtr->poseVersion;
+  auto &cache = this->dataPtr->worldPoseCache;
+
+  auto cacheIt = cache.find(_entity);
+  if (cacheIt != cache.end() && cacheIt->second.first == version)
+    return cacheIt->second.second;
+
+  // Walk up until an ancestor whose world pose is known, or one without a
+  // pose, and then compute the world poses of the chain top down, so that
+  // siblings reuse them
+  std::vector<const components::Pose *> chain{poseComp};
+  std::vector<Entity> chainEntities{_entity};
+  math::Pose3d pose;
+  for (const Entity ancestor : this->AncestorsUnlocked(_entity))
+  {
+    auto ancestorIt = cache.find(ancestor);
+    if (ancestorIt != cache.end() && ancestorIt->second.first == version)
+    {
+      pose = ancestorIt->second.second;
+      break;
+    }
+
+    auto ancestorPose = this->Component<components::Pose>(ancestor);
+    if (nullptr == ancestorPose)
+      break;
+
+    chain.push_back(ancestorPose);
+    chainEntities.push_back(ancestor);
+  }
+
+  for (std::size_t i = chain.size(); i > 0u; --i)
+  {
+    pose = pose * chain[i - 1]->Data();
+    cache[chainEntities[i - 1]] = {version, pose};
+  }
+
+  return pose;
+}
+
 //////////////////////////////////////////////////
 void EntityComponentManager::SetAllComponentsUnchanged()
 {
   this->dataPtr->periodicChangedComponents.clear();
   this->dataPtr->oneTimeChangedComponents.clear();
+
+  auto clearFlag = [this](const Entity _entity)
+  {
+    if (auto *flag = this->dataPtr->ModifiedFlag(_entity))
+      flag->store(false, std::memory_order_relaxed);
+  };
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->modifiedListsMutex);
+  for (const Entity entity : this->dataPtr->modifiedComponents)
+    clearFlag(entity);
   this->dataPtr->modifiedComponents.clear();
+  for (auto &list : this->dataPtr->modifiedLists)
+  {
+    for (const Entity entity : *list)
+      clearFlag(entity);
+    list->clear();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -1890,34 +3799,40 @@ void EntityComponentManager::SetChanged(
       this->dataPtr->ComponentMarkedAsRemoved(_entity, _type))
     return;
 
-  if (_c == ComponentState::PeriodicChange)
   {
-    this->dataPtr->periodicChangedComponents[_type].insert(_entity);
-    auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(_type);
-    if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end())
-      oneTimeIter->second.erase(_entity);
-  }
-  else if (_c == ComponentState::OneTimeChange)
-  {
-    auto periodicIter = this->dataPtr->periodicChangedComponents.find(_type);
-    if (periodicIter != this->dataPtr->periodicChangedComponents.end())
-      periodicIter->second.erase(_entity);
-    this->dataPtr->oneTimeChangedComponents[_type].insert(_entity);
-  }
-  else
-  {
-    auto periodicIter = this->dataPtr->periodicChangedComponents.find(_type);
-    if (periodicIter != this->dataPtr->periodicChangedComponents.end())
-      periodicIter->second.erase(_entity);
-    auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(_type);
-    if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end())
-      oneTimeIter->second.erase(_entity);
+    std::lock_guard<std::mutex> lock(this->dataPtr->changedComponentsMutex);
+    if (_c == ComponentState::PeriodicChange)
+    {
+      this->dataPtr->periodicChangedComponents[_type].insert(_entity);
+      auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(_type);
+      if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end())
+        oneTimeIter->second.erase(_entity);
+    }
+    else if (_c == ComponentState::OneTimeChange)
+    {
+      auto periodicIter = this->dataPtr->periodicChangedComponents.find(_type);
+      if (periodicIter != this->dataPtr->periodicChangedComponents.end())
+        periodicIter->second.erase(_entity);
+      this->dataPtr->oneTimeChangedComponents[_type].insert(_entity);
+    }
+    else
+    {
+      auto periodicIter = this->dataPtr->periodicChangedComponents.find(_type);
+      if (periodicIter != this->dataPtr->periodicChangedComponents.end())
+        periodicIter->second.erase(_entity);
+      auto oneTimeIter = this->dataPtr->oneTimeChangedComponents.find(_type);
+      if (oneTimeIter != this->dataPtr->oneTimeChangedComponents.end())
+        oneTimeIter->second.erase(_entity);
+
+      // the component state is flagged as no change, so don't mark the
+      // corresponding entity as one with a modified component
+      return;
+    }
 
-    // the component state is flagged as no change, so don't mark the
-    // corresponding entity as one with a modified component
-    return;
+    this->dataPtr->StampChange(_entity, _type);
   }
 
+  // Recording the entity doesn't need the lock
   this->dataPtr->AddModifiedComponent(_entity);
 }
 
@@ -1964,20 +3879,286 @@ bool EntityComponentManager::LockAddingEntitiesToViews() const
   return this->dataPtr->lockAddEntitiesToViews;
 }
 
+/////////////////////////////////////////////////
+std::atomic<bool> *EntityComponentManagerPrivate::ModifiedFlag(
+    const Entity _entity)
+{
+  const auto index = this->hierarchy.IndexOf(_entity).index;
+  if (index >= this->modifiedFlags.size())
+    return nullptr;
+  return &this->modifiedFlags[index];
+}
+
 /////////////////////////////////////////////////
 void EntityComponentManagerPrivate::AddModifiedComponent(const Entity &_entity)
 {
-  if (this->newlyCreatedEntities.find(_entity)
-        != this->newlyCreatedEntities.end() ||
-      this->toRemoveEntities.find(_entity) != this->toRemoveEntities.end() ||
-      this->modifiedComponents.find(_entity) != this->modifiedComponents.end())
+  // Entities are only recorded once. Flags are only missing for entities
+  // that were never created, which are recorded as well, as before.
+  auto *flag = this->ModifiedFlag(_entity);
+  if (nullptr != flag && flag->exchange(true, std::memory_order_relaxed))
+    return;
+
+  this->ModifiedList().push_back(_entity);
+}
+
+/////////////////////////////////////////////////
+std::vector<Entity> &EntityComponentManagerPrivate::ModifiedList()
+{
+  // Threads usually keep working with the same manager, so the last list
+  // is cached to avoid locking
+  thread_local uint64_t cachedManager{0u};
+  thread_local std::vector<Entity> *cachedList{nullptr};
+  if (cachedManager == this->managerId)
+    return *cachedList;
+
+  std::lock_guard<std::mutex> lock(this->modifiedListsMutex);
+  auto &list = this->modifiedListsByThread[std::this_thread::get_id()];
+  if (nullptr == list)
+  {
+    this->modifiedLists.push_back(std::make_unique<std::vector<Entity>>());
+    list = this->modifiedLists.back().get();
+  }
+  cachedManager = this->managerId;
+  cachedList = list;
+  return *list;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::SyncModifiedComponents()
+{
+  std::lock_guard<std::mutex> lock(this->modifiedListsMutex);
+  for (auto &list : this->modifiedLists)
+  {
+    for (const Entity entity : *list)
+    {
+      if (this->newlyCreatedEntities.find(entity) !=
+            this->newlyCreatedEntities.end() ||
+          this->toRemoveEntities.find(entity) != this->toRemoveEntities.end())
+      {
+        // The entity is already reported as new or removed, so it can be
+        // recorded again once it isn't anymore
+        if (auto *flag = this->ModifiedFlag(entity))
+          flag->store(false, std::memory_order_relaxed);
+        continue;
+      }
+      this->modifiedComponents.insert(entity);
+    }
+    list->clear();
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::DestroyEntityComponents(
+    const Entity _entity)
+{
+  auto typeMapIter = this->componentTypeIndex.find(_entity);
+  if (typeMapIter == this->componentTypeIndex.end())
+    return;
+
+  for (const auto &[typeId, index] : typeMapIter->second)
+  {
+    auto storageIter = this->componentStorage.find(typeId);
+    if (storageIter == this->componentStorage.end())
+      continue;
+
+    // The last component of the storage was moved into the freed slot, so
+    // its owner needs to point to the new index
+    const Entity moved = storageIter->second.Remove(index);
+    if (kNullEntity != moved)
+      this->componentTypeIndex[moved][typeId] = index;
+  }
+}
+
+/////////////////////////////////////////////////
+std::unordered_set<Entity> EntityComponentManagerPrivate::ChangedEntities(
+    const std::unordered_set<ComponentTypeId> &_types) const
+{
+  std::unordered_set<Entity> result(this->toRemoveEntities);
+
+  auto addChanged = [&](const std::unordered_map<ComponentTypeId,
+      std::unordered_set<Entity>> &_changed)
+  {
+    if (_types.empty())
+    {
+      for (const auto &typeEntities : _changed)
+        result.insert(typeEntities.second.begin(), typeEntities.second.end());
+      return;
+    }
+
+    for (const auto &type : _types)
+    {
+      auto iter = _changed.find(type);
+      if (iter != _changed.end())
+        result.insert(iter->second.begin(), iter->second.end());
+    }
+  };
+  addChanged(this->oneTimeChangedComponents);
+  addChanged(this->periodicChangedComponents);
+
+  std::lock_guard<std::mutex> lock(this->removedComponentsMutex);
+  for (const auto &removed : this->removedComponents)
+    result.insert(removed.first);
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::StampChange(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  this->InvalidateCachesFor(_entity, _typeId);
+
+  auto typeMapIter = this->componentTypeIndex.find(_entity);
+  if (typeMapIter == this->componentTypeIndex.end())
+    return;
+
+  auto compIdxIter = typeMapIter->second.find(_typeId);
+  if (compIdxIter == typeMapIter->second.end())
+    return;
+
+  auto storageIter = this->componentStorage.find(_typeId);
+  if (storageIter != this->componentStorage.end())
+    storageIter->second.SetTick(compIdxIter->second, this->changeTick);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::InvalidateHierarchy()
+{
+  ++this->hierarchyVersion;
+  ++this->poseVersion;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::InvalidateCachesFor(const Entity _entity,
+    const ComponentTypeId _typeId)
+{
+  if (_typeId == components::ParentEntity::typeId)
+  {
+    this->InvalidateHierarchy();
+  }
+  else if (_typeId == components::Pose::typeId)
+  {
+    ++this->poseVersion;
+  }
+  else if (_typeId == components::Name::typeId)
+  {
+    std::lock_guard<std::mutex> lock(this->nameIndexMutex);
+    this->nameIndexDirty.insert(_entity);
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::InvalidateCachesForType(
+    const ComponentTypeId _typeId)
+{
+  if (_typeId == components::ParentEntity::typeId)
+  {
+    this->InvalidateHierarchy();
+  }
+  else if (_typeId == components::Pose::typeId)
+  {
+    ++this->poseVersion;
+  }
+  else if (_typeId == components::Name::typeId)
+  {
+    std::lock_guard<std::mutex> lock(this->nameIndexMutex);
+    this->nameIndexStale = true;
+  }
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::UnindexName(const Entity _entity) const
+{
+  auto nameIter = this->indexedNames.find(_entity);
+  if (nameIter == this->indexedNames.end())
+    return;
+
+  auto indexIter = this->nameIndex.find(nameIter->second);
+  if (indexIter != this->nameIndex.end())
   {
-    // modified component is already in newlyCreatedEntities
-    // or toRemoveEntities list
+    auto &entities = indexIter->second;
+    auto it = std::lower_bound(entities.begin(), entities.end(), _entity);
+    if (it != entities.end() && *it == _entity)
+      entities.erase(it);
+    if (entities.empty())
+      this->nameIndex.erase(indexIter);
+  }
+  this->indexedNames.erase(nameIter);
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManagerPrivate::UpdateDescendantSpans() const
+{
+  if (this->descendantSpansVersion == this->hierarchyVersion)
     return;
+
+  IGN_PROFILE("EntityComponentManager::UpdateDescendantSpans");
+  this->descendantOrder.clear();
+  this->descendantSpans.clear();
+
+  this->descendantOrder.reserve(this->hierarchy.Size());
+
+  // Iterative depth first traversal from the roots, which are the entities
+  // without a parent. The second element is true when all descendants of the
+  // entity have been visited.
+  std::vector<std::pair<Entity, bool>> stack;
+  for (const Entity root : this->hierarchy.Roots())
+  {
+    stack.push_back({root, false});
+    while (!stack.empty())
+    {
+      const auto [entity, done] = stack.back();
+      stack.pop_back();
+      if (done)
+      {
+        this->descendantSpans[entity].second = this->descendantOrder.size();
+        continue;
+      }
+
+      if (this->descendantSpans.find(entity) != this->descendantSpans.end())
+        continue;
+
+      this->descendantSpans[entity] = {this->descendantOrder.size(), 0u};
+      this->descendantOrder.push_back(entity);
+      stack.push_back({entity, true});
+      this->hierarchy.EachChild(entity, [&](const Entity _child)
+      {
+        if (this->descendantSpans.find(_child) ==
+            this->descendantSpans.end())
+        {
+          stack.push_back({_child, false});
+        }
+      });
+    }
   }
 
-  this->modifiedComponents.insert(_entity);
+  this->descendantSpansVersion = this->hierarchyVersion;
+}
+
+/////////////////////////////////////////////////
+ThreadPool &EntityComponentManagerPrivate::Pool()
+{
+  std::lock_guard<std::mutex> lock(this->poolMutex);
+  if (!this->pool)
+    this->pool = std::make_shared<ThreadPool>();
+  return *this->pool;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::SetThreadPool(
+    const std::shared_ptr<ThreadPool> &_pool)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->poolMutex);
+  this->dataPtr->pool = _pool;
+}
+
+/////////////////////////////////////////////////
+void EntityComponentManager::ParallelFor(std::size_t _count,
+    const std::function<void(std::size_t, std::size_t)> &_func,
+    std::size_t _minChunkSize) const
+{
+  IGN_PROFILE("EntityComponentManager::ParallelFor");
+  this->dataPtr->Pool().ParallelFor(_count, _func, _minChunkSize);
 }
 
 /////////////////////////////////////////////////
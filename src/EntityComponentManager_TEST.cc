@@ -17,6 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/math/Pose3.hh>
@@ -24,16 +31,21 @@
 #include <ignition/utilities/ExtraTestMacros.hh>
 #include <ignition/utils/SuppressWarning.hh>
 
+#include "ignition/gazebo/components/AxisAlignedBox.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/ChildLinkName.hh"
 #include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Joint.hh"
 #include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/ParentLinkName.hh"
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EntityComponentSnapshot.hh"
+#include "ignition/gazebo/SpatialIndex.hh"
+#include "ignition/gazebo/Util.hh"
 #include "ignition/gazebo/config.hh"
 #include "../test/helpers/EnvTestFixture.hh"
 
@@ -106,6 +118,18 @@ class EntityCompMgrTest : public EntityComponentManager
   {
     this->ClearRemovedComponents();
   }
+  public: void RunAdvanceChangeTick()
+  {
+    this->AdvanceChangeTick();
+  }
+  public: void RunApplyDeferredCommands()
+  {
+    this->ApplyDeferredCommands();
+  }
+  public: void RunUpdateSpatialIndex()
+  {
+    this->UpdateSpatialIndex();
+  }
 };
 
 class EntityComponentManagerFixture
@@ -1560,6 +1584,24 @@ TEST_P(EntityComponentManagerFixture,
    *   4   6     5
    */
 
+  // Immediate children, sorted by id
+  EXPECT_EQ((std::vector<Entity>{e2, e3}), manager.Children(e1));
+  EXPECT_EQ((std::vector<Entity>{e4, e6}), manager.Children(e2));
+  EXPECT_EQ((std::vector<Entity>{e5}), manager.Children(e3));
+  EXPECT_TRUE(manager.Children(e7).empty());
+  EXPECT_TRUE(manager.Children(gazebo::Entity(1000)).empty());
+  EXPECT_EQ((std::vector<Entity>{e1, e2, e3, e4, e5, e6, e7}),
+      manager.AllEntities());
+
+  // The graph follows the hierarchy
+  {
+    const auto &graph = manager.Entities();
+    EXPECT_EQ(7u, graph.Vertices().size());
+    EXPECT_EQ(5u, graph.Edges().size());
+    EXPECT_EQ(2u, graph.AdjacentsFrom(e2).size());
+    EXPECT_EQ(1u, graph.AdjacentsTo(e5).count(e3));
+  }
+
   // Add components
   auto comp1 = manager.CreateComponent<Even>(e2, {});
   ASSERT_NE(nullptr, comp1);
@@ -2204,6 +2246,601 @@ TEST_P(EntityComponentManagerFixture, Descendants)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CachedViewsAfterRemoveAll)
+{
+  auto count = [&]()
+  {
+    int result{0};
+    manager.Each<IntComponent>([&](const Entity &, const IntComponent *)
+        {
+          ++result;
+          return true;
+        });
+    return result;
+  };
+
+  manager.CreateComponent(manager.CreateEntity(), IntComponent(1));
+  manager.CreateComponent(manager.CreateEntity(), IntComponent(2));
+  EXPECT_EQ(2, count());
+  EXPECT_EQ(2, count());
+
+  // Removing all entities clears the views, and queries must not use the
+  // views they had cached
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0, count());
+
+  manager.CreateComponent(manager.CreateEntity(), IntComponent(3));
+  EXPECT_EQ(1, count());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, MemoryStats)
+{
+  auto empty = manager.MemoryStats();
+  EXPECT_EQ(0u, empty.entityCount);
+  EXPECT_TRUE(empty.components.empty());
+  EXPECT_EQ(0u, empty.viewCount);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    if (i % 2 == 0)
+      manager.CreateComponent(entity, DoubleComponent(i));
+  }
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *)
+      {
+        return true;
+      });
+
+  auto stats = manager.MemoryStats();
+  EXPECT_EQ(10u, stats.entityCount);
+  ASSERT_EQ(2u, stats.components.size());
+  EXPECT_EQ(1u, stats.viewCount);
+  EXPECT_EQ(10u, stats.viewEntityCount);
+  EXPECT_GT(stats.viewBytes, 0u);
+  EXPECT_GT(stats.graphBytes, 0u);
+  EXPECT_GT(stats.indexBytes, 0u);
+
+  // Sorted by size, and each type is at least as large as its instances
+  EXPECT_GE(stats.components[0].bytes, stats.components[1].bytes);
+  uint64_t componentBytes{0u};
+  for (const auto &comp : stats.components)
+  {
+    if (comp.typeId == DoubleComponent::typeId)
+    {
+      EXPECT_EQ(5u, comp.count);
+      EXPECT_EQ("ign_gazebo_components.DoubleComponent", comp.name);
+      EXPECT_GE(comp.bytes, 5u * sizeof(DoubleComponent));
+    }
+    else
+    {
+      EXPECT_EQ(IntComponent::typeId, comp.typeId);
+      EXPECT_EQ(10u, comp.count);
+      EXPECT_GE(comp.bytes, 10u * sizeof(IntComponent));
+    }
+    componentBytes += comp.bytes;
+  }
+  EXPECT_EQ(componentBytes, stats.componentBytes);
+  EXPECT_EQ(stats.componentBytes + stats.viewBytes + stats.graphBytes +
+      stats.indexBytes + stats.cacheBytes, stats.totalBytes);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, Compact)
+{
+  std::vector<Entity> entities;
+  for (int i = 0; i < 4000; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    manager.CreateComponent(entity, DoubleComponent(i));
+    entities.push_back(entity);
+  }
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *)
+      {
+        return true;
+      });
+  const auto peak = manager.MemoryStats();
+  EXPECT_EQ(0u, peak.reclaimedBytes);
+
+  // Removing most entities compacts the manager automatically
+  for (std::size_t i = 100u; i < entities.size(); ++i)
+    manager.RequestRemoveEntity(entities[i]);
+  manager.ProcessRemoveEntityRequests();
+
+  auto stats = manager.MemoryStats();
+  EXPECT_EQ(100u, stats.entityCount);
+  EXPECT_GT(stats.reclaimedBytes, 0u);
+  EXPECT_LT(stats.totalBytes, peak.totalBytes);
+
+  // Remaining entities and views are intact
+  int count{0};
+  manager.Each<IntComponent, DoubleComponent>([&](const Entity &_entity,
+      const IntComponent *_int, const DoubleComponent *_double)
+      {
+        EXPECT_EQ(entities[_int->Data()], _entity);
+        EXPECT_DOUBLE_EQ(_int->Data(), _double->Data());
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(100, count);
+
+  // Nothing left to reclaim
+  EXPECT_EQ(0u, manager.Compact());
+  EXPECT_EQ(stats.reclaimedBytes, manager.MemoryStats().reclaimedBytes);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, Snapshot)
+{
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e1, DoubleComponent(1.5));
+  manager.CreateComponent(e2, IntComponent(2));
+
+  auto first = manager.Snapshot();
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(manager.ChangeTick(), first->ChangeTick());
+  EXPECT_EQ(3u, first->ComponentCount());
+  EXPECT_EQ(3u, first->CopiedComponentCount());
+  EXPECT_EQ(std::vector<Entity>({e1, e2}), first->Entities());
+  EXPECT_EQ(std::vector<Entity>({e1, e2}),
+      first->EntitiesWithComponent(IntComponent::typeId));
+  EXPECT_EQ(1, first->ComponentData<IntComponent>(e1));
+  EXPECT_EQ(nullptr, first->Component<DoubleComponent>(e2));
+
+  // Only the changed component is copied, and older snapshots keep their
+  // data
+  manager.RunAdvanceChangeTick();
+  manager.SetComponentData<IntComponent>(e1, 10);
+  manager.SetChanged(e1, IntComponent::typeId);
+
+  auto second = manager.Snapshot();
+  EXPECT_EQ(3u, second->ComponentCount());
+  EXPECT_EQ(1u, second->CopiedComponentCount());
+  EXPECT_EQ(10, second->ComponentData<IntComponent>(e1));
+  EXPECT_EQ(1, first->ComponentData<IntComponent>(e1));
+  EXPECT_EQ(first->Component<IntComponent>(e2),
+      second->Component<IntComponent>(e2));
+  EXPECT_EQ(first->Component<DoubleComponent>(e1),
+      second->Component<DoubleComponent>(e1));
+  EXPECT_EQ(&first->Entities(), &second->Entities());
+
+  // Removals are reflected without copying anything
+  manager.RunAdvanceChangeTick();
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+
+  auto third = manager.Snapshot();
+  EXPECT_EQ(0u, third->CopiedComponentCount());
+  EXPECT_EQ(2u, third->ComponentCount());
+  EXPECT_FALSE(third->HasEntity(e2));
+  EXPECT_TRUE(second->HasEntity(e2));
+  EXPECT_EQ(nullptr, third->Component<IntComponent>(e2));
+
+  int count{0};
+  third->Each<IntComponent, DoubleComponent>(
+      [&](const Entity &_entity, const IntComponent *_int,
+          const DoubleComponent *_double)
+      {
+        EXPECT_EQ(e1, _entity);
+        EXPECT_EQ(10, _int->Data());
+        EXPECT_DOUBLE_EQ(1.5, _double->Data());
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(1, count);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, SnapshotState)
+{
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e1, DoubleComponent(1.5));
+  manager.CreateComponent(e2, StringComponent("two"));
+  manager.CreateComponent(e3, IntComponent(3));
+
+  msgs::SerializedStateMap fullMsg;
+  manager.State(fullMsg, {}, {}, true);
+  auto snapshot = manager.Snapshot();
+
+  // Serializing the snapshot in chunks gives the same result as the manager
+  msgs::SerializedStateMap chunkMsg;
+  snapshot->State(chunkMsg, 0, 2);
+  ASSERT_EQ(2, chunkMsg.entities_size());
+  EXPECT_EQ(0u, chunkMsg.entities().count(e3));
+  snapshot->State(chunkMsg, 2, 100);
+  ASSERT_EQ(3, chunkMsg.entities_size());
+
+  for (const auto &entity : fullMsg.entities())
+  {
+    const auto &chunkEntity = chunkMsg.entities().at(entity.first);
+    EXPECT_EQ(entity.second.id(), chunkEntity.id());
+    ASSERT_EQ(entity.second.components_size(),
+        chunkEntity.components_size());
+    for (const auto &comp : entity.second.components())
+    {
+      const auto &chunkComp = chunkEntity.components().at(comp.first);
+      EXPECT_EQ(comp.second.type(), chunkComp.type());
+      EXPECT_EQ(comp.second.component(), chunkComp.component());
+    }
+  }
+
+  // Empty ranges don't add anything
+  msgs::SerializedStateMap emptyMsg;
+  snapshot->State(emptyMsg, 3, 5);
+  snapshot->State(emptyMsg, 1, 1);
+  EXPECT_EQ(0, emptyMsg.entities_size());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, RestoreSnapshot)
+{
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e1, DoubleComponent(1.5));
+  manager.CreateComponent(e2, IntComponent(2));
+  manager.CreateComponent(e2, ParentEntity(e1));
+  manager.CreateComponent(e3, StringComponent("unchanged"));
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunAdvanceChangeTick();
+
+  auto snapshot = manager.Snapshot();
+  manager.RunAdvanceChangeTick();
+  const auto e3Tick = manager.ComponentChangeTick(e3, StringComponent::typeId);
+
+  // Change, add and remove entities and components
+  manager.SetComponentData<IntComponent>(e1, 10);
+  manager.SetChanged(e1, IntComponent::typeId);
+  manager.RemoveComponent<DoubleComponent>(e1);
+  manager.CreateComponent(e1, BoolComponent(true));
+  auto e4 = manager.CreateEntity();
+  manager.CreateComponent(e4, IntComponent(4));
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  manager.RunClearNewlyCreatedEntities();
+  EXPECT_FALSE(manager.HasEntity(e2));
+  manager.RunAdvanceChangeTick();
+
+  manager.RestoreSnapshot(*snapshot);
+
+  // Entities created since are being removed, and removed ones are back as
+  // new entities with the same id
+  EXPECT_TRUE(manager.HasEntitiesMarkedForRemoval());
+  EXPECT_TRUE(manager.HasEntity(e2));
+  EXPECT_TRUE(manager.IsNewEntity(e2));
+  EXPECT_EQ(e1, manager.ParentEntity(e2));
+  EXPECT_EQ(2, manager.ComponentData<IntComponent>(e2));
+
+  EXPECT_EQ(1, manager.ComponentData<IntComponent>(e1));
+  EXPECT_EQ(1.5, manager.ComponentData<DoubleComponent>(e1));
+  EXPECT_EQ(nullptr, manager.Component<BoolComponent>(e1));
+  EXPECT_EQ(ComponentState::OneTimeChange,
+      manager.ComponentState(e1, IntComponent::typeId));
+
+  // Components which didn't change are left alone
+  EXPECT_EQ("unchanged", manager.ComponentData<StringComponent>(e3));
+  EXPECT_EQ(e3Tick, manager.ComponentChangeTick(e3, StringComponent::typeId));
+
+  manager.ProcessEntityRemovals();
+  manager.RunClearRemovedComponents();
+  EXPECT_FALSE(manager.HasEntity(e4));
+  EXPECT_EQ(3u, manager.EntityCount());
+
+  // A snapshot can be restored more than once
+  manager.RunAdvanceChangeTick();
+  manager.SetComponentData<IntComponent>(e2, 20);
+  manager.SetChanged(e2, IntComponent::typeId);
+  manager.RestoreSnapshot(*snapshot);
+  EXPECT_EQ(2, manager.ComponentData<IntComponent>(e2));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, RemoveManyEntitiesFromViews)
+{
+  std::vector<Entity> entities;
+  for (int i = 0; i < 20; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    if (i % 3 == 0)
+      manager.CreateComponent(entity, DoubleComponent(i));
+    entities.push_back(entity);
+  }
+
+  auto ints = [&]()
+  {
+    std::vector<int> result;
+    manager.Each<IntComponent>(
+        [&](const Entity &, const IntComponent *_int)
+        {
+          result.push_back(_int->Data());
+          return true;
+        });
+    return result;
+  };
+  auto both = [&]()
+  {
+    std::vector<int> result;
+    manager.Each<IntComponent, DoubleComponent>(
+        [&](const Entity &, const IntComponent *_int,
+            const DoubleComponent *_double)
+        {
+          EXPECT_DOUBLE_EQ(_int->Data(), _double->Data());
+          result.push_back(_int->Data());
+          return true;
+        });
+    return result;
+  };
+  EXPECT_EQ(20u, ints().size());
+  EXPECT_EQ(7u, both().size());
+
+  // Remove every odd entity in one go, the remaining entities keep their
+  // component data
+  for (std::size_t i = 1; i < entities.size(); i += 2)
+    manager.RequestRemoveEntity(entities[i]);
+  manager.ProcessEntityRemovals();
+
+  EXPECT_EQ(std::vector<int>({0, 2, 4, 6, 8, 10, 12, 14, 16, 18}), ints());
+  EXPECT_EQ(std::vector<int>({0, 6, 12, 18}), both());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachFilters)
+{
+  // e1: int
+  // e2: int, double
+  // e3: int, string
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e2, IntComponent(2));
+  manager.CreateComponent(e2, DoubleComponent(2.0));
+  manager.CreateComponent(e3, IntComponent(3));
+  manager.CreateComponent(e3, StringComponent("3"));
+
+  auto without = [&]()
+  {
+    std::vector<Entity> entities;
+    manager.Each<IntComponent, Without<DoubleComponent>>(
+        [&](const Entity &_entity, const IntComponent *_int) -> bool
+        {
+          EXPECT_NE(nullptr, _int);
+          entities.push_back(_entity);
+          return true;
+        });
+    return entities;
+  };
+
+  std::map<Entity, const DoubleComponent *> optionalData;
+  auto optional = [&]()
+  {
+    std::vector<Entity> entities;
+    optionalData.clear();
+    manager.Each<Optional<DoubleComponent>, IntComponent,
+        Without<StringComponent>>(
+        [&](const Entity &_entity, const DoubleComponent *_double,
+            const IntComponent *_int) -> bool
+        {
+          EXPECT_NE(nullptr, _int);
+          entities.push_back(_entity);
+          optionalData[_entity] = _double;
+          return true;
+        });
+    return entities;
+  };
+
+  EXPECT_EQ(std::vector<Entity>({e1, e3}), without());
+  EXPECT_EQ(std::vector<Entity>({e1, e2}), optional());
+  EXPECT_EQ(nullptr, optionalData[e1]);
+  ASSERT_NE(nullptr, optionalData[e2]);
+  EXPECT_DOUBLE_EQ(2.0, optionalData[e2]->Data());
+
+  // Filtered views don't replace the plain view of the same types
+  int count{0};
+  manager.Each<IntComponent>([&](const Entity &, const IntComponent *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(3, count);
+
+  // Adding an excluded component moves the entity out of the view, and
+  // adding an optional one updates its data
+  manager.CreateComponent(e1, DoubleComponent(1.0));
+  EXPECT_EQ(std::vector<Entity>({e3}), without());
+  EXPECT_EQ(std::vector<Entity>({e1, e2}), optional());
+  ASSERT_NE(nullptr, optionalData[e1]);
+  EXPECT_DOUBLE_EQ(1.0, optionalData[e1]->Data());
+
+  // Removing them moves it back
+  EXPECT_TRUE(manager.RemoveComponent<DoubleComponent>(e1));
+  EXPECT_TRUE(manager.RemoveComponent<StringComponent>(e3));
+  EXPECT_EQ(std::vector<Entity>({e1, e3}), without());
+  EXPECT_EQ(std::vector<Entity>({e1, e2, e3}), optional());
+  EXPECT_EQ(nullptr, optionalData[e1]);
+  EXPECT_EQ(nullptr, optionalData[e3]);
+
+  // Re-adding a removed component
+  manager.CreateComponent(e1, DoubleComponent(4.0));
+  EXPECT_EQ(std::vector<Entity>({e3}), without());
+  optional();
+  ASSERT_NE(nullptr, optionalData[e1]);
+  EXPECT_DOUBLE_EQ(4.0, optionalData[e1]->Data());
+
+  // New entities
+  EXPECT_TRUE(manager.HasNewEntities());
+  std::vector<Entity> newEntities;
+  manager.EachNew<IntComponent, Without<DoubleComponent>>(
+      [&](const Entity &_entity, const IntComponent *) -> bool
+      {
+        newEntities.push_back(_entity);
+        return true;
+      });
+  EXPECT_EQ(std::vector<Entity>({e3}), newEntities);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, NameIndex)
+{
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  manager.CreateComponent(e1, components::Name("box"));
+  manager.CreateComponent(e2, components::Name("box"));
+  manager.CreateComponent(e3, components::Name("sphere"));
+  manager.CreateComponent(e2, components::ParentEntity(e3));
+
+  EXPECT_EQ(std::vector<Entity>({e1, e2}), manager.EntitiesByName("box"));
+  EXPECT_EQ(std::vector<Entity>({e3}), manager.EntitiesByName("sphere"));
+  EXPECT_TRUE(manager.EntitiesByName("cylinder").empty());
+
+  // Queries by name go through the index, and still check other components
+  EXPECT_EQ(e1, manager.EntityByComponents(components::Name("box")));
+  EXPECT_EQ(e2, manager.EntityByComponents(components::Name("box"),
+      components::ParentEntity(e3)));
+  EXPECT_EQ(kNullEntity, manager.EntityByComponents(components::Name("box"),
+      components::ParentEntity(e1)));
+  EXPECT_EQ(std::vector<Entity>({e2}), manager.EntitiesByComponents(
+      components::ParentEntity(e3), components::Name("box")));
+
+  // Renaming through SetChanged updates the index
+  manager.Component<components::Name>(e1)->Data() = "cylinder";
+  manager.SetChanged(e1, components::Name::typeId,
+      ComponentState::OneTimeChange);
+  EXPECT_EQ(std::vector<Entity>({e2}), manager.EntitiesByName("box"));
+  EXPECT_EQ(std::vector<Entity>({e1}), manager.EntitiesByName("cylinder"));
+
+  // So does renaming without marking the name as changed, through
+  // SetComponentData, a mutable accessor or a mutable query
+  EXPECT_TRUE(manager.SetComponentData<components::Name>(e1, "capsule"));
+  EXPECT_EQ(e1, manager.EntityByComponents(components::Name("capsule")));
+  EXPECT_TRUE(manager.EntitiesByName("cylinder").empty());
+
+  manager.Component<components::Name>(e1)->Data() = "cone";
+  EXPECT_EQ(std::vector<Entity>({e1}), manager.EntitiesByComponents(
+      components::Name("cone")));
+  EXPECT_EQ(kNullEntity, manager.EntityByComponents(
+      components::Name("capsule")));
+
+  manager.Each<components::Name>(
+      [&](const Entity &_entity, components::Name *_name) -> bool
+      {
+        if (_entity == e1)
+          _name->Data() = "cylinder";
+        return true;
+      });
+  EXPECT_EQ(std::vector<Entity>({e1}), manager.EntitiesByName("cylinder"));
+  EXPECT_TRUE(manager.EntitiesByName("cone").empty());
+  EXPECT_EQ(std::vector<Entity>({e2}), manager.EntitiesByName("box"));
+
+  // Removed components and entities leave the index
+  EXPECT_TRUE(manager.RemoveComponent<components::Name>(e3));
+  EXPECT_TRUE(manager.EntitiesByName("sphere").empty());
+
+  manager.RequestRemoveEntity(e1);
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.EntitiesByName("cylinder").empty());
+
+  EXPECT_EQ(std::unordered_set<Entity>({e2}),
+      entitiesFromScopedName("box", manager));
+
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.EntitiesByName("box").empty());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, HierarchyCaches)
+{
+  // - 1
+  //   - 2
+  //     - 3
+  // - 4
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  auto e3 = manager.CreateEntity();
+  auto e4 = manager.CreateEntity();
+  manager.SetParentEntity(e2, e1);
+  manager.SetParentEntity(e3, e2);
+  manager.CreateComponent(e2, components::ParentEntity(e1));
+  manager.CreateComponent(e3, components::ParentEntity(e2));
+
+  manager.CreateComponent(e1,
+      components::Pose(math::Pose3d(1, 0, 0, 0, 0, 0)));
+  manager.CreateComponent(e2,
+      components::Pose(math::Pose3d(0, 2, 0, 0, 0, 0)));
+  manager.CreateComponent(e3,
+      components::Pose(math::Pose3d(0, 0, 3, 0, 0, 0)));
+
+  EXPECT_TRUE(manager.Ancestors(e1).empty());
+  EXPECT_EQ(std::vector<Entity>({e2, e1}), manager.Ancestors(e3));
+
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), manager.WorldPose(e3));
+  EXPECT_EQ(math::Pose3d(1, 2, 0, 0, 0, 0), manager.WorldPose(e2));
+  EXPECT_EQ(worldPose(e3, manager), manager.WorldPose(e3));
+  EXPECT_EQ(math::Pose3d::Zero, manager.WorldPose(e4));
+
+  // Marking a pose as changed invalidates cached world poses
+  EXPECT_TRUE(manager.SetComponentData<components::Pose>(e1,
+      math::Pose3d(5, 0, 0, 0, 0, 0)));
+  manager.SetChanged(e1, components::Pose::typeId,
+      ComponentState::OneTimeChange);
+  EXPECT_EQ(math::Pose3d(5, 2, 3, 0, 0, 0), manager.WorldPose(e3));
+
+  // So does setting a pose without marking it as changed
+  EXPECT_TRUE(manager.SetComponentData<components::Pose>(e1,
+      math::Pose3d(6, 0, 0, 0, 0, 0)));
+  EXPECT_EQ(math::Pose3d(6, 2, 3, 0, 0, 0), manager.WorldPose(e3));
+
+  // Or modifying a pose in place, through a mutable accessor or query
+  manager.Component<components::Pose>(e2)->Data().Pos().Y() = 4;
+  EXPECT_EQ(math::Pose3d(6, 4, 3, 0, 0, 0), manager.WorldPose(e3));
+  manager.Each<components::Pose>(
+      [&](const Entity &_entity, components::Pose *_pose) -> bool
+      {
+        if (_entity == e1)
+          _pose->Data().Pos().X() = 5;
+        return true;
+      });
+  EXPECT_EQ(math::Pose3d(5, 4, 3, 0, 0, 0), manager.WorldPose(e3));
+  EXPECT_EQ(worldPose(e3, manager), manager.WorldPose(e3));
+
+  // Ancestors are returned by value, so they outlive changes to the cache
+  const auto ancestors = manager.Ancestors(e3);
+
+  // Reparenting updates ancestors, descendants and world poses, even if the
+  // parent isn't marked as changed
+  manager.SetParentEntity(e2, e4);
+  EXPECT_EQ(std::vector<Entity>({e2, e1}), manager.Ancestors(e3));
+  manager.SetComponentData<components::ParentEntity>(e2, e4);
+  EXPECT_EQ(std::vector<Entity>({e2, e4}), manager.Ancestors(e3));
+  EXPECT_EQ(math::Pose3d(0, 4, 3, 0, 0, 0), manager.WorldPose(e3));
+  EXPECT_EQ(std::vector<Entity>({e2, e1}), ancestors);
+
+  auto ds = manager.Descendants(e4);
+  EXPECT_EQ(3u, ds.size());
+  EXPECT_NE(ds.end(), ds.find(e2));
+  EXPECT_NE(ds.end(), ds.find(e3));
+  EXPECT_EQ(1u, manager.Descendants(e1).size());
+
+  // Removed entities are dropped from the caches
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_TRUE(manager.Descendants(e3).empty());
+  EXPECT_EQ(1u, manager.Descendants(e4).size());
+}
+
 //////////////////////////////////////////////////
 TEST_P(EntityComponentManagerFixture,
        IGN_UTILS_TEST_DISABLED_ON_WIN32(SetChanged))
@@ -2930,6 +3567,148 @@ TEST_P(EntityComponentManagerFixture,
   EXPECT_EQ(18u, manager.EntityCount());
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CloneMany)
+{
+  // - model
+  //    - link1 (canonical link)
+  //    - link2
+  //       - sensor
+  Entity model = manager.CreateEntity();
+  manager.CreateComponent(model, components::Name("model"));
+  Entity link1 = manager.CreateEntity();
+  manager.CreateComponent(link1, components::Name("link1"));
+  manager.CreateComponent(link1, components::ParentEntity(model));
+  manager.CreateComponent(link1, components::CanonicalLink());
+  Entity link2 = manager.CreateEntity();
+  manager.CreateComponent(link2, components::Name("link2"));
+  manager.CreateComponent(link2, components::ParentEntity(model));
+  manager.CreateComponent(link2, IntComponent(2));
+  Entity sensor = manager.CreateEntity();
+  manager.CreateComponent(sensor, components::Name("sensor"));
+  manager.CreateComponent(sensor, components::ParentEntity(link2));
+  manager.CreateComponent(sensor, StringComponent("camera"));
+  manager.CreateComponent(model, components::ModelCanonicalLink(link1));
+
+  // An unrelated entity already has the first generated name
+  auto other = manager.CreateEntity();
+  manager.CreateComponent(other, components::Name("model_1"));
+  EXPECT_EQ(5u, manager.EntityCount());
+
+  EXPECT_TRUE(manager.CloneMany(kNullEntity, kNullEntity, 2).empty());
+  EXPECT_TRUE(manager.CloneMany(model, kNullEntity, 0).empty());
+
+  auto roots = manager.CloneMany(model, kNullEntity, 3);
+  ASSERT_EQ(3u, roots.size());
+  EXPECT_EQ(17u, manager.EntityCount());
+
+  std::set<std::string> names;
+  for (const Entity root : roots)
+  {
+    auto name = manager.ComponentData<components::Name>(root);
+    ASSERT_TRUE(name.has_value());
+    names.insert(*name);
+    EXPECT_EQ(nullptr, manager.Component<components::ParentEntity>(root));
+
+    // Descendants keep their names, and references are remapped
+    auto clonedLink1 = manager.EntityByComponents(components::Name("link1"),
+        components::ParentEntity(root));
+    auto clonedLink2 = manager.EntityByComponents(components::Name("link2"),
+        components::ParentEntity(root));
+    ASSERT_NE(kNullEntity, clonedLink1);
+    ASSERT_NE(kNullEntity, clonedLink2);
+    EXPECT_NE(link1, clonedLink1);
+    EXPECT_EQ(clonedLink1,
+        manager.ComponentData<components::ModelCanonicalLink>(root));
+    EXPECT_NE(nullptr,
+        manager.Component<components::CanonicalLink>(clonedLink1));
+    EXPECT_EQ(2, manager.ComponentData<IntComponent>(clonedLink2));
+    EXPECT_EQ(root, manager.ParentEntity(clonedLink2));
+
+    auto clonedSensor = manager.EntityByComponents(
+        components::Name("sensor"), components::ParentEntity(clonedLink2));
+    ASSERT_NE(kNullEntity, clonedSensor);
+    EXPECT_EQ("camera", manager.ComponentData<StringComponent>(clonedSensor));
+    EXPECT_EQ(3u, manager.Descendants(root).size() - 1u);
+  }
+  EXPECT_EQ(std::set<std::string>({"model_2", "model_3", "model_4"}), names);
+
+  // The original is untouched
+  EXPECT_EQ(link1, manager.ComponentData<components::ModelCanonicalLink>(
+      model));
+  EXPECT_EQ("model", manager.ComponentData<components::Name>(model));
+
+  // Clones can go under a parent
+  auto nested = manager.CloneMany(link2, model, 1);
+  ASSERT_EQ(1u, nested.size());
+  EXPECT_EQ(model, manager.ParentEntity(nested[0]));
+  EXPECT_EQ(model,
+      manager.ComponentData<components::ParentEntity>(nested[0]));
+  EXPECT_EQ("link2_1", manager.ComponentData<components::Name>(nested[0]));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, CopyEntities)
+{
+  // An entity already exists, so copies are numbered differently
+  Entity existing = manager.CreateEntity();
+  manager.CreateComponent(existing, components::Name("existing"));
+
+  // - model
+  //    - link (canonical link)
+  //       - sensor
+  EntityComponentManager other;
+  Entity model = other.CreateEntity();
+  other.CreateComponent(model, components::Name("model"));
+  Entity link = other.CreateEntity();
+  other.CreateComponent(link, components::Name("link"));
+  other.CreateComponent(link, components::ParentEntity(model));
+  other.CreateComponent(link, IntComponent(3));
+  Entity sensor = other.CreateEntity();
+  other.CreateComponent(sensor, components::ParentEntity(link));
+  other.CreateComponent(sensor, StringComponent("camera"));
+  other.CreateComponent(model, components::ModelCanonicalLink(link));
+
+  EXPECT_TRUE(manager.CopyEntities(manager).empty());
+  EXPECT_TRUE(manager.CopyEntities(EntityComponentManager()).empty());
+
+  auto copies = manager.CopyEntities(other);
+  ASSERT_EQ(3u, copies.size());
+  EXPECT_EQ(4u, manager.EntityCount());
+  EXPECT_EQ(3u, other.EntityCount());
+
+  // Copies are allocated in the order of the originals
+  const Entity modelCopy = copies[model];
+  const Entity linkCopy = copies[link];
+  const Entity sensorCopy = copies[sensor];
+  EXPECT_LT(existing, modelCopy);
+  EXPECT_LT(modelCopy, linkCopy);
+  EXPECT_LT(linkCopy, sensorCopy);
+
+  // References are remapped
+  EXPECT_EQ("model", manager.ComponentData<components::Name>(modelCopy));
+  EXPECT_EQ(kNullEntity, manager.ParentEntity(modelCopy));
+  EXPECT_EQ(linkCopy,
+      manager.ComponentData<components::ModelCanonicalLink>(modelCopy));
+  EXPECT_EQ(modelCopy, manager.ParentEntity(linkCopy));
+  EXPECT_EQ(modelCopy,
+      manager.ComponentData<components::ParentEntity>(linkCopy));
+  EXPECT_EQ(3, manager.ComponentData<IntComponent>(linkCopy));
+  EXPECT_EQ(linkCopy, manager.ParentEntity(sensorCopy));
+  EXPECT_EQ("camera", manager.ComponentData<StringComponent>(sensorCopy));
+  EXPECT_EQ(3u, manager.Descendants(modelCopy).size());
+
+  // Copies show up in views
+  std::size_t count{0u};
+  manager.Each<components::Name>(
+      [&](const Entity &, const components::Name *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(3u, count);
+}
+
 /////////////////////////////////////////////////
 // Check that some widely used deprecated APIs still work
 TEST_P(EntityComponentManagerFixture,
@@ -3161,6 +3940,1106 @@ TEST_P(EntityComponentManagerFixture,
   EXPECT_EQ(1, foundEntities);
 }
 
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, RemoveEntityKeepsOtherComponents)
+{
+  // Components of the same type are stored together, so removing an entity
+  // shouldn't affect the components of other entities
+  std::vector<Entity> entities;
+  for (int i = 0; i < 10; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    manager.CreateComponent(entity, DoubleComponent(i * 0.5));
+    entities.push_back(entity);
+  }
+
+  const auto *lastInt = manager.Component<IntComponent>(entities.back());
+  ASSERT_NE(nullptr, lastInt);
+
+  manager.RequestRemoveEntity(entities[0]);
+  manager.RequestRemoveEntity(entities[4]);
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(8u, manager.EntityCount());
+
+  // Component addresses are stable
+  EXPECT_EQ(lastInt, manager.Component<IntComponent>(entities.back()));
+
+  for (int i = 0; i < 10; ++i)
+  {
+    if (i == 0 || i == 4)
+    {
+      EXPECT_EQ(nullptr, manager.Component<IntComponent>(entities[i]));
+      continue;
+    }
+
+    auto intComp = manager.Component<IntComponent>(entities[i]);
+    ASSERT_NE(nullptr, intComp);
+    EXPECT_EQ(i, intComp->Data());
+
+    auto doubleComp = manager.Component<DoubleComponent>(entities[i]);
+    ASSERT_NE(nullptr, doubleComp);
+    EXPECT_DOUBLE_EQ(i * 0.5, doubleComp->Data());
+  }
+
+  // New components still go to the right entity
+  auto entity = manager.CreateEntity();
+  manager.CreateComponent(entity, IntComponent(123));
+  EXPECT_EQ(123, manager.Component<IntComponent>(entity)->Data());
+  EXPECT_EQ(9, manager.Component<IntComponent>(entities.back())->Data());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachParallel)
+{
+  const int count = 1000;
+  for (int i = 0; i < count; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    if (i % 2 == 0)
+      manager.CreateComponent(entity, DoubleComponent(0.0));
+  }
+
+  // Mutable components, each entity is visited once
+  std::atomic<int> visited{0};
+  manager.EachParallel<IntComponent, DoubleComponent>(
+      [&](const Entity &, IntComponent *_int,
+          DoubleComponent *_double) -> bool
+      {
+        _double->Data() = _int->Data() * 2.0;
+        visited++;
+        return true;
+      });
+  EXPECT_EQ(count / 2, visited.load());
+
+  // Const components see the changes
+  std::atomic<int> sum{0};
+  const EntityComponentManager &constManager = manager;
+  constManager.EachParallel<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *_int,
+          const DoubleComponent *_double) -> bool
+      {
+        EXPECT_DOUBLE_EQ(_int->Data() * 2.0, _double->Data());
+        sum += _int->Data();
+        return true;
+      });
+
+  int expectedSum = 0;
+  for (int i = 0; i < count; i += 2)
+    expectedSum += i;
+  EXPECT_EQ(expectedSum, sum.load());
+
+  // Stopping prevents most entities from being visited
+  visited = 0;
+  manager.EachParallel<IntComponent>(
+      [&](const Entity &, IntComponent *) -> bool
+      {
+        visited++;
+        return false;
+      });
+  EXPECT_GE(visited.load(), 1);
+  EXPECT_LT(visited.load(), count);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachSpan)
+{
+  // More entities than fit in a chunk
+  const int count = 1000;
+  std::vector<Entity> expectedEntities;
+  for (int i = 0; i < count; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    if (i % 2 == 0)
+    {
+      manager.CreateComponent(entity, DoubleComponent(0.0));
+      expectedEntities.push_back(entity);
+    }
+  }
+
+  // Mutable data is copied back into the components
+  std::vector<Entity> visited;
+  std::size_t chunks{0u};
+  manager.EachSpan<IntComponent, DoubleComponent>(
+      [&](std::size_t _count, const Entity *_entities, int *_ints,
+          double *_doubles)
+      {
+        ++chunks;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          EXPECT_EQ(_ints[i],
+              manager.Component<IntComponent>(_entities[i])->Data());
+          _doubles[i] = _ints[i] * 2.0;
+        }
+        visited.insert(visited.end(), _entities, _entities + _count);
+      });
+  EXPECT_EQ(expectedEntities, visited);
+  EXPECT_LT(1u, chunks);
+
+  for (auto entity : expectedEntities)
+  {
+    EXPECT_DOUBLE_EQ(manager.Component<IntComponent>(entity)->Data() * 2.0,
+        manager.Component<DoubleComponent>(entity)->Data());
+  }
+
+  // Const data on a mutable manager isn't copied back
+  manager.EachSpan<DoubleComponent>(
+      [&](std::size_t _count, const Entity *, const double *_doubles)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          EXPECT_LE(0.0, _doubles[i]);
+      });
+
+  // Const manager
+  int sum{0};
+  const EntityComponentManager &constManager = manager;
+  constManager.EachSpan<IntComponent>(
+      [&](std::size_t _count, const Entity *, const int *_ints)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          sum += _ints[i];
+      });
+  EXPECT_EQ(count * (count - 1) / 2, sum);
+
+  // No matching entities
+  chunks = 0u;
+  manager.EachSpan<StringComponent>(
+      [&](std::size_t, const Entity *, const std::string *)
+      {
+        ++chunks;
+      });
+  EXPECT_EQ(0u, chunks);
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComponentCount)
+{
+  EXPECT_EQ(0u, manager.ComponentCount(IntComponent::typeId));
+
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e2, IntComponent(2));
+  manager.CreateComponent(e2, DoubleComponent(2.0));
+  EXPECT_EQ(2u, manager.ComponentCount(IntComponent::typeId));
+  EXPECT_EQ(1u, manager.ComponentCount(DoubleComponent::typeId));
+
+  // Removed components are kept until their entity is removed
+  EXPECT_TRUE(manager.RemoveComponent<DoubleComponent>(e2));
+  EXPECT_EQ(1u, manager.ComponentCount(DoubleComponent::typeId));
+
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(1u, manager.ComponentCount(IntComponent::typeId));
+  EXPECT_EQ(0u, manager.ComponentCount(DoubleComponent::typeId));
+
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0u, manager.ComponentCount(IntComponent::typeId));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ParallelFor)
+{
+  // Every index is visited exactly once
+  std::vector<int> visits(1000, 0);
+  manager.ParallelFor(visits.size(),
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        EXPECT_LT(_begin, _end);
+        for (std::size_t i = _begin; i < _end; ++i)
+          visits[i]++;
+      }, 16u);
+  for (const auto visit : visits)
+    EXPECT_EQ(1, visit);
+
+  // Ranges smaller than the minimum chunk size are a single chunk
+  std::atomic<int> chunks{0};
+  manager.ParallelFor(10u,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        EXPECT_EQ(0u, _begin);
+        EXPECT_EQ(10u, _end);
+        chunks++;
+      }, 16u);
+  EXPECT_EQ(1, chunks.load());
+
+  // Empty ranges don't call the function
+  manager.ParallelFor(0u, [&](std::size_t, std::size_t)
+      {
+        chunks++;
+      });
+  EXPECT_EQ(1, chunks.load());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, StateOnlyChanged)
+{
+  std::vector<Entity> entities;
+  for (int i = 0; i < 100; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    manager.CreateComponent(entity, DoubleComponent(i * 1.0));
+    entities.push_back(entity);
+  }
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+
+  // Nothing changed
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.State(stateMsg);
+    EXPECT_EQ(0, stateMsg.entities_size());
+  }
+
+  // Change a few components
+  manager.SetChanged(entities[3], IntComponent::typeId,
+      ComponentState::PeriodicChange);
+  manager.SetChanged(entities[7], DoubleComponent::typeId,
+      ComponentState::OneTimeChange);
+  manager.RequestRemoveEntity(entities[9]);
+
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.State(stateMsg);
+    ASSERT_EQ(3, stateMsg.entities_size());
+
+    auto e3 = stateMsg.entities().at(entities[3]);
+    EXPECT_FALSE(e3.remove());
+    ASSERT_EQ(1, e3.components_size());
+    EXPECT_EQ(IntComponent::typeId, e3.components().begin()->second.type());
+
+    auto e7 = stateMsg.entities().at(entities[7]);
+    ASSERT_EQ(1, e7.components_size());
+    EXPECT_EQ(DoubleComponent::typeId,
+        e7.components().begin()->second.type());
+
+    EXPECT_TRUE(stateMsg.entities().at(entities[9]).remove());
+  }
+
+  // Filter by type
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.State(stateMsg, {}, {IntComponent::typeId});
+    ASSERT_EQ(2, stateMsg.entities_size());
+    EXPECT_EQ(1, stateMsg.entities().at(entities[3]).components_size());
+    EXPECT_EQ(0u, stateMsg.entities().count(entities[7]));
+  }
+
+  // Filter by entity
+  {
+    msgs::SerializedStateMap stateMsg;
+    manager.State(stateMsg, {entities[7], entities[8]});
+    ASSERT_EQ(1, stateMsg.entities_size());
+    EXPECT_EQ(1u, stateMsg.entities().count(entities[7]));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ChangeTicks)
+{
+  std::vector<Entity> entities;
+  for (int i = 0; i < 10; ++i)
+  {
+    auto entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    manager.CreateComponent(entity, DoubleComponent(i * 1.0));
+    entities.push_back(entity);
+  }
+
+  const uint64_t loadTick = manager.ChangeTick();
+  EXPECT_LT(0u, loadTick);
+  EXPECT_EQ(loadTick,
+      manager.ComponentChangeTick(entities[0], IntComponent::typeId));
+  EXPECT_EQ(0u,
+      manager.ComponentChangeTick(entities[0], StringComponent::typeId));
+
+  // Everything changed since tick zero
+  int count = 0;
+  manager.EachChangedSince<IntComponent>(0u,
+      [&](const Entity &, const IntComponent *) -> bool
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(10, count);
+
+  // Skip a few iterations, as a consumer which doesn't run every iteration
+  // would, and change components in between
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  manager.RunAdvanceChangeTick();
+  manager.SetChanged(entities[2], IntComponent::typeId);
+  manager.RunSetAllComponentsUnchanged();
+  manager.RunAdvanceChangeTick();
+  manager.SetChanged(entities[5], DoubleComponent::typeId,
+      ComponentState::PeriodicChange);
+  manager.RemoveComponent<IntComponent>(entities[6]);
+  manager.RunSetAllComponentsUnchanged();
+  manager.RunAdvanceChangeTick();
+
+  EXPECT_EQ(loadTick + 3, manager.ChangeTick());
+  EXPECT_EQ(loadTick + 1,
+      manager.ComponentChangeTick(entities[2], IntComponent::typeId));
+
+  // Only entities with changed components are visited, even though the
+  // per-iteration changes have been cleared
+  std::vector<Entity> visited;
+  manager.EachChangedSince<IntComponent, DoubleComponent>(loadTick,
+      [&](const Entity &_entity, const IntComponent *,
+          const DoubleComponent *) -> bool
+      {
+        visited.push_back(_entity);
+        return true;
+      });
+  ASSERT_EQ(2u, visited.size());
+  EXPECT_EQ(entities[2], visited[0]);
+  EXPECT_EQ(entities[5], visited[1]);
+
+  visited.clear();
+  manager.EachChangedSince<DoubleComponent>(loadTick + 1,
+      [&](const Entity &_entity, DoubleComponent *) -> bool
+      {
+        visited.push_back(_entity);
+        return true;
+      });
+  ASSERT_EQ(1u, visited.size());
+  EXPECT_EQ(entities[5], visited[0]);
+
+  // Changes per component type
+  EXPECT_TRUE(manager.ComponentTypeChangedSince(loadTick,
+      IntComponent::typeId));
+  EXPECT_FALSE(manager.ComponentTypeChangedSince(loadTick + 1,
+      IntComponent::typeId));
+  EXPECT_TRUE(manager.ComponentTypeChangedSince(loadTick + 1,
+      DoubleComponent::typeId));
+  EXPECT_FALSE(manager.ComponentTypeChangedSince(0u,
+      StringComponent::typeId));
+
+  // Remove an entity and catch up with all changes with a state message
+  manager.RequestRemoveEntity(entities[8]);
+  manager.ProcessEntityRemovals();
+  manager.RunAdvanceChangeTick();
+
+  msgs::SerializedStateMap stateMsg;
+  manager.ChangedState(stateMsg, loadTick);
+  ASSERT_EQ(4, stateMsg.entities_size());
+
+  auto e2 = stateMsg.entities().at(entities[2]);
+  EXPECT_FALSE(e2.remove());
+  ASSERT_EQ(1, e2.components_size());
+  EXPECT_EQ(IntComponent::typeId, e2.components().begin()->second.type());
+  EXPECT_FALSE(e2.components().begin()->second.component().empty());
+
+  EXPECT_EQ(1, stateMsg.entities().at(entities[5]).components_size());
+
+  auto e6 = stateMsg.entities().at(entities[6]);
+  ASSERT_EQ(1, e6.components_size());
+  EXPECT_TRUE(e6.components().begin()->second.remove());
+
+  EXPECT_TRUE(stateMsg.entities().at(entities[8]).remove());
+
+  // Only the requested entities
+  msgs::SerializedStateMap filteredMsg;
+  manager.ChangedState(filteredMsg, loadTick, {entities[2], entities[8]});
+  ASSERT_EQ(2, filteredMsg.entities_size());
+  EXPECT_EQ(1, filteredMsg.entities().at(entities[2]).components_size());
+  EXPECT_TRUE(filteredMsg.entities().at(entities[8]).remove());
+
+  // Only the requested component types, entity removals are kept
+  msgs::SerializedStateMap typesMsg;
+  manager.ChangedState(typesMsg, loadTick, {}, {DoubleComponent::typeId});
+  ASSERT_EQ(2, typesMsg.entities_size());
+  EXPECT_EQ(1, typesMsg.entities().at(entities[5]).components_size());
+  EXPECT_TRUE(typesMsg.entities().at(entities[8]).remove());
+
+  // Nothing changed since the current tick
+  msgs::SerializedStateMap emptyMsg;
+  manager.ChangedState(emptyMsg, manager.ChangeTick());
+  EXPECT_EQ(0, emptyMsg.entities_size());
+
+  // SetComponentData stamps the change tick only if the data changed
+  EXPECT_FALSE(manager.SetComponentData<IntComponent>(entities[3], 3));
+  EXPECT_EQ(loadTick,
+      manager.ComponentChangeTick(entities[3], IntComponent::typeId));
+  EXPECT_TRUE(manager.SetComponentData<IntComponent>(entities[3], 30));
+  EXPECT_EQ(manager.ChangeTick(),
+      manager.ComponentChangeTick(entities[3], IntComponent::typeId));
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ChangedStateFiltered)
+{
+  Entity e1 = manager.CreateEntity();
+  Entity e2 = manager.CreateEntity();
+  manager.CreateComponent<IntComponent>(e1, IntComponent(1));
+  manager.CreateComponent<DoubleComponent>(e1, DoubleComponent(0.5));
+  manager.CreateComponent<IntComponent>(e2, IntComponent(2));
+
+  // Only e1, only doubles
+  msgs::SerializedStateMap stateMsg;
+  manager.ChangedState(stateMsg,
+      [&](const Entity _entity)
+      {
+        return _entity == e1;
+      },
+      [](const ComponentTypeId _type)
+      {
+        return _type == DoubleComponent::typeId;
+      });
+  ASSERT_EQ(1, stateMsg.entities_size());
+  const auto &e1Msg = stateMsg.entities().at(e1);
+  ASSERT_EQ(1, e1Msg.components_size());
+  EXPECT_EQ(DoubleComponent::typeId, e1Msg.components().begin()->second.type());
+
+  // Entities without accepted components aren't added
+  msgs::SerializedStateMap emptyMsg;
+  manager.ChangedState(emptyMsg, nullptr,
+      [](const ComponentTypeId)
+      {
+        return false;
+      });
+  EXPECT_EQ(0, emptyMsg.entities_size());
+
+  // Empty filters are the same as the unfiltered state
+  msgs::SerializedStateMap allMsg;
+  manager.ChangedState(allMsg, nullptr, nullptr);
+  msgs::SerializedStateMap unfilteredMsg;
+  manager.ChangedState(unfilteredMsg);
+  EXPECT_EQ(unfilteredMsg.entities_size(), allMsg.entities_size());
+  EXPECT_EQ(2, allMsg.entities().at(e1).components_size());
+
+  // Removals of accepted entities are kept
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  manager.RequestRemoveEntity(e2);
+  msgs::SerializedStateMap removedMsg;
+  manager.ChangedState(removedMsg, nullptr,
+      [](const ComponentTypeId)
+      {
+        return false;
+      });
+  ASSERT_EQ(1, removedMsg.entities_size());
+  EXPECT_TRUE(removedMsg.entities().at(e2).remove());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EachNewRemovedWithoutChanges)
+{
+  auto countNew = [&]()
+  {
+    int count = 0;
+    manager.EachNew<IntComponent>(
+        [&](const Entity &, const IntComponent *) -> bool
+        {
+          ++count;
+          return true;
+        });
+    return count;
+  };
+  auto countRemoved = [&]()
+  {
+    int count = 0;
+    manager.EachRemoved<IntComponent>(
+        [&](const Entity &, const IntComponent *) -> bool
+        {
+          ++count;
+          return true;
+        });
+    return count;
+  };
+
+  // Nothing new or removed yet, so the view isn't even created
+  EXPECT_EQ(0, countNew());
+  EXPECT_EQ(0, countRemoved());
+
+  // The view is created on the first call with pending changes, and still
+  // sees the new entities
+  auto e1 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  auto e2 = manager.CreateEntity();
+  manager.CreateComponent(e2, IntComponent(2));
+  EXPECT_EQ(2, countNew());
+  EXPECT_EQ(0, countRemoved());
+
+  manager.RunClearNewlyCreatedEntities();
+  EXPECT_EQ(0, countNew());
+
+  manager.RequestRemoveEntity(e2);
+  EXPECT_EQ(0, countNew());
+  EXPECT_EQ(1, countRemoved());
+
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0, countRemoved());
+
+  // Removing all entities also goes through the queues
+  manager.RequestRemoveEntities();
+  EXPECT_EQ(1, countRemoved());
+  manager.ProcessEntityRemovals();
+  EXPECT_EQ(0, countRemoved());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, PooledComponentAllocations)
+{
+  EXPECT_EQ(0u, manager.ComponentAllocationCount());
+
+  auto spawn = [&](int _count)
+  {
+    std::vector<Entity> spawned;
+    for (int i = 0; i < _count; ++i)
+    {
+      auto entity = manager.CreateEntity();
+      manager.CreateComponent(entity, IntComponent(i));
+      manager.CreateComponent(entity, DoubleComponent(i * 0.5));
+      spawned.push_back(entity);
+    }
+    return spawned;
+  };
+
+  // Warm up to the peak number of components
+  auto entities = spawn(100);
+  EXPECT_GT(manager.ComponentAllocationCount(), 0u);
+  for (auto entity : entities)
+    manager.RequestRemoveEntity(entity);
+  manager.ProcessEntityRemovals();
+  const auto warm = manager.ComponentAllocationCount();
+
+  // Steady state spawn / despawn reuses the pooled memory
+  for (int cycle = 0; cycle < 5; ++cycle)
+  {
+    entities = spawn(100);
+    ASSERT_EQ(100u, entities.size());
+    auto comp = manager.Component<IntComponent>(entities[42]);
+    ASSERT_NE(nullptr, comp);
+    EXPECT_EQ(42, comp->Data());
+
+    for (auto entity : entities)
+      manager.RequestRemoveEntity(entity);
+    manager.ProcessEntityRemovals();
+    EXPECT_EQ(warm, manager.ComponentAllocationCount());
+  }
+
+  // Removing all entities keeps the pooled memory too
+  spawn(100);
+  manager.RequestRemoveEntities();
+  manager.ProcessEntityRemovals();
+  spawn(100);
+  EXPECT_EQ(warm, manager.ComponentAllocationCount());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, BatchCreation)
+{
+  // Create the view before the entities, so it must be updated
+  int count = 0;
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *, const DoubleComponent *)
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(0, count);
+
+  auto entities = manager.CreateEntities(100);
+  ASSERT_EQ(100u, entities.size());
+  EXPECT_EQ(100u, manager.EntityCount());
+  for (std::size_t i = 1; i < entities.size(); ++i)
+    EXPECT_EQ(entities[i - 1] + 1, entities[i]);
+  EXPECT_TRUE(manager.HasNewEntities());
+  EXPECT_TRUE(manager.CreateEntities(0).empty());
+
+  std::vector<IntComponent> ints;
+  for (int i = 0; i < 100; ++i)
+    ints.push_back(IntComponent(i));
+  manager.CreateComponents(entities, ints);
+  manager.CreateComponents(entities, DoubleComponent(0.5));
+
+  auto comp = manager.Component<IntComponent>(entities[42]);
+  ASSERT_NE(nullptr, comp);
+  EXPECT_EQ(42, comp->Data());
+
+  count = 0;
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *, const DoubleComponent *)
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(100, count);
+
+  int newCount = 0;
+  manager.EachNew<IntComponent>(
+      [&](const Entity &, const IntComponent *)
+      {
+        ++newCount;
+        return true;
+      });
+  EXPECT_EQ(100, newCount);
+
+  // Mismatched sizes don't create anything
+  manager.CreateComponents(entities, std::vector<StringComponent>(3));
+  EXPECT_EQ(nullptr, manager.Component<StringComponent>(entities[0]));
+
+  // Views used within a batch see the entities created so far
+  manager.BeginBatchCreation();
+  auto e1 = manager.CreateEntity();
+  manager.CreateComponent(e1, IntComponent(1));
+  manager.CreateComponent(e1, DoubleComponent(1.0));
+  count = 0;
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *, const DoubleComponent *)
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(101, count);
+
+  // Entities removed within a batch are not added to views
+  auto e2 = manager.CreateEntity();
+  manager.CreateComponent(e2, IntComponent(2));
+  manager.CreateComponent(e2, DoubleComponent(2.0));
+  manager.RequestRemoveEntity(e2);
+  manager.EndBatchCreation();
+
+  int removedCount = 0;
+  manager.EachRemoved<IntComponent, DoubleComponent>(
+      [&](const Entity &_entity, const IntComponent *, const DoubleComponent *)
+      {
+        EXPECT_EQ(e2, _entity);
+        ++removedCount;
+        return true;
+      });
+  EXPECT_EQ(1, removedCount);
+
+  manager.ProcessEntityRemovals();
+  count = 0;
+  manager.Each<IntComponent, DoubleComponent>(
+      [&](const Entity &, const IntComponent *, const DoubleComponent *)
+      {
+        ++count;
+        return true;
+      });
+  EXPECT_EQ(101, count);
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, DeferredCommands)
+{
+  auto existing = manager.CreateEntity();
+  manager.CreateComponent(existing, IntComponent(1));
+  manager.CreateComponent(existing, DoubleComponent(1.0));
+  manager.RunClearNewlyCreatedEntities();
+
+  // Record from a const manager, as in PostUpdate
+  const EntityComponentManager &constManager = manager;
+  auto &deferred = constManager.Deferred();
+  EXPECT_EQ(&deferred, &manager.Deferred());
+  EXPECT_TRUE(deferred.Empty());
+
+  auto created = deferred.CreateEntity();
+  EXPECT_NE(kNullEntity, created);
+  EXPECT_NE(existing, created);
+  deferred.CreateComponent(created, IntComponent(2));
+  deferred.CreateComponent(existing, IntComponent(3));
+  deferred.RemoveComponent<DoubleComponent>(existing);
+  EXPECT_FALSE(deferred.Empty());
+
+  // Nothing happens until the commands are applied
+  EXPECT_FALSE(manager.HasEntity(created));
+  EXPECT_EQ(1, manager.Component<IntComponent>(existing)->Data());
+  EXPECT_NE(nullptr, manager.Component<DoubleComponent>(existing));
+
+  manager.RunApplyDeferredCommands();
+  EXPECT_TRUE(deferred.Empty());
+  EXPECT_TRUE(manager.HasEntity(created));
+  EXPECT_TRUE(manager.HasNewEntities());
+  ASSERT_NE(nullptr, manager.Component<IntComponent>(created));
+  EXPECT_EQ(2, manager.Component<IntComponent>(created)->Data());
+  EXPECT_EQ(3, manager.Component<IntComponent>(existing)->Data());
+  EXPECT_EQ(nullptr, manager.Component<DoubleComponent>(existing));
+
+  // Entities created directly don't reuse reserved ids
+  EXPECT_NE(created, manager.CreateEntity());
+
+  // Each thread records into its own buffer
+  const int threadCount = 4;
+  const int perThread = 25;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([&constManager, t]()
+    {
+      auto &buffer = constManager.Deferred();
+      for (int i = 0; i < perThread; ++i)
+      {
+        auto entity = buffer.CreateEntity();
+        buffer.CreateComponent(entity,
+            IntComponent(1000 + t * perThread + i));
+      }
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  manager.RunApplyDeferredCommands();
+  std::set<int> values;
+  manager.Each<IntComponent>(
+      [&](const Entity &, const IntComponent *_int)
+      {
+        values.insert(_int->Data());
+        return true;
+      });
+  EXPECT_EQ(static_cast<std::size_t>(threadCount * perThread + 2),
+      values.size());
+
+  // Removal requests go through the usual processing
+  deferred.RequestRemoveEntity(created);
+  manager.RunApplyDeferredCommands();
+  EXPECT_TRUE(manager.HasEntitiesMarkedForRemoval());
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.HasEntity(created));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ModelSpatialIndex)
+{
+  auto model = manager.CreateEntity();
+  manager.CreateComponent(model, components::Model());
+  manager.CreateComponent(model, components::Pose(math::Pose3d(1, 0, 0,
+      0, 0, 0)));
+
+  auto nested = manager.CreateEntity();
+  manager.CreateComponent(nested, components::Model());
+  manager.CreateComponent(nested, components::Pose(math::Pose3d(0, 1, 0,
+      0, 0, 0)));
+  manager.CreateComponent(nested, components::ParentEntity(model));
+
+  auto link = manager.CreateEntity();
+  manager.CreateComponent(link, components::Link());
+  manager.CreateComponent(link, components::Pose());
+  manager.CreateComponent(link, components::ParentEntity(model));
+
+  auto boxed = manager.CreateEntity();
+  manager.CreateComponent(boxed, components::Model());
+  manager.CreateComponent(boxed, components::Pose(math::Pose3d(100, 0, 0,
+      0, 0, 0)));
+  manager.CreateComponent(boxed, components::AxisAlignedBox(
+      math::AxisAlignedBox(math::Vector3d(99, -1, -1),
+      math::Vector3d(101, 1, 1))));
+
+  // Only models are indexed, by box if they have one, by world position
+  // otherwise
+  const auto &index = manager.ModelSpatialIndex();
+  EXPECT_EQ(&index, &manager.ModelSpatialIndex());
+  EXPECT_EQ(3u, index.Size());
+  EXPECT_FALSE(index.HasEntity(link));
+  EXPECT_EQ(math::AxisAlignedBox(math::Vector3d(1, 1, 0),
+      math::Vector3d(1, 1, 0)), index.Box(nested));
+  EXPECT_EQ(std::vector<Entity>({model, nested}),
+      index.QuerySphere(math::Vector3d::Zero, 2.0));
+  EXPECT_EQ(std::vector<Entity>({boxed}),
+      index.QueryBox(math::AxisAlignedBox(math::Vector3d(98.5, 0, 0),
+      math::Vector3d(99.5, 0, 0))));
+
+  // Moving a model moves its nested models once the index is updated
+  manager.RunAdvanceChangeTick();
+  manager.Component<components::Pose>(model)->Data() =
+      math::Pose3d(50, 0, 0, 0, 0, 0);
+  manager.SetChanged(model, components::Pose::typeId,
+      ComponentState::PeriodicChange);
+  EXPECT_EQ(2u, index.QuerySphere(math::Vector3d::Zero, 2.0).size());
+
+  manager.RunUpdateSpatialIndex();
+  EXPECT_TRUE(index.QuerySphere(math::Vector3d::Zero, 2.0).empty());
+  EXPECT_EQ(std::vector<Entity>({model, nested}),
+      index.QuerySphere(math::Vector3d(50, 0, 0), 2.0));
+
+  // Removed models leave the index
+  manager.RunAdvanceChangeTick();
+  manager.RequestRemoveEntity(boxed);
+  manager.ProcessEntityRemovals();
+  manager.RunUpdateSpatialIndex();
+  EXPECT_FALSE(index.HasEntity(boxed));
+  EXPECT_EQ(2u, index.Size());
+}
+
+//////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(SetStateUpdatesInPlace))
+{
+  // Enough entities for the updates to be deserialized in parallel
+  const int count = 2000;
+  EntityComponentManager original;
+  std::vector<Entity> entities;
+  for (int i = 0; i < count; ++i)
+  {
+    entities.push_back(original.CreateEntity());
+    original.CreateComponent(entities.back(), components::IntComponent(i));
+  }
+
+  msgs::SerializedStateMap stateMapMsg;
+  original.State(stateMapMsg);
+  manager.SetState(stateMapMsg);
+
+  std::vector<const components::IntComponent *> comps;
+  for (auto entity : entities)
+    comps.push_back(manager.Component<components::IntComponent>(entity));
+
+  // Existing components are updated without being replaced
+  for (int i = 0; i < count; ++i)
+  {
+    original.SetComponentData<components::IntComponent>(entities[i],
+        i * 10);
+  }
+  stateMapMsg.Clear();
+  original.State(stateMapMsg);
+  manager.RunAdvanceChangeTick();
+  const auto tick = manager.ChangeTick();
+  manager.SetState(stateMapMsg);
+  for (int i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(comps[i],
+        manager.Component<components::IntComponent>(entities[i]));
+    EXPECT_EQ(i * 10, comps[i]->Data());
+  }
+  int changed = 0;
+  manager.EachChangedSince<components::IntComponent>(tick - 1u,
+      [&](const Entity &, const components::IntComponent *) -> bool
+      {
+        ++changed;
+        return true;
+      });
+  EXPECT_EQ(count, changed);
+
+  // Same with the vector message, where an entity listed twice ends up with
+  // the last value
+  for (int i = 0; i < count; ++i)
+  {
+    original.SetComponentData<components::IntComponent>(entities[i],
+        i * 100);
+  }
+  auto stateMsg = original.State();
+  auto extra = stateMsg.add_entities();
+  extra->CopyFrom(stateMsg.entities(0));
+  const Entity twice{extra->id()};
+  extra->mutable_components(0)->set_component("-5");
+  manager.SetState(stateMsg);
+  for (int i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(comps[i],
+        manager.Component<components::IntComponent>(entities[i]));
+    if (entities[i] == twice)
+      EXPECT_EQ(-5, comps[i]->Data());
+    else
+      EXPECT_EQ(i * 100, comps[i]->Data());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComponentHandles)
+{
+  // Empty handles never point to a component
+  ComponentHandle<IntComponent> empty;
+  EXPECT_FALSE(empty);
+  EXPECT_EQ(nullptr, empty.Get());
+  EXPECT_EQ(kNullEntity, empty.Owner());
+
+  auto entity = manager.CreateEntity();
+  auto other = manager.CreateEntity();
+
+  // The handle can be created before the component
+  auto handle = manager.Handle<IntComponent>(entity);
+  EXPECT_EQ(entity, handle.Owner());
+  EXPECT_FALSE(handle);
+
+  manager.CreateComponent(entity, IntComponent(1));
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(manager.Component<IntComponent>(entity), handle.Get());
+  EXPECT_EQ(1, handle->Data());
+
+  // Changes through the handle are seen by the manager and vice versa
+  handle->Data() = 2;
+  EXPECT_EQ(2, manager.Component<IntComponent>(entity)->Data());
+  manager.SetComponentData<IntComponent>(entity, 3);
+  EXPECT_EQ(3, handle->Data());
+
+  // Const managers give const handles
+  const EntityComponentManager &constManager = manager;
+  ComponentHandle<const IntComponent> constHandle =
+      constManager.Handle<IntComponent>(entity);
+  ASSERT_TRUE(constHandle);
+  EXPECT_EQ(3, constHandle->Data());
+
+  // Components of other entities don't affect the handle
+  manager.CreateComponent(other, IntComponent(10));
+  EXPECT_EQ(3, handle->Data());
+  EXPECT_TRUE(manager.RemoveComponent<IntComponent>(other));
+  EXPECT_EQ(3, handle->Data());
+
+  // Removing the component invalidates the handle, even though the
+  // instance is kept until the end of the step
+  EXPECT_TRUE(manager.RemoveComponent<IntComponent>(entity));
+  EXPECT_FALSE(handle);
+  EXPECT_FALSE(constHandle);
+
+  // Creating it again makes it valid again
+  manager.CreateComponent(entity, IntComponent(4));
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(4, handle->Data());
+  EXPECT_EQ(4, constHandle->Data());
+
+  // Removing the entity invalidates the handle
+  manager.RequestRemoveEntity(entity);
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.HasEntity(entity));
+  EXPECT_FALSE(handle);
+  EXPECT_EQ(nullptr, constHandle.Get());
+
+  // Writes through a mutable handle invalidate the name index
+  auto named = manager.CreateEntity();
+  manager.CreateComponent(named, components::Name("before"));
+  EXPECT_EQ(1u, manager.EntitiesByName("before").size());
+
+  auto nameHandle = manager.Handle<components::Name>(named);
+  ASSERT_TRUE(nameHandle);
+  nameHandle->Data() = "after";
+  EXPECT_TRUE(manager.EntitiesByName("before").empty());
+  ASSERT_EQ(1u, manager.EntitiesByName("after").size());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ComponentTypeGeneration)
+{
+  EXPECT_EQ(0u, manager.ComponentTypeGeneration(IntComponent::typeId));
+
+  auto entity = manager.CreateEntity();
+  manager.CreateComponent(entity, IntComponent(1));
+  const auto created = manager.ComponentTypeGeneration(IntComponent::typeId);
+  EXPECT_NE(0u, created);
+
+  // Changing data and other types don't change the generation
+  manager.SetComponentData<IntComponent>(entity, 2);
+  manager.CreateComponent(entity, DoubleComponent(0.5));
+  EXPECT_EQ(created, manager.ComponentTypeGeneration(IntComponent::typeId));
+
+  auto other = manager.CreateEntity();
+  manager.CreateComponent(other, IntComponent(3));
+  const auto added = manager.ComponentTypeGeneration(IntComponent::typeId);
+  EXPECT_NE(created, added);
+
+  EXPECT_TRUE(manager.RemoveComponent<IntComponent>(other));
+  EXPECT_NE(added, manager.ComponentTypeGeneration(IntComponent::typeId));
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, EntityIndices)
+{
+  EXPECT_EQ(0u, manager.IndexCount());
+  EXPECT_FALSE(manager.IndexOf(1).Valid());
+
+  auto e1 = manager.CreateEntity();
+  auto e2 = manager.CreateEntity();
+  EXPECT_EQ(2u, manager.IndexCount());
+
+  const auto index2 = manager.IndexOf(e2);
+  ASSERT_TRUE(index2.Valid());
+  EXPECT_LT(index2.index, manager.IndexCount());
+  EXPECT_EQ(e2, manager.EntityAt(index2));
+  EXPECT_NE(manager.IndexOf(e1).index, index2.index);
+
+  // Entity ids keep increasing, but the index of the removed entity is
+  // reused
+  manager.RequestRemoveEntity(e2);
+  manager.ProcessEntityRemovals();
+  EXPECT_FALSE(manager.IndexOf(e2).Valid());
+  EXPECT_EQ(kNullEntity, manager.EntityAt(index2));
+
+  auto e3 = manager.CreateEntity();
+  EXPECT_GT(e3, e2);
+  const auto index3 = manager.IndexOf(e3);
+  EXPECT_EQ(index2.index, index3.index);
+  EXPECT_NE(index2.generation, index3.generation);
+  EXPECT_EQ(e3, manager.EntityAt(index3));
+  EXPECT_EQ(kNullEntity, manager.EntityAt(index2));
+  EXPECT_EQ(2u, manager.IndexCount());
+
+  // The reused index doesn't carry over the removed entity's changes
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  manager.CreateComponent(e3, IntComponent(1));
+  EXPECT_EQ(1, manager.ChangedState().entities_size());
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityComponentManagerFixture, ConcurrentSetChanged)
+{
+  const int entityCount = 400;
+  const int threadCount = 4;
+
+  std::vector<Entity> entities;
+  for (int i = 0; i < entityCount; ++i)
+  {
+    Entity entity = manager.CreateEntity();
+    manager.CreateComponent(entity, IntComponent(i));
+    entities.push_back(entity);
+  }
+
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_EQ(0, manager.ChangedState().entities_size());
+
+  // Each thread marks a disjoint range of entities, some of them twice
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      const int begin = t * entityCount / threadCount;
+      const int end = (t + 1) * entityCount / threadCount;
+      for (int i = begin; i < end; ++i)
+      {
+        manager.SetChanged(entities[i], IntComponent::typeId,
+            ComponentState::OneTimeChange);
+        manager.SetChanged(entities[i], IntComponent::typeId,
+            ComponentState::PeriodicChange);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(entityCount, manager.ChangedState().entities_size());
+
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_EQ(0, manager.ChangedState().entities_size());
+
+  // An entity which is new and modified in the same step is reported once
+  Entity newEntity = manager.CreateEntity();
+  manager.CreateComponent(newEntity, IntComponent(1));
+  manager.SetChanged(newEntity, IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  manager.SetChanged(entities[0], IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  EXPECT_EQ(2, manager.ChangedState().entities_size());
+
+  // Modified entities which are removed are only reported as removed
+  manager.RequestRemoveEntity(entities[0]);
+  EXPECT_EQ(2, manager.ChangedState().entities_size());
+  manager.ProcessEntityRemovals();
+  manager.RunClearNewlyCreatedEntities();
+  manager.RunSetAllComponentsUnchanged();
+  EXPECT_EQ(0, manager.ChangedState().entities_size());
+
+  // Flags are reset, so entities can be marked again on the next step
+  manager.SetChanged(entities[1], IntComponent::typeId,
+      ComponentState::OneTimeChange);
+  EXPECT_EQ(1, manager.ChangedState().entities_size());
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_SUITE_P(EntityComponentManagerRepeat,
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/EntityComponentSnapshot.hh"
+
+#include <algorithm>
+
+#include "ignition/gazebo/components/Factory.hh"
+
+#include "EntityComponentSnapshotPrivate.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Returned for component types which aren't in a snapshot.
+static const std::vector<Entity> kNoEntities;
+
+//////////////////////////////////////////////////
+std::size_t SnapshotComponentTable::IndexOf(const Entity _entity) const
+{
+  auto it = std::lower_bound(this->entities.begin(), this->entities.end(),
+      _entity);
+  if (it == this->entities.end() || *it != _entity)
+    return this->entities.size();
+  return static_cast<std::size_t>(it - this->entities.begin());
+}
+
+//////////////////////////////////////////////////
+EntityComponentSnapshot::EntityComponentSnapshot()
+  : dataPtr(std::make_unique<EntityComponentSnapshotPrivate>())
+{
+  this->dataPtr->entities = std::make_shared<std::vector<Entity>>();
+}
+
+//////////////////////////////////////////////////
+EntityComponentSnapshot::~EntityComponentSnapshot() = default;
+
+//////////////////////////////////////////////////
+uint64_t EntityComponentSnapshot::ChangeTick() const
+{
+  return this->dataPtr->changeTick;
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &EntityComponentSnapshot::Entities() const
+{
+  return *this->dataPtr->entities;
+}
+
+//////////////////////////////////////////////////
+bool EntityComponentSnapshot::HasEntity(const Entity _entity) const
+{
+  return std::binary_search(this->dataPtr->entities->begin(),
+      this->dataPtr->entities->end(), _entity);
+}
+
+//////////////////////////////////////////////////
+const std::vector<Entity> &EntityComponentSnapshot::EntitiesWithComponent(
+    const ComponentTypeId _typeId) const
+{
+  auto it = this->dataPtr->tables.find(_typeId);
+  if (it == this->dataPtr->tables.end())
+    return kNoEntities;
+  return it->second->entities;
+}
+
+//////////////////////////////////////////////////
+const components::BaseComponent *
+    EntityComponentSnapshot::ComponentImplementation(const Entity _entity,
+    const ComponentTypeId _typeId) const
+{
+  auto it = this->dataPtr->tables.find(_typeId);
+  if (it == this->dataPtr->tables.end())
+    return nullptr;
+
+  const auto &table = *it->second;
+  const std::size_t index = table.IndexOf(_entity);
+  if (index == table.entities.size())
+    return nullptr;
+  return table.components[index].get();
+}
+
+//////////////////////////////////////////////////
+void EntityComponentSnapshot::State(msgs::SerializedStateMap &_state,
+    const std::size_t _begin, const std::size_t _end) const
+{
+  const auto &entities = *this->dataPtr->entities;
+  const std::size_t end = std::min(_end, entities.size());
+  if (_begin >= end)
+    return;
+
+  auto &entitiesMsg = *_state.mutable_entities();
+  for (std::size_t i = _begin; i < end; ++i)
+    entitiesMsg[static_cast<uint64_t>(entities[i])].set_id(entities[i]);
+
+  // Entities are sorted in every table too, so the range is contiguous
+  const Entity first = entities[_begin];
+  const Entity last = entities[end - 1];
+  for (const auto &typeTable : this->dataPtr->tables)
+  {
+    const ComponentTypeId type = typeTable.first;
+    const auto &table = *typeTable.second;
+    auto it = std::lower_bound(table.entities.begin(), table.entities.end(),
+        first);
+    for (; it != table.entities.end() && *it <= last; ++it)
+    {
+      const auto &comp = table.components[
+          static_cast<std::size_t>(it - table.entities.begin())];
+      auto &compMsg = (*entitiesMsg[static_cast<uint64_t>(*it)]
+          .mutable_components())[static_cast<int64_t>(type)];
+      compMsg.set_type(type);
+      compMsg.clear_component();
+      components::ComponentBufferSerializer::Serialize(*comp,
+          *compMsg.mutable_component());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityComponentSnapshot::ComponentCount() const
+{
+  return this->dataPtr->componentCount;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityComponentSnapshot::CopiedComponentCount() const
+{
+  return this->dataPtr->copiedCount;
+}
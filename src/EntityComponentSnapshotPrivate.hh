@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYCOMPONENTSNAPSHOTPRIVATE_HH_
+#define IGNITION_GAZEBO_ENTITYCOMPONENTSNAPSHOTPRIVATE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ignition/gazebo/components/Component.hh"
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Types.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Copies of all the components of one type in a snapshot.
+    /// Tables are immutable once built, so they can be shared between
+    /// snapshots.
+    class SnapshotComponentTable
+    {
+      /// \brief Entities which have the component, sorted by id.
+      public: std::vector<Entity> entities;
+
+      /// \brief Component of the entity at the same index in `entities`.
+      /// Components are shared between the tables of successive snapshots
+      /// for as long as they don't change.
+      public: std::vector<std::shared_ptr<const components::BaseComponent>>
+              components;
+
+      /// \brief Get the index of an entity.
+      /// \param[in] _entity Entity.
+      /// \return Index in `entities`, or the size of `entities` if the
+      /// entity isn't in the table.
+      public: std::size_t IndexOf(const Entity _entity) const;
+    };
+
+    /// \brief Private data of EntityComponentSnapshot.
+    class EntityComponentSnapshotPrivate
+    {
+      /// \brief Change tick of the manager when the snapshot was taken.
+      public: uint64_t changeTick{0u};
+
+      /// \brief All entities, sorted by id. Shared with the previous
+      /// snapshot if no entity was added or removed.
+      public: std::shared_ptr<const std::vector<Entity>> entities;
+
+      /// \brief Table of each component type.
+      public: std::unordered_map<ComponentTypeId,
+              std::shared_ptr<const SnapshotComponentTable>> tables;
+
+      /// \brief Total number of components.
+      public: std::size_t componentCount{0u};
+
+      /// \brief Number of components copied from the manager.
+      public: std::size_t copiedCount{0u};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "EntityHierarchy.hh"
+
+#include <algorithm>
+
+#include "MemoryEstimate.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::Add(const Entity _entity)
+{
+  if (kNullEntity == _entity || this->slots.find(_entity) != this->slots.end())
+    return false;
+
+  Slot slot;
+  if (!this->freeSlots.empty())
+  {
+    // Freed nodes are already reset
+    slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+  }
+  else
+  {
+    slot = static_cast<Slot>(this->nodes.size());
+    this->nodes.emplace_back();
+  }
+  this->nodes[slot].entity = _entity;
+  this->slots[_entity] = slot;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::Remove(const Entity _entity)
+{
+  auto it = this->slots.find(_entity);
+  if (it == this->slots.end())
+    return false;
+
+  const Slot slot = it->second;
+  this->Detach(slot);
+
+  auto &node = this->nodes[slot];
+  for (auto child = node.firstChild; child != kNoSlot;)
+  {
+    auto &childNode = this->nodes[child];
+    const Slot next = childNode.nextSibling;
+    childNode.parent = kNoSlot;
+    childNode.prevSibling = kNoSlot;
+    childNode.nextSibling = kNoSlot;
+    child = next;
+  }
+
+  this->Free(slot);
+  this->slots.erase(it);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Free(const Slot _slot)
+{
+  auto &node = this->nodes[_slot];
+  const uint32_t generation = node.generation + 1u;
+  node = Node();
+  node.generation = generation;
+  this->freeSlots.push_back(_slot);
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Clear()
+{
+  // Lower nodes are reused first
+  this->freeSlots.clear();
+  for (Slot slot = static_cast<Slot>(this->nodes.size()); slot > 0u; --slot)
+  {
+    if (this->nodes[slot - 1u].entity != kNullEntity)
+    {
+      this->Free(slot - 1u);
+    }
+    else
+    {
+      this->freeSlots.push_back(slot - 1u);
+    }
+  }
+  this->slots.clear();
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::Has(const Entity _entity) const
+{
+  return this->slots.find(_entity) != this->slots.end();
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityHierarchy::Size() const
+{
+  return this->slots.size();
+}
+
+//////////////////////////////////////////////////
+Entity EntityHierarchy::Parent(const Entity _entity) const
+{
+  auto it = this->slots.find(_entity);
+  if (it == this->slots.end())
+    return kNullEntity;
+
+  const Slot parent = this->nodes[it->second].parent;
+  return parent == kNoSlot ? kNullEntity : this->nodes[parent].entity;
+}
+
+//////////////////////////////////////////////////
+bool EntityHierarchy::SetParent(const Entity _child, const Entity _parent)
+{
+  auto childIt = this->slots.find(_child);
+  if (childIt == this->slots.end())
+    return false;
+
+  const Slot slot = childIt->second;
+  this->Detach(slot);
+
+  if (kNullEntity == _parent)
+    return true;
+
+  auto parentIt = this->slots.find(_parent);
+  if (parentIt == this->slots.end())
+    return false;
+
+  // Keep the children sorted. Look for the insertion point from the back,
+  // since children are usually added in order of creation.
+  const Slot parentSlot = parentIt->second;
+  auto &parentNode = this->nodes[parentSlot];
+  Slot prev = parentNode.lastChild;
+  while (prev != kNoSlot && this->nodes[prev].entity > _child)
+    prev = this->nodes[prev].prevSibling;
+
+  auto &node = this->nodes[slot];
+  node.parent = parentSlot;
+  node.prevSibling = prev;
+  if (prev == kNoSlot)
+  {
+    node.nextSibling = parentNode.firstChild;
+    parentNode.firstChild = slot;
+  }
+  else
+  {
+    node.nextSibling = this->nodes[prev].nextSibling;
+    this->nodes[prev].nextSibling = slot;
+  }
+
+  if (node.nextSibling == kNoSlot)
+    parentNode.lastChild = slot;
+  else
+    this->nodes[node.nextSibling].prevSibling = slot;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Detach(const Slot _slot)
+{
+  auto &node = this->nodes[_slot];
+  if (node.parent == kNoSlot)
+    return;
+
+  auto &parentNode = this->nodes[node.parent];
+  if (node.prevSibling == kNoSlot)
+    parentNode.firstChild = node.nextSibling;
+  else
+    this->nodes[node.prevSibling].nextSibling = node.nextSibling;
+
+  if (node.nextSibling == kNoSlot)
+    parentNode.lastChild = node.prevSibling;
+  else
+    this->nodes[node.nextSibling].prevSibling = node.prevSibling;
+
+  node.parent = kNoSlot;
+  node.prevSibling = kNoSlot;
+  node.nextSibling = kNoSlot;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Children(const Entity _entity) const
+{
+  std::vector<Entity> children;
+  this->EachChild(_entity, [&](const Entity _child)
+  {
+    children.push_back(_child);
+  });
+  return children;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Entities() const
+{
+  std::vector<Entity> entities;
+  entities.reserve(this->slots.size());
+  for (const auto &node : this->nodes)
+  {
+    if (kNullEntity != node.entity)
+      entities.push_back(node.entity);
+  }
+  std::sort(entities.begin(), entities.end());
+  return entities;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Subtree(const Entity _entity) const
+{
+  std::vector<Entity> subtree;
+  auto it = this->slots.find(_entity);
+  if (it == this->slots.end())
+    return subtree;
+
+  // Each node has a single parent, so the only node which can be reached
+  // twice is the top one, when it's part of a cycle
+  const Slot top = it->second;
+  std::vector<Slot> stack{top};
+  while (!stack.empty())
+  {
+    const Slot slot = stack.back();
+    stack.pop_back();
+    subtree.push_back(this->nodes[slot].entity);
+
+    // Push in reverse, so that children are visited in order
+    for (auto child = this->nodes[slot].lastChild; child != kNoSlot;
+         child = this->nodes[child].prevSibling)
+    {
+      if (child != top)
+        stack.push_back(child);
+    }
+  }
+  return subtree;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> EntityHierarchy::Roots() const
+{
+  std::vector<Entity> roots;
+  for (const auto &node : this->nodes)
+  {
+    if (kNullEntity != node.entity && node.parent == kNoSlot)
+      roots.push_back(node.entity);
+  }
+  std::sort(roots.begin(), roots.end());
+  return roots;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityHierarchy::MemoryUsage() const
+{
+  // Each entry of the map is a list node holding the pair and the next
+  // pointer, plus a bucket pointer
+  const std::size_t slotBytes =
+      this->slots.bucket_count() * sizeof(void *) +
+      this->slots.size() * (sizeof(void *) +
+          sizeof(std::pair<const Entity, Slot>));
+  return this->nodes.capacity() * sizeof(Node) +
+      this->freeSlots.capacity() * sizeof(Slot) + slotBytes;
+}
+
+//////////////////////////////////////////////////
+void EntityHierarchy::Compact()
+{
+  compactHash(this->slots);
+}
+
+//////////////////////////////////////////////////
+EntityIndex EntityHierarchy::IndexOf(const Entity _entity) const
+{
+  auto it = this->slots.find(_entity);
+  if (it == this->slots.end())
+    return EntityIndex();
+  return {it->second, this->nodes[it->second].generation};
+}
+
+//////////////////////////////////////////////////
+Entity EntityHierarchy::EntityAt(const EntityIndex &_index) const
+{
+  if (_index.index >= this->nodes.size())
+    return kNullEntity;
+  const auto &node = this->nodes[_index.index];
+  return node.generation == _index.generation ? node.entity : kNullEntity;
+}
+
+//////////////////////////////////////////////////
+std::size_t EntityHierarchy::IndexCount() const
+{
+  return this->nodes.size();
+}
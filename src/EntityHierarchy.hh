@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ENTITYHIERARCHY_HH_
+#define IGNITION_GAZEBO_ENTITYHIERARCHY_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class EntityHierarchy EntityHierarchy.hh
+    /// \brief Compact storage of the parenting of entities, where each
+    /// entity has at most one parent.
+    ///
+    /// Entities are kept in a packed array of nodes. Each node holds the
+    /// index of its parent, of its first and last children and of its
+    /// previous and next siblings, so that adding, removing and reparenting
+    /// entities doesn't allocate once the array has grown, and walking the
+    /// hierarchy doesn't go through any lookup. The children of each entity
+    /// are kept sorted by id. Entities are created with increasing ids, so
+    /// new children are usually appended in constant time.
+    ///
+    /// The hierarchy doesn't prevent cycles, but none of the queries loop
+    /// forever on them.
+    ///
+    /// The index of each entity's node is also its compact index, see
+    /// EntityIndex. Nodes of removed entities are reused by later entities,
+    /// and the generation of a node is increased each time it's freed.
+    class IGNITION_GAZEBO_VISIBLE EntityHierarchy
+    {
+      /// \brief Add an entity without a parent.
+      /// \param[in] _entity Entity to add.
+      /// \return False if the entity is null or already in the hierarchy.
+      public: bool Add(const Entity _entity);
+
+      /// \brief Remove an entity. Its children are left without a parent.
+      /// \param[in] _entity Entity to remove.
+      /// \return False if the entity isn't in the hierarchy.
+      public: bool Remove(const Entity _entity);
+
+      /// \brief Remove all entities. Memory is kept, to be reused by later
+      /// entities, and the generations of all nodes are increased.
+      public: void Clear();
+
+      /// \brief Get whether an entity is in the hierarchy.
+      /// \param[in] _entity Entity to look for.
+      /// \return True if the entity is in the hierarchy.
+      public: bool Has(const Entity _entity) const;
+
+      /// \brief Get the number of entities in the hierarchy.
+      /// \return Number of entities.
+      public: std::size_t Size() const;
+
+      /// \brief Get the parent of an entity.
+      /// \param[in] _entity Child entity.
+      /// \return The parent, or kNullEntity if the entity has no parent or
+      /// isn't in the hierarchy.
+      public: Entity Parent(const Entity _entity) const;
+
+      /// \brief Set the parent of an entity. The entity is detached from
+      /// its current parent first, even if the new parent is missing.
+      /// \param[in] _child Child entity.
+      /// \param[in] _parent New parent, or kNullEntity to leave the child
+      /// without a parent.
+      /// \return False if the child or the parent isn't in the hierarchy.
+      public: bool SetParent(const Entity _child, const Entity _parent);
+
+      /// \brief Get the children of an entity.
+      /// \param[in] _entity Parent entity.
+      /// \return Children sorted by id, empty if the entity isn't in the
+      /// hierarchy.
+      public: std::vector<Entity> Children(const Entity _entity) const;
+
+      /// \brief Call a function for each child of an entity, in order of id.
+      /// \param[in] _entity Parent entity.
+      /// \param[in] _f Function called with each child.
+      /// \tparam F Function type, taking an Entity.
+      public: template <typename F>
+              void EachChild(const Entity _entity, F &&_f) const
+      {
+        auto it = this->slots.find(_entity);
+        if (it == this->slots.end())
+          return;
+        for (auto child = this->nodes[it->second].firstChild;
+             child != kNoSlot; child = this->nodes[child].nextSibling)
+        {
+          _f(this->nodes[child].entity);
+        }
+      }
+
+      /// \brief Get all entities.
+      /// \return Entities sorted by id.
+      public: std::vector<Entity> Entities() const;
+
+      /// \brief Get an entity and all its descendants, in depth first
+      /// order, so that each entity comes before its descendants. Entities
+      /// in a cycle are only visited once.
+      /// \param[in] _entity Top entity.
+      /// \return The entity followed by its descendants, empty if it isn't
+      /// in the hierarchy.
+      public: std::vector<Entity> Subtree(const Entity _entity) const;
+
+      /// \brief Get the entities which don't have a parent.
+      /// \return Root entities sorted by id.
+      public: std::vector<Entity> Roots() const;
+
+      /// \brief Estimate the memory used by the hierarchy.
+      /// \return Number of bytes.
+      public: std::size_t MemoryUsage() const;
+
+      /// \brief Shrink the entity lookup if it uses much less memory than
+      /// it holds. Nodes are kept, so that indices keep their generations.
+      public: void Compact();
+
+      /// \brief Get the compact index of an entity.
+      /// \param[in] _entity Entity to look for.
+      /// \return Index and generation of the entity's node, or an invalid
+      /// index if the entity isn't in the hierarchy.
+      public: EntityIndex IndexOf(const Entity _entity) const;
+
+      /// \brief Get the entity which has a compact index.
+      /// \param[in] _index Compact index.
+      /// \return The entity, or kNullEntity if no entity has the index,
+      /// including when the generation doesn't match because the entity
+      /// which had it was removed.
+      public: Entity EntityAt(const EntityIndex &_index) const;
+
+      /// \brief Get the number of nodes, including free ones. Compact
+      /// indices are smaller than this.
+      /// \return Number of nodes.
+      public: std::size_t IndexCount() const;
+
+      /// \brief Index of a node in the packed array.
+      private: using Slot = uint32_t;
+
+      /// \brief Marks a missing node.
+      private: static constexpr Slot kNoSlot{EntityIndex::kInvalid};
+
+      /// \brief Node of the hierarchy.
+      private: struct Node
+      {
+        /// \brief Entity of the node, kNullEntity for free nodes.
+        Entity entity{kNullEntity};
+
+        /// \brief Parent node.
+        Slot parent{kNoSlot};
+
+        /// \brief First child node.
+        Slot firstChild{kNoSlot};
+
+        /// \brief Last child node.
+        Slot lastChild{kNoSlot};
+
+        /// \brief Previous sibling node.
+        Slot prevSibling{kNoSlot};
+
+        /// \brief Next sibling node.
+        Slot nextSibling{kNoSlot};
+
+        /// \brief Number of times the node was freed.
+        uint32_t generation{0u};
+      };
+
+      /// \brief Free a node, keeping its generation increased.
+      /// \param[in] _slot Node to free.
+      private: void Free(const Slot _slot);
+
+      /// \brief Unlink a node from its parent's children.
+      /// \param[in] _slot Node to unlink.
+      private: void Detach(const Slot _slot);
+
+      /// \brief Packed array of nodes.
+      private: std::vector<Node> nodes;
+
+      /// \brief Free nodes, to be reused by later entities.
+      private: std::vector<Slot> freeSlots;
+
+      /// \brief Node of each entity.
+      private: std::unordered_map<Entity, Slot> slots;
+    };
+    }
+  }
+}
+#endif
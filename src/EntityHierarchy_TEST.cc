@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "EntityHierarchy.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchyTest, AddRemove)
+{
+  EntityHierarchy hierarchy;
+  EXPECT_EQ(0u, hierarchy.Size());
+  EXPECT_FALSE(hierarchy.Has(1));
+  EXPECT_FALSE(hierarchy.Remove(1));
+
+  EXPECT_TRUE(hierarchy.Add(3));
+  EXPECT_TRUE(hierarchy.Add(1));
+  EXPECT_TRUE(hierarchy.Add(2));
+  EXPECT_FALSE(hierarchy.Add(2));
+  EXPECT_FALSE(hierarchy.Add(kNullEntity));
+  EXPECT_EQ(3u, hierarchy.Size());
+  EXPECT_TRUE(hierarchy.Has(2));
+  EXPECT_EQ((std::vector<Entity>{1, 2, 3}), hierarchy.Entities());
+
+  EXPECT_TRUE(hierarchy.Remove(2));
+  EXPECT_FALSE(hierarchy.Has(2));
+  EXPECT_EQ((std::vector<Entity>{1, 3}), hierarchy.Entities());
+
+  // The freed node is reused
+  EXPECT_TRUE(hierarchy.Add(4));
+  EXPECT_EQ((std::vector<Entity>{1, 3, 4}), hierarchy.Entities());
+  EXPECT_LT(0u, hierarchy.MemoryUsage());
+
+  hierarchy.Clear();
+  EXPECT_EQ(0u, hierarchy.Size());
+  EXPECT_TRUE(hierarchy.Entities().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchyTest, Parenting)
+{
+  EntityHierarchy hierarchy;
+  for (Entity entity = 1; entity <= 7; ++entity)
+    EXPECT_TRUE(hierarchy.Add(entity));
+
+  /*
+   *        1
+   *      /   \
+   *     2     3
+   *  / / \ \
+   * 4 5   6 7
+   */
+  EXPECT_TRUE(hierarchy.SetParent(2, 1));
+  EXPECT_TRUE(hierarchy.SetParent(3, 1));
+  // Out of order, children are still sorted
+  EXPECT_TRUE(hierarchy.SetParent(6, 2));
+  EXPECT_TRUE(hierarchy.SetParent(4, 2));
+  EXPECT_TRUE(hierarchy.SetParent(7, 2));
+  EXPECT_TRUE(hierarchy.SetParent(5, 2));
+
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(1));
+  EXPECT_EQ(1u, hierarchy.Parent(2));
+  EXPECT_EQ(2u, hierarchy.Parent(5));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(100));
+  EXPECT_EQ((std::vector<Entity>{2, 3}), hierarchy.Children(1));
+  EXPECT_EQ((std::vector<Entity>{4, 5, 6, 7}), hierarchy.Children(2));
+  EXPECT_TRUE(hierarchy.Children(3).empty());
+  EXPECT_TRUE(hierarchy.Children(100).empty());
+  EXPECT_EQ((std::vector<Entity>{1}), hierarchy.Roots());
+  EXPECT_EQ((std::vector<Entity>{1, 2, 4, 5, 6, 7, 3}),
+      hierarchy.Subtree(1));
+  EXPECT_EQ((std::vector<Entity>{2, 4, 5, 6, 7}), hierarchy.Subtree(2));
+  EXPECT_TRUE(hierarchy.Subtree(100).empty());
+
+  // Missing entities
+  EXPECT_FALSE(hierarchy.SetParent(100, 1));
+  EXPECT_FALSE(hierarchy.SetParent(7, 100));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(7));
+
+  // Reparent and detach
+  EXPECT_TRUE(hierarchy.SetParent(5, 3));
+  EXPECT_TRUE(hierarchy.SetParent(4, kNullEntity));
+  EXPECT_EQ((std::vector<Entity>{6}), hierarchy.Children(2));
+  EXPECT_EQ((std::vector<Entity>{5}), hierarchy.Children(3));
+  EXPECT_EQ((std::vector<Entity>{1, 4, 7}), hierarchy.Roots());
+
+  // Removing a parent leaves its children without a parent
+  EXPECT_TRUE(hierarchy.Remove(2));
+  EXPECT_EQ(kNullEntity, hierarchy.Parent(6));
+  EXPECT_EQ((std::vector<Entity>{3}), hierarchy.Children(1));
+  EXPECT_EQ((std::vector<Entity>{1, 4, 6, 7}), hierarchy.Roots());
+
+  std::vector<Entity> children;
+  hierarchy.EachChild(1, [&](const Entity _child)
+  {
+    children.push_back(_child);
+  });
+  EXPECT_EQ((std::vector<Entity>{3}), children);
+}
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchyTest, Cycle)
+{
+  EntityHierarchy hierarchy;
+  for (Entity entity = 1; entity <= 3; ++entity)
+    EXPECT_TRUE(hierarchy.Add(entity));
+
+  EXPECT_TRUE(hierarchy.SetParent(2, 1));
+  EXPECT_TRUE(hierarchy.SetParent(3, 2));
+  EXPECT_TRUE(hierarchy.SetParent(1, 3));
+
+  EXPECT_TRUE(hierarchy.Roots().empty());
+  EXPECT_EQ((std::vector<Entity>{1, 2, 3}), hierarchy.Subtree(1));
+  EXPECT_EQ((std::vector<Entity>{2, 3, 1}), hierarchy.Subtree(2));
+}
+
+/////////////////////////////////////////////////
+TEST(EntityHierarchyTest, Indices)
+{
+  EntityHierarchy hierarchy;
+  EXPECT_FALSE(hierarchy.IndexOf(1).Valid());
+  EXPECT_EQ(kNullEntity, hierarchy.EntityAt(EntityIndex()));
+
+  for (Entity entity = 1; entity <= 3; ++entity)
+    EXPECT_TRUE(hierarchy.Add(entity));
+  EXPECT_EQ(3u, hierarchy.IndexCount());
+
+  const auto index2 = hierarchy.IndexOf(2);
+  ASSERT_TRUE(index2.Valid());
+  EXPECT_EQ(1u, index2.index);
+  EXPECT_EQ(2u, hierarchy.EntityAt(index2));
+
+  // The index of a removed entity is reused with a new generation
+  EXPECT_TRUE(hierarchy.Remove(2));
+  EXPECT_FALSE(hierarchy.IndexOf(2).Valid());
+  EXPECT_EQ(kNullEntity, hierarchy.EntityAt(index2));
+
+  EXPECT_TRUE(hierarchy.Add(4));
+  const auto index4 = hierarchy.IndexOf(4);
+  EXPECT_EQ(index2.index, index4.index);
+  EXPECT_NE(index2, index4);
+  EXPECT_EQ(kNullEntity, hierarchy.EntityAt(index2));
+  EXPECT_EQ(4u, hierarchy.EntityAt(index4));
+  EXPECT_EQ(3u, hierarchy.IndexCount());
+
+  // Clearing keeps the indices, and lower ones are reused first
+  const auto index1 = hierarchy.IndexOf(1);
+  hierarchy.Clear();
+  EXPECT_EQ(kNullEntity, hierarchy.EntityAt(index1));
+  EXPECT_TRUE(hierarchy.Add(5));
+  EXPECT_EQ(0u, hierarchy.IndexOf(5).index);
+  EXPECT_NE(index1, hierarchy.IndexOf(5));
+  EXPECT_EQ(3u, hierarchy.IndexCount());
+}
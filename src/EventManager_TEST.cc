@@ -119,3 +119,48 @@ TEST(EventManager, Disambiguate)
   EXPECT_EQ(1, calls);
 }
 
+
+/////////////////////////////////////////////////
+TEST(EventManager, Channel)
+{
+  EventManager eventManager;
+
+  using TestEvent = ignition::common::EventT<void(int, int &)>;
+
+  // The channel is resolved before anything connects
+  auto channel = eventManager.Channel<TestEvent>();
+  EXPECT_TRUE(channel.Valid());
+  EXPECT_FALSE(channel.Connected());
+
+  int total{0};
+  channel.Emit(1, total);
+
+  auto connection = eventManager.Connect<TestEvent>(
+      [](int _value, int &_total)
+      {
+        _total += _value;
+      });
+  EXPECT_TRUE(channel.Connected());
+
+  // The channel, and emitting through the manager, reach the same event
+  channel.Emit(2, total);
+  EXPECT_EQ(2, total);
+  eventManager.Emit<TestEvent>(3, total);
+  EXPECT_EQ(5, total);
+
+  // Arguments taken by reference reach the callbacks
+  int totalA{0}, totalB{0};
+  std::vector<std::tuple<int, int &>> batch{
+      {1, totalA}, {2, totalB}, {3, totalA}};
+  channel.EmitBatch(batch.begin(), batch.end());
+  EXPECT_EQ(4, totalA);
+  EXPECT_EQ(2, totalB);
+
+  // An invalid channel emits nothing
+  EventManager::EventChannel<TestEvent> invalid;
+  EXPECT_FALSE(invalid.Valid());
+  EXPECT_FALSE(invalid.Connected());
+  invalid.Emit(10, total);
+  invalid.EmitBatch(batch.begin(), batch.end());
+  EXPECT_EQ(5, total);
+}
@@ -18,21 +18,31 @@
 #include "LevelManager.hh"
 
 #include <algorithm>
+#include <cmath>
 
 #include <sdf/Actor.hh>
 #include <sdf/Atmosphere.hh>
+#include <sdf/Collision.hh>
 #include <sdf/Light.hh>
+#include <sdf/Link.hh>
+#include <sdf/Mesh.hh>
 #include <sdf/Model.hh>
+#include <sdf/Visual.hh>
 #include <sdf/World.hh>
 
 #include <ignition/math/SphericalCoordinates.hh>
+#include <ignition/msgs/serialized_map.pb.h>
 #include <ignition/common/Profiler.hh>
 
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/MeshCache.hh"
+#include "ignition/gazebo/SpatialIndex.hh"
+#include "ignition/gazebo/Util.hh"
 
 #include "ignition/gazebo/components/Actor.hh"
 #include "ignition/gazebo/components/Atmosphere.hh"
+#include "ignition/gazebo/components/Dormant.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Gravity.hh"
 #include "ignition/gazebo/components/Level.hh"
@@ -53,6 +63,7 @@
 #include "ignition/gazebo/components/RenderEngineGuiPlugin.hh"
 #include "ignition/gazebo/components/RenderEngineServerHeadless.hh"
 #include "ignition/gazebo/components/RenderEngineServerPlugin.hh"
+#include "ignition/gazebo/components/RenderThreadAffinity.hh"
 #include "ignition/gazebo/components/Scene.hh"
 #include "ignition/gazebo/components/SphericalCoordinates.hh"
 #include "ignition/gazebo/components/Wind.hh"
@@ -63,6 +74,9 @@
 using namespace ignition;
 using namespace gazebo;
 
+/// \brief Maximum number of meshes prefetched on each step.
+static constexpr std::size_t kMaxPrefetchedMeshesPerStep{1u};
+
 /////////////////////////////////////////////////
 LevelManager::LevelManager(SimulationRunner *_runner, const bool _useLevels)
     : runner(_runner), useLevels(_useLevels)
@@ -158,6 +172,22 @@ void LevelManager::ReadLevelPerformerInfo()
       components::RenderEngineGuiPlugin(
       this->runner->serverConfig.RenderEngineGui()));
 
+  // The rendering thread is started by a system, which may be loaded on the
+  // simulation thread, so it's given the unrestricted cores if it has none of
+  // its own but the simulation thread does.
+  auto renderCores = this->runner->serverConfig.ThreadAffinity(
+      ServerConfig::ThreadGroup::kRendering);
+  if (renderCores.empty() && !this->runner->serverConfig.ThreadAffinity(
+      ServerConfig::ThreadGroup::kSimulation).empty())
+  {
+    renderCores = this->runner->unrestrictedCores;
+  }
+  if (!renderCores.empty())
+  {
+    this->runner->entityCompMgr.CreateComponent(this->worldEntity,
+        components::RenderThreadAffinity(renderCores));
+  }
+
   auto worldElem = this->runner->sdfWorld->Element();
 
   // Create Wind
@@ -222,8 +252,12 @@ void LevelManager::ReadLevelPerformerInfo()
   else
   {
     this->ReadPerformers(pluginElem);
+    this->ReadSimulationLod(pluginElem);
     if (this->useLevels)
+    {
       this->ReadLevels(pluginElem);
+      this->ReadLevelPolicy(pluginElem);
+    }
   }
 
   this->ConfigureDefaultLevel();
@@ -437,6 +471,282 @@ void LevelManager::ReadLevels(const sdf::ElementPtr &_sdf)
         levelEntity, components::LevelBuffer(buffer));
 
     this->entityCreator->SetParent(levelEntity, this->worldEntity);
+
+    const auto halfSize = geometry.BoxShape()->Size() / 2;
+    LevelRegion levelRegion;
+    levelRegion.entity = levelEntity;
+    levelRegion.region = math::AxisAlignedBox(pose.Pos() - halfSize,
+        pose.Pos() + halfSize);
+    levelRegion.outerRegion = math::AxisAlignedBox(
+        pose.Pos() - (halfSize + buffer), pose.Pos() + (halfSize + buffer));
+    this->levelRegions.push_back(levelRegion);
+  }
+
+  this->IndexLevels();
+}
+
+/////////////////////////////////////////////////
+void LevelManager::ReadLevelPolicy(const sdf::ElementPtr &_sdf)
+{
+  if (_sdf == nullptr || !_sdf->HasElement("level_policy"))
+    return;
+
+  auto policy = _sdf->GetElement("level_policy");
+
+  this->lookahead = policy->Get<double>("lookahead", 0.0).first;
+  if (this->lookahead < 0)
+  {
+    ignwarn << "The <lookahead> of the level policy cannot be a negative "
+            << "number. Setting to 0.0\n";
+    this->lookahead = 0.0;
+  }
+
+  const int maxEntities = policy->Get<int>("max_loaded_entities", 0).first;
+  if (maxEntities < 0)
+  {
+    ignwarn << "The <max_loaded_entities> of the level policy cannot be a "
+            << "negative number. Setting to 0\n";
+  }
+  else
+  {
+    this->maxLoadedEntities = static_cast<std::size_t>(maxEntities);
+  }
+
+  igndbg << "Level policy: lookahead [" << this->lookahead
+         << "s], max loaded entities [" << this->maxLoadedEntities << "]\n";
+}
+
+/////////////////////////////////////////////////
+void LevelManager::ReadSimulationLod(const sdf::ElementPtr &_sdf)
+{
+  if (_sdf == nullptr || !_sdf->HasElement("simulation_lod"))
+    return;
+
+  auto lod = _sdf->GetElement("simulation_lod");
+
+  this->dormantDistance = lod->Get<double>("dormant_distance", 0.0).first;
+  if (this->dormantDistance < 0)
+  {
+    ignwarn << "The <dormant_distance> of the simulation LOD cannot be a "
+            << "negative number. Disabling the simulation LOD.\n";
+    this->dormantDistance = 0.0;
+    return;
+  }
+
+  this->wakeDistance = lod->Get<double>("wake_distance",
+      0.9 * this->dormantDistance).first;
+  if (this->wakeDistance < 0 || this->wakeDistance > this->dormantDistance)
+  {
+    ignwarn << "The <wake_distance> of the simulation LOD must be between 0 "
+            << "and the <dormant_distance>. Setting to the "
+            << "<dormant_distance>.\n";
+    this->wakeDistance = this->dormantDistance;
+  }
+
+  this->freezeDormant = lod->Get<bool>("freeze", true).first;
+
+  igndbg << "Simulation LOD: dormant distance [" << this->dormantDistance
+         << "m], wake distance [" << this->wakeDistance << "m], freeze ["
+         << this->freezeDormant << "]\n";
+}
+
+/////////////////////////////////////////////////
+void LevelManager::UpdateDormantModels()
+{
+  if (this->dormantDistance <= 0.0)
+    return;
+
+  IGN_PROFILE("LevelManager::UpdateDormantModels");
+
+  auto &ecm = this->runner->entityCompMgr;
+
+  // Performer models and their positions
+  std::set<Entity> performerModels;
+  std::vector<math::Vector3d> performerPositions;
+  ecm.Each<components::Performer, components::ParentEntity>(
+      [&](const Entity &, const components::Performer *,
+          const components::ParentEntity *_parent) -> bool
+      {
+        auto pose = ecm.Component<components::Pose>(_parent->Data());
+        if (nullptr == pose)
+          return true;
+        performerModels.insert(_parent->Data());
+        performerPositions.push_back(pose->Data().Pos());
+        return true;
+      });
+
+  // Without performers, there's nothing to measure the distance to
+  if (performerPositions.empty())
+    return;
+
+  const double dormantSquared = this->dormantDistance * this->dormantDistance;
+  const double wakeSquared = this->wakeDistance * this->wakeDistance;
+
+  std::vector<Entity> toSuspend;
+  std::vector<Entity> toWake;
+  ecm.Each<components::Model, components::ParentEntity, components::Pose>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::ParentEntity *_parent,
+          const components::Pose *_pose) -> bool
+      {
+        if (_parent->Data() != this->worldEntity ||
+            performerModels.find(_entity) != performerModels.end())
+        {
+          return true;
+        }
+
+        double nearest = math::INF_D;
+        for (const auto &position : performerPositions)
+        {
+          nearest = std::min(nearest,
+              (position - _pose->Data().Pos()).SquaredLength());
+        }
+
+        const bool dormant = nullptr != ecm.Component<components::Dormant>(
+            _entity);
+        if (!dormant && nearest > dormantSquared)
+          toSuspend.push_back(_entity);
+        else if (dormant && nearest < wakeSquared)
+          toWake.push_back(_entity);
+        return true;
+      });
+
+  for (const auto &entity : toSuspend)
+  {
+    igndbg << "Model [" << entity << "] is dormant" << std::endl;
+    ecm.CreateComponent(entity, components::Dormant(this->freezeDormant));
+  }
+  for (const auto &entity : toWake)
+  {
+    igndbg << "Model [" << entity << "] woke up" << std::endl;
+    ecm.RemoveComponent<components::Dormant>(entity);
+  }
+}
+
+/////////////////////////////////////////////////
+math::AxisAlignedBox LevelManager::LookaheadVolume(const Entity _perfEntity,
+    const math::AxisAlignedBox &_volume)
+{
+  const auto simTime = this->runner->currentInfo.simTime;
+  const auto center = _volume.Center();
+
+  auto inserted = this->performerMotion.insert(
+      {_perfEntity, PerformerMotion{center, simTime, math::Vector3d::Zero}});
+  auto &motion = inserted.first->second;
+  if (!inserted.second)
+  {
+    const double dt =
+        std::chrono::duration<double>(simTime - motion.simTime).count();
+
+    // Keep the last estimate while paused, and forget it on jumps back
+    if (dt > 0.0)
+      motion.velocity = (center - motion.position) / dt;
+    else if (dt < 0.0)
+      motion.velocity = math::Vector3d::Zero;
+
+    motion.position = center;
+    motion.simTime = simTime;
+  }
+
+  const auto offset = motion.velocity * this->lookahead;
+  auto min = _volume.Min();
+  auto max = _volume.Max();
+  min.Min(_volume.Min() + offset);
+  max.Max(_volume.Max() + offset);
+  return math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+void LevelManager::ApplyLevelBudget(std::vector<Entity> &_levelsToLoad,
+    std::vector<Entity> &_levelsToUnload)
+{
+  for (const auto level : _levelsToLoad)
+    this->levelLastUsed[level] = this->levelUpdateCount;
+
+  if (this->maxLoadedEntities == 0u || _levelsToUnload.empty())
+    return;
+
+  auto entityCount = [&](const Entity _level) -> std::size_t
+  {
+    auto names =
+        this->runner->entityCompMgr.Component<components::LevelEntityNames>(
+            _level);
+    return nullptr == names ? 0u : names->Data().size();
+  };
+
+  // Entities shared by levels are counted once per level, which errs on the
+  // side of unloading
+  std::size_t loaded{0u};
+  for (std::size_t i = 0; i < _levelsToLoad.size(); ++i)
+  {
+    if (i == 0u || _levelsToLoad[i] != _levelsToLoad[i - 1])
+      loaded += entityCount(_levelsToLoad[i]);
+  }
+  for (const auto level : _levelsToUnload)
+    loaded += entityCount(level);
+
+  // Unload the least recently used levels until the rest fits
+  std::sort(_levelsToUnload.begin(), _levelsToUnload.end(),
+      [&](const Entity _a, const Entity _b)
+      {
+        return this->levelLastUsed[_a] < this->levelLastUsed[_b];
+      });
+
+  std::size_t evicted{0u};
+  while (evicted < _levelsToUnload.size() && loaded > this->maxLoadedEntities)
+  {
+    loaded -= entityCount(_levelsToUnload[evicted]);
+    ++evicted;
+  }
+
+  // Retained levels stay loaded as a whole, even if they share entities with
+  // the evicted ones
+  _levelsToLoad.insert(_levelsToLoad.end(), _levelsToUnload.begin() + evicted,
+      _levelsToUnload.end());
+  _levelsToUnload.resize(evicted);
+}
+
+/////////////////////////////////////////////////
+void LevelManager::IndexLevels()
+{
+  if (this->levelRegions.empty())
+    return;
+
+  // Cells the size of an average level keep both the number of cells per
+  // level and the number of levels per cell small
+  double sizeSum{0.0};
+  for (const auto &level : this->levelRegions)
+    sizeSum += level.outerRegion.Size().Max();
+  double cellSize = sizeSum / this->levelRegions.size();
+  if (!(cellSize > 0.0) || !std::isfinite(cellSize))
+    cellSize = 1.0;
+
+  this->levelIndex = std::make_unique<SpatialIndex>(cellSize);
+  for (const auto &level : this->levelRegions)
+    this->levelIndex->Update(level.entity, level.outerRegion);
+}
+
+/////////////////////////////////////////////////
+void LevelManager::NearbyLevels(const math::AxisAlignedBox &_volume,
+    std::vector<std::size_t> &_levels) const
+{
+  _levels.clear();
+  if (nullptr == this->levelIndex)
+    return;
+
+  // Both the query result and levelRegions are sorted by entity
+  auto level = this->levelRegions.begin();
+  for (const Entity entity : this->levelIndex->QueryBox(_volume))
+  {
+    level = std::lower_bound(level, this->levelRegions.end(), entity,
+        [](const LevelRegion &_level, const Entity _entity)
+        {
+          return _level.entity < _entity;
+        });
+    if (level == this->levelRegions.end())
+      break;
+    if (level->entity == entity)
+      _levels.push_back(level - this->levelRegions.begin());
   }
 }
 
@@ -569,6 +879,8 @@ void LevelManager::UpdateLevelsState()
 {
   IGN_PROFILE("LevelManager::UpdateLevelsState");
 
+  ++this->levelUpdateCount;
+
   std::vector<Entity> levelsToLoad;
   std::vector<Entity> levelsToUnload;
 
@@ -604,6 +916,7 @@ void LevelManager::UpdateLevelsState()
   // If levels are not being used, we only process the default level.
   if (this->useLevels)
   {
+    bool hasPerformer{false};
     this->runner->entityCompMgr.Each<
       components::Performer,
       components::PerformerLevels,
@@ -628,73 +941,89 @@ void LevelManager::UpdateLevelsState()
           << "] missing box." << std::endl;
           return true;
           }
+          hasPerformer = true;
 
           math::AxisAlignedBox performerVolume{
             pose->Data().Pos() - perfBox->Size() / 2,
               pose->Data().Pos() + perfBox->Size() / 2};
 
+          // Levels ahead of the performer are prefetched too
+          auto searchVolume = performerVolume;
+          if (this->lookahead > 0.0)
+            searchVolume = this->LookaheadVolume(_perfEntity, performerVolume);
+
+          // Only look up the levels near the performer when it moves
+          auto cache = this->performerLevelCache.find(_perfEntity);
+          if (cache == this->performerLevelCache.end() ||
+              cache->second.volume != searchVolume)
+          {
+            IGN_PROFILE("NearbyLevels");
+            auto &newCache = this->performerLevelCache[_perfEntity];
+            newCache.volume = searchVolume;
+            this->NearbyLevels(searchVolume, newCache.levels);
+            cache = this->performerLevelCache.find(_perfEntity);
+          }
+
           std::set<Entity> newPerfLevels;
+          std::vector<Entity> levelsToPrefetch;
 
-          // loop through levels and check for intersections
-          // Add all levels with intersections to the levelsToLoad even if they
-          // are currently active.
-          this->runner->entityCompMgr.Each<components::Level, components::Pose,
-            components::Geometry,
-            components::LevelBuffer >(
-                [&](const Entity &_entity, const components::Level *,
-                  const components::Pose *_pose,
-                  const components::Geometry *_levelGeometry,
-                  const components::LevelBuffer *_levelBuffer) -> bool
-                {
-                IGN_PROFILE("CheckPerformerAgainstLevel");
-                // Check if the performer is in this level
-                // assume a box for now
-                auto box = _levelGeometry->Data().BoxShape();
-                if (nullptr == box)
-                {
-                ignerr << "Level [" << _entity
-                << "]'s geometry is not a box." << std::endl;
-                return true;
-                }
-                auto buffer = _levelBuffer->Data();
-                auto center = _pose->Data().Pos();
-                math::AxisAlignedBox region{center - box->Size() / 2,
-                center + box->Size() / 2};
-
-                math::AxisAlignedBox outerRegion{
-                  center - (box->Size() / 2 + buffer),
-                         center + (box->Size() / 2 + buffer)};
-
-                if (region.Intersects(performerVolume))
-                {
-                  newPerfLevels.insert(_entity);
-                  levelsToLoad.push_back(_entity);
-                }
-                else
-                {
-                  // If the level is active, check if the performer is
-                  // outside of the buffer of this level
-                  if (this->IsLevelActive(_entity))
-                  {
-                    if (outerRegion.Intersects(performerVolume))
-                    {
-                      newPerfLevels.insert(_entity);
-                      levelsToLoad.push_back(_entity);
-                      return true;
-                    }
-                    // Otherwise, mark the level to be unloaded
-                    levelsToUnload.push_back(_entity);
-                  }
-                }
-                return true;
-                });
+          // Check the nearby levels for intersections. Add all levels with
+          // intersections to the levelsToLoad even if they are currently
+          // active. Active levels are kept while the performer is within
+          // their buffer.
+          for (const auto index : cache->second.levels)
+          {
+            const auto &level = this->levelRegions[index];
+            if (level.region.Intersects(performerVolume) ||
+                (level.outerRegion.Intersects(performerVolume) &&
+                 this->IsLevelActive(level.entity)))
+            {
+              newPerfLevels.insert(level.entity);
+              levelsToLoad.push_back(level.entity);
+            }
+            // The performer is in the buffer of an inactive level, or heading
+            // towards it, so it's likely to become active soon
+            else if (level.outerRegion.Intersects(searchVolume))
+            {
+              levelsToPrefetch.push_back(level.entity);
+            }
+          }
+
+          for (const auto level : levelsToPrefetch)
+            this->PrefetchLevel(level);
 
           *_perfLevels = components::PerformerLevels(newPerfLevels);
 
           return true;
           });
+
+    // Active levels which no performer keeps loaded are unloaded. Level
+    // entities are created in order, so levelRegions is sorted by entity.
+    if (hasPerformer)
+    {
+      std::sort(levelsToLoad.begin(), levelsToLoad.end());
+      auto byEntity = [](const LevelRegion &_level, const Entity _entity)
+      {
+        return _level.entity < _entity;
+      };
+      for (const auto &active : this->activeLevels)
+      {
+        auto level = std::lower_bound(this->levelRegions.begin(),
+            this->levelRegions.end(), active, byEntity);
+        if (level != this->levelRegions.end() && level->entity == active &&
+            !std::binary_search(levelsToLoad.begin(), levelsToLoad.end(),
+                active))
+        {
+          levelsToUnload.push_back(active);
+        }
+      }
+
+      this->ApplyLevelBudget(levelsToLoad, levelsToUnload);
+    }
   }
 
+  this->PrefetchMeshes();
+
   // Sort levelsToLoad and levelsToUnload so as to run std::unique on them.
   std::sort(levelsToLoad.begin(), levelsToLoad.end());
   std::sort(levelsToUnload.begin(), levelsToUnload.end());
@@ -789,6 +1118,28 @@ void LevelManager::UpdateLevelsState()
   }
   // Erase from vector
   this->activeLevels.erase(pendingEnd, this->activeLevels.end());
+
+  this->UpdateDormantModels();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether an SDF element or any of its descendants has
+/// plugins.
+/// \param[in] _elem Element to check.
+/// \return True if there are plugins, or if the element is null, since the
+/// plugins of a DOM object created without an element can't be checked.
+static bool hasPlugins(const sdf::ElementPtr &_elem)
+{
+  if (nullptr == _elem)
+    return true;
+
+  for (auto child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    if (child->GetName() == "plugin" || hasPlugins(child))
+      return true;
+  }
+  return false;
 }
 
 /////////////////////////////////////////////////
@@ -809,8 +1160,12 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
     // There is no sdf::World::ModelByName so we have to iterate by index and
     // check if the model is in this level
     auto model = this->runner->sdfWorld->ModelByIndex(modelIndex);
-    if (_namesToLoad.find(model->Name()) != _namesToLoad.end())
+    if (_namesToLoad.find(model->Name()) != _namesToLoad.end() &&
+        !this->RestoreUnloadedEntity(model->Name()))
     {
+      if (hasPlugins(model->Element()))
+        this->entityNamesWithPlugins.insert(model->Name());
+
       Entity modelEntity = this->entityCreator->CreateEntities(model);
 
       this->entityCreator->SetParent(modelEntity, this->worldEntity);
@@ -824,8 +1179,12 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
     // There is no sdf::World::ActorByName so we have to iterate by index and
     // check if the actor is in this level
     auto actor = this->runner->sdfWorld->ActorByIndex(actorIndex);
-    if (_namesToLoad.find(actor->Name()) != _namesToLoad.end())
+    if (_namesToLoad.find(actor->Name()) != _namesToLoad.end() &&
+        !this->RestoreUnloadedEntity(actor->Name()))
     {
+      if (hasPlugins(actor->Element()))
+        this->entityNamesWithPlugins.insert(actor->Name());
+
       Entity actorEntity = this->entityCreator->CreateEntities(actor);
 
       this->entityCreator->SetParent(actorEntity, this->worldEntity);
@@ -837,8 +1196,12 @@ void LevelManager::LoadActiveEntities(const std::set<std::string> &_namesToLoad)
        lightIndex < this->runner->sdfWorld->LightCount(); ++lightIndex)
   {
     auto light = this->runner->sdfWorld->LightByIndex(lightIndex);
-    if (_namesToLoad.find(light->Name()) != _namesToLoad.end())
+    if (_namesToLoad.find(light->Name()) != _namesToLoad.end() &&
+        !this->RestoreUnloadedEntity(light->Name()))
     {
+      if (hasPlugins(light->Element()))
+        this->entityNamesWithPlugins.insert(light->Name());
+
       Entity lightEntity = this->entityCreator->CreateEntities(light);
 
       this->entityCreator->SetParent(lightEntity, this->worldEntity);
@@ -858,6 +1221,7 @@ void LevelManager::UnloadInactiveEntities(
       {
         if (_namesToUnload.find(_name->Data()) != _namesToUnload.end())
         {
+          this->CacheUnloadedEntity(_entity, _name->Data());
           this->entityCreator->RequestRemoveEntity(_entity, true);
         }
         return true;
@@ -869,6 +1233,7 @@ void LevelManager::UnloadInactiveEntities(
       {
         if (_namesToUnload.find(_name->Data()) != _namesToUnload.end())
         {
+          this->CacheUnloadedEntity(_entity, _name->Data());
           this->entityCreator->RequestRemoveEntity(_entity, true);
         }
         return true;
@@ -880,6 +1245,7 @@ void LevelManager::UnloadInactiveEntities(
       {
         if (_namesToUnload.find(_name->Data()) != _namesToUnload.end())
         {
+          this->CacheUnloadedEntity(_entity, _name->Data());
           this->entityCreator->RequestRemoveEntity(_entity, true);
         }
         return true;
@@ -891,6 +1257,151 @@ void LevelManager::UnloadInactiveEntities(
   }
 }
 
+/////////////////////////////////////////////////
+void LevelManager::CacheUnloadedEntity(const Entity _entity,
+    const std::string &_name)
+{
+  IGN_PROFILE("LevelManager::CacheUnloadedEntity");
+
+  if (this->entityNamesWithPlugins.find(_name) !=
+      this->entityNamesWithPlugins.end())
+  {
+    return;
+  }
+
+  // An empty set would serialize all entities
+  auto &ecm = this->runner->entityCompMgr;
+  const auto descendants = ecm.Descendants(_entity);
+  if (descendants.empty())
+    return;
+
+  msgs::SerializedStateMap state;
+  ecm.State(state, descendants, {}, true);
+
+  // Components without a serializer would come back with default values
+  for (const auto &entity : state.entities())
+  {
+    for (const auto &component : entity.second.components())
+    {
+      if (component.second.component().empty())
+      {
+        igndbg << "Entity [" << _name << "] has components which can't be "
+               << "serialized, it will be recreated from SDF when its level "
+               << "is loaded again." << std::endl;
+        return;
+      }
+    }
+  }
+
+  state.SerializeToString(&this->unloadedEntities[_name]);
+}
+
+/////////////////////////////////////////////////
+bool LevelManager::RestoreUnloadedEntity(const std::string &_name)
+{
+  auto it = this->unloadedEntities.find(_name);
+  if (it == this->unloadedEntities.end())
+    return false;
+
+  IGN_PROFILE("LevelManager::RestoreUnloadedEntity");
+
+  msgs::SerializedStateMap state;
+  const bool parsed = state.ParseFromString(it->second);
+  this->unloadedEntities.erase(it);
+  if (!parsed)
+    return false;
+
+  // The entities were removed when they were unloaded, so they're created
+  // again with their old ids
+  this->runner->entityCompMgr.SetState(state);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LevelManager::PrefetchLevel(const Entity _level)
+{
+  if (!this->prefetchedLevels.insert(_level).second)
+    return;
+
+  IGN_PROFILE("LevelManager::PrefetchLevel");
+
+  if (this->sdfModels.empty())
+  {
+    for (uint64_t modelIndex = 0;
+         modelIndex < this->runner->sdfWorld->ModelCount(); ++modelIndex)
+    {
+      auto model = this->runner->sdfWorld->ModelByIndex(modelIndex);
+      this->sdfModels[model->Name()] = model;
+    }
+  }
+
+  auto entityNames =
+      this->runner->entityCompMgr.Component<components::LevelEntityNames>(
+          _level);
+  if (nullptr == entityNames)
+    return;
+
+  for (const auto &name : entityNames->Data())
+  {
+    // Entities which are already loaded had their meshes loaded too
+    if (this->activeEntityNames.find(name) != this->activeEntityNames.end())
+      continue;
+
+    auto model = this->sdfModels.find(name);
+    if (model != this->sdfModels.end())
+      this->QueueModelMeshes(*model->second);
+  }
+}
+
+/////////////////////////////////////////////////
+void LevelManager::QueueModelMeshes(const sdf::Model &_model)
+{
+  auto queueMesh = [&](const sdf::Geometry *_geom)
+  {
+    if (nullptr == _geom || nullptr == _geom->MeshShape())
+      return;
+
+    const auto mesh = _geom->MeshShape();
+    auto fullPath = asFullPath(mesh->Uri(), mesh->FilePath());
+    if (this->queuedMeshes.insert(fullPath).second)
+      this->meshesToPrefetch.push_back(fullPath);
+  };
+
+  for (uint64_t linkIndex = 0; linkIndex < _model.LinkCount(); ++linkIndex)
+  {
+    auto link = _model.LinkByIndex(linkIndex);
+    for (uint64_t i = 0; i < link->CollisionCount(); ++i)
+      queueMesh(link->CollisionByIndex(i)->Geom());
+    for (uint64_t i = 0; i < link->VisualCount(); ++i)
+      queueMesh(link->VisualByIndex(i)->Geom());
+  }
+
+  for (uint64_t modelIndex = 0; modelIndex < _model.ModelCount();
+       ++modelIndex)
+  {
+    this->QueueModelMeshes(*_model.ModelByIndex(modelIndex));
+  }
+}
+
+/////////////////////////////////////////////////
+void LevelManager::PrefetchMeshes()
+{
+  if (this->meshesToPrefetch.empty())
+    return;
+
+  IGN_PROFILE("LevelManager::PrefetchMeshes");
+
+  // The mesh manager caches meshes, so systems loading them once the level
+  // is active won't parse them again
+  for (std::size_t i = 0; i < kMaxPrefetchedMeshesPerStep &&
+       !this->meshesToPrefetch.empty(); ++i)
+  {
+    const auto fullPath = this->meshesToPrefetch.front();
+    this->meshesToPrefetch.pop_front();
+    loadCachedMesh(fullPath);
+  }
+}
+
 /////////////////////////////////////////////////
 bool LevelManager::IsLevelActive(const Entity _entity) const
 {
@@ -21,6 +21,8 @@
 #include <ignition/msgs/boolean.pb.h>
 #include <ignition/msgs/stringmsg.pb.h>
 
+#include <chrono>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <set>
@@ -31,6 +33,9 @@
 
 #include <sdf/Element.hh>
 #include <sdf/Geometry.hh>
+#include <sdf/Model.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/config.hh"
@@ -47,6 +52,7 @@ namespace ignition
     //
     // forward declaration
     class SimulationRunner;
+    class SpatialIndex;
 
     /// \brief Used to load / unload levels as performers move in a world.
     ///
@@ -69,10 +75,35 @@ namespace ignition
     ///
     /// The levels feature works with a few assumptions (currently):
     ///
-    /// * Entities which are part of a level should not be modified during
-    ///   simulation. Any component changes or additions will be ignored
-    ///   when the level is reloaded. Likewise, they should not be deleted.
+    /// * Entities which are part of a level and have plugins should not be
+    ///   modified during simulation. Any component changes or additions will
+    ///   be ignored when the level is reloaded. Likewise, they should not be
+    ///   deleted.
     /// * Entities spawned during simulation are part of the default level.
+    /// * Levels don't move nor change size during simulation. Their regions
+    ///   are indexed once, when the levels are read.
+    ///
+    /// Entities of a level are created on the simulation thread, in the step
+    /// the level becomes active, because the entity component manager can't
+    /// be modified concurrently. To make that step cheaper, the meshes of a
+    /// level are loaded into the mesh manager ahead of time, a few per step,
+    /// as soon as a performer enters the level's buffer.
+    ///
+    /// An optional `<level_policy>` makes prefetching look ahead along the
+    /// velocity of performers, and keeps levels loaded after performers leave
+    /// them, as long as the entities of loaded levels fit in a budget. Levels
+    /// are then unloaded in least recently used order.
+    ///
+    /// An optional `<simulation_lod>` marks the loaded top level models
+    /// which are far from all performers with components::Dormant, which
+    /// suspends their systems and, optionally, freezes them in physics.
+    ///
+    /// When a top level entity without plugins is unloaded, its components
+    /// and those of its descendants are serialized and kept in memory. When
+    /// its level is loaded again, the entities are restored from that state,
+    /// with the same ids and the state they had when they were unloaded,
+    /// without converting the SDF again. Entities with plugins are always
+    /// recreated from SDF, so that their plugins are loaded again.
     ///
     class IGNITION_GAZEBO_VISIBLE LevelManager
     {
@@ -98,6 +129,22 @@ namespace ignition
       private: void UnloadInactiveEntities(
           const std::set<std::string> &_namesToUnload);
 
+      /// \brief Serialize a top level entity which is being unloaded, along
+      /// with its descendants, so that it can be restored by
+      /// RestoreUnloadedEntity. Does nothing for entities with plugins, and
+      /// for entities with components that can't be serialized.
+      /// \param[in] _entity Top level model, actor or light.
+      /// \param[in] _name Name of the entity.
+      private: void CacheUnloadedEntity(const Entity _entity,
+          const std::string &_name);
+
+      /// \brief Restore a top level entity, and its descendants, from the
+      /// state serialized when it was unloaded.
+      /// \param[in] _name Name of the entity.
+      /// \return False if there is no state for the entity, which must then
+      /// be created from SDF.
+      private: bool RestoreUnloadedEntity(const std::string &_name);
+
       /// \brief Read level and performer information from the sdf::World
       /// object
       private: void ReadLevelPerformerInfo();
@@ -120,6 +167,58 @@ namespace ignition
       /// schedule them to be loaded
       private: void ConfigureDefaultLevel();
 
+      /// \brief Build the spatial index of levelRegions.
+      private: void IndexLevels();
+
+      /// \brief Get the levels whose outer region may intersect a volume.
+      /// \param[in] _volume Volume to look up.
+      /// \param[out] _levels Indices in levelRegions of the candidate levels,
+      /// sorted and without duplicates.
+      private: void NearbyLevels(const math::AxisAlignedBox &_volume,
+                   std::vector<std::size_t> &_levels) const;
+
+      /// \brief Read the optional level loading policy.
+      /// \param[in] _sdf sdf::ElementPtr of the ignition::gazebo plugin tag
+      private: void ReadLevelPolicy(const sdf::ElementPtr &_sdf);
+
+      /// \brief Read the optional simulation level of detail policy.
+      /// \param[in] _sdf sdf::ElementPtr of the ignition::gazebo plugin tag
+      private: void ReadSimulationLod(const sdf::ElementPtr &_sdf);
+
+      /// \brief Mark the top level models which are far from all performers
+      /// as dormant, and wake up the ones which performers approach, see
+      /// components::Dormant.
+      private: void UpdateDormantModels();
+
+      /// \brief Extend the volume of a performer along its velocity, by the
+      /// distance it will travel during the lookahead time.
+      /// \param[in] _perfEntity Performer entity.
+      /// \param[in] _volume Current volume of the performer.
+      /// \return Volume swept by the performer during the lookahead time.
+      private: math::AxisAlignedBox LookaheadVolume(const Entity _perfEntity,
+                   const math::AxisAlignedBox &_volume);
+
+      /// \brief Keep released levels loaded while the entity budget allows
+      /// it, moving them from the levels to unload to the levels to load.
+      /// \param[in,out] _levelsToLoad Levels which performers need, sorted.
+      /// Retained levels are appended.
+      /// \param[in,out] _levelsToUnload Active levels which no performer
+      /// needs. Only the levels to evict are left.
+      private: void ApplyLevelBudget(std::vector<Entity> &_levelsToLoad,
+                   std::vector<Entity> &_levelsToUnload);
+
+      /// \brief Queue the meshes of the entities of a level to be loaded
+      /// ahead of time, if that hasn't been done yet.
+      /// \param[in] _level Level entity.
+      private: void PrefetchLevel(const Entity _level);
+
+      /// \brief Queue the meshes of a model and its nested models.
+      /// \param[in] _model Model to look for meshes.
+      private: void QueueModelMeshes(const sdf::Model &_model);
+
+      /// \brief Load some of the queued meshes into the mesh manager.
+      private: void PrefetchMeshes();
+
       /// \brief Determine if a level is active
       /// \param[in] _entity Entity of level to be checked
       /// \return True of the level is currently active
@@ -178,6 +277,108 @@ namespace ignition
 
       /// \brief Mutex to protect performersToAdd list.
       private: std::mutex performerToAddMutex;
+
+      /// \brief Regions of a level, computed once from its pose, geometry and
+      /// buffer.
+      private: struct LevelRegion
+      {
+        /// \brief Level entity.
+        Entity entity{kNullEntity};
+
+        /// \brief Region of the level.
+        math::AxisAlignedBox region;
+
+        /// \brief Region of the level grown by its buffer.
+        math::AxisAlignedBox outerRegion;
+      };
+
+      /// \brief Regions of all levels.
+      private: std::vector<LevelRegion> levelRegions;
+
+      /// \brief Index of the outer regions of levels. Null if there are no
+      /// levels.
+      private: std::unique_ptr<SpatialIndex> levelIndex;
+
+      /// \brief Volume of a performer and the levels near it, which are
+      /// reused while the performer doesn't move.
+      private: struct PerformerLevelCache
+      {
+        /// \brief Volume of the performer when the cache was computed.
+        math::AxisAlignedBox volume;
+
+        /// \brief Indices in levelRegions of the levels near the volume.
+        std::vector<std::size_t> levels;
+      };
+
+      /// \brief Levels whose meshes have been queued for prefetching.
+      private: std::set<Entity> prefetchedLevels;
+
+      /// \brief Full paths of the meshes waiting to be prefetched.
+      private: std::list<std::string> meshesToPrefetch;
+
+      /// \brief Full paths of the meshes queued so far, so that meshes shared
+      /// by many levels are only queued once.
+      private: std::set<std::string> queuedMeshes;
+
+      /// \brief SDF models by name, used to find the entities of a level.
+      /// Built on first use.
+      private: std::unordered_map<std::string, const sdf::Model *> sdfModels;
+
+      /// \brief Time, in seconds, to look ahead along the velocity of
+      /// performers for prefetching. Zero disables the lookahead.
+      private: double lookahead{0.0};
+
+      /// \brief Maximum number of level entities kept loaded after the
+      /// performers leave their levels. Zero unloads levels as soon as no
+      /// performer needs them.
+      private: std::size_t maxLoadedEntities{0u};
+
+      /// \brief Distance from all performers beyond which top level models
+      /// become dormant. Zero disables the simulation level of detail.
+      private: double dormantDistance{0.0};
+
+      /// \brief Distance from a performer within which dormant models wake
+      /// up. Smaller than dormantDistance, so that models near the border
+      /// don't keep switching.
+      private: double wakeDistance{0.0};
+
+      /// \brief True to hold dormant models in place in physics.
+      private: bool freezeDormant{true};
+
+      /// \brief Motion of a performer between two updates.
+      private: struct PerformerMotion
+      {
+        /// \brief Center of the performer on the last update.
+        math::Vector3d position;
+
+        /// \brief Simulation time of the last update.
+        std::chrono::steady_clock::duration simTime;
+
+        /// \brief Estimated velocity.
+        math::Vector3d velocity;
+      };
+
+      /// \brief Motion of each performer, keyed by performer entity.
+      private: std::unordered_map<Entity, PerformerMotion> performerMotion;
+
+      /// \brief Update count at which each level was last needed by a
+      /// performer.
+      private: std::unordered_map<Entity, uint64_t> levelLastUsed;
+
+      /// \brief Number of calls to UpdateLevelsState.
+      private: uint64_t levelUpdateCount{0u};
+
+      /// \brief Levels near each performer, keyed by performer entity.
+      private: std::unordered_map<Entity, PerformerLevelCache>
+                   performerLevelCache;
+
+      /// \brief Names of the loaded top level entities which have plugins,
+      /// and so can't be restored from a serialized state.
+      private: std::set<std::string> entityNamesWithPlugins;
+
+      /// \brief Serialized msgs::SerializedStateMap of each unloaded top
+      /// level entity which can be restored, keyed by name.
+      private: std::unordered_map<std::string, std::string> unloadedEntities;
     };
     }
   }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_MEMORYESTIMATE_HH_
+#define IGNITION_GAZEBO_MEMORYESTIMATE_HH_
+
+#include <cstddef>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Estimate the heap memory used by a contiguous container, such
+    /// as std::vector, not counting memory owned by its elements.
+    /// \param[in] _container The container.
+    /// \return Number of bytes.
+    template <typename ContainerT>
+    std::size_t vectorBytes(const ContainerT &_container)
+    {
+      return _container.capacity() *
+          sizeof(typename ContainerT::value_type);
+    }
+
+    /// \brief Estimate the heap memory used by a node based tree container,
+    /// such as std::set or std::map, not counting memory owned by its
+    /// elements. Each node holds three links and a color next to its value.
+    /// \param[in] _container The container.
+    /// \return Number of bytes.
+    template <typename ContainerT>
+    std::size_t treeBytes(const ContainerT &_container)
+    {
+      return _container.size() *
+          (sizeof(typename ContainerT::value_type) + 4u * sizeof(void *));
+    }
+
+    /// \brief Estimate the heap memory used by a hash container, such as
+    /// std::unordered_map, not counting memory owned by its elements. Each
+    /// node holds a link and a cached hash next to its value.
+    /// \param[in] _container The container.
+    /// \return Number of bytes.
+    template <typename ContainerT>
+    std::size_t hashBytes(const ContainerT &_container)
+    {
+      return _container.bucket_count() * sizeof(void *) + _container.size() *
+          (sizeof(typename ContainerT::value_type) + 2u * sizeof(void *));
+    }
+
+    /// \brief Fraction of a container's capacity below which compaction
+    /// shrinks it.
+    constexpr double kCompactOccupancy{0.25};
+
+    /// \brief Rehash a hash container to fit its elements if it uses less
+    /// than kCompactOccupancy of its buckets. This invalidates iterators.
+    /// \param[in, out] _container The container.
+    template <typename ContainerT>
+    void compactHash(ContainerT &_container)
+    {
+      if (_container.bucket_count() > 16u &&
+          _container.size() < _container.bucket_count() * kCompactOccupancy)
+      {
+        _container.rehash(0u);
+      }
+    }
+
+    /// \brief Shrink a contiguous container to fit its elements if it uses
+    /// less than kCompactOccupancy of its capacity. This invalidates
+    /// iterators.
+    /// \param[in, out] _container The container.
+    template <typename ContainerT>
+    void compactVector(ContainerT &_container)
+    {
+      if (_container.capacity() > 16u &&
+          _container.size() < _container.capacity() * kCompactOccupancy)
+      {
+        _container.shrink_to_fit();
+      }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/MeshCache.hh"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Material.hh>
+#include <ignition/common/MeshManager.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/common/SubMesh.hh>
+#include <ignition/common/Util.hh>
+#include <ignition/common/Uuid.hh>
+#include <ignition/math/Color.hh>
+
+#include "BinaryStream.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Identifies mesh cache files.
+static constexpr std::array<char, 8> kMagic{
+    {'I', 'G', 'N', 'M', 'C', 'A', 'C', 'H'}};
+
+/// \brief Version of the file layout. Increment when it changes.
+static constexpr uint32_t kFormatVersion{1u};
+
+/// \brief Written in native byte order, so that caches written by machines
+/// with another byte order are rejected.
+static constexpr uint32_t kByteOrderMark{0x01020304u};
+
+/// \brief Extension of mesh cache files.
+static const char kCacheExtension[] = ".mesh";
+
+/// \brief Read-only view of the contents of a file, memory mapped where
+/// supported, and read into memory otherwise.
+class MappedFile
+{
+  /// \brief Constructor. Check Data() to know whether the file could be
+  /// read.
+  /// \param[in] _path Path to the file.
+  public: explicit MappedFile(const std::string &_path)
+  {
+#ifndef _WIN32
+    const int fd = open(_path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      void *memory = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+          PROT_READ, MAP_PRIVATE, fd, 0);
+      if (memory != MAP_FAILED)
+      {
+        this->data = static_cast<const char *>(memory);
+        this->size = static_cast<std::size_t>(info.st_size);
+      }
+    }
+    close(fd);
+#else
+    std::ifstream in(_path, std::ios::binary);
+    if (!in)
+      return;
+    this->buffer.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+    if (!this->buffer.empty())
+    {
+      this->data = this->buffer.data();
+      this->size = this->buffer.size();
+    }
+#endif
+  }
+
+  /// \brief Destructor. Unmaps the file.
+  public: ~MappedFile()
+  {
+#ifndef _WIN32
+    if (nullptr != this->data)
+      munmap(const_cast<char *>(this->data), this->size);
+#endif
+  }
+
+  /// \brief The mapping can't be copied.
+  public: MappedFile(const MappedFile &) = delete;
+
+  /// \brief The mapping can't be copied.
+  public: MappedFile &operator=(const MappedFile &) = delete;
+
+  /// \brief Contents of the file, or nullptr if it couldn't be read or is
+  /// empty.
+  public: const char *data{nullptr};
+
+  /// \brief Size of the contents in bytes.
+  public: std::size_t size{0u};
+
+#ifdef _WIN32
+  /// \brief Contents of the file, where it can't be mapped.
+  private: std::string buffer;
+#endif
+};
+
+/// \brief Reads values from a buffer, failing at its end instead of reading
+/// past it.
+struct BufferReader
+{
+  /// \brief Next byte to read.
+  const char *cursor{nullptr};
+
+  /// \brief End of the buffer.
+  const char *end{nullptr};
+
+  /// \brief Read a value.
+  /// \param[out] _value Value read.
+  /// \return False if the buffer ended first.
+  template<typename T>
+  bool Read(T &_value)
+  {
+    if (static_cast<std::size_t>(this->end - this->cursor) < sizeof(T))
+      return false;
+    std::memcpy(&_value, this->cursor, sizeof(T));
+    this->cursor += sizeof(T);
+    return true;
+  }
+
+  /// \brief Read a string.
+  /// \param[out] _value String read.
+  /// \return False if the buffer ended first.
+  bool ReadString(std::string &_value)
+  {
+    uint64_t size{0u};
+    if (!this->ReadCount(size, 1u))
+      return false;
+    _value.assign(this->cursor, size);
+    this->cursor += size;
+    return true;
+  }
+
+  /// \brief Read the number of elements of an array, rejecting arrays
+  /// which don't fit in the rest of the buffer before anything is
+  /// allocated for them.
+  /// \param[out] _count Number of elements.
+  /// \param[in] _elementSize Size of each element in bytes.
+  /// \return False if the array or its count don't fit in the buffer.
+  bool ReadCount(uint64_t &_count, const std::size_t _elementSize)
+  {
+    return this->Read(_count) &&
+        _count <= static_cast<uint64_t>(this->end - this->cursor) /
+        _elementSize;
+  }
+};
+
+//////////////////////////////////////////////////
+static void writeColor(std::ostream &_out, const math::Color &_color)
+{
+  writeValue(_out, _color.R());
+  writeValue(_out, _color.G());
+  writeValue(_out, _color.B());
+  writeValue(_out, _color.A());
+}
+
+//////////////////////////////////////////////////
+static bool readColor(BufferReader &_reader, math::Color &_color)
+{
+  std::array<float, 4> rgba{};
+  for (auto &value : rgba)
+  {
+    if (!_reader.Read(value))
+      return false;
+  }
+  _color.Set(rgba[0], rgba[1], rgba[2], rgba[3]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+static void writeMaterial(std::ostream &_out,
+    const common::Material &_material)
+{
+  writeString(_out, _material.TextureImage());
+  writeColor(_out, _material.Ambient());
+  writeColor(_out, _material.Diffuse());
+  writeColor(_out, _material.Specular());
+  writeColor(_out, _material.Emissive());
+  writeValue(_out, _material.Shininess());
+  writeValue(_out, _material.Transparency());
+
+  double srcFactor{0.0};
+  double dstFactor{0.0};
+  _material.BlendFactors(srcFactor, dstFactor);
+  writeValue(_out, srcFactor);
+  writeValue(_out, dstFactor);
+
+  bool alphaEnabled{false};
+  double alpha{0.0};
+  bool twoSided{false};
+  _material.AlphaFromTexture(alphaEnabled, alpha, twoSided);
+  writeValue<uint8_t>(_out, alphaEnabled);
+  writeValue(_out, alpha);
+  writeValue<uint8_t>(_out, twoSided);
+  writeValue<uint8_t>(_out, _material.Lighting());
+}
+
+//////////////////////////////////////////////////
+static common::MaterialPtr readMaterial(BufferReader &_reader)
+{
+  std::string texture;
+  math::Color ambient;
+  math::Color diffuse;
+  math::Color specular;
+  math::Color emissive;
+  double shininess{0.0};
+  double transparency{0.0};
+  double srcFactor{0.0};
+  double dstFactor{0.0};
+  uint8_t alphaEnabled{0u};
+  double alpha{0.0};
+  uint8_t twoSided{0u};
+  uint8_t lighting{0u};
+  if (!_reader.ReadString(texture) || !readColor(_reader, ambient) ||
+      !readColor(_reader, diffuse) || !readColor(_reader, specular) ||
+      !readColor(_reader, emissive) || !_reader.Read(shininess) ||
+      !_reader.Read(transparency) || !_reader.Read(srcFactor) ||
+      !_reader.Read(dstFactor) || !_reader.Read(alphaEnabled) ||
+      !_reader.Read(alpha) || !_reader.Read(twoSided) ||
+      !_reader.Read(lighting))
+  {
+    return nullptr;
+  }
+
+  auto material = std::make_shared<common::Material>();
+  if (!texture.empty())
+    material->SetTextureImage(texture);
+  material->SetAmbient(ambient);
+  material->SetDiffuse(diffuse);
+  material->SetSpecular(specular);
+  material->SetEmissive(emissive);
+  material->SetShininess(shininess);
+  material->SetTransparency(transparency);
+  material->SetBlendFactors(srcFactor, dstFactor);
+  material->SetAlphaFromTexture(alphaEnabled != 0u, alpha, twoSided != 0u);
+  material->SetLighting(lighting != 0u);
+  return material;
+}
+
+//////////////////////////////////////////////////
+static void writeSubMesh(std::ostream &_out, const common::SubMesh &_subMesh)
+{
+  writeString(_out, _subMesh.Name());
+  writeValue<uint32_t>(_out, _subMesh.SubMeshPrimitive());
+  writeValue<int32_t>(_out, _subMesh.MaterialIndex());
+
+  writeValue<uint64_t>(_out, _subMesh.VertexCount());
+  for (unsigned int i = 0; i < _subMesh.VertexCount(); ++i)
+  {
+    const auto &vertex = _subMesh.Vertex(i);
+    writeValue(_out, vertex.X());
+    writeValue(_out, vertex.Y());
+    writeValue(_out, vertex.Z());
+  }
+
+  writeValue<uint64_t>(_out, _subMesh.NormalCount());
+  for (unsigned int i = 0; i < _subMesh.NormalCount(); ++i)
+  {
+    const auto &normal = _subMesh.Normal(i);
+    writeValue(_out, normal.X());
+    writeValue(_out, normal.Y());
+    writeValue(_out, normal.Z());
+  }
+
+  writeValue<uint64_t>(_out, _subMesh.TexCoordCount());
+  for (unsigned int i = 0; i < _subMesh.TexCoordCount(); ++i)
+  {
+    const auto &texCoord = _subMesh.TexCoord(i);
+    writeValue(_out, texCoord.X());
+    writeValue(_out, texCoord.Y());
+  }
+
+  writeValue<uint64_t>(_out, _subMesh.IndexCount());
+  for (unsigned int i = 0; i < _subMesh.IndexCount(); ++i)
+    writeValue<uint32_t>(_out, _subMesh.Index(i));
+}
+
+//////////////////////////////////////////////////
+/// \brief Read an array of elements made of _width values, copying it from
+/// the buffer in bulk.
+/// \param[in] _reader Reader.
+/// \param[in] _width Number of values in each element.
+/// \param[out] _values Values of all elements.
+/// \return False if the buffer ended first.
+template<typename T>
+static bool readArray(BufferReader &_reader, const std::size_t _width,
+    std::vector<T> &_values)
+{
+  uint64_t count{0u};
+  if (!_reader.ReadCount(count, _width * sizeof(T)))
+    return false;
+  _values.resize(count * _width);
+  if (!_values.empty())
+    std::memcpy(_values.data(), _reader.cursor, _values.size() * sizeof(T));
+  _reader.cursor += _values.size() * sizeof(T);
+  return true;
+}
+
+//////////////////////////////////////////////////
+static bool readSubMesh(BufferReader &_reader, common::SubMesh &_subMesh)
+{
+  std::string name;
+  uint32_t primitive{0u};
+  int32_t materialIndex{-1};
+  if (!_reader.ReadString(name) || !_reader.Read(primitive) ||
+      primitive > static_cast<uint32_t>(common::SubMesh::TRISTRIPS) ||
+      !_reader.Read(materialIndex))
+  {
+    return false;
+  }
+  _subMesh.SetName(name);
+  _subMesh.SetPrimitiveType(
+      static_cast<common::SubMesh::PrimitiveType>(primitive));
+  if (materialIndex >= 0)
+    _subMesh.SetMaterialIndex(static_cast<unsigned int>(materialIndex));
+
+  std::vector<double> values;
+  if (!readArray(_reader, 3u, values))
+    return false;
+  for (std::size_t i = 0; i < values.size(); i += 3u)
+    _subMesh.AddVertex(values[i], values[i + 1u], values[i + 2u]);
+
+  if (!readArray(_reader, 3u, values))
+    return false;
+  for (std::size_t i = 0; i < values.size(); i += 3u)
+    _subMesh.AddNormal(values[i], values[i + 1u], values[i + 2u]);
+
+  if (!readArray(_reader, 2u, values))
+    return false;
+  for (std::size_t i = 0; i < values.size(); i += 2u)
+    _subMesh.AddTexCoord(values[i], values[i + 1u]);
+
+  std::vector<uint32_t> indices;
+  if (!readArray(_reader, 1u, indices))
+    return false;
+  for (const auto index : indices)
+  {
+    if (index >= _subMesh.VertexCount())
+      return false;
+    _subMesh.AddIndex(index);
+  }
+  return true;
+}
+//////////////////////////////////////////////////
+/// \brief Get the directory of the mesh cache.
+/// \return The directory, or an empty string if the cache is disabled.
+static std::string meshCacheDirectory()
+{
+  std::string path;
+  if (common::env(kMeshCachePathEnv, path))
+    return path == "0" ? std::string() : path;
+
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  return common::joinPaths(home, ".ignition", "gazebo", "mesh_cache");
+}
+
+//////////////////////////////////////////////////
+uint64_t ignition::gazebo::meshCacheHash(const std::string &_fullPath,
+    const std::string &_contents)
+{
+  const std::string key = std::to_string(kFormatVersion) + '\n' +
+      common::parentPath(_fullPath) + '\n' + _contents;
+  return common::hash64(std::string_view(key));
+}
+
+//////////////////////////////////////////////////
+bool ignition::gazebo::isMeshCacheable(const common::Mesh &_mesh)
+{
+  if (_mesh.HasSkeleton())
+    return false;
+
+  for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+  {
+    auto material = _mesh.MaterialByIndex(i);
+    if (nullptr == material || nullptr != material->PbrMaterial())
+      return false;
+  }
+
+  for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (nullptr != subMesh && subMesh->NodeAssignmentsCount() > 0u)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ignition::gazebo::saveMeshCache(const std::string &_path,
+    const common::Mesh &_mesh, uint64_t _sourceHash)
+{
+  // Other processes may be writing the same cache
+  const std::string tmpPath = _path + "." + common::Uuid().String() + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      ignerr << "Failed to open mesh cache [" << tmpPath << "] for writing."
+             << std::endl;
+      return false;
+    }
+
+    out.write(kMagic.data(), kMagic.size());
+    writeValue(out, kFormatVersion);
+    writeValue(out, kByteOrderMark);
+    writeValue(out, _sourceHash);
+
+    writeValue<uint64_t>(out, _mesh.MaterialCount());
+    for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+      writeMaterial(out, *_mesh.MaterialByIndex(i));
+
+    std::vector<std::shared_ptr<common::SubMesh>> subMeshes;
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      if (nullptr != subMesh)
+        subMeshes.push_back(subMesh);
+    }
+    writeValue<uint64_t>(out, subMeshes.size());
+    for (const auto &subMesh : subMeshes)
+      writeSubMesh(out, *subMesh);
+
+    if (!out.flush())
+    {
+      ignerr << "Failed to write mesh cache [" << tmpPath << "]."
+             << std::endl;
+      common::removeFile(tmpPath);
+      return false;
+    }
+  }
+
+  if (!common::moveFile(tmpPath, _path))
+  {
+    ignerr << "Failed to move mesh cache [" << tmpPath << "] to [" << _path
+           << "]." << std::endl;
+    common::removeFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<common::Mesh> ignition::gazebo::loadMeshCache(
+    const std::string &_path, uint64_t _sourceHash)
+{
+  MappedFile file(_path);
+  if (nullptr == file.data)
+    return nullptr;
+  BufferReader reader{file.data, file.data + file.size};
+
+  std::array<char, kMagic.size()> magic{};
+  uint32_t version{0u};
+  uint32_t byteOrder{0u};
+  uint64_t sourceHash{0u};
+  if (!reader.Read(magic) || magic != kMagic || !reader.Read(version) ||
+      version != kFormatVersion || !reader.Read(byteOrder) ||
+      byteOrder != kByteOrderMark || !reader.Read(sourceHash))
+  {
+    ignwarn << "Ignoring mesh cache [" << _path << "], it isn't a mesh "
+            << "cache or was written by another version." << std::endl;
+    return nullptr;
+  }
+
+  // Hash collisions in the file name, or leftovers from a deleted mesh
+  if (sourceHash != _sourceHash)
+  {
+    igndbg << "Mesh cache [" << _path << "] doesn't match the mesh."
+           << std::endl;
+    return nullptr;
+  }
+
+  auto mesh = std::make_unique<common::Mesh>();
+  uint64_t materialCount{0u};
+  bool valid = reader.ReadCount(materialCount, 1u);
+  for (uint64_t i = 0; valid && i < materialCount; ++i)
+  {
+    auto material = readMaterial(reader);
+    valid = nullptr != material;
+    if (valid)
+      mesh->AddMaterial(material);
+  }
+
+  uint64_t subMeshCount{0u};
+  valid = valid && reader.ReadCount(subMeshCount, 1u);
+  for (uint64_t i = 0; valid && i < subMeshCount; ++i)
+  {
+    common::SubMesh subMesh;
+    valid = readSubMesh(reader, subMesh);
+    if (valid)
+      mesh->AddSubMesh(subMesh);
+  }
+
+  if (!valid)
+  {
+    ignwarn << "Ignoring truncated mesh cache [" << _path << "]."
+            << std::endl;
+    return nullptr;
+  }
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+const common::Mesh *ignition::gazebo::loadCachedMesh(
+    const std::string &_fullPath)
+{
+  IGN_PROFILE("loadCachedMesh");
+
+  // Keeps threads from loading the same mesh twice
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto *meshManager = common::MeshManager::Instance();
+  if (meshManager->HasMesh(_fullPath))
+    return meshManager->MeshByName(_fullPath);
+
+  const std::string cacheDir = meshCacheDirectory();
+  std::string contents;
+  if (!cacheDir.empty())
+  {
+    std::ifstream in(_fullPath, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+  if (contents.empty())
+    return meshManager->Load(_fullPath);
+
+  const uint64_t hash = meshCacheHash(_fullPath, contents);
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash
+       << kCacheExtension;
+  const std::string cachePath = common::joinPaths(cacheDir, name.str());
+
+  auto cached = loadMeshCache(cachePath, hash);
+  if (nullptr != cached)
+  {
+    igndbg << "Loaded mesh [" << _fullPath << "] from cache [" << cachePath
+           << "]." << std::endl;
+    cached->SetName(_fullPath);
+    cached->SetPath(common::parentPath(_fullPath));
+    auto *mesh = cached.release();
+    meshManager->AddMesh(mesh);
+    return mesh;
+  }
+
+  auto *mesh = meshManager->Load(_fullPath);
+  if (nullptr != mesh && isMeshCacheable(*mesh) &&
+      (common::isDirectory(cacheDir) || common::createDirectories(cacheDir)))
+  {
+    saveMeshCache(cachePath, *mesh, hash);
+  }
+  return mesh;
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Material.hh>
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/MeshManager.hh>
+#include <ignition/common/SubMesh.hh>
+#include <ignition/common/Util.hh>
+
+#include "ignition/gazebo/MeshCache.hh"
+#include "ignition/gazebo/test_config.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+/// \param[in] _path Path to the file.
+/// \return Contents of the file.
+static std::string readFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that two meshes have the same submeshes and materials.
+/// \param[in] _expected Expected mesh.
+/// \param[in] _actual Mesh to check.
+static void expectSameMesh(const common::Mesh &_expected,
+    const common::Mesh &_actual)
+{
+  ASSERT_EQ(_expected.MaterialCount(), _actual.MaterialCount());
+  for (unsigned int i = 0; i < _expected.MaterialCount(); ++i)
+  {
+    auto expected = _expected.MaterialByIndex(i);
+    auto actual = _actual.MaterialByIndex(i);
+    ASSERT_NE(nullptr, actual);
+    EXPECT_EQ(expected->TextureImage(), actual->TextureImage());
+    EXPECT_EQ(expected->Ambient(), actual->Ambient());
+    EXPECT_EQ(expected->Diffuse(), actual->Diffuse());
+    EXPECT_EQ(expected->Specular(), actual->Specular());
+    EXPECT_EQ(expected->Emissive(), actual->Emissive());
+    EXPECT_DOUBLE_EQ(expected->Shininess(), actual->Shininess());
+    EXPECT_DOUBLE_EQ(expected->Transparency(), actual->Transparency());
+    EXPECT_EQ(expected->Lighting(), actual->Lighting());
+  }
+
+  ASSERT_EQ(_expected.SubMeshCount(), _actual.SubMeshCount());
+  for (unsigned int i = 0; i < _expected.SubMeshCount(); ++i)
+  {
+    auto expected = _expected.SubMeshByIndex(i).lock();
+    auto actual = _actual.SubMeshByIndex(i).lock();
+    ASSERT_NE(nullptr, actual);
+    EXPECT_EQ(expected->Name(), actual->Name());
+    EXPECT_EQ(expected->SubMeshPrimitive(), actual->SubMeshPrimitive());
+    EXPECT_EQ(expected->MaterialIndex(), actual->MaterialIndex());
+    ASSERT_EQ(expected->VertexCount(), actual->VertexCount());
+    for (unsigned int v = 0; v < expected->VertexCount(); ++v)
+      EXPECT_EQ(expected->Vertex(v), actual->Vertex(v));
+    ASSERT_EQ(expected->NormalCount(), actual->NormalCount());
+    for (unsigned int n = 0; n < expected->NormalCount(); ++n)
+      EXPECT_EQ(expected->Normal(n), actual->Normal(n));
+    ASSERT_EQ(expected->TexCoordCount(), actual->TexCoordCount());
+    for (unsigned int t = 0; t < expected->TexCoordCount(); ++t)
+      EXPECT_EQ(expected->TexCoord(t), actual->TexCoord(t));
+    ASSERT_EQ(expected->IndexCount(), actual->IndexCount());
+    for (unsigned int j = 0; j < expected->IndexCount(); ++j)
+      EXPECT_EQ(expected->Index(j), actual->Index(j));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, Hash)
+{
+  EXPECT_EQ(meshCacheHash("/a/mesh.obj", "v 0 0 0"),
+      meshCacheHash("/a/mesh.obj", "v 0 0 0"));
+  EXPECT_NE(meshCacheHash("/a/mesh.obj", "v 0 0 0"),
+      meshCacheHash("/a/mesh.obj", "v 0 0 1"));
+
+  // Textures are resolved relative to the mesh, so the directory matters,
+  // but not the file name
+  EXPECT_NE(meshCacheHash("/a/mesh.obj", "v 0 0 0"),
+      meshCacheHash("/b/mesh.obj", "v 0 0 0"));
+  EXPECT_EQ(meshCacheHash("/a/mesh.obj", "v 0 0 0"),
+      meshCacheHash("/a/copy.obj", "v 0 0 0"));
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, SaveLoad)
+{
+  const std::string path = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_mesh_cache.mesh");
+  common::removeFile(path);
+  EXPECT_EQ(nullptr, loadMeshCache(path, 1u));
+
+  common::Mesh mesh;
+  auto material = std::make_shared<common::Material>();
+  material->SetDiffuse(math::Color(0.1f, 0.2f, 0.3f, 1.0f));
+  material->SetShininess(5.0);
+  material->SetTransparency(0.25);
+  mesh.AddMaterial(material);
+
+  common::SubMesh subMesh;
+  subMesh.SetName("triangle");
+  subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  subMesh.SetMaterialIndex(0u);
+  subMesh.AddVertex(0.0, 0.0, 0.0);
+  subMesh.AddVertex(1.0, 0.0, 0.0);
+  subMesh.AddVertex(0.0, 1.0, 0.5);
+  for (int i = 0; i < 3; ++i)
+  {
+    subMesh.AddNormal(0.0, 0.0, 1.0);
+    subMesh.AddIndex(i);
+  }
+  subMesh.AddTexCoord(0.0, 0.0);
+  subMesh.AddTexCoord(1.0, 0.0);
+  subMesh.AddTexCoord(0.0, 1.0);
+  mesh.AddSubMesh(subMesh);
+
+  common::SubMesh lines;
+  lines.SetName("lines");
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  lines.AddVertex(0.0, 0.0, 0.0);
+  lines.AddVertex(0.0, 0.0, 2.0);
+  lines.AddIndex(0);
+  lines.AddIndex(1);
+  mesh.AddSubMesh(lines);
+
+  ASSERT_TRUE(isMeshCacheable(mesh));
+  const uint64_t hash = meshCacheHash("/a/mesh.obj", "source");
+  ASSERT_TRUE(saveMeshCache(path, mesh, hash));
+
+  auto loaded = loadMeshCache(path, hash);
+  ASSERT_NE(nullptr, loaded);
+  expectSameMesh(mesh, *loaded);
+
+  // Another source
+  EXPECT_EQ(nullptr, loadMeshCache(path,
+      meshCacheHash("/a/mesh.obj", "other")));
+
+  // Truncated file
+  const std::string contents = readFile(path);
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 10u);
+  }
+  EXPECT_EQ(nullptr, loadMeshCache(path, hash));
+
+  // Not a cache
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "v 0 0 0";
+  }
+  EXPECT_EQ(nullptr, loadMeshCache(path, hash));
+
+  common::removeFile(path);
+}
+
+/////////////////////////////////////////////////
+TEST(MeshCache, LoadCachedMesh)
+{
+  const std::string cacheDir = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_mesh_cache");
+  common::removeAll(cacheDir);
+  ASSERT_TRUE(common::setenv(kMeshCachePathEnv, cacheDir));
+
+  const std::string meshPath = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "models", "mesh_with_submeshes", "meshes",
+      "mesh_with_submeshes.dae");
+
+  // The first load parses the file and writes the cache
+  auto *mesh = loadCachedMesh(meshPath);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(mesh, common::MeshManager::Instance()->MeshByName(meshPath));
+  EXPECT_EQ(mesh, loadCachedMesh(meshPath));
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0')
+       << meshCacheHash(meshPath, readFile(meshPath)) << ".mesh";
+  const std::string cachePath = common::joinPaths(cacheDir, name.str());
+  ASSERT_TRUE(common::exists(cachePath));
+
+  // Later loads map the cache, which holds the same mesh
+  auto cached = loadMeshCache(cachePath,
+      meshCacheHash(meshPath, readFile(meshPath)));
+  ASSERT_NE(nullptr, cached);
+  expectSameMesh(*mesh, *cached);
+
+  // Disabled cache
+  ASSERT_TRUE(common::setenv(kMeshCachePathEnv, "0"));
+  const std::string otherPath = common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "media", "duck.dae");
+  EXPECT_NE(nullptr, loadCachedMesh(otherPath));
+  std::ostringstream otherName;
+  otherName << std::hex << std::setw(16) << std::setfill('0')
+            << meshCacheHash(otherPath, readFile(otherPath)) << ".mesh";
+  EXPECT_FALSE(common::exists(common::joinPaths(cacheDir, otherName.str())));
+
+  EXPECT_TRUE(common::unsetenv(kMeshCachePathEnv));
+  common::removeAll(cacheDir);
+}
@@ -0,0 +1,450 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/PoseStreamCodec.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Version of the stream format.
+static constexpr uint8_t kPoseStreamVersion{1u};
+
+/// \brief Frame flag set on keyframes.
+static constexpr uint8_t kKeyframeFlag{0x01u};
+
+/// \brief Pose flag set when the pose doesn't depend on the keyframe.
+static constexpr uint8_t kAbsolutePoseFlag{0x04u};
+
+/// \brief Scale from the smallest three quaternion components, which are
+/// within [-1/sqrt(2), 1/sqrt(2)], to 16 bit integers.
+static const double kQuaternionScale{32767.0 * std::sqrt(2.0)};
+
+/// \brief A pose quantized for the stream.
+struct QuantizedStreamPose
+{
+  /// \brief Position, in multiples of the position resolution.
+  std::array<int64_t, 3> position{{0, 0, 0}};
+
+  /// \brief Index of the largest quaternion component, in w, x, y, z
+  /// order. It is implied by the other three, since it's positive.
+  uint8_t largest{0u};
+
+  /// \brief The other three quaternion components, in order.
+  std::array<int64_t, 3> orientation{{0, 0, 0}};
+};
+
+/// \brief Quantized poses of a keyframe.
+using PoseStreamKeyframe = std::unordered_map<Entity, QuantizedStreamPose>;
+
+//////////////////////////////////////////////////
+/// \brief Quantize a pose.
+/// \param[in] _pose Pose.
+/// \param[in] _resolution Position resolution.
+/// \return Quantized pose.
+static QuantizedStreamPose quantize(const math::Pose3d &_pose,
+    const double _resolution)
+{
+  QuantizedStreamPose result;
+  for (std::size_t i = 0; i < 3; ++i)
+    result.position[i] = std::llround(_pose.Pos()[i] / _resolution);
+
+  auto rot = _pose.Rot();
+  rot.Normalize();
+  std::array<double, 4> q{{rot.W(), rot.X(), rot.Y(), rot.Z()}};
+  for (std::size_t i = 1; i < 4; ++i)
+  {
+    if (std::abs(q[i]) > std::abs(q[result.largest]))
+      result.largest = static_cast<uint8_t>(i);
+  }
+
+  // q and -q are the same rotation, so the largest component can always be
+  // made positive
+  const double sign = q[result.largest] < 0.0 ? -1.0 : 1.0;
+  for (std::size_t i = 0, j = 0; i < 4; ++i)
+  {
+    if (i == result.largest)
+      continue;
+    result.orientation[j++] = std::clamp<int64_t>(
+        std::llround(sign * q[i] * kQuaternionScale), -32767, 32767);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Restore a quantized pose.
+/// \param[in] _pose Quantized pose.
+/// \param[in] _resolution Position resolution.
+/// \return Pose.
+static math::Pose3d restore(const QuantizedStreamPose &_pose,
+    const double _resolution)
+{
+  std::array<double, 4> q{{0.0, 0.0, 0.0, 0.0}};
+  double sumSquares{0.0};
+  for (std::size_t i = 0, j = 0; i < 4; ++i)
+  {
+    if (i == _pose.largest)
+      continue;
+    q[i] = _pose.orientation[j++] / kQuaternionScale;
+    sumSquares += q[i] * q[i];
+  }
+  q[_pose.largest] = std::sqrt(std::max(0.0, 1.0 - sumSquares));
+
+  math::Quaterniond rot(q[0], q[1], q[2], q[3]);
+  rot.Normalize();
+  return math::Pose3d(
+      math::Vector3d(
+          _pose.position[0] * _resolution,
+          _pose.position[1] * _resolution,
+          _pose.position[2] * _resolution),
+      rot);
+}
+
+//////////////////////////////////////////////////
+/// \brief Append an unsigned variable length integer, 7 bits per byte.
+/// \param[in] _value Value.
+/// \param[in,out] _buffer Buffer to append to.
+static void writeVarint(uint64_t _value, std::string &_buffer)
+{
+  while (_value >= 0x80u)
+  {
+    _buffer.push_back(static_cast<char>((_value & 0x7Fu) | 0x80u));
+    _value >>= 7;
+  }
+  _buffer.push_back(static_cast<char>(_value));
+}
+
+//////////////////////////////////////////////////
+/// \brief Append a signed variable length integer, zigzag encoded so that
+/// small negative values are short too.
+/// \param[in] _value Value.
+/// \param[in,out] _buffer Buffer to append to.
+static void writeSigned(const int64_t _value, std::string &_buffer)
+{
+  writeVarint((static_cast<uint64_t>(_value) << 1) ^
+      static_cast<uint64_t>(_value >> 63), _buffer);
+}
+
+/// \brief Reads values from an encoded frame.
+class PoseStreamReader
+{
+  /// \brief Constructor
+  /// \param[in] _buffer Encoded frame.
+  public: explicit PoseStreamReader(const std::string &_buffer)
+    : buffer(_buffer)
+  {
+  }
+
+  /// \brief Read a byte.
+  /// \param[out] _value Value.
+  /// \return False if the frame is too short.
+  public: bool Byte(uint8_t &_value)
+  {
+    if (this->offset >= this->buffer.size())
+      return false;
+    _value = static_cast<uint8_t>(this->buffer[this->offset++]);
+    return true;
+  }
+
+  /// \brief Read an unsigned variable length integer.
+  /// \param[out] _value Value.
+  /// \return False if the frame is too short or the value is too long.
+  public: bool Varint(uint64_t &_value)
+  {
+    _value = 0u;
+    for (unsigned int shift = 0u; shift < 64u; shift += 7u)
+    {
+      uint8_t byte;
+      if (!this->Byte(byte))
+        return false;
+      _value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+      if ((byte & 0x80u) == 0u)
+        return true;
+    }
+    return false;
+  }
+
+  /// \brief Read a zigzag encoded signed variable length integer.
+  /// \param[out] _value Value.
+  /// \return False if the frame is too short or the value is too long.
+  public: bool Signed(int64_t &_value)
+  {
+    uint64_t raw;
+    if (!this->Varint(raw))
+      return false;
+    _value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1u);
+    return true;
+  }
+
+  /// \brief Read a double stored as its IEEE 754 bits.
+  /// \param[out] _value Value.
+  /// \return False if the frame is too short.
+  public: bool Double(double &_value)
+  {
+    uint64_t bits;
+    if (!this->Varint(bits))
+      return false;
+    std::memcpy(&_value, &bits, sizeof(_value));
+    return true;
+  }
+
+  /// \brief Encoded frame.
+  private: const std::string &buffer;
+
+  /// \brief Offset of the next value.
+  private: std::size_t offset{0u};
+};
+
+class ignition::gazebo::PoseStreamEncoderPrivate
+{
+  /// \brief Stream options.
+  public: PoseStreamOptions options;
+
+  /// \brief Quantized poses of the last keyframe.
+  public: PoseStreamKeyframe keyframe;
+
+  /// \brief Id of the last keyframe.
+  public: uint64_t keyframeId{0u};
+
+  /// \brief Number of frames encoded since the last keyframe, including
+  /// the keyframe.
+  public: unsigned int framesSinceKeyframe{0u};
+
+  /// \brief True if the next frame must be a keyframe.
+  public: bool keyframeRequested{true};
+};
+
+class ignition::gazebo::PoseStreamDecoderPrivate
+{
+  /// \brief Quantized poses of the last keyframe.
+  public: PoseStreamKeyframe keyframe;
+
+  /// \brief Id of the last keyframe.
+  public: uint64_t keyframeId{0u};
+
+  /// \brief True once a keyframe has been decoded.
+  public: bool hasKeyframe{false};
+};
+
+//////////////////////////////////////////////////
+PoseStreamEncoder::PoseStreamEncoder(const PoseStreamOptions &_options)
+  : dataPtr(std::make_unique<PoseStreamEncoderPrivate>())
+{
+  auto &options = this->dataPtr->options;
+  options = _options;
+  if (!(options.positionResolution > 0.0))
+  {
+    ignwarn << "Pose stream position resolution must be positive, using "
+            << "default" << std::endl;
+    options.positionResolution = PoseStreamOptions().positionResolution;
+  }
+  options.keyframeInterval = std::max(1u, options.keyframeInterval);
+}
+
+//////////////////////////////////////////////////
+PoseStreamEncoder::~PoseStreamEncoder() = default;
+
+//////////////////////////////////////////////////
+const PoseStreamOptions &PoseStreamEncoder::Options() const
+{
+  return this->dataPtr->options;
+}
+
+//////////////////////////////////////////////////
+void PoseStreamEncoder::RequestKeyframe()
+{
+  this->dataPtr->keyframeRequested = true;
+}
+
+//////////////////////////////////////////////////
+bool PoseStreamEncoder::Encode(const std::vector<EntityPose> &_poses,
+    const std::chrono::steady_clock::duration &_simTime,
+    std::string &_buffer)
+{
+  auto &d = *this->dataPtr;
+  const bool isKeyframe = d.keyframeRequested ||
+      d.framesSinceKeyframe >= d.options.keyframeInterval;
+  if (isKeyframe)
+  {
+    d.keyframe.clear();
+    ++d.keyframeId;
+    d.framesSinceKeyframe = 0u;
+    d.keyframeRequested = false;
+  }
+  ++d.framesSinceKeyframe;
+
+  const double resolution = d.options.positionResolution;
+  uint64_t resolutionBits;
+  std::memcpy(&resolutionBits, &resolution, sizeof(resolution));
+
+  _buffer.clear();
+  _buffer.reserve(16u + _poses.size() * 12u);
+  _buffer.push_back(static_cast<char>(kPoseStreamVersion));
+  _buffer.push_back(static_cast<char>(isKeyframe ? kKeyframeFlag : 0u));
+  writeVarint(d.keyframeId, _buffer);
+  writeSigned(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _simTime).count(), _buffer);
+  writeVarint(resolutionBits, _buffer);
+  writeVarint(_poses.size(), _buffer);
+
+  Entity previous{0u};
+  for (const auto &[entity, pose] : _poses)
+  {
+    const QuantizedStreamPose quantized = quantize(pose, resolution);
+
+    // Ids are stored as the difference to the previous one, which is small
+    // since entities are usually visited in creation order
+    writeSigned(static_cast<int64_t>(entity - previous), _buffer);
+    previous = entity;
+
+    QuantizedStreamPose base;
+    bool absolute{true};
+    if (isKeyframe)
+    {
+      d.keyframe[entity] = quantized;
+    }
+    else
+    {
+      auto it = d.keyframe.find(entity);
+      if (it != d.keyframe.end() && it->second.largest == quantized.largest)
+      {
+        base = it->second;
+        absolute = false;
+      }
+    }
+
+    _buffer.push_back(static_cast<char>(quantized.largest |
+        (absolute ? kAbsolutePoseFlag : 0u)));
+    for (std::size_t i = 0; i < 3; ++i)
+      writeSigned(quantized.position[i] - base.position[i], _buffer);
+    for (std::size_t i = 0; i < 3; ++i)
+      writeSigned(quantized.orientation[i] - base.orientation[i], _buffer);
+  }
+  return isKeyframe;
+}
+
+//////////////////////////////////////////////////
+PoseStreamDecoder::PoseStreamDecoder()
+  : dataPtr(std::make_unique<PoseStreamDecoderPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+PoseStreamDecoder::~PoseStreamDecoder() = default;
+
+//////////////////////////////////////////////////
+bool PoseStreamDecoder::HasKeyframe() const
+{
+  return this->dataPtr->hasKeyframe;
+}
+
+//////////////////////////////////////////////////
+bool PoseStreamDecoder::Decode(const std::string &_buffer,
+    std::chrono::steady_clock::duration &_simTime,
+    std::vector<EntityPose> &_poses)
+{
+  _poses.clear();
+
+  PoseStreamReader reader(_buffer);
+  uint8_t version, flags;
+  uint64_t keyframeId, count;
+  int64_t simTimeNs;
+  double resolution;
+  if (!reader.Byte(version) || version != kPoseStreamVersion ||
+      !reader.Byte(flags) || !reader.Varint(keyframeId) ||
+      !reader.Signed(simTimeNs) || !reader.Double(resolution) ||
+      !reader.Varint(count))
+  {
+    return false;
+  }
+
+  const bool isKeyframe = (flags & kKeyframeFlag) != 0u;
+  auto &d = *this->dataPtr;
+  if (!isKeyframe && (!d.hasKeyframe || keyframeId != d.keyframeId))
+    return false;
+
+  PoseStreamKeyframe keyframe;
+  _poses.reserve(std::min<uint64_t>(count, _buffer.size()));
+  Entity entity{0u};
+  for (uint64_t p = 0u; p < count; ++p)
+  {
+    int64_t idDelta;
+    uint8_t poseFlags;
+    if (!reader.Signed(idDelta) || !reader.Byte(poseFlags))
+    {
+      _poses.clear();
+      return false;
+    }
+    entity += static_cast<Entity>(idDelta);
+
+    QuantizedStreamPose quantized;
+    quantized.largest = poseFlags & 0x03u;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      if (!reader.Signed(quantized.position[i]))
+      {
+        _poses.clear();
+        return false;
+      }
+    }
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      if (!reader.Signed(quantized.orientation[i]))
+      {
+        _poses.clear();
+        return false;
+      }
+    }
+
+    if ((poseFlags & kAbsolutePoseFlag) == 0u)
+    {
+      auto it = d.keyframe.find(entity);
+      if (isKeyframe || it == d.keyframe.end())
+      {
+        _poses.clear();
+        return false;
+      }
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        quantized.position[i] += it->second.position[i];
+        quantized.orientation[i] += it->second.orientation[i];
+      }
+    }
+
+    if (isKeyframe)
+      keyframe[entity] = quantized;
+    _poses.emplace_back(entity, restore(quantized, resolution));
+  }
+
+  if (isKeyframe)
+  {
+    d.keyframe = std::move(keyframe);
+    d.keyframeId = keyframeId;
+    d.hasKeyframe = true;
+  }
+
+  _simTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds(simTimeNs));
+  return true;
+}
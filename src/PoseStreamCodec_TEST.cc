@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ignition/gazebo/PoseStreamCodec.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Check that decoded poses match the original ones within the
+/// quantization error.
+void expectNear(const std::vector<EntityPose> &_expected,
+    const std::vector<EntityPose> &_actual, const double _resolution)
+{
+  ASSERT_EQ(_expected.size(), _actual.size());
+  for (std::size_t i = 0; i < _expected.size(); ++i)
+  {
+    EXPECT_EQ(_expected[i].first, _actual[i].first);
+    const auto &expected = _expected[i].second;
+    const auto &actual = _actual[i].second;
+    EXPECT_LE(expected.Pos().Distance(actual.Pos()), _resolution);
+
+    // q and -q are the same rotation
+    EXPECT_NEAR(1.0, std::abs(expected.Rot().Dot(actual.Rot())), 1e-8);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStreamCodecTest, RoundTrip)
+{
+  PoseStreamOptions options;
+  options.positionResolution = 1e-3;
+  options.keyframeInterval = 3u;
+  PoseStreamEncoder encoder(options);
+  PoseStreamDecoder decoder;
+  EXPECT_FALSE(decoder.HasKeyframe());
+
+  std::vector<EntityPose> poses;
+  for (int i = 0; i < 50; ++i)
+  {
+    poses.emplace_back(10u + i * 3u, math::Pose3d(i * 0.5, -i * 0.25, 3.3,
+        0.1 * i, -0.2, 0.3 * i));
+  }
+
+  std::string keyframe;
+  EXPECT_TRUE(encoder.Encode(poses, 2s, keyframe));
+
+  std::chrono::steady_clock::duration simTime;
+  std::vector<EntityPose> decoded;
+  EXPECT_TRUE(decoder.Decode(keyframe, simTime, decoded));
+  EXPECT_TRUE(decoder.HasKeyframe());
+  EXPECT_EQ(2s, simTime);
+  expectNear(poses, decoded, options.positionResolution);
+
+  // Small motions are encoded relative to the keyframe
+  for (auto &pose : poses)
+    pose.second.Pos().X() += 0.01;
+
+  std::string delta;
+  EXPECT_FALSE(encoder.Encode(poses, 3s, delta));
+  EXPECT_LT(delta.size(), keyframe.size() / 2);
+  EXPECT_TRUE(decoder.Decode(delta, simTime, decoded));
+  EXPECT_EQ(3s, simTime);
+  expectNear(poses, decoded, options.positionResolution);
+
+  // A new entity doesn't need the keyframe
+  poses.emplace_back(500u, math::Pose3d(1, 2, 3, 0, 0, 1));
+  EXPECT_FALSE(encoder.Encode(poses, 4s, delta));
+  EXPECT_TRUE(decoder.Decode(delta, simTime, decoded));
+  expectNear(poses, decoded, options.positionResolution);
+
+  // The interval is reached
+  EXPECT_TRUE(encoder.Encode(poses, 5s, keyframe));
+
+  // A keyframe can be requested
+  EXPECT_FALSE(encoder.Encode(poses, 6s, delta));
+  encoder.RequestKeyframe();
+  EXPECT_TRUE(encoder.Encode(poses, 7s, keyframe));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseStreamCodecTest, MissingKeyframe)
+{
+  PoseStreamEncoder encoder;
+  PoseStreamDecoder decoder;
+
+  std::vector<EntityPose> poses{{1u, math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3)}};
+  std::string first, second, third;
+  EXPECT_TRUE(encoder.Encode(poses, 0s, first));
+  EXPECT_FALSE(encoder.Encode(poses, 1s, second));
+
+  // Frames can't be decoded before their keyframe
+  std::chrono::steady_clock::duration simTime;
+  std::vector<EntityPose> decoded;
+  EXPECT_FALSE(decoder.Decode(second, simTime, decoded));
+  EXPECT_TRUE(decoded.empty());
+
+  // But dropping a frame doesn't affect the next ones
+  EXPECT_TRUE(decoder.Decode(first, simTime, decoded));
+  EXPECT_FALSE(encoder.Encode(poses, 2s, third));
+  EXPECT_TRUE(decoder.Decode(third, simTime, decoded));
+  expectNear(poses, decoded, encoder.Options().positionResolution);
+
+  // Frames of an older keyframe are rejected
+  encoder.RequestKeyframe();
+  std::string newKeyframe;
+  EXPECT_TRUE(encoder.Encode(poses, 3s, newKeyframe));
+  EXPECT_TRUE(decoder.Decode(newKeyframe, simTime, decoded));
+  EXPECT_FALSE(decoder.Decode(second, simTime, decoded));
+
+  // Malformed frames are rejected
+  EXPECT_FALSE(decoder.Decode(std::string(), simTime, decoded));
+  EXPECT_FALSE(decoder.Decode(newKeyframe.substr(0, newKeyframe.size() - 1),
+      simTime, decoded));
+}
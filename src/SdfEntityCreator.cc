@@ -21,6 +21,7 @@
 
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 
 #include "ignition/gazebo/components/Actor.hh"
 #include "ignition/gazebo/components/AirPressureSensor.hh"
@@ -81,6 +82,8 @@
 #include "ignition/gazebo/components/WindMode.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "ThreadPool.hh"
+
 class ignition::gazebo::SdfEntityCreatorPrivate
 {
   /// \brief Pointer to entity component manager. We don't assume ownership.
@@ -100,8 +103,51 @@ class ignition::gazebo::SdfEntityCreatorPrivate
   /// \brief Keep track of new visuals being added, so we load their plugins
   /// only after we have their scoped name.
   public: std::map<Entity, sdf::Plugins> newVisuals;
+
+  /// \brief Entities of a model built once, to be copied by
+  /// CreateFromTemplate.
+  public: struct Template
+  {
+    /// \brief Manager holding the template entities.
+    std::unique_ptr<EntityComponentManager> ecm;
+
+    /// \brief Event manager of the template creator. Nothing listens to it.
+    std::unique_ptr<EventManager> eventMgr;
+
+    /// \brief Creator which built the template. It keeps the plugins of the
+    /// template entities, which are loaded for each copy.
+    std::unique_ptr<SdfEntityCreator> creator;
+
+    /// \brief Model entity in the template manager.
+    Entity model{kNullEntity};
+  };
+
+  /// \brief Templates built by CreateTemplate, indexed by id. Shared by
+  /// copies of the creator, since templates are never modified.
+  public: std::vector<std::shared_ptr<const Template>> templates;
+
+  /// \brief Load the plugins of new models, then of new sensors and then of
+  /// new visuals, and clear them.
+  public: void LoadNewPlugins();
+
+  /// \brief Move the new plugins of another creator into this one.
+  /// \param[in] _other Creator whose plugins will be moved.
+  /// \param[in] _copies New id of each entity of _other.
+  public: void AdoptNewPlugins(SdfEntityCreatorPrivate &_other,
+              const std::unordered_map<Entity, Entity> &_copies);
+
+  /// \brief Copy the new plugins of another creator into this one, leaving
+  /// the other creator unchanged.
+  /// \param[in] _other Creator whose plugins will be copied.
+  /// \param[in] _copies New id of each entity of _other.
+  public: void CopyNewPlugins(const SdfEntityCreatorPrivate &_other,
+              const std::unordered_map<Entity, Entity> &_copies);
 };
 
+/// \brief Worlds with at least this many models build their models
+/// concurrently. Smaller worlds load faster serially.
+static constexpr uint64_t kMinParallelModels{16u};
+
 using namespace ignition;
 using namespace gazebo;
 
@@ -221,6 +267,9 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
 {
   IGN_PROFILE("SdfEntityCreator::CreateEntities(sdf::World)");
 
+  // Update views once for the whole world instead of once per component
+  this->dataPtr->ecm->BeginBatchCreation();
+
   // World entity
   Entity worldEntity = this->dataPtr->ecm->CreateEntity();
 
@@ -251,13 +300,20 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
   }
 
   // Models
-  for (uint64_t modelIndex = 0; modelIndex < _world->ModelCount();
-      ++modelIndex)
+  if (_world->ModelCount() >= kMinParallelModels)
+  {
+    this->CreateModelsInParallel(_world, worldEntity);
+  }
+  else
   {
-    auto model = _world->ModelByIndex(modelIndex);
-    auto modelEntity = this->CreateEntities(model);
+    for (uint64_t modelIndex = 0; modelIndex < _world->ModelCount();
+        ++modelIndex)
+    {
+      auto model = _world->ModelByIndex(modelIndex);
+      auto modelEntity = this->CreateEntities(model);
 
-    this->SetParent(modelEntity, worldEntity);
+      this->SetParent(modelEntity, worldEntity);
+    }
   }
 
   // Actors
@@ -323,6 +379,8 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
   this->dataPtr->ecm->CreateComponent(worldEntity,
       components::MagneticField(_world->MagneticField()));
 
+  this->dataPtr->ecm->EndBatchCreation();
+
   this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(worldEntity,
       _world->Plugins());
   for (const sdf::Plugin &p : _world->Plugins())
@@ -342,46 +400,202 @@ Entity SdfEntityCreator::CreateEntities(const sdf::World *_world)
 Entity SdfEntityCreator::CreateEntities(const sdf::Model *_model)
 {
   IGN_PROFILE("SdfEntityCreator::CreateEntities(sdf::Model)");
+  StartupTrace::Scope scope("model", _model->Name());
 
+  // Update views once for the whole model instead of once per component
+  this->dataPtr->ecm->BeginBatchCreation();
   auto ent = this->CreateEntities(_model, false);
+  this->dataPtr->ecm->EndBatchCreation();
+
+  this->dataPtr->LoadNewPlugins();
+
+  return ent;
+}
+
+//////////////////////////////////////////////////
+void SdfEntityCreator::CreateModelsInParallel(const sdf::World *_world,
+    Entity _worldEntity)
+{
+  IGN_PROFILE("SdfEntityCreator::CreateModelsInParallel");
+
+  // Each top-level model is built in its own manager, which only needs the
+  // SDF of that model
+  const std::size_t count = _world->ModelCount();
+  std::vector<std::unique_ptr<EntityComponentManager>> stagedEcms(count);
+  std::vector<std::unique_ptr<EventManager>> stagedEventMgrs(count);
+  std::vector<std::unique_ptr<SdfEntityCreator>> stagedCreators(count);
+  std::vector<Entity> stagedModels(count, kNullEntity);
+  {
+    ThreadPool pool;
+    pool.ParallelFor(count, [&](std::size_t _begin, std::size_t _end)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        StartupTrace::Scope scope("model", _world->ModelByIndex(i)->Name());
+        stagedEcms[i] = std::make_unique<EntityComponentManager>();
+        stagedEventMgrs[i] = std::make_unique<EventManager>();
+        stagedCreators[i] = std::make_unique<SdfEntityCreator>(
+            *stagedEcms[i], *stagedEventMgrs[i]);
+
+        stagedEcms[i]->BeginBatchCreation();
+        stagedModels[i] = stagedCreators[i]->CreateEntities(
+            _world->ModelByIndex(i), false);
+        stagedEcms[i]->EndBatchCreation();
+      }
+    });
+  }
+
+  // Copy the models in order, so that entities get the same ids and plugins
+  // are loaded in the same order as when models are built one by one
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto copies = this->dataPtr->ecm->CopyEntities(*stagedEcms[i]);
+    auto modelIt = copies.find(stagedModels[i]);
+    if (modelIt == copies.end())
+      continue;
+
+    this->dataPtr->AdoptNewPlugins(*stagedCreators[i]->dataPtr, copies);
+    this->dataPtr->LoadNewPlugins();
+    this->SetParent(modelIt->second, _worldEntity);
+
+    stagedCreators[i].reset();
+    stagedEcms[i].reset();
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t SdfEntityCreator::CreateTemplate(const sdf::Model *_model)
+{
+  IGN_PROFILE("SdfEntityCreator::CreateTemplate");
+
+  auto tmpl = std::make_shared<SdfEntityCreatorPrivate::Template>();
+  tmpl->ecm = std::make_unique<EntityComponentManager>();
+  tmpl->eventMgr = std::make_unique<EventManager>();
+  tmpl->creator = std::make_unique<SdfEntityCreator>(*tmpl->ecm,
+      *tmpl->eventMgr);
+
+  // Plugins aren't loaded, so that they're kept for the copies
+  tmpl->ecm->BeginBatchCreation();
+  tmpl->model = tmpl->creator->CreateEntities(_model, false);
+  tmpl->ecm->EndBatchCreation();
+
+  this->dataPtr->templates.push_back(std::move(tmpl));
+  return this->dataPtr->templates.size() - 1;
+}
+
+//////////////////////////////////////////////////
+Entity SdfEntityCreator::CreateFromTemplate(std::size_t _template,
+    const std::string &_name, const math::Pose3d &_pose)
+{
+  IGN_PROFILE("SdfEntityCreator::CreateFromTemplate");
+
+  if (_template >= this->dataPtr->templates.size())
+  {
+    ignerr << "Invalid entity template [" << _template << "]" << std::endl;
+    return kNullEntity;
+  }
+  const auto &tmpl = *this->dataPtr->templates[_template];
+
+  auto copies = this->dataPtr->ecm->CopyEntities(*tmpl.ecm);
+  auto modelIt = copies.find(tmpl.model);
+  if (modelIt == copies.end())
+    return kNullEntity;
+  const Entity modelEntity = modelIt->second;
+
+  // The copy is new, so its components don't need to be marked as changed
+  auto nameComp = this->dataPtr->ecm->Component<components::Name>(
+      modelEntity);
+  if (nullptr != nameComp)
+    nameComp->Data() = _name;
+  auto poseComp = this->dataPtr->ecm->Component<components::Pose>(
+      modelEntity);
+  if (nullptr != poseComp)
+    poseComp->Data() = _pose;
+
+  this->dataPtr->CopyNewPlugins(*tmpl.creator->dataPtr, copies);
+  this->dataPtr->LoadNewPlugins();
+
+  return modelEntity;
+}
+
+//////////////////////////////////////////////////
+void SdfEntityCreatorPrivate::AdoptNewPlugins(SdfEntityCreatorPrivate &_other,
+    const std::unordered_map<Entity, Entity> &_copies)
+{
+  auto adopt = [&](std::map<Entity, sdf::Plugins> &_from,
+      std::map<Entity, sdf::Plugins> &_to)
+  {
+    for (auto &[entity, plugins] : _from)
+    {
+      auto it = _copies.find(entity);
+      if (it != _copies.end())
+        _to[it->second] = std::move(plugins);
+    }
+    _from.clear();
+  };
+  adopt(_other.newModels, this->newModels);
+  adopt(_other.newSensors, this->newSensors);
+  adopt(_other.newVisuals, this->newVisuals);
+}
+
+//////////////////////////////////////////////////
+void SdfEntityCreatorPrivate::CopyNewPlugins(
+    const SdfEntityCreatorPrivate &_other,
+    const std::unordered_map<Entity, Entity> &_copies)
+{
+  auto copy = [&](const std::map<Entity, sdf::Plugins> &_from,
+      std::map<Entity, sdf::Plugins> &_to)
+  {
+    for (const auto &[entity, plugins] : _from)
+    {
+      auto it = _copies.find(entity);
+      if (it != _copies.end())
+        _to[it->second] = plugins;
+    }
+  };
+  copy(_other.newModels, this->newModels);
+  copy(_other.newSensors, this->newSensors);
+  copy(_other.newVisuals, this->newVisuals);
+}
 
+//////////////////////////////////////////////////
+void SdfEntityCreatorPrivate::LoadNewPlugins()
+{
   // Load all model plugins afterwards, so we get scoped name for nested models.
-  for (const auto &[entity, plugins] : this->dataPtr->newModels)
+  for (const auto &[entity, plugins] : this->newModels)
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
     for (const sdf::Plugin &p : plugins)
     {
-      this->dataPtr->eventManager->Emit<events::LoadPlugins>(entity,
+      this->eventManager->Emit<events::LoadPlugins>(entity,
           p.ToElement());
     }
   }
-  this->dataPtr->newModels.clear();
+  this->newModels.clear();
 
   // Load sensor plugins after model, so we get scoped name.
-  for (const auto &[entity, plugins] : this->dataPtr->newSensors)
+  for (const auto &[entity, plugins] : this->newSensors)
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
     for (const sdf::Plugin &p : plugins)
     {
-      this->dataPtr->eventManager->Emit<events::LoadPlugins>(entity,
+      this->eventManager->Emit<events::LoadPlugins>(entity,
           p.ToElement());
     }
   }
-  this->dataPtr->newSensors.clear();
+  this->newSensors.clear();
 
   // Load visual plugins after model, so we get scoped name.
-  for (const auto &[entity, plugins] : this->dataPtr->newVisuals)
+  for (const auto &[entity, plugins] : this->newVisuals)
   {
-    this->dataPtr->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
+    this->eventManager->Emit<events::LoadSdfPlugins>(entity, plugins);
     for (const sdf::Plugin &p : plugins)
     {
-      this->dataPtr->eventManager->Emit<events::LoadPlugins>(entity,
+      this->eventManager->Emit<events::LoadPlugins>(entity,
           p.ToElement());
     }
   }
-  this->dataPtr->newVisuals.clear();
-
-  return ent;
+  this->newVisuals.clear();
 }
 
 //////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 #include <sdf/Sphere.hh>
 
 #include "ignition/gazebo/test_config.hh"
+#include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/CastShadows.hh"
 #include "ignition/gazebo/components/ChildLinkName.hh"
@@ -1271,3 +1272,194 @@ TEST_F(SdfEntityCreatorTest, EachRemovedRecursiveRemoved)
   EXPECT_EQ(0u, removedCount<components::Collision>(ecm));
   EXPECT_EQ(0u, removedCount<components::Visual>(ecm));
 }
+
+/////////////////////////////////////////////////
+TEST_F(SdfEntityCreatorTest, CreateModelsInParallel)
+{
+  // Enough models for them to be built concurrently
+  const std::size_t modelCount{40u};
+  std::string sdfStr = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="parallel">)";
+  for (std::size_t i = 0; i < modelCount; ++i)
+  {
+    sdfStr += R"(
+    <model name="model_)" + std::to_string(i) + R"(">
+      <pose>)" + std::to_string(i) + R"( 0 0 0 0 0</pose>
+      <link name="base">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+        <visual name="visual">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </visual>
+      </link>
+      <link name="arm"/>
+      <joint name="joint" type="revolute">
+        <parent>base</parent>
+        <child>arm</child>
+        <axis><xyz>0 0 1</xyz></axis>
+      </joint>
+      <model name="nested">
+        <link name="nested_link"/>
+      </model>
+      <plugin filename="plugin_)" + std::to_string(i) + R"(" name="plugin"/>
+    </model>)";
+  }
+  sdfStr += R"(
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  ASSERT_TRUE(root.LoadSdfString(sdfStr).empty());
+  ASSERT_EQ(1u, root.WorldCount());
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_EQ(modelCount, world->ModelCount());
+
+  std::vector<std::pair<Entity, std::string>> loadedPlugins;
+  auto conn = this->evm.Connect<events::LoadSdfPlugins>(
+      [&](const Entity _entity, const sdf::Plugins &_plugins)
+      {
+        for (const auto &plugin : _plugins)
+          loadedPlugins.push_back({_entity, plugin.Filename()});
+      });
+
+  SdfEntityCreator creator(this->ecm, this->evm);
+  const Entity worldEntity = creator.CreateEntities(world);
+
+  // Build the same models one by one in another manager
+  EntityComponentManager serialEcm;
+  EventManager serialEvm;
+  SdfEntityCreator serialCreator(serialEcm, serialEvm);
+  const Entity serialWorld = serialEcm.CreateEntity();
+  EXPECT_EQ(worldEntity, serialWorld);
+  for (uint64_t i = 0; i < world->ModelCount(); ++i)
+  {
+    serialCreator.SetParent(
+        serialCreator.CreateEntities(world->ModelByIndex(i)), serialWorld);
+  }
+
+  // Entities get the same ids, names, parents and components
+  ASSERT_EQ(serialEcm.EntityCount(), this->ecm.EntityCount());
+  serialEcm.Each<components::Name>(
+      [&](const Entity &_entity, const components::Name *_name) -> bool
+      {
+        auto name = this->ecm.Component<components::Name>(_entity);
+        EXPECT_NE(nullptr, name);
+        if (nullptr == name)
+          return true;
+        EXPECT_EQ(_name->Data(), name->Data());
+
+        auto parent = this->ecm.ParentEntity(_entity);
+        EXPECT_EQ(serialEcm.ParentEntity(_entity), parent);
+        EXPECT_EQ(serialEcm.ComponentTypes(_entity),
+            this->ecm.ComponentTypes(_entity));
+        return true;
+      });
+
+  // References to other entities point to the copies
+  auto models = this->ecm.ChildrenByComponents(worldEntity,
+      components::Model());
+  ASSERT_EQ(modelCount, models.size());
+  for (const Entity model : models)
+  {
+    auto canonical = this->ecm.Component<components::ModelCanonicalLink>(
+        model);
+    ASSERT_NE(nullptr, canonical);
+    EXPECT_EQ(model, this->ecm.ParentEntity(canonical->Data()));
+    EXPECT_EQ("base",
+        this->ecm.Component<components::Name>(canonical->Data())->Data());
+  }
+
+  // Plugins are loaded for the copies, in model order
+  ASSERT_EQ(modelCount, loadedPlugins.size());
+  for (std::size_t i = 0; i < modelCount; ++i)
+  {
+    EXPECT_EQ("plugin_" + std::to_string(i), loadedPlugins[i].second);
+    EXPECT_EQ("model_" + std::to_string(i), this->ecm.Component<
+        components::Name>(loadedPlugins[i].first)->Data());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SdfEntityCreatorTest, CreateFromTemplate)
+{
+  sdf::Root root;
+  ASSERT_TRUE(root.LoadSdfString(R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <model name="crumb">
+    <pose>0 0 1 0 0 0</pose>
+    <link name="base">
+      <visual name="visual">
+        <geometry><box><size>1 1 1</size></box></geometry>
+      </visual>
+    </link>
+    <link name="top"/>
+    <joint name="joint" type="fixed">
+      <parent>base</parent>
+      <child>top</child>
+    </joint>
+    <plugin filename="crumb_plugin" name="plugin"/>
+  </model>
+</sdf>)").empty());
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+
+  std::vector<std::pair<Entity, std::string>> loadedPlugins;
+  auto conn = this->evm.Connect<events::LoadSdfPlugins>(
+      [&](const Entity _entity, const sdf::Plugins &_plugins)
+      {
+        for (const auto &plugin : _plugins)
+          loadedPlugins.push_back({_entity, plugin.Filename()});
+      });
+
+  SdfEntityCreator creator(this->ecm, this->evm);
+  const Entity worldEntity = this->ecm.CreateEntity();
+
+  // The template isn't part of the manager
+  const std::size_t tmpl = creator.CreateTemplate(model);
+  EXPECT_EQ(1u, this->ecm.EntityCount());
+  EXPECT_TRUE(loadedPlugins.empty());
+
+  EXPECT_EQ(kNullEntity, creator.CreateFromTemplate(tmpl + 1, "invalid",
+      math::Pose3d::Zero));
+
+  // Copies match the entities built straight from the model
+  EntityComponentManager sdfEcm;
+  EventManager sdfEvm;
+  SdfEntityCreator sdfCreator(sdfEcm, sdfEvm);
+  const Entity sdfModel = sdfCreator.CreateEntities(model);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    const std::string name = "crumb_" + std::to_string(i);
+    const math::Pose3d pose(i, 0, 0, 0, 0, 0);
+    const Entity copy = creator.CreateFromTemplate(tmpl, name, pose);
+    ASSERT_NE(kNullEntity, copy);
+    creator.SetParent(copy, worldEntity);
+
+    EXPECT_EQ(name, this->ecm.Component<components::Name>(copy)->Data());
+    EXPECT_EQ(pose, this->ecm.Component<components::Pose>(copy)->Data());
+    EXPECT_EQ(worldEntity, this->ecm.ParentEntity(copy));
+    EXPECT_EQ(sdfEcm.ComponentTypes(sdfModel),
+        this->ecm.ComponentTypes(copy));
+
+    auto links = this->ecm.ChildrenByComponents(copy, components::Link());
+    EXPECT_EQ(2u, links.size());
+    auto joints = this->ecm.ChildrenByComponents(copy, components::Joint());
+    EXPECT_EQ(1u, joints.size());
+
+    auto canonical = this->ecm.Component<components::ModelCanonicalLink>(
+        copy);
+    ASSERT_NE(nullptr, canonical);
+    EXPECT_EQ(copy, this->ecm.ParentEntity(canonical->Data()));
+
+    // Plugins are loaded for each copy
+    ASSERT_EQ(static_cast<std::size_t>(i + 1), loadedPlugins.size());
+    EXPECT_EQ(copy, loadedPlugins.back().first);
+    EXPECT_EQ("crumb_plugin", loadedPlugins.back().second);
+  }
+  EXPECT_EQ(1u + 3u * sdfEcm.EntityCount(), this->ecm.EntityCount());
+}
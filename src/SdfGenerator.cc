@@ -18,7 +18,13 @@
 #include "SdfGenerator.hh"
 
 #include <ctype.h>
+#include <algorithm>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <sdf/sdf.hh>
@@ -59,6 +65,8 @@
 #include "ignition/gazebo/components/WindMode.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "ThreadPool.hh"
+
 
 namespace ignition
 {
@@ -270,26 +278,40 @@ namespace sdf_generator
   }
 
   /////////////////////////////////////////////////
-  std::optional<std::string> generateWorld(
-      const EntityComponentManager &_ecm, const Entity &_entity,
-      const IncludeUriMap &_includeUriMap,
-      const msgs::SdfGeneratorConfig &_config)
+  /// \brief A direct child of a world which is generated from the ECM.
+  struct WorldChild
   {
-    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
-    sdf::initFile("root.sdf", elem);
-    auto worldElem = elem->AddElement("world");
-    if (!updateWorldElement(worldElem, _ecm, _entity, _includeUriMap, _config))
-      return std::nullopt;
+    /// \brief Entity of the model or light.
+    Entity entity{kNullEntity};
 
-    return elem->ToString("");
-  }
+    /// \brief Name of the element, one of "model", "include" and "light".
+    std::string type;
+
+    /// \brief URI of an include.
+    std::string uri;
+
+    /// \brief Whether the includes nested in an expanded model are kept.
+    bool nestedIncludes{false};
+
+    /// \brief Whether Fuel versions are kept in nested includes.
+    bool saveFuelVersion{false};
+  };
 
   /////////////////////////////////////////////////
-  bool updateWorldElement(sdf::ElementPtr _elem,
-                          const EntityComponentManager &_ecm,
-                          const Entity &_entity,
-                          const IncludeUriMap &_includeUriMap,
-                          const msgs::SdfGeneratorConfig &_config)
+  /// \brief Copy the world's SDF without the children that are generated
+  /// from the ECM, and list those children in the order they're generated.
+  /// \param[in, out] _elem World element
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _entity World entity
+  /// \param[in] _includeUriMap Map from file paths to URIs
+  /// \param[in] _config Configuration for the world generator
+  /// \param[out] _children Children to generate
+  /// \returns False if the world has no SDF.
+  static bool prepareWorldElement(const sdf::ElementPtr &_elem,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config,
+      std::vector<WorldChild> &_children)
   {
     const auto *worldSdf = _ecm.Component<components::WorldSdf>(_entity);
 
@@ -357,17 +379,16 @@ namespace sdf_generator
             mergeWithOverride(modelConfig, modelConfigIt->second);
           }
 
+          WorldChild child;
+          child.entity = _modelEntity;
+          child.saveFuelVersion = modelConfig.save_fuel_version().data();
+
           if (modelConfig.expand_include_tags().data() || !modelFromInclude)
           {
-            auto modelElem = _elem->AddElement("model");
-            updateModelElement(modelElem, _ecm, _modelEntity);
+            child.type = "model";
 
             // Check & update possible //model/include(s)
-            if (!modelConfig.expand_include_tags().data())
-            {
-              updateModelElementWithNestedInclude(modelElem,
-                    modelConfig.save_fuel_version().data(), _includeUriMap);
-            }
+            child.nestedIncludes = !modelConfig.expand_include_tags().data();
           }
           else if (uriMapIt != _includeUriMap.end())
           {
@@ -406,18 +427,18 @@ namespace sdf_generator
               uri.Path() /= common::basename(modelDir);
             }
 
-            auto includeElem = _elem->AddElement("include");
-            updateIncludeElement(includeElem, _ecm, _modelEntity, uri.Str());
+            child.type = "include";
+            child.uri = uri.Str();
           }
           else
           {
             // The model is not in the includeUriMap, but expandIncludeTags =
             // false, so we will assume that its uri is the file path of the
             // model on the local machine
-            auto includeElem = _elem->AddElement("include");
-            const std::string uri = "file://" + modelDir;
-            updateIncludeElement(includeElem, _ecm, _modelEntity, uri);
+            child.type = "include";
+            child.uri = "file://" + modelDir;
           }
+          _children.push_back(std::move(child));
           return true;
         });
 
@@ -430,15 +451,322 @@ namespace sdf_generator
           if (_parent->Data() != _entity)
             return true;
 
-           auto lightElem = _elem->AddElement("light");
-           updateLightElement(lightElem, _ecm, _lightEntity);
-
+          WorldChild child;
+          child.entity = _lightEntity;
+          child.type = "light";
+          _children.push_back(std::move(child));
           return true;
         });
 
     return true;
   }
 
+  /////////////////////////////////////////////////
+  /// \brief Update the element of a direct child of a world.
+  /// \param[in, out] _elem Element to update, whose name is _child.type
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _child Child to generate
+  /// \param[in] _includeUriMap Map from file paths to URIs
+  static void updateWorldChildElement(sdf::ElementPtr _elem,
+      const EntityComponentManager &_ecm, const WorldChild &_child,
+      const IncludeUriMap &_includeUriMap)
+  {
+    if (_child.type == "model")
+    {
+      updateModelElement(_elem, _ecm, _child.entity);
+      if (_child.nestedIncludes)
+      {
+        updateModelElementWithNestedInclude(_elem, _child.saveFuelVersion,
+            _includeUriMap);
+      }
+    }
+    else if (_child.type == "include")
+    {
+      updateIncludeElement(_elem, _ecm, _child.entity, _child.uri);
+    }
+    else
+    {
+      updateLightElement(_elem, _ecm, _child.entity);
+    }
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Key of a child's cached SDF, made of all the options that
+  /// affect it.
+  /// \param[in] _child Child to generate
+  /// \return Key
+  static std::string worldChildCacheKey(const WorldChild &_child)
+  {
+    return _child.type + "|" + _child.uri + "|" +
+        (_child.nestedIncludes ? "1" : "0") +
+        (_child.saveFuelVersion ? "1" : "0");
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Summary of the entities under an entity, used to tell whether
+  /// its cached SDF is still valid.
+  struct SubtreeState
+  {
+    /// \brief Number of entities, the entity included.
+    std::size_t entityCount{0u};
+
+    /// \brief Sum of the entity ids.
+    uint64_t entitySum{0u};
+
+    /// \brief Number of components of all the entities.
+    std::size_t componentCount{0u};
+
+    /// \brief Latest change tick of the components.
+    uint64_t latestTick{0u};
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Summarize the entities under an entity.
+  /// \param[in] _ecm Immutable reference to the Entity Component Manager
+  /// \param[in] _entity Entity
+  /// \return Summary
+  static SubtreeState subtreeState(const EntityComponentManager &_ecm,
+      const Entity _entity)
+  {
+    SubtreeState state;
+    for (const Entity entity : _ecm.Descendants(_entity))
+    {
+      ++state.entityCount;
+      state.entitySum += entity;
+      for (const auto typeId : _ecm.ComponentTypes(entity))
+      {
+        ++state.componentCount;
+        state.latestTick = std::max(state.latestTick,
+            _ecm.ComponentChangeTick(entity, typeId));
+      }
+    }
+    return state;
+  }
+
+  /////////////////////////////////////////////////
+  class EntitySdfCachePrivate
+  {
+    /// \brief Cached SDF of an entity.
+    public: struct Entry
+    {
+      /// \brief Options the SDF was generated with.
+      std::string key;
+
+      /// \brief Generated SDF.
+      std::string sdf;
+
+      /// \brief Change tick of the ECM when the SDF was generated.
+      uint64_t tick{0u};
+
+      /// \brief Entities under the entity when the SDF was generated.
+      SubtreeState state;
+    };
+
+    /// \brief Cached SDF by entity.
+    public: std::unordered_map<Entity, Entry> entries;
+  };
+
+  /////////////////////////////////////////////////
+  EntitySdfCache::EntitySdfCache()
+    : dataPtr(std::make_unique<EntitySdfCachePrivate>())
+  {
+  }
+
+  /////////////////////////////////////////////////
+  EntitySdfCache::~EntitySdfCache() = default;
+
+  /////////////////////////////////////////////////
+  std::size_t EntitySdfCache::Size() const
+  {
+    return this->dataPtr->entries.size();
+  }
+
+  /////////////////////////////////////////////////
+  void EntitySdfCache::Clear()
+  {
+    this->dataPtr->entries.clear();
+  }
+
+  /////////////////////////////////////////////////
+  std::optional<std::string> generateWorld(
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config)
+  {
+    std::ostringstream out;
+    if (!generateWorld(out, _ecm, _entity, _includeUriMap, _config))
+      return std::nullopt;
+
+    return out.str();
+  }
+
+  /////////////////////////////////////////////////
+  bool generateWorld(std::ostream &_out,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config,
+      EntitySdfCache *_cache, ThreadPool *_pool)
+  {
+    sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+    sdf::initFile("root.sdf", elem);
+    auto worldElem = elem->AddElement("world");
+    std::vector<WorldChild> children;
+    if (!prepareWorldElement(worldElem, _ecm, _entity, _includeUriMap,
+        _config, children))
+    {
+      return false;
+    }
+
+    // The generated children go at the end of the world, so the world is
+    // written up to its closing tag, then each child, then the rest. A world
+    // without any elements is closed on its opening tag, and has to be
+    // generated as a whole.
+    const std::string head = elem->ToString("");
+    const auto closePos = head.rfind("</world>");
+    if (closePos == std::string::npos)
+    {
+      for (const auto &child : children)
+      {
+        updateWorldChildElement(worldElem->AddElement(child.type), _ecm,
+            child, _includeUriMap);
+      }
+      _out << elem->ToString("");
+      return _out.good();
+    }
+    const auto closeLine = head.rfind('\n', closePos) + 1u;
+
+    // Children are indented under <sdf> and <world>
+    const std::string childPrefix{"    "};
+
+    // Children whose entities didn't change since they were cached are
+    // written from the cache
+    const uint64_t tick = _ecm.ChangeTick();
+    std::vector<SubtreeState> childStates(children.size());
+    std::vector<char> cached(children.size(), 0);
+    if (nullptr != _cache)
+    {
+      auto validate = [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          childStates[i] = subtreeState(_ecm, children[i].entity);
+          auto entryIt = _cache->dataPtr->entries.find(children[i].entity);
+          if (entryIt == _cache->dataPtr->entries.end())
+            continue;
+
+          // Changes made during the tick the entry was generated in may
+          // have come after it
+          const auto &entry = entryIt->second;
+          const auto &state = childStates[i];
+          cached[i] = entry.key == worldChildCacheKey(children[i]) &&
+              state.latestTick < entry.tick &&
+              state.entityCount == entry.state.entityCount &&
+              state.entitySum == entry.state.entitySum &&
+              state.componentCount == entry.state.componentCount;
+        }
+      };
+      if (nullptr != _pool)
+        _pool->ParallelFor(children.size(), validate, 64u);
+      else
+        validate(0u, children.size());
+    }
+
+    // The elements of the other children are created up front under a
+    // scratch world, since adding elements to a parent isn't thread safe
+    auto scratchWorld = elem->AddElement("world");
+    std::vector<sdf::ElementPtr> childElems(children.size());
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+      if (!cached[i])
+        childElems[i] = scratchWorld->AddElement(children[i].type);
+    }
+
+    // Each child only reads the ECM and writes its own element
+    std::vector<std::string> childSdf(children.size());
+    auto generate = [&](std::size_t _begin, std::size_t _end)
+    {
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        if (cached[i])
+          continue;
+
+        updateWorldChildElement(childElems[i], _ecm, children[i],
+            _includeUriMap);
+        childSdf[i] = childElems[i]->ToString(childPrefix);
+
+        // The element isn't needed once it's written
+        childElems[i]->ClearElements();
+      }
+    };
+    if (nullptr != _pool)
+      _pool->ParallelFor(children.size(), generate, 16u);
+    else
+      generate(0u, children.size());
+
+    _out.write(head.data(), static_cast<std::streamsize>(closeLine));
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+      if (cached[i])
+      {
+        _out << _cache->dataPtr->entries.at(children[i].entity).sdf;
+        continue;
+      }
+      _out << childSdf[i];
+
+      if (nullptr != _cache)
+      {
+        auto &entry = _cache->dataPtr->entries[children[i].entity];
+        entry.key = worldChildCacheKey(children[i]);
+        entry.sdf = std::move(childSdf[i]);
+        entry.tick = tick;
+        entry.state = childStates[i];
+      }
+    }
+    _out.write(head.data() + closeLine,
+        static_cast<std::streamsize>(head.size() - closeLine));
+
+    // Forget the entities which aren't children of the world anymore
+    if (nullptr != _cache)
+    {
+      std::unordered_set<Entity> current;
+      for (const auto &child : children)
+        current.insert(child.entity);
+      for (auto it = _cache->dataPtr->entries.begin();
+           it != _cache->dataPtr->entries.end();)
+      {
+        if (current.count(it->first) == 0u)
+          it = _cache->dataPtr->entries.erase(it);
+        else
+          ++it;
+      }
+    }
+
+    return _out.good();
+  }
+
+  /////////////////////////////////////////////////
+  bool updateWorldElement(sdf::ElementPtr _elem,
+                          const EntityComponentManager &_ecm,
+                          const Entity &_entity,
+                          const IncludeUriMap &_includeUriMap,
+                          const msgs::SdfGeneratorConfig &_config)
+  {
+    std::vector<WorldChild> children;
+    if (!prepareWorldElement(_elem, _ecm, _entity, _includeUriMap, _config,
+        children))
+    {
+      return false;
+    }
+
+    for (const auto &child : children)
+    {
+      updateWorldChildElement(_elem->AddElement(child.type), _ecm, child,
+          _includeUriMap);
+    }
+
+    return true;
+  }
+
   /////////////////////////////////////////////////
   bool updateModelElement(const sdf::ElementPtr &_elem,
                           const EntityComponentManager &_ecm,
@@ -918,11 +1246,13 @@ namespace sdf_generator
       _elem->RemoveChild(e);
     }
 
-    auto sensorEntities = _ecm.EntitiesByComponents(
-        components::ParentEntity(_entity), components::Sensor());
-
-    for (const auto &sensorEnt : sensorEntities)
+    // Go through the joint's children instead of a view, so that joints can
+    // be updated concurrently
+    for (const Entity sensorEnt : _ecm.Children(_entity))
     {
+      if (nullptr == _ecm.Component<components::Sensor>(sensorEnt))
+        continue;
+
       sdf::ElementPtr sensorElem = _elem->AddElement("sensor");
       updateSensorElement(sensorElem, _ecm, sensorEnt);
     }
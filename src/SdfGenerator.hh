@@ -20,7 +20,9 @@
 #include <ignition/msgs/sdf_generator_config.pb.h>
 
 #include <sdf/Element.hh>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <string>
 #include <unordered_map>
 
@@ -33,10 +35,48 @@ namespace gazebo
 // Inline bracket to help doxygen filtering.
 inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 {
+// Forward declarations.
+class ThreadPool;
+
 namespace sdf_generator
 {
+  // Forward declarations.
+  class EntitySdfCachePrivate;
+
   using IncludeUriMap = std::unordered_map<std::string, std::string>;
 
+  /// \brief SDFormat generated for the direct children of a world, such as
+  /// its models, kept from one generation to the next. A child whose
+  /// entities and components haven't changed since it was generated, going
+  /// by the ECM's change ticks, is written from the cache instead of being
+  /// generated again. As with other change tick consumers, components
+  /// modified without EntityComponentManager::SetChanged aren't picked up.
+  class IGNITION_GAZEBO_VISIBLE EntitySdfCache
+  {
+    /// \brief Constructor
+    public: EntitySdfCache();
+
+    /// \brief Destructor
+    public: ~EntitySdfCache();
+
+    /// \brief Get the number of cached children.
+    /// \return Number of children.
+    public: std::size_t Size() const;
+
+    /// \brief Forget all cached children.
+    public: void Clear();
+
+    /// \brief The generator reads and fills the cache.
+    private: friend bool generateWorld(std::ostream &_out,
+                 const EntityComponentManager &_ecm, const Entity &_entity,
+                 const IncludeUriMap &_includeUriMap,
+                 const msgs::SdfGeneratorConfig &_config,
+                 EntitySdfCache *_cache, ThreadPool *_pool);
+
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<EntitySdfCachePrivate> dataPtr;
+  };
+
   /// \brief Generate the SDFormat representation of a world
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
   /// \input[in] _entity World entity
@@ -51,6 +91,30 @@ namespace sdf_generator
       const IncludeUriMap &_includeUriMap = IncludeUriMap(),
       const msgs::SdfGeneratorConfig &_config = msgs::SdfGeneratorConfig());
 
+  /// \brief Write the SDFormat representation of a world to a stream. The
+  /// direct children of the world, such as models, are generated one by one
+  /// and written as they're done instead of building the whole document in
+  /// memory first.
+  /// \input[out] _out Stream to write to
+  /// \input[in] _ecm Immutable reference to the Entity Component Manager
+  /// \input[in] _entity World entity
+  /// \input[in] _includeUriMap Map from file paths to URIs used to preserve
+  /// included Fuel models
+  /// \input[in] _config Configuration for the world generator
+  /// \input[in, out] _cache Children generated by a previous call, which are
+  /// reused if they didn't change, and updated with this call's children.
+  /// Null to generate all children.
+  /// \input[in] _pool Pool which generates children concurrently, or null to
+  /// generate them on the calling thread. Nothing may modify the ECM while
+  /// the world is generated.
+  /// \returns True if the world was generated and written.
+  IGNITION_GAZEBO_VISIBLE
+  bool generateWorld(std::ostream &_out,
+      const EntityComponentManager &_ecm, const Entity &_entity,
+      const IncludeUriMap &_includeUriMap,
+      const msgs::SdfGeneratorConfig &_config,
+      EntitySdfCache *_cache = nullptr, ThreadPool *_pool = nullptr);
+
   /// \brief Update a sdf::Element of a world. Intended for internal use.
   /// \input[in, out] _elem sdf::Element to update
   /// \input[in] _ecm Immutable reference to the Entity Component Manager
@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 #include <tinyxml2.h>
 
+#include <sstream>
+#include <string>
+
 #include <ignition/common/Console.hh>
 #include <ignition/fuel_tools/ClientConfig.hh>
 #include <ignition/fuel_tools/Interface.hh>
@@ -44,6 +47,7 @@
 #include "helpers/EnvTestFixture.hh"
 
 #include "SdfGenerator.hh"
+#include "ThreadPool.hh"
 
 using namespace ignition;
 using namespace gazebo;
@@ -305,7 +309,22 @@ class ElementUpdateFixture : public InternalFixture<::testing::Test>
     return nullptr;
   }
 
-  public: EntityComponentManager ecm;
+  /// \brief Lets tests move on to the next change tick and process
+  /// removals, as the simulation runner does on every iteration.
+  public: class TickingEntityComponentManager : public EntityComponentManager
+  {
+    public: void AdvanceTick()
+    {
+      this->AdvanceChangeTick();
+    }
+
+    public: void ProcessRemovals()
+    {
+      this->ProcessRemoveEntityRequests();
+    }
+  };
+
+  public: TickingEntityComponentManager ecm;
   public: EventManager evm;
   public: sdf::Root root;
   public: const sdf::World *world{nullptr};
@@ -1048,6 +1067,76 @@ TEST_F(GenerateWorldFixture, PoseWithAttributes)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(GenerateWorldFixture, StreamCacheAndPool)
+{
+  std::string worldSdf = R"(
+<?xml version="1.0" ?>
+<sdf version="1.9">
+  <world name="test_cache">
+    <light type="directional" name="sun">
+      <pose>0 0 10 0 0 0</pose>
+    </light>)";
+  for (int i = 0; i < 40; ++i)
+  {
+    worldSdf += R"(
+    <model name="box_)" + std::to_string(i) + R"(">
+      <pose>)" + std::to_string(i) + R"( 0 0.5 0 0 0</pose>
+      <link name="link">
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+      </link>
+    </model>)";
+  }
+  worldSdf += R"(
+  </world>
+</sdf>)";
+  this->LoadWorldString(worldSdf);
+  Entity worldEntity = this->ecm.EntityByComponents(components::World());
+
+  const auto reference = sdf_generator::generateWorld(this->ecm, worldEntity);
+  ASSERT_TRUE(reference.has_value());
+
+  // Streaming on a pool gives the same document
+  sdf_generator::EntitySdfCache cache;
+  ThreadPool pool(4u);
+  auto generate = [&]()
+  {
+    std::ostringstream out;
+    EXPECT_TRUE(sdf_generator::generateWorld(out, this->ecm, worldEntity,
+        this->includeUriMap, this->sdfGenConfig, &cache, &pool));
+    return out.str();
+  };
+  EXPECT_EQ(*reference, generate());
+  EXPECT_EQ(41u, cache.Size());
+
+  // Unchanged children come from the cache
+  this->ecm.AdvanceTick();
+  EXPECT_EQ(*reference, generate());
+
+  // Changed children are generated again
+  Entity box = this->ecm.EntityByComponents(components::Model(),
+      components::Name("box_3"));
+  ASSERT_NE(kNullEntity, box);
+  this->ecm.SetComponentData<components::Pose>(box,
+      math::Pose3d(3, 4, 0.5, 0, 0, 0));
+  this->ecm.AdvanceTick();
+
+  const auto moved = sdf_generator::generateWorld(this->ecm, worldEntity);
+  ASSERT_TRUE(moved.has_value());
+  EXPECT_NE(*reference, *moved);
+  EXPECT_EQ(*moved, generate());
+
+  // Children which are gone are forgotten
+  this->ecm.RequestRemoveEntity(box);
+  this->ecm.ProcessRemovals();
+  this->ecm.AdvanceTick();
+  const auto removed = generate();
+  EXPECT_EQ(40u, cache.Size());
+  EXPECT_EQ(std::string::npos, removed.find("box_3'"));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int _argc, char **_argv)
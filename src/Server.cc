@@ -15,7 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
 #include <numeric>
+#include <sstream>
 
 #include <ignition/common/SystemPaths.hh>
 #include <ignition/fuel_tools/Interface.hh>
@@ -25,10 +30,12 @@
 
 #include "ignition/gazebo/config.hh"
 #include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 #include "ignition/gazebo/Util.hh"
 
 #include "ServerPrivate.hh"
 #include "SimulationRunner.hh"
+#include "ThreadPool.hh"
 
 using namespace ignition;
 using namespace gazebo;
@@ -55,6 +62,7 @@ struct DefaultWorld
 Server::Server(const ServerConfig &_config)
   : dataPtr(new ServerPrivate)
 {
+  StartupTrace::Instance().Start();
   this->dataPtr->config = _config;
 
   // Configure the fuel client
@@ -72,6 +80,7 @@ Server::Server(const ServerConfig &_config)
   addResourcePaths();
 
   sdf::Errors errors;
+  const auto sdfLoadStart = std::chrono::steady_clock::now();
 
   switch (_config.Source())
   {
@@ -95,7 +104,12 @@ Server::Server(const ServerConfig &_config)
         msg += "File path [" + _config.SdfFile() + "].\n";
       }
       ignmsg <<  msg;
-      errors = this->dataPtr->sdfRoot.LoadSdfString(_config.SdfString());
+      if (!this->dataPtr->LoadWorldCache(
+          _config.SdfFile() + '\n' + _config.SdfString()))
+      {
+        this->dataPtr->PrefetchFuelResources(_config.SdfString());
+        errors = this->dataPtr->sdfRoot.LoadSdfString(_config.SdfString());
+      }
       break;
     }
 
@@ -113,11 +127,28 @@ Server::Server(const ServerConfig &_config)
 
       ignmsg << "Loading SDF world file[" << filePath << "].\n";
 
+      // Included files are found relative to the world file, so its path is
+      // part of the source
+      if (!_config.WorldCache().empty())
+      {
+        std::ifstream file(filePath, std::ios::binary);
+        std::stringstream source;
+        source << filePath << '\n' << file.rdbuf();
+        if (this->dataPtr->LoadWorldCache(source.str()))
+          break;
+      }
+
       // \todo(nkoenig) Async resource download.
       // This call can block for a long period of time while
       // resources are downloaded. Blocking here causes the GUI to block with
       // a black screen (search for "Async resource download" in
       // 'src/gui_main.cc'.
+      {
+        std::ifstream file(filePath);
+        std::stringstream sdf;
+        sdf << file.rdbuf();
+        this->dataPtr->PrefetchFuelResources(sdf.str());
+      }
       errors = this->dataPtr->sdfRoot.Load(filePath);
       break;
     }
@@ -133,6 +164,9 @@ Server::Server(const ServerConfig &_config)
     }
   }
 
+  StartupTrace::Instance().Add("sdf_load", _config.SdfFile(), sdfLoadStart,
+      std::chrono::steady_clock::now());
+
   if (!errors.empty())
   {
     for (auto &err : errors)
@@ -147,6 +181,7 @@ Server::Server(const ServerConfig &_config)
   }
 
   this->dataPtr->CreateEntities();
+  this->dataPtr->SaveWorldCache();
 
   // Set the desired update period, this will override the desired RTF given in
   // the world file which was parsed by CreateEntities.
@@ -221,6 +256,133 @@ bool Server::RunOnce(const bool _paused)
   return this->Run(true, 1, _paused);
 }
 
+/////////////////////////////////////////////////
+std::optional<bool> Server::Step(const uint64_t _iterations,
+    const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+    return std::nullopt;
+
+  return this->dataPtr->StepWorld(_iterations, _worldIndex);
+}
+
+/////////////////////////////////////////////////
+std::future<bool> Server::StepAsync(const uint64_t _iterations,
+    const unsigned int _worldIndex)
+{
+  auto promise = std::make_shared<std::promise<bool>>();
+  std::future<bool> future = promise->get_future();
+  if (!this->StepAsync(_iterations,
+        [promise](bool _result) {promise->set_value(_result);}, _worldIndex))
+  {
+    promise->set_value(false);
+  }
+  return future;
+}
+
+/////////////////////////////////////////////////
+bool Server::StepAsync(const uint64_t _iterations,
+    const std::function<void(bool)> &_done, const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+  {
+    ignerr << "Invalid world index [" << _worldIndex << "].\n";
+    return false;
+  }
+
+  this->dataPtr->QueueStep({_iterations, _worldIndex, _done});
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Server::SetStepHooks(
+    const std::function<void(const UpdateInfo &,
+        EntityComponentManager &)> &_input,
+    const std::function<void(const UpdateInfo &,
+        const EntityComponentManager &)> &_output,
+    const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+  {
+    ignerr << "Invalid world index [" << _worldIndex << "].\n";
+    return false;
+  }
+
+  return this->dataPtr->SetStepHooks(_input, _output, _worldIndex);
+}
+
+/////////////////////////////////////////////////
+bool Server::StepAll(const uint64_t _iterations)
+{
+  auto &runners = this->dataPtr->simRunners;
+  if (this->dataPtr->running)
+  {
+    ignwarn << "The server is already running.\n";
+    return false;
+  }
+
+  for (auto &runner : runners)
+  {
+    if (runner->Running())
+    {
+      ignwarn << "A world is already running.\n";
+      return false;
+    }
+    runner->SetPaused(false);
+  }
+
+  const uint64_t iterations = std::max<uint64_t>(1u, _iterations);
+  std::atomic<bool> result{true};
+  auto step = [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      if (!runners[i]->Run(iterations))
+        result = false;
+    }
+  };
+
+  // Loops started by the systems of each world run serially, since they
+  // are nested in this one
+  if (this->dataPtr->threadPool)
+    this->dataPtr->threadPool->ParallelFor(runners.size(), step, 1u);
+  else
+    step(0u, runners.size());
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::optional<uint64_t> Server::Checkpoint(const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+    return std::nullopt;
+  return this->dataPtr->simRunners[_worldIndex]->Checkpoint();
+}
+
+/////////////////////////////////////////////////
+bool Server::Restore(const uint64_t _id, const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+    return false;
+  return this->dataPtr->simRunners[_worldIndex]->Restore(_id);
+}
+
+/////////////////////////////////////////////////
+bool Server::RemoveCheckpoint(const uint64_t _id,
+    const unsigned int _worldIndex)
+{
+  if (_worldIndex >= this->dataPtr->simRunners.size())
+    return false;
+  return this->dataPtr->simRunners[_worldIndex]->RemoveCheckpoint(_id);
+}
+
+/////////////////////////////////////////////////
+std::size_t Server::WorldCount() const
+{
+  return this->dataPtr->simRunners.size();
+}
+
 /////////////////////////////////////////////////
 void Server::SetUpdatePeriod(
     const std::chrono::steady_clock::duration &_updatePeriod,
@@ -18,6 +18,9 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <array>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
@@ -280,6 +283,13 @@ class ignition::gazebo::ServerConfigPrivate
             networkRole(_cfg->networkRole),
             networkSecondaries(_cfg->networkSecondaries),
             seed(_cfg->seed),
+            barrierSpinCount(_cfg->barrierSpinCount),
+            threadAffinity(_cfg->threadAffinity),
+            throughputMode(_cfg->throughputMode),
+            throughputInterval(_cfg->throughputInterval),
+            worldInstances(_cfg->worldInstances),
+            worldCache(_cfg->worldCache),
+            startupTracePath(_cfg->startupTracePath),
             logRecordTopics(_cfg->logRecordTopics),
             isHeadlessRendering(_cfg->isHeadlessRendering) { }
 
@@ -337,6 +347,27 @@ class ignition::gazebo::ServerConfigPrivate
   /// \brief The given random seed.
   public: unsigned int seed = 0;
 
+  /// \brief Number of times barrier waiters poll before blocking.
+  public: unsigned int barrierSpinCount = 0;
+
+  /// \brief Cores of each thread group, indexed by ThreadGroup.
+  public: std::array<std::vector<unsigned int>, 4> threadAffinity;
+
+  /// \brief Whether to run in throughput mode.
+  public: bool throughputMode{false};
+
+  /// \brief Iterations between periodic work in throughput mode.
+  public: uint64_t throughputInterval{1000u};
+
+  /// \brief Number of instances of each world.
+  public: unsigned int worldInstances{1u};
+
+  /// \brief Path to the world cache file.
+  public: std::string worldCache = "";
+
+  /// \brief Path to the startup trace file.
+  public: std::string startupTracePath = "";
+
   /// \brief Timestamp that marks when this ServerConfig was created.
   public: std::chrono::time_point<std::chrono::system_clock> timestamp;
 
@@ -547,6 +578,92 @@ void ServerConfig::SetSeed(unsigned int _seed)
   ignition::math::Rand::Seed(_seed);
 }
 
+/////////////////////////////////////////////////
+unsigned int ServerConfig::BarrierSpinCount() const
+{
+  return this->dataPtr->barrierSpinCount;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetBarrierSpinCount(unsigned int _spinCount)
+{
+  this->dataPtr->barrierSpinCount = _spinCount;
+}
+
+/////////////////////////////////////////////////
+const std::vector<unsigned int> &ServerConfig::ThreadAffinity(
+    ThreadGroup _group) const
+{
+  return this->dataPtr->threadAffinity[static_cast<std::size_t>(_group)];
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetThreadAffinity(ThreadGroup _group,
+    const std::vector<unsigned int> &_cores)
+{
+  this->dataPtr->threadAffinity[static_cast<std::size_t>(_group)] = _cores;
+}
+
+/////////////////////////////////////////////////
+bool ServerConfig::ThroughputMode() const
+{
+  return this->dataPtr->throughputMode;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetThroughputMode(bool _throughput)
+{
+  this->dataPtr->throughputMode = _throughput;
+}
+
+/////////////////////////////////////////////////
+uint64_t ServerConfig::ThroughputInterval() const
+{
+  return this->dataPtr->throughputInterval;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetThroughputInterval(uint64_t _iterations)
+{
+  this->dataPtr->throughputInterval = std::max<uint64_t>(1u, _iterations);
+}
+
+/////////////////////////////////////////////////
+unsigned int ServerConfig::WorldInstances() const
+{
+  return this->dataPtr->worldInstances;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetWorldInstances(unsigned int _instances)
+{
+  this->dataPtr->worldInstances = std::max(1u, _instances);
+}
+
+/////////////////////////////////////////////////
+const std::string &ServerConfig::WorldCache() const
+{
+  return this->dataPtr->worldCache;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetWorldCache(const std::string &_path)
+{
+  this->dataPtr->worldCache = _path;
+}
+
+/////////////////////////////////////////////////
+const std::string &ServerConfig::StartupTracePath() const
+{
+  return this->dataPtr->startupTracePath;
+}
+
+/////////////////////////////////////////////////
+void ServerConfig::SetStartupTracePath(const std::string &_path)
+{
+  this->dataPtr->startupTracePath = _path;
+}
+
 /////////////////////////////////////////////////
 const std::string &ServerConfig::ResourceCache() const
 {
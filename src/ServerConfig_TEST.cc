@@ -271,3 +271,108 @@ TEST(ServerConfig, SdfRoot)
   EXPECT_TRUE(config.SdfString().empty());
   EXPECT_EQ(ServerConfig::SourceType::kSdfRoot, config.Source());
 }
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, BarrierSpinCount)
+{
+  ServerConfig config;
+  EXPECT_EQ(0u, config.BarrierSpinCount());
+
+  config.SetBarrierSpinCount(1000u);
+  EXPECT_EQ(1000u, config.BarrierSpinCount());
+
+  ServerConfig copy(config);
+  EXPECT_EQ(1000u, copy.BarrierSpinCount());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ThreadAffinity)
+{
+  using ThreadGroup = ServerConfig::ThreadGroup;
+
+  ServerConfig config;
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kSimulation).empty());
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kPostUpdate).empty());
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kWorkers).empty());
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kRendering).empty());
+
+  config.SetThreadAffinity(ThreadGroup::kSimulation, {0u});
+  config.SetThreadAffinity(ThreadGroup::kWorkers, {2u, 3u});
+  EXPECT_EQ(std::vector<unsigned int>{0u},
+      config.ThreadAffinity(ThreadGroup::kSimulation));
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kPostUpdate).empty());
+  EXPECT_EQ((std::vector<unsigned int>{2u, 3u}),
+      config.ThreadAffinity(ThreadGroup::kWorkers));
+
+  ServerConfig copy(config);
+  EXPECT_EQ((std::vector<unsigned int>{2u, 3u}),
+      copy.ThreadAffinity(ThreadGroup::kWorkers));
+
+  config.SetThreadAffinity(ThreadGroup::kWorkers, {});
+  EXPECT_TRUE(config.ThreadAffinity(ThreadGroup::kWorkers).empty());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, ThroughputMode)
+{
+  ServerConfig config;
+  EXPECT_FALSE(config.ThroughputMode());
+  EXPECT_EQ(1000u, config.ThroughputInterval());
+
+  config.SetThroughputMode(true);
+  config.SetThroughputInterval(50u);
+  EXPECT_TRUE(config.ThroughputMode());
+  EXPECT_EQ(50u, config.ThroughputInterval());
+
+  // The interval can't be zero
+  config.SetThroughputInterval(0u);
+  EXPECT_EQ(1u, config.ThroughputInterval());
+
+  ServerConfig copy(config);
+  EXPECT_TRUE(copy.ThroughputMode());
+  EXPECT_EQ(1u, copy.ThroughputInterval());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, WorldInstances)
+{
+  ServerConfig config;
+  EXPECT_EQ(1u, config.WorldInstances());
+
+  config.SetWorldInstances(4u);
+  EXPECT_EQ(4u, config.WorldInstances());
+
+  // There is always at least one instance
+  config.SetWorldInstances(0u);
+  EXPECT_EQ(1u, config.WorldInstances());
+
+  config.SetWorldInstances(3u);
+  ServerConfig copy(config);
+  EXPECT_EQ(3u, copy.WorldInstances());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, WorldCache)
+{
+  ServerConfig config;
+  EXPECT_TRUE(config.WorldCache().empty());
+
+  config.SetWorldCache("/tmp/world.cache");
+  EXPECT_EQ("/tmp/world.cache", config.WorldCache());
+
+  ServerConfig copy(config);
+  EXPECT_EQ("/tmp/world.cache", copy.WorldCache());
+}
+
+//////////////////////////////////////////////////
+TEST(ServerConfig, StartupTracePath)
+{
+  ServerConfig config;
+  EXPECT_TRUE(config.StartupTracePath().empty());
+
+  config.SetStartupTracePath("/tmp/startup.json");
+  EXPECT_EQ("/tmp/startup.json", config.StartupTracePath());
+
+  ServerConfig copy(config);
+  EXPECT_EQ("/tmp/startup.json", copy.StartupTracePath());
+}
@@ -18,20 +18,71 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <utility>
+
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Util.hh>
 
 #include <ignition/fuel_tools/Interface.hh>
+#include <ignition/msgs/Utility.hh>
 
+#include "ignition/gazebo/StartupTrace.hh"
+#include "ignition/gazebo/System.hh"
+#include "ignition/gazebo/Tracer.hh"
 #include "ignition/gazebo/Util.hh"
 #include "SimulationRunner.hh"
+#include "ThreadPool.hh"
+#include "WorldCache.hh"
 
 using namespace ignition;
 using namespace gazebo;
 
+/// \brief Maximum number of Fuel models downloaded at the same time by
+/// ServerPrivate::PrefetchFuelResources.
+static constexpr unsigned int kMaxParallelFuelFetches{8u};
+
+//////////////////////////////////////////////////
+/// \brief Find the remote URIs of an SDF element and its descendants.
+/// \param[in] _elem Element to search.
+/// \param[out] _uris URIs found.
+static void findRemoteUris(const tinyxml2::XMLElement *_elem,
+    std::vector<std::string> &_uris)
+{
+  for (auto *child = _elem->FirstChildElement(); nullptr != child;
+       child = child->NextSiblingElement())
+  {
+    if (std::string(child->Name()) == "uri" && nullptr != child->GetText())
+    {
+      std::string uri = common::trimmed(child->GetText());
+      if (uri.find("http://") == 0 || uri.find("https://") == 0)
+        _uris.push_back(uri);
+    }
+    findRemoteUris(child, _uris);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the remote URIs of an SDF string.
+/// \param[in] _sdf SDF string.
+/// \return URIs found, which may point to Fuel.
+static std::vector<std::string> findRemoteUris(const std::string &_sdf)
+{
+  std::vector<std::string> uris;
+  tinyxml2::XMLDocument doc;
+  if (doc.Parse(_sdf.c_str()) == tinyxml2::XML_SUCCESS)
+    findRemoteUris(doc.RootElement(), uris);
+  return uris;
+}
+
 /// \brief This struct provides access to the record plugin SDF string
 struct LoggingPlugin
 {
@@ -81,6 +132,53 @@ struct LoggingPlugin
   }
 };
 
+namespace ignition
+{
+namespace gazebo
+{
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+{
+/// \brief System which calls the functions set through
+/// Server::SetStepHooks.
+class StepHooksSystem :
+  public System,
+  public ISystemPreUpdate,
+  public ISystemPostUpdate
+{
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &_info,
+              EntityComponentManager &_ecm) override
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->input)
+      this->input(_info, _ecm);
+  }
+
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm) override
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->output)
+      this->output(_info, _ecm);
+  }
+
+  /// \brief Function called on PreUpdate.
+  public: std::function<void(const UpdateInfo &,
+              EntityComponentManager &)> input;
+
+  /// \brief Function called on PostUpdate.
+  public: std::function<void(const UpdateInfo &,
+              const EntityComponentManager &)> output;
+
+  /// \brief Protects the functions, which may be replaced while the world
+  /// is running.
+  public: std::mutex mutex;
+};
+}
+}
+}
+
 //////////////////////////////////////////////////
 ServerPrivate::ServerPrivate()
 : systemLoader(std::make_shared<SystemLoader>())
@@ -102,6 +200,98 @@ ServerPrivate::~ServerPrivate()
   {
     this->stopThread->join();
   }
+
+  {
+    std::lock_guard<std::mutex> lock(this->stepMutex);
+    this->stopStepThread = true;
+  }
+  this->stepCond.notify_all();
+  if (this->stepThread.joinable())
+  {
+    this->stepThread.join();
+  }
+
+  // Requests which never ran
+  for (StepRequest &request : this->stepRequests)
+  {
+    if (request.done)
+      request.done(false);
+  }
+}
+
+//////////////////////////////////////////////////
+bool ServerPrivate::StepWorld(const uint64_t _iterations,
+    const unsigned int _worldIndex)
+{
+  auto &runner = this->simRunners[_worldIndex];
+  if (this->running || runner->Running())
+  {
+    ignwarn << "World [" << _worldIndex << "] is already running.\n";
+    return false;
+  }
+
+  runner->SetPaused(false);
+  return runner->Run(std::max<uint64_t>(1u, _iterations));
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::QueueStep(StepRequest &&_request)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->stepMutex);
+    this->stepRequests.push_back(std::move(_request));
+    if (!this->stepThread.joinable())
+      this->stepThread = std::thread(&ServerPrivate::StepLoop, this);
+  }
+  this->stepCond.notify_one();
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::StepLoop()
+{
+  std::unique_lock<std::mutex> lock(this->stepMutex);
+  while (true)
+  {
+    this->stepCond.wait(lock, [this]
+        {
+          return this->stopStepThread || !this->stepRequests.empty();
+        });
+    if (this->stopStepThread)
+      return;
+
+    StepRequest request = std::move(this->stepRequests.front());
+    this->stepRequests.pop_front();
+
+    lock.unlock();
+    bool result = this->StepWorld(request.iterations, request.worldIndex);
+    if (request.done)
+      request.done(result);
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+bool ServerPrivate::SetStepHooks(
+    const std::function<void(const UpdateInfo &,
+        EntityComponentManager &)> &_input,
+    const std::function<void(const UpdateInfo &,
+        const EntityComponentManager &)> &_output,
+    const unsigned int _worldIndex)
+{
+  if (this->stepHooks.size() <= _worldIndex)
+    this->stepHooks.resize(_worldIndex + 1);
+
+  auto &hooks = this->stepHooks[_worldIndex];
+  if (!hooks)
+  {
+    hooks = std::make_shared<StepHooksSystem>();
+    this->simRunners[_worldIndex]->AddSystem(hooks);
+  }
+
+  std::lock_guard<std::mutex> lock(hooks->mutex);
+  hooks->input = _input;
+  hooks->output = _output;
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -273,20 +463,54 @@ void ServerPrivate::AddRecordPlugin(const ServerConfig &_config)
 //////////////////////////////////////////////////
 void ServerPrivate::CreateEntities()
 {
-  // Create a simulation runner for each world.
+  // Create a simulation runner for each instance of each world.
+  const unsigned int instances = this->config.WorldInstances();
   for (uint64_t worldIndex = 0; worldIndex <
        this->sdfRoot.WorldCount(); ++worldIndex)
   {
-    auto world = this->sdfRoot.WorldByIndex(worldIndex);
+    for (unsigned int instance = 0; instance < instances; ++instance)
+    {
+      const sdf::World *world = this->sdfRoot.WorldByIndex(worldIndex);
+      if (instance > 0u)
+      {
+        auto copy = std::make_unique<sdf::World>(*world);
+        copy->SetName(world->Name() + "_" + std::to_string(instance));
+        world = copy.get();
+        this->worldInstances.push_back(std::move(copy));
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(this->worldsMutex);
+        this->worldNames.push_back(world->Name());
+      }
+      StartupTrace::Scope scope("world", world->Name());
+      auto runner = std::make_unique<SimulationRunner>(
+          world, this->systemLoader, this->config);
+      runner->SetFuelUriMap(this->fuelUriMap);
+      this->simRunners.push_back(std::move(runner));
+    }
+  }
 
+  // Worlds step independently, so a single set of workers is enough for all
+  // of them. A loop started while another world holds the pool runs
+  // serially instead of waiting.
+  if (this->simRunners.size() > 1u)
+  {
+    const auto &workerCores =
+        this->config.ThreadAffinity(ServerConfig::ThreadGroup::kWorkers);
+    if (workerCores.empty())
+    {
+      this->threadPool = std::make_shared<ThreadPool>();
+    }
+    else
     {
-      std::lock_guard<std::mutex> lock(this->worldsMutex);
-      this->worldNames.push_back(world->Name());
+      this->threadPool = std::make_shared<ThreadPool>(
+          static_cast<unsigned int>(workerCores.size()) + 1u);
+      if (!this->threadPool->SetAffinity(workerCores))
+        ignwarn << "Failed to set the affinity of worker threads." << std::endl;
     }
-    auto runner = std::make_unique<SimulationRunner>(
-        world, this->systemLoader, this->config);
-    runner->SetFuelUriMap(this->fuelUriMap);
-    this->simRunners.push_back(std::move(runner));
+    for (auto &runner : this->simRunners)
+      runner->SetThreadPool(this->threadPool);
   }
 }
 
@@ -373,6 +597,17 @@ void ServerPrivate::SetupTransport()
     ignerr << "Something went wrong, failed to advertise ["
            << serverControlService << "]" << std::endl;
   }
+
+  std::string traceService{"/gazebo/trace"};
+  if (this->node.Advertise(traceService, &ServerPrivate::TraceService, this))
+  {
+    ignmsg << "Trace service on [" << traceService << "]." << std::endl;
+  }
+  else
+  {
+    ignerr << "Something went wrong, failed to advertise ["
+           << traceService << "]" << std::endl;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -433,6 +668,48 @@ bool ServerPrivate::ServerControlService(
   return true;
 }
 
+//////////////////////////////////////////////////
+bool ServerPrivate::TraceService(const ignition::msgs::Param &_req,
+    ignition::msgs::StringMsg &_res)
+{
+  _res.Clear();
+
+  auto param = [](const msgs::Param &_msg, const std::string &_key)
+      -> const msgs::Any *
+  {
+    auto it = _msg.params().find(_key);
+    return it == _msg.params().end() ? nullptr : &it->second;
+  };
+
+  auto &tracer = Tracer::Instance();
+  auto enableParam = param(_req, "enable");
+  if (nullptr == enableParam)
+  {
+    ignerr << "Trace request is missing the [enable] parameter" << std::endl;
+    return false;
+  }
+
+  if (!enableParam->bool_value())
+    return tracer.Stop();
+
+  std::string path;
+  auto pathParam = param(_req, "path");
+  if (nullptr != pathParam)
+    path = pathParam->string_value();
+
+  std::chrono::steady_clock::duration duration{0};
+  auto durationParam = param(_req, "duration");
+  if (nullptr != durationParam)
+  {
+    duration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(durationParam->double_value()));
+  }
+
+  path = tracer.Start(path, duration);
+  _res.set_data(path);
+  return !path.empty();
+}
+
 //////////////////////////////////////////////////
 void ServerPrivate::AddResourcePathsService(
     const ignition::msgs::StringMsg_V &_req)
@@ -534,9 +811,161 @@ bool ServerPrivate::ResourcePathsResolveService(
   return false;
 }
 
+//////////////////////////////////////////////////
+bool ServerPrivate::LoadWorldCache(const std::string &_source)
+{
+  if (this->config.WorldCache().empty())
+    return false;
+
+  StartupTrace::Scope scope("world_cache_load", this->config.WorldCache());
+  this->worldSourceHash = worldCacheHash(_source);
+  auto cache = loadWorldCache(this->config.WorldCache(),
+      *this->worldSourceHash);
+  if (!cache)
+    return false;
+
+  auto errors = this->sdfRoot.LoadSdfString(cache->sdf);
+  if (!errors.empty())
+  {
+    ignwarn << "Failed to load the world from cache ["
+            << this->config.WorldCache() << "], loading it from SDF instead."
+            << std::endl;
+    this->sdfRoot = sdf::Root();
+    return false;
+  }
+
+  ignmsg << "Loading world from cache [" << this->config.WorldCache()
+         << "].\n";
+  this->fuelUriMap = cache->fuelUriMap;
+  this->loadedFromWorldCache = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::SaveWorldCache()
+{
+  if (!this->worldSourceHash || this->loadedFromWorldCache ||
+      this->simRunners.empty())
+  {
+    return;
+  }
+
+  // The record plugin is added to the world SDF, and would be cached with it
+  if (this->config.UseLogRecord())
+  {
+    ignwarn << "Not writing world cache [" << this->config.WorldCache()
+            << "] while recording." << std::endl;
+    return;
+  }
+
+  if (this->sdfRoot.WorldCount() != 1u)
+  {
+    ignwarn << "Only single-world SDFs are cached, not writing world cache ["
+            << this->config.WorldCache() << "]." << std::endl;
+    return;
+  }
+
+  StartupTrace::Scope scope("world_cache_save", this->config.WorldCache());
+
+  // The cached world doesn't need any includes or Fuel lookups
+  msgs::SdfGeneratorConfig req;
+  msgs::Set(req.mutable_global_entity_gen_config()->
+      mutable_expand_include_tags(), true);
+  msgs::StringMsg res;
+  if (!this->simRunners.front()->GenerateWorldSdf(req, res))
+  {
+    ignwarn << "Failed to generate the world, not writing world cache ["
+            << this->config.WorldCache() << "]." << std::endl;
+    return;
+  }
+
+  WorldCache cache;
+  cache.sourceHash = *this->worldSourceHash;
+  cache.sdf = res.data();
+  cache.fuelUriMap = this->fuelUriMap;
+  if (saveWorldCache(this->config.WorldCache(), cache))
+    ignmsg << "Wrote world cache [" << this->config.WorldCache() << "].\n";
+}
+
+//////////////////////////////////////////////////
+void ServerPrivate::PrefetchFuelResources(const std::string &_sdf)
+{
+  StartupTrace::Scope scope("fuel_prefetch");
+
+  std::set<std::string> seen;
+  std::vector<std::string> pending = findRemoteUris(_sdf);
+  if (pending.empty())
+    return;
+
+  ThreadPool pool(kMaxParallelFuelFetches);
+  while (!pending.empty())
+  {
+    // URIs of the same model are fetched by the same thread, so that
+    // downloads don't race to write the model into the cache
+    std::map<std::string, std::vector<std::string>> modelUris;
+    for (const auto &uri : pending)
+    {
+      if (!seen.insert(uri).second)
+        continue;
+
+      fuel_tools::ModelIdentifier id;
+      std::string filePath;
+      if (this->fuelClient->ParseModelUrl(common::URI(uri), id) ||
+          this->fuelClient->ParseModelFileUrl(common::URI(uri), id,
+              filePath))
+      {
+        modelUris[id.UniqueName()].push_back(uri);
+      }
+    }
+
+    std::vector<std::vector<std::string>> groups;
+    for (auto &model : modelUris)
+      groups.push_back(std::move(model.second));
+
+    // Models may include other Fuel models, which are fetched in the next
+    // round
+    std::vector<std::vector<std::string>> included(groups.size());
+    pool.ParallelFor(groups.size(), [&](std::size_t _begin, std::size_t _end)
+    {
+      // The client isn't meant to be shared by threads
+      fuel_tools::FuelClient client(this->fuelClient->Config());
+      for (std::size_t i = _begin; i < _end; ++i)
+      {
+        for (const auto &uri : groups[i])
+        {
+          StartupTrace::Scope fetchScope("fuel_fetch", uri);
+          const auto path = fuel_tools::fetchResourceWithClient(uri, client);
+          if (path.empty() || !common::isDirectory(path))
+            continue;
+
+          for (common::DirIter file(path); file != common::DirIter(); ++file)
+          {
+            const std::string filePath = *file;
+            if (filePath.size() < 4u ||
+                filePath.compare(filePath.size() - 4u, 4u, ".sdf") != 0)
+            {
+              continue;
+            }
+            std::ifstream in(filePath);
+            std::stringstream sdf;
+            sdf << in.rdbuf();
+            auto uris = findRemoteUris(sdf.str());
+            included[i].insert(included[i].end(), uris.begin(), uris.end());
+          }
+        }
+      }
+    });
+
+    pending.clear();
+    for (const auto &uris : included)
+      pending.insert(pending.end(), uris.begin(), uris.end());
+  }
+}
+
 //////////////////////////////////////////////////
 std::string ServerPrivate::FetchResource(const std::string &_uri)
 {
+  StartupTrace::Scope scope("fuel_fetch", _uri);
   auto path =
       fuel_tools::fetchResourceWithClient(_uri, *this->fuelClient.get());
 
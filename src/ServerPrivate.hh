@@ -17,10 +17,14 @@
 #ifndef IGNITION_GAZEBO_SERVERPRIVATE_HH_
 #define IGNITION_GAZEBO_SERVERPRIVATE_HH_
 
+#include <ignition/msgs/param.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
 #include <ignition/msgs/stringmsg_v.pb.h>
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -31,6 +35,7 @@
 #include <vector>
 
 #include <sdf/Root.hh>
+#include <sdf/World.hh>
 
 #include <ignition/common/SignalHandler.hh>
 #include <ignition/common/URI.hh>
@@ -43,9 +48,11 @@
 #include <ignition/msgs/server_control.pb.h>
 
 #include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Export.hh"
 #include "ignition/gazebo/ServerConfig.hh"
 #include "ignition/gazebo/SystemLoader.hh"
+#include "ignition/gazebo/Types.hh"
 
 using namespace std::chrono_literals;
 
@@ -56,6 +63,8 @@ namespace ignition
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     class SimulationRunner;
+    class StepHooksSystem;
+    class ThreadPool;
 
     // Private data for Server
     class IGNITION_GAZEBO_HIDDEN ServerPrivate
@@ -80,6 +89,24 @@ namespace ignition
       /// \brief Create all entities that exist in the sdf::Root object.
       public: void CreateEntities();
 
+      /// \brief Load the world from the cache file set in the configuration,
+      /// if the cache was written for the given source.
+      /// \param[in] _source SDF string, or path and contents of the SDF
+      /// file, that the world would otherwise be loaded from.
+      /// \return True if the world was loaded from the cache.
+      public: bool LoadWorldCache(const std::string &_source);
+
+      /// \brief Download the Fuel resources referenced by an SDF, and by the
+      /// Fuel models it includes, so that they're already cached when the
+      /// SDF is loaded. Models are downloaded in parallel, while the SDF
+      /// loader would download them one at a time.
+      /// \param[in] _sdf SDF string.
+      public: void PrefetchFuelResources(const std::string &_sdf);
+
+      /// \brief Write the cache file set in the configuration, if the world
+      /// wasn't loaded from it. Must be called once entities are created.
+      public: void SaveWorldCache();
+
       /// \brief Stop server.
       public: void Stop();
 
@@ -146,9 +173,29 @@ namespace ignition
       private: bool ServerControlService(
         const ignition::msgs::ServerControl &_req, msgs::Boolean &_res);
 
+      /// \brief Callback for the trace service, which starts and stops the
+      /// built-in tracer.
+      /// \param[in] _req Request with an `enable` boolean, and optionally a
+      /// `path` string and a `duration` double in seconds, used when
+      /// starting.
+      /// \param[out] _res Path of the trace file, empty if the request
+      /// failed.
+      /// \return True if successful.
+      private: bool TraceService(const ignition::msgs::Param &_req,
+          ignition::msgs::StringMsg &_res);
+
       /// \brief A pool of worker threads.
       public: common::WorkerPool workerPool{2};
 
+      /// \brief Extra instances of the SDF worlds, created when
+      /// ServerConfig::WorldInstances is greater than one. Runners keep a
+      /// pointer to their world, so these must outlive simRunners.
+      public: std::vector<std::unique_ptr<sdf::World>> worldInstances;
+
+      /// \brief Thread pool shared by all the simulation runners, only set
+      /// when there is more than one runner.
+      public: std::shared_ptr<ThreadPool> threadPool;
+
       /// \brief All the simulation runners.
       public: std::vector<std::unique_ptr<SimulationRunner>> simRunners;
 
@@ -165,6 +212,68 @@ namespace ignition
       /// \brief Thread that shuts down the system.
       public: std::shared_ptr<std::thread> stopThread;
 
+      /// \brief Steps requested through Server::StepAsync.
+      public: struct StepRequest
+      {
+        /// \brief Number of iterations.
+        uint64_t iterations{1u};
+
+        /// \brief Index of the world to step.
+        unsigned int worldIndex{0u};
+
+        /// \brief Function called with the result of the step.
+        std::function<void(bool)> done;
+      };
+
+      /// \brief Queue a step to be run by stepThread, starting the thread
+      /// if needed.
+      /// \param[in] _request The step.
+      public: void QueueStep(StepRequest &&_request);
+
+      /// \brief Run the queued steps in order until stopped. Runs on
+      /// stepThread.
+      private: void StepLoop();
+
+      /// \brief Step a single world. See Server::Step.
+      /// \param[in] _iterations Number of iterations.
+      /// \param[in] _worldIndex Index of the world, assumed to be valid.
+      /// \return True if the world completed the steps.
+      public: bool StepWorld(const uint64_t _iterations,
+                  const unsigned int _worldIndex);
+
+      /// \brief Set the hooks called on every step of a world, adding the
+      /// system which calls them the first time.
+      /// \param[in] _input Hook called on PreUpdate.
+      /// \param[in] _output Hook called on PostUpdate.
+      /// \param[in] _worldIndex Index of the world, assumed to be valid.
+      /// \return False if the system couldn't be added.
+      public: bool SetStepHooks(
+          const std::function<void(const UpdateInfo &,
+              EntityComponentManager &)> &_input,
+          const std::function<void(const UpdateInfo &,
+              const EntityComponentManager &)> &_output,
+          const unsigned int _worldIndex);
+
+      /// \brief Thread which runs the steps requested through
+      /// Server::StepAsync, so that one thread serves all requests.
+      public: std::thread stepThread;
+
+      /// \brief Steps waiting to be run by stepThread.
+      public: std::deque<StepRequest> stepRequests;
+
+      /// \brief Protects stepRequests and stopStepThread.
+      public: std::mutex stepMutex;
+
+      /// \brief Notifies stepThread of new requests.
+      public: std::condition_variable stepCond;
+
+      /// \brief Whether stepThread should stop.
+      public: bool stopStepThread{false};
+
+      /// \brief System calling the step hooks of each world, null until
+      /// hooks are set for that world.
+      public: std::vector<std::shared_ptr<StepHooksSystem>> stepHooks;
+
       /// \brief Our signal handler.
       public: ignition::common::SignalHandler sigHandler;
 
@@ -186,6 +295,13 @@ namespace ignition
       /// Server. It is used in the SDFormat world generator when saving worlds
       public: std::unordered_map<std::string, std::string> fuelUriMap;
 
+      /// \brief Hash of the source the world was loaded from, set if a world
+      /// cache is used.
+      public: std::optional<uint64_t> worldSourceHash;
+
+      /// \brief True if the world was loaded from the world cache.
+      public: bool loadedFromWorldCache{false};
+
       /// \brief List of names for all worlds loaded in this server.
       private: std::vector<std::string> worldNames;
 
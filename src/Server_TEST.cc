@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 #include <csignal>
+#include <fstream>
+#include <future>
+#include <sstream>
 #include <vector>
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/StringUtils.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/math/Rand.hh>
@@ -33,6 +37,7 @@
 #include "ignition/gazebo/System.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 #include "ignition/gazebo/Types.hh"
 #include "ignition/gazebo/Util.hh"
 #include "ignition/gazebo/test_config.hh"
@@ -710,6 +715,206 @@ TEST_P(ServerFixture, RunNonBlockingMultiple)
   EXPECT_FALSE(*server.Running(0));
 }
 
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, StepWorldInstances)
+{
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(TestWorldSansPhysics::World());
+  serverConfig.SetWorldInstances(3u);
+  gazebo::Server server(serverConfig);
+
+  ASSERT_EQ(3u, server.WorldCount());
+  EXPECT_EQ(3u, *server.EntityCount(2));
+  EXPECT_FALSE(server.Step(1, 3u).has_value());
+
+  for (unsigned int i = 0; i < 3u; ++i)
+    server.SetUpdatePeriod(1ns, i);
+
+  // Instances step independently
+  EXPECT_TRUE(*server.Step(5, 1u));
+  EXPECT_EQ(0u, *server.IterationCount(0));
+  EXPECT_EQ(5u, *server.IterationCount(1));
+  EXPECT_EQ(0u, *server.IterationCount(2));
+
+  EXPECT_TRUE(server.StepAll(10));
+  EXPECT_EQ(10u, *server.IterationCount(0));
+  EXPECT_EQ(15u, *server.IterationCount(1));
+  EXPECT_EQ(10u, *server.IterationCount(2));
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(1));
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, StepAsync)
+{
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(TestWorldSansPhysics::World());
+  serverConfig.SetWorldInstances(2u);
+  gazebo::Server server(serverConfig);
+  for (unsigned int i = 0; i < 2u; ++i)
+    server.SetUpdatePeriod(1ns, i);
+
+  EXPECT_FALSE(server.StepAsync(1, 2u).get());
+  EXPECT_FALSE(server.StepAsync(1, [](bool) {}, 2u));
+  EXPECT_FALSE(server.SetStepHooks(nullptr, nullptr, 2u));
+
+  // Inputs are applied before the systems update, outputs read after
+  std::vector<uint64_t> inputs;
+  std::vector<uint64_t> outputs;
+  EXPECT_TRUE(server.SetStepHooks(
+      [&](const UpdateInfo &_info, EntityComponentManager &)
+      {
+        inputs.push_back(_info.iterations);
+      },
+      [&](const UpdateInfo &_info, const EntityComponentManager &)
+      {
+        outputs.push_back(_info.iterations);
+      }, 1u));
+
+  // Requests run in order, so the second one waits for the first
+  auto first = server.StepAsync(5, 1u);
+  auto second = server.StepAsync(3, 1u);
+  EXPECT_TRUE(first.get());
+  EXPECT_TRUE(second.get());
+  EXPECT_EQ(8u, *server.IterationCount(1));
+  EXPECT_EQ(0u, *server.IterationCount(0));
+  EXPECT_EQ(8u, inputs.size());
+  EXPECT_EQ(inputs, outputs);
+
+  std::promise<bool> done;
+  EXPECT_TRUE(server.StepAsync(2,
+      [&](bool _result) {done.set_value(_result);}, 0u));
+  EXPECT_TRUE(done.get_future().get());
+  EXPECT_EQ(2u, *server.IterationCount(0));
+  EXPECT_EQ(8u, outputs.size());
+
+  // Removing the hooks
+  EXPECT_TRUE(server.SetStepHooks(nullptr, nullptr, 1u));
+  EXPECT_TRUE(*server.Step(1, 1u));
+  EXPECT_EQ(8u, inputs.size());
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, CheckpointRestore)
+{
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(TestWorldSansPhysics::World());
+  gazebo::Server server(serverConfig);
+  server.SetUpdatePeriod(1ns);
+
+  EXPECT_FALSE(server.Checkpoint(1u).has_value());
+  EXPECT_FALSE(server.Restore(1u, 1u));
+
+  EXPECT_TRUE(*server.Step(10));
+  auto id = server.Checkpoint();
+  ASSERT_TRUE(id.has_value());
+  const auto entityCount = *server.EntityCount();
+
+  EXPECT_TRUE(*server.Step(5));
+  EXPECT_EQ(15u, *server.IterationCount());
+
+  // Time goes back to the checkpoint, and stepping resumes from there
+  EXPECT_TRUE(server.Restore(*id));
+  EXPECT_EQ(10u, *server.IterationCount());
+  EXPECT_EQ(entityCount, *server.EntityCount());
+  EXPECT_TRUE(*server.Step(3));
+  EXPECT_EQ(13u, *server.IterationCount());
+
+  EXPECT_TRUE(server.Restore(*id));
+  EXPECT_EQ(10u, *server.IterationCount());
+
+  EXPECT_FALSE(server.Restore(*id + 1));
+  EXPECT_TRUE(server.RemoveCheckpoint(*id));
+  EXPECT_FALSE(server.Restore(*id));
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, WorldCache)
+{
+  const std::string cachePath = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_server_world_cache.bin");
+  common::removeFile(cachePath);
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "shapes.sdf"));
+  serverConfig.SetWorldCache(cachePath);
+
+  // The cache is written on the first load
+  std::optional<std::size_t> entityCount;
+  {
+    gazebo::Server server(serverConfig);
+    entityCount = server.EntityCount();
+    ASSERT_TRUE(entityCount.has_value());
+  }
+  ASSERT_TRUE(common::exists(cachePath));
+
+  // And used on the next one
+  {
+    gazebo::Server server(serverConfig);
+    EXPECT_EQ(entityCount, server.EntityCount());
+    EXPECT_TRUE(server.HasEntity("box"));
+    EXPECT_TRUE(server.HasEntity("sphere"));
+    EXPECT_TRUE(*server.Step(10));
+  }
+
+  // A different world doesn't use the cache, and replaces it
+  serverConfig.SetSdfFile("");
+  serverConfig.SetSdfString(TestWorldSansPhysics::World());
+  {
+    gazebo::Server server(serverConfig);
+    EXPECT_FALSE(server.HasEntity("box"));
+  }
+  {
+    gazebo::Server server(serverConfig);
+    EXPECT_FALSE(server.HasEntity("box"));
+  }
+
+  common::removeFile(cachePath);
+}
+
+/////////////////////////////////////////////////
+TEST_P(ServerFixture, StartupTrace)
+{
+  const std::string tracePath = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_server_startup_trace.json");
+  common::removeFile(tracePath);
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "shapes.sdf"));
+  serverConfig.SetStartupTracePath(tracePath);
+
+  gazebo::Server server(serverConfig);
+  EXPECT_TRUE(StartupTrace::Instance().Active());
+  EXPECT_FALSE(common::exists(tracePath));
+
+  // The trace is written once the first iteration is done
+  EXPECT_TRUE(*server.Step(1, true, false));
+  EXPECT_FALSE(StartupTrace::Instance().Active());
+  ASSERT_TRUE(common::exists(tracePath));
+
+  std::ifstream file(tracePath);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const auto json = contents.str();
+  EXPECT_NE(std::string::npos, json.find("\"phase\": \"sdf_load\""));
+  EXPECT_NE(std::string::npos, json.find("\"phase\": \"entity_creation\""));
+  EXPECT_NE(std::string::npos, json.find("\"phase\": \"system_load\""));
+  EXPECT_NE(std::string::npos, json.find("\"phase\": \"physics_update\""));
+  EXPECT_NE(std::string::npos,
+      json.find("\"phase\": \"model\", \"name\": \"box\""));
+
+  // Later iterations don't change it
+  EXPECT_TRUE(*server.Step(1, true, false));
+  std::ifstream again(tracePath);
+  std::stringstream againContents;
+  againContents << again.rdbuf();
+  EXPECT_EQ(json, againContents.str());
+
+  common::removeFile(tracePath);
+}
+
 /////////////////////////////////////////////////
 TEST_P(ServerFixture, SigInt)
 {
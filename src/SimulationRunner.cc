@@ -18,10 +18,19 @@
 #include "SimulationRunner.hh"
 
 #include <algorithm>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <sstream>
 
+#include <sdf/Link.hh>
+#include <sdf/Model.hh>
 #include <sdf/Root.hh>
+#include <sdf/Sensor.hh>
+#include <sdf/Visual.hh>
 
-#include "ignition/common/Profiler.hh"
+#include "ignition/gazebo/Profiler.hh"
+#include "ignition/gazebo/components/Dormant.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/Sensor.hh"
@@ -31,8 +40,10 @@
 #include "ignition/gazebo/components/Physics.hh"
 #include "ignition/gazebo/components/PhysicsCmd.hh"
 #include "ignition/gazebo/components/Recreate.hh"
+#include "ignition/gazebo/EntityComponentSnapshot.hh"
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 #include "ignition/gazebo/Util.hh"
 
 #include "network/NetworkManagerPrimary.hh"
@@ -43,6 +54,44 @@ using namespace gazebo;
 
 using StringSet = std::unordered_set<std::string>;
 
+//////////////////////////////////////////////////
+/// \brief Append the filenames of plugins not seen yet.
+/// \param[in] _plugins Plugins to add.
+/// \param[in, out] _seen Filenames already added.
+/// \param[in, out] _filenames Filenames, in the order they were found.
+static void addPluginFilenames(const sdf::Plugins &_plugins, StringSet &_seen,
+    std::vector<std::string> &_filenames)
+{
+  for (const auto &plugin : _plugins)
+  {
+    if (_seen.insert(plugin.Filename()).second)
+      _filenames.push_back(plugin.Filename());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Append the filenames of all plugins of a model and its children.
+/// \param[in] _model Model to visit.
+/// \param[in, out] _seen Filenames already added.
+/// \param[in, out] _filenames Filenames, in the order they were found.
+static void addModelPluginFilenames(const sdf::Model *_model,
+    StringSet &_seen, std::vector<std::string> &_filenames)
+{
+  addPluginFilenames(_model->Plugins(), _seen, _filenames);
+
+  for (uint64_t i = 0; i < _model->LinkCount(); ++i)
+  {
+    auto link = _model->LinkByIndex(i);
+    for (uint64_t j = 0; j < link->SensorCount(); ++j)
+      addPluginFilenames(link->SensorByIndex(j)->Plugins(), _seen, _filenames);
+    for (uint64_t j = 0; j < link->VisualCount(); ++j)
+      addPluginFilenames(link->VisualByIndex(j)->Plugins(), _seen, _filenames);
+  }
+
+  for (uint64_t i = 0; i < _model->ModelCount(); ++i)
+    addModelPluginFilenames(_model->ModelByIndex(i), _seen, _filenames);
+}
+
 
 //////////////////////////////////////////////////
 SimulationRunner::SimulationRunner(const sdf::World *_world,
@@ -131,10 +180,56 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   this->node = std::make_unique<transport::Node>(opts);
 
+  // The publishers are created when the runner starts running, before the
+  // first stats are pushed
+  this->statsPublisher = std::make_unique<StatsPublisher>(
+      [this](const msgs::WorldStatistics &_stats, const msgs::Clock &_clock)
+  {
+    // The stats message is throttled
+    this->statsPub.Publish(_stats);
+    if (this->rootStatsPub.Valid())
+      this->rootStatsPub.Publish(_stats);
+
+    // The clock message is not throttled. Only publish to the root topic if
+    // no others are.
+    this->clockPub.Publish(_clock);
+    if (this->rootClockPub.Valid())
+      this->rootClockPub.Publish(_clock);
+  });
+
   // Create the system manager
   this->systemMgr = std::make_unique<SystemManager>(_systemLoader,
       &this->entityCompMgr, &this->eventMgr, validNs);
 
+  // Find and load the plugin libraries on another thread while entities are
+  // being created, so that loading the plugins themselves is quick
+  std::future<void> preloadFuture;
+  if (_systemLoader)
+  {
+    StringSet seen;
+    std::vector<std::string> filenames;
+    addPluginFilenames(_world->Plugins(), seen, filenames);
+    for (uint64_t i = 0; i < _world->ModelCount(); ++i)
+      addModelPluginFilenames(_world->ModelByIndex(i), seen, filenames);
+    for (const auto &plugin : this->serverConfig.Plugins())
+    {
+      if (seen.insert(plugin.Plugin().Filename()).second)
+        filenames.push_back(plugin.Plugin().Filename());
+    }
+
+    if (!filenames.empty())
+    {
+      preloadFuture = std::async(std::launch::async,
+          [_systemLoader, filenames]
+          {
+            GZ_TRACE_THREAD_NAME("PluginPreload");
+            StartupTrace::Scope scope("plugin_preload");
+            for (const auto &filename : filenames)
+              _systemLoader->PreloadLibrary(filename);
+          });
+    }
+  }
+
   this->pauseConn = this->eventMgr.Connect<events::Pause>(
       std::bind(&SimulationRunner::SetPaused, this, std::placeholders::_1));
 
@@ -145,6 +240,28 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
       std::bind(&SimulationRunner::LoadPlugins, this, std::placeholders::_1,
       std::placeholders::_2));
 
+  // Workers restricted to a set of cores get one thread per core, shared by
+  // systems and the ECM. The pool is also created up front when the
+  // simulation thread is restricted, so its workers don't inherit the
+  // simulation cores.
+  this->unrestrictedCores = threadAffinity();
+  const auto &simCores =
+      _config.ThreadAffinity(ServerConfig::ThreadGroup::kSimulation);
+  const auto &workerCores =
+      _config.ThreadAffinity(ServerConfig::ThreadGroup::kWorkers);
+  if (!workerCores.empty())
+  {
+    auto pool = std::make_shared<ThreadPool>(
+        static_cast<unsigned int>(workerCores.size()) + 1u);
+    if (!pool->SetAffinity(workerCores))
+      ignwarn << "Failed to set the affinity of worker threads." << std::endl;
+    this->SetThreadPool(pool);
+  }
+  else if (!simCores.empty())
+  {
+    this->SetThreadPool(std::make_shared<ThreadPool>());
+  }
+
   // Create the level manager
   this->levelMgr = std::make_unique<LevelManager>(this, _config.UseLevels());
 
@@ -185,8 +302,15 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
     }
   }
 
-  // Load the active levels
-  this->levelMgr->UpdateLevelsState();
+  // Load the active levels. Entities are created on the simulation cores,
+  // so that their memory is allocated on the simulation thread's NUMA node.
+  {
+    StartupTrace::Scope scope("entity_creation", this->worldName);
+    const bool pinned = !simCores.empty() && setThreadAffinity(simCores);
+    this->levelMgr->UpdateLevelsState();
+    if (pinned)
+      setThreadAffinity(this->unrestrictedCores);
+  }
 
   // Load any additional plugins from the Server Configuration
   this->LoadServerPlugins(this->serverConfig.Plugins());
@@ -204,6 +328,9 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   this->LoadLoggingPlugins(this->serverConfig);
 
+  if (preloadFuture.valid())
+    preloadFuture.wait();
+
   // TODO(louise) Combine both messages into one.
   this->node->Advertise("control", &SimulationRunner::OnWorldControl, this);
   this->node->Advertise("control/state", &SimulationRunner::OnWorldControlState,
@@ -237,26 +364,44 @@ SimulationRunner::SimulationRunner(const sdf::World *_world,
 
   ignmsg << "Serving world SDF generation service on [" << opts.NameSpace()
          << "/" << genWorldSdfService << "]" << std::endl;
+
+  std::string saveWorldSdfService{"save_world_sdf"};
+  this->node->Advertise(
+      saveWorldSdfService, &SimulationRunner::SaveWorldSdf, this);
+
+  ignmsg << "Serving world SDF saving service on [" << opts.NameSpace()
+         << "/" << saveWorldSdfService << "]" << std::endl;
+
+  // Dump it with:
+  // ign service -s /world/<name>/memory_stats --reqtype ignition.msgs.Empty
+  //   --reptype ignition.msgs.StringMsg --timeout 5000 --req ''
+  std::string memoryStatsService{"memory_stats"};
+  this->node->Advertise(
+      memoryStatsService, &SimulationRunner::MemoryStatsService, this);
+
+  ignmsg << "Serving memory statistics on [" << opts.NameSpace() << "/"
+         << memoryStatsService << "]" << std::endl;
 }
 
 //////////////////////////////////////////////////
 SimulationRunner::~SimulationRunner()
 {
   this->StopWorkerThreads();
+
+  // Stop publishing before the publishers go away
+  this->statsPublisher.reset();
 }
 
 /////////////////////////////////////////////////
 void SimulationRunner::UpdateCurrentInfo()
 {
-  IGN_PROFILE("SimulationRunner::UpdateCurrentInfo");
+  GZ_TRACE("SimulationRunner::UpdateCurrentInfo");
 
   // Rewind
   if (this->requestedRewind)
   {
     igndbg << "Rewinding simulation back to time zero." << std::endl;
-    this->realTimes.clear();
-    this->simTimes.clear();
-    this->realTimeFactor = 0;
+    this->rtfResetPending = true;
 
     this->currentInfo.dt = -this->currentInfo.simTime;
     this->currentInfo.simTime = std::chrono::steady_clock::duration::zero();
@@ -277,9 +422,7 @@ void SimulationRunner::UpdateCurrentInfo()
     igndbg << "Seeking to " << std::chrono::duration_cast<std::chrono::seconds>(
         this->requestedSeek).count() << "s." << std::endl;
 
-    this->realTimes.clear();
-    this->simTimes.clear();
-    this->realTimeFactor = 0;
+    this->rtfResetPending = true;
 
     this->currentInfo.dt = this->requestedSeek - this->currentInfo.simTime;
     this->currentInfo.simTime = this->requestedSeek;
@@ -293,44 +436,6 @@ void SimulationRunner::UpdateCurrentInfo()
   }
 
   // Regular time flow
-
-  // Store the real time and sim time only if not paused.
-  if (this->realTimeWatch.Running())
-  {
-    this->realTimes.push_back(this->realTimeWatch.ElapsedRunTime());
-    this->simTimes.push_back(this->currentInfo.simTime);
-  }
-
-  // Maintain a window size of 20 for realtime and simtime.
-  if (this->realTimes.size() > 20)
-    this->realTimes.pop_front();
-  if (this->simTimes.size() > 20)
-    this->simTimes.pop_front();
-
-  // Compute the average sim and real times.
-  std::chrono::steady_clock::duration simAvg{0}, realAvg{0};
-  std::list<std::chrono::steady_clock::duration>::iterator simIter,
-    realIter;
-
-  simIter = ++(this->simTimes.begin());
-  realIter = ++(this->realTimes.begin());
-  while (simIter != this->simTimes.end() && realIter != this->realTimes.end())
-  {
-    simAvg += ((*simIter) - this->simTimes.front());
-    realAvg += ((*realIter) - this->realTimes.front());
-    ++simIter;
-    ++realIter;
-  }
-
-  // RTF, only compute this if the realTime count is greater than zero. The
-  // realtTime count could be zero if simulation was started paused.
-  if (realAvg.count() > 0)
-  {
-    this->realTimeFactor = math::precision(
-          static_cast<double>(simAvg.count()) / realAvg.count(), 4);
-  }
-
-  // Fill the current update info
   this->currentInfo.realTime = this->realTimeWatch.ElapsedRunTime();
   this->currentInfo.dt = std::chrono::steady_clock::duration::zero();
 
@@ -388,8 +493,7 @@ void SimulationRunner::UpdatePhysicsParams()
     }
     if (updated)
     {
-      this->simTimes.clear();
-      this->realTimes.clear();
+      this->rtfResetPending = true;
       // Set as OneTimeChange to make sure the update is not missed
       this->entityCompMgr.SetChanged(worldEntity, components::Physics::typeId,
           ComponentState::OneTimeChange);
@@ -401,55 +505,29 @@ void SimulationRunner::UpdatePhysicsParams()
 /////////////////////////////////////////////////
 void SimulationRunner::PublishStats()
 {
-  IGN_PROFILE("SimulationRunner::PublishStats");
-
-  // Create the world statistics message.
-  ignition::msgs::WorldStatistics msg;
-  msg.set_real_time_factor(this->realTimeFactor);
-
-  auto realTimeSecNsec =
-    ignition::math::durationToSecNsec(this->currentInfo.realTime);
-
-  auto simTimeSecNsec =
-    ignition::math::durationToSecNsec(this->currentInfo.simTime);
-
-  msg.mutable_real_time()->set_sec(realTimeSecNsec.first);
-  msg.mutable_real_time()->set_nsec(realTimeSecNsec.second);
-
-  msg.mutable_sim_time()->set_sec(simTimeSecNsec.first);
-  msg.mutable_sim_time()->set_nsec(simTimeSecNsec.second);
-
-  msg.set_iterations(this->currentInfo.iterations);
-
-  msg.set_paused(this->currentInfo.paused);
-
-  if (this->Stepping())
-  {
-    auto headerData = msg.mutable_header()->add_data();
-    headerData->set_key("step");
-  }
-
-  // Publish the stats message. The stats message is throttled.
-  this->statsPub.Publish(msg);
-
-  if (this->rootStatsPub.Valid())
-    this->rootStatsPub.Publish(msg);
-
-  // Create and publish the clock message. The clock message is not
-  // throttled.
-  ignition::msgs::Clock clockMsg;
-  clockMsg.mutable_real()->set_sec(realTimeSecNsec.first);
-  clockMsg.mutable_real()->set_nsec(realTimeSecNsec.second);
-  clockMsg.mutable_sim()->set_sec(simTimeSecNsec.first);
-  clockMsg.mutable_sim()->set_nsec(simTimeSecNsec.second);
-  clockMsg.mutable_system()->set_sec(IGN_SYSTEM_TIME_S());
-  clockMsg.mutable_system()->set_nsec(
-      IGN_SYSTEM_TIME_NS() - IGN_SYSTEM_TIME_S() * IGN_SEC_TO_NANO);
-  this->clockPub.Publish(clockMsg);
+  GZ_TRACE("SimulationRunner::PublishStats");
+  if (!this->statsPublisher)
+    return;
 
-  // Only publish to root topic if no others are.
-  if (this->rootClockPub.Valid())
-    this->rootClockPub.Publish(clockMsg);
+  StatsSnapshot snapshot;
+  snapshot.realTime = this->currentInfo.realTime;
+  snapshot.simTime = this->currentInfo.simTime;
+  snapshot.systemTime = std::chrono::system_clock::now();
+  snapshot.iterations = this->currentInfo.iterations;
+  snapshot.paused = this->currentInfo.paused;
+  snapshot.stepping = this->Stepping();
+  snapshot.rtfSample = this->realTimeWatch.Running();
+  snapshot.rtfReset = this->rtfResetPending;
+  snapshot.phaseTimes = {
+      this->systemTimes.StepTime(SystemTimingStats::Phase::PRE_UPDATE),
+      this->systemTimes.StepTime(SystemTimingStats::Phase::UPDATE),
+      this->systemTimes.StepTime(SystemTimingStats::Phase::POST_UPDATE)};
+  snapshot.deadlines = this->deadlineStats.Stats();
+
+  // A dropped snapshot only delays the next message, but a dropped reset
+  // must be retried
+  if (this->statsPublisher->Push(snapshot))
+    this->rtfResetPending = false;
 }
 
 //////////////////////////////////////////////////
@@ -473,6 +551,35 @@ void SimulationRunner::AddSystem(
   this->systemMgr->AddSystem(_system, entity, sdf);
 }
 
+/////////////////////////////////////////////////
+/// \brief Call a system and record the wall time it took, and the heap
+/// allocations it made if allocation tracking is compiled in.
+/// \param[in] _stats Statistics to record into.
+/// \param[in] _slot Index of the system in the statistics.
+/// \param[in] _phase Phase the system runs.
+/// \param[in] _func Function calling the system.
+template <typename Func>
+static void timedSystemCall(SystemTimingStats &_stats, std::size_t _slot,
+    SystemTimingStats::Phase _phase, const Func &_func)
+{
+  if (!AllocationTracker::Enabled())
+  {
+    const auto start = std::chrono::steady_clock::now();
+    _func();
+    _stats.Add(_slot, _phase, std::chrono::steady_clock::now() - start);
+    return;
+  }
+
+  const auto allocStart = AllocationTracker::ThreadCounts();
+  const auto start = std::chrono::steady_clock::now();
+  _func();
+  const auto duration = std::chrono::steady_clock::now() - start;
+  const auto allocEnd = AllocationTracker::ThreadCounts();
+  _stats.Add(_slot, _phase, duration);
+  _stats.AddAllocations(_slot, _phase, allocEnd.count - allocStart.count,
+      allocEnd.bytes - allocStart.bytes);
+}
+
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessSystemQueue()
 {
@@ -485,33 +592,65 @@ void SimulationRunner::ProcessSystemQueue()
   this->StopWorkerThreads();
 
   this->systemMgr->ActivatePendingSystems();
+  this->UpdateSystemSlots();
 
-  auto threadCount = this->systemMgr->SystemsPostUpdate().size() + 1u;
+  // Most PostUpdate calls run as tasks on the systems pool, only systems
+  // which ask for it get a thread of their own
+  const auto &dedicated = this->systemMgr->SystemsPostUpdateDedicated();
+  if (dedicated.empty())
+  {
+    this->postUpdateStartBarrier.reset();
+    this->postUpdateStopBarrier.reset();
+    return;
+  }
+
+  auto threadCount = dedicated.size() + 1u;
 
   igndbg << "Creating PostUpdate worker threads: "
     << threadCount << std::endl;
 
-  this->postUpdateStartBarrier = std::make_unique<Barrier>(threadCount);
-  this->postUpdateStopBarrier = std::make_unique<Barrier>(threadCount);
+  const auto spinCount = this->serverConfig.BarrierSpinCount();
+  this->postUpdateStartBarrier =
+      std::make_unique<Barrier>(threadCount, spinCount);
+  this->postUpdateStopBarrier =
+      std::make_unique<Barrier>(threadCount, spinCount);
 
   this->postUpdateThreadsRunning = true;
   int id = 0;
 
-  for (auto &system : this->systemMgr->SystemsPostUpdate())
+  for (auto &system : dedicated)
   {
     igndbg << "Creating postupdate worker thread (" << id << ")" << std::endl;
 
-    this->postUpdateThreads.push_back(std::thread([&, id]()
+    const std::size_t slot = this->postupdateDedicatedSlots[id];
+    this->postUpdateThreads.push_back(std::thread([&, id, slot]()
     {
       std::stringstream ss;
       ss << "PostUpdateThread: " << id;
-      IGN_PROFILE_THREAD_NAME(ss.str().c_str());
+      GZ_TRACE_THREAD_NAME(ss.str().c_str());
+      auto cores = this->serverConfig.ThreadAffinity(
+          ServerConfig::ThreadGroup::kPostUpdate);
+      if (cores.empty() && !this->serverConfig.ThreadAffinity(
+          ServerConfig::ThreadGroup::kSimulation).empty())
+      {
+        cores = this->unrestrictedCores;
+      }
+      if (!cores.empty() && !setThreadAffinity(cores))
+      {
+        ignwarn << "Failed to set the affinity of PostUpdate thread [" << id
+                << "]." << std::endl;
+      }
       while (this->postUpdateThreadsRunning)
       {
         this->postUpdateStartBarrier->Wait();
-        if (this->postUpdateThreadsRunning)
+        const UpdateInfo *info = this->systemPostInfoPtrs[slot];
+        if (this->postUpdateThreadsRunning && nullptr != info)
         {
-          system->PostUpdate(this->currentInfo, this->entityCompMgr);
+          timedSystemCall(this->systemTimes, slot,
+              SystemTimingStats::Phase::POST_UPDATE, [&]
+              {
+                system->PostUpdate(*info, this->entityCompMgr);
+              });
         }
         this->postUpdateStopBarrier->Wait();
       }
@@ -522,40 +661,334 @@ void SimulationRunner::ProcessSystemQueue()
   }
 }
 
+/////////////////////////////////////////////////
+void SimulationRunner::UpdateSystemSlots()
+{
+  const auto &active = this->systemMgr->ActiveSystems();
+  std::vector<std::string> names;
+  std::unordered_map<const void *, std::size_t> slotOf;
+  for (std::size_t i = 0; i < active.size(); ++i)
+  {
+    names.push_back(active[i].name);
+    // The interfaces of a system may live at different addresses
+    for (const void *iface : {static_cast<const void *>(active[i].preupdate),
+        static_cast<const void *>(active[i].update),
+        static_cast<const void *>(active[i].postupdate)})
+    {
+      if (nullptr != iface)
+        slotOf[iface] = i;
+    }
+  }
+  this->systemTimes.SetSystems(names);
+
+  this->systemPeriods.resize(active.size());
+  this->systemLastRun.resize(active.size());
+  this->systemInfos.resize(active.size());
+  this->systemInfoPtrs.resize(active.size(), nullptr);
+  this->systemPostInfoPtrs.resize(active.size(), nullptr);
+  this->systemSuspendedAt.resize(active.size());
+  this->systemWakeInfos.resize(active.size());
+  this->systemEntities.resize(active.size());
+  for (std::size_t i = 0; i < active.size(); ++i)
+  {
+    this->systemPeriods[i] = active[i].updatePeriod;
+    this->systemEntities[i] = active[i].parentEntity;
+  }
+
+  auto slots = [&](const auto &_systems)
+  {
+    std::vector<std::size_t> result;
+    for (const auto &system : _systems)
+      result.push_back(slotOf[system]);
+    return result;
+  };
+
+  this->preupdateSlots.clear();
+  for (const auto &stage : this->systemMgr->SystemsPreUpdateStages())
+    this->preupdateSlots.push_back(slots(stage));
+
+  this->updateSlots.clear();
+  for (const auto &stage : this->systemMgr->SystemsUpdateStages())
+    this->updateSlots.push_back(slots(stage));
+
+  this->postupdatePooledSlots =
+      slots(this->systemMgr->SystemsPostUpdatePooled());
+  this->postupdateDedicatedSlots =
+      slots(this->systemMgr->SystemsPostUpdateDedicated());
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::ScheduleSystems()
+{
+  const bool hasDormant =
+      this->entityCompMgr.ComponentCount(components::Dormant::typeId) > 0u;
+  for (std::size_t i = 0; i < this->systemPeriods.size(); ++i)
+  {
+    // Systems of models far from all performers are suspended
+    auto &suspendedAt = this->systemSuspendedAt[i];
+    if (hasDormant && this->IsDormant(this->systemEntities[i]))
+    {
+      if (!suspendedAt)
+        suspendedAt = this->currentInfo.simTime - this->currentInfo.dt;
+      this->systemInfoPtrs[i] = nullptr;
+      this->systemPostInfoPtrs[i] = nullptr;
+      continue;
+    }
+
+    // Systems waking up receive the time they were suspended for in dt
+    this->systemInfoPtrs[i] = &this->currentInfo;
+    if (suspendedAt)
+    {
+      const auto suspended = this->currentInfo.simTime - *suspendedAt;
+      if (suspended > this->currentInfo.dt)
+      {
+        this->systemWakeInfos[i] = this->currentInfo;
+        this->systemWakeInfos[i].dt = suspended;
+        this->systemInfoPtrs[i] = &this->systemWakeInfos[i];
+      }
+      suspendedAt.reset();
+    }
+
+    // The update period only applies to PostUpdate
+    const auto &period = this->systemPeriods[i];
+    if (period <= std::chrono::steady_clock::duration::zero())
+    {
+      this->systemPostInfoPtrs[i] = this->systemInfoPtrs[i];
+      continue;
+    }
+
+    // Run on the first step, when a period has passed, or when time went
+    // back, for example after a rewind
+    auto &lastRun = this->systemLastRun[i];
+    const auto elapsed = this->currentInfo.simTime - lastRun.value_or(
+        this->currentInfo.simTime);
+    if (lastRun && elapsed >= std::chrono::steady_clock::duration::zero() &&
+        elapsed < period)
+    {
+      this->systemPostInfoPtrs[i] = nullptr;
+      continue;
+    }
+
+    this->systemInfos[i] = this->currentInfo;
+    if (lastRun && elapsed > std::chrono::steady_clock::duration::zero())
+      this->systemInfos[i].dt = elapsed;
+    lastRun = this->currentInfo.simTime;
+    this->systemPostInfoPtrs[i] = &this->systemInfos[i];
+  }
+}
+
+/////////////////////////////////////////////////
+bool SimulationRunner::IsDormant(Entity _entity) const
+{
+  for (Entity entity = _entity; kNullEntity != entity;
+       entity = this->entityCompMgr.ParentEntity(entity))
+  {
+    if (this->entityCompMgr.EntityHasComponentType(entity,
+        components::Dormant::typeId))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 /////////////////////////////////////////////////
 void SimulationRunner::UpdateSystems()
 {
-  IGN_PROFILE("SimulationRunner::UpdateSystems");
+  GZ_TRACE("SimulationRunner::UpdateSystems");
   // \todo(nkoenig)  Systems used to be updated in parallel using
   // an ignition::common::WorkerPool. There is overhead associated with
   // this, most notably the creation and destruction of WorkOrders (see
-  // WorkerPool.cc). We could turn on parallel updates in the future, and/or
-  // turn it on if there are sufficient systems. More testing is required.
+  // WorkerPool.cc). PreUpdate and Update now run in stages on a persistent
+  // ThreadPool, but only systems which declare their component access
+  // through ISystemAccess can share a stage.
+  using Phase = SystemTimingStats::Phase;
+
+  // Decide which throttled systems run on this step
+  this->ScheduleSystems();
 
   {
-    IGN_PROFILE("PreUpdate");
-    for (auto& system : this->systemMgr->SystemsPreUpdate())
-      system->PreUpdate(this->currentInfo, this->entityCompMgr);
+    GZ_TRACE("PreUpdate");
+    const auto phaseStart = std::chrono::steady_clock::now();
+    const auto &stages = this->systemMgr->SystemsPreUpdateStages();
+    for (std::size_t s = 0; s < stages.size(); ++s)
+    {
+      const auto &stage = stages[s];
+      const auto &slots = this->preupdateSlots[s];
+      auto run = [&](std::size_t _i)
+      {
+        const UpdateInfo *info = this->systemInfoPtrs[slots[_i]];
+        if (nullptr == info)
+          return;
+        timedSystemCall(this->systemTimes, slots[_i], Phase::PRE_UPDATE, [&]
+            {
+              stage[_i]->PreUpdate(*info, this->entityCompMgr);
+            });
+      };
+
+      if (stage.size() == 1u)
+      {
+        run(0u);
+        continue;
+      }
+
+      this->entityCompMgr.LockAddingEntitiesToViews(true);
+      this->SystemsPool().ParallelFor(stage.size(),
+          [&](std::size_t _begin, std::size_t _end)
+          {
+            for (std::size_t i = _begin; i < _end; ++i)
+              run(i);
+          });
+      this->entityCompMgr.LockAddingEntitiesToViews(false);
+    }
+    this->systemTimes.SetStepTime(Phase::PRE_UPDATE,
+        std::chrono::steady_clock::now() - phaseStart);
   }
 
   {
-    IGN_PROFILE("Update");
-    for (auto& system : this->systemMgr->SystemsUpdate())
-      system->Update(this->currentInfo, this->entityCompMgr);
+    GZ_TRACE("Update");
+    const auto phaseStart = std::chrono::steady_clock::now();
+    const auto &stages = this->systemMgr->SystemsUpdateStages();
+    for (std::size_t s = 0; s < stages.size(); ++s)
+    {
+      const auto &stage = stages[s];
+      const auto &slots = this->updateSlots[s];
+      auto run = [&](std::size_t _i)
+      {
+        const UpdateInfo *info = this->systemInfoPtrs[slots[_i]];
+        if (nullptr == info)
+          return;
+        timedSystemCall(this->systemTimes, slots[_i], Phase::UPDATE, [&]
+            {
+              stage[_i]->Update(*info, this->entityCompMgr);
+            });
+      };
+
+      if (stage.size() == 1u)
+      {
+        run(0u);
+        continue;
+      }
+
+      this->entityCompMgr.LockAddingEntitiesToViews(true);
+      this->SystemsPool().ParallelFor(stage.size(),
+          [&](std::size_t _begin, std::size_t _end)
+          {
+            for (std::size_t i = _begin; i < _end; ++i)
+              run(i);
+          });
+      this->entityCompMgr.LockAddingEntitiesToViews(false);
+    }
+    this->systemTimes.SetStepTime(Phase::UPDATE,
+        std::chrono::steady_clock::now() - phaseStart);
   }
 
   {
-    IGN_PROFILE("PostUpdate");
+    GZ_TRACE("PostUpdate");
+    const auto phaseStart = std::chrono::steady_clock::now();
     this->entityCompMgr.LockAddingEntitiesToViews(true);
-    // If no systems implementing PostUpdate have been added, then
-    // the barriers will be uninitialized, so guard against that condition.
-    if (this->postUpdateStartBarrier && this->postUpdateStopBarrier)
-    {
+    // If no systems need a dedicated PostUpdate thread, then the barriers
+    // will be uninitialized, so guard against that condition.
+    const bool dedicated =
+        this->postUpdateStartBarrier && this->postUpdateStopBarrier;
+    if (dedicated)
       this->postUpdateStartBarrier->Wait();
-      this->postUpdateStopBarrier->Wait();
+
+    // The dedicated threads run while this thread and the pool go through
+    // the other systems
+    const auto &pooled = this->systemMgr->SystemsPostUpdatePooled();
+    auto run = [&](std::size_t _i)
+    {
+      const std::size_t slot = this->postupdatePooledSlots[_i];
+      const UpdateInfo *info = this->systemPostInfoPtrs[slot];
+      if (nullptr == info)
+        return;
+      timedSystemCall(this->systemTimes, slot, Phase::POST_UPDATE, [&]
+          {
+            pooled[_i]->PostUpdate(*info, this->entityCompMgr);
+          });
+    };
+
+    if (pooled.size() == 1u)
+    {
+      run(0u);
+    }
+    else if (!pooled.empty())
+    {
+      this->SystemsPool().ParallelFor(pooled.size(),
+          [&](std::size_t _begin, std::size_t _end)
+          {
+            for (std::size_t i = _begin; i < _end; ++i)
+              run(i);
+          });
     }
+
+    if (dedicated)
+      this->postUpdateStopBarrier->Wait();
     this->entityCompMgr.LockAddingEntitiesToViews(false);
+    this->systemTimes.SetStepTime(Phase::POST_UPDATE,
+        std::chrono::steady_clock::now() - phaseStart);
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::PublishSystemStats()
+{
+  if (!this->systemStatsPub.Valid() || !this->systemStatsPub.HasConnections())
+    return;
+
+  // Computing percentiles isn't free, so don't do it on every step
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->systemStatsPubTime < std::chrono::seconds(1))
+    return;
+  this->systemStatsPubTime = now;
+
+  GZ_TRACE("SimulationRunner::PublishSystemStats");
+  msgs::Param_V msg;
+  this->systemTimes.FillMsg(msg);
+
+  // Allocations of each profiled scope per step since the last publication
+  if (AllocationTracker::Enabled())
+  {
+    const auto iterations = this->currentInfo.iterations;
+    const auto steps = iterations - this->scopeAllocationsIteration;
+    auto scopeCounts = AllocationTracker::ScopeCounts();
+    for (const auto &[scope, counts] : scopeCounts)
+    {
+      const auto &previous = this->scopeAllocations[scope];
+      if (steps == 0u || counts.count == previous.count)
+        continue;
+
+      auto &params = *msg.add_param()->mutable_params();
+      params["scope"].set_type(msgs::Any::STRING);
+      params["scope"].set_string_value(scope);
+      params["allocs_per_step"].set_type(msgs::Any::DOUBLE);
+      params["allocs_per_step"].set_double_value(
+          static_cast<double>(counts.count - previous.count) / steps);
+      params["alloc_bytes_per_step"].set_type(msgs::Any::DOUBLE);
+      params["alloc_bytes_per_step"].set_double_value(
+          static_cast<double>(counts.bytes - previous.bytes) / steps);
+    }
+    this->scopeAllocations = std::move(scopeCounts);
+    this->scopeAllocationsIteration = iterations;
   }
+
+  this->systemStatsPub.Publish(msg);
+}
+
+/////////////////////////////////////////////////
+ThreadPool &SimulationRunner::SystemsPool()
+{
+  if (!this->systemsPool)
+    this->systemsPool = std::make_unique<ThreadPool>();
+  return *this->systemsPool;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::SetThreadPool(const std::shared_ptr<ThreadPool> &_pool)
+{
+  this->systemsPool = _pool;
+  this->entityCompMgr.SetThreadPool(_pool);
 }
 
 /////////////////////////////////////////////////
@@ -598,7 +1031,15 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   //
   // \todo(nkoenig) We should implement the two-phase update detailed
   // in the design.
-  IGN_PROFILE_THREAD_NAME("SimulationRunner");
+  GZ_TRACE_THREAD_NAME("SimulationRunner");
+
+  const auto &simCores =
+      this->serverConfig.ThreadAffinity(ServerConfig::ThreadGroup::kSimulation);
+  if (!simCores.empty() && !setThreadAffinity(simCores))
+  {
+    ignwarn << "Failed to set the affinity of the simulation thread."
+            << std::endl;
+  }
 
   // Initialize network communications.
   if (this->networkMgr)
@@ -646,6 +1087,13 @@ bool SimulationRunner::Run(const uint64_t _iterations)
         "stats", advertOpts);
   }
 
+  // Create the per system timing statistics publisher.
+  if (!this->systemStatsPub.Valid())
+  {
+    this->systemStatsPub =
+        this->node->Advertise<ignition::msgs::Param_V>("system_stats");
+  }
+
   if (!this->rootStatsPub.Valid())
   {
     // Check for the existence of other publishers on `/stats`
@@ -715,7 +1163,7 @@ bool SimulationRunner::Run(const uint64_t _iterations)
   while (this->running && (_iterations == 0 ||
        processedIterations < _iterations))
   {
-    IGN_PROFILE("SimulationRunner::Run - Iteration");
+    GZ_TRACE("SimulationRunner::Run - Iteration");
 
     // Update the step size and desired rtf
     this->UpdatePhysicsParams();
@@ -725,14 +1173,18 @@ bool SimulationRunner::Run(const uint64_t _iterations)
     sleepTime = 0ns;
     actualSleep = 0ns;
 
-    sleepTime = std::max(0ns, this->prevUpdateRealTime +
-        this->updatePeriod - std::chrono::steady_clock::now() -
-        this->sleepOffset);
+    // Throughput mode runs as fast as possible
+    if (!this->serverConfig.ThroughputMode())
+    {
+      sleepTime = std::max(0ns, this->prevUpdateRealTime +
+          this->updatePeriod - std::chrono::steady_clock::now() -
+          this->sleepOffset);
+    }
 
     // Only sleep if needed.
     if (sleepTime > 0ns)
     {
-      IGN_PROFILE("Sleep");
+      GZ_TRACE("Sleep");
       // Get the current time, sleep for the duration needed to match the
       // updatePeriod, and then record the actual time slept.
       startTime = std::chrono::steady_clock::now();
@@ -754,6 +1206,22 @@ bool SimulationRunner::Run(const uint64_t _iterations)
       processedIterations++;
     }
 
+    // Compare the wall time of the previous step to its budget. Only steps
+    // which ran and were paced to the update period have a deadline.
+    const bool paced = !this->currentInfo.paused &&
+        !this->serverConfig.ThroughputMode() &&
+        this->updatePeriod > 0ns;
+    if (paced && this->prevStepPaced)
+    {
+      this->deadlineStats.Add(this->updatePeriod,
+          std::chrono::steady_clock::now() - this->prevUpdateRealTime,
+          {this->systemTimes.StepTime(SystemTimingStats::Phase::PRE_UPDATE),
+           this->systemTimes.StepTime(SystemTimingStats::Phase::UPDATE),
+           this->systemTimes.StepTime(SystemTimingStats::Phase::POST_UPDATE)},
+          sleepTime > 0ns);
+    }
+    this->prevStepPaced = paced;
+
     // If network, wait for network step, otherwise do our own step
     if (this->networkMgr)
     {
@@ -777,21 +1245,43 @@ bool SimulationRunner::Run(const uint64_t _iterations)
 
   this->running = false;
 
+  // The next call to Run doesn't follow on from the last step
+  this->prevStepPaced = false;
+
+  // Callers expect the stats of the last iteration to be out once Run
+  // returns
+  if (this->statsPublisher)
+    this->statsPublisher->Flush();
+
+  // Requests made while the last iteration was finishing
+  this->ProcessCheckpoints();
+
   return true;
 }
 
 /////////////////////////////////////////////////
 void SimulationRunner::Step(const UpdateInfo &_info)
 {
-  IGN_PROFILE("SimulationRunner::Step");
+  GZ_TRACE("SimulationRunner::Step");
   this->currentInfo = _info;
 
-  // Process new ECM state information, typically sent from the GUI after
-  // a change was made to the GUI's ECM.
-  this->ProcessNewWorldControlState();
+  // In throughput mode, periodic work only happens every few iterations
+  if (this->serverConfig.ThroughputMode())
+  {
+    this->periodicWorkDue =
+        this->throughputSteps % this->serverConfig.ThroughputInterval() == 0;
+    ++this->throughputSteps;
+  }
+
+  if (this->periodicWorkDue)
+  {
+    // Process new ECM state information, typically sent from the GUI after
+    // a change was made to the GUI's ECM.
+    this->ProcessNewWorldControlState();
 
-  // Publish info
-  this->PublishStats();
+    // Publish info
+    this->PublishStats();
+  }
 
   // Record when the update step starts.
   this->prevUpdateRealTime = std::chrono::steady_clock::now();
@@ -813,6 +1303,10 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // Update all the systems.
   this->UpdateSystems();
 
+  // Changes made from now on, including the ones processed below, are newer
+  // than anything systems could have seen during this iteration
+  this->entityCompMgr.AdvanceChangeTick();
+
   if (!this->Paused() &&
        this->requestedRunToSimTime >
        std::chrono::steady_clock::duration::zero() &&
@@ -835,7 +1329,8 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   }
 
   // Process world control messages.
-  this->ProcessMessages();
+  if (this->periodicWorkDue)
+    this->ProcessMessages();
 
   // Clear all new entities
   this->entityCompMgr.ClearNewlyCreatedEntities();
@@ -846,15 +1341,127 @@ void SimulationRunner::Step(const UpdateInfo &_info)
   // cloned entities will loose their "New" state.
   this->ProcessRecreateEntitiesCreate();
 
+  // Apply structural changes that systems deferred during this iteration.
+  // This also happens after ClearNewlyCreatedEntities, so that entities
+  // created through command buffers are seen as new by the next iteration.
+  this->entityCompMgr.ApplyDeferredCommands();
+
   // Process entity removals.
   this->entityCompMgr.ProcessRemoveEntityRequests();
 
+  // Bring the shared spatial index up to date for the next iteration
+  this->entityCompMgr.UpdateSpatialIndex();
+
   // Process components removals
   this->entityCompMgr.ClearRemovedComponents();
 
   // Each network manager takes care of marking its components as unchanged
   if (!this->networkMgr)
     this->entityCompMgr.SetAllComponentsUnchanged();
+
+  // Report memory usage once this iteration's changes are settled
+  this->ProcessMemoryStatsRequest();
+  this->ProcessWorldSdfRequest();
+
+  // Checkpoints see the settled state of this iteration, and a restore
+  // takes effect before the next one
+  this->ProcessCheckpoints();
+
+  this->PublishSystemStats();
+
+  // Startup is over once the first iteration is done
+  auto &trace = StartupTrace::Instance();
+  if (trace.Active())
+    trace.Finish(this->serverConfig.StartupTracePath());
+}
+
+/////////////////////////////////////////////////
+uint64_t SimulationRunner::Checkpoint()
+{
+  std::lock_guard<std::mutex> lock(this->checkpointMutex);
+  const uint64_t id = this->nextCheckpointId++;
+  if (this->running)
+    this->pendingCheckpoints.push_back(id);
+  else
+    this->TakeCheckpoint(id);
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool SimulationRunner::Restore(const uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->checkpointMutex);
+  if (this->checkpoints.find(_id) == this->checkpoints.end() &&
+      std::find(this->pendingCheckpoints.begin(),
+      this->pendingCheckpoints.end(), _id) == this->pendingCheckpoints.end())
+  {
+    return false;
+  }
+
+  if (this->running)
+    this->pendingRestore = _id;
+  else
+    this->RestoreCheckpoint(_id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SimulationRunner::RemoveCheckpoint(const uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->checkpointMutex);
+  auto pendingIt = std::find(this->pendingCheckpoints.begin(),
+      this->pendingCheckpoints.end(), _id);
+  if (pendingIt != this->pendingCheckpoints.end())
+  {
+    this->pendingCheckpoints.erase(pendingIt);
+    return true;
+  }
+  return this->checkpoints.erase(_id) > 0u;
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::ProcessCheckpoints()
+{
+  std::lock_guard<std::mutex> lock(this->checkpointMutex);
+  for (const uint64_t id : this->pendingCheckpoints)
+    this->TakeCheckpoint(id);
+  this->pendingCheckpoints.clear();
+
+  if (this->pendingRestore)
+  {
+    this->RestoreCheckpoint(*this->pendingRestore);
+    this->pendingRestore.reset();
+  }
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::TakeCheckpoint(const uint64_t _id)
+{
+  GZ_TRACE("SimulationRunner::TakeCheckpoint");
+  this->checkpoints[_id] = {this->entityCompMgr.Snapshot(), this->currentInfo};
+}
+
+/////////////////////////////////////////////////
+void SimulationRunner::RestoreCheckpoint(const uint64_t _id)
+{
+  auto it = this->checkpoints.find(_id);
+  if (it == this->checkpoints.end())
+    return;
+
+  GZ_TRACE("SimulationRunner::RestoreCheckpoint");
+  igndbg << "Restoring checkpoint [" << _id << "]." << std::endl;
+  this->entityCompMgr.RestoreSnapshot(*it->second.snapshot);
+
+  // Time jumps back to the checkpoint, as with a seek
+  this->rtfResetPending = true;
+
+  const UpdateInfo &info = it->second.info;
+  this->currentInfo.dt = info.simTime - this->currentInfo.simTime;
+  this->currentInfo.simTime = info.simTime;
+  this->currentInfo.iterations = info.iterations;
+
+  for (auto &system : this->systemMgr->SystemsReset())
+    system->Reset(info, this->entityCompMgr);
 }
 
 //////////////////////////////////////////////////
@@ -1191,7 +1798,7 @@ bool SimulationRunner::OnPlaybackControl(const msgs::LogPlaybackControl &_req,
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessMessages()
 {
-  IGN_PROFILE("SimulationRunner::ProcessMessages");
+  GZ_TRACE("SimulationRunner::ProcessMessages");
   std::lock_guard<std::mutex> lock(this->msgBufferMutex);
   this->ProcessWorldControl();
 }
@@ -1199,7 +1806,7 @@ void SimulationRunner::ProcessMessages()
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessWorldControl()
 {
-  IGN_PROFILE("SimulationRunner::ProcessWorldControl");
+  GZ_TRACE("SimulationRunner::ProcessWorldControl");
 
   // assume no stepping unless WorldControl msgs say otherwise
   this->SetStepping(false);
@@ -1236,7 +1843,7 @@ void SimulationRunner::ProcessWorldControl()
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessRecreateEntitiesRemove()
 {
-  IGN_PROFILE("SimulationRunner::ProcessRecreateEntitiesRemove");
+  GZ_TRACE("SimulationRunner::ProcessRecreateEntitiesRemove");
 
   // store the original entities to recreate and put in request to remove them
   this->entityCompMgr.EachNoCache<components::Model,
@@ -1254,7 +1861,7 @@ void SimulationRunner::ProcessRecreateEntitiesRemove()
 /////////////////////////////////////////////////
 void SimulationRunner::ProcessRecreateEntitiesCreate()
 {
-  IGN_PROFILE("SimulationRunner::ProcessRecreateEntitiesCreate");
+  GZ_TRACE("SimulationRunner::ProcessRecreateEntitiesCreate");
 
   // clone the original entities
   for (auto & ent : this->entitiesToRecreate)
@@ -1331,6 +1938,12 @@ SimulationRunner::UpdatePeriod() const
   return this->updatePeriod;
 }
 
+/////////////////////////////////////////////////
+const StepDeadlineStats::Summary &SimulationRunner::DeadlineStats() const
+{
+  return this->deadlineStats.Stats();
+}
+
 /////////////////////////////////////////////////
 const ignition::math::clock::duration &SimulationRunner::StepSize() const
 {
@@ -1427,17 +2040,156 @@ bool SimulationRunner::GuiInfoService(ignition::msgs::GUI &_res)
 bool SimulationRunner::GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                         msgs::StringMsg &_res)
 {
+  std::ostringstream out;
+  if (!this->GenerateWorldSdfTo(out, _req))
+    return false;
+
+  _res.set_data(out.str());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::SaveWorldSdf(const msgs::SdfGeneratorConfig &_req,
+                                    msgs::Boolean &_res)
+{
+  std::string path;
+  for (const auto &data : _req.header().data())
+  {
+    if (data.key() == "path" && data.value_size() > 0)
+      path = data.value(0);
+  }
+  if (path.empty())
+  {
+    ignerr << "No path given to save the world SDF to" << std::endl;
+    return false;
+  }
+
+  std::ofstream file(path, std::ios::out);
+  if (!file.is_open())
+  {
+    ignerr << "Failed to open [" << path << "] to save the world SDF"
+           << std::endl;
+    _res.set_data(false);
+    return true;
+  }
+
+  _res.set_data(this->GenerateWorldSdfTo(file, _req));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::GenerateWorldSdfTo(std::ostream &_out,
+    const msgs::SdfGeneratorConfig &_config)
+{
+  // Generations share the cache
+  std::lock_guard<std::mutex> serviceLock(this->worldSdfServiceMutex);
+
+  auto generate = [&](sdf_generator::EntitySdfCache *_cache,
+      ThreadPool *_pool)
+  {
+    Entity world =
+        this->entityCompMgr.EntityByComponents(components::World());
+    return sdf_generator::generateWorld(_out, this->entityCompMgr, world,
+        this->fuelUriMap, _config, _cache, _pool);
+  };
+
+  if (this->running)
+  {
+    std::unique_lock<std::mutex> lock(this->worldSdfMutex);
+    bool done{false};
+    bool result{false};
+    this->worldSdfRequest = [&]
+    {
+      result = generate(&this->worldSdfCache, &this->SystemsPool());
+      done = true;
+    };
+
+    // Once the simulation thread picks the request up, this waits until the
+    // world is generated
+    if (this->worldSdfCv.wait_for(lock, std::chrono::seconds(3),
+        [&] { return done; }))
+    {
+      return result;
+    }
+    this->worldSdfRequest = nullptr;
+
+    // The simulation thread may be blocked, for example while waiting for
+    // a step while paused
+    igndbg << "Timed out waiting for the simulation thread, generating the "
+           << "world SDF on the service thread" << std::endl;
+  }
+
   // TODO(addisu) This is not thread-safe. Wait until it is safe to access the
   // ECM.
-  Entity world = this->entityCompMgr.EntityByComponents(components::World());
-  std::optional<std::string> genString = sdf_generator::generateWorld(
-      this->entityCompMgr, world, this->fuelUriMap, _req);
-  if (genString.has_value())
+  return generate(nullptr, nullptr);
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessWorldSdfRequest()
+{
+  std::lock_guard<std::mutex> lock(this->worldSdfMutex);
+  if (!this->worldSdfRequest)
+    return;
+
+  GZ_TRACE("SimulationRunner::ProcessWorldSdfRequest");
+  this->worldSdfRequest();
+  this->worldSdfRequest = nullptr;
+  this->worldSdfCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+bool SimulationRunner::MemoryStatsService(msgs::StringMsg &_res)
+{
+  std::unique_lock<std::mutex> lock(this->memoryStatsMutex);
+  const uint64_t generation = this->memoryStatsGeneration;
+  this->memoryStatsRequested = true;
+
+  // The simulation thread may be blocked, for example while waiting for
+  // a step while paused, so don't wait forever
+  if (!this->memoryStatsCv.wait_for(lock, std::chrono::seconds(3),
+      [&]
+      {
+        return this->memoryStatsGeneration != generation;
+      }))
   {
-    _res.set_data(*genString);
-    return true;
+    ignerr << "Timed out waiting for the memory statistics" << std::endl;
+    return false;
   }
-  return false;
+
+  _res.set_data(this->memoryStatsReport);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SimulationRunner::ProcessMemoryStatsRequest()
+{
+  std::lock_guard<std::mutex> lock(this->memoryStatsMutex);
+  if (!this->memoryStatsRequested)
+    return;
+
+  GZ_TRACE("SimulationRunner::ProcessMemoryStatsRequest");
+  const auto stats = this->entityCompMgr.MemoryStats();
+
+  std::ostringstream report;
+  report << "Entities: " << stats.entityCount << "\n"
+         << "Total bytes: " << stats.totalBytes << "\n"
+         << "  components: " << stats.componentBytes << "\n"
+         << "  views: " << stats.viewBytes << " (" << stats.viewCount
+         << " views, " << stats.viewEntityCount << " entities)\n"
+         << "  entity graph: " << stats.graphBytes << "\n"
+         << "  indices: " << stats.indexBytes << "\n"
+         << "  caches: " << stats.cacheBytes << "\n"
+         << "Components by type:\n";
+  for (const auto &comp : stats.components)
+  {
+    report << "  " << std::setw(12) << comp.bytes << " bytes "
+           << std::setw(8) << comp.count << " x " << comp.name << "\n";
+  }
+
+  this->memoryStatsReport = report.str();
+  this->memoryStatsRequested = false;
+  ++this->memoryStatsGeneration;
+  this->memoryStatsCv.notify_all();
 }
 
 //////////////////////////////////////////////////
@@ -23,10 +23,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
+#include <ostream>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -43,6 +46,7 @@
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/AllocationTracker.hh"
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/EventManager.hh"
@@ -53,8 +57,13 @@
 
 #include "network/NetworkManager.hh"
 #include "LevelManager.hh"
+#include "SdfGenerator.hh"
 #include "SystemManager.hh"
+#include "StatsPublisher.hh"
+#include "StepDeadlineStats.hh"
+#include "SystemTimingStats.hh"
 #include "Barrier.hh"
+#include "ThreadPool.hh"
 #include "WorldControl.hh"
 
 using namespace std::chrono_literals;
@@ -90,6 +99,31 @@ namespace ignition
       /// \brief Stop and join all post update worker threads
       private: void StopWorkerThreads();
 
+      /// \brief Get the pool used to run systems concurrently, creating it
+      /// on first use.
+      /// \return The thread pool.
+      private: ThreadPool &SystemsPool();
+
+      /// \brief Map the systems of each stage and PostUpdate list to their
+      /// index among the active systems, which is used for the timing
+      /// statistics and the update periods. Called whenever systems are
+      /// activated.
+      private: void UpdateSystemSlots();
+
+      /// \brief Decide which systems run on the current step, according
+      /// to their update period, and fill the update info they receive.
+      private: void ScheduleSystems();
+
+      /// \brief Check whether an entity belongs to a dormant model, see
+      /// components::Dormant.
+      /// \param[in] _entity Entity to check.
+      /// \return True if the entity or one of its ancestors is dormant.
+      private: bool IsDormant(Entity _entity) const;
+
+      /// \brief Publish the per system timing statistics, at most once per
+      /// second and only if someone is listening.
+      private: void PublishSystemStats();
+
       /// \brief Run the simulationrunner.
       /// \param[in] _iterations Number of iterations.
       /// \return True if the operation completed successfully.
@@ -133,7 +167,37 @@ namespace ignition
       /// \brief Update all the systems
       public: void UpdateSystems();
 
-      /// \brief Publish current world statistics.
+      /// \brief Use a thread pool shared with other runners, both for the
+      /// systems and for the entity component manager. Loops started on a
+      /// pool which is busy with another runner run on the calling thread,
+      /// so runners stepping concurrently never wait on each other. Must not
+      /// be called while the runner is running.
+      /// \param[in] _pool Pool to share.
+      public: void SetThreadPool(const std::shared_ptr<ThreadPool> &_pool);
+
+      /// \brief Save the entities, components and simulation time of the
+      /// world in memory, so that the world can be reset to them later with
+      /// Restore. Checkpoints are copy-on-write, see
+      /// EntityComponentManager::Snapshot. While the runner is running, the
+      /// checkpoint is taken at the end of the current iteration.
+      /// \return Id of the checkpoint.
+      public: uint64_t Checkpoint();
+
+      /// \brief Reset the world to a checkpoint. Systems implementing
+      /// ISystemReset are told once the state has been restored. While the
+      /// runner is running, the reset happens at the end of the current
+      /// iteration.
+      /// \param[in] _id Id returned by Checkpoint.
+      /// \return False if there is no checkpoint with that id.
+      public: bool Restore(const uint64_t _id);
+
+      /// \brief Release the memory held by a checkpoint.
+      /// \param[in] _id Id returned by Checkpoint.
+      /// \return False if there is no checkpoint with that id.
+      public: bool RemoveCheckpoint(const uint64_t _id);
+
+      /// \brief Publish current world statistics. The messages are built and
+      /// published on another thread.
       public: void PublishStats();
 
       /// \brief Load system plugin for a given entity.
@@ -193,6 +257,14 @@ namespace ignition
       /// \return The update period.
       public: const std::chrono::steady_clock::duration &UpdatePeriod() const;
 
+      /// \brief Get the real time deadline statistics of the steps run so
+      /// far. Only steps paced to the update period are recorded, so nothing
+      /// is recorded in throughput mode or with an unlimited real time
+      /// factor. The statistics are also published with the world
+      /// statistics.
+      /// \return Deadline statistics.
+      public: const StepDeadlineStats::Summary &DeadlineStats() const;
+
       /// \brief Set the paused state.
       /// \param[in] _paused True to pause the simulation runner.
       public: void SetPaused(const bool _paused);
@@ -316,13 +388,43 @@ namespace ignition
       /// \return True if successful.
       private: bool GuiInfoService(ignition::msgs::GUI &_res);
 
-      /// \brief Calculate real time factor and populate currentInfo.
+      /// \brief Populate currentInfo.
       private: void UpdateCurrentInfo();
 
       /// \brief Process all buffered messages. Ths function is called at
       /// the end of an update iteration.
       private: void ProcessMessages();
 
+      /// \brief Build the memory report if a service call is waiting for
+      /// it. This function is called at the end of an update iteration.
+      private: void ProcessMemoryStatsRequest();
+
+      /// \brief Generate the world's SDFormat if a service call is waiting
+      /// for it. This function is called at the end of an update iteration.
+      private: void ProcessWorldSdfRequest();
+
+      /// \brief Generate the world's SDFormat. While the runner is running,
+      /// this is done by the simulation thread at the end of an iteration,
+      /// so that the ECM isn't modified meanwhile, on the systems pool and
+      /// reusing the models which didn't change since the previous call.
+      /// \param[out] _out Stream to write to.
+      /// \param[in] _config Generator options.
+      /// \return True if the world was generated.
+      private: bool GenerateWorldSdfTo(std::ostream &_out,
+                   const msgs::SdfGeneratorConfig &_config);
+
+      /// \brief Take the checkpoints and apply the restore requested since
+      /// the last call.
+      private: void ProcessCheckpoints();
+
+      /// \brief Save the current state under a checkpoint id.
+      /// \param[in] _id Checkpoint id.
+      private: void TakeCheckpoint(const uint64_t _id);
+
+      /// \brief Reset the world to a saved checkpoint.
+      /// \param[in] _id Id of a taken checkpoint.
+      private: void RestoreCheckpoint(const uint64_t _id);
+
       /// \brief Process world control service messages.
       private: void ProcessWorldControl();
 
@@ -342,6 +444,24 @@ namespace ignition
       public: bool GenerateWorldSdf(const msgs::SdfGeneratorConfig &_req,
                                     msgs::StringMsg &_res);
 
+      /// \brief Write the current world's SDFormat representation straight
+      /// to a file, without building the whole document in memory.
+      /// \param[in] _req Request message with options for saving a world to
+      /// an SDFormat file. The path of the file is given by the "path" key of
+      /// the header data.
+      /// \param[out] _res True if the file was written.
+      /// \return True if the request had a path.
+      public: bool SaveWorldSdf(const msgs::SdfGeneratorConfig &_req,
+                                msgs::Boolean &_res);
+
+      /// \brief Service callback which reports the memory used by the
+      /// entity component manager, per component type and per internal data
+      /// structure. The report is built by the simulation thread at the end
+      /// of an iteration, so this blocks until then.
+      /// \param[out] _res Human readable report.
+      /// \return True if the report was built before timing out.
+      public: bool MemoryStatsService(msgs::StringMsg &_res);
+
       /// \brief Sets the file path to fuel URI map.
       /// \param[in] _map A populated map of file paths to fuel URIs.
       public: void SetFuelUriMap(
@@ -419,12 +539,6 @@ namespace ignition
       /// The default update rate is 500hz, which is a period of 2ms.
       private: std::chrono::steady_clock::duration updatePeriod{2ms};
 
-      /// \brief List of simulation times used to compute averages.
-      private: std::list<std::chrono::steady_clock::duration> simTimes;
-
-      /// \brief List of real times used to compute averages.
-      private: std::list<std::chrono::steady_clock::duration> realTimes;
-
       /// \brief Node for communication.
       private: std::unique_ptr<transport::Node> node{nullptr};
 
@@ -440,6 +554,14 @@ namespace ignition
       /// \brief Clock publisher for the root `/clock` topic.
       private: ignition::transport::Node::Publisher rootClockPub;
 
+      /// \brief Publishes the stats and clock messages off the simulation
+      /// thread, using the publishers above.
+      private: std::unique_ptr<StatsPublisher> statsPublisher;
+
+      /// \brief Set when simulation time jumps, so that the real time factor
+      /// is computed anew from the next published stats on.
+      private: bool rtfResetPending{false};
+
       /// \brief Name of world being simulated.
       private: std::string worldName;
 
@@ -464,10 +586,6 @@ namespace ignition
       /// \brief Pointer to the sdf::World object of this runner
       private: const sdf::World *sdfWorld;
 
-      /// \brief The real time factor calculated based on sim and real time
-      /// averages.
-      private: double realTimeFactor{0.0};
-
       /// \brief Number of simulation steps requested that haven't been
       /// executed yet.
       private: unsigned int pendingSimIterations{0};
@@ -492,13 +610,53 @@ namespace ignition
       /// \brief Mutex to protect message buffers.
       private: std::mutex msgBufferMutex;
 
+      /// \brief Protects the memory report and its requests.
+      private: std::mutex memoryStatsMutex;
+
+      /// \brief Notifies the service callbacks that a memory report was
+      /// built.
+      private: std::condition_variable memoryStatsCv;
+
+      /// \brief True if a memory report was requested and not built yet.
+      private: bool memoryStatsRequested{false};
+
+      /// \brief Number of memory reports built so far.
+      private: uint64_t memoryStatsGeneration{0u};
+
+      /// \brief Latest memory report.
+      private: std::string memoryStatsReport;
+
+      /// \brief Only one world SDFormat generation runs at a time.
+      private: std::mutex worldSdfServiceMutex;
+
+      /// \brief Protects the world SDFormat generation request.
+      private: std::mutex worldSdfMutex;
+
+      /// \brief Notifies the service callbacks that the world SDFormat was
+      /// generated.
+      private: std::condition_variable worldSdfCv;
+
+      /// \brief Generation of the world SDFormat waiting for the simulation
+      /// thread, if any.
+      private: std::function<void()> worldSdfRequest;
+
+      /// \brief SDFormat of the world's children from the previous
+      /// generation.
+      private: sdf_generator::EntitySdfCache worldSdfCache;
+
       /// \brief Keep the latest GUI message.
       public: msgs::GUI guiMsg;
 
       /// \brief Copy of the server configuration.
       public: ServerConfig serverConfig;
 
-      /// \brief Collection of threads running system PostUpdates
+      /// \brief Cores the runner was created on, which are given to threads
+      /// without a thread group of their own, so that they don't inherit the
+      /// cores of the simulation thread. Empty if unknown.
+      public: std::vector<unsigned int> unrestrictedCores;
+
+      /// \brief Collection of threads running the PostUpdates of systems
+      /// which need a dedicated thread
       private: std::vector<std::thread> postUpdateThreads;
 
       /// \brief Flag to indicate running status of PostUpdate threads
@@ -510,6 +668,117 @@ namespace ignition
       /// \brief Barrier to signal end of PostUpdate thread execution
       private: std::unique_ptr<Barrier> postUpdateStopBarrier;
 
+      /// \brief Pool running PreUpdate and Update systems which share a
+      /// stage, and PostUpdate systems without a dedicated thread. Created
+      /// on first use, so worlds with few systems don't start any extra
+      /// threads, unless one is shared through SetThreadPool.
+      private: std::shared_ptr<ThreadPool> systemsPool;
+
+      /// \brief Wall time spent in each system.
+      private: SystemTimingStats systemTimes;
+
+      /// \brief Wall time of paced steps compared to the update period.
+      private: StepDeadlineStats deadlineStats;
+
+      /// \brief Whether the previous step was paced, so that the wall time
+      /// from its start to the next step's start can be recorded.
+      private: bool prevStepPaced{false};
+
+      /// \brief Index in systemTimes of each system of each PreUpdate stage.
+      private: std::vector<std::vector<std::size_t>> preupdateSlots;
+
+      /// \brief Index in systemTimes of each system of each Update stage.
+      private: std::vector<std::vector<std::size_t>> updateSlots;
+
+      /// \brief Index in systemTimes of each pooled PostUpdate system.
+      private: std::vector<std::size_t> postupdatePooledSlots;
+
+      /// \brief Index in systemTimes of each dedicated PostUpdate system.
+      private: std::vector<std::size_t> postupdateDedicatedSlots;
+
+      /// \brief PostUpdate period of each active system, zero to run on
+      /// every step.
+      private: std::vector<std::chrono::steady_clock::duration> systemPeriods;
+
+      /// \brief Simulation time of the last PostUpdate of each active system
+      /// with an update period.
+      private: std::vector<std::optional<std::chrono::steady_clock::duration>>
+                   systemLastRun;
+
+      /// \brief Update info passed to the PostUpdate of each active system
+      /// with an update period, whose dt spans the time since its last call.
+      private: std::vector<UpdateInfo> systemInfos;
+
+      /// \brief Update info each active system receives in PreUpdate and
+      /// Update on the current step, or null if the system is skipped.
+      private: std::vector<const UpdateInfo *> systemInfoPtrs;
+
+      /// \brief Update info each active system receives in PostUpdate on the
+      /// current step, or null if the system is skipped.
+      private: std::vector<const UpdateInfo *> systemPostInfoPtrs;
+
+      /// \brief Entity each active system is attached to, used to skip the
+      /// systems of dormant models.
+      private: std::vector<Entity> systemEntities;
+
+      /// \brief Simulation time of the last step each active system ran
+      /// on before its model became dormant, while it's dormant.
+      private: std::vector<std::optional<std::chrono::steady_clock::duration>>
+                   systemSuspendedAt;
+
+      /// \brief Update info passed to PreUpdate and Update of each active
+      /// system on the step its model wakes up, whose dt spans the time it
+      /// was suspended for.
+      private: std::vector<UpdateInfo> systemWakeInfos;
+
+      /// \brief False on iterations where throughput mode skips periodic
+      /// work, such as publishing statistics. Always true otherwise.
+      private: bool periodicWorkDue{true};
+
+      /// \brief Number of steps taken in throughput mode.
+      private: uint64_t throughputSteps{0u};
+
+      /// \brief World state saved by Checkpoint.
+      private: struct WorldCheckpoint
+      {
+        /// \brief Entities and components.
+        std::shared_ptr<const EntityComponentSnapshot> snapshot;
+
+        /// \brief Simulation time and iteration.
+        UpdateInfo info;
+      };
+
+      /// \brief Taken checkpoints, by id.
+      private: std::map<uint64_t, WorldCheckpoint> checkpoints;
+
+      /// \brief Ids of checkpoints requested while running, to be taken at
+      /// the end of the current iteration.
+      private: std::vector<uint64_t> pendingCheckpoints;
+
+      /// \brief Id of the checkpoint to restore at the end of the current
+      /// iteration, if any.
+      private: std::optional<uint64_t> pendingRestore;
+
+      /// \brief Id of the next checkpoint.
+      private: uint64_t nextCheckpointId{1u};
+
+      /// \brief Protects the checkpoints.
+      private: std::mutex checkpointMutex;
+
+      /// \brief Publisher of the per system timing statistics.
+      private: ignition::transport::Node::Publisher systemStatsPub;
+
+      /// \brief Last time the per system timing statistics were published.
+      private: std::chrono::steady_clock::time_point systemStatsPubTime;
+
+      /// \brief Allocations of each profiled scope when the statistics were
+      /// last published. Only used when allocation tracking is compiled in.
+      private: std::map<std::string, AllocationTracker::Counts>
+                   scopeAllocations;
+
+      /// \brief Iteration when the statistics were last published.
+      private: uint64_t scopeAllocationsIteration{0u};
+
       /// \brief Map from file paths to Fuel URIs.
       private: std::unordered_map<std::string, std::string> fuelUriMap;
 
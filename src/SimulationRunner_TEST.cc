@@ -1666,6 +1666,44 @@ TEST_P(SimulationRunnerTest, GeneratedSdfHasNoSpuriousPlugins)
   EXPECT_TRUE(checkForSpuriousPlugins(newRoot.Element()));
 }
 
+/////////////////////////////////////////////////
+TEST_P(SimulationRunnerTest, DeadlineStats)
+{
+  // Load SDF file
+  sdf::Root root;
+  root.Load(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "worlds", "shapes.sdf"));
+
+  ASSERT_EQ(1u, root.WorldCount());
+
+  // Create simulation runner
+  auto systemLoader = std::make_shared<SystemLoader>();
+  SimulationRunner runner(root.WorldByIndex(0), systemLoader);
+  runner.SetPaused(false);
+
+  // Steps which aren't paced have no deadline
+  ASSERT_EQ(0ms, runner.UpdatePeriod());
+  EXPECT_TRUE(runner.Run(10));
+  EXPECT_EQ(0u, runner.DeadlineStats().steps);
+
+  // The first step of a run has no previous step to be measured from
+  runner.SetUpdatePeriod(2ms);
+  EXPECT_TRUE(runner.Run(20));
+  auto stats = runner.DeadlineStats();
+  EXPECT_EQ(19u, stats.steps);
+  EXPECT_LE(stats.misses, stats.steps);
+
+  uint64_t bucketed{0u};
+  for (const auto count : stats.histogram)
+    bucketed += count;
+  EXPECT_EQ(stats.steps, bucketed);
+
+  uint64_t attributed{0u};
+  for (const auto count : stats.phaseMisses)
+    attributed += count;
+  EXPECT_EQ(stats.misses, attributed);
+}
+
 // Run multiple times. We want to make sure that static globals don't cause
 // problems.
 INSTANTIATE_TEST_SUITE_P(ServerRepeat, SimulationRunnerTest,
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "ignition/gazebo/SmallVector.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+using Doubles = SmallVector<double, 2>;
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, Inline)
+{
+  Doubles values;
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(0u, values.size());
+  EXPECT_EQ(2u, values.capacity());
+  EXPECT_TRUE(values.IsInline());
+
+  values.push_back(1.0);
+  values.emplace_back(2.0);
+  EXPECT_EQ(2u, values.size());
+  EXPECT_TRUE(values.IsInline());
+  EXPECT_DOUBLE_EQ(1.0, values[0]);
+  EXPECT_DOUBLE_EQ(2.0, values.at(1));
+  EXPECT_DOUBLE_EQ(1.0, values.front());
+  EXPECT_DOUBLE_EQ(2.0, values.back());
+  EXPECT_THROW(values.at(2), std::out_of_range);
+
+  values.resize(1);
+  EXPECT_EQ(1u, values.size());
+  values.resize(2);
+  EXPECT_DOUBLE_EQ(0.0, values[1]);
+
+  values.pop_back();
+  EXPECT_EQ(1u, values.size());
+  values.clear();
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(values.IsInline());
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, Heap)
+{
+  Doubles values{1.0, 2.0, 3.0};
+  EXPECT_EQ(3u, values.size());
+  EXPECT_FALSE(values.IsInline());
+  EXPECT_LE(3u, values.capacity());
+  EXPECT_EQ((std::vector<double>{1.0, 2.0, 3.0}), values);
+
+  // Appending an element of the container itself
+  values.push_back(values[0]);
+  values.push_back(values[3]);
+  EXPECT_EQ((std::vector<double>{1.0, 2.0, 3.0, 1.0, 1.0}), values);
+
+  // Copies only allocate if needed
+  Doubles copy(values);
+  EXPECT_EQ(values, copy);
+  copy.resize(1u);
+  EXPECT_NE(values, copy);
+
+  // Moves take over the heap storage
+  const double *data = values.data();
+  Doubles moved(std::move(values));
+  EXPECT_EQ(data, moved.data());
+  EXPECT_EQ(5u, moved.size());
+  EXPECT_TRUE(values.empty());  // NOLINT
+  EXPECT_TRUE(values.IsInline());  // NOLINT
+
+  Doubles assigned;
+  assigned = std::move(moved);
+  EXPECT_EQ(data, assigned.data());
+  EXPECT_EQ(5u, assigned.size());
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, Vector)
+{
+  // Conversions from and to std::vector
+  std::vector<double> vec{1.0, 2.0};
+  Doubles values = vec;
+  EXPECT_TRUE(values.IsInline());
+  EXPECT_EQ(vec, values);
+  EXPECT_EQ(values, vec);
+
+  std::vector<double> back = values;
+  EXPECT_EQ(vec, back);
+
+  values = std::vector<double>(3u, 4.0);
+  EXPECT_EQ(3u, values.size());
+  EXPECT_DOUBLE_EQ(4.0, values[2]);
+  EXPECT_NE(vec, values);
+
+  values = {5.0};
+  EXPECT_EQ(1u, values.size());
+  EXPECT_DOUBLE_EQ(5.0, values[0]);
+
+  // Functions taking vectors accept it
+  auto sum = [](const std::vector<double> &_vec)
+  {
+    double total{0.0};
+    for (double v : _vec)
+      total += v;
+    return total;
+  };
+  EXPECT_DOUBLE_EQ(5.0, sum(values));
+}
+
+/////////////////////////////////////////////////
+TEST(SmallVectorTest, Modifiers)
+{
+  Doubles values(2u, 1.0);
+  EXPECT_EQ((std::vector<double>{1.0, 1.0}), values);
+
+  values.assign({1.0, 2.0, 3.0});
+  values.erase(values.begin());
+  EXPECT_EQ((std::vector<double>{2.0, 3.0}), values);
+
+  values.insert(values.begin() + 1, 4.0);
+  EXPECT_EQ((std::vector<double>{2.0, 4.0, 3.0}), values);
+
+  values.erase(values.begin(), values.end());
+  EXPECT_TRUE(values.empty());
+
+  // Ranges
+  std::vector<double> vec{6.0, 7.0};
+  Doubles range(vec.begin(), vec.end());
+  EXPECT_EQ(vec, range);
+  EXPECT_EQ((std::vector<double>{7.0, 6.0}),
+      std::vector<double>(range.rbegin(), range.rend()));
+
+  Doubles other{8.0, 9.0, 10.0};
+  range.swap(other);
+  EXPECT_EQ(3u, range.size());
+  EXPECT_EQ(vec, other);
+}
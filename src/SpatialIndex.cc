@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/SpatialIndex.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+/// \brief Maximum number of cells an entity can be stored in. Entities
+/// whose box overlaps more cells are tested on every query instead.
+static constexpr double kMaxCellsPerEntity{64.0};
+
+/// \brief Cell coordinates are clamped to this value, so that boxes far
+/// away from the origin don't overflow.
+static constexpr double kMaxCellCoordinate{1e15};
+
+/// \brief Integer coordinates of a grid cell.
+struct CellKey
+{
+  /// \brief Equality operator.
+  /// \param[in] _other Key to compare to.
+  /// \return True if the keys are the same cell.
+  bool operator==(const CellKey &_other) const
+  {
+    return this->x == _other.x && this->y == _other.y && this->z == _other.z;
+  }
+
+  /// \brief X coordinate.
+  int64_t x{0};
+
+  /// \brief Y coordinate.
+  int64_t y{0};
+
+  /// \brief Z coordinate.
+  int64_t z{0};
+};
+
+/// \brief Hash function for cell keys.
+struct CellKeyHash
+{
+  /// \brief Hash a key.
+  /// \param[in] _key Key to hash.
+  /// \return Hash value.
+  std::size_t operator()(const CellKey &_key) const
+  {
+    const uint64_t h = static_cast<uint64_t>(_key.x) * 73856093u ^
+        static_cast<uint64_t>(_key.y) * 19349663u ^
+        static_cast<uint64_t>(_key.z) * 83492791u;
+    return static_cast<std::size_t>(h);
+  }
+};
+
+/// \brief An entity in the index.
+struct IndexEntry
+{
+  /// \brief Box of the entity.
+  ignition::math::AxisAlignedBox box;
+
+  /// \brief Lowest cell overlapped by the box.
+  CellKey min;
+
+  /// \brief Highest cell overlapped by the box.
+  CellKey max;
+
+  /// \brief True if the entity is in the oversized list instead of cells.
+  bool oversized{false};
+};
+
+/// \brief Private data for SpatialIndex
+class ignition::gazebo::SpatialIndexPrivate
+{
+  /// \brief Get the cell containing a point.
+  /// \param[in] _point Point in the world frame.
+  /// \return The cell.
+  public: CellKey Cell(const math::Vector3d &_point) const;
+
+  /// \brief Get the number of cells between two cells, inclusive.
+  /// \param[in] _min Lowest cell.
+  /// \param[in] _max Highest cell.
+  /// \return Number of cells.
+  public: static double CellCount(const CellKey &_min, const CellKey &_max);
+
+  /// \brief Add an entity to the cells, or to the oversized list.
+  /// \param[in] _entity Entity.
+  /// \param[in] _entry Entry of the entity.
+  public: void Insert(const Entity _entity, const IndexEntry &_entry);
+
+  /// \brief Remove an entity from the cells, or from the oversized list.
+  /// \param[in] _entity Entity.
+  /// \param[in] _entry Entry of the entity.
+  public: void Erase(const Entity _entity, const IndexEntry &_entry);
+
+  /// \brief Get all entities whose box intersects a box, without any
+  /// further filtering.
+  /// \param[in] _box Box in the world frame.
+  /// \return Entities, sorted by id.
+  public: std::vector<Entity> Query(const math::AxisAlignedBox &_box) const;
+
+  /// \brief Length of the side of each cell.
+  public: double cellSize{8.0};
+
+  /// \brief All entities in the index.
+  public: std::unordered_map<Entity, IndexEntry> entries;
+
+  /// \brief Entities overlapping each non-empty cell.
+  public: std::unordered_map<CellKey, std::vector<Entity>, CellKeyHash> cells;
+
+  /// \brief Entities overlapping too many cells to be stored in them.
+  public: std::vector<Entity> oversized;
+};
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Check whether a box can be indexed.
+/// \param[in] _box Box to check.
+/// \return True if the box is finite and its minimum isn't greater than its
+/// maximum.
+static bool validBox(const math::AxisAlignedBox &_box)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!std::isfinite(_box.Min()[i]) || !std::isfinite(_box.Max()[i]) ||
+        _box.Min()[i] > _box.Max()[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+CellKey SpatialIndexPrivate::Cell(const math::Vector3d &_point) const
+{
+  auto coordinate = [this](double _value)
+  {
+    const double cell = std::floor(_value / this->cellSize);
+    return static_cast<int64_t>(
+        std::clamp(cell, -kMaxCellCoordinate, kMaxCellCoordinate));
+  };
+
+  CellKey key;
+  key.x = coordinate(_point.X());
+  key.y = coordinate(_point.Y());
+  key.z = coordinate(_point.Z());
+  return key;
+}
+
+//////////////////////////////////////////////////
+double SpatialIndexPrivate::CellCount(const CellKey &_min,
+    const CellKey &_max)
+{
+  return (static_cast<double>(_max.x - _min.x) + 1.0) *
+      (static_cast<double>(_max.y - _min.y) + 1.0) *
+      (static_cast<double>(_max.z - _min.z) + 1.0);
+}
+
+//////////////////////////////////////////////////
+void SpatialIndexPrivate::Insert(const Entity _entity,
+    const IndexEntry &_entry)
+{
+  if (_entry.oversized)
+  {
+    this->oversized.push_back(_entity);
+    return;
+  }
+
+  for (int64_t x = _entry.min.x; x <= _entry.max.x; ++x)
+  {
+    for (int64_t y = _entry.min.y; y <= _entry.max.y; ++y)
+    {
+      for (int64_t z = _entry.min.z; z <= _entry.max.z; ++z)
+        this->cells[CellKey{x, y, z}].push_back(_entity);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void SpatialIndexPrivate::Erase(const Entity _entity,
+    const IndexEntry &_entry)
+{
+  auto eraseFrom = [_entity](std::vector<Entity> &_entities)
+  {
+    auto it = std::find(_entities.begin(), _entities.end(), _entity);
+    if (it == _entities.end())
+      return;
+    *it = _entities.back();
+    _entities.pop_back();
+  };
+
+  if (_entry.oversized)
+  {
+    eraseFrom(this->oversized);
+    return;
+  }
+
+  for (int64_t x = _entry.min.x; x <= _entry.max.x; ++x)
+  {
+    for (int64_t y = _entry.min.y; y <= _entry.max.y; ++y)
+    {
+      for (int64_t z = _entry.min.z; z <= _entry.max.z; ++z)
+      {
+        auto cellIt = this->cells.find(CellKey{x, y, z});
+        if (cellIt == this->cells.end())
+          continue;
+        eraseFrom(cellIt->second);
+        if (cellIt->second.empty())
+          this->cells.erase(cellIt);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> SpatialIndexPrivate::Query(
+    const math::AxisAlignedBox &_box) const
+{
+  std::vector<Entity> result;
+  if (!validBox(_box) || this->entries.empty())
+    return result;
+
+  auto test = [&](const Entity _entity)
+  {
+    auto it = this->entries.find(_entity);
+    if (it != this->entries.end() && it->second.box.Intersects(_box))
+      result.push_back(_entity);
+  };
+
+  const CellKey min = this->Cell(_box.Min());
+  const CellKey max = this->Cell(_box.Max());
+
+  // Visiting every entity is cheaper than visiting more cells than there are
+  // entities
+  if (CellCount(min, max) > static_cast<double>(this->entries.size()))
+  {
+    for (const auto &entry : this->entries)
+    {
+      if (entry.second.box.Intersects(_box))
+        result.push_back(entry.first);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  for (int64_t x = min.x; x <= max.x; ++x)
+  {
+    for (int64_t y = min.y; y <= max.y; ++y)
+    {
+      for (int64_t z = min.z; z <= max.z; ++z)
+      {
+        auto cellIt = this->cells.find(CellKey{x, y, z});
+        if (cellIt == this->cells.end())
+          continue;
+        for (const Entity entity : cellIt->second)
+          test(entity);
+      }
+    }
+  }
+
+  for (const Entity entity : this->oversized)
+    test(entity);
+
+  // Entities spanning several cells are found once per cell
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(double _cellSize)
+  : dataPtr(std::make_unique<SpatialIndexPrivate>())
+{
+  if (_cellSize > 0.0 && std::isfinite(_cellSize))
+    this->dataPtr->cellSize = _cellSize;
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::~SpatialIndex() = default;
+
+//////////////////////////////////////////////////
+void SpatialIndex::Update(const Entity _entity,
+    const math::AxisAlignedBox &_box)
+{
+  if (!validBox(_box))
+  {
+    this->Remove(_entity);
+    return;
+  }
+
+  IndexEntry newEntry;
+  newEntry.box = _box;
+  newEntry.min = this->dataPtr->Cell(_box.Min());
+  newEntry.max = this->dataPtr->Cell(_box.Max());
+  newEntry.oversized = SpatialIndexPrivate::CellCount(newEntry.min,
+      newEntry.max) > kMaxCellsPerEntity;
+
+  auto it = this->dataPtr->entries.find(_entity);
+  if (it == this->dataPtr->entries.end())
+  {
+    this->dataPtr->Insert(_entity, newEntry);
+    this->dataPtr->entries.emplace(_entity, newEntry);
+    return;
+  }
+
+  // Most updates are small motions within the same cells
+  auto &entry = it->second;
+  if (entry.oversized != newEntry.oversized || !(entry.min == newEntry.min) ||
+      !(entry.max == newEntry.max))
+  {
+    this->dataPtr->Erase(_entity, entry);
+    this->dataPtr->Insert(_entity, newEntry);
+  }
+  entry = newEntry;
+}
+
+//////////////////////////////////////////////////
+void SpatialIndex::Remove(const Entity _entity)
+{
+  auto it = this->dataPtr->entries.find(_entity);
+  if (it == this->dataPtr->entries.end())
+    return;
+
+  this->dataPtr->Erase(_entity, it->second);
+  this->dataPtr->entries.erase(it);
+}
+
+//////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  this->dataPtr->entries.clear();
+  this->dataPtr->cells.clear();
+  this->dataPtr->oversized.clear();
+}
+
+//////////////////////////////////////////////////
+bool SpatialIndex::HasEntity(const Entity _entity) const
+{
+  return this->dataPtr->entries.find(_entity) !=
+      this->dataPtr->entries.end();
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox SpatialIndex::Box(const Entity _entity) const
+{
+  auto it = this->dataPtr->entries.find(_entity);
+  if (it == this->dataPtr->entries.end())
+    return math::AxisAlignedBox();
+  return it->second.box;
+}
+
+//////////////////////////////////////////////////
+std::size_t SpatialIndex::Size() const
+{
+  return this->dataPtr->entries.size();
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> SpatialIndex::QueryBox(
+    const math::AxisAlignedBox &_box) const
+{
+  IGN_PROFILE("SpatialIndex::QueryBox");
+  return this->dataPtr->Query(_box);
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> SpatialIndex::QuerySphere(const math::Vector3d &_center,
+    double _radius) const
+{
+  IGN_PROFILE("SpatialIndex::QuerySphere");
+  if (_radius < 0.0)
+    return {};
+
+  const math::Vector3d extent(_radius, _radius, _radius);
+  auto result = this->dataPtr->Query(
+      math::AxisAlignedBox(_center - extent, _center + extent));
+
+  // Keep boxes whose closest point to the center is within the radius
+  const double radiusSquared = _radius * _radius;
+  result.erase(std::remove_if(result.begin(), result.end(),
+      [&](const Entity _entity)
+      {
+        const auto &box = this->dataPtr->entries.at(_entity).box;
+        double distanceSquared{0.0};
+        for (int i = 0; i < 3; ++i)
+        {
+          const double closest =
+              std::clamp(_center[i], box.Min()[i], box.Max()[i]);
+          distanceSquared += (closest - _center[i]) * (closest - _center[i]);
+        }
+        return distanceSquared > radiusSquared;
+      }), result.end());
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<Entity> SpatialIndex::QueryFrustum(
+    const math::Frustum &_frustum) const
+{
+  IGN_PROFILE("SpatialIndex::QueryFrustum");
+
+  // Bound the frustum by the sphere around its origin which contains the
+  // corners of its far plane
+  const double halfWidth =
+      std::tan(_frustum.FOV().Radian() * 0.5) * _frustum.Far();
+  const double halfHeight = _frustum.AspectRatio() > 0.0 ?
+      halfWidth / _frustum.AspectRatio() : halfWidth;
+  double radius = std::sqrt(_frustum.Far() * _frustum.Far() +
+      halfWidth * halfWidth + halfHeight * halfHeight);
+  if (!std::isfinite(radius))
+    radius = std::numeric_limits<double>::max() * 0.25;
+
+  const math::Vector3d center = _frustum.Pose().Pos();
+  const math::Vector3d extent(radius, radius, radius);
+  auto result = this->dataPtr->Query(
+      math::AxisAlignedBox(center - extent, center + extent));
+
+  result.erase(std::remove_if(result.begin(), result.end(),
+      [&](const Entity _entity)
+      {
+        return !_frustum.Contains(this->dataPtr->entries.at(_entity).box);
+      }), result.end());
+  return result;
+}
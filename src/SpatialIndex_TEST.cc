@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "ignition/gazebo/SpatialIndex.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Make a cube centered at a point.
+/// \param[in] _center Center of the cube.
+/// \param[in] _halfSize Half the length of its side.
+/// \return The cube.
+static math::AxisAlignedBox cube(const math::Vector3d &_center,
+    double _halfSize)
+{
+  const math::Vector3d extent(_halfSize, _halfSize, _halfSize);
+  return math::AxisAlignedBox(_center - extent, _center + extent);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, UpdateRemove)
+{
+  SpatialIndex index(1.0);
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_FALSE(index.HasEntity(1));
+  EXPECT_TRUE(index.QueryBox(cube(math::Vector3d::Zero, 100)).empty());
+
+  index.Update(1, cube(math::Vector3d::Zero, 0.25));
+  index.Update(2, cube(math::Vector3d(10, 0, 0), 0.25));
+  EXPECT_EQ(2u, index.Size());
+  EXPECT_TRUE(index.HasEntity(1));
+  EXPECT_EQ(cube(math::Vector3d::Zero, 0.25), index.Box(1));
+
+  EXPECT_EQ(std::vector<Entity>({1}),
+      index.QueryBox(cube(math::Vector3d(0.5, 0, 0), 0.5)));
+
+  // Small motion within a cell, then across cells
+  index.Update(1, cube(math::Vector3d(0.1, 0, 0), 0.25));
+  EXPECT_EQ(std::vector<Entity>({1}),
+      index.QueryBox(cube(math::Vector3d::Zero, 0.5)));
+  index.Update(1, cube(math::Vector3d(10, 0.5, 0), 0.25));
+  EXPECT_TRUE(index.QueryBox(cube(math::Vector3d::Zero, 0.5)).empty());
+  EXPECT_EQ(std::vector<Entity>({1, 2}),
+      index.QueryBox(cube(math::Vector3d(10, 0, 0), 1.0)));
+
+  index.Remove(2);
+  EXPECT_FALSE(index.HasEntity(2));
+  EXPECT_EQ(std::vector<Entity>({1}),
+      index.QueryBox(cube(math::Vector3d(10, 0, 0), 1.0)));
+
+  // Invalid boxes remove the entity
+  index.Update(1, math::AxisAlignedBox(math::Vector3d(1, 1, 1),
+      math::Vector3d(-1, -1, -1)));
+  EXPECT_FALSE(index.HasEntity(1));
+
+  index.Update(3, cube(math::Vector3d::Zero, 1.0));
+  index.Clear();
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_TRUE(index.QueryBox(cube(math::Vector3d::Zero, 100)).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, LargeBoxes)
+{
+  SpatialIndex index(1.0);
+
+  // Spans many cells, so it's tested on every query
+  index.Update(1, cube(math::Vector3d::Zero, 50.0));
+  // Spans a few cells
+  index.Update(2, cube(math::Vector3d(20, 0, 0), 1.5));
+
+  EXPECT_EQ(std::vector<Entity>({1}),
+      index.QueryBox(cube(math::Vector3d(-40, 40, 0), 0.1)));
+  EXPECT_EQ(std::vector<Entity>({1, 2}),
+      index.QueryBox(cube(math::Vector3d(21, 0, 0), 0.1)));
+
+  // Entities in several cells are only reported once
+  EXPECT_EQ(std::vector<Entity>({1, 2}),
+      index.QueryBox(cube(math::Vector3d(20, 0, 0), 3.0)));
+
+  // Huge queries visit entities instead of cells
+  EXPECT_EQ(std::vector<Entity>({1, 2}),
+      index.QueryBox(cube(math::Vector3d::Zero, 1e12)));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, Sphere)
+{
+  SpatialIndex index(2.0);
+  index.Update(1, cube(math::Vector3d(3, 3, 0), 0.5));
+  index.Update(2, cube(math::Vector3d(3, 0, 0), 0.5));
+  index.Update(3, math::AxisAlignedBox(math::Vector3d(-1, 0, 0),
+      math::Vector3d(-1, 0, 0)));
+
+  // The corner of the box of entity 1 is 2.5 * sqrt(2) away
+  EXPECT_EQ(std::vector<Entity>({2, 3}),
+      index.QuerySphere(math::Vector3d::Zero, 3.0));
+  EXPECT_EQ(std::vector<Entity>({1, 2, 3}),
+      index.QuerySphere(math::Vector3d::Zero, 3.6));
+  EXPECT_EQ(std::vector<Entity>({3}),
+      index.QuerySphere(math::Vector3d::Zero, 1.0));
+  EXPECT_TRUE(index.QuerySphere(math::Vector3d::Zero, -1.0).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialIndexTest, Frustum)
+{
+  SpatialIndex index(1.0);
+  index.Update(1, cube(math::Vector3d(5, 0, 0), 0.5));
+  index.Update(2, cube(math::Vector3d(-5, 0, 0), 0.5));
+  index.Update(3, cube(math::Vector3d(50, 0, 0), 0.5));
+  index.Update(4, cube(math::Vector3d(5, 20, 0), 0.5));
+
+  // Looking along +X, up to 10 m away
+  math::Frustum frustum(0.1, 10.0, math::Angle(IGN_PI * 0.5), 1.0,
+      math::Pose3d::Zero);
+  EXPECT_EQ(std::vector<Entity>({1}), index.QueryFrustum(frustum));
+
+  // Looking along -X
+  frustum.SetPose(math::Pose3d(0, 0, 0, 0, 0, IGN_PI));
+  EXPECT_EQ(std::vector<Entity>({2}), index.QueryFrustum(frustum));
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SPSCRING_HH_
+#define IGNITION_GAZEBO_SPSCRING_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class SpscRing SpscRing.hh
+    /// \brief Fixed capacity, lock-free queue for one producer thread and one
+    /// consumer thread.
+    ///
+    /// Push must only be called from one thread and Pop from one other
+    /// thread. Neither blocks nor allocates: Push fails when the ring is
+    /// full and Pop fails when it is empty.
+    /// \tparam T Element type, which must be default constructible and move
+    /// assignable.
+    template <typename T>
+    class SpscRing
+    {
+      /// \brief Constructor
+      /// \param[in] _capacity Maximum number of elements in the ring.
+      public: explicit SpscRing(std::size_t _capacity)
+        : slots(_capacity + 1u)
+      {
+      }
+
+      /// \brief Add an element. Must only be called by the producer.
+      /// \param[in] _value Element to add.
+      /// \return False if the ring is full, in which case _value is not
+      /// added.
+      public: bool Push(T _value)
+      {
+        const std::size_t index = this->tail.load(std::memory_order_relaxed);
+        const std::size_t next = this->Next(index);
+        if (next == this->head.load(std::memory_order_acquire))
+          return false;
+
+        this->slots[index] = std::move(_value);
+        this->tail.store(next, std::memory_order_seq_cst);
+        return true;
+      }
+
+      /// \brief Remove the oldest element. Must only be called by the
+      /// consumer.
+      /// \param[out] _value The removed element.
+      /// \return False if the ring is empty.
+      public: bool Pop(T &_value)
+      {
+        const std::size_t index = this->head.load(std::memory_order_relaxed);
+        if (index == this->tail.load(std::memory_order_seq_cst))
+          return false;
+
+        _value = std::move(this->slots[index]);
+        this->head.store(this->Next(index), std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Whether the ring is empty. Exact when called by the consumer,
+      /// a snapshot otherwise.
+      /// \return True if there are no elements.
+      public: bool Empty() const
+      {
+        return this->head.load(std::memory_order_acquire) ==
+            this->tail.load(std::memory_order_seq_cst);
+      }
+
+      /// \brief Get the maximum number of elements.
+      /// \return Capacity.
+      public: std::size_t Capacity() const
+      {
+        return this->slots.size() - 1u;
+      }
+
+      /// \brief Get the slot after the given one.
+      /// \param[in] _index Slot index.
+      /// \return Next slot index.
+      private: std::size_t Next(std::size_t _index) const
+      {
+        return _index + 1u == this->slots.size() ? 0u : _index + 1u;
+      }
+
+      /// \brief Element storage. One slot is always free, to tell a full
+      /// ring from an empty one.
+      private: std::vector<T> slots;
+
+      /// \brief Index of the oldest element, written by the consumer.
+      private: alignas(64) std::atomic<std::size_t> head{0u};
+
+      /// \brief Index of the next free slot, written by the producer.
+      private: alignas(64) std::atomic<std::size_t> tail{0u};
+    };
+    }
+  }
+}
+#endif
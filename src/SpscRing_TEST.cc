@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "SpscRing.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, PushPop)
+{
+  SpscRing<int> ring(3u);
+  EXPECT_EQ(3u, ring.Capacity());
+  EXPECT_TRUE(ring.Empty());
+
+  int value{0};
+  EXPECT_FALSE(ring.Pop(value));
+
+  EXPECT_TRUE(ring.Push(1));
+  EXPECT_TRUE(ring.Push(2));
+  EXPECT_TRUE(ring.Push(3));
+  EXPECT_FALSE(ring.Push(4));
+  EXPECT_FALSE(ring.Empty());
+
+  ASSERT_TRUE(ring.Pop(value));
+  EXPECT_EQ(1, value);
+
+  // Freed slots are reused, in order
+  EXPECT_TRUE(ring.Push(5));
+  for (int expected : {2, 3, 5})
+  {
+    ASSERT_TRUE(ring.Pop(value));
+    EXPECT_EQ(expected, value);
+  }
+  EXPECT_TRUE(ring.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingTest, Threads)
+{
+  SpscRing<uint64_t> ring(16u);
+  const uint64_t count{100000u};
+
+  std::thread consumer([&]
+  {
+    uint64_t expected{0u};
+    uint64_t value{0u};
+    while (expected < count)
+    {
+      if (!ring.Pop(value))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+      EXPECT_EQ(expected, value);
+      ++expected;
+    }
+  });
+
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    while (!ring.Push(i))
+      std::this_thread::yield();
+  }
+
+  consumer.join();
+  EXPECT_TRUE(ring.Empty());
+}
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/StartupTrace.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+#include "JsonString.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Number of slowest events listed in the summary.
+static constexpr std::size_t kSummaryEvents{10u};
+
+namespace
+{
+/// \brief An event of the trace.
+struct TraceEvent
+{
+  /// \brief Phase of the event.
+  std::string phase;
+
+  /// \brief Name of the element handled during the event.
+  std::string name;
+
+  /// \brief Thread which added the event.
+  unsigned int thread;
+
+  /// \brief Start time.
+  std::chrono::steady_clock::time_point start;
+
+  /// \brief End time.
+  std::chrono::steady_clock::time_point end;
+};
+
+/// \brief Total time of a phase.
+struct TracePhase
+{
+  /// \brief Name of the phase.
+  std::string phase;
+
+  /// \brief Number of events.
+  std::size_t count{0u};
+
+  /// \brief Total duration of the events.
+  std::chrono::steady_clock::duration total{0};
+};
+}
+
+class ignition::gazebo::StartupTracePrivate
+{
+  /// \brief Stop the trace, then write it and print its summary.
+  public: void Complete();
+
+  /// \brief Get the total time of each phase, in order of first event.
+  /// Must be called with the mutex held.
+  /// \return Phases.
+  public: std::vector<TracePhase> Phases() const;
+
+  /// \brief Get the time elapsed since the start of the trace.
+  /// Must be called with the mutex held.
+  /// \param[in] _time Time point.
+  /// \return Milliseconds since the start.
+  public: double Ms(const std::chrono::steady_clock::time_point &_time) const;
+
+  /// \brief Protects everything but `active`.
+  public: mutable std::mutex mutex;
+
+  /// \brief Whether a trace is running. Checked without the mutex, so that
+  /// scopes are cheap when there's no trace.
+  public: std::atomic<bool> active{false};
+
+  /// \brief Time at which the trace started.
+  public: std::chrono::steady_clock::time_point origin;
+
+  /// \brief Time at which the trace completed, or origin while running.
+  public: std::chrono::steady_clock::time_point end;
+
+  /// \brief Events, in the order they were added.
+  public: std::vector<TraceEvent> events;
+
+  /// \brief Index of each thread which added an event.
+  public: std::unordered_map<std::thread::id, unsigned int> threads;
+
+  /// \brief Number of holds not released yet.
+  public: unsigned int holds{0u};
+
+  /// \brief Whether Finish was called.
+  public: bool finishRequested{false};
+
+  /// \brief Path given to Finish.
+  public: std::string path;
+};
+
+//////////////////////////////////////////////////
+StartupTrace::Scope::Scope(const char *_phase, const std::string &_name)
+{
+  if (!StartupTrace::Instance().Active())
+    return;
+
+  this->phase = _phase;
+  this->name = _name;
+  this->start = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+StartupTrace::Scope::~Scope()
+{
+  if (nullptr == this->phase)
+    return;
+
+  StartupTrace::Instance().Add(this->phase, this->name, this->start,
+      std::chrono::steady_clock::now());
+}
+
+//////////////////////////////////////////////////
+StartupTrace &StartupTrace::Instance()
+{
+  static StartupTrace trace;
+  return trace;
+}
+
+//////////////////////////////////////////////////
+StartupTrace::StartupTrace()
+  : dataPtr(std::make_unique<StartupTracePrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+StartupTrace::~StartupTrace() = default;
+
+//////////////////////////////////////////////////
+void StartupTrace::Start()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->origin = std::chrono::steady_clock::now();
+  this->dataPtr->end = this->dataPtr->origin;
+  this->dataPtr->events.clear();
+  this->dataPtr->threads.clear();
+  this->dataPtr->holds = 0u;
+  this->dataPtr->finishRequested = false;
+  this->dataPtr->path.clear();
+  this->dataPtr->active = true;
+}
+
+//////////////////////////////////////////////////
+bool StartupTrace::Active() const
+{
+  return this->dataPtr->active;
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Add(const std::string &_phase, const std::string &_name,
+    const std::chrono::steady_clock::time_point &_start,
+    const std::chrono::steady_clock::time_point &_end)
+{
+  if (!this->dataPtr->active)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->active)
+    return;
+
+  auto &threads = this->dataPtr->threads;
+  const auto thread = threads.emplace(std::this_thread::get_id(),
+      static_cast<unsigned int>(threads.size())).first->second;
+  this->dataPtr->events.push_back({_phase, _name, thread, _start, _end});
+}
+
+//////////////////////////////////////////////////
+bool StartupTrace::Hold()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->active)
+    return false;
+
+  ++this->dataPtr->holds;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Release()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->holds == 0u)
+      return;
+    if (--this->dataPtr->holds > 0u || !this->dataPtr->finishRequested)
+      return;
+  }
+  this->dataPtr->Complete();
+}
+
+//////////////////////////////////////////////////
+void StartupTrace::Finish(const std::string &_path)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->active || this->dataPtr->finishRequested)
+      return;
+    this->dataPtr->finishRequested = true;
+    this->dataPtr->path = _path;
+    if (this->dataPtr->holds > 0u)
+      return;
+  }
+  this->dataPtr->Complete();
+}
+
+//////////////////////////////////////////////////
+void StartupTracePrivate::Complete()
+{
+  std::string tracePath;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->active)
+      return;
+    this->active = false;
+    this->end = std::chrono::steady_clock::now();
+    tracePath = this->path;
+  }
+
+  auto &trace = StartupTrace::Instance();
+  if (!tracePath.empty())
+  {
+    std::ofstream file(tracePath);
+    file << trace.Json();
+    if (file.good())
+      ignmsg << "Wrote startup trace [" << tracePath << "].\n";
+    else
+      ignerr << "Failed to write startup trace [" << tracePath << "].\n";
+  }
+
+  igndbg << trace.Summary();
+}
+
+//////////////////////////////////////////////////
+std::vector<TracePhase> StartupTracePrivate::Phases() const
+{
+  std::vector<TracePhase> phases;
+  std::unordered_map<std::string, std::size_t> indices;
+  for (const auto &event : this->events)
+  {
+    auto it = indices.emplace(event.phase, phases.size()).first;
+    if (it->second == phases.size())
+      phases.push_back({event.phase});
+
+    auto &phase = phases[it->second];
+    ++phase.count;
+    phase.total += event.end - event.start;
+  }
+  return phases;
+}
+
+//////////////////////////////////////////////////
+double StartupTracePrivate::Ms(
+    const std::chrono::steady_clock::time_point &_time) const
+{
+  return std::chrono::duration<double, std::milli>(
+      _time - this->origin).count();
+}
+
+//////////////////////////////////////////////////
+std::string StartupTrace::Json() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const auto end = this->dataPtr->active ?
+      std::chrono::steady_clock::now() : this->dataPtr->end;
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"total_ms\": " << this->dataPtr->Ms(end) << ",\n";
+
+  out << "  \"phases\": [";
+  const auto phases = this->dataPtr->Phases();
+  for (std::size_t i = 0; i < phases.size(); ++i)
+  {
+    out << (i == 0u ? "\n" : ",\n") << "    {\"phase\": "
+        << jsonString(phases[i].phase) << ", \"count\": " << phases[i].count
+        << ", \"total_ms\": " << std::chrono::duration<double, std::milli>(
+        phases[i].total).count() << "}";
+  }
+  out << (phases.empty() ? "],\n" : "\n  ],\n");
+
+  out << "  \"events\": [";
+  const auto &events = this->dataPtr->events;
+  for (std::size_t i = 0; i < events.size(); ++i)
+  {
+    const auto &event = events[i];
+    out << (i == 0u ? "\n" : ",\n") << "    {\"phase\": "
+        << jsonString(event.phase) << ", \"name\": "
+        << jsonString(event.name) << ", \"thread\": " << event.thread
+        << ", \"start_ms\": " << this->dataPtr->Ms(event.start)
+        << ", \"duration_ms\": " << std::chrono::duration<double,
+        std::milli>(event.end - event.start).count() << "}";
+  }
+  out << (events.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+std::string StartupTrace::Summary() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const auto end = this->dataPtr->active ?
+      std::chrono::steady_clock::now() : this->dataPtr->end;
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1);
+  out << "Startup took " << this->dataPtr->Ms(end) << " ms\n";
+  for (const auto &phase : this->dataPtr->Phases())
+  {
+    out << "  " << phase.phase << ": " << std::chrono::duration<double,
+        std::milli>(phase.total).count() << " ms (" << phase.count << ")\n";
+  }
+
+  std::vector<const TraceEvent *> named;
+  for (const auto &event : this->dataPtr->events)
+  {
+    if (!event.name.empty())
+      named.push_back(&event);
+  }
+  const auto count = std::min(named.size(), kSummaryEvents);
+  std::partial_sort(named.begin(), named.begin() + count, named.end(),
+      [](const TraceEvent *_a, const TraceEvent *_b)
+      {
+        return _a->end - _a->start > _b->end - _b->start;
+      });
+  if (count > 0u)
+    out << "Slowest:\n";
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    out << "  " << named[i]->phase << " [" << named[i]->name << "]: "
+        << std::chrono::duration<double, std::milli>(
+        named[i]->end - named[i]->start).count() << " ms\n";
+  }
+  return out.str();
+}
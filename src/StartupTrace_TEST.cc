@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "ignition/gazebo/StartupTrace.hh"
+#include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(StartupTraceTest, Inactive)
+{
+  auto &trace = StartupTrace::Instance();
+  trace.Start();
+  trace.Finish("");
+  EXPECT_FALSE(trace.Active());
+
+  // Events are ignored while no trace is running
+  {
+    StartupTrace::Scope scope("ignored", "model");
+  }
+  EXPECT_FALSE(trace.Hold());
+  EXPECT_EQ(std::string::npos, trace.Json().find("ignored"));
+}
+
+/////////////////////////////////////////////////
+TEST(StartupTraceTest, Events)
+{
+  auto &trace = StartupTrace::Instance();
+  trace.Start();
+  EXPECT_TRUE(trace.Active());
+
+  {
+    StartupTrace::Scope load("sdf_load");
+    StartupTrace::Scope model("model", "box_\"1\"");
+  }
+  {
+    StartupTrace::Scope model("model", "sphere");
+  }
+
+  const auto json = trace.Json();
+  EXPECT_NE(std::string::npos, json.find("\"total_ms\": "));
+  EXPECT_NE(std::string::npos,
+      json.find("{\"phase\": \"sdf_load\", \"count\": 1, "));
+  EXPECT_NE(std::string::npos,
+      json.find("{\"phase\": \"model\", \"count\": 2, "));
+  EXPECT_NE(std::string::npos, json.find("\"name\": \"box_\\\"1\\\"\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\": \"sphere\""));
+
+  // Phases are listed in order of first event, which is the first to end
+  EXPECT_LT(json.find("\"phase\": \"model\""),
+      json.find("\"phase\": \"sdf_load\""));
+
+  const auto summary = trace.Summary();
+  EXPECT_NE(std::string::npos, summary.find("Startup took "));
+  EXPECT_NE(std::string::npos, summary.find("  model: "));
+  EXPECT_NE(std::string::npos, summary.find("model [sphere]: "));
+  EXPECT_EQ(std::string::npos, summary.find("sdf_load ["));
+
+  trace.Finish("");
+  EXPECT_FALSE(trace.Active());
+}
+
+/////////////////////////////////////////////////
+TEST(StartupTraceTest, HoldAndWrite)
+{
+  const std::string path = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_startup_trace.json");
+  common::removeFile(path);
+
+  auto &trace = StartupTrace::Instance();
+  trace.Start();
+  ASSERT_TRUE(trace.Hold());
+
+  // Finishing waits for the hold
+  trace.Finish(path);
+  EXPECT_TRUE(trace.Active());
+  EXPECT_FALSE(common::exists(path));
+
+  {
+    StartupTrace::Scope scope("render_scene");
+  }
+
+  trace.Release();
+  EXPECT_FALSE(trace.Active());
+  ASSERT_TRUE(common::exists(path));
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  EXPECT_EQ(trace.Json(), contents.str());
+  EXPECT_NE(std::string::npos, contents.str().find("render_scene"));
+}
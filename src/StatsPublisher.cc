@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StatsPublisher.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/Helpers.hh>
+
+#include "SpscRing.hh"
+
+/// \brief Number of snapshots over which the real time factor is averaged.
+static constexpr std::size_t kRtfWindow{20u};
+
+class ignition::gazebo::StatsPublisherPrivate
+{
+  /// \brief Constructor
+  /// \param[in] _publish Publish callback.
+  /// \param[in] _capacity Ring capacity.
+  public: StatsPublisherPrivate(StatsPublisher::PublishCallback _publish,
+              std::size_t _capacity)
+    : publish(std::move(_publish)), ring(_capacity)
+  {
+  }
+
+  /// \brief Main loop of the publisher thread.
+  public: void Run();
+
+  /// \brief Update the real time factor with a snapshot.
+  /// \param[in] _snapshot Snapshot.
+  public: void UpdateRtf(const StatsSnapshot &_snapshot);
+
+  /// \brief Publish callback.
+  public: StatsPublisher::PublishCallback publish;
+
+  /// \brief Snapshots waiting to be published.
+  public: SpscRing<StatsSnapshot> ring;
+
+  /// \brief Publisher thread.
+  public: std::thread thread;
+
+  /// \brief Only used to sleep and wake up the threads.
+  public: std::mutex mutex;
+
+  /// \brief Wakes up the publisher thread.
+  public: std::condition_variable wakeCv;
+
+  /// \brief Signals that the ring has been drained.
+  public: std::condition_variable drainedCv;
+
+  /// \brief Whether the publisher thread is waiting on wakeCv. The
+  /// producer only takes the mutex to wake it up in that case.
+  public: std::atomic<bool> waiting{false};
+
+  /// \brief Set to stop the publisher thread.
+  public: bool stop{false};
+
+  /// \brief Number of snapshots pushed. Only used by the producer.
+  public: uint64_t pushed{0u};
+
+  /// \brief Number of snapshots published.
+  public: std::atomic<uint64_t> published{0u};
+
+  /// \brief Number of snapshots dropped.
+  public: std::atomic<uint64_t> dropped{0u};
+
+  /// \brief Recent simulation times. Only used by the publisher thread.
+  public: std::deque<std::chrono::steady_clock::duration> simTimes;
+
+  /// \brief Recent real times. Only used by the publisher thread.
+  public: std::deque<std::chrono::steady_clock::duration> realTimes;
+
+  /// \brief Current real time factor. Only used by the publisher thread.
+  public: double rtf{0.0};
+};
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+StatsPublisher::StatsPublisher(PublishCallback _publish,
+    std::size_t _capacity)
+  : dataPtr(std::make_unique<StatsPublisherPrivate>(std::move(_publish),
+        _capacity))
+{
+}
+
+//////////////////////////////////////////////////
+StatsPublisher::~StatsPublisher()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->wakeCv.notify_one();
+  this->dataPtr->thread.join();
+}
+
+//////////////////////////////////////////////////
+bool StatsPublisher::Push(const StatsSnapshot &_snapshot)
+{
+  if (!this->dataPtr->thread.joinable())
+  {
+    this->dataPtr->thread =
+        std::thread(&StatsPublisherPrivate::Run, this->dataPtr.get());
+  }
+
+  if (!this->dataPtr->ring.Push(_snapshot))
+  {
+    ++this->dataPtr->dropped;
+    return false;
+  }
+  ++this->dataPtr->pushed;
+
+  // Either the publisher thread sees the new snapshot before it sleeps, or
+  // it is sleeping and needs to be woken up
+  if (this->dataPtr->waiting)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    }
+    this->dataPtr->wakeCv.notify_one();
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void StatsPublisher::Flush()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->drainedCv.wait(lock, [this]
+  {
+    return this->dataPtr->published == this->dataPtr->pushed;
+  });
+}
+
+//////////////////////////////////////////////////
+uint64_t StatsPublisher::DroppedCount() const
+{
+  return this->dataPtr->dropped;
+}
+
+//////////////////////////////////////////////////
+void StatsPublisher::FillMsgs(const StatsSnapshot &_snapshot, double _rtf,
+    msgs::WorldStatistics &_stats, msgs::Clock &_clock)
+{
+  _stats.set_real_time_factor(_rtf);
+
+  auto realTimeSecNsec = math::durationToSecNsec(_snapshot.realTime);
+  auto simTimeSecNsec = math::durationToSecNsec(_snapshot.simTime);
+
+  _stats.mutable_real_time()->set_sec(realTimeSecNsec.first);
+  _stats.mutable_real_time()->set_nsec(realTimeSecNsec.second);
+
+  _stats.mutable_sim_time()->set_sec(simTimeSecNsec.first);
+  _stats.mutable_sim_time()->set_nsec(simTimeSecNsec.second);
+
+  _stats.set_iterations(_snapshot.iterations);
+
+  _stats.set_paused(_snapshot.paused);
+
+  if (_snapshot.stepping)
+  {
+    auto headerData = _stats.mutable_header()->add_data();
+    headerData->set_key("step");
+  }
+
+  // Wall time spent in each phase during the last step. See the
+  // system_stats topic for each system's share.
+  const std::array<const char *, 3> phaseKeys{
+      "pre_update_us", "update_us", "post_update_us"};
+  for (std::size_t i = 0; i < phaseKeys.size(); ++i)
+  {
+    auto headerData = _stats.mutable_header()->add_data();
+    headerData->set_key(phaseKeys[i]);
+    headerData->add_value(std::to_string(
+        std::chrono::duration<double, std::micro>(
+        _snapshot.phaseTimes[i]).count()));
+  }
+
+  // Real time deadlines of paced steps
+  const auto &deadlines = _snapshot.deadlines;
+  if (deadlines.steps > 0u)
+  {
+    auto addHeader = [&_stats](const std::string &_key)
+    {
+      auto headerData = _stats.mutable_header()->add_data();
+      headerData->set_key(_key);
+      return headerData;
+    };
+
+    addHeader("timed_steps")->add_value(std::to_string(deadlines.steps));
+    addHeader("deadline_misses")->add_value(
+        std::to_string(deadlines.misses));
+
+    // PreUpdate, Update, PostUpdate and sleep
+    auto phaseMisses = addHeader("deadline_miss_phases");
+    for (const auto count : deadlines.phaseMisses)
+      phaseMisses->add_value(std::to_string(count));
+
+    // Mean, standard deviation and largest overrun
+    auto jitter = addHeader("step_jitter_us");
+    jitter->add_value(std::to_string(deadlines.jitterMeanUs));
+    jitter->add_value(std::to_string(deadlines.jitterStdDevUs));
+    jitter->add_value(std::to_string(
+        std::chrono::duration<double, std::micro>(
+        deadlines.maxOverrun).count()));
+
+    // Buckets bounded by StepDeadlineStats::kBucketBounds
+    auto histogram = addHeader("step_period_histogram");
+    for (const auto count : deadlines.histogram)
+      histogram->add_value(std::to_string(count));
+  }
+
+  auto systemSecNsec = math::durationToSecNsec(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      _snapshot.systemTime.time_since_epoch()));
+
+  _clock.mutable_real()->set_sec(realTimeSecNsec.first);
+  _clock.mutable_real()->set_nsec(realTimeSecNsec.second);
+  _clock.mutable_sim()->set_sec(simTimeSecNsec.first);
+  _clock.mutable_sim()->set_nsec(simTimeSecNsec.second);
+  _clock.mutable_system()->set_sec(systemSecNsec.first);
+  _clock.mutable_system()->set_nsec(systemSecNsec.second);
+}
+
+//////////////////////////////////////////////////
+void StatsPublisherPrivate::UpdateRtf(const StatsSnapshot &_snapshot)
+{
+  if (_snapshot.rtfReset)
+  {
+    this->simTimes.clear();
+    this->realTimes.clear();
+    this->rtf = 0.0;
+  }
+
+  if (!_snapshot.rtfSample)
+    return;
+
+  this->realTimes.push_back(_snapshot.realTime);
+  this->simTimes.push_back(_snapshot.simTime);
+  if (this->realTimes.size() > kRtfWindow)
+  {
+    this->realTimes.pop_front();
+    this->simTimes.pop_front();
+  }
+
+  // Average of the differences with the oldest sample
+  std::chrono::steady_clock::duration simAvg{0}, realAvg{0};
+  for (std::size_t i = 1; i < this->realTimes.size(); ++i)
+  {
+    simAvg += this->simTimes[i] - this->simTimes.front();
+    realAvg += this->realTimes[i] - this->realTimes.front();
+  }
+
+  // The real time count could be zero if simulation was started paused
+  if (realAvg.count() > 0)
+  {
+    this->rtf = math::precision(
+        static_cast<double>(simAvg.count()) / realAvg.count(), 4);
+  }
+}
+
+//////////////////////////////////////////////////
+void StatsPublisherPrivate::Run()
+{
+  IGN_PROFILE_THREAD_NAME("StatsPublisher");
+
+  StatsSnapshot snapshot;
+  while (true)
+  {
+    while (this->ring.Pop(snapshot))
+    {
+      IGN_PROFILE("StatsPublisher::Publish");
+      this->UpdateRtf(snapshot);
+
+      msgs::WorldStatistics stats;
+      msgs::Clock clock;
+      StatsPublisher::FillMsgs(snapshot, this->rtf, stats, clock);
+      this->publish(stats, clock);
+      ++this->published;
+    }
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->drainedCv.notify_all();
+
+    this->waiting = true;
+    this->wakeCv.wait(lock, [this]
+    {
+      return this->stop || !this->ring.Empty();
+    });
+    this->waiting = false;
+
+    if (this->stop && this->ring.Empty())
+      return;
+  }
+}
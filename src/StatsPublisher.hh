@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STATSPUBLISHER_HH_
+#define IGNITION_GAZEBO_STATSPUBLISHER_HH_
+
+#include <ignition/msgs/clock.pb.h>
+#include <ignition/msgs/world_stats.pb.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+#include "StepDeadlineStats.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class StatsPublisherPrivate;
+
+    /// \brief State of the simulation at the end of a step, which is all
+    /// that's needed to build the world statistics and clock messages.
+    struct StatsSnapshot
+    {
+      /// \brief Wall time elapsed while simulation was running.
+      std::chrono::steady_clock::duration realTime{0};
+
+      /// \brief Simulation time.
+      std::chrono::steady_clock::duration simTime{0};
+
+      /// \brief Wall clock time at which the snapshot was taken.
+      std::chrono::system_clock::time_point systemTime;
+
+      /// \brief Number of iterations.
+      uint64_t iterations{0u};
+
+      /// \brief Whether simulation is paused.
+      bool paused{false};
+
+      /// \brief Whether simulation is being stepped.
+      bool stepping{false};
+
+      /// \brief Whether the times of this snapshot are used to compute the
+      /// real time factor. False while the wall clock isn't running.
+      bool rtfSample{false};
+
+      /// \brief Whether the real time factor must be computed anew from this
+      /// snapshot on, for example after a time jump.
+      bool rtfReset{false};
+
+      /// \brief Wall time of the PreUpdate, Update and PostUpdate phases of
+      /// the last step.
+      std::array<std::chrono::steady_clock::duration, 3> phaseTimes{};
+
+      /// \brief Deadline statistics of the steps so far. Left empty when
+      /// steps aren't paced, such as in throughput mode.
+      StepDeadlineStats::Summary deadlines;
+    };
+
+    /// \class StatsPublisher StatsPublisher.hh
+    /// \brief Builds and publishes the world statistics and clock messages
+    /// on a thread of its own, so that message serialization and transport
+    /// don't add to the duration of simulation steps.
+    ///
+    /// The simulation thread pushes snapshots to a lock-free single producer
+    /// ring, which the publisher thread drains in order. The real time factor
+    /// is also computed on the publisher thread, as an average over the last
+    /// snapshots. The thread is started by the first push.
+    ///
+    /// Push and Flush must always be called from the same thread.
+    class IGNITION_GAZEBO_VISIBLE StatsPublisher
+    {
+      /// \brief Function which publishes the messages of a snapshot.
+      public: using PublishCallback = std::function<void(
+                  const msgs::WorldStatistics &, const msgs::Clock &)>;
+
+      /// \brief Constructor
+      /// \param[in] _publish Called on the publisher thread with the messages
+      /// of each snapshot.
+      /// \param[in] _capacity Number of snapshots which can wait to be
+      /// published.
+      public: explicit StatsPublisher(PublishCallback _publish,
+                  std::size_t _capacity = 256u);
+
+      /// \brief Destructor. Publishes the remaining snapshots, then stops the
+      /// publisher thread.
+      public: ~StatsPublisher();
+
+      /// \brief Queue a snapshot to be published. Doesn't block.
+      /// \param[in] _snapshot Snapshot.
+      /// \return False if the ring was full and the snapshot was dropped.
+      public: bool Push(const StatsSnapshot &_snapshot);
+
+      /// \brief Block until all pushed snapshots have been published.
+      public: void Flush();
+
+      /// \brief Get the number of snapshots dropped because the publisher
+      /// thread couldn't keep up.
+      /// \return Number of dropped snapshots.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Fill the messages of a snapshot.
+      /// \param[in] _snapshot Snapshot.
+      /// \param[in] _rtf Real time factor.
+      /// \param[out] _stats World statistics message.
+      /// \param[out] _clock Clock message.
+      public: static void FillMsgs(const StatsSnapshot &_snapshot,
+                  double _rtf, msgs::WorldStatistics &_stats,
+                  msgs::Clock &_clock);
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<StatsPublisherPrivate> dataPtr;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "StatsPublisher.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+TEST(StatsPublisherTest, FillMsgs)
+{
+  StatsSnapshot snapshot;
+  snapshot.realTime = 2500ms;
+  snapshot.simTime = 1250ms;
+  snapshot.systemTime = std::chrono::system_clock::time_point(3s);
+  snapshot.iterations = 125u;
+  snapshot.paused = true;
+  snapshot.stepping = true;
+  snapshot.phaseTimes = {10us, 20us, 30us};
+
+  msgs::WorldStatistics stats;
+  msgs::Clock clock;
+  StatsPublisher::FillMsgs(snapshot, 0.5, stats, clock);
+
+  EXPECT_DOUBLE_EQ(0.5, stats.real_time_factor());
+  EXPECT_EQ(2, stats.real_time().sec());
+  EXPECT_EQ(500000000, stats.real_time().nsec());
+  EXPECT_EQ(1, stats.sim_time().sec());
+  EXPECT_EQ(250000000, stats.sim_time().nsec());
+  EXPECT_EQ(125u, stats.iterations());
+  EXPECT_TRUE(stats.paused());
+
+  ASSERT_EQ(4, stats.header().data_size());
+  EXPECT_EQ("step", stats.header().data(0).key());
+  EXPECT_EQ("pre_update_us", stats.header().data(1).key());
+  EXPECT_EQ("update_us", stats.header().data(2).key());
+  EXPECT_EQ("post_update_us", stats.header().data(3).key());
+  ASSERT_EQ(1, stats.header().data(3).value_size());
+  EXPECT_DOUBLE_EQ(30.0, std::stod(stats.header().data(3).value(0)));
+
+  EXPECT_EQ(2, clock.real().sec());
+  EXPECT_EQ(1, clock.sim().sec());
+  EXPECT_EQ(250000000, clock.sim().nsec());
+  EXPECT_EQ(3, clock.system().sec());
+  EXPECT_EQ(0, clock.system().nsec());
+}
+
+/////////////////////////////////////////////////
+TEST(StatsPublisherTest, FillDeadlineMsgs)
+{
+  StatsSnapshot snapshot;
+  snapshot.deadlines.steps = 10u;
+  snapshot.deadlines.misses = 3u;
+  snapshot.deadlines.phaseMisses = {0u, 2u, 0u, 1u};
+  snapshot.deadlines.histogram = {1u, 4u, 2u, 1u, 1u, 1u, 0u};
+  snapshot.deadlines.jitterMeanUs = 12.5;
+  snapshot.deadlines.maxOverrun = 250us;
+
+  msgs::WorldStatistics stats;
+  msgs::Clock clock;
+  StatsPublisher::FillMsgs(snapshot, 1.0, stats, clock);
+
+  // Phase times, then deadlines
+  ASSERT_EQ(8, stats.header().data_size());
+  EXPECT_EQ("timed_steps", stats.header().data(3).key());
+  EXPECT_EQ("10", stats.header().data(3).value(0));
+  EXPECT_EQ("deadline_misses", stats.header().data(4).key());
+  EXPECT_EQ("3", stats.header().data(4).value(0));
+
+  const auto &phases = stats.header().data(5);
+  EXPECT_EQ("deadline_miss_phases", phases.key());
+  ASSERT_EQ(4, phases.value_size());
+  EXPECT_EQ("2", phases.value(1));
+  EXPECT_EQ("1", phases.value(3));
+
+  const auto &jitter = stats.header().data(6);
+  EXPECT_EQ("step_jitter_us", jitter.key());
+  ASSERT_EQ(3, jitter.value_size());
+  EXPECT_DOUBLE_EQ(12.5, std::stod(jitter.value(0)));
+  EXPECT_DOUBLE_EQ(250.0, std::stod(jitter.value(2)));
+
+  const auto &histogram = stats.header().data(7);
+  EXPECT_EQ("step_period_histogram", histogram.key());
+  ASSERT_EQ(static_cast<int>(StepDeadlineStats::kBucketCount),
+      histogram.value_size());
+  EXPECT_EQ("4", histogram.value(1));
+}
+
+/////////////////////////////////////////////////
+TEST(StatsPublisherTest, PublishInOrder)
+{
+  std::mutex mutex;
+  std::vector<msgs::WorldStatistics> published;
+  std::thread::id publisherThread;
+  StatsPublisher publisher(
+      [&](const msgs::WorldStatistics &_stats, const msgs::Clock &)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        published.push_back(_stats);
+        publisherThread = std::this_thread::get_id();
+      });
+
+  // Flushing before anything was pushed doesn't block
+  publisher.Flush();
+
+  // Simulation runs twice as fast as real time
+  StatsSnapshot snapshot;
+  snapshot.rtfSample = true;
+  for (uint64_t i = 1u; i <= 50u; ++i)
+  {
+    snapshot.iterations = i;
+    snapshot.simTime = i * 2ms;
+    snapshot.realTime = i * 1ms;
+    EXPECT_TRUE(publisher.Push(snapshot));
+  }
+  publisher.Flush();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(50u, published.size());
+    for (uint64_t i = 0u; i < published.size(); ++i)
+      EXPECT_EQ(i + 1u, published[i].iterations());
+    EXPECT_DOUBLE_EQ(0.0, published[0].real_time_factor());
+    EXPECT_DOUBLE_EQ(2.0, published.back().real_time_factor());
+    EXPECT_NE(std::this_thread::get_id(), publisherThread);
+  }
+
+  // A reset starts the average anew
+  snapshot.rtfReset = true;
+  snapshot.iterations = 51u;
+  EXPECT_TRUE(publisher.Push(snapshot));
+  publisher.Flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(51u, published.size());
+    EXPECT_DOUBLE_EQ(0.0, published.back().real_time_factor());
+  }
+  EXPECT_EQ(0u, publisher.DroppedCount());
+}
+
+/////////////////////////////////////////////////
+TEST(StatsPublisherTest, DropWhenFull)
+{
+  std::mutex blockMutex;
+  std::unique_lock<std::mutex> block(blockMutex);
+  uint64_t count{0u};
+  {
+    StatsPublisher publisher(
+        [&](const msgs::WorldStatistics &, const msgs::Clock &)
+        {
+          std::lock_guard<std::mutex> lock(blockMutex);
+          ++count;
+        }, 2u);
+
+    // The first snapshot is popped and blocks the publisher thread, so the
+    // ring fills up
+    StatsSnapshot snapshot;
+    uint64_t pushed{0u};
+    for (int i = 0; i < 10; ++i)
+    {
+      if (publisher.Push(snapshot))
+        ++pushed;
+      std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_LE(pushed, 3u);
+    EXPECT_EQ(10u - pushed, publisher.DroppedCount());
+
+    // Flushing publishes what's left
+    block.unlock();
+    publisher.Flush();
+    EXPECT_EQ(pushed, count);
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "StepDeadlineStats.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ignition;
+using namespace gazebo;
+
+//////////////////////////////////////////////////
+StepDeadlineStats::StepDeadlineStats(double _tolerance)
+  : tolerance(std::max(0.0, _tolerance))
+{
+}
+
+//////////////////////////////////////////////////
+bool StepDeadlineStats::Add(std::chrono::steady_clock::duration _period,
+    std::chrono::steady_clock::duration _wallTime,
+    const std::array<std::chrono::steady_clock::duration, 3> &_phaseTimes,
+    bool _slept)
+{
+  if (_period <= std::chrono::steady_clock::duration::zero())
+    return false;
+
+  auto &s = this->summary;
+  ++s.steps;
+
+  const double ratio = static_cast<double>(_wallTime.count()) /
+      static_cast<double>(_period.count());
+  const auto bucket = std::lower_bound(kBucketBounds.begin(),
+      kBucketBounds.end(), ratio) - kBucketBounds.begin();
+  ++s.histogram[static_cast<std::size_t>(bucket)];
+
+  // Welford's algorithm
+  const double jitter =
+      std::chrono::duration<double, std::micro>(_wallTime - _period).count();
+  const double delta = jitter - s.jitterMeanUs;
+  s.jitterMeanUs += delta / static_cast<double>(s.steps);
+  this->jitterM2 += delta * (jitter - s.jitterMeanUs);
+  s.jitterStdDevUs = std::sqrt(this->jitterM2 / static_cast<double>(s.steps));
+
+  s.maxOverrun = std::max(s.maxOverrun, _wallTime - _period);
+
+  if (ratio <= 1.0 + this->tolerance)
+    return false;
+
+  ++s.misses;
+  Phase phase{Phase::SLEEP};
+  if (!_slept)
+  {
+    const auto longest =
+        std::max_element(_phaseTimes.begin(), _phaseTimes.end());
+    phase = static_cast<Phase>(longest - _phaseTimes.begin());
+  }
+  ++s.phaseMisses[static_cast<std::size_t>(phase)];
+  return true;
+}
+
+//////////////////////////////////////////////////
+const StepDeadlineStats::Summary &StepDeadlineStats::Stats() const
+{
+  return this->summary;
+}
+
+//////////////////////////////////////////////////
+void StepDeadlineStats::Reset()
+{
+  this->summary = Summary();
+  this->jitterM2 = 0.0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_STEPDEADLINESTATS_HH_
+#define IGNITION_GAZEBO_STEPDEADLINESTATS_HH_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class StepDeadlineStats StepDeadlineStats.hh
+    /// \brief Statistics of the wall time of simulation steps compared to
+    /// the period which keeps the desired real time factor.
+    ///
+    /// A step's wall time goes from the start of its update to the start of
+    /// the next step's update, sleep included. A step misses its deadline
+    /// when it takes longer than the target period plus a tolerance. Each
+    /// miss is attributed to the phase which overran: if the runner had to
+    /// sleep, the systems fit in the budget and the sleep overshot, otherwise
+    /// the phase with the longest wall time is blamed.
+    class IGNITION_GAZEBO_VISIBLE StepDeadlineStats
+    {
+      /// \brief Phases a deadline miss can be attributed to.
+      public: enum class Phase
+      {
+        /// \brief PreUpdate
+        PRE_UPDATE = 0,
+        /// \brief Update
+        UPDATE = 1,
+        /// \brief PostUpdate
+        POST_UPDATE = 2,
+        /// \brief Sleep between steps
+        SLEEP = 3,
+      };
+
+      /// \brief Number of phases.
+      public: static constexpr std::size_t kPhaseCount{4u};
+
+      /// \brief Upper bounds of the histogram buckets, as ratios of a step's
+      /// wall time to the target period. The last bucket holds the steps
+      /// above the last bound.
+      public: static constexpr std::array<double, 6> kBucketBounds{
+                  {0.9, 1.0, 1.1, 1.25, 1.5, 2.0}};
+
+      /// \brief Number of histogram buckets.
+      public: static constexpr std::size_t kBucketCount{
+                  kBucketBounds.size() + 1u};
+
+      /// \brief Statistics of all steps recorded so far.
+      public: struct Summary
+      {
+        /// \brief Number of steps.
+        uint64_t steps{0u};
+
+        /// \brief Number of steps which missed their deadline.
+        uint64_t misses{0u};
+
+        /// \brief Number of misses attributed to each phase.
+        std::array<uint64_t, kPhaseCount> phaseMisses{};
+
+        /// \brief Number of steps in each histogram bucket.
+        std::array<uint64_t, kBucketCount> histogram{};
+
+        /// \brief Mean difference between a step's wall time and the target
+        /// period, in microseconds. Negative if steps are early.
+        double jitterMeanUs{0.0};
+
+        /// \brief Standard deviation of the difference between a step's
+        /// wall time and the target period, in microseconds.
+        double jitterStdDevUs{0.0};
+
+        /// \brief Longest time a step took past the target period.
+        std::chrono::steady_clock::duration maxOverrun{0};
+      };
+
+      /// \brief Constructor
+      /// \param[in] _tolerance Fraction of the target period a step may
+      /// overrun before it counts as a deadline miss.
+      public: explicit StepDeadlineStats(double _tolerance = 0.1);
+
+      /// \brief Record a step.
+      /// \param[in] _period Target period.
+      /// \param[in] _wallTime Wall time of the step, sleep included.
+      /// \param[in] _phaseTimes Wall time of the PreUpdate, Update and
+      /// PostUpdate phases of the step.
+      /// \param[in] _slept Whether the runner slept before the next step.
+      /// \return True if the step missed its deadline.
+      public: bool Add(std::chrono::steady_clock::duration _period,
+                  std::chrono::steady_clock::duration _wallTime,
+                  const std::array<std::chrono::steady_clock::duration, 3>
+                  &_phaseTimes, bool _slept);
+
+      /// \brief Get the statistics of the steps recorded so far.
+      /// \return Statistics.
+      public: const Summary &Stats() const;
+
+      /// \brief Forget all recorded steps.
+      public: void Reset();
+
+      /// \brief Fraction of the period a step may overrun.
+      private: double tolerance;
+
+      /// \brief Statistics so far.
+      private: Summary summary;
+
+      /// \brief Sum of squared differences from the mean jitter, used to
+      /// compute the standard deviation incrementally.
+      private: double jitterM2{0.0};
+    };
+    }
+  }
+}
+#endif
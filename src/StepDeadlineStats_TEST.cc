@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "StepDeadlineStats.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+using Phase = StepDeadlineStats::Phase;
+
+/////////////////////////////////////////////////
+TEST(StepDeadlineStatsTest, Empty)
+{
+  StepDeadlineStats stats;
+  EXPECT_EQ(0u, stats.Stats().steps);
+  EXPECT_EQ(0u, stats.Stats().misses);
+  EXPECT_DOUBLE_EQ(0.0, stats.Stats().jitterMeanUs);
+
+  // Steps without a period have no deadline
+  EXPECT_FALSE(stats.Add(0ms, 5ms, {1ms, 1ms, 1ms}, false));
+  EXPECT_EQ(0u, stats.Stats().steps);
+}
+
+/////////////////////////////////////////////////
+TEST(StepDeadlineStatsTest, Misses)
+{
+  StepDeadlineStats stats(0.1);
+
+  // On time, and within the tolerance
+  EXPECT_FALSE(stats.Add(10ms, 10ms, {1ms, 2ms, 1ms}, true));
+  EXPECT_FALSE(stats.Add(10ms, 10500us, {1ms, 2ms, 1ms}, true));
+
+  // The systems fit in the budget, so the sleep overshot
+  EXPECT_TRUE(stats.Add(10ms, 12ms, {1ms, 2ms, 1ms}, true));
+
+  // The longest phase overran
+  EXPECT_TRUE(stats.Add(10ms, 15ms, {1ms, 12ms, 2ms}, false));
+  EXPECT_TRUE(stats.Add(10ms, 30ms, {1ms, 2ms, 25ms}, false));
+  EXPECT_TRUE(stats.Add(10ms, 13ms, {11ms, 1ms, 1ms}, false));
+
+  const auto &summary = stats.Stats();
+  EXPECT_EQ(6u, summary.steps);
+  EXPECT_EQ(4u, summary.misses);
+  EXPECT_EQ(1u, summary.phaseMisses[static_cast<int>(Phase::PRE_UPDATE)]);
+  EXPECT_EQ(1u, summary.phaseMisses[static_cast<int>(Phase::UPDATE)]);
+  EXPECT_EQ(1u, summary.phaseMisses[static_cast<int>(Phase::POST_UPDATE)]);
+  EXPECT_EQ(1u, summary.phaseMisses[static_cast<int>(Phase::SLEEP)]);
+  EXPECT_EQ(20ms, summary.maxOverrun);
+
+  stats.Reset();
+  EXPECT_EQ(0u, stats.Stats().steps);
+  EXPECT_EQ(0u, stats.Stats().misses);
+  EXPECT_EQ(0ms, stats.Stats().maxOverrun);
+}
+
+/////////////////////////////////////////////////
+TEST(StepDeadlineStatsTest, Histogram)
+{
+  StepDeadlineStats stats;
+
+  // Ratios of 0.5, 1.0, 1.05, 1.2, 1.4, 1.8 and 3.0
+  for (const auto wallTime : {5ms, 10ms})
+    stats.Add(10ms, wallTime, {}, true);
+  for (const auto wallTime :
+      {10500us, 12000us, 14000us, 18000us, 30000us})
+  {
+    stats.Add(10ms, wallTime, {}, true);
+  }
+
+  const auto &histogram = stats.Stats().histogram;
+  ASSERT_EQ(StepDeadlineStats::kBucketCount, histogram.size());
+  for (std::size_t i = 0; i < histogram.size(); ++i)
+    EXPECT_EQ(1u, histogram[i]) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(StepDeadlineStatsTest, Jitter)
+{
+  StepDeadlineStats stats;
+  stats.Add(10ms, 9ms, {}, true);
+  stats.Add(10ms, 11ms, {}, true);
+  stats.Add(10ms, 10ms, {}, true);
+
+  const auto &summary = stats.Stats();
+  EXPECT_NEAR(0.0, summary.jitterMeanUs, 1e-6);
+  EXPECT_NEAR(816.4966, summary.jitterStdDevUs, 1e-3);
+  EXPECT_EQ(1ms, summary.maxOverrun);
+}
@@ -19,6 +19,7 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -48,6 +49,11 @@ namespace ignition
                 preupdate(systemPlugin->QueryInterface<ISystemPreUpdate>()),
                 update(systemPlugin->QueryInterface<ISystemUpdate>()),
                 postupdate(systemPlugin->QueryInterface<ISystemPostUpdate>()),
+                access(systemPlugin->QueryInterface<ISystemAccess>()),
+                affinity(
+                    systemPlugin->QueryInterface<ISystemPostUpdateAffinity>()),
+                period(systemPlugin->QueryInterface<ISystemUpdatePeriod>()),
+                reset(systemPlugin->QueryInterface<ISystemReset>()),
                 parentEntity(_entity)
       {
       }
@@ -63,6 +69,11 @@ namespace ignition
                 preupdate(dynamic_cast<ISystemPreUpdate *>(_system.get())),
                 update(dynamic_cast<ISystemUpdate *>(_system.get())),
                 postupdate(dynamic_cast<ISystemPostUpdate *>(_system.get())),
+                access(dynamic_cast<ISystemAccess *>(_system.get())),
+                affinity(
+                    dynamic_cast<ISystemPostUpdateAffinity *>(_system.get())),
+                period(dynamic_cast<ISystemUpdatePeriod *>(_system.get())),
+                reset(dynamic_cast<ISystemReset *>(_system.get())),
                 parentEntity(_entity)
       {
       }
@@ -95,6 +106,23 @@ namespace ignition
       /// Will be nullptr if the System doesn't implement this interface.
       public: ISystemPostUpdate *postupdate = nullptr;
 
+      /// \brief Access this system via the ISystemAccess interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemAccess *access = nullptr;
+
+      /// \brief Access this system via the ISystemPostUpdateAffinity
+      /// interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemPostUpdateAffinity *affinity = nullptr;
+
+      /// \brief Access this system via the ISystemUpdatePeriod interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemUpdatePeriod *period = nullptr;
+
+      /// \brief Access this system via the ISystemReset interface
+      /// Will be nullptr if the System doesn't implement this interface.
+      public: ISystemReset *reset = nullptr;
+
       /// \brief Entity that the system is attached to. It's passed to the
       /// system during the `Configure` call.
       public: Entity parentEntity = {kNullEntity};
@@ -103,6 +131,14 @@ namespace ignition
       /// Useful for if a system needs to be reconfigured at runtime
       public: std::shared_ptr<const sdf::Element> configureSdf = nullptr;
 
+      /// \brief Name of the system used in diagnostics, such as the plugin
+      /// name given in SDF.
+      public: std::string name;
+
+      /// \brief Simulation time between calls to the system's PostUpdate,
+      /// zero to run on every step. See ISystemUpdatePeriod.
+      public: std::chrono::steady_clock::duration updatePeriod{0};
+
       /// \brief Vector of queries and callbacks
       public: std::vector<EntityQueryCallback> updates;
     };
@@ -15,8 +15,10 @@
  *
 */
 
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <ignition/gazebo/SystemLoader.hh>
@@ -32,6 +34,7 @@
 #include <ignition/plugin/Loader.hh>
 
 #include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/StartupTrace.hh>
 
 using namespace ignition::gazebo;
 
@@ -41,9 +44,19 @@ class ignition::gazebo::SystemLoaderPrivate
   public: explicit SystemLoaderPrivate() = default;
 
   //////////////////////////////////////////////////
-  public: bool InstantiateSystemPlugin(const sdf::Plugin &_sdfPlugin,
-              ignition::plugin::PluginPtr &_gzPlugin)
+  /// \brief Find the shared library of a plugin, and load it if it wasn't
+  /// loaded yet. Must be called with the mutex held.
+  /// \param[in] _filename Plugin filename, as given in SDF.
+  /// \param[in] _quiet True to not print an error if the library isn't
+  /// found.
+  /// \return Path of the loaded library, empty on error.
+  public: std::string LoadLibrary(const std::string &_filename,
+              const bool _quiet)
   {
+    auto pathIt = this->libraryPaths.find(_filename);
+    if (pathIt != this->libraryPaths.end())
+      return pathIt->second;
+
     ignition::common::SystemPaths systemPaths;
     systemPaths.SetPluginPathEnv(pluginPathEnv);
 
@@ -55,35 +68,46 @@ class ignition::gazebo::SystemLoaderPrivate
     systemPaths.AddPluginPaths(homePath + "/.ignition/gazebo/plugins");
     systemPaths.AddPluginPaths(IGN_GAZEBO_PLUGIN_INSTALL_DIR);
 
-    auto pathToLib = systemPaths.FindSharedLibrary(_sdfPlugin.Filename());
+    auto pathToLib = systemPaths.FindSharedLibrary(_filename);
     if (pathToLib.empty())
     {
-      // We assume ignition::gazebo corresponds to the levels feature
-      if (_sdfPlugin.Name() != "ignition::gazebo")
+      if (!_quiet)
       {
-        ignerr << "Failed to load system plugin [" << _sdfPlugin.Filename() <<
+        ignerr << "Failed to load system plugin [" << _filename <<
                   "] : couldn't find shared library." << std::endl;
       }
-      return false;
+      return {};
     }
 
-    auto pluginNames = this->loader.LoadLib(pathToLib);
-    if (pluginNames.empty())
+    // Different filenames may resolve to the same library
+    if (this->loadedLibraries.find(pathToLib) == this->loadedLibraries.end())
     {
-      ignerr << "Failed to load system plugin [" << _sdfPlugin.Filename() <<
-                "] : couldn't load library on path [" << pathToLib <<
-                "]." << std::endl;
-      return false;
+      auto pluginNames = this->loader.LoadLib(pathToLib);
+      if (pluginNames.empty() || pluginNames.begin()->empty())
+      {
+        ignerr << "Failed to load system plugin [" << _filename <<
+                  "] : couldn't load library on path [" << pathToLib <<
+                  "]." << std::endl;
+        return {};
+      }
+      this->loadedLibraries.insert(pathToLib);
     }
 
-    auto pluginName = *pluginNames.begin();
-    if (pluginName.empty())
-    {
-      ignerr << "Failed to load system plugin [" << _sdfPlugin.Filename() <<
-                "] : couldn't load library on path [" << pathToLib <<
-                "]." << std::endl;
+    this->libraryPaths[_filename] = pathToLib;
+    return pathToLib;
+  }
+
+  //////////////////////////////////////////////////
+  public: bool InstantiateSystemPlugin(const sdf::Plugin &_sdfPlugin,
+              ignition::plugin::PluginPtr &_gzPlugin)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // We assume ignition::gazebo corresponds to the levels feature
+    auto pathToLib = this->LoadLibrary(_sdfPlugin.Filename(),
+        _sdfPlugin.Name() == "ignition::gazebo");
+    if (pathToLib.empty())
       return false;
-    }
 
     _gzPlugin = this->loader.Instantiate(_sdfPlugin.Name());
     if (!_gzPlugin)
@@ -118,6 +142,17 @@ class ignition::gazebo::SystemLoaderPrivate
 
   /// \brief System plugins that have instances loaded via the manager.
   public: std::unordered_set<SystemPluginPtr> systemPluginsAdded;
+
+  /// \brief Path of the loaded library of each plugin filename, so that
+  /// plugins used many times are only searched for and loaded once.
+  public: std::unordered_map<std::string, std::string> libraryPaths;
+
+  /// \brief Paths of all loaded libraries.
+  public: std::unordered_set<std::string> loadedLibraries;
+
+  /// \brief Protects the loader and the caches, so that plugins can be
+  /// loaded from several threads.
+  public: mutable std::mutex mutex;
 };
 
 //////////////////////////////////////////////////
@@ -132,9 +167,21 @@ SystemLoader::~SystemLoader() = default;
 //////////////////////////////////////////////////
 void SystemLoader::AddSystemPluginPath(const std::string &_path)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->systemPluginPaths.insert(_path);
 }
 
+//////////////////////////////////////////////////
+bool SystemLoader::PreloadLibrary(const std::string &_filename)
+{
+  if (_filename.empty() || _filename == "__default__")
+    return false;
+
+  StartupTrace::Scope scope("plugin_library", _filename);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return !this->dataPtr->LoadLibrary(_filename, true).empty();
+}
+
 //////////////////////////////////////////////////
 std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
   const std::string &_filename,
@@ -183,6 +230,7 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
     return {};
   }
 
+  StartupTrace::Scope scope("system_load", _plugin.Name());
   auto ret = this->dataPtr->InstantiateSystemPlugin(_plugin, plugin);
   if (ret && plugin)
     return plugin;
@@ -193,6 +241,7 @@ std::optional<SystemPluginPtr> SystemLoader::LoadPlugin(
 //////////////////////////////////////////////////
 std::string SystemLoader::PrettyStr() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->loader.PrettyStr();
 }
 
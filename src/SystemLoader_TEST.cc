@@ -67,3 +67,36 @@ TEST(SystemLoader, EmptyNames)
   auto system = sm.LoadPlugin(plugin);
   ASSERT_FALSE(system.has_value());
 }
+
+/////////////////////////////////////////////////
+TEST(SystemLoader, PreloadLibrary)
+{
+  gazebo::SystemLoader sm;
+
+  auto testBuildPath = ignition::common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "lib");
+  sm.AddSystemPluginPath(testBuildPath);
+
+  const std::string filename = std::string("libignition-gazebo") +
+      IGNITION_GAZEBO_MAJOR_VERSION_STR + "-physics-system.so";
+
+  EXPECT_FALSE(sm.PreloadLibrary(""));
+  EXPECT_FALSE(sm.PreloadLibrary("libnot-a-real-plugin.so"));
+  EXPECT_TRUE(sm.PreloadLibrary(filename));
+
+  // Preloading again and loading the plugin reuse the library
+  EXPECT_TRUE(sm.PreloadLibrary(filename));
+
+  sdf::Plugin plugin;
+  plugin.SetFilename(filename);
+  plugin.SetName("ignition::gazebo::systems::Physics");
+  auto first = sm.LoadPlugin(plugin);
+  auto second = sm.LoadPlugin(plugin);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_NE(*first, *second);
+
+  // An unknown plugin name in a loaded library still fails
+  plugin.SetName("ignition::gazebo::systems::NotAPlugin");
+  EXPECT_FALSE(sm.LoadPlugin(plugin).has_value());
+}
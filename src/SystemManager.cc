@@ -15,13 +15,53 @@
  *
 */
 
+#include <string>
+#include <typeinfo>
+
 #include "ignition/gazebo/components/SystemPluginInfo.hh"
 #include "ignition/gazebo/Conversions.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 #include "SystemManager.hh"
 
 using namespace ignition;
 using namespace gazebo;
 
+//////////////////////////////////////////////////
+/// \brief Split systems in stages which can run one after the other, so
+/// that the systems within a stage can run concurrently. Each system is
+/// placed in the stage after the last stage holding an earlier system it
+/// conflicts with, so conflicting systems keep their relative order.
+/// Systems without a declared access conflict with all other systems.
+/// \param[in] _systems Systems, in the order they were loaded.
+/// \param[in] _access Declared access of each system, may be null.
+/// \return Stages.
+template <typename SystemT>
+static std::vector<std::vector<SystemT *>> buildStages(
+    const std::vector<SystemT *> &_systems,
+    const std::vector<std::shared_ptr<SystemAccess>> &_access)
+{
+  std::vector<std::vector<SystemT *>> stages;
+  std::vector<std::size_t> stageOf(_systems.size(), 0u);
+  for (std::size_t i = 0; i < _systems.size(); ++i)
+  {
+    std::size_t stage{0u};
+    for (std::size_t j = 0; j < i; ++j)
+    {
+      if (stageOf[j] + 1u > stage &&
+          (!_access[i] || !_access[j] ||
+           _access[i]->ConflictsWith(*_access[j])))
+      {
+        stage = stageOf[j] + 1u;
+      }
+    }
+    stageOf[i] = stage;
+    if (stage >= stages.size())
+      stages.resize(stage + 1u);
+    stages[stage].push_back(_systems[i]);
+  }
+  return stages;
+}
+
 //////////////////////////////////////////////////
 SystemManager::SystemManager(const SystemLoaderPtr &_systemLoader,
                              EntityComponentManager *_entityCompMgr,
@@ -93,14 +133,43 @@ size_t SystemManager::ActivatePendingSystems()
     if (system.configure)
       this->systemsConfigure.push_back(system.configure);
 
+    std::shared_ptr<SystemAccess> access;
+    if (system.access)
+    {
+      access = std::make_shared<SystemAccess>();
+      system.access->DeclareAccess(*access);
+    }
+
     if (system.preupdate)
+    {
       this->systemsPreupdate.push_back(system.preupdate);
+      this->preupdateAccess.push_back(access);
+    }
 
     if (system.update)
+    {
       this->systemsUpdate.push_back(system.update);
+      this->updateAccess.push_back(access);
+    }
 
     if (system.postupdate)
+    {
       this->systemsPostupdate.push_back(system.postupdate);
+      if (system.affinity && system.affinity->DedicatedPostUpdateThread())
+        this->systemsPostupdateDedicated.push_back(system.postupdate);
+      else
+        this->systemsPostupdatePooled.push_back(system.postupdate);
+    }
+
+    if (system.reset)
+      this->systemsReset.push_back(system.reset);
+  }
+
+  if (count > 0u)
+  {
+    this->preupdateStages = buildStages(this->systemsPreupdate,
+        this->preupdateAccess);
+    this->updateStages = buildStages(this->systemsUpdate, this->updateAccess);
   }
 
   this->pendingSystems.clear();
@@ -152,14 +221,38 @@ void SystemManager::AddSystemImpl(
         components::SystemPluginInfo::typeId);
   }
 
+  // Name the system after its plugin, falling back to its type
+  if (_sdf && _sdf->GetName() == "plugin" && _sdf->HasAttribute("name"))
+    _system.name = _sdf->Get<std::string>("name");
+  else if (_system.system)
+    _system.name = typeid(*_system.system).name();
+
   // Configure the system, if necessary
   if (_system.configure && this->entityCompMgr && this->eventMgr)
   {
+    StartupTrace::Scope scope("system_configure", _system.name);
     _system.configure->Configure(_system.parentEntity, _sdf,
                                  *this->entityCompMgr,
                                  *this->eventMgr);
   }
 
+  // The period given in SDF takes precedence over the one of the system
+  if (_sdf && _sdf->GetName() == "plugin" &&
+      _sdf->HasElement("post_update_rate"))
+  {
+    const double rate = _sdf->Get<double>("post_update_rate");
+    if (rate > 0)
+    {
+      _system.updatePeriod =
+          std::chrono::round<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / rate));
+    }
+  }
+  else if (_system.period)
+  {
+    _system.updatePeriod = _system.period->UpdatePeriod();
+  }
+
   // Update callbacks will be handled later, add to queue
   std::lock_guard<std::mutex> lock(this->pendingSystemsMutex);
   this->pendingSystems.push_back(_system);
@@ -183,12 +276,52 @@ const std::vector<ISystemUpdate *>& SystemManager::SystemsUpdate()
   return this->systemsUpdate;
 }
 
+//////////////////////////////////////////////////
+const std::vector<std::vector<ISystemPreUpdate *>> &
+    SystemManager::SystemsPreUpdateStages() const
+{
+  return this->preupdateStages;
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::vector<ISystemUpdate *>> &
+    SystemManager::SystemsUpdateStages() const
+{
+  return this->updateStages;
+}
+
+//////////////////////////////////////////////////
+const std::vector<SystemInternal> &SystemManager::ActiveSystems() const
+{
+  return this->systems;
+}
+
 //////////////////////////////////////////////////
 const std::vector<ISystemPostUpdate *>& SystemManager::SystemsPostUpdate()
 {
   return this->systemsPostupdate;
 }
 
+//////////////////////////////////////////////////
+const std::vector<ISystemPostUpdate *> &
+    SystemManager::SystemsPostUpdatePooled() const
+{
+  return this->systemsPostupdatePooled;
+}
+
+//////////////////////////////////////////////////
+const std::vector<ISystemPostUpdate *> &
+    SystemManager::SystemsPostUpdateDedicated() const
+{
+  return this->systemsPostupdateDedicated;
+}
+
+//////////////////////////////////////////////////
+const std::vector<ISystemReset *> &SystemManager::SystemsReset() const
+{
+  return this->systemsReset;
+}
+
 //////////////////////////////////////////////////
 std::vector<SystemInternal> SystemManager::TotalByEntity(Entity _entity)
 {
@@ -107,10 +107,45 @@ namespace ignition
       /// \return Vector of systems's update interfaces.
       public: const std::vector<ISystemUpdate *>& SystemsUpdate();
 
+      /// \brief Get the active systems implementing "PreUpdate", split in
+      /// stages. Stages must run in order, and the systems within a stage
+      /// may run concurrently, because their declared accesses don't
+      /// conflict. See ISystemAccess.
+      /// \return Stages of systems's preupdate interfaces.
+      public: const std::vector<std::vector<ISystemPreUpdate *>> &
+                  SystemsPreUpdateStages() const;
+
+      /// \brief Get the active systems implementing "Update", split in
+      /// stages. Stages must run in order, and the systems within a stage
+      /// may run concurrently.
+      /// \return Stages of systems's update interfaces.
+      public: const std::vector<std::vector<ISystemUpdate *>> &
+                  SystemsUpdateStages() const;
+
+      /// \brief Get all active systems, in the order they were activated.
+      /// \return Active systems.
+      public: const std::vector<SystemInternal> &ActiveSystems() const;
+
       /// \brief Get an vector of all active systems implementing "PostUpdate"
       /// \return Vector of systems's post-update interfaces.
       public: const std::vector<ISystemPostUpdate *>& SystemsPostUpdate();
 
+      /// \brief Get the active systems implementing "PostUpdate" which may
+      /// run as tasks on a shared pool of threads.
+      /// \return Vector of systems's post-update interfaces.
+      public: const std::vector<ISystemPostUpdate *> &
+                  SystemsPostUpdatePooled() const;
+
+      /// \brief Get the active systems implementing "PostUpdate" which need
+      /// a dedicated thread. See ISystemPostUpdateAffinity.
+      /// \return Vector of systems's post-update interfaces.
+      public: const std::vector<ISystemPostUpdate *> &
+                  SystemsPostUpdateDedicated() const;
+
+      /// \brief Get all active systems implementing "Reset".
+      /// \return Vector of systems's reset interfaces.
+      public: const std::vector<ISystemReset *> &SystemsReset() const;
+
       /// \brief Get an vector of all systems attached to a given entity.
       /// \return Vector of systems.
       public: std::vector<SystemInternal> TotalByEntity(Entity _entity);
@@ -160,9 +195,32 @@ namespace ignition
       /// \brief Systems implementing Update
       private: std::vector<ISystemUpdate *> systemsUpdate;
 
+      /// \brief Declared access of each system in systemsPreupdate, null for
+      /// systems which don't declare it.
+      private: std::vector<std::shared_ptr<SystemAccess>> preupdateAccess;
+
+      /// \brief Declared access of each system in systemsUpdate, null for
+      /// systems which don't declare it.
+      private: std::vector<std::shared_ptr<SystemAccess>> updateAccess;
+
+      /// \brief Systems implementing PreUpdate, split in stages.
+      private: std::vector<std::vector<ISystemPreUpdate *>> preupdateStages;
+
+      /// \brief Systems implementing Update, split in stages.
+      private: std::vector<std::vector<ISystemUpdate *>> updateStages;
+
       /// \brief Systems implementing PostUpdate
       private: std::vector<ISystemPostUpdate *> systemsPostupdate;
 
+      /// \brief Systems implementing PostUpdate which run on a shared pool
+      private: std::vector<ISystemPostUpdate *> systemsPostupdatePooled;
+
+      /// \brief Systems implementing PostUpdate which need their own thread
+      private: std::vector<ISystemPostUpdate *> systemsPostupdateDedicated;
+
+      /// \brief Systems implementing Reset
+      private: std::vector<ISystemReset *> systemsReset;
+
       /// \brief System loader, for loading system plugins.
       private: SystemLoaderPtr systemLoader;
 
@@ -63,6 +63,58 @@ class SystemWithUpdates:
                 const EntityComponentManager &) override {};
 };
 
+/////////////////////////////////////////////////
+class SystemWithAccess:
+  public SystemWithUpdates,
+  public ISystemAccess
+{
+  /// \brief Constructor
+  /// \param[in] _access Access to declare.
+  public: explicit SystemWithAccess(const SystemAccess &_access)
+          : access(_access) {}
+
+  // Documentation inherited
+  public: void DeclareAccess(SystemAccess &_access) const override
+          {
+            _access = this->access;
+          }
+
+  /// \brief Access to declare.
+  public: SystemAccess access;
+};
+
+/////////////////////////////////////////////////
+class SystemWithAffinity:
+  public SystemWithUpdates,
+  public ISystemPostUpdateAffinity
+{
+  /// \brief Constructor
+  /// \param[in] _dedicated Whether to ask for a dedicated thread.
+  public: explicit SystemWithAffinity(bool _dedicated)
+          : dedicated(_dedicated) {}
+
+  // Documentation inherited
+  public: bool DedicatedPostUpdateThread() const override
+          {
+            return this->dedicated;
+          }
+
+  /// \brief Whether to ask for a dedicated thread.
+  public: bool dedicated;
+};
+
+/////////////////////////////////////////////////
+class SystemWithPeriod:
+  public SystemWithUpdates,
+  public ISystemUpdatePeriod
+{
+  // Documentation inherited
+  public: std::chrono::steady_clock::duration UpdatePeriod() const override
+          {
+            return std::chrono::milliseconds(100);
+          }
+};
+
 /////////////////////////////////////////////////
 TEST(SystemManager, Constructor)
 {
@@ -260,3 +312,126 @@ TEST(SystemManager, AddSystemWithInfo)
   EXPECT_EQ(1, entityCount);
 }
 
+/////////////////////////////////////////////////
+TEST(SystemManager, Stages)
+{
+  auto loader = std::make_shared<SystemLoader>();
+
+  auto ecm = EntityComponentManager();
+  auto eventManager = EventManager();
+
+  SystemManager systemMgr(loader, &ecm, &eventManager);
+  EXPECT_TRUE(systemMgr.SystemsPreUpdateStages().empty());
+  EXPECT_TRUE(systemMgr.SystemsUpdateStages().empty());
+
+  const ComponentTypeId typeA{1001};
+  const ComponentTypeId typeB{1002};
+  const ComponentTypeId typeC{1003};
+
+  // Disjoint writes and shared reads can run together
+  auto writeA = std::make_shared<SystemWithAccess>(
+      SystemAccess().Write(typeA).Read(typeC));
+  auto writeB = std::make_shared<SystemWithAccess>(
+      SystemAccess().Write(typeB).Read(typeC));
+  // Reads what the first system writes, so must run after it
+  auto readA = std::make_shared<SystemWithAccess>(
+      SystemAccess().Read(typeA));
+  // Doesn't declare its access, so runs alone
+  auto undeclared = std::make_shared<SystemWithUpdates>();
+  // Would fit in the second stage, but can't move before the undeclared
+  // system
+  auto writeB2 = std::make_shared<SystemWithAccess>(
+      SystemAccess().Write(typeB));
+
+  systemMgr.AddSystem(writeA, kNullEntity, nullptr);
+  systemMgr.AddSystem(writeB, kNullEntity, nullptr);
+  systemMgr.AddSystem(readA, kNullEntity, nullptr);
+  systemMgr.AddSystem(undeclared, kNullEntity, nullptr);
+  systemMgr.AddSystem(writeB2, kNullEntity, nullptr);
+  systemMgr.ActivatePendingSystems();
+
+  EXPECT_TRUE(writeA->access.ConflictsWith(readA->access));
+  EXPECT_FALSE(writeA->access.ConflictsWith(writeB->access));
+
+  const auto &stages = systemMgr.SystemsPreUpdateStages();
+  ASSERT_EQ(4u, stages.size());
+  ASSERT_EQ(2u, stages[0].size());
+  EXPECT_EQ(writeA.get(), stages[0][0]);
+  EXPECT_EQ(writeB.get(), stages[0][1]);
+  ASSERT_EQ(1u, stages[1].size());
+  EXPECT_EQ(readA.get(), stages[1][0]);
+  ASSERT_EQ(1u, stages[2].size());
+  EXPECT_EQ(undeclared.get(), stages[2][0]);
+  ASSERT_EQ(1u, stages[3].size());
+  EXPECT_EQ(writeB2.get(), stages[3][0]);
+
+  ASSERT_EQ(4u, systemMgr.SystemsUpdateStages().size());
+  EXPECT_EQ(2u, systemMgr.SystemsUpdateStages()[0].size());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemManager, PostUpdateAffinity)
+{
+  auto loader = std::make_shared<SystemLoader>();
+
+  auto ecm = EntityComponentManager();
+  auto eventManager = EventManager();
+
+  SystemManager systemMgr(loader, &ecm, &eventManager);
+
+  auto plain = std::make_shared<SystemWithUpdates>();
+  auto dedicated = std::make_shared<SystemWithAffinity>(true);
+  auto notDedicated = std::make_shared<SystemWithAffinity>(false);
+  systemMgr.AddSystem(plain, kNullEntity, nullptr);
+  systemMgr.AddSystem(dedicated, kNullEntity, nullptr);
+  systemMgr.AddSystem(notDedicated, kNullEntity, nullptr);
+  systemMgr.ActivatePendingSystems();
+
+  EXPECT_EQ(3u, systemMgr.SystemsPostUpdate().size());
+
+  const auto &pooled = systemMgr.SystemsPostUpdatePooled();
+  ASSERT_EQ(2u, pooled.size());
+  EXPECT_EQ(plain.get(), pooled[0]);
+  EXPECT_EQ(notDedicated.get(), pooled[1]);
+
+  ASSERT_EQ(1u, systemMgr.SystemsPostUpdateDedicated().size());
+  EXPECT_EQ(dedicated.get(), systemMgr.SystemsPostUpdateDedicated()[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(SystemManager, UpdatePeriod)
+{
+  auto loader = std::make_shared<SystemLoader>();
+
+  auto ecm = EntityComponentManager();
+  auto eventManager = EventManager();
+
+  SystemManager systemMgr(loader, &ecm, &eventManager);
+
+  auto pluginElem = std::make_shared<sdf::Element>();
+  sdf::initFile("plugin.sdf", pluginElem);
+  sdf::readString("<?xml version='1.0'?><sdf version='1.6'>"
+      "  <plugin filename='plum' name='peach'>"
+      "    <post_update_rate>50</post_update_rate>"
+      "  </plugin>"
+      "</sdf>", pluginElem);
+
+  // Every step
+  systemMgr.AddSystem(std::make_shared<SystemWithUpdates>(), kNullEntity,
+      nullptr);
+  // From the interface
+  systemMgr.AddSystem(std::make_shared<SystemWithPeriod>(), kNullEntity,
+      nullptr);
+  // SDF takes precedence over the interface
+  systemMgr.AddSystem(std::make_shared<SystemWithPeriod>(), kNullEntity,
+      pluginElem);
+  systemMgr.ActivatePendingSystems();
+
+  const auto &systems = systemMgr.ActiveSystems();
+  ASSERT_EQ(3u, systems.size());
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      systems[0].updatePeriod);
+  EXPECT_EQ(std::chrono::milliseconds(100), systems[1].updatePeriod);
+  EXPECT_EQ(std::chrono::milliseconds(20), systems[2].updatePeriod);
+  EXPECT_EQ("peach", systems[2].name);
+}
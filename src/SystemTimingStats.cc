@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SystemTimingStats.hh"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Message key prefix of each phase.
+static const char *kSystemTimingPhaseKeys[] =
+{
+  "pre_update",
+  "update",
+  "post_update",
+};
+
+//////////////////////////////////////////////////
+SystemTimingStats::SystemTimingStats(std::size_t _window)
+  : window(std::max<std::size_t>(1u, _window))
+{
+}
+
+//////////////////////////////////////////////////
+void SystemTimingStats::SetSystems(const std::vector<std::string> &_names)
+{
+  this->systems.resize(_names.size());
+  for (std::size_t i = 0; i < _names.size(); ++i)
+    this->systems[i].name = _names[i];
+}
+
+//////////////////////////////////////////////////
+std::size_t SystemTimingStats::SystemCount() const
+{
+  return this->systems.size();
+}
+
+//////////////////////////////////////////////////
+void SystemTimingStats::Add(std::size_t _system, Phase _phase,
+    std::chrono::steady_clock::duration _duration)
+{
+  if (_system >= this->systems.size())
+    return;
+
+  auto &samples = this->systems[_system].phases[static_cast<int>(_phase)];
+  if (samples.ring.empty())
+    samples.ring.resize(this->window);
+
+  samples.ring[samples.count % this->window] =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_duration).count();
+  ++samples.count;
+}
+
+//////////////////////////////////////////////////
+void SystemTimingStats::AddAllocations(std::size_t _system, Phase _phase,
+    uint64_t _count, uint64_t _bytes)
+{
+  if (_system >= this->systems.size())
+    return;
+
+  auto &samples = this->systems[_system].phases[static_cast<int>(_phase)];
+  if (samples.allocRing.empty())
+  {
+    samples.allocRing.resize(this->window);
+    samples.allocBytesRing.resize(this->window);
+  }
+
+  samples.allocRing[samples.allocCount % this->window] = _count;
+  samples.allocBytesRing[samples.allocCount % this->window] = _bytes;
+  ++samples.allocCount;
+}
+
+//////////////////////////////////////////////////
+SystemTimingStats::Summary SystemTimingStats::Stats(std::size_t _system,
+    Phase _phase) const
+{
+  Summary summary;
+  if (_system >= this->systems.size())
+    return summary;
+
+  const auto &samples =
+      this->systems[_system].phases[static_cast<int>(_phase)];
+  summary.count = static_cast<std::size_t>(
+      std::min<uint64_t>(samples.count, this->window));
+  if (summary.count == 0u)
+    return summary;
+
+  std::vector<int64_t> sorted(samples.ring.begin(),
+      samples.ring.begin() + summary.count);
+
+  int64_t total{0};
+  for (const auto sample : sorted)
+    total += sample;
+
+  // Nearest rank percentile
+  const std::size_t rank = (summary.count * 99u + 99u) / 100u - 1u;
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  const int64_t p99 = sorted[rank];
+  const int64_t max = *std::max_element(sorted.begin() + rank, sorted.end());
+
+  using Nanoseconds = std::chrono::nanoseconds;
+  using Duration = std::chrono::steady_clock::duration;
+  summary.mean = std::chrono::duration_cast<Duration>(Nanoseconds(
+      total / static_cast<int64_t>(summary.count)));
+  summary.p99 = std::chrono::duration_cast<Duration>(Nanoseconds(p99));
+  summary.max = std::chrono::duration_cast<Duration>(Nanoseconds(max));
+  return summary;
+}
+
+//////////////////////////////////////////////////
+void SystemTimingStats::SetStepTime(Phase _phase,
+    std::chrono::steady_clock::duration _duration)
+{
+  this->stepTimes[static_cast<int>(_phase)] = _duration;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration SystemTimingStats::StepTime(
+    Phase _phase) const
+{
+  return this->stepTimes[static_cast<int>(_phase)];
+}
+
+//////////////////////////////////////////////////
+void SystemTimingStats::FillMsg(msgs::Param_V &_msg) const
+{
+  _msg.clear_param();
+
+  auto toUs = [](std::chrono::steady_clock::duration _duration)
+  {
+    return std::chrono::duration<double, std::micro>(_duration).count();
+  };
+
+  for (std::size_t i = 0; i < this->systems.size(); ++i)
+  {
+    msgs::Param *param{nullptr};
+    for (std::size_t p = 0; p < kPhaseCount; ++p)
+    {
+      const auto summary = this->Stats(i, static_cast<Phase>(p));
+      if (summary.count == 0u)
+        continue;
+
+      if (nullptr == param)
+      {
+        param = _msg.add_param();
+        auto &name = (*param->mutable_params())["name"];
+        name.set_type(msgs::Any::STRING);
+        name.set_string_value(this->systems[i].name);
+      }
+
+      const std::string prefix = kSystemTimingPhaseKeys[p];
+      auto &params = *param->mutable_params();
+      params[prefix + "_mean_us"].set_type(msgs::Any::DOUBLE);
+      params[prefix + "_mean_us"].set_double_value(toUs(summary.mean));
+      params[prefix + "_p99_us"].set_type(msgs::Any::DOUBLE);
+      params[prefix + "_p99_us"].set_double_value(toUs(summary.p99));
+      params[prefix + "_max_us"].set_type(msgs::Any::DOUBLE);
+      params[prefix + "_max_us"].set_double_value(toUs(summary.max));
+
+      const auto &samples = this->systems[i].phases[p];
+      const auto allocCount = static_cast<std::size_t>(
+          std::min<uint64_t>(samples.allocCount, this->window));
+      if (allocCount == 0u)
+        continue;
+
+      uint64_t allocs{0u};
+      uint64_t allocsMax{0u};
+      uint64_t bytes{0u};
+      for (std::size_t s = 0; s < allocCount; ++s)
+      {
+        allocs += samples.allocRing[s];
+        allocsMax = std::max(allocsMax, samples.allocRing[s]);
+        bytes += samples.allocBytesRing[s];
+      }
+
+      params[prefix + "_allocs_mean"].set_type(msgs::Any::DOUBLE);
+      params[prefix + "_allocs_mean"].set_double_value(
+          static_cast<double>(allocs) / allocCount);
+      params[prefix + "_allocs_max"].set_type(msgs::Any::INT32);
+      params[prefix + "_allocs_max"].set_int_value(
+          static_cast<int>(std::min<uint64_t>(allocsMax, INT32_MAX)));
+      params[prefix + "_alloc_bytes_mean"].set_type(msgs::Any::DOUBLE);
+      params[prefix + "_alloc_bytes_mean"].set_double_value(
+          static_cast<double>(bytes) / allocCount);
+    }
+  }
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMTIMINGSTATS_HH_
+#define IGNITION_GAZEBO_SYSTEMTIMINGSTATS_HH_
+
+#include <ignition/msgs/param_v.pb.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \class SystemTimingStats SystemTimingStats.hh
+    /// \brief Rolling statistics of the wall time spent in each system
+    /// during each phase of a simulation step.
+    ///
+    /// Only the most recent samples of each system and phase are kept, so
+    /// the statistics follow the current behaviour of the systems. Calls to
+    /// Add for different systems or phases may happen concurrently, but not
+    /// concurrently with any other function.
+    class IGNITION_GAZEBO_VISIBLE SystemTimingStats
+    {
+      /// \brief Phases of a simulation step.
+      public: enum class Phase
+      {
+        /// \brief PreUpdate
+        PRE_UPDATE = 0,
+        /// \brief Update
+        UPDATE = 1,
+        /// \brief PostUpdate
+        POST_UPDATE = 2,
+      };
+
+      /// \brief Statistics of a system in one phase.
+      public: struct Summary
+      {
+        /// \brief Number of samples the statistics are computed from.
+        std::size_t count{0u};
+
+        /// \brief Mean duration.
+        std::chrono::steady_clock::duration mean{0};
+
+        /// \brief 99th percentile of the durations.
+        std::chrono::steady_clock::duration p99{0};
+
+        /// \brief Longest duration.
+        std::chrono::steady_clock::duration max{0};
+      };
+
+      /// \brief Constructor
+      /// \param[in] _window Number of recent samples to keep for each system
+      /// and phase.
+      public: explicit SystemTimingStats(std::size_t _window = 500u);
+
+      /// \brief Set the systems being tracked. Systems which were already
+      /// tracked at the same index keep their samples.
+      /// \param[in] _names Name of each system.
+      public: void SetSystems(const std::vector<std::string> &_names);
+
+      /// \brief Get the number of tracked systems.
+      /// \return Number of systems.
+      public: std::size_t SystemCount() const;
+
+      /// \brief Record the time spent in a system.
+      /// \param[in] _system Index of the system.
+      /// \param[in] _phase Phase the system ran.
+      /// \param[in] _duration Wall time spent in the system.
+      public: void Add(std::size_t _system, Phase _phase,
+                  std::chrono::steady_clock::duration _duration);
+
+      /// \brief Record the heap allocations made by a system. Used when
+      /// allocation tracking is compiled in, see AllocationTracker.
+      /// \param[in] _system Index of the system.
+      /// \param[in] _phase Phase the system ran.
+      /// \param[in] _count Number of allocations.
+      /// \param[in] _bytes Number of bytes allocated.
+      public: void AddAllocations(std::size_t _system, Phase _phase,
+                  uint64_t _count, uint64_t _bytes);
+
+      /// \brief Get the statistics of a system.
+      /// \param[in] _system Index of the system.
+      /// \param[in] _phase Phase.
+      /// \return Statistics over the kept samples, with a zero count if the
+      /// system has no samples for _phase.
+      public: Summary Stats(std::size_t _system, Phase _phase) const;
+
+      /// \brief Record the wall time spent in a whole phase during the last
+      /// step, which is less than the sum of its systems when they run
+      /// concurrently.
+      /// \param[in] _phase Phase.
+      /// \param[in] _duration Wall time spent in the phase.
+      public: void SetStepTime(Phase _phase,
+                  std::chrono::steady_clock::duration _duration);
+
+      /// \brief Get the wall time spent in a whole phase during the last
+      /// step.
+      /// \param[in] _phase Phase.
+      /// \return Wall time.
+      public: std::chrono::steady_clock::duration StepTime(
+                  Phase _phase) const;
+
+      /// \brief Fill a message with the statistics of all systems which have
+      /// samples. Each system is a param holding its "name" and the
+      /// "<phase>_mean_us", "<phase>_p99_us" and "<phase>_max_us" values of
+      /// each phase it runs, where phase is one of "pre_update", "update"
+      /// and "post_update". Systems with allocation samples also hold the
+      /// "<phase>_allocs_mean", "<phase>_allocs_max" and
+      /// "<phase>_alloc_bytes_mean" values.
+      /// \param[out] _msg Message to fill. Existing params are cleared.
+      public: void FillMsg(msgs::Param_V &_msg) const;
+
+      /// \brief Number of phases.
+      private: static constexpr std::size_t kPhaseCount{3u};
+
+      /// \brief Recent samples of a system in one phase.
+      private: struct Samples
+      {
+        /// \brief Ring buffer of durations in nanoseconds. Allocated on the
+        /// first sample, so phases a system doesn't run cost no memory.
+        std::vector<int64_t> ring;
+
+        /// \brief Total number of samples added.
+        uint64_t count{0u};
+
+        /// \brief Ring buffer of allocation counts, allocated on the first
+        /// allocation sample.
+        std::vector<uint64_t> allocRing;
+
+        /// \brief Ring buffer of allocated bytes, parallel to allocRing.
+        std::vector<uint64_t> allocBytesRing;
+
+        /// \brief Total number of allocation samples added.
+        uint64_t allocCount{0u};
+      };
+
+      /// \brief Tracked system.
+      private: struct SystemSamples
+      {
+        /// \brief Name of the system.
+        std::string name;
+
+        /// \brief Samples of each phase.
+        std::array<Samples, kPhaseCount> phases;
+      };
+
+      /// \brief Number of samples kept per system and phase.
+      private: std::size_t window;
+
+      /// \brief Tracked systems.
+      private: std::vector<SystemSamples> systems;
+
+      /// \brief Wall time of each phase during the last step.
+      private: std::array<std::chrono::steady_clock::duration, kPhaseCount>
+                   stepTimes{};
+    };
+    }
+  }
+}
+#endif
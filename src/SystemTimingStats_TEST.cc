@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "SystemTimingStats.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+using Phase = SystemTimingStats::Phase;
+
+/////////////////////////////////////////////////
+TEST(SystemTimingStatsTest, Stats)
+{
+  SystemTimingStats stats(100u);
+  stats.SetSystems({"physics", "sensors"});
+  EXPECT_EQ(2u, stats.SystemCount());
+
+  // No samples
+  EXPECT_EQ(0u, stats.Stats(0, Phase::UPDATE).count);
+  EXPECT_EQ(0u, stats.Stats(5, Phase::UPDATE).count);
+
+  for (int i = 1; i <= 100; ++i)
+    stats.Add(0, Phase::UPDATE, std::chrono::microseconds(i));
+
+  auto summary = stats.Stats(0, Phase::UPDATE);
+  EXPECT_EQ(100u, summary.count);
+  EXPECT_EQ(std::chrono::nanoseconds(50500), summary.mean);
+  EXPECT_EQ(std::chrono::microseconds(99), summary.p99);
+  EXPECT_EQ(std::chrono::microseconds(100), summary.max);
+
+  // Other phases and systems are tracked separately
+  EXPECT_EQ(0u, stats.Stats(0, Phase::PRE_UPDATE).count);
+  EXPECT_EQ(0u, stats.Stats(1, Phase::UPDATE).count);
+
+  // Only the most recent samples are kept
+  for (int i = 0; i < 100; ++i)
+    stats.Add(0, Phase::UPDATE, 2us);
+  summary = stats.Stats(0, Phase::UPDATE);
+  EXPECT_EQ(100u, summary.count);
+  EXPECT_EQ(std::chrono::microseconds(2), summary.mean);
+  EXPECT_EQ(std::chrono::microseconds(2), summary.max);
+
+  // Adding systems keeps existing samples
+  stats.SetSystems({"physics", "sensors", "user_commands"});
+  EXPECT_EQ(3u, stats.SystemCount());
+  EXPECT_EQ(100u, stats.Stats(0, Phase::UPDATE).count);
+
+  stats.SetStepTime(Phase::POST_UPDATE, 3ms);
+  EXPECT_EQ(std::chrono::milliseconds(3), stats.StepTime(Phase::POST_UPDATE));
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(),
+      stats.StepTime(Phase::PRE_UPDATE));
+}
+
+/////////////////////////////////////////////////
+TEST(SystemTimingStatsTest, FillMsg)
+{
+  SystemTimingStats stats;
+  stats.SetSystems({"physics", "idle", "sensors"});
+  stats.Add(0, Phase::UPDATE, 10us);
+  stats.Add(2, Phase::PRE_UPDATE, 1us);
+  stats.Add(2, Phase::POST_UPDATE, 4us);
+
+  msgs::Param_V msg;
+  stats.FillMsg(msg);
+
+  // Systems without samples are skipped
+  ASSERT_EQ(2, msg.param_size());
+
+  const auto &physics = msg.param(0).params();
+  EXPECT_EQ("physics", physics.at("name").string_value());
+  EXPECT_DOUBLE_EQ(10.0, physics.at("update_mean_us").double_value());
+  EXPECT_DOUBLE_EQ(10.0, physics.at("update_p99_us").double_value());
+  EXPECT_DOUBLE_EQ(10.0, physics.at("update_max_us").double_value());
+  EXPECT_EQ(0u, physics.count("pre_update_mean_us"));
+
+  const auto &sensors = msg.param(1).params();
+  EXPECT_EQ("sensors", sensors.at("name").string_value());
+  EXPECT_DOUBLE_EQ(1.0, sensors.at("pre_update_max_us").double_value());
+  EXPECT_DOUBLE_EQ(4.0, sensors.at("post_update_mean_us").double_value());
+  EXPECT_EQ(0u, sensors.count("update_mean_us"));
+
+  // Filling again replaces the previous content
+  stats.FillMsg(msg);
+  EXPECT_EQ(2, msg.param_size());
+}
+
+/////////////////////////////////////////////////
+TEST(SystemTimingStatsTest, Allocations)
+{
+  SystemTimingStats stats;
+  stats.SetSystems({"physics", "sensors"});
+  stats.Add(0, Phase::UPDATE, 10us);
+  stats.Add(0, Phase::UPDATE, 10us);
+  stats.AddAllocations(0, Phase::UPDATE, 2u, 64u);
+  stats.AddAllocations(0, Phase::UPDATE, 6u, 192u);
+  stats.Add(1, Phase::POST_UPDATE, 1us);
+
+  // Out of range
+  stats.AddAllocations(2, Phase::UPDATE, 1u, 1u);
+
+  msgs::Param_V msg;
+  stats.FillMsg(msg);
+  ASSERT_EQ(2, msg.param_size());
+
+  const auto &physics = msg.param(0).params();
+  EXPECT_DOUBLE_EQ(4.0, physics.at("update_allocs_mean").double_value());
+  EXPECT_EQ(6, physics.at("update_allocs_max").int_value());
+  EXPECT_DOUBLE_EQ(128.0,
+      physics.at("update_alloc_bytes_mean").double_value());
+
+  // Systems without allocation samples only have timings
+  const auto &sensors = msg.param(1).params();
+  EXPECT_EQ(1u, sensors.count("post_update_mean_us"));
+  EXPECT_EQ(0u, sensors.count("post_update_allocs_mean"));
+}
@@ -15,6 +15,8 @@
  *
 */
 
+#include <utility>
+
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/ServerConfig.hh"
 
@@ -105,6 +107,59 @@ void HelperSystem::PostUpdate(const UpdateInfo &_info,
     this->postUpdateCallback(_info, _ecm);
 }
 
+/////////////////////////////////////////////////
+/// \brief Wrap a callback so that it's only called on iterations which are
+/// multiples of _iterations. Paused updates, which repeat an iteration, don't
+/// call it again.
+/// \param[in] _iterations Number of iterations between calls.
+/// \param[in] _cb Callback to wrap.
+/// \return The wrapped callback.
+template <typename ECM>
+static std::function<void(const UpdateInfo &, ECM &)> EveryIterations(
+    uint64_t _iterations,
+    std::function<void(const UpdateInfo &, ECM &)> _cb)
+{
+  if (_iterations <= 1u || !_cb)
+    return _cb;
+
+  uint64_t lastCount{0u};
+  return [_iterations, lastCount, cb = std::move(_cb)](
+      const UpdateInfo &_info, ECM &_ecm) mutable
+  {
+    const uint64_t count = _info.iterations / _iterations;
+    if (count <= lastCount)
+      return;
+    lastCount = count;
+    cb(_info, _ecm);
+  };
+}
+
+/////////////////////////////////////////////////
+/// \brief Wrap a callback so that it's only called on the first iteration
+/// that reaches each multiple of _period in sim time.
+/// \param[in] _period Sim time between calls.
+/// \param[in] _cb Callback to wrap.
+/// \return The wrapped callback.
+template <typename ECM>
+static std::function<void(const UpdateInfo &, ECM &)> EveryPeriod(
+    const std::chrono::steady_clock::duration &_period,
+    std::function<void(const UpdateInfo &, ECM &)> _cb)
+{
+  if (_period <= std::chrono::steady_clock::duration::zero() || !_cb)
+    return _cb;
+
+  std::chrono::steady_clock::duration::rep lastCount{0};
+  return [_period, lastCount, cb = std::move(_cb)](
+      const UpdateInfo &_info, ECM &_ecm) mutable
+  {
+    const auto count = _info.simTime / _period;
+    if (count <= lastCount)
+      return;
+    lastCount = count;
+    cb(_info, _ecm);
+  };
+}
+
 //////////////////////////////////////////////////
 class ignition::gazebo::TestFixturePrivate
 {
@@ -207,6 +262,57 @@ TestFixture &TestFixture::OnPostUpdate(std::function<void(
   return *this;
 }
 
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnPreUpdate(uint64_t _iterations,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+{
+  return this->OnPreUpdate(EveryIterations(_iterations, std::move(_cb)));
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnPreUpdate(
+          const std::chrono::steady_clock::duration &_period,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+{
+  return this->OnPreUpdate(EveryPeriod(_period, std::move(_cb)));
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnUpdate(uint64_t _iterations,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+{
+  return this->OnUpdate(EveryIterations(_iterations, std::move(_cb)));
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnUpdate(
+          const std::chrono::steady_clock::duration &_period,
+          std::function<void(
+          const UpdateInfo &, EntityComponentManager &)> _cb)
+{
+  return this->OnUpdate(EveryPeriod(_period, std::move(_cb)));
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnPostUpdate(uint64_t _iterations,
+          std::function<void(
+          const UpdateInfo &, const EntityComponentManager &)> _cb)
+{
+  return this->OnPostUpdate(EveryIterations(_iterations, std::move(_cb)));
+}
+
+//////////////////////////////////////////////////
+TestFixture &TestFixture::OnPostUpdate(
+          const std::chrono::steady_clock::duration &_period,
+          std::function<void(
+          const UpdateInfo &, const EntityComponentManager &)> _cb)
+{
+  return this->OnPostUpdate(EveryPeriod(_period, std::move(_cb)));
+}
+
 //////////////////////////////////////////////////
 std::shared_ptr<gazebo::Server> TestFixture::Server() const
 {
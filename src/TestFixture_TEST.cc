@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
 
@@ -259,3 +262,43 @@ TEST_F(TestFixtureTest, ChangeCallback)
   // New callback is called
   EXPECT_EQ(expectedIterations, preUpdate2);
 }
+
+/////////////////////////////////////////////////
+TEST_F(TestFixtureTest, IntervalCallbacks)
+{
+  TestFixture testFixture(common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "worlds", "shapes.sdf"));
+  ASSERT_NE(nullptr, testFixture.Server());
+
+  std::vector<uint64_t> preUpdates;
+  std::vector<uint64_t> updates;
+  std::vector<uint64_t> postUpdates;
+  testFixture.
+    OnPreUpdate(3u, [&](const UpdateInfo &_info, EntityComponentManager &)
+    {
+      preUpdates.push_back(_info.iterations);
+    }).
+    OnUpdate(std::chrono::milliseconds(4),
+        [&](const UpdateInfo &_info, EntityComponentManager &)
+    {
+      updates.push_back(_info.iterations);
+    }).
+    OnPostUpdate(0u, [&](const UpdateInfo &_info,
+        const EntityComponentManager &)
+    {
+      postUpdates.push_back(_info.iterations);
+    }).
+    Finalize();
+
+  testFixture.Server()->Run(true, 10u, false);
+
+  // Step size is 1 ms, so each iteration is 1 ms apart
+  EXPECT_EQ(std::vector<uint64_t>({3u, 6u, 9u}), preUpdates);
+  EXPECT_EQ(std::vector<uint64_t>({4u, 8u}), updates);
+  EXPECT_EQ(10u, postUpdates.size());
+
+  // Counting carries over across runs
+  testFixture.Server()->Run(true, 2u, false);
+  EXPECT_EQ(std::vector<uint64_t>({3u, 6u, 9u, 12u}), preUpdates);
+  EXPECT_EQ(std::vector<uint64_t>({4u, 8u, 12u}), updates);
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ThreadPool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ignition/gazebo/Profiler.hh"
+#include "ignition/gazebo/Util.hh"
+
+/// \brief Pool whose loop the current thread is processing, if any. Used to
+/// run loops nested in a loop of the same pool serially instead of
+/// deadlocking, while loops of other pools still run in parallel.
+static thread_local const ignition::gazebo::ThreadPoolPrivate *tlCurrentPool{
+    nullptr};
+
+class ignition::gazebo::ThreadPoolPrivate
+{
+  /// \brief Main loop of each worker thread.
+  /// \param[in] _id Worker id, used for profiling.
+  public: void Worker(unsigned int _id);
+
+  /// \brief Claim and process chunks of the current loop until it is
+  /// exhausted.
+  public: void RunChunks();
+
+  /// \brief Worker threads.
+  public: std::vector<std::thread> workers;
+
+  /// \brief Protects the current loop and the worker states.
+  public: std::mutex mutex;
+
+  /// \brief Signals the workers that a new loop is available or that they
+  /// should stop.
+  public: std::condition_variable startCv;
+
+  /// \brief Signals the calling thread that all workers are done.
+  public: std::condition_variable doneCv;
+
+  /// \brief Only one loop runs on the pool at a time.
+  public: std::mutex loopMutex;
+
+  /// \brief Incremented every time a new loop is started.
+  public: uint64_t generation{0};
+
+  /// \brief Number of workers still processing the current loop.
+  public: unsigned int activeWorkers{0};
+
+  /// \brief Set to true to stop the workers.
+  public: bool stop{false};
+
+  /// \brief Function of the current loop.
+  public: const std::function<void(std::size_t, std::size_t)> *func{nullptr};
+
+  /// \brief Number of elements in the current loop.
+  public: std::size_t count{0};
+
+  /// \brief Number of elements per chunk in the current loop.
+  public: std::size_t chunkSize{1};
+
+  /// \brief Index of the first element of the next unclaimed chunk.
+  public: std::atomic<std::size_t> nextIndex{0};
+};
+
+using namespace ignition::gazebo;
+
+//////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned int _threadCount)
+  : dataPtr(std::make_unique<ThreadPoolPrivate>())
+{
+  if (_threadCount == 0u)
+    _threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  // The calling thread also processes chunks
+  for (unsigned int i = 0; i + 1 < _threadCount; ++i)
+  {
+    this->dataPtr->workers.push_back(
+        std::thread(&ThreadPoolPrivate::Worker, this->dataPtr.get(), i));
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->startCv.notify_all();
+
+  for (auto &worker : this->dataPtr->workers)
+    worker.join();
+}
+
+//////////////////////////////////////////////////
+unsigned int ThreadPool::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->workers.size()) + 1u;
+}
+
+//////////////////////////////////////////////////
+bool ThreadPool::SetAffinity(const std::vector<unsigned int> &_cores)
+{
+  bool result{true};
+  for (auto &worker : this->dataPtr->workers)
+    result = setThreadAffinity(worker, _cores) && result;
+  return result;
+}
+
+//////////////////////////////////////////////////
+void ThreadPool::ParallelFor(std::size_t _count,
+    const std::function<void(std::size_t, std::size_t)> &_func,
+    std::size_t _minChunkSize)
+{
+  if (_count == 0u)
+    return;
+
+  _minChunkSize = std::max<std::size_t>(1u, _minChunkSize);
+
+  // Run serially if there's nothing to split, if this is a nested loop or if
+  // another thread is already using the pool
+  std::unique_lock<std::mutex> loopLock(this->dataPtr->loopMutex,
+      std::defer_lock);
+  if (this->dataPtr->workers.empty() || _count <= _minChunkSize ||
+      tlCurrentPool == this->dataPtr.get() || !loopLock.try_lock())
+  {
+    _func(0u, _count);
+    return;
+  }
+
+  GZ_TRACE("ThreadPool::ParallelFor");
+
+  // A few chunks per thread help balance uneven work
+  const std::size_t threads = this->ThreadCount();
+  std::size_t chunkSize = (_count + threads * 4u - 1u) / (threads * 4u);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->func = &_func;
+    this->dataPtr->count = _count;
+    this->dataPtr->chunkSize = std::max(chunkSize, _minChunkSize);
+    this->dataPtr->nextIndex = 0u;
+    this->dataPtr->activeWorkers =
+        static_cast<unsigned int>(this->dataPtr->workers.size());
+    ++this->dataPtr->generation;
+  }
+  this->dataPtr->startCv.notify_all();
+
+  // The calling thread may be a worker of another pool
+  const ThreadPoolPrivate *outerPool = tlCurrentPool;
+  tlCurrentPool = this->dataPtr.get();
+  this->dataPtr->RunChunks();
+  tlCurrentPool = outerPool;
+
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->doneCv.wait(lock, [this]
+  {
+    return this->dataPtr->activeWorkers == 0u;
+  });
+  this->dataPtr->func = nullptr;
+}
+
+//////////////////////////////////////////////////
+void ThreadPoolPrivate::RunChunks()
+{
+  while (true)
+  {
+    const std::size_t begin = this->nextIndex.fetch_add(this->chunkSize);
+    if (begin >= this->count)
+      break;
+
+    (*this->func)(begin, std::min(begin + this->chunkSize, this->count));
+  }
+}
+
+//////////////////////////////////////////////////
+void ThreadPoolPrivate::Worker(unsigned int _id)
+{
+  std::stringstream ss;
+  ss << "ThreadPoolWorker: " << _id;
+  GZ_TRACE_THREAD_NAME(ss.str().c_str());
+
+  tlCurrentPool = this;
+  uint64_t lastGeneration{0};
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->startCv.wait(lock, [&]
+      {
+        return this->stop || this->generation != lastGeneration;
+      });
+      if (this->stop)
+        return;
+      lastGeneration = this->generation;
+    }
+
+    this->RunChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (--this->activeWorkers == 0u)
+        this->doneCv.notify_all();
+    }
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_THREADPOOL_HH_
+#define IGNITION_GAZEBO_THREADPOOL_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class ThreadPoolPrivate;
+
+    /// \class ThreadPool ThreadPool.hh
+    /// \brief A pool of persistent worker threads used to split loops over
+    /// many independent elements.
+    ///
+    /// Unlike common::WorkerPool, no work order is allocated per task: the
+    /// pool runs a single loop at a time, which is divided in chunks that
+    /// are claimed by the workers and by the calling thread until the loop
+    /// is exhausted.
+    ///
+    /// Calling ParallelFor from within a loop that is already running on the
+    /// pool, or while another thread is using the pool, runs the loop
+    /// serially on the calling thread instead of blocking.
+    class IGNITION_GAZEBO_VISIBLE ThreadPool
+    {
+      /// \brief Constructor
+      /// \param[in] _threadCount Total number of threads that will process a
+      /// loop, including the calling thread. Zero uses the number of
+      /// hardware threads.
+      public: explicit ThreadPool(unsigned int _threadCount = 0u);
+
+      /// \brief Destructor. Stops and joins all worker threads.
+      public: ~ThreadPool();
+
+      /// \brief Get the number of threads that process a loop, including the
+      /// calling thread.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Restrict the worker threads to a set of CPU cores. The
+      /// calling thread of each loop is not affected.
+      /// \param[in] _cores Core numbers.
+      /// \return False if the affinity of any worker couldn't be set.
+      /// \sa setThreadAffinity
+      public: bool SetAffinity(const std::vector<unsigned int> &_cores);
+
+      /// \brief Call a function over the range [0, _count), split in
+      /// contiguous chunks that are processed concurrently. This function
+      /// blocks until the whole range has been processed.
+      /// \param[in] _count Number of elements in the range.
+      /// \param[in] _func Function called with the [begin, end) indices of
+      /// each chunk. It must be safe to call concurrently.
+      /// \param[in] _minChunkSize Minimum number of elements per chunk. Loops
+      /// with fewer elements than this are run on the calling thread.
+      public: void ParallelFor(std::size_t _count,
+                  const std::function<void(std::size_t, std::size_t)> &_func,
+                  std::size_t _minChunkSize = 1u);
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<ThreadPoolPrivate> dataPtr;
+    };
+    }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+  }  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_THREADPOOL_HH_
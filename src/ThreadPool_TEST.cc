@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "ignition/gazebo/Util.hh"
+#include "ThreadPool.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(ThreadPool, ThreadCount)
+{
+  gazebo::ThreadPool single(1u);
+  EXPECT_EQ(1u, single.ThreadCount());
+
+  gazebo::ThreadPool four(4u);
+  EXPECT_EQ(4u, four.ThreadCount());
+
+  gazebo::ThreadPool hardware;
+  EXPECT_GE(hardware.ThreadCount(), 1u);
+}
+
+//////////////////////////////////////////////////
+TEST(ThreadPool, ParallelFor)
+{
+  gazebo::ThreadPool pool(4u);
+
+  // Empty range doesn't call the function
+  bool called{false};
+  pool.ParallelFor(0u, [&](std::size_t, std::size_t)
+  {
+    called = true;
+  });
+  EXPECT_FALSE(called);
+
+  // Every element is visited exactly once, over many loops
+  for (std::size_t count : {1u, 3u, 100u, 10000u})
+  {
+    std::vector<std::atomic<int>> visits(count);
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+      pool.ParallelFor(count, [&](std::size_t _begin, std::size_t _end)
+      {
+        EXPECT_LT(_begin, _end);
+        EXPECT_LE(_end, count);
+        for (std::size_t i = _begin; i < _end; ++i)
+          visits[i]++;
+      });
+    }
+
+    for (const auto &visit : visits)
+      EXPECT_EQ(10, visit.load());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(ThreadPool, Nested)
+{
+  gazebo::ThreadPool pool(4u);
+
+  // Nested loops run serially instead of deadlocking
+  std::atomic<int> total{0};
+  pool.ParallelFor(16u, [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      pool.ParallelFor(8u, [&](std::size_t _b, std::size_t _e)
+      {
+        total += static_cast<int>(_e - _b);
+      });
+    }
+  });
+  EXPECT_EQ(16 * 8, total.load());
+}
+
+//////////////////////////////////////////////////
+TEST(ThreadPool, NestedOtherPool)
+{
+  gazebo::ThreadPool outer(2u);
+  gazebo::ThreadPool inner(4u);
+
+  // A loop of another pool nested in a loop still runs on that pool
+  std::atomic<int> total{0};
+  std::atomic<int> innerChunks{0};
+  outer.ParallelFor(4u, [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      inner.ParallelFor(1000u, [&](std::size_t _b, std::size_t _e)
+      {
+        innerChunks++;
+        total += static_cast<int>(_e - _b);
+      });
+    }
+  });
+  EXPECT_EQ(4 * 1000, total.load());
+  EXPECT_GT(innerChunks.load(), 4);
+}
+
+//////////////////////////////////////////////////
+TEST(ThreadPool, SetAffinity)
+{
+  // A pool without workers has nothing to restrict
+  gazebo::ThreadPool single(1u);
+  EXPECT_TRUE(single.SetAffinity({0u}));
+
+#ifdef __linux__
+  auto allowed = gazebo::threadAffinity();
+  ASSERT_FALSE(allowed.empty());
+
+  gazebo::ThreadPool pool(4u);
+  EXPECT_TRUE(pool.SetAffinity({allowed.front()}));
+  EXPECT_FALSE(pool.SetAffinity({}));
+
+  // The calling thread is unaffected
+  EXPECT_EQ(allowed, gazebo::threadAffinity());
+
+  std::atomic<int> total{0};
+  pool.ParallelFor(64u, [&](std::size_t _begin, std::size_t _end)
+  {
+    total += static_cast<int>(_end - _begin);
+  });
+  EXPECT_EQ(64, total.load());
+#endif
+}
@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gazebo/Tracer.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+
+#include "JsonString.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+namespace
+{
+/// \brief An event of the trace.
+struct TracerEvent
+{
+  /// \brief Name of the event.
+  const char *name;
+
+  /// \brief Start time, in nanoseconds since the trace started.
+  int64_t start;
+
+  /// \brief Duration in nanoseconds.
+  int64_t duration;
+};
+
+/// \brief Ring buffer with the events of a thread. Only its thread writes
+/// events, while the tracer may read them at any time.
+struct TracerBuffer
+{
+  /// \brief Events, indexed by their number modulo the buffer size.
+  std::vector<TracerEvent> events;
+
+  /// \brief Number of events written since the buffer was cleared.
+  std::atomic<uint64_t> count{0u};
+
+  /// \brief Trace the events belong to. Buffers of older traces are
+  /// cleared by their thread when it records its next event.
+  std::atomic<uint64_t> trace{0u};
+
+  /// \brief Id of the thread in the trace.
+  unsigned int thread{0u};
+
+  /// \brief Name of the thread. Protected by the tracer's mutex.
+  std::string name;
+};
+
+/// \brief State of the current thread.
+struct TracerThread
+{
+  /// \brief Buffer of the thread, created when it records its first event.
+  std::shared_ptr<TracerBuffer> buffer;
+
+  /// \brief Events started with Begin which haven't ended. Events started
+  /// while the tracer wasn't running have a null name.
+  std::vector<std::pair<const char *, std::chrono::steady_clock::time_point>>
+      stack;
+
+  /// \brief Name given by SetThreadName.
+  std::string name;
+};
+
+/// \brief State of the current thread.
+thread_local TracerThread tracerThread;
+}
+
+class ignition::gazebo::TracerPrivate
+{
+  /// \brief Get the buffer of the current thread for the running trace,
+  /// creating or clearing it if needed.
+  /// \return The buffer.
+  public: TracerBuffer &Buffer();
+
+  /// \brief Stop the timer thread, if any. Must be called without the
+  /// mutex held.
+  public: void StopTimer();
+
+  /// \brief Whether the tracer is running. This is the only state checked
+  /// when the tracer is stopped.
+  public: std::atomic<bool> active{false};
+
+  /// \brief Number of the running or last trace.
+  public: std::atomic<uint64_t> trace{0u};
+
+  /// \brief Time at which the trace started.
+  public: std::chrono::steady_clock::time_point origin;
+
+  /// \brief Protects everything below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Buffers of all threads which recorded events.
+  public: std::vector<std::shared_ptr<TracerBuffer>> buffers;
+
+  /// \brief Number of events kept per thread.
+  public: std::size_t bufferSize{65536u};
+
+  /// \brief Id of the next thread.
+  public: unsigned int nextThread{1u};
+
+  /// \brief Path of the trace file.
+  public: std::string path;
+
+  /// \brief Thread which stops the trace after its duration.
+  public: std::thread timer;
+
+  /// \brief Protects stopTimer and timer.
+  public: std::mutex timerMutex;
+
+  /// \brief Wakes up the timer thread.
+  public: std::condition_variable timerCv;
+
+  /// \brief Set to stop the timer thread early.
+  public: bool stopTimer{false};
+};
+
+//////////////////////////////////////////////////
+TracerBuffer &TracerPrivate::Buffer()
+{
+  auto &thread = tracerThread;
+  const uint64_t current = this->trace.load(std::memory_order_acquire);
+  if (!thread.buffer)
+  {
+    auto buffer = std::make_shared<TracerBuffer>();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    buffer->events.resize(std::max<std::size_t>(this->bufferSize, 1u));
+    buffer->thread = this->nextThread++;
+    buffer->name = thread.name;
+    buffer->trace = current;
+    this->buffers.push_back(buffer);
+    thread.buffer = std::move(buffer);
+  }
+  else if (thread.buffer->trace.load(std::memory_order_relaxed) != current)
+  {
+    thread.buffer->count.store(0u, std::memory_order_relaxed);
+    thread.buffer->trace.store(current, std::memory_order_release);
+  }
+  return *thread.buffer;
+}
+
+//////////////////////////////////////////////////
+void TracerPrivate::StopTimer()
+{
+  std::unique_lock<std::mutex> lock(this->timerMutex);
+  this->stopTimer = true;
+  this->timerCv.notify_all();
+  if (!this->timer.joinable())
+    return;
+
+  // The timer thread stops the trace itself
+  if (this->timer.get_id() == std::this_thread::get_id())
+  {
+    this->timer.detach();
+    return;
+  }
+  auto timer = std::move(this->timer);
+  lock.unlock();
+  timer.join();
+}
+
+//////////////////////////////////////////////////
+Tracer::Scope::Scope(const char *_name)
+{
+  if (!Tracer::Instance().Active())
+    return;
+
+  this->name = _name;
+  this->start = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+Tracer::Scope::~Scope()
+{
+  if (nullptr == this->name)
+    return;
+
+  Tracer::Instance().Add(this->name, this->start,
+      std::chrono::steady_clock::now());
+}
+
+//////////////////////////////////////////////////
+Tracer &Tracer::Instance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+//////////////////////////////////////////////////
+Tracer::Tracer()
+  : dataPtr(std::make_unique<TracerPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+Tracer::~Tracer()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+std::string Tracer::Start(const std::string &_path,
+    const std::chrono::steady_clock::duration &_duration)
+{
+  if (this->Active())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    ignwarn << "Tracer is already running, writing to ["
+            << this->dataPtr->path << "]." << std::endl;
+    return "";
+  }
+
+  // Wait for the timer of the previous trace, if it's still winding down
+  this->dataPtr->StopTimer();
+
+  std::string path = _path;
+  if (path.empty())
+  {
+    std::string dir = ignLogDirectory();
+    if (dir.empty())
+      dir = common::cwd();
+    path = common::joinPaths(dir,
+        "trace_" + common::systemTimeISO() + ".json");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->active)
+      return "";
+
+    // Forget the buffers of threads which exited
+    auto &buffers = this->dataPtr->buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+        [](const std::shared_ptr<TracerBuffer> &_buffer)
+        {
+          return _buffer.use_count() == 1;
+        }), buffers.end());
+
+    this->dataPtr->path = path;
+    this->dataPtr->origin = std::chrono::steady_clock::now();
+    this->dataPtr->trace.fetch_add(1u, std::memory_order_release);
+    this->dataPtr->active = true;
+  }
+
+  if (_duration > std::chrono::steady_clock::duration::zero())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->timerMutex);
+    this->dataPtr->stopTimer = false;
+    this->dataPtr->timer = std::thread([this, _duration]
+    {
+      {
+        std::unique_lock<std::mutex> timerLock(this->dataPtr->timerMutex);
+        if (this->dataPtr->timerCv.wait_for(timerLock, _duration,
+            [this]{return this->dataPtr->stopTimer;}))
+        {
+          return;
+        }
+      }
+      this->Stop();
+    });
+  }
+
+  ignmsg << "Started tracing to [" << path << "]." << std::endl;
+  return path;
+}
+
+//////////////////////////////////////////////////
+bool Tracer::Stop()
+{
+  this->dataPtr->StopTimer();
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->active)
+      return false;
+    this->dataPtr->active = false;
+    path = this->dataPtr->path;
+  }
+
+  std::ofstream file(path);
+  file << this->Json();
+  if (!file.good())
+  {
+    ignerr << "Failed to write trace [" << path << "]." << std::endl;
+    return false;
+  }
+  ignmsg << "Wrote trace [" << path << "]." << std::endl;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Tracer::Active() const
+{
+  return this->dataPtr->active.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void Tracer::SetBufferSize(std::size_t _events)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->bufferSize = _events;
+}
+
+//////////////////////////////////////////////////
+void Tracer::Begin(const char *_name)
+{
+  // Events are always pushed, so that End matches the right Begin even if
+  // the tracer started in between
+  auto &stack = tracerThread.stack;
+  if (!this->Active())
+    stack.emplace_back(nullptr, std::chrono::steady_clock::time_point());
+  else
+    stack.emplace_back(_name, std::chrono::steady_clock::now());
+}
+
+//////////////////////////////////////////////////
+void Tracer::End()
+{
+  auto &stack = tracerThread.stack;
+  if (stack.empty())
+    return;
+
+  auto event = stack.back();
+  stack.pop_back();
+  if (nullptr != event.first)
+    this->Add(event.first, event.second, std::chrono::steady_clock::now());
+}
+
+//////////////////////////////////////////////////
+void Tracer::SetThreadName(const std::string &_name)
+{
+  // Some threads are named on every callback
+  if (tracerThread.name == _name)
+    return;
+
+  tracerThread.name = _name;
+  if (tracerThread.buffer)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    tracerThread.buffer->name = _name;
+  }
+}
+
+//////////////////////////////////////////////////
+void Tracer::Add(const char *_name,
+    const std::chrono::steady_clock::time_point &_start,
+    const std::chrono::steady_clock::time_point &_end)
+{
+  // Acquire, so that the trace's origin is seen
+  if (!this->dataPtr->active.load(std::memory_order_acquire))
+    return;
+
+  auto &buffer = this->dataPtr->Buffer();
+  const uint64_t index = buffer.count.load(std::memory_order_relaxed);
+  auto &event = buffer.events[index % buffer.events.size()];
+  event.name = _name;
+  event.start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _start - this->dataPtr->origin).count();
+  event.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _end - _start).count();
+  buffer.count.store(index + 1u, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+std::string Tracer::Json() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const uint64_t current = this->dataPtr->trace.load(std::memory_order_acquire);
+  // All events belong to this process
+  const int pid{1};
+
+  std::ostringstream json;
+  json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{true};
+  auto separator = [&]()
+  {
+    if (!first)
+      json << ",";
+    first = false;
+  };
+
+  std::vector<TracerEvent> events;
+  for (const auto &buffer : this->dataPtr->buffers)
+  {
+    if (buffer->trace.load(std::memory_order_acquire) != current)
+      continue;
+
+    if (!buffer->name.empty())
+    {
+      separator();
+      json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+           << ",\"tid\":" << buffer->thread << ",\"args\":{\"name\":"
+           << jsonString(buffer->name) << "}}";
+    }
+
+    // Copy the events, then drop those which may have been overwritten
+    // while they were copied
+    const uint64_t size = buffer->events.size();
+    const uint64_t count = buffer->count.load(std::memory_order_acquire);
+    uint64_t begin = count > size ? count - size : 0u;
+    events.clear();
+    for (uint64_t i = begin; i < count; ++i)
+      events.push_back(buffer->events[i % size]);
+    const uint64_t after = buffer->count.load(std::memory_order_acquire);
+    const uint64_t valid = after > size ? after - size : 0u;
+    const std::size_t skip = static_cast<std::size_t>(
+        valid > begin ? std::min(valid - begin, count - begin) : 0u);
+
+    for (std::size_t i = skip; i < events.size(); ++i)
+    {
+      const auto &event = events[i];
+      if (nullptr == event.name)
+        continue;
+      separator();
+      char times[64];
+      std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+          event.start * 1e-3, event.duration * 1e-3);
+      json << "{\"name\":" << jsonString(event.name)
+           << ",\"cat\":\"ign\",\"ph\":\"X\"," << times
+           << ",\"pid\":" << pid << ",\"tid\":" << buffer->thread << "}";
+    }
+  }
+  json << "]}";
+  return json.str();
+}
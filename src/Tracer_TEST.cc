@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "ignition/gazebo/Profiler.hh"
+#include "ignition/gazebo/Tracer.hh"
+#include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Path of the trace file used by the tests.
+static const std::string kTracePath = common::joinPaths(  // NOLINT
+    PROJECT_BINARY_PATH, "test_tracer.json");
+
+/////////////////////////////////////////////////
+TEST(TracerTest, Inactive)
+{
+  auto &tracer = Tracer::Instance();
+  EXPECT_FALSE(tracer.Active());
+  EXPECT_FALSE(tracer.Stop());
+
+  // Events are ignored while the tracer is stopped
+  {
+    GZ_TRACE("TracerTest::Ignored");
+  }
+  ASSERT_FALSE(tracer.Start(kTracePath).empty());
+  EXPECT_EQ(std::string::npos, tracer.Json().find("TracerTest::Ignored"));
+  EXPECT_TRUE(tracer.Stop());
+}
+
+/////////////////////////////////////////////////
+TEST(TracerTest, Events)
+{
+  common::removeFile(kTracePath);
+
+  auto &tracer = Tracer::Instance();
+  EXPECT_EQ(kTracePath, tracer.Start(kTracePath));
+  EXPECT_TRUE(tracer.Active());
+
+  // Already running
+  EXPECT_TRUE(tracer.Start(kTracePath).empty());
+
+  GZ_TRACE_THREAD_NAME("Test \"main\"");
+  {
+    GZ_TRACE("TracerTest::Scope");
+  }
+  GZ_TRACE_BEGIN("TracerTest::Begin");
+  GZ_TRACE_END();
+
+  std::thread thread([]
+  {
+    GZ_TRACE_THREAD_NAME("Test worker");
+    GZ_TRACE("TracerTest::Worker");
+  });
+  thread.join();
+
+  EXPECT_TRUE(tracer.Stop());
+  EXPECT_FALSE(tracer.Active());
+  ASSERT_TRUE(common::exists(kTracePath));
+
+  std::ifstream file(kTracePath);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const auto json = contents.str();
+  EXPECT_EQ(tracer.Json(), json);
+
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos,
+      json.find("{\"name\":\"TracerTest::Scope\",\"cat\":\"ign\","
+                "\"ph\":\"X\",\"ts\":"));
+  EXPECT_NE(std::string::npos, json.find("\"TracerTest::Begin\""));
+  EXPECT_NE(std::string::npos, json.find("\"TracerTest::Worker\""));
+  EXPECT_NE(std::string::npos, json.find("{\"name\":\"Test \\\"main\\\"\"}"));
+  EXPECT_NE(std::string::npos, json.find("{\"name\":\"Test worker\"}"));
+
+  // A new trace starts empty
+  ASSERT_FALSE(tracer.Start(kTracePath).empty());
+  EXPECT_EQ(std::string::npos, tracer.Json().find("TracerTest::Scope"));
+  EXPECT_TRUE(tracer.Stop());
+}
+
+/////////////////////////////////////////////////
+TEST(TracerTest, RingBuffer)
+{
+  auto &tracer = Tracer::Instance();
+  tracer.SetBufferSize(4u);
+
+  // Run on a new thread, so that it gets a buffer of the new size
+  ASSERT_FALSE(tracer.Start(kTracePath).empty());
+  std::thread thread([]
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      GZ_TRACE("TracerTest::Ring");
+    }
+  });
+  thread.join();
+
+  // Only the most recent events are kept
+  const auto json = tracer.Json();
+  std::size_t count{0u};
+  for (auto pos = json.find("TracerTest::Ring"); pos != std::string::npos;
+       pos = json.find("TracerTest::Ring", pos + 1))
+  {
+    ++count;
+  }
+  EXPECT_EQ(4u, count);
+
+  EXPECT_TRUE(tracer.Stop());
+  tracer.SetBufferSize(65536u);
+}
+
+/////////////////////////////////////////////////
+TEST(TracerTest, Duration)
+{
+  common::removeFile(kTracePath);
+
+  auto &tracer = Tracer::Instance();
+  ASSERT_FALSE(tracer.Start(kTracePath, std::chrono::milliseconds(10))
+      .empty());
+
+  // Stops by itself
+  for (int i = 0; i < 200 && tracer.Active(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(tracer.Active());
+  EXPECT_TRUE(common::exists(kTracePath));
+  EXPECT_FALSE(tracer.Stop());
+}
@@ -30,6 +30,13 @@
   #endif
 #endif
 
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+#include <algorithm>
+
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/StringUtils.hh>
 #include <ignition/common/Util.hh>
@@ -76,17 +83,14 @@ math::Pose3d worldPose(const Entity &_entity,
 
   // work out pose in world frame
   math::Pose3d pose = poseComp->Data();
-  auto p = _ecm.Component<components::ParentEntity>(_entity);
-  while (p)
+  for (const Entity ancestor : _ecm.Ancestors(_entity))
   {
     // get pose of parent entity
-    auto parentPose = _ecm.Component<components::Pose>(p->Data());
+    auto parentPose = _ecm.Component<components::Pose>(ancestor);
     if (!parentPose)
       break;
     // transform pose
     pose = parentPose->Data() * pose;
-    // keep going up the tree
-    p = _ecm.Component<components::ParentEntity>(p->Data());
   }
   return pose;
 }
@@ -500,22 +504,16 @@ void addResourcePaths(const std::vector<std::string> &_paths)
 ignition::gazebo::Entity topLevelModel(const Entity &_entity,
     const EntityComponentManager &_ecm)
 {
-  auto entity = _entity;
-
   // search up the entity tree and find the model with no parent models
   // (there is the possibility of nested models)
   Entity modelEntity = kNullEntity;
-  while (entity)
-  {
-    if (_ecm.Component<components::Model>(entity))
-      modelEntity = entity;
-
-    // stop searching if we are at the root of the tree
-    auto parentComp = _ecm.Component<components::ParentEntity>(entity);
-    if (!parentComp)
-      break;
+  if (_entity && _ecm.Component<components::Model>(_entity))
+    modelEntity = _entity;
 
-    entity = parentComp->Data();
+  for (const Entity ancestor : _ecm.Ancestors(_entity))
+  {
+    if (_ecm.Component<components::Model>(ancestor))
+      modelEntity = ancestor;
   }
 
   return modelEntity;
@@ -656,6 +654,115 @@ std::string resolveSdfWorldFile(const std::string &_sdfFile,
 
   return filePath;
 }
+
+//////////////////////////////////////////////////
+std::optional<std::vector<unsigned int>> parseCoreList(
+    const std::string &_list)
+{
+  std::vector<unsigned int> cores;
+  for (const auto &item : common::split(_list, ","))
+  {
+    const auto range = common::split(common::trimmed(item), "-");
+    if (range.empty() || range.size() > 2u)
+      return std::nullopt;
+
+    unsigned long first{0u};
+    unsigned long last{0u};
+    try
+    {
+      std::size_t pos{0u};
+      first = std::stoul(range.front(), &pos);
+      if (pos != range.front().size())
+        return std::nullopt;
+      last = std::stoul(range.back(), &pos);
+      if (pos != range.back().size())
+        return std::nullopt;
+    }
+    catch (...)
+    {
+      return std::nullopt;
+    }
+
+    // Ranges larger than any machine are most likely typos
+    if (first > last || last >= 4096u)
+      return std::nullopt;
+
+    for (auto core = first; core <= last; ++core)
+      cores.push_back(static_cast<unsigned int>(core));
+  }
+
+  if (cores.empty())
+    return std::nullopt;
+
+  std::sort(cores.begin(), cores.end());
+  cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+  return cores;
+}
+
+#ifdef __linux__
+//////////////////////////////////////////////////
+/// \brief Fill a CPU set.
+/// \param[in] _cores Core numbers.
+/// \param[out] _set Set with the cores which fit in it.
+/// \return False if no core fits.
+static bool toCpuSet(const std::vector<unsigned int> &_cores,
+    cpu_set_t &_set)
+{
+  CPU_ZERO(&_set);
+  for (const auto core : _cores)
+  {
+    if (core < CPU_SETSIZE)
+      CPU_SET(core, &_set);
+  }
+  return CPU_COUNT(&_set) > 0;
+}
+#endif
+
+//////////////////////////////////////////////////
+bool setThreadAffinity(const std::vector<unsigned int> &_cores)
+{
+#ifdef __linux__
+  cpu_set_t set;
+  return toCpuSet(_cores, set) &&
+      pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)_cores;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+bool setThreadAffinity(std::thread &_thread,
+    const std::vector<unsigned int> &_cores)
+{
+#ifdef __linux__
+  cpu_set_t set;
+  return _thread.joinable() && toCpuSet(_cores, set) &&
+      pthread_setaffinity_np(_thread.native_handle(), sizeof(set), &set) == 0;
+#else
+  (void)_thread;
+  (void)_cores;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+std::vector<unsigned int> threadAffinity()
+{
+  std::vector<unsigned int> cores;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    return cores;
+  for (unsigned int core = 0; core < CPU_SETSIZE; ++core)
+  {
+    if (CPU_ISSET(core, &set))
+      cores.push_back(core);
+  }
+#endif
+  return cores;
+}
 }
 }
 }
@@ -15,6 +15,9 @@
  *
 */
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <ignition/common/Console.hh>
 #include <sdf/Actor.hh>
@@ -757,3 +760,45 @@ TEST_F(UtilTest, ResolveSdfWorldFile)
   // A bad relative path should return an empty string
   EXPECT_TRUE(resolveSdfWorldFile("../invalid/does_not_exist.sdf").empty());
 }
+
+/////////////////////////////////////////////////
+TEST_F(UtilTest, ParseCoreList)
+{
+  auto cores = parseCoreList("0-3,8, 10-11");
+  ASSERT_TRUE(cores.has_value());
+  EXPECT_EQ((std::vector<unsigned int>{0, 1, 2, 3, 8, 10, 11}), *cores);
+
+  // Sorted and without duplicates
+  cores = parseCoreList("5,1-2,2");
+  ASSERT_TRUE(cores.has_value());
+  EXPECT_EQ((std::vector<unsigned int>{1, 2, 5}), *cores);
+
+  EXPECT_FALSE(parseCoreList("").has_value());
+  EXPECT_FALSE(parseCoreList("a").has_value());
+  EXPECT_FALSE(parseCoreList("1-").has_value());
+  EXPECT_FALSE(parseCoreList("3-1").has_value());
+  EXPECT_FALSE(parseCoreList("1-2-3").has_value());
+  EXPECT_FALSE(parseCoreList("2x").has_value());
+  EXPECT_FALSE(parseCoreList("0-100000").has_value());
+}
+
+/////////////////////////////////////////////////
+TEST_F(UtilTest, ThreadAffinity)
+{
+  EXPECT_FALSE(setThreadAffinity(std::vector<unsigned int>()));
+
+#ifdef __linux__
+  auto allowed = threadAffinity();
+  ASSERT_FALSE(allowed.empty());
+
+  std::thread thread([&]
+  {
+    EXPECT_TRUE(setThreadAffinity({allowed.front()}));
+    EXPECT_EQ(std::vector<unsigned int>{allowed.front()}, threadAffinity());
+  });
+  thread.join();
+
+  // The calling thread is unaffected
+  EXPECT_EQ(allowed, threadAffinity());
+#endif
+}
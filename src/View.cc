@@ -17,6 +17,13 @@
 
 #include "ignition/gazebo/detail/View.hh"
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "MemoryEstimate.hh"
+
 namespace ignition
 {
 namespace gazebo
@@ -29,66 +36,231 @@ namespace detail
 View::View(const std::set<ComponentTypeId>& _compIds)
 {
   this->componentTypes = _compIds;
+  this->MutableState().stride = _compIds.size();
 }
 
 //////////////////////////////////////////////////
-const std::vector<const components::BaseComponent *>
-    &View::EntityComponentConstData(const Entity _entity) const
+View::View(const std::set<ComponentTypeId> &_compIds,
+    const std::set<ComponentTypeId> &_excludedIds,
+    const std::set<ComponentTypeId> &_optionalIds,
+    const std::size_t _stride)
 {
-  return this->validConstData.at(_entity);
+  this->componentTypes = _compIds;
+  auto &state = this->MutableState();
+  state.excludedTypes = _excludedIds;
+  state.optionalTypes = _optionalIds;
+  state.stride = _stride;
 }
 
 //////////////////////////////////////////////////
-const std::vector<components::BaseComponent *> &View::EntityComponentData(
-    const Entity _entity) const
+void View::AddEntityWithData(const Entity _entity, const bool _new,
+    components::BaseComponent *const *_data)
 {
-  return this->validData.at(_entity);
+  this->InsertValid(this->MutableState(), _entity, _data);
+  if (_new)
+    this->newEntities.insert(_entity);
 }
 
 //////////////////////////////////////////////////
-bool View::HasCachedComponentData(const Entity _entity) const
+void View::InsertValid(ViewState &_state, const Entity _entity,
+    components::BaseComponent *const *_data)
 {
-  auto cachedComps =
-    this->validData.find(_entity) != this->validData.end() ||
-    this->invalidData.find(_entity) != this->invalidData.end();
-  auto cachedConstComps =
-    this->validConstData.find(_entity) != this->validConstData.end() ||
-    this->invalidConstData.find(_entity) != this->invalidConstData.end();
+  // Entities are usually created in increasing id order, so this is almost
+  // always an append
+  auto iter = std::lower_bound(_state.packedEntities.begin(),
+      _state.packedEntities.end(), _entity);
+  const auto index =
+      static_cast<std::size_t>(iter - _state.packedEntities.begin());
+  _state.packedEntities.insert(iter, _entity);
+  this->entities.insert(_entity);
+  auto dataIter = _state.validData.begin() +
+      static_cast<std::ptrdiff_t>(index * _state.stride);
+  _state.validData.insert(dataIter, _data, _data + _state.stride);
+}
+
+//////////////////////////////////////////////////
+void View::AddEntityWithPartialData(const Entity _entity, const bool _new,
+    components::BaseComponent *const *_data, const bool _const)
+{
+  auto &state = this->MutableState();
+  const auto index = state.IndexOf(_entity);
+  if (index < state.packedEntities.size())
+  {
+    std::copy_n(_data, state.stride, state.validData.begin() +
+        static_cast<std::ptrdiff_t>(index * state.stride));
+
+    // The data is cached once it was given both as const and non-const
+    auto partialIter = state.partialData.find(_entity);
+    if (partialIter != state.partialData.end() &&
+        partialIter->second != _const)
+    {
+      state.partialData.erase(partialIter);
+    }
+  }
+  else
+  {
+    this->InsertValid(state, _entity, _data);
+    state.partialData[_entity] = _const;
+  }
+
+  if (_new)
+    this->newEntities.insert(_entity);
+}
 
-  if (cachedComps && !cachedConstComps)
+//////////////////////////////////////////////////
+View::ConstComponentData View::EntityComponentConstData(
+    const Entity _entity) const
+{
+  const auto &state = this->State();
+  const auto ptrs = state.ComponentDataFor(_entity);
+  if (nullptr == ptrs)
+  {
+    throw std::out_of_range("Entity [" + std::to_string(_entity) +
+        "] is not part of the view");
+  }
+  return ConstComponentData(ptrs, ptrs + state.stride);
+}
+
+//////////////////////////////////////////////////
+View::ComponentData View::EntityComponentData(const Entity _entity) const
+{
+  const auto &state = this->State();
+  const auto ptrs = state.ComponentDataFor(_entity);
+  if (nullptr == ptrs)
   {
-    ignwarn << "Non-const component data is cached for entity " << _entity
-      << ", but const component data is not cached." << std::endl;
+    throw std::out_of_range("Entity [" + std::to_string(_entity) +
+        "] is not part of the view");
   }
-  else if (cachedConstComps && !cachedComps)
+  return ComponentData(ptrs, ptrs + state.stride);
+}
+
+//////////////////////////////////////////////////
+components::BaseComponent *const *View::ComponentDataFor(
+    const Entity _entity) const
+{
+  return this->State().ComponentDataFor(_entity);
+}
+
+//////////////////////////////////////////////////
+components::BaseComponent *const *View::ComponentDataAt(
+    const std::size_t _index) const
+{
+  return this->State().ComponentDataAt(_index);
+}
+
+//////////////////////////////////////////////////
+std::size_t View::NextIndex(const std::size_t _index,
+    const Entity _entity) const
+{
+  return this->State().NextIndex(_index, _entity);
+}
+
+//////////////////////////////////////////////////
+bool View::HasCachedComponentData(const Entity _entity) const
+{
+  const auto &partialData = this->State().partialData;
+  if (!partialData.empty())
   {
-    ignwarn << "Const component data is cached for entity " << _entity
-      << ", but non-const component data is not cached." << std::endl;
+    auto partialIter = partialData.find(_entity);
+    if (partialIter != partialData.end())
+    {
+      if (partialIter->second)
+      {
+        ignwarn << "Const component data is cached for entity " << _entity
+          << ", but non-const component data is not cached." << std::endl;
+      }
+      else
+      {
+        ignwarn << "Non-const component data is cached for entity "
+          << _entity << ", but const component data is not cached."
+          << std::endl;
+      }
+      return false;
+    }
   }
 
-  return cachedComps && cachedConstComps;
+  return this->HasEntity(_entity) ||
+    this->invalidData.find(_entity) != this->invalidData.end();
 }
 
 //////////////////////////////////////////////////
 bool View::RemoveEntity(const Entity _entity)
 {
   this->invalidData.erase(_entity);
-  this->invalidConstData.erase(_entity);
   this->missingCompTracker.erase(_entity);
 
   if (!this->HasEntity(_entity) && !this->IsEntityMarkedForAddition(_entity))
     return false;
 
-  this->entities.erase(_entity);
+  auto &state = this->MutableState();
+  state.partialData.erase(_entity);
+  const auto index = state.IndexOf(_entity);
+  if (index < state.packedEntities.size())
+  {
+    state.packedEntities.erase(state.packedEntities.begin() +
+        static_cast<std::ptrdiff_t>(index));
+    this->entities.erase(_entity);
+    auto dataBegin = state.validData.begin() +
+        static_cast<std::ptrdiff_t>(index * state.stride);
+    state.validData.erase(dataBegin,
+        dataBegin + static_cast<std::ptrdiff_t>(state.stride));
+  }
   this->newEntities.erase(_entity);
   this->toRemoveEntities.erase(_entity);
   this->toAddEntities.erase(_entity);
-  this->validData.erase(_entity);
-  this->validConstData.erase(_entity);
 
   return true;
 }
 
+//////////////////////////////////////////////////
+void View::RemoveEntities(const std::vector<Entity> &_entities)
+{
+  if (_entities.empty())
+    return;
+
+  // Both lists are sorted, so a single pass finds and compacts out all the
+  // removed entities
+  auto &state = this->MutableState();
+  std::size_t kept{0};
+  auto removed = _entities.begin();
+  for (std::size_t i = 0; i < state.packedEntities.size(); ++i)
+  {
+    const Entity entity = state.packedEntities[i];
+    removed = std::lower_bound(removed, _entities.end(), entity);
+    if (removed != _entities.end() && *removed == entity)
+      continue;
+
+    if (kept != i)
+    {
+      state.packedEntities[kept] = entity;
+      std::copy_n(state.validData.begin() +
+          static_cast<std::ptrdiff_t>(i * state.stride), state.stride,
+          state.validData.begin() +
+          static_cast<std::ptrdiff_t>(kept * state.stride));
+    }
+    ++kept;
+  }
+  state.packedEntities.resize(kept);
+  state.validData.resize(kept * state.stride);
+
+  for (const Entity entity : _entities)
+  {
+    this->entities.erase(entity);
+    if (!state.partialData.empty())
+      state.partialData.erase(entity);
+    if (!this->invalidData.empty())
+      this->invalidData.erase(entity);
+    if (!this->missingCompTracker.empty())
+      this->missingCompTracker.erase(entity);
+    if (!this->newEntities.empty())
+      this->newEntities.erase(entity);
+    if (!this->toRemoveEntities.empty())
+      this->toRemoveEntities.erase(entity);
+    if (!this->toAddEntities.empty())
+      this->toAddEntities.erase(entity);
+  }
+}
+
 //////////////////////////////////////////////////
 bool View::NotifyComponentAddition(const Entity _entity,
     bool _newEntity, const ComponentTypeId _typeId)
@@ -113,11 +285,13 @@ bool View::NotifyComponentAddition(const Entity _entity,
   // view, then add the entity back to the view
   if (missingCompsIter->second.empty())
   {
-    auto nh = this->invalidData.extract(_entity);
-    this->validData.insert(std::move(nh));
-    auto constCompNh = this->invalidConstData.extract(_entity);
-    this->validConstData.insert(std::move(constCompNh));
-    this->entities.insert(_entity);
+    auto invalidIter = this->invalidData.find(_entity);
+    if (invalidIter != this->invalidData.end())
+    {
+      this->InsertValid(this->MutableState(), _entity,
+          invalidIter->second.data());
+      this->invalidData.erase(invalidIter);
+    }
     if (_newEntity)
       this->newEntities.insert(_entity);
     this->missingCompTracker.erase(_entity);
@@ -143,15 +317,17 @@ bool View::NotifyComponentRemoval(const Entity _entity,
   // if the component being removed is the first component that causes _entity
   // to be invalid for this view, move _entity from validData to invalidData
   // since _entity should no longer be considered a part of the view
-  auto it = this->validData.find(_entity);
-  auto constCompIt = this->validConstData.find(_entity);
-  if (it != this->validData.end() &&
-      constCompIt != this->validConstData.end())
+  auto &state = this->MutableState();
+  const auto index = state.IndexOf(_entity);
+  if (index < state.packedEntities.size())
   {
-    auto nh = this->validData.extract(it);
-    this->invalidData.insert(std::move(nh));
-    auto constCompNh = this->validConstData.extract(constCompIt);
-    this->invalidConstData.insert(std::move(constCompNh));
+    auto dataBegin = state.validData.begin() +
+        static_cast<std::ptrdiff_t>(index * state.stride);
+    auto dataEnd = dataBegin + static_cast<std::ptrdiff_t>(state.stride);
+    this->invalidData[_entity] = ComponentData(dataBegin, dataEnd);
+    state.validData.erase(dataBegin, dataEnd);
+    state.packedEntities.erase(state.packedEntities.begin() +
+        static_cast<std::ptrdiff_t>(index));
     this->entities.erase(_entity);
     this->newEntities.erase(_entity);
   }
@@ -172,13 +348,45 @@ void View::Reset()
   this->toAddEntities.clear();
 
   // reset all data structures unique to the templated view
-  this->validData.clear();
-  this->validConstData.clear();
+  auto &state = this->MutableState();
+  state.packedEntities.clear();
+  state.validData.clear();
+  state.partialData.clear();
   this->invalidData.clear();
-  this->invalidConstData.clear();
   this->missingCompTracker.clear();
 }
 
+//////////////////////////////////////////////////
+std::size_t View::MemoryUsage() const
+{
+  const auto &state = this->State();
+  std::size_t bytes = sizeof(*this) + sizeof(state) +
+      treeBytes(this->entities) + vectorBytes(state.packedEntities) +
+      vectorBytes(state.validData) + treeBytes(this->newEntities) +
+      treeBytes(this->toRemoveEntities) + hashBytes(this->toAddEntities) +
+      treeBytes(this->componentTypes) + treeBytes(state.excludedTypes) +
+      treeBytes(state.optionalTypes) + hashBytes(state.partialData) +
+      hashBytes(this->invalidData) +
+      hashBytes(this->missingCompTracker);
+  for (const auto &data : this->invalidData)
+    bytes += vectorBytes(data.second);
+  for (const auto &missing : this->missingCompTracker)
+    bytes += hashBytes(missing.second);
+  return bytes;
+}
+
+//////////////////////////////////////////////////
+void View::Compact()
+{
+  auto &state = this->MutableState();
+  compactVector(state.packedEntities);
+  compactVector(state.validData);
+  compactHash(state.partialData);
+  compactHash(this->toAddEntities);
+  compactHash(this->invalidData);
+  compactHash(this->missingCompTracker);
+}
+
 }  // namespace detail
 }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 }  // namespace gazebo
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "WorldCache.hh"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+
+#include "BinaryStream.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Identifies world cache files.
+static constexpr std::array<char, 8> kMagic{
+    {'I', 'G', 'N', 'W', 'C', 'A', 'C', 'H'}};
+
+/// \brief Version of the file layout. Increment when it changes.
+static constexpr uint32_t kFormatVersion{1u};
+
+//////////////////////////////////////////////////
+template<typename T>
+static bool readValue(std::istream &_in, T &_value)
+{
+  return static_cast<bool>(
+      _in.read(reinterpret_cast<char *>(&_value), sizeof(T)));
+}
+
+//////////////////////////////////////////////////
+static bool readString(std::istream &_in, std::string &_value,
+    const uint64_t _fileSize)
+{
+  // Reject sizes past the end of the file before allocating
+  uint64_t size{0u};
+  if (!readValue(_in, size) ||
+      size > _fileSize - static_cast<uint64_t>(_in.tellg()))
+  {
+    return false;
+  }
+
+  _value.resize(size);
+  return static_cast<bool>(
+      _in.read(_value.data(), static_cast<std::streamsize>(size)));
+}
+
+//////////////////////////////////////////////////
+uint64_t ignition::gazebo::worldCacheHash(const std::string &_source)
+{
+  const std::string key = std::string(IGNITION_GAZEBO_VERSION_FULL) + '\n' +
+      std::to_string(kFormatVersion) + '\n' + _source;
+  return common::hash64(std::string_view(key));
+}
+
+//////////////////////////////////////////////////
+bool ignition::gazebo::saveWorldCache(const std::string &_path,
+    const WorldCache &_cache)
+{
+  const std::string tmpPath = _path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      ignerr << "Failed to open world cache [" << tmpPath << "] for writing."
+             << std::endl;
+      return false;
+    }
+
+    out.write(kMagic.data(), kMagic.size());
+    writeValue(out, kFormatVersion);
+    writeValue(out, _cache.sourceHash);
+    writeString(out, _cache.sdf);
+    writeValue<uint64_t>(out, _cache.fuelUriMap.size());
+    for (const auto &[path, uri] : _cache.fuelUriMap)
+    {
+      writeString(out, path);
+      writeString(out, uri);
+    }
+
+    if (!out.flush())
+    {
+      ignerr << "Failed to write world cache [" << tmpPath << "]."
+             << std::endl;
+      return false;
+    }
+  }
+
+  if (!common::moveFile(tmpPath, _path))
+  {
+    ignerr << "Failed to move world cache [" << tmpPath << "] to [" << _path
+           << "]." << std::endl;
+    common::removeFile(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::optional<WorldCache> ignition::gazebo::loadWorldCache(
+    const std::string &_path, uint64_t _sourceHash)
+{
+  std::ifstream in(_path, std::ios::binary | std::ios::ate);
+  if (!in)
+    return std::nullopt;
+  const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+  in.seekg(0);
+
+  std::array<char, kMagic.size()> magic{};
+  uint32_t version{0u};
+  WorldCache cache;
+  if (!in.read(magic.data(), magic.size()) || magic != kMagic ||
+      !readValue(in, version) || version != kFormatVersion ||
+      !readValue(in, cache.sourceHash))
+  {
+    ignwarn << "Ignoring world cache [" << _path << "], it isn't a world "
+            << "cache or was written by another version." << std::endl;
+    return std::nullopt;
+  }
+
+  // A cache of another world, or of an older version of this one
+  if (cache.sourceHash != _sourceHash)
+  {
+    igndbg << "World cache [" << _path << "] doesn't match the world."
+           << std::endl;
+    return std::nullopt;
+  }
+
+  uint64_t uriCount{0u};
+  bool valid = readString(in, cache.sdf, fileSize) && readValue(in, uriCount);
+  for (uint64_t i = 0; valid && i < uriCount; ++i)
+  {
+    std::string path;
+    std::string uri;
+    valid = readString(in, path, fileSize) &&
+        readString(in, uri, fileSize);
+    if (valid)
+      cache.fuelUriMap[path] = uri;
+  }
+
+  if (!valid)
+  {
+    ignwarn << "Ignoring truncated world cache [" << _path << "]."
+            << std::endl;
+    return std::nullopt;
+  }
+  return cache;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_WORLDCACHE_HH_
+#define IGNITION_GAZEBO_WORLDCACHE_HH_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Contents of a world cache file.
+    ///
+    /// A cache holds a world generated from a fully loaded entity component
+    /// manager, with all includes expanded and all URIs resolved to local
+    /// paths, along with the Fuel URIs of the resources that were fetched
+    /// while loading it. It's keyed by a hash of the SDF it was loaded from.
+    struct WorldCache
+    {
+      /// \brief Hash of the SDF the world was loaded from.
+      uint64_t sourceHash{0u};
+
+      /// \brief Generated world SDF.
+      std::string sdf;
+
+      /// \brief Map from local paths to the Fuel URIs they were fetched
+      /// from.
+      std::unordered_map<std::string, std::string> fuelUriMap;
+    };
+
+    /// \brief Hash the source of a world. The hash also covers the version
+    /// of this library, so caches written by other versions don't match.
+    /// \param[in] _source SDF string, or contents of the SDF file.
+    /// \return Hash of the source.
+    IGNITION_GAZEBO_VISIBLE
+    uint64_t worldCacheHash(const std::string &_source);
+
+    /// \brief Write a world cache file. The file is replaced atomically, so
+    /// readers never see a partial cache.
+    /// \param[in] _path Path to the cache file.
+    /// \param[in] _cache Contents of the cache.
+    /// \return True if the file was written.
+    IGNITION_GAZEBO_VISIBLE
+    bool saveWorldCache(const std::string &_path, const WorldCache &_cache);
+
+    /// \brief Read a world cache file.
+    /// \param[in] _path Path to the cache file.
+    /// \param[in] _sourceHash Expected hash of the source, from
+    /// worldCacheHash.
+    /// \return Contents of the cache, or nullopt if the file doesn't exist,
+    /// is invalid or was written for another source.
+    IGNITION_GAZEBO_VISIBLE
+    std::optional<WorldCache> loadWorldCache(const std::string &_path,
+        uint64_t _sourceHash);
+    }
+  }
+}
+#endif
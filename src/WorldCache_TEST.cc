@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "ignition/gazebo/test_config.hh"
+#include "WorldCache.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+TEST(WorldCache, Hash)
+{
+  EXPECT_EQ(worldCacheHash("<sdf/>"), worldCacheHash("<sdf/>"));
+  EXPECT_NE(worldCacheHash("<sdf/>"), worldCacheHash("<sdf />"));
+}
+
+/////////////////////////////////////////////////
+TEST(WorldCache, SaveLoad)
+{
+  const std::string path = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_world_cache.bin");
+  common::removeFile(path);
+  EXPECT_FALSE(loadWorldCache(path, 1u).has_value());
+
+  WorldCache cache;
+  cache.sourceHash = worldCacheHash("source");
+  cache.sdf = "<sdf version='1.6'><world name='default'/></sdf>";
+  cache.fuelUriMap["/home/user/.ignition/fuel/model"] =
+      "https://fuel.ignitionrobotics.org/1.0/user/models/model";
+  ASSERT_TRUE(saveWorldCache(path, cache));
+  EXPECT_FALSE(common::exists(path + ".tmp"));
+
+  auto loaded = loadWorldCache(path, cache.sourceHash);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(cache.sourceHash, loaded->sourceHash);
+  EXPECT_EQ(cache.sdf, loaded->sdf);
+  EXPECT_EQ(cache.fuelUriMap, loaded->fuelUriMap);
+
+  // Another source
+  EXPECT_FALSE(loadWorldCache(path, worldCacheHash("other")).has_value());
+
+  // Overwrite
+  cache.sdf = "<sdf version='1.6'><world name='other'/></sdf>";
+  ASSERT_TRUE(saveWorldCache(path, cache));
+  loaded = loadWorldCache(path, cache.sourceHash);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(cache.sdf, loaded->sdf);
+
+  // Truncated file
+  std::string contents;
+  {
+    std::ifstream in(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 10u);
+  }
+  EXPECT_FALSE(loadWorldCache(path, cache.sourceHash).has_value());
+
+  // Not a cache
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "<sdf version='1.6'/>";
+  }
+  EXPECT_FALSE(loadWorldCache(path, cache.sourceHash).has_value());
+
+  common::removeFile(path);
+}
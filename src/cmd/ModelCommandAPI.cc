@@ -30,6 +30,7 @@
 #include <sdf/Noise.hh>
 #include <sdf/Sensor.hh>
 
+#include <ignition/msgs/param.pb.h>
 #include <ignition/msgs/serialized.pb.h>
 #include <ignition/msgs/stringmsg.pb.h>
 
@@ -40,6 +41,7 @@
 #include <ignition/gazebo/components/Altimeter.hh>
 #include <ignition/gazebo/components/Camera.hh>
 #include <ignition/gazebo/components/ChildLinkName.hh>
+#include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/GpuLidar.hh>
 #include <ignition/gazebo/components/Imu.hh>
 #include <ignition/gazebo/components/Inertial.hh>
@@ -534,11 +536,24 @@ void printMagnetometer(const uint64_t _entity,
   printNoise(mag->ZNoise(), _spaces + 2, "T");
 }
 
+//////////////////////////////////////////////////
+// \brief Add a component type to a filtered state request.
+// \param[in] _typeId Type of the component.
+// \param[out] _filter Filtered state request.
+void addComponentFilter(const ComponentTypeId _typeId, msgs::Param &_filter)
+{
+  (*_filter.add_children()->mutable_params())["component"].set_string_value(
+      components::Factory::Instance()->Name(_typeId));
+}
+
 //////////////////////////////////////////////////
 // \brief Set the state of a ECM instance with a world snapshot.
-// \param _ecm ECM instance to be populated.
+// \param[in] _ecm ECM instance to be populated.
+// \param[in] _filter Entities and components to request from the
+// `state/filtered` service. If the service isn't available, the full state
+// is requested instead.
 // \return boolean indicating if it was able to populate the ECM.
-bool populateECM(EntityComponentManager &_ecm)
+bool populateECM(EntityComponentManager &_ecm, const msgs::Param &_filter)
 {
   const std::string world = getWorldName();
   if (world.empty())
@@ -551,7 +566,6 @@ bool populateECM(EntityComponentManager &_ecm)
   transport::Node node;
   bool result{false};
   const unsigned int timeout{5000};
-  const std::string service{"/world/" + world + "/state"};
 
   std::cout << std::endl << "Requesting state for world [" << world
             << "]..." << std::endl << std::endl;
@@ -559,6 +573,16 @@ bool populateECM(EntityComponentManager &_ecm)
   // Request and block
   msgs::SerializedStepMap res;
 
+  // Only the state needed by the command is serialized by the server
+  const std::string filteredService{"/world/" + world + "/state/filtered"};
+  if (node.Request(filteredService, _filter, timeout, res, result) && result)
+  {
+    _ecm.SetState(res.state());
+    return true;
+  }
+
+  // Servers without the filtered service send the full state
+  const std::string service{"/world/" + world + "/state"};
   if (!node.Request(service, timeout, res, result))
   {
     std::cerr << std::endl << "Service call to [" << service << "] timed out"
@@ -578,7 +602,6 @@ bool populateECM(EntityComponentManager &_ecm)
   return true;
 }
 
-
 //////////////////////////////////////////////////
 // \brief Print the model information.
 // \param[in] _entity Entity of the model requested.
@@ -780,8 +803,15 @@ void printJoints(const uint64_t _modelEntity,
 //////////////////////////////////////////////////
 extern "C" void cmdModelList()
 {
+  // Only the world's models and their names are needed
+  msgs::Param filter;
+  addComponentFilter(components::World::typeId, filter);
+  addComponentFilter(components::Model::typeId, filter);
+  addComponentFilter(components::Name::typeId, filter);
+  addComponentFilter(components::ParentEntity::typeId, filter);
+
   EntityComponentManager ecm{};
-  if (!populateECM(ecm))
+  if (!populateECM(ecm, filter))
   {
     return;
   }
@@ -835,8 +865,21 @@ extern "C" void cmdModelInfo(
     return;
   }
 
+  // Only the model is needed, along with its descendants unless just the
+  // pose was asked for
+  msgs::Param filter;
+  auto scope = filter.add_children()->mutable_params();
+  (*scope)["name"].set_string_value(_modelName);
+  if (!printAll && !_linkName && !_jointName && !_sensorName)
+  {
+    (*scope)["descendants"].set_bool_value(false);
+    addComponentFilter(components::Model::typeId, filter);
+    addComponentFilter(components::Name::typeId, filter);
+    addComponentFilter(components::Pose::typeId, filter);
+  }
+
   EntityComponentManager ecm{};
-  if (!populateECM(ecm))
+  if (!populateECM(ecm, filter))
     return;
 
   // Get the desired model entity.
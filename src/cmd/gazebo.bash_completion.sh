@@ -34,6 +34,12 @@ GZ_SIM_COMPLETION_LIST="
   --log-compress
   --playback
   --headless-rendering
+  --world-cache
+  --startup-trace
+  --sim-cores
+  --post-update-cores
+  --worker-cores
+  --render-cores
   -r
   -s
   -v --verbose
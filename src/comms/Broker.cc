@@ -19,6 +19,7 @@
 #include <ignition/msgs/dataframe.pb.h>
 #include <ignition/msgs/time.pb.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,9 +30,28 @@
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/Util.hh"
 
+/// \brief A message received from a client which hasn't been added to the
+/// outbound queue of its sender yet.
+struct StagedMsg
+{
+  /// \brief The message.
+  ignition::msgs::DataframeSharedPtr msg;
+
+  /// \brief Message staged before this one.
+  StagedMsg *next{nullptr};
+};
+
 /// \brief Private Broker data class.
 class ignition::gazebo::comms::Broker::Implementation
 {
+  /// \brief Destructor. Releases the messages which are still staged.
+  public: ~Implementation();
+
+  /// \brief Move all the staged messages to the outbound queues of their
+  /// senders, in the order they were received. Must be called with the
+  /// mutex locked.
+  public: void DrainStagedMsgs();
+
   /// \brief The message manager.
   public: MsgManager data;
 
@@ -52,12 +72,57 @@ class ignition::gazebo::comms::Broker::Implementation
 
   /// \brief An Ignition Transport node for communications.
   public: std::unique_ptr<ignition::transport::Node> node;
+
+  /// \brief Lock-free stack of the messages received since they were last
+  /// drained, newest first. Transport threads push to it without taking
+  /// the mutex, so they don't contend with the comms model step.
+  public: std::atomic<StagedMsg *> staged{nullptr};
 };
 
 using namespace ignition;
 using namespace gazebo;
 using namespace comms;
 
+//////////////////////////////////////////////////
+Broker::Implementation::~Implementation()
+{
+  auto node = this->staged.exchange(nullptr);
+  while (nullptr != node)
+  {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+//////////////////////////////////////////////////
+void Broker::Implementation::DrainStagedMsgs()
+{
+  // Take the whole stack at once and reverse it, so messages are queued in
+  // the order they were received
+  StagedMsg *node = this->staged.exchange(nullptr, std::memory_order_acquire);
+  StagedMsg *oldest = nullptr;
+  while (nullptr != node)
+  {
+    auto next = node->next;
+    node->next = oldest;
+    oldest = node;
+    node = next;
+  }
+
+  // Messages are stamped with the time at which they were received, which
+  // is the time of the last step
+  const auto stamp = gazebo::convert<msgs::Time>(this->time);
+  while (nullptr != oldest)
+  {
+    auto next = oldest->next;
+    oldest->msg->mutable_header()->mutable_stamp()->CopyFrom(stamp);
+    this->data.AddOutbound(oldest->msg->src_address(), oldest->msg);
+    delete oldest;
+    oldest = next;
+  }
+}
+
 //////////////////////////////////////////////////
 Broker::Broker()
   : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
@@ -181,16 +246,15 @@ void Broker::OnUnbind(const ignition::msgs::StringMsg_V &_req)
 //////////////////////////////////////////////////
 void Broker::OnMsg(const ignition::msgs::Dataframe &_msg)
 {
-  // Place the message in the outbound queue of the sender.
-  auto msgPtr = std::make_shared<ignition::msgs::Dataframe>(_msg);
-
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  // Stamp the time.
-  msgPtr->mutable_header()->mutable_stamp()->CopyFrom(
-      gazebo::convert<msgs::Time>(this->dataPtr->time));
-
-  this->DataManager().AddOutbound(_msg.src_address(), msgPtr);
+  // Stage the message. It's stamped and placed in the outbound queue of
+  // the sender the next time the data is locked.
+  auto node = new StagedMsg;
+  node->msg = std::make_shared<ignition::msgs::Dataframe>(_msg);
+  node->next = this->dataPtr->staged.load(std::memory_order_relaxed);
+  while (!this->dataPtr->staged.compare_exchange_weak(node->next, node,
+      std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
 }
 
 //////////////////////////////////////////////////
@@ -210,6 +274,7 @@ MsgManager &Broker::DataManager()
 void Broker::Lock()
 {
   this->dataPtr->mutex.lock();
+  this->dataPtr->DrainStagedMsgs();
 }
 
 //////////////////////////////////////////////////
@@ -69,6 +69,11 @@ TEST_F(BrokerTest, Broker)
   msgs::Dataframe msg;
   msg.set_src_address("addr1");
   broker.OnMsg(msg);
+  EXPECT_TRUE(allData["addr1"].outboundMsgs.empty());
+
+  // The message is queued the next time the data is locked.
+  broker.Lock();
+  broker.Unlock();
   EXPECT_EQ(1u, allData["addr1"].outboundMsgs.size());
   EXPECT_EQ("addr1", allData["addr1"].outboundMsgs[0u]->src_address());
 
@@ -44,6 +44,11 @@ class ignition::gazebo::comms::ICommsModel::Implementation
 
   /// \brief Current time.
   public: std::chrono::steady_clock::time_point currentTime;
+
+  /// \brief Registry updated by the comms model on each step. After the
+  /// step, it's swapped with the broker's registry, so it holds the
+  /// previous content, whose memory is reused by the next step.
+  public: Registry newRegistry;
 };
 
 //////////////////////////////////////////////////
@@ -114,12 +119,14 @@ void ICommsModel::StepImpl(const UpdateInfo &_info,
   // Update the time in the broker.
   this->dataPtr->broker.SetTime(_info.simTime);
 
-  // Step the comms model.
+  // Step the comms model. Copy assigning into the registry of the previous
+  // step reuses its nodes, and swapping it back avoids a second copy.
   const Registry &currentRegistry =
     this->dataPtr->broker.DataManager().DataConst();
-  Registry newRegistry = this->dataPtr->broker.DataManager().Copy();
+  Registry &newRegistry = this->dataPtr->newRegistry;
+  newRegistry = currentRegistry;
   this->Step(_info, currentRegistry, newRegistry, _ecm);
-  this->dataPtr->broker.DataManager().Set(newRegistry);
+  this->dataPtr->broker.DataManager().Swap(newRegistry);
 
   this->dataPtr->broker.Unlock();
 
@@ -185,3 +185,9 @@ void MsgManager::Set(const Registry &_newContent)
 {
   this->dataPtr->data = _newContent;
 }
+
+//////////////////////////////////////////////////
+void MsgManager::Swap(Registry &_other)
+{
+  this->dataPtr->data.swap(_other);
+}
@@ -143,4 +143,15 @@ TEST_F(MsgManagerTest, MsgManager)
   auto it = msgManager.DataConst().find("addr6");
   EXPECT_TRUE(it->second.subscriptions.empty());
 
+  // Test swap.
+  auto msgIn3 = std::make_shared<msgs::Dataframe>();
+  comms::Registry other;
+  other["addr7"].inboundMsgs.push_back(msgIn3);
+  msgManager.Swap(other);
+  EXPECT_EQ(1u, msgManager.DataConst().size());
+  ASSERT_EQ(1u, msgManager.Data()["addr7"].inboundMsgs.size());
+  EXPECT_EQ(msgIn3, msgManager.Data()["addr7"].inboundMsgs[0u]);
+  EXPECT_NE(other.end(), other.find("addr6"));
+  EXPECT_EQ(other.end(), other.find("addr7"));
+
 }
@@ -15,7 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -57,21 +65,82 @@ class ignition::gazebo::GuiRunner::Implementation
   /// \brief Topic to request state
   public: std::string stateTopic;
 
+  /// \brief Service which registers state interest streams.
+  public: std::string interestService;
+
+  /// \brief Protects the state subscription.
+  public: std::mutex subscriptionMutex;
+
+  /// \brief Component types received from the server, empty if all types
+  /// are received. Protected by subscriptionMutex.
+  public: std::set<ComponentTypeId> stateTypes;
+
+  /// \brief Topic of the interest stream carrying the state of stateTypes,
+  /// empty while the state is received on stateTopic. Protected by
+  /// subscriptionMutex.
+  public: std::string interestTopic;
+
+  /// \brief Name of the interest stream.
+  /// \return Name, unique to this process.
+  public: std::string InterestName() const;
+
   /// \brief Latest update info
   public: UpdateInfo updateInfo;
 
-  /// \brief Flag used to end the updateThread.
+  /// \brief Flag used to end the updateThread. Protected by stateMutex.
   public: bool running{false};
 
-  /// \brief Mutex to protect the plugin update.
+  /// \brief Protects the ECM and updateInfo, which are written by the
+  /// updateThread and read by the Qt thread.
   public: std::mutex updateMutex;
 
-  /// \brief The plugin update thread..
+  /// \brief Thread which applies the received states to the ECM.
   public: std::thread updateThread;
 
+  /// \brief Protects the pending state.
+  public: std::mutex stateMutex;
+
+  /// \brief Notifies the updateThread of a pending state.
+  public: std::condition_variable stateCv;
+
+  /// \brief States received since the updateThread last applied one,
+  /// merged so that only the latest value of each component is kept.
+  /// Protected by stateMutex.
+  public: msgs::SerializedStepMap pendingState;
+
+  /// \brief True if pendingState holds a state to be applied. Protected by
+  /// stateMutex.
+  public: bool hasPendingState{false};
+
+  /// \brief Merge a state into the pending state and wake up the
+  /// updateThread.
+  /// \param[in] _msg State.
+  public: void QueueState(const msgs::SerializedStepMap &_msg);
+
+  /// \brief Apply pending states to the ECM until stopped.
+  public: void RunUpdateThread();
+
   /// \brief True if the initial state has been received and processed.
+  /// Protected by initialStateMutex.
   public: bool receivedInitialState{false};
 
+  /// \brief Protects the initial state and its chunks.
+  public: std::mutex initialStateMutex;
+
+  /// \brief Initial state, merged from the chunks received so far.
+  public: msgs::SerializedStepMap initialState;
+
+  /// \brief Number of chunks of the initial state received so far.
+  public: std::size_t receivedChunks{0u};
+
+  /// \brief Number of chunks of the initial state, zero until the last
+  /// chunk is received.
+  public: std::size_t expectedChunks{0u};
+
+  /// \brief Periodic states received while the first initial state was
+  /// being received, applied on top of it once it's complete.
+  public: std::vector<msgs::SerializedStepMap> pendingStates;
+
   /// \brief Name of WorldControl service
   public: std::string controlService;
 
@@ -101,6 +170,236 @@ class ignition::gazebo::GuiRunner::Implementation
   public: EventManager eventMgr;
 };
 
+/////////////////////////////////////////////////
+/// \brief Merge a state into another, so that the result is the same as
+/// applying both in order.
+/// \param[in, out] _dst State applied first, which receives the merge.
+/// \param[in] _src State applied second.
+static void mergeState(msgs::SerializedStepMap &_dst,
+    const msgs::SerializedStepMap &_src)
+{
+  _dst.mutable_stats()->CopyFrom(_src.stats());
+
+  auto dstState = _dst.mutable_state();
+  if (_src.state().has_one_time_component_changes())
+  {
+    dstState->set_has_one_time_component_changes(
+        _src.state().has_one_time_component_changes());
+  }
+
+  auto &dstEntities = *dstState->mutable_entities();
+  for (const auto &[id, srcEntity] : _src.state().entities())
+  {
+    auto it = dstEntities.find(id);
+    if (it == dstEntities.end() || srcEntity.remove())
+    {
+      dstEntities[id] = srcEntity;
+      continue;
+    }
+
+    // Newer components replace older ones of the same type, including
+    // component removals
+    auto &dstEntity = it->second;
+    dstEntity.set_remove(false);
+    for (const auto &[type, srcComp] : srcEntity.components())
+      (*dstEntity.mutable_components())[type] = srcComp;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief What a GUI system wants to be updated on, and when it was last
+/// updated. This is kept here instead of in GuiSystem so that the size of
+/// that class doesn't change.
+struct GuiSystemFilter
+{
+  /// \brief Component types which trigger an update when they change.
+  std::vector<ComponentTypeId> types;
+
+  /// \brief Entities which trigger an update when their components change.
+  std::vector<Entity> entities;
+
+  /// \brief Component types which the system reads, empty for all.
+  std::vector<ComponentTypeId> requiredTypes;
+
+  /// \brief Shortest time between updates, zero for no limit.
+  std::chrono::steady_clock::duration minPeriod{0};
+
+  /// \brief True once the system has been updated, until an update is
+  /// requested.
+  bool updated{false};
+
+  /// \brief Change tick of the ECM at the latest update.
+  uint64_t updateTick{0u};
+
+  /// \brief Wall clock time of the latest update.
+  std::chrono::steady_clock::time_point updateTime;
+};
+
+/// \brief Mutex which protects the GUI system filters. Filters may be set
+/// and updates requested from any thread.
+/// \return The mutex.
+static std::mutex &FiltersMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// \brief Filters of the GUI systems, by system.
+/// \return The filters.
+static std::unordered_map<const GuiSystem *, GuiSystemFilter> &Filters()
+{
+  static std::unordered_map<const GuiSystem *, GuiSystemFilter> filters;
+  return filters;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the filter of a GUI system, creating it if needed. The
+/// filter is removed when the system is destroyed. The caller must hold
+/// FiltersMutex().
+/// \param[in] _system The GUI system.
+/// \return The filter.
+static GuiSystemFilter &filterFor(GuiSystem &_system)
+{
+  auto &filters = Filters();
+  auto it = filters.find(&_system);
+  if (it != filters.end())
+    return it->second;
+
+  const GuiSystem *key = &_system;
+  QObject::connect(&_system, &QObject::destroyed, [key]()
+  {
+    std::lock_guard<std::mutex> lock(FiltersMutex());
+    Filters().erase(key);
+  });
+  return filters[key];
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a GUI system should be updated.
+/// \param[in] _system The GUI system.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _now Current wall clock time.
+/// \return True if the system has no filter, has never been updated, or if
+/// what it's interested in changed since it was last updated and it's not
+/// over its rate.
+static bool needsUpdate(const GuiSystem *_system,
+    const EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::time_point &_now)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto it = Filters().find(_system);
+  if (it == Filters().end())
+    return true;
+  const auto &filter = it->second;
+
+  if (!filter.updated)
+    return true;
+
+  // Structural changes are only visible until the next update, so they're
+  // never skipped nor delayed
+  if (_ecm.HasNewEntities() || _ecm.HasEntitiesMarkedForRemoval() ||
+      _ecm.HasRemovedComponents())
+  {
+    return true;
+  }
+
+  if (_now - filter.updateTime < filter.minPeriod)
+    return false;
+
+  if (filter.types.empty() && filter.entities.empty())
+    return true;
+
+  const uint64_t tick = filter.updateTick;
+  for (const auto type : filter.types)
+  {
+    if (_ecm.ComponentTypeChangedSince(tick, type))
+      return true;
+  }
+
+  for (const auto entity : filter.entities)
+  {
+    const auto types = _ecm.ComponentTypes(entity);
+    if (std::any_of(types.begin(), types.end(),
+        [&](const ComponentTypeId _type)
+        {
+          return _ecm.ComponentChangeTick(entity, _type) > tick;
+        }))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record that a GUI system has been updated.
+/// \param[in] _system The GUI system.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _now Current wall clock time.
+static void markUpdated(const GuiSystem *_system,
+    const EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::time_point &_now)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto it = Filters().find(_system);
+  if (it == Filters().end())
+    return;
+
+  it->second.updated = true;
+  it->second.updateTick = _ecm.ChangeTick();
+  it->second.updateTime = _now;
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::Implementation::QueueState(
+    const msgs::SerializedStepMap &_msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->stateMutex);
+    if (this->hasPendingState)
+      mergeState(this->pendingState, _msg);
+    else
+      this->pendingState.CopyFrom(_msg);
+    this->hasPendingState = true;
+  }
+  this->stateCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::Implementation::RunUpdateThread()
+{
+  IGN_PROFILE_THREAD_NAME("GuiRunner::UpdateThread");
+
+  msgs::SerializedStepMap msg;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->stateMutex);
+      this->stateCv.wait(lock, [this]
+      {
+        return !this->running || this->hasPendingState;
+      });
+      if (!this->running)
+        return;
+
+      msg.Swap(&this->pendingState);
+      this->pendingState.Clear();
+      this->hasPendingState = false;
+    }
+
+    IGN_PROFILE("GuiRunner::SetState");
+    std::lock_guard<std::mutex> lock(this->updateMutex);
+    this->ecm.SetState(msg.state());
+    this->updateInfo = convert<UpdateInfo>(msg.stats());
+  }
+}
+
+/////////////////////////////////////////////////
+std::string GuiRunner::Implementation::InterestName() const
+{
+  return "gui_" + std::to_string(ignition::gui::App()->applicationPid());
+}
+
 /////////////////////////////////////////////////
 GuiRunner::GuiRunner(const std::string &_worldName)
   : dataPtr(utils::MakeUniqueImpl<Implementation>())
@@ -142,6 +441,12 @@ GuiRunner::GuiRunner(const std::string &_worldName)
     return fuel_tools::fetchResource(_uri.Str());
   });
 
+  // States are applied to the ECM by their own thread, so that the Qt
+  // thread only has to update the plugins
+  this->dataPtr->running = true;
+  this->dataPtr->updateThread = std::thread(
+      &GuiRunner::Implementation::RunUpdateThread, this->dataPtr.get());
+
   igndbg << "Requesting initial state from [" << this->dataPtr->stateTopic
          << "]..." << std::endl;
 
@@ -153,13 +458,37 @@ GuiRunner::GuiRunner(const std::string &_worldName)
   timer->start(33);
 
   this->dataPtr->controlService = "/world/" + _worldName + "/control/state";
+  this->dataPtr->interestService = "/world/" + _worldName + "/state/interest";
 
   ignition::gui::App()->findChild<
       ignition::gui::MainWindow *>()->installEventFilter(this);
 }
 
 /////////////////////////////////////////////////
-GuiRunner::~GuiRunner() = default;
+GuiRunner::~GuiRunner()
+{
+  // Stop the interest stream, if any
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->subscriptionMutex);
+    if (!this->dataPtr->stateTypes.empty())
+    {
+      msgs::Param req;
+      (*req.mutable_params())["name"].set_string_value(
+          this->dataPtr->InterestName());
+      std::function<void(const msgs::StringMsg &, const bool)> cb =
+          [](const msgs::StringMsg &, const bool) {};
+      this->dataPtr->node.Request(this->dataPtr->interestService, req, cb);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->stateMutex);
+    this->dataPtr->running = false;
+  }
+  this->dataPtr->stateCv.notify_all();
+  if (this->dataPtr->updateThread.joinable())
+    this->dataPtr->updateThread.join();
+}
 
 /////////////////////////////////////////////////
 bool GuiRunner::eventFilter(QObject *_obj, QEvent *_event)
@@ -182,7 +511,10 @@ bool GuiRunner::eventFilter(QObject *_obj, QEvent *_event)
       const bool pressedPlay = !info.pause() && !pressedStep;
       const bool pressedStepWhilePaused = info.pause() && pressedStep;
       if (pressedPlay || pressedStepWhilePaused)
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
         req.mutable_state()->CopyFrom(this->dataPtr->ecm.State());
+      }
 
       std::function<void(const ignition::msgs::Boolean &, const bool)> cb =
           [](const ignition::msgs::Boolean &/*_rep*/, const bool _result)
@@ -258,12 +590,25 @@ void GuiRunner::RequestState()
   ignition::msgs::StringMsg req;
   req.set_data(reqSrv);
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->initialStateMutex);
+    this->dataPtr->initialState.Clear();
+    this->dataPtr->receivedChunks = 0u;
+    this->dataPtr->expectedChunks = 0u;
+
+    // Periodic states are held until the new initial state arrives, so that
+    // it doesn't override them
+    this->dataPtr->receivedInitialState = false;
+  }
+
   // Subscribe to periodic updates.
   this->dataPtr->node.Subscribe(this->dataPtr->stateTopic,
       &GuiRunner::OnState, this);
 
-  // send async state request
-  this->dataPtr->node.Request(this->dataPtr->stateTopic + "_async", req);
+  // Send chunked state request, so that the state of large worlds is
+  // serialized off the server's simulation thread and doesn't need to fit in
+  // a single message
+  this->dataPtr->node.Request(this->dataPtr->stateTopic + "_chunked", req);
 }
 
 /////////////////////////////////////////////////
@@ -276,12 +621,48 @@ void GuiRunner::OnPluginAdded(const QString &)
 /////////////////////////////////////////////////
 void GuiRunner::OnStateAsyncService(const msgs::SerializedStepMap &_res)
 {
-  // Since this function may be called from a transport thread, we push the
-  // OnStateQt function to the queue so that its called from the Qt thread. This
-  // ensures that only one thread has access to the ecm and updateInfo
-  // variables.
-  QMetaObject::invokeMethod(this, "OnStateQt", Qt::QueuedConnection,
-                            Q_ARG(msgs::SerializedStepMap, _res));
+  std::lock_guard<std::mutex> lock(this->dataPtr->initialStateMutex);
+
+  // Chunks may arrive in any order, the last one tells how many there are.
+  // A response without chunk keys holds the whole state.
+  bool chunked{false};
+  for (const auto &data : _res.header().data())
+  {
+    if (data.key() == "chunk")
+      chunked = true;
+    else if (data.key() == "chunk_count" && data.value_size() > 0)
+      this->dataPtr->expectedChunks = std::stoul(data.value(0));
+  }
+
+  if (chunked)
+  {
+    this->dataPtr->initialState.mutable_stats()->CopyFrom(_res.stats());
+    this->dataPtr->initialState.mutable_state()->MergeFrom(_res.state());
+    ++this->dataPtr->receivedChunks;
+    if (this->dataPtr->expectedChunks == 0u ||
+        this->dataPtr->receivedChunks < this->dataPtr->expectedChunks)
+    {
+      return;
+    }
+  }
+  else
+  {
+    this->dataPtr->initialState.CopyFrom(_res);
+  }
+
+  this->dataPtr->QueueState(this->dataPtr->initialState);
+
+  // States published while the initial state was on its way, skipping those
+  // which are older than it
+  const auto iterations = this->dataPtr->initialState.stats().iterations();
+  for (const auto &pending : this->dataPtr->pendingStates)
+  {
+    if (pending.stats().iterations() < iterations)
+      continue;
+    this->dataPtr->QueueState(pending);
+  }
+  this->dataPtr->pendingStates.clear();
+  this->dataPtr->initialState.Clear();
   this->dataPtr->receivedInitialState = true;
 
   // todo(anyone) store reqSrv string in a member variable and use it here
@@ -298,38 +679,49 @@ void GuiRunner::OnState(const msgs::SerializedStepMap &_msg)
   IGN_PROFILE_THREAD_NAME("GuiRunner::OnState");
   IGN_PROFILE("GuiRunner::Update");
 
-  // Only process state updates after initial state has been received.
-  if (!this->dataPtr->receivedInitialState)
-    return;
+  // Only process state updates after initial state has been received. Until
+  // then, keep them to be applied on top of it.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->initialStateMutex);
+    if (!this->dataPtr->receivedInitialState)
+    {
+      this->dataPtr->pendingStates.push_back(_msg);
+      return;
+    }
+  }
 
-  // Since this function may be called from a transport thread, we push the
-  // OnStateQt function to the queue so that its called from the Qt thread. This
-  // ensures that only one thread has access to the ecm and updateInfo
-  // variables.
-  QMetaObject::invokeMethod(this, "OnStateQt", Qt::QueuedConnection,
-                            Q_ARG(msgs::SerializedStepMap, _msg));
+  // States which arrive faster than they're applied are merged, instead of
+  // piling up
+  this->dataPtr->QueueState(_msg);
 }
 
 /////////////////////////////////////////////////
 void GuiRunner::OnStateQt(const msgs::SerializedStepMap &_msg)
 {
-  IGN_PROFILE_THREAD_NAME("Qt thread");
-  IGN_PROFILE("GuiRunner::Update");
-  this->dataPtr->ecm.SetState(_msg.state());
-
-  // Update all plugins
-  this->dataPtr->updateInfo = convert<UpdateInfo>(_msg.stats());
-  this->UpdatePlugins();
+  // States are now applied by the update thread, this is kept for ABI
+  // compatibility
+  this->dataPtr->QueueState(_msg);
 }
 
 /////////////////////////////////////////////////
 void GuiRunner::UpdatePlugins()
 {
-  // gui plugins
+  IGN_PROFILE_THREAD_NAME("Qt thread");
+  IGN_PROFILE("GuiRunner::UpdatePlugins");
+
+  // Plugins see the ECM as left by the latest applied state, which isn't
+  // modified until they're done
+  std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+
+  // gui plugins, skipping those which aren't interested in what changed
+  const auto now = std::chrono::steady_clock::now();
   auto plugins = ignition::gui::App()->findChildren<GuiSystem *>();
   for (auto plugin : plugins)
   {
+    if (!needsUpdate(plugin, this->dataPtr->ecm, now))
+      continue;
     plugin->Update(this->dataPtr->updateInfo, this->dataPtr->ecm);
+    markUpdated(plugin, this->dataPtr->ecm, now);
   }
   this->dataPtr->ecm.ClearRemovedComponents();
   this->dataPtr->ecm.ClearNewlyCreatedEntities();
@@ -338,6 +730,114 @@ void GuiRunner::UpdatePlugins()
   // ign-gazebo systems
   this->LoadSystems();
   this->UpdateSystems();
+
+  this->UpdateStateTypes();
+
+  // State received from now on is newer than what plugins have seen
+  this->dataPtr->ecm.AdvanceChangeTick();
+}
+
+/////////////////////////////////////////////////
+void GuiRunner::UpdateStateTypes()
+{
+  // Only filter the state if all GUI systems declared what they need.
+  // ign-gazebo systems loaded on the GUI can't declare it.
+  std::set<ComponentTypeId> types;
+  auto plugins = ignition::gui::App()->findChildren<GuiSystem *>();
+  bool all = plugins.empty() || !this->dataPtr->systems.empty();
+  for (auto plugin : plugins)
+  {
+    const auto required = guiSystemRequiredComponentTypes(*plugin);
+    if (required.empty())
+    {
+      all = true;
+      break;
+    }
+    types.insert(required.begin(), required.end());
+  }
+
+  if (all)
+  {
+    types.clear();
+  }
+  else
+  {
+    // Needed to create entities and their hierarchy
+    types.insert(components::Name::typeId);
+    types.insert(components::ParentEntity::typeId);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->subscriptionMutex);
+  if (types == this->dataPtr->stateTypes)
+    return;
+
+  const bool wasFiltered = !this->dataPtr->stateTypes.empty();
+  this->dataPtr->stateTypes = types;
+
+  msgs::Param req;
+  (*req.mutable_params())["name"].set_string_value(
+      this->dataPtr->InterestName());
+
+  // Back to all types, which need the full state again
+  if (types.empty())
+  {
+    std::function<void(const msgs::StringMsg &, const bool)> cb =
+        [](const msgs::StringMsg &, const bool) {};
+    this->dataPtr->node.Request(this->dataPtr->interestService, req, cb);
+
+    if (!this->dataPtr->interestTopic.empty())
+    {
+      this->dataPtr->node.Unsubscribe(this->dataPtr->interestTopic);
+      this->dataPtr->interestTopic.clear();
+    }
+    this->dataPtr->node.Unsubscribe(this->dataPtr->stateTopic);
+    this->RequestState();
+    return;
+  }
+
+  igndbg << "Requesting state with " << types.size() << " component types"
+         << std::endl;
+
+  (*req.mutable_params())["hertz"].set_double_value(60.0);
+  for (const auto type : types)
+  {
+    (*req.add_children()->mutable_params())["component"].set_string_value(
+        components::Factory::Instance()->Name(type));
+  }
+
+  // Changing the types of an existing stream keeps its topic, and the next
+  // message carries the full state of the new types
+  if (wasFiltered)
+  {
+    std::function<void(const msgs::StringMsg &, const bool)> cb =
+        [](const msgs::StringMsg &, const bool) {};
+    this->dataPtr->node.Request(this->dataPtr->interestService, req, cb);
+    return;
+  }
+
+  std::function<void(const msgs::StringMsg &, const bool)> cb =
+      [this](const msgs::StringMsg &_rep, const bool _result)
+      {
+        if (!_result || _rep.data().empty())
+        {
+          ignwarn << "Failed to request a filtered state, receiving all "
+                  << "component types." << std::endl;
+          return;
+        }
+
+        std::lock_guard<std::mutex> cbLock(this->dataPtr->subscriptionMutex);
+        if (this->dataPtr->stateTypes.empty() ||
+            !this->dataPtr->interestTopic.empty())
+        {
+          return;
+        }
+
+        this->dataPtr->interestTopic = _rep.data();
+        this->dataPtr->node.Subscribe(this->dataPtr->interestTopic,
+            &GuiRunner::OnState, this);
+        this->dataPtr->node.Unsubscribe(this->dataPtr->stateTopic);
+      };
+  this->dataPtr->node.Request(this->dataPtr->interestService, req, cb);
 }
 
 /////////////////////////////////////////////////
@@ -420,3 +920,75 @@ EventManager &GuiRunner::GuiEventManager() const
 {
   return this->dataPtr->eventMgr;
 }
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+/////////////////////////////////////////////////
+void setGuiSystemUpdateComponentTypes(GuiSystem &_system,
+    const std::vector<ComponentTypeId> &_types)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto &filter = filterFor(_system);
+  filter.types = _types;
+  filter.updated = false;
+}
+
+/////////////////////////////////////////////////
+void setGuiSystemUpdateEntities(GuiSystem &_system,
+    const std::vector<Entity> &_entities)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto &filter = filterFor(_system);
+  filter.entities = _entities;
+  filter.updated = false;
+}
+
+/////////////////////////////////////////////////
+void setGuiSystemMaxUpdateRate(GuiSystem &_system, double _rate)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto &filter = filterFor(_system);
+  if (_rate <= 0.0)
+  {
+    filter.minPeriod = std::chrono::steady_clock::duration::zero();
+    return;
+  }
+  filter.minPeriod =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / _rate));
+}
+
+/////////////////////////////////////////////////
+void setGuiSystemRequiredComponentTypes(GuiSystem &_system,
+    const std::vector<ComponentTypeId> &_types)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  filterFor(_system).requiredTypes = _types;
+}
+
+/////////////////////////////////////////////////
+std::vector<ComponentTypeId> guiSystemRequiredComponentTypes(
+    const GuiSystem &_system)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto it = Filters().find(&_system);
+  if (it == Filters().end())
+    return {};
+  return it->second.requiredTypes;
+}
+
+/////////////////////////////////////////////////
+void requestGuiSystemUpdate(GuiSystem &_system)
+{
+  std::lock_guard<std::mutex> lock(FiltersMutex());
+  auto it = Filters().find(&_system);
+  if (it != Filters().end())
+    it->second.updated = false;
+}
+}
+}
+}
@@ -65,12 +65,15 @@ class IGNITION_GAZEBO_GUI_VISIBLE GuiRunner : public QObject
   /// \param[in] _res Response containing new state.
   private: void OnStateAsyncService(const msgs::SerializedStepMap &_res);
 
-  /// \brief Callback when a new state is received from the server. Actual
-  /// updating of the ECM is delegated to OnStateQt
+  /// \brief Callback when a new state is received from the server. The
+  /// state is merged with other states which haven't been applied yet, and
+  /// applied to the ECM by an update thread. Plugins are updated with the
+  /// latest applied state by the Qt thread, at display rate.
   /// \param[in] _msg New state message.
   private: void OnState(const msgs::SerializedStepMap &_msg);
 
-  /// \brief Called by the Qt thread to update the ECM with new state
+  /// \brief Queue a state to be applied to the ECM by the update thread.
+  /// This function is left here for ABI compatibility.
   /// \param[in] _msg New state message.
   private: Q_INVOKABLE void OnStateQt(const msgs::SerializedStepMap &_msg);
 
@@ -84,6 +87,10 @@ class IGNITION_GAZEBO_GUI_VISIBLE GuiRunner : public QObject
   /// \brief Update systems
   private: void UpdateSystems();
 
+  /// \brief Request only the component types needed by the GUI systems
+  /// from the server, or all types if any system needs them.
+  private: void UpdateStateTypes();
+
   /// \brief Pointer to private data.
   IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
 };
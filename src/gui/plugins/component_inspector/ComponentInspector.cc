@@ -18,6 +18,7 @@
 #include <iostream>
 #include <list>
 #include <regex>
+#include <unordered_map>
 #include <QColorDialog>
 #include <ignition/common/Console.hh>
 #include <ignition/common/Profiler.hh>
@@ -119,6 +120,13 @@ namespace ignition::gazebo
 
     /// \brief Handles all system info components.
     public: std::unique_ptr<inspector::SystemPluginInfo> systemInfo;
+
+    /// \brief Entity whose components are currently displayed.
+    public: Entity displayedEntity{kNullEntity};
+
+    /// \brief Change tick of each displayed component when its item was
+    /// last refreshed.
+    public: std::unordered_map<ComponentTypeId, uint64_t> displayedTicks;
   };
 }
 
@@ -482,6 +490,8 @@ void ComponentInspector::LoadConfig(const tinyxml2::XMLElement *)
   this->dataPtr->pose3d = std::make_unique<inspector::Pose3d>(this);
   this->dataPtr->systemInfo =
       std::make_unique<inspector::SystemPluginInfo>(this);
+
+  setGuiSystemUpdateEntities(*this, {this->dataPtr->entity});
 }
 
 //////////////////////////////////////////////////
@@ -493,11 +503,28 @@ void ComponentInspector::Update(const UpdateInfo &,
   if (this->dataPtr->paused)
     return;
 
+  // Items of another entity's components need to be refreshed
+  if (this->dataPtr->displayedEntity != this->dataPtr->entity)
+  {
+    this->dataPtr->displayedEntity = this->dataPtr->entity;
+    this->dataPtr->displayedTicks.clear();
+  }
+
   auto componentTypes = _ecm.ComponentTypes(this->dataPtr->entity);
 
   // List all components
   for (const auto &typeId : componentTypes)
   {
+    // Only refresh components which changed since they were last displayed
+    auto tick = _ecm.ComponentChangeTick(this->dataPtr->entity, typeId);
+    auto tickIt = this->dataPtr->displayedTicks.find(typeId);
+    if (tickIt != this->dataPtr->displayedTicks.end() &&
+        tickIt->second == tick)
+    {
+      continue;
+    }
+    this->dataPtr->displayedTicks[typeId] = tick;
+
     // Type components
     if (typeId == components::World::typeId)
     {
@@ -584,9 +611,6 @@ void ComponentInspector::Update(const UpdateInfo &,
       item = this->dataPtr->componentsModel.AddComponentType(typeId);
     }
 
-    item->setData(QString::number(this->dataPtr->entity),
-                  ComponentsModel::RoleNames().key("entity"));
-
     if (nullptr == item)
     {
       ignerr << "Failed to get item for component type [" << typeId << "]"
@@ -594,6 +618,9 @@ void ComponentInspector::Update(const UpdateInfo &,
       continue;
     }
 
+    item->setData(QString::number(this->dataPtr->entity),
+                  ComponentsModel::RoleNames().key("entity"));
+
     // Populate component-specific data
     if (typeId == components::AngularAcceleration::typeId)
     {
@@ -916,6 +943,7 @@ void ComponentInspector::Update(const UpdateInfo &,
   // Remove components in list
   for (auto typeId : itemsToRemove)
   {
+    this->dataPtr->displayedTicks.erase(typeId);
     QMetaObject::invokeMethod(&this->dataPtr->componentsModel,
         "RemoveComponentType",
         Qt::QueuedConnection,
@@ -977,6 +1005,9 @@ void ComponentInspector::SetEntity(const Entity &_entity)
   {
     this->dataPtr->entity = _entity;
   }
+
+  // Only the inspected entity's components are displayed
+  setGuiSystemUpdateEntities(*this, {this->dataPtr->entity});
   this->EntityChanged();
 }
 
@@ -989,6 +1020,9 @@ QString ComponentInspector::Type() const
 /////////////////////////////////////////////////
 void ComponentInspector::SetType(const QString &_type)
 {
+  if (this->dataPtr->type == _type)
+    return;
+
   this->dataPtr->type = _type;
   this->TypeChanged();
 }
@@ -1016,6 +1050,7 @@ bool ComponentInspector::Paused() const
 void ComponentInspector::SetPaused(bool _paused)
 {
   this->dataPtr->paused = _paused;
+  requestGuiSystemUpdate(*this);
   this->PausedChanged();
 }
 
@@ -22,6 +22,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -116,150 +117,352 @@ QString entityType(Entity _entity,
 }
 
 /////////////////////////////////////////////////
-TreeModel::TreeModel() : QStandardItemModel()
+TreeModel::TreeModel() : QAbstractItemModel()
 {
   qRegisterMetaType<Entity>("Entity");
+
+  // Top level entities are always exposed
+  this->root.populated = true;
 }
 
 /////////////////////////////////////////////////
-void TreeModel::AddEntity(Entity _entity, const QString &_entityName,
-    Entity _parentEntity, const QString &_type)
+QModelIndex TreeModel::index(int _row, int _column,
+    const QModelIndex &_parent) const
 {
-  IGN_PROFILE_THREAD_NAME("Qt thread");
-  IGN_PROFILE("TreeModel::AddEntity");
-  QStandardItem *parentItem{nullptr};
+  auto node = this->IndexNode(_parent);
+  if (_column != 0 || _row < 0 || _row >= node->fetched)
+    return QModelIndex();
+  return this->createIndex(_row, 0, node->children[_row]);
+}
 
-  // check if entity has already been added or not.
-  // This could happen because we get new and removed entity updates from both
-  // the ECM and GUI events.
-  if (this->entityItems.find(_entity) != this->entityItems.end())
+/////////////////////////////////////////////////
+QModelIndex TreeModel::parent(const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return QModelIndex();
+  return this->NodeIndex(this->IndexNode(_index)->parent);
+}
+
+/////////////////////////////////////////////////
+int TreeModel::rowCount(const QModelIndex &_parent) const
+{
+  if (_parent.column() > 0)
+    return 0;
+  return this->IndexNode(_parent)->fetched;
+}
+
+/////////////////////////////////////////////////
+int TreeModel::columnCount(const QModelIndex &) const
+{
+  return 1;
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::hasChildren(const QModelIndex &_parent) const
+{
+  return !this->IndexNode(_parent)->children.empty();
+}
+
+/////////////////////////////////////////////////
+bool TreeModel::canFetchMore(const QModelIndex &_parent) const
+{
+  auto node = this->IndexNode(_parent);
+  return node->fetched < static_cast<int>(node->children.size());
+}
+
+/////////////////////////////////////////////////
+void TreeModel::fetchMore(const QModelIndex &_parent)
+{
+  IGN_PROFILE("TreeModel::fetchMore");
+  auto node = const_cast<EntityNode *>(this->IndexNode(_parent));
+  node->populated = true;
+
+  const int count = static_cast<int>(node->children.size());
+  if (node->fetched >= count)
     return;
 
-  // Root
-  if (_parentEntity == kNullEntity)
+  this->beginInsertRows(_parent, node->fetched, count - 1);
+  node->fetched = count;
+  this->endInsertRows();
+}
+
+/////////////////////////////////////////////////
+QVariant TreeModel::data(const QModelIndex &_index, int _role) const
+{
+  if (!_index.isValid())
+    return QVariant();
+
+  auto node = this->IndexNode(_index);
+  switch (_role)
   {
-    parentItem = this->invisibleRootItem();
+    case Qt::DisplayRole:
+    case 100:
+      return node->name;
+    case 101:
+      return QString::number(node->entity);
+    case 102:
+      return node->type;
+    default:
+      return QVariant();
   }
+}
+
+/////////////////////////////////////////////////
+QModelIndex TreeModel::NodeIndex(const EntityNode *_node) const
+{
+  if (nullptr == _node || _node == &this->root)
+    return QModelIndex();
+  return this->createIndex(_node->row, 0, const_cast<EntityNode *>(_node));
+}
+
+/////////////////////////////////////////////////
+const TreeModel::EntityNode *TreeModel::IndexNode(
+    const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return &this->root;
+  return static_cast<const EntityNode *>(_index.internalPointer());
+}
 
-  // Nested
-  // TODO(louise) There should be a way to easily access these from
-  // QStandardItemModel instead of keeping our own map
-  auto item = this->entityItems.find(_parentEntity);
-  if (item != this->entityItems.end())
+/////////////////////////////////////////////////
+bool TreeModel::Exposed(const EntityNode *_node) const
+{
+  for (; _node != &this->root; _node = _node->parent)
   {
-    parentItem = item->second;
+    if (_node->row >= _node->parent->fetched)
+      return false;
   }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TreeModel::AddEntity(Entity _entity, const QString &_entityName,
+    Entity _parentEntity, const QString &_type)
+{
+  IGN_PROFILE_THREAD_NAME("Qt thread");
+  IGN_PROFILE("TreeModel::AddEntity");
+  this->InsertEntity({_entity, _entityName, _parentEntity, _type});
+  this->ExposeGrown();
+}
 
-  if (nullptr == parentItem)
+/////////////////////////////////////////////////
+void TreeModel::InsertEntity(EntityInfo _info)
+{
+  // Entities may be added again, because we get new and removed entity
+  // updates from both the ECM and GUI events. Children which were waiting
+  // for their parent are added along with it.
+  std::vector<EntityInfo> toAdd;
+  toAdd.push_back(std::move(_info));
+  while (!toAdd.empty())
   {
-    this->pendingEntities.push_back(
-      {_entity, _entityName, _parentEntity, _type});
-    return;
-  }
+    auto info = std::move(toAdd.back());
+    toAdd.pop_back();
 
-  // New entity item
-  auto entityItem = new QStandardItem(_entityName);
-  entityItem->setData(_entityName, this->roleNames().key("entityName"));
-  entityItem->setData(QString::number(_entity),
-      this->roleNames().key("entity"));
-  entityItem->setData(_type, this->roleNames().key("type"));
+    if (this->nodes.find(info.entity) != this->nodes.end())
+      continue;
 
-  parentItem->appendRow(entityItem);
+    EntityNode *parentNode{nullptr};
+    if (info.parentEntity == kNullEntity)
+    {
+      parentNode = &this->root;
+    }
+    else
+    {
+      auto parentIt = this->nodes.find(info.parentEntity);
+      if (parentIt != this->nodes.end())
+        parentNode = parentIt->second.get();
+    }
 
-  this->entityItems[_entity] = entityItem;
+    if (nullptr == parentNode)
+    {
+      this->pendingEntities.emplace(info.parentEntity, std::move(info));
+      continue;
+    }
 
-  // Check if there are pending children
-  auto sep = std::partition(this->pendingEntities.begin(),
-      this->pendingEntities.end(), [&_entity](const EntityInfo &_entityInfo)
-      {
-        return _entityInfo.parentEntity != _entity;
-      });
+    // New children are exposed once the whole batch is added
+    auto node = std::make_unique<EntityNode>();
+    node->entity = info.entity;
+    node->name = std::move(info.name);
+    node->type = std::move(info.type);
+    node->parent = parentNode;
+    node->row = static_cast<int>(parentNode->children.size());
+    parentNode->children.push_back(node.get());
+    this->grown.insert(info.parentEntity);
+    this->nodes[info.entity] = std::move(node);
+
+    auto range = this->pendingEntities.equal_range(info.entity);
+    for (auto it = range.first; it != range.second; ++it)
+      toAdd.push_back(std::move(it->second));
+    this->pendingEntities.erase(range.first, range.second);
+  }
+}
 
-  for (auto it = sep; it != this->pendingEntities.end(); ++it)
+/////////////////////////////////////////////////
+void TreeModel::ExposeGrown()
+{
+  for (const Entity entity : this->grown)
   {
-    this->AddEntity(it->entity, it->name, it->parentEntity, it->type);
+    EntityNode *node{&this->root};
+    if (entity != kNullEntity)
+    {
+      auto nodeIt = this->nodes.find(entity);
+      if (nodeIt == this->nodes.end())
+        continue;
+      node = nodeIt->second.get();
+    }
+
+    if (!this->Exposed(node))
+      continue;
+
+    // Collapsed nodes keep their children until they're expanded, but views
+    // need to know that they now have some
+    const auto index = this->NodeIndex(node);
+    if (!node->populated)
+    {
+      if (node->fetched == 0)
+        emit this->dataChanged(index, index);
+      continue;
+    }
+
+    const int count = static_cast<int>(node->children.size());
+    if (node->fetched >= count)
+      continue;
+    this->beginInsertRows(index, node->fetched, count - 1);
+    node->fetched = count;
+    this->endInsertRows();
   }
-  this->pendingEntities.erase(sep, this->pendingEntities.end());
+  this->grown.clear();
 }
 
 /////////////////////////////////////////////////
 void TreeModel::RemoveEntity(Entity _entity)
 {
   IGN_PROFILE("TreeModel::RemoveEntity");
-  QStandardItem *item{nullptr};
-  auto itemIt = this->entityItems.find(_entity);
-  if (itemIt != this->entityItems.end())
+  auto nodeIt = this->nodes.find(_entity);
+  if (nodeIt == this->nodes.end())
   {
-    item = itemIt->second;
+    // See if it's pending
+    for (auto it = this->pendingEntities.begin();
+        it != this->pendingEntities.end();)
+    {
+      if (it->second.entity == _entity)
+        it = this->pendingEntities.erase(it);
+      else
+        ++it;
+    }
+    return;
   }
 
-  if (nullptr == item)
+  auto node = nodeIt->second.get();
+  auto parentNode = node->parent;
+  const int row = node->row;
+
+  const bool exposed = this->Exposed(node);
+  if (exposed)
+    this->beginRemoveRows(this->NodeIndex(parentNode), row, row);
+
+  parentNode->children.erase(parentNode->children.begin() + row);
+  for (auto i = static_cast<std::size_t>(row);
+      i < parentNode->children.size(); ++i)
   {
-    // See if it's pending
-    auto toRemove = std::remove_if(this->pendingEntities.begin(),
-        this->pendingEntities.end(), [&_entity](const EntityInfo &_entityInfo)
-        {
-          return _entityInfo.entity == _entity;
-        });
-    this->pendingEntities.erase(toRemove, this->pendingEntities.end());
+    parentNode->children[i]->row = static_cast<int>(i);
+  }
+  if (row < parentNode->fetched)
+    --parentNode->fetched;
 
-    return;
+  // Remove all descendants
+  std::vector<Entity> toErase{_entity};
+  while (!toErase.empty())
+  {
+    auto eraseIt = this->nodes.find(toErase.back());
+    toErase.pop_back();
+    if (eraseIt == this->nodes.end())
+      continue;
+    for (auto child : eraseIt->second->children)
+      toErase.push_back(child->entity);
+    this->nodes.erase(eraseIt);
   }
 
-  // Remove all children from our custom map
-  std::function<void(const QStandardItem *)> removeChildren =
-      [&](const QStandardItem *_item)
+  if (exposed)
+    this->endRemoveRows();
+}
+
+/////////////////////////////////////////////////
+void TreeModel::QueueAddEntity(Entity _entity, const QString &_entityName,
+    Entity _parentEntity, const QString &_type)
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->queue.push_back({true, {_entity, _entityName, _parentEntity, _type}});
+  if (!this->processScheduled)
   {
-    for (int i = 0; i < _item->rowCount(); ++i)
-    {
-      auto childItem = _item->child(i);
-      removeChildren(childItem);
-      this->entityItems.erase(childItem->data(
-          this->roleNames().key("entity")).toUInt());
-    }
-  };
-  this->entityItems.erase(_entity);
-  removeChildren(item);
+    this->processScheduled = true;
+    QMetaObject::invokeMethod(this, "ProcessQueue", Qt::QueuedConnection);
+  }
+}
 
-  // Remove from the view
-  if (nullptr == item->parent())
-    this->removeRow(item->row());
-  else
-    item->parent()->removeRow(item->row());
+/////////////////////////////////////////////////
+void TreeModel::QueueRemoveEntity(Entity _entity)
+{
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->queue.push_back({false, {_entity, QString(), kNullEntity,
+      QString()}});
+  if (!this->processScheduled)
+  {
+    this->processScheduled = true;
+    QMetaObject::invokeMethod(this, "ProcessQueue", Qt::QueuedConnection);
+  }
 }
 
 /////////////////////////////////////////////////
-QString TreeModel::EntityType(const QModelIndex &_index) const
+void TreeModel::ProcessQueue()
 {
-  QString type;
-  QStandardItem *item = this->itemFromIndex(_index);
-  if (!item)
-    return type;
+  IGN_PROFILE_THREAD_NAME("Qt thread");
+  IGN_PROFILE("TreeModel::ProcessQueue");
+
+  std::vector<QueuedChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    changes.swap(this->queue);
+    this->processScheduled = false;
+  }
+
+  // Additions are only exposed at the end, so that each parent notifies
+  // views once. Removals are applied right away, which only affects the
+  // rows which are already exposed.
+  for (auto &change : changes)
+  {
+    if (change.add)
+      this->InsertEntity(std::move(change.info));
+    else
+      this->RemoveEntity(change.info.entity);
+  }
 
-  QVariant typeVar  = item->data(this->roleNames().key("type"));
-  if (!typeVar.isValid())
-    return type;
+  this->ExposeGrown();
+}
 
-  return typeVar.toString();
+/////////////////////////////////////////////////
+QString TreeModel::EntityType(const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return QString();
+  return this->IndexNode(_index)->type;
 }
 
 /////////////////////////////////////////////////
 QString TreeModel::ScopedName(const QModelIndex &_index) const
 {
   QString scopedName;
-  QModelIndex idx = _index;
-  while (idx.isValid())
+  if (!_index.isValid())
+    return scopedName;
+
+  for (auto node = this->IndexNode(_index); node != &this->root;
+      node = node->parent)
   {
-    QVariant v = idx.data();
-    if (v.isValid())
+    if (!node->name.isEmpty())
     {
-      QString str = v.toString();
-      if (!str.isEmpty())
-      {
-        scopedName = scopedName.isEmpty() ? str : str + "::" + scopedName;
-      }
+      scopedName = scopedName.isEmpty() ? node->name :
+          node->name + "::" + scopedName;
     }
-    idx = idx.parent();
   }
   return scopedName;
 }
@@ -267,16 +470,31 @@ QString TreeModel::ScopedName(const QModelIndex &_index) const
 /////////////////////////////////////////////////
 Entity TreeModel::EntityId(const QModelIndex &_index) const
 {
-  Entity entity{kNullEntity};
-  QStandardItem *item = this->itemFromIndex(_index);
-  if (!item)
-    return entity;
-
-  QVariant entityVar  = item->data(this->roleNames().key("entity"));
-  if (!entityVar.isValid())
-    return entity;
+  if (!_index.isValid())
+    return kNullEntity;
+  return this->IndexNode(_index)->entity;
+}
 
-  return entityVar.toUInt();
+/////////////////////////////////////////////////
+QModelIndex TreeModel::EntityIndex(qulonglong _entity)
+{
+  auto nodeIt = this->nodes.find(_entity);
+  if (nodeIt == this->nodes.end())
+    return QModelIndex();
+
+  // Fetch the children of the ancestors, from the top down
+  std::vector<EntityNode *> ancestors;
+  for (auto node = nodeIt->second->parent; node != &this->root;
+      node = node->parent)
+  {
+    ancestors.push_back(node);
+  }
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it)
+  {
+    if (this->canFetchMore(this->NodeIndex(*it)))
+      this->fetchMore(this->NodeIndex(*it));
+  }
+  return this->NodeIndex(nodeIt->second.get());
 }
 
 /////////////////////////////////////////////////
@@ -305,6 +523,19 @@ void EntityTree::LoadConfig(const tinyxml2::XMLElement *)
   if (this->title.empty())
     this->title = "Entity tree";
 
+  // The tree only changes with entities, their names and parents
+  setGuiSystemUpdateComponentTypes(*this, {components::Name::typeId,
+      components::ParentEntity::typeId});
+
+  // Types used to tell what each entity is
+  setGuiSystemRequiredComponentTypes(*this, {components::Name::typeId,
+      components::ParentEntity::typeId, components::World::typeId,
+      components::Model::typeId, components::Link::typeId,
+      components::Joint::typeId, components::Collision::typeId,
+      components::Visual::typeId, components::Light::typeId,
+      components::Level::typeId, components::Performer::typeId,
+      components::Sensor::typeId, components::Actor::typeId});
+
   ignition::gui::App()->findChild<
       ignition::gui::MainWindow *>()->installEventFilter(this);
 }
@@ -345,12 +576,9 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(_entity,
+          QString::fromStdString(_name->Data()), parentEntity,
+          entityType(_entity, _ecm));
       return true;
     });
 
@@ -375,12 +603,9 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, _entity),
-          Q_ARG(QString, QString::fromStdString(_name->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(_entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(_entity,
+          QString::fromStdString(_name->Data()), parentEntity,
+          entityType(_entity, _ecm));
       return true;
     });
   }
@@ -389,9 +614,7 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
     [&](const Entity &_entity,
         const components::Name *)->bool
   {
-    QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntity",
-        Qt::QueuedConnection,
-        Q_ARG(Entity, _entity));
+    this->dataPtr->treeModel.QueueRemoveEntity(_entity);
     return true;
   });
 
@@ -425,20 +648,13 @@ void EntityTree::Update(const UpdateInfo &, EntityComponentManager &_ecm)
         parentEntity = kNullEntity;
       }
 
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "AddEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, entity),
-          Q_ARG(QString, QString::fromStdString(nameComp->Data())),
-          Q_ARG(Entity, parentEntity),
-          Q_ARG(QString, entityType(entity, _ecm)));
+      this->dataPtr->treeModel.QueueAddEntity(entity,
+          QString::fromStdString(nameComp->Data()), parentEntity,
+          entityType(entity, _ecm));
     }
 
     for (auto entity : this->dataPtr->removedEntities)
-    {
-      QMetaObject::invokeMethod(&this->dataPtr->treeModel, "RemoveEntity",
-          Qt::QueuedConnection,
-          Q_ARG(Entity, entity));
-    }
+      this->dataPtr->treeModel.QueueRemoveEntity(entity);
 
     this->dataPtr->newEntities.clear();
     this->dataPtr->removedEntities.clear();
@@ -569,6 +785,7 @@ bool EntityTree::eventFilter(QObject *_obj, QEvent *_event)
 
       for (auto entity : addedRemovedEvent->RemovedEntities())
         this->dataPtr->removedEntities.insert(entity);
+      requestGuiSystemUpdate(*this);
     }
   }
 
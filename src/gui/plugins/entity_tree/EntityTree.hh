@@ -18,8 +18,10 @@
 #ifndef IGNITION_GAZEBO_GUI_ENTITYTREE_HH_
 #define IGNITION_GAZEBO_GUI_ENTITYTREE_HH_
 
-#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <ignition/gazebo/Entity.hh>
@@ -31,8 +33,17 @@ namespace gazebo
 {
   class EntityTreePrivate;
 
-  /// \brief TODO
-  class TreeModel : public QStandardItemModel
+  /// \brief Model of the entity tree.
+  ///
+  /// Entities are kept in a lightweight tree of nodes, and the children of a
+  /// node are only exposed to views once the node is expanded, through
+  /// canFetchMore and fetchMore, so large worlds don't create rows which are
+  /// never displayed. Top level entities are always exposed.
+  ///
+  /// Additions and removals can be queued from any thread, and are applied
+  /// together once per event loop iteration, notifying views once per parent
+  /// instead of once per entity.
+  class TreeModel : public QAbstractItemModel
   {
     Q_OBJECT
 
@@ -45,6 +56,35 @@ namespace gazebo
     // Documentation inherited
     public: QHash<int, QByteArray> roleNames() const override;
 
+    // Documentation inherited
+    public: QModelIndex index(int _row, int _column,
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: QModelIndex parent(const QModelIndex &_index) const override;
+
+    // Documentation inherited
+    public: int rowCount(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    // Documentation inherited
+    public: int columnCount(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    // Documentation inherited
+    public: bool hasChildren(const QModelIndex &_parent = QModelIndex()) const
+        override;
+
+    // Documentation inherited
+    public: bool canFetchMore(const QModelIndex &_parent) const override;
+
+    // Documentation inherited
+    public: void fetchMore(const QModelIndex &_parent) override;
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override;
+
     /// \brief Add an entity to the tree.
     /// \param[in] _entity Entity to be added
     /// \param[in] _entityName Name of entity to be added
@@ -60,6 +100,21 @@ namespace gazebo
     /// \param[in] _entity Entity to be removed
     public slots: void RemoveEntity(Entity _entity);
 
+    /// \brief Queue an entity to be added to the tree. Thread safe.
+    /// \param[in] _entity Entity to be added
+    /// \param[in] _entityName Name of entity to be added
+    /// \param[in] _parentEntity Parent entity, kNullEntity for a root entity.
+    /// \param[in] _type Entity type
+    public: void QueueAddEntity(Entity _entity, const QString &_entityName,
+        Entity _parentEntity, const QString &_type);
+
+    /// \brief Queue an entity to be removed from the tree. Thread safe.
+    /// \param[in] _entity Entity to be removed
+    public: void QueueRemoveEntity(Entity _entity);
+
+    /// \brief Apply all the queued additions and removals.
+    public slots: void ProcessQueue();
+
     /// \brief Get the entity type of a tree item at specified index
     /// \param[in] _index Model index
     /// \return Type of entity
@@ -75,8 +130,70 @@ namespace gazebo
     /// \return Entity ID
     public: Q_INVOKABLE Entity EntityId(const QModelIndex &_index) const;
 
-    /// \brief Keep track of which item corresponds to which entity.
-    private: std::map<Entity, QStandardItem *> entityItems;
+    /// \brief Get the index of an entity, exposing it and its ancestors to
+    /// views if they aren't yet.
+    /// \param[in] _entity Entity ID
+    /// \return Model index, invalid if the entity isn't in the tree.
+    public: Q_INVOKABLE QModelIndex EntityIndex(qulonglong _entity);
+
+    /// \brief Node of the tree, holding an entity.
+    private: struct EntityNode
+    {
+      /// \brief Entity ID
+      Entity entity{kNullEntity};
+
+      /// \brief Entity name
+      QString name;
+
+      /// \brief Entity type
+      QString type;
+
+      /// \brief Parent node, null for the root.
+      EntityNode *parent{nullptr};
+
+      /// \brief Row of the node within its parent's children.
+      int row{0};
+
+      /// \brief Child nodes, in order of addition.
+      std::vector<EntityNode *> children;
+
+      /// \brief Number of children exposed to views, which are always the
+      /// first ones.
+      int fetched{0};
+
+      /// \brief True once the children of the node have been fetched, after
+      /// which new children are exposed as they're added.
+      bool populated{false};
+    };
+
+    /// \brief Get the index of a node.
+    /// \param[in] _node Node, which must be exposed.
+    /// \return Model index, invalid for the root.
+    private: QModelIndex NodeIndex(const EntityNode *_node) const;
+
+    /// \brief Get the node of an index.
+    /// \param[in] _index Model index.
+    /// \return Node, the root for invalid indices.
+    private: const EntityNode *IndexNode(const QModelIndex &_index) const;
+
+    /// \brief Check whether a node is exposed to views.
+    /// \param[in] _node Node.
+    /// \return True if the node and all its ancestors are exposed.
+    private: bool Exposed(const EntityNode *_node) const;
+
+    /// \brief Expose the new children of the nodes which grew while adding a
+    /// batch of entities.
+    private: void ExposeGrown();
+
+    /// \brief Root of the tree, parent of the top level entities.
+    private: EntityNode root;
+
+    /// \brief Nodes of all the entities in the tree.
+    private: std::unordered_map<Entity, std::unique_ptr<EntityNode>> nodes;
+
+    /// \brief Entities whose nodes got children while adding a batch,
+    /// kNullEntity for the root.
+    private: std::unordered_set<Entity> grown;
 
     /// \brief Entity information used to queue the pending entities
     struct EntityInfo
@@ -99,8 +216,34 @@ namespace gazebo
     };
 
     /// \brief If an entity is added before its parent, we queue it in this
-    /// vector until their parent shows up or they are deleted.
-    private: std::vector<EntityInfo> pendingEntities;
+    /// map, keyed by parent, until their parent shows up or they are
+    /// deleted.
+    private: std::unordered_multimap<Entity, EntityInfo> pendingEntities;
+
+    /// \brief Add an entity to the tree, and the pending entities waiting for
+    /// it, without exposing them to views.
+    /// \param[in] _info Entity to be added.
+    private: void InsertEntity(EntityInfo _info);
+
+    /// \brief A queued addition or removal.
+    struct QueuedChange
+    {
+      /// \brief True to add the entity, false to remove it.
+      bool add;
+
+      /// \brief Entity to add, only the ID is used for removals.
+      EntityInfo info;
+    };
+
+    /// \brief Changes waiting for ProcessQueue. Protected by queueMutex.
+    private: std::vector<QueuedChange> queue;
+
+    /// \brief True if ProcessQueue has been scheduled. Protected by
+    /// queueMutex.
+    private: bool processScheduled{false};
+
+    /// \brief Protects the queue.
+    private: std::mutex queueMutex;
   };
 
   /// \brief Displays a tree view with all the entities in the world.
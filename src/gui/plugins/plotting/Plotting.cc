@@ -17,6 +17,14 @@
 
 #include "Plotting.hh"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Vector2.hh>
 #include <ignition/plugin/Register.hh>
 
 #include "ignition/gazebo/components/AngularAcceleration.hh"
@@ -41,6 +49,165 @@
 
 namespace ignition::gazebo
 {
+  /// \brief Reads the value of a component straight into an array of
+  /// attribute values, in the order of the attributes of its data type.
+  /// \return False if the entity doesn't have the component.
+  using SampleFn = bool (*)(const EntityComponentManager &, Entity,
+      double *);
+
+  /// \brief Fixed capacity queue of chart points. Once full, new points
+  /// overwrite the oldest ones, so that a chart which isn't flushed doesn't
+  /// make the queue grow.
+  class PointRing
+  {
+    /// \brief Constructor
+    /// \param[in] _capacity Maximum number of points.
+    public: explicit PointRing(std::size_t _capacity) : points(_capacity) {}
+
+    /// \brief Add a point, dropping the oldest one if the queue is full.
+    /// \param[in] _x Sim time in seconds.
+    /// \param[in] _y Value.
+    public: void Push(double _x, double _y)
+    {
+      this->points[(this->head + this->size) % this->points.size()] =
+          {_x, _y};
+      if (this->size < this->points.size())
+        ++this->size;
+      else
+        this->head = (this->head + 1) % this->points.size();
+    }
+
+    /// \brief Get a queued point.
+    /// \param[in] _index Index from the oldest point.
+    /// \return The point.
+    public: const math::Vector2d &At(std::size_t _index) const
+    {
+      return this->points[(this->head + _index) % this->points.size()];
+    }
+
+    /// \brief Remove all points.
+    public: void Clear()
+    {
+      this->head = 0u;
+      this->size = 0u;
+    }
+
+    /// \brief Storage of the points.
+    public: std::vector<math::Vector2d> points;
+
+    /// \brief Index of the oldest point.
+    public: std::size_t head{0u};
+
+    /// \brief Number of queued points.
+    public: std::size_t size{0u};
+  };
+
+  /// \brief Samples of a single component attribute. Samples are grouped in
+  /// buckets whose width grows with the plotted time range, so that a long
+  /// plot doesn't accumulate an unbounded number of points on the chart.
+  /// The first sample of each bucket is plotted right away, and the rest
+  /// are reduced to their minimum and maximum, so that peaks aren't lost.
+  class PlotSeries
+  {
+    /// \brief Constructor
+    public: PlotSeries() : pending(1024u) {}
+
+    /// \brief Add a sample.
+    /// \param[in] _x Sim time in seconds.
+    /// \param[in] _y Value.
+    /// \param[in] _maxPoints Number of buckets the plotted time range is
+    /// split into. Zero to plot every sample.
+    public: void Sample(double _x, double _y, unsigned int _maxPoints)
+    {
+      // Start over when simulation is reset
+      if (!this->active || _x < this->bucketStart)
+      {
+        this->active = true;
+        this->first = _x;
+        this->Open(_x, _y);
+        return;
+      }
+
+      const double width = _maxPoints == 0u ? 0.0 :
+          (_x - this->first) / _maxPoints;
+      if (_x - this->bucketStart >= width)
+      {
+        this->Close();
+        this->Open(_x, _y);
+        return;
+      }
+
+      if (!this->hasRest || _y < this->min.Y())
+        this->min.Set(_x, _y);
+      if (!this->hasRest || _y > this->max.Y())
+        this->max.Set(_x, _y);
+      this->hasRest = true;
+    }
+
+    /// \brief Forget all samples, for example because the series isn't
+    /// plotted anymore.
+    public: void Reset()
+    {
+      this->active = false;
+      this->hasRest = false;
+      this->pending.Clear();
+    }
+
+    /// \brief Start a bucket.
+    /// \param[in] _x Sim time of its first sample.
+    /// \param[in] _y Value of its first sample.
+    private: void Open(double _x, double _y)
+    {
+      this->bucketStart = _x;
+      this->hasRest = false;
+      this->pending.Push(_x, _y);
+    }
+
+    /// \brief Queue the extremes of the current bucket, in time order.
+    private: void Close()
+    {
+      if (!this->hasRest)
+        return;
+
+      const auto &a = this->min.X() <= this->max.X() ? this->min : this->max;
+      const auto &b = this->min.X() <= this->max.X() ? this->max : this->min;
+      this->pending.Push(a.X(), a.Y());
+      if (b.X() != a.X())
+        this->pending.Push(b.X(), b.Y());
+      this->hasRest = false;
+    }
+
+    /// \brief Attribute data, which holds the charts of the series.
+    public: std::shared_ptr<ignition::gui::PlotData> data;
+
+    /// \brief Field ID of the series on the charts.
+    public: QString fieldId;
+
+    /// \brief Points waiting to be handed to the charts.
+    public: PointRing pending;
+
+    /// \brief Whether the series is being sampled.
+    private: bool active{false};
+
+    /// \brief Sim time of the first sample.
+    private: double first{0.0};
+
+    /// \brief Sim time of the first sample of the current bucket.
+    private: double bucketStart{0.0};
+
+    /// \brief Whether the current bucket has samples besides its first
+    /// one.
+    private: bool hasRest{false};
+
+    /// \brief Sample with the lowest value of the current bucket, not
+    /// counting its first one.
+    private: math::Vector2d min;
+
+    /// \brief Sample with the highest value of the current bucket, not
+    /// counting its first one.
+    private: math::Vector2d max;
+  };
+
   class PlottingPrivate
   {
     /// \brief Interface to communicate with Qml
@@ -53,6 +220,16 @@ namespace ignition::gazebo
 
     /// \brief Mutex to protect the components map.
     public: std::recursive_mutex componentsMutex;
+
+    /// \brief Number of buckets each plotted time range is split into.
+    public: unsigned int maxPoints{1000u};
+
+    /// \brief Wall clock period at which points are handed to the charts.
+    public: std::chrono::steady_clock::duration batchPeriod{
+        std::chrono::milliseconds(100)};
+
+    /// \brief Last time points were handed to the charts.
+    public: std::chrono::steady_clock::time_point lastFlush;
   };
 
   class PlotComponentPrivate
@@ -70,6 +247,14 @@ namespace ignition::gazebo
     /// ex: x,y,z attributes in Vector3d type component
     public: std::map<std::string,
       std::shared_ptr<ignition::gui::PlotData>> data;
+
+    /// \brief Series of each attribute, in the order values are read by
+    /// `sample`.
+    public: std::vector<PlotSeries> series;
+
+    /// \brief Reads the component, resolved once from its type ID.
+    /// Null if the type can't be plotted.
+    public: SampleFn sample{nullptr};
   };
 }
 
@@ -77,6 +262,152 @@ using namespace ignition;
 using namespace ignition::gazebo;
 using namespace ignition::gui;
 
+/// \brief Maximum number of attributes of a component data type.
+static constexpr std::size_t kMaxAttributes{20u};
+
+/// \brief Attributes of each plottable data type, in the order they're
+/// read by the samplers.
+static const std::map<std::string, std::vector<std::string>> kAttributes{
+  {"Vector3d", {"x", "y", "z"}},
+  {"Pose3d", {"x", "y", "z", "roll", "pitch", "yaw"}},
+  {"Light", {"diffuseR", "diffuseG", "diffuseB", "diffuseA",
+             "specularR", "specularG", "specularB", "specularA",
+             "attRange", "attConstant", "attLinear", "attQuadratic",
+             "castshadows", "directionX", "directionY", "directionZ",
+             "innerAngle", "outerAngle", "falloff", "intensity"}},
+  {"double", {"value"}},
+  {"Physics", {"stepSize", "realTimeFactor"}},
+  {"SphericalCoordinates", {"latitude", "longitude", "elevation",
+                            "heading"}}
+};
+
+//////////////////////////////////////////////////
+static void unpack(const math::Vector3d &_vector, double *_values)
+{
+  _values[0] = _vector.X();
+  _values[1] = _vector.Y();
+  _values[2] = _vector.Z();
+}
+
+//////////////////////////////////////////////////
+static void unpack(const math::Pose3d &_pose, double *_values)
+{
+  unpack(_pose.Pos(), _values);
+  _values[3] = _pose.Rot().Roll();
+  _values[4] = _pose.Rot().Pitch();
+  _values[5] = _pose.Rot().Yaw();
+}
+
+//////////////////////////////////////////////////
+static void unpack(const sdf::Light &_light, double *_values)
+{
+  // Same values as the light message, without going through it
+  _values[0] = _light.Diffuse().R();
+  _values[1] = _light.Diffuse().G();
+  _values[2] = _light.Diffuse().B();
+  _values[3] = _light.Diffuse().A();
+  _values[4] = _light.Specular().R();
+  _values[5] = _light.Specular().G();
+  _values[6] = _light.Specular().B();
+  _values[7] = _light.Specular().A();
+  _values[8] = _light.AttenuationRange();
+  _values[9] = _light.ConstantAttenuationFactor();
+  _values[10] = _light.LinearAttenuationFactor();
+  _values[11] = _light.QuadraticAttenuationFactor();
+  _values[12] = _light.CastShadows();
+  unpack(_light.Direction(), _values + 13);
+  _values[16] = _light.SpotInnerAngle().Radian();
+  _values[17] = _light.SpotOuterAngle().Radian();
+  _values[18] = _light.SpotFalloff();
+  _values[19] = _light.Intensity();
+}
+
+//////////////////////////////////////////////////
+static void unpack(const double _value, double *_values)
+{
+  _values[0] = _value;
+}
+
+//////////////////////////////////////////////////
+static void unpack(const sdf::Physics &_physics, double *_values)
+{
+  _values[0] = _physics.MaxStepSize();
+  _values[1] = _physics.RealTimeFactor();
+}
+
+//////////////////////////////////////////////////
+static void unpack(const math::SphericalCoordinates &_sc, double *_values)
+{
+  _values[0] = _sc.LatitudeReference().Degree();
+  _values[1] = _sc.LongitudeReference().Degree();
+  _values[2] = _sc.ElevationReference();
+  _values[3] = _sc.HeadingOffset().Degree();
+}
+
+//////////////////////////////////////////////////
+template <typename ComponentT>
+static bool sampleComponent(const EntityComponentManager &_ecm,
+    Entity _entity, double *_values)
+{
+  auto comp = _ecm.Component<ComponentT>(_entity);
+  if (nullptr == comp)
+    return false;
+  unpack(comp->Data(), _values);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the sampler and data type of each plottable component type.
+static const std::unordered_map<ComponentTypeId,
+    std::pair<std::string, SampleFn>> &samplers()
+{
+  static const std::unordered_map<ComponentTypeId,
+      std::pair<std::string, SampleFn>> kSamplers{
+    {components::AngularAcceleration::typeId,
+        {"Vector3d", &sampleComponent<components::AngularAcceleration>}},
+    {components::AngularVelocity::typeId,
+        {"Vector3d", &sampleComponent<components::AngularVelocity>}},
+    {components::CastShadows::typeId,
+        {"double", &sampleComponent<components::CastShadows>}},
+    {components::Gravity::typeId,
+        {"Vector3d", &sampleComponent<components::Gravity>}},
+    {components::LinearAcceleration::typeId,
+        {"Vector3d", &sampleComponent<components::LinearAcceleration>}},
+    {components::LinearVelocity::typeId,
+        {"Vector3d", &sampleComponent<components::LinearVelocity>}},
+    {components::MagneticField::typeId,
+        {"Vector3d", &sampleComponent<components::MagneticField>}},
+    {components::ParentEntity::typeId,
+        {"double", &sampleComponent<components::ParentEntity>}},
+    {components::Physics::typeId,
+        {"Physics", &sampleComponent<components::Physics>}},
+    {components::Pose::typeId,
+        {"Pose3d", &sampleComponent<components::Pose>}},
+    {components::Static::typeId,
+        {"double", &sampleComponent<components::Static>}},
+    {components::SphericalCoordinates::typeId,
+        {"SphericalCoordinates",
+         &sampleComponent<components::SphericalCoordinates>}},
+    {components::TrajectoryPose::typeId,
+        {"Pose3d", &sampleComponent<components::TrajectoryPose>}},
+    {components::WindMode::typeId,
+        {"double", &sampleComponent<components::WindMode>}},
+    {components::WorldAngularAcceleration::typeId,
+        {"Vector3d", &sampleComponent<components::WorldAngularAcceleration>}},
+    {components::WorldLinearVelocity::typeId,
+        {"Vector3d", &sampleComponent<components::WorldLinearVelocity>}},
+    {components::WorldLinearVelocitySeed::typeId,
+        {"Vector3d", &sampleComponent<components::WorldLinearVelocitySeed>}},
+    {components::WorldPose::typeId,
+        {"Pose3d", &sampleComponent<components::WorldPose>}},
+    {components::WorldPoseCmd::typeId,
+        {"Pose3d", &sampleComponent<components::WorldPoseCmd>}},
+    {components::Light::typeId,
+        {"Light", &sampleComponent<components::Light>}}
+  };
+  return kSamplers;
+}
+
 //////////////////////////////////////////////////
 PlotComponent::PlotComponent(const std::string &_type,
                              ignition::gazebo::Entity _entity,
@@ -87,60 +418,32 @@ PlotComponent::PlotComponent(const std::string &_type,
   this->dataPtr->typeId = _typeId;
   this->dataPtr->type = _type;
 
-  if (_type == "Vector3d")
-  {
-    this->dataPtr->data["x"] = std::make_shared<PlotData>();
-    this->dataPtr->data["y"] = std::make_shared<PlotData>();
-    this->dataPtr->data["z"] = std::make_shared<PlotData>();
-  }
-  else if (_type == "Pose3d")
-  {
-    this->dataPtr->data["x"] = std::make_shared<PlotData>();
-    this->dataPtr->data["y"] = std::make_shared<PlotData>();
-    this->dataPtr->data["z"] = std::make_shared<PlotData>();
-    this->dataPtr->data["roll"] = std::make_shared<PlotData>();
-    this->dataPtr->data["pitch"] = std::make_shared<PlotData>();
-    this->dataPtr->data["yaw"] = std::make_shared<PlotData>();
-  }
-  else if (_type == "Light")
-  {
-    this->dataPtr->data["diffuseR"] = std::make_shared<PlotData>();
-    this->dataPtr->data["diffuseG"] = std::make_shared<PlotData>();
-    this->dataPtr->data["diffuseB"] = std::make_shared<PlotData>();
-    this->dataPtr->data["diffuseA"] = std::make_shared<PlotData>();
-    this->dataPtr->data["specularR"] = std::make_shared<PlotData>();
-    this->dataPtr->data["specularG"] = std::make_shared<PlotData>();
-    this->dataPtr->data["specularB"] = std::make_shared<PlotData>();
-    this->dataPtr->data["specularA"] = std::make_shared<PlotData>();
-    this->dataPtr->data["attRange"] = std::make_shared<PlotData>();
-    this->dataPtr->data["attConstant"] = std::make_shared<PlotData>();
-    this->dataPtr->data["attLinear"] = std::make_shared<PlotData>();
-    this->dataPtr->data["attQuadratic"] = std::make_shared<PlotData>();
-    this->dataPtr->data["castshadows"] = std::make_shared<PlotData>();
-    this->dataPtr->data["directionX"] = std::make_shared<PlotData>();
-    this->dataPtr->data["directionY"] = std::make_shared<PlotData>();
-    this->dataPtr->data["directionZ"] = std::make_shared<PlotData>();
-    this->dataPtr->data["innerAngle"] = std::make_shared<PlotData>();
-    this->dataPtr->data["outerAngle"] = std::make_shared<PlotData>();
-    this->dataPtr->data["falloff"] = std::make_shared<PlotData>();
-    this->dataPtr->data["intensity"] = std::make_shared<PlotData>();
-  }
-  else if (_type == "double")
-    this->dataPtr->data["value"] = std::make_shared<PlotData>();
-  else if (_type == "Physics")
+  auto attributes = kAttributes.find(_type);
+  if (attributes == kAttributes.end())
   {
-    this->dataPtr->data["stepSize"] = std::make_shared<PlotData>();
-    this->dataPtr->data["realTimeFactor"] = std::make_shared<PlotData>();
+    ignwarn << "Invalid Plot Component Type:" << _type << std::endl;
+    return;
   }
-  else if (_type == "SphericalCoordinates")
+
+  const std::string id = std::to_string(_entity) + "," +
+      std::to_string(_typeId);
+  for (const auto &attribute : attributes->second)
   {
-    this->dataPtr->data["latitude"] = std::make_shared<PlotData>();
-    this->dataPtr->data["longitude"] = std::make_shared<PlotData>();
-    this->dataPtr->data["elevation"] = std::make_shared<PlotData>();
-    this->dataPtr->data["heading"] = std::make_shared<PlotData>();
+    auto data = std::make_shared<PlotData>();
+    this->dataPtr->data[attribute] = data;
+
+    PlotSeries series;
+    series.data = data;
+    series.fieldId = QString::fromStdString(id + "," + attribute);
+    this->dataPtr->series.push_back(std::move(series));
   }
+
+  auto sampler = samplers().find(_typeId);
+  if (sampler != samplers().end() && sampler->second.first == _type)
+    this->dataPtr->sample = sampler->second.second;
   else
-    ignwarn << "Invalid Plot Component Type:" << _type << std::endl;
+    ignwarn << "Component type [" << _typeId << "] can't be plotted as ["
+            << _type << "]" << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -205,6 +508,45 @@ ComponentTypeId PlotComponent::TypeId()
   return this->dataPtr->typeId;
 }
 
+//////////////////////////////////////////////////
+void PlotComponent::Sample(const EntityComponentManager &_ecm, double _time,
+                           unsigned int _maxPoints)
+{
+  std::array<double, kMaxAttributes> values{};
+  if (nullptr == this->dataPtr->sample ||
+      !this->dataPtr->sample(_ecm, this->dataPtr->entity, values.data()))
+  {
+    return;
+  }
+
+  for (std::size_t i = 0; i < this->dataPtr->series.size(); ++i)
+  {
+    auto &series = this->dataPtr->series[i];
+    series.data->SetValue(values[i]);
+    if (series.data->ChartCount() == 0)
+      series.Reset();
+    else
+      series.Sample(_time, values[i], _maxPoints);
+  }
+}
+
+//////////////////////////////////////////////////
+void PlotComponent::Flush(ignition::gui::PlottingInterface *_iface)
+{
+  for (auto &series : this->dataPtr->series)
+  {
+    for (auto chart : series.data->Charts())
+    {
+      for (std::size_t i = 0; i < series.pending.size; ++i)
+      {
+        const auto &point = series.pending.At(i);
+        emit _iface->plot(chart, series.fieldId, point.X(), point.Y());
+      }
+    }
+    series.pending.Clear();
+  }
+}
+
 //////////////////////////////////////////////////
 Plotting::Plotting() : GuiSystem(),
   dataPtr(std::make_unique<PlottingPrivate>())
@@ -232,10 +574,28 @@ Plotting::~Plotting()
 }
 
 //////////////////////////////////////////
-void Plotting::LoadConfig(const tinyxml2::XMLElement *)
+void Plotting::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Plotting";
+
+  // Parameters from SDF
+  if (_pluginElem)
+  {
+    auto ptsElem = _pluginElem->FirstChildElement("max_points");
+    if (nullptr != ptsElem && nullptr != ptsElem->GetText())
+      ptsElem->QueryUnsignedText(&this->dataPtr->maxPoints);
+
+    auto periodElem = _pluginElem->FirstChildElement("batch_period");
+    if (nullptr != periodElem && nullptr != periodElem->GetText())
+    {
+      double period{0.0};
+      periodElem->QueryDoubleText(&period);
+      this->dataPtr->batchPeriod =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(std::max(0.0, period)));
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -400,153 +760,20 @@ void Plotting::Update(const ignition::gazebo::UpdateInfo &_info,
                        ignition::gazebo::EntityComponentManager &_ecm)
 {
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->componentsMutex);
-  for (auto component : this->dataPtr->components)
-  {
-    auto entity = component.second->Entity();
-    auto typeId = component.second->TypeId();
 
-    if (typeId == components::AngularAcceleration::typeId)
-    {
-      auto comp = _ecm.Component<components::AngularAcceleration>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::AngularVelocity::typeId)
-    {
-      auto comp = _ecm.Component<components::AngularVelocity>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::CastShadows::typeId)
-    {
-      auto comp = _ecm.Component<components::CastShadows>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::Gravity::typeId)
-    {
-      auto comp = _ecm.Component<components::Gravity>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::LinearAcceleration::typeId)
-    {
-      auto comp = _ecm.Component<components::LinearAcceleration>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::LinearVelocity::typeId)
-    {
-      auto comp = _ecm.Component<components::LinearVelocity>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::MagneticField::typeId)
-    {
-      auto comp = _ecm.Component<components::MagneticField>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::ParentEntity::typeId)
-    {
-      auto comp = _ecm.Component<components::ParentEntity>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::Physics::typeId)
-    {
-      auto comp = _ecm.Component<components::Physics>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::Pose::typeId)
-    {
-      auto comp = _ecm.Component<components::Pose>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::Static::typeId)
-    {
-      auto comp = _ecm.Component<components::Static>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::SphericalCoordinates::typeId)
-    {
-      auto comp = _ecm.Component<components::SphericalCoordinates>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::TrajectoryPose::typeId)
-    {
-      auto comp = _ecm.Component<components::TrajectoryPose>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WindMode::typeId)
-    {
-      auto comp = _ecm.Component<components::WindMode>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WorldAngularAcceleration::typeId)
-    {
-      auto comp = _ecm.Component<components::WorldAngularAcceleration>(
-                  entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WorldLinearVelocity::typeId)
-    {
-      auto comp = _ecm.Component<components::WorldLinearVelocity>(
-                  entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WorldLinearVelocitySeed::typeId)
-    {
-      auto comp = _ecm.Component<components::WorldLinearVelocitySeed>(
-                  entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WorldPose::typeId)
-    {
-      auto comp = _ecm.Component<components::WorldPose>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::WorldPoseCmd::typeId)
-    {
-      auto comp = _ecm.Component<components::WorldPoseCmd>(entity);
-      if (comp)
-        this->SetData(component.first, comp->Data());
-    }
-    else if (typeId == components::Light::typeId)
-    {
-      auto comp = _ecm.Component<components::Light>(entity);
-      if (comp)
-      {
-        ignition::msgs::Light lightMsgs =
-          convert<ignition::msgs::Light>(comp->Data());
-        this->SetData(component.first, lightMsgs);
-      }
-    }
-
-    for (auto attribute : component.second->Data())
-    {
-      for (auto chart : attribute.second->Charts())
-      {
-        QString attributeName = QString::fromStdString(
-                    component.first + "," + attribute.first);
-        double y = attribute.second->Value();
+  // Each component reads its values through the accessor resolved when it
+  // was registered, and keeps them until the next batch
+  const double x = std::chrono::duration<double>(_info.simTime).count();
+  for (auto &component : this->dataPtr->components)
+    component.second->Sample(_ecm, x, this->dataPtr->maxPoints);
 
-        double x = _info.simTime.count() * std::pow(10, -9);
+  auto now = std::chrono::steady_clock::now();
+  if (now - this->dataPtr->lastFlush < this->dataPtr->batchPeriod)
+    return;
+  this->dataPtr->lastFlush = now;
 
-        emit this->dataPtr->plottingIface->plot(chart, attributeName, x, y);
-      }
-    }
-  }
+  for (auto &component : this->dataPtr->components)
+    component.second->Flush(this->dataPtr->plottingIface.get());
 }
 
 // Register this plugin
@@ -87,6 +87,20 @@ class PlotComponent
   /// \return component type ID
   public: ComponentTypeId TypeId();
 
+  /// \brief Read the component from the ECM and add its values to the
+  /// series of the attributes which are plotted.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _time Sim time in seconds.
+  /// \param[in] _maxPoints Number of buckets the plotted time range is
+  /// decimated into. Zero to plot every sample.
+  public: void Sample(const EntityComponentManager &_ecm, double _time,
+                      unsigned int _maxPoints);
+
+  /// \brief Hand the points sampled since the last call to the charts of
+  /// each attribute.
+  /// \param[in] _iface Interface to the charts.
+  public: void Flush(ignition::gui::PlottingInterface *_iface);
+
   /// \brief dataPtr holds Abstraction data of PlottingPrivate
   private: std::unique_ptr<PlotComponentPrivate> dataPtr;
 };
@@ -95,6 +109,18 @@ class PlottingPrivate;
 
 /// \brief Physics data plotting handler that keeps track of the
 /// registered components, update them and update the plot
+///
+/// ## Configuration
+///
+/// * `<max_points>` (optional): Each series is split into this many buckets
+/// over its plotted time range, and only the first sample of each bucket,
+/// as well as the lowest and highest of the rest, are plotted. This keeps
+/// the number of points on the charts bounded on long plots, without
+/// losing peaks. Zero plots every sample. Defaults to 1000.
+///
+/// * `<batch_period>` (optional): Period in seconds of wall clock time at
+/// which sampled points are handed to the charts, in batches. Defaults to
+/// 0.1.
 class Plotting : public ignition::gazebo::GuiSystem
 {
   Q_OBJECT
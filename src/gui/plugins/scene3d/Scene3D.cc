@@ -18,6 +18,8 @@
 #include "Scene3D.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <condition_variable>
 #include <limits>
@@ -40,7 +42,6 @@
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/StringUtils.hh>
 #include <ignition/common/Uuid.hh>
-#include <ignition/common/VideoEncoder.hh>
 
 #include <ignition/plugin/Register.hh>
 
@@ -69,6 +70,7 @@
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/gui/GuiEvents.hh"
+#include "ignition/gazebo/rendering/AsyncVideoEncoder.hh"
 #include "ignition/gazebo/rendering/RenderUtil.hh"
 
 /// \brief condition variable for lockstepping video recording
@@ -185,6 +187,16 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Video recorder bitrate (bps)
     public: unsigned int recordVideoBitrate = 2070000;
 
+    /// \brief Hardware encoder used to record video, empty for the
+    /// encoders allowed by the environment.
+    public: std::string recordVideoEncoder;
+
+    /// \brief Device of the hardware encoder.
+    public: std::string recordVideoEncoderDevice;
+
+    /// \brief Maximum number of frames waiting to be encoded.
+    public: unsigned int recordVideoMaxQueuedFrames = 8;
+
     /// \brief Previous camera update time during video recording
     /// only used in lockstep mode and recording in sim time.
     public: std::chrono::steady_clock::time_point recordVideoUpdateTime;
@@ -198,8 +210,8 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Image from user camera
     public: rendering::Image cameraImage;
 
-    /// \brief Video encoder
-    public: common::VideoEncoder videoEncoder;
+    /// \brief Video encoder, which encodes frames off the rendering thread
+    public: AsyncVideoEncoder videoEncoder;
 
     // --------------------------------------------------------------
     // CameraTracking
@@ -343,6 +355,38 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \brief Ray query for mouse clicks
     public: rendering::RayQueryPtr rayQuery;
 
+    /// \brief Last point found by ScreenToScene.
+    public: struct ScenePick
+    {
+      /// \brief Screen position the point was picked at.
+      math::Vector2i screenPos;
+
+      /// \brief Camera pose when the point was picked.
+      math::Pose3d cameraPose;
+
+      /// \brief Image size when the point was picked.
+      math::Vector2i imageSize;
+
+      /// \brief Scene revision when the point was picked.
+      uint64_t sceneRevision{0u};
+
+      /// \brief Picked point.
+      math::Vector3d point;
+
+      /// \brief Whether a point was picked.
+      bool valid{false};
+    };
+
+    /// \brief Last point found by ScreenToScene, used for hover events
+    /// which would otherwise cast a ray on every frame.
+    public: ScenePick scenePick;
+
+    /// \brief Protects scenePick, which is also used from the Qt thread.
+    public: std::mutex scenePickMutex;
+
+    /// \brief Incremented each time the scene changes, see SceneChanged.
+    public: std::atomic<uint64_t> sceneRevision{0u};
+
     /// \brief Rendering utility
     public: RenderUtil renderUtil;
 
@@ -359,6 +403,17 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 
     /// \brief ID of thread where render calls can be made.
     public: std::thread::id renderThreadId;
+
+    /// \brief True to only render frames when requested.
+    public: std::atomic<bool> renderOnDemand{false};
+
+    /// \brief True if a new frame was requested while rendering on demand.
+    public: std::atomic<bool> renderRequested{true};
+
+    /// \brief Frames keep being rendered until this time after the last
+    /// request, so that camera motions which depend on time, such as
+    /// following a target, settle.
+    public: std::chrono::steady_clock::time_point renderUntil;
   };
 
   /// \brief Qt and Ogre rendering is happening in different threads
@@ -560,6 +615,13 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// Used when recording in lockstep mode.
     public: std::mutex renderMutex;
 
+    /// \brief True to only render frames when something changed.
+    public: bool renderOnDemand = false;
+
+    /// \brief ECM change tick of the last update, used to tell whether the
+    /// scene changed since.
+    public: uint64_t renderTick = 0u;
+
     /// \brief Text for popup error message
     public: QString errorPopupText;
   };
@@ -655,14 +717,14 @@ RenderUtil *IgnRenderer::RenderUtil() const
 }
 
 /////////////////////////////////////////////////
-void IgnRenderer::Render(RenderSync *_renderSync)
+bool IgnRenderer::Render(RenderSync *_renderSync)
 {
   rendering::ScenePtr scene = this->dataPtr->renderUtil.Scene();
   if (!scene)
   {
     ignwarn << "Scene is null. The render step will not occur in Scene3D."
       << std::endl;
-    return;
+    return false;
   }
 
   this->dataPtr->renderThreadId = std::this_thread::get_id();
@@ -673,6 +735,7 @@ void IgnRenderer::Render(RenderSync *_renderSync)
   std::unique_lock<std::mutex> lock(_renderSync->mutex);
   _renderSync->WaitForQtThreadAndBlock(lock);
 
+  const bool resized = this->textureDirty;
   if (this->textureDirty)
   {
     // TODO(anyone) If SwapFromThread gets implemented,
@@ -701,6 +764,30 @@ void IgnRenderer::Render(RenderSync *_renderSync)
     // _renderSync->ReleaseQtThreadFromBlock(lock);
   }
 
+  // when rendering on demand, skip frames while nothing has changed, still
+  // completing the handshake with the Qt thread
+  if (this->dataPtr->renderOnDemand)
+  {
+    auto now = std::chrono::steady_clock::now();
+    bool needed = resized || this->dataPtr->renderRequested.exchange(false);
+    {
+      std::lock_guard<std::mutex> guard(this->dataPtr->mutex);
+      needed = needed || this->dataPtr->recordVideo ||
+          !this->dataPtr->moveToHelper.Idle() ||
+          !this->dataPtr->moveToTarget.empty() ||
+          this->dataPtr->moveToPoseValue || this->dataPtr->viewAngle;
+    }
+    if (needed)
+    {
+      this->dataPtr->renderUntil = now + std::chrono::milliseconds(500);
+    }
+    else if (now >= this->dataPtr->renderUntil)
+    {
+      _renderSync->ReleaseQtThreadFromBlock(lock);
+      return false;
+    }
+  }
+
   // texture id could change so get the value in every render update
   this->textureId = this->dataPtr->camera->RenderTextureGLId();
 
@@ -817,6 +904,14 @@ void IgnRenderer::Render(RenderSync *_renderSync)
         }
         ignmsg << "Recording video using bitrate: "
                << this->dataPtr->recordVideoBitrate <<  std::endl;
+        this->dataPtr->videoEncoder.SetHardwareEncoder(
+            this->dataPtr->recordVideoEncoder,
+            this->dataPtr->recordVideoEncoderDevice);
+        this->dataPtr->videoEncoder.SetQueueSize(
+            this->dataPtr->recordVideoMaxQueuedFrames);
+        // Frames can't be dropped in lockstep, wait for the encoder instead
+        this->dataPtr->videoEncoder.SetDropFrames(
+            !this->dataPtr->recordVideoLockstep);
         this->dataPtr->videoEncoder.Start(this->dataPtr->recordVideoFormat,
             this->dataPtr->recordVideoSavePath, width, height, 25,
             this->dataPtr->recordVideoBitrate);
@@ -827,6 +922,11 @@ void IgnRenderer::Render(RenderSync *_renderSync)
     else if (this->dataPtr->videoEncoder.IsEncoding())
     {
       this->dataPtr->videoEncoder.Stop();
+      ignmsg << "Stopped recording video. Encoded ["
+             << this->dataPtr->videoEncoder.EncodedFrames()
+             << "] frames, dropped ["
+             << this->dataPtr->videoEncoder.DroppedFrames() << "]."
+             << std::endl;
     }
   }
 
@@ -890,7 +990,7 @@ void IgnRenderer::Render(RenderSync *_renderSync)
     if (!this->dataPtr->moveToTarget.empty())
     {
       _renderSync->ReleaseQtThreadFromBlock(lock);
-      return;
+      return true;
     }
     rendering::NodePtr followTarget = this->dataPtr->camera->FollowTarget();
     if (!this->dataPtr->followTarget.empty())
@@ -1192,6 +1292,7 @@ void IgnRenderer::Render(RenderSync *_renderSync)
   // else
   //  _renderSync->ReleaseQtThreadFromBlock(lock);
   _renderSync->ReleaseQtThreadFromBlock(lock);
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -1471,6 +1572,7 @@ void IgnRenderer::HandleKeyPress(QKeyEvent *_e)
     default:
       break;
   }
+  this->RequestRender();
 }
 
 ////////////////////////////////////////////////
@@ -1527,6 +1629,7 @@ void IgnRenderer::HandleKeyRelease(QKeyEvent *_e)
     default:
       break;
   }
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2287,6 +2390,7 @@ void IgnRenderer::SetTransformMode(const std::string &_mode)
     Entity entity = this->dataPtr->renderUtil.SelectedEntities().back();
     this->dataPtr->selectionHelper = {entity, false, false};
   }
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2295,6 +2399,7 @@ void IgnRenderer::SetModel(const std::string &_model)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->isSpawning = true;
   this->dataPtr->spawnSdfString = _model;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2303,6 +2408,7 @@ void IgnRenderer::SetModelPath(const std::string &_filePath)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->isSpawning = true;
   this->dataPtr->spawnSdfPath = _filePath;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2319,6 +2425,7 @@ void IgnRenderer::SetRecordVideo(bool _record, const std::string &_format,
   this->dataPtr->recordVideo = _record;
   this->dataPtr->recordVideoFormat = _format;
   this->dataPtr->recordVideoSavePath = _savePath;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2342,11 +2449,22 @@ void IgnRenderer::SetRecordVideoBitrate(unsigned int _bitrate)
   this->dataPtr->recordVideoBitrate = _bitrate;
 }
 
+/////////////////////////////////////////////////
+void IgnRenderer::SetRecordVideoEncoder(const std::string &_encoder,
+    const std::string &_device, unsigned int _maxQueuedFrames)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->recordVideoEncoder = _encoder;
+  this->dataPtr->recordVideoEncoderDevice = _device;
+  this->dataPtr->recordVideoMaxQueuedFrames = _maxQueuedFrames;
+}
+
 /////////////////////////////////////////////////
 void IgnRenderer::SetMoveTo(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->moveToTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2356,6 +2474,7 @@ void IgnRenderer::SetFollowTarget(const std::string &_target,
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->followTarget = _target;
   this->dataPtr->followTargetWait = _waitForTarget;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2364,6 +2483,7 @@ void IgnRenderer::SetViewAngle(const math::Vector3d &_direction)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewAngle = true;
   this->dataPtr->viewAngleDirection = _direction;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2371,6 +2491,7 @@ void IgnRenderer::SetMoveToPose(const math::Pose3d &_pose)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->moveToPoseValue = _pose;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2378,6 +2499,7 @@ void IgnRenderer::SetViewTransparentTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewTransparentTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2385,6 +2507,7 @@ void IgnRenderer::SetViewCOMTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewCOMTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2392,6 +2515,7 @@ void IgnRenderer::SetViewInertiaTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewInertiaTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2399,6 +2523,7 @@ void IgnRenderer::SetViewJointsTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewJointsTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2406,6 +2531,7 @@ void IgnRenderer::SetViewWireframesTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewWireframesTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2413,6 +2539,7 @@ void IgnRenderer::SetViewCollisionsTarget(const std::string &_target)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->viewCollisionsTarget = _target;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2424,6 +2551,7 @@ void IgnRenderer::SetViewController(const std::string &_controller)
   // mark mouse dirty to trigger HandleMouseEvent call and
   // set up a new view controller
   this->dataPtr->mouseDirty = true;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2445,6 +2573,7 @@ void IgnRenderer::SetInitCameraPose(const math::Pose3d &_pose)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->moveToHelper.SetInitCameraPose(_pose);
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2462,6 +2591,7 @@ void IgnRenderer::SetFollowOffset(const math::Vector3d &_offset)
 
   if (!this->dataPtr->followTarget.empty())
     this->dataPtr->newFollowOffset = true;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2505,6 +2635,7 @@ void IgnRenderer::NewHoverEvent(const math::Vector2i &_hoverPos)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->mouseHoverPos = _hoverPos;
   this->dataPtr->hoverDirty = true;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2515,6 +2646,7 @@ void IgnRenderer::NewMouseEvent(const common::MouseEvent &_e,
   this->dataPtr->mouseEvent = _e;
   this->dataPtr->drag += _drag;
   this->dataPtr->mouseDirty = true;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2559,17 +2691,41 @@ math::Vector3d IgnRenderer::ScreenToScene(
   double nx = 2.0 * _screenPos.X() / width - 1.0;
   double ny = 1.0 - 2.0 * _screenPos.Y() / height;
 
+  // Reuse the last point while nothing it depends on has changed. Moving
+  // the transform gizmo changes the scene without the ECM, so don't reuse
+  // points while it's active.
+  const math::Vector2i imageSize(this->dataPtr->camera->ImageWidth(),
+      this->dataPtr->camera->ImageHeight());
+  const math::Pose3d cameraPose = this->dataPtr->camera->WorldPose();
+  const uint64_t sceneRevision = this->dataPtr->sceneRevision;
+  std::lock_guard<std::mutex> lock(this->dataPtr->scenePickMutex);
+  auto &pick = this->dataPtr->scenePick;
+  if (pick.valid && pick.screenPos == _screenPos &&
+      pick.imageSize == imageSize && pick.sceneRevision == sceneRevision &&
+      pick.cameraPose == cameraPose &&
+      !this->dataPtr->transformControl.Active())
+  {
+    return pick.point;
+  }
+
   // Make a ray query
   this->dataPtr->rayQuery->SetFromCamera(
       this->dataPtr->camera, math::Vector2d(nx, ny));
 
   auto result = this->dataPtr->rayQuery->ClosestPoint();
-  if (result)
-    return result.point;
 
   // Set point to be 10m away if no intersection found
-  return this->dataPtr->rayQuery->Origin() +
+  math::Vector3d point = result ? result.point :
+      this->dataPtr->rayQuery->Origin() +
       this->dataPtr->rayQuery->Direction() * 10;
+
+  pick.screenPos = _screenPos;
+  pick.imageSize = imageSize;
+  pick.cameraPose = cameraPose;
+  pick.sceneRevision = sceneRevision;
+  pick.point = point;
+  pick.valid = true;
+  return point;
 }
 
 ////////////////////////////////////////////////
@@ -2577,6 +2733,37 @@ void IgnRenderer::RequestSelectionChange(Entity _selectedEntity,
     bool _deselectAll, bool _sendEvent)
 {
   this->dataPtr->selectionHelper = {_selectedEntity, _deselectAll, _sendEvent};
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::SetRenderOnDemand(bool _renderOnDemand)
+{
+  this->dataPtr->renderOnDemand = _renderOnDemand;
+  this->RequestRender();
+}
+
+/////////////////////////////////////////////////
+bool IgnRenderer::RenderOnDemand() const
+{
+  return this->dataPtr->renderOnDemand;
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::RequestRender()
+{
+  if (!this->dataPtr->renderOnDemand)
+    return;
+
+  this->dataPtr->renderRequested = true;
+  emit RenderRequested();
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::SceneChanged()
+{
+  ++this->dataPtr->sceneRevision;
+  this->RequestRender();
 }
 
 /////////////////////////////////////////////////
@@ -2616,9 +2803,14 @@ void RenderThread::RenderNext(RenderSync *_renderSync)
     return;
   }
 
-  this->ignRenderer.Render(_renderSync);
-
-  emit TextureReady(this->ignRenderer.textureId, this->ignRenderer.textureSize);
+  // when rendering on demand, the render loop goes idle until the next
+  // request restarts it, see RenderWindowItem::Ready
+  if (this->ignRenderer.Render(_renderSync) ||
+      !this->ignRenderer.RenderOnDemand())
+  {
+    emit TextureReady(this->ignRenderer.textureId,
+        this->ignRenderer.textureSize);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -2813,6 +3005,12 @@ void RenderWindowItem::Ready()
       &IgnRenderer::FollowTargetChanged,
       this, &RenderWindowItem::SetFollowTarget, Qt::QueuedConnection);
 
+  // schedule a new frame of the window, so that its PrepareNode restarts the
+  // render loop when rendering on demand
+  this->connect(&this->dataPtr->renderThread->ignRenderer,
+      &IgnRenderer::RenderRequested,
+      this, &QQuickItem::update, Qt::QueuedConnection);
+
   this->dataPtr->renderThread->moveToThread(this->dataPtr->renderThread);
 
   this->connect(this, &QQuickItem::widthChanged,
@@ -3130,6 +3328,50 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
                  << std::endl;
         }
       }
+      std::string encoder;
+      std::string device;
+      unsigned int maxQueuedFrames = 8u;
+      if (auto encoderElem = elem->FirstChildElement("hw_encoder"))
+      {
+        if (encoderElem->GetText())
+          encoder = encoderElem->GetText();
+      }
+      if (auto deviceElem = elem->FirstChildElement("hw_encoder_device"))
+      {
+        if (deviceElem->GetText())
+          device = deviceElem->GetText();
+      }
+      if (auto queueElem = elem->FirstChildElement("max_queued_frames"))
+      {
+        if (queueElem->QueryUnsignedText(&maxQueuedFrames) !=
+            tinyxml2::XML_SUCCESS || maxQueuedFrames == 0u)
+        {
+          ignerr << "Failed to parse <max_queued_frames> value: "
+                 << queueElem->GetText() << std::endl;
+          maxQueuedFrames = 8u;
+        }
+      }
+      renderWindow->SetRecordVideoEncoder(encoder, device, maxQueuedFrames);
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("async_scene_updates"))
+    {
+      bool async = false;
+      elem->QueryBoolText(&async);
+      this->dataPtr->renderUtil->SetAsyncUpdates(async);
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("interpolate_poses"))
+    {
+      bool interpolate = false;
+      elem->QueryBoolText(&interpolate);
+      this->dataPtr->renderUtil->SetPoseInterpolation(interpolate);
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("render_on_demand"))
+    {
+      elem->QueryBoolText(&this->dataPtr->renderOnDemand);
+      renderWindow->SetRenderOnDemand(this->dataPtr->renderOnDemand);
     }
 
     if (auto elem = _pluginElem->FirstChildElement("fullscreen"))
@@ -3321,6 +3563,16 @@ void Scene3D::Update(const UpdateInfo &_info,
   this->dataPtr->renderUtil->UpdateECM(_info, _ecm);
   this->dataPtr->renderUtil->UpdateFromECM(_info, _ecm);
 
+  // also needed when rendering continuously, to refresh the scene points
+  // cached for mouse events
+  if (this->dataPtr->renderUtil->SceneChangedSince(_ecm,
+      this->dataPtr->renderTick) ||
+      this->dataPtr->renderUtil->MarkerManager().HasPendingChanges())
+  {
+    renderWindow->SceneChanged();
+  }
+  this->dataPtr->renderTick = _ecm.ChangeTick();
+
   // check if video recording is enabled and if we need to lock step
   // ECM updates with GUI rendering during video recording
   std::unique_lock<std::mutex> lock(this->dataPtr->recordMutex);
@@ -3810,6 +4062,24 @@ void RenderWindowItem::SetDropdownMenuEnabled(bool _enableDropdownMenu)
       _enableDropdownMenu);
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderOnDemand(bool _renderOnDemand)
+{
+  this->dataPtr->renderThread->ignRenderer.SetRenderOnDemand(_renderOnDemand);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::RequestRender()
+{
+  this->dataPtr->renderThread->ignRenderer.RequestRender();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SceneChanged()
+{
+  this->dataPtr->renderThread->ignRenderer.SceneChanged();
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetRecordVideo(bool _record, const std::string &_format,
     const std::string &_savePath)
@@ -3960,6 +4230,14 @@ void RenderWindowItem::SetRecordVideoBitrate(unsigned int _bitrate)
       _bitrate);
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRecordVideoEncoder(const std::string &_encoder,
+    const std::string &_device, unsigned int _maxQueuedFrames)
+{
+  this->dataPtr->renderThread->ignRenderer.SetRecordVideoEncoder(
+      _encoder, _device, _maxQueuedFrames);
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetVisibilityMask(uint32_t _mask)
 {
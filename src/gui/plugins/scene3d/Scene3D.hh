@@ -79,6 +79,22 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
   ///     * \<p_gain\>    : Camera follow movement p gain.
   ///     * \<target\>    : Target to follow.
   /// * \<fullscreen\> : Optional starting the window in fullscreen.
+  /// * \<async_scene_updates\> : Optional, true to keep rendering the last
+  ///                            completed scene at display rate while the
+  ///                            scene is being updated from a new state,
+  ///                            instead of waiting for the update. Defaults
+  ///                            to false.
+  /// * \<interpolate_poses\> : Optional, true to move entities smoothly
+  ///                          between the poses of consecutive states,
+  ///                          at the cost of up to one state of latency.
+  ///                          Defaults to false.
+  /// * \<render_on_demand\> : Optional, true to only render the scene when
+  ///                         it changes, the camera moves, the user
+  ///                         interacts with it or markers are updated,
+  ///                         instead of at display rate. Plugins which draw
+  ///                         into the scene by themselves are only shown
+  ///                         when another change renders a frame. Defaults
+  ///                         to false.
   class Scene3D : public ignition::gazebo::GuiSystem
   {
     Q_OBJECT
@@ -287,7 +303,26 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     ///  \brief Main render function
     /// \param[in] _renderSync RenderSync to safely
     /// synchronize Qt and worker thread (this)
-    public: void Render(RenderSync *_renderSync);
+    /// \return True if a new frame was rendered. Always true unless
+    /// rendering on demand.
+    public: bool Render(RenderSync *_renderSync);
+
+    /// \brief Set whether to only render frames when requested, see
+    /// RequestRender.
+    /// \param[in] _renderOnDemand True to render on demand.
+    public: void SetRenderOnDemand(bool _renderOnDemand);
+
+    /// \brief Get whether frames are only rendered when requested.
+    /// \return True if rendering on demand.
+    public: bool RenderOnDemand() const;
+
+    /// \brief Request a new frame to be rendered. Only has an effect when
+    /// rendering on demand.
+    public: void RequestRender();
+
+    /// \brief Notify that the scene changed, which invalidates the points
+    /// cached by ScreenToScene and requests a new frame.
+    public: void SceneChanged();
 
     /// \brief Initialize the render engine
     /// \return Error message if initialization failed. If empty, no errors
@@ -317,6 +352,16 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// the dropdown menu
     public: void SetDropdownMenuEnabled(bool _enableDropdownMenu);
 
+    /// \brief Set whether to only render frames when requested.
+    /// \param[in] _renderOnDemand True to render on demand.
+    public: void SetRenderOnDemand(bool _renderOnDemand);
+
+    /// \brief Request a new frame to be rendered when rendering on demand.
+    public: void RequestRender();
+
+    /// \brief Notify that the scene changed, see IgnRenderer::SceneChanged.
+    public: void SceneChanged();
+
     /// \brief Set whether to record video
     /// \param[in] _record True to start video recording, false to stop.
     /// \param[in] _format Video encoding format: "mp4", "ogv"
@@ -336,6 +381,16 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _bitrate Bit rate to set to
     public: void SetRecordVideoBitrate(unsigned int _bitrate);
 
+    /// \brief Set the encoder used to record video
+    /// \param[in] _encoder Hardware encoder, such as nvenc or vaapi. Empty
+    /// to use the encoders allowed by the environment.
+    /// \param[in] _device Device of the hardware encoder, empty to pick
+    /// one automatically.
+    /// \param[in] _maxQueuedFrames Maximum number of frames waiting to be
+    /// encoded.
+    public: void SetRecordVideoEncoder(const std::string &_encoder,
+                const std::string &_device, unsigned int _maxQueuedFrames);
+
     /// \brief Move the user camera to move to the speficied target
     /// \param[in] _target Target to move the camera to
     public: void SetMoveTo(const std::string &_target);
@@ -538,7 +593,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
         const;
 
     /// \brief Retrieve the first point on a surface in the 3D scene hit by a
-    /// ray cast from the given 2D screen coordinates.
+    /// ray cast from the given 2D screen coordinates. The point is reused
+    /// for the same coordinates until the camera moves, the window is
+    /// resized or the scene changes, so it's cheap to call on every mouse
+    /// event.
     /// \param[in] _screenPos 2D coordinates on the screen, in pixels.
     /// \return 3D coordinates of a point in the 3D scene.
     public: math::Vector3d ScreenToScene(const math::Vector2i &_screenPos)
@@ -579,6 +637,10 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     signals: void FollowTargetChanged(const std::string &_target,
         bool _waitForTarget);
 
+    /// \brief Signal fired when a new frame is requested while rendering on
+    /// demand, so that the render loop restarts if it's idle.
+    signals: void RenderRequested();
+
     /// \brief Render texture id
     /// Values is constantly constantly cycled/swapped/changed
     /// from a worker thread
@@ -718,6 +780,16 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
     /// \param[in] _bitrate Bit rate to set to
     public: void SetRecordVideoBitrate(unsigned int _bitrate);
 
+    /// \brief Set the encoder used to record video
+    /// \param[in] _encoder Hardware encoder, such as nvenc or vaapi. Empty
+    /// to use the encoders allowed by the environment.
+    /// \param[in] _device Device of the hardware encoder, empty to pick
+    /// one automatically.
+    /// \param[in] _maxQueuedFrames Maximum number of frames waiting to be
+    /// encoded.
+    public: void SetRecordVideoEncoder(const std::string &_encoder,
+                const std::string &_device, unsigned int _maxQueuedFrames);
+
     /// \brief Move the user camera to move to the specified target
     /// \param[in] _target Target to move the camera to
     public: void SetMoveTo(const std::string &_target);
@@ -21,6 +21,9 @@
 #include <ignition/msgs/stringmsg.pb.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <set>
@@ -29,6 +32,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 #include <QQmlProperty>
 
@@ -48,6 +52,7 @@
 
 #include "ignition/rendering/AxisVisual.hh"
 #include "ignition/rendering/Capsule.hh"
+#include <ignition/rendering/Camera.hh>
 #include <ignition/rendering/COMVisual.hh>
 #include <ignition/rendering/Heightmap.hh>
 #include <ignition/rendering/InertiaVisual.hh>
@@ -100,6 +105,45 @@ namespace ignition::gazebo
     /// \brief Update the 3D scene.
     public: void OnRender();
 
+    /// \brief Create the debug visuals of pending entities, until the
+    /// frame's time budget is used. Entities whose visual is out of the
+    /// user camera's view are kept pending until they come into view, so
+    /// that toggling debug visuals on a large world doesn't stall
+    /// rendering.
+    /// \param[in,out] _pending Entities whose visuals need to be created.
+    /// Entities which were handled are removed.
+    /// \param[in] _deadline Time after which no more visuals are created on
+    /// this frame.
+    /// \param[in] _create Function which creates the visuals of an entity.
+    public: void ProcessPending(std::vector<Entity> &_pending,
+                const std::chrono::steady_clock::time_point &_deadline,
+                const std::function<void(const Entity &)> &_create);
+
+    /// \brief Get whether a visual is within the user camera's view.
+    /// \param[in] _visual Visual to check.
+    /// \return True if the visual's origin is roughly within the camera's
+    /// frustum, or if there's no user camera.
+    public: bool InView(const rendering::VisualPtr &_visual) const;
+
+    /// \brief Remove entities from a list of pending entities.
+    /// \param[in,out] _pending Pending entities.
+    /// \param[in] _entities Entities to remove.
+    /// \return True if any of the entities was pending.
+    public: static bool CancelPending(std::vector<Entity> &_pending,
+                const std::vector<Entity> &_entities);
+
+    /// \brief User camera, used to create debug visuals in view first.
+    public: rendering::CameraPtr camera;
+
+    /// \brief Time spent creating debug visuals on each frame.
+    public: std::chrono::steady_clock::duration creationBudget{
+        std::chrono::milliseconds(5)};
+
+    /// \brief ID from which to start looking for a free ID for new debug
+    /// visuals, so that creating many of them doesn't test the same IDs
+    /// over and over.
+    public: Entity nextVisualId{0u};
+
     /// \brief Helper function to get all child links of a model entity.
     /// \param[in] _entity Entity to find child links
     /// \return Vector of child links found for the parent entity
@@ -554,6 +598,26 @@ void VisualizationCapabilitiesPrivate::OnRender()
     this->sceneManager.SetScene(this->scene);
   }
 
+  if (nullptr == this->camera)
+  {
+    for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
+    {
+      auto cam = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+      if (cam && cam->HasUserData("user-camera") &&
+          std::holds_alternative<bool>(cam->UserData("user-camera")) &&
+          std::get<bool>(cam->UserData("user-camera")))
+      {
+        this->camera = cam;
+        break;
+      }
+    }
+  }
+
+  // Debug visuals are created within a time budget per frame
+  const auto deadline = std::chrono::steady_clock::now() +
+      this->creationBudget;
+
   // create new wireframe visuals
   for (const auto &link : this->newWireframeVisualLinks)
   {
@@ -607,116 +671,116 @@ void VisualizationCapabilitiesPrivate::OnRender()
   this->newTransparentVisualLinks.clear();
 
   // create new inertia visuals
-  for (const auto &link : this->newInertiaLinks)
+  auto createInertia = [this](const Entity &_link)
   {
     // create a new id for the inertia visual
     auto attempts = 100000u;
     for (auto i = 0u; i < attempts; ++i)
     {
-      Entity id = i;
+      Entity id = this->nextVisualId + i;
       if (!this->scene->HasNodeId(id) && !this->scene->HasLightId(id) &&
           !this->scene->HasSensorId(id) && !this->scene->HasVisualId(id) &&
-          !this->viewingInertias[link])
+          !this->viewingInertias[_link])
       {
         auto existsVisual = this->VisualByEntity(id);
-        auto parentInertiaVisual = this->VisualByEntity(link);
+        auto parentInertiaVisual = this->VisualByEntity(_link);
 
         if (existsVisual == nullptr && parentInertiaVisual != nullptr)
         {
-          this->CreateInertiaVisual(id, this->entityInertials[link],
+          this->CreateInertiaVisual(id, this->entityInertials[_link],
             parentInertiaVisual);
         }
         else
         {
           continue;
         }
-        this->viewingInertias[link] = true;
-        this->linkToInertiaVisuals[link] = id;
+        this->viewingInertias[_link] = true;
+        this->linkToInertiaVisuals[_link] = id;
+        this->nextVisualId = id + 1;
         break;
       }
     }
-  }
-  this->newInertiaLinks.clear();
+  };
+  this->ProcessPending(this->newInertiaLinks, deadline, createInertia);
 
   // create new joint visuals
+  auto createJoints = [this](const Entity &_model)
   {
-    for (const auto &model : this->newJointModels)
-    {
-      std::vector<Entity> jointEntities =
-          this->modelToJointEntities[model];
+    std::vector<Entity> jointEntities =
+        this->modelToJointEntities[_model];
 
-      for (const auto &jointEntity : jointEntities)
+    for (const auto &jointEntity : jointEntities)
+    {
+      if (!this->scene->HasNodeId(jointEntity) &&
+          !this->scene->HasLightId(jointEntity) &&
+          !this->scene->HasSensorId(jointEntity) &&
+          !this->scene->HasVisualId(jointEntity) &&
+          !this->viewingInertias[jointEntity])
       {
-        if (!this->scene->HasNodeId(jointEntity) &&
-            !this->scene->HasLightId(jointEntity) &&
-            !this->scene->HasSensorId(jointEntity) &&
-            !this->scene->HasVisualId(jointEntity) &&
-            !this->viewingInertias[jointEntity])
-        {
-          std::string childLinkName =
-              this->entityJoints[jointEntity].ChildLinkName();
-          Entity childId =
-              this->matchLinksWithEntities[model][childLinkName];
+        std::string childLinkName =
+            this->entityJoints[jointEntity].ChildLinkName();
+        Entity childId =
+            this->matchLinksWithEntities[_model][childLinkName];
 
-          std::string parentLinkName =
-              this->entityJoints[jointEntity].ParentLinkName();
-          Entity parentId =
-              this->matchLinksWithEntities[model][parentLinkName];
+        std::string parentLinkName =
+            this->entityJoints[jointEntity].ParentLinkName();
+        Entity parentId =
+            this->matchLinksWithEntities[_model][parentLinkName];
 
-          auto joint = this->entityJoints[jointEntity];
+        auto joint = this->entityJoints[jointEntity];
 
-          auto vis = this->CreateJointVisual(
-              jointEntity, joint, childId, parentId);
-          this->viewingJoints[jointEntity] = true;
+        auto vis = this->CreateJointVisual(
+            jointEntity, joint, childId, parentId);
+        this->viewingJoints[jointEntity] = true;
 
-          // Update joint parent visual pose
-          if (joint.Axis(1))
-          {
-            this->updateJointParentPoses.push_back(jointEntity);
-          }
+        // Update joint parent visual pose
+        if (joint.Axis(1))
+        {
+          this->updateJointParentPoses.push_back(jointEntity);
         }
       }
     }
-  }
-  this->newJointModels.clear();
+  };
+  this->ProcessPending(this->newJointModels, deadline, createJoints);
 
   // create new center of mass visuals
-  for (const auto &link : this->newCOMLinks)
+  auto createCOM = [this](const Entity &_link)
   {
     // create a new id for the center of mass visual
     auto attempts = 100000u;
     for (auto i = 0u; i < attempts; ++i)
     {
-      Entity id = i;
+      Entity id = this->nextVisualId + i;
       if (!this->scene->HasNodeId(id) && !this->scene->HasLightId(id) &&
           !this->scene->HasSensorId(id) && !this->scene->HasVisualId(id) &&
-          !this->viewingCOM[link])
+          !this->viewingCOM[_link])
       {
         auto existsVisual = this->VisualByEntity(id);
-        auto parentInertiaVisual = this->VisualByEntity(link);
+        auto parentInertiaVisual = this->VisualByEntity(_link);
 
         if (existsVisual == nullptr && parentInertiaVisual != nullptr)
         {
-          this->CreateCOMVisual(id, this->entityInertials[link],
+          this->CreateCOMVisual(id, this->entityInertials[_link],
             parentInertiaVisual);
         }
         else
         {
           continue;
         }
-        this->viewingCOM[link] = true;
-        this->linkToCOMVisuals[link] = id;
+        this->viewingCOM[_link] = true;
+        this->linkToCOMVisuals[_link] = id;
+        this->nextVisualId = id + 1;
         break;
       }
     }
-  }
-  this->newCOMLinks.clear();
+  };
+  this->ProcessPending(this->newCOMLinks, deadline, createCOM);
 
   // create new collision visuals
-  for (const auto &link : this->newCollisionLinks)
+  auto createCollisions = [this](const Entity &_link)
   {
     std::vector<Entity> colEntities =
-        this->linkToCollisionEntities[link];
+        this->linkToCollisionEntities[_link];
 
     for (const auto &colEntity : colEntities)
     {
@@ -724,9 +788,9 @@ void VisualizationCapabilitiesPrivate::OnRender()
           !this->scene->HasLightId(colEntity) &&
           !this->scene->HasSensorId(colEntity) &&
           !this->scene->HasVisualId(colEntity) &&
-          !this->viewingCollisions[link])
+          !this->viewingCollisions[_link])
       {
-        auto parentCollisionVisual = this->VisualByEntity(link);
+        auto parentCollisionVisual = this->VisualByEntity(_link);
         if (parentCollisionVisual != nullptr)
         {
           auto vis = this->CreateCollision(
@@ -759,8 +823,8 @@ void VisualizationCapabilitiesPrivate::OnRender()
         }
       }
     }
-  }
-  this->newCollisionLinks.clear();
+  };
+  this->ProcessPending(this->newCollisionLinks, deadline, createCollisions);
 
   // create new frame visuals
   for (const auto &entity : this->newFrameEntities)
@@ -1095,6 +1159,84 @@ rendering::VisualPtr VisualizationCapabilitiesPrivate::CreateJointVisual(
   return jointVis;
 }
 
+/////////////////////////////////////////////////
+void VisualizationCapabilitiesPrivate::ProcessPending(
+    std::vector<Entity> &_pending,
+    const std::chrono::steady_clock::time_point &_deadline,
+    const std::function<void(const Entity &)> &_create)
+{
+  // Entities which are kept for later frames are compacted at the front
+  std::size_t kept = 0u;
+  for (std::size_t i = 0u; i < _pending.size(); ++i)
+  {
+    const Entity entity = _pending[i];
+    if (std::chrono::steady_clock::now() >= _deadline)
+    {
+      _pending[kept++] = entity;
+      continue;
+    }
+
+    // Visuals which don't exist yet are handled by _create
+    auto visual = this->VisualByEntity(entity);
+    if (visual && !this->InView(visual))
+    {
+      _pending[kept++] = entity;
+      continue;
+    }
+
+    _create(entity);
+  }
+  _pending.resize(kept);
+
+  // Drop duplicates, for entities which were requested more than once
+  std::sort(_pending.begin(), _pending.end());
+  _pending.erase(std::unique(_pending.begin(), _pending.end()),
+      _pending.end());
+}
+
+/////////////////////////////////////////////////
+bool VisualizationCapabilitiesPrivate::InView(
+    const rendering::VisualPtr &_visual) const
+{
+  if (nullptr == this->camera)
+    return true;
+
+  // Position in the camera frame, where X points forward
+  const auto cameraPose = this->camera->WorldPose();
+  const auto pos = cameraPose.Rot().RotateVectorReverse(
+      _visual->WorldPosition() - cameraPose.Pos());
+
+  // The origin of visuals right around the camera may be out of view while
+  // their geometry isn't
+  if (pos.Length() < 1.0)
+    return true;
+
+  if (pos.X() <= 0.0 || pos.X() > this->camera->FarClipPlane())
+    return false;
+
+  // Leave some margin, since only the origin of the visual is checked
+  const double margin = 1.2;
+  const double tanHalfHFOV = std::tan(this->camera->HFOV().Radian() * 0.5);
+  const double tanHalfVFOV = tanHalfHFOV /
+      std::max(this->camera->AspectRatio(), 1e-6);
+  return std::abs(pos.Y()) <= pos.X() * tanHalfHFOV * margin &&
+         std::abs(pos.Z()) <= pos.X() * tanHalfVFOV * margin;
+}
+
+/////////////////////////////////////////////////
+bool VisualizationCapabilitiesPrivate::CancelPending(
+    std::vector<Entity> &_pending, const std::vector<Entity> &_entities)
+{
+  const std::set<Entity> entities(_entities.begin(), _entities.end());
+  const auto size = _pending.size();
+  _pending.erase(std::remove_if(_pending.begin(), _pending.end(),
+      [&entities](const Entity &_entity)
+      {
+        return entities.count(_entity) > 0;
+      }), _pending.end());
+  return _pending.size() != size;
+}
+
 ////////////////////////////////////////////////
 void VisualizationCapabilitiesPrivate::UpdateJointParentPose(Entity _jointId)
 {
@@ -1790,15 +1932,27 @@ void VisualizationCapabilitiesPrivate::ViewCollisions(const Entity &_entity)
   // create and/or toggle collision visuals
   bool showCol, showColInit = false;
 
-  // first loop looks for new collisions
-  for (const auto &colEntity : colEntities)
+  // toggling while visuals are still being created cancels the ones which
+  // weren't created yet and hides the others
+  links.push_back(_entity);
+  if (CancelPending(this->newCollisionLinks, links))
   {
-    if (this->viewingCollisions.find(colEntity) ==
-        this->viewingCollisions.end())
+    showCol = false;
+    showColInit = true;
+  }
+  else
+  {
+    // first loop looks for new collisions
+    for (const auto &colEntity : colEntities)
     {
-      this->newCollisions.push_back(_entity);
-      showColInit = showCol = true;
+      if (this->viewingCollisions.find(colEntity) ==
+          this->viewingCollisions.end())
+      {
+        showColInit = showCol = true;
+      }
     }
+    if (showColInit)
+      this->newCollisions.push_back(_entity);
   }
 
   // second loop toggles already created collisions
@@ -1837,15 +1991,27 @@ void VisualizationCapabilitiesPrivate::ViewInertia(const Entity &_entity)
 
   // create and/or toggle inertia visuals
   bool showInertia, showInertiaInit = false;
-  // first loop looks for new inertias
-  for (const auto &inertiaLink : inertiaLinks)
+
+  // toggling while visuals are still being created cancels the ones which
+  // weren't created yet and hides the others
+  if (CancelPending(this->newInertiaLinks, inertiaLinks))
   {
-    if (this->viewingInertias.find(inertiaLink) ==
-        this->viewingInertias.end())
+    showInertia = false;
+    showInertiaInit = true;
+  }
+  else
+  {
+    // first loop looks for new inertias
+    for (const auto &inertiaLink : inertiaLinks)
     {
-      this->newInertias.push_back(_entity);
-      showInertiaInit = showInertia = true;
+      if (this->viewingInertias.find(inertiaLink) ==
+          this->viewingInertias.end())
+      {
+        showInertiaInit = showInertia = true;
+      }
     }
+    if (showInertiaInit)
+      this->newInertias.push_back(_entity);
   }
 
   // second loop toggles already created inertias
@@ -1878,6 +2044,7 @@ void VisualizationCapabilitiesPrivate::ViewInertia(const Entity &_entity)
 void VisualizationCapabilitiesPrivate::ViewJoints(const Entity &_entity)
 {
   std::vector<Entity> jointEntities;
+  std::vector<Entity> models{_entity};
   if (this->modelToJointEntities.find(_entity) !=
            this->modelToJointEntities.end())
   {
@@ -1906,6 +2073,7 @@ void VisualizationCapabilitiesPrivate::ViewJoints(const Entity &_entity)
       for (const auto &childModel : childModels)
       {
         modelStack.push(childModel);
+        models.push_back(childModel);
       }
     }
   }
@@ -1913,15 +2081,26 @@ void VisualizationCapabilitiesPrivate::ViewJoints(const Entity &_entity)
   // Toggle joints
   bool showJoint, showJointInit = false;
 
-  // first loop looks for new joints
-  for (const auto &jointEntity : jointEntities)
+  // toggling while visuals are still being created cancels the ones which
+  // weren't created yet and hides the others
+  if (CancelPending(this->newJointModels, models))
   {
-    if (this->viewingJoints.find(jointEntity) ==
-        this->viewingJoints.end())
+    showJoint = false;
+    showJointInit = true;
+  }
+  else
+  {
+    // first loop looks for new joints
+    for (const auto &jointEntity : jointEntities)
     {
-      this->newJoints.push_back(_entity);
-      showJointInit = showJoint = true;
+      if (this->viewingJoints.find(jointEntity) ==
+          this->viewingJoints.end())
+      {
+        showJointInit = showJoint = true;
+      }
     }
+    if (showJointInit)
+      this->newJoints.push_back(_entity);
   }
 
   // second loop toggles joints
@@ -1965,15 +2144,27 @@ void VisualizationCapabilitiesPrivate::ViewCOM(const Entity &_entity)
 
   // create and/or toggle center of mass visuals
   bool showCOM, showCOMInit = false;
-  // first loop looks for new center of mass visuals
-  for (const auto &inertiaLink : inertiaLinks)
+
+  // toggling while visuals are still being created cancels the ones which
+  // weren't created yet and hides the others
+  if (CancelPending(this->newCOMLinks, inertiaLinks))
   {
-    if (this->viewingCOM.find(inertiaLink) ==
-        this->viewingCOM.end())
+    showCOM = false;
+    showCOMInit = true;
+  }
+  else
+  {
+    // first loop looks for new center of mass visuals
+    for (const auto &inertiaLink : inertiaLinks)
     {
-      this->newCOMVisuals.push_back(_entity);
-      showCOMInit = showCOM = true;
+      if (this->viewingCOM.find(inertiaLink) ==
+          this->viewingCOM.end())
+      {
+        showCOMInit = showCOM = true;
+      }
     }
+    if (showCOMInit)
+      this->newCOMVisuals.push_back(_entity);
   }
 
   // second loop toggles already created center of mass visuals
@@ -29,6 +29,7 @@
 
 #include <ignition/plugin/Register.hh>
 
+#include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 
@@ -85,8 +86,23 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
     /// \brief URI sequence to the lidar link
     public: std::string lidarString{""};
 
-    /// \brief LaserScan message from sensor
-    public: msgs::LaserScan msg;
+    /// \brief Ranges of the latest scan. The buffer is reused across
+    /// scans, so once it has grown, receiving a scan doesn't allocate. Only
+    /// the latest scan is kept, so scans which arrive between rendered
+    /// frames are dropped.
+    public: std::vector<double> ranges;
+
+    /// \brief Number of horizontal rays of the latest scan.
+    public: unsigned int horizontalCount{0u};
+
+    /// \brief Number of vertical rays of the latest scan.
+    public: unsigned int verticalCount{0u};
+
+    /// \brief Horizontal angles of the latest scan, min and max.
+    public: math::Vector2d horizontalAngles;
+
+    /// \brief Vertical angles of the latest scan, min and max.
+    public: math::Vector2d verticalAngles;
 
     /// \brief Pose of the lidar visual
     public: math::Pose3d lidarPose{math::Pose3d::Zero};
@@ -108,7 +124,7 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 
     /// \brief Mutex for variable mutated by the checkbox and spinboxes
     /// callbacks.
-    /// The variables are: msg, visualType, minVisualRange and
+    /// The variables are: ranges, visualType, minVisualRange and
     /// maxVisualRange
     public: std::mutex serviceMutex;
 
@@ -123,6 +139,13 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 
     /// \brief lidar sensor entity dirty flag
     public: bool lidarEntityDirty{true};
+
+    /// \brief Whether the ray counts or angles of the latest scan differ
+    /// from those of the visual.
+    public: bool raysDirty{false};
+
+    /// \brief Whether the visual range needs to be set on the visual.
+    public: bool rangeDirty{false};
   };
 }
 }
@@ -239,8 +262,27 @@ bool VisualizeLidar::eventFilter(QObject *_obj, QEvent *_event)
         this->dataPtr->lidar->ClearPoints();
         this->dataPtr->resetVisual = false;
       }
+      if (this->dataPtr->rangeDirty)
+      {
+        this->dataPtr->lidar->SetMaxRange(this->dataPtr->maxVisualRange);
+        this->dataPtr->lidar->SetMinRange(this->dataPtr->minVisualRange);
+        this->dataPtr->rangeDirty = false;
+      }
       if (this->dataPtr->visualDirty)
       {
+        // Only the latest scan is converted, once per rendered frame
+        if (this->dataPtr->raysDirty)
+        {
+          auto &lidar = this->dataPtr->lidar;
+          lidar->SetVerticalRayCount(this->dataPtr->verticalCount);
+          lidar->SetHorizontalRayCount(this->dataPtr->horizontalCount);
+          lidar->SetMinHorizontalAngle(this->dataPtr->horizontalAngles.X());
+          lidar->SetMaxHorizontalAngle(this->dataPtr->horizontalAngles.Y());
+          lidar->SetMinVerticalAngle(this->dataPtr->verticalAngles.X());
+          lidar->SetMaxVerticalAngle(this->dataPtr->verticalAngles.Y());
+          this->dataPtr->raysDirty = false;
+        }
+        this->dataPtr->lidar->SetPoints(this->dataPtr->ranges);
         this->dataPtr->lidar->SetWorldPose(this->dataPtr->lidarPose);
         this->dataPtr->lidar->Update();
         this->dataPtr->visualDirty = false;
@@ -470,27 +512,31 @@ void VisualizeLidar::OnScan(const msgs::LaserScan &_msg)
   std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
   if (this->dataPtr->initialized)
   {
-    this->dataPtr->msg = std::move(_msg);
-    this->dataPtr->lidar->SetVerticalRayCount(
-                                  this->dataPtr->msg.vertical_count());
-    this->dataPtr->lidar->SetHorizontalRayCount(
-                                  this->dataPtr->msg.count());
-    this->dataPtr->lidar->SetMinHorizontalAngle(
-                                  this->dataPtr->msg.angle_min());
-    this->dataPtr->lidar->SetMaxHorizontalAngle(
-                                  this->dataPtr->msg.angle_max());
-    this->dataPtr->lidar->SetMinVerticalAngle(
-                                  this->dataPtr->msg.vertical_angle_min());
-    this->dataPtr->lidar->SetMaxVerticalAngle(
-                                  this->dataPtr->msg.vertical_angle_max());
-
-    this->dataPtr->lidar->SetPoints(std::vector<double>(
-                                  this->dataPtr->msg.ranges().begin(),
-                                  this->dataPtr->msg.ranges().end()));
+    // The visual is updated on the render thread, here we only keep the
+    // latest scan
+    const unsigned int verticalCount = _msg.vertical_count();
+    const unsigned int horizontalCount = _msg.count();
+    const math::Vector2d horizontalAngles(_msg.angle_min(),
+        _msg.angle_max());
+    const math::Vector2d verticalAngles(_msg.vertical_angle_min(),
+        _msg.vertical_angle_max());
+    if (verticalCount != this->dataPtr->verticalCount ||
+        horizontalCount != this->dataPtr->horizontalCount ||
+        horizontalAngles != this->dataPtr->horizontalAngles ||
+        verticalAngles != this->dataPtr->verticalAngles)
+    {
+      this->dataPtr->verticalCount = verticalCount;
+      this->dataPtr->horizontalCount = horizontalCount;
+      this->dataPtr->horizontalAngles = horizontalAngles;
+      this->dataPtr->verticalAngles = verticalAngles;
+      this->dataPtr->raysDirty = true;
+    }
+
+    this->dataPtr->ranges.assign(_msg.ranges().begin(), _msg.ranges().end());
 
     this->dataPtr->visualDirty = true;
 
-    for (auto data_values : this->dataPtr->msg.header().data())
+    for (const auto &data_values : _msg.header().data())
     {
       if (data_values.key() == "frame_id")
       {
@@ -499,10 +545,9 @@ void VisualizeLidar::OnScan(const msgs::LaserScan &_msg)
         {
           this->dataPtr->lidarString = common::trimmed(data_values.value(0));
           this->dataPtr->lidarEntityDirty = true;
-          this->dataPtr->maxVisualRange = this->dataPtr->msg.range_max();
-          this->dataPtr->minVisualRange = this->dataPtr->msg.range_min();
-          this->dataPtr->lidar->SetMaxRange(this->dataPtr->maxVisualRange);
-          this->dataPtr->lidar->SetMinRange(this->dataPtr->minVisualRange);
+          this->dataPtr->maxVisualRange = _msg.range_max();
+          this->dataPtr->minVisualRange = _msg.range_min();
+          this->dataPtr->rangeDirty = true;
           this->MinRangeChanged();
           this->MaxRangeChanged();
           break;
@@ -19,6 +19,7 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -31,6 +32,7 @@
 #include "ignition/gazebo/config.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/Util.hh"
 
 #include "ignition/gazebo/gui/Gui.hh"
 
@@ -122,7 +124,9 @@ extern "C" int runServer(const char *_sdfString,
     const char *_playback, const char *_physicsEngine,
     const char *_renderEngineServer, const char *_renderEngineGui,
     const char *_file, const char *_recordTopics,
-    int _headless)
+    int _headless, const char *_worldCache, const char *_startupTrace,
+    const char *_simCores, const char *_postUpdateCores,
+    const char *_workerCores, const char *_renderCores)
 {
   ignition::gazebo::ServerConfig serverConfig;
 
@@ -337,6 +341,38 @@ extern "C" int runServer(const char *_sdfString,
 
   serverConfig.SetHeadlessRendering(_headless);
 
+  if (_worldCache != nullptr && std::strlen(_worldCache) > 0)
+  {
+    serverConfig.SetWorldCache(ignition::common::absPath(_worldCache));
+  }
+
+  if (_startupTrace != nullptr && std::strlen(_startupTrace) > 0)
+  {
+    serverConfig.SetStartupTracePath(
+        ignition::common::absPath(_startupTrace));
+  }
+
+  using ThreadGroup = ignition::gazebo::ServerConfig::ThreadGroup;
+  const std::vector<std::pair<ThreadGroup, const char *>> coreLists{
+      {ThreadGroup::kSimulation, _simCores},
+      {ThreadGroup::kPostUpdate, _postUpdateCores},
+      {ThreadGroup::kWorkers, _workerCores},
+      {ThreadGroup::kRendering, _renderCores}};
+  for (const auto &[group, list] : coreLists)
+  {
+    if (list == nullptr || std::strlen(list) == 0)
+      continue;
+
+    auto cores = ignition::gazebo::parseCoreList(list);
+    if (!cores)
+    {
+      ignwarn << "Invalid list of cores [" << list << "], ignoring it."
+              << std::endl;
+      continue;
+    }
+    serverConfig.SetThreadAffinity(group, *cores);
+  }
+
   if (_renderEngineServer != nullptr && std::strlen(_renderEngineServer) > 0)
   {
     serverConfig.SetRenderEngineServer(_renderEngineServer);
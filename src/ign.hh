@@ -55,6 +55,12 @@ extern "C" const char *worldInstallDir();
 /// \param[in] _recordTopics Colon separated list of topics to record. Leave
 /// null to record the default topics.
 /// \param[in] _headless True if server rendering should run headless
+/// \param[in] _worldCache --world-cache option
+/// \param[in] _startupTrace --startup-trace option
+/// \param[in] _simCores --sim-cores option
+/// \param[in] _postUpdateCores --post-update-cores option
+/// \param[in] _workerCores --worker-cores option
+/// \param[in] _renderCores --render-cores option
 /// \return 0 if successful, 1 if not.
 extern "C" int runServer(const char *_sdfString,
     int _iterations, int _run, float _hz, int _levels,
@@ -63,7 +69,10 @@ extern "C" int runServer(const char *_sdfString,
     int _logCompress, const char *_playback,
     const char *_physicsEngine, const char *_renderEngineServer,
     const char *_renderEngineGui, const char *_file,
-    const char *_recordTopics, int _headless);
+    const char *_recordTopics, int _headless, const char *_worldCache,
+    const char *_startupTrace, const char *_simCores,
+    const char *_postUpdateCores, const char *_workerCores,
+    const char *_renderCores);
 
 /// \brief External hook to run simulation GUI.
 /// \param[in] _guiConfig Path to Ignition GUI configuration file.
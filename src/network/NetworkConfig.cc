@@ -17,6 +17,7 @@
 #include "NetworkConfig.hh"
 
 #include <algorithm>
+#include <string>
 
 #include "ignition/common/Console.hh"
 #include "ignition/common/Util.hh"
@@ -74,6 +75,30 @@ NetworkConfig NetworkConfig::FromValues(const std::string &_role,
     }
   }
 
+  std::string pipelined;
+  if (common::env("IGN_GAZEBO_NETWORK_PIPELINED", pipelined))
+  {
+    std::transform(pipelined.begin(), pipelined.end(), pipelined.begin(),
+        ::tolower);
+    config.pipelined = (pipelined == "1" || pipelined == "true");
+  }
+
+  std::string sharedMemory;
+  if (common::env("IGN_GAZEBO_NETWORK_SHARED_MEMORY", sharedMemory))
+  {
+    std::transform(sharedMemory.begin(), sharedMemory.end(),
+        sharedMemory.begin(), ::tolower);
+    config.sharedMemory = !(sharedMemory == "0" || sharedMemory == "false");
+  }
+
+  std::string regions;
+  if (common::env("IGN_GAZEBO_NETWORK_REGIONS", regions))
+  {
+    std::transform(regions.begin(), regions.end(), regions.begin(),
+        ::tolower);
+    config.regions = (regions == "1" || regions == "true");
+  }
+
   return config;
 }
 
@@ -43,6 +43,13 @@ namespace ignition
       /// \param[in] _role One of [primary, secondary].
       /// \param[in] _secondaries Number of secondaries the primary should
       /// expect. This is only meaningful if _role == primary.
+      /// The pipelined flag is read from the IGN_GAZEBO_NETWORK_PIPELINED
+      /// environment variable, which enables it when set to 1 or true.
+      /// The shared memory flag is read from the
+      /// IGN_GAZEBO_NETWORK_SHARED_MEMORY environment variable, which
+      /// disables it when set to 0 or false.
+      /// The regions flag is read from the IGN_GAZEBO_NETWORK_REGIONS
+      /// environment variable, which enables it when set to 1 or true.
       /// \return A NetworkConfig object based on the provided values.
       public: static NetworkConfig FromValues(const std::string &_role,
                                               unsigned int _secondaries = 0);
@@ -52,6 +59,24 @@ namespace ignition
 
       /// \brief Expect number of network secondaries.
       public: size_t numSecondariesExpected { 0 };
+
+      /// \brief Whether the primary steps its own systems while the
+      /// secondaries compute, instead of waiting for them first. The states
+      /// of the secondaries then reach the primary's systems one iteration
+      /// later. Set from the IGN_GAZEBO_NETWORK_PIPELINED environment
+      /// variable.
+      public: bool pipelined { false };
+
+      /// \brief Whether peers on the same host exchange steps and states
+      /// through shared memory instead of ign-transport. Can be disabled
+      /// through the IGN_GAZEBO_NETWORK_SHARED_MEMORY environment variable.
+      public: bool sharedMemory { true };
+
+      /// \brief Whether each secondary owns a spatial region of the levels,
+      /// and performers are handed over to the owner of the region they're
+      /// in, instead of being balanced by load. Set from the
+      /// IGN_GAZEBO_NETWORK_REGIONS environment variable.
+      public: bool regions { false };
     };
     }
   }  // namespace gazebo
@@ -61,3 +61,77 @@ TEST(NetworkManager, ValueConstructor)
   }
 }
 
+TEST(NetworkManager, Pipelined)
+{
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_PIPELINED");
+  {
+    // Disabled by default
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_FALSE(config.pipelined);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_PIPELINED", "TRUE");
+  {
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_TRUE(config.pipelined);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_PIPELINED", "0");
+  {
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_FALSE(config.pipelined);
+  }
+
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_PIPELINED");
+}
+
+/////////////////////////////////////////////////
+TEST(NetworkManager, SharedMemory)
+{
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_SHARED_MEMORY");
+  {
+    // Enabled by default
+    auto config = NetworkConfig::FromValues("SECONDARY", 0);
+    EXPECT_TRUE(config.sharedMemory);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_SHARED_MEMORY", "False");
+  {
+    auto config = NetworkConfig::FromValues("SECONDARY", 0);
+    EXPECT_FALSE(config.sharedMemory);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_SHARED_MEMORY", "1");
+  {
+    auto config = NetworkConfig::FromValues("SECONDARY", 0);
+    EXPECT_TRUE(config.sharedMemory);
+  }
+
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_SHARED_MEMORY");
+}
+
+/////////////////////////////////////////////////
+TEST(NetworkManager, Regions)
+{
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_REGIONS");
+  {
+    // Disabled by default
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_FALSE(config.regions);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_REGIONS", "1");
+  {
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_TRUE(config.regions);
+  }
+
+  ignition::common::setenv("IGN_GAZEBO_NETWORK_REGIONS", "false");
+  {
+    auto config = NetworkConfig::FromValues("PRIMARY", 3);
+    EXPECT_FALSE(config.regions);
+  }
+
+  ignition::common::unsetenv("IGN_GAZEBO_NETWORK_REGIONS");
+}
+
@@ -175,3 +175,43 @@ NetworkConfig NetworkManager::Config() const
 {
   return this->dataPtr->config;
 }
+
+//////////////////////////////////////////////////
+void ignition::gazebo::FillStatistics(const std::string &_prefix,
+    const SecondaryStepStatistics &_stats,
+    private_msgs::SecondaryStatistics &_msg)
+{
+  _msg.set_prefix(_prefix);
+  _msg.set_steps(_stats.steps);
+  if (_stats.steps > 0u)
+  {
+    _msg.set_round_trip_time(_stats.roundTripTime / _stats.steps);
+    _msg.set_compute_time(_stats.computeTime / _stats.steps);
+  }
+  _msg.set_max_round_trip_time(_stats.maxRoundTripTime);
+  _msg.set_bytes_sent(_stats.bytesSent);
+  _msg.set_bytes_received(_stats.bytesReceived);
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, std::string> ignition::gazebo::HeartbeatStatistics(
+    const private_msgs::NetworkStatistics &_msg)
+{
+  std::map<std::string, std::string> data;
+  data["steps"] = std::to_string(_msg.steps());
+  data["apply_time"] = std::to_string(_msg.apply_time());
+  for (const auto &secondary : _msg.secondaries())
+  {
+    const std::string prefix{secondary.prefix() + "/"};
+    data[prefix + "steps"] = std::to_string(secondary.steps());
+    data[prefix + "round_trip_time"] =
+        std::to_string(secondary.round_trip_time());
+    data[prefix + "max_round_trip_time"] =
+        std::to_string(secondary.max_round_trip_time());
+    data[prefix + "compute_time"] = std::to_string(secondary.compute_time());
+    data[prefix + "bytes_sent"] = std::to_string(secondary.bytes_sent());
+    data[prefix + "bytes_received"] =
+        std::to_string(secondary.bytes_received());
+  }
+  return data;
+}
@@ -18,20 +18,29 @@
 #include "NetworkManagerPrimary.hh"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <future>
+#include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
+#include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
 
 #include "msgs/peer_control.pb.h"
 #include "msgs/simulation_step.pb.h"
 
+#include "ignition/gazebo/components/Level.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/PerformerAffinity.hh"
 #include "ignition/gazebo/components/PerformerLevels.hh"
+#include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
@@ -44,6 +53,83 @@ using namespace ignition;
 using namespace gazebo;
 using namespace std::chrono_literals;
 
+/// \brief Number of iterations between attempts to rebalance affinities.
+static constexpr uint64_t kRebalancePeriod{500u};
+
+/// \brief Relative load difference between the busiest and the least busy
+/// secondaries above which a performer is migrated.
+static constexpr double kLoadImbalance{0.25};
+
+/// \brief Number of rebalance periods during which a migrated performer
+/// isn't migrated again.
+static constexpr uint64_t kMigrationCooldown{10u};
+
+/// \brief Weight of the latest step time in the smoothed load of a
+/// secondary.
+static constexpr double kLoadSmoothing{0.1};
+
+/// \brief Size in bytes of the rings of shared memory channels. Each holds
+/// at most one step or ack at a time, so this only bounds the size of a
+/// message. Pages are only backed by memory as they're touched.
+static constexpr std::size_t kSharedMemoryCapacity{64u << 20};
+
+/// \brief Level entity and the position of its center.
+using LevelCenter = std::pair<Entity, math::Vector3d>;
+
+//////////////////////////////////////////////////
+/// \brief Split levels into contiguous regions, one per secondary, and
+/// assign each level to the owner of its region.
+/// \param[in] _begin First level to split.
+/// \param[in] _end One past the last level to split.
+/// \param[in] _owners Prefixes of the secondaries which share the levels.
+/// \param[out] _levelOwners Owner of each level.
+static void splitRegions(std::vector<LevelCenter>::iterator _begin,
+    std::vector<LevelCenter>::iterator _end,
+    const std::vector<std::string> &_owners,
+    std::map<Entity, std::string> &_levelOwners)
+{
+  if (_begin == _end || _owners.empty())
+    return;
+
+  if (_owners.size() == 1u)
+  {
+    for (auto it = _begin; it != _end; ++it)
+      _levelOwners[it->first] = _owners.front();
+    return;
+  }
+
+  // Split along the axis in which the levels are most spread out, so that
+  // regions stay compact
+  math::Vector3d min{_begin->second};
+  math::Vector3d max{_begin->second};
+  for (auto it = _begin; it != _end; ++it)
+  {
+    min.Min(it->second);
+    max.Max(it->second);
+  }
+  const auto extent = max - min;
+  std::size_t axis{0u};
+  if (extent.Y() > extent[axis])
+    axis = 1u;
+  if (extent.Z() > extent[axis])
+    axis = 2u;
+
+  // Each half gets a number of levels proportional to its secondaries
+  const std::size_t lowOwners = _owners.size() / 2u;
+  const auto count = static_cast<std::size_t>(std::distance(_begin, _end));
+  auto mid = _begin + count * lowOwners / _owners.size();
+  std::nth_element(_begin, mid, _end,
+      [axis](const LevelCenter &_a, const LevelCenter &_b)
+      {
+        return _a.second[axis] < _b.second[axis];
+      });
+
+  splitRegions(_begin, mid, std::vector<std::string>(_owners.begin(),
+      _owners.begin() + lowOwners), _levelOwners);
+  splitRegions(mid, _end, std::vector<std::string>(
+      _owners.begin() + lowOwners, _owners.end()), _levelOwners);
+}
+
 //////////////////////////////////////////////////
 NetworkManagerPrimary::NetworkManagerPrimary(
     const std::function<void(const UpdateInfo &_info)> &_stepFunction,
@@ -55,6 +141,10 @@ NetworkManagerPrimary::NetworkManagerPrimary(
   this->simStepPub = this->node.Advertise<private_msgs::SimulationStep>("step");
 
   this->node.Subscribe("step_ack", &NetworkManagerPrimary::OnStepAck, this);
+
+  this->statisticsPub = this->node.Advertise<private_msgs::NetworkStatistics>(
+      kNetworkStatisticsTopic);
+  this->lastStatistics = std::chrono::steady_clock::now();
 }
 
 //////////////////////////////////////////////////
@@ -70,6 +160,23 @@ void NetworkManagerPrimary::Handshake()
     sc->id = peer;
     sc->prefix = peer.substr(0, 8);
 
+    // Offer shared memory channels, which the secondary can only open if it
+    // runs on the same host
+    if (this->dataPtr->config.sharedMemory)
+    {
+      const std::string channel{"ign_gazebo_" +
+          this->dataPtr->peerInfo.id.substr(0, 8) + "_" + sc->prefix};
+      sc->stepChannel = SharedMemoryChannel::Create(channel + "_step",
+          kSharedMemoryCapacity);
+      sc->ackChannel = SharedMemoryChannel::Create(channel + "_ack",
+          kSharedMemoryCapacity);
+      if (sc->stepChannel && sc->ackChannel)
+      {
+        req.set_step_channel(sc->stepChannel->Name());
+        req.set_ack_channel(sc->ackChannel->Name());
+      }
+    }
+
     bool result;
     std::string topic {sc->prefix + "/control"};
     unsigned int timeout = 5000;
@@ -96,6 +203,17 @@ void NetworkManagerPrimary::Handshake()
              << timeout << " ms" << std::endl;
     }
 
+    if (executed && result && resp.shared_memory())
+    {
+      ignmsg << "Exchanging steps with peer [" << sc->prefix
+             << "] through shared memory" << std::endl;
+    }
+    else
+    {
+      sc->stepChannel.reset();
+      sc->ackChannel.reset();
+    }
+
     this->secondaries[sc->prefix] = std::move(sc);
   }
 }
@@ -142,20 +260,72 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
     return false;
   }
 
-  // Send step to all secondaries
-  this->secondaryStates.clear();
-  this->secondaryStatesPromise = std::promise<void>{};
+  // Send step to all secondaries, the ones on the same host through shared
+  // memory
+  {
+    std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+    this->secondaryStates.clear();
+    this->secondaryAckTimes.clear();
+    this->secondaryStatesPromise = std::promise<void>{};
+  }
   auto future = this->secondaryStatesPromise.get_future();
-  this->simStepPub.Publish(step);
+  const std::size_t stepBytes = step.ByteSizeLong();
+  this->stepSentTime = std::chrono::steady_clock::now();
+  bool transportSecondaries{false};
+  for (const auto &secondary : this->secondaries)
+  {
+    this->stepStatistics[secondary.first].bytesSent += stepBytes;
+
+    const auto &channel = secondary.second->stepChannel;
+    if (nullptr == channel)
+    {
+      transportSecondaries = true;
+    }
+    else if (!channel->Write(step))
+    {
+      ignerr << "Failed to send step through shared memory to secondary ["
+             << secondary.first << "]. Stopping simulation." << std::endl;
+      this->dataPtr->eventMgr->Emit<events::Stop>();
+      return false;
+    }
+  }
+  if (transportSecondaries)
+    this->simStepPub.Publish(step);
+
+  // Step all systems while the secondaries compute. Their states are applied
+  // below, so the primary's systems see them on the next iteration.
+  const bool pipelined = this->dataPtr->config.pipelined;
+  if (pipelined)
+  {
+    this->dataPtr->stepFunction(_info);
+    this->dataPtr->ecm->SetAllComponentsUnchanged();
+  }
 
   // Block until all secondaries are done
   {
     IGN_PROFILE("Waiting for secondaries");
 
-    auto result = future.wait_for(10s);
+    // Acks sent through shared memory are polled, which costs a core while
+    // waiting but avoids waking up a thread for each ack
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    std::future_status result;
+    do
+    {
+      if (!this->ReceiveSharedMemoryAcks())
+      {
+        result = future.wait_until(deadline);
+        break;
+      }
+      result = future.wait_for(0s);
+      if (std::future_status::ready != result)
+        std::this_thread::yield();
+    }
+    while (std::future_status::ready != result &&
+           std::chrono::steady_clock::now() < deadline);
 
     if (std::future_status::ready != result)
     {
+      std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
       ignerr << "Waited 10 s and got only [" << this->secondaryStates.size()
              << " / " << this->secondaries.size()
              << "] responses from secondaries. Stopping simulation."
@@ -165,20 +335,68 @@ bool NetworkManagerPrimary::Step(const UpdateInfo &_info)
     }
   }
 
-  // Update primary state with states received from secondaries
+  // Update primary state with states received from secondaries. Each
+  // secondary only sends the components which changed during its step.
+  // The replies are merged and applied at once, so that all updated
+  // components are deserialized in parallel instead of one reply at a time.
+  // Replies with one-time changes are merged apart, so that the periodic
+  // changes of the other secondaries aren't marked as one-time.
   {
     IGN_PROFILE("Updating primary state");
-    for (const auto &msg : this->secondaryStates)
+    msgs::SerializedStateMap periodic;
+    msgs::SerializedStateMap oneTime;
+    oneTime.set_has_one_time_component_changes(true);
+    for (std::size_t i = 0; i < this->secondaryStates.size(); ++i)
     {
-      this->dataPtr->ecm->SetState(msg);
+      auto &msg = this->secondaryStates[i];
+      this->UpdateSecondaryLoad(msg, std::chrono::duration<double>(
+          this->secondaryAckTimes[i] - this->stepSentTime).count());
+
+      auto &mergedEntities = msg.has_one_time_component_changes() ?
+          *oneTime.mutable_entities() : *periodic.mutable_entities();
+      for (auto &entity : *msg.mutable_entities())
+      {
+        auto existing = mergedEntities.find(entity.first);
+        if (existing == mergedEntities.end())
+        {
+          mergedEntities[entity.first].Swap(&entity.second);
+          continue;
+        }
+
+        // Each entity should be owned by a single secondary. If several
+        // replies still update it, the last one wins.
+        if (entity.second.remove())
+          existing->second.set_remove(true);
+        for (auto &comp : *entity.second.mutable_components())
+        {
+          (*existing->second.mutable_components())[comp.first].Swap(
+              &comp.second);
+        }
+      }
     }
     this->secondaryStates.clear();
+    this->secondaryAckTimes.clear();
+
+    const auto applyStart = std::chrono::steady_clock::now();
+    for (const auto *merged : {&periodic, &oneTime})
+    {
+      if (!merged->entities().empty())
+        this->dataPtr->ecm->SetState(*merged);
+    }
+    this->applyTime += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - applyStart).count();
   }
 
   // Step all systems
-  this->dataPtr->stepFunction(_info);
+  if (!pipelined)
+  {
+    this->dataPtr->stepFunction(_info);
+
+    this->dataPtr->ecm->SetAllComponentsUnchanged();
+  }
 
-  this->dataPtr->ecm->SetAllComponentsUnchanged();
+  ++this->statisticsSteps;
+  this->PublishStatistics();
 
   return true;
 }
@@ -199,13 +417,40 @@ std::map<std::string, SecondaryControl::Ptr>
 //////////////////////////////////////////////////
 void NetworkManagerPrimary::OnStepAck(const msgs::SerializedStateMap &_msg)
 {
-  this->secondaryStates.push_back(_msg);
+  this->AddSecondaryState(msgs::SerializedStateMap(_msg));
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::AddSecondaryState(
+    msgs::SerializedStateMap &&_msg)
+{
+  std::lock_guard<std::mutex> lock(this->secondaryStatesMutex);
+  this->secondaryStates.push_back(std::move(_msg));
+  this->secondaryAckTimes.push_back(std::chrono::steady_clock::now());
   if (this->secondaryStates.size() == this->secondaries.size())
   {
     this->secondaryStatesPromise.set_value();
   }
 }
 
+//////////////////////////////////////////////////
+bool NetworkManagerPrimary::ReceiveSharedMemoryAcks()
+{
+  bool sharedMemory{false};
+  msgs::SerializedStateMap msg;
+  for (const auto &secondary : this->secondaries)
+  {
+    const auto &channel = secondary.second->ackChannel;
+    if (nullptr == channel)
+      continue;
+
+    sharedMemory = true;
+    while (channel->Read(msg))
+      this->AddSecondaryState(std::move(msg));
+  }
+  return sharedMemory;
+}
+
 //////////////////////////////////////////////////
 bool NetworkManagerPrimary::SecondariesCanStep() const
 {
@@ -222,6 +467,12 @@ void NetworkManagerPrimary::PopulateAffinities(
 {
   IGN_PROFILE("NetworkManagerPrimary::PopulateAffinities");
 
+  if (this->dataPtr->config.regions)
+  {
+    this->PopulateRegionAffinities(_msg);
+    return;
+  }
+
   // p: performer
   // l: level
   // s: secondary
@@ -301,6 +552,287 @@ void NetworkManagerPrimary::PopulateAffinities(
   }
 
   // TODO(louise) Process level changes
+
+  this->RebalanceAffinities(_msg);
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::UpdateSecondaryLoad(
+    const msgs::SerializedStateMap &_msg, double _roundTripTime)
+{
+  std::string prefix;
+  double stepTime{-1.0};
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.value_size() == 0)
+      continue;
+
+    if (data.key() == kSecondaryPrefixKey)
+    {
+      prefix = data.value(0);
+    }
+    else if (data.key() == kSecondaryStepTimeKey)
+    {
+      try
+      {
+        stepTime = std::stod(data.value(0)) * 1e-9;
+      }
+      catch (...)
+      {
+        stepTime = -1.0;
+      }
+    }
+  }
+
+  if (prefix.empty() || stepTime < 0.0 ||
+      this->secondaries.find(prefix) == this->secondaries.end())
+  {
+    return;
+  }
+
+  auto load = this->secondaryLoads.find(prefix);
+  if (load == this->secondaryLoads.end())
+    this->secondaryLoads[prefix] = stepTime;
+  else
+    load->second += kLoadSmoothing * (stepTime - load->second);
+
+  auto &stats = this->stepStatistics[prefix];
+  ++stats.steps;
+  stats.roundTripTime += _roundTripTime;
+  stats.maxRoundTripTime = std::max(stats.maxRoundTripTime, _roundTripTime);
+  stats.computeTime += stepTime;
+  stats.bytesReceived += _msg.ByteSizeLong();
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::PublishStatistics()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->lastStatistics < kNetworkStatisticsPeriod)
+    return;
+
+  private_msgs::NetworkStatistics msg;
+  msg.set_peer_id(this->dataPtr->peerInfo.id);
+  msg.set_steps(this->statisticsSteps);
+  if (this->statisticsSteps > 0u)
+    msg.set_apply_time(this->applyTime / this->statisticsSteps);
+  for (const auto &stats : this->stepStatistics)
+    FillStatistics(stats.first, stats.second, *msg.add_secondaries());
+
+  this->statisticsPub.Publish(msg);
+  this->dataPtr->tracker->SetHeartbeatData(HeartbeatStatistics(msg));
+
+  this->stepStatistics.clear();
+  this->statisticsSteps = 0u;
+  this->applyTime = 0.0;
+  this->lastStatistics = now;
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::RebalanceAffinities(
+    private_msgs::SimulationStep &_msg)
+{
+  ++this->affinityUpdates;
+  if (this->affinityUpdates % kRebalancePeriod != 0u ||
+      this->secondaryLoads.size() < 2u)
+  {
+    return;
+  }
+
+  IGN_PROFILE("NetworkManagerPrimary::RebalanceAffinities");
+  const uint64_t rebalance = this->affinityUpdates / kRebalancePeriod;
+
+  auto byLoad = [](const std::pair<const std::string, double> &_a,
+                   const std::pair<const std::string, double> &_b)
+  {
+    return _a.second < _b.second;
+  };
+  auto idlest = std::min_element(this->secondaryLoads.begin(),
+      this->secondaryLoads.end(), byLoad);
+  auto busiest = std::max_element(this->secondaryLoads.begin(),
+      this->secondaryLoads.end(), byLoad);
+  const double difference = busiest->second - idlest->second;
+  if (difference <= busiest->second * kLoadImbalance)
+    return;
+
+  // The cost of each performer is estimated from the share of the
+  // secondary's entities which belong to it
+  std::vector<std::pair<Entity, std::size_t>> candidates;
+  std::size_t totalEntities{0u};
+  std::size_t performers{0u};
+  this->dataPtr->ecm->Each<components::PerformerAffinity>(
+    [&](const Entity &_entity,
+        const components::PerformerAffinity *_affinity) -> bool
+    {
+      if (_affinity->Data() != busiest->first)
+        return true;
+
+      auto parent =
+          this->dataPtr->ecm->Component<components::ParentEntity>(_entity);
+      if (nullptr == parent)
+        return true;
+
+      const std::size_t entities =
+          this->dataPtr->ecm->Descendants(parent->Data()).size();
+      totalEntities += entities;
+      ++performers;
+
+      auto last = this->lastMigrations.find(_entity);
+      if (last == this->lastMigrations.end() ||
+          rebalance - last->second > kMigrationCooldown)
+      {
+        candidates.push_back({_entity, entities});
+      }
+      return true;
+    });
+
+  // Moving the only performer would just move the load elsewhere
+  if (candidates.empty() || totalEntities == 0u || performers < 2u)
+    return;
+
+  // Move the performer whose cost is closest to half the difference, as long
+  // as moving it narrows the gap
+  Entity performer{kNullEntity};
+  double performerCost{0.0};
+  double bestError{difference};
+  for (const auto &[entity, entities] : candidates)
+  {
+    const double cost = busiest->second * entities / totalEntities;
+    const double error = std::abs(cost - difference / 2.0);
+    if (cost < difference && error < bestError)
+    {
+      performer = entity;
+      performerCost = cost;
+      bestError = error;
+    }
+  }
+  if (kNullEntity == performer)
+    return;
+
+  const std::string from = busiest->first;
+  const std::string to = idlest->first;
+  this->MigratePerformer(performer, to, _msg);
+
+  this->lastMigrations[performer] = rebalance;
+
+  // Assume the cost moves along, until new step times come in
+  busiest->second -= performerCost;
+  idlest->second += performerCost;
+
+  ignmsg << "Migrated performer [" << performer << "] from secondary ["
+         << from << "] to [" << to << "] to balance their loads."
+         << std::endl;
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::PopulateRegionAffinities(
+    private_msgs::SimulationStep &_msg)
+{
+  if (this->levelOwners.empty())
+    this->AssignRegions();
+
+  // Performers without a level yet are spread round-robin, and performers
+  // which left their secondary's region are handed over afterwards, since
+  // affinity components can't be changed while iterating
+  std::vector<std::pair<Entity, std::string>> initial;
+  std::vector<std::pair<Entity, std::string>> handovers;
+  auto secondaryIt = this->secondaries.begin();
+  this->dataPtr->ecm->Each<components::PerformerLevels>(
+    [&](const Entity &_entity,
+        const components::PerformerLevels *_perfLevels) -> bool
+    {
+      auto currentAffinityComp =
+          this->dataPtr->ecm->Component<components::PerformerAffinity>(_entity);
+
+      // Levels include the buffer of active levels, so the performer stays
+      // with its secondary while it's within the buffer of one of its
+      // levels, and doesn't bounce between secondaries along a border
+      std::string owner;
+      for (const auto &level : _perfLevels->Data())
+      {
+        auto ownerIt = this->levelOwners.find(level);
+        if (ownerIt == this->levelOwners.end())
+          continue;
+        if (nullptr != currentAffinityComp &&
+            ownerIt->second == currentAffinityComp->Data())
+        {
+          owner = ownerIt->second;
+          break;
+        }
+        if (owner.empty())
+          owner = ownerIt->second;
+      }
+
+      if (nullptr == currentAffinityComp)
+      {
+        if (owner.empty())
+        {
+          owner = secondaryIt->second->prefix;
+          if (++secondaryIt == this->secondaries.end())
+            secondaryIt = this->secondaries.begin();
+        }
+        initial.push_back({_entity, owner});
+      }
+      else if (!owner.empty() && owner != currentAffinityComp->Data())
+      {
+        handovers.push_back({_entity, owner});
+      }
+      return true;
+    });
+
+  for (const auto &[performer, owner] : initial)
+    this->SetAffinity(performer, owner, _msg.add_affinity());
+
+  for (const auto &[performer, owner] : handovers)
+  {
+    this->MigratePerformer(performer, owner, _msg);
+    igndbg << "Handed performer [" << performer << "] over to secondary ["
+           << owner << "], which owns its region." << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::AssignRegions()
+{
+  std::vector<LevelCenter> levels;
+  this->dataPtr->ecm->Each<components::Level, components::Pose>(
+    [&](const Entity &_entity, const components::Level *,
+        const components::Pose *_pose) -> bool
+    {
+      levels.push_back({_entity, _pose->Data().Pos()});
+      return true;
+    });
+
+  std::vector<std::string> owners;
+  for (const auto &secondary : this->secondaries)
+    owners.push_back(secondary.second->prefix);
+
+  splitRegions(levels.begin(), levels.end(), owners, this->levelOwners);
+
+  std::map<std::string, std::size_t> ownedLevels;
+  for (const auto &level : this->levelOwners)
+    ++ownedLevels[level.second];
+  for (const auto &owner : owners)
+  {
+    ignmsg << "Secondary [" << owner << "] owns a region of ["
+           << ownedLevels[owner] << "] levels." << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+void NetworkManagerPrimary::MigratePerformer(Entity _performer,
+    const std::string &_secondary, private_msgs::SimulationStep &_msg)
+{
+  auto affinityMsg = _msg.add_affinity();
+  this->SetAffinity(_performer, _secondary, affinityMsg);
+
+  // Hand the state of the performer's model over to the new secondary
+  auto parent =
+      this->dataPtr->ecm->Component<components::ParentEntity>(_performer);
+  if (nullptr == parent)
+    return;
+  this->dataPtr->ecm->State(*affinityMsg->mutable_state(),
+      this->dataPtr->ecm->Descendants(parent->Data()), {}, true);
 }
 
 //////////////////////////////////////////////////
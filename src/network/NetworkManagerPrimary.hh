@@ -18,9 +18,11 @@
 #define IGNITION_GAZEBO_NETWORK_NETWORKMANAGERPRIMARY_HH_
 
 #include <atomic>
+#include <chrono>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -32,6 +34,8 @@
 #include "msgs/simulation_step.pb.h"
 
 #include "NetworkManager.hh"
+#include "NetworkManagerPrivate.hh"
+#include "SharedMemoryChannel.hh"
 
 namespace ignition
 {
@@ -50,6 +54,14 @@ namespace ignition
       /// \brief prefix namespace of the secondary peer
       std::string prefix;
 
+      /// \brief Channel through which steps are sent to the secondary, if
+      /// it runs on the same host. Null otherwise.
+      std::unique_ptr<SharedMemoryChannel> stepChannel;
+
+      /// \brief Channel through which step acks are received from the
+      /// secondary, if it runs on the same host. Null otherwise.
+      std::unique_ptr<SharedMemoryChannel> ackChannel;
+
       /// \brief Convenience alias for unique_ptr.
       using Ptr = std::unique_ptr<SecondaryControl>;
     };
@@ -92,6 +104,16 @@ namespace ignition
       /// \param[in] _msg Message containing secondary's updated state.
       private: void OnStepAck(const msgs::SerializedStateMap &_msg);
 
+      /// \brief Keep a step ack, and notify when all secondaries have
+      /// acknowledged the step.
+      /// \param[in] _msg Message containing secondary's updated state.
+      private: void AddSecondaryState(msgs::SerializedStateMap &&_msg);
+
+      /// \brief Receive the step acks sent through shared memory.
+      /// \return True if any secondary acknowledges steps through shared
+      /// memory.
+      private: bool ReceiveSharedMemoryAcks();
+
       /// \brief Check if the step publisher has connections.
       private: bool SecondariesCanStep() const;
 
@@ -100,6 +122,47 @@ namespace ignition
       /// \param[in] _msg Step message.
       private: void PopulateAffinities(private_msgs::SimulationStep &_msg);
 
+      /// \brief Move one performer from the busiest to the least busy
+      /// secondary, if their loads have drifted apart. Performers which
+      /// migrated recently aren't moved again, so they don't bounce between
+      /// secondaries.
+      /// \param[in] _msg Step message, populated with the new affinity.
+      private: void RebalanceAffinities(private_msgs::SimulationStep &_msg);
+
+      /// \brief Populate the step message with the latest affinities when
+      /// secondaries own regions. Each performer is assigned to the owner of
+      /// a level it's in, and handed over to another secondary once it
+      /// leaves all the levels owned by its current one, buffers included.
+      /// \param[in] _msg Step message.
+      private: void PopulateRegionAffinities(
+                   private_msgs::SimulationStep &_msg);
+
+      /// \brief Split the levels into one spatial region per secondary, by
+      /// recursively halving them along the axis in which their centers are
+      /// most spread out. Fills levelOwners.
+      private: void AssignRegions();
+
+      /// \brief Assign a performer to another secondary, handing it the
+      /// state of the performer's model.
+      /// \param[in] _performer Performer entity.
+      /// \param[in] _secondary Prefix of the new secondary.
+      /// \param[in] _msg Step message, populated with the new affinity.
+      private: void MigratePerformer(Entity _performer,
+                   const std::string &_secondary,
+                   private_msgs::SimulationStep &_msg);
+
+      /// \brief Update the load estimate and the statistics of a secondary
+      /// from its step ack.
+      /// \param[in] _msg Step ack received from the secondary.
+      /// \param[in] _roundTripTime Wall time from sending the step to
+      /// receiving the ack, in seconds.
+      private: void UpdateSecondaryLoad(const msgs::SerializedStateMap &_msg,
+                   double _roundTripTime);
+
+      /// \brief Publish the network statistics accumulated since the last
+      /// publication and attach them to the heartbeats, if it's time to.
+      private: void PublishStatistics();
+
       /// \brief Set the performer to secondary affinity.
       /// \param[in] _performer Performer entity.
       /// \param[in] _secondary Secondary identifier.
@@ -119,8 +182,52 @@ namespace ignition
       /// \brief Keep track of states received from secondaries.
       private: std::vector<msgs::SerializedStateMap> secondaryStates;
 
+      /// \brief Time at which each of secondaryStates was received.
+      private: std::vector<std::chrono::steady_clock::time_point>
+                   secondaryAckTimes;
+
+      /// \brief Protects secondaryStates and secondaryAckTimes, which are
+      /// filled both from the transport thread and from the simulation
+      /// thread.
+      private: std::mutex secondaryStatesMutex;
+
+      /// \brief Time at which the current step was sent.
+      private: std::chrono::steady_clock::time_point stepSentTime;
+
+      /// \brief Publisher of network statistics.
+      private: ignition::transport::Node::Publisher statisticsPub;
+
+      /// \brief Statistics of each secondary accumulated since the last
+      /// publication, keyed by secondary prefix.
+      private: std::map<std::string, SecondaryStepStatistics>
+                   stepStatistics;
+
+      /// \brief Number of steps since the last publication of statistics.
+      private: uint64_t statisticsSteps{0u};
+
+      /// \brief Sum of the times spent applying the states of secondaries
+      /// since the last publication of statistics, in seconds.
+      private: double applyTime{0.0};
+
+      /// \brief Time of the last publication of statistics.
+      private: std::chrono::steady_clock::time_point lastStatistics;
+
       /// \brief Promise used to notify when all secondaryStates where received.
       private: std::promise<void> secondaryStatesPromise;
+
+      /// \brief Smoothed wall time, in seconds, that each secondary takes to
+      /// step, keyed by secondary prefix.
+      private: std::map<std::string, double> secondaryLoads;
+
+      /// \brief Rebalance count at which each performer last migrated.
+      private: std::map<Entity, uint64_t> lastMigrations;
+
+      /// \brief Number of times affinities have been populated.
+      private: uint64_t affinityUpdates{0u};
+
+      /// \brief Prefix of the secondary which owns each level, when
+      /// secondaries own regions.
+      private: std::map<Entity, std::string> levelOwners;
     };
     }
   }  // namespace gazebo
@@ -17,12 +17,18 @@
 #ifndef IGNITION_GAZEBO_NETWORK_NETWORKMANAGERPRIVATE_HH_
 #define IGNITION_GAZEBO_NETWORK_NETWORKMANAGERPRIVATE_HH_
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <string>
 
 #include <ignition/gazebo/config.hh>
 #include <ignition/gazebo/Export.hh>
 
+#include "msgs/network_statistics.pb.h"
+
 #include "NetworkConfig.hh"
 #include "PeerInfo.hh"
 #include "PeerTracker.hh"
@@ -33,6 +39,59 @@ namespace ignition
   {
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    /// \brief Key of the step ack header data holding the prefix of the
+    /// secondary which sent it.
+    const std::string kSecondaryPrefixKey{"secondary_prefix"};
+
+    /// \brief Key of the step ack header data holding the wall time, in
+    /// nanoseconds, that the secondary took to step.
+    const std::string kSecondaryStepTimeKey{"step_time_ns"};
+
+    /// \brief Topic on which each peer publishes its network statistics.
+    const std::string kNetworkStatisticsTopic{"network_statistics"};
+
+    /// \brief Wall time between two publications of network statistics.
+    constexpr std::chrono::seconds kNetworkStatisticsPeriod{1};
+
+    /// \brief Steps exchanged with one secondary, accumulated between two
+    /// publications of network statistics.
+    struct SecondaryStepStatistics
+    {
+      /// \brief Number of acknowledged steps.
+      uint64_t steps{0u};
+
+      /// \brief Sum of the round trip times, in seconds.
+      double roundTripTime{0.0};
+
+      /// \brief Longest round trip time, in seconds.
+      double maxRoundTripTime{0.0};
+
+      /// \brief Sum of the times the secondary took to step, in seconds.
+      double computeTime{0.0};
+
+      /// \brief Bytes of steps sent to the secondary.
+      uint64_t bytesSent{0u};
+
+      /// \brief Bytes of acks received from the secondary.
+      uint64_t bytesReceived{0u};
+    };
+
+    /// \brief Fill a statistics message with the averages of accumulated
+    /// statistics.
+    /// \param[in] _prefix Prefix of the secondary.
+    /// \param[in] _stats Accumulated statistics.
+    /// \param[out] _msg Message to fill.
+    void FillStatistics(const std::string &_prefix,
+        const SecondaryStepStatistics &_stats,
+        private_msgs::SecondaryStatistics &_msg);
+
+    /// \brief Flatten network statistics into heartbeat data. Statistics of
+    /// each secondary are keyed by "<prefix>/<field>".
+    /// \param[in] _msg Statistics.
+    /// \return Key-value data for PeerTracker::SetHeartbeatData.
+    std::map<std::string, std::string> HeartbeatStatistics(
+        const private_msgs::NetworkStatistics &_msg);
+
     /// \class NetworkManagerPrivate NetworkManagerPrivate.hh
     /// ignition/gazebo/NetworkManagerPrivate.hh
     class IGNITION_GAZEBO_VISIBLE NetworkManagerPrivate
@@ -16,7 +16,9 @@
 */
 
 #include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
@@ -37,6 +39,14 @@
 using namespace ignition;
 using namespace gazebo;
 
+/// \brief Number of consecutive empty polls of the step channel after which
+/// the polling thread starts sleeping between polls. Steps usually follow
+/// each other closely, so it only sleeps while simulation is idle.
+static constexpr unsigned int kBusyPolls{100000u};
+
+/// \brief Time the polling thread sleeps between polls once idle.
+static constexpr std::chrono::microseconds kIdlePollPeriod{100};
+
 //////////////////////////////////////////////////
 NetworkManagerSecondary::NetworkManagerSecondary(
     const std::function<void(const UpdateInfo &_info)> &_stepFunction,
@@ -62,6 +72,18 @@ NetworkManagerSecondary::NetworkManagerSecondary(
   this->node.Subscribe("step", &NetworkManagerSecondary::OnStep, this);
 
   this->stepAckPub = this->node.Advertise<msgs::SerializedStateMap>("step_ack");
+
+  this->statisticsPub = this->node.Advertise<private_msgs::NetworkStatistics>(
+      kNetworkStatisticsTopic);
+  this->lastStatistics = std::chrono::steady_clock::now();
+}
+
+//////////////////////////////////////////////////
+NetworkManagerSecondary::~NetworkManagerSecondary()
+{
+  this->stopPolling = true;
+  if (this->pollThread.joinable())
+    this->pollThread.join();
 }
 
 //////////////////////////////////////////////////
@@ -93,14 +115,85 @@ bool NetworkManagerSecondary::OnControl(const private_msgs::PeerControl &_req,
 {
   this->enableSim = _req.enable_sim();
   _resp.set_enable_sim(this->enableSim);
+  _resp.set_shared_memory(this->OpenSharedMemory(_req));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool NetworkManagerSecondary::OpenSharedMemory(
+    const private_msgs::PeerControl &_req)
+{
+  if (this->sharedMemory)
+    return true;
+
+  if (!this->dataPtr->config.sharedMemory || _req.step_channel().empty() ||
+      _req.ack_channel().empty())
+  {
+    return false;
+  }
+
+  // The channels only exist on the primary's host
+  this->stepChannel = SharedMemoryChannel::Open(_req.step_channel());
+  this->ackChannel = SharedMemoryChannel::Open(_req.ack_channel());
+  if (nullptr == this->stepChannel || nullptr == this->ackChannel)
+  {
+    this->stepChannel.reset();
+    this->ackChannel.reset();
+    return false;
+  }
+
+  ignmsg << "Secondary [" << this->Namespace()
+         << "] exchanging steps with the primary through shared memory."
+         << std::endl;
+
+  this->sharedMemory = true;
+  this->pollThread = std::thread(&NetworkManagerSecondary::PollSteps, this);
   return true;
 }
 
+//////////////////////////////////////////////////
+void NetworkManagerSecondary::PollSteps()
+{
+  IGN_PROFILE_THREAD_NAME("NetworkManagerSecondary::PollSteps");
+
+  private_msgs::SimulationStep msg;
+  unsigned int emptyPolls{0u};
+  while (!this->stopPolling && !this->dataPtr->stopReceived)
+  {
+    if (this->stepChannel->Read(msg))
+    {
+      emptyPolls = 0u;
+      this->ProcessStep(msg);
+    }
+    else if (emptyPolls < kBusyPolls)
+    {
+      ++emptyPolls;
+      std::this_thread::yield();
+    }
+    else
+    {
+      std::this_thread::sleep_for(kIdlePollPeriod);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void NetworkManagerSecondary::OnStep(
     const private_msgs::SimulationStep &_msg)
 {
-  IGN_PROFILE("NetworkManagerSecondary::OnStep");
+  if (this->sharedMemory)
+    return;
+
+  this->ProcessStep(_msg);
+}
+
+/////////////////////////////////////////////////
+void NetworkManagerSecondary::ProcessStep(
+    const private_msgs::SimulationStep &_msg)
+{
+  IGN_PROFILE("NetworkManagerSecondary::ProcessStep");
+
+  this->stepStatistics.bytesReceived += _msg.ByteSizeLong();
 
   // Throttle the number of step messages going to the debug output.
   if (!_msg.stats().paused() && _msg.stats().iterations() % 1000 == 0)
@@ -117,6 +210,17 @@ void NetworkManagerSecondary::OnStep(
 
     if (affinityMsg.secondary_prefix() == this->Namespace())
     {
+      // A performer migrating from another secondary brings the state of its
+      // model, which was removed from this secondary when first assigned
+      if (affinityMsg.has_state() &&
+          this->performers.find(entityId) == this->performers.end())
+      {
+        const auto applyStart = std::chrono::steady_clock::now();
+        this->dataPtr->ecm->SetState(affinityMsg.state());
+        this->applyTime += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - applyStart).count();
+      }
+
       this->performers.insert(entityId);
 
       ignmsg << "Secondary [" << this->Namespace()
@@ -126,9 +230,12 @@ void NetworkManagerSecondary::OnStep(
     // If performer has been assigned to another secondary, remove it
     else
     {
+      // The performer may have been removed already, when it was assigned
+      // to another secondary before
       auto parent =
           this->dataPtr->ecm->Component<components::ParentEntity>(entityId);
-      this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
+      if (nullptr != parent)
+        this->dataPtr->ecm->RequestRemoveEntity(parent->Data());
 
       if (this->performers.find(entityId) != this->performers.end())
       {
@@ -144,7 +251,9 @@ void NetworkManagerSecondary::OnStep(
   auto info = convert<UpdateInfo>(_msg.stats());
 
   // Step runner
+  const auto stepStart = std::chrono::steady_clock::now();
   this->dataPtr->stepFunction(info);
+  const auto stepTime = std::chrono::steady_clock::now() - stepStart;
 
   // Update state with all the performer's entities
   std::unordered_set<Entity> entities;
@@ -170,8 +279,48 @@ void NetworkManagerSecondary::OnStep(
   stateMsg.set_has_one_time_component_changes(
     this->dataPtr->ecm->HasOneTimeComponentChanges());
 
-  this->stepAckPub.Publish(stateMsg);
+  // Let the primary balance the load of secondaries
+  auto prefixData = stateMsg.mutable_header()->add_data();
+  prefixData->set_key(kSecondaryPrefixKey);
+  prefixData->add_value(this->Namespace());
+  auto stepTimeData = stateMsg.mutable_header()->add_data();
+  stepTimeData->set_key(kSecondaryStepTimeKey);
+  stepTimeData->add_value(std::to_string(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stepTime).count()));
+
+  // Acks which don't fit in shared memory go through ign-transport, which the
+  // primary also listens to
+  if (nullptr == this->ackChannel || !this->ackChannel->Write(stateMsg))
+    this->stepAckPub.Publish(stateMsg);
+
+  ++this->stepStatistics.steps;
+  this->stepStatistics.computeTime +=
+      std::chrono::duration<double>(stepTime).count();
+  this->stepStatistics.bytesSent += stateMsg.ByteSizeLong();
+  this->PublishStatistics();
 
   this->dataPtr->ecm->SetAllComponentsUnchanged();
 }
 
+/////////////////////////////////////////////////
+void NetworkManagerSecondary::PublishStatistics()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->lastStatistics < kNetworkStatisticsPeriod)
+    return;
+
+  private_msgs::NetworkStatistics msg;
+  msg.set_peer_id(this->dataPtr->peerInfo.id);
+  msg.set_steps(this->stepStatistics.steps);
+  if (this->stepStatistics.steps > 0u)
+    msg.set_apply_time(this->applyTime / this->stepStatistics.steps);
+  FillStatistics(this->Namespace(), this->stepStatistics,
+      *msg.add_secondaries());
+
+  this->statisticsPub.Publish(msg);
+  this->dataPtr->tracker->SetHeartbeatData(HeartbeatStatistics(msg));
+
+  this->stepStatistics = SecondaryStepStatistics();
+  this->applyTime = 0.0;
+  this->lastStatistics = now;
+}
@@ -18,8 +18,10 @@
 #define IGNITION_GAZEBO_NETWORK_NETWORKMANAGERSECONDARY_HH_
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 #include <ignition/gazebo/config.hh>
@@ -30,6 +32,8 @@
 #include "msgs/peer_control.pb.h"
 
 #include "NetworkManager.hh"
+#include "NetworkManagerPrivate.hh"
+#include "SharedMemoryChannel.hh"
 
 namespace ignition
 {
@@ -50,6 +54,9 @@ namespace ignition
           const NetworkConfig &_config,
           const NodeOptions &_options);
 
+      /// \brief Destructor. Stops receiving steps through shared memory.
+      public: ~NetworkManagerSecondary() override;
+
       // Documentation inherited
       public: bool Ready() const override;
 
@@ -67,9 +74,29 @@ namespace ignition
                              private_msgs::PeerControl &_resp);
 
       /// \brief Callback when step commands are received from the primary
+      /// through ign-transport. They're ignored if steps are received through
+      /// shared memory.
       /// \param[in] _msg Step message.
       private: void OnStep(const private_msgs::SimulationStep &_msg);
 
+      /// \brief Step the secondary and acknowledge the step to the primary.
+      /// \param[in] _msg Step message.
+      private: void ProcessStep(const private_msgs::SimulationStep &_msg);
+
+      /// \brief Open the shared memory channels offered by the primary.
+      /// \param[in] _req Control request from the primary.
+      /// \return True if the channels were opened, meaning that this
+      /// secondary runs on the same host as the primary.
+      private: bool OpenSharedMemory(const private_msgs::PeerControl &_req);
+
+      /// \brief Receive steps through shared memory until stopped. Runs on
+      /// its own thread.
+      private: void PollSteps();
+
+      /// \brief Publish the network statistics accumulated since the last
+      /// publication and attach them to the heartbeats, if it's time to.
+      private: void PublishStatistics();
+
       /// \brief Flag to control enabling/disabling simulation secondary.
       private: std::atomic<bool> enableSim {false};
 
@@ -81,6 +108,37 @@ namespace ignition
 
       /// \brief Collection of performers associated with this secondary.
       private: std::unordered_set<Entity> performers;
+
+      /// \brief Channel through which steps are received from the primary.
+      /// Null if the primary isn't on the same host.
+      private: std::unique_ptr<SharedMemoryChannel> stepChannel;
+
+      /// \brief Channel through which step acks are sent to the primary.
+      /// Null if the primary isn't on the same host.
+      private: std::unique_ptr<SharedMemoryChannel> ackChannel;
+
+      /// \brief True once steps are received through shared memory.
+      private: std::atomic<bool> sharedMemory {false};
+
+      /// \brief Set to true to stop the polling thread.
+      private: std::atomic<bool> stopPolling {false};
+
+      /// \brief Thread which receives steps through shared memory.
+      private: std::thread pollThread;
+
+      /// \brief Publisher of network statistics.
+      private: ignition::transport::Node::Publisher statisticsPub;
+
+      /// \brief Statistics accumulated since the last publication. Round
+      /// trip times are only known by the primary.
+      private: SecondaryStepStatistics stepStatistics;
+
+      /// \brief Sum of the times spent applying the states of migrated
+      /// performers since the last publication of statistics, in seconds.
+      private: double applyTime{0.0};
+
+      /// \brief Time of the last publication of statistics.
+      private: std::chrono::steady_clock::time_point lastStatistics;
     };
     }
   }  // namespace gazebo
@@ -116,6 +116,25 @@ size_t PeerTracker::NumPeers(const NetworkRole &_role) const
   return count;
 }
 
+/////////////////////////////////////////////////
+void PeerTracker::SetHeartbeatData(
+    const std::map<std::string, std::string> &_data)
+{
+  std::lock_guard<std::mutex> lock(this->heartbeatDataMutex);
+  this->heartbeatData = _data;
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, std::string> PeerTracker::HeartbeatData(
+    const std::string &_id) const
+{
+  auto lock = PeerLock(this->peersMutex);
+  auto iter = this->peers.find(_id);
+  if (iter == this->peers.end())
+    return {};
+  return iter->second.heartbeatData;
+}
+
 /////////////////////////////////////////////////
 void PeerTracker::HeartbeatLoop()
 {
@@ -125,7 +144,17 @@ void PeerTracker::HeartbeatLoop()
   while (this->heartbeatRunning)
   {
     lastUpdateTime = Clock::now();
-    this->heartbeatPub.Publish(toProto(this->info));
+    auto msg = toProto(this->info);
+    {
+      std::lock_guard<std::mutex> lock(this->heartbeatDataMutex);
+      for (const auto &data : this->heartbeatData)
+      {
+        auto headerData = msg.mutable_header()->add_data();
+        headerData->set_key(data.first);
+        headerData->add_value(data.second);
+      }
+    }
+    this->heartbeatPub.Publish(msg);
 
     std::vector<PeerInfo> toRemove;
     for (auto peer : this->peers)
@@ -220,6 +249,13 @@ void PeerTracker::OnPeerHeartbeat(const private_msgs::PeerInfo &_info)
   peerState.lastHeader = std::chrono::steady_clock::time_point(
       std::chrono::seconds(_info.header().stamp().sec()) +
       std::chrono::nanoseconds(_info.header().stamp().nsec()));
+
+  peerState.heartbeatData.clear();
+  for (const auto &data : _info.header().data())
+  {
+    if (data.value_size() > 0)
+      peerState.heartbeatData[data.key()] = data.value(0);
+  }
 }
 
 /////////////////////////////////////////////////
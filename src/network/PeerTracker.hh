@@ -19,6 +19,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -136,6 +137,20 @@ namespace ignition
                 return ret;
               }
 
+      /// \brief Set key-value data attached to the header of the heartbeats
+      /// of this peer, such as statistics. Replaces the previous data.
+      /// \param[in] _data Data to attach.
+      public: void SetHeartbeatData(
+                  const std::map<std::string, std::string> &_data);
+
+      /// \brief Get the data attached to the latest heartbeat received from
+      /// a peer.
+      /// \param[in] _id ID of the peer.
+      /// \return Key-value data, empty if the peer isn't known or didn't
+      /// attach any.
+      public: std::map<std::string, std::string> HeartbeatData(
+                  const std::string &_id) const;
+
       /// \brief Internal loop to announce and check stale peers.
       private: void HeartbeatLoop();
 
@@ -175,6 +190,9 @@ namespace ignition
 
         /// \brief Keep last time heartbeat was received
         std::chrono::steady_clock::time_point lastSeen;
+
+        /// \brief Data attached to the last heartbeat
+        std::map<std::string, std::string> heartbeatData;
       };
 
       /// \brief Convenience type alias
@@ -205,6 +223,12 @@ namespace ignition
       /// \brief Peer information that this tracker announces.
       private: PeerInfo info;
 
+      /// \brief Data attached to the heartbeats of this peer.
+      private: std::map<std::string, std::string> heartbeatData;
+
+      /// \brief Protects heartbeatData.
+      private: mutable std::mutex heartbeatDataMutex;
+
       /// \brief Event manager instance to be used to emit network events.
       private: EventManager *eventMgr;
 
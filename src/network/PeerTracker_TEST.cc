@@ -275,6 +275,47 @@ TEST(PeerTracker, Namespaced)
   EXPECT_EQ(1u, tracker4.NumPeers());
 }
 
+//////////////////////////////////////////////////
+TEST(PeerTracker, HeartbeatData)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  auto options = ignition::transport::NodeOptions();
+  options.SetPartition("heartbeat_data");
+
+  auto info1 = PeerInfo(NetworkRole::SimulationPrimary);
+  auto tracker1 = PeerTracker(info1, nullptr, options);
+  tracker1.SetHeartbeatPeriod(std::chrono::milliseconds(10));
+
+  auto info2 = PeerInfo(NetworkRole::SimulationSecondary);
+  auto tracker2 = PeerTracker(info2, nullptr, options);
+
+  EXPECT_TRUE(tracker2.HeartbeatData(info1.id).empty());
+  EXPECT_TRUE(tracker2.HeartbeatData("unknown").empty());
+
+  tracker1.SetHeartbeatData({{"compute_time", "0.5"}, {"steps", "3"}});
+
+  for (int sleep = 0; sleep < 100 &&
+      tracker2.HeartbeatData(info1.id).size() < 2u; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  auto data = tracker2.HeartbeatData(info1.id);
+  ASSERT_EQ(2u, data.size());
+  EXPECT_EQ("0.5", data["compute_time"]);
+  EXPECT_EQ("3", data["steps"]);
+
+  // Data is replaced by later heartbeats
+  tracker1.SetHeartbeatData({});
+  for (int sleep = 0; sleep < 100 &&
+      !tracker2.HeartbeatData(info1.id).empty(); ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(tracker2.HeartbeatData(info1.id).empty());
+}
+
 //////////////////////////////////////////////////
 // Only on Linux for the moment
 #ifdef  __linux__
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "SharedMemoryChannel.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Identifies segments created by SharedMemoryChannel.
+static constexpr uint64_t kRingMagic{0x69676e5368524731u};
+
+/// \brief Size of the length which prefixes each record.
+static constexpr uint64_t kLengthSize{sizeof(uint64_t)};
+
+/// \brief Length stored in place of a record when the space left before the
+/// end of the ring is skipped.
+static constexpr uint64_t kWrapMarker{UINT64_MAX};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+    "Shared memory channels need address-free atomics");
+
+/// \brief Control block at the start of the segment, followed by the ring.
+/// Positions only grow, and are wrapped around the capacity when accessing
+/// the ring, so that a full ring can be told from an empty one.
+struct RingHeader
+{
+  /// \brief Set to kRingMagic once the ring is initialized.
+  uint64_t magic{0u};
+
+  /// \brief Size of the ring in bytes, a multiple of kLengthSize.
+  uint64_t capacity{0u};
+
+  /// \brief Position of the oldest record, written by the consumer.
+  alignas(64) std::atomic<uint64_t> head{0u};
+
+  /// \brief Position of the next free byte, written by the producer.
+  alignas(64) std::atomic<uint64_t> tail{0u};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the number of bytes taken by a record in the ring.
+/// \param[in] _length Length of the serialized message.
+/// \return Size of the length prefix plus the message, padded so that the
+/// next length is aligned.
+static uint64_t RecordSize(const uint64_t _length)
+{
+  return kLengthSize + (_length + kLengthSize - 1u) / kLengthSize * kLengthSize;
+}
+
+class ignition::gazebo::SharedMemoryChannelPrivate
+{
+  /// \brief Name of the channel.
+  public: std::string name;
+
+  /// \brief Start of the mapped segment.
+  public: void *memory{nullptr};
+
+  /// \brief Size of the mapped segment.
+  public: std::size_t size{0u};
+
+  /// \brief Control block, at the start of the segment.
+  public: RingHeader *header{nullptr};
+
+  /// \brief Start of the ring, right after the control block.
+  public: char *data{nullptr};
+
+  /// \brief Whether this process created the segment, and should remove it.
+  public: bool owner{false};
+};
+
+/////////////////////////////////////////////////
+SharedMemoryChannel::SharedMemoryChannel()
+  : dataPtr(std::make_unique<SharedMemoryChannelPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+#ifndef _WIN32
+  if (nullptr != this->dataPtr->memory)
+    munmap(this->dataPtr->memory, this->dataPtr->size);
+  if (this->dataPtr->owner)
+    shm_unlink(("/" + this->dataPtr->name).c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::Create(
+    const std::string &_name, std::size_t _capacity)
+{
+#ifndef _WIN32
+  _capacity = (std::max<std::size_t>(_capacity, kLengthSize) +
+      kLengthSize - 1u) / kLengthSize * kLengthSize;
+  const std::string path{"/" + _name};
+
+  // A segment with the same name may have been left behind by a process
+  // which crashed
+  int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST)
+  {
+    shm_unlink(path.c_str());
+    fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  if (fd < 0)
+  {
+    ignerr << "Failed to create shared memory [" << path << "]: "
+           << std::strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  const std::size_t size = sizeof(RingHeader) + _capacity;
+  void *memory{MAP_FAILED};
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (MAP_FAILED == memory)
+  {
+    ignerr << "Failed to map shared memory [" << path << "]: "
+           << std::strerror(errno) << std::endl;
+    shm_unlink(path.c_str());
+    return nullptr;
+  }
+
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel());
+  channel->dataPtr->name = _name;
+  channel->dataPtr->memory = memory;
+  channel->dataPtr->size = size;
+  channel->dataPtr->owner = true;
+  channel->dataPtr->header = new (memory) RingHeader;
+  channel->dataPtr->header->capacity = _capacity;
+  channel->dataPtr->data = static_cast<char *>(memory) + sizeof(RingHeader);
+
+  // Peers only check the magic number after being told the channel's name,
+  // which is enough to order it after the initialization
+  std::atomic_thread_fence(std::memory_order_release);
+  channel->dataPtr->header->magic = kRingMagic;
+  return channel;
+#else
+  (void)_name;
+  (void)_capacity;
+  return nullptr;
+#endif
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::Open(
+    const std::string &_name)
+{
+#ifndef _WIN32
+  const std::string path{"/" + _name};
+  int fd = shm_open(path.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info;
+  void *memory{MAP_FAILED};
+  std::size_t size{0u};
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) > sizeof(RingHeader))
+  {
+    size = static_cast<std::size_t>(info.st_size);
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (MAP_FAILED == memory)
+    return nullptr;
+
+  auto header = static_cast<RingHeader *>(memory);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header->magic != kRingMagic || header->capacity == 0u ||
+      header->capacity > size - sizeof(RingHeader) ||
+      header->capacity % kLengthSize != 0u)
+  {
+    ignerr << "Shared memory [" << path << "] isn't a valid channel"
+           << std::endl;
+    munmap(memory, size);
+    return nullptr;
+  }
+
+  std::unique_ptr<SharedMemoryChannel> channel(new SharedMemoryChannel());
+  channel->dataPtr->name = _name;
+  channel->dataPtr->memory = memory;
+  channel->dataPtr->size = size;
+  channel->dataPtr->header = header;
+  channel->dataPtr->data = static_cast<char *>(memory) + sizeof(RingHeader);
+  return channel;
+#else
+  (void)_name;
+  return nullptr;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryChannel::Write(const google::protobuf::MessageLite &_msg)
+{
+  auto header = this->dataPtr->header;
+  const uint64_t capacity = header->capacity;
+
+  // Limiting records to half the ring guarantees that they fit once the ring
+  // is drained, even if the space before its end has to be skipped
+  const std::size_t length = _msg.ByteSizeLong();
+  const uint64_t record = RecordSize(length);
+  if (length > static_cast<std::size_t>(INT_MAX) || record > capacity / 2u)
+    return false;
+
+  const uint64_t tail = header->tail.load(std::memory_order_relaxed);
+  const uint64_t head = header->head.load(std::memory_order_acquire);
+
+  // Records are contiguous, so the end of the ring is skipped if the record
+  // doesn't fit there
+  uint64_t offset = tail % capacity;
+  const uint64_t skipped = capacity - offset < record ? capacity - offset : 0u;
+  if (capacity - (tail - head) < skipped + record)
+    return false;
+
+  if (skipped > 0u)
+  {
+    std::memcpy(this->dataPtr->data + offset, &kWrapMarker, kLengthSize);
+    offset = 0u;
+  }
+
+  const uint64_t length64 = length;
+  std::memcpy(this->dataPtr->data + offset, &length64, kLengthSize);
+  _msg.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(
+      this->dataPtr->data + offset + kLengthSize));
+
+  header->tail.store(tail + skipped + record, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryChannel::Read(google::protobuf::MessageLite &_msg)
+{
+  auto header = this->dataPtr->header;
+  const uint64_t capacity = header->capacity;
+
+  uint64_t head = header->head.load(std::memory_order_relaxed);
+  const uint64_t tail = header->tail.load(std::memory_order_acquire);
+  if (head == tail)
+    return false;
+
+  uint64_t offset = head % capacity;
+  uint64_t length;
+  std::memcpy(&length, this->dataPtr->data + offset, kLengthSize);
+  if (kWrapMarker == length)
+  {
+    head += capacity - offset;
+    offset = 0u;
+    std::memcpy(&length, this->dataPtr->data, kLengthSize);
+  }
+
+  // A corrupt length can't be skipped, so everything is dropped
+  if (length > capacity / 2u || tail - head < RecordSize(length))
+  {
+    ignerr << "Dropping corrupt messages from shared memory ["
+           << this->dataPtr->name << "]" << std::endl;
+    header->head.store(tail, std::memory_order_release);
+    return false;
+  }
+
+  const bool parsed = _msg.ParseFromArray(
+      this->dataPtr->data + offset + kLengthSize, static_cast<int>(length));
+
+  header->head.store(head + RecordSize(length), std::memory_order_release);
+  return parsed;
+}
+
+/////////////////////////////////////////////////
+const std::string &SharedMemoryChannel::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+std::size_t SharedMemoryChannel::Capacity() const
+{
+  return this->dataPtr->header->capacity;
+}
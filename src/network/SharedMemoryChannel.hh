@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_NETWORK_SHAREDMEMORYCHANNEL_HH_
+#define IGNITION_GAZEBO_NETWORK_SHAREDMEMORYCHANNEL_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <google/protobuf/message_lite.h>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    // Forward declarations.
+    class SharedMemoryChannelPrivate;
+
+    /// \class SharedMemoryChannel SharedMemoryChannel.hh
+    ///   ignition/gazebo/network/SharedMemoryChannel.hh
+    /// \brief Lock-free queue of protobuf messages between two processes on
+    /// the same host, backed by a named shared memory segment.
+    ///
+    /// The segment holds a ring of variable length records. Messages are
+    /// serialized straight into the ring by Write and parsed straight out of
+    /// it by Read, so no intermediate buffers are needed. Write must only be
+    /// called by one producer and Read by one consumer. Neither blocks: Write
+    /// fails when there's no room for the message and Read fails when there's
+    /// no message.
+    ///
+    /// Shared memory is only supported on POSIX systems. Elsewhere, Create
+    /// and Open always fail, so callers can fall back to ign-transport.
+    class IGNITION_GAZEBO_VISIBLE SharedMemoryChannel
+    {
+      /// \brief Create a new channel. The segment is removed from the system
+      /// when the returned channel is destroyed, but stays mapped by the
+      /// processes which opened it.
+      /// \param[in] _name Name of the channel, unique in the host.
+      /// \param[in] _capacity Size of the ring in bytes. It's rounded up to
+      /// a multiple of 8. Messages larger than half of it can't be written.
+      /// \return The new channel, or nullptr if it couldn't be created.
+      public: static std::unique_ptr<SharedMemoryChannel> Create(
+                  const std::string &_name, std::size_t _capacity);
+
+      /// \brief Open a channel created by another process.
+      /// \param[in] _name Name passed to Create.
+      /// \return The channel, or nullptr if there is no channel with that
+      /// name in this host.
+      public: static std::unique_ptr<SharedMemoryChannel> Open(
+                  const std::string &_name);
+
+      /// \brief Destructor. Unmaps the segment.
+      public: ~SharedMemoryChannel();
+
+      /// \brief Serialize a message into the ring. Must only be called by
+      /// the producer.
+      /// \param[in] _msg Message to write.
+      /// \return False if there isn't enough room for the message, in which
+      /// case nothing is written.
+      public: bool Write(const google::protobuf::MessageLite &_msg);
+
+      /// \brief Parse the oldest message out of the ring. Must only be called
+      /// by the consumer.
+      /// \param[out] _msg Message to parse into.
+      /// \return False if there are no messages, or if the oldest message
+      /// couldn't be parsed. In the latter case, the message is dropped.
+      public: bool Read(google::protobuf::MessageLite &_msg);
+
+      /// \brief Get the name of the channel.
+      /// \return Name passed to Create or Open.
+      public: const std::string &Name() const;
+
+      /// \brief Get the size of the ring.
+      /// \return Number of bytes.
+      public: std::size_t Capacity() const;
+
+      /// \brief Constructor. Use Create or Open instead.
+      private: SharedMemoryChannel();
+
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<SharedMemoryChannelPrivate> dataPtr;
+    };
+    }
+  }  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_NETWORK_SHAREDMEMORYCHANNEL_HH_
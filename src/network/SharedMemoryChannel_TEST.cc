@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include <random>
+#include <string>
+#include <thread>
+
+#include "SharedMemoryChannel.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Get a channel name which isn't used by other test processes.
+/// \param[in] _suffix Suffix which tells the channels of a test apart.
+/// \return Channel name.
+std::string ChannelName(const std::string &_suffix)
+{
+  return "ign_gazebo_test_" + std::to_string(std::random_device()()) + "_" +
+      _suffix;
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, IGN_UTILS_TEST_DISABLED_ON_WIN32(WriteRead))
+{
+  const std::string name = ChannelName("write_read");
+  EXPECT_EQ(nullptr, SharedMemoryChannel::Open(name));
+
+  auto producer = SharedMemoryChannel::Create(name, 1021u);
+  ASSERT_NE(nullptr, producer);
+  EXPECT_EQ(name, producer->Name());
+  EXPECT_EQ(1024u, producer->Capacity());
+
+  auto consumer = SharedMemoryChannel::Open(name);
+  ASSERT_NE(nullptr, consumer);
+  EXPECT_EQ(1024u, consumer->Capacity());
+
+  msgs::StringMsg msg;
+  EXPECT_FALSE(consumer->Read(msg));
+
+  msgs::StringMsg first;
+  first.set_data("first");
+  msgs::StringMsg second;
+  second.set_data("second");
+  EXPECT_TRUE(producer->Write(first));
+  EXPECT_TRUE(producer->Write(second));
+
+  // Messages come out in order
+  EXPECT_TRUE(consumer->Read(msg));
+  EXPECT_EQ("first", msg.data());
+  EXPECT_TRUE(consumer->Read(msg));
+  EXPECT_EQ("second", msg.data());
+  EXPECT_FALSE(consumer->Read(msg));
+
+  // Messages larger than half the ring are rejected
+  msgs::StringMsg large;
+  large.set_data(std::string(600u, 'x'));
+  EXPECT_FALSE(producer->Write(large));
+
+  // The segment is removed along with its creator
+  producer.reset();
+  EXPECT_EQ(nullptr, SharedMemoryChannel::Open(name));
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, IGN_UTILS_TEST_DISABLED_ON_WIN32(Full))
+{
+  const std::string name = ChannelName("full");
+  auto producer = SharedMemoryChannel::Create(name, 256u);
+  ASSERT_NE(nullptr, producer);
+  auto consumer = SharedMemoryChannel::Open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  msgs::StringMsg msg;
+  msg.set_data(std::string(50u, 'a'));
+
+  int written{0};
+  while (producer->Write(msg))
+    ++written;
+  EXPECT_GT(written, 0);
+
+  // Reading makes room again
+  msgs::StringMsg received;
+  EXPECT_TRUE(consumer->Read(received));
+  EXPECT_EQ(msg.data(), received.data());
+  EXPECT_TRUE(producer->Write(msg));
+
+  // Records never straddle the end of the ring
+  for (int i = 0; i < 100; ++i)
+  {
+    msg.set_data(std::string(static_cast<std::size_t>(i % 90), 'b'));
+    while (consumer->Read(received)) {}
+    ASSERT_TRUE(producer->Write(msg)) << i;
+    ASSERT_TRUE(consumer->Read(received)) << i;
+    EXPECT_EQ(msg.data(), received.data()) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryChannel, IGN_UTILS_TEST_DISABLED_ON_WIN32(Threads))
+{
+  const std::string name = ChannelName("threads");
+  auto producer = SharedMemoryChannel::Create(name, 4096u);
+  ASSERT_NE(nullptr, producer);
+  auto consumer = SharedMemoryChannel::Open(name);
+  ASSERT_NE(nullptr, consumer);
+
+  const int count{10000};
+  std::thread thread([&]
+  {
+    msgs::StringMsg msg;
+    for (int i = 0; i < count; ++i)
+    {
+      msg.set_data(std::to_string(i));
+      while (!producer->Write(msg))
+        std::this_thread::yield();
+    }
+  });
+
+  msgs::StringMsg msg;
+  for (int i = 0; i < count; ++i)
+  {
+    while (!consumer->Read(msg))
+      std::this_thread::yield();
+    ASSERT_EQ(std::to_string(i), msg.data());
+  }
+  thread.join();
+  EXPECT_FALSE(consumer->Read(msg));
+}
@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/FlagSet.hh>
+#include <ignition/common/HWVideo.hh>
+#include <ignition/common/StringUtils.hh>
+#include <ignition/common/VideoEncoder.hh>
+
+#include "ignition/gazebo/rendering/AsyncVideoEncoder.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief A frame waiting to be encoded.
+struct QueuedFrame
+{
+  /// \brief Frame data.
+  std::vector<unsigned char> data;
+
+  /// \brief Width of the frame.
+  unsigned int width{0u};
+
+  /// \brief Height of the frame.
+  unsigned int height{0u};
+
+  /// \brief Time of the frame.
+  std::chrono::steady_clock::time_point timestamp;
+};
+
+/// Private data for the AsyncVideoEncoder class
+class ignition::gazebo::AsyncVideoEncoderPrivate
+{
+  /// \brief Encode queued frames until encoding is stopped and the queue
+  /// is empty. Runs on the encoding thread.
+  public: void Run();
+
+  /// \brief Video encoder. It's only used by the encoding thread while
+  /// that thread is running.
+  public: common::VideoEncoder encoder;
+
+  /// \brief Encoding thread.
+  public: std::thread thread;
+
+  /// \brief Protects the queue and the free buffers.
+  public: std::mutex mutex;
+
+  /// \brief Notifies the encoding thread of new frames or of a stop.
+  public: std::condition_variable frameCv;
+
+  /// \brief Notifies blocked callers that there's room in the queue.
+  public: std::condition_variable roomCv;
+
+  /// \brief Frames waiting to be encoded.
+  public: std::deque<QueuedFrame> queue;
+
+  /// \brief Buffers of encoded frames, reused for new frames so that
+  /// frames don't allocate once the queue has filled up.
+  public: std::vector<std::vector<unsigned char>> freeBuffers;
+
+  /// \brief Number of frames queued or being copied into the queue.
+  public: unsigned int pending{0u};
+
+  /// \brief Maximum number of frames waiting to be encoded.
+  public: unsigned int queueSize{8u};
+
+  /// \brief Whether frames are dropped when the queue is full.
+  public: bool dropFrames{true};
+
+  /// \brief Whether the encoding thread should stop once the queue is
+  /// empty.
+  public: bool stopRequested{false};
+
+  /// \brief Whether a video is being encoded.
+  public: std::atomic<bool> encoding{false};
+
+  /// \brief Name of the hardware encoder.
+  public: std::string hwEncoder;
+
+  /// \brief Device of the hardware encoder.
+  public: std::string hwDevice;
+
+  /// \brief Minimum time between frames.
+  public: std::chrono::steady_clock::duration framePeriod{0};
+
+  /// \brief Time of the last queued frame.
+  public: std::chrono::steady_clock::time_point lastFrameTime;
+
+  /// \brief Whether a frame has been queued since the video started.
+  public: bool hasFrame{false};
+
+  /// \brief Number of frames dropped.
+  public: std::atomic<uint64_t> dropped{0u};
+
+  /// \brief Number of frames encoded.
+  public: std::atomic<uint64_t> encoded{0u};
+};
+
+//////////////////////////////////////////////////
+void AsyncVideoEncoderPrivate::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->frameCv.wait(lock, [this]
+    {
+      return !this->queue.empty() || this->stopRequested;
+    });
+    if (this->queue.empty())
+      break;
+
+    QueuedFrame frame = std::move(this->queue.front());
+    this->queue.pop_front();
+    lock.unlock();
+
+    if (this->encoder.AddFrame(frame.data.data(), frame.width, frame.height,
+        frame.timestamp))
+    {
+      ++this->encoded;
+    }
+
+    lock.lock();
+    this->freeBuffers.push_back(std::move(frame.data));
+    --this->pending;
+    this->roomCv.notify_one();
+  }
+}
+
+//////////////////////////////////////////////////
+AsyncVideoEncoder::AsyncVideoEncoder()
+  : dataPtr(std::make_unique<AsyncVideoEncoderPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+AsyncVideoEncoder::~AsyncVideoEncoder()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+void AsyncVideoEncoder::SetHardwareEncoder(const std::string &_encoder,
+    const std::string &_device)
+{
+  this->dataPtr->hwEncoder = common::lowercase(_encoder);
+  this->dataPtr->hwDevice = _device;
+}
+
+//////////////////////////////////////////////////
+void AsyncVideoEncoder::SetQueueSize(const unsigned int _size)
+{
+  this->dataPtr->queueSize = std::max(1u, _size);
+}
+
+//////////////////////////////////////////////////
+void AsyncVideoEncoder::SetDropFrames(const bool _drop)
+{
+  this->dataPtr->dropFrames = _drop;
+}
+
+//////////////////////////////////////////////////
+bool AsyncVideoEncoder::Start(const std::string &_format,
+    const std::string &_filename, const unsigned int _width,
+    const unsigned int _height, const unsigned int _fps,
+    const unsigned int _bitRate)
+{
+  if (this->dataPtr->encoding)
+    return false;
+
+  bool started{false};
+  const std::string &hw = this->dataPtr->hwEncoder;
+  if (hw.empty())
+  {
+    // The allowed encoders can still be set through environment variables
+    started = this->dataPtr->encoder.Start(_format, _filename, _width,
+        _height, _fps, _bitRate);
+  }
+  else
+  {
+    common::FlagSet<common::HWEncoderType> allowed;
+    if (hw == "auto")
+      allowed = common::FlagSet<common::HWEncoderType>::AllSet();
+    else if (hw == "nvenc")
+      allowed = {common::HWEncoderType::NVENC};
+    else if (hw == "vaapi")
+      allowed = {common::HWEncoderType::VAAPI};
+    else if (hw == "qsv")
+      allowed = {common::HWEncoderType::QSV};
+    else if (hw == "videotoolbox")
+      allowed = {common::HWEncoderType::VIDEOTOOLBOX};
+    else if (hw != "none")
+    {
+      ignwarn << "Unknown hardware video encoder [" << hw << "], using "
+              << "software encoding. Supported encoders are auto, nvenc, "
+              << "vaapi, qsv and videotoolbox." << std::endl;
+    }
+
+    started = this->dataPtr->encoder.Start(_format, _filename, _width,
+        _height, _fps, _bitRate, allowed, this->dataPtr->hwDevice);
+  }
+
+  if (!started)
+    return false;
+
+  this->dataPtr->framePeriod = _fps > 0u ?
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / _fps)) :
+      std::chrono::steady_clock::duration::zero();
+  this->dataPtr->hasFrame = false;
+  this->dataPtr->dropped = 0u;
+  this->dataPtr->encoded = 0u;
+  this->dataPtr->stopRequested = false;
+  this->dataPtr->encoding = true;
+  this->dataPtr->thread =
+      std::thread(&AsyncVideoEncoderPrivate::Run, this->dataPtr.get());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool AsyncVideoEncoder::AddFrame(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height,
+    const std::chrono::steady_clock::time_point &_timestamp)
+{
+  if (!this->dataPtr->encoding)
+    return false;
+
+  // The encoder skips frames which come too soon, so there's no point in
+  // copying them
+  const auto dt = _timestamp - this->dataPtr->lastFrameTime;
+  if (this->dataPtr->hasFrame && dt >= dt.zero() &&
+      dt < this->dataPtr->framePeriod)
+  {
+    return false;
+  }
+
+  std::vector<unsigned char> buffer;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->pending >= this->dataPtr->queueSize)
+    {
+      if (this->dataPtr->dropFrames)
+      {
+        if (this->dataPtr->dropped++ == 0u)
+        {
+          ignwarn << "Video encoding can't keep up, dropping frames."
+                  << std::endl;
+        }
+        return false;
+      }
+      this->dataPtr->roomCv.wait(lock, [this]
+      {
+        return this->dataPtr->pending < this->dataPtr->queueSize;
+      });
+    }
+    ++this->dataPtr->pending;
+    if (!this->dataPtr->freeBuffers.empty())
+    {
+      buffer = std::move(this->dataPtr->freeBuffers.back());
+      this->dataPtr->freeBuffers.pop_back();
+    }
+  }
+
+  // The copy is made outside the lock, so the encoding thread can carry on
+  buffer.assign(_frame, _frame + _width * _height * 3u);
+  this->dataPtr->hasFrame = true;
+  this->dataPtr->lastFrameTime = _timestamp;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->queue.push_back(
+        {std::move(buffer), _width, _height, _timestamp});
+  }
+  this->dataPtr->frameCv.notify_one();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool AsyncVideoEncoder::Stop()
+{
+  if (!this->dataPtr->encoding)
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopRequested = true;
+  }
+  this->dataPtr->frameCv.notify_one();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+
+  this->dataPtr->encoder.Stop();
+  this->dataPtr->encoding = false;
+  this->dataPtr->freeBuffers.clear();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool AsyncVideoEncoder::IsEncoding() const
+{
+  return this->dataPtr->encoding;
+}
+
+//////////////////////////////////////////////////
+uint64_t AsyncVideoEncoder::DroppedFrames() const
+{
+  return this->dataPtr->dropped;
+}
+
+//////////////////////////////////////////////////
+uint64_t AsyncVideoEncoder::EncodedFrames() const
+{
+  return this->dataPtr->encoded;
+}
@@ -16,10 +16,12 @@
 */
 
 #include <functional>
-#include <list>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ignition/msgs.hh>
 #include <ignition/transport/Node.hh>
@@ -51,7 +53,8 @@ class ignition::gazebo::MarkerManagerPrivate
                     const ignition::msgs::Marker &_msg);
 
   /// \brief Converts an ignition msg material to ignition rendering
-  //         material.
+  //         material. The same material is reused by all calls, so it must
+  //         be cloned before being handed to a marker.
   //  \param[in] _msg The message data.
   //  \return Converted rendering material, if any.
   public: rendering::MaterialPtr MsgToMaterial(
@@ -95,15 +98,27 @@ class ignition::gazebo::MarkerManagerPrivate
   /// \brief Previous sim time received
   public: std::chrono::steady_clock::duration lastSimTime;
 
-  /// \brief Mutex to protect message list.
-  public: std::mutex mutex;
+  /// \brief Mutex to protect the visuals and sim time.
+  public: mutable std::mutex mutex;
+
+  /// \brief Mutex to protect the message list, so that messages can be
+  /// received while markers are being processed.
+  public: mutable std::mutex msgMutex;
 
   /// \brief Map of visuals
   public: std::map<std::string,
       std::map<uint64_t, ignition::rendering::VisualPtr>> visuals;
 
+  /// \brief Namespace and id of markers which were given a lifetime. May
+  /// hold markers which have been deleted or modified since, which are
+  /// dropped on the next update.
+  public: std::set<std::pair<std::string, uint64_t>> expiringMarkers;
+
   /// \brief List of marker message to process.
-  public: std::list<ignition::msgs::Marker> markerMsgs;
+  public: std::vector<ignition::msgs::Marker> markerMsgs;
+
+  /// \brief Material filled by MsgToMaterial, reused for all messages.
+  public: rendering::MaterialPtr msgMaterial;
 
   /// \brief Pointer to the scene
   public: rendering::ScenePtr scene;
@@ -148,6 +163,20 @@ void MarkerManager::Update()
   return this->dataPtr->Update();
 }
 
+/////////////////////////////////////////////////
+bool MarkerManager::HasPendingChanges() const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    if (!this->dataPtr->markerMsgs.empty())
+      return true;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return !this->dataPtr->expiringMarkers.empty() &&
+      this->dataPtr->simTime != this->dataPtr->lastSimTime;
+}
+
 /////////////////////////////////////////////////
 bool MarkerManager::Init(const ignition::rendering::ScenePtr &_scene)
 {
@@ -206,50 +235,157 @@ void MarkerManager::SetSimTime(
 }
 
 /////////////////////////////////////////////////
-void MarkerManagerPrivate::Update()
+/// \brief Merge an add / modify message into an earlier one for the same
+/// marker, so that processing the result has the same effect as processing
+/// both.
+/// \param[in,out] _dst Earlier message, which receives the merge.
+/// \param[in] _src Later message. It must not have a parent, since the
+/// parent would then be looked up earlier than requested.
+/// \return False if the messages can't be merged, in which case _dst is
+/// unchanged.
+static bool mergeMarkerMsg(msgs::Marker &_dst, const msgs::Marker &_src)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-
-  // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  // Points are colored with the diffuse color of the message which carries
+  // them, so the points and the material must come from the same message
+  if (_src.point_size() > 0)
+  {
+    if (!_src.has_material() && _dst.has_material())
+      return false;
+  }
+  else if (_dst.point_size() > 0 && _src.has_material())
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    return false;
   }
 
+  msgs::Marker merged = _src;
+  if (!merged.has_scale() && _dst.has_scale())
+    *merged.mutable_scale() = _dst.scale();
+  if (!merged.has_pose() && _dst.has_pose())
+    *merged.mutable_pose() = _dst.pose();
+  if (!merged.has_material() && _dst.has_material())
+    *merged.mutable_material() = _dst.material();
+  if (merged.point_size() == 0)
+    *merged.mutable_point() = _dst.point();
+  if (merged.type() == msgs::Marker::NONE)
+    merged.set_type(_dst.type());
+  merged.set_parent(_dst.parent());
+
+  _dst = std::move(merged);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Merge the add / modify messages received for the same marker
+/// within a frame, so that each marker is updated once. Messages are kept
+/// in order otherwise, and deletions end the merging for the markers they
+/// remove.
+/// \param[in,out] _msgs Messages to coalesce.
+static void coalesceMarkerMsgs(std::vector<msgs::Marker> &_msgs)
+{
+  // Index in _msgs of the latest add / modify message of each marker
+  std::map<std::pair<std::string, uint64_t>, std::size_t> pending;
 
-  // Erase any markers that have a lifetime.
-  for (auto mit = this->visuals.begin();
-       mit != this->visuals.end();)
+  std::size_t count{0u};
+  for (std::size_t i = 0; i < _msgs.size(); ++i)
   {
-    for (auto it = mit->second.cbegin();
-         it != mit->second.cend(); ++it)
+    auto &msg = _msgs[i];
+    if (msg.action() == msgs::Marker::DELETE_ALL)
     {
-      if (it->second->GeometryCount() == 0u)
-        continue;
-
-      ignition::rendering::MarkerPtr markerPtr =
-            std::dynamic_pointer_cast<ignition::rendering::Marker>
-            (it->second->GeometryByIndex(0u));
-      if (markerPtr != nullptr)
+      if (msg.ns().empty())
       {
-        if (markerPtr->Lifetime().count() != 0 &&
-            (markerPtr->Lifetime() <= simTime ||
-            this->simTime < this->lastSimTime))
+        pending.clear();
+      }
+      else
+      {
+        auto it = pending.lower_bound({msg.ns(), 0u});
+        while (it != pending.end() && it->first.first == msg.ns())
+          it = pending.erase(it);
+      }
+    }
+    // Markers without an id get a new one each time
+    else if (msg.id() != 0)
+    {
+      std::pair<std::string, uint64_t> key{msg.ns(), msg.id()};
+      if (msg.action() == msgs::Marker::ADD_MODIFY)
+      {
+        auto it = pending.find(key);
+        if (it != pending.end() && msg.parent().empty() &&
+            mergeMarkerMsg(_msgs[it->second], msg))
         {
-          this->scene->DestroyVisual(it->second);
-          it = mit->second.erase(it);
-          break;
+          continue;
         }
+        pending[key] = count;
+      }
+      else
+      {
+        pending.erase(key);
       }
     }
 
-    // Erase a namespace if it's empty
-    if (mit->second.empty())
-      mit = this->visuals.erase(mit);
-    else
-      ++mit;
+    if (count != i)
+      _msgs[count] = std::move(msg);
+    ++count;
+  }
+  _msgs.resize(count);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::Update()
+{
+  std::vector<ignition::msgs::Marker> batch;
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    batch.swap(this->markerMsgs);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Process the marker messages.
+  coalesceMarkerMsgs(batch);
+  for (const auto &msg : batch)
+    this->ProcessMarkerMsg(msg);
+
+  // Erase any markers whose lifetime is over.
+  const bool reset = this->simTime < this->lastSimTime;
+  for (auto it = this->expiringMarkers.begin();
+       it != this->expiringMarkers.end();)
+  {
+    auto nsIter = this->visuals.find(it->first);
+    if (nsIter == this->visuals.end())
+    {
+      it = this->expiringMarkers.erase(it);
+      continue;
+    }
+    auto visualIter = nsIter->second.find(it->second);
+    if (visualIter == nsIter->second.end() ||
+        visualIter->second->GeometryCount() == 0u)
+    {
+      it = this->expiringMarkers.erase(it);
+      continue;
+    }
+
+    ignition::rendering::MarkerPtr markerPtr =
+          std::dynamic_pointer_cast<ignition::rendering::Marker>
+          (visualIter->second->GeometryByIndex(0u));
+    if (markerPtr == nullptr || markerPtr->Lifetime().count() == 0)
+    {
+      it = this->expiringMarkers.erase(it);
+      continue;
+    }
+
+    if (markerPtr->Lifetime() <= this->simTime || reset)
+    {
+      this->scene->DestroyVisual(visualIter->second);
+      nsIter->second.erase(visualIter);
+
+      // Erase a namespace if it's empty
+      if (nsIter->second.empty())
+        this->visuals.erase(nsIter);
+
+      it = this->expiringMarkers.erase(it);
+      continue;
+    }
+    ++it;
   }
   this->lastSimTime = this->simTime;
 }
@@ -327,9 +463,6 @@ void MarkerManagerPrivate::SetMarker(const ignition::msgs::Marker &_msg,
   {
     rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
     _markerPtr->SetMaterial(materialPtr, true /* clone */);
-
-    // clean up material after clone
-    this->scene->DestroyMaterial(materialPtr);
   }
 
   // Assume the presence of points means we clear old ones
@@ -401,7 +534,9 @@ ignition::rendering::MarkerType MarkerManagerPrivate::MsgToType(
 rendering::MaterialPtr MarkerManagerPrivate::MsgToMaterial(
                               const ignition::msgs::Marker &_msg)
 {
-  rendering::MaterialPtr material = this->scene->CreateMaterial();
+  if (!this->msgMaterial)
+    this->msgMaterial = this->scene->CreateMaterial();
+  rendering::MaterialPtr material = this->msgMaterial;
 
   material->SetAmbient(
       _msg.material().ambient().r(),
@@ -491,6 +626,8 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
 
         // Set the marker values from the Marker Message
         this->SetMarker(_msg, markerPtr);
+        if (markerPtr->Lifetime().count() != 0)
+          this->expiringMarkers.insert({ns, id});
 
         visualIter->second->AddGeometry(markerPtr);
       }
@@ -513,6 +650,8 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const ignition::msgs::Marker &_msg)
 
       // Set the marker values from the Marker Message
       this->SetMarker(_msg, markerPtr);
+      if (markerPtr->Lifetime().count() != 0)
+        this->expiringMarkers.insert({ns, id});
 
       // Add populated marker to the visual
       visualPtr->AddGeometry(markerPtr);
@@ -615,7 +754,7 @@ bool MarkerManagerPrivate::OnList(ignition::msgs::Marker_V &_rep)
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
+  std::lock_guard<std::mutex> lock(this->msgMutex);
   this->markerMsgs.push_back(_req);
 }
 
@@ -623,9 +762,9 @@ void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 bool MarkerManagerPrivate::OnMarkerMsgArray(
     const ignition::msgs::Marker_V&_req, ignition::msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
+  std::lock_guard<std::mutex> lock(this->msgMutex);
+  this->markerMsgs.insert(this->markerMsgs.end(), _req.marker().begin(),
+      _req.marker().end());
   _res.set_data(true);
   return true;
 }
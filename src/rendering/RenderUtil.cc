@@ -15,6 +15,8 @@
  *
  */
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <stack>
 #include <string>
@@ -298,6 +300,10 @@ class ignition::gazebo::RenderUtilPrivate
   /// \brief A map of entity ids and pose updates.
   public: std::unordered_map<Entity, math::Pose3d> entityPoses;
 
+  /// \brief ECM change tick of the last pose update. Only poses which
+  /// changed after it are pushed to the scene.
+  public: uint64_t poseTick{0u};
+
   /// \brief A map of entity ids and light updates.
   public: std::unordered_map<Entity, msgs::Light> entityLights;
 
@@ -341,6 +347,10 @@ class ignition::gazebo::RenderUtilPrivate
   /// All temperatures are in Kelvin.
   public: std::map<Entity, std::tuple<float, float, std::string>> entityTemp;
 
+  /// \brief ECM change tick of the last temperature update. Only the
+  /// temperatures which changed after it are pushed to the scene.
+  public: uint64_t temperatureTick{0u};
+
   /// \brief A map of entity ids and label data for datasets annotations
   public: std::unordered_map<Entity, int> entityLabel;
 
@@ -418,6 +428,48 @@ class ignition::gazebo::RenderUtilPrivate
   /// \brief Whether the transform gizmo is being dragged.
   public: bool transformActive{false};
 
+  /// \brief Whether Update renders the current scene instead of waiting
+  /// for an ECM update in progress.
+  public: bool asyncUpdates{false};
+
+  /// \brief Whether poses received from the ECM are interpolated over the
+  /// period of incoming states.
+  public: bool interpolatePoses{false};
+
+  /// \brief Pose interpolation of a single node.
+  public: struct PoseInterpolation
+  {
+    /// \brief Node being moved.
+    rendering::NodePtr node;
+
+    /// \brief Pose of the node when it started moving.
+    math::Pose3d from;
+
+    /// \brief Pose received from the ECM.
+    math::Pose3d to;
+  };
+
+  /// \brief Nodes which are being moved to the poses they were last given.
+  public: std::unordered_map<Entity, PoseInterpolation> poseInterpolations;
+
+  /// \brief Wall clock time at which the poses being interpolated were
+  /// received.
+  public: std::chrono::steady_clock::time_point interpolationStart;
+
+  /// \brief Period over which the poses being interpolated move.
+  public: std::chrono::duration<double> interpolationPeriod{0.0};
+
+  /// \brief Wall clock time at which the last state with a new sim time
+  /// was read from the ECM.
+  public: std::chrono::steady_clock::time_point lastStateTime;
+
+  /// \brief Smoothed wall clock period between states with a new sim time.
+  public: std::chrono::duration<double> statePeriod{0.0};
+
+  /// \brief Move the nodes being interpolated towards their target poses.
+  /// This should be called in RenderUtil::Update.
+  public: void InterpolatePoses();
+
   /// \brief Highlight a node and all its children.
   /// \param[in] _node Node to be highlighted
   public: void HighlightNode(const rendering::NodePtr &_node);
@@ -762,11 +814,72 @@ void RenderUtil::UpdateECM(const UpdateInfo &/*_info*/,
 }
 
 //////////////////////////////////////////////////
+bool RenderUtil::SceneChangedSince(const EntityComponentManager &_ecm,
+    uint64_t _tick) const
+{
+  if (_ecm.HasNewEntities() || _ecm.HasEntitiesMarkedForRemoval())
+    return true;
+
+  // Actors and particles are animated over time
+  if (_ecm.HasComponentType(components::Actor::typeId) ||
+      _ecm.HasComponentType(components::ParticleEmitter::typeId))
+  {
+    return true;
+  }
+
+  bool changed{false};
+  auto check = [&changed](const Entity &, const auto *) -> bool
+  {
+    changed = true;
+    return false;
+  };
+  _ecm.EachChangedSince<components::Pose>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::Geometry>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::Material>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::Transparency>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::VisibilityFlags>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::VisualCmd>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::Light>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::LightCmd>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::Temperature>(_tick, check);
+  if (!changed)
+    _ecm.EachChangedSince<components::SemanticLabel>(_tick, check);
+  return changed;
+}
+
+/////////////////////////////////////////////////
 void RenderUtil::UpdateFromECM(const UpdateInfo &_info,
                                const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("RenderUtil::UpdateFromECM");
   std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
+
+  // Keep track of how often new states arrive, which is the period poses
+  // are interpolated over
+  if (_info.simTime != this->dataPtr->simTime)
+  {
+    auto now = std::chrono::steady_clock::now();
+    if (this->dataPtr->lastStateTime !=
+        std::chrono::steady_clock::time_point())
+    {
+      // Cap the period so that a long pause doesn't slow down interpolation
+      std::chrono::duration<double> period = std::min<
+          std::chrono::duration<double>>(now - this->dataPtr->lastStateTime,
+          std::chrono::milliseconds(500));
+      this->dataPtr->statePeriod = this->dataPtr->statePeriod.count() <= 0.0 ?
+          period : 0.8 * this->dataPtr->statePeriod + 0.2 * period;
+    }
+    this->dataPtr->lastStateTime = now;
+  }
+
   this->dataPtr->simTime = _info.simTime;
 
   this->dataPtr->CreateRenderingEntities(_ecm, _info);
@@ -1031,7 +1144,19 @@ void RenderUtil::Update()
   if (!this->dataPtr->scene)
     return;
 
-  this->dataPtr->updateMutex.lock();
+  std::unique_lock<std::mutex> lock(this->dataPtr->updateMutex,
+      std::defer_lock);
+  if (!this->dataPtr->asyncUpdates)
+  {
+    lock.lock();
+  }
+  // Render the scene as of the last completed update, instead of waiting
+  // for the ECM update in progress. Its changes are applied next frame.
+  else if (!lock.try_lock())
+  {
+    this->dataPtr->InterpolatePoses();
+    return;
+  }
 
   this->dataPtr->scene->SetTime(this->dataPtr->simTime);
   auto newScenes = std::move(this->dataPtr->newScenes);
@@ -1098,7 +1223,8 @@ void RenderUtil::Update()
     newSensors = std::move(this->dataPtr->newSensors);
     this->dataPtr->newSensors.clear();
   }
-  this->dataPtr->updateMutex.unlock();
+  const auto statePeriod = this->dataPtr->statePeriod;
+  lock.unlock();
 
   // scene - only one scene is supported for now
   // extend the sensor system to support mutliple scenes in the future
@@ -1136,10 +1262,13 @@ void RenderUtil::Update()
           this->dataPtr->selectedEntities.end(), entity.first),
           this->dataPtr->selectedEntities.end());
       this->dataPtr->sceneManager.RemoveEntity(entity.first);
+      this->dataPtr->poseInterpolations.erase(entity.first);
 
       this->dataPtr->RemoveSensor(entity.first);
       this->dataPtr->RemoveBoundingBox(entity.first);
     }
+    if (!removeEntities.empty())
+      this->dataPtr->sceneManager.Compact();
   }
 
   // create new entities
@@ -1261,6 +1390,14 @@ void RenderUtil::Update()
   // update entities' pose
   {
     IGN_PROFILE("RenderUtil::Update Poses");
+    const bool interpolate = this->dataPtr->interpolatePoses &&
+        statePeriod.count() > 0.0 && !entityPoses.empty();
+    if (interpolate)
+    {
+      this->dataPtr->interpolationStart = std::chrono::steady_clock::now();
+      this->dataPtr->interpolationPeriod = statePeriod;
+    }
+
     for (const auto &pose : entityPoses)
     {
       auto node = this->dataPtr->sceneManager.NodeById(pose.first);
@@ -1286,11 +1423,27 @@ void RenderUtil::Update()
           entityId == this->dataPtr->selectedEntities.back())) ||
           updateNode)
       {
+        this->dataPtr->poseInterpolations.erase(pose.first);
+        continue;
+      }
+
+      // Actors are posed together with their animation below
+      if (!interpolate ||
+          this->dataPtr->sceneManager.ActorMeshById(pose.first))
+      {
+        this->dataPtr->poseInterpolations.erase(pose.first);
+        node->SetLocalPose(pose.second);
         continue;
       }
 
-      node->SetLocalPose(pose.second);
+      auto from = node->LocalPose();
+      if (from == pose.second)
+        this->dataPtr->poseInterpolations.erase(pose.first);
+      else
+        this->dataPtr->poseInterpolations[pose.first] = {node, from,
+            pose.second};
     }
+    this->dataPtr->InterpolatePoses();
 
     // update entities' local transformations
     if (this->dataPtr->actorManualSkeletonUpdate)
@@ -2172,7 +2325,12 @@ void RenderUtilPrivate::UpdateRenderingEntities(
     const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("RenderUtilPrivate::UpdateRenderingEntities");
-  _ecm.Each<components::Model, components::Pose>(
+
+  // Only push the poses which changed since the last update, so that static
+  // entities don't cost anything. Poses are kept until they're consumed by
+  // Update, so none are lost if several ECM updates happen in between
+  _ecm.EachChangedSince<components::Model, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::Model *,
         const components::Pose *_pose)->bool
@@ -2181,7 +2339,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
         return true;
       });
 
-  _ecm.Each<components::Link, components::Pose>(
+  _ecm.EachChangedSince<components::Link, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::Link *,
         const components::Pose *_pose)->bool
@@ -2191,7 +2350,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // visuals
-  _ecm.Each<components::Visual, components::Pose >(
+  _ecm.EachChangedSince<components::Visual, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::Visual *,
         const components::Pose *_pose)->bool
@@ -2256,7 +2416,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // update lights
-  _ecm.Each<components::Light, components::Pose>(
+  _ecm.EachChangedSince<components::Light, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::Light *,
         const components::Pose *_pose)->bool
@@ -2266,7 +2427,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update cameras
-  _ecm.Each<components::Camera, components::Pose>(
+  _ecm.EachChangedSince<components::Camera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::Camera *,
         const components::Pose *_pose)->bool
@@ -2276,7 +2438,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update depth cameras
-  _ecm.Each<components::DepthCamera, components::Pose>(
+  _ecm.EachChangedSince<components::DepthCamera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::DepthCamera *,
         const components::Pose *_pose)->bool
@@ -2286,7 +2449,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update RGBD cameras
-  _ecm.Each<components::RgbdCamera, components::Pose>(
+  _ecm.EachChangedSince<components::RgbdCamera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::RgbdCamera *,
         const components::Pose *_pose)->bool
@@ -2296,7 +2460,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update gpu_lidar
-  _ecm.Each<components::GpuLidar, components::Pose>(
+  _ecm.EachChangedSince<components::GpuLidar, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::GpuLidar *,
         const components::Pose *_pose)->bool
@@ -2306,7 +2471,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update thermal cameras
-  _ecm.Each<components::ThermalCamera, components::Pose>(
+  _ecm.EachChangedSince<components::ThermalCamera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::ThermalCamera *,
         const components::Pose *_pose)->bool
@@ -2316,7 +2482,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update segmentation cameras
-  _ecm.Each<components::SegmentationCamera, components::Pose>(
+  _ecm.EachChangedSince<components::SegmentationCamera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::SegmentationCamera *,
         const components::Pose *_pose)->bool
@@ -2326,7 +2493,8 @@ void RenderUtilPrivate::UpdateRenderingEntities(
       });
 
   // Update bounding box cameras
-  _ecm.Each<components::BoundingBoxCamera, components::Pose>(
+  _ecm.EachChangedSince<components::BoundingBoxCamera, components::Pose>(
+      this->poseTick,
       [&](const Entity &_entity,
         const components::BoundingBoxCamera *,
         const components::Pose *_pose)->bool
@@ -2334,6 +2502,42 @@ void RenderUtilPrivate::UpdateRenderingEntities(
         this->entityPoses[_entity] = _pose->Data();
         return true;
       });
+
+  this->poseTick = _ecm.ChangeTick();
+
+  // Temperatures are set on the visuals, which are shared by all thermal
+  // cameras, so they're only pushed when they change, once for all cameras
+  _ecm.EachChangedSince<components::Visual, components::Temperature>(
+      this->temperatureTick,
+      [&](const Entity &_entity,
+        const components::Visual *,
+        const components::Temperature *_temp)->bool
+      {
+        this->entityTemp[_entity] = std::make_tuple<float, float, std::string>(
+            _temp->Data().Kelvin(), 0.0, "");
+        return true;
+      });
+
+  _ecm.EachChangedSince<components::Visual, components::TemperatureRange,
+      components::SourceFilePath>(
+      this->temperatureTick,
+      [&](const Entity &_entity,
+        const components::Visual *,
+        const components::TemperatureRange *_tempRange,
+        const components::SourceFilePath *_heatSignature)->bool
+      {
+        // A uniform temperature takes precedence over a heat signature
+        if (_ecm.Component<components::Temperature>(_entity))
+          return true;
+
+        this->entityTemp[_entity] = std::make_tuple<float, float, std::string>(
+            _tempRange->Data().min.Kelvin(),
+            _tempRange->Data().max.Kelvin(),
+            std::string(_heatSignature->Data()));
+        return true;
+      });
+
+  this->temperatureTick = this->poseTick;
 }
 
 //////////////////////////////////////////////////
@@ -2741,6 +2945,43 @@ void RenderUtil::SetTransformActive(bool _active)
   this->dataPtr->transformActive = _active;
 }
 
+/////////////////////////////////////////////////
+void RenderUtil::SetAsyncUpdates(bool _async)
+{
+  this->dataPtr->asyncUpdates = _async;
+}
+
+/////////////////////////////////////////////////
+void RenderUtil::SetPoseInterpolation(bool _interpolate)
+{
+  this->dataPtr->interpolatePoses = _interpolate;
+}
+
+/////////////////////////////////////////////////
+void RenderUtilPrivate::InterpolatePoses()
+{
+  if (this->poseInterpolations.empty())
+    return;
+
+  IGN_PROFILE("RenderUtil::Update Interpolate poses");
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - this->interpolationStart;
+  const double t = this->interpolationPeriod.count() <= 0.0 ? 1.0 :
+      std::min(1.0, elapsed / this->interpolationPeriod);
+
+  for (const auto &interpolation : this->poseInterpolations)
+  {
+    const auto &from = interpolation.second.from;
+    const auto &to = interpolation.second.to;
+    math::Pose3d pose(from.Pos() + (to.Pos() - from.Pos()) * t,
+        math::Quaterniond::Slerp(t, from.Rot(), to.Rot(), true));
+    interpolation.second.node->SetLocalPose(pose);
+  }
+
+  if (t >= 1.0)
+    this->poseInterpolations.clear();
+}
+
 ////////////////////////////////////////////////
 void RenderUtilPrivate::UpdateVisualLabels(
   const std::unordered_map<Entity, int> &_entityLabel)
@@ -16,8 +16,16 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include <google/protobuf/descriptor.h>
 
 #include <sdf/Box.hh>
 #include <sdf/Capsule.hh>
@@ -59,6 +67,7 @@
 #include <ignition/rendering/WireBox.hh>
 
 #include "ignition/gazebo/Conversions.hh"
+#include "ignition/gazebo/MeshCache.hh"
 #include "ignition/gazebo/Util.hh"
 #include "ignition/gazebo/rendering/SceneManager.hh"
 
@@ -99,6 +108,11 @@ class ignition::gazebo::SceneManagerPrivate
   /// rendering pointers.
   public: std::map<Entity, rendering::ParticleEmitterPtr> particleEmitters;
 
+  /// \brief Map of particle emitter entity in Gazebo to the properties last
+  /// applied to its rendering emitter.
+  public: std::unordered_map<Entity, msgs::ParticleEmitter>
+      particleEmitterStates;
+
   /// \brief Map of sensor entity in Gazebo to sensor pointers.
   public: std::unordered_map<Entity, rendering::SensorPtr> sensors;
 
@@ -115,8 +129,133 @@ class ignition::gazebo::SceneManagerPrivate
   /// also sets the time point in which the animation should be played
   public: AnimationUpdateData ActorTrajectoryAt(
       Entity _id, const std::chrono::steady_clock::duration &_time) const;
+
+  /// \brief Get the skin transforms of all nodes of a skeleton at a point
+  /// of one of its animations. The animation is sampled at
+  /// kAnimationSampleRate, and samples are cached, so that actors sharing a
+  /// skin and an animation reuse each other's results.
+  /// \param[in] _skel Skeleton of the actor
+  /// \param[in] _animIndex Index of the animation in the skeleton
+  /// \param[in] _time Time in the animation, in seconds
+  /// \param[in] _loop True if the animation loops
+  /// \return Transforms of the skin nodes, keyed by name
+  public: const std::map<std::string, math::Matrix4d> &SkinFramesAt(
+      const common::SkeletonPtr &_skel, unsigned int _animIndex,
+      double _time, bool _loop) const;
+
+  /// \brief Cached skin transforms, keyed by skeleton, animation index,
+  /// whether it loops and sample index.
+  public: mutable std::map<std::tuple<const common::Skeleton *, unsigned int,
+      bool, int64_t>, std::map<std::string, math::Matrix4d>> skinFrames;
 };
 
+/// \brief Rate at which skeleton animations are sampled for actors whose
+/// skeletons are updated manually, in samples per second.
+static constexpr double kAnimationSampleRate{120.0};
+
+/////////////////////////////////////////////////
+/// \brief Get the properties of a particle emitter message which differ
+/// from the ones already applied, and record them as applied. Properties
+/// which are only applied in pairs, such as the velocity range, are kept
+/// together.
+/// \param[in] _msg Properties requested.
+/// \param[in, out] _state Properties already applied.
+/// \return Properties to apply.
+static msgs::ParticleEmitter particleEmitterChanges(
+    const msgs::ParticleEmitter &_msg, msgs::ParticleEmitter &_state)
+{
+  msgs::ParticleEmitter changes;
+  const auto *descriptor = _msg.GetDescriptor();
+  const auto *reflection = _msg.GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i)
+  {
+    const auto *field = descriptor->field(i);
+    if (field->is_repeated() || !reflection->HasField(_msg, field) ||
+        field->cpp_type() !=
+        google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
+    {
+      continue;
+    }
+
+    const auto &value = reflection->GetMessage(_msg, field);
+    if (reflection->HasField(_state, field) &&
+        reflection->GetMessage(_state, field).SerializeAsString() ==
+        value.SerializeAsString())
+    {
+      continue;
+    }
+    reflection->MutableMessage(&changes, field)->CopyFrom(value);
+    reflection->MutableMessage(&_state, field)->CopyFrom(value);
+  }
+
+  // The type is the only property which isn't a message, and it's unset when
+  // it's the default
+  if (_msg.type() != msgs::ParticleEmitter::POINT &&
+      _msg.type() != _state.type())
+  {
+    changes.set_type(_msg.type());
+    _state.set_type(_msg.type());
+  }
+
+  if (changes.has_min_velocity() || changes.has_max_velocity())
+  {
+    changes.mutable_min_velocity()->CopyFrom(_state.min_velocity());
+    changes.mutable_max_velocity()->CopyFrom(_state.max_velocity());
+  }
+  if (changes.has_color_start() || changes.has_color_end())
+  {
+    changes.mutable_color_start()->CopyFrom(_state.color_start());
+    changes.mutable_color_end()->CopyFrom(_state.color_end());
+  }
+  return changes;
+}
+
+/////////////////////////////////////////////////
+/// \brief Rehash an entity map to fit its entries if it uses less than a
+/// quarter of its buckets, such as after many entities were removed.
+/// \param[in, out] _map Map to compact.
+/// \return True if the map was rehashed.
+template <typename MapT>
+static bool compactMap(MapT &_map)
+{
+  if (_map.bucket_count() <= 16u || _map.size() * 4u >= _map.bucket_count())
+    return false;
+  _map.rehash(0u);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the file of a resource, such as a texture, caching the
+/// result. The cache is shared by all scene managers in the process, so that
+/// the GUI and the sensors don't search for the same files again, and
+/// neither do repeated instances of the same model.
+/// \param[in] _uri URI of the resource.
+/// \param[in] _filePath Path of the file where the resource is referenced.
+/// \return Full path to the file, or empty string if it wasn't found.
+static std::string findResource(const std::string &_uri,
+    const std::string &_filePath)
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::string> resources;
+
+  const std::string key = _filePath + '\n' + _uri;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = resources.find(key);
+    if (it != resources.end())
+      return it->second;
+  }
+
+  // Files which aren't found aren't cached, since they may become available
+  // later, for example once they're downloaded
+  std::string fullPath = common::findFile(asFullPath(_uri, _filePath));
+  if (!fullPath.empty())
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    resources[key] = fullPath;
+  }
+  return fullPath;
+}
 
 /////////////////////////////////////////////////
 SceneManager::SceneManager()
@@ -677,16 +816,14 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const sdf::Geometry &_geom,
     descriptor.subMeshName = _geom.MeshShape()->Submesh();
     descriptor.centerSubMesh = _geom.MeshShape()->CenterSubmesh();
 
-    ignition::common::MeshManager *meshManager =
-        ignition::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
+    descriptor.mesh = loadCachedMesh(descriptor.meshName);
     geom = this->dataPtr->scene->CreateMesh(descriptor);
     scale = _geom.MeshShape()->Scale();
   }
   else if (_geom.Type() == sdf::GeometryType::HEIGHTMAP)
   {
-    auto fullPath = common::findFile(asFullPath(_geom.HeightmapShape()->Uri(),
-        _geom.HeightmapShape()->FilePath()));
+    auto fullPath = findResource(_geom.HeightmapShape()->Uri(),
+        _geom.HeightmapShape()->FilePath());
     if (fullPath.empty())
     {
       ignerr << "Heightmap geometry missing URI" << std::endl;
@@ -712,10 +849,10 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const sdf::Geometry &_geom,
       auto textureSdf = _geom.HeightmapShape()->TextureByIndex(i);
       rendering::HeightmapTexture textureDesc;
       textureDesc.SetSize(textureSdf->Size());
-      textureDesc.SetDiffuse(common::findFile(asFullPath(textureSdf->Diffuse(),
-          _geom.HeightmapShape()->FilePath())));
-      textureDesc.SetNormal(common::findFile(asFullPath(textureSdf->Normal(),
-          _geom.HeightmapShape()->FilePath())));
+      textureDesc.SetDiffuse(findResource(textureSdf->Diffuse(),
+          _geom.HeightmapShape()->FilePath()));
+      textureDesc.SetNormal(findResource(textureSdf->Normal(),
+          _geom.HeightmapShape()->FilePath()));
       descriptor.AddTexture(textureDesc);
     }
 
@@ -796,8 +933,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
       std::string roughnessMap = metal->RoughnessMap();
       if (!roughnessMap.empty())
       {
-        std::string fullPath = common::findFile(
-            asFullPath(roughnessMap, _material.FilePath()));
+        std::string fullPath = findResource(roughnessMap, _material.FilePath());
         if (!fullPath.empty())
           material->SetRoughnessMap(fullPath);
         else
@@ -808,8 +944,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
       std::string metalnessMap = metal->MetalnessMap();
       if (!metalnessMap.empty())
       {
-        std::string fullPath = common::findFile(
-            asFullPath(metalnessMap, _material.FilePath()));
+        std::string fullPath = findResource(metalnessMap, _material.FilePath());
         if (!fullPath.empty())
           material->SetMetalnessMap(fullPath);
         else
@@ -840,8 +975,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
     std::string albedoMap = workflow->AlbedoMap();
     if (!albedoMap.empty())
     {
-      std::string fullPath = common::findFile(
-          asFullPath(albedoMap, _material.FilePath()));
+      std::string fullPath = findResource(albedoMap, _material.FilePath());
       if (!fullPath.empty())
       {
         material->SetTexture(fullPath);
@@ -856,8 +990,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
     std::string normalMap = workflow->NormalMap();
     if (!normalMap.empty())
     {
-      std::string fullPath = common::findFile(
-          asFullPath(normalMap, _material.FilePath()));
+      std::string fullPath = findResource(normalMap, _material.FilePath());
       if (!fullPath.empty())
         material->SetNormalMap(fullPath);
       else
@@ -869,8 +1002,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
     std::string environmentMap = workflow->EnvironmentMap();
     if (!environmentMap.empty())
     {
-      std::string fullPath = common::findFile(
-          asFullPath(environmentMap, _material.FilePath()));
+      std::string fullPath = findResource(environmentMap, _material.FilePath());
       if (!fullPath.empty())
         material->SetEnvironmentMap(fullPath);
       else
@@ -881,8 +1013,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
     std::string emissiveMap = workflow->EmissiveMap();
     if (!emissiveMap.empty())
     {
-      std::string fullPath = common::findFile(
-          asFullPath(emissiveMap, _material.FilePath()));
+      std::string fullPath = findResource(emissiveMap, _material.FilePath());
       if (!fullPath.empty())
         material->SetEmissiveMap(fullPath);
       else
@@ -893,8 +1024,7 @@ rendering::MaterialPtr SceneManager::LoadMaterial(
     std::string lightMap = workflow->LightMap();
     if (!lightMap.empty())
     {
-      std::string fullPath = common::findFile(
-          asFullPath(lightMap, _material.FilePath()));
+      std::string fullPath = findResource(lightMap, _material.FilePath());
       if (!fullPath.empty())
       {
         unsigned int uvSet = workflow->LightMapTexCoordSet();
@@ -1552,7 +1682,7 @@ rendering::ParticleEmitterPtr SceneManager::CreateParticleEmitter(
 
 /////////////////////////////////////////////////
 rendering::ParticleEmitterPtr SceneManager::UpdateParticleEmitter(Entity _id,
-    const msgs::ParticleEmitter &_emitter)
+    const msgs::ParticleEmitter &_emitterMsg)
 {
   if (!this->dataPtr->scene)
     return rendering::ParticleEmitterPtr();
@@ -1567,8 +1697,13 @@ rendering::ParticleEmitterPtr SceneManager::UpdateParticleEmitter(Entity _id,
   }
   auto emitter = emitterIt->second;
 
+  // Only apply the properties which changed, since applying some of them,
+  // such as the material, is costly even when they're the same
+  const msgs::ParticleEmitter changes = particleEmitterChanges(_emitterMsg,
+      this->dataPtr->particleEmitterStates[_id]);
+
   // Type.
-  switch (_emitter.type())
+  switch (changes.type())
   {
     case ignition::msgs::ParticleEmitter_EmitterType_BOX:
     {
@@ -1592,76 +1727,76 @@ rendering::ParticleEmitterPtr SceneManager::UpdateParticleEmitter(Entity _id,
   }
 
   // Emitter size.
-  if (_emitter.has_size())
-    emitter->SetEmitterSize(ignition::msgs::Convert(_emitter.size()));
+  if (changes.has_size())
+    emitter->SetEmitterSize(ignition::msgs::Convert(changes.size()));
 
   // Rate.
-  if (_emitter.has_rate())
-    emitter->SetRate(_emitter.rate().data());
+  if (changes.has_rate())
+    emitter->SetRate(changes.rate().data());
 
   // Duration.
-  if (_emitter.has_duration())
-    emitter->SetDuration(_emitter.duration().data());
+  if (changes.has_duration())
+    emitter->SetDuration(changes.duration().data());
 
   // Emitting.
-  if (_emitter.has_emitting()) {
-    emitter->SetEmitting(_emitter.emitting().data());
+  if (changes.has_emitting()) {
+    emitter->SetEmitting(changes.emitting().data());
   }
 
   // Particle size.
-  if (_emitter.has_particle_size())
+  if (changes.has_particle_size())
   {
     emitter->SetParticleSize(
-        ignition::msgs::Convert(_emitter.particle_size()));
+        ignition::msgs::Convert(changes.particle_size()));
   }
 
   // Lifetime.
-  if (_emitter.has_lifetime())
-    emitter->SetLifetime(_emitter.lifetime().data());
+  if (changes.has_lifetime())
+    emitter->SetLifetime(changes.lifetime().data());
 
   // Material.
-  if (_emitter.has_material())
+  if (changes.has_material())
   {
     ignition::rendering::MaterialPtr material =
-      this->LoadMaterial(convert<sdf::Material>(_emitter.material()));
+      this->LoadMaterial(convert<sdf::Material>(changes.material()));
     emitter->SetMaterial(material);
   }
 
   // Velocity range.
-  if (_emitter.has_min_velocity() && _emitter.has_max_velocity())
+  if (changes.has_min_velocity() && changes.has_max_velocity())
   {
-    emitter->SetVelocityRange(_emitter.min_velocity().data(),
-        _emitter.max_velocity().data());
+    emitter->SetVelocityRange(changes.min_velocity().data(),
+        changes.max_velocity().data());
   }
 
   // Color range image.
-  if (_emitter.has_color_range_image() &&
-      !_emitter.color_range_image().data().empty())
+  if (changes.has_color_range_image() &&
+      !changes.color_range_image().data().empty())
   {
-    emitter->SetColorRangeImage(_emitter.color_range_image().data());
+    emitter->SetColorRangeImage(changes.color_range_image().data());
   }
   // Color range.
-  else if (_emitter.has_color_start() && _emitter.has_color_end())
+  else if (changes.has_color_start() && changes.has_color_end())
   {
     emitter->SetColorRange(
-      ignition::msgs::Convert(_emitter.color_start()),
-      ignition::msgs::Convert(_emitter.color_end()));
+      ignition::msgs::Convert(changes.color_start()),
+      ignition::msgs::Convert(changes.color_end()));
   }
 
   // Scale rate.
-  if (_emitter.has_scale_rate())
-    emitter->SetScaleRate(_emitter.scale_rate().data());
+  if (changes.has_scale_rate())
+    emitter->SetScaleRate(changes.scale_rate().data());
 
   // pose
-  if (_emitter.has_pose())
-    emitter->SetLocalPose(msgs::Convert(_emitter.pose()));
+  if (changes.has_pose())
+    emitter->SetLocalPose(msgs::Convert(changes.pose()));
 
   // particle scatter ratio
-  if (_emitter.has_header())
+  if (changes.has_header())
   {
-    for (int i = 0; i < _emitter.header().data_size(); ++i)
+    for (int i = 0; i < changes.header().data_size(); ++i)
     {
-      const auto &data = _emitter.header().data(i);
+      const auto &data = changes.header().data(i);
       const std::string key = "particle_scatter_ratio";
       if (data.key() == "particle_scatter_ratio" && data.value_size() > 0)
       {
@@ -1887,9 +2022,8 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorSkeletonTransformsAt(
   {
     auto skel = vIt->second;
     unsigned int animIndex = traj.AnimIndex();
-    std::map<std::string, math::Matrix4d> rawFrames;
-
     double timeSeconds = std::chrono::duration<double>(time).count();
+    bool loop = !noLoop;
 
     if (followTraj)
     {
@@ -1900,30 +2034,24 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorSkeletonTransformsAt(
       // e.g. a person standing that does not move in x direction
       if (traj.Waypoints()->InterpolateX() && !math::equal(distance, 0.0))
       {
-        rawFrames = skel->Animation(animIndex)->PoseAtX(distance,
-                                        skel->RootNode()->Name());
-      }
-      else
-      {
-        rawFrames = skel->Animation(animIndex)->PoseAt(timeSeconds, !noLoop);
+        // Find the time at which the root node reaches the distance, the
+        // same way common::SkeletonAnimation::PoseAtX does, so that the
+        // pose can be sampled by time
+        common::NodeAnimation *rootNode = skel->Animation(animIndex)->
+            NodeAnimationByName(skel->RootNode()->Name());
+        double firstX = rootNode->KeyFrame(0).second.Translation().X();
+        double lastX = rootNode->KeyFrame(
+            rootNode->FrameCount() - 1).second.Translation().X();
+        double x = std::max(distance, firstX);
+        if (lastX > 0.0)
+          x = std::fmod(x, lastX);
+        timeSeconds = rootNode->TimeAtX(x);
+        loop = true;
       }
     }
-    else
-    {
-      rawFrames = skel->Animation(animIndex)->PoseAt(timeSeconds, !noLoop);
-    }
-
-    for (auto pair : rawFrames)
-    {
-      std::string nodeName = pair.first;
-      auto nodeTf = pair.second;
-
-      std::string skinName = skel->NodeNameAnimToSkin(animIndex, nodeName);
-      math::Matrix4d skinTf = skel->AlignTranslation(animIndex, nodeName)
-              * nodeTf * skel->AlignRotation(animIndex, nodeName);
 
-      allFrames[skinName] = skinTf;
-    }
+    allFrames = this->dataPtr->SkinFramesAt(skel, animIndex, timeSeconds,
+        loop);
   }
 
   // correct animation root pose
@@ -1944,6 +2072,18 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorSkeletonTransformsAt(
   return allFrames;
 }
 
+/////////////////////////////////////////////////
+bool SceneManager::Compact()
+{
+  bool compacted = compactMap(this->dataPtr->visuals);
+  compacted = compactMap(this->dataPtr->actors) || compacted;
+  compacted = compactMap(this->dataPtr->actorSkeletons) || compacted;
+  compacted = compactMap(this->dataPtr->actorTrajectories) || compacted;
+  compacted = compactMap(this->dataPtr->lights) || compacted;
+  compacted = compactMap(this->dataPtr->sensors) || compacted;
+  return compacted;
+}
+
 /////////////////////////////////////////////////
 void SceneManager::RemoveEntity(Entity _id)
 {
@@ -1989,6 +2129,7 @@ void SceneManager::RemoveEntity(Entity _id)
     {
       this->dataPtr->scene->DestroyVisual(it->second);
       this->dataPtr->particleEmitters.erase(it);
+      this->dataPtr->particleEmitterStates.erase(_id);
       return;
     }
   }
@@ -2235,6 +2376,42 @@ AnimationUpdateData SceneManagerPrivate::ActorTrajectoryAt(
   return animData;
 }
 
+/////////////////////////////////////////////////
+const std::map<std::string, math::Matrix4d> &SceneManagerPrivate::SkinFramesAt(
+    const common::SkeletonPtr &_skel, unsigned int _animIndex, double _time,
+    bool _loop) const
+{
+  auto anim = _skel->Animation(_animIndex);
+
+  // Bring the time within the animation, so that the number of samples is
+  // bounded by its length
+  double length = anim->Length();
+  if (length > 0.0)
+  {
+    if (_loop)
+      _time = std::fmod(std::max(_time, 0.0), length);
+    else
+      _time = std::clamp(_time, 0.0, length);
+  }
+
+  int64_t sample = std::llround(_time * kAnimationSampleRate);
+  auto key = std::make_tuple(_skel.get(), _animIndex, _loop, sample);
+  auto it = this->skinFrames.find(key);
+  if (it != this->skinFrames.end())
+    return it->second;
+
+  auto &frames = this->skinFrames[key];
+  auto rawFrames = anim->PoseAt(sample / kAnimationSampleRate, _loop);
+  for (const auto &[nodeName, nodeTf] : rawFrames)
+  {
+    std::string skinName = _skel->NodeNameAnimToSkin(_animIndex, nodeName);
+    frames[skinName] = _skel->AlignTranslation(_animIndex, nodeName)
+        * nodeTf * _skel->AlignRotation(_animIndex, nodeName);
+  }
+  return frames;
+}
+
+/////////////////////////////////////////////////
 std::unordered_map<std::string, unsigned int>
 SceneManager::LoadAnimations(const sdf::Actor &_actor)
 {
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_WORLDMODELS_HH_
+#define IGNITION_GAZEBO_SYSTEMS_WORLDMODELS_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <sdf/Element.hh>
+
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+{
+namespace systems
+{
+/// \brief A model handled by a system attached to the world, such as one
+/// of the `<vehicle>` elements of the drive systems.
+struct WorldModelElement
+{
+  /// \brief Name of the model.
+  std::string modelName;
+
+  /// \brief Parameters for the model.
+  sdf::ElementPtr sdf;
+};
+
+/// \brief Get the `_element` children of the SDF of a system attached to
+/// the world. Children without a `<model_name>` are skipped with an error.
+/// \param[in] _sdf SDF of the system.
+/// \param[in] _element Name of the children, such as "vehicle".
+/// \param[in] _system Name of the system, used in errors.
+/// \return The valid children.
+inline std::vector<WorldModelElement> worldModelElements(
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    const std::string &_element, const std::string &_system)
+{
+  std::vector<WorldModelElement> result;
+  auto sdfClone = _sdf->Clone();
+  for (auto elem = sdfClone->FindElement(_element); elem != nullptr;
+       elem = elem->GetNextElement(_element))
+  {
+    auto modelName = elem->Get<std::string>("model_name", "").first;
+    if (modelName.empty())
+    {
+      ignerr << "Each <" << _element << "> of the " << _system
+             << " system requires a <model_name>" << std::endl;
+      continue;
+    }
+    result.push_back({modelName, elem});
+  }
+  return result;
+}
+
+/// \brief Find a model of the world by name. Models may be spawned after
+/// the systems which handle them are loaded, so callers retry on later
+/// steps until it's found.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _world World entity.
+/// \param[in] _name Name of the model.
+/// \return The model entity, or kNullEntity if it doesn't exist yet.
+inline Entity worldModelByName(const EntityComponentManager &_ecm,
+    const Entity _world, const std::string &_name)
+{
+  return _ecm.EntityByComponents(components::Model(), components::Name(_name),
+      components::ParentEntity(_world));
+}
+
+/// \brief Load the models of a list which have been spawned, and remove
+/// them from the list.
+/// \param[in] _ecm Entity component manager.
+/// \param[in] _world World entity.
+/// \param[in, out] _pending Models which haven't been loaded yet.
+/// \param[in] _load Function called with the entity and parameters of each
+/// model which exists.
+template<typename LoadFn>
+void loadSpawnedModels(EntityComponentManager &_ecm, const Entity _world,
+    std::vector<WorldModelElement> &_pending, LoadFn _load)
+{
+  auto it = _pending.begin();
+  while (it != _pending.end())
+  {
+    auto model = worldModelByName(_ecm, _world, it->modelName);
+    if (model == kNullEntity)
+    {
+      ++it;
+      continue;
+    }
+
+    _load(model, it->sdf);
+    it = _pending.erase(it);
+  }
+}
+}
+}
+}
+}
+#endif
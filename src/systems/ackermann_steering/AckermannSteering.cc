@@ -19,6 +19,7 @@
 
 #include <ignition/msgs/odometry.pb.h>
 
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -34,10 +35,13 @@
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/JointPosition.hh"
 #include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Link.hh"
 #include "ignition/gazebo/Model.hh"
 #include "ignition/gazebo/Util.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
@@ -54,8 +58,26 @@ struct Commands
   Commands() : lin(0.0), ang(0.0) {}
 };
 
-class ignition::gazebo::systems::AckermannSteeringPrivate
+/// \brief State of a single vehicle controlled by the system.
+class AckermannSteeringVehicle
 {
+  /// \brief Load the vehicle's parameters and set up its transport.
+  /// \param[in] _model Model entity of the vehicle.
+  /// \param[in] _sdf Parameters of the vehicle.
+  /// \param[in] _ecm The EntityComponentManager.
+  /// \param[in] _node Node used for the vehicle's subscriptions and
+  /// publishers.
+  /// \return True if the vehicle was loaded.
+  public: bool Load(const Entity &_model,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm, transport::Node &_node);
+
+  /// \brief Find the vehicle's joints and set the joint velocities.
+  /// \param[in] _info System update information.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm);
+
   /// \brief Callback for velocity subscription
   /// \param[in] _msg Velocity message
   public: void OnCmdVel(const ignition::msgs::Twist &_msg);
@@ -74,9 +96,6 @@ class ignition::gazebo::systems::AckermannSteeringPrivate
   public: void UpdateVelocity(const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &_ecm);
 
-  /// \brief Ignition communication node.
-  public: transport::Node node;
-
   /// \brief Entity of the left joint
   public: std::vector<Entity> leftJoints;
 
@@ -186,6 +205,26 @@ class ignition::gazebo::systems::AckermannSteeringPrivate
   public: std::string sdfChildFrameId;
 };
 
+class ignition::gazebo::systems::AckermannSteeringPrivate
+{
+  /// \brief Load the vehicles whose models have been spawned.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void LoadPendingVehicles(EntityComponentManager &_ecm);
+
+  /// \brief Ignition communication node.
+  public: transport::Node node;
+
+  /// \brief Vehicles controlled by the system. They're held by pointer
+  /// because transport callbacks are bound to them.
+  public: std::vector<std::unique_ptr<AckermannSteeringVehicle>> vehicles;
+
+  /// \brief Vehicles which are waiting for their model to be spawned.
+  public: std::vector<WorldModelElement> pendingVehicles;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity world{kNullEntity};
+};
+
 //////////////////////////////////////////////////
 AckermannSteering::AckermannSteering()
   : dataPtr(std::make_unique<AckermannSteeringPrivate>())
@@ -193,25 +232,24 @@ AckermannSteering::AckermannSteering()
 }
 
 //////////////////////////////////////////////////
-void AckermannSteering::Configure(const Entity &_entity,
+bool AckermannSteeringVehicle::Load(const Entity &_model,
     const std::shared_ptr<const sdf::Element> &_sdf,
-    EntityComponentManager &_ecm,
-    EventManager &/*_eventMgr*/)
+    EntityComponentManager &_ecm, transport::Node &_node)
 {
-  this->dataPtr->model = Model(_entity);
+  this->model = Model(_model);
 
-  if (!this->dataPtr->model.Valid(_ecm))
+  if (!this->model.Valid(_ecm))
   {
     ignerr << "AckermannSteering plugin should be attached to a model entity. "
            << "Failed to initialize." << std::endl;
-    return;
+    return false;
   }
 
   // Get the canonical link
   std::vector<Entity> links = _ecm.ChildrenByComponents(
-      this->dataPtr->model.Entity(), components::CanonicalLink());
+      this->model.Entity(), components::CanonicalLink());
   if (!links.empty())
-    this->dataPtr->canonicalLink = Link(links[0]);
+    this->canonicalLink = Link(links[0]);
 
   // Ugly, but needed because the sdf::Element::GetElement is not a const
   // function and _sdf is a const shared pointer to a const sdf::Element.
@@ -221,81 +259,81 @@ void AckermannSteering::Configure(const Entity &_entity,
   sdf::ElementPtr sdfElem = ptr->GetElement("left_joint");
   while (sdfElem)
   {
-    this->dataPtr->leftJointNames.push_back(sdfElem->Get<std::string>());
+    this->leftJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("left_joint");
   }
   sdfElem = ptr->GetElement("right_joint");
   while (sdfElem)
   {
-    this->dataPtr->rightJointNames.push_back(sdfElem->Get<std::string>());
+    this->rightJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("right_joint");
   }
   sdfElem = ptr->GetElement("left_steering_joint");
   while (sdfElem)
   {
-    this->dataPtr->leftSteeringJointNames.push_back(
+    this->leftSteeringJointNames.push_back(
                           sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("left_steering_joint");
   }
   sdfElem = ptr->GetElement("right_steering_joint");
   while (sdfElem)
   {
-    this->dataPtr->rightSteeringJointNames.push_back(
+    this->rightSteeringJointNames.push_back(
                            sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("right_steering_joint");
   }
 
-  this->dataPtr->wheelSeparation = _sdf->Get<double>("wheel_separation",
-      this->dataPtr->wheelSeparation).first;
-  this->dataPtr->kingpinWidth = _sdf->Get<double>("kingpin_width",
-      this->dataPtr->kingpinWidth).first;
-  this->dataPtr->wheelBase = _sdf->Get<double>("wheel_base",
-      this->dataPtr->wheelBase).first;
-  this->dataPtr->steeringLimit = _sdf->Get<double>("steering_limit",
-      this->dataPtr->steeringLimit).first;
-  this->dataPtr->wheelRadius = _sdf->Get<double>("wheel_radius",
-      this->dataPtr->wheelRadius).first;
+  this->wheelSeparation = _sdf->Get<double>("wheel_separation",
+      this->wheelSeparation).first;
+  this->kingpinWidth = _sdf->Get<double>("kingpin_width",
+      this->kingpinWidth).first;
+  this->wheelBase = _sdf->Get<double>("wheel_base",
+      this->wheelBase).first;
+  this->steeringLimit = _sdf->Get<double>("steering_limit",
+      this->steeringLimit).first;
+  this->wheelRadius = _sdf->Get<double>("wheel_radius",
+      this->wheelRadius).first;
 
   // Instantiate the speed limiters.
-  this->dataPtr->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
-  this->dataPtr->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
 
   // Parse speed limiter parameters.
   if (_sdf->HasElement("min_velocity"))
   {
     const double minVel = _sdf->Get<double>("min_velocity");
-    this->dataPtr->limiterLin->SetMinVelocity(minVel);
-    this->dataPtr->limiterAng->SetMinVelocity(minVel);
+    this->limiterLin->SetMinVelocity(minVel);
+    this->limiterAng->SetMinVelocity(minVel);
   }
   if (_sdf->HasElement("max_velocity"))
   {
     const double maxVel = _sdf->Get<double>("max_velocity");
-    this->dataPtr->limiterLin->SetMaxVelocity(maxVel);
-    this->dataPtr->limiterAng->SetMaxVelocity(maxVel);
+    this->limiterLin->SetMaxVelocity(maxVel);
+    this->limiterAng->SetMaxVelocity(maxVel);
   }
   if (_sdf->HasElement("min_acceleration"))
   {
     const double minAccel = _sdf->Get<double>("min_acceleration");
-    this->dataPtr->limiterLin->SetMinAcceleration(minAccel);
-    this->dataPtr->limiterAng->SetMinAcceleration(minAccel);
+    this->limiterLin->SetMinAcceleration(minAccel);
+    this->limiterAng->SetMinAcceleration(minAccel);
   }
   if (_sdf->HasElement("max_acceleration"))
   {
     const double maxAccel = _sdf->Get<double>("max_acceleration");
-    this->dataPtr->limiterLin->SetMaxAcceleration(maxAccel);
-    this->dataPtr->limiterAng->SetMaxAcceleration(maxAccel);
+    this->limiterLin->SetMaxAcceleration(maxAccel);
+    this->limiterAng->SetMaxAcceleration(maxAccel);
   }
   if (_sdf->HasElement("min_jerk"))
   {
     const double minJerk = _sdf->Get<double>("min_jerk");
-    this->dataPtr->limiterLin->SetMinJerk(minJerk);
-    this->dataPtr->limiterAng->SetMinJerk(minJerk);
+    this->limiterLin->SetMinJerk(minJerk);
+    this->limiterAng->SetMinJerk(minJerk);
   }
   if (_sdf->HasElement("max_jerk"))
   {
     const double maxJerk = _sdf->Get<double>("max_jerk");
-    this->dataPtr->limiterLin->SetMaxJerk(maxJerk);
-    this->dataPtr->limiterAng->SetMaxJerk(maxJerk);
+    this->limiterLin->SetMaxJerk(maxJerk);
+    this->limiterAng->SetMaxJerk(maxJerk);
   }
 
 
@@ -303,7 +341,7 @@ void AckermannSteering::Configure(const Entity &_entity,
   if (odomFreq > 0)
   {
     std::chrono::duration<double> odomPer{1 / odomFreq};
-    this->dataPtr->odomPubPeriod =
+    this->odomPubPeriod =
       std::chrono::duration_cast<std::chrono::steady_clock::duration>(odomPer);
   }
 
@@ -313,74 +351,63 @@ void AckermannSteering::Configure(const Entity &_entity,
   {
     topics.push_back(_sdf->Get<std::string>("topic"));
   }
-  topics.push_back("/model/" + this->dataPtr->model.Name(_ecm) + "/cmd_vel");
+  topics.push_back("/model/" + this->model.Name(_ecm) + "/cmd_vel");
   auto topic = validTopic(topics);
   if (topic.empty())
   {
     ignerr << "AckermannSteering plugin received invalid model name "
            << "Failed to initialize." << std::endl;
-    return;
+    return false;
   }
 
-  this->dataPtr->node.Subscribe(topic, &AckermannSteeringPrivate::OnCmdVel,
-      this->dataPtr.get());
+  _node.Subscribe(topic, &AckermannSteeringVehicle::OnCmdVel, this);
 
   std::vector<std::string> odomTopics;
   if (_sdf->HasElement("odom_topic"))
   {
     odomTopics.push_back(_sdf->Get<std::string>("odom_topic"));
   }
-  odomTopics.push_back("/model/" + this->dataPtr->model.Name(_ecm) +
+  odomTopics.push_back("/model/" + this->model.Name(_ecm) +
       "/odometry");
   auto odomTopic = validTopic(odomTopics);
   if (topic.empty())
   {
     ignerr << "AckermannSteering plugin received invalid model name "
            << "Failed to initialize." << std::endl;
-    return;
+    return false;
   }
 
-  this->dataPtr->odomPub = this->dataPtr->node.Advertise<msgs::Odometry>(
-      odomTopic);
+  this->odomPub = _node.Advertise<msgs::Odometry>(odomTopic);
 
   if (_sdf->HasElement("frame_id"))
-    this->dataPtr->sdfFrameId = _sdf->Get<std::string>("frame_id");
+    this->sdfFrameId = _sdf->Get<std::string>("frame_id");
 
   if (_sdf->HasElement("child_frame_id"))
-    this->dataPtr->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
+    this->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
 
   ignmsg << "AckermannSteering subscribing to twist messages on [" <<
       topic << "]" << std::endl;
+  return true;
 }
 
 //////////////////////////////////////////////////
-void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
-    ignition::gazebo::EntityComponentManager &_ecm)
+void AckermannSteeringVehicle::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("AckermannSteering::PreUpdate");
-
-  // \TODO(anyone) Support rewind
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
-  {
-    ignwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
-  }
-
   // If the joints haven't been identified yet, look for them
   static std::set<std::string> warnedModels;
-  auto modelName = this->dataPtr->model.Name(_ecm);
-  if (this->dataPtr->leftJoints.empty() ||
-      this->dataPtr->rightJoints.empty() ||
-      this->dataPtr->leftSteeringJoints.empty() ||
-      this->dataPtr->rightSteeringJoints.empty())
+  auto modelName = this->model.Name(_ecm);
+  if (this->leftJoints.empty() ||
+      this->rightJoints.empty() ||
+      this->leftSteeringJoints.empty() ||
+      this->rightSteeringJoints.empty())
   {
     bool warned{false};
-    for (const std::string &name : this->dataPtr->leftJointNames)
+    for (const std::string &name : this->leftJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->leftJoints.push_back(joint);
+        this->leftJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find left joint [" << name << "] for model ["
@@ -389,11 +416,11 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->rightJointNames)
+    for (const std::string &name : this->rightJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->rightJoints.push_back(joint);
+        this->rightJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find right joint [" << name << "] for model ["
@@ -401,11 +428,11 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
         warned = true;
       }
     }
-    for (const std::string &name : this->dataPtr->leftSteeringJointNames)
+    for (const std::string &name : this->leftSteeringJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->leftSteeringJoints.push_back(joint);
+        this->leftSteeringJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find left steering joint ["
@@ -415,11 +442,11 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->rightSteeringJointNames)
+    for (const std::string &name : this->rightSteeringJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->rightSteeringJoints.push_back(joint);
+        this->rightSteeringJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find right steering joint [" <<
@@ -433,9 +460,9 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     }
   }
 
-  if (this->dataPtr->leftJoints.empty() || this->dataPtr->rightJoints.empty() ||
-      this->dataPtr->leftSteeringJoints.empty() ||
-      this->dataPtr->rightSteeringJoints.empty())
+  if (this->leftJoints.empty() || this->rightJoints.empty() ||
+      this->leftSteeringJoints.empty() ||
+      this->rightSteeringJoints.empty())
     return;
 
   if (warnedModels.find(modelName) != warnedModels.end())
@@ -449,7 +476,7 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  for (Entity joint : this->dataPtr->leftJoints)
+  for (Entity joint : this->leftJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -457,15 +484,15 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(
-          joint, components::JointVelocityCmd({this->dataPtr->leftJointSpeed}));
+          joint, components::JointVelocityCmd({this->leftJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->leftJointSpeed});
+      *vel = components::JointVelocityCmd({this->leftJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->rightJoints)
+  for (Entity joint : this->rightJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -473,16 +500,16 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->rightJointSpeed}));
+          components::JointVelocityCmd({this->rightJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->rightJointSpeed});
+      *vel = components::JointVelocityCmd({this->rightJointSpeed});
     }
   }
 
   // Update steering
-  for (Entity joint : this->dataPtr->leftSteeringJoints)
+  for (Entity joint : this->leftSteeringJoints)
   {
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
 
@@ -490,16 +517,16 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     {
       _ecm.CreateComponent(
           joint, components::JointVelocityCmd(
-                             {this->dataPtr->leftSteeringJointSpeed}));
+                             {this->leftSteeringJointSpeed}));
     }
     else
     {
       *vel = components::JointVelocityCmd(
-                         {this->dataPtr->leftSteeringJointSpeed});
+                         {this->leftSteeringJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->rightSteeringJoints)
+  for (Entity joint : this->rightSteeringJoints)
   {
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
 
@@ -507,50 +534,107 @@ void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     {
       _ecm.CreateComponent(joint,
           components::JointVelocityCmd(
-                  {this->dataPtr->rightSteeringJointSpeed}));
+                  {this->rightSteeringJointSpeed}));
     }
     else
     {
       *vel = components::JointVelocityCmd(
-                     {this->dataPtr->rightSteeringJointSpeed});
+                     {this->rightSteeringJointSpeed});
     }
   }
 
   // Create the left and right side joint position components if they
   // don't exist.
   auto leftPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->leftJoints[0]);
+      this->leftJoints[0]);
   if (!leftPos)
   {
-    _ecm.CreateComponent(this->dataPtr->leftJoints[0],
+    _ecm.CreateComponent(this->leftJoints[0],
         components::JointPosition());
   }
 
   auto rightPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->rightJoints[0]);
+      this->rightJoints[0]);
   if (!rightPos)
   {
-    _ecm.CreateComponent(this->dataPtr->rightJoints[0],
+    _ecm.CreateComponent(this->rightJoints[0],
         components::JointPosition());
   }
 
   auto leftSteeringPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->leftSteeringJoints[0]);
+      this->leftSteeringJoints[0]);
   if (!leftSteeringPos)
   {
-    _ecm.CreateComponent(this->dataPtr->leftSteeringJoints[0],
+    _ecm.CreateComponent(this->leftSteeringJoints[0],
         components::JointPosition());
   }
 
   auto rightSteeringPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->rightSteeringJoints[0]);
+      this->rightSteeringJoints[0]);
   if (!rightSteeringPos)
   {
-    _ecm.CreateComponent(this->dataPtr->rightSteeringJoints[0],
+    _ecm.CreateComponent(this->rightSteeringJoints[0],
         components::JointPosition());
   }
 }
 
+//////////////////////////////////////////////////
+void AckermannSteering::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  // When attached to the world, the system controls every <vehicle>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->world = _entity;
+    this->dataPtr->pendingVehicles = worldModelElements(_sdf, "vehicle",
+        "AckermannSteering");
+    this->dataPtr->LoadPendingVehicles(_ecm);
+    return;
+  }
+
+  auto vehicle = std::make_unique<AckermannSteeringVehicle>();
+  if (vehicle->Load(_entity, _sdf, _ecm, this->dataPtr->node))
+    this->dataPtr->vehicles.push_back(std::move(vehicle));
+}
+
+//////////////////////////////////////////////////
+void AckermannSteeringPrivate::LoadPendingVehicles(
+    EntityComponentManager &_ecm)
+{
+  loadSpawnedModels(_ecm, this->world, this->pendingVehicles,
+      [&](const Entity &_model, const sdf::ElementPtr &_sdf)
+      {
+        auto vehicle = std::make_unique<AckermannSteeringVehicle>();
+        if (vehicle->Load(_model, _sdf, _ecm, this->node))
+          this->vehicles.push_back(std::move(vehicle));
+      });
+}
+
+//////////////////////////////////////////////////
+void AckermannSteering::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
+    ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("AckermannSteering::PreUpdate");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // When attached to the world, models may be spawned after the system is
+  // loaded
+  if (!this->dataPtr->pendingVehicles.empty())
+    this->dataPtr->LoadPendingVehicles(_ecm);
+
+  for (auto &vehicle : this->dataPtr->vehicles)
+    vehicle->PreUpdate(_info, _ecm);
+}
+
 //////////////////////////////////////////////////
 void AckermannSteering::PostUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
@@ -560,12 +644,15 @@ void AckermannSteering::PostUpdate(const UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  this->dataPtr->UpdateVelocity(_info, _ecm);
-  this->dataPtr->UpdateOdometry(_info, _ecm);
+  for (auto &vehicle : this->dataPtr->vehicles)
+  {
+    vehicle->UpdateVelocity(_info, _ecm);
+    vehicle->UpdateOdometry(_info, _ecm);
+  }
 }
 
 //////////////////////////////////////////////////
-void AckermannSteeringPrivate::UpdateOdometry(
+void AckermannSteeringVehicle::UpdateOdometry(
     const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &_ecm)
 {
@@ -672,7 +759,7 @@ void AckermannSteeringPrivate::UpdateOdometry(
 }
 
 //////////////////////////////////////////////////
-void AckermannSteeringPrivate::UpdateVelocity(
+void AckermannSteeringVehicle::UpdateVelocity(
     const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &_ecm)
 {
@@ -752,7 +839,7 @@ void AckermannSteeringPrivate::UpdateVelocity(
 }
 
 //////////////////////////////////////////////////
-void AckermannSteeringPrivate::OnCmdVel(const msgs::Twist &_msg)
+void AckermannSteeringVehicle::OnCmdVel(const msgs::Twist &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
   this->targetVel = _msg;
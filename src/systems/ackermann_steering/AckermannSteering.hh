@@ -94,6 +94,17 @@ namespace systems
   /// of left_joint, right_joint, left_steering_joint and
   /// right_steering_joint
   ///
+  /// When attached to a world instead of a model, a single instance of the
+  /// system controls a whole fleet of vehicles, which are all updated in
+  /// one pass, instead of loading one system per vehicle. Each vehicle is
+  /// described by a `<vehicle>` element, which takes all the parameters
+  /// above plus:
+  ///
+  /// `<model_name>`: Name of the top level model of the vehicle.
+  ///
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned.
+  ///
   /// References:
   /// https://github.com/ignitionrobotics/ign-gazebo/tree/main/src/systems/diff_drive
   /// https://www.auto.tuwien.ac.at/bib/pdf_TR/TR0183.pdf
@@ -81,8 +81,10 @@ class ignition::gazebo::systems::AirPressurePrivate
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
   /// \brief Update air pressure sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateAirPressures(const EntityComponentManager &_ecm);
+  public: void UpdateAirPressures(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove air pressure sensors if their entities have been removed
   /// from simulation.
@@ -140,31 +142,8 @@ void AirPressure::PostUpdate(const UpdateInfo &_info,
 
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the AirPressurePrivate::UpdatePressures function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->UpdateAirPressures(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update measurement time
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->UpdateAirPressures(_info, _ecm);
   }
 
   this->dataPtr->RemoveAirPressureEntities(_ecm);
@@ -246,7 +225,8 @@ void AirPressurePrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void AirPressurePrivate::UpdateAirPressures(const EntityComponentManager &_ecm)
+void AirPressurePrivate::UpdateAirPressures(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("AirPressurePrivate::UpdateAirPressures");
   _ecm.Each<components::AirPressureSensor, components::WorldPose>(
@@ -257,8 +237,17 @@ void AirPressurePrivate::UpdateAirPressures(const EntityComponentManager &_ecm)
         auto it = this->entitySensorMap.find(_entity);
         if (it != this->entitySensorMap.end())
         {
+          // Skip sensors which aren't due or have no subscribers
+          if (it->second->NextDataUpdateTime() > _info.simTime ||
+              !it->second->HasConnections())
+          {
+            return true;
+          }
+
           const math::Pose3d &worldPose = _worldPose->Data();
           it->second->SetPose(worldPose);
+
+          it->second->sensors::Sensor::Update(_info.simTime, false);
         }
         else
         {
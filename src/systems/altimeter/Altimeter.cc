@@ -83,8 +83,10 @@ class ignition::gazebo::systems::AltimeterPrivate
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
   /// \brief Update altimeter sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateAltimeters(const EntityComponentManager &_ecm);
+  public: void UpdateAltimeters(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove altimeter sensors if their entities have been removed from
   /// simulation.
@@ -141,31 +143,8 @@ void Altimeter::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the AltimeterPrivate::UpdateAltimeters function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->UpdateAltimeters(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update measurement time
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->UpdateAltimeters(_info, _ecm);
   }
 
   this->dataPtr->RemoveAltimeterEntities(_ecm);
@@ -248,7 +227,8 @@ void AltimeterPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void AltimeterPrivate::UpdateAltimeters(const EntityComponentManager &_ecm)
+void AltimeterPrivate::UpdateAltimeters(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("Altimeter::UpdateAltimeters");
   _ecm.Each<components::Altimeter, components::WorldPose,
@@ -261,10 +241,19 @@ void AltimeterPrivate::UpdateAltimeters(const EntityComponentManager &_ecm)
         auto it = this->entitySensorMap.find(_entity);
         if (it != this->entitySensorMap.end())
         {
+          // Skip sensors which aren't due or have no subscribers
+          if (it->second->NextDataUpdateTime() > _info.simTime ||
+              !it->second->HasConnections())
+          {
+            return true;
+          }
+
           math::Vector3d linearVel;
           math::Pose3d worldPose = _worldPose->Data();
           it->second->SetPosition(worldPose.Pos().Z());
           it->second->SetVerticalVelocity(_worldLinearVel->Data().Z());
+
+          it->second->sensors::Sensor::Update(_info.simTime, false);
         }
         else
         {
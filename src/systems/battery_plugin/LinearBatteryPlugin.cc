@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <deque>
 #include <functional>
 #include <string>
@@ -48,12 +50,47 @@
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Model.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
-class ignition::gazebo::systems::LinearBatteryPluginPrivate
+/// \brief State of a single battery simulated by the system.
+class LinearBattery
 {
+  /// \brief Destructor
+  public: ~LinearBattery();
+
+  /// \brief Load the battery's parameters, create its entity and set up its
+  /// transport.
+  /// \param[in] _entity Model entity which holds the battery.
+  /// \param[in] _sdf Parameters of the battery.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _node Node used for the battery's services, subscriptions
+  /// and publishers.
+  public: void Load(const Entity &_entity,
+              const std::shared_ptr<const sdf::Element> &_sdf,
+              EntityComponentManager &_ecm, transport::Node &_node);
+
+  /// \brief Check whether the battery should start draining.
+  /// \param[in] _ecm Entity component manager.
+  public: void PreUpdate(const EntityComponentManager &_ecm);
+
+  /// \brief Integrate the battery's charge, if it's due.
+  /// \param[in] _info Update information.
+  /// \param[in] _ecm Entity component manager.
+  public: void Update(const UpdateInfo &_info, EntityComponentManager &_ecm);
+
+  /// \brief Publish the battery's state, if it's due.
+  /// \param[in] _info Update information.
+  public: void PostUpdate(const UpdateInfo &_info);
+
+  /// \brief Callback for Battery Update events.
+  /// \param[in] _battery Pointer to the battery that is to be updated.
+  /// \return The new voltage.
+  public: double OnUpdateVoltage(const common::Battery *_battery);
+
   /// \brief Reset the plugin
   public: void Reset();
 
@@ -61,6 +98,10 @@ class ignition::gazebo::systems::LinearBatteryPluginPrivate
   /// \return State of charge of the battery in range [0.0, 1.0].
   public: double StateOfCharge() const;
 
+  /// \brief Get the current power supply status of the battery.
+  /// \return Power supply status.
+  public: msgs::BatteryState::PowerSupplyStatus PowerSupplyStatus() const;
+
   /// \brief Callback executed to start recharging.
   /// \param[in] _req This value should be true.
   public: void OnEnableRecharge(const ignition::msgs::Boolean &_req);
@@ -89,7 +130,7 @@ class ignition::gazebo::systems::LinearBatteryPluginPrivate
 
   /// \brief Battery consumer identifier.
   /// Current implementation limits one consumer (Model) per battery.
-  public: int32_t consumerId;
+  public: int32_t consumerId{-1};
 
   /// \brief Battery entity
   public: Entity batteryEntity{kNullEntity};
@@ -157,47 +198,134 @@ class ignition::gazebo::systems::LinearBatteryPluginPrivate
   /// \brief Model interface
   public: Model model{kNullEntity};
 
-  /// \brief Ignition communication node
-  public: transport::Node node;
-
   /// \brief Battery state of charge message publisher
   public: transport::Node::Publisher statePub;
 
   /// \brief Whether a topic has received any battery-draining command.
   public: bool startDrainingFromTopics = false;
+
+  /// \brief Period at which the charge is integrated, zero to integrate it
+  /// on every iteration.
+  public: std::chrono::steady_clock::duration updatePeriod{0};
+
+  /// \brief Simulation time spent draining or charging which hasn't been
+  /// integrated yet.
+  public: std::chrono::steady_clock::duration pendingTime{0};
+
+  /// \brief Period at which the state is published, zero to publish it on
+  /// every iteration.
+  public: std::chrono::steady_clock::duration publishPeriod{0};
+
+  /// \brief Last time the state was published.
+  public: std::chrono::steady_clock::duration lastPubTime{0};
+
+  /// \brief Power supply status in the last published state.
+  public: msgs::BatteryState::PowerSupplyStatus lastPubStatus{
+      msgs::BatteryState::UNKNOWN};
+
+  /// \brief Whether the battery was drained in the last published state.
+  public: bool lastPubDrained{false};
+
+  /// \brief Whether the state of charge held by the battery's component is
+  /// above zero. The component is only marked as changed when this flips,
+  /// which is all that consumers such as the Sensors system check for.
+  public: bool componentHasCharge{true};
+
+  /// \brief Battery state message, kept as a member to reuse its memory.
+  public: msgs::BatteryState stateMsg;
 };
 
-/////////////////////////////////////////////////
-LinearBatteryPlugin::LinearBatteryPlugin()
-    : System(), dataPtr(std::make_unique<LinearBatteryPluginPrivate>())
+class ignition::gazebo::systems::LinearBatteryPluginPrivate
 {
-}
+  /// \brief Load the batteries whose models have been spawned.
+  /// \param[in] _ecm Entity component manager.
+  public: void LoadPendingBatteries(EntityComponentManager &_ecm);
+
+  /// \brief Batteries simulated by the system. They're held by pointer
+  /// because transport callbacks are bound to them.
+  public: std::vector<std::unique_ptr<LinearBattery>> batteries;
+
+  /// \brief Batteries which are waiting for their model to be spawned.
+  public: std::vector<WorldModelElement> pendingBatteries;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity world{kNullEntity};
+
+  /// \brief Ignition communication node. It's declared after the batteries
+  /// so that its callbacks stop before the batteries are destroyed.
+  public: transport::Node node;
+};
 
 /////////////////////////////////////////////////
-LinearBatteryPlugin::~LinearBatteryPlugin()
+LinearBattery::~LinearBattery()
 {
-  this->dataPtr->Reset();
+  this->Reset();
 
-  if (this->dataPtr->battery)
+  if (this->battery)
   {
     // Consumer-specific
-    if (this->dataPtr->consumerId != -1)
+    if (this->consumerId != -1)
     {
-      this->dataPtr->battery->RemoveConsumer(this->dataPtr->consumerId);
+      this->battery->RemoveConsumer(this->consumerId);
     }
 
     // This is needed so that common::Battery stops calling the update function
     //   of this object, when this object is destroyed. Else seg fault in test,
     //   though no seg fault in actual run.
-    this->dataPtr->battery->ResetUpdateFunc();
+    this->battery->ResetUpdateFunc();
   }
 }
 
+/////////////////////////////////////////////////
+LinearBatteryPlugin::LinearBatteryPlugin()
+    : System(), dataPtr(std::make_unique<LinearBatteryPluginPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+LinearBatteryPlugin::~LinearBatteryPlugin() = default;
+
 /////////////////////////////////////////////////
 void LinearBatteryPlugin::Configure(const Entity &_entity,
                const std::shared_ptr<const sdf::Element> &_sdf,
                EntityComponentManager &_ecm,
                EventManager &/*_eventMgr*/)
+{
+  // When attached to the world, the system simulates every <battery>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->world = _entity;
+
+    this->dataPtr->pendingBatteries = worldModelElements(_sdf, "battery",
+        "LinearBatteryPlugin");
+    this->dataPtr->LoadPendingBatteries(_ecm);
+    return;
+  }
+
+  // Batteries which fail to load part of their parameters are kept, as they
+  // may still be able to drain
+  auto battery = std::make_unique<LinearBattery>();
+  battery->Load(_entity, _sdf, _ecm, this->dataPtr->node);
+  this->dataPtr->batteries.push_back(std::move(battery));
+}
+
+//////////////////////////////////////////////////
+void LinearBatteryPluginPrivate::LoadPendingBatteries(
+    EntityComponentManager &_ecm)
+{
+  loadSpawnedModels(_ecm, this->world, this->pendingBatteries,
+      [&](const Entity &_model, const sdf::ElementPtr &_sdf)
+      {
+        auto battery = std::make_unique<LinearBattery>();
+        battery->Load(_model, _sdf, _ecm, this->node);
+        this->batteries.push_back(std::move(battery));
+      });
+}
+
+/////////////////////////////////////////////////
+void LinearBattery::Load(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm, transport::Node &_node)
 {
   // Store the pointer to the model this battery is under
   auto model = Model(_entity);
@@ -207,58 +335,58 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
            << "Failed to initialize." << std::endl;
     return;
   }
-  this->dataPtr->model = model;
-  this->dataPtr->modelName = model.Name(_ecm);
+  this->model = model;
+  this->modelName = model.Name(_ecm);
 
   if (_sdf->HasElement("open_circuit_voltage_constant_coef"))
-    this->dataPtr->e0 = _sdf->Get<double>("open_circuit_voltage_constant_coef");
+    this->e0 = _sdf->Get<double>("open_circuit_voltage_constant_coef");
 
   if (_sdf->HasElement("open_circuit_voltage_linear_coef"))
-    this->dataPtr->e1 = _sdf->Get<double>("open_circuit_voltage_linear_coef");
+    this->e1 = _sdf->Get<double>("open_circuit_voltage_linear_coef");
 
   if (_sdf->HasElement("capacity"))
-    this->dataPtr->c = _sdf->Get<double>("capacity");
+    this->c = _sdf->Get<double>("capacity");
 
-  if (this->dataPtr->c <= 0)
+  if (this->c <= 0)
   {
     ignerr << "No <capacity> or incorrect value specified. Capacity should be "
            << "greater than 0.\n";
     return;
   }
 
-  this->dataPtr->q0 = this->dataPtr->c;
+  this->q0 = this->c;
   if (_sdf->HasElement("initial_charge"))
   {
-    this->dataPtr->q0 = _sdf->Get<double>("initial_charge");
-    if (this->dataPtr->q0 > this->dataPtr->c || this->dataPtr->q0 < 0)
+    this->q0 = _sdf->Get<double>("initial_charge");
+    if (this->q0 > this->c || this->q0 < 0)
     {
       ignerr << "<initial_charge> value should be between [0, <capacity>]."
              << std::endl;
-      this->dataPtr->q0 =
-        std::max(0.0, std::min(this->dataPtr->q0, this->dataPtr->c));
-      ignerr << "Setting <initial_charge> to [" << this->dataPtr->q0
+      this->q0 =
+        std::max(0.0, std::min(this->q0, this->c));
+      ignerr << "Setting <initial_charge> to [" << this->q0
              << "] instead." << std::endl;
     }
   }
 
-  this->dataPtr->q = this->dataPtr->q0;
+  this->q = this->q0;
 
   if (_sdf->HasElement("resistance"))
-    this->dataPtr->r = _sdf->Get<double>("resistance");
+    this->r = _sdf->Get<double>("resistance");
 
   if (_sdf->HasElement("smooth_current_tau"))
   {
-    this->dataPtr->tau = _sdf->Get<double>("smooth_current_tau");
-    if (this->dataPtr->tau <= 0)
+    this->tau = _sdf->Get<double>("smooth_current_tau");
+    if (this->tau <= 0)
     {
       ignerr << "<smooth_current_tau> value should be positive. "
              << "Using [1] instead." << std::endl;
-      this->dataPtr->tau = 1;
+      this->tau = 1;
     }
   }
 
   if (_sdf->HasElement("fix_issue_225"))
-    this->dataPtr->fixIssue225 = _sdf->Get<bool>("fix_issue_225");
+    this->fixIssue225 = _sdf->Get<bool>("fix_issue_225");
 
   if (_sdf->HasElement("battery_name") && _sdf->HasElement("voltage"))
   {
@@ -266,20 +394,20 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     auto initVoltage = _sdf->Get<double>("voltage");
 
     // Create battery entity and component
-    this->dataPtr->batteryEntity = _ecm.CreateEntity();
+    this->batteryEntity = _ecm.CreateEntity();
     // Initialize with initial voltage
-    _ecm.CreateComponent(this->dataPtr->batteryEntity,
-      components::BatterySoC(this->dataPtr->soc));
-    _ecm.CreateComponent(this->dataPtr->batteryEntity, components::Name(
+    _ecm.CreateComponent(this->batteryEntity,
+      components::BatterySoC(this->soc));
+    _ecm.CreateComponent(this->batteryEntity, components::Name(
       batteryName));
-    _ecm.SetParentEntity(this->dataPtr->batteryEntity, _entity);
+    _ecm.SetParentEntity(this->batteryEntity, _entity);
 
     // Create actual battery and assign update function
-    this->dataPtr->battery = std::make_shared<common::Battery>(batteryName,
+    this->battery = std::make_shared<common::Battery>(batteryName,
       initVoltage);
-    this->dataPtr->battery->Init();
-    this->dataPtr->battery->SetUpdateFunc(
-      std::bind(&LinearBatteryPlugin::OnUpdateVoltage, this,
+    this->battery->Init();
+    this->battery->SetUpdateFunc(
+      std::bind(&LinearBattery::OnUpdateVoltage, this,
         std::placeholders::_1));
   }
   else
@@ -294,7 +422,7 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     if (isCharging)
     {
       if (_sdf->HasElement("charging_time"))
-        this->dataPtr->tCharge = _sdf->Get<double>("charging_time");
+        this->tCharge = _sdf->Get<double>("charging_time");
       else
       {
         ignerr << "No <charging_time> specified. "
@@ -302,10 +430,10 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
         return;
       }
 
-      std::string enableRechargeTopic = "/model/" + this->dataPtr->modelName +
+      std::string enableRechargeTopic = "/model/" + this->modelName +
         "/battery/" + _sdf->Get<std::string>("battery_name") +
         "/recharge/start";
-      std::string disableRechargeTopic = "/model/" + this->dataPtr->modelName +
+      std::string disableRechargeTopic = "/model/" + this->modelName +
         "/battery/" + _sdf->Get<std::string>("battery_name") +
         "/recharge/stop";
 
@@ -321,17 +449,17 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
         return;
       }
 
-      this->dataPtr->node.Advertise(validEnableRechargeTopic,
-        &LinearBatteryPluginPrivate::OnEnableRecharge, this->dataPtr.get());
-      this->dataPtr->node.Advertise(validDisableRechargeTopic,
-        &LinearBatteryPluginPrivate::OnDisableRecharge, this->dataPtr.get());
+      _node.Advertise(validEnableRechargeTopic,
+        &LinearBattery::OnEnableRecharge, this);
+      _node.Advertise(validDisableRechargeTopic,
+        &LinearBattery::OnDisableRecharge, this);
 
       if (_sdf->HasElement("recharge_by_topic"))
       {
-        this->dataPtr->node.Subscribe(validEnableRechargeTopic,
-          &LinearBatteryPluginPrivate::OnEnableRecharge, this->dataPtr.get());
-        this->dataPtr->node.Subscribe(validDisableRechargeTopic,
-          &LinearBatteryPluginPrivate::OnDisableRecharge, this->dataPtr.get());
+        _node.Subscribe(validEnableRechargeTopic,
+          &LinearBattery::OnEnableRecharge, this);
+        _node.Subscribe(validDisableRechargeTopic,
+          &LinearBattery::OnDisableRecharge, this);
       }
     }
   }
@@ -340,9 +468,9 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
   if (_sdf->HasElement("power_load"))
   {
     auto powerLoad = _sdf->Get<double>("power_load");
-    this->dataPtr->consumerId = this->dataPtr->battery->AddConsumer();
-    bool success = this->dataPtr->battery->SetPowerLoad(
-      this->dataPtr->consumerId, powerLoad);
+    this->consumerId = this->battery->AddConsumer();
+    bool success = this->battery->SetPowerLoad(
+      this->consumerId, powerLoad);
     if (!success)
       ignerr << "Failed to set consumer power load." << std::endl;
   }
@@ -359,9 +487,9 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     while (sdfElem)
     {
       const auto &topic = sdfElem->Get<std::string>();
-      this->dataPtr->node.SubscribeRaw(topic,
-          std::bind(&LinearBatteryPluginPrivate::OnBatteryDrainingMsg,
-          this->dataPtr.get(), std::placeholders::_1, std::placeholders::_2,
+      _node.SubscribeRaw(topic,
+          std::bind(&LinearBattery::OnBatteryDrainingMsg,
+          this, std::placeholders::_1, std::placeholders::_2,
           std::placeholders::_3));
       ignmsg << "LinearBatteryPlugin subscribes to power draining topic ["
              << topic << "]." << std::endl;
@@ -369,16 +497,33 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
     }
   }
 
+  double updateFrequency = _sdf->Get<double>("update_frequency", -1).first;
+  if (updateFrequency > 0)
+  {
+    std::chrono::duration<double> period{1 / updateFrequency};
+    this->updatePeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+  }
+
+  double publishFrequency =
+      _sdf->Get<double>("state_publish_frequency", -1).first;
+  if (publishFrequency > 0)
+  {
+    std::chrono::duration<double> period{1 / publishFrequency};
+    this->publishPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+  }
+
   ignmsg << "LinearBatteryPlugin configured. Battery name: "
-         << this->dataPtr->battery->Name() << std::endl;
-  igndbg << "Battery initial voltage: " << this->dataPtr->battery->InitVoltage()
+         << this->battery->Name() << std::endl;
+  igndbg << "Battery initial voltage: " << this->battery->InitVoltage()
          << std::endl;
 
-  this->dataPtr->soc = this->dataPtr->q / this->dataPtr->c;
+  this->soc = this->q / this->c;
 
   // Setup battery state topic
-  std::string stateTopic{"/model/" + this->dataPtr->model.Name(_ecm) +
-    "/battery/" + this->dataPtr->battery->Name() + "/state"};
+  std::string stateTopic{"/model/" + this->model.Name(_ecm) +
+    "/battery/" + this->battery->Name() + "/state"};
 
   auto validStateTopic = transport::TopicUtils::AsValidTopic(stateTopic);
   if (validStateTopic.empty())
@@ -390,12 +535,12 @@ void LinearBatteryPlugin::Configure(const Entity &_entity,
 
   transport::AdvertiseMessageOptions opts;
   opts.SetMsgsPerSec(50);
-  this->dataPtr->statePub = this->dataPtr->node.Advertise<msgs::BatteryState>(
+  this->statePub = _node.Advertise<msgs::BatteryState>(
     validStateTopic, opts);
 }
 
 /////////////////////////////////////////////////
-void LinearBatteryPluginPrivate::Reset()
+void LinearBattery::Reset()
 {
   this->iraw = 0.0;
   this->ismooth = 0.0;
@@ -404,13 +549,13 @@ void LinearBatteryPluginPrivate::Reset()
 }
 
 /////////////////////////////////////////////////
-double LinearBatteryPluginPrivate::StateOfCharge() const
+double LinearBattery::StateOfCharge() const
 {
   return this->soc;
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPluginPrivate::OnEnableRecharge(
+void LinearBattery::OnEnableRecharge(
   const ignition::msgs::Boolean &/*_req*/)
 {
   igndbg << "Request for start charging received" << std::endl;
@@ -418,7 +563,7 @@ void LinearBatteryPluginPrivate::OnEnableRecharge(
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPluginPrivate::OnDisableRecharge(
+void LinearBattery::OnDisableRecharge(
   const ignition::msgs::Boolean &/*_req*/)
 {
   igndbg << "Request for stop charging received" << std::endl;
@@ -426,28 +571,37 @@ void LinearBatteryPluginPrivate::OnDisableRecharge(
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPluginPrivate::OnBatteryDrainingMsg(
+void LinearBattery::OnBatteryDrainingMsg(
   const char *, const size_t, const ignition::transport::MessageInfo &)
 {
   this->startDrainingFromTopics = true;
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPlugin::PreUpdate(
-  const ignition::gazebo::UpdateInfo &/*_info*/,
-  ignition::gazebo::EntityComponentManager &_ecm)
+msgs::BatteryState::PowerSupplyStatus LinearBattery::PowerSupplyStatus()
+    const
 {
-  IGN_PROFILE("LinearBatteryPlugin::PreUpdate");
+  if (this->startCharging)
+    return msgs::BatteryState::CHARGING;
+  else if (this->startDraining)
+    return msgs::BatteryState::DISCHARGING;
+  else if (this->StateOfCharge() > 0.9)
+    return msgs::BatteryState::FULL;
+  return msgs::BatteryState::NOT_CHARGING;
+}
 
+//////////////////////////////////////////////////
+void LinearBattery::PreUpdate(const EntityComponentManager &_ecm)
+{
   // \todo(anyone) Add in the ability to stop the battery from draining
   // after it has been started by a topic. See this comment:
   // https://github.com/ignitionrobotics/ign-gazebo/pull/1255#discussion_r770223092
-  this->dataPtr->startDraining = this->dataPtr->startDrainingFromTopics;
+  this->startDraining = this->startDrainingFromTopics;
   // Start draining the battery if the robot has started moving
-  if (!this->dataPtr->startDraining)
+  if (!this->startDraining)
   {
     const std::vector<Entity> joints = _ecm.ChildrenByComponents(
-      this->dataPtr->model.Entity(),
+      this->model.Entity(),
       components::Joint());
 
     for (Entity jointEntity : joints)
@@ -460,7 +614,7 @@ void LinearBatteryPlugin::PreUpdate(
         {
           if (fabsf(static_cast<float>(jointVel)) > 0)
           {
-            this->dataPtr->startDraining = true;
+            this->startDraining = true;
             return;
           }
         }
@@ -474,7 +628,7 @@ void LinearBatteryPlugin::PreUpdate(
         {
           if (fabsf(static_cast<float>(jointForce)) > 0)
           {
-            this->dataPtr->startDraining = true;
+            this->startDraining = true;
             return;
           }
         }
@@ -484,186 +638,262 @@ void LinearBatteryPlugin::PreUpdate(
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPlugin::Update(const UpdateInfo &_info,
-                                 EntityComponentManager &_ecm)
+void LinearBattery::Update(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("LinearBatteryPlugin::Update");
-
-  // \TODO(anyone) Support rewind
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
-  {
-    ignwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
-  }
-
-  if (_info.paused)
-    return;
-
-  if (!this->dataPtr->startDraining && !this->dataPtr->startCharging)
+  if (!this->startDraining && !this->startCharging)
     return;
 
   // Find the time at which battery starts to drain
   int simTime = static_cast<int>(
     std::chrono::duration_cast<std::chrono::seconds>(_info.simTime).count());
-  if (this->dataPtr->drainStartTime == -1)
-    this->dataPtr->drainStartTime = simTime;
+  if (this->drainStartTime == -1)
+    this->drainStartTime = simTime;
 
   // Print drain time in minutes
-  int drainTime = (simTime - this->dataPtr->drainStartTime) / 60;
-  if (drainTime != this->dataPtr->lastPrintTime)
+  int drainTime = (simTime - this->drainStartTime) / 60;
+  if (drainTime != this->lastPrintTime)
   {
-    this->dataPtr->lastPrintTime = drainTime;
+    this->lastPrintTime = drainTime;
     igndbg << "[Battery Plugin] Battery drain: " << drainTime <<
       " minutes passed.\n";
   }
 
-  // Update actual battery
-  this->dataPtr->stepSize = _info.dt;
-
   // Sanity check: tau should be between [dt, +inf).
   double dt = (std::chrono::duration_cast<std::chrono::nanoseconds>(
-    this->dataPtr->stepSize).count()) * 1e-9;
-  if (this->dataPtr->tau < dt)
+    _info.dt).count()) * 1e-9;
+  if (this->tau < dt)
   {
     ignerr << "<smooth_current_tau> should be in the range [dt, +inf) but is "
-           << "configured with [" << this->dataPtr->tau << "]. We'll be using "
+           << "configured with [" << this->tau << "]. We'll be using "
            << "[" << dt << "] instead" << std::endl;
-    this->dataPtr->tau = dt;
+    this->tau = dt;
   }
 
-  if (this->dataPtr->battery)
+  if (!this->battery)
+    return;
+
+  // When integrating at a lower rate, the time spent draining or charging
+  // accumulates until the battery is due, and it's then integrated at once
+  this->pendingTime += _info.dt;
+  if (this->updatePeriod > std::chrono::steady_clock::duration::zero() &&
+      this->pendingTime < this->updatePeriod)
   {
-    this->dataPtr->battery->Update();
+    return;
+  }
 
-    // Update component
-    auto *batteryComp =
-      _ecm.Component<components::BatterySoC>(this->dataPtr->batteryEntity);
+  // Update actual battery
+  this->stepSize = this->pendingTime;
+  this->pendingTime = std::chrono::steady_clock::duration::zero();
+  this->battery->Update();
 
-    batteryComp->Data() = this->dataPtr->StateOfCharge();
+  // Update component
+  auto *batteryComp =
+    _ecm.Component<components::BatterySoC>(this->batteryEntity);
+  batteryComp->Data() = this->StateOfCharge();
+
+  bool hasCharge = batteryComp->Data() > 0;
+  if (hasCharge != this->componentHasCharge)
+  {
+    this->componentHasCharge = hasCharge;
+    _ecm.SetChanged(this->batteryEntity, components::BatterySoC::typeId,
+        ComponentState::OneTimeChange);
   }
 }
 
 //////////////////////////////////////////////////
-void LinearBatteryPlugin::PostUpdate(const UpdateInfo &_info,
-    const EntityComponentManager &/*_ecm*/)
+void LinearBattery::PostUpdate(const UpdateInfo &_info)
 {
-  IGN_PROFILE("LinearBatteryPlugin::PostUpdate");
-  // Nothing left to do if paused or the publisher wasn't created.
-  if (_info.paused || !this->dataPtr->statePub)
+  // Nothing left to do if the publisher wasn't created.
+  if (!this->statePub)
     return;
 
+  // Throttle publishing, but publish right away when the power supply
+  // status changes or the battery drains. If time has gone backward,
+  // publish and allow the time to be reset.
+  auto status = this->PowerSupplyStatus();
+  bool drained = this->StateOfCharge() <= 0;
+  auto diff = _info.simTime - this->lastPubTime;
+  if (status == this->lastPubStatus && drained == this->lastPubDrained &&
+      diff > std::chrono::steady_clock::duration::zero() &&
+      diff < this->publishPeriod)
+  {
+    return;
+  }
+  this->lastPubTime = _info.simTime;
+  this->lastPubStatus = status;
+  this->lastPubDrained = drained;
+
   // Publish battery state
-  msgs::BatteryState msg;
+  auto &msg = this->stateMsg;
   msg.mutable_header()->mutable_stamp()->CopyFrom(
       convert<msgs::Time>(_info.simTime));
-  msg.set_voltage(this->dataPtr->battery->Voltage());
-  msg.set_current(this->dataPtr->ismooth);
-  msg.set_charge(this->dataPtr->q);
-  msg.set_capacity(this->dataPtr->c);
+  msg.set_voltage(this->battery->Voltage());
+  msg.set_current(this->ismooth);
+  msg.set_charge(this->q);
+  msg.set_capacity(this->c);
 
-  if (this->dataPtr->fixIssue225)
-    msg.set_percentage(this->dataPtr->soc * 100);
+  if (this->fixIssue225)
+    msg.set_percentage(this->soc * 100);
   else
-    msg.set_percentage(this->dataPtr->soc);
-
-  if (this->dataPtr->startCharging)
-    msg.set_power_supply_status(msgs::BatteryState::CHARGING);
-  else if (this->dataPtr->startDraining)
-    msg.set_power_supply_status(msgs::BatteryState::DISCHARGING);
-  else if (this->dataPtr->StateOfCharge() > 0.9)
-    msg.set_power_supply_status(msgs::BatteryState::FULL);
-  else
-    msg.set_power_supply_status(msgs::BatteryState::NOT_CHARGING);
-  this->dataPtr->statePub.Publish(msg);
+    msg.set_percentage(this->soc);
+
+  msg.set_power_supply_status(status);
+  this->statePub.Publish(msg);
+}
+
+//////////////////////////////////////////////////
+void LinearBatteryPlugin::PreUpdate(
+  const ignition::gazebo::UpdateInfo &/*_info*/,
+  ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("LinearBatteryPlugin::PreUpdate");
+
+  // When attached to the world, models may be spawned after the system is
+  // loaded
+  if (!this->dataPtr->pendingBatteries.empty())
+    this->dataPtr->LoadPendingBatteries(_ecm);
+
+  for (auto &battery : this->dataPtr->batteries)
+    battery->PreUpdate(_ecm);
+}
+
+//////////////////////////////////////////////////
+void LinearBatteryPlugin::Update(const UpdateInfo &_info,
+                                 EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("LinearBatteryPlugin::Update");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  if (_info.paused)
+    return;
+
+  for (auto &battery : this->dataPtr->batteries)
+    battery->Update(_info, _ecm);
+}
+
+//////////////////////////////////////////////////
+void LinearBatteryPlugin::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &/*_ecm*/)
+{
+  IGN_PROFILE("LinearBatteryPlugin::PostUpdate");
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  for (auto &battery : this->dataPtr->batteries)
+    battery->PostUpdate(_info);
 }
 
 /////////////////////////////////////////////////
-double LinearBatteryPlugin::OnUpdateVoltage(
+double LinearBattery::OnUpdateVoltage(
   const common::Battery *_battery)
 {
   IGN_ASSERT(_battery != nullptr, "common::Battery is null.");
 
-  if (fabs(_battery->Voltage()) < 1e-3 && !this->dataPtr->startCharging)
+  if (fabs(_battery->Voltage()) < 1e-3 && !this->startCharging)
     return 0.0;
-  if (this->dataPtr->StateOfCharge() < 0 && !this->dataPtr->startCharging)
+  if (this->StateOfCharge() < 0 && !this->startCharging)
     return _battery->Voltage();
 
-  auto prevSocInt = static_cast<int>(this->dataPtr->StateOfCharge() * 100);
+  auto prevSocInt = static_cast<int>(this->StateOfCharge() * 100);
 
   // Seconds
   double dt = (std::chrono::duration_cast<std::chrono::nanoseconds>(
-    this->dataPtr->stepSize).count()) * 1e-9;
+    this->stepSize).count()) * 1e-9;
   double totalpower = 0.0;
-  double k = dt / this->dataPtr->tau;
 
-  if (this->dataPtr->startDraining)
+  if (this->startDraining)
   {
     for (auto powerLoad : _battery->PowerLoads())
       totalpower += powerLoad.second;
   }
 
-  this->dataPtr->iraw = totalpower / _battery->Voltage();
+  this->iraw = totalpower / _battery->Voltage();
 
   // compute charging current
-  auto iCharge = this->dataPtr->c / this->dataPtr->tCharge;
+  auto iCharge = this->c / this->tCharge;
 
   // add charging current to battery
-  if (this->dataPtr->startCharging && this->dataPtr->StateOfCharge() < 0.9)
-    this->dataPtr->iraw -= iCharge;
+  if (this->startCharging && this->StateOfCharge() < 0.9)
+    this->iraw -= iCharge;
 
-  this->dataPtr->ismooth = this->dataPtr->ismooth + k *
-    (this->dataPtr->iraw - this->dataPtr->ismooth);
+  // Average current drawn over dt
+  double iaverage{0.0};
+  if (this->updatePeriod > std::chrono::steady_clock::duration::zero())
+  {
+    // Integrate the low-pass filter analytically over the whole interval,
+    // taking the raw current as constant over it, so that the result
+    // doesn't depend on how many iterations the interval spans
+    double decay = std::exp(-dt / this->tau);
+    double i0 = this->ismooth;
+    this->ismooth = this->iraw + (i0 - this->iraw) * decay;
+    iaverage = this->iraw + (i0 - this->iraw) * this->tau * (1.0 - decay) / dt;
+  }
+  else
+  {
+    double k = dt / this->tau;
+    this->ismooth = this->ismooth + k *
+      (this->iraw - this->ismooth);
+    iaverage = this->ismooth;
+  }
 
-  if (!this->dataPtr->fixIssue225)
+  if (!this->fixIssue225)
   {
-    if (this->dataPtr->iList.size() >= 100)
+    if (this->iList.size() >= 100)
     {
-      this->dataPtr->iList.pop_front();
-      this->dataPtr->dtList.pop_front();
+      this->iList.pop_front();
+      this->dtList.pop_front();
     }
-    this->dataPtr->iList.push_back(this->dataPtr->ismooth);
-    this->dataPtr->dtList.push_back(dt);
+    this->iList.push_back(iaverage);
+    this->dtList.push_back(dt);
   }
 
   // Convert dt to hours
-  this->dataPtr->q = this->dataPtr->q - ((dt * this->dataPtr->ismooth) /
+  this->q = this->q - ((dt * iaverage) /
     3600.0);
 
   // open circuit voltage
-  double voltage = this->dataPtr->e0 + this->dataPtr->e1 * (
-    1 - this->dataPtr->q / this->dataPtr->c)
-      - this->dataPtr->r * this->dataPtr->ismooth;
+  double voltage = this->e0 + this->e1 * (
+    1 - this->q / this->c)
+      - this->r * this->ismooth;
 
   // Estimate state of charge
-  if (this->dataPtr->fixIssue225)
-    this->dataPtr->soc = this->dataPtr->q / this->dataPtr->c;
+  if (this->fixIssue225)
+    this->soc = this->q / this->c;
   else
   {
     double isum = 0.0;
-    for (size_t i = 0; i < this->dataPtr->iList.size(); ++i)
-      isum += (this->dataPtr->iList[i] * this->dataPtr->dtList[i] / 3600.0);
-    this->dataPtr->soc = this->dataPtr->soc - isum / this->dataPtr->c;
+    for (size_t i = 0; i < this->iList.size(); ++i)
+      isum += (this->iList[i] * this->dtList[i] / 3600.0);
+    this->soc = this->soc - isum / this->c;
   }
 
   // Throttle debug messages
-  auto socInt = static_cast<int>(this->dataPtr->StateOfCharge() * 100);
+  auto socInt = static_cast<int>(this->StateOfCharge() * 100);
   if (socInt % 10 == 0 && socInt != prevSocInt)
   {
-    igndbg << "Battery: " << this->dataPtr->battery->Name() << std::endl;
+    igndbg << "Battery: " << this->battery->Name() << std::endl;
     igndbg << "PowerLoads().size(): " << _battery->PowerLoads().size()
            << std::endl;
     igndbg << "charging status: " << std::boolalpha
-           << this->dataPtr->startCharging << std::endl;
+           << this->startCharging << std::endl;
     igndbg << "charging current: " << iCharge << std::endl;
     igndbg << "voltage: " << voltage << std::endl;
-    igndbg << "state of charge: " << this->dataPtr->StateOfCharge()
-           << " (q " << this->dataPtr->q << ")" << std::endl << std::endl;
+    igndbg << "state of charge: " << this->StateOfCharge()
+           << " (q " << this->q << ")" << std::endl << std::endl;
   }
-  if (this->dataPtr->StateOfCharge() < 0 && !this->dataPtr->drainPrinted)
+  if (this->StateOfCharge() < 0 && !this->drainPrinted)
   {
-    ignwarn << "Model " << this->dataPtr->modelName << " out of battery.\n";
-    this->dataPtr->drainPrinted = true;
+    ignwarn << "Model " << this->modelName << " out of battery.\n";
+    this->drainPrinted = true;
   }
 
   return voltage;
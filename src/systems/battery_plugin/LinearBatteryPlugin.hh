@@ -63,6 +63,34 @@ namespace systems
   /// start draining. This element can be specified multiple times if
   /// multiple topics should be monitored. Note that this mechanism will
   /// start the battery draining, and once started will keep drainig.
+  /// - `<update_frequency>` Frequency in Hz at which the charge is
+  /// integrated. Between updates, the time the battery spends draining or
+  /// charging accumulates, and the charge and smoothed current are then
+  /// integrated analytically over the whole interval, taking the power
+  /// loads as constant over it. Changes to the loads or the charging state
+  /// take effect on the next update. Defaults to integrating on every
+  /// iteration.
+  /// - `<state_publish_frequency>` Frequency in Hz at which the battery
+  /// state is published. The state is also published right away whenever
+  /// the power supply status changes or the battery drains. Defaults to
+  /// publishing on every iteration.
+  ///
+  /// The `BatterySoC` component of the battery is updated whenever the
+  /// charge is integrated, but it's only marked as changed when the battery
+  /// drains or regains charge.
+  ///
+  /// # Fleet mode
+  ///
+  /// When attached to a world instead of a model, a single instance of the
+  /// system simulates the batteries of a whole fleet, which are all updated
+  /// in one pass, instead of loading one system per battery. Each battery is
+  /// described by a `<battery>` element, which takes all the parameters
+  /// above plus:
+  ///
+  /// - `<model_name>` Name of the top level model which holds the battery.
+  ///
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned. Topics and services stay per battery.
   class LinearBatteryPlugin
       : public System,
         public ISystemConfigure,
@@ -96,11 +124,6 @@ namespace systems
                 const UpdateInfo &_info,
                 const EntityComponentManager &_ecm) override;
 
-    /// \brief Callback for Battery Update events.
-    /// \param[in] _battery Pointer to the battery that is to be updated.
-    /// \return The new voltage.
-    private: double OnUpdateVoltage(const common::Battery *_battery);
-
     /// \brief Private data pointer
     private: std::unique_ptr<LinearBatteryPluginPrivate> dataPtr;
   };
@@ -166,6 +166,10 @@ void Breadcrumbs::Configure(const Entity &_entity,
 
   this->creator = std::make_unique<SdfEntityCreator>(_ecm, _eventMgr);
 
+  // Build the breadcrumb entities once, so that deployments only copy them
+  this->breadcrumbTemplate =
+      this->creator->CreateTemplate(this->modelRoot.Model());
+
   this->worldEntity = _ecm.EntityByComponents(components::World());
 
   this->initialized = true;
@@ -203,9 +207,9 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       if (this->maxDeployments < 0 ||
           this->numDeployments < this->maxDeployments)
       {
-        sdf::Model modelToSpawn = *this->modelRoot.Model();
+        const sdf::Model *modelToSpawn = this->modelRoot.Model();
         std::string desiredName =
-            modelToSpawn.Name() + "_" + std::to_string(this->numDeployments);
+            modelToSpawn->Name() + "_" + std::to_string(this->numDeployments);
 
         std::vector<std::string> modelNames;
         _ecm.Each<components::Name, components::Model>(
@@ -239,15 +243,14 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
           desiredName = newName;
         }
 
-        modelToSpawn.SetName(desiredName);
-        modelToSpawn.SetRawPose(poseComp->Data() * modelToSpawn.RawPose());
-        ignmsg << "Deploying " << modelToSpawn.Name() << " at "
-               << modelToSpawn.RawPose() << std::endl;
-        Entity entity = this->creator->CreateEntities(&modelToSpawn);
+        math::Pose3d pose = poseComp->Data() * modelToSpawn->RawPose();
+        ignmsg << "Deploying " << desiredName << " at " << pose << std::endl;
+        Entity entity = this->creator->CreateFromTemplate(
+            this->breadcrumbTemplate, desiredName, pose);
         this->creator->SetParent(entity, this->worldEntity);
 
         // keep track of entities that are set to auto disable
-        if (!modelToSpawn.Static() &&
+        if (!modelToSpawn->Static() &&
             this->disablePhysicsTime >
             std::chrono::steady_clock::duration::zero())
         {
@@ -259,7 +262,7 @@ void Breadcrumbs::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
           auto worldName =
               _ecm.Component<components::Name>(this->worldEntity)->Data();
           msgs::StringMsg req;
-          req.set_data(modelToSpawn.Name());
+          req.set_data(desiredName);
           this->node.Request<msgs::StringMsg, msgs::Boolean>(
               "/world/" + worldName + "/level/set_performer", req,
               [](const msgs::Boolean &, const bool)
@@ -354,7 +357,7 @@ bool Breadcrumbs::MakeStatic(Entity _entity, EntityComponentManager &_ecm)
   // breadcrumb to the static model
   // todo(anyone) Add a feature in ign-physics to support making a model
   // static
-  if (this->staticModelToSpawn.LinkCount() == 0u)
+  if (!this->staticTemplate)
   {
     sdf::ElementPtr staticModelSDF(new sdf::Element);
     sdf::initFile("model.sdf", staticModelSDF);
@@ -363,18 +366,18 @@ bool Breadcrumbs::MakeStatic(Entity _entity, EntityComponentManager &_ecm)
     sdf::ElementPtr linkElem = staticModelSDF->AddElement("link");
     linkElem->GetAttribute("name")->Set("static_link");
     this->staticModelToSpawn.Load(staticModelSDF);
+    this->staticTemplate =
+        this->creator->CreateTemplate(&this->staticModelToSpawn);
   }
 
   auto bcPoseComp = _ecm.Component<components::Pose>(_entity);
   if (!bcPoseComp)
     return false;
-  math::Pose3d p = bcPoseComp->Data();
-  this->staticModelToSpawn.SetRawPose(p);
 
   auto nameComp = _ecm.Component<components::Name>(_entity);
-  this->staticModelToSpawn.SetName(nameComp->Data() + "__static__");
-
-  Entity staticEntity = this->creator->CreateEntities(&staticModelToSpawn);
+  Entity staticEntity = this->creator->CreateFromTemplate(
+      *this->staticTemplate, nameComp->Data() + "__static__",
+      bcPoseComp->Data());
   this->creator->SetParent(staticEntity, this->worldEntity);
 
   Entity parentLinkEntity = _ecm.EntityByComponents(
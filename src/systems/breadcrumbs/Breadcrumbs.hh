@@ -51,7 +51,9 @@ namespace systems
   /// generated for the breadcrumb by appending the current count of deployments
   /// to the name specified in the breadcrumb `<model>` element. The model
   /// specified in the `<breadcrumb>` parameter serves as a template for
-  /// deploying multiple breadcrumbs of the same type. Including models from
+  /// deploying multiple breadcrumbs of the same type. Its entities are built
+  /// once, when the system is configured, and each deployment copies them,
+  /// which is much cheaper than loading the model again. Including models from
   /// Fuel is accomplished by creating a `<model>` that includes the Fuel
   /// model using the `<include>` tag.
   /// See the example in examples/worlds/breadcrumbs.sdf.
@@ -167,6 +169,14 @@ namespace systems
     /// \brief SDF DOM of a static model with empty link
     private: sdf::Model staticModelToSpawn;
 
+    /// \brief Id of the creator template of the breadcrumb model,
+    /// which is copied on each deployment.
+    private: std::size_t breadcrumbTemplate{0u};
+
+    /// \brief Id of the creator template of staticModelToSpawn, built on
+    /// the first breadcrumb made static.
+    private: std::optional<std::size_t> staticTemplate;
+
     /// \brief Publishes remaining deployments.
     public: transport::Node::Publisher remainingPub;
 
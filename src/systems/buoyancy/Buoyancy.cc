@@ -19,6 +19,8 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -76,17 +78,82 @@ class ignition::gazebo::systems::BuoyancyPrivate
   /// \return The fluid density at the givein pose.
   public: double UniformFluidDensity(const math::Pose3d &_pose) const;
 
+  /// \brief Holds information about forces contributed by a single collision
+  /// shape.
+  public: struct BuoyancyActionPoint
+  {
+    /// \brief The force to be applied, expressed in the world frame.
+    math::Vector3d force;
+
+    /// \brief The point from which the force will be applied, expressed in
+    /// the collision's frame.
+    math::Vector3d point;
+
+    /// \brief The world pose of the collision.
+    math::Pose3d pose;
+  };
+
   /// \brief Get the resultant buoyant force on a shape.
   /// \param[in] _pose World pose of the shape's origin.
   /// \param[in] _shape The collision mesh of a shape. Currently must
   /// be box or sphere.
   /// \param[in] _gravity Gravity acceleration in the world frame.
-  /// Updates this->buoyancyForces containing {force, center_of_volume} to be
-  /// applied on the link.
+  /// \param[out] _forces Forces {force, center_of_volume} to be applied on
+  /// the link are appended to this.
   public:
   template<typename T>
   void GradedFluidDensity(
-    const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity);
+    const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity,
+    std::vector<BuoyancyActionPoint> &_forces) const;
+
+  /// \brief Collision shape used by graded buoyancy.
+  public: struct GradedShape
+  {
+    /// \brief Pose of the collision in the link frame.
+    math::Pose3d poseInLink;
+
+    /// \brief True for a box, false for a sphere.
+    bool isBox{true};
+
+    /// \brief Shape of the collision, if it's a box.
+    math::Boxd box;
+
+    /// \brief Shape of the collision, if it's a sphere.
+    math::Sphered sphere;
+  };
+
+  /// \brief Link which receives graded buoyancy on this iteration.
+  public: struct GradedLink
+  {
+    /// \brief Link entity.
+    Entity entity{kNullEntity};
+
+    /// \brief Collision shapes of the link.
+    const std::vector<GradedShape> *shapes{nullptr};
+
+    /// \brief Resultant force, expressed in the world frame.
+    math::Vector3d force;
+
+    /// \brief Resultant torque, expressed in the world frame.
+    math::Vector3d torque;
+  };
+
+  /// \brief Get the collision shapes of a link used by graded buoyancy.
+  /// They're cached the first time a link is seen, so collisions and their
+  /// poses aren't looked up on every iteration.
+  /// \param[in] _link Link entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return Shapes of the link.
+  public: const std::vector<GradedShape> &GradedShapes(const Entity _link,
+    const EntityComponentManager &_ecm);
+
+  /// \brief Compute the graded buoyancy wrench of a link.
+  /// \param[in,out] _link Link, whose force and torque are set.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _gravity Gravity acceleration in the world frame.
+  public: void ComputeGradedWrench(GradedLink &_link,
+    const EntityComponentManager &_ecm,
+    const math::Vector3d &_gravity) const;
 
   /// \brief Model interface
   public: Entity world{kNullEntity};
@@ -102,36 +169,22 @@ class ignition::gazebo::systems::BuoyancyPrivate
   /// fluidDensity.
   public: std::map<double, double> layers;
 
-  /// \brief Holds information about forces contributed by a single collision
-  /// shape.
-  public: struct BuoyancyActionPoint
-  {
-    /// \brief The force to be applied, expressed in the world frame.
-    math::Vector3d force;
-
-    /// \brief The point from which the force will be applied, expressed in
-    /// the collision's frame.
-    math::Vector3d point;
-
-    /// \brief The world pose of the collision.
-    math::Pose3d pose;
-  };
-
-  /// \brief List of points from where the forces act.
-  /// This holds values refent to the current link being processed and must be
-  /// cleared between links.
-  /// \TODO(chapulina) It's dangerous to keep link-specific values in a member
-  /// variable. We should consider reducing the scope of this variable and pass
-  /// it across functions as needed.
-  public: std::vector<BuoyancyActionPoint> buoyancyForces;
-
   /// \brief Resolve all forces as if they act as a Wrench from the give pose.
   /// \param[in] _linkInWorld The point from which all poses are to be resolved.
   /// This is the link's origin in the world frame.
+  /// \param[in] _forces Forces contributed by the link's collisions.
   /// \return A pair of {force, torque} describing the wrench to be applied
   /// at _pose, expressed in the world frame.
-  public: std::pair<math::Vector3d, math::Vector3d> ResolveForces(
-    const math::Pose3d &_linkInWorld);
+  public: static std::pair<math::Vector3d, math::Vector3d> ResolveForces(
+    const math::Pose3d &_linkInWorld,
+    const std::vector<BuoyancyActionPoint> &_forces);
+
+  /// \brief Collision shapes of each link which received graded buoyancy.
+  public: std::unordered_map<Entity, std::vector<GradedShape>> gradedShapes;
+
+  /// \brief Links which receive graded buoyancy on the current iteration.
+  /// Kept as a member to reuse its memory.
+  public: std::vector<GradedLink> gradedLinks;
 
   /// \brief Scoped names of entities that buoyancy should apply to. If empty,
   /// all links will receive buoyancy.
@@ -147,7 +200,8 @@ double BuoyancyPrivate::UniformFluidDensity(const math::Pose3d &/*_pose*/) const
 //////////////////////////////////////////////////
 template<typename T>
 void BuoyancyPrivate::GradedFluidDensity(
-  const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity)
+  const math::Pose3d &_pose, const T &_shape, const math::Vector3d &_gravity,
+  std::vector<BuoyancyActionPoint> &_forces) const
 {
   auto prevLayerFluidDensity = this->fluidDensity;
   auto prevLayerVol = 0.0;
@@ -190,7 +244,7 @@ void BuoyancyPrivate::GradedFluidDensity(
       cob,
       _pose
     };
-    this->buoyancyForces.push_back(buoyancyAction);
+    _forces.push_back(buoyancyAction);
 
     prevLayerVol = vol;
   }
@@ -215,17 +269,18 @@ void BuoyancyPrivate::GradedFluidDensity(
     cob,
     _pose
   };
-  this->buoyancyForces.push_back(buoyancyAction);
+  _forces.push_back(buoyancyAction);
 }
 
 //////////////////////////////////////////////////
 std::pair<math::Vector3d, math::Vector3d> BuoyancyPrivate::ResolveForces(
-  const math::Pose3d &_linkInWorld)
+  const math::Pose3d &_linkInWorld,
+  const std::vector<BuoyancyActionPoint> &_forces)
 {
   auto force = math::Vector3d{0, 0, 0};
   auto torque = math::Vector3d{0, 0, 0};
 
-  for (const auto &b : this->buoyancyForces)
+  for (const auto &b : _forces)
   {
     force += b.force;
 
@@ -245,6 +300,79 @@ std::pair<math::Vector3d, math::Vector3d> BuoyancyPrivate::ResolveForces(
   return {force, torque};
 }
 
+//////////////////////////////////////////////////
+const std::vector<BuoyancyPrivate::GradedShape> &BuoyancyPrivate::GradedShapes(
+  const Entity _link, const EntityComponentManager &_ecm)
+{
+  auto it = this->gradedShapes.find(_link);
+  if (it != this->gradedShapes.end())
+    return it->second;
+
+  auto &shapes = this->gradedShapes[_link];
+  for (auto e : _ecm.ChildrenByComponents(_link, components::Collision()))
+  {
+    const components::CollisionElement *coll =
+      _ecm.Component<components::CollisionElement>(e);
+    if (!coll)
+    {
+      ignerr << "Invalid collision pointer. This shouldn't happen\n";
+      continue;
+    }
+
+    GradedShape shape;
+    auto poseComp = _ecm.Component<components::Pose>(e);
+    if (poseComp)
+      shape.poseInLink = poseComp->Data();
+
+    switch (coll->Data().Geom()->Type())
+    {
+      case sdf::GeometryType::BOX:
+        shape.isBox = true;
+        shape.box = coll->Data().Geom()->BoxShape()->Shape();
+        shapes.push_back(shape);
+        break;
+      case sdf::GeometryType::SPHERE:
+        shape.isBox = false;
+        shape.sphere = coll->Data().Geom()->SphereShape()->Shape();
+        shapes.push_back(shape);
+        break;
+      default:
+      {
+        static bool warned{false};
+        if (!warned)
+        {
+          ignwarn << "Only <box> and <sphere> collisions are supported "
+            << "by the graded buoyancy option." << std::endl;
+          warned = true;
+        }
+        break;
+      }
+    }
+  }
+  return shapes;
+}
+
+//////////////////////////////////////////////////
+void BuoyancyPrivate::ComputeGradedWrench(GradedLink &_link,
+  const EntityComponentManager &_ecm, const math::Vector3d &_gravity) const
+{
+  // World pose of the link.
+  math::Pose3d linkWorldPose = worldPose(_link.entity, _ecm);
+
+  std::vector<BuoyancyActionPoint> forces;
+  for (const auto &shape : *_link.shapes)
+  {
+    auto pose = linkWorldPose * shape.poseInLink;
+    if (shape.isBox)
+      this->GradedFluidDensity(pose, shape.box, _gravity, forces);
+    else
+      this->GradedFluidDensity(pose, shape.sphere, _gravity, forces);
+  }
+
+  std::tie(_link.force, _link.torque) =
+    ResolveForces(linkWorldPose, forces);
+}
+
 //////////////////////////////////////////////////
 Buoyancy::Buoyancy()
   : dataPtr(std::make_unique<BuoyancyPrivate>())
@@ -452,10 +580,18 @@ void Buoyancy::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     return true;
   });
 
+  _ecm.EachRemoved<components::Link>(
+      [&](const Entity &_entity, const components::Link *) -> bool
+  {
+    this->dataPtr->gradedShapes.erase(_entity);
+    return true;
+  });
+
   // Only update if not paused.
   if (_info.paused)
     return;
 
+  this->dataPtr->gradedLinks.clear();
   _ecm.Each<components::Link,
             components::Volume,
             components::CenterOfVolume>(
@@ -464,18 +600,18 @@ void Buoyancy::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
           const components::Volume *_volume,
           const components::CenterOfVolume *_centerOfVolume) -> bool
     {
-      // World pose of the link.
-      math::Pose3d linkWorldPose = worldPose(_entity, _ecm);
-
-      Link link(_entity);
-
-      math::Vector3d buoyancy;
       // By Archimedes' principle,
       // buoyancy = -(mass*gravity)*fluid_density/object_density
       // object_density = mass/volume, so the mass term cancels.
       if (this->dataPtr->buoyancyType
         == BuoyancyPrivate::BuoyancyType::UNIFORM_BUOYANCY)
       {
+        // World pose of the link.
+        math::Pose3d linkWorldPose = worldPose(_entity, _ecm);
+
+        Link link(_entity);
+
+        math::Vector3d buoyancy;
         buoyancy =
         -this->dataPtr->UniformFluidDensity(linkWorldPose) *
         _volume->Data() * gravity->Data();
@@ -494,58 +630,36 @@ void Buoyancy::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       else if (this->dataPtr->buoyancyType
         == BuoyancyPrivate::BuoyancyType::GRADED_BUOYANCY)
       {
-        std::vector<Entity> collisions = _ecm.ChildrenByComponents(
-          _entity, components::Collision());
-        this->dataPtr->buoyancyForces.clear();
-
-        for (auto e : collisions)
-        {
-          const components::CollisionElement *coll =
-            _ecm.Component<components::CollisionElement>(e);
-
-          auto pose = worldPose(e, _ecm);
-
-          if (!coll)
-          {
-            ignerr << "Invalid collision pointer. This shouldn't happen\n";
-            continue;
-          }
-
-          switch (coll->Data().Geom()->Type())
-          {
-            case sdf::GeometryType::BOX:
-              this->dataPtr->GradedFluidDensity<math::Boxd>(
-                pose,
-                coll->Data().Geom()->BoxShape()->Shape(),
-                gravity->Data());
-              break;
-            case sdf::GeometryType::SPHERE:
-              this->dataPtr->GradedFluidDensity<math::Sphered>(
-                pose,
-                coll->Data().Geom()->SphereShape()->Shape(),
-                gravity->Data());
-              break;
-            default:
-            {
-              static bool warned{false};
-              if (!warned)
-              {
-                ignwarn << "Only <box> and <sphere> collisions are supported "
-                  << "by the graded buoyancy option." << std::endl;
-                warned = true;
-              }
-              break;
-            }
-          }
-        }
-        auto [force, torque] = this->dataPtr->ResolveForces(linkWorldPose);
-        // Apply the wrench to the link. This wrench is applied in the
-        // Physics System.
-        link.AddWorldWrench(_ecm, force, torque);
+        // Links are evaluated all together below
+        BuoyancyPrivate::GradedLink gradedLink;
+        gradedLink.entity = _entity;
+        gradedLink.shapes = &this->dataPtr->GradedShapes(_entity, _ecm);
+        this->dataPtr->gradedLinks.push_back(gradedLink);
       }
 
       return true;
   });
+
+  // Submerged volumes of different links are independent of each other, so
+  // they're computed concurrently, and wrenches are applied afterwards
+  auto &gradedLinks = this->dataPtr->gradedLinks;
+  _ecm.ParallelFor(gradedLinks.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      this->dataPtr->ComputeGradedWrench(gradedLinks[i], _ecm,
+          gravity->Data());
+    }
+  }, 8u);
+
+  for (const auto &gradedLink : gradedLinks)
+  {
+    // Apply the wrench to the link. This wrench is applied in the
+    // Physics System.
+    Link link(gradedLink.entity);
+    link.AddWorldWrench(_ecm, gradedLink.force, gradedLink.torque);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -52,7 +52,9 @@ namespace systems
   /// simulating an open ocean with its surface and under water behaviour. This
   /// mode slices the volume of each collision mesh according to where the water
   /// line is set. When defining a `<graded_buoyancy>` tag, one must also define
-  /// `<default_density>` and `<density_change>` tags.
+  /// `<default_density>` and `<density_change>` tags. The collisions of each
+  /// link and their poses are read once, when the link first receives
+  /// buoyancy, so changes to them afterwards aren't taken into account.
   /// * `<default_density>` is the default fluid which the world should be
   /// filled with. [Units: kgm^-3]
   /// * `<density_change>` allows you to define a new layer.
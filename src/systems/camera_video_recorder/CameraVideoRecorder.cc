@@ -21,7 +21,6 @@
 #include <unordered_map>
 
 #include <ignition/common/Profiler.hh>
-#include <ignition/common/VideoEncoder.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
@@ -30,6 +29,7 @@
 #include <ignition/rendering/RenderingIface.hh>
 #include <ignition/rendering/Scene.hh>
 
+#include "ignition/gazebo/rendering/AsyncVideoEncoder.hh"
 #include "ignition/gazebo/rendering/RenderUtil.hh"
 #include "ignition/gazebo/rendering/Events.hh"
 #include "ignition/gazebo/rendering/MarkerManager.hh"
@@ -93,8 +93,8 @@ class ignition::gazebo::systems::CameraVideoRecorderPrivate
   /// \brief Image from user camera
   public: rendering::Image cameraImage;
 
-  /// \brief Video encoder
-  public: common::VideoEncoder videoEncoder;
+  /// \brief Video encoder, which encodes frames off the rendering thread
+  public: AsyncVideoEncoder videoEncoder;
 
   /// \brief Video encoding format
   public: std::string recordVideoFormat;
@@ -135,6 +135,15 @@ class ignition::gazebo::systems::CameraVideoRecorderPrivate
   /// \brief Recording frames per second.
   public: unsigned int fps = 25;
 
+  /// \brief Hardware encoder, empty for software encoding.
+  public: std::string hwEncoder;
+
+  /// \brief Device of the hardware encoder.
+  public: std::string hwEncoderDevice;
+
+  /// \brief Maximum number of frames waiting to be encoded.
+  public: unsigned int maxQueuedFrames = 8;
+
   /// \brief Marker manager
   public: MarkerManager markerManager;
 };
@@ -264,6 +273,13 @@ void CameraVideoRecorder::Configure(
 
   this->dataPtr->fps = _sdf->Get<unsigned int>("fps", this->dataPtr->fps).first;
 
+  this->dataPtr->hwEncoder = _sdf->Get<std::string>("hw_encoder",
+      this->dataPtr->hwEncoder).first;
+  this->dataPtr->hwEncoderDevice = _sdf->Get<std::string>(
+      "hw_encoder_device", this->dataPtr->hwEncoderDevice).first;
+  this->dataPtr->maxQueuedFrames = _sdf->Get<unsigned int>(
+      "max_queued_frames", this->dataPtr->maxQueuedFrames).first;
+
   // recorder stats topic
   std::string recorderStatsTopic = this->dataPtr->sensorTopic + "/stats";
   this->dataPtr->recorderStatsPub =
@@ -374,6 +390,9 @@ void CameraVideoRecorderPrivate::OnPostRender()
       this->node.Subscribe(this->sensorTopic,
           &CameraVideoRecorderPrivate::OnImage, this);
 
+      this->videoEncoder.SetHardwareEncoder(this->hwEncoder,
+          this->hwEncoderDevice);
+      this->videoEncoder.SetQueueSize(this->maxQueuedFrames);
       this->videoEncoder.Start(this->recordVideoFormat,
           this->tmpVideoFilename, width, height, this->fps,
           this->recordVideoBitrate);
@@ -392,10 +411,12 @@ void CameraVideoRecorderPrivate::OnPostRender()
     // other connections
     this->node.Unsubscribe(this->sensorTopic);
 
-    // stop encoding
+    // stop encoding, which finishes encoding the queued frames
     this->videoEncoder.Stop();
 
-    ignmsg << "Stop video recording on [" << this->service << "]." << std::endl;
+    ignmsg << "Stop video recording on [" << this->service << "]. Encoded ["
+           << this->videoEncoder.EncodedFrames() << "] frames, dropped ["
+           << this->videoEncoder.DroppedFrames() << "]." << std::endl;
 
     if (common::exists(this->tmpVideoFilename))
     {
@@ -51,6 +51,23 @@ namespace systems
   ///
   ///   <bitrate> Video recorder bitrate (bps). The default value is
   ///             2070000 bps, and the supported type is unsigned int.
+  ///
+  ///   <hw_encoder> Hardware encoder to use if FFmpeg supports it: auto,
+  ///                nvenc, vaapi, qsv, videotoolbox or none. Falls back to
+  ///                software encoding if the encoder isn't available. By
+  ///                default, the encoders allowed by the
+  ///                IGN_VIDEO_ALLOWED_ENCODERS environment variable are
+  ///                used.
+  ///
+  ///   <hw_encoder_device> Device of the hardware encoder, such as
+  ///                       /dev/dri/renderD128 for VAAPI. Optional.
+  ///
+  ///   <max_queued_frames> Frames are encoded on a background thread, so
+  ///                       that the rendering thread doesn't wait for the
+  ///                       encoder. This is the maximum number of frames
+  ///                       waiting to be encoded, beyond which frames are
+  ///                       dropped. Dropped frames are reported when the
+  ///                       recording stops. The default value is 8.
   class CameraVideoRecorder:
     public System,
     public ISystemConfigure,
@@ -15,6 +15,9 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,6 +58,29 @@ using namespace gazebo;
 using namespace systems;
 
 
+/// \brief A submesh of the world which is waiting to be exported.
+struct ColladaWorldSubMesh
+{
+  /// \brief Submesh to export, owned by the mesh manager.
+  std::shared_ptr<const common::SubMesh> subMesh;
+
+  /// \brief Mesh which holds the submesh, used to look up its material.
+  const common::Mesh *mesh{nullptr};
+
+  /// \brief Scale applied to the submesh's vertices.
+  math::Vector3d scale;
+
+  /// \brief World transform of the submesh.
+  math::Matrix4d matrix;
+
+  /// \brief Material of the visual, used when the submesh doesn't have one
+  /// of its own.
+  common::MaterialPtr material;
+
+  /// \brief Whether the submesh uses its own material from the mesh.
+  bool useMeshMaterial{false};
+};
+
 class ignition::gazebo::systems::ColladaWorldExporterPrivate
 {
   // Default constructor
@@ -63,37 +89,224 @@ class ignition::gazebo::systems::ColladaWorldExporterPrivate
   /// \brief Has the world already been exported?.
   private: bool exported{false};
 
+  /// \brief Maximum number of submeshes per exported file, zero for no
+  /// limit.
+  public: std::size_t maxSubMeshesPerFile{0u};
+
+  /// \brief Collect the submeshes of a visual.
+  /// \param[in] _entity Visual entity.
+  /// \param[in] _geom Geometry of the visual.
+  /// \param[in] _mat Material of the visual.
+  /// \param[in] _worldPose World pose of the visual.
+  /// \param[out] _subMeshes Submeshes to export, which the visual's
+  /// submeshes are appended to.
+  public: void CollectSubMeshes(const Entity _entity,
+              const sdf::Geometry &_geom, const common::MaterialPtr &_mat,
+              math::Pose3d _worldPose,
+              std::vector<ColladaWorldSubMesh> &_subMeshes) const
+  {
+    ColladaWorldSubMesh item;
+    item.material = _mat;
+    ignition::common::MeshManager *meshManager =
+        ignition::common::MeshManager::Instance();
+
+    if (_geom.Type() == sdf::GeometryType::BOX)
+    {
+      if (meshManager->HasMesh("unit_box"))
+      {
+        item.mesh = meshManager->MeshByName("unit_box");
+        item.scale = _geom.BoxShape()->Size();
+        item.subMesh = item.mesh->SubMeshByIndex(0).lock();
+      }
+    }
+    else if (_geom.Type() == sdf::GeometryType::CYLINDER)
+    {
+      if (meshManager->HasMesh("unit_cylinder"))
+      {
+        item.mesh = meshManager->MeshByName("unit_cylinder");
+        item.scale.X() = _geom.CylinderShape()->Radius() * 2;
+        item.scale.Y() = item.scale.X();
+        item.scale.Z() = _geom.CylinderShape()->Length();
+        item.subMesh = item.mesh->SubMeshByIndex(0).lock();
+      }
+    }
+    else if (_geom.Type() == sdf::GeometryType::PLANE)
+    {
+      if (meshManager->HasMesh("unit_plane"))
+      {
+        // Create a rotation for the plane mesh to account
+        // for the normal vector.
+        item.mesh = meshManager->MeshByName("unit_plane");
+
+        item.scale.X() = _geom.PlaneShape()->Size().X();
+        item.scale.Y() = _geom.PlaneShape()->Size().Y();
+
+        // // The rotation is the angle between the +z(0,0,1) vector and the
+        // // normal, which are both expressed in the local (Visual) frame.
+        math::Vector3d normal = _geom.PlaneShape()->Normal();
+        math::Quaterniond normalRot;
+        normalRot.From2Axes(math::Vector3d::UnitZ, normal.Normalized());
+        _worldPose.Rot() = _worldPose.Rot() * normalRot;
+
+        item.subMesh = item.mesh->SubMeshByIndex(0).lock();
+      }
+    }
+    else if (_geom.Type() == sdf::GeometryType::SPHERE)
+    {
+      if (meshManager->HasMesh("unit_sphere"))
+      {
+        item.mesh = meshManager->MeshByName("unit_sphere");
+
+        item.scale.X() = _geom.SphereShape()->Radius() * 2;
+        item.scale.Y() = item.scale.X();
+        item.scale.Z() = item.scale.X();
+
+        item.subMesh = item.mesh->SubMeshByIndex(0).lock();
+      }
+    }
+    else if (_geom.Type() == sdf::GeometryType::MESH)
+    {
+      auto fullPath = asFullPath(_geom.MeshShape()->Uri(),
+          _geom.MeshShape()->FilePath());
+
+      if (fullPath.empty())
+      {
+        ignerr << "Mesh geometry missing uri" << std::endl;
+        return;
+      }
+      item.mesh = meshManager->Load(fullPath);
+
+      if (!item.mesh) {
+        ignerr << "mesh not found!" << std::endl;
+        return;
+      }
+
+      const auto subMeshName = _geom.MeshShape()->Submesh();
+      item.scale = _geom.MeshShape()->Scale();
+      item.matrix = math::Matrix4d(_worldPose);
+      item.useMeshMaterial = true;
+      if(subMeshName == "")
+      {
+        for (unsigned int k = 0; k < item.mesh->SubMeshCount(); k++)
+        {
+          item.subMesh = item.mesh->SubMeshByIndex(k).lock();
+          _subMeshes.push_back(item);
+        }
+      }
+      else
+      {
+        item.subMesh = item.mesh->SubMeshByName(subMeshName).lock();
+        if (item.subMesh)
+          _subMeshes.push_back(item);
+      }
+      return;
+    }
+    else
+    {
+      ignwarn << "Unsupported geometry type for visual [" << _entity << "]"
+              << std::endl;
+    }
+
+    if (item.subMesh)
+    {
+      item.matrix = math::Matrix4d(_worldPose);
+      _subMeshes.push_back(item);
+    }
+  }
+
+  /// \brief Export a range of submeshes into a single Collada file.
+  /// \param[in] _name Name of the exported mesh and its directory.
+  /// \param[in] _begin First submesh to export.
+  /// \param[in] _end One past the last submesh to export.
+  /// \param[in] _lights Lights to export.
+  /// \param[in] _ecm Entity component manager, used to convert the
+  /// submeshes in parallel.
+  public: void ExportSubMeshes(const std::string &_name,
+              std::vector<ColladaWorldSubMesh>::const_iterator _begin,
+              std::vector<ColladaWorldSubMesh>::const_iterator _end,
+              const std::vector<common::ColladaLight> &_lights,
+              const EntityComponentManager &_ecm) const
+  {
+    const auto count = static_cast<std::size_t>(std::distance(_begin, _end));
+
+    // Copying and scaling the vertices is the bulk of the work, and each
+    // submesh is independent of the others
+    std::vector<std::unique_ptr<common::SubMesh>> copies(count);
+    _ecm.ParallelFor(count,
+        [&](std::size_t _first, std::size_t _last)
+        {
+          for (std::size_t i = _first; i < _last; ++i)
+          {
+            const auto &item = *(_begin + i);
+            copies[i] = std::make_unique<common::SubMesh>(*item.subMesh);
+            copies[i]->Scale(item.scale);
+          }
+        }, 16u);
+
+    common::Mesh worldMesh;
+    worldMesh.SetName(_name);
+    std::vector<math::Matrix4d> subMeshMatrix;
+    subMeshMatrix.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto &item = *(_begin + i);
+      int newMatIndex = 0;
+      const int matIndex = item.subMesh->MaterialIndex();
+      if (item.useMeshMaterial && matIndex != -1)
+      {
+        auto m = item.mesh->MaterialByIndex(matIndex);
+        newMatIndex = worldMesh.IndexOfMaterial(m.get());
+        if (newMatIndex < 0)
+        {
+          newMatIndex = worldMesh.AddMaterial(m);
+        }
+      }
+      else
+      {
+        newMatIndex = worldMesh.AddMaterial(item.material);
+      }
+
+      copies[i]->SetMaterialIndex(newMatIndex);
+      worldMesh.AddSubMesh(std::move(copies[i]));
+      subMeshMatrix.push_back(item.matrix);
+    }
+
+    common::ColladaExporter exporter;
+    exporter.Export(&worldMesh, "./" + worldMesh.Name(), true,
+                    subMeshMatrix, _lights);
+    ignmsg << "The world has been exported into the "
+           << "./" + worldMesh.Name() << " directory." << std::endl;
+  }
+
   /// \brief Exports the world to a mesh.
   /// \param[_ecm] _ecm Mutable reference to the EntityComponentManager.
   public: void Export(const EntityComponentManager &_ecm)
   {
     if (this->exported) return;
 
-    common::Mesh worldMesh;
-    std::vector<math::Matrix4d> subMeshMatrix;
-
+    std::string worldName;
     _ecm.Each<components::World, components::Name>(
       [&](const Entity /*& _entity*/,
         const components::World *,
         const components::Name * _name)->bool
     {
-      worldMesh.SetName(_name->Data());
+      worldName = _name->Data();
       return true;
     });
 
+    // Only references to the source submeshes are collected here. Their
+    // vertices are copied when each file is exported.
+    std::vector<ColladaWorldSubMesh> subMeshes;
     _ecm.Each<components::Visual,
             components::Name,
             components::Geometry,
             components::Transparency>(
     [&](const ignition::gazebo::Entity &_entity,
         const components::Visual *,
-        const components::Name *_name,
+        const components::Name *,
         const components::Geometry *_geom,
         const components::Transparency *_transparency)->bool
     {
-      std::string name = _name->Data().empty() ? std::to_string(_entity) :
-          _name->Data();
-
       math::Pose3d worldPose = gazebo::worldPose(_entity, _ecm);
 
       common::MaterialPtr mat = std::make_shared<common::Material>();
@@ -107,142 +320,8 @@ class ignition::gazebo::systems::ColladaWorldExporterPrivate
       }
       mat->SetTransparency(_transparency->Data());
 
-      const ignition::common::Mesh *mesh;
-      std::weak_ptr<ignition::common::SubMesh> subm;
-      math::Vector3d scale;
-      math::Matrix4d matrix(worldPose);
-      ignition::common::MeshManager *meshManager =
-          ignition::common::MeshManager::Instance();
-
-      auto addSubmeshFunc = [&](int _matIndex)
-      {
-        int newMatIndex = 0;
-        if (_matIndex != -1)
-        {
-          auto m = mesh->MaterialByIndex(_matIndex);
-          newMatIndex = worldMesh.IndexOfMaterial(m.get());
-          if (newMatIndex < 0)
-          {
-            newMatIndex = worldMesh.AddMaterial(m);
-          }
-        }
-        else
-        {
-          newMatIndex = worldMesh.AddMaterial(mat);
-        }
-
-        subm.lock()->SetMaterialIndex(newMatIndex);
-        subm.lock()->Scale(scale);
-        subMeshMatrix.push_back(matrix);
-      };
-
-      if (_geom->Data().Type() == sdf::GeometryType::BOX)
-      {
-        if (meshManager->HasMesh("unit_box"))
-        {
-          mesh = meshManager->MeshByName("unit_box");
-          scale = _geom->Data().BoxShape()->Size();
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
-        }
-      }
-      else if (_geom->Data().Type() == sdf::GeometryType::CYLINDER)
-      {
-        if (meshManager->HasMesh("unit_cylinder"))
-        {
-          mesh = meshManager->MeshByName("unit_cylinder");
-          scale.X() = _geom->Data().CylinderShape()->Radius() * 2;
-          scale.Y() = scale.X();
-          scale.Z() = _geom->Data().CylinderShape()->Length();
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
-        }
-      }
-      else if (_geom->Data().Type() == sdf::GeometryType::PLANE)
-      {
-        if (meshManager->HasMesh("unit_plane"))
-        {
-          // Create a rotation for the plane mesh to account
-          // for the normal vector.
-          mesh = meshManager->MeshByName("unit_plane");
-
-          scale.X() = _geom->Data().PlaneShape()->Size().X();
-          scale.Y() = _geom->Data().PlaneShape()->Size().Y();
-
-          // // The rotation is the angle between the +z(0,0,1) vector and the
-          // // normal, which are both expressed in the local (Visual) frame.
-          math::Vector3d normal = _geom->Data().PlaneShape()->Normal();
-          math::Quaterniond normalRot;
-          normalRot.From2Axes(math::Vector3d::UnitZ, normal.Normalized());
-          worldPose.Rot() = worldPose.Rot() * normalRot;
-
-          matrix = math::Matrix4d(worldPose);
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
-        }
-      }
-      else if (_geom->Data().Type() == sdf::GeometryType::SPHERE)
-      {
-        if (meshManager->HasMesh("unit_sphere"))
-        {
-          mesh = meshManager->MeshByName("unit_sphere");
-
-          scale.X() = _geom->Data().SphereShape()->Radius() * 2;
-          scale.Y() = scale.X();
-          scale.Z() = scale.X();
-
-          subm = worldMesh.AddSubMesh(
-              *mesh->SubMeshByIndex(0).lock().get());
-
-          addSubmeshFunc(-1);
-        }
-      }
-      else if (_geom->Data().Type() == sdf::GeometryType::MESH)
-      {
-        auto fullPath = asFullPath(_geom->Data().MeshShape()->Uri(),
-            _geom->Data().MeshShape()->FilePath());
-
-        if (fullPath.empty())
-        {
-          ignerr << "Mesh geometry missing uri" << std::endl;
-          return true;
-        }
-        mesh = meshManager->Load(fullPath);
-
-        if (!mesh) {
-          ignerr << "mesh not found!" << std::endl;
-          return true;
-        }
-
-        const auto subMeshName = _geom->Data().MeshShape()->Submesh();
-        scale = _geom->Data().MeshShape()->Scale();
-        if(subMeshName == "")
-        {
-          for (unsigned int k = 0; k < mesh->SubMeshCount(); k++)
-          {
-            auto subMeshLock = mesh->SubMeshByIndex(k).lock();
-            subm = worldMesh.AddSubMesh(*subMeshLock.get());
-            addSubmeshFunc(subMeshLock->MaterialIndex());
-          }
-        }
-        else
-        {
-          auto subMeshLock = mesh->SubMeshByName(subMeshName).lock();
-          subm = worldMesh.AddSubMesh(*subMeshLock.get());
-          addSubmeshFunc(subMeshLock->MaterialIndex());
-        }
-      }
-      else
-      {
-        ignwarn << "Unsupported geometry type" << std::endl;
-      }
-
+      this->CollectSubMeshes(_entity, _geom->Data(), mat, worldPose,
+          subMeshes);
       return true;
     });
 
@@ -292,11 +371,29 @@ class ignition::gazebo::systems::ColladaWorldExporterPrivate
       return true;
     });
 
-    common::ColladaExporter exporter;
-    exporter.Export(&worldMesh, "./" + worldMesh.Name(), true,
-                    subMeshMatrix, lights);
-    ignmsg << "The world has been exported into the "
-           << "./" + worldMesh.Name() << " directory." << std::endl;
+    // Large worlds are split into several files, so that only the vertices
+    // of one file are held in memory at a time. The lights go to the first
+    // file.
+    const std::size_t perFile = this->maxSubMeshesPerFile == 0u ?
+        subMeshes.size() : this->maxSubMeshesPerFile;
+    if (subMeshes.size() <= perFile)
+    {
+      this->ExportSubMeshes(worldName, subMeshes.cbegin(), subMeshes.cend(),
+          lights, _ecm);
+    }
+    else
+    {
+      const std::vector<common::ColladaLight> noLights;
+      std::size_t part{0u};
+      for (auto it = subMeshes.cbegin(); it != subMeshes.cend(); ++part)
+      {
+        auto last = it + std::min<std::ptrdiff_t>(perFile,
+            std::distance(it, subMeshes.cend()));
+        this->ExportSubMeshes(worldName + "_" + std::to_string(part), it,
+            last, part == 0u ? lights : noLights, _ecm);
+        it = last;
+      }
+    }
     this->exported = true;
   }
 };
@@ -310,6 +407,27 @@ ColladaWorldExporter::ColladaWorldExporter() : System(),
 /////////////////////////////////////////////////
 ColladaWorldExporter::~ColladaWorldExporter() = default;
 
+/////////////////////////////////////////////////
+void ColladaWorldExporter::Configure(const Entity & /*_entity*/,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager & /*_ecm*/, EventManager & /*_eventMgr*/)
+{
+  if (_sdf->HasElement("max_submeshes_per_file"))
+  {
+    const int maxSubMeshes = _sdf->Get<int>("max_submeshes_per_file");
+    if (maxSubMeshes < 0)
+    {
+      ignerr << "<max_submeshes_per_file> can't be negative, exporting "
+             << "the whole world into a single file." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->maxSubMeshesPerFile =
+          static_cast<std::size_t>(maxSubMeshes);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void ColladaWorldExporter::PostUpdate(const UpdateInfo & /*_info*/,
     const EntityComponentManager &_ecm)
@@ -319,6 +437,7 @@ void ColladaWorldExporter::PostUpdate(const UpdateInfo & /*_info*/,
 
 IGNITION_ADD_PLUGIN(ColladaWorldExporter,
                     System,
+                    ColladaWorldExporter::ISystemConfigure,
                     ColladaWorldExporter::ISystemPostUpdate)
 
 IGNITION_ADD_PLUGIN_ALIAS(ColladaWorldExporter,
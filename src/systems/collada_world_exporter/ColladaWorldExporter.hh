@@ -35,8 +35,18 @@ namespace systems
   /// \brief A plugin that exports a world to a mesh.
   /// When loaded the plugin will dump a mesh containing all the models in
   /// the world to the current directory.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<max_submeshes_per_file>` Maximum number of submeshes exported into
+  /// a single file. Worlds with more submeshes are split into several
+  /// files, named `<world>_0`, `<world>_1` and so on, which are written one
+  /// after the other, so that only one of them is held in memory at a time.
+  /// Lights are exported into the first file. Defaults to 0, which exports
+  /// the whole world into a single file named after the world.
   class ColladaWorldExporter:
     public System,
+    public ISystemConfigure,
     public ISystemPostUpdate
   {
     /// \brief Constructor
@@ -45,6 +55,12 @@ namespace systems
     /// \brief Destructor
     public: ~ColladaWorldExporter() final;
 
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
     // Documentation inherited
     public: void PostUpdate(const UpdateInfo &_info,
                            const EntityComponentManager &_ecm);
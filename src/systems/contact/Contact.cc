@@ -59,7 +59,7 @@ class ContactSensor
   /// \brief Add contacts to the list to be published
   /// \param[in] _stamp Time stamp of the sensor measurement
   /// \param[in] _contacts A contact message to be added to the list
-  public: void AddContacts(const std::chrono::steady_clock::duration &_stamp,
+  public: void AddContacts(const msgs::Time &_stamp,
                            const msgs::Contacts &_contacts);
 
   /// \brief Publish sensor data over ign transport
@@ -68,7 +68,8 @@ class ContactSensor
   /// \brief Topic to publish data to
   public: std::string topic;
 
-  /// \brief Message to publish
+  /// \brief Message to publish. It's cleared after publishing, which keeps
+  /// its contacts allocated, so that they're reused on the next step.
   public: msgs::Contacts contactsMsg;
 
   /// \brief Ign transport node
@@ -127,19 +128,17 @@ void ContactSensor::Load(const sdf::ElementPtr &_sdf, const std::string &_topic,
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::AddContacts(
-    const std::chrono::steady_clock::duration &_stamp,
+void ContactSensor::AddContacts(const msgs::Time &_stamp,
     const msgs::Contacts &_contacts)
 {
-  auto stamp = convert<msgs::Time>(_stamp);
   for (const auto &contact : _contacts.contact())
   {
     auto *newContact = this->contactsMsg.add_contact();
     newContact->CopyFrom(contact);
-    newContact->mutable_header()->mutable_stamp()->CopyFrom(stamp);
+    newContact->mutable_header()->mutable_stamp()->CopyFrom(_stamp);
   }
 
-  this->contactsMsg.mutable_header()->mutable_stamp()->CopyFrom(stamp);
+  this->contactsMsg.mutable_header()->mutable_stamp()->CopyFrom(_stamp);
 }
 
 //////////////////////////////////////////////////
@@ -216,8 +215,14 @@ void ContactPrivate::UpdateSensors(const UpdateInfo &_info,
                                    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("ContactPrivate::UpdateSensors");
+  bool hasStamp{false};
+  msgs::Time stamp;
   for (const auto &item : this->entitySensorMap)
   {
+    // Nobody would receive the message
+    if (!item.second->pub.HasConnections())
+      continue;
+
     for (const Entity &entity : item.second->collisionEntities)
     {
       auto contacts = _ecm.Component<components::ContactSensorData>(entity);
@@ -226,7 +231,12 @@ void ContactPrivate::UpdateSensors(const UpdateInfo &_info,
       // this entity is in the collisionEntities list
       if (contacts->Data().contact_size() > 0)
       {
-        item.second->AddContacts(_info.simTime, contacts->Data());
+        if (!hasStamp)
+        {
+          stamp = convert<msgs::Time>(_info.simTime);
+          hasStamp = true;
+        }
+        item.second->AddContacts(stamp, contacts->Data());
       }
     }
   }
@@ -105,6 +105,17 @@ void DetachableJoint::Configure(const Entity &_entity,
       "/detachable_joint/detach");
   this->topic = validTopic(topics);
 
+  std::vector<std::string> attachTopics;
+  if (_sdf->HasElement("attach_topic"))
+  {
+    attachTopics.push_back(_sdf->Get<std::string>("attach_topic"));
+  }
+  attachTopics.push_back("/model/" + this->model.Name(_ecm) +
+      "/detachable_joint/attach");
+  this->attachTopic = validTopic(attachTopics);
+
+  this->persistent = _sdf->Get<bool>("persistent", this->persistent).first;
+
   this->suppressChildWarning =
       _sdf->Get<bool>("suppress_child_warning", this->suppressChildWarning)
           .first;
@@ -141,19 +152,16 @@ void DetachableJoint::PreUpdate(
       if (kNullEntity != this->childLinkEntity)
       {
         // Attach the models
-        // We do this by creating a detachable joint entity.
-        this->detachableJointEntity = _ecm.CreateEntity();
-
-        _ecm.CreateComponent(
-            this->detachableJointEntity,
-            components::DetachableJoint({this->parentLinkEntity,
-                                         this->childLinkEntity, "fixed"}));
+        this->Attach(_ecm);
 
         this->node.Subscribe(
             this->topic, &DetachableJoint::OnDetachRequest, this);
+        this->node.Subscribe(
+            this->attachTopic, &DetachableJoint::OnAttachRequest, this);
 
         ignmsg << "DetachableJoint subscribing to messages on "
-               << "[" << this->topic << "]" << std::endl;
+               << "[" << this->topic << "] and [" << this->attachTopic << "]"
+               << std::endl;
 
         this->initialized = true;
       }
@@ -172,23 +180,79 @@ void DetachableJoint::PreUpdate(
 
   if (this->initialized)
   {
-    if (this->detachRequested && (kNullEntity != this->detachableJointEntity))
+    if (this->detachRequested && this->attached)
     {
-      // Detach the models
-      igndbg << "Removing entity: " << this->detachableJointEntity << std::endl;
-      _ecm.RequestRemoveEntity(this->detachableJointEntity);
-      this->detachableJointEntity = kNullEntity;
+      this->Detach(_ecm);
       this->detachRequested = false;
     }
+
+    if (this->attachRequested)
+    {
+      if (!this->attached)
+        this->Attach(_ecm);
+      this->attachRequested = false;
+    }
   }
 }
 
+//////////////////////////////////////////////////
+void DetachableJoint::Attach(EntityComponentManager &_ecm)
+{
+  // A persistent joint which already exists only needs to be enabled
+  if (this->persistent && kNullEntity != this->detachableJointEntity)
+  {
+    igndbg << "Enabling entity: " << this->detachableJointEntity << std::endl;
+    _ecm.SetComponentData<components::DetachableJointEnabled>(
+        this->detachableJointEntity, true);
+    this->attached = true;
+    return;
+  }
+
+  // Otherwise we attach by creating a detachable joint entity.
+  this->detachableJointEntity = _ecm.CreateEntity();
+
+  _ecm.CreateComponent(
+      this->detachableJointEntity,
+      components::DetachableJoint({this->parentLinkEntity,
+                                   this->childLinkEntity, "fixed"}));
+  if (this->persistent)
+  {
+    _ecm.CreateComponent(this->detachableJointEntity,
+        components::DetachableJointEnabled(true));
+  }
+  this->attached = true;
+}
+
+//////////////////////////////////////////////////
+void DetachableJoint::Detach(EntityComponentManager &_ecm)
+{
+  if (this->persistent)
+  {
+    igndbg << "Disabling entity: " << this->detachableJointEntity << std::endl;
+    _ecm.SetComponentData<components::DetachableJointEnabled>(
+        this->detachableJointEntity, false);
+  }
+  else
+  {
+    igndbg << "Removing entity: " << this->detachableJointEntity << std::endl;
+    _ecm.RequestRemoveEntity(this->detachableJointEntity);
+    this->detachableJointEntity = kNullEntity;
+  }
+  this->attached = false;
+}
+
 //////////////////////////////////////////////////
 void DetachableJoint::OnDetachRequest(const msgs::Empty &)
 {
   this->detachRequested = true;
 }
 
+//////////////////////////////////////////////////
+void DetachableJoint::OnAttachRequest(const msgs::Empty &)
+{
+  this->attachRequested = true;
+}
+
 IGNITION_ADD_PLUGIN(DetachableJoint,
                     ignition::gazebo::System,
                     DetachableJoint::ISystemConfigure,
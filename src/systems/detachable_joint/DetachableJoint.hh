@@ -36,7 +36,8 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace systems
 {
   /// \brief A system that initially attaches two models via a fixed joint and
-  /// allows for the models to get detached during simulation via a topic.
+  /// allows for the models to get detached and reattached during simulation
+  /// via topics.
   ///
   /// Parameters:
   ///
@@ -50,6 +51,16 @@ namespace systems
   ///
   /// - `<topic>` (optional): Topic name to be used for detaching connections
   ///
+  /// - `<attach_topic>` (optional): Topic name to be used for attaching the
+  /// links again after they were detached. Defaults to
+  /// `/model/<model_name>/detachable_joint/attach`.
+  ///
+  /// - `<persistent>` (optional): If true, the joint entity is kept for the
+  /// lifetime of the system and detaching and attaching toggle its
+  /// `DetachableJointEnabled` component, instead of removing and creating
+  /// the entity each time. This is cheaper when the links are connected and
+  /// disconnected often. Defaults to false.
+  ///
   /// - `<suppress_child_warning>` (optional): If true, the system
   /// will not print a warning message if a child model does not exist yet.
   /// Otherwise, a warning message is printed. Defaults to false.
@@ -76,6 +87,18 @@ namespace systems
     /// \brief Callback for detach request topic
     private: void OnDetachRequest(const msgs::Empty &_msg);
 
+    /// \brief Callback for attach request topic
+    private: void OnAttachRequest(const msgs::Empty &_msg);
+
+    /// \brief Attach the links, creating the joint entity if needed.
+    /// \param[in] _ecm Entity component manager.
+    private: void Attach(EntityComponentManager &_ecm);
+
+    /// \brief Detach the links, removing the joint entity unless it's
+    /// persistent.
+    /// \param[in] _ecm Entity component manager.
+    private: void Detach(EntityComponentManager &_ecm);
+
     /// \brief The model associated with this system.
     private: Model model;
 
@@ -88,6 +111,15 @@ namespace systems
     /// \brief Topic to be used for detaching connections
     private: std::string topic;
 
+    /// \brief Topic to be used for attaching connections
+    private: std::string attachTopic;
+
+    /// \brief Whether the joint entity is kept while detached
+    private: bool persistent{false};
+
+    /// \brief Whether the links are currently attached
+    private: bool attached{false};
+
     /// \brief Whether to suppress warning about missing child model.
     private: bool suppressChildWarning{false};
 
@@ -103,6 +135,9 @@ namespace systems
     /// \brief Whether detachment has been requested
     private: std::atomic<bool> detachRequested{false};
 
+    /// \brief Whether attachment has been requested
+    private: std::atomic<bool> attachRequested{false};
+
     /// \brief Ignition communication node.
     public: transport::Node node;
 
@@ -18,8 +18,10 @@
 #include "DiffDrive.hh"
 
 #include <ignition/msgs/odometry.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
 
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -32,13 +34,17 @@
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
+#include "ignition/gazebo/ComponentHandle.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/JointPosition.hh"
 #include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Link.hh"
 #include "ignition/gazebo/Model.hh"
 #include "ignition/gazebo/Util.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
@@ -55,8 +61,29 @@ struct Commands
   Commands() : lin(0.0), ang(0.0) {}
 };
 
-class ignition::gazebo::systems::DiffDrivePrivate
+/// \brief State of a single vehicle controlled by the system.
+class DiffDriveVehicle
 {
+  /// \brief Load the vehicle's parameters and set up its transport.
+  /// \param[in] _model Model entity of the vehicle.
+  /// \param[in] _sdf Parameters of the vehicle.
+  /// \param[in] _ecm The EntityComponentManager.
+  /// \param[in] _node Node used for the vehicle's subscriptions and
+  /// publishers.
+  /// \param[in] _publishTf False if the system batches the transforms of
+  /// all vehicles, so the vehicle shouldn't advertise its own.
+  /// \return True if the vehicle was loaded.
+  public: bool Load(const Entity &_model,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm, transport::Node &_node,
+    bool _publishTf);
+
+  /// \brief Find the vehicle's joints and set the wheel velocities.
+  /// \param[in] _info System update information.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm);
+
   /// \brief Callback for velocity subscription
   /// \param[in] _msg Velocity message
   public: void OnCmdVel(const ignition::msgs::Twist &_msg);
@@ -69,8 +96,11 @@ class ignition::gazebo::systems::DiffDrivePrivate
   /// \param[in] _info System update information.
   /// \param[in] _ecm The EntityComponentManager of the given simulation
   /// instance.
+  /// \param[out] _tfBatch If not null, the transform is added to this
+  /// message instead of being published on the vehicle's own topic.
   public: void UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
-    const ignition::gazebo::EntityComponentManager &_ecm);
+    const ignition::gazebo::EntityComponentManager &_ecm,
+    msgs::Pose_V *_tfBatch);
 
   /// \brief Update the linear and angular velocities.
   /// \param[in] _info System update information.
@@ -79,15 +109,18 @@ class ignition::gazebo::systems::DiffDrivePrivate
   public: void UpdateVelocity(const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &_ecm);
 
-  /// \brief Ignition communication node.
-  public: transport::Node node;
-
   /// \brief Entity of the left joint
   public: std::vector<Entity> leftJoints;
 
   /// \brief Entity of the right joint
   public: std::vector<Entity> rightJoints;
 
+  /// \brief Position of the first left joint, read for odometry.
+  public: ComponentHandle<const components::JointPosition> leftPosHandle;
+
+  /// \brief Position of the first right joint, read for odometry.
+  public: ComponentHandle<const components::JointPosition> rightPosHandle;
+
   /// \brief Name of left joint
   public: std::vector<std::string> leftJointNames;
 
@@ -155,6 +188,36 @@ class ignition::gazebo::systems::DiffDrivePrivate
   public: std::string sdfChildFrameId;
 };
 
+class ignition::gazebo::systems::DiffDrivePrivate
+{
+  /// \brief Load the vehicles whose models have been spawned.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void LoadPendingVehicles(EntityComponentManager &_ecm);
+
+  /// \brief Ignition communication node.
+  public: transport::Node node;
+
+  /// \brief Vehicles controlled by the system. They're held by pointer
+  /// because transport callbacks are bound to them.
+  public: std::vector<std::unique_ptr<DiffDriveVehicle>> vehicles;
+
+  /// \brief Vehicles which are waiting for their model to be spawned.
+  public: std::vector<WorldModelElement> pendingVehicles;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity world{kNullEntity};
+
+  /// \brief Publisher of the batched transforms of all vehicles.
+  public: transport::Node::Publisher tfBatchPub;
+
+  /// \brief Transforms of all vehicles which updated their odometry on the
+  /// current iteration. Kept as a member to reuse its memory.
+  public: msgs::Pose_V tfBatch;
+
+  /// \brief Whether transforms are batched into tfBatch.
+  public: bool batchTf{false};
+};
+
 //////////////////////////////////////////////////
 DiffDrive::DiffDrive()
   : dataPtr(std::make_unique<DiffDrivePrivate>())
@@ -162,24 +225,24 @@ DiffDrive::DiffDrive()
 }
 
 //////////////////////////////////////////////////
-void DiffDrive::Configure(const Entity &_entity,
+bool DiffDriveVehicle::Load(const Entity &_model,
     const std::shared_ptr<const sdf::Element> &_sdf,
-    EntityComponentManager &_ecm,
-    EventManager &/*_eventMgr*/)
+    EntityComponentManager &_ecm, transport::Node &_node,
+    bool _publishTf)
 {
-  this->dataPtr->model = Model(_entity);
+  this->model = Model(_model);
 
   // Get the canonical link
   std::vector<Entity> links = _ecm.ChildrenByComponents(
-      this->dataPtr->model.Entity(), components::CanonicalLink());
+      this->model.Entity(), components::CanonicalLink());
   if (!links.empty())
-    this->dataPtr->canonicalLink = Link(links[0]);
+    this->canonicalLink = Link(links[0]);
 
-  if (!this->dataPtr->model.Valid(_ecm))
+  if (!this->model.Valid(_ecm))
   {
     ignerr << "DiffDrive plugin should be attached to a model entity. "
            << "Failed to initialize." << std::endl;
-    return;
+    return false;
   }
 
   // Ugly, but needed because the sdf::Element::GetElement is not a const
@@ -190,24 +253,24 @@ void DiffDrive::Configure(const Entity &_entity,
   sdf::ElementPtr sdfElem = ptr->GetElement("left_joint");
   while (sdfElem)
   {
-    this->dataPtr->leftJointNames.push_back(sdfElem->Get<std::string>());
+    this->leftJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("left_joint");
   }
   sdfElem = ptr->GetElement("right_joint");
   while (sdfElem)
   {
-    this->dataPtr->rightJointNames.push_back(sdfElem->Get<std::string>());
+    this->rightJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("right_joint");
   }
 
-  this->dataPtr->wheelSeparation = _sdf->Get<double>("wheel_separation",
-      this->dataPtr->wheelSeparation).first;
-  this->dataPtr->wheelRadius = _sdf->Get<double>("wheel_radius",
-      this->dataPtr->wheelRadius).first;
+  this->wheelSeparation = _sdf->Get<double>("wheel_separation",
+      this->wheelSeparation).first;
+  this->wheelRadius = _sdf->Get<double>("wheel_radius",
+      this->wheelRadius).first;
 
   // Instantiate the speed limiters.
-  this->dataPtr->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
-  this->dataPtr->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
 
   // Parse speed limiter parameters.
 
@@ -215,121 +278,121 @@ void DiffDrive::Configure(const Entity &_entity,
   if (_sdf->HasElement("min_velocity"))
   {
     const double minVel = _sdf->Get<double>("min_velocity");
-    this->dataPtr->limiterLin->SetMinVelocity(minVel);
-    this->dataPtr->limiterAng->SetMinVelocity(minVel);
+    this->limiterLin->SetMinVelocity(minVel);
+    this->limiterAng->SetMinVelocity(minVel);
   }
   if (_sdf->HasElement("min_linear_velocity"))
   {
     const double minLinVel = _sdf->Get<double>("min_linear_velocity");
-    this->dataPtr->limiterLin->SetMinVelocity(minLinVel);
+    this->limiterLin->SetMinVelocity(minLinVel);
   }
   if (_sdf->HasElement("min_angular_velocity"))
   {
     const double minAngVel = _sdf->Get<double>("min_angular_velocity");
-    this->dataPtr->limiterAng->SetMinVelocity(minAngVel);
+    this->limiterAng->SetMinVelocity(minAngVel);
   }
 
   // Max Velocity
   if (_sdf->HasElement("max_velocity"))
   {
     const double maxVel = _sdf->Get<double>("max_velocity");
-    this->dataPtr->limiterLin->SetMaxVelocity(maxVel);
-    this->dataPtr->limiterAng->SetMaxVelocity(maxVel);
+    this->limiterLin->SetMaxVelocity(maxVel);
+    this->limiterAng->SetMaxVelocity(maxVel);
   }
   if (_sdf->HasElement("max_linear_velocity"))
   {
     const double maxLinVel = _sdf->Get<double>("max_linear_velocity");
-    this->dataPtr->limiterLin->SetMaxVelocity(maxLinVel);
+    this->limiterLin->SetMaxVelocity(maxLinVel);
   }
   if (_sdf->HasElement("max_angular_velocity"))
   {
     const double maxAngVel = _sdf->Get<double>("max_angular_velocity");
-    this->dataPtr->limiterAng->SetMaxVelocity(maxAngVel);
+    this->limiterAng->SetMaxVelocity(maxAngVel);
   }
 
   // Min Acceleration
   if (_sdf->HasElement("min_acceleration"))
   {
     const double minAccel = _sdf->Get<double>("min_acceleration");
-    this->dataPtr->limiterLin->SetMinAcceleration(minAccel);
-    this->dataPtr->limiterAng->SetMinAcceleration(minAccel);
+    this->limiterLin->SetMinAcceleration(minAccel);
+    this->limiterAng->SetMinAcceleration(minAccel);
   }
   if (_sdf->HasElement("min_linear_acceleration"))
   {
     const double minLinAccel = _sdf->Get<double>("min_linear_acceleration");
-    this->dataPtr->limiterLin->SetMinAcceleration(minLinAccel);
+    this->limiterLin->SetMinAcceleration(minLinAccel);
   }
   if (_sdf->HasElement("min_angular_acceleration"))
   {
     const double minAngAccel = _sdf->Get<double>("min_angular_acceleration");
-    this->dataPtr->limiterAng->SetMinAcceleration(minAngAccel);
+    this->limiterAng->SetMinAcceleration(minAngAccel);
   }
 
   // Max Acceleration
   if (_sdf->HasElement("max_acceleration"))
   {
     const double maxAccel = _sdf->Get<double>("max_acceleration");
-    this->dataPtr->limiterLin->SetMaxAcceleration(maxAccel);
-    this->dataPtr->limiterAng->SetMaxAcceleration(maxAccel);
+    this->limiterLin->SetMaxAcceleration(maxAccel);
+    this->limiterAng->SetMaxAcceleration(maxAccel);
   }
   if (_sdf->HasElement("max_linear_acceleration"))
   {
     const double maxLinAccel = _sdf->Get<double>("max_linear_acceleration");
-    this->dataPtr->limiterLin->SetMaxAcceleration(maxLinAccel);
+    this->limiterLin->SetMaxAcceleration(maxLinAccel);
   }
   if (_sdf->HasElement("max_angular_acceleration"))
   {
     const double maxAngAccel = _sdf->Get<double>("max_angular_acceleration");
-    this->dataPtr->limiterAng->SetMaxAcceleration(maxAngAccel);
+    this->limiterAng->SetMaxAcceleration(maxAngAccel);
   }
 
   // Min Jerk
   if (_sdf->HasElement("min_jerk"))
   {
     const double minJerk = _sdf->Get<double>("min_jerk");
-    this->dataPtr->limiterLin->SetMinJerk(minJerk);
-    this->dataPtr->limiterAng->SetMinJerk(minJerk);
+    this->limiterLin->SetMinJerk(minJerk);
+    this->limiterAng->SetMinJerk(minJerk);
   }
   if (_sdf->HasElement("min_linear_jerk"))
   {
     const double minLinJerk = _sdf->Get<double>("min_linear_jerk");
-    this->dataPtr->limiterLin->SetMinJerk(minLinJerk);
+    this->limiterLin->SetMinJerk(minLinJerk);
   }
   if (_sdf->HasElement("min_angular_jerk"))
   {
     const double minAngJerk = _sdf->Get<double>("min_angular_jerk");
-    this->dataPtr->limiterAng->SetMinJerk(minAngJerk);
+    this->limiterAng->SetMinJerk(minAngJerk);
   }
 
   // Max Jerk
   if (_sdf->HasElement("max_jerk"))
   {
     const double maxJerk = _sdf->Get<double>("max_jerk");
-    this->dataPtr->limiterLin->SetMaxJerk(maxJerk);
-    this->dataPtr->limiterAng->SetMaxJerk(maxJerk);
+    this->limiterLin->SetMaxJerk(maxJerk);
+    this->limiterAng->SetMaxJerk(maxJerk);
   }
   if (_sdf->HasElement("max_linear_jerk"))
   {
     const double maxLinJerk = _sdf->Get<double>("max_linear_jerk");
-    this->dataPtr->limiterLin->SetMaxJerk(maxLinJerk);
+    this->limiterLin->SetMaxJerk(maxLinJerk);
   }
   if (_sdf->HasElement("max_angular_jerk"))
   {
     const double maxAngJerk = _sdf->Get<double>("max_angular_jerk");
-    this->dataPtr->limiterAng->SetMaxJerk(maxAngJerk);
+    this->limiterAng->SetMaxJerk(maxAngJerk);
   }
 
   double odomFreq = _sdf->Get<double>("odom_publish_frequency", 50).first;
   if (odomFreq > 0)
   {
     std::chrono::duration<double> odomPer{1 / odomFreq};
-    this->dataPtr->odomPubPeriod =
+    this->odomPubPeriod =
       std::chrono::duration_cast<std::chrono::steady_clock::duration>(odomPer);
   }
 
   // Setup odometry.
-  this->dataPtr->odom.SetWheelParams(this->dataPtr->wheelSeparation,
-      this->dataPtr->wheelRadius, this->dataPtr->wheelRadius);
+  this->odom.SetWheelParams(this->wheelSeparation,
+      this->wheelRadius, this->wheelRadius);
 
   // Subscribe to commands
   std::vector<std::string> topics;
@@ -337,80 +400,70 @@ void DiffDrive::Configure(const Entity &_entity,
   {
     topics.push_back(_sdf->Get<std::string>("topic"));
   }
-  topics.push_back("/model/" + this->dataPtr->model.Name(_ecm) + "/cmd_vel");
+  topics.push_back("/model/" + this->model.Name(_ecm) + "/cmd_vel");
   auto topic = validTopic(topics);
 
-  this->dataPtr->node.Subscribe(topic, &DiffDrivePrivate::OnCmdVel,
-      this->dataPtr.get());
+  _node.Subscribe(topic, &DiffDriveVehicle::OnCmdVel, this);
 
   // Subscribe to enable/disable
   std::vector<std::string> enableTopics;
   enableTopics.push_back(
-    "/model/" + this->dataPtr->model.Name(_ecm) + "/enable");
+    "/model/" + this->model.Name(_ecm) + "/enable");
   auto enableTopic = validTopic(enableTopics);
 
   if (!enableTopic.empty())
   {
-    this->dataPtr->node.Subscribe(enableTopic, &DiffDrivePrivate::OnEnable,
-        this->dataPtr.get());
+    _node.Subscribe(enableTopic, &DiffDriveVehicle::OnEnable, this);
   }
-  this->dataPtr->enabled = true;
+  this->enabled = true;
 
   std::vector<std::string> odomTopics;
   if (_sdf->HasElement("odom_topic"))
   {
     odomTopics.push_back(_sdf->Get<std::string>("odom_topic"));
   }
-  odomTopics.push_back("/model/" + this->dataPtr->model.Name(_ecm) +
+  odomTopics.push_back("/model/" + this->model.Name(_ecm) +
       "/odometry");
   auto odomTopic = validTopic(odomTopics);
 
-  this->dataPtr->odomPub = this->dataPtr->node.Advertise<msgs::Odometry>(
-      odomTopic);
+  this->odomPub = _node.Advertise<msgs::Odometry>(odomTopic);
 
-  std::string tfTopic{"/model/" + this->dataPtr->model.Name(_ecm) +
-    "/tf"};
-  if (_sdf->HasElement("tf_topic"))
-    tfTopic = _sdf->Get<std::string>("tf_topic");
-  this->dataPtr->tfPub = this->dataPtr->node.Advertise<msgs::Pose_V>(
-      tfTopic);
+  if (_publishTf)
+  {
+    std::string tfTopic{"/model/" + this->model.Name(_ecm) +
+      "/tf"};
+    if (_sdf->HasElement("tf_topic"))
+      tfTopic = _sdf->Get<std::string>("tf_topic");
+    this->tfPub = _node.Advertise<msgs::Pose_V>(tfTopic);
+  }
 
   if (_sdf->HasElement("frame_id"))
-    this->dataPtr->sdfFrameId = _sdf->Get<std::string>("frame_id");
+    this->sdfFrameId = _sdf->Get<std::string>("frame_id");
 
   if (_sdf->HasElement("child_frame_id"))
-    this->dataPtr->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
+    this->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
 
   ignmsg << "DiffDrive subscribing to twist messages on [" << topic << "]"
          << std::endl;
+  return true;
 }
 
 //////////////////////////////////////////////////
-void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
-    ignition::gazebo::EntityComponentManager &_ecm)
+void DiffDriveVehicle::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("DiffDrive::PreUpdate");
-
-  // \TODO(anyone) Support rewind
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
-  {
-    ignwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
-  }
-
   // If the joints haven't been identified yet, look for them
   static std::set<std::string> warnedModels;
-  auto modelName = this->dataPtr->model.Name(_ecm);
-  if (this->dataPtr->leftJoints.empty() ||
-      this->dataPtr->rightJoints.empty())
+  auto modelName = this->model.Name(_ecm);
+  if (this->leftJoints.empty() ||
+      this->rightJoints.empty())
   {
     bool warned{false};
-    for (const std::string &name : this->dataPtr->leftJointNames)
+    for (const std::string &name : this->leftJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->leftJoints.push_back(joint);
+        this->leftJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find left joint [" << name << "] for model ["
@@ -419,11 +472,11 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->rightJointNames)
+    for (const std::string &name : this->rightJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->rightJoints.push_back(joint);
+        this->rightJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find right joint [" << name << "] for model ["
@@ -437,7 +490,7 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     }
   }
 
-  if (this->dataPtr->leftJoints.empty() || this->dataPtr->rightJoints.empty())
+  if (this->leftJoints.empty() || this->rightJoints.empty())
     return;
 
   if (warnedModels.find(modelName) != warnedModels.end())
@@ -451,7 +504,7 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  for (Entity joint : this->dataPtr->leftJoints)
+  for (Entity joint : this->leftJoints)
   {
     // skip this entity if it has been removed
     if (!_ecm.HasEntity(joint))
@@ -463,15 +516,15 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(
-          joint, components::JointVelocityCmd({this->dataPtr->leftJointSpeed}));
+          joint, components::JointVelocityCmd({this->leftJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->leftJointSpeed});
+      *vel = components::JointVelocityCmd({this->leftJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->rightJoints)
+  for (Entity joint : this->rightJoints)
   {
     // skip this entity if it has been removed
     if (!_ecm.HasEntity(joint))
@@ -483,33 +536,96 @@ void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->rightJointSpeed}));
+          components::JointVelocityCmd({this->rightJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->rightJointSpeed});
+      *vel = components::JointVelocityCmd({this->rightJointSpeed});
     }
   }
 
   // Create the left and right side joint position components if they
   // don't exist.
   auto leftPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->leftJoints[0]);
-  if (!leftPos && _ecm.HasEntity(this->dataPtr->leftJoints[0]))
+      this->leftJoints[0]);
+  if (!leftPos && _ecm.HasEntity(this->leftJoints[0]))
   {
-    _ecm.CreateComponent(this->dataPtr->leftJoints[0],
+    _ecm.CreateComponent(this->leftJoints[0],
         components::JointPosition());
   }
 
   auto rightPos = _ecm.Component<components::JointPosition>(
-      this->dataPtr->rightJoints[0]);
-  if (!rightPos && _ecm.HasEntity(this->dataPtr->rightJoints[0]))
+      this->rightJoints[0]);
+  if (!rightPos && _ecm.HasEntity(this->rightJoints[0]))
   {
-    _ecm.CreateComponent(this->dataPtr->rightJoints[0],
+    _ecm.CreateComponent(this->rightJoints[0],
         components::JointPosition());
   }
 }
 
+//////////////////////////////////////////////////
+void DiffDrive::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  // When attached to the world, the system controls every <vehicle>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->world = _entity;
+    if (_sdf->HasElement("tf_topic"))
+    {
+      this->dataPtr->batchTf = true;
+      this->dataPtr->tfBatchPub = this->dataPtr->node.Advertise<msgs::Pose_V>(
+          _sdf->Get<std::string>("tf_topic"));
+    }
+
+    this->dataPtr->pendingVehicles = worldModelElements(_sdf, "vehicle",
+        "DiffDrive");
+    this->dataPtr->LoadPendingVehicles(_ecm);
+    return;
+  }
+
+  auto vehicle = std::make_unique<DiffDriveVehicle>();
+  if (vehicle->Load(_entity, _sdf, _ecm, this->dataPtr->node, true))
+    this->dataPtr->vehicles.push_back(std::move(vehicle));
+}
+
+//////////////////////////////////////////////////
+void DiffDrivePrivate::LoadPendingVehicles(EntityComponentManager &_ecm)
+{
+  loadSpawnedModels(_ecm, this->world, this->pendingVehicles,
+      [&](const Entity &_model, const sdf::ElementPtr &_sdf)
+      {
+        auto vehicle = std::make_unique<DiffDriveVehicle>();
+        if (vehicle->Load(_model, _sdf, _ecm, this->node, !this->batchTf))
+          this->vehicles.push_back(std::move(vehicle));
+      });
+}
+
+//////////////////////////////////////////////////
+void DiffDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
+    ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("DiffDrive::PreUpdate");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // When attached to the world, models may be spawned after the system is
+  // loaded
+  if (!this->dataPtr->pendingVehicles.empty())
+    this->dataPtr->LoadPendingVehicles(_ecm);
+
+  for (auto &vehicle : this->dataPtr->vehicles)
+    vehicle->PreUpdate(_info, _ecm);
+}
+
 //////////////////////////////////////////////////
 void DiffDrive::PostUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
@@ -519,13 +635,32 @@ void DiffDrive::PostUpdate(const UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  this->dataPtr->UpdateVelocity(_info, _ecm);
-  this->dataPtr->UpdateOdometry(_info, _ecm);
+  msgs::Pose_V *tfBatch{nullptr};
+  if (this->dataPtr->batchTf)
+  {
+    tfBatch = &this->dataPtr->tfBatch;
+    tfBatch->clear_pose();
+  }
+
+  for (auto &vehicle : this->dataPtr->vehicles)
+  {
+    vehicle->UpdateVelocity(_info, _ecm);
+    vehicle->UpdateOdometry(_info, _ecm, tfBatch);
+  }
+
+  if (tfBatch && tfBatch->pose_size() > 0)
+  {
+    tfBatch->mutable_header()->mutable_stamp()->CopyFrom(
+        convert<msgs::Time>(_info.simTime));
+    this->dataPtr->tfBatchPub.Publish(*tfBatch);
+  }
 }
 
 //////////////////////////////////////////////////
-void DiffDrivePrivate::UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
-    const ignition::gazebo::EntityComponentManager &_ecm)
+void DiffDriveVehicle::UpdateOdometry(
+    const ignition::gazebo::UpdateInfo &_info,
+    const ignition::gazebo::EntityComponentManager &_ecm,
+    msgs::Pose_V *_tfBatch)
 {
   IGN_PROFILE("DiffDrive::UpdateOdometry");
   // Initialize, if not already initialized.
@@ -538,10 +673,20 @@ void DiffDrivePrivate::UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
   if (this->leftJoints.empty() || this->rightJoints.empty())
     return;
 
-  // Get the first joint positions for the left and right side.
-  auto leftPos = _ecm.Component<components::JointPosition>(this->leftJoints[0]);
-  auto rightPos = _ecm.Component<components::JointPosition>(
-      this->rightJoints[0]);
+  // Get the first joint positions for the left and right side. They're read
+  // on every step, so keep handles to them.
+  if (this->leftPosHandle.Owner() != this->leftJoints[0])
+  {
+    this->leftPosHandle =
+        _ecm.Handle<components::JointPosition>(this->leftJoints[0]);
+  }
+  if (this->rightPosHandle.Owner() != this->rightJoints[0])
+  {
+    this->rightPosHandle =
+        _ecm.Handle<components::JointPosition>(this->rightJoints[0]);
+  }
+  auto leftPos = this->leftPosHandle.Get();
+  auto rightPos = this->rightPosHandle.Get();
 
   // Abort if the joints were not found or just created.
   if (!leftPos || !rightPos || leftPos->Data().empty() ||
@@ -608,18 +753,21 @@ void DiffDrivePrivate::UpdateOdometry(const ignition::gazebo::UpdateInfo &_info,
 
   // Construct the Pose_V/tf message and publish it.
   msgs::Pose_V tfMsg;
-  ignition::msgs::Pose *tfMsgPose = tfMsg.add_pose();
+  msgs::Pose_V *tfTarget = _tfBatch ? _tfBatch : &tfMsg;
+  ignition::msgs::Pose *tfMsgPose = tfTarget->add_pose();
   tfMsgPose->mutable_header()->CopyFrom(*msg.mutable_header());
   tfMsgPose->mutable_position()->CopyFrom(msg.mutable_pose()->position());
   tfMsgPose->mutable_orientation()->CopyFrom(msg.mutable_pose()->orientation());
 
   // Publish the messages
   this->odomPub.Publish(msg);
-  this->tfPub.Publish(tfMsg);
+  if (!_tfBatch)
+    this->tfPub.Publish(tfMsg);
 }
 
 //////////////////////////////////////////////////
-void DiffDrivePrivate::UpdateVelocity(const ignition::gazebo::UpdateInfo &_info,
+void DiffDriveVehicle::UpdateVelocity(
+    const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &/*_ecm*/)
 {
   IGN_PROFILE("DiffDrive::UpdateVelocity");
@@ -651,7 +799,7 @@ void DiffDrivePrivate::UpdateVelocity(const ignition::gazebo::UpdateInfo &_info,
 }
 
 //////////////////////////////////////////////////
-void DiffDrivePrivate::OnCmdVel(const msgs::Twist &_msg)
+void DiffDriveVehicle::OnCmdVel(const msgs::Twist &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
   if (this->enabled)
@@ -661,7 +809,7 @@ void DiffDrivePrivate::OnCmdVel(const msgs::Twist &_msg)
 }
 
 //////////////////////////////////////////////////
-void DiffDrivePrivate::OnEnable(const msgs::Boolean &_msg)
+void DiffDriveVehicle::OnEnable(const msgs::Boolean &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
   this->enabled = _msg.data();
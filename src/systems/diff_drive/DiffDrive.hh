@@ -129,6 +129,24 @@ namespace systems
   ///
   /// `<max_angular_jerk>`: Sets the maximum angular jerk. Overrides
   /// `<max_jerk>` if set.
+  ///
+  /// # Fleet mode
+  ///
+  /// When attached to a world instead of a model, a single instance of the
+  /// system controls a whole fleet of vehicles, which are all updated in
+  /// one pass, instead of loading one system per vehicle. Each vehicle is
+  /// described by a `<vehicle>` element, which takes all the parameters
+  /// above plus:
+  ///
+  /// `<model_name>`: Name of the top level model of the vehicle.
+  ///
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned. The world level also takes:
+  ///
+  /// `<tf_topic>`: Optional topic on which the transforms of all vehicles
+  /// which updated their odometry on an iteration are published together,
+  /// in a single `ignition.msgs.Pose_V` message. When set, vehicles don't
+  /// publish transforms on their own topics.
   class DiffDrive
       : public System,
         public ISystemConfigure,
@@ -32,6 +32,7 @@
 #include "ElevatorStateMachine.hh"
 #include "utils/DoorTimer.hh"
 #include "utils/JointMonitor.hh"
+#include "utils/SystemWakeup.hh"
 
 #include <ignition/msgs/double.pb.h>
 #include <ignition/msgs/int32.pb.h>
@@ -106,6 +107,10 @@ class ElevatorPrivate : public ElevatorCommonPrivate
   public: void UpdateState(const ignition::gazebo::UpdateInfo &_info,
                            const EntityComponentManager &_ecm);
 
+  /// \brief Arms the wake conditions for the timer and monitors which are
+  /// running, and for the next state publication
+  public: void ScheduleWakeup();
+
   /// \brief Callback for the door lidar scans
   /// \param[in] _floorLevel Floor level
   /// \param[in] _msg Laserscan message
@@ -142,6 +147,11 @@ class ElevatorPrivate : public ElevatorCommonPrivate
   /// level
   public: JointMonitor cabinJointMonitor;
 
+  /// \brief Wakes the system when commands or lidar events are received,
+  /// when a monitored joint moves or when a timer is due, so that idle
+  /// elevators skip their updates
+  public: SystemWakeup wakeup;
+
   /// \brief System update period calculated from <update_rate>
   public: std::chrono::steady_clock::duration updatePeriod{0};
 
@@ -250,11 +260,15 @@ void Elevator::PostUpdate(const UpdateInfo &_info,
   this->dataPtr->lastUpdateTime = _info.simTime;
 
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->wakeup.Due(_info, _ecm))
+    return;
+
   this->dataPtr->UpdateState(_info, _ecm);
   this->dataPtr->doorTimer->Update(
       _info, this->dataPtr->isDoorwayBlockedStates[this->dataPtr->state]);
   this->dataPtr->doorJointMonitor.Update(_ecm);
   this->dataPtr->cabinJointMonitor.Update(_ecm);
+  this->dataPtr->ScheduleWakeup();
 }
 
 //////////////////////////////////////////////////
@@ -370,6 +384,7 @@ void ElevatorPrivate::StartDoorTimer(
 {
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
   this->doorTimer->Configure(this->lastUpdateTime, _timeoutCallback);
+  this->wakeup.Notify();
 }
 
 //////////////////////////////////////////////////
@@ -381,6 +396,7 @@ void ElevatorPrivate::SetDoorMonitor(
   this->doorJointMonitor.Configure(this->doorJoints[_floorTarget], _jointTarget,
                                    _posEps, _velEps,
                                    _jointTargetReachedCallback);
+  this->wakeup.Notify();
 }
 
 //////////////////////////////////////////////////
@@ -391,6 +407,7 @@ void ElevatorPrivate::SetCabinMonitor(
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
   this->cabinJointMonitor.Configure(this->cabinJoint, _jointTarget, _posEps,
                                     _velEps, _jointTargetReachedCallback);
+  this->wakeup.Notify();
 }
 
 //////////////////////////////////////////////////
@@ -418,6 +435,33 @@ void ElevatorPrivate::UpdateState(const ignition::gazebo::UpdateInfo &_info,
   this->statePub.Publish(this->stateMsg);
 }
 
+//////////////////////////////////////////////////
+void ElevatorPrivate::ScheduleWakeup()
+{
+  // While the doorway is blocked the timer doesn't run, and the lidar wakes
+  // the system once it's unblocked
+  if (this->doorTimer->IsActive() &&
+      !this->isDoorwayBlockedStates[this->state])
+  {
+    this->wakeup.WakeAt(this->doorTimer->TimeoutTime());
+  }
+
+  // Joint positions change on every step while the joints move, so the
+  // monitors are checked at the update rate until their targets are reached
+  if (this->doorJointMonitor.IsActive())
+  {
+    this->wakeup.Watch(this->doorJointMonitor.Joint(),
+                       components::JointPosition::typeId);
+  }
+  if (this->cabinJointMonitor.IsActive())
+  {
+    this->wakeup.Watch(this->cabinJointMonitor.Joint(),
+                       components::JointPosition::typeId);
+  }
+
+  this->wakeup.WakeAt(this->lastStatePubTime + this->statePubPeriod);
+}
+
 //////////////////////////////////////////////////
 void ElevatorPrivate::OnLidarMsg(size_t _floorLevel,
                                  const msgs::LaserScan &_msg)
@@ -426,6 +470,7 @@ void ElevatorPrivate::OnLidarMsg(size_t _floorLevel,
   if (isDoorwayBlocked == this->isDoorwayBlockedStates[_floorLevel]) return;
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
   this->isDoorwayBlockedStates[_floorLevel] = isDoorwayBlocked;
+  this->wakeup.Notify();
 }
 
 //////////////////////////////////////////////////
@@ -439,6 +484,7 @@ void ElevatorPrivate::OnCmdMsg(const msgs::Int32 &_msg)
     return;
   }
   this->stateMachine->process_event(events::EnqueueNewTarget(_msg.data()));
+  this->wakeup.Notify();
 }
 
 IGNITION_ADD_PLUGIN(Elevator, System, Elevator::ISystemConfigure,
@@ -68,6 +68,13 @@ class ElevatorPrivate;
 /// doorway is blocked. The lidar publishes sensor data on topic
 /// `/model/{model_name}/{door_joint_name}/lidar`
 ///
+/// ## Idle elevators
+///
+/// The system only runs when it has work to do: when it receives a command
+/// or a change in a doorway's lidar, while a door or the cabin is moving
+/// towards its target, when the door timer is due and when the state is due
+/// to be published. On other updates it doesn't read any component.
+///
 /// ## System Parameters
 ///
 /// `<update_rate>`: System update rate. This element is optional and the
@@ -99,6 +99,18 @@ void DoorTimer::Update(const UpdateInfo &_info, bool _isDoorwayBlocked)
   this->dataPtr->timeoutCallback();
 }
 
+//////////////////////////////////////////////////
+bool DoorTimer::IsActive() const
+{
+  return this->dataPtr->isActive;
+}
+
+//////////////////////////////////////////////////
+std::chrono::steady_clock::duration DoorTimer::TimeoutTime() const
+{
+  return this->dataPtr->timeoutTime;
+}
+
 }  // namespace systems
 }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 }  // namespace gazebo
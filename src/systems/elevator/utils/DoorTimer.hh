@@ -68,6 +68,15 @@ class DoorTimer
   /// blocked
   public: void Update(const UpdateInfo &_info, bool _isDoorwayBlocked);
 
+  /// \brief Checks whether the timer is running
+  /// \return True if the timer was started and hasn't timed out yet
+  public: bool IsActive() const;
+
+  /// \brief Gets the time at which the timer times out, unless the doorway
+  /// is blocked
+  /// \return Timeout time
+  public: std::chrono::steady_clock::duration TimeoutTime() const;
+
   /// \brief Private data pointer
   private: std::unique_ptr<DoorTimerPrivate> dataPtr;
 };
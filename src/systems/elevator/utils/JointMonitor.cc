@@ -96,6 +96,18 @@ void JointMonitor::Update(const EntityComponentManager &_ecm)
   this->dataPtr->targetReachedCallback();
 }
 
+//////////////////////////////////////////////////
+bool JointMonitor::IsActive() const
+{
+  return this->dataPtr->isActive;
+}
+
+//////////////////////////////////////////////////
+Entity JointMonitor::Joint() const
+{
+  return this->dataPtr->joint;
+}
+
 }  // namespace systems
 }  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 }  // namespace gazebo
@@ -67,6 +67,15 @@ class JointMonitor
   /// \param[in] _ecm Entity component manager
   public: void Update(const EntityComponentManager &_ecm);
 
+  /// \brief Checks whether the monitor is waiting for the joint to reach its
+  /// target
+  /// \return True if the monitor is active
+  public: bool IsActive() const;
+
+  /// \brief Gets the joint under monitoring
+  /// \return Joint entity
+  public: Entity Joint() const;
+
   /// \brief Private data pointer
   private: std::unique_ptr<JointMonitorPrivate> dataPtr;
 };
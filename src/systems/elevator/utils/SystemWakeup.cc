@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SystemWakeup.hh"
+
+#include <ignition/gazebo/EntityComponentManager.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+{
+namespace systems
+{
+class SystemWakeupPrivate
+{
+  /// \brief Flag set by Notify. The first update always wakes the system.
+  public: std::atomic<bool> notified{true};
+
+  /// \brief Flag to indicate whether a wake time is scheduled
+  public: bool isScheduled{false};
+
+  /// \brief Scheduled wake time
+  public: std::chrono::steady_clock::duration wakeTime{0};
+
+  /// \brief Watched components
+  public: std::vector<std::pair<Entity, ComponentTypeId>> watched;
+
+  /// \brief Change tick when the system was last woken
+  public: uint64_t tick{0u};
+
+  /// \brief Simulation time when the system was last checked
+  public: std::chrono::steady_clock::duration lastSimTime{0};
+};
+
+//////////////////////////////////////////////////
+SystemWakeup::SystemWakeup()
+    : dataPtr(std::make_unique<SystemWakeupPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+SystemWakeup::~SystemWakeup() = default;
+
+//////////////////////////////////////////////////
+void SystemWakeup::Notify()
+{
+  this->dataPtr->notified = true;
+}
+
+//////////////////////////////////////////////////
+void SystemWakeup::WakeAt(const std::chrono::steady_clock::duration &_simTime)
+{
+  if (this->dataPtr->isScheduled && this->dataPtr->wakeTime <= _simTime)
+    return;
+  this->dataPtr->isScheduled = true;
+  this->dataPtr->wakeTime = _simTime;
+}
+
+//////////////////////////////////////////////////
+void SystemWakeup::Watch(Entity _entity, ComponentTypeId _typeId)
+{
+  this->dataPtr->watched.emplace_back(_entity, _typeId);
+}
+
+//////////////////////////////////////////////////
+bool SystemWakeup::Due(const UpdateInfo &_info,
+                       const EntityComponentManager &_ecm)
+{
+  bool due = this->dataPtr->notified.exchange(false) ||
+      _info.simTime < this->dataPtr->lastSimTime ||
+      (this->dataPtr->isScheduled && _info.simTime >= this->dataPtr->wakeTime);
+  this->dataPtr->lastSimTime = _info.simTime;
+
+  for (auto it = this->dataPtr->watched.begin();
+       !due && it != this->dataPtr->watched.end(); ++it)
+  {
+    due = _ecm.ComponentChangeTick(it->first, it->second) >
+        this->dataPtr->tick;
+  }
+  if (!due)
+    return false;
+
+  this->dataPtr->isScheduled = false;
+  this->dataPtr->watched.clear();
+  this->dataPtr->tick = _ecm.ChangeTick();
+  return true;
+}
+
+}  // namespace systems
+}  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+}  // namespace gazebo
+}  // namespace ignition
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef IGNITION_GAZEBO_SYSTEMS_SYSTEM_WAKEUP_HH_
+#define IGNITION_GAZEBO_SYSTEMS_SYSTEM_WAKEUP_HH_
+
+#include <chrono>
+#include <memory>
+
+#include <ignition/gazebo/System.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+{
+namespace systems
+{
+// Data forward declaration
+class SystemWakeupPrivate;
+
+/// \brief Decides when an event driven system, such as one running a state
+/// machine, has work to do, so that it can skip the updates in between.
+///
+/// The system is woken by any of:
+/// * A call to Notify, usually from a transport callback which fed an
+///   event to the state machine.
+/// * A simulation time scheduled with WakeAt being reached.
+/// * A component registered with Watch being marked as changed.
+///
+/// Wake conditions are one shot: once Due returns true, the scheduled time
+/// and the watched components are cleared, and the system arms the
+/// conditions it's waiting on again after handling the update. The first
+/// update, and any update after simulation time goes back, always wakes the
+/// system.
+class SystemWakeup
+{
+  /// \brief Constructor
+  public: SystemWakeup();
+
+  /// \brief Destructor
+  public: ~SystemWakeup();
+
+  /// \brief Wake the system on its next update. This can be called from
+  /// any thread.
+  public: void Notify();
+
+  /// \brief Wake the system once simulation time reaches the given time. If
+  /// a time is already scheduled, the earliest one is kept.
+  /// \param[in] _simTime Simulation time
+  public: void WakeAt(const std::chrono::steady_clock::duration &_simTime);
+
+  /// \brief Wake the system when a component is created, removed or marked
+  /// as changed. Note that components which are changed periodically, such
+  /// as joint positions updated by physics, wake the system on every update,
+  /// so they should only be watched while their values matter.
+  /// \param[in] _entity Entity that contains the component
+  /// \param[in] _typeId Component type ID
+  public: void Watch(Entity _entity, ComponentTypeId _typeId);
+
+  /// \brief Checks whether the system should handle the current update, and
+  /// clears the wake conditions if so.
+  /// \param[in] _info Current simulation step info
+  /// \param[in] _ecm Entity component manager
+  /// \return True if the system was woken
+  public: bool Due(const UpdateInfo &_info,
+                   const EntityComponentManager &_ecm);
+
+  /// \brief Private data pointer
+  private: std::unique_ptr<SystemWakeupPrivate> dataPtr;
+};
+
+}  // namespace systems
+}  // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
+}  // namespace gazebo
+}  // namespace ignition
+
+#endif  // IGNITION_GAZEBO_SYSTEMS_SYSTEM_WAKEUP_HH_
@@ -89,8 +89,10 @@ class ignition::gazebo::systems::ForceTorquePrivate
   public: void CreateForceTorqueEntities(EntityComponentManager &_ecm);
 
   /// \brief Update FT sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  public: void Update(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove FT sensors if their entities have been removed from
   /// simulation.
@@ -132,30 +134,8 @@ void ForceTorque::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the ForceTorquePrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->Update(_info, _ecm);
   }
 
   this->dataPtr->RemoveForceTorqueEntities(_ecm);
@@ -274,7 +254,8 @@ void ForceTorquePrivate::CreateForceTorqueEntities(EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void ForceTorquePrivate::Update(const EntityComponentManager &_ecm)
+void ForceTorquePrivate::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("ForceTorquePrivate::Update");
   _ecm.Each<components::ForceTorque>(
@@ -283,6 +264,13 @@ void ForceTorquePrivate::Update(const EntityComponentManager &_ecm)
         auto it = this->entitySensorMap.find(_entity);
         if (it != this->entitySensorMap.end())
         {
+          // Skip sensors which aren't due or have no subscribers
+          if (it->second->NextDataUpdateTime() > _info.simTime ||
+              !it->second->HasConnections())
+          {
+            return true;
+          }
+
           auto jointLinkIt = this->sensorJointLinkMap.find(_entity);
           if (jointLinkIt == this->sensorJointLinkMap.end())
           {
@@ -302,8 +290,8 @@ void ForceTorquePrivate::Update(const EntityComponentManager &_ecm)
           // X_SP: Pose of parent link in sensors frame
           // X_SC: Pose of child link in sensors frame
           const auto X_WP =
-              worldPose(jointLinkIt->second.jointParentLink, _ecm);
-          const auto X_WC = worldPose(jointLinkIt->second.jointChildLink, _ecm);
+              _ecm.WorldPose(jointLinkIt->second.jointParentLink);
+          const auto X_WC = _ecm.WorldPose(jointLinkIt->second.jointChildLink);
           // There appears to be a bug worldPose for computing poses of //joint
           // and its children, so we do it manually here.
           const auto X_CJ =
@@ -328,6 +316,8 @@ void ForceTorquePrivate::Update(const EntityComponentManager &_ecm)
           it->second->SetForce(force);
           it->second->SetTorque(torque);
           it->second->SetRotationParentInSensor(X_SP.Rot());
+
+          it->second->sensors::Sensor::Update(_info.simTime, false);
         }
         else
         {
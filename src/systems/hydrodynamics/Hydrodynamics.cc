@@ -14,7 +14,11 @@
  * limitations under the License.
  *
  */
+#include <cmath>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <Eigen/Eigen>
 
@@ -35,67 +39,82 @@
 
 #include "Hydrodynamics.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
-/// \brief Private Hydrodynamics data class.
-class ignition::gazebo::systems::HydrodynamicsPrivateData
-{
-  /// \brief Values to set via Plugin Parameters.
-  /// Plugin Parameter: Added mass in surge, X_\dot{u}.
-  public: double paramXdotU;
-
-  /// \brief Plugin Parameter: Added mass in sway, Y_\dot{v}.
-  public: double paramYdotV;
-
-  /// \brief Plugin Parameter: Added mass in heave, Z_\dot{w}.
-  public: double paramZdotW;
+/// \brief Vector holding one value per degree of freedom, in the order
+/// [surge, sway, heave, roll, pitch, yaw].
+using Vector6d = Eigen::Matrix<double, 6, 1>;
 
-  /// \brief Plugin Parameter: Added mass in roll, K_\dot{p}.
-  public: double paramKdotP;
-
-  /// \brief Plugin Parameter: Added mass in pitch, M_\dot{q}.
-  public: double paramMdotQ;
-
-  /// \brief Plugin Parameter: Added mass in yaw, N_\dot{r}.
-  public: double paramNdotR;
-
-  /// \brief Plugin Parameter: Linear drag in surge.
-  public: double paramXu;
+/// \brief A body subject to hydrodynamic forces.
+struct HydrodynamicsBody
+{
+  /// \brief Added mass in each degree of freedom, i.e. X_\dot{u}, Y_\dot{v},
+  /// Z_\dot{w}, K_\dot{p}, M_\dot{q} and N_\dot{r}. The added mass matrix is
+  /// diagonal, see: https://en.wikipedia.org/wiki/Added_mass
+  Vector6d addedMass;
 
-  /// \brief Plugin Parameter: Quadratic drag in surge.
-  public: double paramXuu;
+  /// \brief Linear drag in each degree of freedom.
+  Vector6d linearDrag;
 
-  /// \brief Plugin Parameter: Linear drag in sway.
-  public: double paramYv;
+  /// \brief Quadratic drag in each degree of freedom.
+  Vector6d quadraticDrag;
 
-  /// \brief Plugin Parameter: Quadratic drag in sway.
-  public: double paramYvv;
+  /// \brief Previous state.
+  Vector6d prevState{Vector6d::Zero()};
 
-  /// \brief Plugin Parameter: Linear drag in heave.
-  public: double paramZw;
+  /// \brief Ocean current experienced by this body
+  public: math::Vector3d currentVector {0, 0, 0};
 
-  /// \brief Plugin Parameter: Quadratic drag in heave.
-  public: double paramZww;
+  /// \brief Name of the model, used to find the link when the system is
+  /// attached to the world.
+  public: std::string modelName;
 
-  /// \brief Plugin Parameter: Linear drag in roll.
-  public: double paramKp;
+  /// \brief Name of the link.
+  public: std::string linkName;
 
-  /// \brief Plugin Parameter: Quadratic drag in roll.
-  public: double paramKpp;
+  /// \brief Link entity, null until found.
+  public: Entity linkEntity{kNullEntity};
 
-  /// \brief Plugin Parameter: Linear drag in pitch.
-  public: double paramMq;
+  /// \brief Force computed on the current iteration, in the world frame.
+  public: math::Vector3d force;
 
-  /// \brief Plugin Parameter: Quadratic drag in pitch.
-  public: double paramMqq;
+  /// \brief Torque computed on the current iteration, in the world frame.
+  public: math::Vector3d torque;
 
-  /// \brief Plugin Parameter: Linear drag in yaw.
-  public: double paramNr;
+  /// \brief Whether force and torque should be applied on this iteration.
+  public: bool apply{false};
+};
 
-  /// \brief Plugin Parameter: Quadratic drag in yaw.
-  public: double paramNrr;
+/// \brief Private Hydrodynamics data class.
+class ignition::gazebo::systems::HydrodynamicsPrivateData
+{
+  /// \brief Load the parameters of a body.
+  /// \param[in] _sdf Element holding the body's parameters.
+  /// \return The body.
+  public: static HydrodynamicsBody LoadBody(
+      const std::shared_ptr<const sdf::Element> &_sdf);
+
+  /// \brief Subscribe a body to the ocean current of its namespace.
+  /// \param[in] _sdf Element holding the body's parameters.
+  /// \param[in] _index Index of the body.
+  public: void SubscribeCurrent(
+      const std::shared_ptr<const sdf::Element> &_sdf, std::size_t _index);
+
+  /// \brief Find the link of bodies which don't have one yet, and create the
+  /// components that the system needs on it.
+  /// \param[in] _ecm Entity component manager.
+  public: void FindLinks(EntityComponentManager &_ecm);
+
+  /// \brief Compute the hydrodynamic wrench on a body.
+  /// \param[in,out] _body Body, whose wrench and state are updated.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _dt Time step in seconds.
+  public: static void ComputeWrench(HydrodynamicsBody &_body,
+      const EntityComponentManager &_ecm, double _dt);
 
   /// \brief Water density [kg/m^3].
   public: double waterDensity;
@@ -103,31 +122,39 @@ class ignition::gazebo::systems::HydrodynamicsPrivateData
   /// \brief The ignition transport node
   public: transport::Node node;
 
-  /// \brief Ocean current experienced by this body
-  public: math::Vector3d currentVector {0, 0, 0};
+  /// \brief Bodies subject to hydrodynamic forces. There's a single one when
+  /// the system is attached to a model.
+  public: std::vector<HydrodynamicsBody> bodies;
 
-  /// \brief Added mass of vehicle;
-  /// See: https://en.wikipedia.org/wiki/Added_mass
-  public: Eigen::MatrixXd Ma;
+  /// \brief Indices of the bodies listening to each ocean current topic.
+  public: std::map<std::string, std::vector<std::size_t>> currentTopics;
 
-  /// \brief Previous state.
-  public: Eigen::VectorXd prevState;
+  /// \brief Ocean current received on each topic, copied into the bodies
+  /// on the next iteration. Protected by mtx.
+  public: std::map<std::string, math::Vector3d> receivedCurrents;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity worldEntity{kNullEntity};
 
-  /// \brief Link entity
-  public: Entity linkEntity;
+  /// \brief Number of bodies whose link hasn't been found yet.
+  public: std::size_t pendingLinks{0u};
 
   /// \brief Ocean current callback
-  public: void UpdateCurrent(const msgs::Vector3d &_msg);
+  /// \param[in] _topic Topic on which the current was received.
+  /// \param[in] _msg Current.
+  public: void UpdateCurrent(const std::string &_topic,
+      const msgs::Vector3d &_msg);
 
   /// \brief Mutex
   public: std::mutex mtx;
 };
 
 /////////////////////////////////////////////////
-void HydrodynamicsPrivateData::UpdateCurrent(const msgs::Vector3d &_msg)
+void HydrodynamicsPrivateData::UpdateCurrent(const std::string &_topic,
+    const msgs::Vector3d &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mtx);
-  this->currentVector = ignition::msgs::Convert(_msg);
+  this->receivedCurrents[_topic] = ignition::msgs::Convert(_msg);
 }
 
 /////////////////////////////////////////////////
@@ -183,6 +210,101 @@ double SdfParamDouble(
   return _sdf->Get<double>(_field, _default).first;
 }
 
+/////////////////////////////////////////////////
+HydrodynamicsBody HydrodynamicsPrivateData::LoadBody(
+    const std::shared_ptr<const sdf::Element> &_sdf)
+{
+  HydrodynamicsBody body;
+  body.addedMass <<
+      SdfParamDouble(_sdf, "xDotU", 5),
+      SdfParamDouble(_sdf, "yDotV", 5),
+      SdfParamDouble(_sdf, "zDotW", 0.1),
+      SdfParamDouble(_sdf, "kDotP", 0.1),
+      SdfParamDouble(_sdf, "mDotQ", 0.1),
+      SdfParamDouble(_sdf, "nDotR", 1);
+  body.linearDrag <<
+      SdfParamDouble(_sdf, "xU", 20),
+      SdfParamDouble(_sdf, "yV", 20),
+      SdfParamDouble(_sdf, "zW", 20),
+      SdfParamDouble(_sdf, "kP", 20),
+      SdfParamDouble(_sdf, "mQ", 20),
+      SdfParamDouble(_sdf, "nR", 20);
+  body.quadraticDrag <<
+      SdfParamDouble(_sdf, "xUU", 0),
+      SdfParamDouble(_sdf, "yVV", 0),
+      SdfParamDouble(_sdf, "zWW", 0),
+      SdfParamDouble(_sdf, "kPP", 0),
+      SdfParamDouble(_sdf, "mQQ", 0),
+      SdfParamDouble(_sdf, "nRR", 0);
+
+  if (_sdf->HasElement("model_name"))
+    body.modelName = _sdf->Get<std::string>("model_name");
+  if (_sdf->HasElement("link_name"))
+    body.linkName = _sdf->Get<std::string>("link_name");
+
+  if (_sdf->HasElement("default_current"))
+    body.currentVector = _sdf->Get<math::Vector3d>("default_current");
+
+  return body;
+}
+
+/////////////////////////////////////////////////
+void HydrodynamicsPrivateData::SubscribeCurrent(
+    const std::shared_ptr<const sdf::Element> &_sdf, std::size_t _index)
+{
+  std::string currentTopic {"/ocean_current"};
+  if (_sdf->HasElement("namespace"))
+  {
+    auto ns = _sdf->Get<std::string>("namespace");
+    currentTopic = ignition::transport::TopicUtils::AsValidTopic(
+        "/model/" + ns + "/ocean_current");
+  }
+
+  // Bodies in the same namespace share a subscription
+  auto &indices = this->currentTopics[currentTopic];
+  if (indices.empty())
+  {
+    std::function<void(const msgs::Vector3d &)> callback =
+        [this, currentTopic](const msgs::Vector3d &_msg)
+        {
+          this->UpdateCurrent(currentTopic, _msg);
+        };
+    this->node.Subscribe(currentTopic, callback);
+  }
+  indices.push_back(_index);
+}
+
+/////////////////////////////////////////////////
+void HydrodynamicsPrivateData::FindLinks(EntityComponentManager &_ecm)
+{
+  for (auto &body : this->bodies)
+  {
+    if (body.linkEntity != kNullEntity || body.modelName.empty())
+      continue;
+
+    // Models may be spawned after the system is loaded
+    auto modelEntity = worldModelByName(_ecm, this->worldEntity,
+        body.modelName);
+    if (modelEntity == kNullEntity)
+      continue;
+
+    --this->pendingLinks;
+    body.linkEntity = Model(modelEntity).LinkByName(_ecm, body.linkName);
+    if (!_ecm.HasEntity(body.linkEntity))
+    {
+      ignerr << "Link name [" << body.linkName << "] does not exist in model ["
+             << body.modelName << "]" << std::endl;
+      body.linkEntity = kNullEntity;
+      body.modelName.clear();
+      continue;
+    }
+
+    AddWorldPose(body.linkEntity, _ecm);
+    AddAngularVelocityComponent(body.linkEntity, _ecm);
+    AddWorldLinearVelocity(body.linkEntity, _ecm);
+  }
+}
+
 /////////////////////////////////////////////////
 Hydrodynamics::Hydrodynamics()
 {
@@ -213,123 +335,87 @@ void Hydrodynamics::Configure(
   this->dataPtr->waterDensity     = SdfParamDouble(_sdf, "waterDensity",
                                       SdfParamDouble(_sdf, "water_density", 998)
                                     );
-  this->dataPtr->paramXdotU       = SdfParamDouble(_sdf, "xDotU"       , 5);
-  this->dataPtr->paramYdotV       = SdfParamDouble(_sdf, "yDotV"       , 5);
-  this->dataPtr->paramZdotW       = SdfParamDouble(_sdf, "zDotW"       , 0.1);
-  this->dataPtr->paramKdotP       = SdfParamDouble(_sdf, "kDotP"       , 0.1);
-  this->dataPtr->paramMdotQ       = SdfParamDouble(_sdf, "mDotQ"       , 0.1);
-  this->dataPtr->paramNdotR       = SdfParamDouble(_sdf, "nDotR"       , 1);
-  this->dataPtr->paramXu          = SdfParamDouble(_sdf, "xU"          , 20);
-  this->dataPtr->paramXuu         = SdfParamDouble(_sdf, "xUU"         , 0);
-  this->dataPtr->paramYv          = SdfParamDouble(_sdf, "yV"          , 20);
-  this->dataPtr->paramYvv         = SdfParamDouble(_sdf, "yVV"         , 0);
-  this->dataPtr->paramZw          = SdfParamDouble(_sdf, "zW"          , 20);
-  this->dataPtr->paramZww         = SdfParamDouble(_sdf, "zWW"         , 0);
-  this->dataPtr->paramKp          = SdfParamDouble(_sdf, "kP"          , 20);
-  this->dataPtr->paramKpp         = SdfParamDouble(_sdf, "kPP"         , 0);
-  this->dataPtr->paramMq          = SdfParamDouble(_sdf, "mQ"          , 20);
-  this->dataPtr->paramMqq         = SdfParamDouble(_sdf, "mQQ"         , 0);
-  this->dataPtr->paramNr          = SdfParamDouble(_sdf, "nR"          , 20);
-  this->dataPtr->paramNrr         = SdfParamDouble(_sdf, "nRR"         , 0);
-
-  // Create model object, to access convenient functions
-  auto model = ignition::gazebo::Model(_entity);
 
-  std::string ns {""};
-  std::string currentTopic {"/ocean_current"};
-  if (_sdf->HasElement("namespace"))
+  // When attached to the world, the system handles every <body>
+  if (_ecm.Component<components::World>(_entity))
   {
-    ns = _sdf->Get<std::string>("namespace");
-    currentTopic = ignition::transport::TopicUtils::AsValidTopic(
-        "/model/" + ns + "/ocean_current");
+    this->dataPtr->worldEntity = _entity;
+    for (const auto &elem : worldModelElements(_sdf, "body", "Hydrodynamics"))
+    {
+      auto body = HydrodynamicsPrivateData::LoadBody(elem.sdf);
+      if (body.linkName.empty())
+      {
+        ignerr << "Each <body> of the hydrodynamic plugin must specify a "
+               << "<link_name>" << std::endl;
+        continue;
+      }
+      this->dataPtr->SubscribeCurrent(elem.sdf, this->dataPtr->bodies.size());
+      this->dataPtr->bodies.push_back(body);
+    }
+    this->dataPtr->pendingLinks = this->dataPtr->bodies.size();
+    this->dataPtr->FindLinks(_ecm);
+    return;
   }
 
-  this->dataPtr->node.Subscribe(
-    currentTopic,
-    &HydrodynamicsPrivateData::UpdateCurrent,
-    this->dataPtr.get());
+  // Create model object, to access convenient functions
+  auto model = ignition::gazebo::Model(_entity);
+
+  auto body = HydrodynamicsPrivateData::LoadBody(_sdf);
+  this->dataPtr->SubscribeCurrent(_sdf, 0u);
 
-  if (!_sdf->HasElement("link_name"))
+  if (body.linkName.empty())
   {
     ignerr << "You must specify a <link_name> for the hydrodynamic"
       << " plugin to act upon";
     return;
   }
-  auto linkName = _sdf->Get<std::string>("link_name");
-  this->dataPtr->linkEntity = model.LinkByName(_ecm, linkName);
-  if (!_ecm.HasEntity(this->dataPtr->linkEntity))
+  body.linkEntity = model.LinkByName(_ecm, body.linkName);
+  if (!_ecm.HasEntity(body.linkEntity))
   {
-    ignerr << "Link name" << linkName << "does not exist";
+    ignerr << "Link name" << body.linkName << "does not exist";
     return;
   }
 
-  if(_sdf->HasElement("default_current"))
-  {
-    this->dataPtr->currentVector = _sdf->Get<math::Vector3d>("default_current");
-  }
-
-  this->dataPtr->prevState = Eigen::VectorXd::Zero(6);
-
-  AddWorldPose(this->dataPtr->linkEntity, _ecm);
-  AddAngularVelocityComponent(this->dataPtr->linkEntity, _ecm);
-  AddWorldLinearVelocity(this->dataPtr->linkEntity, _ecm);
+  AddWorldPose(body.linkEntity, _ecm);
+  AddAngularVelocityComponent(body.linkEntity, _ecm);
+  AddWorldLinearVelocity(body.linkEntity, _ecm);
 
-
-  // Added mass according to Fossen's equations (p 37)
-  this->dataPtr->Ma = Eigen::MatrixXd::Zero(6, 6);
-
-  this->dataPtr->Ma(0, 0) = this->dataPtr->paramXdotU;
-  this->dataPtr->Ma(1, 1) = this->dataPtr->paramYdotV;
-  this->dataPtr->Ma(2, 2) = this->dataPtr->paramZdotW;
-  this->dataPtr->Ma(3, 3) = this->dataPtr->paramKdotP;
-  this->dataPtr->Ma(4, 4) = this->dataPtr->paramMdotQ;
-  this->dataPtr->Ma(5, 5) = this->dataPtr->paramNdotR;
+  this->dataPtr->bodies.push_back(body);
 }
 
 /////////////////////////////////////////////////
-void Hydrodynamics::PreUpdate(
-      const ignition::gazebo::UpdateInfo &_info,
-      ignition::gazebo::EntityComponentManager &_ecm)
+void HydrodynamicsPrivateData::ComputeWrench(HydrodynamicsBody &_body,
+    const EntityComponentManager &_ecm, double _dt)
 {
-  if (_info.paused)
-    return;
+  _body.apply = false;
 
   // These variables follow Fossen's scheme in "Guidance and Control
   // of Ocean Vehicles." The `state` vector contains the ship's current velocity
   // in the formate [x_vel, y_vel, z_vel, roll_vel, pitch_vel, yaw_vel].
   // `stateDot` consists of the first derivative in time of the state vector.
   // `Cmat` corresponds to the Centripetal matrix
-  // `Dmat` is the drag matrix
   // `Ma` is the added mass.
-  Eigen::VectorXd stateDot = Eigen::VectorXd(6);
-  Eigen::VectorXd state    = Eigen::VectorXd(6);
-  Eigen::MatrixXd Cmat     = Eigen::MatrixXd::Zero(6, 6);
-  Eigen::MatrixXd Dmat     = Eigen::MatrixXd::Zero(6, 6);
+  Vector6d state;
+  Eigen::Matrix<double, 6, 6> Cmat = Eigen::Matrix<double, 6, 6>::Zero();
 
   // Get vehicle state
-  ignition::gazebo::Link baseLink(this->dataPtr->linkEntity);
+  ignition::gazebo::Link baseLink(_body.linkEntity);
   auto linearVelocity =
-    _ecm.Component<components::WorldLinearVelocity>(this->dataPtr->linkEntity);
+    _ecm.Component<components::WorldLinearVelocity>(_body.linkEntity);
   auto rotationalVelocity = baseLink.WorldAngularVelocity(_ecm);
+  auto pose = baseLink.WorldPose(_ecm);
 
-  if (!linearVelocity)
+  if (!linearVelocity || !rotationalVelocity || !pose)
   {
     ignerr << "no linear vel" <<"\n";
     return;
   }
 
-  // Get current vector
-  math::Vector3d currentVector;
-  {
-    std::lock_guard lock(this->dataPtr->mtx);
-    currentVector = this->dataPtr->currentVector;
-  }
   // Transform state to local frame
-  auto pose = baseLink.WorldPose(_ecm);
   // Since we are transforming angular and linear velocity we only care about
   // rotation
   auto localLinearVelocity = pose->Rot().Inverse() *
-    (linearVelocity->Data() - currentVector);
+    (linearVelocity->Data() - _body.currentVector);
   auto localRotationalVelocity = pose->Rot().Inverse() * *rotationalVelocity;
 
   state(0) = localLinearVelocity.X();
@@ -340,64 +426,99 @@ void Hydrodynamics::PreUpdate(
   state(4) = localRotationalVelocity.Y();
   state(5) = localRotationalVelocity.Z();
 
-  auto dt = static_cast<double>(_info.dt.count())/1e9;
-  stateDot = (state - this->dataPtr->prevState)/dt;
+  const Vector6d stateDot = (state - _body.prevState) / _dt;
 
-  this->dataPtr->prevState = state;
+  _body.prevState = state;
 
   // The added mass
-  const Eigen::VectorXd kAmassVec = this->dataPtr->Ma * stateDot;
+  const Vector6d kAmassVec = _body.addedMass.cwiseProduct(stateDot);
 
   // Coriolis and Centripetal forces for under water vehicles (Fossen P. 37)
   // Note: this is significantly different from VRX because we need to account
   // for the under water vehicle's additional DOF
-  Cmat(0, 4) = - this->dataPtr->paramZdotW * state(2);
-  Cmat(0, 5) = - this->dataPtr->paramYdotV * state(1);
-  Cmat(1, 3) =   this->dataPtr->paramZdotW * state(2);
-  Cmat(1, 5) = - this->dataPtr->paramXdotU * state(0);
-  Cmat(2, 3) = - this->dataPtr->paramYdotV * state(1);
-  Cmat(2, 4) =   this->dataPtr->paramXdotU * state(0);
-  Cmat(3, 1) = - this->dataPtr->paramZdotW * state(2);
-  Cmat(3, 2) =   this->dataPtr->paramYdotV * state(1);
-  Cmat(3, 4) = - this->dataPtr->paramNdotR * state(5);
-  Cmat(3, 5) =   this->dataPtr->paramMdotQ * state(4);
-  Cmat(4, 0) =   this->dataPtr->paramZdotW * state(2);
-  Cmat(4, 2) = - this->dataPtr->paramXdotU * state(0);
-  Cmat(4, 3) =   this->dataPtr->paramNdotR * state(5);
-  Cmat(4, 5) = - this->dataPtr->paramKdotP * state(3);
-  Cmat(5, 0) =   this->dataPtr->paramZdotW * state(2);
-  Cmat(5, 1) =   this->dataPtr->paramXdotU * state(0);
-  Cmat(5, 3) = - this->dataPtr->paramMdotQ * state(4);
-  Cmat(5, 4) =   this->dataPtr->paramKdotP * state(3);
-  const Eigen::VectorXd kCmatVec = - Cmat * state;
-
-  // Damping forces (Fossen P. 43)
-  Dmat(1, 1)
-    = - this->dataPtr->paramYv - this->dataPtr->paramYvv * abs(state(1));
-  Dmat(0, 0)
-    = - this->dataPtr->paramXu - this->dataPtr->paramXuu * abs(state(0));
-  Dmat(2, 2)
-    = - this->dataPtr->paramZw - this->dataPtr->paramZww * abs(state(2));
-  Dmat(3, 3)
-    = - this->dataPtr->paramKp - this->dataPtr->paramKpp * abs(state(3));
-  Dmat(4, 4)
-    = - this->dataPtr->paramMq - this->dataPtr->paramMqq * abs(state(4));
-  Dmat(5, 5)
-    = - this->dataPtr->paramNr - this->dataPtr->paramNrr * abs(state(5));
-
-  const Eigen::VectorXd kDvec = Dmat * state;
-
-  const Eigen::VectorXd kTotalWrench = kAmassVec + kDvec + kCmatVec;
+  const Vector6d &ma = _body.addedMass;
+  Cmat(0, 4) = - ma(2) * state(2);
+  Cmat(0, 5) = - ma(1) * state(1);
+  Cmat(1, 3) =   ma(2) * state(2);
+  Cmat(1, 5) = - ma(0) * state(0);
+  Cmat(2, 3) = - ma(1) * state(1);
+  Cmat(2, 4) =   ma(0) * state(0);
+  Cmat(3, 1) = - ma(2) * state(2);
+  Cmat(3, 2) =   ma(1) * state(1);
+  Cmat(3, 4) = - ma(5) * state(5);
+  Cmat(3, 5) =   ma(4) * state(4);
+  Cmat(4, 0) =   ma(2) * state(2);
+  Cmat(4, 2) = - ma(0) * state(0);
+  Cmat(4, 3) =   ma(5) * state(5);
+  Cmat(4, 5) = - ma(3) * state(3);
+  Cmat(5, 0) =   ma(2) * state(2);
+  Cmat(5, 1) =   ma(0) * state(0);
+  Cmat(5, 3) = - ma(4) * state(4);
+  Cmat(5, 4) =   ma(3) * state(3);
+  const Vector6d kCmatVec = - Cmat * state;
+
+  // Damping forces (Fossen P. 43). The damping matrix is diagonal.
+  const Vector6d kDvec = -(_body.linearDrag +
+      _body.quadraticDrag.cwiseProduct(state.cwiseAbs())).cwiseProduct(state);
+
+  const Vector6d kTotalWrench = kAmassVec + kDvec + kCmatVec;
 
   ignition::math::Vector3d
     totalForce(-kTotalWrench(0), -kTotalWrench(1), -kTotalWrench(2));
   ignition::math::Vector3d
     totalTorque(-kTotalWrench(3), -kTotalWrench(4), -kTotalWrench(5));
 
-  baseLink.AddWorldWrench(
-    _ecm,
-    pose->Rot()*(totalForce),
-    pose->Rot()*totalTorque);
+  _body.force = pose->Rot() * totalForce;
+  _body.torque = pose->Rot() * totalTorque;
+  _body.apply = true;
+}
+
+/////////////////////////////////////////////////
+void Hydrodynamics::PreUpdate(
+      const ignition::gazebo::UpdateInfo &_info,
+      ignition::gazebo::EntityComponentManager &_ecm)
+{
+  if (this->dataPtr->pendingLinks > 0u)
+    this->dataPtr->FindLinks(_ecm);
+
+  if (_info.paused)
+    return;
+
+  auto &bodies = this->dataPtr->bodies;
+
+  // Get current vectors
+  {
+    std::lock_guard lock(this->dataPtr->mtx);
+    for (const auto &[topic, current] : this->dataPtr->receivedCurrents)
+    {
+      for (auto index : this->dataPtr->currentTopics[topic])
+        bodies[index].currentVector = current;
+    }
+    this->dataPtr->receivedCurrents.clear();
+  }
+
+  auto dt = static_cast<double>(_info.dt.count())/1e9;
+
+  // Bodies are independent of each other, so their wrenches are computed
+  // concurrently, and applied afterwards
+  _ecm.ParallelFor(bodies.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      if (bodies[i].linkEntity != kNullEntity)
+        HydrodynamicsPrivateData::ComputeWrench(bodies[i], _ecm, dt);
+    }
+  }, 16u);
+
+  for (const auto &body : bodies)
+  {
+    if (!body.apply)
+      continue;
+
+    ignition::gazebo::Link baseLink(body.linkEntity);
+    baseLink.AddWorldWrench(_ecm, body.force, body.torque);
+  }
 }
 
 IGNITION_ADD_PLUGIN(
@@ -78,6 +78,32 @@ namespace systems
   ///   * <default_current> - A generic current.
   ///      [vector3d m/s, optional, default = [0,0,0]m/s]
   ///
+  /// ## Multiple bodies
+  /// When attached to a world instead of a model, a single instance of the
+  /// system handles many bodies, such as a fleet of vehicles. Each body is
+  /// described by a `<body>` element, which takes all of the parameters
+  /// above except `<water_density>`, plus:
+  ///   * <model_name> - Name of the top level model which holds the link.
+  ///     [Required]
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned. The wrenches of all bodies are computed
+  /// concurrently.
+  /// ```
+  /// <plugin filename="ignition-gazebo-hydrodynamics-system"
+  ///         name="ignition::gazebo::systems::Hydrodynamics">
+  ///   <body>
+  ///     <model_name>auv_0</model_name>
+  ///     <link_name>base_link</link_name>
+  ///     <xDotU>-4.876161</xDotU>
+  ///   </body>
+  ///   <body>
+  ///     <model_name>auv_1</model_name>
+  ///     <link_name>base_link</link_name>
+  ///     <namespace>auv_1</namespace>
+  ///   </body>
+  /// </plugin>
+  /// ```
+  ///
   /// # Example
   /// An example configuration is provided in the examples folder. The example
   /// uses the LiftDrag plugin to apply steering controls. It also uses the
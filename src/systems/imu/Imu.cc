@@ -76,8 +76,10 @@ class ignition::gazebo::systems::ImuPrivate
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
   /// \brief Update IMU sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  public: void Update(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Create sensor
   /// \param[in] _ecm Immutable reference to ECM.
@@ -145,31 +147,8 @@ void Imu::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the ImuPrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update measurement time
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->Update(_info, _ecm);
   }
 
   this->dataPtr->RemoveImuEntities(_ecm);
@@ -300,7 +279,8 @@ void ImuPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void ImuPrivate::Update(const EntityComponentManager &_ecm)
+void ImuPrivate::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("ImuPrivate::Update");
   _ecm.Each<components::Imu,
@@ -316,6 +296,13 @@ void ImuPrivate::Update(const EntityComponentManager &_ecm)
         auto it = this->entitySensorMap.find(_entity);
         if (it != this->entitySensorMap.end())
         {
+          // Skip sensors which aren't due or have no subscribers
+          if (it->second->NextDataUpdateTime() > _info.simTime ||
+              !it->second->HasConnections())
+          {
+            return true;
+          }
+
           const auto &imuWorldPose = _worldPose->Data();
           it->second->SetWorldPose(imuWorldPose);
 
@@ -324,6 +311,8 @@ void ImuPrivate::Update(const EntityComponentManager &_ecm)
 
           // Set the IMU linear acceleration in the imu local frame
           it->second->SetLinearAcceleration(_linearAccel->Data());
+
+          it->second->sensors::Sensor::Update(_info.simTime, false);
          }
         else
         {
@@ -19,6 +19,7 @@
 
 #include <ignition/msgs/model.pb.h>
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -101,6 +102,64 @@ void JointStatePublisher::Configure(
     this->topic = _sdf->Get<std::string>("topic");
   }
 
+  double updateFrequency = _sdf->Get<double>("update_frequency", -1).first;
+  if (updateFrequency > 0)
+  {
+    std::chrono::duration<double> period{1 / updateFrequency};
+    this->updatePeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+  }
+
+  this->InitMessage(_ecm);
+}
+
+//////////////////////////////////////////////////
+void JointStatePublisher::InitMessage(const EntityComponentManager &_ecm)
+{
+  // Fields which don't change during simulation are only set once. Each
+  // publication then only updates the joint states in place.
+  this->msg.set_name(this->model.Name(_ecm));
+  this->msg.set_id(this->model.Entity());
+
+  for (const Entity &joint : this->joints)
+  {
+    msgs::Joint *jointMsg = this->msg.add_joint();
+    auto name = _ecm.Component<components::Name>(joint);
+    if (name)
+      jointMsg->set_name(name->Data());
+    jointMsg->set_id(joint);
+
+    // Set the joint pose
+    auto pose = _ecm.Component<components::Pose>(joint);
+    if (pose)
+      msgs::Set(jointMsg->mutable_pose(), pose->Data());
+
+    auto child = _ecm.Component<components::ChildLinkName>(joint);
+    if (child)
+    {
+      jointMsg->set_child(child->Data());
+    }
+
+    auto parent = _ecm.Component<components::ParentLinkName>(joint);
+    if (parent)
+    {
+      jointMsg->set_parent(parent->Data());
+    }
+
+    auto jointAxis = _ecm.Component<components::JointAxis>(joint);
+    if (jointAxis)
+    {
+      msgs::Set(
+        jointMsg->mutable_axis1()->mutable_xyz(),
+        jointAxis->Data().Xyz());
+      jointMsg->mutable_axis1()->set_limit_upper(
+        jointAxis->Data().Upper());
+      jointMsg->mutable_axis1()->set_limit_lower(
+        jointAxis->Data().Lower());
+      jointMsg->mutable_axis1()->set_damping(
+        jointAxis->Data().Damping());
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -183,47 +242,33 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
   if (!this->modelPub)
     return;
 
-  // Create the message
-  msgs::Model msg;
-  msg.mutable_header()->mutable_stamp()->CopyFrom(
-      convert<msgs::Time>(_info.simTime));
+  // Throttle publishing. If time has gone backward, publish and allow the
+  // time to be reset.
+  auto diff = _info.simTime - this->lastPubTime;
+  if ((diff > std::chrono::steady_clock::duration::zero()) &&
+      (diff < this->updatePeriod))
+  {
+    return;
+  }
+  this->lastPubTime = _info.simTime;
 
-  // Set the name and ID.
-  msg.set_name(this->model.Name(_ecm));
-  msg.set_id(this->model.Entity());
+  this->msg.mutable_header()->mutable_stamp()->CopyFrom(
+      convert<msgs::Time>(_info.simTime));
 
   // Set the model pose
   const auto *pose = _ecm.Component<components::Pose>(
       this->model.Entity());
   if (pose)
-    msgs::Set(msg.mutable_pose(), pose->Data());
+    msgs::Set(this->msg.mutable_pose(), pose->Data());
 
   static bool hasWarned {false};
 
-  // Process each joint
+  // Process each joint. The joints are in the same order as they were added
+  // to the message.
+  int index{0};
   for (const Entity &joint : this->joints)
   {
-    // Add a joint message.
-    msgs::Joint *jointMsg = msg.add_joint();
-    jointMsg->set_name(_ecm.Component<components::Name>(joint)->Data());
-    jointMsg->set_id(joint);
-
-    // Set the joint pose
-    pose = _ecm.Component<components::Pose>(joint);
-    if (pose)
-      msgs::Set(jointMsg->mutable_pose(), pose->Data());
-
-    auto child = _ecm.Component<components::ChildLinkName>(joint);
-    if (child)
-    {
-      jointMsg->set_child(child->Data());
-    }
-
-    auto parent = _ecm.Component<components::ParentLinkName>(joint);
-    if (parent)
-    {
-      jointMsg->set_parent(parent->Data());
-    }
+    msgs::Joint *jointMsg = this->msg.mutable_joint(index++);
 
     // Set the joint position
     const auto *jointPositions  =
@@ -235,19 +280,6 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
         if (i == 0)
         {
           jointMsg->mutable_axis1()->set_position(jointPositions->Data()[i]);
-          auto jointAxis = _ecm.Component<components::JointAxis>(joint);
-          if (jointAxis)
-          {
-            msgs::Set(
-              jointMsg->mutable_axis1()->mutable_xyz(),
-              jointAxis->Data().Xyz());
-            jointMsg->mutable_axis1()->set_limit_upper(
-              jointAxis->Data().Upper());
-            jointMsg->mutable_axis1()->set_limit_lower(
-              jointAxis->Data().Lower());
-            jointMsg->mutable_axis1()->set_damping(
-              jointAxis->Data().Damping());
-          }
         }
         else if (i == 1)
         {
@@ -309,7 +341,7 @@ void JointStatePublisher::PostUpdate(const UpdateInfo &_info,
   }
 
   // Publish the message.
-  this->modelPub->Publish(msg);
+  this->modelPub->Publish(this->msg);
 }
 
 IGNITION_ADD_PLUGIN(JointStatePublisher,
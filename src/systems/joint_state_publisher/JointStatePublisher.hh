@@ -18,6 +18,9 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_STATE_PUBLISHER_HH_
 #define IGNITION_GAZEBO_SYSTEMS_STATE_PUBLISHER_HH_
 
+#include <ignition/msgs/model.pb.h>
+
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -46,6 +49,13 @@ namespace systems
   /// `<joint_name>`: Name of a joint to publish. This parameter can be
   /// specified multiple times, and is optional. All joints in a model will
   /// be published if joint names are not specified.
+  ///
+  /// `<update_frequency>`: Publication frequency in Hz. This parameter is
+  /// optional, and by default the state is published on every iteration.
+  ///
+  /// The layout of the message, including joint names and axes, is built
+  /// once at configuration. Each publication only updates the model pose
+  /// and the joint states in place.
   class JointStatePublisher
       : public System,
         public ISystemConfigure,
@@ -72,6 +82,11 @@ namespace systems
     private: void CreateComponents(EntityComponentManager &_ecm,
                                    gazebo::Entity _joint);
 
+    /// \brief Set the fields of the message which don't change during
+    /// simulation.
+    /// \param[in] _ecm The EntityComponentManager.
+    private: void InitMessage(const EntityComponentManager &_ecm);
+
     /// \brief The model
     private: Model model;
 
@@ -86,6 +101,15 @@ namespace systems
 
     /// \brief The topic
     private: std::string topic;
+
+    /// \brief Message which is updated and published on every publication.
+    private: msgs::Model msg;
+
+    /// \brief Publication period, zero to publish on every iteration.
+    private: std::chrono::steady_clock::duration updatePeriod{0};
+
+    /// \brief Simulation time of the last publication.
+    private: std::chrono::steady_clock::duration lastPubTime{0};
   };
   }
 }
@@ -35,6 +35,7 @@
 #include <ignition/transport/Publisher.hh>
 #include <ignition/transport/TopicUtils.hh>
 
+#include <chrono>
 #include <map>
 #include <string>
 #include <vector>
@@ -251,6 +252,15 @@ class Trajectory
   /// \brief Trajectory defined in terms of temporal points, whose members are
   /// ordered according to `jointNames`
   public: std::vector<ignition::msgs::JointTrajectoryPoint> points;
+
+  /// \brief Time from start of each of `points`, converted once when the
+  /// trajectory is received so that it isn't converted on every update
+  public: std::vector<std::chrono::steady_clock::duration> pointTimes;
+
+  /// \brief Actuated joint of each of `jointNames`, resolved once when the
+  /// trajectory is received. Null for joints which aren't controlled by the
+  /// plugin.
+  public: std::vector<ActuatedJoint *> joints;
 };
 
 /// \brief Private data of the JointTrajectoryController plugin
@@ -481,20 +491,19 @@ void JointTrajectoryController::PreUpdate(
     if (isTargetUpdateRequired &&
         this->dataPtr->trajectory.status != Trajectory::Reached)
     {
-      const auto targetPoint =
+      const auto &targetPoint =
           this->dataPtr->trajectory.points[this->dataPtr->trajectory
                                                .pointIndex];
       for (auto jointIndex = 0u;
-           jointIndex < this->dataPtr->trajectory.jointNames.size();
+           jointIndex < this->dataPtr->trajectory.joints.size();
            ++jointIndex)
       {
-        const auto jointName = this->dataPtr->trajectory.jointNames[jointIndex];
-        if (this->dataPtr->actuatedJoints.count(jointName) == 0)
+        auto *joint = this->dataPtr->trajectory.joints[jointIndex];
+        if (nullptr == joint)
         {
-          // Warning about unconfigured joint is already logged above
+          // Joint isn't controlled by this plugin
           continue;
         }
-        auto *joint = &this->dataPtr->actuatedJoints[jointName];
         joint->SetTarget(targetPoint, jointIndex);
       }
 
@@ -677,14 +686,28 @@ void JointTrajectoryControllerPrivate::JointTrajectoryCallback(
   // Reset for a new trajectory
   this->trajectory.Reset();
 
-  // Extract joint names and points
+  // Extract joint names and points. The joints and the times of the points
+  // are resolved here, once per trajectory, rather than on every update.
+  this->trajectory.jointNames.reserve(_msg.joint_names_size());
+  this->trajectory.joints.reserve(_msg.joint_names_size());
   for (const auto &joint_name : _msg.joint_names())
   {
     this->trajectory.jointNames.push_back(joint_name);
+
+    auto jointIt = this->actuatedJoints.find(joint_name);
+    this->trajectory.joints.push_back(
+        jointIt == this->actuatedJoints.end() ? nullptr : &jointIt->second);
   }
+  this->trajectory.points.reserve(_msg.points_size());
+  this->trajectory.pointTimes.reserve(_msg.points_size());
   for (const auto &point : _msg.points())
   {
     this->trajectory.points.push_back(point);
+
+    const auto &pointTFS = point.time_from_start();
+    this->trajectory.pointTimes.push_back(
+        std::chrono::seconds(pointTFS.sec()) +
+        std::chrono::nanoseconds(pointTFS.nsec()));
   }
 }
 
@@ -1011,10 +1034,7 @@ bool Trajectory::UpdateCurrentPoint(
     }
 
     // Break if point needs to be followed
-    const auto pointTFS = this->points[this->pointIndex].time_from_start();
-    const auto pointTime = std::chrono::seconds(pointTFS.sec()) +
-                           std::chrono::nanoseconds(pointTFS.nsec());
-    if (pointTime >= trajectoryTime)
+    if (this->pointTimes[this->pointIndex] >= trajectoryTime)
     {
       break;
     }
@@ -1055,6 +1075,8 @@ void Trajectory::Reset()
   this->pointIndex = 0;
   this->jointNames.clear();
   this->points.clear();
+  this->pointTimes.clear();
+  this->joints.clear();
 }
 
 // Register plugin
@@ -27,16 +27,21 @@
 #endif
 
 #include <ignition/msgs/double.pb.h>
+#include <ignition/msgs/double_v.pb.h>
 
 #include <string>
+#include <vector>
 
 #include <ignition/gazebo/components/AngularVelocity.hh>
 #include <ignition/gazebo/components/Link.hh>
 #include <ignition/gazebo/components/LinearVelocity.hh>
+#include <ignition/gazebo/components/Model.hh>
 #include <ignition/gazebo/components/Name.hh>
+#include <ignition/gazebo/components/ParentEntity.hh>
 #include <ignition/gazebo/components/Pose.hh>
 #include <ignition/gazebo/components/World.hh>
 #include <ignition/gazebo/components/Inertial.hh>
+#include <ignition/gazebo/Conversions.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
 #include <ignition/gazebo/Link.hh>
 #include <ignition/gazebo/Model.hh>
@@ -49,30 +54,63 @@
 
 #include "KineticEnergyMonitor.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
-/// \brief Private data class
-class ignition::gazebo::systems::KineticEnergyMonitorPrivate
+/// \brief A link whose kinetic energy is monitored.
+struct MonitoredLink
 {
-  /// \brief Link of the model.
-  public: Entity linkEntity;
+  /// \brief Name of the model.
+  std::string modelName;
+
+  /// \brief Name of the link.
+  std::string linkName;
 
-  /// \brief Name of the model this plugin is attached to.
-  public: std::string modelName;
+  /// \brief Link of the model, or kNullEntity until it's found.
+  Entity linkEntity{kNullEntity};
 
   /// \brief Kinetic energy during the previous step.
-  public: double prevKineticEnergy {0.0};
+  double prevKineticEnergy{0.0};
 
   /// \brief Kinetic energy threshold.
-  public: double keThreshold {7.0};
+  double keThreshold{7.0};
+
+  /// \brief Loss of kinetic energy during the current step, or zero if it's
+  /// below the threshold.
+  double deltaKE{0.0};
+};
+
+/// \brief Private data class
+class ignition::gazebo::systems::KineticEnergyMonitorPrivate
+{
+  /// \brief Find the link of a monitor and enable the components needed to
+  /// compute its kinetic energy.
+  /// \param[in] _monitor Monitor whose model entity is known.
+  /// \param[in] _model Model of the link.
+  /// \param[in] _ecm Entity component manager.
+  /// \return True if the link was found.
+  public: bool EnableLink(MonitoredLink &_monitor, const Model &_model,
+      EntityComponentManager &_ecm);
+
+  /// \brief Find the links of monitors whose model hasn't been found yet.
+  /// \param[in] _ecm Entity component manager.
+  public: void FindLinks(EntityComponentManager &_ecm);
+
+  /// \brief Links being monitored. There's a single one when the system is
+  /// attached to a model.
+  public: std::vector<MonitoredLink> monitors;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity worldEntity{kNullEntity};
+
+  /// \brief Number of monitors whose model hasn't been found yet.
+  public: std::size_t pendingMonitors{0u};
 
   /// \brief Ignition communication publisher.
   public: transport::Node::Publisher pub;
-
-  /// \brief The model this plugin is attached to.
-  public: Model model;
 };
 
 //////////////////////////////////////////////////
@@ -90,45 +128,77 @@ void KineticEnergyMonitor::Configure(const Entity &_entity,
         EntityComponentManager &_ecm,
         EventManager &/*_eventMgr*/)
 {
-  this->dataPtr->model = Model(_entity);
+  auto sdfClone = _sdf->Clone();
+  const double keThreshold = sdfClone->Get<double>(
+      "kinetic_energy_threshold", 7.0).first;
+
+  // When attached to the world, the system monitors every <link>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldEntity = _entity;
+    for (const auto &elem :
+         worldModelElements(_sdf, "link", "KineticEnergyMonitor"))
+    {
+      MonitoredLink monitor;
+      monitor.modelName = elem.modelName;
+      monitor.linkName = elem.sdf->Get<std::string>("link_name", "").first;
+      if (monitor.linkName.empty())
+      {
+        ignerr << "Each <link> of the kinetic energy monitor must have a "
+               << "<link_name>" << std::endl;
+        continue;
+      }
+      monitor.keThreshold = elem.sdf->Get<double>("kinetic_energy_threshold",
+          keThreshold).first;
+      this->dataPtr->monitors.push_back(monitor);
+    }
+    this->dataPtr->pendingMonitors = this->dataPtr->monitors.size();
 
-  if (!this->dataPtr->model.Valid(_ecm))
+    auto worldName = _ecm.Component<components::Name>(_entity)->Data();
+    std::string defaultTopic{"/world/" + worldName + "/kinetic_energy"};
+    std::string topic = transport::TopicUtils::AsValidTopic(
+        sdfClone->Get<std::string>("topic", defaultTopic).first);
+
+    ignmsg << "KineticEnergyMonitor monitoring "
+      << this->dataPtr->monitors.size() << " links, publishing messages on "
+      << "[" << topic << "]" << std::endl;
+
+    transport::Node node;
+    this->dataPtr->pub = node.Advertise<msgs::Double_V>(topic);
+
+    this->dataPtr->FindLinks(_ecm);
+    return;
+  }
+
+  Model model(_entity);
+  if (!model.Valid(_ecm))
   {
     ignerr << "KineticEnergyMonitor should be attached to a model "
       << "entity. Failed to initialize." << std::endl;
     return;
   }
 
-  this->dataPtr->modelName = this->dataPtr->model.Name(_ecm);
-
-  auto sdfClone = _sdf->Clone();
-  std::string linkName;
+  MonitoredLink monitor;
+  monitor.modelName = model.Name(_ecm);
   if (sdfClone->HasElement("link_name"))
   {
-    linkName = sdfClone->Get<std::string>("link_name");
+    monitor.linkName = sdfClone->Get<std::string>("link_name");
   }
 
-  if (linkName.empty())
+  if (monitor.linkName.empty())
   {
     ignerr << "found an empty <link_name> parameter. Failed to initialize."
       << std::endl;
     return;
   }
 
-  // Get the link entity
-  this->dataPtr->linkEntity = this->dataPtr->model.LinkByName(_ecm, linkName);
-
-  if (this->dataPtr->linkEntity == kNullEntity)
-  {
-    ignerr << "Link " << linkName
-      << " could not be found. Failed to initialize.\n";
+  if (!this->dataPtr->EnableLink(monitor, model, _ecm))
     return;
-  }
 
-  this->dataPtr->keThreshold = sdfClone->Get<double>(
-      "kinetic_energy_threshold", 7.0).first;
+  monitor.keThreshold = keThreshold;
+  this->dataPtr->monitors.push_back(monitor);
 
-  std::string defaultTopic{"/model/" + this->dataPtr->modelName +
+  std::string defaultTopic{"/model/" + monitor.modelName +
     "/kinetic_energy"};
   std::string topic = sdfClone->Get<std::string>("topic", defaultTopic).first;
 
@@ -137,12 +207,59 @@ void KineticEnergyMonitor::Configure(const Entity &_entity,
 
   transport::Node node;
   this->dataPtr->pub = node.Advertise<msgs::Double>(topic);
+}
+
+//////////////////////////////////////////////////
+bool KineticEnergyMonitorPrivate::EnableLink(MonitoredLink &_monitor,
+    const Model &_model, EntityComponentManager &_ecm)
+{
+  // Get the link entity
+  _monitor.linkEntity = _model.LinkByName(_ecm, _monitor.linkName);
+
+  if (_monitor.linkEntity == kNullEntity)
+  {
+    ignerr << "Link " << _monitor.linkName
+      << " could not be found. Failed to initialize.\n";
+    return false;
+  }
 
-  Link link(this->dataPtr->linkEntity);
+  Link link(_monitor.linkEntity);
   link.EnableVelocityChecks(_ecm, true);
 
   // Create a default inertia in case the link doesn't have it
-  enableComponent<components::Inertial>(_ecm, this->dataPtr->linkEntity, true);
+  enableComponent<components::Inertial>(_ecm, _monitor.linkEntity, true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void KineticEnergyMonitorPrivate::FindLinks(EntityComponentManager &_ecm)
+{
+  for (auto &monitor : this->monitors)
+  {
+    if (monitor.linkEntity != kNullEntity || monitor.modelName.empty())
+      continue;
+
+    // Models may be spawned after the system is loaded
+    auto modelEntity = worldModelByName(_ecm, this->worldEntity,
+        monitor.modelName);
+    if (modelEntity == kNullEntity)
+      continue;
+
+    --this->pendingMonitors;
+    if (!this->EnableLink(monitor, Model(modelEntity), _ecm))
+    {
+      // Don't look for it again
+      monitor.modelName.clear();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void KineticEnergyMonitor::PreUpdate(const UpdateInfo &/*_info*/,
+    EntityComponentManager &_ecm)
+{
+  if (this->dataPtr->pendingMonitors > 0u)
+    this->dataPtr->FindLinks(_ecm);
 }
 
 //////////////////////////////////////////////////
@@ -154,33 +271,79 @@ void KineticEnergyMonitor::PostUpdate(const UpdateInfo &_info,
   if (_info.paused || !this->dataPtr->pub)
     return;
 
-  if (this->dataPtr->linkEntity != kNullEntity)
+  // Links are independent of each other, so their energies are computed
+  // concurrently
+  auto &monitors = this->dataPtr->monitors;
+  _ecm.ParallelFor(monitors.size(),
+      [&](std::size_t _begin, std::size_t _end)
   {
-    Link link(this->dataPtr->linkEntity);
-    if (std::nullopt != link.WorldKineticEnergy(_ecm))
+    for (std::size_t i = _begin; i < _end; ++i)
     {
-      double currKineticEnergy = *link.WorldKineticEnergy(_ecm);
+      auto &monitor = monitors[i];
+      monitor.deltaKE = 0.0;
+      if (monitor.linkEntity == kNullEntity)
+        continue;
+
+      Link link(monitor.linkEntity);
+      auto kineticEnergy = link.WorldKineticEnergy(_ecm);
+      if (std::nullopt == kineticEnergy)
+        continue;
 
       // We only care about positive values of this (the links looses energy)
-      double deltaKE = this->dataPtr->prevKineticEnergy - currKineticEnergy;
-      this->dataPtr->prevKineticEnergy = currKineticEnergy;
+      double deltaKE = monitor.prevKineticEnergy - *kineticEnergy;
+      monitor.prevKineticEnergy = *kineticEnergy;
+      if (deltaKE > monitor.keThreshold)
+        monitor.deltaKE = deltaKE;
+    }
+  }, 64u);
 
-      if (deltaKE > this->dataPtr->keThreshold)
-      {
-        ignmsg << this->dataPtr->modelName
-          << " Change in kinetic energy above threshold - deltaKE: "
-          << deltaKE << std::endl;
-        msgs::Double msg;
-        msg.set_data(deltaKE);
-        this->dataPtr->pub.Publish(msg);
-      }
+  if (this->dataPtr->worldEntity == kNullEntity)
+  {
+    if (monitors.empty() || monitors[0].deltaKE <= 0.0)
+      return;
+
+    ignmsg << monitors[0].modelName
+      << " Change in kinetic energy above threshold - deltaKE: "
+      << monitors[0].deltaKE << std::endl;
+    msgs::Double msg;
+    msg.set_data(monitors[0].deltaKE);
+    this->dataPtr->pub.Publish(msg);
+    return;
+  }
+
+  // All links above their threshold on this step go in a single message
+  msgs::Double_V msg;
+  msgs::Header::Map *modelData{nullptr};
+  msgs::Header::Map *linkData{nullptr};
+  for (const auto &monitor : monitors)
+  {
+    if (monitor.deltaKE <= 0.0)
+      continue;
+
+    if (nullptr == modelData)
+    {
+      modelData = msg.mutable_header()->add_data();
+      modelData->set_key("model");
+      linkData = msg.mutable_header()->add_data();
+      linkData->set_key("link");
     }
+    modelData->add_value(monitor.modelName);
+    linkData->add_value(monitor.linkName);
+    msg.add_data(monitor.deltaKE);
+  }
+
+  if (msg.data_size() > 0)
+  {
+    msg.mutable_header()->mutable_stamp()->CopyFrom(
+        convert<msgs::Time>(_info.simTime));
+    this->dataPtr->pub.Publish(msg);
   }
 }
 
 IGNITION_ADD_PLUGIN(KineticEnergyMonitor,
                     ignition::gazebo::System,
                     KineticEnergyMonitor::ISystemConfigure,
+                    KineticEnergyMonitor::ISystemPreUpdate,
                     KineticEnergyMonitor::ISystemPostUpdate)
 
 IGNITION_ADD_PLUGIN_ALIAS(KineticEnergyMonitor,
@@ -52,6 +52,19 @@ namespace systems
   /// energy surpasses the threshold. This element if optional, and the
   /// default value is `/model/{name_of_model}/kinetic_energy`.
   ///
+  /// # Monitoring many links
+  ///
+  /// When attached to the world, the system monitors one link for each
+  /// `<link>` element, which must have a `<model_name>` and a `<link_name>`,
+  /// and may have its own `<kinetic_energy_threshold>`, defaulting to the
+  /// system's. Models spawned later are found once they appear. The energies
+  /// of all links are computed concurrently, and a single
+  /// ignition.msgs.Double_V is published on each step in which any link
+  /// crossed its threshold, with one value per link. The `model` and `link`
+  /// entries of its header hold the names of each link and its model, in
+  /// the same order. The default `<topic>` is
+  /// `/world/{name_of_world}/kinetic_energy`.
+  ///
   /// # Example Usage
   ///
   /** \verbatim
@@ -100,6 +113,7 @@ namespace systems
   class KineticEnergyMonitor :
     public System,
     public ISystemConfigure,
+    public ISystemPreUpdate,
     public ISystemPostUpdate
   {
     /// \brief Constructor
@@ -114,6 +128,10 @@ namespace systems
                            EntityComponentManager &_ecm,
                            EventManager &_eventMgr) final;
 
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
     // Documentation inherited
     public: void PostUpdate(const UpdateInfo &_info,
                             const EntityComponentManager &_ecm) final;
@@ -40,21 +40,26 @@
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/ExternalWorldWrenchCmd.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/World.hh"
+
+#include "../WorldModels.hh"
 
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
-class ignition::gazebo::systems::LiftDragPrivate
+/// \brief A lifting body, with its lift / drag properties.
+class LiftDragSurface
 {
-  // Initialize the system
+  // Initialize the surface
   public: void Load(const EntityComponentManager &_ecm,
                     const sdf::ElementPtr &_sdf);
 
-  /// \brief Compute lift and drag forces and update the corresponding
-  /// components
+  /// \brief Compute lift and drag forces, which are stored in worldForce
+  /// and worldTorque. This only reads from the ECM, so different surfaces
+  /// can be computed concurrently.
   /// \param[in] _ecm Immutable reference to the EntityComponentManager
-  public: void Update(EntityComponentManager &_ecm);
+  public: void Compute(const EntityComponentManager &_ecm);
 
   /// \brief Model interface
   public: Model model{kNullEntity};
@@ -136,10 +141,41 @@ class ignition::gazebo::systems::LiftDragPrivate
 
   /// \brief Initialization flag
   public: bool initialized{false};
+
+  /// \brief Name of the top level model holding the surface, when the
+  /// system is attached to the world.
+  public: std::string modelName;
+
+  /// \brief Force computed on the current iteration, in the world frame.
+  public: math::Vector3d worldForce;
+
+  /// \brief Torque computed on the current iteration, in the world frame.
+  public: math::Vector3d worldTorque;
+
+  /// \brief Whether worldForce and worldTorque should be applied on this
+  /// iteration.
+  public: bool apply{false};
+};
+
+class ignition::gazebo::systems::LiftDragPrivate
+{
+  /// \brief Initialize the surfaces which weren't initialized yet.
+  /// \param[in] _ecm Mutable reference to the EntityComponentManager
+  public: void Initialize(EntityComponentManager &_ecm);
+
+  /// \brief Lifting surfaces. There's a single one when the system is
+  /// attached to a model.
+  public: std::vector<LiftDragSurface> surfaces;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity world{kNullEntity};
+
+  /// \brief Number of surfaces which haven't been initialized yet.
+  public: std::size_t pendingSurfaces{0u};
 };
 
 //////////////////////////////////////////////////
-void LiftDragPrivate::Load(const EntityComponentManager &_ecm,
+void LiftDragSurface::Load(const EntityComponentManager &_ecm,
                            const sdf::ElementPtr &_sdf)
 {
   this->cla = _sdf->Get<double>("cla", this->cla).first;
@@ -248,9 +284,10 @@ LiftDrag::LiftDrag()
 }
 
 //////////////////////////////////////////////////
-void LiftDragPrivate::Update(EntityComponentManager &_ecm)
+void LiftDragSurface::Compute(const EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("LiftDragPrivate::Update");
+  this->apply = false;
+
   // get linear velocity at cp in world frame
   const auto worldLinVel =
       _ecm.Component<components::WorldLinearVelocity>(this->linkEntity);
@@ -259,7 +296,7 @@ void LiftDragPrivate::Update(EntityComponentManager &_ecm)
   const auto worldPose =
       _ecm.Component<components::WorldPose>(this->linkEntity);
 
-  components::JointPosition *controlJointPosition = nullptr;
+  const components::JointPosition *controlJointPosition = nullptr;
   if (this->controlJointEntity != kNullEntity)
   {
     controlJointPosition =
@@ -466,9 +503,9 @@ void LiftDragPrivate::Update(EntityComponentManager &_ecm)
   //
   // \todo(addisu) Create a convenient API for applying forces at offset
   // positions
-  const auto totalTorque = torque + cpWorld.Cross(force);
-  Link link(this->linkEntity);
-  link.AddWorldWrench(_ecm, force, totalTorque);
+  this->worldForce = force;
+  this->worldTorque = torque + cpWorld.Cross(force);
+  this->apply = true;
 
   // Debug
   // auto linkName = _ecm.Component<components::Name>(this->linkEntity)->Data();
@@ -492,7 +529,48 @@ void LiftDragPrivate::Update(EntityComponentManager &_ecm)
   // igndbg << "moment: " << moment << "\n";
   // igndbg << "force: " << force << "\n";
   // igndbg << "torque: " << torque << "\n";
-  // igndbg << "totalTorque: " << totalTorque << "\n";
+  // igndbg << "totalTorque: " << this->worldTorque << "\n";
+}
+
+//////////////////////////////////////////////////
+void LiftDragPrivate::Initialize(EntityComponentManager &_ecm)
+{
+  for (auto &surface : this->surfaces)
+  {
+    if (surface.initialized)
+      continue;
+
+    // When attached to the world, models may be spawned after the system is
+    // loaded
+    if (this->world != kNullEntity)
+    {
+      auto modelEntity = worldModelByName(_ecm, this->world,
+          surface.modelName);
+      if (modelEntity == kNullEntity)
+        continue;
+      surface.model = Model(modelEntity);
+    }
+
+    // We call Load here instead of Configure because we can't be guaranteed
+    // that all entities have been created when Configure is called
+    surface.Load(_ecm, surface.sdfConfig);
+    surface.initialized = true;
+    --this->pendingSurfaces;
+
+    if (surface.validConfig)
+    {
+      Link link(surface.linkEntity);
+      link.EnableVelocityChecks(_ecm, true);
+
+      if ((surface.controlJointEntity != kNullEntity) &&
+          !_ecm.Component<components::JointPosition>(
+              surface.controlJointEntity))
+      {
+        _ecm.CreateComponent(surface.controlJointEntity,
+            components::JointPosition());
+      }
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -500,14 +578,32 @@ void LiftDrag::Configure(const Entity &_entity,
                          const std::shared_ptr<const sdf::Element> &_sdf,
                          EntityComponentManager &_ecm, EventManager &)
 {
-  this->dataPtr->model = Model(_entity);
-  if (!this->dataPtr->model.Valid(_ecm))
+  // When attached to the world, the system handles every <surface>
+  if (_ecm.Component<components::World>(_entity))
   {
-    ignerr << "The LiftDrag system should be attached to a model entity. "
-           << "Failed to initialize." << std::endl;
+    this->dataPtr->world = _entity;
+    for (const auto &elem : worldModelElements(_sdf, "surface", "LiftDrag"))
+    {
+      LiftDragSurface surface;
+      surface.modelName = elem.modelName;
+      surface.sdfConfig = elem.sdf;
+      this->dataPtr->surfaces.push_back(surface);
+    }
+    this->dataPtr->pendingSurfaces = this->dataPtr->surfaces.size();
     return;
   }
-  this->dataPtr->sdfConfig = _sdf->Clone();
+
+  LiftDragSurface surface;
+  surface.model = Model(_entity);
+  if (!surface.model.Valid(_ecm))
+  {
+    ignerr << "The LiftDrag system should be attached to a model or world "
+           << "entity. Failed to initialize." << std::endl;
+    return;
+  }
+  surface.sdfConfig = _sdf->Clone();
+  this->dataPtr->surfaces.push_back(surface);
+  this->dataPtr->pendingSurfaces = 1u;
 }
 
 //////////////////////////////////////////////////
@@ -523,37 +619,32 @@ void LiftDrag::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
         << "s]. System may not work properly." << std::endl;
   }
 
-  if (!this->dataPtr->initialized)
-  {
-    // We call Load here instead of Configure because we can't be guaranteed
-    // that all entities have been created when Configure is called
-    this->dataPtr->Load(_ecm, this->dataPtr->sdfConfig);
-    this->dataPtr->initialized = true;
+  if (this->dataPtr->pendingSurfaces > 0u)
+    this->dataPtr->Initialize(_ecm);
 
+  if (_info.paused)
+    return;
 
-    if (this->dataPtr->validConfig)
+  // Surfaces are independent of each other, so their forces are computed
+  // concurrently, and applied afterwards
+  auto &surfaces = this->dataPtr->surfaces;
+  _ecm.ParallelFor(surfaces.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
     {
-      Link link(this->dataPtr->linkEntity);
-      link.EnableVelocityChecks(_ecm, true);
-
-      if ((this->dataPtr->controlJointEntity != kNullEntity) &&
-          !_ecm.Component<components::JointPosition>(
-              this->dataPtr->controlJointEntity))
-      {
-        _ecm.CreateComponent(this->dataPtr->controlJointEntity,
-            components::JointPosition());
-      }
+      if (surfaces[i].initialized && surfaces[i].validConfig)
+        surfaces[i].Compute(_ecm);
     }
-  }
+  }, 16u);
 
-  if (_info.paused)
-    return;
-
-  // This is not an "else" because "initialized" can be set in the if block
-  // above
-  if (this->dataPtr->initialized && this->dataPtr->validConfig)
+  for (const auto &surface : surfaces)
   {
-    this->dataPtr->Update(_ecm);
+    if (!surface.apply)
+      continue;
+
+    Link link(surface.linkEntity);
+    link.AddWorldWrench(_ecm, surface.worldForce, surface.worldTorque);
   }
 }
 
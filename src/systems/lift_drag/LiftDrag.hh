@@ -63,6 +63,18 @@ namespace systems
   ///               stall.
   /// control_joint_name: Name of joint that actuates a control surface for this
   ///                     lifting body (Optional)
+  ///
+  /// When attached to a world instead of a model, a single instance of the
+  /// system handles many lifting bodies, such as all the surfaces of a
+  /// fleet of aircraft. Each body is described by a `<surface>` element,
+  /// which takes all the parameters above plus:
+  ///
+  /// model_name  : Name of the top level model that `link_name` and
+  ///               `control_joint_name` are relative to.
+  ///
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned. The forces of all surfaces are computed
+  /// concurrently.
   class LiftDrag
       : public System,
         public ISystemConfigure,
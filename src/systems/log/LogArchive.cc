@@ -0,0 +1,534 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogArchive.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief Signature of a local file header.
+static constexpr uint32_t kLocalHeaderSignature{0x04034b50u};
+
+/// \brief Signature of a central directory file header.
+static constexpr uint32_t kCentralHeaderSignature{0x02014b50u};
+
+/// \brief Signature of the end of central directory record.
+static constexpr uint32_t kEndSignature{0x06054b50u};
+
+/// \brief Signature of the zip64 end of central directory record.
+static constexpr uint32_t kZip64EndSignature{0x06064b50u};
+
+/// \brief Signature of the zip64 end of central directory locator.
+static constexpr uint32_t kZip64LocatorSignature{0x07064b50u};
+
+/// \brief Id of the extra field holding zip64 sizes and offsets.
+static constexpr uint16_t kZip64ExtraId{0x0001u};
+
+/// \brief Sizes of the fixed parts of the records.
+static constexpr std::size_t kLocalHeaderSize{30u};
+static constexpr std::size_t kCentralHeaderSize{46u};
+static constexpr std::size_t kEndSize{22u};
+static constexpr std::size_t kZip64EndSize{56u};
+static constexpr std::size_t kZip64LocatorSize{20u};
+
+/// \brief Compression methods which can be extracted.
+static constexpr uint16_t kMethodStore{0u};
+static constexpr uint16_t kMethodDeflate{8u};
+
+/// \brief Size of the buffer entries are inflated into.
+static constexpr std::size_t kInflateBufferSize{256u * 1024u};
+
+/////////////////////////////////////////////////
+/// \brief Read a little endian value.
+/// \param[in] _data Bytes of the value.
+/// \return The value.
+template <typename T>
+static T readLittleEndian(const unsigned char *_data)
+{
+  T value{0};
+  for (std::size_t i = 0; i < sizeof(T); ++i)
+    value |= static_cast<T>(static_cast<T>(_data[i]) << (8u * i));
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a path is in a directory.
+/// \param[in] _path Path.
+/// \param[in] _prefix Path of the directory, ending with a '/'.
+/// \return True if _path starts with _prefix.
+static bool inDirectory(std::string_view _path, const std::string &_prefix)
+{
+  return _path.size() > _prefix.size() &&
+      _path.compare(0, _prefix.size(), _prefix) == 0;
+}
+
+// Private data class.
+class ignition::gazebo::systems::LogArchive::Implementation
+{
+  /// \brief A file in the archive.
+  public: struct Entry
+  {
+    /// \brief Path in the archive, pointing into the mapped central
+    /// directory.
+    std::string_view name;
+
+    /// \brief Offset of the local file header.
+    uint64_t offset{0u};
+
+    /// \brief Size of the stored data.
+    uint64_t compressedSize{0u};
+
+    /// \brief Size of the file.
+    uint64_t size{0u};
+
+    /// \brief CRC-32 of the file.
+    uint32_t crc{0u};
+
+    /// \brief Compression method.
+    uint16_t method{0u};
+  };
+
+  /// \brief Read the central directory into entries.
+  /// \return False if the archive is malformed or not supported.
+  public: bool ReadIndex();
+
+  /// \brief Find a file.
+  /// \param[in] _name Path in the archive.
+  /// \return The entry, or nullptr if there's no such file.
+  public: const Entry *Find(std::string_view _name) const;
+
+  /// \brief Find the first file in a directory.
+  /// \param[in] _prefix Path of the directory, ending with a '/'.
+  /// \return Iterator to the first entry in the directory, if any.
+  public: std::vector<Entry>::const_iterator FirstIn(
+              const std::string &_prefix) const;
+
+  /// \brief Extract a file.
+  /// \param[in] _entry File to extract.
+  /// \param[in] _dest Directory to extract to.
+  /// \return True if successful.
+  public: bool Extract(const Entry &_entry, const std::string &_dest) const;
+
+  /// \brief Path of the archive.
+  public: std::string path;
+
+  /// \brief Mapped archive.
+  public: const unsigned char *data{nullptr};
+
+  /// \brief Size of the mapped archive.
+  public: std::size_t size{0u};
+
+  /// \brief Files in the archive, sorted by path.
+  public: std::vector<Entry> entries;
+};
+
+/////////////////////////////////////////////////
+bool LogArchive::Implementation::ReadIndex()
+{
+  if (this->size < kEndSize)
+    return false;
+
+  // The end of central directory record is followed by a comment of up to
+  // 64 KiB
+  const unsigned char *end{nullptr};
+  const std::size_t lowest = this->size > kEndSize + UINT16_MAX ?
+      this->size - kEndSize - UINT16_MAX : 0u;
+  for (std::size_t pos = this->size - kEndSize + 1u; pos-- > lowest;)
+  {
+    if (readLittleEndian<uint32_t>(this->data + pos) == kEndSignature)
+    {
+      end = this->data + pos;
+      break;
+    }
+  }
+  if (nullptr == end)
+    return false;
+
+  uint64_t count = readLittleEndian<uint16_t>(end + 10);
+  uint64_t dirSize = readLittleEndian<uint32_t>(end + 12);
+  uint64_t dirOffset = readLittleEndian<uint32_t>(end + 16);
+
+  // Archives which are too large for the record hold a zip64 one
+  if (count == UINT16_MAX || dirSize == UINT32_MAX || dirOffset == UINT32_MAX)
+  {
+    const std::size_t endPos = static_cast<std::size_t>(end - this->data);
+    if (endPos < kZip64LocatorSize)
+      return false;
+    const unsigned char *locator = end - kZip64LocatorSize;
+    if (readLittleEndian<uint32_t>(locator) != kZip64LocatorSignature)
+      return false;
+
+    const uint64_t zip64EndPos = readLittleEndian<uint64_t>(locator + 8);
+    if (this->size < kZip64EndSize ||
+        zip64EndPos > this->size - kZip64EndSize)
+      return false;
+    const unsigned char *zip64End = this->data + zip64EndPos;
+    if (readLittleEndian<uint32_t>(zip64End) != kZip64EndSignature)
+      return false;
+
+    count = readLittleEndian<uint64_t>(zip64End + 32);
+    dirSize = readLittleEndian<uint64_t>(zip64End + 40);
+    dirOffset = readLittleEndian<uint64_t>(zip64End + 48);
+  }
+
+  if (dirOffset > this->size || dirSize > this->size - dirOffset)
+    return false;
+
+  const unsigned char *header = this->data + dirOffset;
+  const unsigned char *dirEnd = header + dirSize;
+  this->entries.clear();
+  this->entries.reserve(static_cast<std::size_t>(
+      std::min<uint64_t>(count, dirSize / kCentralHeaderSize)));
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    if (static_cast<std::size_t>(dirEnd - header) < kCentralHeaderSize ||
+        readLittleEndian<uint32_t>(header) != kCentralHeaderSignature)
+    {
+      return false;
+    }
+
+    const auto flags = readLittleEndian<uint16_t>(header + 8);
+    Entry entry;
+    entry.method = readLittleEndian<uint16_t>(header + 10);
+    entry.crc = readLittleEndian<uint32_t>(header + 16);
+    entry.compressedSize = readLittleEndian<uint32_t>(header + 20);
+    entry.size = readLittleEndian<uint32_t>(header + 24);
+    const auto nameSize = readLittleEndian<uint16_t>(header + 28);
+    const auto extraSize = readLittleEndian<uint16_t>(header + 30);
+    const auto commentSize = readLittleEndian<uint16_t>(header + 32);
+    entry.offset = readLittleEndian<uint32_t>(header + 42);
+
+    const std::size_t headerSize =
+        kCentralHeaderSize + nameSize + extraSize + commentSize;
+    if (static_cast<std::size_t>(dirEnd - header) < headerSize)
+      return false;
+
+    entry.name = std::string_view(
+        reinterpret_cast<const char *>(header + kCentralHeaderSize),
+        nameSize);
+
+    // Sizes and offset which don't fit are in the zip64 extra field, in
+    // this order
+    const unsigned char *extra = header + kCentralHeaderSize + nameSize;
+    const unsigned char *extraEnd = extra + extraSize;
+    while (extraEnd - extra >= 4)
+    {
+      const auto id = readLittleEndian<uint16_t>(extra);
+      const auto fieldSize = readLittleEndian<uint16_t>(extra + 2);
+      const unsigned char *field = extra + 4;
+      if (extraEnd - field < fieldSize)
+        break;
+
+      if (id == kZip64ExtraId)
+      {
+        const unsigned char *fieldEnd = field + fieldSize;
+        for (uint64_t *value :
+            {&entry.size, &entry.compressedSize, &entry.offset})
+        {
+          if (*value != UINT32_MAX)
+            continue;
+          if (fieldEnd - field < 8)
+            return false;
+          *value = readLittleEndian<uint64_t>(field);
+          field += 8;
+        }
+      }
+      extra += 4u + fieldSize;
+    }
+    header += headerSize;
+
+    // Directories are implied by the paths of their files
+    if (entry.name.empty() || entry.name.back() == '/')
+      continue;
+
+    if ((flags & 0x1u) != 0u)
+    {
+      ignerr << "Recording [" << this->path << "] holds encrypted file ["
+             << entry.name << "], which can't be extracted." << std::endl;
+      return false;
+    }
+
+    if (entry.method != kMethodStore && entry.method != kMethodDeflate)
+    {
+      ignerr << "Recording [" << this->path << "] holds file ["
+             << entry.name << "] compressed with unsupported method ["
+             << entry.method << "]." << std::endl;
+      return false;
+    }
+
+    this->entries.push_back(entry);
+  }
+
+  std::sort(this->entries.begin(), this->entries.end(),
+      [](const Entry &_a, const Entry &_b)
+      {
+        return _a.name < _b.name;
+      });
+  return true;
+}
+
+/////////////////////////////////////////////////
+const LogArchive::Implementation::Entry *LogArchive::Implementation::Find(
+    std::string_view _name) const
+{
+  auto it = std::lower_bound(this->entries.begin(), this->entries.end(),
+      _name, [](const Entry &_entry, std::string_view _value)
+      {
+        return _entry.name < _value;
+      });
+  if (it == this->entries.end() || it->name != _name)
+    return nullptr;
+  return &*it;
+}
+
+/////////////////////////////////////////////////
+std::vector<LogArchive::Implementation::Entry>::const_iterator
+    LogArchive::Implementation::FirstIn(const std::string &_prefix) const
+{
+  return std::lower_bound(this->entries.begin(), this->entries.end(),
+      _prefix, [](const Entry &_entry, const std::string &_value)
+      {
+        return _entry.name < _value;
+      });
+}
+
+/////////////////////////////////////////////////
+bool LogArchive::Implementation::Extract(const Entry &_entry,
+    const std::string &_dest) const
+{
+  IGN_PROFILE("LogArchive::Extract");
+  const std::string name(_entry.name);
+
+  // The data follows the local header, whose variable fields may differ
+  // from the central directory's
+  if (this->size < kLocalHeaderSize ||
+      _entry.offset > this->size - kLocalHeaderSize ||
+      readLittleEndian<uint32_t>(this->data + _entry.offset) !=
+      kLocalHeaderSignature)
+  {
+    ignerr << "Malformed file [" << name << "] in recording ["
+           << this->path << "]." << std::endl;
+    return false;
+  }
+  const unsigned char *local = this->data + _entry.offset;
+  const uint64_t dataOffset = _entry.offset + kLocalHeaderSize +
+      readLittleEndian<uint16_t>(local + 26) +
+      readLittleEndian<uint16_t>(local + 28);
+  if (dataOffset > this->size ||
+      _entry.compressedSize > this->size - dataOffset)
+  {
+    ignerr << "Malformed file [" << name << "] in recording ["
+           << this->path << "]." << std::endl;
+    return false;
+  }
+  const unsigned char *input = this->data + dataOffset;
+
+  const std::string filePath = common::joinPaths(_dest, name);
+  common::createDirectories(common::parentPath(filePath));
+  std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    ignerr << "Failed to create [" << filePath << "]." << std::endl;
+    return false;
+  }
+
+  // zlib counts in unsigned ints, so large files are handled in chunks
+  const uint64_t maxChunk = UINT_MAX;
+  uLong crc = crc32(0L, Z_NULL, 0);
+  uint64_t written{0u};
+  bool ok{true};
+  if (_entry.method == kMethodStore)
+  {
+    for (uint64_t pos = 0; pos < _entry.compressedSize;)
+    {
+      const auto chunk = static_cast<uInt>(
+          std::min(maxChunk, _entry.compressedSize - pos));
+      crc = crc32(crc, input + pos, chunk);
+      out.write(reinterpret_cast<const char *>(input + pos), chunk);
+      pos += chunk;
+    }
+    written = _entry.compressedSize;
+  }
+  else
+  {
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+    {
+      ignerr << "Failed to initialize zlib." << std::endl;
+      return false;
+    }
+
+    std::vector<unsigned char> buffer(kInflateBufferSize);
+    uint64_t consumed{0u};
+    int result{Z_OK};
+    while (result != Z_STREAM_END)
+    {
+      if (stream.avail_in == 0u && consumed < _entry.compressedSize)
+      {
+        stream.next_in = const_cast<Bytef *>(input + consumed);
+        stream.avail_in = static_cast<uInt>(
+            std::min(maxChunk, _entry.compressedSize - consumed));
+        consumed += stream.avail_in;
+      }
+
+      stream.next_out = buffer.data();
+      stream.avail_out = static_cast<uInt>(buffer.size());
+      result = inflate(&stream, Z_NO_FLUSH);
+      if (result != Z_OK && result != Z_STREAM_END)
+      {
+        ok = false;
+        break;
+      }
+
+      const auto produced = static_cast<uInt>(buffer.size()) -
+          stream.avail_out;
+      crc = crc32(crc, buffer.data(), produced);
+      out.write(reinterpret_cast<const char *>(buffer.data()), produced);
+      written += produced;
+    }
+    inflateEnd(&stream);
+  }
+
+  out.close();
+  if (!ok || !out || written != _entry.size || crc != _entry.crc)
+  {
+    ignerr << "Failed to extract [" << name << "] from recording ["
+           << this->path << "]." << std::endl;
+    common::removeFile(filePath);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+LogArchive::LogArchive()
+  : dataPtr(std::make_unique<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+LogArchive::~LogArchive()
+{
+#ifndef _WIN32
+  if (nullptr != this->dataPtr->data)
+  {
+    munmap(const_cast<unsigned char *>(this->dataPtr->data),
+        this->dataPtr->size);
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+bool LogArchive::Open(const std::string &_path)
+{
+#ifndef _WIN32
+  if (nullptr != this->dataPtr->data)
+    return false;
+
+  const int fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+  {
+    void *memory = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+        PROT_READ, MAP_PRIVATE, fd, 0);
+    if (memory != MAP_FAILED)
+    {
+      this->dataPtr->data = static_cast<const unsigned char *>(memory);
+      this->dataPtr->size = static_cast<std::size_t>(info.st_size);
+    }
+  }
+  close(fd);
+
+  if (nullptr == this->dataPtr->data)
+    return false;
+
+  this->dataPtr->path = _path;
+  if (!this->dataPtr->ReadIndex())
+  {
+    this->dataPtr->entries.clear();
+    return false;
+  }
+  return true;
+#else
+  (void)_path;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool LogArchive::HasFile(const std::string &_name) const
+{
+  return nullptr != this->dataPtr->Find(_name);
+}
+
+/////////////////////////////////////////////////
+bool LogArchive::HasDirectory(const std::string &_dir) const
+{
+  const std::string prefix = _dir + "/";
+  auto it = this->dataPtr->FirstIn(prefix);
+  return it != this->dataPtr->entries.end() && inDirectory(it->name, prefix);
+}
+
+/////////////////////////////////////////////////
+bool LogArchive::ExtractFile(const std::string &_name,
+    const std::string &_dest) const
+{
+  auto entry = this->dataPtr->Find(_name);
+  if (nullptr == entry)
+    return false;
+  return this->dataPtr->Extract(*entry, _dest);
+}
+
+/////////////////////////////////////////////////
+std::size_t LogArchive::ExtractDirectory(const std::string &_dir,
+    const std::string &_dest) const
+{
+  const std::string prefix = _dir + "/";
+  std::size_t count{0u};
+  for (auto it = this->dataPtr->FirstIn(prefix);
+      it != this->dataPtr->entries.end() && inDirectory(it->name, prefix);
+      ++it)
+  {
+    if (this->dataPtr->Extract(*it, _dest))
+      ++count;
+  }
+  return count;
+}
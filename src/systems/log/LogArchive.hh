@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_LOGARCHIVE_HH_
+#define IGNITION_GAZEBO_SYSTEMS_LOGARCHIVE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Read access to the entries of a compressed log, without
+  /// extracting the whole archive.
+  ///
+  /// The archive is memory mapped, and its index is read from the central
+  /// directory at its end, so opening it costs the same regardless of its
+  /// size. Entries are then extracted one by one as they're needed. Zip
+  /// archives, including zip64 ones, with stored or deflated entries are
+  /// supported, which covers the logs compressed by LogRecord. Memory
+  /// mapping isn't implemented on Windows, where Open always fails.
+  class LogArchive
+  {
+    /// \brief Constructor
+    public: LogArchive();
+
+    /// \brief Destructor. Unmaps the archive.
+    public: ~LogArchive();
+
+    /// \brief Map an archive and read its index.
+    /// \param[in] _path Path of the archive.
+    /// \return False if the archive can't be read, or holds entries which
+    /// can't be extracted, such as encrypted ones.
+    public: bool Open(const std::string &_path);
+
+    /// \brief Whether the archive holds a file.
+    /// \param[in] _name Path of the file in the archive.
+    /// \return True if the file is in the archive.
+    public: bool HasFile(const std::string &_name) const;
+
+    /// \brief Whether the archive holds files in a directory.
+    /// \param[in] _dir Path of the directory in the archive.
+    /// \return True if the directory holds files.
+    public: bool HasDirectory(const std::string &_dir) const;
+
+    /// \brief Extract a file. Its path in the archive is kept under the
+    /// destination directory.
+    /// \param[in] _name Path of the file in the archive.
+    /// \param[in] _dest Directory to extract to.
+    /// \return True if the file was extracted and its checksum matches.
+    public: bool ExtractFile(const std::string &_name,
+                const std::string &_dest) const;
+
+    /// \brief Extract all files in a directory and its subdirectories.
+    /// Their paths in the archive are kept under the destination directory.
+    /// \param[in] _dir Path of the directory in the archive.
+    /// \param[in] _dest Directory to extract to.
+    /// \return Number of files extracted.
+    public: std::size_t ExtractDirectory(const std::string &_dir,
+                const std::string &_dest) const;
+
+    /// \brief Forward declaration of the private data.
+    private: class Implementation;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<Implementation> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
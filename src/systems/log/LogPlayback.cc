@@ -19,9 +19,13 @@
 
 #include <ignition/msgs/log_playback_stats.pb.h>
 
+#include <algorithm>
+#include <chrono>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Profiler.hh>
@@ -29,6 +33,7 @@
 #include <ignition/math/Pose3.hh>
 #include <ignition/msgs/Utility.hh>
 #include <ignition/plugin/RegisterMore.hh>
+#include <ignition/transport/log/Descriptor.hh>
 #include <ignition/transport/log/QueryOptions.hh>
 #include <ignition/transport/log/Log.hh>
 #include <ignition/transport/log/Message.hh>
@@ -39,6 +44,7 @@
 
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/Events.hh"
+#include "ignition/gazebo/PoseStreamCodec.hh"
 #include "ignition/gazebo/SdfEntityCreator.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/LogPlaybackStatistics.hh"
@@ -47,6 +53,9 @@
 #include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "LogArchive.hh"
+#include "LogPrefetcher.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
@@ -58,6 +67,19 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   /// \return True if extraction was successful.
   public: bool ExtractStateAndResources();
 
+  /// \brief Open the compressed file and only extract the state file from
+  /// it. Resources are extracted later by ExtractResource.
+  /// \return True if the state file was extracted.
+  public: bool ExtractState();
+
+  /// \brief Extract a recorded resource from the compressed file if it
+  /// wasn't extracted yet, along with the rest of its model, since meshes
+  /// and materials refer to files next to them. The model is the closest
+  /// directory holding a model.config, or else the directory above the
+  /// resource's.
+  /// \param[in] _path Path the resource is extracted to.
+  public: void ExtractResource(const std::string &_path);
+
   /// \brief Start log playback.
   /// \param[in] _logPath Path of recorded state to playback.
   /// \param[in] _ecm The EntityComponentManager of the given simulation
@@ -85,12 +107,70 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   public: void Parse(EntityComponentManager &_ecm,
       const msgs::SerializedStateMap &_msg);
 
+  /// \brief Find the latest keyframe recorded at or before a given time.
+  /// Keyframes are looked up in windows growing backwards from that time,
+  /// so only the keyframes close to it are read from the log.
+  /// \param[in] _time Sim time to look for.
+  /// \param[out] _stamp Sim time at which the keyframe was recorded.
+  /// \param[out] _msg The keyframe.
+  /// \return True if a keyframe was found.
+  public: bool LatestKeyframe(const std::chrono::steady_clock::duration &_time,
+      std::chrono::steady_clock::duration &_stamp,
+      msgs::SerializedStateMap &_msg) const;
+
+  /// \brief Merge a changed state into an accumulated one, so that a
+  /// sequence of changes can be applied to the ECM at once. Components
+  /// changed later replace the ones changed earlier, and removing an entity
+  /// drops its earlier changes.
+  /// \param[in,out] _into Accumulated state.
+  /// \param[in] _msg Changed state, more recent than _into.
+  public: static void Merge(msgs::SerializedStateMap &_into,
+      const msgs::SerializedStateMap &_msg);
+
+  /// \brief Decode a frame of the pose stream.
+  /// \param[in] _data Encoded frame.
+  /// \param[in,out] _poses Latest pose of each entity, updated with the
+  /// poses of the frame.
+  public: void DecodePoseFrame(const std::string &_data,
+      std::unordered_map<Entity, math::Pose3d> &_poses);
+
   /// \brief A batch of data from log file, of all pose messages
   public: transport::log::Batch batch;
 
+  /// \brief Topic holding keyframes, which are complete states recorded
+  /// periodically. Empty for logs recorded without keyframes.
+  public: std::string keyframeTopic;
+
+  /// \brief Topic holding the pose stream, which carries the poses of
+  /// entities apart from the changed states. Empty for logs recorded
+  /// without it.
+  public: std::string poseStreamTopic;
+
+  /// \brief Decoder of the pose stream.
+  public: PoseStreamDecoder poseDecoder;
+
+  /// \brief Poses of the last decoded frame, kept to reuse memory.
+  public: std::vector<EntityPose> framePoses;
+
+  /// \brief Period between keyframes, estimated from the first two.
+  public: std::chrono::steady_clock::duration keyframePeriod{
+      std::chrono::seconds(1)};
+
   /// \brief Pointer to ign-transport Log
   public: std::unique_ptr<transport::log::Log> log;
 
+  /// \brief Reads and parses the messages of upcoming steps in the
+  /// background. Null if prefetching is disabled.
+  public: std::unique_ptr<LogPrefetcher> prefetcher;
+
+  /// \brief How far ahead of playback messages are prefetched, in sim time.
+  /// Zero disables prefetching.
+  public: std::chrono::steady_clock::duration prefetchDuration{
+      std::chrono::seconds(1)};
+
+  /// \brief Prefetched messages of the current step, kept to reuse memory.
+  public: std::vector<LogPrefetchedMsg> prefetchedMsgs;
+
   /// \brief Indicator of whether any playback instance has ever been started
   public: static bool started;
 
@@ -100,6 +180,17 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   /// \brief Directory to which compressed file is extracted to
   public: std::string extDest{""};
 
+  /// \brief Whether to only extract the state file from a compressed file
+  /// at start, and its resources as they're used.
+  public: bool lazyExtraction{false};
+
+  /// \brief Compressed file resources are extracted from, when extracting
+  /// lazily.
+  public: std::unique_ptr<LogArchive> archive;
+
+  /// \brief Directories of the compressed file already extracted.
+  public: std::unordered_set<std::string> extractedDirs;
+
   /// \brief Indicator of whether this instance has been started
   public: bool instStarted{false};
 
@@ -136,6 +227,76 @@ LogPlayback::~LogPlayback()
     LogPlaybackPrivate::started = false;
 }
 
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::LatestKeyframe(
+    const std::chrono::steady_clock::duration &_time,
+    std::chrono::steady_clock::duration &_stamp,
+    msgs::SerializedStateMap &_msg) const
+{
+  if (this->keyframeTopic.empty())
+    return false;
+
+  const auto zero = std::chrono::steady_clock::duration::zero();
+  auto span = this->keyframePeriod;
+  while (true)
+  {
+    const auto begin = _time > span ? _time - span : zero;
+    auto keyframes = this->log->QueryMessages(
+        transport::log::TopicList(this->keyframeTopic, {begin, _time}));
+
+    // Keyframes are sorted by time, so the last one is the latest
+    bool found{false};
+    std::string data;
+    for (const auto &keyframe : keyframes)
+    {
+      _stamp = keyframe.TimeReceived();
+      data = keyframe.Data();
+      found = true;
+    }
+
+    if (found)
+      return _msg.ParseFromString(data);
+
+    if (begin == zero)
+      return false;
+    span *= 2;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::Merge(msgs::SerializedStateMap &_into,
+    const msgs::SerializedStateMap &_msg)
+{
+  for (const auto &[id, entityMsg] : _msg.entities())
+  {
+    auto &merged = (*_into.mutable_entities())[id];
+    if (entityMsg.remove() || merged.remove())
+      merged.Clear();
+
+    merged.set_id(entityMsg.id());
+    if (entityMsg.remove())
+    {
+      merged.set_remove(true);
+      continue;
+    }
+
+    for (const auto &[type, compMsg] : entityMsg.components())
+      (*merged.mutable_components())[type] = compMsg;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::DecodePoseFrame(const std::string &_data,
+    std::unordered_map<Entity, math::Pose3d> &_poses)
+{
+  std::chrono::steady_clock::duration frameTime;
+  if (!this->poseDecoder.Decode(_data, frameTime, this->framePoses))
+    return;
+
+  for (const auto &[entity, pose] : this->framePoses)
+    _poses[entity] = pose;
+}
+
 //////////////////////////////////////////////////
 void LogPlaybackPrivate::Parse(EntityComponentManager &_ecm,
     const msgs::SerializedStateMap &_msg)
@@ -158,6 +319,15 @@ void LogPlayback::Configure(const Entity &,
   // Get directory paths from SDF
   this->dataPtr->logPath = _sdf->Get<std::string>("playback_path");
 
+  auto prefetchDuration = _sdf->Get<double>("prefetch_duration",
+      std::chrono::duration<double>(this->dataPtr->prefetchDuration).count());
+  this->dataPtr->prefetchDuration = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+      std::max(0.0, prefetchDuration.first)));
+
+  this->dataPtr->lazyExtraction = _sdf->Get<bool>("lazy_extraction",
+      this->dataPtr->lazyExtraction).first;
+
   this->dataPtr->eventManager = &_eventMgr;
 
   // Prepend working directory if path is relative
@@ -223,6 +393,55 @@ bool LogPlaybackPrivate::Start(EntityComponentManager &_ecm)
     ignerr << "Failed to open log file [" << dbPath << "]" << std::endl;
   }
 
+  // Logs may hold keyframes and a pose stream on topics of their own
+  auto endsWith = [](const std::string &_name, const std::string &_suffix)
+  {
+    return _name.size() >= _suffix.size() && _name.compare(
+        _name.size() - _suffix.size(), _suffix.size(), _suffix) == 0;
+  };
+  auto descriptor = this->log->Descriptor();
+  if (nullptr != descriptor)
+  {
+    for (const auto &topic : descriptor->TopicsToMsgTypesToId())
+    {
+      const auto &name = topic.first;
+      if (endsWith(name, "/state_keyframe"))
+        this->keyframeTopic = name;
+      else if (endsWith(name, "/pose_stream"))
+        this->poseStreamTopic = name;
+    }
+  }
+  if (!this->poseStreamTopic.empty())
+  {
+    igndbg << "Log has a pose stream on topic [" << this->poseStreamTopic
+           << "]" << std::endl;
+  }
+  if (!this->keyframeTopic.empty())
+  {
+    auto keyframes = this->log->QueryMessages(
+        transport::log::TopicList(this->keyframeTopic));
+    auto keyframeIt = keyframes.begin();
+    if (keyframeIt != keyframes.end())
+    {
+      const auto first = keyframeIt->TimeReceived();
+      if (++keyframeIt != keyframes.end() &&
+          keyframeIt->TimeReceived() > first)
+      {
+        this->keyframePeriod = keyframeIt->TimeReceived() - first;
+      }
+    }
+    igndbg << "Log has keyframes on topic [" << this->keyframeTopic
+           << "]" << std::endl;
+  }
+
+  if (this->prefetchDuration > std::chrono::steady_clock::duration::zero())
+  {
+    this->prefetcher = std::make_unique<LogPrefetcher>(
+        this->prefetchDuration, this->keyframeTopic);
+    if (!this->prefetcher->Open(dbPath))
+      this->prefetcher.reset();
+  }
+
   // Access all messages in .tlog file
   this->batch = this->log->QueryMessages();
   auto iter = this->batch.begin();
@@ -398,6 +617,8 @@ std::string LogPlaybackPrivate::PrependLogPath(const std::string &_uri)
     std::string pathPrepended = common::joinPaths(this->logPath,
       pathNoPrefix);
 
+    this->ExtractResource(pathPrepended);
+
     // For backward compatibility. If prepended record path does not exist,
     // then do not prepend logPath. Assume recording is from an older version.
     if (!common::exists(pathPrepended))
@@ -427,6 +648,15 @@ bool LogPlaybackPrivate::ExtractStateAndResources()
   this->extDest += "_extracted";
   this->extDest = common::uniqueDirectoryPath(this->extDest);
 
+  if (this->lazyExtraction)
+  {
+    if (this->ExtractState())
+      return true;
+
+    ignwarn << "Cannot read recording [" << this->logPath
+            << "] without extracting it, extracting all files." << std::endl;
+  }
+
   if (fuel_tools::Zip::Extract(this->logPath, this->extDest))
   {
     ignmsg << "Extracted recording to [" << this->extDest << "]" << std::endl;
@@ -446,6 +676,77 @@ bool LogPlaybackPrivate::ExtractStateAndResources()
   }
 }
 
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::ExtractState()
+{
+  // Files are in a directory with the same name as the compressed file,
+  // without extension
+  std::string dirName = common::basename(this->logPath);
+  dirName = dirName.substr(0, dirName.find_last_of('.'));
+
+  auto archive = std::make_unique<LogArchive>();
+  if (!archive->Open(this->logPath) ||
+      !archive->ExtractFile(dirName + "/state.tlog", this->extDest))
+  {
+    common::removeAll(this->extDest);
+    return false;
+  }
+
+  ignmsg << "Extracted state of recording to [" << this->extDest
+         << "], resources are extracted as they're used." << std::endl;
+  this->archive = std::move(archive);
+  this->logPath = common::joinPaths(this->extDest, dirName);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogPlaybackPrivate::ExtractResource(const std::string &_path)
+{
+  if (!this->archive || common::exists(_path))
+    return;
+
+  // Paths in the archive are relative to the extraction directory
+  const std::string root = this->extDest + "/";
+  if (_path.compare(0, root.size(), root) != 0)
+    return;
+  const std::string name = _path.substr(root.size());
+  if (!this->archive->HasFile(name))
+    return;
+
+  auto parent = [](const std::string &_name)
+  {
+    const auto pos = _name.find_last_of('/');
+    return pos == std::string::npos ? std::string() : _name.substr(0, pos);
+  };
+
+  const std::string fileDir = parent(name);
+  std::string modelDir;
+  for (auto dir = fileDir; !dir.empty(); dir = parent(dir))
+  {
+    if (this->archive->HasFile(dir + "/model.config"))
+    {
+      modelDir = dir;
+      break;
+    }
+  }
+  if (modelDir.empty())
+    modelDir = parent(fileDir);
+
+  // Never extract the top directory, which holds the whole recording
+  if (parent(modelDir).empty())
+    modelDir = parent(fileDir).empty() ? std::string() : fileDir;
+
+  if (modelDir.empty() || !this->extractedDirs.insert(modelDir).second)
+  {
+    this->archive->ExtractFile(name, this->extDest);
+    return;
+  }
+
+  auto count = this->archive->ExtractDirectory(modelDir, this->extDest);
+  igndbg << "Extracted [" << count << "] files of [" << modelDir
+         << "] from recording." << std::endl;
+}
+
 //////////////////////////////////////////////////
 void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
@@ -456,109 +757,238 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   if (!this->dataPtr->instStarted)
     return;
 
-  // Get all messages from this timestep
-  // TODO(anyone) Jumping forward can be expensive for long jumps. For now,
-  // just playing every single step so we don't miss insertions and deletions.
+  // Get all messages from this timestep. Every single step is played so we
+  // don't miss insertions and deletions.
   auto startTime = _info.simTime - _info.dt;
   auto endTime = _info.simTime;
 
+  // Rewinding, or jumping forward past a keyframe, is a seek. Each
+  // serialized state is a changed state and not an absolute state, so
+  // seeking plays all changes from the latest keyframe before the target
+  // time, or from the beginning for logs without keyframes. The keyframe is
+  // found in a logarithmic number of queries on the log's time index, so
+  // the cost of a seek doesn't depend on the length of the log.
   bool seekRewind = false;
   std::set<Entity> entitiesToRemove;
+  msgs::SerializedStateMap keyframeMsg;
+  auto keyframeTime = std::chrono::steady_clock::duration::zero();
   if (_info.dt < std::chrono::steady_clock::duration::zero())
   {
-    // Detected jumping back in time. This can be expensive.
-    // To rewind / seek backward in time, we also need to play every single
-    // step from the beginning so we don't miss insertions and deletions
-    // This is because each serialized state is a changed state and not an
-    // absolute state.
-    // todo(anyone) Record absolute states during recording, i.e. key frames,
-    // so that playback can jump to these states without the need to
-    // incrementally build the states from the beginning
+    seekRewind = true;
+    if (!this->dataPtr->LatestKeyframe(endTime, keyframeTime, keyframeMsg))
+      keyframeTime = std::chrono::steady_clock::duration::zero();
+  }
+  else if (_info.dt > this->dataPtr->keyframePeriod &&
+      this->dataPtr->LatestKeyframe(endTime, keyframeTime, keyframeMsg) &&
+      keyframeTime > startTime)
+  {
+    seekRewind = true;
+  }
 
+  if (seekRewind)
+  {
     // Create a list of entities to be removed. The list will be updated later
     // as the log steps forward below
-    seekRewind = true;
-    const auto &entities = _ecm.Entities().Vertices();
-    for (const auto &entity : entities)
-      entitiesToRemove.insert(Entity(entity.first));
+    for (const Entity entity : _ecm.AllEntities())
+      entitiesToRemove.insert(entity);
+
+    // The keyframe holds all the entities which exist at its time. It's
+    // applied together with the changes that follow it.
+    for (const auto &entIt : keyframeMsg.entities())
+      entitiesToRemove.erase(Entity(entIt.second.id()));
 
-    startTime = std::chrono::steady_clock::duration::zero();
+    startTime = keyframeTime;
   }
 
-  this->dataPtr->batch = this->dataPtr->log->QueryMessages(
-      transport::log::AllTopics({startTime, endTime}));
+  // While seeking, all the changed states are merged into the keyframe and
+  // applied at once, so each component is only set once
+  msgs::SerializedStateMap &seekMsg = keyframeMsg;
+  bool parsed{false};
 
-  auto iter = this->dataPtr->batch.begin();
-  while (iter != this->dataPtr->batch.end())
-  {
-    auto msgType = iter->Type();
+  // Latest streamed pose of each entity, applied after the states so that
+  // the entities exist
+  std::unordered_map<Entity, math::Pose3d> streamedPoses;
 
-    if (msgType == "ignition.msgs.SerializedState")
+  // Regular steps are played from messages which were read and parsed
+  // in the background. Seeks read the log directly, and then move the
+  // prefetcher to the new position.
+  bool prefetched{false};
+  if (this->dataPtr->prefetcher)
+  {
+    auto position = std::chrono::steady_clock::duration::zero();
+    if (seekRewind)
     {
-      msgs::SerializedState msg;
-      msg.ParseFromString(iter->Data());
-
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
+      this->dataPtr->prefetcher->Seek(endTime);
+    }
+    else
+    {
+      if (!this->dataPtr->prefetcher->Position(position) ||
+          position != startTime)
       {
-        for (const auto &entIt : msg.entities())
-        {
-          Entity entity{entIt.id()};
-          if (entIt.remove())
-          {
-            entitiesToRemove.insert(entity);
-          }
-          else
-          {
-            entitiesToRemove.erase(entity);
-          }
-        }
+        this->dataPtr->prefetcher->Seek(startTime);
       }
+      prefetched = this->dataPtr->prefetcher->Take(endTime,
+          this->dataPtr->prefetchedMsgs);
+    }
+  }
 
-      this->dataPtr->Parse(_ecm, msg);
+  if (prefetched)
+  {
+    for (const auto &msg : this->dataPtr->prefetchedMsgs)
+    {
+      if (!this->dataPtr->poseStreamTopic.empty() &&
+          msg.topic == this->dataPtr->poseStreamTopic)
+      {
+        this->dataPtr->DecodePoseFrame(msg.data, streamedPoses);
+      }
+      else if (msg.stateMap)
+      {
+        this->dataPtr->Parse(_ecm, *msg.stateMap);
+        parsed = true;
+      }
+      else if (msg.state)
+      {
+        this->dataPtr->Parse(_ecm, *msg.state);
+        parsed = true;
+      }
+      else if (msg.type != "ignition.msgs.StringMsg")
+      {
+        ignwarn << "Trying to playback unsupported message type ["
+                << msg.type << "]" << std::endl;
+      }
     }
-    else if (msgType == "ignition.msgs.SerializedStateMap")
+  }
+  else
+  {
+    this->dataPtr->batch = this->dataPtr->log->QueryMessages(
+        transport::log::AllTopics({startTime, endTime}));
+
+    auto iter = this->dataPtr->batch.begin();
+    while (iter != this->dataPtr->batch.end())
     {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(iter->Data());
+      // Keyframes duplicate the changes, they're only used for seeking
+      if (!this->dataPtr->keyframeTopic.empty() &&
+          iter->Topic() == this->dataPtr->keyframeTopic)
+      {
+        ++iter;
+        continue;
+      }
 
-      // For seeking back in time only:
-      // While stepping, update the list of entities to be removed
-      // so we do not remove any entities that are to be created
-      if (seekRewind)
+      // Frames of the pose stream are decoded in order, since they depend on
+      // the stream's latest keyframe. After a seek, the first frame is the
+      // keyframe recorded with the state's keyframe.
+      if (!this->dataPtr->poseStreamTopic.empty() &&
+          iter->Topic() == this->dataPtr->poseStreamTopic)
       {
-        for (const auto &entIt : msg.entities())
+        this->dataPtr->DecodePoseFrame(iter->Data(), streamedPoses);
+        ++iter;
+        continue;
+      }
+
+      auto msgType = iter->Type();
+
+      if (msgType == "ignition.msgs.SerializedState")
+      {
+        msgs::SerializedState msg;
+        msg.ParseFromString(iter->Data());
+
+        // For seeking back in time only:
+        // While stepping, update the list of entities to be removed
+        // so we do not remove any entities that are to be created
+        if (seekRewind)
         {
-          const auto &entityMsg = entIt.second;
-          Entity entity{entityMsg.id()};
-          if (entityMsg.remove())
+          for (const auto &entIt : msg.entities())
           {
-            entitiesToRemove.insert(entity);
+            Entity entity{entIt.id()};
+            if (entIt.remove())
+            {
+              entitiesToRemove.insert(entity);
+            }
+            else
+            {
+              entitiesToRemove.erase(entity);
+            }
           }
-          else
+        }
+
+        // Apply the merged states first, to keep the order of changes
+        if (!seekMsg.entities().empty())
+        {
+          this->dataPtr->Parse(_ecm, seekMsg);
+          seekMsg.Clear();
+        }
+        this->dataPtr->Parse(_ecm, msg);
+        parsed = true;
+      }
+      else if (msgType == "ignition.msgs.SerializedStateMap")
+      {
+        msgs::SerializedStateMap msg;
+        msg.ParseFromString(iter->Data());
+
+        // For seeking back in time only:
+        // While stepping, update the list of entities to be removed
+        // so we do not remove any entities that are to be created
+        if (seekRewind)
+        {
+          for (const auto &entIt : msg.entities())
           {
-            entitiesToRemove.erase(entity);
+            const auto &entityMsg = entIt.second;
+            Entity entity{entityMsg.id()};
+            if (entityMsg.remove())
+            {
+              entitiesToRemove.insert(entity);
+            }
+            else
+            {
+              entitiesToRemove.erase(entity);
+            }
           }
         }
-      }
 
-      this->dataPtr->Parse(_ecm, msg);
-    }
-    else if (msgType == "ignition.msgs.StringMsg")
-    {
-      // Do nothing, we assume this is the SDF string
+        if (seekRewind)
+        {
+          LogPlaybackPrivate::Merge(seekMsg, msg);
+        }
+        else
+        {
+          this->dataPtr->Parse(_ecm, msg);
+          parsed = true;
+        }
+      }
+      else if (msgType == "ignition.msgs.StringMsg")
+      {
+        // Do nothing, we assume this is the SDF string
+      }
+      else
+      {
+        ignwarn << "Trying to playback unsupported message type ["
+                << msgType << "]" << std::endl;
+      }
+      ++iter;
     }
-    else
+  }
+
+  if (!seekMsg.entities().empty())
+  {
+    this->dataPtr->Parse(_ecm, seekMsg);
+    parsed = true;
+  }
+
+  for (const auto &[entity, pose] : streamedPoses)
+  {
+    if (nullptr != _ecm.Component<components::Pose>(entity) &&
+        _ecm.SetComponentData<components::Pose>(entity, pose))
     {
-      ignwarn << "Trying to playback unsupported message type ["
-              << msgType << "]" << std::endl;
+      _ecm.SetChanged(entity, components::Pose::typeId,
+          ComponentState::PeriodicChange);
     }
-    this->dataPtr->ReplaceResourceURIs(_ecm);
-    ++iter;
   }
 
+  // Resource URIs only need to be replaced once the ECM holds the final
+  // state of this step, instead of after every message
+  if (parsed)
+    this->dataPtr->ReplaceResourceURIs(_ecm);
+
     // particle emitters
   _ecm.Each<components::ParticleEmitterCmd>(
       [&](const Entity &_entity,
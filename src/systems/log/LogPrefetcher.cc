@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogPrefetcher.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/transport/log/Batch.hh>
+#include <ignition/transport/log/Log.hh>
+#include <ignition/transport/log/QualifiedTime.hh>
+#include <ignition/transport/log/QueryOptions.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+// Private data class.
+class ignition::gazebo::systems::LogPrefetcher::Implementation
+{
+  /// \brief Run by the reading thread until the prefetcher is destroyed.
+  public: void Run();
+
+  /// \brief How far ahead of the playback position messages are read.
+  public: std::chrono::nanoseconds lead;
+
+  /// \brief Duration covered by each query.
+  public: std::chrono::nanoseconds chunk;
+
+  /// \brief Topic which isn't read.
+  public: std::string skipTopic;
+
+  /// \brief Connection to the log file, only used by the reading thread
+  /// once it started.
+  public: transport::log::Log log;
+
+  /// \brief Time of the last recorded message.
+  public: std::chrono::nanoseconds endTime{0};
+
+  /// \brief Messages read and not taken yet, in the order they were
+  /// recorded.
+  public: std::deque<LogPrefetchedMsg> ready;
+
+  /// \brief Playback position.
+  public: std::chrono::nanoseconds position{0};
+
+  /// \brief Time up to which messages were read.
+  public: std::chrono::nanoseconds readUntil{0};
+
+  /// \brief Whether there's a playback position.
+  public: bool seeked{false};
+
+  /// \brief Incremented on every seek, so that chunks which were being
+  /// read during a seek are dropped.
+  public: uint64_t generation{0u};
+
+  /// \brief Whether the reading thread should stop.
+  public: bool stop{false};
+
+  /// \brief Protects all the members above, except the log.
+  public: mutable std::mutex mutex;
+
+  /// \brief Notifies the reading thread that it may read more.
+  public: std::condition_variable readCv;
+
+  /// \brief Notifies Take that messages were read.
+  public: std::condition_variable readyCv;
+
+  /// \brief Reading thread.
+  public: std::thread thread;
+};
+
+//////////////////////////////////////////////////
+void LogPrefetcher::Implementation::Run()
+{
+  std::vector<LogPrefetchedMsg> msgs;
+  while (true)
+  {
+    std::chrono::nanoseconds begin;
+    uint64_t chunkGeneration;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->readCv.wait(lock, [this]
+      {
+        return this->stop || (this->seeked &&
+            this->readUntil < this->endTime &&
+            this->readUntil < this->position + this->lead);
+      });
+      if (this->stop)
+        return;
+      begin = this->readUntil;
+      chunkGeneration = this->generation;
+    }
+
+    IGN_PROFILE("LogPrefetcher::Run");
+    const auto end = begin + this->chunk;
+
+    // Chunks don't overlap, so that each message is only read once
+    auto batch = this->log.QueryMessages(transport::log::AllTopics(
+        transport::log::QualifiedTimeRange(
+        transport::log::QualifiedTime(begin,
+        transport::log::QualifiedTime::Qualifier::EXCLUSIVE),
+        transport::log::QualifiedTime(end,
+        transport::log::QualifiedTime::Qualifier::INCLUSIVE))));
+
+    for (const auto &msg : batch)
+    {
+      if (!this->skipTopic.empty() && msg.Topic() == this->skipTopic)
+        continue;
+
+      LogPrefetchedMsg prefetched;
+      prefetched.time = msg.TimeReceived();
+      prefetched.topic = msg.Topic();
+      prefetched.type = msg.Type();
+      if (prefetched.type == "ignition.msgs.SerializedStateMap")
+      {
+        prefetched.stateMap = std::make_unique<msgs::SerializedStateMap>();
+        prefetched.stateMap->ParseFromString(msg.Data());
+      }
+      else if (prefetched.type == "ignition.msgs.SerializedState")
+      {
+        prefetched.state = std::make_unique<msgs::SerializedState>();
+        prefetched.state->ParseFromString(msg.Data());
+      }
+      else
+      {
+        prefetched.data = msg.Data();
+      }
+      msgs.push_back(std::move(prefetched));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (chunkGeneration == this->generation)
+      {
+        std::move(msgs.begin(), msgs.end(), std::back_inserter(this->ready));
+        this->readUntil = end;
+      }
+    }
+    msgs.clear();
+    this->readyCv.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+LogPrefetcher::LogPrefetcher(const std::chrono::steady_clock::duration &_lead,
+    const std::string &_skipTopic)
+  : dataPtr(std::make_unique<Implementation>())
+{
+  this->dataPtr->lead = std::max(std::chrono::nanoseconds(1),
+      std::chrono::duration_cast<std::chrono::nanoseconds>(_lead));
+
+  // Read in a few chunks, so that playback doesn't wait for a whole lead
+  this->dataPtr->chunk = std::max(std::chrono::nanoseconds(1),
+      this->dataPtr->lead / 4);
+  this->dataPtr->skipTopic = _skipTopic;
+}
+
+//////////////////////////////////////////////////
+LogPrefetcher::~LogPrefetcher()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->readCv.notify_all();
+  this->dataPtr->thread.join();
+}
+
+//////////////////////////////////////////////////
+bool LogPrefetcher::Open(const std::string &_path)
+{
+  if (this->dataPtr->thread.joinable())
+  {
+    ignerr << "Log prefetcher already opened." << std::endl;
+    return false;
+  }
+
+  if (!this->dataPtr->log.Open(_path))
+  {
+    ignerr << "Failed to open log file [" << _path << "] for prefetching."
+           << std::endl;
+    return false;
+  }
+  this->dataPtr->endTime = this->dataPtr->log.EndTime();
+
+  this->dataPtr->thread = std::thread(&Implementation::Run,
+      this->dataPtr.get());
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogPrefetcher::Seek(const std::chrono::steady_clock::duration &_time)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    ++this->dataPtr->generation;
+    this->dataPtr->ready.clear();
+    this->dataPtr->position =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_time);
+    this->dataPtr->readUntil = this->dataPtr->position;
+    this->dataPtr->seeked = true;
+  }
+  this->dataPtr->readCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+bool LogPrefetcher::Position(std::chrono::steady_clock::duration &_time) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->seeked)
+    return false;
+  _time = this->dataPtr->position;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogPrefetcher::Take(const std::chrono::steady_clock::duration &_time,
+    std::vector<LogPrefetchedMsg> &_msgs)
+{
+  _msgs.clear();
+
+  const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _time);
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->seeked || !this->dataPtr->thread.joinable())
+    return false;
+
+  // Let the reading thread go past the playback position if needed
+  if (time > this->dataPtr->position)
+  {
+    this->dataPtr->position = time;
+    this->dataPtr->readCv.notify_one();
+  }
+
+  {
+    IGN_PROFILE("LogPrefetcher::Take wait");
+    this->dataPtr->readyCv.wait(lock, [&]
+    {
+      return this->dataPtr->readUntil >= time ||
+          this->dataPtr->readUntil >= this->dataPtr->endTime;
+    });
+  }
+
+  auto &ready = this->dataPtr->ready;
+  while (!ready.empty() && ready.front().time <= time)
+  {
+    _msgs.push_back(std::move(ready.front()));
+    ready.pop_front();
+  }
+  this->dataPtr->position = time;
+  this->dataPtr->readCv.notify_one();
+  return true;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_LOGPREFETCHER_HH_
+#define IGNITION_GAZEBO_SYSTEMS_LOGPREFETCHER_HH_
+
+#include <ignition/msgs/serialized.pb.h>
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief A log message read ahead of playback.
+  struct LogPrefetchedMsg
+  {
+    /// \brief Time at which the message was recorded.
+    std::chrono::nanoseconds time;
+
+    /// \brief Topic of the message.
+    std::string topic;
+
+    /// \brief Type of the message.
+    std::string type;
+
+    /// \brief Parsed message, if it's an ignition.msgs.SerializedStateMap.
+    std::unique_ptr<msgs::SerializedStateMap> stateMap;
+
+    /// \brief Parsed message, if it's an ignition.msgs.SerializedState.
+    std::unique_ptr<msgs::SerializedState> state;
+
+    /// \brief Serialized message, for all other types.
+    std::string data;
+  };
+
+  /// \brief Reads and parses log messages ahead of playback, from a thread
+  /// of its own.
+  ///
+  /// The prefetcher opens its own connection to the log file, and reads
+  /// the messages which follow the playback position in chunks, up to a
+  /// given duration ahead of it. Serialized states are parsed as they're
+  /// read, so playback only needs to apply them. Moving the playback
+  /// position anywhere other than where the last Take left it requires a
+  /// Seek, which drops the messages read so far.
+  class LogPrefetcher
+  {
+    /// \brief Constructor
+    /// \param[in] _lead How far ahead of the playback position messages are
+    /// read, in sim time.
+    /// \param[in] _skipTopic Topic whose messages are never needed, such as
+    /// the keyframes. Empty to read all topics.
+    public: LogPrefetcher(const std::chrono::steady_clock::duration &_lead,
+                const std::string &_skipTopic);
+
+    /// \brief Destructor. Stops the reading thread.
+    public: ~LogPrefetcher();
+
+    /// \brief Open the log file and start the reading thread. No messages
+    /// are read until the first Seek.
+    /// \param[in] _path Path of the log file.
+    /// \return True if the file was opened.
+    public: bool Open(const std::string &_path);
+
+    /// \brief Drop all messages read so far, and read the messages
+    /// recorded after the given time.
+    /// \param[in] _time New playback position.
+    public: void Seek(const std::chrono::steady_clock::duration &_time);
+
+    /// \brief Get the playback position, which is the time up to which
+    /// messages were taken.
+    /// \param[out] _time Playback position.
+    /// \return False if the prefetcher has no position yet, because Seek
+    /// wasn't called.
+    public: bool Position(std::chrono::steady_clock::duration &_time) const;
+
+    /// \brief Take the messages recorded after the playback position and up
+    /// to the given time, included, waiting for them to be read if needed.
+    /// The playback position moves to the given time.
+    /// \param[in] _time Time up to which messages are taken.
+    /// \param[out] _msgs Messages, in the order they were recorded. Its
+    /// previous contents are replaced.
+    /// \return False if there's no playback position.
+    public: bool Take(const std::chrono::steady_clock::duration &_time,
+                std::vector<LogPrefetchedMsg> &_msgs);
+
+    /// \brief Forward declaration of the private data.
+    private: class Implementation;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<Implementation> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
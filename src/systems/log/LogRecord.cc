@@ -18,13 +18,27 @@
 #include "LogRecord.hh"
 
 #include <sys/stat.h>
+#include <ignition/msgs/bytes.pb.h>
 #include <ignition/msgs/stringmsg.pb.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <string>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
 #include <ctime>
 #include <set>
 #include <list>
+#include <unordered_map>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
@@ -48,18 +62,23 @@
 #include <sdf/Visual.hh>
 #include <sdf/World.hh>
 
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
 #include "ignition/gazebo/components/Material.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
 #include "ignition/gazebo/components/SourceFilePath.hh"
 #include "ignition/gazebo/components/Visual.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "ignition/gazebo/PoseStreamCodec.hh"
 #include "ignition/gazebo/Util.hh"
 
+#include "LogWriter.hh"
+
 using namespace ignition;
 using namespace ignition::gazebo;
 using namespace ignition::gazebo::systems;
@@ -101,9 +120,86 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// there are errors saving the models.
   public: bool SaveModels(const std::set<std::string> &_models);
 
+  /// \brief Queue models to be saved by the resource thread, starting it
+  /// if needed.
+  /// \param[in] _models List of absolute paths of model SDFs to save
+  public: void QueueModels(std::set<std::string> _models);
+
+  /// \brief Run by the resource thread, which saves queued models until
+  /// it's stopped and the queue is empty.
+  public: void RunResourceThread();
+
+  /// \brief Save all queued models and stop the resource thread.
+  public: void StopResourceThread();
+
   /// \brief Compress model resource files and state file into one file.
   public: void CompressStateAndResources();
 
+  /// \brief Whether an entity is recorded, due to a model filter.
+  enum class EntityRecording
+  {
+    /// \brief The entity isn't recorded.
+    kExcluded,
+
+    /// \brief The entity is recorded, but isn't inside an included model.
+    kRecorded,
+
+    /// \brief The entity is an included model, or inside one.
+    kIncluded
+  };
+
+  /// \brief Read a list of regular expressions from the plugin's SDF.
+  /// \param[in] _name Name of the repeated element holding them.
+  /// \return Regular expressions.
+  public: std::vector<std::regex> Patterns(const std::string &_name) const;
+
+  /// \brief Get whether a component type passes the component filters.
+  /// \param[in] _type Component type.
+  /// \return True if components of this type are recorded.
+  public: bool RecordType(const ComponentTypeId _type);
+
+  /// \brief Get whether an entity passes the model filters.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _entity Entity.
+  /// \return How the entity is recorded.
+  public: EntityRecording RecordEntity(const EntityComponentManager &_ecm,
+    const Entity _entity);
+
+  /// \brief Keep the ancestors of new included models, so that they're
+  /// recorded with them.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateIncludedAncestors(const EntityComponentManager &_ecm);
+
+  /// \brief Remove the entities and components which don't pass the
+  /// filters from a state.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in,out] _stateMsg State.
+  public: void FilterState(const EntityComponentManager &_ecm,
+    msgs::SerializedStateMap &_stateMsg);
+
+  /// \brief Move the poses out of a changed state into the pose stream,
+  /// and record a frame of the stream. Entities which are new to the stream
+  /// keep their pose in the state as well, so that playback creates them
+  /// with it.
+  /// \param[in] _time Sim time of the state.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in,out] _stateMsg Changed state.
+  /// \param[in] _keyframe Whether a keyframe of the state is recorded on
+  /// this iteration, in which case the frame is a keyframe of the stream.
+  public: void StreamPoses(const std::chrono::steady_clock::duration &_time,
+    const EntityComponentManager &_ecm, msgs::SerializedStateMap &_stateMsg,
+    bool _keyframe);
+
+  /// \brief Record a message. It's queued straight to the log writer if
+  /// there is one, and published otherwise, so the recorder picks it up.
+  /// \param[in] _time Sim time of the message.
+  /// \param[in] _topic Topic to record the message under.
+  /// \param[in] _pub Publisher of the topic.
+  /// \param[in] _msg Message to record.
+  public: void Record(const std::chrono::steady_clock::duration &_time,
+    const std::string &_topic, transport::Node::Publisher &_pub,
+    std::unique_ptr<google::protobuf::Message> _msg);
+
   /// \brief Indicator of whether any recorder instance has ever been started.
   /// Currently, only one instance is allowed. This enforcement may be removed
   /// in the future.
@@ -112,9 +208,21 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Indicator of whether this instance has been started
   public: bool instStarted{false};
 
-  /// \brief Ignition transport recorder
+  /// \brief Ignition transport recorder, used if topics other than the
+  /// default ones are recorded, or if the log writer is disabled.
   public: transport::log::Recorder recorder;
 
+  /// \brief Writes the default topics to the log from its own thread,
+  /// without going through transport. Null if the recorder is used instead.
+  public: std::unique_ptr<LogWriter> writer;
+
+  /// \brief Whether to use the log writer when possible
+  public: bool asyncWriter{true};
+
+  /// \brief Maximum number of messages held by the log writer before
+  /// PostUpdate blocks.
+  public: std::size_t writerQueueSize{1000u};
+
   /// \brief Directory in which to place log file
   public: std::string logPath{""};
 
@@ -137,12 +245,48 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Transport node for publishing SDF string to be recorded
   public: transport::Node node;
 
+  /// \brief Topic for SDF string
+  public: std::string sdfTopic;
+
+  /// \brief Topic for state changes
+  public: std::string stateTopic;
+
+  /// \brief Topic for keyframes
+  public: std::string keyframeTopic;
+
+  /// \brief Topic for the pose stream
+  public: std::string poseStreamTopic;
+
   /// \brief Publisher for SDF string
   public: transport::Node::Publisher sdfPub;
 
+  /// \brief Publisher for the pose stream
+  public: transport::Node::Publisher poseStreamPub;
+
+  /// \brief Encoder of the pose stream, null if poses are recorded in the
+  /// changed state.
+  public: std::unique_ptr<PoseStreamEncoder> poseEncoder;
+
+  /// \brief Entities whose pose is carried by the pose stream.
+  public: std::unordered_set<Entity> streamedEntities;
+
+  /// \brief Poses of the current pose stream frame, kept to reuse memory.
+  public: std::vector<EntityPose> streamPoses;
+
   /// \brief Publisher for state changes
   public: transport::Node::Publisher statePub;
 
+  /// \brief Publisher for keyframes, which hold the complete state
+  public: transport::Node::Publisher keyframePub;
+
+  /// \brief Period of keyframes in sim time. Zero, the default, disables
+  /// them.
+  public: std::chrono::steady_clock::duration keyframePeriod{
+      std::chrono::steady_clock::duration::zero()};
+
+  /// \brief Sim time of the last keyframe
+  public: std::optional<std::chrono::steady_clock::duration> lastKeyframeTime;
+
   /// \brief Message holding SDF string of world
   public: msgs::StringMsg sdfMsg;
 
@@ -155,8 +299,51 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Compress log files at the end
   public: bool compress{false};
 
+  /// \brief Patterns of component type names to record. Empty to record
+  /// all types.
+  public: std::vector<std::regex> includeComponents;
+
+  /// \brief Patterns of component type names not to record.
+  public: std::vector<std::regex> excludeComponents;
+
+  /// \brief Patterns of model names to record, along with all that's inside
+  /// them. Empty to record all models.
+  public: std::vector<std::regex> includeModels;
+
+  /// \brief Patterns of model names not to record, along with all that's
+  /// inside them.
+  public: std::vector<std::regex> excludeModels;
+
+  /// \brief Whether each component type is recorded, cached by type id.
+  public: std::unordered_map<ComponentTypeId, bool> recordedTypes;
+
+  /// \brief How each entity is recorded, cached by entity.
+  public: std::unordered_map<Entity, EntityRecording> recordedEntities;
+
+  /// \brief Models which don't match the include patterns, but hold models
+  /// which do.
+  public: std::unordered_set<Entity> includedAncestors;
+
   /// \brief List of saved models if record with resources is enabled.
+  /// Only accessed by the resource thread while it runs.
   public: std::set<std::string> savedModels;
+
+  /// \brief Saves model resources, so that copying model directories
+  /// doesn't stall the simulation.
+  public: std::thread resourceThread;
+
+  /// \brief Models waiting to be saved by the resource thread.
+  public: std::set<std::string> queuedModels;
+
+  /// \brief Whether the resource thread should stop once the queue is
+  /// empty.
+  public: bool stopResources{false};
+
+  /// \brief Protects the queued models and the stop flag.
+  public: std::mutex resourceMutex;
+
+  /// \brief Notifies the resource thread that models were queued.
+  public: std::condition_variable resourceCv;
 };
 
 bool LogRecordPrivate::started{false};
@@ -185,8 +372,31 @@ LogRecord::~LogRecord()
 {
   if (this->dataPtr->instStarted)
   {
-    // Use ign-transport directly
-    this->dataPtr->recorder.Stop();
+    this->dataPtr->StopResourceThread();
+
+    if (this->dataPtr->writer)
+    {
+      this->dataPtr->writer->Stop();
+
+      auto stats = this->dataPtr->writer->Stats();
+      ignmsg << "Log writer wrote [" << stats.written << "] messages in ["
+             << stats.batches << "] batches of up to [" << stats.maxBatch
+             << "] messages. Simulation waited for the writer ["
+             << stats.stalls << "] times, for ["
+             << std::chrono::duration<double>(stats.stallTime).count()
+             << "] s." << std::endl;
+      if (stats.failed > 0u)
+      {
+        ignerr << "Log writer failed to write [" << stats.failed
+               << "] messages." << std::endl;
+      }
+      this->dataPtr->writer.reset();
+    }
+    else
+    {
+      // Use ign-transport directly
+      this->dataPtr->recorder.Stop();
+    }
 
     if (this->dataPtr->compress)
       this->dataPtr->CompressStateAndResources();
@@ -210,8 +420,39 @@ void LogRecord::Configure(const Entity &_entity,
     false).first);
 
   this->dataPtr->compress = _sdf->Get<bool>("compress", false).first;
+
+  auto keyframePeriod = _sdf->Get<double>("keyframe_period",
+      std::chrono::duration<double>(this->dataPtr->keyframePeriod).count());
+  this->dataPtr->keyframePeriod = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+      std::max(0.0, keyframePeriod.first)));
   this->dataPtr->cmpPath = _sdf->Get<std::string>("compress_path", "").first;
 
+  this->dataPtr->includeComponents =
+      this->dataPtr->Patterns("include_component");
+  this->dataPtr->excludeComponents =
+      this->dataPtr->Patterns("exclude_component");
+  this->dataPtr->includeModels = this->dataPtr->Patterns("include_model");
+  this->dataPtr->excludeModels = this->dataPtr->Patterns("exclude_model");
+
+  if (_sdf->HasElement("pose_stream"))
+  {
+    auto poseStreamElem = _sdf->FindElement("pose_stream");
+    PoseStreamOptions options;
+    options.positionResolution = poseStreamElem->Get<double>(
+        "position_resolution", options.positionResolution).first;
+    options.keyframeInterval = poseStreamElem->Get<unsigned int>(
+        "keyframe_interval", options.keyframeInterval).first;
+    this->dataPtr->poseEncoder = std::make_unique<PoseStreamEncoder>(options);
+  }
+
+  this->dataPtr->asyncWriter = _sdf->Get<bool>("async_writer",
+      this->dataPtr->asyncWriter).first;
+  auto writerQueueSize = _sdf->Get<int>("writer_queue_size",
+      static_cast<int>(this->dataPtr->writerQueueSize));
+  this->dataPtr->writerQueueSize = static_cast<std::size_t>(
+      std::max(1, writerQueueSize.first));
+
   // If plugin is specified in both the SDF tag and on command line, only
   //   activate one recorder.
   if (!LogRecordPrivate::started)
@@ -286,6 +527,7 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   auto validSdfTopic = transport::TopicUtils::AsValidTopic(sdfTopic);
   if (!validSdfTopic.empty())
   {
+    this->sdfTopic = validSdfTopic;
     this->sdfPub = this->node.Advertise(validSdfTopic,
         this->sdfMsg.GetTypeName());
   }
@@ -300,6 +542,7 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   auto validStateTopic = transport::TopicUtils::AsValidTopic(stateTopic);
   if (!validStateTopic.empty())
   {
+    this->stateTopic = validStateTopic;
     this->statePub = this->node.Advertise<msgs::SerializedStateMap>(
         validStateTopic);
   }
@@ -309,6 +552,46 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
            << stateTopic << "]." << std::endl;
   }
 
+  // Keyframes are recorded on their own topic, so playback can look up the
+  // latest one before a given time without going through the changes
+  std::string keyframeTopic = "/world/" + this->worldName + "/state_keyframe";
+  auto validKeyframeTopic = transport::TopicUtils::AsValidTopic(keyframeTopic);
+  if (this->keyframePeriod > std::chrono::steady_clock::duration::zero())
+  {
+    if (!validKeyframeTopic.empty())
+    {
+      this->keyframeTopic = validKeyframeTopic;
+      this->keyframePub = this->node.Advertise<msgs::SerializedStateMap>(
+          validKeyframeTopic);
+    }
+    else
+    {
+      ignerr << "Failed to generate valid topic to publish keyframes. Tried ["
+             << keyframeTopic << "]." << std::endl;
+    }
+  }
+
+  // Poses are optionally recorded apart from the rest of the state, in a
+  // compact stream
+  std::string poseStreamTopic = "/world/" + this->worldName + "/pose_stream";
+  if (this->poseEncoder)
+  {
+    auto validPoseStreamTopic =
+        transport::TopicUtils::AsValidTopic(poseStreamTopic);
+    if (!validPoseStreamTopic.empty())
+    {
+      this->poseStreamTopic = validPoseStreamTopic;
+      this->poseStreamPub = this->node.Advertise<msgs::Bytes>(
+          validPoseStreamTopic);
+    }
+    else
+    {
+      ignerr << "Failed to generate valid topic to publish the pose stream. "
+             << "Tried [" << poseStreamTopic << "]." << std::endl;
+      this->poseEncoder.reset();
+    }
+  }
+
   // Append file name
   std::string dbPath = common::joinPaths(this->logPath, "state.tlog");
   if (common::exists(dbPath))
@@ -318,11 +601,37 @@ bool LogRecordPrivate::Start(const std::string &_logPath,
   }
   ignmsg << "Recording to log file [" << dbPath << "]" << std::endl;
 
+  // The default topics are produced by this system, so they can be handed
+  // straight to the log writer. Other topics need the recorder, which owns
+  // the log file, so then everything goes through it.
+  if (this->asyncWriter && !this->sdf->HasElement("record_topic"))
+  {
+    this->writer = std::make_unique<LogWriter>(this->writerQueueSize);
+    if (this->writer->Start(dbPath))
+    {
+      igndbg << "Recording default topics with the log writer.\n";
+      this->instStarted = true;
+      return true;
+    }
+    this->writer.reset();
+    return false;
+  }
+
   // Add default topics if no topics were specified.
   igndbg << "Recording default topic[" << sdfTopic << "].\n";
   igndbg << "Recording default topic[" << stateTopic << "].\n";
   this->recorder.AddTopic(sdfTopic);
   this->recorder.AddTopic(stateTopic);
+  if (this->keyframePub)
+  {
+    igndbg << "Recording default topic[" << keyframeTopic << "].\n";
+    this->recorder.AddTopic(keyframeTopic);
+  }
+  if (this->poseEncoder)
+  {
+    igndbg << "Recording default topic[" << poseStreamTopic << "].\n";
+    this->recorder.AddTopic(poseStreamTopic);
+  }
 
   // Get the topics to record, if any.
   if (this->sdf->HasElement("record_topic"))
@@ -426,12 +735,64 @@ void LogRecordPrivate::LogModelResources(const EntityComponentManager &_ecm)
     return true;
   });
 
-  if (!this->SaveModels(modelSdfPaths))
+  if (!modelSdfPaths.empty())
+    this->QueueModels(std::move(modelSdfPaths));
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::QueueModels(std::set<std::string> _models)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->resourceMutex);
+    this->queuedModels.merge(_models);
+    if (!this->resourceThread.joinable())
+    {
+      this->stopResources = false;
+      this->resourceThread = std::thread(
+          &LogRecordPrivate::RunResourceThread, this);
+    }
+  }
+  this->resourceCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::RunResourceThread()
+{
+  std::set<std::string> models;
+  while (true)
   {
-    ignwarn << "Failed to save model resources during logging\n";
+    {
+      std::unique_lock<std::mutex> lock(this->resourceMutex);
+      this->resourceCv.wait(lock, [this]
+      {
+        return this->stopResources || !this->queuedModels.empty();
+      });
+      if (this->queuedModels.empty())
+        return;
+      models.swap(this->queuedModels);
+    }
+
+    if (!this->SaveModels(models))
+    {
+      ignwarn << "Failed to save model resources during logging\n";
+    }
+    models.clear();
   }
 }
 
+//////////////////////////////////////////////////
+void LogRecordPrivate::StopResourceThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->resourceMutex);
+    if (!this->resourceThread.joinable())
+      return;
+    this->stopResources = true;
+  }
+  this->resourceCv.notify_one();
+  this->resourceThread.join();
+}
+
 //////////////////////////////////////////////////
 bool LogRecordPrivate::SaveModels(const std::set<std::string> &_models)
 {
@@ -617,8 +978,16 @@ void LogRecordPrivate::CompressStateAndResources()
     common::removeFile(this->cmpPath);
   }
 
+  // Compress to a temporary file, so that an interrupted compression
+  // doesn't leave a truncated archive behind. The recorded directory is only
+  // removed once the archive is complete.
+  const std::string partPath = this->cmpPath + ".part";
+  if (common::exists(partPath))
+    common::removeFile(partPath);
+
   // Compress directory
-  if (fuel_tools::Zip::Compress(this->logPath, this->cmpPath))
+  if (fuel_tools::Zip::Compress(this->logPath, partPath) &&
+      common::moveFile(partPath, this->cmpPath))
   {
     ignmsg << "Compressed log file and resources to [" << this->cmpPath
            << "].\nRemoving recorded directory [" << this->logPath << "]."
@@ -628,19 +997,256 @@ void LogRecordPrivate::CompressStateAndResources()
   }
   else
   {
+    if (common::exists(partPath))
+      common::removeFile(partPath);
     ignerr << "Failed to compress log file and resources to ["
            << this->cmpPath << "]. Keeping recorded directory ["
            << this->logPath << "]." << std::endl;
   }
 }
 
+//////////////////////////////////////////////////
+std::vector<std::regex> LogRecordPrivate::Patterns(
+    const std::string &_name) const
+{
+  std::vector<std::regex> patterns;
+  if (!this->sdf->HasElement(_name))
+    return patterns;
+
+  auto ptr = const_cast<sdf::Element *>(this->sdf.get());
+  for (auto elem = ptr->GetElement(_name); elem;
+      elem = elem->GetNextElement(_name))
+  {
+    auto pattern = elem->Get<std::string>();
+    try
+    {
+      patterns.emplace_back(pattern);
+    }
+    catch (const std::regex_error &_err)
+    {
+      ignerr << "Invalid regular expression [" << pattern << "] in <"
+             << _name << ">: " << _err.what() << std::endl;
+    }
+  }
+  return patterns;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether a name matches any of a list of patterns.
+/// \param[in] _patterns Regular expressions.
+/// \param[in] _name Name.
+/// \return True if any pattern matches the whole name.
+static bool matchesAny(const std::vector<std::regex> &_patterns,
+    const std::string &_name)
+{
+  return std::any_of(_patterns.begin(), _patterns.end(),
+      [&_name](const std::regex &_pattern)
+      {
+        return std::regex_match(_name, _pattern);
+      });
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::RecordType(const ComponentTypeId _type)
+{
+  auto it = this->recordedTypes.find(_type);
+  if (it != this->recordedTypes.end())
+    return it->second;
+
+  const auto name = components::Factory::Instance()->Name(_type);
+  const bool record = (this->includeComponents.empty() ||
+      matchesAny(this->includeComponents, name)) &&
+      !matchesAny(this->excludeComponents, name);
+  this->recordedTypes[_type] = record;
+  return record;
+}
+
+//////////////////////////////////////////////////
+LogRecordPrivate::EntityRecording LogRecordPrivate::RecordEntity(
+    const EntityComponentManager &_ecm, const Entity _entity)
+{
+  auto it = this->recordedEntities.find(_entity);
+  if (it != this->recordedEntities.end())
+    return it->second;
+
+  const bool isModel = _ecm.EntityHasComponentType(_entity,
+      components::Model::typeId);
+  std::string name;
+  if (isModel)
+  {
+    auto nameComp = _ecm.Component<components::Name>(_entity);
+    if (nullptr != nameComp)
+      name = nameComp->Data();
+  }
+  const Entity parent = _ecm.ParentEntity(_entity);
+  const auto parentRecording = parent == kNullEntity ?
+      EntityRecording::kRecorded : this->RecordEntity(_ecm, parent);
+
+  EntityRecording recording{EntityRecording::kRecorded};
+  if (parentRecording == EntityRecording::kExcluded ||
+      (isModel && matchesAny(this->excludeModels, name)))
+  {
+    recording = EntityRecording::kExcluded;
+  }
+  else if (this->includeModels.empty() ||
+      parentRecording == EntityRecording::kIncluded ||
+      (isModel && matchesAny(this->includeModels, name)))
+  {
+    recording = EntityRecording::kIncluded;
+  }
+  else if (isModel && this->includedAncestors.count(_entity) == 0u)
+  {
+    // Models which neither match nor hold a match aren't recorded, while
+    // other entities outside models, such as lights, are
+    recording = EntityRecording::kExcluded;
+  }
+
+  this->recordedEntities[_entity] = recording;
+  return recording;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::UpdateIncludedAncestors(
+    const EntityComponentManager &_ecm)
+{
+  if (this->includeModels.empty())
+    return;
+
+  _ecm.EachNew<components::Model, components::Name>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Name *_name) -> bool
+      {
+        if (!matchesAny(this->includeModels, _name->Data()))
+          return true;
+
+        for (auto parent = _ecm.ParentEntity(_entity);
+            parent != kNullEntity; parent = _ecm.ParentEntity(parent))
+        {
+          this->includedAncestors.insert(parent);
+        }
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::FilterState(const EntityComponentManager &_ecm,
+    msgs::SerializedStateMap &_stateMsg)
+{
+  auto &entities = *_stateMsg.mutable_entities();
+  for (auto it = entities.begin(); it != entities.end();)
+  {
+    if (this->RecordEntity(_ecm, it->second.id()) ==
+        EntityRecording::kExcluded)
+    {
+      it = entities.erase(it);
+      continue;
+    }
+
+    auto &components = *it->second.mutable_components();
+    for (auto compIt = components.begin(); compIt != components.end();)
+    {
+      if (this->RecordType(compIt->second.type()))
+        ++compIt;
+      else
+        compIt = components.erase(compIt);
+    }
+    ++it;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::StreamPoses(
+    const std::chrono::steady_clock::duration &_time,
+    const EntityComponentManager &_ecm, msgs::SerializedStateMap &_stateMsg,
+    const bool _keyframe)
+{
+  IGN_PROFILE("LogRecordPrivate::StreamPoses");
+  this->streamPoses.clear();
+
+  auto &entities = *_stateMsg.mutable_entities();
+  for (auto it = entities.begin(); it != entities.end();)
+  {
+    auto &entityMsg = it->second;
+    const Entity entity = entityMsg.id();
+    if (entityMsg.remove())
+    {
+      this->streamedEntities.erase(entity);
+      ++it;
+      continue;
+    }
+
+    auto &components = *entityMsg.mutable_components();
+    auto compIt = components.find(components::Pose::typeId);
+    auto poseComp = _ecm.Component<components::Pose>(entity);
+    if (compIt == components.end() || nullptr == poseComp)
+    {
+      ++it;
+      continue;
+    }
+
+    this->streamPoses.emplace_back(entity, poseComp->Data());
+    if (this->streamedEntities.insert(entity).second)
+    {
+      ++it;
+      continue;
+    }
+
+    components.erase(compIt);
+    if (components.empty())
+      it = entities.erase(it);
+    else
+      ++it;
+  }
+
+  // Frames after a keyframe of the state only depend on the stream's
+  // keyframe recorded with it, so playback can seek to it
+  if (_keyframe)
+    this->poseEncoder->RequestKeyframe();
+
+  if (this->streamPoses.empty())
+    return;
+
+  // Sorted ids are stored as small differences
+  std::sort(this->streamPoses.begin(), this->streamPoses.end(),
+      [](const EntityPose &_a, const EntityPose &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  auto frameMsg = std::make_unique<msgs::Bytes>();
+  this->poseEncoder->Encode(this->streamPoses, _time,
+      *frameMsg->mutable_data());
+  this->Record(_time, this->poseStreamTopic, this->poseStreamPub,
+      std::move(frameMsg));
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::Record(const std::chrono::steady_clock::duration &_time,
+    const std::string &_topic, transport::Node::Publisher &_pub,
+    std::unique_ptr<google::protobuf::Message> _msg)
+{
+  if (!this->writer)
+  {
+    _pub.Publish(*_msg);
+    return;
+  }
+
+  if (_topic.empty())
+    return;
+
+  // Other subscribers may still be listening on the topic
+  if (_pub.HasConnections())
+    _pub.Publish(*_msg);
+  this->writer->Write(_time, _topic, std::move(_msg));
+}
+
 //////////////////////////////////////////////////
 void LogRecord::PreUpdate(const UpdateInfo &_info,
     EntityComponentManager &)
 {
   IGN_PROFILE("LogRecord::PreUpdate");
   // Safe guard to prevent seg faults if recorder could not be started
-  if (!this->dataPtr->instStarted)
+  if (!this->dataPtr->instStarted || !this->dataPtr->clock)
     return;
   this->dataPtr->clock->SetTime(_info.simTime);
 }
@@ -684,7 +1290,9 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
         this->dataPtr->sdfMsg.set_data(
             worldSdfComp->Data().Element()->ToString(""));
 
-        this->dataPtr->sdfPub.Publish(this->dataPtr->sdfMsg);
+        this->dataPtr->Record(_info.simTime, this->dataPtr->sdfTopic,
+            this->dataPtr->sdfPub,
+            std::make_unique<msgs::StringMsg>(this->dataPtr->sdfMsg));
         this->dataPtr->sdfPublished = true;
       }
     }
@@ -692,14 +1300,69 @@ void LogRecord::PostUpdate(const UpdateInfo &_info,
 
   // TODO(louise) Use the SceneBroadcaster's topic once that publishes
   // the changed state
-  // \todo(anyone) A potential enhancement here is have a keyframe mechanism
-  // to store complete state periodically, and then store incremental from
-  // that. It would reduce some of the compute on replaying
-  // (especially in tools like plotting or seeking through logs).
-  msgs::SerializedStateMap stateMsg;
-  _ecm.ChangedState(stateMsg);
-  if (!stateMsg.entities().empty())
-    this->dataPtr->statePub.Publish(stateMsg);
+  // Periodically store the complete state as well, so that playback can
+  // seek to it instead of replaying all changes from the beginning. The
+  // changes are still recorded, so the keyframes are optional for playback.
+  const bool keyframeDue = this->dataPtr->keyframePub &&
+      (!this->dataPtr->lastKeyframeTime.has_value() ||
+      _info.simTime - *this->dataPtr->lastKeyframeTime >=
+      this->dataPtr->keyframePeriod ||
+      _info.simTime < *this->dataPtr->lastKeyframeTime);
+
+  // Filtered out entities and components aren't serialized at all
+  auto stateMsg = std::make_unique<msgs::SerializedStateMap>();
+  const bool filterModels = !this->dataPtr->includeModels.empty() ||
+      !this->dataPtr->excludeModels.empty();
+  const bool filterTypes = !this->dataPtr->includeComponents.empty() ||
+      !this->dataPtr->excludeComponents.empty();
+  if (filterModels || filterTypes)
+  {
+    this->dataPtr->UpdateIncludedAncestors(_ecm);
+
+    std::function<bool(const Entity)> entityFilter;
+    if (filterModels)
+    {
+      entityFilter = [&](const Entity _entity)
+      {
+        return this->dataPtr->RecordEntity(_ecm, _entity) !=
+            LogRecordPrivate::EntityRecording::kExcluded;
+      };
+    }
+    std::function<bool(const ComponentTypeId)> typeFilter;
+    if (filterTypes)
+    {
+      typeFilter = [&](const ComponentTypeId _type)
+      {
+        return this->dataPtr->RecordType(_type);
+      };
+    }
+    _ecm.ChangedState(*stateMsg, entityFilter, typeFilter);
+  }
+  else
+  {
+    _ecm.ChangedState(*stateMsg);
+  }
+  if (this->dataPtr->poseEncoder)
+  {
+    this->dataPtr->StreamPoses(_info.simTime, _ecm, *stateMsg,
+        keyframeDue);
+  }
+  if (!stateMsg->entities().empty())
+  {
+    this->dataPtr->Record(_info.simTime, this->dataPtr->stateTopic,
+        this->dataPtr->statePub, std::move(stateMsg));
+  }
+
+  if (keyframeDue)
+  {
+    auto keyframeMsg = std::make_unique<msgs::SerializedStateMap>();
+    _ecm.State(*keyframeMsg, {}, {}, true);
+    if (filterModels || filterTypes)
+      this->dataPtr->FilterState(_ecm, *keyframeMsg);
+    this->dataPtr->Record(_info.simTime, this->dataPtr->keyframeTopic,
+        this->dataPtr->keyframePub, std::move(keyframeMsg));
+    this->dataPtr->lastKeyframeTime = _info.simTime;
+  }
 
   // If there are new models loaded, save meshes and textures
   if (this->dataPtr->RecordResources() && _ecm.HasNewEntities())
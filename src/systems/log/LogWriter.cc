@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "LogWriter.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/transport/log/Log.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief A message waiting to be written.
+struct LogWriterEntry
+{
+  /// \brief Time to stamp the message with.
+  std::chrono::nanoseconds time;
+
+  /// \brief Topic to record the message under.
+  std::string topic;
+
+  /// \brief Message to write.
+  std::unique_ptr<google::protobuf::Message> msg;
+};
+
+// Private data class.
+class ignition::gazebo::systems::LogWriter::Implementation
+{
+  /// \brief Run by the writer thread until the writer is stopped and the
+  /// queue is empty.
+  public: void Run();
+
+  /// \brief Maximum number of queued messages.
+  public: std::size_t capacity;
+
+  /// \brief Log file being written.
+  public: transport::log::Log log;
+
+  /// \brief Messages waiting to be written.
+  public: std::vector<LogWriterEntry> queue;
+
+  /// \brief Counters, protected by the mutex.
+  public: LogWriterStats stats;
+
+  /// \brief Whether the writer thread should stop once the queue is empty.
+  public: bool stop{false};
+
+  /// \brief Protects the queue, the counters and the stop flag.
+  public: mutable std::mutex mutex;
+
+  /// \brief Notifies the writer thread that messages were queued.
+  public: std::condition_variable queued;
+
+  /// \brief Notifies Write that the queue was emptied.
+  public: std::condition_variable drained;
+
+  /// \brief Writer thread.
+  public: std::thread thread;
+};
+
+//////////////////////////////////////////////////
+void LogWriter::Implementation::Run()
+{
+  // Reused across batches, so that the queue and the buffer keep their
+  // capacity
+  std::vector<LogWriterEntry> batch;
+  std::string data;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->queued.wait(lock, [this]
+      {
+        return this->stop || !this->queue.empty();
+      });
+      if (this->queue.empty())
+        return;
+      batch.swap(this->queue);
+    }
+    this->drained.notify_all();
+
+    IGN_PROFILE("LogWriter::Run");
+    uint64_t failed{0u};
+    for (auto &entry : batch)
+    {
+      data.clear();
+      if (!entry.msg->SerializeToString(&data) ||
+          !this->log.InsertMessage(entry.time, entry.topic,
+            entry.msg->GetTypeName(), data.data(), data.size()))
+      {
+        ++failed;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stats.written += batch.size() - failed;
+      this->stats.failed += failed;
+      ++this->stats.batches;
+      this->stats.maxBatch = std::max(this->stats.maxBatch, batch.size());
+    }
+    if (failed > 0u)
+    {
+      ignerr << "Failed to write [" << failed << "] messages to the log."
+             << std::endl;
+    }
+    batch.clear();
+  }
+}
+
+//////////////////////////////////////////////////
+LogWriter::LogWriter(const std::size_t _capacity)
+  : dataPtr(std::make_unique<Implementation>())
+{
+  this->dataPtr->capacity = std::max<std::size_t>(_capacity, 1u);
+  this->dataPtr->queue.reserve(this->dataPtr->capacity);
+}
+
+//////////////////////////////////////////////////
+LogWriter::~LogWriter()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+bool LogWriter::Start(const std::string &_path)
+{
+  if (this->dataPtr->thread.joinable())
+  {
+    ignerr << "Log writer already started." << std::endl;
+    return false;
+  }
+
+  // This creates the file and loads the sql schema
+  if (!this->dataPtr->log.Open(_path, std::ios_base::out))
+  {
+    ignerr << "Failed to open log file [" << _path << "]." << std::endl;
+    return false;
+  }
+
+  this->dataPtr->stop = false;
+  this->dataPtr->thread = std::thread(&Implementation::Run,
+      this->dataPtr.get());
+  return true;
+}
+
+//////////////////////////////////////////////////
+void LogWriter::Stop()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->queued.notify_all();
+  this->dataPtr->thread.join();
+}
+
+//////////////////////////////////////////////////
+void LogWriter::Write(const std::chrono::steady_clock::duration &_time,
+    const std::string &_topic,
+    std::unique_ptr<google::protobuf::Message> _msg)
+{
+  if (!_msg)
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->stop || !this->dataPtr->thread.joinable())
+    {
+      ++this->dataPtr->stats.failed;
+      return;
+    }
+
+    if (this->dataPtr->queue.size() >= this->dataPtr->capacity)
+    {
+      IGN_PROFILE("LogWriter::Write stall");
+      auto start = std::chrono::steady_clock::now();
+      this->dataPtr->drained.wait(lock, [this]
+      {
+        return this->dataPtr->queue.size() < this->dataPtr->capacity;
+      });
+      ++this->dataPtr->stats.stalls;
+      this->dataPtr->stats.stallTime +=
+          std::chrono::steady_clock::now() - start;
+    }
+
+    this->dataPtr->queue.push_back({
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_time),
+        _topic, std::move(_msg)});
+  }
+  this->dataPtr->queued.notify_one();
+}
+
+//////////////////////////////////////////////////
+LogWriterStats LogWriter::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_LOGWRITER_HH_
+#define IGNITION_GAZEBO_SYSTEMS_LOGWRITER_HH_
+
+#include <google/protobuf/message.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Counters describing how the writer kept up with the messages
+  /// given to it.
+  struct LogWriterStats
+  {
+    /// \brief Number of messages written to the log.
+    uint64_t written{0u};
+
+    /// \brief Number of batches written to the log.
+    uint64_t batches{0u};
+
+    /// \brief Largest number of messages written in a single batch.
+    std::size_t maxBatch{0u};
+
+    /// \brief Number of times Write had to wait for room in the queue.
+    uint64_t stalls{0u};
+
+    /// \brief Total time spent by Write waiting for room in the queue.
+    std::chrono::steady_clock::duration stallTime{
+        std::chrono::steady_clock::duration::zero()};
+
+    /// \brief Number of messages which couldn't be written to the log.
+    uint64_t failed{0u};
+  };
+
+  /// \brief Writes messages to an ign-transport log file from a thread of
+  /// its own.
+  ///
+  /// Messages are handed over to the writer without being published or
+  /// serialized. The writer thread takes all the queued messages at once,
+  /// serializes them and inserts them as a single batch, so many simulation
+  /// steps share each database transaction.
+  ///
+  /// The queue is bounded. When it's full, Write blocks until the writer
+  /// thread catches up, instead of dropping messages, because each state
+  /// message only holds the changes since the previous one. The time spent
+  /// blocked is reported through Stats.
+  class LogWriter
+  {
+    /// \brief Constructor
+    /// \param[in] _capacity Maximum number of queued messages.
+    public: explicit LogWriter(std::size_t _capacity);
+
+    /// \brief Destructor. Writes all queued messages and closes the log.
+    public: ~LogWriter();
+
+    /// \brief Open the log file and start the writer thread.
+    /// \param[in] _path Path of the log file, which must not exist.
+    /// \return True if the file was opened.
+    public: bool Start(const std::string &_path);
+
+    /// \brief Write all queued messages, stop the writer thread and close
+    /// the log file. Write can't be called after this.
+    public: void Stop();
+
+    /// \brief Queue a message to be written to the log. Blocks while the
+    /// queue is full.
+    /// \param[in] _time Time to stamp the message with.
+    /// \param[in] _topic Topic to record the message under.
+    /// \param[in] _msg Message to write.
+    public: void Write(const std::chrono::steady_clock::duration &_time,
+                const std::string &_topic,
+                std::unique_ptr<google::protobuf::Message> _msg);
+
+    /// \brief Get the counters accumulated since the writer started.
+    /// \return Writer counters.
+    public: LogWriterStats Stats() const;
+
+    /// \brief Forward declaration of the private data.
+    private: class Implementation;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<Implementation> dataPtr;
+  };
+  }
+}
+}
+}
+#endif
@@ -17,6 +17,7 @@
 
 #include "LogicalAudioSensorPlugin.hh"
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <mutex>
@@ -24,6 +25,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <ignition/gazebo/components/LogicalAudio.hh>
 #include <ignition/gazebo/components/Model.hh>
@@ -31,10 +33,12 @@
 #include <ignition/gazebo/components/Pose.hh>
 #include <ignition/gazebo/components/Sensor.hh>
 #include <ignition/gazebo/components/World.hh>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/msgs.hh>
 #include <ignition/transport.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/gazebo/SdfEntityCreator.hh>
+#include <ignition/gazebo/SpatialIndex.hh>
 #include <ignition/gazebo/Util.hh>
 #include <sdf/Element.hh>
 #include "LogicalAudio.hh"
@@ -43,8 +47,60 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief State of an audio source on the previous update.
+struct SourceState
+{
+  /// \brief World pose of the source.
+  math::Pose3d pose;
+
+  /// \brief Properties of the source.
+  logical_audio::Source source;
+
+  /// \brief Playing information of the source.
+  logical_audio::SourcePlayInfo playInfo;
+
+  /// \brief Scoped name of the source, which is embedded in detection
+  /// messages.
+  std::string name;
+
+  /// \brief Whether the source was found on the current update.
+  bool seen{false};
+};
+
+/// \brief State of a microphone on the previous update.
+struct MicState
+{
+  /// \brief World pose of the microphone.
+  math::Pose3d pose;
+
+  /// \brief Properties of the microphone.
+  logical_audio::Microphone mic;
+
+  /// \brief Sources detected by the microphone, with the volume at which
+  /// they were detected.
+  std::vector<std::pair<Entity, double>> detections;
+
+  /// \brief Whether the detections have been evaluated at least once.
+  bool valid{false};
+};
+
 class ignition::gazebo::systems::LogicalAudioSensorPluginPrivate
 {
+  /// \brief Update the state of all sources and their boxes in the source
+  /// index. Sources which moved, changed or were removed since the previous
+  /// update are added to changedSources.
+  /// \param[in] _ecm The simulation's EntityComponentManager.
+  public: void UpdateSources(const EntityComponentManager &_ecm);
+
+  /// \brief Evaluate which sources a microphone detects, reusing the
+  /// previous detections if neither the microphone nor any source that
+  /// may reach it changed.
+  /// \param[in] _micEntity The microphone entity.
+  /// \param[in] _ecm The simulation's EntityComponentManager.
+  /// \param[in,out] _state The microphone's state.
+  public: void EvaluateMicrophone(const Entity _micEntity,
+              const EntityComponentManager &_ecm, MicState &_state) const;
+
   /// \brief Creates an audio source with attributes specified in an SDF file.
   /// \param[in] _elem A pointer to the source element in the SDF file.
   /// \param[in] _parent The source element's parent entity.
@@ -106,6 +162,22 @@ class ignition::gazebo::systems::LogicalAudioSensorPluginPrivate
   /// \brief A mutex used to ensure that the stop source service call does
   /// not interfere with the source's state in the PreUpdate step.
   public: std::mutex stopSourceMutex;
+
+  /// \brief State of every audio source in the world, including the ones
+  /// created by other instances of this plugin.
+  public: std::unordered_map<Entity, SourceState> sourceStates;
+
+  /// \brief Index of the playing sources by the box around their falloff
+  /// sphere, so that each microphone only evaluates the sources which may
+  /// reach it.
+  public: SpatialIndex sourceIndex;
+
+  /// \brief Sources which moved, changed or were removed on the current
+  /// update.
+  public: std::unordered_set<Entity> changedSources;
+
+  /// \brief State of each microphone.
+  public: std::unordered_map<Entity, MicState> micStates;
 };
 
 //////////////////////////////////////////////////
@@ -212,48 +284,170 @@ void LogicalAudioSensorPlugin::PostUpdate(const UpdateInfo &_info,
     std::chrono::duration_cast<std::chrono::nanoseconds>(_info.simTime);
   const auto nanosecondOffset = (simNanoseconds - simSeconds).count();
 
-  for (auto & [micEntity, detectionPub] : this->dataPtr->micEntities)
+  this->dataPtr->UpdateSources(_ecm);
+
+  // Microphones are independent of each other, so they're evaluated
+  // concurrently, and detections are published afterwards
+  std::vector<std::pair<Entity, MicState *>> mics;
+  mics.reserve(this->dataPtr->micEntities.size());
+  for (const auto &micEntity : this->dataPtr->micEntities)
+  {
+    mics.emplace_back(micEntity.first,
+        &this->dataPtr->micStates[micEntity.first]);
+  }
+
+  _ecm.ParallelFor(mics.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+      this->dataPtr->EvaluateMicrophone(mics[i].first, _ecm, *mics[i].second);
+  });
+
+  for (const auto & [micEntity, state] : mics)
+  {
+    auto &publisher = this->dataPtr->micEntities[micEntity];
+    for (const auto & [sourceEntity, vol] : state->detections)
+    {
+      // publish the source that the microphone heard, along with the
+      // volume level the microphone detected. The detected source's
+      // ID is embedded in the message's header
+      ignition::msgs::Double msg;
+      auto header = msg.mutable_header();
+      auto timeStamp = header->mutable_stamp();
+      timeStamp->set_sec(simSeconds.count());
+      timeStamp->set_nsec(nanosecondOffset);
+      auto headerData = header->add_data();
+      headerData->set_key(this->dataPtr->sourceStates[sourceEntity].name);
+      msg.set_data(vol);
+
+      publisher.Publish(msg);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void LogicalAudioSensorPluginPrivate::UpdateSources(
+    const EntityComponentManager &_ecm)
+{
+  this->changedSources.clear();
+
+  _ecm.Each<components::LogicalAudioSource,
+            components::LogicalAudioSourcePlayInfo>(
+    [&](const Entity &_entity,
+        const components::LogicalAudioSource *_source,
+        const components::LogicalAudioSourcePlayInfo *_playInfo)
+    {
+      const auto sourcePose = _ecm.WorldPose(_entity);
+
+      auto [it, isNew] = this->sourceStates.try_emplace(_entity);
+      auto &state = it->second;
+      state.seen = true;
+      if (isNew)
+      {
+        state.name = scopedName(_entity, _ecm);
+      }
+      else if (state.pose == sourcePose &&
+          state.source == _source->Data() &&
+          state.playInfo == _playInfo->Data())
+      {
+        return true;
+      }
+
+      state.pose = sourcePose;
+      state.source = _source->Data();
+      state.playInfo = _playInfo->Data();
+      this->changedSources.insert(_entity);
+
+      // Sources which aren't playing can't be heard
+      if (!state.playInfo.playing)
+      {
+        this->sourceIndex.Remove(_entity);
+        return true;
+      }
+
+      // The volume is zero beyond the falloff distance
+      const double radius = std::max(state.source.falloffDistance,
+          state.source.innerRadius);
+      const math::Vector3d extent(radius, radius, radius);
+      this->sourceIndex.Update(_entity, math::AxisAlignedBox(
+          sourcePose.Pos() - extent, sourcePose.Pos() + extent));
+
+      return true;
+    });
+
+  for (auto it = this->sourceStates.begin(); it != this->sourceStates.end();)
   {
-    const auto micPose = worldPose(micEntity, _ecm);
-    const auto micInfo = _ecm.Component<components::LogicalMicrophone>(
-        micEntity)->Data();
+    if (!it->second.seen)
+    {
+      this->sourceIndex.Remove(it->first);
+      this->changedSources.insert(it->first);
+      it = this->sourceStates.erase(it);
+      continue;
+    }
+    it->second.seen = false;
+    ++it;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogicalAudioSensorPluginPrivate::EvaluateMicrophone(
+    const Entity _micEntity, const EntityComponentManager &_ecm,
+    MicState &_state) const
+{
+  const auto micPose = _ecm.WorldPose(_micEntity);
+  const auto &micInfo = _ecm.Component<components::LogicalMicrophone>(
+      _micEntity)->Data();
 
-    _ecm.Each<components::LogicalAudioSource,
-              components::LogicalAudioSourcePlayInfo>(
-      [&, &publisher = detectionPub](const Entity &_entity,
-          const components::LogicalAudioSource *_source,
-          const components::LogicalAudioSourcePlayInfo *_playInfo)
+  if (_state.valid && _state.pose == micPose && _state.mic == micInfo)
+  {
+    // The microphone didn't change, so the detections only need to be
+    // evaluated again if a source it heard, or a source which may now reach
+    // it, changed
+    bool affected{false};
+    for (const auto &entity : this->changedSources)
+    {
+      const auto &box = this->sourceIndex.Box(entity);
+      if (box.Contains(micPose.Pos()))
       {
-        const auto sourcePose = worldPose(_entity, _ecm);
-        const auto vol = logical_audio::computeVolume(
-            _playInfo->Data().playing,
-            _source->Data().attFunc,
-            _source->Data().attShape,
-            _source->Data().emissionVolume,
-            _source->Data().innerRadius,
-            _source->Data().falloffDistance,
-            sourcePose,
-            micPose);
-
-        if (logical_audio::detect(vol, micInfo.volumeDetectionThreshold))
+        affected = true;
+        break;
+      }
+      for (const auto &detection : _state.detections)
+      {
+        if (detection.first == entity)
         {
-          // publish the source that the microphone heard, along with the
-          // volume level the microphone detected. The detected source's
-          // ID is embedded in the message's header
-          ignition::msgs::Double msg;
-          auto header = msg.mutable_header();
-          auto timeStamp = header->mutable_stamp();
-          timeStamp->set_sec(simSeconds.count());
-          timeStamp->set_nsec(nanosecondOffset);
-          auto headerData = header->add_data();
-          headerData->set_key(scopedName(_entity, _ecm));
-          msg.set_data(vol);
-
-          publisher.Publish(msg);
+          affected = true;
+          break;
         }
+      }
+      if (affected)
+        break;
+    }
+    if (!affected)
+      return;
+  }
 
-        return true;
-      });
+  _state.pose = micPose;
+  _state.mic = micInfo;
+  _state.valid = true;
+  _state.detections.clear();
+
+  const math::AxisAlignedBox micBox(micPose.Pos(), micPose.Pos());
+  for (const auto &entity : this->sourceIndex.QueryBox(micBox))
+  {
+    const auto &source = this->sourceStates.at(entity);
+    const auto vol = logical_audio::computeVolume(
+        source.playInfo.playing,
+        source.source.attFunc,
+        source.source.attShape,
+        source.source.emissionVolume,
+        source.source.innerRadius,
+        source.source.falloffDistance,
+        source.pose,
+        micPose);
+
+    if (logical_audio::detect(vol, micInfo.volumeDetectionThreshold))
+      _state.detections.emplace_back(entity, vol);
   }
 }
 
@@ -30,6 +30,7 @@
 
 #include <sdf/Sensor.hh>
 
+#include <ignition/math/Frustum.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/transport/Node.hh>
 
@@ -44,6 +45,7 @@
 #include "ignition/gazebo/components/Sensor.hh"
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/SpatialIndex.hh"
 #include "ignition/gazebo/Util.hh"
 
 using namespace ignition;
@@ -83,9 +85,12 @@ class ignition::gazebo::systems::LogicalCameraPrivate
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
-  /// \brief Update logicalCamera sensor data based on physics data
+  /// \brief Update the logicalCamera sensors which are due and have
+  /// subscribers, based on physics data.
+  /// \param[in] _info Current simulation information.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void UpdateLogicalCameras(const EntityComponentManager &_ecm);
+  public: void UpdateLogicalCameras(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove logicalCamera sensors if their entities have been removed
   /// from simulation.
@@ -142,34 +147,7 @@ void LogicalCamera::PostUpdate(const UpdateInfo &_info,
 
   // Only update and publish if not paused.
   if (!_info.paused)
-  {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the LogicalCameraPrivate::UpdateLogicalCameras
-    // function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->UpdateLogicalCameras(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update sensor
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
-  }
+    this->dataPtr->UpdateLogicalCameras(_info, _ecm);
 
   this->dataPtr->RemoveLogicalCameraEntities(_ecm);
 }
@@ -249,24 +227,10 @@ void LogicalCameraPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void LogicalCameraPrivate::UpdateLogicalCameras(
+void LogicalCameraPrivate::UpdateLogicalCameras(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("LogicalCameraPrivate::UpdateLogicalCameras");
-  std::map<std::string, math::Pose3d> modelPoses;
-
-  _ecm.Each<components::Model, components::Name, components::Pose>(
-      [&](const Entity &,
-        const components::Model *,
-        const components::Name *_name,
-        const components::Pose *_pose)->bool
-      {
-        /// todo(anyone) We currently assume there are only top level models
-        /// Update to retrieve world pose when nested models are supported.
-        modelPoses[_name->Data()] = _pose->Data();
-        return true;
-      });
-
 
   _ecm.Each<components::LogicalCamera, components::WorldPose>(
     [&](const Entity &_entity,
@@ -274,19 +238,47 @@ void LogicalCameraPrivate::UpdateLogicalCameras(
         const components::WorldPose *_worldPose)->bool
       {
         auto it = this->entitySensorMap.find(_entity);
-        if (it != this->entitySensorMap.end())
-        {
-          const math::Pose3d &worldPose = _worldPose->Data();
-          it->second->SetPose(worldPose);
-          // Make a copy of modelPoses s.t. SetModelPoses can take ownership
-          auto modelPoses_ = modelPoses;
-          it->second->SetModelPoses(std::move(modelPoses_));
-        }
-        else
+        if (it == this->entitySensorMap.end())
         {
           ignerr << "Failed to update logicalCamera: " << _entity << ". "
                  << "Entity not found." << std::endl;
+          return true;
+        }
+
+        // Only update sensors which need data and have subscribers.
+        // note: ign-sensors does its own throttling. Here the check is mainly
+        // to avoid querying models for sensors which won't publish.
+        auto &sensor = it->second;
+        if (sensor->NextDataUpdateTime() > _info.simTime ||
+            !sensor->HasConnections())
+        {
+          return true;
+        }
+
+        const math::Pose3d &worldPose = _worldPose->Data();
+        sensor->SetPose(worldPose);
+
+        // Only models whose box overlaps the camera frustum may be detected,
+        // so there's no need to go through all the models in the world
+        math::Frustum frustum(sensor->Near(), sensor->Far(),
+            sensor->HorizontalFOV(), sensor->AspectRatio(), worldPose);
+
+        std::map<std::string, math::Pose3d> modelPoses;
+        for (const auto &model :
+            _ecm.ModelSpatialIndex().QueryFrustum(frustum))
+        {
+          auto name = _ecm.Component<components::Name>(model);
+          auto pose = _ecm.Component<components::Pose>(model);
+          if (nullptr == name || nullptr == pose)
+            continue;
+
+          /// todo(anyone) We currently assume there are only top level
+          /// models. Update to retrieve world pose when nested models are
+          /// supported.
+          modelPoses[name->Data()] = pose->Data();
         }
+        sensor->SetModelPoses(std::move(modelPoses));
+        sensor->sensors::Sensor::Update(_info.simTime, false);
 
         return true;
       });
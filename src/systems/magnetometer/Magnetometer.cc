@@ -83,8 +83,10 @@ class ignition::gazebo::systems::MagnetometerPrivate
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
   /// \brief Update magnetometer sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  public: void Update(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove magnetometer sensors if their entities have been removed
   /// from simulation.
@@ -142,31 +144,8 @@ void Magnetometer::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the MagnetometerPrivate::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      // Update measurement time
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->Update(_info, _ecm);
   }
 
   this->dataPtr->RemoveMagnetometerEntities(_ecm);
@@ -270,7 +249,7 @@ void MagnetometerPrivate::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void MagnetometerPrivate::Update(
+void MagnetometerPrivate::Update(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("MagnetometerPrivate::Update");
@@ -283,9 +262,18 @@ void MagnetometerPrivate::Update(
         auto it = this->entitySensorMap.find(_entity);
         if (it != this->entitySensorMap.end())
         {
+          // Skip sensors which aren't due or have no subscribers
+          if (it->second->NextDataUpdateTime() > _info.simTime ||
+              !it->second->HasConnections())
+          {
+            return true;
+          }
+
           // Get the magnetometer physical position
           const math::Pose3d &magnetometerWorldPose = _worldPose->Data();
           it->second->SetWorldPose(magnetometerWorldPose);
+
+          it->second->sensors::Sensor::Update(_info.simTime, false);
         }
         else
         {
@@ -20,6 +20,7 @@
 #include <ignition/msgs/odometry.pb.h>
 
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -35,10 +36,13 @@
 #include "ignition/gazebo/components/CanonicalLink.hh"
 #include "ignition/gazebo/components/JointPosition.hh"
 #include "ignition/gazebo/components/JointVelocityCmd.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Link.hh"
 #include "ignition/gazebo/Model.hh"
 #include "ignition/gazebo/Util.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
@@ -58,8 +62,26 @@ struct Commands
   Commands() : lin(0.0), lat(0.0), ang(0.0) {}
 };
 
-class ignition::gazebo::systems::MecanumDrivePrivate
+/// \brief State of a single vehicle controlled by the system.
+class MecanumDriveVehicle
 {
+  /// \brief Load the vehicle's parameters and set up its transport.
+  /// \param[in] _model Model entity of the vehicle.
+  /// \param[in] _sdf Parameters of the vehicle.
+  /// \param[in] _ecm The EntityComponentManager.
+  /// \param[in] _node Node used for the vehicle's subscriptions and
+  /// publishers.
+  /// \return True if the vehicle was loaded.
+  public: bool Load(const Entity &_model,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm, transport::Node &_node);
+
+  /// \brief Find the vehicle's joints and set the wheel velocities.
+  /// \param[in] _info System update information.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm);
+
   /// \brief Callback for velocity subscription
   /// \param[in] _msg Velocity message
   public: void OnCmdVel(const ignition::msgs::Twist &_msg);
@@ -71,9 +93,6 @@ class ignition::gazebo::systems::MecanumDrivePrivate
   public: void UpdateVelocity(const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &_ecm);
 
-  /// \brief Ignition communication node.
-  public: transport::Node node;
-
   /// \brief Entity of the front left joint
   public: std::vector<Entity> frontLeftJoints;
 
@@ -165,6 +184,26 @@ class ignition::gazebo::systems::MecanumDrivePrivate
   public: std::string sdfChildFrameId;
 };
 
+class ignition::gazebo::systems::MecanumDrivePrivate
+{
+  /// \brief Load the vehicles whose models have been spawned.
+  /// \param[in] _ecm The EntityComponentManager.
+  public: void LoadPendingVehicles(EntityComponentManager &_ecm);
+
+  /// \brief Ignition communication node.
+  public: transport::Node node;
+
+  /// \brief Vehicles controlled by the system. They're held by pointer
+  /// because transport callbacks are bound to them.
+  public: std::vector<std::unique_ptr<MecanumDriveVehicle>> vehicles;
+
+  /// \brief Vehicles which are waiting for their model to be spawned.
+  public: std::vector<WorldModelElement> pendingVehicles;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity world{kNullEntity};
+};
+
 //////////////////////////////////////////////////
 MecanumDrive::MecanumDrive()
   : dataPtr(std::make_unique<MecanumDrivePrivate>())
@@ -172,24 +211,23 @@ MecanumDrive::MecanumDrive()
 }
 
 //////////////////////////////////////////////////
-void MecanumDrive::Configure(const Entity &_entity,
+bool MecanumDriveVehicle::Load(const Entity &_model,
     const std::shared_ptr<const sdf::Element> &_sdf,
-    EntityComponentManager &_ecm,
-    EventManager &/*_eventMgr*/)
+    EntityComponentManager &_ecm, transport::Node &_node)
 {
-  this->dataPtr->model = Model(_entity);
+  this->model = Model(_model);
 
   // Get the canonical link
   std::vector<Entity> links = _ecm.ChildrenByComponents(
-      this->dataPtr->model.Entity(), components::CanonicalLink());
+      this->model.Entity(), components::CanonicalLink());
   if (!links.empty())
-    this->dataPtr->canonicalLink = Link(links[0]);
+    this->canonicalLink = Link(links[0]);
 
-  if (!this->dataPtr->model.Valid(_ecm))
+  if (!this->model.Valid(_ecm))
   {
     ignerr << "MecanumDrive plugin should be attached to a model entity. "
            << "Failed to initialize." << std::endl;
-    return;
+    return false;
   }
 
   // Ugly, but needed because the sdf::Element::GetElement is not a const
@@ -200,89 +238,89 @@ void MecanumDrive::Configure(const Entity &_entity,
   sdf::ElementPtr sdfElem = ptr->GetElement("front_left_joint");
   while (sdfElem)
   {
-    this->dataPtr->frontLeftJointNames.push_back(sdfElem->Get<std::string>());
+    this->frontLeftJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("front_left_joint");
   }
   sdfElem = ptr->GetElement("front_right_joint");
   while (sdfElem)
   {
-    this->dataPtr->frontRightJointNames.push_back(sdfElem->Get<std::string>());
+    this->frontRightJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("front_right_joint");
   }
 
   sdfElem = ptr->GetElement("back_left_joint");
   while (sdfElem)
   {
-    this->dataPtr->backLeftJointNames.push_back(sdfElem->Get<std::string>());
+    this->backLeftJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("back_left_joint");
   }
   sdfElem = ptr->GetElement("back_right_joint");
   while (sdfElem)
   {
-    this->dataPtr->backRightJointNames.push_back(sdfElem->Get<std::string>());
+    this->backRightJointNames.push_back(sdfElem->Get<std::string>());
     sdfElem = sdfElem->GetNextElement("back_right_joint");
   }
 
-  this->dataPtr->wheelSeparation = _sdf->Get<double>("wheel_separation",
-      this->dataPtr->wheelSeparation).first;
-  this->dataPtr->wheelbase = _sdf->Get<double>("wheelbase",
-      this->dataPtr->wheelbase).first;
-  this->dataPtr->wheelRadius = _sdf->Get<double>("wheel_radius",
-      this->dataPtr->wheelRadius).first;
+  this->wheelSeparation = _sdf->Get<double>("wheel_separation",
+      this->wheelSeparation).first;
+  this->wheelbase = _sdf->Get<double>("wheelbase",
+      this->wheelbase).first;
+  this->wheelRadius = _sdf->Get<double>("wheel_radius",
+      this->wheelRadius).first;
 
   // Instantiate the speed limiters.
-  this->dataPtr->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
-  this->dataPtr->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterLin = std::make_unique<ignition::math::SpeedLimiter>();
+  this->limiterAng = std::make_unique<ignition::math::SpeedLimiter>();
 
   // Parse speed limiter parameters.
   if (_sdf->HasElement("min_velocity"))
   {
     double minVel = _sdf->Get<double>("min_velocity");
-    this->dataPtr->limiterLin->SetMinVelocity(minVel);
-    this->dataPtr->limiterAng->SetMinVelocity(minVel);
+    this->limiterLin->SetMinVelocity(minVel);
+    this->limiterAng->SetMinVelocity(minVel);
   }
   if (_sdf->HasElement("max_velocity"))
   {
     double maxVel = _sdf->Get<double>("max_velocity");
-    this->dataPtr->limiterLin->SetMaxVelocity(maxVel);
-    this->dataPtr->limiterAng->SetMaxVelocity(maxVel);
+    this->limiterLin->SetMaxVelocity(maxVel);
+    this->limiterAng->SetMaxVelocity(maxVel);
   }
   if (_sdf->HasElement("min_acceleration"))
   {
     double minAccel = _sdf->Get<double>("min_acceleration");
-    this->dataPtr->limiterLin->SetMinAcceleration(minAccel);
-    this->dataPtr->limiterAng->SetMinAcceleration(minAccel);
+    this->limiterLin->SetMinAcceleration(minAccel);
+    this->limiterAng->SetMinAcceleration(minAccel);
   }
   if (_sdf->HasElement("max_acceleration"))
   {
     double maxAccel = _sdf->Get<double>("max_acceleration");
-    this->dataPtr->limiterLin->SetMaxAcceleration(maxAccel);
-    this->dataPtr->limiterAng->SetMaxAcceleration(maxAccel);
+    this->limiterLin->SetMaxAcceleration(maxAccel);
+    this->limiterAng->SetMaxAcceleration(maxAccel);
   }
   if (_sdf->HasElement("min_jerk"))
   {
     double minJerk = _sdf->Get<double>("min_jerk");
-    this->dataPtr->limiterLin->SetMinJerk(minJerk);
-    this->dataPtr->limiterAng->SetMinJerk(minJerk);
+    this->limiterLin->SetMinJerk(minJerk);
+    this->limiterAng->SetMinJerk(minJerk);
   }
   if (_sdf->HasElement("max_jerk"))
   {
     double maxJerk = _sdf->Get<double>("max_jerk");
-    this->dataPtr->limiterLin->SetMaxJerk(maxJerk);
-    this->dataPtr->limiterAng->SetMaxJerk(maxJerk);
+    this->limiterLin->SetMaxJerk(maxJerk);
+    this->limiterAng->SetMaxJerk(maxJerk);
   }
 
   double odomFreq = _sdf->Get<double>("odom_publish_frequency", 50).first;
   if (odomFreq > 0)
   {
     std::chrono::duration<double> odomPer{1 / odomFreq};
-    this->dataPtr->odomPubPeriod =
+    this->odomPubPeriod =
       std::chrono::duration_cast<std::chrono::steady_clock::duration>(odomPer);
   }
 
   // Setup odometry.
-  this->dataPtr->odom.SetWheelParams(this->dataPtr->wheelSeparation,
-      this->dataPtr->wheelRadius, this->dataPtr->wheelRadius);
+  this->odom.SetWheelParams(this->wheelSeparation,
+      this->wheelRadius, this->wheelRadius);
 
   // Subscribe to commands
   std::vector<std::string> topics;
@@ -290,69 +328,57 @@ void MecanumDrive::Configure(const Entity &_entity,
   {
     topics.push_back(_sdf->Get<std::string>("topic"));
   }
-  topics.push_back("/model/" + this->dataPtr->model.Name(_ecm) + "/cmd_vel");
+  topics.push_back("/model/" + this->model.Name(_ecm) + "/cmd_vel");
   auto topic = validTopic(topics);
 
-  this->dataPtr->node.Subscribe(topic, &MecanumDrivePrivate::OnCmdVel,
-      this->dataPtr.get());
+  _node.Subscribe(topic, &MecanumDriveVehicle::OnCmdVel, this);
 
   std::vector<std::string> odomTopics;
   if (_sdf->HasElement("odom_topic"))
   {
     odomTopics.push_back(_sdf->Get<std::string>("odom_topic"));
   }
-  odomTopics.push_back("/model/" + this->dataPtr->model.Name(_ecm) +
+  odomTopics.push_back("/model/" + this->model.Name(_ecm) +
       "/odometry");
   auto odomTopic = validTopic(odomTopics);
 
-  this->dataPtr->odomPub = this->dataPtr->node.Advertise<msgs::Odometry>(
-      odomTopic);
+  this->odomPub = _node.Advertise<msgs::Odometry>(odomTopic);
 
-  std::string tfTopic{"/model/" + this->dataPtr->model.Name(_ecm) +
+  std::string tfTopic{"/model/" + this->model.Name(_ecm) +
     "/tf"};
   if (_sdf->HasElement("tf_topic"))
     tfTopic = _sdf->Get<std::string>("tf_topic");
-  this->dataPtr->tfPub = this->dataPtr->node.Advertise<msgs::Pose_V>(
-      tfTopic);
+  this->tfPub = _node.Advertise<msgs::Pose_V>(tfTopic);
 
   if (_sdf->HasElement("frame_id"))
-    this->dataPtr->sdfFrameId = _sdf->Get<std::string>("frame_id");
+    this->sdfFrameId = _sdf->Get<std::string>("frame_id");
 
   if (_sdf->HasElement("child_frame_id"))
-    this->dataPtr->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
+    this->sdfChildFrameId = _sdf->Get<std::string>("child_frame_id");
 
   ignmsg << "MecanumDrive subscribing to twist messages on [" << topic << "]"
          << std::endl;
+  return true;
 }
 
 //////////////////////////////////////////////////
-void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
-    ignition::gazebo::EntityComponentManager &_ecm)
+void MecanumDriveVehicle::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("MecanumDrive::PreUpdate");
-
-  // \TODO(anyone) Support rewind
-  if (_info.dt < std::chrono::steady_clock::duration::zero())
-  {
-    ignwarn << "Detected jump back in time ["
-        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
-        << "s]. System may not work properly." << std::endl;
-  }
-
   // If the joints haven't been identified yet, look for them
   static std::set<std::string> warnedModels;
-  auto modelName = this->dataPtr->model.Name(_ecm);
-  if (this->dataPtr->frontLeftJoints.empty() ||
-      this->dataPtr->frontRightJoints.empty() ||
-      this->dataPtr->backLeftJoints.empty() ||
-      this->dataPtr->backRightJoints.empty())
+  auto modelName = this->model.Name(_ecm);
+  if (this->frontLeftJoints.empty() ||
+      this->frontRightJoints.empty() ||
+      this->backLeftJoints.empty() ||
+      this->backRightJoints.empty())
   {
     bool warned{false};
-    for (const std::string &name : this->dataPtr->frontLeftJointNames)
+    for (const std::string &name : this->frontLeftJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->frontLeftJoints.push_back(joint);
+        this->frontLeftJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find left joint [" << name << "] for model ["
@@ -361,11 +387,11 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->frontRightJointNames)
+    for (const std::string &name : this->frontRightJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->frontRightJoints.push_back(joint);
+        this->frontRightJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find right joint [" << name << "] for model ["
@@ -374,11 +400,11 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->backLeftJointNames)
+    for (const std::string &name : this->backLeftJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->backLeftJoints.push_back(joint);
+        this->backLeftJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find left joint [" << name << "] for model ["
@@ -387,11 +413,11 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
       }
     }
 
-    for (const std::string &name : this->dataPtr->backRightJointNames)
+    for (const std::string &name : this->backRightJointNames)
     {
-      Entity joint = this->dataPtr->model.JointByName(_ecm, name);
+      Entity joint = this->model.JointByName(_ecm, name);
       if (joint != kNullEntity)
-        this->dataPtr->backRightJoints.push_back(joint);
+        this->backRightJoints.push_back(joint);
       else if (warnedModels.find(modelName) == warnedModels.end())
       {
         ignwarn << "Failed to find right joint [" << name << "] for model ["
@@ -406,10 +432,10 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     }
   }
 
-  if (this->dataPtr->frontLeftJoints.empty() ||
-      this->dataPtr->frontRightJoints.empty() ||
-      this->dataPtr->backLeftJoints.empty() ||
-      this->dataPtr->backRightJoints.empty())
+  if (this->frontLeftJoints.empty() ||
+      this->frontRightJoints.empty() ||
+      this->backLeftJoints.empty() ||
+      this->backRightJoints.empty())
   {
     return;
   }
@@ -425,7 +451,7 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  for (Entity joint : this->dataPtr->frontLeftJoints)
+  for (Entity joint : this->frontLeftJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -433,15 +459,15 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->frontLeftJointSpeed}));
+          components::JointVelocityCmd({this->frontLeftJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->frontLeftJointSpeed});
+      *vel = components::JointVelocityCmd({this->frontLeftJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->frontRightJoints)
+  for (Entity joint : this->frontRightJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -449,16 +475,16 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->frontRightJointSpeed}));
+          components::JointVelocityCmd({this->frontRightJointSpeed}));
     }
     else
     {
       *vel =
-          components::JointVelocityCmd({this->dataPtr->frontRightJointSpeed});
+          components::JointVelocityCmd({this->frontRightJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->backLeftJoints)
+  for (Entity joint : this->backLeftJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -466,15 +492,15 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->backLeftJointSpeed}));
+          components::JointVelocityCmd({this->backLeftJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->backLeftJointSpeed});
+      *vel = components::JointVelocityCmd({this->backLeftJointSpeed});
     }
   }
 
-  for (Entity joint : this->dataPtr->backRightJoints)
+  for (Entity joint : this->backRightJoints)
   {
     // Update wheel velocity
     auto vel = _ecm.Component<components::JointVelocityCmd>(joint);
@@ -482,15 +508,71 @@ void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     if (vel == nullptr)
     {
       _ecm.CreateComponent(joint,
-          components::JointVelocityCmd({this->dataPtr->backRightJointSpeed}));
+          components::JointVelocityCmd({this->backRightJointSpeed}));
     }
     else
     {
-      *vel = components::JointVelocityCmd({this->dataPtr->backRightJointSpeed});
+      *vel = components::JointVelocityCmd({this->backRightJointSpeed});
     }
   }
 }
 
+//////////////////////////////////////////////////
+void MecanumDrive::Configure(const Entity &_entity,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &/*_eventMgr*/)
+{
+  // When attached to the world, the system controls every <vehicle>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->world = _entity;
+    this->dataPtr->pendingVehicles = worldModelElements(_sdf, "vehicle",
+        "MecanumDrive");
+    this->dataPtr->LoadPendingVehicles(_ecm);
+    return;
+  }
+
+  auto vehicle = std::make_unique<MecanumDriveVehicle>();
+  if (vehicle->Load(_entity, _sdf, _ecm, this->dataPtr->node))
+    this->dataPtr->vehicles.push_back(std::move(vehicle));
+}
+
+//////////////////////////////////////////////////
+void MecanumDrivePrivate::LoadPendingVehicles(EntityComponentManager &_ecm)
+{
+  loadSpawnedModels(_ecm, this->world, this->pendingVehicles,
+      [&](const Entity &_model, const sdf::ElementPtr &_sdf)
+      {
+        auto vehicle = std::make_unique<MecanumDriveVehicle>();
+        if (vehicle->Load(_model, _sdf, _ecm, this->node))
+          this->vehicles.push_back(std::move(vehicle));
+      });
+}
+
+//////////////////////////////////////////////////
+void MecanumDrive::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
+    ignition::gazebo::EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("MecanumDrive::PreUpdate");
+
+  // \TODO(anyone) Support rewind
+  if (_info.dt < std::chrono::steady_clock::duration::zero())
+  {
+    ignwarn << "Detected jump back in time ["
+        << std::chrono::duration_cast<std::chrono::seconds>(_info.dt).count()
+        << "s]. System may not work properly." << std::endl;
+  }
+
+  // When attached to the world, models may be spawned after the system is
+  // loaded
+  if (!this->dataPtr->pendingVehicles.empty())
+    this->dataPtr->LoadPendingVehicles(_ecm);
+
+  for (auto &vehicle : this->dataPtr->vehicles)
+    vehicle->PreUpdate(_info, _ecm);
+}
+
 //////////////////////////////////////////////////
 void MecanumDrive::PostUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
@@ -500,11 +582,12 @@ void MecanumDrive::PostUpdate(const UpdateInfo &_info,
   if (_info.paused)
     return;
 
-  this->dataPtr->UpdateVelocity(_info, _ecm);
+  for (auto &vehicle : this->dataPtr->vehicles)
+    vehicle->UpdateVelocity(_info, _ecm);
 }
 
 //////////////////////////////////////////////////
-void MecanumDrivePrivate::UpdateVelocity(
+void MecanumDriveVehicle::UpdateVelocity(
     const ignition::gazebo::UpdateInfo &_info,
     const ignition::gazebo::EntityComponentManager &/*_ecm*/)
 {
@@ -553,7 +636,7 @@ void MecanumDrivePrivate::UpdateVelocity(
 }
 
 //////////////////////////////////////////////////
-void MecanumDrivePrivate::OnCmdVel(const msgs::Twist &_msg)
+void MecanumDriveVehicle::OnCmdVel(const msgs::Twist &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
   this->targetVel = _msg;
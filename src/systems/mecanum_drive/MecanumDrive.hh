@@ -87,6 +87,19 @@ namespace systems
   /// `ignition.msgs.Pose_V` message and the `<odom_topic>`
   /// `ignition.msgs.Odometry` message. This element if optional,
   ///  and the default value is `{name_of_model}/{name_of_link}`.
+  ///
+  /// # Fleet mode
+  ///
+  /// When attached to a world instead of a model, a single instance of the
+  /// system controls a whole fleet of vehicles, which are all updated in
+  /// one pass, instead of loading one system per vehicle. Each vehicle is
+  /// described by a `<vehicle>` element, which takes all the parameters
+  /// above plus:
+  ///
+  /// `<model_name>`: Name of the top level model of the vehicle.
+  ///
+  /// Models which don't exist yet when the system is loaded are picked up
+  /// once they're spawned.
   class MecanumDrive
       : public System,
         public ISystemConfigure,
@@ -16,17 +16,27 @@
  */
 #include "ModelPhotoShoot.hh"
 
+#include <fstream>
+#include <future>
+#include <mutex>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <ignition/common/Filesystem.hh>
 #include <ignition/common/Image.hh>
+#include <ignition/common/StringUtils.hh>
+#include <ignition/common/WorkerPool.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/rendering/Camera.hh>
+#include <ignition/rendering/Image.hh>
 #include <ignition/rendering/Scene.hh>
 #include <ignition/rendering/RenderingIface.hh>
 #include <ignition/rendering/Visual.hh>
 
+#include <sdf/Root.hh>
+
 #include "ignition/gazebo/components/Joint.hh"
 #include "ignition/gazebo/components/JointAxis.hh"
 #include "ignition/gazebo/components/JointType.hh"
@@ -34,8 +44,10 @@
 #include "ignition/gazebo/components/JointPositionReset.hh"
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Model.hh"
 #include "ignition/gazebo/rendering/Events.hh"
+#include "ignition/gazebo/SdfEntityCreator.hh"
 #include "ignition/gazebo/Util.hh"
 
 using namespace ignition;
@@ -45,13 +57,33 @@ using namespace systems;
 /// \brief Private ModelPhotoShoot data class.
 class ignition::gazebo::systems::ModelPhotoShootPrivate
 {
+  /// \brief Destructor. Waits for the pictures which are still being
+  /// written.
+  public: ~ModelPhotoShootPrivate();
+
   /// \brief Callback for pos rendering operations.
   public: void PerformPostRenderingOperations();
 
-  /// \brief Save a pitcture with the camera from the given pose.
+  /// \brief Save a pitcture with the camera from the given pose. The
+  /// picture is encoded and written by the writer pool.
   public: void SavePicture (const ignition::rendering::CameraPtr _camera,
                     const ignition::math::Pose3d &_pose,
-                    const std::string &_fileName) const;
+                    const std::string &_fileName);
+
+  /// \brief Set random poses to the joints of the model.
+  /// \param[in] _ecm Entity component manager.
+  public: void RandomizeJoints(EntityComponentManager &_ecm);
+
+  /// \brief Start loading the SDF of a model in the batch in the
+  /// background, so that it's ready by the time the previous model has
+  /// been photographed.
+  /// \param[in] _index Index of the model in the batch.
+  public: void LoadModel(const std::size_t _index);
+
+  /// \brief Remove the photographed model and spawn the next one in the
+  /// batch.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateBatch(EntityComponentManager &_ecm);
 
   /// \brief Name of the loaded model.
   public: std::string modelName;
@@ -73,6 +105,57 @@ class ignition::gazebo::systems::ModelPhotoShootPrivate
 
   /// \brief File to save translation and scaling info.
   public: std::ofstream savingFile;
+
+  /// \brief Protects the model being photographed, which is set by the
+  /// simulation thread and used by the rendering thread.
+  public: std::mutex mutex;
+
+  /// \brief Directory where the pictures of the model being photographed
+  /// are saved. Empty to save them in the current directory.
+  public: std::string picturesDir;
+
+  /// \brief Camera used to take the pictures, kept from one model to the
+  /// next.
+  public: ignition::rendering::CameraPtr camera;
+
+  /// \brief Image the camera captures into, reused for all pictures.
+  public: ignition::rendering::Image cameraImage;
+
+  /// \brief Whether the lights have been added to the scene.
+  public: bool lightsCreated{false};
+
+  /// \brief Encodes and writes pictures in the background.
+  public: common::WorkerPool writerPool{2};
+
+  /// \brief Whether the plugin is photographing a batch of models.
+  public: bool batch{false};
+
+  /// \brief URIs of the models in the batch.
+  public: std::vector<std::string> modelUris;
+
+  /// \brief Index of the model being photographed in the batch.
+  public: std::size_t modelIndex{0u};
+
+  /// \brief Whether the joints of each model in the batch adopt random
+  /// poses.
+  public: bool randomJointsPose{false};
+
+  /// \brief Directory where the pictures of each model in the batch are
+  /// saved.
+  public: std::string outputDir;
+
+  /// \brief SDF of the next model in the batch, loaded in the background.
+  public: std::future<std::shared_ptr<sdf::Root>> nextRoot;
+
+  /// \brief Name of the translation data file within each model's
+  /// directory, in batch mode.
+  public: std::string dataFileName;
+
+  /// \brief World entity, which spawned models are attached to.
+  public: Entity worldEntity{kNullEntity};
+
+  /// \brief Creates the models of the batch.
+  public: std::unique_ptr<SdfEntityCreator> creator;
 };
 
 //////////////////////////////////////////////////
@@ -81,12 +164,21 @@ ModelPhotoShoot::ModelPhotoShoot()
 {
 }
 
+//////////////////////////////////////////////////
+ModelPhotoShootPrivate::~ModelPhotoShootPrivate()
+{
+  this->writerPool.WaitForResults();
+}
+
 //////////////////////////////////////////////////
 void ModelPhotoShoot::Configure(const ignition::gazebo::Entity &_entity,
                                 const std::shared_ptr<const sdf::Element> &_sdf,
                                 ignition::gazebo::EntityComponentManager &_ecm,
                                 ignition::gazebo::EventManager &_eventMgr)
 {
+  // Attached to a world, the plugin photographs a batch of models
+  this->dataPtr->batch = nullptr != _ecm.Component<components::World>(_entity);
+
   std::string saveDataLocation =
       _sdf->Get<std::string>("translation_data_file");
   if (saveDataLocation.empty())
@@ -94,6 +186,12 @@ void ModelPhotoShoot::Configure(const ignition::gazebo::Entity &_entity,
     igndbg << "No data location specified, skipping translaiton data"
               "saving.\n";
   }
+  else if (this->dataPtr->batch)
+  {
+    igndbg << "Saving translation data of each model to: "
+        << saveDataLocation << std::endl;
+    this->dataPtr->dataFileName = saveDataLocation;
+  }
   else
   {
     igndbg << "Saving translation data to: "
@@ -104,6 +202,7 @@ void ModelPhotoShoot::Configure(const ignition::gazebo::Entity &_entity,
   if (_sdf->HasElement("random_joints_pose"))
   {
     this->dataPtr->randomPoses = _sdf->Get<bool>("random_joints_pose");
+    this->dataPtr->randomJointsPose = this->dataPtr->randomPoses;
   }
 
   this->dataPtr->connection =
@@ -111,11 +210,55 @@ void ModelPhotoShoot::Configure(const ignition::gazebo::Entity &_entity,
           &ModelPhotoShootPrivate::PerformPostRenderingOperations,
           this->dataPtr.get()));
 
-  this->dataPtr->model = std::make_shared<ignition::gazebo::Model>(_entity);
-  this->dataPtr->modelName = this->dataPtr->model->Name(_ecm);
-  // Get the pose of the model
-  this->dataPtr->modelPose3D =
-      ignition::gazebo::worldPose(this->dataPtr->model->Entity(), _ecm);
+  if (!this->dataPtr->batch)
+  {
+    this->dataPtr->model =
+        std::make_shared<ignition::gazebo::Model>(_entity);
+    this->dataPtr->modelName = this->dataPtr->model->Name(_ecm);
+    // Get the pose of the model
+    this->dataPtr->modelPose3D =
+        ignition::gazebo::worldPose(this->dataPtr->model->Entity(), _ecm);
+    return;
+  }
+
+  auto sdfClone = _sdf->Clone();
+  for (auto uriElem = sdfClone->GetElement("model_uri"); uriElem;
+       uriElem = uriElem->GetNextElement("model_uri"))
+  {
+    auto uri = uriElem->Get<std::string>();
+    if (!uri.empty())
+      this->dataPtr->modelUris.push_back(uri);
+  }
+
+  if (_sdf->HasElement("model_list_file"))
+  {
+    auto listFile = _sdf->Get<std::string>("model_list_file");
+    std::ifstream list(listFile);
+    if (!list.is_open())
+    {
+      ignerr << "Failed to open model list file [" << listFile << "]"
+             << std::endl;
+    }
+    std::string line;
+    while (std::getline(list, line))
+    {
+      line = common::trimmed(line);
+      if (!line.empty() && line[0] != '#')
+        this->dataPtr->modelUris.push_back(line);
+    }
+  }
+
+  if (_sdf->HasElement("output_dir"))
+    this->dataPtr->outputDir = _sdf->Get<std::string>("output_dir");
+
+  ignmsg << "Taking pictures of a batch of ["
+         << this->dataPtr->modelUris.size() << "] models." << std::endl;
+
+  this->dataPtr->worldEntity = _entity;
+  this->dataPtr->creator = std::make_unique<SdfEntityCreator>(_ecm, _eventMgr);
+  this->dataPtr->takePicture = false;
+  this->dataPtr->randomPoses = false;
+  this->dataPtr->LoadModel(0u);
 }
 
 //////////////////////////////////////////////////
@@ -123,81 +266,181 @@ void ModelPhotoShoot::PreUpdate(
     const ignition::gazebo::UpdateInfo &,
     ignition::gazebo::EntityComponentManager &_ecm)
 {
-  if (this->dataPtr->randomPoses)
+  if (this->dataPtr->batch)
+    this->dataPtr->UpdateBatch(_ecm);
+
+  if (this->dataPtr->randomPoses && this->dataPtr->model)
+  {
+    this->dataPtr->RandomizeJoints(_ecm);
+    // Only set random joint poses once per model
+    this->dataPtr->randomPoses = false;
+  }
+}
+
+//////////////////////////////////////////////////
+void ModelPhotoShootPrivate::LoadModel(const std::size_t _index)
+{
+  if (_index >= this->modelUris.size())
+    return;
+
+  const std::string uri = this->modelUris[_index];
+  this->nextRoot = std::async(std::launch::async, [uri]()
+  {
+    auto root = std::make_shared<sdf::Root>();
+    auto errors = root->LoadSdfString(
+        "<?xml version='1.0'?><sdf version='1.6'><include><uri>" + uri +
+        "</uri></include></sdf>");
+    if (!errors.empty() || nullptr == root->Model())
+    {
+      ignerr << "Failed to load model [" << uri << "]" << std::endl;
+      for (const auto &error : errors)
+        ignerr << error << std::endl;
+      return std::shared_ptr<sdf::Root>();
+    }
+    return root;
+  });
+}
+
+//////////////////////////////////////////////////
+void ModelPhotoShootPrivate::UpdateBatch(EntityComponentManager &_ecm)
+{
+  if (this->model)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->takePicture)
+        return;
+      this->modelName.clear();
+    }
+
+    // The next model is spawned on the following iteration, once this one
+    // is gone
+    this->creator->RequestRemoveEntity(this->model->Entity());
+    this->model.reset();
+    if (++this->modelIndex == this->modelUris.size())
+    {
+      ignmsg << "Finished taking pictures of [" << this->modelUris.size()
+             << "] models." << std::endl;
+    }
+    return;
+  }
+
+  if (!this->nextRoot.valid())
+    return;
+
+  // Load the following model while this one is photographed
+  auto root = this->nextRoot.get();
+  this->LoadModel(this->modelIndex + 1);
+  if (!root)
+  {
+    ++this->modelIndex;
+    return;
+  }
+
+  sdf::Model sdfModel = *root->Model();
+  const std::string dir = common::joinPaths(this->outputDir,
+      std::to_string(this->modelIndex) + "_" + sdfModel.Name());
+  sdfModel.SetName("photo_shoot_subject_" + std::to_string(this->modelIndex));
+  sdfModel.SetRawPose(math::Pose3d::Zero);
+
+  Entity entity = this->creator->CreateEntities(&sdfModel);
+  this->creator->SetParent(entity, this->worldEntity);
+  this->model = std::make_shared<ignition::gazebo::Model>(entity);
+  this->randomPoses = this->randomJointsPose;
+
+  if (!common::createDirectories(dir))
+    ignerr << "Failed to create directory [" << dir << "]" << std::endl;
+
+  if (!this->dataFileName.empty())
+  {
+    this->savingFile.close();
+    this->savingFile.open(common::joinPaths(dir, this->dataFileName));
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->modelName = sdfModel.Name();
+  this->modelPose3D = worldPose(entity, _ecm);
+  this->picturesDir = dir;
+  this->takePicture = true;
+}
+
+//////////////////////////////////////////////////
+void ModelPhotoShootPrivate::RandomizeJoints(EntityComponentManager &_ecm)
+{
+  std::vector<gazebo::Entity> joints = this->model->Joints(_ecm);
+  unsigned seed =
+      std::chrono::system_clock::now().time_since_epoch().count();
+  std::default_random_engine generator(seed);
+  for (const auto &joint : joints)
   {
-    std::vector<gazebo::Entity> joints = this->dataPtr->model->Joints(_ecm);
-    unsigned seed =
-        std::chrono::system_clock::now().time_since_epoch().count();
-    std::default_random_engine generator(seed);
-    for (const auto &joint : joints)
+    auto jointNameComp = _ecm.Component<components::Name>(joint);
+    if (jointNameComp)
     {
-      auto jointNameComp = _ecm.Component<components::Name>(joint);
-      if (jointNameComp)
+      auto jointType = _ecm.Component<components::JointType>(joint)->Data();
+      if (jointType != sdf::JointType::FIXED)
       {
-        auto jointType = _ecm.Component<components::JointType>(joint)->Data();
-        if (jointType != sdf::JointType::FIXED)
+        if (jointType == sdf::JointType::REVOLUTE  ||
+            jointType == sdf::JointType::PRISMATIC)
         {
-          if (jointType == sdf::JointType::REVOLUTE  ||
-              jointType == sdf::JointType::PRISMATIC)
+          // Using the JointAxis component to extract the joint pose limits
+          auto jointAxisComp = _ecm.Component<components::JointAxis>(joint);
+          if (jointAxisComp)
           {
-            // Using the JointAxis component to extract the joint pose limits
-            auto jointAxisComp = _ecm.Component<components::JointAxis>(joint);
-            if (jointAxisComp)
+            std::uniform_real_distribution<double> distribution(
+                jointAxisComp->Data().Lower(),
+                jointAxisComp->Data().Upper());
+            double jointPose = distribution(generator);
+            _ecm.SetComponentData<components::JointPositionReset>(
+                joint, {jointPose});
+
+            // Create a JointPosition component if it doesn't exist.
+            if (nullptr == _ecm.Component<components::JointPosition>(joint))
             {
-              std::uniform_real_distribution<double> distribution(
-                  jointAxisComp->Data().Lower(),
-                  jointAxisComp->Data().Upper());
-              double jointPose = distribution(generator);
-              _ecm.SetComponentData<components::JointPositionReset>(
+              _ecm.CreateComponent(joint, components::JointPosition());
+              _ecm.SetComponentData<components::JointPosition>(
                   joint, {jointPose});
-
-              // Create a JointPosition component if it doesn't exist.
-              if (nullptr == _ecm.Component<components::JointPosition>(joint))
-              {
-                _ecm.CreateComponent(joint, components::JointPosition());
-                _ecm.SetComponentData<components::JointPosition>(
-                    joint, {jointPose});
-              }
-
-              if (this->dataPtr->savingFile.is_open())
-              {
-                this->dataPtr->savingFile << jointNameComp->Data() << ": "
-                                          << std::setprecision(17)
-                                          << jointPose << std::endl;
-              }
             }
-            else
+
+            if (this->savingFile.is_open())
             {
-              ignerr << "No jointAxisComp found, ignoring joint: " <<
-                  jointNameComp->Data() << std::endl;
+              this->savingFile << jointNameComp->Data() << ": "
+                                        << std::setprecision(17)
+                                        << jointPose << std::endl;
             }
           }
           else
           {
-            ignerr << "Model Photo Shoot only supports single axis joints. "
-                "Skipping joint: "<< jointNameComp->Data() << std::endl;
+            ignerr << "No jointAxisComp found, ignoring joint: " <<
+                jointNameComp->Data() << std::endl;
           }
         }
         else
         {
-          igndbg << "Ignoring fixed joint: " << jointNameComp->Data() <<
-              std::endl;
+          ignerr << "Model Photo Shoot only supports single axis joints. "
+              "Skipping joint: "<< jointNameComp->Data() << std::endl;
         }
       }
       else
       {
-          ignerr << "No jointNameComp found on entity: " << joint <<
-              std:: endl;
+        igndbg << "Ignoring fixed joint: " << jointNameComp->Data() <<
+            std::endl;
       }
     }
-    // Only set random joint poses once
-    this->dataPtr->randomPoses = false;
+    else
+    {
+        ignerr << "No jointNameComp found on entity: " << joint <<
+            std:: endl;
+    }
   }
 }
 
 //////////////////////////////////////////////////
 void ModelPhotoShootPrivate::PerformPostRenderingOperations()
 {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->takePicture || this->modelName.empty())
+    return;
+
   ignition::rendering::ScenePtr scene =
       ignition::rendering::sceneFromFirstRenderEngine();
   ignition::rendering::VisualPtr modelVisual =
@@ -205,81 +448,102 @@ void ModelPhotoShootPrivate::PerformPostRenderingOperations()
 
   ignition::rendering::VisualPtr root = scene->RootVisual();
 
-  if (modelVisual && this->takePicture)
+  if (modelVisual)
   {
-    scene->SetAmbientLight(0.3, 0.3, 0.3);
-
-    // create directional light
-    ignition::rendering::DirectionalLightPtr light0 =
-        scene->CreateDirectionalLight();
-    light0->SetDirection(-0.5, 0.5, -1);
-    light0->SetDiffuseColor(0.8, 0.8, 0.8);
-    light0->SetSpecularColor(0.5, 0.5, 0.5);
-    root->AddChild(light0);
-
-    // create point light
-    ignition::rendering::PointLightPtr light2 = scene->CreatePointLight();
-    light2->SetDiffuseColor(0.5, 0.5, 0.5);
-    light2->SetSpecularColor(0.5, 0.5, 0.5);
-    light2->SetLocalPosition(3, 5, 5);
-    root->AddChild(light2);
-
-    for (unsigned int i = 0; i < scene->NodeCount(); ++i)
+    // The lights and camera are kept for all the models of a batch
+    if (!this->lightsCreated)
+    {
+      scene->SetAmbientLight(0.3, 0.3, 0.3);
+
+      // create directional light
+      ignition::rendering::DirectionalLightPtr light0 =
+          scene->CreateDirectionalLight();
+      light0->SetDirection(-0.5, 0.5, -1);
+      light0->SetDiffuseColor(0.8, 0.8, 0.8);
+      light0->SetSpecularColor(0.5, 0.5, 0.5);
+      root->AddChild(light0);
+
+      // create point light
+      ignition::rendering::PointLightPtr light2 = scene->CreatePointLight();
+      light2->SetDiffuseColor(0.5, 0.5, 0.5);
+      light2->SetSpecularColor(0.5, 0.5, 0.5);
+      light2->SetLocalPosition(3, 5, 5);
+      root->AddChild(light2);
+      this->lightsCreated = true;
+    }
+
+    for (unsigned int i = 0; nullptr == this->camera &&
+         i < scene->NodeCount(); ++i)
     {
       auto camera = std::dynamic_pointer_cast<ignition::rendering::Camera>(
           scene->NodeByIndex(i));
       if (nullptr != camera && camera->Name() == "photo_shoot::link::camera")
       {
-        // Compute the translation we have to apply to the cameras to
-        // center the model in the image.
-        ignition::math::AxisAlignedBox bbox = modelVisual->LocalBoundingBox();
-        double scaling = 1.0 / bbox.Size().Max();
-        ignition::math::Vector3d bboxCenter = bbox.Center();
-        ignition::math::Vector3d translation =
-            bboxCenter + this->modelPose3D.Pos();
-        if (this->savingFile.is_open()) {
-          this->savingFile << "Translation: " << translation << std::endl;
-          this->savingFile << "Scaling: " << scaling << std::endl;
-        }
+        this->camera = camera;
+        this->cameraImage = camera->CreateImage();
+      }
+    }
 
-        ignition::math::Pose3d pose;
-        // Perspective view
-        pose.Pos().Set(1.6 / scaling + translation.X(),
-                       -1.6 / scaling + translation.Y(),
-                       1.2 / scaling + translation.Z());
-        pose.Rot().Euler(0, IGN_DTOR(30), IGN_DTOR(-225));
-        SavePicture(camera, pose, "1.png");
-
-        // Top view
-        pose.Pos().Set(0 + translation.X(),
-                       0 + translation.Y(),
-                       2.2 / scaling + translation.Z());
-        pose.Rot().Euler(0, IGN_DTOR(90), 0);
-        SavePicture(camera, pose, "2.png");
-
-        // Front view
-        pose.Pos().Set(2.2 / scaling + translation.X(),
-                       0 + translation.Y(),
-                       0 + translation.Z());
-        pose.Rot().Euler(0, 0, IGN_DTOR(-180));
-        SavePicture(camera, pose, "3.png");
-
-        // Side view
-        pose.Pos().Set(0 + translation.X(),
-                       2.2 / scaling + translation.Y(),
-                       0 + translation.Z());
-        pose.Rot().Euler(0, 0, IGN_DTOR(-90));
-        SavePicture(camera, pose, "4.png");
-
-        // Back view
-        pose.Pos().Set(-2.2 / scaling + translation.X(),
-                       0 + translation.Y(),
-                       0 + translation.Z());
-        pose.Rot().Euler(0, 0, 0);
-        SavePicture(camera, pose, "5.png");
-
-        this->takePicture = false;
+    if (nullptr != this->camera)
+    {
+      // Pictures of the previous model may still be being written. Waiting
+      // for them bounds the number of images held in memory.
+      this->writerPool.WaitForResults();
+
+      auto camera = this->camera;
+      // Compute the translation we have to apply to the cameras to
+      // center the model in the image.
+      ignition::math::AxisAlignedBox bbox = modelVisual->LocalBoundingBox();
+      double scaling = 1.0 / bbox.Size().Max();
+      ignition::math::Vector3d bboxCenter = bbox.Center();
+      ignition::math::Vector3d translation =
+          bboxCenter + this->modelPose3D.Pos();
+      if (this->savingFile.is_open()) {
+        this->savingFile << "Translation: " << translation << std::endl;
+        this->savingFile << "Scaling: " << scaling << std::endl;
       }
+
+      ignition::math::Pose3d pose;
+      // Perspective view
+      pose.Pos().Set(1.6 / scaling + translation.X(),
+                     -1.6 / scaling + translation.Y(),
+                     1.2 / scaling + translation.Z());
+      pose.Rot().Euler(0, IGN_DTOR(30), IGN_DTOR(-225));
+      SavePicture(camera, pose, "1.png");
+
+      // Top view
+      pose.Pos().Set(0 + translation.X(),
+                     0 + translation.Y(),
+                     2.2 / scaling + translation.Z());
+      pose.Rot().Euler(0, IGN_DTOR(90), 0);
+      SavePicture(camera, pose, "2.png");
+
+      // Front view
+      pose.Pos().Set(2.2 / scaling + translation.X(),
+                     0 + translation.Y(),
+                     0 + translation.Z());
+      pose.Rot().Euler(0, 0, IGN_DTOR(-180));
+      SavePicture(camera, pose, "3.png");
+
+      // Side view
+      pose.Pos().Set(0 + translation.X(),
+                     2.2 / scaling + translation.Y(),
+                     0 + translation.Z());
+      pose.Rot().Euler(0, 0, IGN_DTOR(-90));
+      SavePicture(camera, pose, "4.png");
+
+      // Back view
+      pose.Pos().Set(-2.2 / scaling + translation.X(),
+                     0 + translation.Y(),
+                     0 + translation.Z());
+      pose.Rot().Euler(0, 0, 0);
+      SavePicture(camera, pose, "5.png");
+
+      this->takePicture = false;
+
+      // A single model's pictures are available as soon as they're taken
+      if (!this->batch)
+        this->writerPool.WaitForResults();
     }
   }
 }
@@ -288,22 +552,30 @@ void ModelPhotoShootPrivate::PerformPostRenderingOperations()
 void ModelPhotoShootPrivate::SavePicture(
                                   const ignition::rendering::CameraPtr _camera,
                                   const ignition::math::Pose3d &_pose,
-                                  const std::string &_fileName) const
+                                  const std::string &_fileName)
 {
   unsigned int width = _camera->ImageWidth();
   unsigned int height = _camera->ImageHeight();
-  ignition::common::Image image;
 
   _camera->SetWorldPose(_pose);
-  auto cameraImage = _camera->CreateImage();
-  _camera->Capture(cameraImage);
+  _camera->Capture(this->cameraImage);
   auto formatStr =
       ignition::rendering::PixelUtil::Name(_camera->ImageFormat());
   auto format = ignition::common::Image::ConvertPixelFormat(formatStr);
-  image.SetFromData(cameraImage.Data<unsigned char>(), width, height, format);
-  image.SavePNG(_fileName);
 
-  igndbg << "Saved image to [" << _fileName << "]" << std::endl;
+  // Encoding and writing the picture is left to the writer pool, so that
+  // the rendering thread can move on to the next view
+  auto data = this->cameraImage.Data<unsigned char>();
+  auto pixels = std::make_shared<std::vector<unsigned char>>(
+      data, data + this->cameraImage.MemorySize());
+  const std::string fileName = common::joinPaths(this->picturesDir, _fileName);
+  this->writerPool.AddWork([pixels, width, height, format, fileName]()
+  {
+    ignition::common::Image image;
+    image.SetFromData(pixels->data(), width, height, format);
+    image.SavePNG(fileName);
+    igndbg << "Saved image to [" << fileName << "]" << std::endl;
+  });
 }
 
 IGNITION_ADD_PLUGIN(ModelPhotoShoot, ignition::gazebo::System,
@@ -50,6 +50,23 @@ namespace systems
   ///   plugin to take the pictures. This allows the plugin user to set the
   ///   camera parameters as needed. [Required]
   ///
+  /// ## Batch mode
+  /// When the plugin is attached to a world instead of a model, it takes
+  /// pictures of a batch of models in a single server. Each model is
+  /// spawned at the origin, photographed and removed before the next one is
+  /// spawned, while the lights, camera and render scene are kept. The SDF
+  /// of the next model is loaded in the background while the current one is
+  /// photographed, and pictures are encoded and written on background
+  /// threads. The pictures of each model, along with its translation data
+  /// file, are saved in a directory named `<index>_<model name>`, where the
+  /// index is the model's position in the batch.
+  /// - <model_uri> - URI of a model to photograph. May be repeated.
+  /// - <model_list_file> - File with the URIs of the models to photograph,
+  ///   one per line. Empty lines and lines starting with `#` are ignored.
+  ///   [Optional]
+  /// - <output_dir> - Directory where the models' directories are created.
+  ///   Defaults to the current directory. [Optional]
+  ///
   /// ## Example
   /// An example configuration is installed with Gazebo. The example uses
   /// the Ogre2 rendering plugin to set the background color of the pictures.
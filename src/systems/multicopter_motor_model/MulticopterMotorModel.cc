@@ -25,6 +25,8 @@
 
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 
@@ -115,44 +117,46 @@ enum class MotorType {
   kForce
 };
 
-class ignition::gazebo::systems::MulticopterMotorModelPrivate
+/// \brief State and parameters of a single rotor.
+class MulticopterRotor
 {
-  /// \brief Callback for actuator commands.
-  public: void OnActuatorMsg(const ignition::msgs::Actuators &_msg);
+  /// \brief Look up the entities of the rotor and create the components it
+  /// needs, and update `ready`.
+  /// \param[in] _model Model of the rotor.
+  /// \param[in] _ecm Entity component manager.
+  public: void Prepare(Model &_model, EntityComponentManager &_ecm);
 
   /// \brief Apply link forces and moments based on propeller state.
-  public: void UpdateForcesAndMoments(EntityComponentManager &_ecm);
+  /// \param[in] _msg Latest actuator command, or nullptr if there's no new
+  /// command.
+  /// \param[in] _windSpeedWorld Wind velocity in the world frame.
+  /// \param[in] _samplingTime Time step in seconds.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateForcesAndMoments(const msgs::Actuators *_msg,
+              const math::Vector3d &_windSpeedWorld, double _samplingTime,
+              EntityComponentManager &_ecm);
+
+  /// \brief True if forces and moments can be computed on this iteration.
+  public: bool ready{false};
 
   /// \brief Joint Entity
-  public: Entity jointEntity;
+  public: Entity jointEntity{kNullEntity};
 
   /// \brief Joint name
   public: std::string jointName;
 
   /// \brief Link Entity
-  public: Entity linkEntity;
+  public: Entity linkEntity{kNullEntity};
 
   /// \brief Link name
   public: std::string linkName;
 
   /// \brief Parent link Entity
-  public: Entity parentLinkEntity;
+  public: Entity parentLinkEntity{kNullEntity};
 
   /// \brief Parent link name
   public: std::string parentLinkName;
 
-  /// \brief Model interface
-  public: Model model{kNullEntity};
-
-  /// \brief Topic for actuator commands.
-  public: std::string commandSubTopic;
-
-  /// \brief Topic namespace.
-  public: std::string robotNamespace;
-
-  /// \brief Sampling time (from motor_model.hpp).
-  public: double samplingTime = 0.01;
-
   /// \brief Index of motor on multirotor_base.
   public: int motorNumber = 0;
 
@@ -206,11 +210,50 @@ class ignition::gazebo::systems::MulticopterMotorModelPrivate
   /// \brief Filter on rotor velocity that has different time constants
   /// for increasing and decreasing values.
   public: std::unique_ptr<FirstOrderFilter<double>> rotorVelocityFilter;
+};
+
+class ignition::gazebo::systems::MulticopterMotorModelPrivate
+{
+  /// \brief Callback for actuator commands.
+  public: void OnActuatorMsg(const ignition::msgs::Actuators &_msg);
+
+  /// \brief Load the parameters of a rotor.
+  /// \param[in] _sdf Element holding the rotor parameters.
+  /// \param[in] _defaults Element holding the parameters which aren't set
+  /// in _sdf, or nullptr to use the default values.
+  /// \param[out] _rotor Rotor to load.
+  /// \return True if the rotor could be loaded.
+  public: bool LoadRotor(const sdf::ElementPtr &_sdf,
+              const sdf::ElementPtr &_defaults, MulticopterRotor &_rotor);
+
+  /// \brief Apply link forces and moments of all rotors.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateForcesAndMoments(EntityComponentManager &_ecm);
+
+  /// \brief Rotors of the model. All of them are evaluated in one pass per
+  /// iteration, sharing the actuator command and the wind velocity.
+  public: std::vector<MulticopterRotor> rotors;
+
+  /// \brief Model interface
+  public: Model model{kNullEntity};
+
+  /// \brief Topic for actuator commands.
+  public: std::string commandSubTopic;
+
+  /// \brief Topic namespace.
+  public: std::string robotNamespace;
+
+  /// \brief Sampling time (from motor_model.hpp).
+  public: double samplingTime = 0.01;
 
   /// \brief Received Actuators message. This is nullopt if no message has been
   /// received.
   public: std::optional<msgs::Actuators> recvdActuatorsMsg;
 
+  /// \brief Latest message taken from recvdActuatorsMsg. Kept across
+  /// iterations so that its memory is reused.
+  public: msgs::Actuators actuatorsMsg;
+
   /// \brief Mutex to protect recvdActuatorsMsg.
   public: std::mutex recvdActuatorsMsgMutex;
 
@@ -253,45 +296,98 @@ void MulticopterMotorModel::Configure(const Entity &_entity,
     ignerr << "Please specify a robotNamespace.\n";
   }
 
+  // Each <rotor> is a rotor of the model, with parameters which default to
+  // the ones set directly in the plugin. Without <rotor>, the plugin is a
+  // single rotor.
+  if (sdfClone->HasElement("rotor"))
+  {
+    for (auto rotorElem = sdfClone->GetElement("rotor"); rotorElem;
+         rotorElem = rotorElem->GetNextElement("rotor"))
+    {
+      MulticopterRotor rotor;
+      if (!this->dataPtr->LoadRotor(rotorElem, sdfClone, rotor))
+        return;
+      this->dataPtr->rotors.push_back(std::move(rotor));
+    }
+  }
+  else
+  {
+    MulticopterRotor rotor;
+    if (!this->dataPtr->LoadRotor(sdfClone, nullptr, rotor))
+      return;
+    this->dataPtr->rotors.push_back(std::move(rotor));
+  }
+
+  sdfClone->Get<std::string>("commandSubTopic",
+      this->dataPtr->commandSubTopic, this->dataPtr->commandSubTopic);
+
+  // Subscribe to actuator command messages
+  std::string topic = transport::TopicUtils::AsValidTopic(
+      this->dataPtr->robotNamespace + "/" + this->dataPtr->commandSubTopic);
+  if (topic.empty())
+  {
+    ignerr << "Failed to create topic for [" << this->dataPtr->robotNamespace
+           << "]" << std::endl;
+    return;
+  }
+  this->dataPtr->node.Subscribe(topic,
+      &MulticopterMotorModelPrivate::OnActuatorMsg, this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+bool MulticopterMotorModelPrivate::LoadRotor(const sdf::ElementPtr &_sdf,
+    const sdf::ElementPtr &_defaults, MulticopterRotor &_rotor)
+{
+  // Element holding a parameter, falling back to the defaults
+  auto elem = [&](const std::string &_name) -> sdf::ElementPtr
+  {
+    if (nullptr != _defaults && !_sdf->HasElement(_name) &&
+        _defaults->HasElement(_name))
+    {
+      return _defaults;
+    }
+    return _sdf;
+  };
+
   // Get params from SDF
-  if (sdfClone->HasElement("jointName"))
+  if (elem("jointName")->HasElement("jointName"))
   {
-    this->dataPtr->jointName = sdfClone->Get<std::string>("jointName");
+    _rotor.jointName = elem("jointName")->Get<std::string>("jointName");
   }
 
-  if (this->dataPtr->jointName.empty())
+  if (_rotor.jointName.empty())
   {
     ignerr << "MulticopterMotorModel found an empty jointName parameter. "
            << "Failed to initialize.";
-    return;
+    return false;
   }
 
-  if (sdfClone->HasElement("linkName"))
+  if (elem("linkName")->HasElement("linkName"))
   {
-    this->dataPtr->linkName = sdfClone->Get<std::string>("linkName");
+    _rotor.linkName = elem("linkName")->Get<std::string>("linkName");
   }
 
-  if (this->dataPtr->linkName.empty())
+  if (_rotor.linkName.empty())
   {
     ignerr << "MulticopterMotorModel found an empty linkName parameter. "
            << "Failed to initialize.";
-    return;
+    return false;
   }
 
-  if (sdfClone->HasElement("motorNumber"))
-    this->dataPtr->motorNumber =
-      sdfClone->GetElement("motorNumber")->Get<int>();
+  if (elem("motorNumber")->HasElement("motorNumber"))
+    _rotor.motorNumber =
+      elem("motorNumber")->GetElement("motorNumber")->Get<int>();
   else
     ignerr << "Please specify a motorNumber.\n";
 
-  if (sdfClone->HasElement("turningDirection"))
+  if (elem("turningDirection")->HasElement("turningDirection"))
   {
-    auto turningDirection =
-        sdfClone->GetElement("turningDirection")->Get<std::string>();
+    auto turningDirection = elem("turningDirection")->GetElement(
+        "turningDirection")->Get<std::string>();
     if (turningDirection == "cw")
-      this->dataPtr->turningDirection = turning_direction::kCw;
+      _rotor.turningDirection = turning_direction::kCw;
     else if (turningDirection == "ccw")
-      this->dataPtr->turningDirection = turning_direction::kCcw;
+      _rotor.turningDirection = turning_direction::kCcw;
     else
       ignerr << "Please only use 'cw' or 'ccw' as turningDirection.\n";
   }
@@ -300,19 +396,20 @@ void MulticopterMotorModel::Configure(const Entity &_entity,
     ignerr << "Please specify a turning direction ('cw' or 'ccw').\n";
   }
 
-  if (sdfClone->HasElement("motorType"))
+  if (elem("motorType")->HasElement("motorType"))
   {
-    auto motorType = sdfClone->GetElement("motorType")->Get<std::string>();
+    auto motorType =
+        elem("motorType")->GetElement("motorType")->Get<std::string>();
     if (motorType == "velocity")
-      this->dataPtr->motorType = MotorType::kVelocity;
+      _rotor.motorType = MotorType::kVelocity;
     else if (motorType == "position")
     {
-      this->dataPtr->motorType = MotorType::kPosition;
+      _rotor.motorType = MotorType::kPosition;
       ignerr << "motorType 'position' not supported" << std::endl;
     }
     else if (motorType == "force")
     {
-      this->dataPtr->motorType = MotorType::kForce;
+      _rotor.motorType = MotorType::kForce;
       ignerr << "motorType 'force' not supported" << std::endl;
     }
     else
@@ -324,49 +421,34 @@ void MulticopterMotorModel::Configure(const Entity &_entity,
   else
   {
     ignwarn << "motorType not specified, using velocity.\n";
-    this->dataPtr->motorType = MotorType::kVelocity;
+    _rotor.motorType = MotorType::kVelocity;
   }
 
-  sdfClone->Get<std::string>("commandSubTopic",
-      this->dataPtr->commandSubTopic, this->dataPtr->commandSubTopic);
-
-  sdfClone->Get<double>("rotorDragCoefficient",
-      this->dataPtr->rotorDragCoefficient,
-      this->dataPtr->rotorDragCoefficient);
-  sdfClone->Get<double>("rollingMomentCoefficient",
-      this->dataPtr->rollingMomentCoefficient,
-      this->dataPtr->rollingMomentCoefficient);
-  sdfClone->Get<double>("maxRotVelocity",
-      this->dataPtr->maxRotVelocity, this->dataPtr->maxRotVelocity);
-  sdfClone->Get<double>("motorConstant",
-      this->dataPtr->motorConstant, this->dataPtr->motorConstant);
-  sdfClone->Get<double>("momentConstant",
-      this->dataPtr->momentConstant, this->dataPtr->momentConstant);
-
-  sdfClone->Get<double>("timeConstantUp",
-      this->dataPtr->timeConstantUp, this->dataPtr->timeConstantUp);
-  sdfClone->Get<double>("timeConstantDown",
-      this->dataPtr->timeConstantDown, this->dataPtr->timeConstantDown);
-  sdfClone->Get<double>("rotorVelocitySlowdownSim",
-      this->dataPtr->rotorVelocitySlowdownSim, 10);
+  elem("rotorDragCoefficient")->Get<double>("rotorDragCoefficient",
+      _rotor.rotorDragCoefficient, _rotor.rotorDragCoefficient);
+  elem("rollingMomentCoefficient")->Get<double>("rollingMomentCoefficient",
+      _rotor.rollingMomentCoefficient, _rotor.rollingMomentCoefficient);
+  elem("maxRotVelocity")->Get<double>("maxRotVelocity",
+      _rotor.maxRotVelocity, _rotor.maxRotVelocity);
+  elem("motorConstant")->Get<double>("motorConstant",
+      _rotor.motorConstant, _rotor.motorConstant);
+  elem("momentConstant")->Get<double>("momentConstant",
+      _rotor.momentConstant, _rotor.momentConstant);
+
+  elem("timeConstantUp")->Get<double>("timeConstantUp",
+      _rotor.timeConstantUp, _rotor.timeConstantUp);
+  elem("timeConstantDown")->Get<double>("timeConstantDown",
+      _rotor.timeConstantDown, _rotor.timeConstantDown);
+  elem("rotorVelocitySlowdownSim")->Get<double>("rotorVelocitySlowdownSim",
+      _rotor.rotorVelocitySlowdownSim, 10);
 
   // Create the first order filter.
-  this->dataPtr->rotorVelocityFilter =
+  _rotor.rotorVelocityFilter =
       std::make_unique<FirstOrderFilter<double>>(
-          this->dataPtr->timeConstantUp, this->dataPtr->timeConstantDown,
-          this->dataPtr->refMotorInput);
+          _rotor.timeConstantUp, _rotor.timeConstantDown,
+          _rotor.refMotorInput);
 
-  // Subscribe to actuator command messages
-  std::string topic = transport::TopicUtils::AsValidTopic(
-      this->dataPtr->robotNamespace + "/" + this->dataPtr->commandSubTopic);
-  if (topic.empty())
-  {
-    ignerr << "Failed to create topic for [" << this->dataPtr->robotNamespace
-           << "]" << std::endl;
-    return;
-  }
-  this->dataPtr->node.Subscribe(topic,
-      &MulticopterMotorModelPrivate::OnActuatorMsg, this->dataPtr.get());
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -383,88 +465,98 @@ void MulticopterMotorModel::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
         << "s]. System may not work properly." << std::endl;
   }
 
+  // skip UpdateForcesAndMoments if needed components are missing
+  bool doUpdateForcesAndMoments = false;
+  for (auto &rotor : this->dataPtr->rotors)
+  {
+    rotor.Prepare(this->dataPtr->model, _ecm);
+    doUpdateForcesAndMoments = doUpdateForcesAndMoments || rotor.ready;
+  }
+
+  // Nothing left to do if paused.
+  if (_info.paused)
+    return;
+
+  this->dataPtr->samplingTime =
+    std::chrono::duration<double>(_info.dt).count();
+  if (doUpdateForcesAndMoments)
+  {
+    this->dataPtr->UpdateForcesAndMoments(_ecm);
+  }
+}
+
+//////////////////////////////////////////////////
+void MulticopterRotor::Prepare(Model &_model,
+    EntityComponentManager &_ecm)
+{
+  this->ready = false;
+
   // If the joint or links haven't been identified yet, look for them
-  if (this->dataPtr->jointEntity == kNullEntity)
+  if (this->jointEntity == kNullEntity)
   {
-    this->dataPtr->jointEntity =
-        this->dataPtr->model.JointByName(_ecm, this->dataPtr->jointName);
+    this->jointEntity = _model.JointByName(_ecm, this->jointName);
 
     const auto parentLinkName = _ecm.Component<components::ParentLinkName>(
-        this->dataPtr->jointEntity);
-    this->dataPtr->parentLinkName = parentLinkName->Data();
+        this->jointEntity);
+    if (parentLinkName)
+      this->parentLinkName = parentLinkName->Data();
   }
 
-  if (this->dataPtr->linkEntity == kNullEntity)
+  if (this->linkEntity == kNullEntity)
   {
-    this->dataPtr->linkEntity =
-        this->dataPtr->model.LinkByName(_ecm, this->dataPtr->linkName);
+    this->linkEntity = _model.LinkByName(_ecm, this->linkName);
   }
 
-  if (this->dataPtr->parentLinkEntity == kNullEntity)
+  if (this->parentLinkEntity == kNullEntity)
   {
-    this->dataPtr->parentLinkEntity =
-        this->dataPtr->model.LinkByName(_ecm, this->dataPtr->parentLinkName);
+    this->parentLinkEntity = _model.LinkByName(_ecm, this->parentLinkName);
   }
 
-  if (this->dataPtr->jointEntity == kNullEntity ||
-      this->dataPtr->linkEntity == kNullEntity ||
-      this->dataPtr->parentLinkEntity == kNullEntity)
+  if (this->jointEntity == kNullEntity ||
+      this->linkEntity == kNullEntity ||
+      this->parentLinkEntity == kNullEntity)
     return;
 
-  // skip UpdateForcesAndMoments if needed components are missing
-  bool doUpdateForcesAndMoments = true;
+  bool ready = true;
 
   const auto jointVelocity = _ecm.Component<components::JointVelocity>(
-      this->dataPtr->jointEntity);
+      this->jointEntity);
   if (!jointVelocity)
   {
-    _ecm.CreateComponent(this->dataPtr->jointEntity,
-        components::JointVelocity());
-    doUpdateForcesAndMoments = false;
+    _ecm.CreateComponent(this->jointEntity, components::JointVelocity());
+    ready = false;
   }
   else if (jointVelocity->Data().empty())
   {
-    doUpdateForcesAndMoments = false;
+    ready = false;
   }
 
-  if (!_ecm.Component<components::JointVelocityCmd>(
-      this->dataPtr->jointEntity))
+  if (!_ecm.Component<components::JointVelocityCmd>(this->jointEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->jointEntity,
+    _ecm.CreateComponent(this->jointEntity,
         components::JointVelocityCmd({0}));
-    doUpdateForcesAndMoments = false;
+    ready = false;
   }
 
-  if (!_ecm.Component<components::WorldPose>(this->dataPtr->linkEntity))
+  if (!_ecm.Component<components::WorldPose>(this->linkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->linkEntity, components::WorldPose());
-    doUpdateForcesAndMoments = false;
+    _ecm.CreateComponent(this->linkEntity, components::WorldPose());
+    ready = false;
   }
-  if (!_ecm.Component<components::WorldLinearVelocity>(
-      this->dataPtr->linkEntity))
+  if (!_ecm.Component<components::WorldLinearVelocity>(this->linkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->linkEntity,
+    _ecm.CreateComponent(this->linkEntity,
         components::WorldLinearVelocity());
-    doUpdateForcesAndMoments = false;
+    ready = false;
   }
 
-  if (!_ecm.Component<components::WorldPose>(this->dataPtr->parentLinkEntity))
+  if (!_ecm.Component<components::WorldPose>(this->parentLinkEntity))
   {
-    _ecm.CreateComponent(this->dataPtr->parentLinkEntity,
-        components::WorldPose());
-    doUpdateForcesAndMoments = false;
+    _ecm.CreateComponent(this->parentLinkEntity, components::WorldPose());
+    ready = false;
   }
 
-  // Nothing left to do if paused.
-  if (_info.paused)
-    return;
-
-  this->dataPtr->samplingTime =
-    std::chrono::duration<double>(_info.dt).count();
-  if (doUpdateForcesAndMoments)
-  {
-    this->dataPtr->UpdateForcesAndMoments(_ecm);
-  }
+  this->ready = ready;
 }
 
 //////////////////////////////////////////////////
@@ -481,46 +573,70 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
 {
   IGN_PROFILE("MulticopterMotorModelPrivate::UpdateForcesAndMoments");
 
-  std::optional<msgs::Actuators> msg;
+  const msgs::Actuators *msg{nullptr};
   auto actuatorMsgComp =
       _ecm.Component<components::Actuators>(this->model.Entity());
 
   // Actuators messages can come in from transport or via a component. If a
-  // component is available, it takes precedence.
+  // component is available, it takes precedence. Either way, all rotors read
+  // the same message without copying it.
   if (actuatorMsgComp)
   {
-    msg = actuatorMsgComp->Data();
+    msg = &actuatorMsgComp->Data();
   }
   else
   {
     std::lock_guard<std::mutex> lock(this->recvdActuatorsMsgMutex);
     if (this->recvdActuatorsMsg.has_value())
     {
-      msg = *this->recvdActuatorsMsg;
+      this->actuatorsMsg.Swap(&*this->recvdActuatorsMsg);
       this->recvdActuatorsMsg.reset();
+      msg = &this->actuatorsMsg;
+    }
+  }
+
+  math::Vector3d windSpeedWorld;
+  Entity windEntity = _ecm.EntityByComponents(components::Wind());
+  auto windLinearVel =
+      _ecm.Component<components::WorldLinearVelocity>(windEntity);
+  if (windLinearVel)
+    windSpeedWorld = windLinearVel->Data();
+
+  for (auto &rotor : this->rotors)
+  {
+    if (rotor.ready)
+    {
+      rotor.UpdateForcesAndMoments(msg, windSpeedWorld, this->samplingTime,
+          _ecm);
     }
   }
+}
 
-  if (msg.has_value())
+//////////////////////////////////////////////////
+void MulticopterRotor::UpdateForcesAndMoments(const msgs::Actuators *_msg,
+    const math::Vector3d &_windSpeedWorld, double _samplingTime,
+    EntityComponentManager &_ecm)
+{
+  if (nullptr != _msg)
   {
-    if (this->motorNumber > msg->velocity_size() - 1)
+    if (this->motorNumber > _msg->velocity_size() - 1)
     {
       ignerr << "You tried to access index " << this->motorNumber
         << " of the Actuator velocity array which is of size "
-        << msg->velocity_size() << std::endl;
+        << _msg->velocity_size() << std::endl;
       return;
     }
 
     if (this->motorType == MotorType::kVelocity)
     {
       this->refMotorInput = std::min(
-          static_cast<double>(msg->velocity(this->motorNumber)),
+          static_cast<double>(_msg->velocity(this->motorNumber)),
           static_cast<double>(this->maxRotVelocity));
     }
     //  else if (this->motorType == MotorType::kPosition)
     else  // if (this->motorType == MotorType::kForce) {
     {
-      this->refMotorInput = msg->velocity(this->motorNumber);
+      this->refMotorInput = _msg->velocity(this->motorNumber);
     }
   }
 
@@ -529,7 +645,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
     case (MotorType::kPosition):
     {
       // double err = joint_->GetAngle(0).Radian() - this->refMotorInput;
-      // double force = pids_.Update(err, this->samplingTime);
+      // double force = pids_.Update(err, _samplingTime);
       // joint_->SetForce(0, force);
       break;
     }
@@ -543,7 +659,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
       const auto jointVelocity = _ecm.Component<components::JointVelocity>(
           this->jointEntity);
       double motorRotVel = jointVelocity->Data()[0];
-      if (motorRotVel / (2 * IGN_PI) > 1 / (2 * this->samplingTime))
+      if (motorRotVel / (2 * IGN_PI) > 1 / (2 * _samplingTime))
       {
         ignerr << "Aliasing on motor [" << this->motorNumber
               << "] might occur. Consider making smaller simulation time "
@@ -592,11 +708,6 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
 
       const auto worldLinearVel = link.WorldLinearVelocity(_ecm);
 
-      Entity windEntity = _ecm.EntityByComponents(components::Wind());
-      auto windLinearVel =
-          _ecm.Component<components::WorldLinearVelocity>(windEntity);
-      Vector3 windSpeedWorld = windLinearVel->Data();
-
       // Forces from Philppe Martin's and Erwan Salaun's
       // 2010 IEEE Conference on Robotics and Automation paper
       // The True Role of Accelerometer Feedback in Quadrotor Control
@@ -604,7 +715,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
       Vector3 jointAxis =
           jointWorldPose.Rot().RotateVector(jointAxisComp->Data().Xyz());
       Vector3 bodyVelocityWorld = *worldLinearVel;
-      Vector3 relativeWindVelocityWorld = bodyVelocityWorld - windSpeedWorld;
+      Vector3 relativeWindVelocityWorld = bodyVelocityWorld - _windSpeedWorld;
       Vector3 bodyVelocityPerpendicular =
           relativeWindVelocityWorld -
           (relativeWindVelocityWorld.Dot(jointAxis) * jointAxis);
@@ -659,7 +770,7 @@ void MulticopterMotorModelPrivate::UpdateForcesAndMoments(
       // Apply the filter on the motor's velocity.
       double refMotorRotVel;
       refMotorRotVel = this->rotorVelocityFilter->UpdateFilter(
-          this->refMotorInput, this->samplingTime);
+          this->refMotorInput, _samplingTime);
 
       const auto jointVelCmd = _ecm.Component<components::JointVelocityCmd>(
           this->jointEntity);
@@ -33,6 +33,38 @@ namespace systems
 
   /// \brief This system applies a thrust force to models with spinning
   /// propellers. See examples/worlds/quadcopter.sdf for a demonstration.
+  ///
+  /// By default, each instance of the system models one rotor, set by
+  /// parameters such as `<jointName>`, `<linkName>` and `<motorNumber>`.
+  /// Alternatively, a single instance can model all the rotors of a vehicle,
+  /// with one `<rotor>` element per rotor holding its parameters. Parameters
+  /// which aren't set in a `<rotor>` are taken from the plugin itself, so
+  /// values shared by all rotors, like `<motorConstant>`, only need to be
+  /// set once. All rotors are evaluated in one pass per iteration, sharing
+  /// a single subscription to `<commandSubTopic>` and reading actuator
+  /// commands in place, which is much cheaper than loading one system per
+  /// rotor on large fleets.
+  ///
+  /// ```
+  /// <plugin filename="ignition-gazebo-multicopter-motor-model-system"
+  ///     name="ignition::gazebo::systems::MulticopterMotorModel">
+  ///   <robotNamespace>x3</robotNamespace>
+  ///   <commandSubTopic>command/motor_speed</commandSubTopic>
+  ///   <motorConstant>8.54858e-06</motorConstant>
+  ///   <rotor>
+  ///     <jointName>rotor_0_joint</jointName>
+  ///     <linkName>rotor_0</linkName>
+  ///     <turningDirection>ccw</turningDirection>
+  ///     <motorNumber>0</motorNumber>
+  ///   </rotor>
+  ///   <rotor>
+  ///     <jointName>rotor_1_joint</jointName>
+  ///     <linkName>rotor_1</linkName>
+  ///     <turningDirection>cw</turningDirection>
+  ///     <motorNumber>1</motorNumber>
+  ///   </rotor>
+  /// </plugin>
+  /// ```
   class MulticopterMotorModel
       : public System,
         public ISystemConfigure,
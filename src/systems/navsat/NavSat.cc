@@ -20,10 +20,12 @@
 #include <ignition/msgs/navsat.pb.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <sdf/Sensor.hh>
 
@@ -31,6 +33,7 @@
 #include <ignition/plugin/Register.hh>
 
 #include <ignition/math/Helpers.hh>
+#include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/transport/Node.hh>
 
 #include <ignition/sensors/SensorFactory.hh>
@@ -41,6 +44,7 @@
 #include "ignition/gazebo/components/NavSat.hh"
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Sensor.hh"
+#include "ignition/gazebo/components/SphericalCoordinates.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/Util.hh"
 
@@ -67,13 +71,52 @@ class ignition::gazebo::systems::NavSat::Implementation
   /// sensors. After this initialization, we only check inserted entities.
   public: bool initialized = false;
 
+  /// \brief A sensor which is due on the current update.
+  public: struct DueSensor
+  {
+    /// \brief Sensor entity.
+    Entity entity{kNullEntity};
+
+    /// \brief The sensor.
+    sensors::NavSatSensor *sensor{nullptr};
+
+    /// \brief Velocity of the sensor in the ENU frame.
+    math::Vector3d velocity;
+
+    /// \brief Latitude and longitude in radians, and altitude in meters.
+    math::Vector3d latLonEle;
+  };
+
+  /// \brief Sensors which are due on the current update. Kept across
+  /// updates to reuse its memory.
+  public: std::vector<DueSensor> dueSensors;
+
+  /// \brief Copy of the world's spherical coordinates, whose transforms
+  /// from the local tangent frame are precomputed. Nullopt if the world
+  /// doesn't have spherical coordinates.
+  public: std::optional<math::SphericalCoordinates> sphericalCoordinates;
+
+  /// \brief Change tick of the world's spherical coordinates component when
+  /// sphericalCoordinates was copied.
+  public: uint64_t sphericalCoordinatesTick{0u};
+
+  /// \brief Whether sphericalCoordinates has been copied yet.
+  public: bool sphericalCoordinatesLoaded{false};
+
+  /// \brief Update the copy of the world's spherical coordinates if the
+  /// component changed.
+  /// \param[in] _ecm Immutable reference to ECM.
+  public: void UpdateSphericalCoordinates(const EntityComponentManager &_ecm);
+
   /// \brief Create sensors in ign-sensors
   /// \param[in] _ecm Immutable reference to ECM.
   public: void CreateSensors(const EntityComponentManager &_ecm);
 
   /// \brief Update sensor data based on physics data
+  /// \param[in] _info Simulation update info.
   /// \param[in] _ecm Immutable reference to ECM.
-  public: void Update(const EntityComponentManager &_ecm);
+  public: void Update(const UpdateInfo &_info,
+      const EntityComponentManager &_ecm);
 
   /// \brief Remove sensors if their entities have been removed from simulation.
   /// \param[in] _ecm Immutable reference to ECM.
@@ -137,30 +180,8 @@ void NavSat::PostUpdate(const UpdateInfo &_info,
   // Only update and publish if not paused.
   if (!_info.paused)
   {
-    // check to see if update is necessary
-    // we only update if there is at least one sensor that needs data
-    // and that sensor has subscribers.
-    // note: ign-sensors does its own throttling. Here the check is mainly
-    // to avoid doing work in the NavSat::Implementation::Update function
-    bool needsUpdate = false;
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      if (it.second->NextDataUpdateTime() <= _info.simTime &&
-          it.second->HasConnections())
-      {
-        needsUpdate = true;
-        break;
-      }
-    }
-    if (!needsUpdate)
-      return;
-
-    this->dataPtr->Update(_ecm);
-
-    for (auto &it : this->dataPtr->entitySensorMap)
-    {
-      it.second.get()->sensors::Sensor::Update(_info.simTime, false);
-    }
+    // Only sensors which are due and have subscribers are updated
+    this->dataPtr->Update(_info, _ecm);
   }
 
   this->dataPtr->RemoveSensors(_ecm);
@@ -233,10 +254,12 @@ void NavSat::Implementation::CreateSensors(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void NavSat::Implementation::Update(const EntityComponentManager &_ecm)
+void NavSat::Implementation::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("NavSat::Update");
 
+  this->dueSensors.clear();
   _ecm.Each<components::NavSat, components::WorldLinearVelocity>(
     [&](const Entity &_entity,
         const components::NavSat * /*_navsat*/,
@@ -252,24 +275,85 @@ void NavSat::Implementation::Update(const EntityComponentManager &_ecm)
           return true;
         }
 
-        // Position
-        auto latLonEle = sphericalCoordinates(_entity, _ecm);
-        if (!latLonEle)
+        // Skip sensors which aren't due or have no subscribers
+        if (it->second->NextDataUpdateTime() > _info.simTime ||
+            !it->second->HasConnections())
         {
-          ignwarn << "Failed to update NavSat sensor enity [" << _entity
-                  << "]. Spherical coordinates not set." << std::endl;
           return true;
         }
 
-        it->second->SetLatitude(IGN_DTOR(latLonEle.value().X()));
-        it->second->SetLongitude(IGN_DTOR(latLonEle.value().Y()));
-        it->second->SetAltitude(latLonEle.value().Z());
-
-        // Velocity in ENU frame
-        it->second->SetVelocity(_worldLinearVel->Data());
-
+        this->dueSensors.push_back(
+            {_entity, it->second.get(), _worldLinearVel->Data(), {}});
         return true;
       });
+
+  if (this->dueSensors.empty())
+    return;
+
+  this->UpdateSphericalCoordinates(_ecm);
+  if (!this->sphericalCoordinates)
+  {
+    for (const auto &due : this->dueSensors)
+    {
+      ignwarn << "Failed to update NavSat sensor enity [" << due.entity
+              << "]. Spherical coordinates not set." << std::endl;
+    }
+    return;
+  }
+
+  // Convert the positions of all due sensors at once. The conversion only
+  // reads poses and the shared spherical coordinates, so it's spread across
+  // threads on large fleets.
+  const auto &sc = *this->sphericalCoordinates;
+  _ecm.ParallelFor(this->dueSensors.size(),
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          auto &due = this->dueSensors[i];
+          due.latLonEle = sc.PositionTransform(
+              _ecm.WorldPose(due.entity).Pos(),
+              math::SphericalCoordinates::LOCAL2,
+              math::SphericalCoordinates::SPHERICAL);
+        }
+      }, 64u);
+
+  // Publishing goes through transport, so it's done serially
+  for (const auto &due : this->dueSensors)
+  {
+    due.sensor->SetLatitude(due.latLonEle.X());
+    due.sensor->SetLongitude(due.latLonEle.Y());
+    due.sensor->SetAltitude(due.latLonEle.Z());
+
+    // Velocity in ENU frame
+    due.sensor->SetVelocity(due.velocity);
+
+    due.sensor->sensors::Sensor::Update(_info.simTime, false);
+  }
+}
+
+//////////////////////////////////////////////////
+void NavSat::Implementation::UpdateSphericalCoordinates(
+    const EntityComponentManager &_ecm)
+{
+  const Entity world = worldEntity(_ecm);
+  const uint64_t tick = _ecm.ComponentChangeTick(world,
+      components::SphericalCoordinates::typeId);
+  if (this->sphericalCoordinatesLoaded &&
+      tick == this->sphericalCoordinatesTick)
+  {
+    return;
+  }
+
+  auto sphericalCoordinatesComp =
+      _ecm.Component<components::SphericalCoordinates>(world);
+  if (nullptr == sphericalCoordinatesComp)
+    this->sphericalCoordinates.reset();
+  else
+    this->sphericalCoordinates = sphericalCoordinatesComp->Data();
+
+  this->sphericalCoordinatesTick = tick;
+  this->sphericalCoordinatesLoaded = true;
 }
 
 //////////////////////////////////////////////////
@@ -331,7 +331,7 @@ void OdometryPublisherPrivate::UpdateOdometry(
     return;
 
   // Get and set robotBaseFrame to odom transformation.
-  const math::Pose3d rawPose = worldPose(this->model.Entity(), _ecm);
+  const math::Pose3d rawPose = _ecm.WorldPose(this->model.Entity());
   math::Pose3d pose = rawPose * this->offset;
   msg.mutable_pose()->mutable_position()->set_x(pose.Pos().X());
   msg.mutable_pose()->mutable_position()->set_y(pose.Pos().Y());
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <optional>
 #include <string>
 #include <vector>
@@ -73,17 +74,26 @@ class ignition::gazebo::systems::OpticalTactilePluginPrivate
   /// of the image, pointing downwards
   /// \param[in] _msgBuffer Buffer with the point cloud data
   /// \returns The corresponding (X,Y,Z) point
+  /// \sa SetPointCloudLayout
   public: ignition::math::Vector3f MapPointCloudData(const uint64_t &_i,
-    const uint64_t &_j, const char *_msgBuffer);
+    const uint64_t &_j, const char *_msgBuffer) const;
+
+  /// \brief Store the layout of a depth camera message, used by
+  /// MapPointCloudData, so that it isn't looked up for every point.
+  /// \param[in] _msg Message from the depth camera
+  public: void SetPointCloudLayout(
+    const ignition::msgs::PointCloudPacked &_msg);
 
   /// \brief Check if a specific point from the depth camera is inside
   /// the contact surface.
   /// \param[in] _point Point from the depth camera
-  public: bool PointInsideSensor(ignition::math::Vector3f _point);
+  public: bool PointInsideSensor(ignition::math::Vector3f _point) const;
 
   /// \brief Computes the normal forces of the Optical Tactile sensor
   /// \param[in] _msg Message from the depth camera
   /// \param[in] _visualizeForces Whether to visualize the forces or not
+  /// \param[in] _ecm Immutable reference to the EntityComponentManager,
+  /// whose worker pool is used to compute rows of forces concurrently
   ///
   /// Implementation inspired by
   /// https://stackoverflow.com/questions/
@@ -91,7 +101,8 @@ class ignition::gazebo::systems::OpticalTactilePluginPrivate
   /// using-neighboring-pixels-cross-produc
   public: void ComputeNormalForces(
     const ignition::msgs::PointCloudPacked &_msg,
-    const bool _visualizeForces);
+    const bool _visualizeForces,
+    const EntityComponentManager &_ecm);
 
   /// \brief Resolution of the visualization in pixels to skip.
   public: int visualizationResolution{30};
@@ -145,6 +156,24 @@ class ignition::gazebo::systems::OpticalTactilePluginPrivate
   /// \brief Message returned by the depth camera
   public: ignition::msgs::PointCloudPacked cameraMsg;
 
+  /// \brief Depth camera message being processed. It's swapped with
+  /// cameraMsg, so that the camera callback isn't blocked while forces are
+  /// computed, and the memory of both messages is reused across frames.
+  public: ignition::msgs::PointCloudPacked processedMsg;
+
+  /// \brief Message for publishing normal forces, reused across frames.
+  public: ignition::msgs::Image normalsMsg;
+
+  /// \brief Number of bytes between rows of the message being processed.
+  public: uint32_t rowStep{0u};
+
+  /// \brief Number of bytes between points of the message being processed.
+  public: uint32_t pointStep{0u};
+
+  /// \brief Offsets of the X, Y and Z fields within a point of the message
+  /// being processed, in bytes.
+  public: uint32_t fieldOffsets[3]{0u, 4u, 8u};
+
   /// \brief Mutex for variables mutated by the camera callback.
   /// The variables are: newCameraMsg, cameraMsg.
   public: std::mutex serviceMutex;
@@ -436,16 +465,21 @@ void OpticalTactilePlugin::PostUpdate(
   }
 
   // Process camera message if it's new
+  bool newCameraMsg{false};
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->serviceMutex);
     if (this->dataPtr->newCameraMsg)
     {
-      this->dataPtr->ComputeNormalForces(this->dataPtr->cameraMsg,
-        this->dataPtr->visualizeForces);
-
+      this->dataPtr->processedMsg.Swap(&this->dataPtr->cameraMsg);
       this->dataPtr->newCameraMsg = false;
+      newCameraMsg = true;
     }
   }
+  if (newCameraMsg)
+  {
+    this->dataPtr->ComputeNormalForces(this->dataPtr->processedMsg,
+      this->dataPtr->visualizeForces, _ecm);
+  }
 
   // Publish sensor marker if required and sensor pose has changed
   if (this->dataPtr->visualizeSensor &&
@@ -669,11 +703,21 @@ void OpticalTactilePluginPrivate::DepthCameraCallback(
   }
 }
 
+//////////////////////////////////////////////////
+void OpticalTactilePluginPrivate::SetPointCloudLayout(
+  const ignition::msgs::PointCloudPacked &_msg)
+{
+  this->rowStep = _msg.row_step();
+  this->pointStep = _msg.point_step();
+  for (int i = 0; i < 3 && i < _msg.field_size(); ++i)
+    this->fieldOffsets[i] = _msg.field(i).offset();
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3f OpticalTactilePluginPrivate::MapPointCloudData(
-  const uint64_t &_i, const uint64_t &_j, const char *_msgBuffer)
+  const uint64_t &_i, const uint64_t &_j, const char *_msgBuffer) const
 {
-  IGN_PROFILE("OpticalTactilePlugin::MapPointCloudData");
+  // This is called for every point, so it isn't profiled on its own
 
   // Initialize return variable
   ignition::math::Vector3f measuredPoint(0, 0, 0);
@@ -682,26 +726,15 @@ ignition::math::Vector3f OpticalTactilePluginPrivate::MapPointCloudData(
   if (!this->initialized)
     return measuredPoint;
 
-  // Save original position of the pointer
-  const char *temporaryMsgBuffer = _msgBuffer;
-
   // Number of bytes from the beginning of the pointer (image coordinates at
   // 0,0) to the desired (i,j) position
-  uint32_t msgBufferIndex =
-    _j*this->cameraMsg.row_step() + _i*this->cameraMsg.point_step();
-
-  temporaryMsgBuffer += msgBufferIndex;
-  int fieldIndex = 0;
-
-  // X coordinate
-  measuredPoint.X() = *reinterpret_cast<const float *>(
-    temporaryMsgBuffer + this->cameraMsg.field(fieldIndex++).offset());
-  // Y coordinate
-  measuredPoint.Y() = *reinterpret_cast<const float *>(
-    temporaryMsgBuffer + this->cameraMsg.field(fieldIndex++).offset());
-  // Z coordinate
-  measuredPoint.Z() = *reinterpret_cast<const float *>(
-    temporaryMsgBuffer + this->cameraMsg.field(fieldIndex).offset());
+  const char *point = _msgBuffer + _j * this->rowStep + _i * this->pointStep;
+
+  // The buffer isn't guaranteed to be aligned for floats
+  float xyz[3];
+  for (int k = 0; k < 3; ++k)
+    std::memcpy(&xyz[k], point + this->fieldOffsets[k], sizeof(float));
+  measuredPoint.Set(xyz[0], xyz[1], xyz[2]);
 
   // Check if point is inside the sensor
   bool pointInside = this->PointInsideSensor(measuredPoint);
@@ -717,10 +750,8 @@ ignition::math::Vector3f OpticalTactilePluginPrivate::MapPointCloudData(
 
 //////////////////////////////////////////////////
 bool OpticalTactilePluginPrivate::PointInsideSensor(
-  ignition::math::Vector3f _point)
+  ignition::math::Vector3f _point) const
 {
-  IGN_PROFILE("OpticalTactilePlugin::PointInsideSensor");
-
   // Nothing left to do if failed to initialize.
   if (!this->initialized)
     return false;
@@ -747,7 +778,8 @@ bool OpticalTactilePluginPrivate::PointInsideSensor(
 //////////////////////////////////////////////////
 void OpticalTactilePluginPrivate::ComputeNormalForces(
   const ignition::msgs::PointCloudPacked &_msg,
-  const bool _visualizeForces)
+  const bool _visualizeForces,
+  const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("OpticalTactilePlugin::ComputeNormalForces");
 
@@ -757,80 +789,99 @@ void OpticalTactilePluginPrivate::ComputeNormalForces(
 
   // Get data from the message
   const char *msgBuffer = _msg.data().data();
+  this->SetPointCloudLayout(_msg);
+
+  // Message for publishing normal forces. Its buffer is only reallocated
+  // if the image size changes.
+  this->normalsMsg.set_width(_msg.width());
+  this->normalsMsg.set_height(_msg.height());
+  this->normalsMsg.set_step(3 * sizeof(float) * _msg.width());
+  this->normalsMsg.set_pixel_format_type(
+    ignition::msgs::PixelFormatType::R_FLOAT32);
+
+  const std::size_t bufferSize =
+    3 * sizeof(float) * _msg.width() * _msg.height();
+  auto normalForcesData = this->normalsMsg.mutable_data();
+  normalForcesData->assign(bufferSize, 0);
+  char *normalForcesBuffer = &(*normalForcesData)[0];
 
-  // Declare variables for storing the XYZ points
-  ignition::math::Vector3f p1, p2, p3, p4, markerPosition;
+  // We don't get the image's edges because there are no adjacent points to
+  // compute the forces
+  std::vector<uint64_t> rows;
+  for (uint64_t j = 1; j + 1 < _msg.height();
+      j += this->visualizationResolution)
+  {
+    rows.push_back(j);
+  }
 
-  // Message for publishing normal forces
-  ignition::msgs::Image normalsMsg;
-  normalsMsg.set_width(_msg.width());
-  normalsMsg.set_height(_msg.height());
-  normalsMsg.set_step(3 * sizeof(float) * _msg.width());
-  normalsMsg.set_pixel_format_type(ignition::msgs::PixelFormatType::R_FLOAT32);
+  // Rows write to distinct parts of the buffer, so they're computed
+  // concurrently
+  _ecm.ParallelFor(rows.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t r = _begin; r < _end; ++r)
+    {
+      const uint64_t j = rows[r];
+      for (uint64_t i = 1; i + 1 < _msg.width();
+          i += this->visualizationResolution)
+      {
+        // Get points for computing normal forces
+        auto p1 = this->MapPointCloudData(i + 1, j, msgBuffer);
+        auto p2 = this->MapPointCloudData(i - 1, j, msgBuffer);
+        auto p3 = this->MapPointCloudData(i, j + 1, msgBuffer);
+        auto p4 = this->MapPointCloudData(i, j - 1, msgBuffer);
+
+        float dxdi = (p1.X() - p2.X()) / std::abs(p1.Y() - p2.Y());
+        float dxdj =  (p3.X() - p4.X()) / std::abs(p3.Z() - p4.Z());
+
+        ignition::math::Vector3f direction(-1, -dxdi, -dxdj);
+
+        // todo(anyone) multiply vector by contact forces info
+
+        // todo(anyone) Replace with MatrixX and use vector multiplication
+        // instead of for-loops once the following issue is completed:
+        // https://github.com/ignitionrobotics/ign-math/issues/144
+        ignition::math::Vector3f normalForce = direction.Normalized();
+
+        // Add force to buffer
+        // Forces buffer is composed of XYZ coordinates, while _msg buffer is
+        // made up of XYZRGB values
+        const float xyz[3]{normalForce.X(), normalForce.Y(), normalForce.Z()};
+        std::memcpy(normalForcesBuffer + 3 * sizeof(float) *
+          (j * _msg.width() + i), xyz, sizeof(xyz));
+      }
+    }
+  }, 4u);
 
-  uint32_t bufferSize = 3 * sizeof(float) * _msg.width() * _msg.height();
-  std::shared_ptr<char> normalForcesBuffer(new char[bufferSize]);
-  uint32_t bufferIndex;
+  // Publish message
+  this->normalForcesPub.Publish(this->normalsMsg);
+
+  if (!_visualizeForces)
+    return;
 
   // Marker messages representing the normal forces
   ignition::msgs::Marker positionMarkerMsg;
   ignition::msgs::Marker forceMarkerMsg;
 
-  // We don't get the image's edges because there are no adjacent points to
-  // compute the forces
-  for (uint64_t j = 1; j < (_msg.height() - 1);
-      j += this->visualizationResolution)
+  for (const auto j : rows)
   {
-    for (uint64_t i = 1; i < (_msg.width() - 1);
+    for (uint64_t i = 1; i + 1 < _msg.width();
         i += this->visualizationResolution)
     {
-      // Get points for computing normal forces
-      p1 = this->MapPointCloudData(i + 1, j, msgBuffer);
-      p2 = this->MapPointCloudData(i - 1, j, msgBuffer);
-      p3 = this->MapPointCloudData(i, j + 1, msgBuffer);
-      p4 = this->MapPointCloudData(i, j - 1, msgBuffer);
-
-      float dxdi = (p1.X() - p2.X()) / std::abs(p1.Y() - p2.Y());
-      float dxdj =  (p3.X() - p4.X()) / std::abs(p3.Z() - p4.Z());
-
-      ignition::math::Vector3f direction(-1, -dxdi, -dxdj);
-
-      // todo(anyone) multiply vector by contact forces info
-
-      // todo(anyone) Replace with MatrixX and use vector multiplication instead
-      // of for-loops once the following issue is completed:
-      // https://github.com/ignitionrobotics/ign-math/issues/144
-      ignition::math::Vector3f normalForce = direction.Normalized();
-
-      // Add force to buffer
-      // Forces buffer is composed of XYZ coordinates, while _msg buffer is
-      // made up of XYZRGB values
-      bufferIndex = j * (_msg.row_step() / 2) + i * (_msg.point_step() / 2);
-      normalForcesBuffer.get()[bufferIndex] = normalForce.X();
-      normalForcesBuffer.get()[bufferIndex + sizeof(float)] = normalForce.Y();
-      normalForcesBuffer.get()[bufferIndex + 2 * sizeof(float)] =
-        normalForce.Z();
+      float xyz[3];
+      std::memcpy(xyz, normalForcesBuffer + 3 * sizeof(float) *
+        (j * _msg.width() + i), sizeof(xyz));
+      ignition::math::Vector3f normalForce(xyz[0], xyz[1], xyz[2]);
 
-      if (!_visualizeForces)
-        continue;
-
-      markerPosition = this->MapPointCloudData(i, j, msgBuffer);
+      auto markerPosition = this->MapPointCloudData(i, j, msgBuffer);
       this->visualizePtr->AddNormalForceToMarkerMsgs(positionMarkerMsg,
         forceMarkerMsg, markerPosition, normalForce,
         this->tactileSensorWorldPose);
     }
   }
 
-  // Publish message
-  normalsMsg.set_data(normalForcesBuffer.get(),
-    3 * sizeof(float) * _msg.width() * _msg.height());
-  this->normalForcesPub.Publish(normalsMsg);
-
-  if (_visualizeForces)
-  {
-    this->visualizePtr->RequestNormalForcesMarkerMsgs(positionMarkerMsg,
-      forceMarkerMsg);
-  }
+  this->visualizePtr->RequestNormalForcesMarkerMsgs(positionMarkerMsg,
+    forceMarkerMsg);
 }
 
 IGNITION_ADD_PLUGIN(OpticalTactilePlugin,
@@ -60,6 +60,11 @@ class ignition::gazebo::systems::ParticleEmitter2Private
   /// \brief Map of Entity to particle emitter command requested externally.
   public: std::map<Entity, ignition::msgs::ParticleEmitter> userCmd;
 
+  /// \brief Serialized last command applied to each emitter, so that
+  /// repeated commands, such as those published periodically, don't reach
+  /// the ECM and the scene again.
+  public: std::map<Entity, std::string> appliedCmd;
+
   /// \brief A mutex to protect the user command.
   public: std::mutex mutex;
 
@@ -218,8 +223,14 @@ void ParticleEmitter2::PreUpdate(const ignition::gazebo::UpdateInfo &_info,
     return;
 
   // Process each command
-  for (const auto cmd : this->dataPtr->userCmd)
+  for (const auto &cmd : this->dataPtr->userCmd)
   {
+    auto serialized = cmd.second.SerializeAsString();
+    auto &applied = this->dataPtr->appliedCmd[cmd.first];
+    if (applied == serialized)
+      continue;
+    applied = std::move(serialized);
+
     // Create component.
     auto emitterComp = _ecm.Component<components::ParticleEmitterCmd>(
         cmd.first);
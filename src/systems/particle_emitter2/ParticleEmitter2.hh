@@ -39,6 +39,11 @@ namespace systems
   /// specified, the following topic naming scheme will be used:
   /// `/model/{model_name}/link/{link_name}/particle_emitter/{emitter_name}/cmd`
   ///
+  /// Particles are simulated by the render engine, so the ECM only holds
+  /// the emitters' parameters. Commands which repeat the last command sent
+  /// to an emitter are dropped, and the rendering side only applies the
+  /// parameters which changed.
+  ///
   /// \todo(nkoenig) Plan for ParticleEmitter and ParticleEmitter2:
   ///     1. Deprecate ParticleEmitter in Ignition Fortress.
   ///     2. Remove ParticleEmitter in Ignition G.
@@ -17,6 +17,12 @@
 
 #include <ignition/msgs/pose.pb.h>
 
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/Vector3.hh>
@@ -41,6 +47,180 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Volumes of the performers of a world, computed once per step
+/// and shared by all the detectors in that world. Performers are sorted by
+/// the X coordinate of their center, so detectors only visit the performers
+/// whose volume may overlap their region along X.
+class ignition::gazebo::systems::PerformerDetectorCache
+{
+  /// \brief A performer and its volume.
+  public: struct Performer
+  {
+    /// \brief Performer entity.
+    Entity entity{kNullEntity};
+
+    /// \brief Model of the performer.
+    Entity parent{kNullEntity};
+
+    /// \brief Pose of the model.
+    math::Pose3d pose;
+
+    /// \brief Volume of the performer.
+    math::AxisAlignedBox volume;
+  };
+
+  /// \brief Get the cache of a world, creating it if needed.
+  /// \param[in] _ecm Entity component manager of the world.
+  /// \return The world's cache.
+  public: static std::shared_ptr<PerformerDetectorCache> Get(
+              const EntityComponentManager &_ecm);
+
+  /// \brief Recompute the performers' volumes, unless they've already been
+  /// computed in this iteration. Detectors may call this concurrently.
+  /// \param[in] _info Current update info.
+  /// \param[in] _ecm Entity component manager.
+  public: void Update(const UpdateInfo &_info,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Visit the performers whose volume intersects a region.
+  /// \param[in] _region Region to test.
+  /// \param[in] _func Function called with each intersecting performer.
+  public: template <typename Func>
+          void Query(const math::AxisAlignedBox &_region, Func _func) const
+  {
+    const double minX = _region.Min().X() - this->maxHalfSizeX;
+    const double maxX = _region.Max().X() + this->maxHalfSizeX;
+    auto it = std::lower_bound(this->performers.begin(),
+        this->performers.end(), minX,
+        [](const Performer &_performer, double _x)
+        {
+          return _performer.volume.Center().X() < _x;
+        });
+    for (; it != this->performers.end() &&
+           it->volume.Center().X() <= maxX; ++it)
+    {
+      if (_region.Intersects(it->volume))
+        _func(*it);
+    }
+  }
+
+  /// \brief Find a performer.
+  /// \param[in] _entity Performer entity.
+  /// \return The performer, or nullptr if it doesn't exist.
+  public: const Performer *Find(const Entity _entity) const
+  {
+    auto it = this->indices.find(_entity);
+    if (it == this->indices.end())
+      return nullptr;
+    return &this->performers[it->second];
+  }
+
+  /// \brief Number incremented whenever a performer moves, appears or
+  /// disappears. Starts at 1.
+  public: uint64_t generation{1u};
+
+  /// \brief Performers, sorted by the X coordinate of their volume's
+  /// center.
+  private: std::vector<Performer> performers;
+
+  /// \brief Index of each performer in `performers`.
+  private: std::unordered_map<Entity, std::size_t> indices;
+
+  /// \brief Largest half size of a performer along X.
+  private: double maxHalfSizeX{0.0};
+
+  /// \brief Iteration at which the volumes were last computed.
+  private: uint64_t iteration{std::numeric_limits<uint64_t>::max()};
+
+  /// \brief Protects the update, which is made by the first detector to
+  /// reach it on each iteration.
+  private: std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+std::shared_ptr<PerformerDetectorCache> PerformerDetectorCache::Get(
+    const EntityComponentManager &_ecm)
+{
+  static std::mutex cachesMutex;
+  static std::unordered_map<const EntityComponentManager *,
+      std::weak_ptr<PerformerDetectorCache>> caches;
+
+  std::lock_guard<std::mutex> lock(cachesMutex);
+  auto cache = caches[&_ecm].lock();
+  if (!cache)
+  {
+    cache = std::make_shared<PerformerDetectorCache>();
+    caches[&_ecm] = cache;
+  }
+  return cache;
+}
+
+//////////////////////////////////////////////////
+void PerformerDetectorCache::Update(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->iteration == _info.iterations)
+    return;
+  this->iteration = _info.iterations;
+
+  std::vector<Performer> newPerformers;
+  newPerformers.reserve(this->performers.size());
+  double maxHalfX{0.0};
+  bool changed{false};
+  _ecm.Each<components::Performer, components::Geometry,
+            components::ParentEntity>(
+      [&](const Entity &_entity, const components::Performer *,
+          const components::Geometry *_geometry,
+          const components::ParentEntity *_parent) -> bool
+      {
+        // We assume the geometry contains a box.
+        auto perfBox = _geometry->Data().BoxShape();
+        if (nullptr == perfBox)
+        {
+          ignerr << "Internal error: geometry of performer [" << _entity
+                 << "] missing box." << std::endl;
+          return true;
+        }
+
+        Performer performer;
+        performer.entity = _entity;
+        performer.parent = _parent->Data();
+        performer.pose =
+            _ecm.Component<components::Pose>(_parent->Data())->Data();
+        performer.volume = math::AxisAlignedBox(
+            performer.pose.Pos() - perfBox->Size() / 2,
+            performer.pose.Pos() + perfBox->Size() / 2);
+        maxHalfX = std::max(maxHalfX, perfBox->Size().X() / 2);
+
+        auto previous = this->Find(_entity);
+        if (nullptr == previous || previous->pose != performer.pose ||
+            previous->volume != performer.volume)
+        {
+          changed = true;
+        }
+
+        newPerformers.push_back(performer);
+        return true;
+      });
+
+  if (!changed && newPerformers.size() == this->performers.size())
+    return;
+
+  std::sort(newPerformers.begin(), newPerformers.end(),
+      [](const Performer &_a, const Performer &_b)
+      {
+        return _a.volume.Center().X() < _b.volume.Center().X();
+      });
+
+  this->performers = std::move(newPerformers);
+  this->indices.clear();
+  for (std::size_t i = 0; i < this->performers.size(); ++i)
+    this->indices[this->performers[i].entity] = i;
+  this->maxHalfSizeX = maxHalfX;
+  ++this->generation;
+}
+
 /////////////////////////////////////////////////
 void PerformerDetector::Configure(const Entity &_entity,
                const std::shared_ptr<const sdf::Element> &_sdf,
@@ -125,6 +305,7 @@ void PerformerDetector::Configure(const Entity &_entity,
 
   transport::Node node;
   this->pub = node.Advertise<msgs::Pose>(topic);
+  this->cache = PerformerDetectorCache::Get(_ecm);
   this->initialized = true;
 }
 
@@ -159,45 +340,50 @@ void PerformerDetector::PostUpdate(
   auto region = this->detectorGeometry -
     (-(modelPose.Pos() + modelPose.Rot() * this->poseOffset.Pos()));
 
-  _ecm.Each<components::Performer, components::Geometry,
-            components::ParentEntity>(
-      [&](const Entity &_entity, const components::Performer *,
-          const components::Geometry *_geometry,
-          const components::ParentEntity *_parent) -> bool
-      {
-        auto pose = _ecm.Component<components::Pose>(_parent->Data())->Data();
-        auto name = _ecm.Component<components::Name>(_parent->Data())->Data();
-        const math::Pose3d relPose = modelPose.Inverse() * pose;
+  this->cache->Update(_info, _ecm);
 
-        // We assume the geometry contains a box.
-        auto perfBox = _geometry->Data().BoxShape();
-        if (nullptr == perfBox)
-        {
-          ignerr << "Internal error: geometry of performer [" << _entity
-                 << "] missing box." << std::endl;
-          return true;
-        }
-
-        math::AxisAlignedBox performerVolume{pose.Pos() - perfBox->Size() / 2,
-                                             pose.Pos() + perfBox->Size() / 2};
-
-        bool alreadyDetected = this->IsAlreadyDetected(_entity);
-        if (region.Intersects(performerVolume))
-        {
-          if (!alreadyDetected)
-          {
-            this->AddToDetected(_entity);
-            this->Publish(_entity, name, true, relPose, _info.simTime);
-          }
-        }
-        else if (alreadyDetected)
-        {
-          this->RemoveFromDetected(_entity);
-          this->Publish(_entity, name, false, relPose, _info.simTime);
-        }
+  // Nothing to do if neither the region nor any performer moved
+  if (this->lastGeneration == this->cache->generation &&
+      this->lastRegion == region)
+  {
+    return;
+  }
+  this->lastGeneration = this->cache->generation;
+  this->lastRegion = region;
 
-        return true;
+  std::unordered_set<Entity> intersecting;
+  this->cache->Query(region,
+      [&](const PerformerDetectorCache::Performer &_performer)
+      {
+        intersecting.insert(_performer.entity);
+        if (this->IsAlreadyDetected(_performer.entity))
+          return;
+
+        auto name =
+            _ecm.Component<components::Name>(_performer.parent)->Data();
+        this->AddToDetected(_performer.entity);
+        this->Publish(_performer.entity, name, true,
+            modelPose.Inverse() * _performer.pose, _info.simTime);
       });
+
+  // Performers which were detected but no longer intersect the region
+  std::vector<Entity> left;
+  for (const auto &entity : this->detectedEntities)
+  {
+    if (intersecting.find(entity) == intersecting.end())
+      left.push_back(entity);
+  }
+  for (const auto &entity : left)
+  {
+    auto performer = this->cache->Find(entity);
+    if (nullptr == performer)
+      continue;
+
+    auto name = _ecm.Component<components::Name>(performer->parent)->Data();
+    this->RemoveFromDetected(entity);
+    this->Publish(entity, name, false,
+        modelPose.Inverse() * performer->pose, _info.simTime);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_PERFORMERDETECTOR_HH_
 #define IGNITION_GAZEBO_SYSTEMS_PERFORMERDETECTOR_HH_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,6 +37,9 @@ namespace gazebo
 inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
 namespace systems
 {
+  // Forward declarations.
+  class PerformerDetectorCache;
+
   /// \brief A system system that publishes on a topic when a performer enters
   /// or leaves a specified region.
   ///
@@ -61,6 +65,11 @@ namespace systems
   /// The system does not assume that levels are enabled, but it does require
   /// performers to be specified.
   ///
+  /// The volumes of the performers are computed once per step and shared by
+  /// all the detectors in the world, which only test the performers near
+  /// their region. A detector skips its check when neither its region nor
+  /// any performer moved since its last check.
+  ///
   /// ## System parameters
   ///
   /// `<topic>`: Custom topic to be used for publishing when a performer is
@@ -145,6 +154,16 @@ namespace systems
 
     /// \brief Optional extra header data.
     private: std::map<std::string, std::string> extraHeaderData;
+
+    /// \brief Performers of the world, shared with the other detectors.
+    private: std::shared_ptr<PerformerDetectorCache> cache;
+
+    /// \brief Detection region at the last check.
+    private: math::AxisAlignedBox lastRegion;
+
+    /// \brief Generation of the cache at the last check, zero if the
+    /// detector hasn't checked yet.
+    private: uint64_t lastGeneration{0u};
   };
 
   }
@@ -18,9 +18,12 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_ENTITY_FEATURE_MAP_HH_
 #define IGNITION_GAZEBO_SYSTEMS_PHYSICS_ENTITY_FEATURE_MAP_HH_
 
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ignition/physics/Entity.hh>
 #include <ignition/physics/FindFeatures.hh>
@@ -52,6 +55,13 @@ namespace systems::physics_system
   // this because there's a 1:1 mapping between the two in maps contained in
   // this class.
   //
+  // Maps which are queried for many entities on every step, such as links
+  // and joints, can be created in dense mode. Lookups by Gazebo entity or by
+  // physics entity ID then index vectors instead of hashing, since both kinds
+  // of IDs are handed out sequentially. Each vector takes one slot per ID up to
+  // the largest one in the map, so IDs above kMaxDenseId fall back to the
+  // hash maps.
+  //
   // \tparam PhysicsEntityT Type of entity, such as World, Model, or Link
   // \tparam PolicyT Policy of the physics engine (2D, 3D)
   // \tparam RequiredFeatureList Required features of the physics entity
@@ -83,6 +93,18 @@ namespace systems::physics_system
                  std::tuple<RequiredEntityPtr,
                             PhysicsEntityPtr<OptionalFeatureLists>...>;
 
+    /// \brief Largest Gazebo entity or physics entity ID that is looked up
+    /// through the dense indices.
+    public: static constexpr std::size_t kMaxDenseId{1u << 22};
+
+    /// \brief Constructor
+    /// \param[in] _dense True to look up entities through dense indices
+    /// instead of hash maps.
+    public: explicit EntityFeatureMap(bool _dense = false)
+        : dense(_dense)
+    {
+    }
+
     /// \brief Helper function to cast from an entity type with minimum features
     /// to an entity with a different set of features. When the entity is cast
     /// successfully, it is added to an internal cache so that subsequent casts
@@ -108,6 +130,21 @@ namespace systems::physics_system
       else
       {
         using ToEntityPtr = PhysicsEntityPtr<ToFeatureList>;
+        if (this->IsDense(_entity))
+        {
+          auto entry = this->FindDense(_entity);
+          if (nullptr == entry)
+            return nullptr;
+
+          auto &castEntity = std::get<ToEntityPtr>(entry->value);
+          if (nullptr == castEntity)
+          {
+            castEntity = physics::RequestFeatures<ToFeatureList>::From(
+                std::get<0>(entry->value));
+          }
+          return castEntity;
+        }
+
         // Has already been cast
         auto castIt = this->castCache.find(_entity);
         if (castIt != this->castCache.end())
@@ -165,6 +202,14 @@ namespace systems::physics_system
     /// nullptr
     public: RequiredEntityPtr Get(const Entity &_entity) const
     {
+      if (this->IsDense(_entity))
+      {
+        auto entry = this->FindDense(_entity);
+        if (nullptr != entry)
+          return std::get<0>(entry->value);
+        return nullptr;
+      }
+
       auto it = this->entityMap.find(_entity);
       if (it != this->entityMap.end())
       {
@@ -180,6 +225,9 @@ namespace systems::physics_system
     /// kNullEntity
     public: Entity Get(const RequiredEntityPtr &_physEntity) const
     {
+      if (nullptr != _physEntity && this->IsDense(_physEntity->EntityID()))
+        return this->GetByPhysicsId(_physEntity->EntityID());
+
       auto it = this->reverseMap.find(_physEntity);
       if (it != this->reverseMap.end())
       {
@@ -195,6 +243,14 @@ namespace systems::physics_system
     /// nullptr
     public: RequiredEntityPtr GetPhysicsEntityPtr(std::size_t _id) const
     {
+      if (this->IsDense(_id))
+      {
+        auto entry = this->FindDenseByPhysicsId(_id);
+        if (nullptr != entry)
+          return std::get<0>(entry->value);
+        return nullptr;
+      }
+
       auto it = this->physEntityById.find(_id);
       if (it != this->physEntityById.end())
       {
@@ -209,6 +265,14 @@ namespace systems::physics_system
     /// kNullEntity
     public: Entity GetByPhysicsId(std::size_t _id) const
     {
+      if (this->IsDense(_id))
+      {
+        auto entry = this->FindDenseByPhysicsId(_id);
+        if (nullptr != entry)
+          return entry->entity;
+        return kNullEntity;
+      }
+
       auto it = this->entityByPhysId.find(_id);
       if (it != this->entityByPhysId.end())
       {
@@ -224,6 +288,8 @@ namespace systems::physics_system
     /// Gazebo entity
     public: bool HasEntity(const Entity &_entity) const
     {
+      if (this->IsDense(_entity))
+        return nullptr != this->FindDense(_entity);
       return this->entityMap.find(_entity) != this->entityMap.end();
     }
 
@@ -234,6 +300,12 @@ namespace systems::physics_system
     /// physics entity
     public: bool HasEntity(const RequiredEntityPtr &_physicsEntity) const
     {
+      if (nullptr != _physicsEntity &&
+          this->IsDense(_physicsEntity->EntityID()))
+      {
+        return nullptr !=
+            this->FindDenseByPhysicsId(_physicsEntity->EntityID());
+      }
       return this->reverseMap.find(_physicsEntity) != this->reverseMap.end();
     }
 
@@ -247,6 +319,20 @@ namespace systems::physics_system
       this->reverseMap[_physicsEntity] = _entity;
       this->physEntityById[_physicsEntity->EntityID()] = _physicsEntity;
       this->entityByPhysId[_physicsEntity->EntityID()] = _entity;
+
+      const std::size_t physicsId = _physicsEntity->EntityID();
+      if (this->IsDense(_entity) || this->IsDense(physicsId))
+      {
+        this->RemoveDense(_entity, physicsId);
+
+        DenseEntry entry;
+        entry.entity = _entity;
+        entry.physicsId = physicsId;
+        std::get<0>(entry.value) = _physicsEntity;
+        this->denseEntries.push_back(std::move(entry));
+        this->SetDenseSlots(this->denseEntries.back(),
+            static_cast<uint32_t>(this->denseEntries.size()));
+      }
     }
 
     /// \brief Remove entity from all associated maps
@@ -261,6 +347,7 @@ namespace systems::physics_system
         this->physEntityById.erase(it->second->EntityID());
         this->entityByPhysId.erase(it->second->EntityID());
         this->castCache.erase(_entity);
+        this->RemoveDense(_entity, it->second->EntityID());
         this->entityMap.erase(it);
         return true;
       }
@@ -279,6 +366,7 @@ namespace systems::physics_system
         this->physEntityById.erase(it->first->EntityID());
         this->entityByPhysId.erase(it->first->EntityID());
         this->castCache.erase(it->second);
+        this->RemoveDense(it->second, it->first->EntityID());
         this->reverseMap.erase(it);
         return true;
       }
@@ -294,7 +382,7 @@ namespace systems::physics_system
     }
 
     /// \brief Get the total number of entries in the maps. Only used for
-    /// testing.
+    /// testing. Casts of entities in the dense storage aren't counted.
     /// \return Number of entries in all the maps.
     public: std::size_t TotalMapEntryCount() const
     {
@@ -303,6 +391,119 @@ namespace systems::physics_system
              this->entityByPhysId.size();
     }
 
+    /// \brief Entry of the dense storage.
+    private: struct DenseEntry
+    {
+      /// \brief Gazebo entity.
+      Entity entity{kNullEntity};
+
+      /// \brief ID of the physics entity.
+      std::size_t physicsId{0u};
+
+      /// \brief Physics entity with required features, followed by the
+      /// entities cast to the optional features so far.
+      ValueType value;
+    };
+
+    /// \brief Check whether an ID is looked up through the dense indices.
+    /// \param[in] _id Gazebo entity or physics entity ID.
+    /// \return True if the map is dense and the ID is small enough.
+    private: bool IsDense(std::size_t _id) const
+    {
+      return this->dense && _id <= kMaxDenseId;
+    }
+
+    /// \brief Get the dense entry of a Gazebo entity.
+    /// \param[in] _entity Gazebo entity.
+    /// \return The entry, or nullptr if the entity isn't in the map.
+    private: DenseEntry *FindDense(const Entity _entity) const
+    {
+      return this->FindDenseSlot(this->denseIndex, _entity);
+    }
+
+    /// \brief Get the dense entry of a physics entity.
+    /// \param[in] _id Physics entity ID.
+    /// \return The entry, or nullptr if the entity isn't in the map.
+    private: DenseEntry *FindDenseByPhysicsId(std::size_t _id) const
+    {
+      return this->FindDenseSlot(this->densePhysicsIndex, _id);
+    }
+
+    /// \brief Get the dense entry referenced by an index.
+    /// \param[in] _index Dense index.
+    /// \param[in] _id ID to look up in the index.
+    /// \return The entry, or nullptr if the ID isn't in the index.
+    private: DenseEntry *FindDenseSlot(const std::vector<uint32_t> &_index,
+                 std::size_t _id) const
+    {
+      if (_id >= _index.size() || 0u == _index[_id])
+        return nullptr;
+      return &this->denseEntries[_index[_id] - 1u];
+    }
+
+    /// \brief Point the dense indices at an entry. Only the IDs which are
+    /// small enough are indexed, the others are looked up in the hash maps.
+    /// \param[in] _entry Entry to index.
+    /// \param[in] _slot One plus the position of the entry, or zero to clear.
+    private: void SetDenseSlots(const DenseEntry &_entry, uint32_t _slot)
+    {
+      auto setSlot = [&](std::vector<uint32_t> &_index, std::size_t _id)
+      {
+        if (!this->IsDense(_id))
+          return;
+        if (_id >= _index.size())
+        {
+          if (0u == _slot)
+            return;
+          _index.resize(_id + 1u, 0u);
+        }
+        _index[_id] = _slot;
+      };
+      setSlot(this->denseIndex, _entry.entity);
+      setSlot(this->densePhysicsIndex, _entry.physicsId);
+    }
+
+    /// \brief Remove the dense entry of an entity, if any. The last entry is
+    /// moved into the freed position to keep the entries packed.
+    /// \param[in] _entity Gazebo entity.
+    /// \param[in] _physicsId ID of the physics entity, used if the Gazebo
+    /// entity isn't indexed.
+    private: void RemoveDense(const Entity _entity, std::size_t _physicsId)
+    {
+      DenseEntry *entry{nullptr};
+      if (this->IsDense(_entity))
+        entry = this->FindDense(_entity);
+      else if (this->IsDense(_physicsId))
+        entry = this->FindDenseByPhysicsId(_physicsId);
+      if (nullptr == entry)
+        return;
+
+      this->SetDenseSlots(*entry, 0u);
+
+      auto &last = this->denseEntries.back();
+      if (entry != &last)
+      {
+        *entry = std::move(last);
+        this->SetDenseSlots(*entry,
+            static_cast<uint32_t>(entry - this->denseEntries.data() + 1));
+      }
+      this->denseEntries.pop_back();
+    }
+
+    /// \brief Whether lookups go through the dense indices.
+    private: bool dense{false};
+
+    /// \brief Entries of the dense storage, packed.
+    private: mutable std::vector<DenseEntry> denseEntries;
+
+    /// \brief One plus the position in denseEntries of each Gazebo entity,
+    /// or zero if the entity isn't in the map.
+    private: std::vector<uint32_t> denseIndex;
+
+    /// \brief One plus the position in denseEntries of each physics entity
+    /// ID, or zero if the entity isn't in the map.
+    private: std::vector<uint32_t> densePhysicsIndex;
+
     /// \brief Map from Gazebo entity to physics entities with required features
     private: std::unordered_map<Entity, RequiredEntityPtr> entityMap;
 
@@ -19,6 +19,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <ignition/physics/BoxShape.hh>
 #include <ignition/physics/CylinderShape.hh>
 #include <ignition/physics/ConstructEmpty.hh>
@@ -183,3 +186,84 @@ TEST_F(EntityFeatureMapFixture,
       testWorld2->EntityID()));
   EXPECT_EQ(0u, testMap.TotalMapEntryCount());
 }
+
+/////////////////////////////////////////////////
+TEST_F(EntityFeatureMapFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(DenseStorage))
+{
+  struct TestOptionalFeatures1
+      : physics::FeatureList<physics::LinkFrameSemantics>
+  {
+  };
+  using TestOptionalFeatures2 = physics::FeatureList<physics::RemoveEntities>;
+
+  using WorldEntityMap =
+      EntityFeatureMap3d<physics::World, MinimumFeatureList,
+                         TestOptionalFeatures1, TestOptionalFeatures2>;
+
+  using WorldPtrType = physics::EntityPtr<
+      physics::World<physics::FeaturePolicy3d, MinimumFeatureList>>;
+
+  // The last entity is too large for the dense indices, so it goes through
+  // the hash maps
+  const std::vector<gazebo::Entity> gazeboEntities{
+      123, 456, 789, WorldEntityMap::kMaxDenseId + 1};
+  std::vector<WorldPtrType> worlds;
+  WorldEntityMap testMap(true);
+  for (std::size_t i = 0; i < gazeboEntities.size(); ++i)
+  {
+    worlds.push_back(this->engine->ConstructEmptyWorld(
+        "world" + std::to_string(i)));
+    EXPECT_FALSE(testMap.HasEntity(gazeboEntities[i]));
+    EXPECT_FALSE(testMap.HasEntity(worlds.back()));
+    testMap.AddEntity(gazeboEntities[i], worlds.back());
+  }
+
+  for (std::size_t i = 0; i < gazeboEntities.size(); ++i)
+  {
+    EXPECT_TRUE(testMap.HasEntity(gazeboEntities[i]));
+    EXPECT_TRUE(testMap.HasEntity(worlds[i]));
+    EXPECT_EQ(worlds[i], testMap.Get(gazeboEntities[i]));
+    EXPECT_EQ(gazeboEntities[i], testMap.Get(worlds[i]));
+    EXPECT_EQ(gazeboEntities[i],
+        testMap.GetByPhysicsId(worlds[i]->EntityID()));
+    EXPECT_EQ(worlds[i], testMap.GetPhysicsEntityPtr(worlds[i]->EntityID()));
+
+    // Casts are cached and return the same entity
+    auto feature1 =
+        testMap.EntityCast<TestOptionalFeatures1>(gazeboEntities[i]);
+    ASSERT_NE(nullptr, feature1);
+    EXPECT_EQ(feature1,
+        testMap.EntityCast<TestOptionalFeatures1>(gazeboEntities[i]));
+    EXPECT_NE(nullptr, testMap.EntityCast<TestOptionalFeatures2>(worlds[i]));
+  }
+  EXPECT_EQ(nullptr, testMap.Get(gazebo::Entity(124)));
+  EXPECT_EQ(nullptr,
+      testMap.EntityCast<TestOptionalFeatures1>(gazebo::Entity(124)));
+
+  // Removing the first entity moves another one into its place, which must
+  // still be found
+  EXPECT_TRUE(testMap.Remove(gazeboEntities[0]));
+  EXPECT_FALSE(testMap.Remove(gazeboEntities[0]));
+  EXPECT_FALSE(testMap.HasEntity(gazeboEntities[0]));
+  EXPECT_EQ(nullptr, testMap.Get(gazeboEntities[0]));
+  EXPECT_EQ(gazebo::kNullEntity, testMap.Get(worlds[0]));
+  EXPECT_EQ(gazebo::kNullEntity,
+      testMap.GetByPhysicsId(worlds[0]->EntityID()));
+  for (std::size_t i = 1; i < gazeboEntities.size(); ++i)
+  {
+    EXPECT_EQ(worlds[i], testMap.Get(gazeboEntities[i]));
+    EXPECT_EQ(gazeboEntities[i], testMap.Get(worlds[i]));
+    EXPECT_NE(nullptr,
+        testMap.EntityCast<TestOptionalFeatures1>(gazeboEntities[i]));
+  }
+
+  // Remove by physics entity
+  for (std::size_t i = 1; i < gazeboEntities.size(); ++i)
+  {
+    EXPECT_TRUE(testMap.Remove(worlds[i]));
+    EXPECT_FALSE(testMap.HasEntity(gazeboEntities[i]));
+    EXPECT_FALSE(testMap.HasEntity(worlds[i]));
+  }
+  EXPECT_EQ(0u, testMap.TotalMapEntryCount());
+}
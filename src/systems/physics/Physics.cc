@@ -23,19 +23,25 @@
 #include <ignition/msgs/Utility.hh>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
-#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <ignition/common/HeightmapData.hh>
 #include <ignition/common/ImageHeightmap.hh>
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
 #include <ignition/common/Profiler.hh>
+#include <ignition/common/SubMesh.hh>
 #include <ignition/common/SystemPaths.hh>
 #include <ignition/common/Uuid.hh>
 #include <ignition/math/AxisAlignedBox.hh>
@@ -86,7 +92,9 @@
 #include <sdf/World.hh>
 
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/MeshCache.hh"
 #include "ignition/gazebo/Model.hh"
+#include "ignition/gazebo/StartupTrace.hh"
 #include "ignition/gazebo/Util.hh"
 
 // Components
@@ -99,6 +107,7 @@
 #include "ignition/gazebo/components/ChildLinkName.hh"
 #include "ignition/gazebo/components/Collision.hh"
 #include "ignition/gazebo/components/ContactSensorData.hh"
+#include "ignition/gazebo/components/Dormant.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Gravity.hh"
 #include "ignition/gazebo/components/Inertial.hh"
@@ -149,6 +158,9 @@ using namespace ignition::gazebo::systems;
 using namespace ignition::gazebo::systems::physics_system;
 namespace components = ignition::gazebo::components;
 
+/// \brief Minimum number of entities written back to the ECM by each worker
+/// after a step. Splitting smaller loops costs more than it saves.
+static constexpr std::size_t kMinWriteBackChunk{32u};
 
 // Private data class.
 class ignition::gazebo::systems::PhysicsPrivate
@@ -217,6 +229,35 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \param[in] _ecm Constant reference to ECM.
   public: void CreateBatteryEntities(const EntityComponentManager &_ecm);
 
+  /// \brief Attach or detach the detachable joints whose
+  /// `DetachableJointEnabled` component changed, keeping their entities.
+  /// \param[in] _ecm Constant reference to ECM.
+  public: void UpdateDetachableJoints(const EntityComponentManager &_ecm);
+
+  /// \brief Create the physics constraint of a detachable joint.
+  /// \param[in] _entity Detachable joint entity.
+  /// \param[in] _info Links connected by the joint.
+  /// \param[in] _ecm Constant reference to ECM.
+  /// \return False if the physics engine doesn't support detachable joints,
+  /// in which case there's no point in attaching other joints.
+  public: bool AttachDetachableJoint(const Entity &_entity,
+              const components::DetachableJointInfo &_info,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Remove the physics constraint of a detachable joint.
+  /// \param[in] _entity Detachable joint entity.
+  /// \return False if the physics engine doesn't support detaching joints,
+  /// in which case there's no point in detaching other joints.
+  public: bool DetachDetachableJoint(const Entity &_entity);
+
+  /// \brief Change tick up to which changes of `DetachableJointEnabled`
+  /// components have been processed.
+  public: uint64_t detachableJointTick{0u};
+
+  /// \brief Change tick up to which changes of `SlipComplianceCmd`
+  /// components have been applied.
+  public: uint64_t slipComplianceTick{0u};
+
   /// \brief Remove physics entities if they are removed from the ECM
   /// \param[in] _ecm Constant reference to ECM.
   public: void RemovePhysicsEntities(const EntityComponentManager &_ecm);
@@ -225,12 +266,35 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \param[in] _ecm Mutable reference to ECM.
   public: void UpdatePhysics(EntityComponentManager &_ecm);
 
-  /// \brief Step the simulation for each world
+  /// \brief Hold the dormant models which should be frozen in place, and
+  /// restore the velocities of the ones which woke up, see
+  /// components::Dormant.
+  /// \param[in] _ecm Mutable reference to ECM.
+  public: void UpdateFrozenModels(EntityComponentManager &_ecm);
+
+  /// \brief Bring the physics engine in line with components restored from
+  /// a checkpoint. Model poses and joint states are applied through
+  /// commands on the next update, and free bodies are stopped.
+  /// \param[in] _ecm Mutable reference to ECM.
+  public: void ResetPhysics(EntityComponentManager &_ecm);
+
+  /// \brief Step the simulation for each world. The duration is split in
+  /// `substeps` engine steps.
   /// \param[in] _dt Duration
+  /// \param[in] _ecm Constant reference to ECM.
   /// \returns Output data from the physics engine (this currently contains
-  /// data for links that experienced a pose change in the physics step)
+  /// data for links that experienced a pose change in any of the substeps)
   public: ignition::physics::ForwardStep::Output Step(
-              const std::chrono::steady_clock::duration &_dt);
+              const std::chrono::steady_clock::duration &_dt,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Apply again the commands which the engine clears after each
+  /// step, i.e. joint forces, joint velocity commands and link wrenches, so
+  /// that they're held constant across substeps. The joints of models which
+  /// are out of battery or halted are zeroed again. Resets and limits aren't
+  /// applied again.
+  /// \param[in] _ecm Constant reference to ECM.
+  public: void ApplyHeldCommands(const EntityComponentManager &_ecm);
 
   /// \brief Get data of links that were updated in the latest physics step.
   /// \param[in] _ecm Mutable reference to ECM.
@@ -281,12 +345,25 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \param[in] _ecm Mutable reference to ECM.
   public: void UpdateCollisions(EntityComponentManager &_ecm);
 
-  /// \brief FrameData relative to world at a given offset pose
-  /// \param[in] _link ign-physics link
+  /// \brief FrameData relative to world at a given offset pose from a link.
+  /// This is pure math, so unlike querying the physics engine, it's safe to
+  /// call concurrently.
+  /// \param[in] _link Frame data of the link relative to world
   /// \param[in] _pose Offset pose in which to compute the frame data
   /// \returns FrameData at the given offset pose
-  public: physics::FrameData3d LinkFrameDataAtOffset(
-      const LinkPtrType &_link, const math::Pose3d &_pose) const;
+  public: static physics::FrameData3d LinkFrameDataAtOffset(
+      const physics::FrameData3d &_link, const math::Pose3d &_pose);
+
+  /// \brief Read back the frame data relative to world of the links which
+  /// are the parent of an entity with both a Pose and a ComponentT
+  /// component, such as a sensor or a collision. Links already in _data
+  /// aren't read again.
+  /// \param[in] _ecm The entity component manager.
+  /// \param[in,out] _data Frame data of each parent link.
+  /// \tparam ComponentT Component to be populated on the child entities.
+  public: template <typename ComponentT>
+          void AddParentLinkFrameData(const EntityComponentManager &_ecm,
+              std::unordered_map<Entity, physics::FrameData3d> &_data);
 
   /// \brief Get transform from one ancestor entity to a descendant entity
   /// that are in the same model.
@@ -296,6 +373,25 @@ class ignition::gazebo::systems::PhysicsPrivate
   public: ignition::math::Pose3d RelativePose(const Entity &_from,
       const Entity &_to, const EntityComponentManager &_ecm) const;
 
+  /// \brief Get the mesh to attach for a mesh collision. Meshes are loaded
+  /// once and shared by all the collisions which use them, which matters
+  /// for worlds with many copies of the same model.
+  /// \param[in] _meshSdf Mesh geometry of the collision.
+  /// \return The mesh, or nullptr if it couldn't be loaded.
+  public: const common::Mesh *CollisionMesh(const sdf::Mesh &_meshSdf);
+
+  /// \brief Key of a collision mesh: full path, submesh name and whether
+  /// the submesh is centered. The scale isn't part of the key, because it's
+  /// applied by the engine when attaching the mesh.
+  public: using CollisionMeshKey = std::tuple<std::string, std::string, bool>;
+
+  /// \brief Meshes used by collisions so far.
+  public: std::map<CollisionMeshKey, const common::Mesh *> collisionMeshes;
+
+  /// \brief Meshes holding a single submesh of a mesh loaded through the
+  /// mesh manager, owned by the system.
+  public: std::vector<std::unique_ptr<common::Mesh>> collisionSubmeshes;
+
   /// \brief Enable contact surface customization for the given world.
   /// \param[in] _world The world to enable it for.
   public: void EnableContactSurfaceCustomization(const Entity &_world);
@@ -308,13 +404,105 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// The key is an entity and the value is its top level model.
   public: std::unordered_map<Entity, Entity> topLevelModelMap;
 
+  /// \brief Append the entities which have a component of a given type,
+  /// skipping the query if no entity has one.
+  /// \param[in] _ecm The entity component manager.
+  /// \param[in,out] _entities Entities to append to.
+  /// \tparam ComponentT Component type, such as a command.
+  public: template <typename ComponentT>
+          static void AddEntitiesWith(const EntityComponentManager &_ecm,
+              std::vector<Entity> &_entities)
+  {
+    if (0u == _ecm.ComponentCount(ComponentT::typeId))
+      return;
+
+    _ecm.Each<ComponentT>(
+        [&](const Entity &_entity, const ComponentT *) -> bool
+        {
+          _entities.push_back(_entity);
+          return true;
+        });
+  }
+
   /// \brief Keep track of what entities are static (models and links).
   public: std::unordered_set<Entity> staticEntities;
 
-  /// \brief Keep track of poses for links attached to non-static models.
-  /// This allows for skipping pose updates if a link's pose didn't change
-  /// after a physics step.
-  public: std::unordered_map<Entity, ignition::math::Pose3d> linkWorldPoses;
+  /// \brief Frame data read back from physics for a link attached to a
+  /// non-static model.
+  public: struct LinkReadback
+  {
+    /// \brief Link entity.
+    Entity entity{kNullEntity};
+
+    /// \brief Physics link.
+    LinkPtrType link;
+
+    /// \brief Frame data read during the step given by `step`.
+    physics::FrameData3d frameData;
+
+    /// \brief Readback step at which frameData was read, zero if never.
+    uint64_t step{0u};
+
+    /// \brief Last world pose written to the ECM. Allows for skipping pose
+    /// updates if a link's pose didn't change after a physics step.
+    std::optional<math::Pose3d> worldPose;
+  };
+
+  /// \brief Rebuild linkReadbacks if links were added or removed since the
+  /// last call. Poses of links which were already tracked are kept.
+  /// \param[in] _ecm The entity component manager.
+  public: void UpdateLinkReadbacks(const EntityComponentManager &_ecm);
+
+  /// \brief Links attached to non-static models, packed so that reading
+  /// them back after a step doesn't go through the ECM or entity maps.
+  public: std::vector<LinkReadback> linkReadbacks;
+
+  /// \brief Index of each link in linkReadbacks.
+  public: std::unordered_map<Entity, std::size_t> linkReadbackIndices;
+
+  /// \brief Whether linkReadbacks must be rebuilt.
+  public: bool linkReadbacksDirty{true};
+
+  /// \brief Incremented each time links are read back from physics.
+  public: uint64_t readbackStep{0u};
+
+  /// \brief Components written back to the ECM for a link after a step,
+  /// one bit per component type. Recorded by the workers so that the
+  /// changes can be marked on the ECM from a single thread.
+  public: struct LinkWriteBack
+  {
+    /// \brief Record that a component was written.
+    /// \param[in] _type Index of the component type.
+    /// \param[in] _changed Whether the component's value changed.
+    void Set(std::size_t _type, bool _changed)
+    {
+      this->written |= static_cast<uint16_t>(1u << _type);
+      if (_changed)
+        this->changed |= static_cast<uint16_t>(1u << _type);
+    }
+
+    /// \brief Whether a component was written.
+    /// \param[in] _type Index of the component type.
+    /// \return True if written.
+    bool Written(std::size_t _type) const
+    {
+      return (this->written >> _type) & 1u;
+    }
+
+    /// \brief Whether a component's value changed.
+    /// \param[in] _type Index of the component type.
+    /// \return True if changed.
+    bool Changed(std::size_t _type) const
+    {
+      return (this->changed >> _type) & 1u;
+    }
+
+    /// \brief Bits of the components that were written.
+    uint16_t written{0u};
+
+    /// \brief Bits of the components whose value changed.
+    uint16_t changed{0u};
+  };
 
   /// \brief Keep a mapping of canonical links to models that have this
   /// canonical link. Useful for updating model poses efficiently after a
@@ -326,10 +514,74 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// most recent model world pose change that took place.
   public: std::unordered_map<Entity, math::Pose3d> modelWorldPoses;
 
+  /// \brief What's needed to update the pose of a model from its canonical
+  /// link, gathered the first time the model moves so that later steps
+  /// don't walk the entity tree.
+  public: struct ModelPoseUpdate
+  {
+    /// \brief Parent of the model, which is a model if it's nested.
+    Entity parent{kNullEntity};
+
+    /// \brief Whether the canonical link is rigidly attached to the model
+    /// frame, which is the case if all the models between them share the
+    /// same canonical link.
+    bool fixedOffset{false};
+
+    /// \brief Pose of the model w.r.t. its canonical link (X_ML^-1). Only
+    /// valid if fixedOffset is true.
+    math::Pose3d modelFromLink;
+
+    /// \brief Links of the model.
+    std::vector<Entity> links;
+
+    /// \brief Canonical links of the nested models, apart from the
+    /// model's own canonical link.
+    std::vector<Entity> nestedCanonicalLinks;
+  };
+
+  /// \brief Get the data for updating the pose of a model, gathering it if
+  /// it isn't cached yet.
+  /// \param[in] _model The model.
+  /// \param[in] _canonicalLink The canonical link of _model.
+  /// \param[in] _ecm The entity component manager.
+  /// \return Data for updating the pose of the model.
+  public: const ModelPoseUpdate &ModelPoseUpdateData(const Entity _model,
+              const Entity _canonicalLink,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Cached ModelPoseUpdate of each model that moved. Cleared when
+  /// entities are created or models removed, since that may change the
+  /// links and nested models of cached models.
+  public: std::unordered_map<Entity, ModelPoseUpdate> modelPoseUpdates;
+
   /// \brief A map between model entity ids in the ECM to whether its battery
   /// has drained.
   public: std::unordered_map<Entity, bool> entityOffMap;
 
+  /// \brief State of a model which is frozen while dormant.
+  public: struct FrozenModel
+  {
+    /// \brief World pose of the model when it was frozen.
+    math::Pose3d pose;
+
+    /// \brief Pose of the root link of its free group, relative to the
+    /// model, if it has one.
+    std::optional<math::Pose3d> rootLinkPose;
+
+    /// \brief World linear velocity of the root link when it was frozen.
+    math::Vector3d linearVelocity;
+
+    /// \brief World angular velocity of the root link when it was frozen.
+    math::Vector3d angularVelocity;
+
+    /// \brief Velocities of the model's joints when it was frozen.
+    std::vector<std::pair<Entity, std::vector<double>>> jointVelocities;
+  };
+
+  /// \brief Top level models which are frozen while dormant. Their joints
+  /// are halted as with components::HaltMotion.
+  public: std::unordered_map<Entity, FrozenModel> frozenModels;
+
   /// \brief Entities whose pose commands have been processed and should be
   /// deleted the following iteration.
   public: std::unordered_set<Entity> worldPoseCmdsToRemove;
@@ -611,7 +863,7 @@ class ignition::gazebo::systems::PhysicsPrivate
 
   /// \brief A map between model entity ids in the ECM to Model Entities in
   /// ign-physics.
-  public: ModelEntityMap entityModelMap;
+  public: ModelEntityMap entityModelMap{true};
 
   /// \brief Link EntityFeatureMap
   public: using EntityLinkMap = EntityFeatureMap3d<
@@ -625,7 +877,7 @@ class ignition::gazebo::systems::PhysicsPrivate
 
   /// \brief A map between link entity ids in the ECM to Link Entities in
   /// ign-physics.
-  public: EntityLinkMap entityLinkMap;
+  public: EntityLinkMap entityLinkMap{true};
 
   /// \brief Joint EntityFeatureMap
   public: using EntityJointMap = EntityFeatureMap3d<
@@ -641,7 +893,46 @@ class ignition::gazebo::systems::PhysicsPrivate
 
   /// \brief A map between joint entity ids in the ECM to Joint Entities in
   /// ign-physics
-  public: EntityJointMap entityJointMap;
+  public: EntityJointMap entityJointMap{true};
+
+  /// \brief State components of a joint which are filled from physics after
+  /// each step.
+  public: struct JointReadback
+  {
+    /// \brief Joint entity.
+    Entity entity{kNullEntity};
+
+    /// \brief Physics joint.
+    EntityJointMap::RequiredEntityPtr joint;
+
+    /// \brief Position component, or nullptr if the joint has none.
+    components::JointPosition *position{nullptr};
+
+    /// \brief Velocity component, or nullptr if the joint has none.
+    components::JointVelocity *velocity{nullptr};
+  };
+
+  /// \brief Rebuild jointReadbacks if joints were added to or removed from
+  /// physics, or if joint state components were created or removed, since
+  /// the last call.
+  /// \param[in] _ecm The entity component manager.
+  public: void UpdateJointReadbacks(EntityComponentManager &_ecm);
+
+  /// \brief Joints which have position or velocity components, packed so
+  /// that reading them back after a step doesn't go through the ECM or
+  /// entity maps. Joints without state components aren't read.
+  public: std::vector<JointReadback> jointReadbacks;
+
+  /// \brief Whether jointReadbacks must be rebuilt because joints were
+  /// added to or removed from physics.
+  public: bool jointReadbacksDirty{true};
+
+  /// \brief Generations of the JointPosition and JointVelocity component
+  /// types when jointReadbacks was built.
+  public: uint64_t jointPositionGeneration{0u};
+
+  /// \brief See jointPositionGeneration.
+  public: uint64_t jointVelocityGeneration{0u};
 
   /// \brief Collision EntityFeatureMap
   public: using EntityCollisionMap = EntityFeatureMap3d<
@@ -654,7 +945,7 @@ class ignition::gazebo::systems::PhysicsPrivate
 
   /// \brief A map between collision entity ids in the ECM to Shape Entities in
   /// ign-physics.
-  public: EntityCollisionMap entityCollisionMap;
+  public: EntityCollisionMap entityCollisionMap{true};
 
   /// \brief FreeGroup EntityFeatureMap
   public: using EntityFreeGroupMap = EntityFeatureMap3d<
@@ -665,17 +956,40 @@ class ignition::gazebo::systems::PhysicsPrivate
 
   /// \brief A map between collision entity ids in the ECM to FreeGroup Entities
   /// in ign-physics.
-  public: EntityFreeGroupMap entityFreeGroupMap;
+  public: EntityFreeGroupMap entityFreeGroupMap{true};
 
   /// \brief Event manager from simulation runner.
   public: EventManager *eventManager = nullptr;
 
+  /// \brief Channel of the CollectContactSurfaceProperties event, resolved
+  /// once since it's emitted for every contact.
+  public: EventManager::EventChannel<events::CollectContactSurfaceProperties>
+    collectContactSurfaceChannel;
+
   /// \brief Keep track of what entities use customized contact surfaces.
   /// Map keys are expected to be world entities so that we keep a set of
   /// entities with customizations per world.
   public: std::unordered_map<Entity, std::unordered_set<Entity>>
     customContactSurfaceEntities;
 
+  /// \brief Contact surface handlers registered through
+  /// events::AddContactSurfaceHandler, keyed by collision entity and then by
+  /// handler id. Contacts of these collisions only go to their handlers.
+  public: std::unordered_map<Entity,
+    std::map<std::string, events::ContactSurfaceHandler>>
+    contactSurfaceHandlers;
+
+  /// \brief Protects contactSurfaceHandlers from registrations made by
+  /// systems running concurrently. The contact callback doesn't lock it,
+  /// since handlers are registered outside the Update phase.
+  public: std::mutex contactSurfaceHandlersMutex;
+
+  /// \brief Connection to events::AddContactSurfaceHandler.
+  public: common::ConnectionPtr addContactSurfaceHandlerConn;
+
+  /// \brief Connection to events::RemoveContactSurfaceHandler.
+  public: common::ConnectionPtr removeContactSurfaceHandlerConn;
+
   /// \brief Set of links that were added to an existing model. This set
   /// is used to track links that were added to an existing model, such as
   /// through the GUI model editor, so that we can avoid premature creation
@@ -692,6 +1006,47 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// \brief Flag to store whether the names of colliding entities should
   /// be populated in the contact points.
   public: bool contactsEntityNames = true;
+
+  /// \brief Number of engine steps taken on each update. Systems only see
+  /// the state at the end of the last one.
+  public: std::size_t substeps{1u};
+
+  /// \brief A contact point involving a collision which has a
+  /// ContactSensorData component.
+  public: struct SensorContact
+  {
+    /// \brief Collision with the ContactSensorData component.
+    Entity sensorCollision{kNullEntity};
+
+    /// \brief The other collision in contact.
+    Entity otherCollision{kNullEntity};
+
+    /// \brief Contact point, owned by the contacts of the current step.
+    const WorldShapeType::ContactPoint *point{nullptr};
+  };
+
+  /// \brief Collisions with a ContactSensorData component, gathered on each
+  /// step. Contacts which don't involve any of them aren't converted.
+  public: std::unordered_set<Entity> contactSensorCollisions;
+
+  /// \brief Contacts of the current step involving contactSensorCollisions,
+  /// sorted by collision. Kept across steps to reuse its memory.
+  public: std::vector<SensorContact> sensorContacts;
+
+  /// \brief Message buffer used to fill ContactSensorData components, kept
+  /// across steps so that its contacts can be reused.
+  public: msgs::Contacts contactsBuffer;
+
+  /// \brief Get the name of a collision as it's set in contact messages.
+  /// The name is computed the first time it's needed and then cached.
+  /// \param[in] _collision Collision entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return Scoped name of the collision, without the world.
+  public: const std::string &ContactCollisionName(const Entity _collision,
+              const EntityComponentManager &_ecm);
+
+  /// \brief Names of collisions in contact messages, keyed by collision.
+  public: std::unordered_map<Entity, std::string> contactCollisionNames;
 };
 
 //////////////////////////////////////////////////
@@ -705,6 +1060,7 @@ void Physics::Configure(const Entity &_entity,
     EntityComponentManager &_ecm,
     EventManager &_eventMgr)
 {
+  StartupTrace::Scope scope("physics_configure");
   std::string pluginLib;
 
   // 1. Engine from component (from command line / ServerConfig)
@@ -746,6 +1102,21 @@ void Physics::Configure(const Entity &_entity,
       "include_entity_names", true).first;
   }
 
+  // Number of physics steps per iteration
+  if (_sdf->HasElement("substeps"))
+  {
+    const int substeps = _sdf->Get<int>("substeps");
+    if (substeps < 1)
+    {
+      ignerr << "Invalid <substeps> [" << substeps
+             << "], it must be at least 1. Using 1." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->substeps = static_cast<std::size_t>(substeps);
+    }
+  }
+
   // Find engine shared library
   // Look in:
   // * Paths from environment variable
@@ -828,6 +1199,32 @@ void Physics::Configure(const Entity &_entity,
   }
 
   this->dataPtr->eventManager = &_eventMgr;
+  this->dataPtr->collectContactSurfaceChannel =
+    _eventMgr.Channel<events::CollectContactSurfaceProperties>();
+
+  this->dataPtr->addContactSurfaceHandlerConn =
+    _eventMgr.Connect<events::AddContactSurfaceHandler>(
+      [this](const Entity &_collision, const std::string &_id,
+             events::ContactSurfaceHandler _handler)
+      {
+        std::lock_guard<std::mutex> lock(
+            this->dataPtr->contactSurfaceHandlersMutex);
+        this->dataPtr->contactSurfaceHandlers[_collision][_id] =
+            std::move(_handler);
+      });
+  this->dataPtr->removeContactSurfaceHandlerConn =
+    _eventMgr.Connect<events::RemoveContactSurfaceHandler>(
+      [this](const Entity &_collision, const std::string &_id)
+      {
+        std::lock_guard<std::mutex> lock(
+            this->dataPtr->contactSurfaceHandlersMutex);
+        auto it = this->dataPtr->contactSurfaceHandlers.find(_collision);
+        if (it == this->dataPtr->contactSurfaceHandlers.end())
+          return;
+        it->second.erase(_id);
+        if (it->second.empty())
+          this->dataPtr->contactSurfaceHandlers.erase(it);
+      });
 }
 
 //////////////////////////////////////////////////
@@ -837,6 +1234,7 @@ Physics::~Physics() = default;
 void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
 {
   IGN_PROFILE("Physics::Update");
+  StartupTrace::Scope scope("physics_update");
 
   // \TODO(anyone) Support rewind
   if (_info.dt < std::chrono::steady_clock::duration::zero())
@@ -849,12 +1247,13 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   if (this->dataPtr->engine)
   {
     this->dataPtr->CreatePhysicsEntities(_ecm);
+    this->dataPtr->UpdateDetachableJoints(_ecm);
     this->dataPtr->UpdatePhysics(_ecm);
     ignition::physics::ForwardStep::Output stepOutput;
     // Only step if not paused.
     if (!_info.paused)
     {
-      stepOutput = this->dataPtr->Step(_info.dt);
+      stepOutput = this->dataPtr->Step(_info.dt, _ecm);
     }
     auto changedLinks = this->dataPtr->ChangedLinks(_ecm, stepOutput);
     this->dataPtr->UpdateSim(_ecm, changedLinks);
@@ -866,6 +1265,87 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   }
 }
 
+//////////////////////////////////////////////////
+void Physics::Reset(const UpdateInfo &, EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("Physics::Reset");
+  if (this->dataPtr->engine)
+    this->dataPtr->ResetPhysics(_ecm);
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::ResetPhysics(EntityComponentManager &_ecm)
+{
+  // Top level models are moved, nested models and links follow them
+  std::vector<std::pair<Entity, math::Pose3d>> modelPoses;
+  for (const auto &[model, topLevel] : this->topLevelModelMap)
+  {
+    if (model != topLevel)
+      continue;
+
+    auto poseComp = _ecm.Component<components::Pose>(model);
+    if (nullptr == poseComp)
+      continue;
+    modelPoses.push_back({model, poseComp->Data()});
+
+    auto modelPtrPhys = this->entityModelMap.Get(model);
+    if (nullptr == modelPtrPhys)
+      continue;
+
+    auto freeGroup = modelPtrPhys->FindFreeGroup();
+    if (!freeGroup)
+      continue;
+    this->entityFreeGroupMap.AddEntity(model, freeGroup);
+
+    auto velFeature = this->entityFreeGroupMap
+        .EntityCast<WorldVelocityCommandFeatureList>(model);
+    if (velFeature)
+    {
+      velFeature->SetWorldLinearVelocity(
+          math::eigen3::convert(math::Vector3d::Zero));
+      velFeature->SetWorldAngularVelocity(
+          math::eigen3::convert(math::Vector3d::Zero));
+    }
+  }
+
+  for (const auto &[model, pose] : modelPoses)
+  {
+    _ecm.SetComponentData<components::WorldPoseCmd>(model, pose);
+  }
+
+  // Joints go back to their restored state, at rest if the velocity wasn't
+  // saved
+  std::vector<std::pair<Entity, std::vector<double>>> jointPositions;
+  _ecm.Each<components::Joint, components::JointPosition>(
+      [&](const Entity &_entity, const components::Joint *,
+          const components::JointPosition *_position) -> bool
+      {
+        jointPositions.push_back({_entity, _position->Data()});
+        return true;
+      });
+
+  for (auto &[joint, positions] : jointPositions)
+  {
+    // Joints whose state wasn't filled yet go back to zero
+    if (positions.empty())
+    {
+      auto jointPhys = this->entityJointMap.Get(joint);
+      if (!jointPhys)
+        continue;
+      positions.assign(jointPhys->GetDegreesOfFreedom(), 0.0);
+    }
+
+    std::vector<double> velocities(positions.size(), 0.0);
+    auto velComp = _ecm.Component<components::JointVelocity>(joint);
+    if (nullptr != velComp && velComp->Data().size() == positions.size())
+      velocities = velComp->Data();
+
+    _ecm.SetComponentData<components::JointPositionReset>(joint, positions);
+    _ecm.SetComponentData<components::JointVelocityReset>(joint,
+        velocities);
+  }
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
 {
@@ -873,6 +1353,7 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
   this->linkAddedToModel.clear();
   this->jointAddedToModel.clear();
 
+  StartupTrace::Scope scope("physics_entities");
   this->CreateWorldEntities(_ecm);
   this->CreateModelEntities(_ecm);
   this->CreateLinkEntities(_ecm);
@@ -977,6 +1458,8 @@ void PhysicsPrivate::CreateModelEntities(const EntityComponentManager &_ecm)
         if (_ecm.EntityHasComponentType(_entity, components::Recreate::typeId))
           return true;
 
+        StartupTrace::Scope scope("physics_model", _name->Data());
+
         // Check if model already exists
         if (this->entityModelMap.HasEntity(_entity))
         {
@@ -1161,6 +1644,7 @@ void PhysicsPrivate::CreateLinkEntities(const EntityComponentManager &_ecm)
 
         auto linkPtrPhys = modelPtrPhys->ConstructLink(link);
         this->entityLinkMap.AddEntity(_entity, linkPtrPhys);
+        this->linkReadbacksDirty = true;
         this->topLevelModelMap.insert(std::make_pair(_entity,
             topLevelModel(_entity, _ecm)));
 
@@ -1226,15 +1710,9 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
             return true;
           }
 
-          auto &meshManager = *ignition::common::MeshManager::Instance();
-          auto fullPath = asFullPath(meshSdf->Uri(), meshSdf->FilePath());
-          auto *mesh = meshManager.Load(fullPath);
+          auto *mesh = this->CollisionMesh(*meshSdf);
           if (nullptr == mesh)
-          {
-            ignwarn << "Failed to load mesh from [" << fullPath
-                    << "]." << std::endl;
             return true;
-          }
 
           auto linkMeshFeature =
               this->entityLinkMap.EntityCast<MeshFeatureList>(_parent->Data());
@@ -1416,6 +1894,50 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+const common::Mesh *PhysicsPrivate::CollisionMesh(const sdf::Mesh &_meshSdf)
+{
+  auto fullPath = asFullPath(_meshSdf.Uri(), _meshSdf.FilePath());
+  CollisionMeshKey key{fullPath, _meshSdf.Submesh(),
+      !_meshSdf.Submesh().empty() && _meshSdf.CenterSubmesh()};
+
+  auto it = this->collisionMeshes.find(key);
+  if (it != this->collisionMeshes.end())
+    return it->second;
+
+  auto *mesh = loadCachedMesh(fullPath);
+  if (nullptr == mesh)
+  {
+    ignwarn << "Failed to load mesh from [" << fullPath
+            << "]." << std::endl;
+    return nullptr;
+  }
+
+  if (!_meshSdf.Submesh().empty())
+  {
+    auto subMesh = mesh->SubMeshByName(_meshSdf.Submesh()).lock();
+    if (!subMesh)
+    {
+      ignwarn << "Failed to find submesh [" << _meshSdf.Submesh()
+              << "] in mesh [" << fullPath << "]." << std::endl;
+      return nullptr;
+    }
+
+    common::SubMesh subMeshCopy(*subMesh);
+    if (_meshSdf.CenterSubmesh())
+      subMeshCopy.Center(math::Vector3d::Zero);
+
+    auto newMesh = std::make_unique<common::Mesh>();
+    newMesh->SetName(fullPath + "::" + _meshSdf.Submesh());
+    newMesh->AddSubMesh(subMeshCopy);
+    mesh = newMesh.get();
+    this->collisionSubmeshes.push_back(std::move(newMesh));
+  }
+
+  this->collisionMeshes[key] = mesh;
+  return mesh;
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
 {
@@ -1509,6 +2031,8 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
           // Some joints may not be supported, so only add them to the map if
           // the physics entity is valid
           this->entityJointMap.AddEntity(_entity, jointPtrPhys);
+    this->jointReadbacksDirty = true;
+          this->jointReadbacksDirty = true;
           this->topLevelModelMap.insert(std::make_pair(_entity,
               topLevelModel(_entity, _ecm)));
         }
@@ -1520,87 +2044,13 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
       [&](const Entity &_entity,
           const components::DetachableJoint *_jointInfo) -> bool
       {
-        if (_jointInfo->Data().jointType != "fixed")
-        {
-          ignerr << "Detachable joint type [" << _jointInfo->Data().jointType
-                 << "] is currently not supported" << std::endl;
-          return true;
-        }
-        // Check if joint already exists
-        if (this->entityJointMap.HasEntity(_entity))
-        {
-          ignwarn << "Joint entity [" << _entity
-                  << "] marked as new, but it's already on the map."
-                  << std::endl;
-          return true;
-        }
-
-        // Check if the link entities exist in the physics engine
-        auto parentLinkPhys =
-            this->entityLinkMap.Get(_jointInfo->Data().parentLink);
-        if (!parentLinkPhys)
-        {
-          ignwarn << "DetachableJoint's parent link entity ["
-                  << _jointInfo->Data().parentLink << "] not found in link map."
-                  << std::endl;
-          return true;
-        }
-
-        auto childLinkEntity = _jointInfo->Data().childLink;
-
-        // Get child link
-        auto childLinkPhys = this->entityLinkMap.Get(childLinkEntity);
-        if (!childLinkPhys)
-        {
-          ignwarn << "Failed to find joint's child link [" << childLinkEntity
-                  << "]." << std::endl;
+        // Joints which start disabled are attached once they're enabled
+        auto enabled =
+            _ecm.Component<components::DetachableJointEnabled>(_entity);
+        if (enabled && !enabled->Data())
           return true;
-        }
-
-        auto childLinkDetachableJointFeature =
-            this->entityLinkMap.EntityCast<DetachableJointFeatureList>(
-                childLinkEntity);
-        if (!childLinkDetachableJointFeature)
-        {
-          static bool informed{false};
-          if (!informed)
-          {
-            igndbg << "Attempting to create a detachable joint, but the physics"
-                   << " engine doesn't support feature "
-                   << "[AttachFixedJointFeature]. Detachable joints will be "
-                   << "ignored." << std::endl;
-            informed = true;
-          }
-
-          // Break Each call since no DetachableJoints can be processed
-          return false;
-        }
-
-        const auto poseParent =
-            parentLinkPhys->FrameDataRelativeToWorld().pose;
-        const auto poseChild =
-            childLinkDetachableJointFeature->FrameDataRelativeToWorld().pose;
 
-        // Pose of child relative to parent
-        auto poseParentChild = poseParent.inverse() * poseChild;
-        auto jointPtrPhys =
-            childLinkDetachableJointFeature->AttachFixedJoint(parentLinkPhys);
-        if (jointPtrPhys.Valid())
-        {
-          // We let the joint be at the origin of the child link.
-          jointPtrPhys->SetTransformFromParent(poseParentChild);
-
-          igndbg << "Creating detachable joint [" << _entity << "]"
-                 << std::endl;
-          this->entityJointMap.AddEntity(_entity, jointPtrPhys);
-          this->topLevelModelMap.insert(std::make_pair(_entity,
-              topLevelModel(_entity, _ecm)));
-        }
-        else
-        {
-          ignwarn << "DetachableJoint could not be created." << std::endl;
-        }
-        return true;
+        return this->AttachDetachableJoint(_entity, _jointInfo->Data(), _ecm);
       });
 
   // The components are removed after each update, so we want to process all
@@ -1653,101 +2103,236 @@ void PhysicsPrivate::CreateBatteryEntities(const EntityComponentManager &_ecm)
 }
 
 //////////////////////////////////////////////////
-void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
+void PhysicsPrivate::UpdateDetachableJoints(const EntityComponentManager &_ecm)
 {
-  // Assume the world will not be erased
-  // Only removing models is supported by ign-physics right now so we only
-  // remove links, joints and collisions if they are children of the removed
-  // model.
-  // We assume the links, joints and collisions will be removed from the
-  // physics engine when the containing model gets removed so, here, we only
-  // remove the entities from the gazebo entity->physics entity map.
-  _ecm.EachRemoved<components::Model>(
-      [&](const Entity &_entity, const components::Model *
-          /* _model */) -> bool
+  _ecm.EachChangedSince<components::DetachableJoint,
+                        components::DetachableJointEnabled>(
+      this->detachableJointTick,
+      [&](const Entity &_entity,
+          const components::DetachableJoint *_jointInfo,
+          const components::DetachableJointEnabled *_enabled) -> bool
       {
-        const auto world = worldEntity(_ecm);
-        // Remove model if found
-        if (auto modelPtrPhys = this->entityModelMap.Get(_entity))
-        {
-          // Remove child links, collisions and joints first
-          for (const auto &childLink :
-               _ecm.ChildrenByComponents(_entity, components::Link()))
-          {
-            for (const auto &childCollision :
-                 _ecm.ChildrenByComponents(childLink, components::Collision()))
-            {
-              this->entityCollisionMap.Remove(childCollision);
-              this->topLevelModelMap.erase(childCollision);
-              if (this->customContactSurfaceEntities[world].erase(
-                childCollision))
-              {
-                // if this was the last collision with contact customization,
-                // disable the whole feature in the physics engine
-                if (this->customContactSurfaceEntities[world].empty())
-                {
-                  this->DisableContactSurfaceCustomization(world);
-                }
-              }
-            }
-            this->entityLinkMap.Remove(childLink);
-            this->topLevelModelMap.erase(childLink);
-            this->staticEntities.erase(childLink);
-            this->linkWorldPoses.erase(childLink);
-            this->canonicalLinkModelTracker.RemoveLink(childLink);
-          }
-
-          for (const auto &childJoint :
-               _ecm.ChildrenByComponents(_entity, components::Joint()))
-          {
-            this->entityJointMap.Remove(childJoint);
-            this->topLevelModelMap.erase(childJoint);
-          }
-
-          this->entityFreeGroupMap.Remove(_entity);
-          // Remove the model from the physics engine
-          modelPtrPhys->Remove();
-          this->entityModelMap.Remove(_entity);
-          this->topLevelModelMap.erase(_entity);
-          this->staticEntities.erase(_entity);
-          this->modelWorldPoses.erase(_entity);
-        }
+        bool attached = this->entityJointMap.HasEntity(_entity);
+        if (_enabled->Data() && !attached)
+          return this->AttachDetachableJoint(_entity, _jointInfo->Data(), _ecm);
+        if (!_enabled->Data() && attached)
+          return this->DetachDetachableJoint(_entity);
         return true;
       });
 
-  _ecm.EachRemoved<components::DetachableJoint>(
-      [&](const Entity &_entity, const components::DetachableJoint *) -> bool
-      {
-        if (!this->entityJointMap.HasEntity(_entity))
-        {
-          ignwarn << "Failed to find joint [" << _entity
-                  << "]." << std::endl;
-          return true;
-        }
+  // Systems which run after physics on this iteration may still change the
+  // components with the current tick, so that tick is visited again on the
+  // next update. Attaching and detaching are idempotent.
+  this->detachableJointTick = _ecm.ChangeTick() - 1u;
+}
 
-        auto castEntity =
-            this->entityJointMap.EntityCast<DetachableJointFeatureList>(
-                _entity);
-        if (!castEntity)
+//////////////////////////////////////////////////
+bool PhysicsPrivate::AttachDetachableJoint(const Entity &_entity,
+    const components::DetachableJointInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  if (_info.jointType != "fixed")
+  {
+    ignerr << "Detachable joint type [" << _info.jointType
+           << "] is currently not supported" << std::endl;
+    return true;
+  }
+  // Check if joint already exists
+  if (this->entityJointMap.HasEntity(_entity))
+  {
+    ignwarn << "Joint entity [" << _entity
+            << "] marked as new, but it's already on the map."
+            << std::endl;
+    return true;
+  }
+
+  // Check if the link entities exist in the physics engine
+  auto parentLinkPhys =
+      this->entityLinkMap.Get(_info.parentLink);
+  if (!parentLinkPhys)
+  {
+    ignwarn << "DetachableJoint's parent link entity ["
+            << _info.parentLink << "] not found in link map."
+            << std::endl;
+    return true;
+  }
+
+  auto childLinkEntity = _info.childLink;
+
+  // Get child link
+  auto childLinkPhys = this->entityLinkMap.Get(childLinkEntity);
+  if (!childLinkPhys)
+  {
+    ignwarn << "Failed to find joint's child link [" << childLinkEntity
+            << "]." << std::endl;
+    return true;
+  }
+
+  auto childLinkDetachableJointFeature =
+      this->entityLinkMap.EntityCast<DetachableJointFeatureList>(
+          childLinkEntity);
+  if (!childLinkDetachableJointFeature)
+  {
+    static bool informed{false};
+    if (!informed)
+    {
+      igndbg << "Attempting to create a detachable joint, but the physics"
+             << " engine doesn't support feature "
+             << "[AttachFixedJointFeature]. Detachable joints will be "
+             << "ignored." << std::endl;
+      informed = true;
+    }
+
+    // Break Each call since no DetachableJoints can be processed
+    return false;
+  }
+
+  const auto poseParent =
+      parentLinkPhys->FrameDataRelativeToWorld().pose;
+  const auto poseChild =
+      childLinkDetachableJointFeature->FrameDataRelativeToWorld().pose;
+
+  // Pose of child relative to parent
+  auto poseParentChild = poseParent.inverse() * poseChild;
+  auto jointPtrPhys =
+      childLinkDetachableJointFeature->AttachFixedJoint(parentLinkPhys);
+  if (jointPtrPhys.Valid())
+  {
+    // We let the joint be at the origin of the child link.
+    jointPtrPhys->SetTransformFromParent(poseParentChild);
+
+    igndbg << "Creating detachable joint [" << _entity << "]"
+           << std::endl;
+    this->entityJointMap.AddEntity(_entity, jointPtrPhys);
+    this->topLevelModelMap.insert(std::make_pair(_entity,
+        topLevelModel(_entity, _ecm)));
+  }
+  else
+  {
+    ignwarn << "DetachableJoint could not be created." << std::endl;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::DetachDetachableJoint(const Entity &_entity)
+{
+  if (!this->entityJointMap.HasEntity(_entity))
+  {
+    ignwarn << "Failed to find joint [" << _entity
+            << "]." << std::endl;
+    return true;
+  }
+
+  auto castEntity =
+      this->entityJointMap.EntityCast<DetachableJointFeatureList>(
+          _entity);
+  if (!castEntity)
+  {
+    static bool informed{false};
+    if (!informed)
+    {
+      igndbg << "Attempting to detach a joint, but the physics "
+             << "engine doesn't support feature "
+             << "[DetachJointFeature]. Joint won't be detached."
+             << std::endl;
+      informed = true;
+    }
+
+    // Break Each call since no DetachableJoints can be processed
+    return false;
+  }
+
+  igndbg << "Detaching joint [" << _entity << "]" << std::endl;
+  castEntity->Detach();
+  this->entityJointMap.Remove(_entity);
+  this->jointReadbacksDirty = true;
+  this->topLevelModelMap.erase(_entity);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
+{
+  // Assume the world will not be erased
+  // Only removing models is supported by ign-physics right now so we only
+  // remove links, joints and collisions if they are children of the removed
+  // model.
+  // We assume the links, joints and collisions will be removed from the
+  // physics engine when the containing model gets removed so, here, we only
+  // remove the entities from the gazebo entity->physics entity map.
+  _ecm.EachRemoved<components::Model>(
+      [&](const Entity &_entity, const components::Model *
+          /* _model */) -> bool
+      {
+        const auto world = worldEntity(_ecm);
+        // Remove model if found
+        if (auto modelPtrPhys = this->entityModelMap.Get(_entity))
         {
-          static bool informed{false};
-          if (!informed)
+          // Remove child links, collisions and joints first
+          for (const auto &childLink :
+               _ecm.ChildrenByComponents(_entity, components::Link()))
           {
-            igndbg << "Attempting to detach a joint, but the physics "
-                   << "engine doesn't support feature "
-                   << "[DetachJointFeature]. Joint won't be detached."
-                   << std::endl;
-            informed = true;
+            for (const auto &childCollision :
+                 _ecm.ChildrenByComponents(childLink, components::Collision()))
+            {
+              this->entityCollisionMap.Remove(childCollision);
+              this->topLevelModelMap.erase(childCollision);
+              this->contactCollisionNames.erase(childCollision);
+              {
+                std::lock_guard<std::mutex> lock(
+                    this->contactSurfaceHandlersMutex);
+                this->contactSurfaceHandlers.erase(childCollision);
+              }
+              if (this->customContactSurfaceEntities[world].erase(
+                childCollision))
+              {
+                // if this was the last collision with contact customization,
+                // disable the whole feature in the physics engine
+                if (this->customContactSurfaceEntities[world].empty())
+                {
+                  this->DisableContactSurfaceCustomization(world);
+                }
+              }
+            }
+            this->entityLinkMap.Remove(childLink);
+            this->topLevelModelMap.erase(childLink);
+            this->staticEntities.erase(childLink);
+            this->linkReadbacksDirty = true;
+            this->canonicalLinkModelTracker.RemoveLink(childLink);
           }
 
-          // Break Each call since no DetachableJoints can be processed
-          return false;
-        }
+          for (const auto &childJoint :
+               _ecm.ChildrenByComponents(_entity, components::Joint()))
+          {
+            this->entityJointMap.Remove(childJoint);
+            this->jointReadbacksDirty = true;
+            this->topLevelModelMap.erase(childJoint);
+          }
 
-        igndbg << "Detaching joint [" << _entity << "]" << std::endl;
-        castEntity->Detach();
+          this->entityFreeGroupMap.Remove(_entity);
+          // Remove the model from the physics engine
+          modelPtrPhys->Remove();
+          this->entityModelMap.Remove(_entity);
+          this->topLevelModelMap.erase(_entity);
+          this->staticEntities.erase(_entity);
+          this->modelWorldPoses.erase(_entity);
+          this->modelPoseUpdates.clear();
+        }
         return true;
       });
+
+  _ecm.EachRemoved<components::DetachableJoint>(
+      [&](const Entity &_entity, const components::DetachableJoint *) -> bool
+      {
+        // Disabled joints have no constraint to remove
+        auto enabled =
+            _ecm.Component<components::DetachableJointEnabled>(_entity);
+        if (enabled && !enabled->Data())
+          return true;
+
+        return this->DetachDetachableJoint(_entity);
+      });
 }
 
 //////////////////////////////////////////////////
@@ -1765,10 +2350,11 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         return true;
       });
 
+  this->UpdateFrozenModels(_ecm);
+
   // Handle joint state
-  _ecm.Each<components::Joint, components::Name>(
-      [&](const Entity &_entity, const components::Joint *,
-          const components::Name *_name)
+  auto updateJoint = [&](const Entity &_entity,
+      const components::Name *_name) -> bool
       {
         auto jointPhys = this->entityJointMap.Get(_entity);
         if (nullptr == jointPhys)
@@ -1797,6 +2383,8 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         {
           haltMotion = haltMotionComp->Data();
         }
+        haltMotion = haltMotion ||
+            this->frozenModels.count(_ecm.ParentEntity(_entity)) > 0u;
 
         // Model is out of battery or halt motion has been triggered.
         if (this->entityOffMap[_ecm.ParentEntity(_entity)] || haltMotion)
@@ -2024,7 +2612,55 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         }
 
         return true;
-      });
+      };
+
+  // Only joints which carry a command, or whose model is out of battery or
+  // halted, need any work, so they're gathered from the command components
+  // instead of visiting every joint
+  std::vector<Entity> pendingJoints;
+  AddEntitiesWith<components::JointPositionLimitsCmd>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointVelocityLimitsCmd>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointEffortLimitsCmd>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointPositionReset>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointVelocityReset>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointForceCmd>(_ecm, pendingJoints);
+  AddEntitiesWith<components::JointVelocityCmd>(_ecm, pendingJoints);
+
+  auto addModelJoints = [&](const Entity _model)
+  {
+    auto joints = _ecm.ChildrenByComponents(_model, components::Joint());
+    pendingJoints.insert(pendingJoints.end(), joints.begin(), joints.end());
+  };
+  for (const auto &[model, off] : this->entityOffMap)
+  {
+    if (off)
+      addModelJoints(model);
+  }
+  for (const auto &frozen : this->frozenModels)
+    addModelJoints(frozen.first);
+  if (_ecm.ComponentCount(components::HaltMotion::typeId) > 0u)
+  {
+    _ecm.Each<components::HaltMotion>(
+        [&](const Entity &_model, const components::HaltMotion *_halt)
+        {
+          if (_halt->Data())
+            addModelJoints(_model);
+          return true;
+        });
+  }
+
+  std::sort(pendingJoints.begin(), pendingJoints.end());
+  pendingJoints.erase(std::unique(pendingJoints.begin(), pendingJoints.end()),
+      pendingJoints.end());
+  for (const Entity joint : pendingJoints)
+  {
+    auto nameComp = _ecm.Component<components::Name>(joint);
+    if (nullptr != nameComp &&
+        _ecm.EntityHasComponentType(joint, components::Joint::typeId))
+    {
+      updateJoint(joint, nameComp);
+    }
+  }
 
   // Link wrenches
   _ecm.Each<components::ExternalWorldWrenchCmd>(
@@ -2131,8 +2767,10 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
     _ecm.RemoveComponent<components::WorldPoseCmd>(entity);
   }
 
-  // Slip compliance on Collisions
-  _ecm.Each<components::SlipComplianceCmd>(
+  // Slip compliance on Collisions. The compliance is kept by the shapes, so
+  // it's only set again when the command changes.
+  _ecm.EachChangedSince<components::SlipComplianceCmd>(
+      this->slipComplianceTick,
       [&](const Entity &_entity,
           const components::SlipComplianceCmd *_slipCmdComp)
       {
@@ -2167,6 +2805,11 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
         return true;
       });
 
+  // Systems which run after physics on this iteration may still change the
+  // commands with the current tick, so that tick is visited again on the
+  // next update. Setting the compliance is idempotent.
+  this->slipComplianceTick = _ecm.ChangeTick() - 1u;
+
   // Update model angular velocity
   _ecm.Each<components::Model, components::AngularVelocityCmd>(
       [&](const Entity &_entity, const components::Model *,
@@ -2417,72 +3060,368 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm)
 // TODO (azeey) Reduce size of function and remove the NOLINT above
 
 //////////////////////////////////////////////////
-ignition::physics::ForwardStep::Output PhysicsPrivate::Step(
-    const std::chrono::steady_clock::duration &_dt)
+void PhysicsPrivate::UpdateFrozenModels(EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("PhysicsPrivate::Step");
-  ignition::physics::ForwardStep::Input input;
-  ignition::physics::ForwardStep::State state;
-  ignition::physics::ForwardStep::Output output;
+  if (this->frozenModels.empty() &&
+      _ecm.ComponentCount(components::Dormant::typeId) == 0u)
+  {
+    return;
+  }
+
+  IGN_PROFILE("PhysicsPrivate::UpdateFrozenModels");
+
+  // Models which just became dormant keep the state they had
+  _ecm.Each<components::Model, components::Dormant, components::Pose>(
+      [&](const Entity &_entity, const components::Model *,
+          const components::Dormant *_dormant,
+          const components::Pose *_pose) -> bool
+      {
+        if (!_dormant->Data() || this->frozenModels.count(_entity) > 0u)
+          return true;
+
+        auto topLevel = this->topLevelModelMap.find(_entity);
+        if (topLevel == this->topLevelModelMap.end() ||
+            topLevel->second != _entity)
+        {
+          return true;
+        }
+
+        auto modelPtrPhys = this->entityModelMap.Get(_entity);
+        if (nullptr == modelPtrPhys)
+          return true;
+
+        FrozenModel frozen;
+        frozen.pose = _pose->Data();
+
+        auto freeGroup = modelPtrPhys->FindFreeGroup();
+        if (freeGroup)
+        {
+          this->entityFreeGroupMap.AddEntity(_entity, freeGroup);
+          const auto linkEntity =
+              this->entityLinkMap.Get(freeGroup->RootLink());
+          if (linkEntity != kNullEntity)
+          {
+            frozen.rootLinkPose = this->RelativePose(_entity, linkEntity,
+                _ecm);
+            physics::FrameData3d data;
+            if (this->GetFrameDataRelativeToWorld(linkEntity, data))
+            {
+              frozen.linearVelocity =
+                  math::eigen3::convert(data.linearVelocity);
+              frozen.angularVelocity =
+                  math::eigen3::convert(data.angularVelocity);
+            }
+          }
+        }
 
-  input.Get<std::chrono::steady_clock::duration>() = _dt;
+        for (const auto &joint :
+            _ecm.ChildrenByComponents(_entity, components::Joint()))
+        {
+          auto jointPhys = this->entityJointMap.Get(joint);
+          if (nullptr == jointPhys)
+            continue;
+
+          std::vector<double> velocities;
+          for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom(); ++i)
+            velocities.push_back(jointPhys->GetVelocity(i));
+          frozen.jointVelocities.push_back({joint, std::move(velocities)});
+        }
 
-  for (const auto &world : this->entityWorldMap.Map())
+        this->frozenModels[_entity] = std::move(frozen);
+        return true;
+      });
+
+  auto iter = this->frozenModels.begin();
+  while (iter != this->frozenModels.end())
   {
-    world.second->Step(output, state, input);
-  }
+    const Entity model = iter->first;
+    const auto &frozen = iter->second;
+    auto dormant = _ecm.Component<components::Dormant>(model);
+    auto modelPtrPhys = this->entityModelMap.Get(model);
+    auto velFeature = this->entityFreeGroupMap
+        .EntityCast<WorldVelocityCommandFeatureList>(model);
+
+    // Models which woke up continue with the velocities they had
+    if (nullptr == dormant || !dormant->Data() || nullptr == modelPtrPhys)
+    {
+      if (nullptr != modelPtrPhys)
+      {
+        if (velFeature)
+        {
+          velFeature->SetWorldLinearVelocity(
+              math::eigen3::convert(frozen.linearVelocity));
+          velFeature->SetWorldAngularVelocity(
+              math::eigen3::convert(frozen.angularVelocity));
+        }
+        for (const auto &[joint, velocities] : frozen.jointVelocities)
+        {
+          auto jointPhys = this->entityJointMap.Get(joint);
+          if (nullptr == jointPhys)
+            continue;
+          const std::size_t nDofs = std::min(velocities.size(),
+              jointPhys->GetDegreesOfFreedom());
+          for (std::size_t i = 0; i < nDofs; ++i)
+            jointPhys->SetVelocity(i, velocities[i]);
+        }
+      }
+      iter = this->frozenModels.erase(iter);
+      continue;
+    }
 
-  return output;
+    // Dormant models are held where they were frozen
+    auto freeGroup = modelPtrPhys->FindFreeGroup();
+    if (freeGroup && frozen.rootLinkPose)
+    {
+      freeGroup->SetWorldPose(math::eigen3::convert(frozen.pose *
+          *frozen.rootLinkPose));
+    }
+    if (velFeature)
+    {
+      velFeature->SetWorldLinearVelocity(
+          math::eigen3::convert(math::Vector3d::Zero));
+      velFeature->SetWorldAngularVelocity(
+          math::eigen3::convert(math::Vector3d::Zero));
+    }
+    ++iter;
+  }
 }
 
 //////////////////////////////////////////////////
-ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
-  const Entity &_to, const EntityComponentManager &_ecm) const
+ignition::physics::ForwardStep::Output PhysicsPrivate::Step(
+    const std::chrono::steady_clock::duration &_dt,
+    const EntityComponentManager &_ecm)
 {
-  math::Pose3d transform;
+  IGN_PROFILE("PhysicsPrivate::Step");
+  ignition::physics::ForwardStep::Input input;
+  ignition::physics::ForwardStep::State state;
+  ignition::physics::ForwardStep::Output output;
 
-  if (_from == _to)
-    return transform;
+  // The last substep absorbs the remainder of the division
+  const auto substepDt = _dt / static_cast<int>(this->substeps);
+  input.Get<std::chrono::steady_clock::duration>() = substepDt;
 
-  auto currentEntity = _to;
-  auto parentComp = _ecm.Component<components::ParentEntity>(_to);
-  while (parentComp)
+  // Links whose pose changed in any substep, by physics ID
+  std::vector<ignition::physics::WorldPose> changedPoses;
+  std::unordered_map<std::size_t, std::size_t> changedPoseIndices;
+
+  for (std::size_t i = 0; i < this->substeps; ++i)
   {
-    auto parentEntity = parentComp->Data();
+    if (i > 0u)
+      this->ApplyHeldCommands(_ecm);
 
-    // get the entity pose
-    auto entityPoseComp =
-      _ecm.Component<components::Pose>(currentEntity);
+    if (i + 1u == this->substeps)
+    {
+      input.Get<std::chrono::steady_clock::duration>() =
+          _dt - substepDt * static_cast<int>(this->substeps - 1u);
+    }
 
-    // update transform
-    transform = entityPoseComp->Data() * transform;
+    // There's a single engine world per ECM, so this isn't worth splitting
+    // across threads. The engine doesn't support partitioning a world
+    // either, see the class documentation.
+    for (const auto &world : this->entityWorldMap.Map())
+    {
+      world.second->Step(output, state, input);
+    }
 
-    if (parentEntity == _from)
-      break;
+    if (this->substeps == 1u ||
+        !output.Has<ignition::physics::ChangedWorldPoses>())
+    {
+      continue;
+    }
 
-    // set current entity to parent
-    currentEntity = parentEntity;
+    for (const auto &pose :
+        output.Query<ignition::physics::ChangedWorldPoses>()->entries)
+    {
+      auto inserted =
+          changedPoseIndices.insert({pose.body, changedPoses.size()});
+      if (inserted.second)
+        changedPoses.push_back(pose);
+      else
+        changedPoses[inserted.first->second] = pose;
+    }
+  }
 
-    // get entity's parent
-    parentComp = _ecm.Component<components::ParentEntity>(
-      parentEntity);
+  if (this->substeps > 1u &&
+      output.Has<ignition::physics::ChangedWorldPoses>())
+  {
+    output.Get<ignition::physics::ChangedWorldPoses>().entries =
+        std::move(changedPoses);
   }
 
-  return transform;
+  return output;
 }
 
 //////////////////////////////////////////////////
-std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
-    EntityComponentManager &_ecm,
-    const ignition::physics::ForwardStep::Output &_updatedLinks)
+void PhysicsPrivate::ApplyHeldCommands(const EntityComponentManager &_ecm)
 {
-  IGN_PROFILE("Links Frame Data");
-
-  std::map<Entity, physics::FrameData3d> linkFrameData;
+  IGN_PROFILE("PhysicsPrivate::ApplyHeldCommands");
+
+  // Models which are out of battery or halted had their joints zeroed by
+  // UpdatePhysics, and that's what's held. The engine clears those commands
+  // after each step as well, so they're zeroed again, otherwise halted
+  // models would move freely during the remaining substeps. Each model is
+  // mapped to whether it's halted.
+  std::unordered_map<Entity, bool> offModels;
+  for (const auto &[model, off] : this->entityOffMap)
+  {
+    if (off)
+      offModels.insert({model, false});
+  }
+  for (const auto &frozen : this->frozenModels)
+    offModels[frozen.first] = true;
+  if (_ecm.ComponentCount(components::HaltMotion::typeId) > 0u)
+  {
+    _ecm.Each<components::HaltMotion>(
+        [&](const Entity &_model, const components::HaltMotion *_halt)
+        {
+          if (_halt->Data())
+            offModels[_model] = true;
+          return true;
+        });
+  }
 
-  // Check to see if the physics engine gave a list of changed poses. If not, we
-  // will iterate through all of the links via the ECM to see which ones changed
-  if (_updatedLinks.Has<ignition::physics::ChangedWorldPoses>())
+  for (const auto &[model, halted] : offModels)
+  {
+    for (const Entity joint :
+        _ecm.ChildrenByComponents(model, components::Joint()))
+    {
+      auto jointPhys = this->entityJointMap.Get(joint);
+      if (nullptr == jointPhys)
+        continue;
+
+      auto jointVelFeature =
+        this->entityJointMap.EntityCast<JointVelocityCommandFeatureList>(
+            joint);
+
+      std::size_t nDofs = jointPhys->GetDegreesOfFreedom();
+      for (std::size_t i = 0; i < nDofs; ++i)
+      {
+        jointPhys->SetForce(i, 0);
+        if (halted && jointVelFeature)
+          jointVelFeature->SetVelocityCommand(i, 0);
+      }
+    }
+  }
+
+  auto isOff = [&](const Entity _joint)
+  {
+    return offModels.count(_ecm.ParentEntity(_joint)) > 0u;
+  };
+
+  _ecm.Each<components::JointForceCmd>(
+      [&](const Entity &_entity, const components::JointForceCmd *_force)
+      {
+        auto jointPhys = this->entityJointMap.Get(_entity);
+        if (nullptr == jointPhys || isOff(_entity))
+          return true;
+
+        std::size_t nDofs = std::min(_force->Data().size(),
+                                     jointPhys->GetDegreesOfFreedom());
+        for (std::size_t i = 0; i < nDofs; ++i)
+          jointPhys->SetForce(i, _force->Data()[i]);
+        return true;
+      });
+
+  _ecm.Each<components::JointVelocityCmd>(
+      [&](const Entity &_entity, const components::JointVelocityCmd *_velCmd)
+      {
+        // Same precedence as in UpdatePhysics
+        if (_ecm.EntityHasComponentType(_entity,
+              components::JointForceCmd::typeId) ||
+            _ecm.EntityHasComponentType(_entity,
+              components::JointVelocityReset::typeId))
+        {
+          return true;
+        }
+
+        auto jointPhys = this->entityJointMap.Get(_entity);
+        if (nullptr == jointPhys || isOff(_entity))
+          return true;
+
+        auto jointVelFeature =
+          this->entityJointMap.EntityCast<JointVelocityCommandFeatureList>(
+              _entity);
+        if (!jointVelFeature)
+          return true;
+
+        std::size_t nDofs = std::min(_velCmd->Data().size(),
+                                     jointPhys->GetDegreesOfFreedom());
+        for (std::size_t i = 0; i < nDofs; ++i)
+          jointVelFeature->SetVelocityCommand(i, _velCmd->Data()[i]);
+        return true;
+      });
+
+  _ecm.Each<components::ExternalWorldWrenchCmd>(
+      [&](const Entity &_entity,
+          const components::ExternalWorldWrenchCmd *_wrenchComp)
+      {
+        if (!this->entityLinkMap.HasEntity(_entity))
+          return true;
+
+        auto linkForceFeature =
+            this->entityLinkMap.EntityCast<LinkForceFeatureList>(_entity);
+        if (!linkForceFeature)
+          return false;
+
+        math::Vector3 force = msgs::Convert(_wrenchComp->Data().force());
+        math::Vector3 torque = msgs::Convert(_wrenchComp->Data().torque());
+        linkForceFeature->AddExternalForce(math::eigen3::convert(force));
+        linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
+        return true;
+      });
+}
+
+//////////////////////////////////////////////////
+ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
+  const Entity &_to, const EntityComponentManager &_ecm) const
+{
+  math::Pose3d transform;
+
+  if (_from == _to)
+    return transform;
+
+  auto currentEntity = _to;
+  auto parentComp = _ecm.Component<components::ParentEntity>(_to);
+  while (parentComp)
+  {
+    auto parentEntity = parentComp->Data();
+
+    // get the entity pose
+    auto entityPoseComp =
+      _ecm.Component<components::Pose>(currentEntity);
+
+    // update transform
+    transform = entityPoseComp->Data() * transform;
+
+    if (parentEntity == _from)
+      break;
+
+    // set current entity to parent
+    currentEntity = parentEntity;
+
+    // get entity's parent
+    parentComp = _ecm.Component<components::ParentEntity>(
+      parentEntity);
+  }
+
+  return transform;
+}
+
+//////////////////////////////////////////////////
+std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
+    EntityComponentManager &_ecm,
+    const ignition::physics::ForwardStep::Output &_updatedLinks)
+{
+  IGN_PROFILE("Links Frame Data");
+
+  std::map<Entity, physics::FrameData3d> linkFrameData;
+
+  // Frame data read back during earlier steps is stale
+  ++this->readbackStep;
+
+  // Check to see if the physics engine gave a list of changed poses. If not, we
+  // will iterate through all of the links via the ECM to see which ones changed
+  if (_updatedLinks.Has<ignition::physics::ChangedWorldPoses>())
   {
     for (const auto &link :
         _updatedLinks.Query<ignition::physics::ChangedWorldPoses>()->entries)
@@ -2509,51 +3448,151 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
   }
   else
   {
-    _ecm.Each<components::Link>(
-      [&](const Entity &_entity, components::Link *) -> bool
+    this->UpdateLinkReadbacks(_ecm);
+
+    const bool hasRecreate =
+        _ecm.HasComponentType(components::Recreate::typeId);
+    for (auto &readback : this->linkReadbacks)
+    {
+      if (hasRecreate && _ecm.EntityHasComponentType(readback.entity,
+          components::Recreate::typeId))
       {
-        if (this->staticEntities.find(_entity) != this->staticEntities.end() ||
-            _ecm.EntityHasComponentType(_entity, components::Recreate::typeId))
-        {
-          return true;
-        }
+        continue;
+      }
+
+      readback.frameData = readback.link->FrameDataRelativeToWorld();
+      readback.step = this->readbackStep;
+
+      // update the link pose if this is the first update,
+      // or if the link pose has changed since the last update
+      // (if the link pose hasn't changed, there's no need for a pose update)
+      const auto worldPoseMath3d = ignition::math::eigen3::convert(
+          readback.frameData.pose);
+      if (!readback.worldPose ||
+          !this->pose3Eql(*readback.worldPose, worldPoseMath3d))
+      {
+        // cache the updated link pose to check if the link pose has changed
+        // during the next iteration
+        readback.worldPose = worldPoseMath3d;
+
+        linkFrameData.emplace_hint(linkFrameData.end(), readback.entity,
+            readback.frameData);
+      }
+    }
+  }
+
+  return linkFrameData;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateLinkReadbacks(const EntityComponentManager &_ecm)
+{
+  if (!this->linkReadbacksDirty)
+    return;
 
-        // This `once` variable is here to aid in debugging, make sure to
-        // remove it.
-        auto linkPhys = this->entityLinkMap.Get(_entity);
-        if (nullptr == linkPhys)
+  IGN_PROFILE("PhysicsPrivate::UpdateLinkReadbacks");
+  std::vector<LinkReadback> readbacks;
+  _ecm.Each<components::Link>(
+    [&](const Entity &_entity, const components::Link *) -> bool
+    {
+      if (this->staticEntities.find(_entity) != this->staticEntities.end())
+        return true;
+
+      auto linkPhys = this->entityLinkMap.Get(_entity);
+      if (nullptr == linkPhys)
+      {
+        if (this->linkAddedToModel.find(_entity) ==
+            this->linkAddedToModel.end())
         {
-          if (this->linkAddedToModel.find(_entity) ==
-              this->linkAddedToModel.end())
-          {
-            ignerr << "Internal error: link [" << _entity
-              << "] not in entity map" << std::endl;
-          }
-          return true;
+          ignerr << "Internal error: link [" << _entity
+            << "] not in entity map" << std::endl;
         }
+        return true;
+      }
 
-        auto frameData = linkPhys->FrameDataRelativeToWorld();
+      LinkReadback readback;
+      readback.entity = _entity;
+      readback.link = linkPhys;
+      auto it = this->linkReadbackIndices.find(_entity);
+      if (it != this->linkReadbackIndices.end())
+        readback.worldPose = this->linkReadbacks[it->second].worldPose;
+
+      readbacks.push_back(std::move(readback));
+      return true;
+    });
+
+  // Sorted by entity, so that changed links are appended to the std::map
+  // in order
+  std::sort(readbacks.begin(), readbacks.end(),
+      [](const LinkReadback &_a, const LinkReadback &_b)
+      {
+        return _a.entity < _b.entity;
+      });
 
-        // update the link pose if this is the first update,
-        // or if the link pose has changed since the last update
-        // (if the link pose hasn't changed, there's no need for a pose update)
-        const auto worldPoseMath3d = ignition::math::eigen3::convert(
-            frameData.pose);
-        if ((this->linkWorldPoses.find(_entity) == this->linkWorldPoses.end())
-            || !this->pose3Eql(this->linkWorldPoses[_entity], worldPoseMath3d))
-        {
-          // cache the updated link pose to check if the link pose has changed
-          // during the next iteration
-          this->linkWorldPoses[_entity] = worldPoseMath3d;
+  std::unordered_map<Entity, std::size_t> indices;
+  indices.reserve(readbacks.size());
+  for (std::size_t i = 0; i < readbacks.size(); ++i)
+    indices[readbacks[i].entity] = i;
 
-          linkFrameData[_entity] = frameData;
-        }
+  this->linkReadbacks = std::move(readbacks);
+  this->linkReadbackIndices = std::move(indices);
+  this->linkReadbacksDirty = false;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::UpdateJointReadbacks(EntityComponentManager &_ecm)
+{
+  const uint64_t positionGeneration =
+      _ecm.ComponentTypeGeneration(components::JointPosition::typeId);
+  const uint64_t velocityGeneration =
+      _ecm.ComponentTypeGeneration(components::JointVelocity::typeId);
+  if (!this->jointReadbacksDirty &&
+      positionGeneration == this->jointPositionGeneration &&
+      velocityGeneration == this->jointVelocityGeneration)
+  {
+    return;
+  }
 
+  IGN_PROFILE("PhysicsPrivate::UpdateJointReadbacks");
+  std::vector<JointReadback> readbacks;
+  std::unordered_map<Entity, std::size_t> indices;
+  auto readback = [&](const Entity _entity) -> JointReadback *
+  {
+    auto it = indices.find(_entity);
+    if (it != indices.end())
+      return &readbacks[it->second];
+
+    auto jointPhys = this->entityJointMap.Get(_entity);
+    if (nullptr == jointPhys)
+      return nullptr;
+
+    indices[_entity] = readbacks.size();
+    readbacks.push_back({_entity, jointPhys, nullptr, nullptr});
+    return &readbacks.back();
+  };
+
+  _ecm.Each<components::Joint, components::JointPosition>(
+      [&](const Entity &_entity, components::Joint *,
+          components::JointPosition *_position) -> bool
+      {
+        if (auto *joint = readback(_entity))
+          joint->position = _position;
         return true;
       });
-  }
 
-  return linkFrameData;
+  _ecm.Each<components::Joint, components::JointVelocity>(
+      [&](const Entity &_entity, components::Joint *,
+          components::JointVelocity *_velocity) -> bool
+      {
+        if (auto *joint = readback(_entity))
+          joint->velocity = _velocity;
+        return true;
+      });
+
+  this->jointReadbacks = std::move(readbacks);
+  this->jointPositionGeneration = positionGeneration;
+  this->jointVelocityGeneration = velocityGeneration;
+  this->jointReadbacksDirty = false;
 }
 
 //////////////////////////////////////////////////
@@ -2561,6 +3600,8 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
     const Entity _canonicalLink, EntityComponentManager &_ecm,
     std::map<Entity, physics::FrameData3d> &_linkFrameData)
 {
+  const auto &update = this->ModelPoseUpdateData(_model, _canonicalLink, _ecm);
+
   std::optional<math::Pose3d> parentWorldPose;
 
   // If this model is nested, the pose of the parent model has already
@@ -2568,9 +3609,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // topological order. We expect to find the updated pose in
   // this->modelWorldPoses. If not found, this must not be nested, so this
   // model's pose component would reflect it's absolute pose.
-  auto parentModelPoseIt =
-    this->modelWorldPoses.find(
-        _ecm.Component<components::ParentEntity>(_model)->Data());
+  auto parentModelPoseIt = this->modelWorldPoses.find(update.parent);
   if (parentModelPoseIt != this->modelWorldPoses.end())
   {
     parentWorldPose = parentModelPoseIt->second;
@@ -2597,10 +3636,15 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   //
   // And X_WM is calculated from X_WL, which is obtained from physics as:
   //   X_WM = X_WL * (X_ML)^-1
-  auto linkPoseFromModel = this->RelativePose(_model, _canonicalLink, _ecm);
+  //
+  // X_ML only changes if the canonical link moves relative to the model,
+  // which can't happen when all the models between them share it.
+  const math::Pose3d modelFromLink = update.fixedOffset ?
+      update.modelFromLink :
+      this->RelativePose(_model, _canonicalLink, _ecm).Inverse();
   const auto &linkWorldPose = _linkFrameData[_canonicalLink].pose;
   const auto &modelWorldPose =
-      math::eigen3::convert(linkWorldPose) * linkPoseFromModel.Inverse();
+      math::eigen3::convert(linkWorldPose) * modelFromLink;
 
   this->modelWorldPoses[_model] = modelWorldPose;
 
@@ -2624,8 +3668,7 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // once the model pose has been updated, all descendant link poses of this
   // model must be updated (whether the link actually changed pose or not)
   // since link poses are saved w.r.t. their parent model
-  auto model = gazebo::Model(_model);
-  for (const auto &childLink : model.Links(_ecm))
+  for (const auto &childLink : update.links)
   {
     // skip links that are already marked as a link to be updated
     if (_linkFrameData.find(childLink) != _linkFrameData.end())
@@ -2641,6 +3684,59 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // since nested model poses are saved w.r.t. the nested model's parent
   // pose, we must also update any nested models that have a different
   // canonical link
+  for (const auto &nestedCanonicalLink : update.nestedCanonicalLinks)
+  {
+    // skip links that are already marked as a link to be updated
+    if (_linkFrameData.find(nestedCanonicalLink) != _linkFrameData.end())
+      continue;
+
+    // mark this canonical link as one that needs to be updated so that all of
+    // the models that have this canonical link are updated
+    physics::FrameData3d canonicalLinkFrameData;
+    if (!this->GetFrameDataRelativeToWorld(nestedCanonicalLink,
+          canonicalLinkFrameData))
+      continue;
+
+    _linkFrameData[nestedCanonicalLink] = canonicalLinkFrameData;
+  }
+}
+
+//////////////////////////////////////////////////
+const PhysicsPrivate::ModelPoseUpdate &PhysicsPrivate::ModelPoseUpdateData(
+    const Entity _model, const Entity _canonicalLink,
+    const EntityComponentManager &_ecm)
+{
+  auto it = this->modelPoseUpdates.find(_model);
+  if (it != this->modelPoseUpdates.end())
+    return it->second;
+
+  ModelPoseUpdate update;
+  update.parent = _ecm.ParentEntity(_model);
+
+  // The pose of a canonical link w.r.t. its model isn't written back, so it
+  // only changes along the way to _model if there's a nested model which
+  // doesn't share _canonicalLink
+  update.fixedOffset = true;
+  for (auto entity = _ecm.ParentEntity(_canonicalLink);
+       entity != _model && entity != kNullEntity;
+       entity = _ecm.ParentEntity(entity))
+  {
+    auto canonicalLinkComp =
+        _ecm.Component<components::ModelCanonicalLink>(entity);
+    if (!canonicalLinkComp || canonicalLinkComp->Data() != _canonicalLink)
+    {
+      update.fixedOffset = false;
+      break;
+    }
+  }
+  if (update.fixedOffset)
+  {
+    update.modelFromLink =
+        this->RelativePose(_model, _canonicalLink, _ecm).Inverse();
+  }
+
+  auto model = gazebo::Model(_model);
+  update.links = model.Links(_ecm);
   for (const auto &nestedModel : model.Models(_ecm))
   {
     auto nestedModelCanonicalLinkComp =
@@ -2654,27 +3750,30 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
     }
 
     auto nestedCanonicalLink = nestedModelCanonicalLinkComp->Data();
-
-    // skip links that are already marked as a link to be updated
-    if (nestedCanonicalLink == _canonicalLink ||
-        _linkFrameData.find(nestedCanonicalLink) != _linkFrameData.end())
-      continue;
-
-    // mark this canonical link as one that needs to be updated so that all of
-    // the models that have this canonical link are updated
-    physics::FrameData3d canonicalLinkFrameData;
-    if (!this->GetFrameDataRelativeToWorld(nestedCanonicalLink,
-          canonicalLinkFrameData))
-      continue;
-
-    _linkFrameData[nestedCanonicalLink] = canonicalLinkFrameData;
+    if (nestedCanonicalLink != _canonicalLink)
+      update.nestedCanonicalLinks.push_back(nestedCanonicalLink);
   }
+
+  return this->modelPoseUpdates.emplace(_model, std::move(update))
+      .first->second;
 }
 
 //////////////////////////////////////////////////
 bool PhysicsPrivate::GetFrameDataRelativeToWorld(const Entity _entity,
     physics::FrameData3d &_data)
 {
+  // Links read back during this step don't need to be queried again
+  auto readbackIt = this->linkReadbackIndices.find(_entity);
+  if (readbackIt != this->linkReadbackIndices.end())
+  {
+    const auto &readback = this->linkReadbacks[readbackIt->second];
+    if (readback.step == this->readbackStep)
+    {
+      _data = readback.frameData;
+      return true;
+    }
+  }
+
   auto entityPhys = this->entityLinkMap.Get(_entity);
   if (nullptr == entityPhys)
   {
@@ -2737,6 +3836,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 
   // make sure we have an up-to-date mapping of canonical links to their models
   this->canonicalLinkModelTracker.AddNewModels(_ecm);
+  if (_ecm.HasNewEntities())
+    this->modelPoseUpdates.clear();
 
   for (const auto &[linkEntity, frameData] : _linkFrameData)
   {
@@ -2764,168 +3865,171 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 
   // Link poses, velocities...
   IGN_PROFILE_BEGIN("Links");
-  for (const auto &[entity, frameData] : _linkFrameData)
+
+  // Component types written back for each link, indexed by the bits of
+  // LinkWriteBack
+  const std::array<ComponentTypeId, 10> linkComponentTypes{
+      components::Pose::typeId,
+      components::WorldPose::typeId,
+      components::WorldLinearVelocity::typeId,
+      components::WorldAngularVelocity::typeId,
+      components::WorldLinearAcceleration::typeId,
+      components::WorldAngularAcceleration::typeId,
+      components::LinearVelocity::typeId,
+      components::AngularVelocity::typeId,
+      components::LinearAcceleration::typeId,
+      components::AngularAcceleration::typeId};
+
+  // Links are sorted by entity, which keeps the links of a model next to each
+  // other, so contiguous chunks mostly cover whole models
+  std::vector<const std::pair<const Entity, physics::FrameData3d> *> links;
+  links.reserve(_linkFrameData.size());
+  for (const auto &link : _linkFrameData)
+    links.push_back(&link);
+
+  // SetChanged can't be called concurrently, so each worker records which
+  // components it wrote and the changes are marked afterwards
+  std::vector<LinkWriteBack> writeBacks(links.size());
+
+  _ecm.ParallelFor(links.size(),
+      [&](std::size_t _begin, std::size_t _end)
   {
-    IGN_PROFILE_BEGIN("Local pose");
-    auto canonicalLink =
-        _ecm.Component<components::CanonicalLink>(entity);
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const Entity entity = links[i]->first;
+      const auto &frameData = links[i]->second;
+      auto &writeBack = writeBacks[i];
 
-    const auto &worldPose = frameData.pose;
-    const auto parentEntity = _ecm.ParentEntity(entity);
+      auto canonicalLink =
+          _ecm.Component<components::CanonicalLink>(entity);
 
-    if (!canonicalLink)
-    {
-      // Compute the relative pose of this link from the parent model
-      auto parentModelPoseIt = this->modelWorldPoses.find(parentEntity);
-      if (parentModelPoseIt == this->modelWorldPoses.end())
+      const auto &worldPose = frameData.pose;
+      const auto parentEntity = _ecm.ParentEntity(entity);
+
+      if (!canonicalLink)
       {
-        ignerr << "Internal error: parent model [" << parentEntity
-              << "] does not have a world pose available for child entity["
-              << entity << "]" << std::endl;
-        continue;
+        // Compute the relative pose of this link from the parent model
+        auto parentModelPoseIt = this->modelWorldPoses.find(parentEntity);
+        if (parentModelPoseIt == this->modelWorldPoses.end())
+        {
+          ignerr << "Internal error: parent model [" << parentEntity
+                << "] does not have a world pose available for child entity["
+                << entity << "]" << std::endl;
+          continue;
+        }
+        const math::Pose3d &parentWorldPose = parentModelPoseIt->second;
+
+        // Unlike canonical links, pose of regular links can move relative.
+        // to the parent. Same for links inside nested models.
+        auto pose = _ecm.Component<components::Pose>(entity);
+        *pose = components::Pose(parentWorldPose.Inverse() *
+                                  math::eigen3::convert(worldPose));
+        writeBack.Set(0, true);
       }
-      const math::Pose3d &parentWorldPose = parentModelPoseIt->second;
-
-      // Unlike canonical links, pose of regular links can move relative.
-      // to the parent. Same for links inside nested models.
-      auto pose = _ecm.Component<components::Pose>(entity);
-      *pose = components::Pose(parentWorldPose.Inverse() *
-                                math::eigen3::convert(worldPose));
-      _ecm.SetChanged(entity, components::Pose::typeId,
-          ComponentState::PeriodicChange);
-    }
-    IGN_PROFILE_END();
 
-    // Populate world poses, velocities and accelerations of the link. For
-    // now these components are updated only if another system has created
-    // the corresponding component on the entity.
-    auto worldPoseComp = _ecm.Component<components::WorldPose>(entity);
-    if (worldPoseComp)
-    {
-      auto state =
-          worldPoseComp->SetData(math::eigen3::convert(frameData.pose),
-          this->pose3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::WorldPose::typeId, state);
-    }
+      // Populate world poses, velocities and accelerations of the link. For
+      // now these components are updated only if another system has created
+      // the corresponding component on the entity.
+      auto worldPoseComp = _ecm.Component<components::WorldPose>(entity);
+      if (worldPoseComp)
+      {
+        writeBack.Set(1, worldPoseComp->SetData(
+            math::eigen3::convert(frameData.pose), this->pose3Eql));
+      }
 
-    // Velocity in world coordinates
-    auto worldLinVelComp =
-        _ecm.Component<components::WorldLinearVelocity>(entity);
-    if (worldLinVelComp)
-    {
-      auto state = worldLinVelComp->SetData(
-            math::eigen3::convert(frameData.linearVelocity),
-            this->vec3Eql) ?
-            ComponentState::PeriodicChange :
-            ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldLinearVelocity::typeId, state);
-    }
+      // Velocity in world coordinates
+      auto worldLinVelComp =
+          _ecm.Component<components::WorldLinearVelocity>(entity);
+      if (worldLinVelComp)
+      {
+        writeBack.Set(2, worldLinVelComp->SetData(
+            math::eigen3::convert(frameData.linearVelocity), this->vec3Eql));
+      }
 
-    // Angular velocity in world frame coordinates
-    auto worldAngVelComp =
-        _ecm.Component<components::WorldAngularVelocity>(entity);
-    if (worldAngVelComp)
-    {
-      auto state = worldAngVelComp->SetData(
-          math::eigen3::convert(frameData.angularVelocity),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldAngularVelocity::typeId, state);
-    }
+      // Angular velocity in world frame coordinates
+      auto worldAngVelComp =
+          _ecm.Component<components::WorldAngularVelocity>(entity);
+      if (worldAngVelComp)
+      {
+        writeBack.Set(3, worldAngVelComp->SetData(
+            math::eigen3::convert(frameData.angularVelocity), this->vec3Eql));
+      }
 
-    // Acceleration in world frame coordinates
-    auto worldLinAccelComp =
-        _ecm.Component<components::WorldLinearAcceleration>(entity);
-    if (worldLinAccelComp)
-    {
-      auto state = worldLinAccelComp->SetData(
-          math::eigen3::convert(frameData.linearAcceleration),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldLinearAcceleration::typeId, state);
-    }
+      // Acceleration in world frame coordinates
+      auto worldLinAccelComp =
+          _ecm.Component<components::WorldLinearAcceleration>(entity);
+      if (worldLinAccelComp)
+      {
+        writeBack.Set(4, worldLinAccelComp->SetData(
+            math::eigen3::convert(frameData.linearAcceleration),
+            this->vec3Eql));
+      }
 
-    // Angular acceleration in world frame coordinates
-    auto worldAngAccelComp =
-        _ecm.Component<components::WorldAngularAcceleration>(entity);
+      // Angular acceleration in world frame coordinates
+      auto worldAngAccelComp =
+          _ecm.Component<components::WorldAngularAcceleration>(entity);
+      if (worldAngAccelComp)
+      {
+        writeBack.Set(5, worldAngAccelComp->SetData(
+            math::eigen3::convert(frameData.angularAcceleration),
+            this->vec3Eql));
+      }
 
-    if (worldAngAccelComp)
-    {
-      auto state = worldAngAccelComp->SetData(
-          math::eigen3::convert(frameData.angularAcceleration),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity,
-          components::WorldAngularAcceleration::typeId, state);
-    }
+      const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
+
+      // Velocity in body-fixed frame coordinates
+      auto bodyLinVelComp =
+          _ecm.Component<components::LinearVelocity>(entity);
+      if (bodyLinVelComp)
+      {
+        Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
+        writeBack.Set(6, bodyLinVelComp->SetData(
+            math::eigen3::convert(bodyLinVel), this->vec3Eql));
+      }
 
-    const Eigen::Matrix3d R_bs = worldPose.linear().transpose(); // NOLINT
+      // Angular velocity in body-fixed frame coordinates
+      auto bodyAngVelComp =
+          _ecm.Component<components::AngularVelocity>(entity);
+      if (bodyAngVelComp)
+      {
+        Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
+        writeBack.Set(7, bodyAngVelComp->SetData(
+            math::eigen3::convert(bodyAngVel), this->vec3Eql));
+      }
 
-    // Velocity in body-fixed frame coordinates
-    auto bodyLinVelComp =
-        _ecm.Component<components::LinearVelocity>(entity);
-    if (bodyLinVelComp)
-    {
-      Eigen::Vector3d bodyLinVel = R_bs * frameData.linearVelocity;
-      auto state =
-          bodyLinVelComp->SetData(math::eigen3::convert(bodyLinVel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::LinearVelocity::typeId, state);
-    }
+      // Acceleration in body-fixed frame coordinates
+      auto bodyLinAccelComp =
+          _ecm.Component<components::LinearAcceleration>(entity);
+      if (bodyLinAccelComp)
+      {
+        Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
+        writeBack.Set(8, bodyLinAccelComp->SetData(
+            math::eigen3::convert(bodyLinAccel), this->vec3Eql));
+      }
 
-    // Angular velocity in body-fixed frame coordinates
-    auto bodyAngVelComp =
-        _ecm.Component<components::AngularVelocity>(entity);
-    if (bodyAngVelComp)
-    {
-      Eigen::Vector3d bodyAngVel = R_bs * frameData.angularVelocity;
-      auto state =
-          bodyAngVelComp->SetData(math::eigen3::convert(bodyAngVel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::AngularVelocity::typeId,
-          state);
+      // Angular acceleration in world frame coordinates
+      auto bodyAngAccelComp =
+          _ecm.Component<components::AngularAcceleration>(entity);
+      if (bodyAngAccelComp)
+      {
+        Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
+        writeBack.Set(9, bodyAngAccelComp->SetData(
+            math::eigen3::convert(bodyAngAccel), this->vec3Eql));
+      }
     }
+  }, kMinWriteBackChunk);
 
-    // Acceleration in body-fixed frame coordinates
-    auto bodyLinAccelComp =
-        _ecm.Component<components::LinearAcceleration>(entity);
-    if (bodyLinAccelComp)
+  for (std::size_t i = 0; i < links.size(); ++i)
+  {
+    const auto &writeBack = writeBacks[i];
+    for (std::size_t type = 0; type < linkComponentTypes.size(); ++type)
     {
-      Eigen::Vector3d bodyLinAccel = R_bs * frameData.linearAcceleration;
-      auto state =
-          bodyLinAccelComp->SetData(math::eigen3::convert(bodyLinAccel),
-          this->vec3Eql)?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::LinearAcceleration::typeId,
-          state);
-    }
+      if (!writeBack.Written(type))
+        continue;
 
-    // Angular acceleration in world frame coordinates
-    auto bodyAngAccelComp =
-        _ecm.Component<components::AngularAcceleration>(entity);
-    if (bodyAngAccelComp)
-    {
-      Eigen::Vector3d bodyAngAccel = R_bs * frameData.angularAcceleration;
-      auto state =
-          bodyAngAccelComp->SetData(math::eigen3::convert(bodyAngAccel),
-          this->vec3Eql) ?
-          ComponentState::PeriodicChange :
-          ComponentState::NoChange;
-      _ecm.SetChanged(entity, components::AngularAcceleration::typeId,
-          state);
+      _ecm.SetChanged(links[i]->first, linkComponentTypes[type],
+          writeBack.Changed(type) ? ComponentState::PeriodicChange :
+          ComponentState::NoChange);
     }
   }
   IGN_PROFILE_END();
@@ -2940,28 +4044,49 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // * LinearAcceleration
 
   IGN_PROFILE_BEGIN("Sensors / collisions");
+  // Querying the physics engine isn't thread safe, so the frame data of each
+  // parent link is read once, serially, and the offsets of its children are
+  // then applied in parallel
+  std::unordered_map<Entity, physics::FrameData3d> parentLinkFrameData;
+  this->AddParentLinkFrameData<components::WorldPose>(_ecm,
+      parentLinkFrameData);
+  this->AddParentLinkFrameData<components::WorldLinearVelocity>(_ecm,
+      parentLinkFrameData);
+  this->AddParentLinkFrameData<components::AngularVelocity>(_ecm,
+      parentLinkFrameData);
+  this->AddParentLinkFrameData<components::LinearAcceleration>(_ecm,
+      parentLinkFrameData);
+
+  // Frame data of an entity attached to a link, or nullopt if the parent
+  // isn't a link
+  auto frameDataAtOffset = [&](const components::ParentEntity *_parent,
+      const components::Pose *_pose) -> std::optional<physics::FrameData3d>
+  {
+    auto it = parentLinkFrameData.find(_parent->Data());
+    if (it == parentLinkFrameData.end())
+      return std::nullopt;
+    return LinkFrameDataAtOffset(it->second, _pose->Data());
+  };
+
   // world pose
-  _ecm.Each<components::Pose, components::WorldPose,
+  _ecm.EachParallel<components::Pose, components::WorldPose,
             components::ParentEntity>(
       [&](const Entity &,
           const components::Pose *_pose, components::WorldPose *_worldPose,
           const components::ParentEntity *_parent)->bool
       {
         // check if parent entity is a link, e.g. entity is sensor / collision
-        if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
+        if (auto entityFrameData = frameDataAtOffset(_parent, _pose))
         {
-          const auto entityFrameData =
-              this->LinkFrameDataAtOffset(linkPhys, _pose->Data());
-
           *_worldPose = components::WorldPose(
-              math::eigen3::convert(entityFrameData.pose));
+              math::eigen3::convert(entityFrameData->pose));
         }
 
         return true;
       });
 
   // world linear velocity
-  _ecm.Each<components::Pose, components::WorldLinearVelocity,
+  _ecm.EachParallel<components::Pose, components::WorldLinearVelocity,
             components::ParentEntity>(
       [&](const Entity &,
           const components::Pose *_pose,
@@ -2969,21 +4094,18 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
           const components::ParentEntity *_parent)->bool
       {
         // check if parent entity is a link, e.g. entity is sensor / collision
-        if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
+        if (auto entityFrameData = frameDataAtOffset(_parent, _pose))
         {
-          const auto entityFrameData =
-              this->LinkFrameDataAtOffset(linkPhys, _pose->Data());
-
           // set entity world linear velocity
           *_worldLinearVel = components::WorldLinearVelocity(
-              math::eigen3::convert(entityFrameData.linearVelocity));
+              math::eigen3::convert(entityFrameData->linearVelocity));
         }
 
         return true;
       });
 
   // body angular velocity
-  _ecm.Each<components::Pose, components::AngularVelocity,
+  _ecm.EachParallel<components::Pose, components::AngularVelocity,
             components::ParentEntity>(
       [&](const Entity &,
           const components::Pose *_pose,
@@ -2991,14 +4113,11 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
           const components::ParentEntity *_parent)->bool
       {
         // check if parent entity is a link, e.g. entity is sensor / collision
-        if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
+        if (auto entityFrameData = frameDataAtOffset(_parent, _pose))
         {
-          const auto entityFrameData =
-              this->LinkFrameDataAtOffset(linkPhys, _pose->Data());
-
-          auto entityWorldPose = math::eigen3::convert(entityFrameData.pose);
+          auto entityWorldPose = math::eigen3::convert(entityFrameData->pose);
           ignition::math::Vector3d entityWorldAngularVel =
-              math::eigen3::convert(entityFrameData.angularVelocity);
+              math::eigen3::convert(entityFrameData->angularVelocity);
 
           auto entityBodyAngularVel =
               entityWorldPose.Rot().RotateVectorReverse(entityWorldAngularVel);
@@ -3009,21 +4128,18 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
       });
 
   // body linear acceleration
-  _ecm.Each<components::Pose, components::LinearAcceleration,
+  _ecm.EachParallel<components::Pose, components::LinearAcceleration,
             components::ParentEntity>(
       [&](const Entity &,
           const components::Pose *_pose,
           components::LinearAcceleration *_linearAcc,
           const components::ParentEntity *_parent)->bool
       {
-        if (auto linkPhys = this->entityLinkMap.Get(_parent->Data()))
+        if (auto entityFrameData = frameDataAtOffset(_parent, _pose))
         {
-          const auto entityFrameData =
-              this->LinkFrameDataAtOffset(linkPhys, _pose->Data());
-
-          auto entityWorldPose = math::eigen3::convert(entityFrameData.pose);
+          auto entityWorldPose = math::eigen3::convert(entityFrameData->pose);
           ignition::math::Vector3d entityWorldLinearAcc =
-              math::eigen3::convert(entityFrameData.linearAcceleration);
+              math::eigen3::convert(entityFrameData->linearAcceleration);
 
           auto entityBodyLinearAcc =
               entityWorldPose.Rot().RotateVectorReverse(entityWorldLinearAcc);
@@ -3037,12 +4153,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // Clear reset components
   IGN_PROFILE_BEGIN("Clear / reset components");
   std::vector<Entity> entitiesPositionReset;
-  _ecm.Each<components::JointPositionReset>(
-      [&](const Entity &_entity, components::JointPositionReset *) -> bool
-      {
-        entitiesPositionReset.push_back(_entity);
-        return true;
-      });
+  AddEntitiesWith<components::JointPositionReset>(_ecm,
+      entitiesPositionReset);
 
   for (const auto entity : entitiesPositionReset)
   {
@@ -3050,12 +4162,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   }
 
   std::vector<Entity> entitiesVelocityReset;
-  _ecm.Each<components::JointVelocityReset>(
-      [&](const Entity &_entity, components::JointVelocityReset *) -> bool
-      {
-        entitiesVelocityReset.push_back(_entity);
-        return true;
-      });
+  AddEntitiesWith<components::JointVelocityReset>(_ecm,
+      entitiesVelocityReset);
 
   for (const auto entity : entitiesVelocityReset)
   {
@@ -3063,13 +4171,8 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   }
 
   std::vector<Entity> entitiesCustomContactSurface;
-  _ecm.Each<components::EnableContactSurfaceCustomization>(
-      [&](const Entity &_entity,
-      components::EnableContactSurfaceCustomization *) -> bool
-      {
-        entitiesCustomContactSurface.push_back(_entity);
-        return true;
-      });
+  AddEntitiesWith<components::EnableContactSurfaceCustomization>(_ecm,
+      entitiesCustomContactSurface);
 
   for (const auto entity : entitiesCustomContactSurface)
   {
@@ -3118,13 +4221,6 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
         std::fill(_vel->Data().begin(), _vel->Data().end(), 0.0);
         return true;
       });
-
-  _ecm.Each<components::SlipComplianceCmd>(
-      [&](const Entity &, components::SlipComplianceCmd *_slip) -> bool
-      {
-        std::fill(_slip->Data().begin(), _slip->Data().end(), 0.0);
-        return true;
-      });
   IGN_PROFILE_END();
 
   _ecm.Each<components::AngularVelocityCmd>(
@@ -3143,39 +4239,42 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 
   // Update joint positions
   IGN_PROFILE_BEGIN("Joints");
-  _ecm.Each<components::Joint, components::JointPosition>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointPosition *_jointPos) -> bool
+  // Reading joint states doesn't modify the physics engine, so joints are
+  // split among the workers. SetChanged can't be called concurrently, so
+  // changes are marked afterwards.
+  this->UpdateJointReadbacks(_ecm);
+  _ecm.ParallelFor(this->jointReadbacks.size(),
+      [&](std::size_t _begin, std::size_t _end)
       {
-        if (auto jointPhys = this->entityJointMap.Get(_entity))
+        for (std::size_t i = _begin; i < _end; ++i)
         {
-          _jointPos->Data().resize(jointPhys->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom(); ++i)
+          const auto &readback = this->jointReadbacks[i];
+          const std::size_t dofs = readback.joint->GetDegreesOfFreedom();
+          if (nullptr != readback.position)
           {
-            _jointPos->Data()[i] = jointPhys->GetPosition(i);
+            auto &positions = readback.position->Data();
+            positions.resize(dofs);
+            for (std::size_t dof = 0; dof < dofs; ++dof)
+              positions[dof] = readback.joint->GetPosition(dof);
           }
-          _ecm.SetChanged(_entity, components::JointPosition::typeId,
-              ComponentState::PeriodicChange);
-        }
-        return true;
-      });
-
-  // Update joint Velocities
-  _ecm.Each<components::Joint, components::JointVelocity>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointVelocity *_jointVel) -> bool
-      {
-        if (auto jointPhys = this->entityJointMap.Get(_entity))
-        {
-          _jointVel->Data().resize(jointPhys->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom();
-               ++i)
+          if (nullptr != readback.velocity)
           {
-            _jointVel->Data()[i] = jointPhys->GetVelocity(i);
+            auto &velocities = readback.velocity->Data();
+            velocities.resize(dofs);
+            for (std::size_t dof = 0; dof < dofs; ++dof)
+              velocities[dof] = readback.joint->GetVelocity(dof);
           }
         }
-        return true;
-      });
+      }, kMinWriteBackChunk);
+
+  for (const auto &readback : this->jointReadbacks)
+  {
+    if (nullptr != readback.position)
+    {
+      _ecm.SetChanged(readback.entity, components::JointPosition::typeId,
+          ComponentState::PeriodicChange);
+    }
+  }
   IGN_PROFILE_END();
 
   // Update joint transmitteds
@@ -3263,17 +4362,18 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     return;
   }
 
-  // Each contact object we get from ign-physics contains the EntityPtrs of the
-  // two colliding entities and other data about the contact such as the
-  // position. This map groups contacts so that it is easy to query all the
-  // contacts of one entity.
-  using EntityContactMap = std::unordered_map<Entity,
-      std::deque<const WorldShapeType::ContactPoint *>>;
-
-  // This data structure is essentially a mapping between a pair of entities and
-  // a list of pointers to their contact object. We use a map inside a map to
-  // create msgs::Contact objects conveniently later on.
-  std::unordered_map<Entity, EntityContactMap> entityContactMap;
+  // Only contacts involving a collision with a ContactSensorData component
+  // are converted
+  this->contactSensorCollisions.clear();
+  _ecm.Each<components::Collision, components::ContactSensorData>(
+      [&](const Entity &_entity, const components::Collision *,
+          const components::ContactSensorData *) -> bool
+      {
+        this->contactSensorCollisions.insert(_entity);
+        return true;
+      });
+  if (this->contactSensorCollisions.empty())
+    return;
 
   // Note that we are temporarily storing pointers to elements in this
   // ("allContacts") container. Thus, we must make sure it doesn't get destroyed
@@ -3281,6 +4381,7 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
   auto allContacts =
       std::move(worldCollisionFeature->GetContactsFromLastStep());
 
+  this->sensorContacts.clear();
   for (const auto &contactComposite : allContacts)
   {
     const auto &contact = contactComposite.Get<WorldShapeType::ContactPoint>();
@@ -3289,13 +4390,24 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     auto coll2Entity =
       this->entityCollisionMap.GetByPhysicsId(contact.collision2->EntityID());
 
-    if (coll1Entity != kNullEntity && coll2Entity != kNullEntity)
-    {
-      entityContactMap[coll1Entity][coll2Entity].push_back(&contact);
-      entityContactMap[coll2Entity][coll1Entity].push_back(&contact);
-    }
+    if (coll1Entity == kNullEntity || coll2Entity == kNullEntity)
+      continue;
+
+    if (this->contactSensorCollisions.count(coll1Entity) > 0u)
+      this->sensorContacts.push_back({coll1Entity, coll2Entity, &contact});
+    if (this->contactSensorCollisions.count(coll2Entity) > 0u)
+      this->sensorContacts.push_back({coll2Entity, coll1Entity, &contact});
   }
 
+  // Group the contacts of each pair of collisions, keeping the order in which
+  // the engine reported them
+  std::stable_sort(this->sensorContacts.begin(), this->sensorContacts.end(),
+      [](const SensorContact &_a, const SensorContact &_b)
+      {
+        return std::tie(_a.sensorCollision, _a.otherCollision) <
+               std::tie(_b.sensorCollision, _b.otherCollision);
+      });
+
   // Go through each collision entity that has a ContactData component and
   // set the component value to the list of contacts that correspond to
   // the collision entity
@@ -3303,40 +4415,41 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       [&](const Entity &_collEntity1, components::Collision *,
           components::ContactSensorData *_contacts) -> bool
       {
-        msgs::Contacts contactsComp;
-        if (entityContactMap.find(_collEntity1) == entityContactMap.end())
-        {
-          // Clear the last contact data
-          auto state = _contacts->SetData(contactsComp,
-            this->contactsEql) ?
-            ComponentState::PeriodicChange :
-            ComponentState::NoChange;
-          _ecm.SetChanged(
-            _collEntity1, components::ContactSensorData::typeId, state);
-          return true;
-        }
+        auto range = std::equal_range(this->sensorContacts.begin(),
+            this->sensorContacts.end(), SensorContact{_collEntity1},
+            [](const SensorContact &_a, const SensorContact &_b)
+            {
+              return _a.sensorCollision < _b.sensorCollision;
+            });
 
-        const auto &contactMap = entityContactMap[_collEntity1];
+        // Clearing keeps the allocated contacts, which are reused below
+        auto &contactsComp = this->contactsBuffer;
+        contactsComp.Clear();
 
-        for (const auto &[collEntity2, contactData] : contactMap)
+        msgs::Contact *contactMsg{nullptr};
+        for (auto it = range.first; it != range.second; ++it)
         {
-          msgs::Contact *contactMsg = contactsComp.add_contact();
-          contactMsg->mutable_collision1()->set_id(_collEntity1);
-          contactMsg->mutable_collision2()->set_id(collEntity2);
-          if (this->contactsEntityNames)
+          const Entity collEntity2 = it->otherCollision;
+          if (nullptr == contactMsg ||
+              static_cast<Entity>(contactMsg->collision2().id()) !=
+              collEntity2)
           {
-            contactMsg->mutable_collision1()->set_name(
-              removeParentScope(scopedName(_collEntity1, _ecm, "::", 0), "::"));
-            contactMsg->mutable_collision2()->set_name(
-              removeParentScope(scopedName(collEntity2, _ecm, "::", 0), "::"));
-          }
-          for (const auto &contact : contactData)
-          {
-            auto *position = contactMsg->add_position();
-            position->set_x(contact->point.x());
-            position->set_y(contact->point.y());
-            position->set_z(contact->point.z());
+            contactMsg = contactsComp.add_contact();
+            contactMsg->mutable_collision1()->set_id(_collEntity1);
+            contactMsg->mutable_collision2()->set_id(collEntity2);
+            if (this->contactsEntityNames)
+            {
+              contactMsg->mutable_collision1()->set_name(
+                  this->ContactCollisionName(_collEntity1, _ecm));
+              contactMsg->mutable_collision2()->set_name(
+                  this->ContactCollisionName(collEntity2, _ecm));
+            }
           }
+
+          auto *position = contactMsg->add_position();
+          position->set_x(it->point->point.x());
+          position->set_y(it->point->point.y());
+          position->set_z(it->point->point.z());
         }
 
         auto state = _contacts->SetData(contactsComp,
@@ -3350,14 +4463,63 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+const std::string &PhysicsPrivate::ContactCollisionName(
+    const Entity _collision, const EntityComponentManager &_ecm)
+{
+  auto it = this->contactCollisionNames.find(_collision);
+  if (it == this->contactCollisionNames.end())
+  {
+    it = this->contactCollisionNames.emplace(_collision, removeParentScope(
+        scopedName(_collision, _ecm, "::", 0), "::")).first;
+  }
+  return it->second;
+}
+
 //////////////////////////////////////////////////
 physics::FrameData3d PhysicsPrivate::LinkFrameDataAtOffset(
-      const LinkPtrType &_link, const math::Pose3d &_pose) const
+      const physics::FrameData3d &_link, const math::Pose3d &_pose)
 {
-  physics::FrameData3d parent;
-  parent.pose = math::eigen3::convert(_pose);
-  physics::RelativeFrameData3d relFrameData(_link->GetFrameID(), parent);
-  return this->engine->Resolve(relFrameData, physics::FrameID::World());
+  // The entity is rigidly attached to the link, so it shares the link's
+  // angular quantities and its linear ones pick up the lever arm terms
+  const Eigen::Vector3d offset =
+      _link.pose.linear() * math::eigen3::convert(_pose.Pos());
+  const Eigen::Vector3d &angularVel = _link.angularVelocity;
+
+  physics::FrameData3d data;
+  data.pose = _link.pose * math::eigen3::convert(_pose);
+  data.linearVelocity = _link.linearVelocity + angularVel.cross(offset);
+  data.angularVelocity = angularVel;
+  data.linearAcceleration = _link.linearAcceleration +
+      _link.angularAcceleration.cross(offset) +
+      angularVel.cross(angularVel.cross(offset));
+  data.angularAcceleration = _link.angularAcceleration;
+  return data;
+}
+
+//////////////////////////////////////////////////
+template <typename ComponentT>
+void PhysicsPrivate::AddParentLinkFrameData(
+    const EntityComponentManager &_ecm,
+    std::unordered_map<Entity, physics::FrameData3d> &_data)
+{
+  _ecm.Each<components::Pose, ComponentT, components::ParentEntity>(
+      [&](const Entity &, const components::Pose *, const ComponentT *,
+          const components::ParentEntity *_parent)->bool
+      {
+        const Entity parent = _parent->Data();
+        if (_data.find(parent) != _data.end())
+          return true;
+
+        // Parents which aren't links, such as joints, are skipped
+        physics::FrameData3d frameData;
+        if (this->entityLinkMap.HasEntity(parent) &&
+            this->GetFrameDataRelativeToWorld(parent, frameData))
+        {
+          _data[parent] = frameData;
+        }
+        return true;
+      });
 }
 
 //////////////////////////////////////////////////
@@ -3393,10 +4555,19 @@ void PhysicsPrivate::EnableContactSurfaceCustomization(const Entity &_world)
 
         // check if at least one of the entities wants contact surface
         // customization
-        if (this->customContactSurfaceEntities[_world].find(coll1Entity) ==
-          this->customContactSurfaceEntities[_world].end() &&
-          this->customContactSurfaceEntities[_world].find(coll2Entity) ==
-          this->customContactSurfaceEntities[_world].end())
+        const auto &customEntities = this->customContactSurfaceEntities[_world];
+        if (customEntities.find(coll1Entity) == customEntities.end() &&
+          customEntities.find(coll2Entity) == customEntities.end())
+        {
+          return;
+        }
+
+        // skip building the contact data if nobody would receive it
+        if (!this->collectContactSurfaceChannel.Connected() &&
+          this->contactSurfaceHandlers.find(coll1Entity) ==
+            this->contactSurfaceHandlers.end() &&
+          this->contactSurfaceHandlers.find(coll2Entity) ==
+            this->contactSurfaceHandlers.end())
         {
           return;
         }
@@ -3412,12 +4583,30 @@ void PhysicsPrivate::EnableContactSurfaceCustomization(const Entity &_world)
           depth = extraData->depth;
         }
 
+        const auto point = math::eigen3::convert(contact.point);
+
+        // call only the handlers of the collisions in this contact, if any
+        bool handled{false};
+        for (const Entity collision : {coll1Entity, coll2Entity})
+        {
+          auto handlersIt = this->contactSurfaceHandlers.find(collision);
+          if (handlersIt == this->contactSurfaceHandlers.end())
+            continue;
+          for (const auto &handler : handlersIt->second)
+          {
+            handler.second(coll1Entity, coll2Entity, point, force, normal,
+                depth, _numContactsOnCollision, _params);
+          }
+          handled = true;
+        }
+        if (handled)
+          return;
+
         // broadcast the event that we want to collect the customized
         // contact surface properties; each connected client should
         // filter in the callback to treat just the entities it knows
-        this->eventManager->
-          Emit<events::CollectContactSurfaceProperties>(
-            coll1Entity, coll2Entity, math::eigen3::convert(contact.point),
+        this->collectContactSurfaceChannel.Emit(
+            coll1Entity, coll2Entity, point,
             force, normal, depth, _numContactsOnCollision, _params);
       }
   );
@@ -3454,6 +4643,7 @@ void PhysicsPrivate::DisableContactSurfaceCustomization(const Entity &_world)
 IGNITION_ADD_PLUGIN(Physics,
                     ignition::gazebo::System,
                     Physics::ISystemConfigure,
-                    Physics::ISystemUpdate)
+                    Physics::ISystemUpdate,
+                    Physics::ISystemReset)
 
 IGNITION_ADD_PLUGIN_ALIAS(Physics, "ignition::gazebo::systems::Physics")
@@ -76,11 +76,33 @@ namespace systems
   ///    </contacts>
   ///  </plugin>
   ///  ```
+  ///
+  /// Includes optional parameter : <substeps>. Number of physics engine
+  /// steps taken on each simulation iteration, splitting the iteration's
+  /// step size evenly. Joint force and velocity commands and link wrenches
+  /// are held constant across substeps, and the ECM is only updated after
+  /// the last one, so other systems keep running at the iteration rate.
+  /// Contacts are the ones of the last substep. Defaults to 1. Usage :
+  /// ```
+  ///  <plugin
+  ///    filename="ignition-gazebo-physics-system"
+  ///    name="ignition::gazebo::systems::Physics">
+  ///    <substeps>4</substeps>
+  ///  </plugin>
+  ///  ```
+  ///
+  /// All bodies of a world live in a single engine world, which is stepped
+  /// on the simulation thread. There's no mode that splits a world into
+  /// independently stepped islands: ign-physics can't move bodies between
+  /// engine worlds, nor detect contacts across them. Worlds with many
+  /// robots that never interact can be split across server processes, for
+  /// example with distributed simulation.
 
   class Physics:
     public System,
     public ISystemConfigure,
-    public ISystemUpdate
+    public ISystemUpdate,
+    public ISystemReset
   {
     /// \brief Constructor
     public: explicit Physics();
@@ -98,6 +120,10 @@ namespace systems
     public: void Update(const UpdateInfo &_info,
                 EntityComponentManager &_ecm) final;
 
+    /// Documentation inherited
+    public: void Reset(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) final;
+
     /// \brief Private data pointer.
     private: std::unique_ptr<PhysicsPrivate> dataPtr;
   };
@@ -17,6 +17,8 @@
 
 #include <ignition/msgs/dataframe.pb.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <list>
 #include <random>
@@ -105,6 +107,37 @@ struct RadioConfiguration
   }
 };
 
+/// \brief Type for holding RF power as a Normally distributed random variable.
+struct RFPower
+{
+  /// \brief Expected value of RF power.
+  double mean;
+
+  /// \brief Variance of RF power.
+  double variance;
+
+  /// \brief double operator.
+  /// \return the RFPower as a double.
+  operator double() const
+  {
+    return mean;
+  }
+};
+
+/// \brief Received power between two radios, cached while neither of them
+/// moves.
+struct PathlossEntry
+{
+  /// \brief Pose version of the transmitter when the power was computed.
+  uint64_t txPoseVersion = 0;
+
+  /// \brief Pose version of the receiver when the power was computed.
+  uint64_t rxPoseVersion = 0;
+
+  /// \brief Received power distribution.
+  RFPower power{0.0, 0.0};
+};
+
 /// \brief Store radio state
 ///
 /// Structure to hold radio state including the pose and book-keeping
@@ -117,6 +150,16 @@ struct RadioState
   /// \brief Pose of the radio.
   ignition::math::Pose3<double> pose;
 
+  /// \brief Change tick at which the pose was last computed.
+  uint64_t poseTick = 0;
+
+  /// \brief Incremented whenever the pose changes.
+  uint64_t poseVersion = 0;
+
+  /// \brief Received power at each receiver this radio sent to, keyed by
+  /// the receiver's state.
+  std::unordered_map<const RadioState *, PathlossEntry> pathloss;
+
   /// \brief Recent sent packet history.
   std::list<std::pair<double, uint64_t>> bytesSent;
 
@@ -130,23 +173,6 @@ struct RadioState
   uint64_t bytesReceivedThisEpoch = 0;
 };
 
-/// \brief Type for holding RF power as a Normally distributed random variable.
-struct RFPower
-{
-  /// \brief Expected value of RF power.
-  double mean;
-
-  /// \brief Variance of RF power.
-  double variance;
-
-  /// \brief double operator.
-  /// \return the RFPower as a double.
-  operator double() const
-  {
-    return mean;
-  }
-};
-
 /// \brief Private RFComms data class.
 class ignition::gazebo::systems::RFComms::Implementation
 {
@@ -189,6 +215,22 @@ class ignition::gazebo::systems::RFComms::Implementation
                                           const RadioState &_txState,
                                           const RadioState &_rxState) const;
 
+  /// \brief Get the received power between two radios, reusing the value
+  /// computed on a previous step if neither radio moved since.
+  /// \param[in out] _txState Radio state of the transmitter.
+  /// \param[in] _rxState Radio state of the receiver.
+  /// \return The RFPower pathloss distribution of the two antenna poses.
+  private: const RFPower &ReceivedPower(RadioState &_txState,
+                                        const RadioState &_rxState) const;
+
+  /// \brief Get the latest change tick of the pose of an entity and all of
+  /// its ancestors, which all contribute to its world pose.
+  /// \param[in] _entity Entity.
+  /// \param[in] _ecm Entity component manager.
+  /// \return The latest change tick.
+  public: uint64_t PoseChangeTick(const Entity _entity,
+                                  const EntityComponentManager &_ecm) const;
+
   /// \brief Range configuration.
   public: RangeConfiguration rangeConfig;
 
@@ -237,6 +279,37 @@ RFPower RFComms::Implementation::LogNormalReceivedPower(
   return {_txPower - kPL, this->rangeConfig.sigma};
 }
 
+/////////////////////////////////////////////
+const RFPower &RFComms::Implementation::ReceivedPower(
+  RadioState &_txState, const RadioState &_rxState) const
+{
+  auto [it, isNew] = _txState.pathloss.try_emplace(&_rxState);
+  auto &entry = it->second;
+  if (isNew || entry.txPoseVersion != _txState.poseVersion ||
+      entry.rxPoseVersion != _rxState.poseVersion)
+  {
+    entry.txPoseVersion = _txState.poseVersion;
+    entry.rxPoseVersion = _rxState.poseVersion;
+    entry.power = this->LogNormalReceivedPower(
+      this->radioConfig.txPower, _txState, _rxState);
+  }
+  return entry.power;
+}
+
+/////////////////////////////////////////////
+uint64_t RFComms::Implementation::PoseChangeTick(const Entity _entity,
+  const EntityComponentManager &_ecm) const
+{
+  uint64_t tick = 0;
+  for (auto entity = _entity; entity != kNullEntity;
+       entity = _ecm.ParentEntity(entity))
+  {
+    tick = std::max(tick,
+      _ecm.ComponentChangeTick(entity, components::Pose::typeId));
+  }
+  return tick;
+}
+
 /////////////////////////////////////////////
 std::tuple<bool, double> RFComms::Implementation::AttemptSend(
   RadioState &_txState, RadioState &_rxState, const uint64_t &_numBytes)
@@ -272,8 +345,12 @@ std::tuple<bool, double> RFComms::Implementation::AttemptSend(
   _txState.bytesSentThisEpoch += _numBytes;
 
   // Get the received power based on TX power and position of each node.
-  auto rxPowerDist =
-    this->LogNormalReceivedPower(this->radioConfig.txPower, _txState, _rxState);
+  const auto &rxPowerDist = this->ReceivedPower(_txState, _rxState);
+
+  // Destinations out of range never receive the packet, so there's no need
+  // to evaluate the error model.
+  if (std::isinf(rxPowerDist.mean) && rxPowerDist.mean < 0.0)
+    return std::make_tuple(false, std::numeric_limits<double>::lowest());
 
   double rxPower = rxPowerDist.mean;
   if (rxPowerDist.variance > 0.0)
@@ -417,10 +494,23 @@ void RFComms::Step(
     else
     {
       // Update radio state.
-      const auto kPose = gazebo::worldPose(content.entity, _ecm);
-      this->dataPtr->radioStates[address].pose = kPose;
-      this->dataPtr->radioStates[address].timeStamp =
-        std::chrono::duration<double>(_info.simTime).count();
+      auto &state = this->dataPtr->radioStates[address];
+      state.timeStamp = std::chrono::duration<double>(_info.simTime).count();
+
+      // Only recompute the pose if it may have changed since it was last
+      // computed. Changes made later during the tick at which it was
+      // computed have the same tick, so they're checked again.
+      if (state.poseTick == 0 || this->dataPtr->PoseChangeTick(
+          content.entity, _ecm) >= state.poseTick)
+      {
+        const auto kPose = gazebo::worldPose(content.entity, _ecm);
+        if (state.poseTick == 0 || kPose != state.pose)
+        {
+          state.pose = kPose;
+          ++state.poseVersion;
+        }
+        state.poseTick = std::max<uint64_t>(_ecm.ChangeTick(), 1);
+      }
     }
   }
 
@@ -450,16 +540,14 @@ void RFComms::Step(
 
         if (sendPacket)
         {
-          // We create a copy of the outbound message because each destination
-          // might have a different rssi value.
-          auto inboundMsg = std::make_shared<ignition::msgs::Dataframe>(*msg);
-
-          // Add rssi.
-          auto *rssiPtr = inboundMsg->mutable_header()->add_data();
+          // Each message has a single destination and is removed from the
+          // outbound queue below, so the rssi can be attached to the message
+          // itself instead of to a copy of it.
+          auto *rssiPtr = msg->mutable_header()->add_data();
           rssiPtr->set_key("rssi");
           rssiPtr->add_value(std::to_string(rssi));
 
-          _newRegistry[msg->dst_address()].inboundMsgs.push_back(inboundMsg);
+          _newRegistry[msg->dst_address()].inboundMsgs.push_back(msg);
         }
       }
     }
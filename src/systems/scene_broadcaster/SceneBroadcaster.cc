@@ -17,16 +17,25 @@
 
 #include "SceneBroadcaster.hh"
 
+#include <ignition/msgs/bytes.pb.h>
+#include <ignition/msgs/param.pb.h>
 #include <ignition/msgs/scene.pb.h>
 
 #include <algorithm>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
+#include <set>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
+#include <ignition/math/AxisAlignedBox.hh>
 #include <ignition/math/graph/Graph.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
@@ -37,6 +46,7 @@
 #include "ignition/gazebo/components/CastShadows.hh"
 #include "ignition/gazebo/components/ContactSensor.hh"
 #include "ignition/gazebo/components/DepthCamera.hh"
+#include "ignition/gazebo/components/Factory.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/GpuLidar.hh"
 #include "ignition/gazebo/components/Imu.hh"
@@ -60,6 +70,9 @@
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EntityComponentSnapshot.hh"
+#include "ignition/gazebo/PoseStreamCodec.hh"
+#include "ignition/gazebo/Util.hh"
 
 #include <sdf/Camera.hh>
 #include <sdf/Imu.hh>
@@ -74,6 +87,51 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Approximate size of each message sent by the chunked state
+/// service, in bytes. Entities aren't split, so a single large entity may
+/// exceed it.
+static constexpr std::size_t kStateChunkBytes{4u << 20};
+
+/////////////////////////////////////////////////
+/// \brief Get the next entry of a pose message which is reused across
+/// publications. Entries are visited in the same order on every publication
+/// unless entities are added or removed, so the entry usually already
+/// belongs to the entity and only its numeric fields need to be written.
+/// \param[in,out] _msg Reused pose message.
+/// \param[in,out] _count Number of entries filled so far, incremented.
+/// \param[in] _entity Entity of the entry.
+/// \param[in] _name Name of the entity, or nullptr to leave names out.
+/// \return The entry, to be filled with the entity's pose.
+static msgs::Pose *NextPose(msgs::Pose_V &_msg, int &_count,
+    const Entity _entity, const std::string *_name)
+{
+  msgs::Pose *pose = _count < _msg.pose_size() ?
+      _msg.mutable_pose(_count) : _msg.add_pose();
+  ++_count;
+
+  if (pose->id() != _entity)
+  {
+    pose->set_id(_entity);
+    if (nullptr != _name)
+      pose->set_name(*_name);
+    else
+      pose->clear_name();
+  }
+  return pose;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove the entries of a reused pose message which weren't filled
+/// on this publication. Removed entries are kept by protobuf, to be reused
+/// when the message grows again.
+/// \param[in,out] _msg Reused pose message.
+/// \param[in] _count Number of entries filled on this publication.
+static void TruncatePoses(msgs::Pose_V &_msg, const int _count)
+{
+  while (_msg.pose_size() > _count)
+    _msg.mutable_pose()->RemoveLast();
+}
+
 // Private data class.
 class ignition::gazebo::systems::SceneBroadcasterPrivate
 {
@@ -81,6 +139,60 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   public: using SceneGraphType = math::graph::DirectedGraph<
           std::shared_ptr<google::protobuf::Message>, bool>;
 
+  /// \brief Pose messages of a pose topic which are handed over to the
+  /// broadcaster thread. Messages are swapped rather than copied, so that
+  /// their entries keep being reused.
+  public: struct PoseBuffer
+  {
+    /// \brief Latest message, waiting to be published.
+    msgs::Pose_V pending;
+
+    /// \brief Message being published by the broadcaster thread.
+    msgs::Pose_V publishing;
+
+    /// \brief Whether the publication of `pending` is in the queue. Later
+    /// messages replace `pending` until it's published, since only the
+    /// latest poses matter.
+    bool queued{false};
+  };
+
+  /// \brief Publication waiting for the broadcaster thread.
+  public: struct Publication
+  {
+    /// \brief Publisher of the message.
+    transport::Node::Publisher *pub{nullptr};
+
+    /// \brief Message to publish, null to publish a pose buffer.
+    std::unique_ptr<google::protobuf::Message> msg;
+
+    /// \brief Pose buffer to publish, if msg is null.
+    PoseBuffer *poses{nullptr};
+  };
+
+  /// \brief Destructor. Stops the broadcaster thread.
+  public: ~SceneBroadcasterPrivate();
+
+  /// \brief Hand a message over to the broadcaster thread to be published.
+  /// Messages are published in the order they're queued.
+  /// \param[in] _pub Publisher of the message.
+  /// \param[in] _msg Message to publish.
+  public: void Queue(transport::Node::Publisher &_pub,
+      std::unique_ptr<google::protobuf::Message> _msg);
+
+  /// \brief Hand a pose message over to the broadcaster thread to be
+  /// published, replacing any message of the same topic which hasn't been
+  /// published yet.
+  /// \param[in] _pub Publisher of the message.
+  /// \param[in,out] _msg Message to publish. It's swapped with a previous
+  /// message of the topic, to be filled again.
+  /// \param[in] _buffer Buffer of the topic.
+  public: void QueuePoses(transport::Node::Publisher &_pub,
+      msgs::Pose_V &_msg, PoseBuffer &_buffer);
+
+  /// \brief Broadcaster thread, which publishes the queued messages so
+  /// that the simulation thread never waits on transport.
+  public: void PublishLoop();
+
   /// \brief Setup Ignition transport services and publishers
   /// \param[in] _worldName Name of world.
   public: void SetupTransport(const std::string &_worldName);
@@ -104,6 +216,60 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \param[out] _res Response containing the last available full state.
   public: void StateAsyncService(const ignition::msgs::StringMsg &_req);
 
+  /// \brief Callback for the chunked state service - non blocking. The full
+  /// state is sent to the given service in chunks of at most about
+  /// kStateChunkBytes, serialized from a snapshot off the simulation thread.
+  /// Each chunk has a `chunk` header key with its index, and the last one
+  /// also has a `chunk_count` key with the number of chunks.
+  /// \param[in] _req Service which receives the chunks.
+  public: void StateChunkedService(const ignition::msgs::StringMsg &_req);
+
+  /// \brief Callback for the filtered state service. Only the state of the
+  /// requested entities and component types is serialized, which keeps
+  /// queries about part of the world cheap on large worlds.
+  /// \param[in] _req Entities and component types to serialize.
+  /// \param[out] _res Response containing the filtered state.
+  /// \return True if successful.
+  public: bool FilteredStateService(const ignition::msgs::Param &_req,
+      ignition::msgs::SerializedStepMap &_res);
+
+  /// \brief Serialize the state for the pending filtered state requests.
+  /// \param[in] _info The update information
+  /// \param[in] _manager The entity component manager
+  public: void FilteredStateUpdate(const UpdateInfo &_info,
+      const EntityComponentManager &_manager);
+
+  /// \brief Start sending the full state to the pending chunked state
+  /// requests, unless a previous snapshot is still being sent.
+  /// \param[in] _info The update information
+  /// \param[in] _manager The entity component manager
+  public: void ChunkedStateUpdate(const UpdateInfo &_info,
+      const EntityComponentManager &_manager);
+
+  /// \brief Serialize a snapshot in chunks and send them. Runs off the
+  /// simulation thread.
+  /// \param[in] _snapshot Snapshot to send.
+  /// \param[in] _stats Statistics of the iteration of the snapshot.
+  /// \param[in] _services Services which receive the chunks.
+  public: void SendStateChunks(
+      std::shared_ptr<const EntityComponentSnapshot> _snapshot,
+      const msgs::WorldStatistics &_stats,
+      const std::vector<std::string> &_services);
+
+  /// \brief Callback for the interest service, which registers, updates or
+  /// removes an interest stream.
+  /// \param[in] _req Interest of the stream.
+  /// \param[out] _res Topic of the stream, empty if it was removed.
+  /// \return True if successful.
+  public: bool InterestService(const ignition::msgs::Param &_req,
+      ignition::msgs::StringMsg &_res);
+
+  /// \brief Publish the interest streams which are due.
+  /// \param[in] _info The update information
+  /// \param[in] _manager The entity component manager
+  public: void InterestUpdate(const UpdateInfo &_info,
+      const EntityComponentManager &_manager);
+
   /// \brief Updates the scene graph when entities are added
   /// \param[in] _manager The entity component manager
   public: void SceneGraphAddEntities(const EntityComponentManager &_manager);
@@ -112,6 +278,12 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \param[in] _manager The entity component manager
   public: void SceneGraphRemoveEntities(const EntityComponentManager &_manager);
 
+  /// \brief Update the cached messages of the scene and of the entities in
+  /// the graph whose components changed since sceneTick, so that they're
+  /// only converted again when their source changes.
+  /// \param[in] _manager The entity component manager
+  public: void SceneGraphUpdateEntities(const EntityComponentManager &_manager);
+
   /// \brief Adds models to a msgs::Scene or msgs::Model object based on the
   /// contents of the scene graph
   /// \tparam T Either a msgs::Scene or msgs::Model
@@ -166,6 +338,19 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   public: static void AddParticleEmitters(msgs::Link *_msg,
               const Entity _entity, const SceneGraphType &_graph);
 
+  /// \brief Get the child of the world which is, or is an ancestor of, an
+  /// entity in the scene graph. Must be called with graphMutex locked.
+  /// \param[in] _entity Entity in the scene graph.
+  /// \return The top level entity, or kNullEntity if _entity isn't in the
+  /// scene graph below the world.
+  public: Entity TopLevelEntity(const Entity _entity) const;
+
+  /// \brief Rebuild the cached scene message of a top level entity from the
+  /// scene graph, or drop it if the entity is no longer in the graph. Must be
+  /// called with graphMutex locked.
+  /// \param[in] _entity Top level entity.
+  public: void UpdateSceneCache(const Entity _entity);
+
   /// \brief Recursively remove entities from the graph
   /// \param[in] _entity Entity
   /// \param[in/out] _graph Scene graph
@@ -184,12 +369,65 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief Pose publisher.
   public: transport::Node::Publisher posePub;
 
+  /// \brief Pose messages handed over to the broadcaster thread.
+  public: PoseBuffer poseBuffer;
+
+  /// \brief Dynamic pose messages handed over to the broadcaster thread.
+  public: PoseBuffer dyPoseBuffer;
+
+  /// \brief Publications waiting for the broadcaster thread.
+  public: std::deque<Publication> publishQueue;
+
+  /// \brief Protects publishQueue, publishStop and the pose buffers.
+  public: std::mutex publishMutex;
+
+  /// \brief Wakes the broadcaster thread up.
+  public: std::condition_variable publishCv;
+
+  /// \brief Set to stop the broadcaster thread.
+  public: bool publishStop{false};
+
+  /// \brief Thread which publishes the queued messages.
+  public: std::thread publishThread;
+
   /// \brief Dynamic pose publisher, for non-static model poses
   public: transport::Node::Publisher dyPosePub;
 
   /// \brief Rate at which to publish dynamic poses
   public: int dyPoseHertz{60};
 
+  /// \brief Whether pose messages hold entity names. Receivers can resolve
+  /// names from the scene graph through the entity ids instead.
+  public: bool poseNames{true};
+
+  /// \brief Pose message, reused across publications.
+  public: msgs::Pose_V poseMsg;
+
+  /// \brief Dynamic pose message, reused across publications.
+  public: msgs::Pose_V dyPoseMsg;
+
+  /// \brief Whether the parent model of each link is static, in the order
+  /// links are visited. Cleared when entities or one-time changes may have
+  /// invalidated it.
+  public: std::vector<std::pair<Entity, bool>> linkStatic;
+
+  /// \brief Quantized dynamic pose publisher. Only advertised if the
+  /// quantized stream is enabled.
+  public: transport::Node::Publisher quantizedPosePub;
+
+  /// \brief Encoder of the quantized dynamic pose stream, null if the stream
+  /// is disabled.
+  public: std::unique_ptr<PoseStreamEncoder> poseEncoder;
+
+  /// \brief Reused buffer of dynamic poses to be encoded.
+  public: std::vector<EntityPose> quantizedPoses;
+
+  /// \brief Last time the quantized dynamic poses were published. The
+  /// stream is throttled here rather than by transport, so that dropped
+  /// frames are never keyframes.
+  public: std::chrono::time_point<std::chrono::steady_clock>
+      lastQuantizedPosePubTime;
+
   /// \brief Scene publisher
   public: transport::Node::Publisher scenePub;
 
@@ -218,6 +456,14 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief Protects scene graph.
   public: std::mutex graphMutex;
 
+  /// \brief Complete messages of the models which are children of the world,
+  /// with all their descendants, kept up to date as entities are added and
+  /// removed so that scene requests don't need to traverse the graph.
+  public: std::map<Entity, msgs::Model> sceneModels;
+
+  /// \brief Messages of the lights which are children of the world.
+  public: std::map<Entity, msgs::Light> sceneLights;
+
   /// \brief Protects stepMsg.
   public: std::mutex stateMutex;
 
@@ -249,11 +495,174 @@ class ignition::gazebo::systems::SceneBroadcasterPrivate
   /// \brief A list of async state requests
   public: std::unordered_set<std::string> stateRequests;
 
-  /// \brief Store SDF scene information so that it can be inserted into
-  /// scene message.
-  public: sdf::Scene sdfScene;
+  /// \brief State stream for the clients interested in part of the world.
+  public: struct InterestStream
+  {
+    /// \brief Publisher of the stream.
+    transport::Node::Publisher pub;
+
+    /// \brief Whether top level entities inside the region are relevant.
+    bool hasRegion{false};
+
+    /// \brief Region of interest, in the world frame.
+    math::AxisAlignedBox region;
+
+    /// \brief Entities which are relevant wherever they are.
+    std::unordered_set<Entity> entities;
+
+    /// \brief Component types which are sent, empty to send all types.
+    std::unordered_set<ComponentTypeId> types;
+
+    /// \brief True if the full state has been sent, for streams without a
+    /// region nor entities, to which all entities are relevant.
+    bool sentFull{false};
+
+    /// \brief Period between publications.
+    std::chrono::duration<double> period{1.0 / 60.0};
+
+    /// \brief Last time the stream was published.
+    std::chrono::time_point<std::chrono::steady_clock> lastPubTime;
+
+    /// \brief Entities which were relevant on the last publication. Empty
+    /// when the next publication must carry the full state.
+    std::unordered_set<Entity> relevant;
+
+    /// \brief Change tick of the last publication.
+    uint64_t lastTick{0u};
+  };
+
+  /// \brief Interest streams, keyed by name.
+  public: std::map<std::string, InterestStream> interestStreams;
+
+  /// \brief Protects interestStreams.
+  public: std::mutex interestMutex;
+
+  /// \brief Scene properties converted from the world's Scene component,
+  /// which are inserted into scene messages. Protected by graphMutex.
+  public: msgs::Scene sceneProperties;
+
+  /// \brief Change tick up to which changes to the scene properties and to
+  /// the components of entities in the graph were applied.
+  public: uint64_t sceneTick{0u};
+
+  /// \brief Request for the filtered state service.
+  public: struct FilteredStateRequest
+  {
+    /// \brief Part of the world to be serialized.
+    struct Scope
+    {
+      /// \brief Scoped name of the entities, empty to use `entity`.
+      std::string name;
+
+      /// \brief Entity, used if there's no name.
+      Entity entity{kNullEntity};
+
+      /// \brief True to also serialize all descendants.
+      bool descendants{true};
+    };
+
+    /// \brief Parts of the world to be serialized, empty for all entities.
+    std::vector<Scope> scopes;
+
+    /// \brief Component types to be serialized, empty for all types.
+    std::unordered_set<ComponentTypeId> types;
+
+    /// \brief Filled on the simulation thread.
+    msgs::SerializedStepMap res;
+
+    /// \brief True once res has been filled.
+    bool done{false};
+  };
+
+  /// \brief Pending filtered state requests, owned by the service callbacks
+  /// waiting for them. Protected by stateMutex.
+  public: std::vector<FilteredStateRequest *> filteredStateRequests;
+
+  /// \brief Pending chunked state requests. Protected by stateMutex.
+  public: std::unordered_set<std::string> chunkedStateRequests;
+
+  /// \brief Sending of the latest snapshot to the chunked state requests.
+  /// Declared last so that it's waited for before anything it uses is
+  /// destroyed.
+  public: std::future<void> chunkFuture;
 };
 
+//////////////////////////////////////////////////
+SceneBroadcasterPrivate::~SceneBroadcasterPrivate()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->publishMutex);
+    this->publishStop = true;
+  }
+  this->publishCv.notify_all();
+  if (this->publishThread.joinable())
+    this->publishThread.join();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::Queue(transport::Node::Publisher &_pub,
+    std::unique_ptr<google::protobuf::Message> _msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->publishMutex);
+    this->publishQueue.push_back({&_pub, std::move(_msg), nullptr});
+  }
+  this->publishCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::QueuePoses(transport::Node::Publisher &_pub,
+    msgs::Pose_V &_msg, PoseBuffer &_buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->publishMutex);
+    _buffer.pending.Swap(&_msg);
+    if (_buffer.queued)
+      return;
+    _buffer.queued = true;
+    this->publishQueue.push_back({&_pub, nullptr, &_buffer});
+  }
+  this->publishCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::PublishLoop()
+{
+  IGN_PROFILE_THREAD_NAME("SceneBroadcaster");
+
+  std::unique_lock<std::mutex> lock(this->publishMutex);
+  while (true)
+  {
+    this->publishCv.wait(lock, [this]
+    {
+      return this->publishStop || !this->publishQueue.empty();
+    });
+    if (this->publishStop)
+      return;
+
+    auto publication = std::move(this->publishQueue.front());
+    this->publishQueue.pop_front();
+
+    // The buffer's latest message is taken now, so that messages queued
+    // while publishing go into a new publication
+    if (nullptr != publication.poses)
+    {
+      publication.poses->publishing.Swap(&publication.poses->pending);
+      publication.poses->queued = false;
+    }
+
+    lock.unlock();
+    {
+      IGN_PROFILE("SceneBroadcast::Publish");
+      if (nullptr != publication.poses)
+        publication.pub->Publish(publication.poses->publishing);
+      else
+        publication.pub->Publish(*publication.msg);
+    }
+    lock.lock();
+  }
+}
+
 //////////////////////////////////////////////////
 SceneBroadcaster::SceneBroadcaster()
   : System(), dataPtr(std::make_unique<SceneBroadcasterPrivate>())
@@ -280,6 +689,20 @@ void SceneBroadcaster::Configure(
   auto readHertz = _sdf->Get<int>("dynamic_pose_hertz", 60);
   this->dataPtr->dyPoseHertz = readHertz.first;
 
+  this->dataPtr->poseNames = _sdf->Get<bool>("pose_names",
+      this->dataPtr->poseNames).first;
+
+  if (_sdf->HasElement("quantized_dynamic_pose"))
+  {
+    auto quantizedElem = _sdf->FindElement("quantized_dynamic_pose");
+    PoseStreamOptions options;
+    options.positionResolution = quantizedElem->Get<double>(
+        "position_resolution", options.positionResolution).first;
+    options.keyframeInterval = quantizedElem->Get<unsigned int>(
+        "keyframe_interval", options.keyframeInterval).first;
+    this->dataPtr->poseEncoder = std::make_unique<PoseStreamEncoder>(options);
+  }
+
   auto stateHertz = _sdf->Get<double>("state_hertz", 60);
   if (stateHertz.first > 0.0)
   {
@@ -314,24 +737,31 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
 {
   IGN_PROFILE("SceneBroadcaster::PostUpdate");
 
-  // Update scene graph with added entities before populating pose message
+  // Update scene graph with changed and added entities before populating
+  // pose message
+  const uint64_t tick = _manager.ChangeTick();
+  this->dataPtr->SceneGraphUpdateEntities(_manager);
   if (_manager.HasNewEntities())
     this->dataPtr->SceneGraphAddEntities(_manager);
-
-  // Store the Scene component data, which holds sdf::Scene so that we can
-  // populate the scene info messages.
-  auto sceneComp =
-    _manager.Component<components::Scene>(this->dataPtr->worldEntity);
-  if (sceneComp)
-    this->dataPtr->sdfScene = sceneComp->Data();
+  this->dataPtr->sceneTick = tick;
 
   // Create and send pose update if transport connections exist.
   if (this->dataPtr->dyPosePub.HasConnections() ||
-      this->dataPtr->posePub.HasConnections())
+      this->dataPtr->posePub.HasConnections() ||
+      this->dataPtr->quantizedPosePub.HasConnections())
   {
     this->dataPtr->PoseUpdate(_info, _manager);
   }
 
+  // Full state in chunks, for clients which can't take it in one message
+  this->dataPtr->ChunkedStateUpdate(_info, _manager);
+
+  // Part of the state, for clients which asked for specific entities
+  this->dataPtr->FilteredStateUpdate(_info, _manager);
+
+  // State of the parts of the world which interest each group of clients
+  this->dataPtr->InterestUpdate(_info, _manager);
+
   // call SceneGraphRemoveEntities at the end of this update cycle so that
   // removed entities are removed from the scene graph for the next update cycle
   this->dataPtr->SceneGraphRemoveEntities(_manager);
@@ -362,7 +792,8 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
     set(this->dataPtr->stepMsg.mutable_stats(), _info);
 
     // Publish full state if it has been explicitly requested
-    if (this->dataPtr->stateServiceRequest)
+    const bool fullStateRequested = this->dataPtr->stateServiceRequest;
+    if (fullStateRequested)
     {
       _manager.State(*this->dataPtr->stepMsg.mutable_state(), {}, {}, true);
     }
@@ -403,7 +834,15 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
     if (shouldPublish)
     {
       IGN_PROFILE("SceneBroadcast::PostUpdate Publish State");
-      this->dataPtr->statePub.Publish(this->dataPtr->stepMsg);
+
+      // The message is only kept for the state service, it's handed over
+      // whole otherwise
+      auto stateMsg = std::make_unique<msgs::SerializedStepMap>();
+      if (fullStateRequested)
+        stateMsg->CopyFrom(this->dataPtr->stepMsg);
+      else
+        stateMsg->Swap(&this->dataPtr->stepMsg);
+      this->dataPtr->Queue(this->dataPtr->statePub, std::move(stateMsg));
       this->dataPtr->lastStatePubTime = now;
     }
   }
@@ -415,10 +854,30 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
 {
   IGN_PROFILE("SceneBroadcast::PoseUpdate");
 
-  msgs::Pose_V poseMsg, dyPoseMsg;
   bool dyPoseConnections = this->dyPosePub.HasConnections();
   bool poseConnections = this->posePub.HasConnections();
 
+  // Throttle the quantized stream to the dynamic pose rate
+  bool quantizedConnections = false;
+  auto now = std::chrono::steady_clock::now();
+  if (this->quantizedPosePub.HasConnections() && this->dyPoseHertz > 0 &&
+      now - this->lastQuantizedPosePubTime >=
+      std::chrono::duration<double>(1.0 / this->dyPoseHertz))
+  {
+    quantizedConnections = true;
+    this->quantizedPoses.clear();
+  }
+
+  // Static flags may have changed along with the entities
+  if (_manager.HasNewEntities() || _manager.HasEntitiesMarkedForRemoval() ||
+      _manager.HasOneTimeComponentChanges())
+  {
+    this->linkStatic.clear();
+  }
+
+  int poseCount{0};
+  int dyPoseCount{0};
+
   // Models
   _manager.Each<components::Model, components::Name, components::Pose,
                 components::Static>(
@@ -427,27 +886,29 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           const components::Pose *_poseComp,
           const components::Static *_staticComp) -> bool
       {
+        const std::string *name =
+            this->poseNames ? &_nameComp->Data() : nullptr;
         if (poseConnections)
         {
           // Add to pose msg
-          auto pose = poseMsg.add_pose();
-          msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
-          pose->set_id(_entity);
+          msgs::Set(NextPose(this->poseMsg, poseCount, _entity, name),
+              _poseComp->Data());
         }
 
         if (dyPoseConnections && !_staticComp->Data())
         {
           // Add to dynamic pose msg
-          auto dyPose = dyPoseMsg.add_pose();
-          msgs::Set(dyPose, _poseComp->Data());
-          dyPose->set_name(_nameComp->Data());
-          dyPose->set_id(_entity);
+          msgs::Set(NextPose(this->dyPoseMsg, dyPoseCount, _entity, name),
+              _poseComp->Data());
         }
+
+        if (quantizedConnections && !_staticComp->Data())
+          this->quantizedPoses.emplace_back(_entity, _poseComp->Data());
         return true;
       });
 
   // Links
+  std::size_t linkCount{0u};
   _manager.Each<components::Link, components::Name, components::Pose,
                 components::ParentEntity>(
       [&](const Entity &_entity, const components::Link *,
@@ -455,43 +916,68 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           const components::Pose *_poseComp,
           const components::ParentEntity *_parentComp) -> bool
       {
+        const std::string *name =
+            this->poseNames ? &_nameComp->Data() : nullptr;
+
         // Add to pose msg
         if (poseConnections)
         {
-          auto pose = poseMsg.add_pose();
-          msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
-          pose->set_id(_entity);
+          msgs::Set(NextPose(this->poseMsg, poseCount, _entity, name),
+              _poseComp->Data());
         }
 
         // Check whether parent model is static
-        auto staticComp = _manager.Component<components::Static>(
-          _parentComp->Data());
-        if (dyPoseConnections && !staticComp->Data())
+        if (linkCount == this->linkStatic.size())
+          this->linkStatic.emplace_back(kNullEntity, false);
+        auto &cached = this->linkStatic[linkCount++];
+        if (cached.first != _entity)
+        {
+          auto staticComp = _manager.Component<components::Static>(
+            _parentComp->Data());
+          cached = {_entity, nullptr != staticComp && staticComp->Data()};
+        }
+        const bool isStatic = cached.second;
+
+        if (dyPoseConnections && !isStatic)
         {
           // Add to dynamic pose msg
-          auto dyPose = dyPoseMsg.add_pose();
-          msgs::Set(dyPose, _poseComp->Data());
-          dyPose->set_name(_nameComp->Data());
-          dyPose->set_id(_entity);
+          msgs::Set(NextPose(this->dyPoseMsg, dyPoseCount, _entity, name),
+              _poseComp->Data());
         }
 
+        if (quantizedConnections && !isStatic)
+          this->quantizedPoses.emplace_back(_entity, _poseComp->Data());
+
         return true;
       });
+  this->linkStatic.resize(linkCount);
 
   if (dyPoseConnections)
   {
+    TruncatePoses(this->dyPoseMsg, dyPoseCount);
+
     // Set the time stamp in the header
-    dyPoseMsg.mutable_header()->mutable_stamp()->CopyFrom(
+    this->dyPoseMsg.mutable_header()->mutable_stamp()->CopyFrom(
         convert<msgs::Time>(_info.simTime));
 
-    this->dyPosePub.Publish(dyPoseMsg);
+    this->QueuePoses(this->dyPosePub, this->dyPoseMsg, this->dyPoseBuffer);
+  }
+
+  if (quantizedConnections)
+  {
+    // Every frame is published, since frames are encoded relative to the
+    // previous ones
+    auto quantizedMsg = std::make_unique<msgs::Bytes>();
+    this->poseEncoder->Encode(this->quantizedPoses, _info.simTime,
+        *quantizedMsg->mutable_data());
+    this->Queue(this->quantizedPosePub, std::move(quantizedMsg));
+    this->lastQuantizedPosePubTime = now;
   }
 
   // Visuals
   if (poseConnections)
   {
-    poseMsg.mutable_header()->mutable_stamp()->CopyFrom(
+    this->poseMsg.mutable_header()->mutable_stamp()->CopyFrom(
         convert<msgs::Time>(_info.simTime));
 
     _manager.Each<components::Visual, components::Name, components::Pose>(
@@ -500,10 +986,9 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
           const components::Pose *_poseComp) -> bool
       {
         // Add to pose msg
-        auto pose = poseMsg.add_pose();
-        msgs::Set(pose, _poseComp->Data());
-        pose->set_name(_nameComp->Data());
-        pose->set_id(_entity);
+        msgs::Set(NextPose(this->poseMsg, poseCount, _entity,
+            this->poseNames ? &_nameComp->Data() : nullptr),
+            _poseComp->Data());
         return true;
       });
 
@@ -514,14 +999,247 @@ void SceneBroadcasterPrivate::PoseUpdate(const UpdateInfo &_info,
             const components::Pose *_poseComp) -> bool
         {
           // Add to pose msg
-          auto pose = poseMsg.add_pose();
-          msgs::Set(pose, _poseComp->Data());
-          pose->set_name(_nameComp->Data());
-          pose->set_id(_entity);
+          msgs::Set(NextPose(this->poseMsg, poseCount, _entity,
+              this->poseNames ? &_nameComp->Data() : nullptr),
+              _poseComp->Data());
           return true;
         });
 
-    this->posePub.Publish(poseMsg);
+    TruncatePoses(this->poseMsg, poseCount);
+    this->QueuePoses(this->posePub, this->poseMsg, this->poseBuffer);
+  }
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::FilteredStateUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager)
+{
+  std::lock_guard<std::mutex> lock(this->stateMutex);
+  if (this->filteredStateRequests.empty())
+    return;
+
+  IGN_PROFILE("SceneBroadcast::FilteredStateUpdate");
+
+  for (auto request : this->filteredStateRequests)
+  {
+    std::unordered_set<Entity> entities;
+    for (const auto &scope : request->scopes)
+    {
+      std::unordered_set<Entity> matches;
+      if (!scope.name.empty())
+        matches = entitiesFromScopedName(scope.name, _manager);
+      else if (_manager.HasEntity(scope.entity))
+        matches.insert(scope.entity);
+
+      for (const auto &entity : matches)
+      {
+        if (scope.descendants)
+        {
+          auto descendants = _manager.Descendants(entity);
+          entities.insert(descendants.begin(), descendants.end());
+        }
+        else
+        {
+          entities.insert(entity);
+        }
+      }
+    }
+
+    set(request->res.mutable_stats(), _info);
+    auto state = request->res.mutable_state();
+
+    // An empty set would serialize all entities
+    if (request->scopes.empty() || !entities.empty())
+      _manager.State(*state, entities, request->types, true);
+
+    request->done = true;
+  }
+  this->filteredStateRequests.clear();
+  this->stateCv.notify_all();
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::ChunkedStateUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager)
+{
+  // Only one snapshot is sent at a time, later requests wait for the next
+  if (this->chunkFuture.valid() &&
+      this->chunkFuture.wait_for(0s) != std::future_status::ready)
+  {
+    return;
+  }
+
+  std::vector<std::string> services;
+  {
+    std::lock_guard<std::mutex> lock(this->stateMutex);
+    if (this->chunkedStateRequests.empty())
+      return;
+    services.assign(this->chunkedStateRequests.begin(),
+        this->chunkedStateRequests.end());
+    this->chunkedStateRequests.clear();
+  }
+
+  IGN_PROFILE("SceneBroadcast::ChunkedStateUpdate");
+
+  msgs::WorldStatistics stats;
+  set(&stats, _info);
+  this->chunkFuture = std::async(std::launch::async,
+      &SceneBroadcasterPrivate::SendStateChunks, this, _manager.Snapshot(),
+      stats, std::move(services));
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::SendStateChunks(
+    std::shared_ptr<const EntityComponentSnapshot> _snapshot,
+    const msgs::WorldStatistics &_stats,
+    const std::vector<std::string> &_services)
+{
+  IGN_PROFILE_THREAD_NAME("SceneBroadcaster chunks");
+  IGN_PROFILE("SceneBroadcast::SendStateChunks");
+
+  const auto &entities = _snapshot->Entities();
+  msgs::SerializedStepMap chunk;
+  std::size_t begin{0u};
+  std::size_t count{0u};
+  do
+  {
+    chunk.Clear();
+    chunk.mutable_stats()->CopyFrom(_stats);
+
+    std::size_t end{begin};
+    std::size_t bytes{0u};
+    while (end < entities.size() && bytes < kStateChunkBytes)
+    {
+      _snapshot->State(*chunk.mutable_state(), end, end + 1);
+      bytes += chunk.state().entities().at(entities[end]).ByteSizeLong();
+      ++end;
+    }
+
+    auto data = chunk.mutable_header()->add_data();
+    data->set_key("chunk");
+    data->add_value(std::to_string(count++));
+    if (end >= entities.size())
+    {
+      data = chunk.mutable_header()->add_data();
+      data->set_key("chunk_count");
+      data->add_value(std::to_string(count));
+    }
+
+    for (const auto &service : _services)
+      this->node->Request(service, chunk);
+
+    begin = end;
+  }
+  while (begin < entities.size());
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::InterestUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_manager)
+{
+  std::lock_guard<std::mutex> lock(this->interestMutex);
+  if (this->interestStreams.empty())
+    return;
+
+  IGN_PROFILE("SceneBroadcast::InterestUpdate");
+
+  auto now = std::chrono::steady_clock::now();
+  for (auto &nameStream : this->interestStreams)
+  {
+    auto &stream = nameStream.second;
+
+    // Clients which subscribe later need the full state
+    if (!stream.pub.HasConnections())
+    {
+      stream.relevant.clear();
+      stream.sentFull = false;
+      continue;
+    }
+
+    if (now - stream.lastPubTime < stream.period)
+      continue;
+
+    // Streams which only filter component types are relevant to all entities
+    if (!stream.hasRegion && stream.entities.empty())
+    {
+      auto msg = std::make_unique<msgs::SerializedStepMap>();
+      set(msg->mutable_stats(), _info);
+      if (stream.sentFull)
+      {
+        _manager.ChangedState(*msg->mutable_state(), stream.lastTick, {},
+            stream.types);
+      }
+      else
+      {
+        _manager.State(*msg->mutable_state(), {}, stream.types, true);
+      }
+
+      this->Queue(stream.pub, std::move(msg));
+      stream.sentFull = true;
+      stream.lastTick = _manager.ChangeTick();
+      stream.lastPubTime = now;
+      continue;
+    }
+
+    std::unordered_set<Entity> relevant;
+    auto addDescendants = [&](const Entity _entity)
+    {
+      auto descendants = _manager.Descendants(_entity);
+      relevant.insert(descendants.begin(), descendants.end());
+    };
+
+    for (const Entity entity : stream.entities)
+      addDescendants(entity);
+
+    if (stream.hasRegion)
+    {
+      for (const Entity child : _manager.Children(this->worldEntity))
+      {
+        auto poseComp = _manager.Component<components::Pose>(child);
+        if (nullptr != poseComp &&
+            stream.region.Contains(poseComp->Data().Pos()))
+        {
+          addDescendants(child);
+        }
+      }
+    }
+
+    auto msg = std::make_unique<msgs::SerializedStepMap>();
+    set(msg->mutable_stats(), _info);
+    auto &state = *msg->mutable_state();
+
+    // Changes since the last publication, including removals
+    if (!stream.relevant.empty())
+    {
+      _manager.ChangedState(state, stream.lastTick, stream.relevant,
+          stream.types);
+    }
+
+    // Entities which are no longer relevant are dropped by the clients
+    for (const Entity entity : stream.relevant)
+    {
+      if (relevant.find(entity) != relevant.end())
+        continue;
+      auto &entityMsg = (*state.mutable_entities())[entity];
+      entityMsg.set_id(entity);
+      entityMsg.clear_components();
+      entityMsg.set_remove(true);
+    }
+
+    // Entities which became relevant are sent in full
+    std::unordered_set<Entity> entering;
+    for (const Entity entity : relevant)
+    {
+      if (stream.relevant.find(entity) == stream.relevant.end())
+        entering.insert(entity);
+    }
+    if (!entering.empty())
+      _manager.State(state, entering, stream.types, true);
+
+    this->Queue(stream.pub, std::move(msg));
+    stream.relevant = std::move(relevant);
+    stream.lastTick = _manager.ChangeTick();
+    stream.lastPubTime = now;
   }
 }
 
@@ -540,6 +1258,9 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
   opts.SetNameSpace(ns);
   this->node = std::make_unique<transport::Node>(opts);
 
+  this->publishThread =
+      std::thread(&SceneBroadcasterPrivate::PublishLoop, this);
+
   // Scene info service
   std::string infoService{"scene/info"};
 
@@ -578,6 +1299,33 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
   ignmsg << "Serving full state (async) on [" << opts.NameSpace() << "/"
          << stateAsyncService << "]" << std::endl;
 
+  // Chunked state service
+  std::string stateChunkedService{"state_chunked"};
+
+  this->node->Advertise(stateChunkedService,
+      &SceneBroadcasterPrivate::StateChunkedService, this);
+
+  ignmsg << "Serving full state (chunked) on [" << opts.NameSpace() << "/"
+         << stateChunkedService << "]" << std::endl;
+
+  // Filtered state service
+  std::string filteredStateService{"state/filtered"};
+
+  this->node->Advertise(filteredStateService,
+      &SceneBroadcasterPrivate::FilteredStateService, this);
+
+  ignmsg << "Serving filtered state on [" << opts.NameSpace() << "/"
+         << filteredStateService << "]" << std::endl;
+
+  // Interest service
+  std::string interestService{"state/interest"};
+
+  this->node->Advertise(interestService,
+      &SceneBroadcasterPrivate::InterestService, this);
+
+  ignmsg << "Serving state interest registration on [" << opts.NameSpace()
+         << "/" << interestService << "]" << std::endl;
+
   // Scene info topic
   std::string sceneTopic{ns + "/scene/info"};
 
@@ -625,6 +1373,19 @@ void SceneBroadcasterPrivate::SetupTransport(const std::string &_worldName)
 
   ignmsg << "Publishing dynamic pose messages on [" << opts.NameSpace() << "/"
          << dyPoseTopic << "]" << std::endl;
+
+  // Quantized dynamic pose publisher
+  if (this->poseEncoder)
+  {
+    std::string quantizedPoseTopic{"dynamic_pose/info/quantized"};
+
+    this->quantizedPosePub =
+        this->node->Advertise<msgs::Bytes>(quantizedPoseTopic);
+
+    ignmsg << "Publishing quantized dynamic pose messages on ["
+           << opts.NameSpace() << "/" << quantizedPoseTopic << "]"
+           << std::endl;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -635,13 +1396,17 @@ bool SceneBroadcasterPrivate::SceneInfoService(ignition::msgs::Scene &_res)
   _res.Clear();
 
   // Populate scene message
-  _res.CopyFrom(convert<msgs::Scene>(this->sdfScene));
+  _res.CopyFrom(this->sceneProperties);
 
   // Add models
-  AddModels(&_res, this->worldEntity, this->sceneGraph);
+  _res.mutable_model()->Reserve(static_cast<int>(this->sceneModels.size()));
+  for (const auto &model : this->sceneModels)
+    _res.add_model()->CopyFrom(model.second);
 
   // Add lights
-  AddLights(&_res, this->worldEntity, this->sceneGraph);
+  _res.mutable_light()->Reserve(static_cast<int>(this->sceneLights.size()));
+  for (const auto &light : this->sceneLights)
+    _res.add_light()->CopyFrom(light.second);
 
   return true;
 }
@@ -655,6 +1420,203 @@ void SceneBroadcasterPrivate::StateAsyncService(
   this->stateRequests.insert(_req.data());
 }
 
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::StateChunkedService(
+    const ignition::msgs::StringMsg &_req)
+{
+  std::unique_lock<std::mutex> lock(this->stateMutex);
+  this->chunkedStateRequests.insert(_req.data());
+}
+
+//////////////////////////////////////////////////
+/// \brief Get a parameter of a message.
+/// \param[in] _msg Message holding the parameters.
+/// \param[in] _key Name of the parameter.
+/// \return The parameter, or nullptr if it's missing.
+static const msgs::Any *param(const msgs::Param &_msg,
+    const std::string &_key)
+{
+  auto it = _msg.params().find(_key);
+  return it == _msg.params().end() ? nullptr : &it->second;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the ID of a component type from its name.
+/// \param[in] _typeName Name of the type, such as
+/// `ign_gazebo_components.Pose`.
+/// \param[out] _typeId ID of the type.
+/// \return True if the type is registered.
+static bool componentTypeId(const std::string &_typeName,
+    ComponentTypeId &_typeId)
+{
+  auto factory = components::Factory::Instance();
+  const auto typeIds = factory->TypeIds();
+  auto typeIt = std::find_if(typeIds.begin(), typeIds.end(),
+      [&](const ComponentTypeId _type)
+      {
+        return factory->Name(_type) == _typeName;
+      });
+  if (typeIt == typeIds.end())
+    return false;
+  _typeId = *typeIt;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::FilteredStateService(
+    const ignition::msgs::Param &_req, ignition::msgs::SerializedStepMap &_res)
+{
+  _res.Clear();
+
+  FilteredStateRequest request;
+  for (const auto &child : _req.children())
+  {
+    auto nameParam = param(child, "name");
+    auto entityParam = param(child, "entity");
+    if (nullptr != nameParam || nullptr != entityParam)
+    {
+      FilteredStateRequest::Scope scope;
+      if (nullptr != nameParam)
+        scope.name = nameParam->string_value();
+      if (nullptr != entityParam)
+        scope.entity = entityParam->int_value();
+      auto descendantsParam = param(child, "descendants");
+      if (nullptr != descendantsParam)
+        scope.descendants = descendantsParam->bool_value();
+      request.scopes.push_back(scope);
+    }
+
+    auto componentParam = param(child, "component");
+    if (nullptr != componentParam)
+    {
+      ComponentTypeId typeId;
+      if (!componentTypeId(componentParam->string_value(), typeId))
+      {
+        ignerr << "Filtered state request has unknown component type ["
+               << componentParam->string_value() << "]" << std::endl;
+        return false;
+      }
+      request.types.insert(typeId);
+    }
+  }
+
+  // Lock and wait for an iteration to be run and fill the state
+  std::unique_lock<std::mutex> lock(this->stateMutex);
+
+  this->filteredStateRequests.push_back(&request);
+  auto success = this->stateCv.wait_for(lock, 5s, [&]
+  {
+    return request.done;
+  });
+
+  if (success)
+  {
+    _res.Swap(&request.res);
+  }
+  else
+  {
+    // Nobody may refer to the request once it goes out of scope
+    auto &requests = this->filteredStateRequests;
+    requests.erase(std::remove(requests.begin(), requests.end(), &request),
+        requests.end());
+    ignerr << "Timed out waiting for filtered state" << std::endl;
+  }
+
+  return success;
+}
+
+//////////////////////////////////////////////////
+bool SceneBroadcasterPrivate::InterestService(
+    const ignition::msgs::Param &_req, ignition::msgs::StringMsg &_res)
+{
+  _res.Clear();
+
+  auto nameParam = param(_req, "name");
+  if (nullptr == nameParam || nameParam->string_value().empty())
+  {
+    ignerr << "State interest requests need a [name]" << std::endl;
+    return false;
+  }
+  const std::string &name = nameParam->string_value();
+
+  InterestStream interest;
+  auto minParam = param(_req, "min");
+  auto maxParam = param(_req, "max");
+  if (nullptr != minParam && nullptr != maxParam)
+  {
+    interest.hasRegion = true;
+    interest.region = math::AxisAlignedBox(
+        msgs::Convert(minParam->vector3d_value()),
+        msgs::Convert(maxParam->vector3d_value()));
+  }
+
+  for (const auto &child : _req.children())
+  {
+    auto entityParam = param(child, "entity");
+    if (nullptr != entityParam)
+      interest.entities.insert(entityParam->int_value());
+
+    auto componentParam = param(child, "component");
+    if (nullptr != componentParam)
+    {
+      const auto &typeName = componentParam->string_value();
+      ComponentTypeId typeId;
+      if (!componentTypeId(typeName, typeId))
+      {
+        ignwarn << "State interest [" << name << "] has unknown component "
+                << "type [" << typeName << "], ignoring it." << std::endl;
+        continue;
+      }
+      interest.types.insert(typeId);
+    }
+  }
+
+  auto hertzParam = param(_req, "hertz");
+  if (nullptr != hertzParam)
+  {
+    if (hertzParam->double_value() <= 0.0)
+    {
+      ignerr << "State interest [" << name << "] must have a positive "
+             << "[hertz]" << std::endl;
+      return false;
+    }
+    interest.period = std::chrono::duration<double>(
+        1.0 / hertzParam->double_value());
+  }
+
+  std::lock_guard<std::mutex> lock(this->interestMutex);
+
+  if (!interest.hasRegion && interest.entities.empty() &&
+      interest.types.empty())
+  {
+    this->interestStreams.erase(name);
+    return true;
+  }
+
+  auto topic = transport::TopicUtils::AsValidTopic(
+      "/world/" + this->worldName + "/state/interest/" + name);
+  if (topic.empty())
+  {
+    ignerr << "Failed to create valid topic for state interest [" << name
+           << "]" << std::endl;
+    return false;
+  }
+
+  // Keep the publisher of an existing stream, so that its subscribers don't
+  // need to subscribe again
+  auto &stream = this->interestStreams[name];
+  interest.pub = stream.pub;
+  if (!interest.pub)
+  {
+    interest.pub =
+        this->node->Advertise<ignition::msgs::SerializedStepMap>(topic);
+  }
+  stream = std::move(interest);
+
+  _res.set_data(topic);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool SceneBroadcasterPrivate::StateService(
     ignition::msgs::SerializedStepMap &_res)
@@ -1043,6 +2005,17 @@ void SceneBroadcasterPrivate::SceneGraphAddEntities(
         this->sceneGraph.AddEdge(edge.get().Vertices(), edge.get().Data());
       }
     }
+
+    // Patch the cached messages of the models the new entities belong to
+    std::set<Entity> changed;
+    for (const auto &vertex : newGraph.Vertices())
+    {
+      auto topLevel = this->TopLevelEntity(vertex.first);
+      if (topLevel != kNullEntity)
+        changed.insert(topLevel);
+    }
+    for (const auto &entity : changed)
+      this->UpdateSceneCache(entity);
   }
 
   if (newEntity)
@@ -1052,15 +2025,18 @@ void SceneBroadcasterPrivate::SceneGraphAddEntities(
     if (!this->node)
       this->SetupTransport(this->worldName);
 
-    msgs::Scene sceneMsg;
+    auto sceneMsg = std::make_unique<msgs::Scene>();
     // Populate scene message
-    sceneMsg.CopyFrom(convert<msgs::Scene>(this->sdfScene));
+    {
+      std::lock_guard<std::mutex> lock(this->graphMutex);
+      sceneMsg->CopyFrom(this->sceneProperties);
+    }
 
-    AddModels(&sceneMsg, this->worldEntity, newGraph);
+    AddModels(sceneMsg.get(), this->worldEntity, newGraph);
 
     // Add lights
-    AddLights(&sceneMsg, this->worldEntity, newGraph);
-    this->scenePub.Publish(sceneMsg);
+    AddLights(sceneMsg.get(), this->worldEntity, newGraph);
+    this->Queue(this->scenePub, std::move(sceneMsg));
   }
 }
 
@@ -1077,10 +2053,12 @@ void SceneBroadcasterPrivate::SceneGraphRemoveEntities(
   // TODO(anyone) Handle case where other entities can be deleted without the
   // parent model being deleted.
   // Models
+  std::set<Entity> changed;
   _manager.EachRemoved<components::Model>(
       [&](const Entity &_entity, const components::Model *) -> bool
       {
         removedEntities.push_back(_entity);
+        changed.insert(this->TopLevelEntity(_entity));
         // Remove from graph
         RemoveFromGraph(_entity, this->sceneGraph);
         return true;
@@ -1091,24 +2069,105 @@ void SceneBroadcasterPrivate::SceneGraphRemoveEntities(
       [&](const Entity &_entity, const components::Light *) -> bool
       {
         removedEntities.push_back(_entity);
+        changed.insert(this->TopLevelEntity(_entity));
         // Remove from graph
         RemoveFromGraph(_entity, this->sceneGraph);
         return true;
       });
 
+  // Entities removed along with their parent aren't in the graph anymore
+  changed.erase(kNullEntity);
+  for (const auto &entity : changed)
+    this->UpdateSceneCache(entity);
+
   if (!removedEntities.empty())
   {
     // Send the list of deleted entities
-    msgs::UInt32_V deletionMsg;
+    auto deletionMsg = std::make_unique<msgs::UInt32_V>();
 
     for (const auto &entity : removedEntities)
     {
-      deletionMsg.mutable_data()->Add(entity);
+      deletionMsg->mutable_data()->Add(entity);
     }
-    this->deletionPub.Publish(deletionMsg);
+    this->Queue(this->deletionPub, std::move(deletionMsg));
   }
 }
 
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::SceneGraphUpdateEntities(
+    const EntityComponentManager &_manager)
+{
+  std::lock_guard<std::mutex> lock(this->graphMutex);
+
+  _manager.EachChangedSince<components::Scene>(this->sceneTick,
+      [&](const Entity &_entity, const components::Scene *_sceneComp) -> bool
+      {
+        if (_entity == this->worldEntity)
+          this->sceneProperties = convert<msgs::Scene>(_sceneComp->Data());
+        return true;
+      });
+
+  // Entities which aren't in the graph yet get their messages when they're
+  // added
+  auto graphMsg = [&](const Entity _entity)
+  {
+    const auto &vertex = this->sceneGraph.VertexFromId(_entity);
+    return vertex.Valid() ? vertex.Data() : nullptr;
+  };
+
+  std::set<Entity> changed;
+  _manager.EachChangedSince<components::Geometry>(this->sceneTick,
+      [&](const Entity &_entity, const components::Geometry *_geometryComp)
+      {
+        auto visualMsg =
+            std::dynamic_pointer_cast<msgs::Visual>(graphMsg(_entity));
+        if (visualMsg)
+        {
+          visualMsg->mutable_geometry()->CopyFrom(
+              convert<msgs::Geometry>(_geometryComp->Data()));
+          changed.insert(this->TopLevelEntity(_entity));
+        }
+        return true;
+      });
+
+  _manager.EachChangedSince<components::Material>(this->sceneTick,
+      [&](const Entity &_entity, const components::Material *_materialComp)
+      {
+        auto visualMsg =
+            std::dynamic_pointer_cast<msgs::Visual>(graphMsg(_entity));
+        if (visualMsg)
+        {
+          visualMsg->mutable_material()->CopyFrom(
+              convert<msgs::Material>(_materialComp->Data()));
+          changed.insert(this->TopLevelEntity(_entity));
+        }
+        return true;
+      });
+
+  _manager.EachChangedSince<components::Light>(this->sceneTick,
+      [&](const Entity &_entity, const components::Light *_lightComp)
+      {
+        auto lightMsg =
+            std::dynamic_pointer_cast<msgs::Light>(graphMsg(_entity));
+        if (lightMsg)
+        {
+          // The graph's message has the entity's id, name and pose
+          auto updated = convert<msgs::Light>(_lightComp->Data());
+          updated.set_id(lightMsg->id());
+          updated.set_parent_id(lightMsg->parent_id());
+          updated.set_name(lightMsg->name());
+          updated.mutable_pose()->Swap(lightMsg->mutable_pose());
+          lightMsg->Swap(&updated);
+          changed.insert(this->TopLevelEntity(_entity));
+        }
+        return true;
+      });
+
+  changed.erase(kNullEntity);
+  for (const auto &entity : changed)
+    this->UpdateSceneCache(entity);
+}
+
 //////////////////////////////////////////////////
 /// \tparam T Either a msgs::Scene or msgs::Model
 template<typename T>
@@ -1237,6 +2296,52 @@ void SceneBroadcasterPrivate::AddLinks(msgs::Model *_msg, const Entity _entity,
   }
 }
 
+//////////////////////////////////////////////////
+Entity SceneBroadcasterPrivate::TopLevelEntity(const Entity _entity) const
+{
+  Entity entity = _entity;
+  while (true)
+  {
+    auto parents = this->sceneGraph.AdjacentsTo(entity);
+    if (parents.empty())
+      return kNullEntity;
+
+    const Entity parent = parents.begin()->first;
+    if (parent == this->worldEntity)
+      return entity;
+    entity = parent;
+  }
+}
+
+//////////////////////////////////////////////////
+void SceneBroadcasterPrivate::UpdateSceneCache(const Entity _entity)
+{
+  this->sceneModels.erase(_entity);
+  this->sceneLights.erase(_entity);
+
+  const auto &vertex = this->sceneGraph.VertexFromId(_entity);
+  if (!vertex.Valid())
+    return;
+
+  auto modelMsg = std::dynamic_pointer_cast<msgs::Model>(vertex.Data());
+  if (modelMsg)
+  {
+    auto &msgOut = this->sceneModels[_entity];
+    msgOut.CopyFrom(*modelMsg);
+
+    // Nested models
+    AddModels(&msgOut, _entity, this->sceneGraph);
+
+    // Links
+    AddLinks(&msgOut, _entity, this->sceneGraph);
+    return;
+  }
+
+  auto lightMsg = std::dynamic_pointer_cast<msgs::Light>(vertex.Data());
+  if (lightMsg)
+    this->sceneLights[_entity].CopyFrom(*lightMsg);
+}
+
 //////////////////////////////////////////////////
 void SceneBroadcasterPrivate::RemoveFromGraph(const Entity _entity,
                                               SceneGraphType &_graph)
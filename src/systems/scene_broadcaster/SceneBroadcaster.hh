@@ -37,6 +37,68 @@ namespace systems
   **/
   /// \brief System which periodically publishes an ignition::msgs::Scene
   /// message with updated information.
+  ///
+  /// Messages are filled during PostUpdate and handed over to a dedicated
+  /// thread which publishes them, so simulation doesn't wait on transport.
+  /// Pose messages which haven't been published by the time newer poses are
+  /// ready are replaced by them, while all other messages are published in
+  /// order.
+  ///
+  /// Setting `<pose_names>` to false leaves entity names out of the
+  /// messages published on `pose/info` and `dynamic_pose/info`, which then
+  /// only identify entities by id. Receivers can resolve the names from the
+  /// scene graph. Defaults to true.
+  ///
+  /// Adding a `<quantized_dynamic_pose>` element also publishes the dynamic
+  /// poses on `dynamic_pose/info/quantized`, encoded by a PoseStreamEncoder
+  /// into an ignition::msgs::Bytes message. It accepts:
+  /// * `<position_resolution>`: Position resolution in meters, defaults to
+  ///   0.0001.
+  /// * `<keyframe_interval>`: Number of frames between keyframes, defaults
+  ///   to 60.
+  ///
+  /// Clients which only need the current state of part of the world can
+  /// request it from the `state/filtered` service, which takes an
+  /// ignition::msgs::Param and responds with an
+  /// ignition::msgs::SerializedStepMap. The request's children may have:
+  /// * `name` (string): Scoped name of entities to serialize, such as
+  ///   `my_model` or `my_model::my_link`.
+  /// * `entity` (int): Entity to serialize, used if there's no name.
+  /// * `descendants` (bool): Whether the descendants of the named entity
+  ///   are also serialized, defaults to true.
+  /// * `component` (string): Name of a component type to serialize, such as
+  ///   `ign_gazebo_components.Pose`.
+  ///
+  /// All entities are serialized if no entities are requested, and all
+  /// component types if no types are requested. The state is serialized on
+  /// the next PostUpdate.
+  ///
+  /// Clients which only need part of the world can register their interest
+  /// through the `state/interest` service, which takes an
+  /// ignition::msgs::Param with:
+  /// * `name` (string): Name of the stream. The state is published on
+  ///   `state/interest/<name>`, which is returned in the response. Clients
+  ///   registering the same name share the stream, and the latest request
+  ///   sets its interest.
+  /// * `min` and `max` (vector3d): Corners of a region. Entities whose
+  ///   parent is the world, such as models and lights, are relevant when
+  ///   their position is inside the region, along with all their
+  ///   descendants.
+  /// * Children with an `entity` (int) parameter: Entities which are
+  ///   relevant, along with all their descendants, wherever they are.
+  /// * Children with a `component` (string) parameter: Names of the
+  ///   component types which are sent, such as
+  ///   `ign_gazebo_components.Pose`. All types are sent if there are none.
+  ///   Without a region nor entities, all entities are relevant.
+  /// * `hertz` (double): Publication rate, defaults to 60.
+  ///
+  /// A request without a region, entities or component types removes the
+  /// stream. Each stream
+  /// carries the changes to the relevant entities since its previous
+  /// message, the full state of entities which became relevant, and entities
+  /// which stopped being relevant flagged as removed. Every registration
+  /// makes the next message carry the full state of all relevant entities,
+  /// so clients joining a shared stream should register too.
   class SceneBroadcaster:
     public System,
     public ISystemConfigure,
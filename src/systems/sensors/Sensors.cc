@@ -17,7 +17,11 @@
 
 #include "Sensors.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -32,6 +36,7 @@
 #include <ignition/math/Helpers.hh>
 
 #include <ignition/rendering/Scene.hh>
+#include <ignition/rendering/Visual.hh>
 #include <ignition/sensors/BoundingBoxCameraSensor.hh>
 #include <ignition/sensors/CameraSensor.hh>
 #include <ignition/sensors/DepthCameraSensor.hh>
@@ -51,12 +56,15 @@
 #include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/RenderEngineServerHeadless.hh"
 #include "ignition/gazebo/components/RenderEngineServerPlugin.hh"
+#include "ignition/gazebo/components/RenderThreadAffinity.hh"
 #include "ignition/gazebo/components/RgbdCamera.hh"
 #include "ignition/gazebo/components/SegmentationCamera.hh"
 #include "ignition/gazebo/components/ThermalCamera.hh"
 #include "ignition/gazebo/components/World.hh"
 #include "ignition/gazebo/Events.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/StartupTrace.hh"
+#include "ignition/gazebo/Util.hh"
 
 #include "ignition/gazebo/rendering/Events.hh"
 #include "ignition/gazebo/rendering/RenderUtil.hh"
@@ -65,6 +73,29 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Check whether there are rendering sensors in the ECM.
+/// \param[in] _ecm Entity component manager
+/// \return True if there's at least one rendering sensor.
+static bool hasRenderingSensors(const EntityComponentManager &_ecm)
+{
+  return _ecm.HasComponentType(components::Camera::typeId) ||
+      _ecm.HasComponentType(components::DepthCamera::typeId) ||
+      _ecm.HasComponentType(components::GpuLidar::typeId) ||
+      _ecm.HasComponentType(components::RgbdCamera::typeId) ||
+      _ecm.HasComponentType(components::ThermalCamera::typeId) ||
+      _ecm.HasComponentType(components::SegmentationCamera::typeId) ||
+      _ecm.HasComponentType(components::BoundingBoxCamera::typeId);
+}
+
+/// \brief Get the time elapsed since a time point, for reporting.
+/// \param[in] _start Start time.
+/// \return Milliseconds since _start.
+static double msSince(const std::chrono::steady_clock::time_point &_start)
+{
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - _start).count();
+}
+
 // Private data class.
 class ignition::gazebo::systems::SensorsPrivate
 {
@@ -81,6 +112,14 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Unique set of sensor ids
   public: std::set<sensors::SensorId> sensorIds;
 
+  /// \brief Whether sensorIds is empty, so it can be checked while the
+  /// rendering thread creates sensors.
+  public: std::atomic<bool> noSensors{true};
+
+  /// \brief ECM change tick up to which the scene was updated from the
+  /// ECM while there were no rendering sensors.
+  public: uint64_t idleSceneTick{0u};
+
   /// \brief rendering scene to be managed by the scene manager and used to
   /// generate sensor data
   public: rendering::ScenePtr scene;
@@ -110,12 +149,24 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Flag to signal if initialization should occur
   public: bool doInit { false };
 
+  /// \brief Whether the startup trace is held until the rendering scene is
+  /// created, so that it includes the scene creation.
+  public: bool startupTraceHeld { false };
+
+  /// \brief Whether sensors were rendered for the first time, which
+  /// compiles their shaders and allocates their render targets.
+  public: bool firstFrameRendered { false };
+
   /// \brief Flag to signal if rendering update is needed
   public: bool updateAvailable { false };
 
   /// \brief Thread that rendering will occur in
   public: std::thread renderThread;
 
+  /// \brief CPU cores the rendering thread runs on, empty to leave it
+  /// unrestricted.
+  public: std::vector<unsigned int> renderCores;
+
   /// \brief Mutex to protect rendering data
   public: std::mutex renderMutex;
 
@@ -135,6 +186,44 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Sensors to include in the next rendering iteration
   public: std::vector<sensors::RenderingSensor *> activeSensors;
 
+  /// \brief Period of the rendering batches, zero to render sensors as soon
+  /// as they're due.
+  public: std::chrono::steady_clock::duration batchPeriod{0};
+
+  /// \brief Start time of the latest batch.
+  public: std::optional<std::chrono::steady_clock::duration> lastBatchTime;
+
+  /// \brief Distance beyond which models aren't rendered by sensors. Zero
+  /// to render all models.
+  public: double maxDrawDistance{0.0};
+
+  /// \brief True to skip rendering sensors when nothing in the scene
+  /// changed since they last rendered.
+  public: bool skipIdleFrames{false};
+
+  /// \brief Longest time a sensor may go without rendering when idle
+  /// frames are skipped.
+  public: std::chrono::steady_clock::duration idleMaxPeriod{
+      std::chrono::seconds(1)};
+
+  /// \brief ECM change tick up to which the scene was checked for changes.
+  public: uint64_t checkedTick{0u};
+
+  /// \brief ECM change tick of the last scene change seen by sensors.
+  public: uint64_t sceneChangeTick{0u};
+
+  /// \brief ECM change tick and sim time of the last render of each
+  /// sensor.
+  public: std::map<sensors::SensorId,
+      std::pair<uint64_t, std::chrono::steady_clock::duration>> lastRenders;
+
+  /// \brief Sensors which are due but are skipped because the scene didn't
+  /// change since they last rendered. Protected by renderMutex.
+  public: std::set<sensors::SensorId> idleSensors;
+
+  /// \brief Number of camera passes submitted to the GPU together.
+  public: unsigned int cameraPassesPerGpuFlush{6u};
+
   /// \brief Mutex to protect sensorMask
   public: std::mutex sensorMaskMutex;
 
@@ -151,6 +240,12 @@ class ignition::gazebo::systems::SensorsPrivate
   /// \brief Run one rendering iteration
   private: void RunOnce();
 
+  /// \brief Hide the top level visuals which are farther than
+  /// maxDrawDistance from all the active sensors.
+  /// \return The hidden visuals, with their original visibility flags.
+  private: std::vector<std::pair<rendering::VisualPtr, uint32_t>>
+      CullVisuals() const;
+
   /// \brief Top level function for the rendering thread
   ///
   /// This function captures all of the behavior of the rendering thread.
@@ -209,6 +304,9 @@ class ignition::gazebo::systems::SensorsPrivate
   /// True means has charge, false means drained
   public: std::unordered_map<Entity, bool> modelBatteryStateChanged;
 
+  /// \brief Change tick up to which battery state changes were processed.
+  public: uint64_t batteryStateTick{0u};
+
   /// \brief A map of sensor ids to their active state
   public: std::map<sensors::SensorId, bool> sensorStateChanged;
 
@@ -238,19 +336,26 @@ void SensorsPrivate::WaitForInit()
     {
       // Only initialize if there are rendering sensors
       igndbg << "Initializing render context" << std::endl;
+      StartupTrace::Scope scope("render_scene");
+      const auto start = std::chrono::steady_clock::now();
       if (this->backgroundColor)
         this->renderUtil.SetBackgroundColor(*this->backgroundColor);
       if (this->ambientLight)
         this->renderUtil.SetAmbientLight(*this->ambientLight);
       this->renderUtil.Init();
       this->scene = this->renderUtil.Scene();
-      this->scene->SetCameraPassCountPerGpuFlush(6u);
+      this->scene->SetCameraPassCountPerGpuFlush(
+          this->cameraPassesPerGpuFlush);
       this->initialized = true;
+      igndbg << "Created rendering scene in " << msSince(start) << " ms"
+             << std::endl;
     }
 
     this->updateAvailable = false;
     this->renderCv.notify_one();
   }
+
+  // The startup trace is held until the first sensor frame is rendered
   igndbg << "Rendering Thread initialized" << std::endl;
 }
 
@@ -272,9 +377,20 @@ void SensorsPrivate::RunOnce()
   IGN_PROFILE("SensorsPrivate::RunOnce");
   {
     IGN_PROFILE("Update");
+    const auto sensorCount = this->sensorIds.size();
+    const auto start = std::chrono::steady_clock::now();
     this->renderUtil.Update();
+    if (this->sensorIds.size() > sensorCount)
+    {
+      igndbg << "Updated the scene and created "
+             << this->sensorIds.size() - sensorCount
+             << " rendering sensors in " << msSince(start) << " ms"
+             << std::endl;
+    }
   }
 
+  bool releaseTrace{false};
+
   if (!this->activeSensors.empty())
   {
     // disable sensors that are out of battery or re-enable sensors that are
@@ -324,6 +440,13 @@ void SensorsPrivate::RunOnce()
       this->scene->PreRender();
     }
 
+    std::vector<std::pair<rendering::VisualPtr, uint32_t>> culledVisuals;
+    if (this->maxDrawDistance > 0.0)
+    {
+      IGN_PROFILE("CullVisuals");
+      culledVisuals = this->CullVisuals();
+    }
+
     // disable sensors that have no subscribers to prevent doing unnecessary
     // work
     std::unordered_set<sensors::RenderingSensor *> tmpDisabledSensors;
@@ -332,7 +455,8 @@ void SensorsPrivate::RunOnce()
     {
       sensors::Sensor *s = this->sensorManager.Sensor(id);
       auto rs = dynamic_cast<sensors::RenderingSensor *>(s);
-      if (rs->IsActive() && !this->HasConnections(rs))
+      if (rs->IsActive() && (!this->HasConnections(rs) ||
+          this->idleSensors.find(id) != this->idleSensors.end()))
       {
         rs->SetActive(false);
         tmpDisabledSensors.insert(rs);
@@ -343,7 +467,21 @@ void SensorsPrivate::RunOnce()
     {
       // publish data
       IGN_PROFILE("RunOnce");
-      this->sensorManager.RunOnce(this->updateTime);
+      if (this->firstFrameRendered)
+      {
+        this->sensorManager.RunOnce(this->updateTime);
+      }
+      else
+      {
+        StartupTrace::Scope scope("render_first_frame");
+        const auto start = std::chrono::steady_clock::now();
+        this->sensorManager.RunOnce(this->updateTime);
+        igndbg << "Rendered the first frame of " << this->sensorIds.size()
+               << " rendering sensors in " << msSince(start) << " ms"
+               << std::endl;
+        this->firstFrameRendered = true;
+        releaseTrace = std::exchange(this->startupTraceHeld, false);
+      }
     }
 
     // re-enble sensors
@@ -352,6 +490,10 @@ void SensorsPrivate::RunOnce()
       rs->SetActive(true);
     }
 
+    // show culled visuals again
+    for (auto &[visual, flags] : culledVisuals)
+      visual->SetVisibilityFlags(flags);
+
     {
       IGN_PROFILE("PostRender");
       // Update the scene graph manually to improve performance
@@ -368,6 +510,61 @@ void SensorsPrivate::RunOnce()
   this->updateAvailable = false;
   lock.unlock();
   this->renderCv.notify_one();
+
+  if (releaseTrace)
+    StartupTrace::Instance().Release();
+}
+
+//////////////////////////////////////////////////
+std::vector<std::pair<rendering::VisualPtr, uint32_t>>
+    SensorsPrivate::CullVisuals() const
+{
+  std::vector<std::pair<rendering::VisualPtr, uint32_t>> culled;
+
+  std::vector<math::Vector3d> positions;
+  for (const auto &sensor : this->activeSensors)
+  {
+    // If we can't tell where a sensor is, any visual may be within reach
+    auto node = this->scene->SensorByName(sensor->Name());
+    if (!node)
+      return culled;
+    positions.push_back(node->WorldPosition());
+  }
+
+  auto root = this->scene->RootVisual();
+  for (unsigned int i = 0; i < root->ChildCount(); ++i)
+  {
+    auto visual =
+        std::dynamic_pointer_cast<rendering::Visual>(root->ChildByIndex(i));
+    if (!visual)
+      continue;
+
+    auto box = visual->BoundingBox();
+    if (box.Min().X() > box.Max().X())
+      continue;
+
+    // Distance from each sensor to the closest point of the visual
+    bool near{false};
+    for (const auto &pos : positions)
+    {
+      math::Vector3d closest(
+          std::clamp(pos.X(), box.Min().X(), box.Max().X()),
+          std::clamp(pos.Y(), box.Min().Y(), box.Max().Y()),
+          std::clamp(pos.Z(), box.Min().Z(), box.Max().Z()));
+      if (pos.Distance(closest) <= this->maxDrawDistance)
+      {
+        near = true;
+        break;
+      }
+    }
+
+    if (!near)
+    {
+      culled.emplace_back(visual, visual->VisibilityFlags());
+      visual->SetVisibilityFlags(0u);
+    }
+  }
+  return culled;
 }
 
 //////////////////////////////////////////////////
@@ -375,6 +572,9 @@ void SensorsPrivate::RenderThread()
 {
   IGN_PROFILE_THREAD_NAME("RenderThread");
 
+  if (!this->renderCores.empty() && !setThreadAffinity(this->renderCores))
+    ignwarn << "Failed to set the affinity of the render thread." << std::endl;
+
   igndbg << "SensorsPrivate::RenderThread started" << std::endl;
 
   // We have to wait for rendering sensors to be available
@@ -389,6 +589,14 @@ void SensorsPrivate::RenderThread()
   for (const auto id : this->sensorIds)
     this->sensorManager.Remove(id);
 
+  bool held{false};
+  {
+    std::lock_guard<std::mutex> lock(this->renderMutex);
+    held = std::exchange(this->startupTraceHeld, false);
+  }
+  if (held)
+    StartupTrace::Instance().Release();
+
   igndbg << "SensorsPrivate::RenderThread stopped" << std::endl;
 }
 
@@ -441,6 +649,7 @@ void Sensors::RemoveSensor(const Entity &_entity)
       {
         this->dataPtr->activeSensors.erase(activeSensorIt);
       }
+      this->dataPtr->lastRenders.erase(idIter->second);
     }
 
     // update cameras list
@@ -454,6 +663,7 @@ void Sensors::RemoveSensor(const Entity &_entity)
     }
 
     this->dataPtr->sensorIds.erase(idIter->second);
+    this->dataPtr->noSensors = this->dataPtr->sensorIds.empty();
     this->dataPtr->sensorManager.Remove(idIter->second);
     this->dataPtr->entityToIdMap.erase(idIter);
   }
@@ -487,6 +697,29 @@ void Sensors::Configure(const Entity &/*_id*/,
       _sdf->Get<bool>("disable_on_drained_battery",
      this->dataPtr-> disableOnDrainedBattery).first;
 
+  // Get the rendering batch settings
+  auto batchPeriod = _sdf->Get<double>("batch_period", 0.0).first;
+  if (batchPeriod > 0.0)
+  {
+    this->dataPtr->batchPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(batchPeriod));
+  }
+  this->dataPtr->maxDrawDistance = _sdf->Get<double>("max_draw_distance",
+      this->dataPtr->maxDrawDistance).first;
+  this->dataPtr->skipIdleFrames = _sdf->Get<bool>("skip_idle_frames",
+      this->dataPtr->skipIdleFrames).first;
+  auto idleMaxPeriod = _sdf->Get<double>("idle_max_period", -1.0).first;
+  if (idleMaxPeriod >= 0.0)
+  {
+    this->dataPtr->idleMaxPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(idleMaxPeriod));
+  }
+  this->dataPtr->cameraPassesPerGpuFlush = _sdf->Get<unsigned int>(
+      "camera_passes_per_gpu_flush",
+      this->dataPtr->cameraPassesPerGpuFlush).first;
+
   // Get the background color, if specified.
   if (_sdf->HasElement("background_color"))
     this->dataPtr->backgroundColor = _sdf->Get<math::Color>("background_color");
@@ -533,6 +766,12 @@ void Sensors::Configure(const Entity &/*_id*/,
       this->dataPtr->renderUtil.SetHeadlessRendering(
         renderEngineServerHeadlessComp->Data());
     }
+
+    // Set the rendering thread's cores if specified from command line
+    auto renderThreadAffinityComp =
+      _ecm.Component<components::RenderThreadAffinity>(worldEntity);
+    if (renderThreadAffinityComp)
+      this->dataPtr->renderCores = renderThreadAffinityComp->Data();
   }
 
   this->dataPtr->eventManager = &_eventMgr;
@@ -540,6 +779,16 @@ void Sensors::Configure(const Entity &/*_id*/,
   this->dataPtr->stopConn = _eventMgr.Connect<events::Stop>(
       std::bind(&SensorsPrivate::Stop, this->dataPtr.get()));
 
+  // If the world already has rendering sensors, load the render engine and
+  // create the scene while the rest of the world loads, instead of waiting
+  // for the first update
+  if (hasRenderingSensors(_ecm))
+  {
+    igndbg << "Initialization needed" << std::endl;
+    this->dataPtr->doInit = true;
+    this->dataPtr->startupTraceHeld = StartupTrace::Instance().Hold();
+  }
+
   // Kick off worker thread
   this->dataPtr->Run();
 }
@@ -572,55 +821,101 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
 
   {
     std::unique_lock<std::mutex> lock(this->dataPtr->renderMutex);
-    if (!this->dataPtr->initialized &&
-        (_ecm.HasComponentType(components::Camera::typeId) ||
-         _ecm.HasComponentType(components::DepthCamera::typeId) ||
-         _ecm.HasComponentType(components::GpuLidar::typeId) ||
-         _ecm.HasComponentType(components::RgbdCamera::typeId) ||
-         _ecm.HasComponentType(components::ThermalCamera::typeId) ||
-         _ecm.HasComponentType(components::SegmentationCamera::typeId) ||
-         _ecm.HasComponentType(components::BoundingBoxCamera::typeId)))
+    if (!this->dataPtr->initialized && !this->dataPtr->doInit &&
+        hasRenderingSensors(_ecm))
     {
       igndbg << "Initialization needed" << std::endl;
       this->dataPtr->doInit = true;
+      if (!this->dataPtr->startupTraceHeld)
+        this->dataPtr->startupTraceHeld = StartupTrace::Instance().Hold();
       this->dataPtr->renderCv.notify_one();
     }
   }
 
   if (this->dataPtr->running && this->dataPtr->initialized)
   {
+    // Without rendering sensors the scene isn't rendered, so it only needs
+    // to follow the ECM when something it shows changed
+    const uint64_t sceneTick = _ecm.ChangeTick();
+    const bool idleScene = this->dataPtr->noSensors &&
+        this->dataPtr->renderUtil.PendingSensors() <= 0 &&
+        !this->dataPtr->renderUtil.SceneChangedSince(_ecm,
+            this->dataPtr->idleSceneTick);
+    this->dataPtr->idleSceneTick = sceneTick;
+    if (idleScene)
+      return;
+
     this->dataPtr->renderUtil.UpdateFromECM(_info, _ecm);
 
     auto time = math::durationToSecNsec(_info.simTime);
     auto t = math::secNsecToDuration(time.first, time.second);
 
     std::vector<sensors::RenderingSensor *> activeSensors;
+    std::set<sensors::SensorId> idleSensors;
 
-    this->dataPtr->sensorMaskMutex.lock();
-    for (auto id : this->dataPtr->sensorIds)
+    // When batching, sensors are only collected on the first update of each
+    // batch, so that all the sensors which became due since the previous
+    // batch are rendered together
+    bool batchStart{true};
+    if (this->dataPtr->batchPeriod.count() > 0)
     {
-      sensors::Sensor *s = this->dataPtr->sensorManager.Sensor(id);
-      auto rs = dynamic_cast<sensors::RenderingSensor *>(s);
+      auto batchTime = t - t % this->dataPtr->batchPeriod;
+      batchStart = batchTime != this->dataPtr->lastBatchTime;
+      this->dataPtr->lastBatchTime = batchTime;
+    }
 
-      auto it = this->dataPtr->sensorMask.find(id);
-      if (it != this->dataPtr->sensorMask.end())
+    // Sensors only need to render again if what they see changed
+    const uint64_t tick = _ecm.ChangeTick();
+    if (this->dataPtr->skipIdleFrames)
+    {
+      if (this->dataPtr->renderUtil.SceneChangedSince(_ecm,
+          this->dataPtr->checkedTick))
       {
-        if (it->second <= t)
+        this->dataPtr->sceneChangeTick = tick;
+      }
+      this->dataPtr->checkedTick = tick;
+    }
+
+    if (batchStart)
+    {
+      this->dataPtr->sensorMaskMutex.lock();
+      for (auto id : this->dataPtr->sensorIds)
+      {
+        sensors::Sensor *s = this->dataPtr->sensorManager.Sensor(id);
+        auto rs = dynamic_cast<sensors::RenderingSensor *>(s);
+
+        auto it = this->dataPtr->sensorMask.find(id);
+        if (it != this->dataPtr->sensorMask.end())
         {
-          this->dataPtr->sensorMask.erase(it);
+          if (it->second <= t)
+          {
+            this->dataPtr->sensorMask.erase(it);
+          }
+          else
+          {
+            continue;
+          }
         }
-        else
+
+        if (rs && rs->NextDataUpdateTime() <= t)
         {
-          continue;
+          if (this->dataPtr->skipIdleFrames)
+          {
+            auto last = this->dataPtr->lastRenders.find(id);
+            if (last != this->dataPtr->lastRenders.end() &&
+                last->second.first >= this->dataPtr->sceneChangeTick &&
+                t - last->second.second < this->dataPtr->idleMaxPeriod)
+            {
+              idleSensors.insert(id);
+              continue;
+            }
+            this->dataPtr->lastRenders[id] = {tick, t};
+          }
+          activeSensors.push_back(rs);
         }
       }
-
-      if (rs && rs->NextDataUpdateTime() <= t)
-      {
-        activeSensors.push_back(rs);
-      }
+      this->dataPtr->sensorMaskMutex.unlock();
     }
-    this->dataPtr->sensorMaskMutex.unlock();
 
     if (!activeSensors.empty() ||
         this->dataPtr->renderUtil.PendingSensors() > 0)
@@ -638,6 +933,7 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
       }
 
       this->dataPtr->activeSensors = std::move(activeSensors);
+      this->dataPtr->idleSensors = std::move(idleSensors);
       this->dataPtr->updateTime = t;
       this->dataPtr->updateAvailable = true;
       this->dataPtr->renderCv.notify_one();
@@ -649,8 +945,9 @@ void Sensors::PostUpdate(const UpdateInfo &_info,
 //////////////////////////////////////////////////
 void SensorsPrivate::UpdateBatteryState(const EntityComponentManager &_ecm)
 {
-  // Battery state
-  _ecm.Each<components::BatterySoC>(
+  // Battery state. The battery systems only mark their components as
+  // changed when the charge crosses zero, so only those need checking.
+  _ecm.EachChangedSince<components::BatterySoC>(this->batteryStateTick,
       [&](const Entity & _entity, const components::BatterySoC *_bat)
       {
         bool hasCharge = _bat->Data() > 0;
@@ -668,6 +965,7 @@ void SensorsPrivate::UpdateBatteryState(const EntityComponentManager &_ecm)
         this->modelBatteryState[_ecm.ParentEntity(_entity)] = hasCharge;
         return true;
       });
+  this->batteryStateTick = _ecm.ChangeTick();
 
   // disable sensor if parent model is out of battery or re-enable sensor
   // if battery is charging
@@ -716,6 +1014,8 @@ std::string Sensors::CreateSensor(const Entity &_entity,
     return std::string();
   }
 
+  StartupTrace::Scope scope("sensor", _sdf.Name());
+
   // Create within ign-sensors
   sensors::Sensor *sensor{nullptr};
   if (_sdf.Type() == sdf::SensorType::CAMERA)
@@ -765,6 +1065,7 @@ std::string Sensors::CreateSensor(const Entity &_entity,
   auto sensorId = sensor->Id();
   this->dataPtr->entityToIdMap.insert({_entity, sensorId});
   this->dataPtr->sensorIds.insert(sensorId);
+  this->dataPtr->noSensors = false;
 
   // Set the scene so it can create the rendering sensor
   auto renderingSensor = dynamic_cast<sensors::RenderingSensor *>(sensor);
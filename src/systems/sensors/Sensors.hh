@@ -50,6 +50,52 @@ namespace systems
   /// - `<disable_on_drained_battery>` Disable sensors if the model's
   /// battery plugin charge reaches zero. Sensors that are in nested
   /// models are also affected.
+  /// - `<batch_period>` Period in seconds at which rendering sensors are
+  /// rendered in batches. Sensors which become due are held until the next
+  /// multiple of the period, so that sensors with close update times are
+  /// rendered in the same frame, sharing the scene update and GPU
+  /// submissions, instead of each triggering a frame of its own. Sensor
+  /// data may be delayed by up to one period, and sensors faster than the
+  /// batch rate are limited to it. Defaults to 0, which renders sensors as
+  /// soon as they're due.
+  /// - `<camera_passes_per_gpu_flush>` Number of camera passes which are
+  /// submitted to the GPU together. Higher values improve GPU utilization
+  /// when many cameras render in the same frame, at the cost of memory.
+  /// Defaults to 6.
+  /// - `<max_draw_distance>` Distance in meters beyond which models aren't
+  /// rendered by sensors. On each frame, top level models whose bounding box
+  /// is farther than this from all the sensors being rendered are hidden
+  /// from them, which saves the culling and drawing of their geometry. This
+  /// is useful when it's shorter than the sensors' far clip planes. Defaults
+  /// to 0, which renders all models.
+  /// - `<skip_idle_frames>` Skip rendering sensors which are due if nothing
+  /// that affects what they see, such as poses, visuals, lights and entity
+  /// creation or removal, changed since they last rendered. Worlds with
+  /// actors or particle emitters are never idle. Skipped sensors don't
+  /// publish. Markers aren't tracked. Defaults to false.
+  /// - `<idle_max_period>` Longest time in seconds a sensor may go without
+  /// rendering when idle frames are skipped, so that consumers still receive
+  /// data periodically. Defaults to 1.
+  ///
+  /// ## Rendering thread
+  ///
+  /// All rendering sensors are rendered by a single thread, with a single
+  /// scene. The render engine is loaded once per process, and its context is
+  /// bound to the thread which created it, so sensors can't be spread across
+  /// threads or GPUs within a process. In order to use more than one GPU,
+  /// split the sensors across processes, for example by running a
+  /// distributed simulation with secondaries on different GPUs.
+  ///
+  /// The rendering thread can be restricted to a set of CPU cores through
+  /// the server configuration, see ServerConfig::SetThreadAffinity.
+  ///
+  /// If the world has rendering sensors when the system is configured, the
+  /// rendering thread loads the render engine and creates the scene right
+  /// away, while the rest of the world loads. The scene creation, the
+  /// creation of each sensor and the first sensor frame, which compiles
+  /// shaders and allocates render targets, are timed in the startup trace
+  /// as `render_scene`, `sensor` and `render_first_frame`, and printed at
+  /// debug level.
   ///
   /// \TODO(louise) Have one system for all sensors, or one per
   /// sensor / sensor type?
@@ -0,0 +1,655 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "SharedMemoryExport.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/plugin/Register.hh>
+
+#include "ignition/gazebo/components/AngularVelocity.hh"
+#include "ignition/gazebo/components/Joint.hh"
+#include "ignition/gazebo/components/JointPosition.hh"
+#include "ignition/gazebo/components/JointVelocity.hh"
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/Util.hh"
+
+#include "SharedMemoryExportLayout.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief Maximum number of joint axes exported.
+static constexpr uint32_t kMaxJointAxes{2u};
+
+/// \brief Component types which can be exported.
+enum class ExportKind
+{
+  /// \brief Pose of models and links.
+  POSE,
+
+  /// \brief World pose of links.
+  WORLD_POSE,
+
+  /// \brief Joint positions.
+  JOINT_POSITION,
+
+  /// \brief Joint velocities.
+  JOINT_VELOCITY,
+
+  /// \brief Linear velocity of links.
+  LINEAR_VELOCITY,
+
+  /// \brief Angular velocity of links.
+  ANGULAR_VELOCITY
+};
+
+/// \brief Table of exported values for one component type.
+struct ExportTable
+{
+  /// \brief Exported component type.
+  ExportKind kind;
+
+  /// \brief Name given to the `<component>` parameter.
+  std::string name;
+
+  /// \brief Number of values in each record.
+  uint32_t valueCount{0u};
+
+  /// \brief Exported entities, in the order of the records.
+  std::vector<Entity> entities;
+
+  /// \brief Description of the table in the region.
+  SharedMemoryExportTable *table{nullptr};
+
+  /// \brief Start of the records in the region.
+  char *records{nullptr};
+};
+
+class ignition::gazebo::systems::SharedMemoryExportPrivate
+{
+  /// \brief Create and initialize the shared memory region.
+  /// \return True if successful.
+  public: bool CreateRegion();
+
+  /// \brief Find the entities exported by each table.
+  /// \param[in] _ecm Entity component manager.
+  /// \return True if any table changed.
+  public: bool FindEntities(const EntityComponentManager &_ecm);
+
+  /// \brief Write the values of one table into its records.
+  /// \param[in] _table Table to write.
+  /// \param[in] _ecm Entity component manager.
+  public: void WriteTable(ExportTable &_table,
+              const EntityComponentManager &_ecm) const;
+
+  /// \brief Name of the region.
+  public: std::string name;
+
+  /// \brief Exported tables.
+  public: std::vector<ExportTable> tables;
+
+  /// \brief Maximum number of records in each table.
+  public: uint32_t maxEntities{4096u};
+
+  /// \brief Time between updates of the region, zero to update it on
+  /// every iteration.
+  public: std::chrono::steady_clock::duration updatePeriod{0};
+
+  /// \brief Simulation time of the last update of the region.
+  public: std::chrono::steady_clock::duration lastUpdateTime{0};
+
+  /// \brief Iteration of the last update of the region.
+  public: uint64_t lastIterations{0u};
+
+  /// \brief Whether the entities of each table need to be found.
+  public: bool entitiesDirty{true};
+
+  /// \brief Whether a warning was printed for tables that are full.
+  public: bool warnedFull{false};
+
+  /// \brief Start of the mapped region, null if it couldn't be created.
+  public: void *memory{nullptr};
+
+  /// \brief Size of the mapped region.
+  public: std::size_t size{0u};
+
+  /// \brief Header at the start of the region.
+  public: SharedMemoryExportHeader *header{nullptr};
+};
+
+/////////////////////////////////////////////////
+/// \brief Parse the name of an exported component.
+/// \param[in] _name Name given to the `<component>` parameter.
+/// \param[out] _table Table to set the type and value count of.
+/// \return False if the name isn't known.
+static bool parseExportKind(const std::string &_name, ExportTable &_table)
+{
+  _table.name = _name;
+  if (_name == "pose" || _name == "world_pose")
+  {
+    _table.kind = _name == "pose" ? ExportKind::POSE : ExportKind::WORLD_POSE;
+    _table.valueCount = 7u;
+  }
+  else if (_name == "joint_position" || _name == "joint_velocity")
+  {
+    _table.kind = _name == "joint_position" ? ExportKind::JOINT_POSITION :
+        ExportKind::JOINT_VELOCITY;
+    _table.valueCount = 1u + kMaxJointAxes;
+  }
+  else if (_name == "linear_velocity" || _name == "angular_velocity")
+  {
+    _table.kind = _name == "linear_velocity" ? ExportKind::LINEAR_VELOCITY :
+        ExportKind::ANGULAR_VELOCITY;
+    _table.valueCount = 3u;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a pose as x, y, z, qw, qx, qy, qz.
+/// \param[in] _pose Pose to write.
+/// \param[out] _values Values to write to.
+static void writePose(const math::Pose3d &_pose, double *_values)
+{
+  _values[0] = _pose.Pos().X();
+  _values[1] = _pose.Pos().Y();
+  _values[2] = _pose.Pos().Z();
+  _values[3] = _pose.Rot().W();
+  _values[4] = _pose.Rot().X();
+  _values[5] = _pose.Rot().Y();
+  _values[6] = _pose.Rot().Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a vector as x, y, z.
+/// \param[in] _vec Vector to write.
+/// \param[out] _values Values to write to.
+static void writeVector(const math::Vector3d &_vec, double *_values)
+{
+  _values[0] = _vec.X();
+  _values[1] = _vec.Y();
+  _values[2] = _vec.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write joint axis values as their count followed by the values.
+/// \param[in] _axes Values to write.
+/// \param[out] _values Values to write to.
+static void writeAxes(const std::vector<double> &_axes, double *_values)
+{
+  const std::size_t count =
+      std::min<std::size_t>(_axes.size(), kMaxJointAxes);
+  _values[0] = static_cast<double>(count);
+  for (std::size_t i = 0u; i < kMaxJointAxes; ++i)
+  {
+    _values[1u + i] = i < count ? _axes[i] :
+        std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a component on all entities which have another one.
+/// \param[in] _ecm Entity component manager.
+template <typename EntityComponentT, typename ComponentT>
+static void enableOnAll(EntityComponentManager &_ecm)
+{
+  // Components aren't created while iterating, so that views aren't
+  // modified under Each
+  std::vector<Entity> entities;
+  _ecm.Each<EntityComponentT>(
+      [&](const Entity &_entity, const EntityComponentT *) -> bool
+      {
+        entities.push_back(_entity);
+        return true;
+      });
+  for (const Entity &entity : entities)
+    enableComponent<ComponentT>(_ecm, entity);
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryExportPrivate::CreateRegion()
+{
+#ifndef _WIN32
+  std::size_t size = sizeof(SharedMemoryExportHeader) +
+      this->tables.size() * sizeof(SharedMemoryExportTable);
+  std::vector<uint64_t> offsets;
+  for (const ExportTable &table : this->tables)
+  {
+    offsets.push_back(size);
+    size += std::size_t{this->maxEntities} *
+        (sizeof(uint64_t) + table.valueCount * sizeof(double));
+  }
+
+  // A region with the same name may have been left behind by a process
+  // which crashed
+  const std::string path{"/" + this->name};
+  int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0 && errno == EEXIST)
+  {
+    shm_unlink(path.c_str());
+    fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (fd < 0)
+  {
+    ignerr << "Failed to create shared memory [" << path << "]: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  void *mapped{MAP_FAILED};
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (MAP_FAILED == mapped)
+  {
+    ignerr << "Failed to map shared memory [" << path << "]: "
+           << std::strerror(errno) << std::endl;
+    shm_unlink(path.c_str());
+    return false;
+  }
+
+  this->memory = mapped;
+  this->size = size;
+  this->header = new (mapped) SharedMemoryExportHeader;
+  this->header->version = kSharedMemoryExportVersion;
+  this->header->tableCount = static_cast<uint32_t>(this->tables.size());
+  this->header->size = size;
+
+  auto tableDescs = reinterpret_cast<SharedMemoryExportTable *>(
+      static_cast<char *>(mapped) + sizeof(SharedMemoryExportHeader));
+  for (std::size_t i = 0u; i < this->tables.size(); ++i)
+  {
+    ExportTable &table = this->tables[i];
+    table.table = new (&tableDescs[i]) SharedMemoryExportTable;
+    std::strncpy(table.table->name, table.name.c_str(),
+        sizeof(table.table->name) - 1u);
+    table.table->valueCount = table.valueCount;
+    table.table->capacity = this->maxEntities;
+    table.table->offset = offsets[i];
+    table.records = static_cast<char *>(mapped) + offsets[i];
+  }
+
+  // Readers check the magic number before anything else
+  std::atomic_thread_fence(std::memory_order_release);
+  this->header->magic = kSharedMemoryExportMagic;
+  return true;
+#else
+  ignerr << "Shared memory isn't supported on this platform" << std::endl;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryExportPrivate::FindEntities(
+    const EntityComponentManager &_ecm)
+{
+  bool changed{false};
+  for (ExportTable &table : this->tables)
+  {
+    std::vector<Entity> entities;
+    auto add = [&](const Entity &_entity) -> bool
+    {
+      entities.push_back(_entity);
+      return true;
+    };
+
+    switch (table.kind)
+    {
+      case ExportKind::POSE:
+        _ecm.Each<components::Model, components::Pose>(
+            [&](const Entity &_entity, const components::Model *,
+                const components::Pose *) {return add(_entity);});
+        _ecm.Each<components::Link, components::Pose>(
+            [&](const Entity &_entity, const components::Link *,
+                const components::Pose *) {return add(_entity);});
+        break;
+      case ExportKind::WORLD_POSE:
+        _ecm.Each<components::Link, components::WorldPose>(
+            [&](const Entity &_entity, const components::Link *,
+                const components::WorldPose *) {return add(_entity);});
+        break;
+      case ExportKind::JOINT_POSITION:
+        _ecm.Each<components::Joint, components::JointPosition>(
+            [&](const Entity &_entity, const components::Joint *,
+                const components::JointPosition *) {return add(_entity);});
+        break;
+      case ExportKind::JOINT_VELOCITY:
+        _ecm.Each<components::Joint, components::JointVelocity>(
+            [&](const Entity &_entity, const components::Joint *,
+                const components::JointVelocity *) {return add(_entity);});
+        break;
+      case ExportKind::LINEAR_VELOCITY:
+        _ecm.Each<components::Link, components::LinearVelocity>(
+            [&](const Entity &_entity, const components::Link *,
+                const components::LinearVelocity *) {return add(_entity);});
+        break;
+      case ExportKind::ANGULAR_VELOCITY:
+        _ecm.Each<components::Link, components::AngularVelocity>(
+            [&](const Entity &_entity, const components::Link *,
+                const components::AngularVelocity *) {return add(_entity);});
+        break;
+    }
+
+    if (entities.size() > this->maxEntities)
+    {
+      if (!this->warnedFull)
+      {
+        ignwarn << "More than [" << this->maxEntities << "] entities to "
+                << "export to shared memory [" << this->name << "], only "
+                << "the first ones are exported. Increase <max_entities>."
+                << std::endl;
+        this->warnedFull = true;
+      }
+      entities.resize(this->maxEntities);
+    }
+
+    if (entities != table.entities)
+    {
+      table.entities = std::move(entities);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryExportPrivate::WriteTable(ExportTable &_table,
+    const EntityComponentManager &_ecm) const
+{
+  const std::size_t recordSize =
+      sizeof(uint64_t) + _table.valueCount * sizeof(double);
+  for (std::size_t i = 0u; i < _table.entities.size(); ++i)
+  {
+    const Entity entity = _table.entities[i];
+    char *record = _table.records + i * recordSize;
+    const uint64_t entity64 = entity;
+    std::memcpy(record, &entity64, sizeof(uint64_t));
+
+    double values[7];
+    std::fill(std::begin(values), std::end(values),
+        std::numeric_limits<double>::quiet_NaN());
+    switch (_table.kind)
+    {
+      case ExportKind::POSE:
+      {
+        auto comp = _ecm.Component<components::Pose>(entity);
+        if (comp)
+          writePose(comp->Data(), values);
+        break;
+      }
+      case ExportKind::WORLD_POSE:
+      {
+        auto comp = _ecm.Component<components::WorldPose>(entity);
+        if (comp)
+          writePose(comp->Data(), values);
+        break;
+      }
+      case ExportKind::JOINT_POSITION:
+      {
+        auto comp = _ecm.Component<components::JointPosition>(entity);
+        if (comp)
+          writeAxes(comp->Data(), values);
+        break;
+      }
+      case ExportKind::JOINT_VELOCITY:
+      {
+        auto comp = _ecm.Component<components::JointVelocity>(entity);
+        if (comp)
+          writeAxes(comp->Data(), values);
+        break;
+      }
+      case ExportKind::LINEAR_VELOCITY:
+      {
+        auto comp = _ecm.Component<components::LinearVelocity>(entity);
+        if (comp)
+          writeVector(comp->Data(), values);
+        break;
+      }
+      case ExportKind::ANGULAR_VELOCITY:
+      {
+        auto comp = _ecm.Component<components::AngularVelocity>(entity);
+        if (comp)
+          writeVector(comp->Data(), values);
+        break;
+      }
+    }
+    std::memcpy(record + sizeof(uint64_t), values,
+        _table.valueCount * sizeof(double));
+  }
+  _table.table->count = static_cast<uint32_t>(_table.entities.size());
+}
+
+/////////////////////////////////////////////////
+SharedMemoryExport::SharedMemoryExport()
+  : dataPtr(std::make_unique<SharedMemoryExportPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemoryExport::~SharedMemoryExport()
+{
+#ifndef _WIN32
+  if (nullptr != this->dataPtr->memory)
+  {
+    munmap(this->dataPtr->memory, this->dataPtr->size);
+    shm_unlink(("/" + this->dataPtr->name).c_str());
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryExport::Configure(const Entity &,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm,
+    EventManager &)
+{
+  auto sdfClone = _sdf->Clone();
+
+  std::string worldName;
+  auto worldNameComp =
+      _ecm.Component<components::Name>(worldEntity(_ecm));
+  if (worldNameComp)
+    worldName = worldNameComp->Data();
+  this->dataPtr->name = sdfClone->Get<std::string>("name",
+      "ign_gazebo_" + worldName + "_state").first;
+
+  // Region names can't have slashes
+  for (char &c : this->dataPtr->name)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' &&
+        c != '-' && c != '.')
+    {
+      c = '_';
+    }
+  }
+
+  std::vector<std::string> names;
+  for (auto elem = sdfClone->FindElement("component"); elem;
+       elem = elem->GetNextElement("component"))
+  {
+    names.push_back(elem->Get<std::string>());
+  }
+  if (names.empty())
+    names = {"pose", "joint_position"};
+
+  for (const std::string &name : names)
+  {
+    ExportTable table;
+    if (!parseExportKind(name, table))
+    {
+      ignerr << "Unknown <component> [" << name << "] for shared memory "
+             << "export, skipping." << std::endl;
+      continue;
+    }
+    if (std::any_of(this->dataPtr->tables.begin(),
+        this->dataPtr->tables.end(),
+        [&](const ExportTable &_t) {return _t.name == name;}))
+    {
+      continue;
+    }
+    this->dataPtr->tables.push_back(std::move(table));
+  }
+
+  const int maxEntities = sdfClone->Get<int>("max_entities", 4096).first;
+  if (maxEntities > 0)
+    this->dataPtr->maxEntities = static_cast<uint32_t>(maxEntities);
+
+  const double rate = sdfClone->Get<double>("update_rate", 0.0).first;
+  if (rate > 0.0)
+  {
+    this->dataPtr->updatePeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate));
+  }
+
+  if (this->dataPtr->tables.empty() || !this->dataPtr->CreateRegion())
+  {
+    ignerr << "Shared memory export disabled." << std::endl;
+    this->dataPtr->tables.clear();
+    return;
+  }
+
+  igndbg << "Exporting state to shared memory [" << this->dataPtr->name
+         << "]" << std::endl;
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryExport::PreUpdate(const UpdateInfo &,
+    EntityComponentManager &_ecm)
+{
+  if (nullptr == this->dataPtr->header ||
+      (!this->dataPtr->entitiesDirty && !_ecm.HasNewEntities()))
+  {
+    return;
+  }
+
+  // Components which are only filled by physics if they exist
+  for (const ExportTable &table : this->dataPtr->tables)
+  {
+    switch (table.kind)
+    {
+      case ExportKind::WORLD_POSE:
+        enableOnAll<components::Link, components::WorldPose>(_ecm);
+        break;
+      case ExportKind::JOINT_POSITION:
+        enableOnAll<components::Joint, components::JointPosition>(_ecm);
+        break;
+      case ExportKind::JOINT_VELOCITY:
+        enableOnAll<components::Joint, components::JointVelocity>(_ecm);
+        break;
+      case ExportKind::LINEAR_VELOCITY:
+        enableOnAll<components::Link, components::LinearVelocity>(_ecm);
+        break;
+      case ExportKind::ANGULAR_VELOCITY:
+        enableOnAll<components::Link, components::AngularVelocity>(_ecm);
+        break;
+      default:
+        break;
+    }
+  }
+  this->dataPtr->entitiesDirty = true;
+}
+
+/////////////////////////////////////////////////
+void SharedMemoryExport::PostUpdate(const UpdateInfo &_info,
+    const EntityComponentManager &_ecm)
+{
+  auto header = this->dataPtr->header;
+  if (nullptr == header)
+    return;
+
+  // Entities marked for removal are removed after this update, so the
+  // tables are refreshed on the next one too
+  const bool removing = _ecm.HasEntitiesMarkedForRemoval();
+  const bool findEntities = this->dataPtr->entitiesDirty || removing;
+
+  const bool rewound = _info.simTime < this->dataPtr->lastUpdateTime;
+  if (!findEntities && !rewound)
+  {
+    if (_info.iterations == this->dataPtr->lastIterations)
+      return;
+    if (this->dataPtr->updatePeriod.count() > 0 &&
+        _info.simTime - this->dataPtr->lastUpdateTime <
+        this->dataPtr->updatePeriod)
+    {
+      return;
+    }
+  }
+
+  bool layoutChanged{false};
+  if (findEntities)
+  {
+    layoutChanged = this->dataPtr->FindEntities(_ecm);
+    this->dataPtr->entitiesDirty = removing;
+  }
+
+  const uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+  header->sequence.store(sequence + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  header->iterations = _info.iterations;
+  header->simTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _info.simTime).count();
+  if (layoutChanged)
+    ++header->layoutGeneration;
+  for (ExportTable &table : this->dataPtr->tables)
+    this->dataPtr->WriteTable(table, _ecm);
+
+  header->sequence.store(sequence + 2u, std::memory_order_release);
+
+  this->dataPtr->lastUpdateTime = _info.simTime;
+  this->dataPtr->lastIterations = _info.iterations;
+}
+
+IGNITION_ADD_PLUGIN(SharedMemoryExport,
+                    ignition::gazebo::System,
+                    SharedMemoryExport::ISystemConfigure,
+                    SharedMemoryExport::ISystemPreUpdate,
+                    SharedMemoryExport::ISystemPostUpdate)
+
+IGNITION_ADD_PLUGIN_ALIAS(SharedMemoryExport,
+  "ignition::gazebo::systems::SharedMemoryExport")
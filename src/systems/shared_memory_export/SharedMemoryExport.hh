@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SYSTEMS_SHARED_MEMORY_EXPORT_HH_
+#define IGNITION_GAZEBO_SYSTEMS_SHARED_MEMORY_EXPORT_HH_
+
+#include <memory>
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/System.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declarations.
+  class SharedMemoryExportPrivate;
+
+  /// \brief A system that exports the latest values of some components
+  /// into a named shared memory region, so that processes on the same host,
+  /// such as bridges, can read the state of the world without serializing
+  /// messages or going through sockets. Any number of processes can map the
+  /// region read only.
+  ///
+  /// The layout of the region is described in SharedMemoryExportLayout.hh,
+  /// which consumers include. Each exported component type is held in a
+  /// table of fixed size records, and consumers read consistent snapshots
+  /// through readSharedMemoryExport. The region is removed when the system
+  /// is destroyed.
+  ///
+  /// Shared memory is only supported on POSIX systems.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<name>` Name of the shared memory region. Defaults to
+  ///   `ign_gazebo_<world name>_state`.
+  /// - `<component>` Component to export, may be repeated. Defaults to
+  ///   `pose` and `joint_position`. One of:
+  ///   * `pose`: Pose of models and links, relative to their parent, as
+  ///     x, y, z, qw, qx, qy, qz.
+  ///   * `world_pose`: World pose of links, as above.
+  ///   * `joint_position`: Position of the axes of joints, as the number of
+  ///     axes followed by up to 2 positions.
+  ///   * `joint_velocity`: Velocity of the axes of joints, as above.
+  ///   * `linear_velocity`: Linear velocity of links, as x, y, z.
+  ///   * `angular_velocity`: Angular velocity of links, as x, y, z.
+  /// - `<max_entities>` Maximum number of entities in each table. Further
+  ///   entities aren't exported. Defaults to 4096.
+  /// - `<update_rate>` Rate in Hz at which the region is updated, 0 to
+  ///   update it on every iteration. Defaults to 0.
+  ///
+  /// ## Example Usage
+  ///
+  /** \verbatim
+    <plugin
+      filename="ignition-gazebo-shared-memory-export-system"
+      name="ignition::gazebo::systems::SharedMemoryExport">
+      <component>pose</component>
+      <component>joint_position</component>
+      <component>joint_velocity</component>
+    </plugin>
+  \endverbatim */
+  class SharedMemoryExport :
+    public System,
+    public ISystemConfigure,
+    public ISystemPreUpdate,
+    public ISystemPostUpdate
+  {
+    /// \brief Constructor
+    public: SharedMemoryExport();
+
+    /// \brief Destructor
+    public: ~SharedMemoryExport() final;
+
+    // Documentation inherited
+    public: void Configure(const Entity &_entity,
+                           const std::shared_ptr<const sdf::Element> &_sdf,
+                           EntityComponentManager &_ecm,
+                           EventManager &_eventMgr) final;
+
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                           EntityComponentManager &_ecm) final;
+
+    // Documentation inherited
+    public: void PostUpdate(const UpdateInfo &_info,
+                            const EntityComponentManager &_ecm) final;
+
+    /// \brief Private data pointer.
+    private: std::unique_ptr<SharedMemoryExportPrivate> dataPtr;
+  };
+}
+}
+}
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SYSTEMS_SHARED_MEMORY_EXPORT_LAYOUT_HH_
+#define IGNITION_GAZEBO_SYSTEMS_SHARED_MEMORY_EXPORT_LAYOUT_HH_
+
+#include <atomic>
+#include <cstdint>
+
+#include <ignition/gazebo/config.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Identifies regions written by the SharedMemoryExport system.
+  constexpr uint64_t kSharedMemoryExportMagic{0x69676e5368455831u};
+
+  /// \brief Version of the layout described in this file. It's increased
+  /// whenever the layout changes, and readers must check it.
+  constexpr uint32_t kSharedMemoryExportVersion{1u};
+
+  /// \brief Header at the start of a region written by the
+  /// SharedMemoryExport system. It's followed by `tableCount`
+  /// SharedMemoryExportTable, and then by the records of each table.
+  ///
+  /// Everything after `sequence` is protected by it, seqlock style: the
+  /// writer makes it odd before updating the region and even again once
+  /// done. Readers copy what they need between two loads of `sequence`, and
+  /// retry if it was odd or changed, see readSharedMemoryExport.
+  struct SharedMemoryExportHeader
+  {
+    /// \brief Set to kSharedMemoryExportMagic once the region is
+    /// initialized.
+    uint64_t magic{0u};
+
+    /// \brief Set to kSharedMemoryExportVersion.
+    uint32_t version{0u};
+
+    /// \brief Number of tables.
+    uint32_t tableCount{0u};
+
+    /// \brief Size of the whole region in bytes.
+    uint64_t size{0u};
+
+    /// \brief Sequence number of the seqlock. Odd while being written.
+    alignas(64) std::atomic<uint64_t> sequence{0u};
+
+    /// \brief Simulation iteration of the exported state.
+    uint64_t iterations{0u};
+
+    /// \brief Simulation time of the exported state, in nanoseconds.
+    int64_t simTime{0};
+
+    /// \brief Increased whenever the entities in any table change, so that
+    /// readers can tell when to rebuild indices into the records.
+    uint64_t layoutGeneration{0u};
+  };
+
+  /// \brief Description of a table, holding one component type for a set
+  /// of entities.
+  struct SharedMemoryExportTable
+  {
+    /// \brief Name of the exported component, null terminated, as given to
+    /// the `<component>` parameter of the system, such as "pose".
+    char name[32]{};
+
+    /// \brief Number of values in each record, after the entity.
+    uint32_t valueCount{0u};
+
+    /// \brief Maximum number of records.
+    uint32_t capacity{0u};
+
+    /// \brief Number of records in use.
+    uint32_t count{0u};
+
+    /// \brief Unused, keeps the offset aligned.
+    uint32_t reserved{0u};
+
+    /// \brief Offset of the records from the start of the region. Each
+    /// record is a uint64_t entity followed by valueCount doubles.
+    uint64_t offset{0u};
+  };
+
+  /// \brief Read a consistent snapshot of a region written by the
+  /// SharedMemoryExport system. The read function is called until it copies
+  /// out what it needs without the region being written meanwhile, so it
+  /// may be called more than once and must not keep pointers into the
+  /// region.
+  /// \param[in] _region Start of the mapped region.
+  /// \param[in] _read Function copying out of the region.
+  /// \param[in] _maxAttempts Number of attempts before giving up.
+  /// \return False if the region isn't valid, or if it kept being written.
+  template <typename ReadFunc>
+  bool readSharedMemoryExport(const void *_region, ReadFunc &&_read,
+      unsigned int _maxAttempts = 1000u)
+  {
+    auto header = static_cast<const SharedMemoryExportHeader *>(_region);
+    if (header->magic != kSharedMemoryExportMagic ||
+        header->version != kSharedMemoryExportVersion)
+    {
+      return false;
+    }
+
+    for (unsigned int i = 0u; i < _maxAttempts; ++i)
+    {
+      const uint64_t before = header->sequence.load(std::memory_order_acquire);
+      if (before % 2u != 0u)
+        continue;
+
+      _read(*header);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header->sequence.load(std::memory_order_relaxed) == before)
+        return true;
+    }
+    return false;
+  }
+}
+}
+}
+}
+#endif
@@ -17,7 +17,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
+#include <ignition/msgs/actuators.pb.h>
 #include <ignition/msgs/double.pb.h>
 
 #include <ignition/math/Helpers.hh>
@@ -26,6 +29,7 @@
 
 #include <ignition/transport/Node.hh>
 
+#include "ignition/gazebo/components/Actuators.hh"
 #include "ignition/gazebo/components/AngularVelocity.hh"
 #include "ignition/gazebo/components/BatterySoC.hh"
 #include "ignition/gazebo/components/ChildLinkName.hh"
@@ -40,32 +44,41 @@
 
 #include "Thruster.hh"
 
+#include "../WorldModels.hh"
+
 using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
-class ignition::gazebo::systems::ThrusterPrivateData
+/// \brief Parameters and state of a single thruster.
+struct ThrusterData
 {
-  /// \brief Mutex for read/write access to class
-  public: std::mutex mtx;
-
-  /// \brief Thrust output by propeller in N
+  /// \brief Thrust output by propeller in N. Protected by the system's mutex.
   public: double thrust = 0.0;
 
-  /// \brief Desired propeller angular velocity in rad / s
+  /// \brief Desired propeller angular velocity in rad / s. Protected by the
+  /// system's mutex.
   public: double propellerAngVel = 0.0;
 
   /// \brief Enabled or not
   public: bool enabled = true;
 
+  /// \brief Name of the model, used to find it when the system is attached
+  /// to the world.
+  public: std::string modelName;
+
+  /// \brief Element holding the thruster's parameters, kept until its model
+  /// is found when the system is attached to the world.
+  public: sdf::ElementPtr sdf;
+
   /// \brief Model entity
-  public: ignition::gazebo::Entity modelEntity;
+  public: ignition::gazebo::Entity modelEntity{kNullEntity};
 
   /// \brief The link entity which will spin
-  public: ignition::gazebo::Entity linkEntity;
+  public: ignition::gazebo::Entity linkEntity{kNullEntity};
 
   /// \brief Axis along which the propeller spins. Expressed in the joint
-  /// frame. Addume this doesn't change during simulation.
+  /// frame. Assume this doesn't change during simulation.
   public: ignition::math::Vector3d jointAxis;
 
   /// \brief Joint pose in the child link frame. Assume this doesn't change
@@ -73,10 +86,7 @@ class ignition::gazebo::systems::ThrusterPrivateData
   public: math::Pose3d jointPose;
 
   /// \brief Propeller koint entity
-  public: ignition::gazebo::Entity jointEntity;
-
-  /// \brief ignition node for handling transport
-  public: ignition::transport::Node node;
+  public: ignition::gazebo::Entity jointEntity{kNullEntity};
 
   /// \brief The PID which controls the propeller. This isn't used if
   /// velocityControl is true.
@@ -104,18 +114,83 @@ class ignition::gazebo::systems::ThrusterPrivateData
   /// \brief Diameter of propeller in m, default: 0.02
   public: double propellerDiameter = 0.02;
 
-  /// \brief Callback for handling thrust update
-  public: void OnCmdThrust(const msgs::Double &_msg);
+  /// \brief Index of the thruster's command in the model's Actuators
+  /// component, or -1 to only take commands from transport.
+  public: int actuatorNumber{-1};
+
+  /// \brief Thrust commanded on the current iteration in N.
+  public: double desiredThrust = 0.0;
+
+  /// \brief Propeller angular velocity commanded on the current iteration
+  /// in rad / s.
+  public: double desiredPropellerAngVel = 0.0;
+
+  /// \brief Thrust direction computed on the current iteration, in the world
+  /// frame.
+  public: math::Vector3d unitVector;
+
+  /// \brief Propeller torque computed on the current iteration.
+  public: double torque = 0.0;
+
+  /// \brief Whether a wrench should be applied on this iteration.
+  public: bool apply = false;
 
   /// \brief Function which computes angular velocity from thrust
   /// \param[in] _thrust Thrust in N
   /// \return Angular velocity in rad/s
-  public: double ThrustToAngularVec(double _thrust);
+  public: double ThrustToAngularVec(double _thrust) const;
+};
 
-  /// \brief Returns a boolean if the battery has sufficient charge to continue
-  /// \return True if battery is charged, false otherwise. If no battery found,
-  /// returns true.
-  public: bool HasSufficientBattery(const EntityComponentManager &_ecm) const;
+class ignition::gazebo::systems::ThrusterPrivateData
+{
+  /// \brief Mutex for read/write access to class
+  public: std::mutex mtx;
+
+  /// \brief ignition node for handling transport
+  public: ignition::transport::Node node;
+
+  /// \brief Thrusters handled by the system. There's a single one when the
+  /// system is attached to a model.
+  public: std::vector<ThrusterData> thrusters;
+
+  /// \brief World entity, if the system is attached to the world.
+  public: Entity worldEntity{kNullEntity};
+
+  /// \brief Number of thrusters whose model hasn't been found yet.
+  public: std::size_t pendingThrusters{0u};
+
+  /// \brief Load a thruster's parameters, find its entities and subscribe to
+  /// its commands.
+  /// \param[in] _index Index of the thruster, whose model entity is set.
+  /// \param[in] _sdf Element holding the thruster's parameters.
+  /// \param[in] _ecm Entity component manager.
+  /// \return True if the thruster was loaded.
+  public: bool LoadThruster(std::size_t _index,
+      const std::shared_ptr<const sdf::Element> &_sdf,
+      EntityComponentManager &_ecm);
+
+  /// \brief Load the thrusters whose model hasn't been found yet.
+  /// \param[in] _ecm Entity component manager.
+  public: void FindModels(EntityComponentManager &_ecm);
+
+  /// \brief Callback for handling thrust update
+  /// \param[in] _index Index of the thruster.
+  /// \param[in] _msg Thrust command.
+  public: void OnCmdThrust(std::size_t _index, const msgs::Double &_msg);
+
+  /// \brief Compute the direction and propeller torque of a thruster.
+  /// \param[in,out] _thruster Thruster, whose wrench is updated.
+  /// \param[in] _ecm Entity component manager.
+  /// \param[in] _dt Time step.
+  public: static void ComputeWrench(ThrusterData &_thruster,
+      const EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_dt);
+
+  /// \brief Update which thrusters are enabled, according to the charge of
+  /// their models' batteries. Thrusters of models without batteries are
+  /// always enabled.
+  /// \param[in] _ecm Entity component manager.
+  public: void UpdateBatteries(const EntityComponentManager &_ecm);
 };
 
 /////////////////////////////////////////////////
@@ -132,9 +207,39 @@ void Thruster::Configure(
   EntityComponentManager &_ecm,
   EventManager &/*_eventMgr*/)
 {
+  // When attached to the world, the system handles every <thruster>
+  if (_ecm.Component<components::World>(_entity))
+  {
+    this->dataPtr->worldEntity = _entity;
+    for (const auto &elem : worldModelElements(_sdf, "thruster", "Thruster"))
+    {
+      ThrusterData thruster;
+      thruster.modelName = elem.modelName;
+      thruster.sdf = elem.sdf;
+      this->dataPtr->thrusters.push_back(thruster);
+    }
+
+    // No more thrusters are added, so commands can refer to them by index
+    this->dataPtr->pendingThrusters = this->dataPtr->thrusters.size();
+    this->dataPtr->FindModels(_ecm);
+    return;
+  }
+
+  this->dataPtr->thrusters.emplace_back();
+  this->dataPtr->thrusters[0].modelEntity = _entity;
+  if (!this->dataPtr->LoadThruster(0u, _sdf, _ecm))
+    this->dataPtr->thrusters.clear();
+}
+
+/////////////////////////////////////////////////
+bool ThrusterPrivateData::LoadThruster(std::size_t _index,
+    const std::shared_ptr<const sdf::Element> &_sdf,
+    EntityComponentManager &_ecm)
+{
+  auto &thruster = this->thrusters[_index];
+
   // Create model object, to access convenient functions
-  this->dataPtr->modelEntity = _entity;
-  auto model = Model(_entity);
+  auto model = Model(thruster.modelEntity);
   auto modelName = model.Name(_ecm);
 
   // Get namespace
@@ -149,78 +254,61 @@ void Thruster::Configure(
   {
     ignerr << "Missing <joint_name>. Plugin won't be initialized."
            << std::endl;
-    return;
+    return false;
   }
   auto jointName = _sdf->Get<std::string>("joint_name");
 
   // Get thrust coefficient
   if (_sdf->HasElement("thrust_coefficient"))
   {
-    this->dataPtr->thrustCoefficient = _sdf->Get<double>("thrust_coefficient");
+    thruster.thrustCoefficient = _sdf->Get<double>("thrust_coefficient");
   }
 
   // Get propeller diameter
   if (_sdf->HasElement("propeller_diameter"))
   {
-    this->dataPtr->propellerDiameter = _sdf->Get<double>("propeller_diameter");
+    thruster.propellerDiameter = _sdf->Get<double>("propeller_diameter");
   }
 
   // Get fluid density, default to water otherwise
   if (_sdf->HasElement("fluid_density"))
   {
-    this->dataPtr->fluidDensity = _sdf->Get<double>("fluid_density");
+    thruster.fluidDensity = _sdf->Get<double>("fluid_density");
+  }
+
+  if (_sdf->HasElement("actuator_number"))
+  {
+    thruster.actuatorNumber = _sdf->Get<int>("actuator_number");
   }
 
-  this->dataPtr->jointEntity = model.JointByName(_ecm, jointName);
-  if (kNullEntity == this->dataPtr->jointEntity)
+  thruster.jointEntity = model.JointByName(_ecm, jointName);
+  if (kNullEntity == thruster.jointEntity)
   {
     ignerr << "Failed to find joint [" << jointName << "] in model ["
            << modelName << "]. Plugin not initialized." << std::endl;
-    return;
+    return false;
   }
 
-  this->dataPtr->jointAxis =
+  thruster.jointAxis =
     _ecm.Component<ignition::gazebo::components::JointAxis>(
-    this->dataPtr->jointEntity)->Data().Xyz();
-
-  this->dataPtr->jointPose = _ecm.Component<components::Pose>(
-      this->dataPtr->jointEntity)->Data();
+    thruster.jointEntity)->Data().Xyz();
 
-  // Keeping cmd_pos for backwards compatibility
-  // TODO(chapulina) Deprecate cmd_pos, because the commands aren't positions
-  std::string thrusterTopicOld = ignition::transport::TopicUtils::AsValidTopic(
-    "/model/" + ns + "/joint/" + jointName + "/cmd_pos");
-
-  this->dataPtr->node.Subscribe(
-    thrusterTopicOld,
-    &ThrusterPrivateData::OnCmdThrust,
-    this->dataPtr.get());
-
-  // Subscribe to force commands
-  std::string thrusterTopic = ignition::transport::TopicUtils::AsValidTopic(
-    "/model/" + ns + "/joint/" + jointName + "/cmd_thrust");
-
-  this->dataPtr->node.Subscribe(
-    thrusterTopic,
-    &ThrusterPrivateData::OnCmdThrust,
-    this->dataPtr.get());
-
-  ignmsg << "Thruster listening to commands in [" << thrusterTopic << "]"
-         << std::endl;
+  thruster.jointPose = _ecm.Component<components::Pose>(
+      thruster.jointEntity)->Data();
 
   // Get link entity
   auto childLink =
       _ecm.Component<ignition::gazebo::components::ChildLinkName>(
-      this->dataPtr->jointEntity);
-  this->dataPtr->linkEntity = model.LinkByName(_ecm, childLink->Data());
+      thruster.jointEntity);
+  thruster.linkEntity = model.LinkByName(_ecm, childLink->Data());
 
   // Create necessary components if not present.
-  enableComponent<components::AngularVelocity>(_ecm, this->dataPtr->linkEntity);
+  enableComponent<components::AngularVelocity>(_ecm, thruster.linkEntity);
   enableComponent<components::WorldAngularVelocity>(_ecm,
-      this->dataPtr->linkEntity);
+      thruster.linkEntity);
 
-  double minThrustCmd = this->dataPtr->cmdMin;
-  double maxThrustCmd = this->dataPtr->cmdMax;
+  double minThrustCmd = thruster.cmdMin;
+  double maxThrustCmd = thruster.cmdMax;
   if (_sdf->HasElement("max_thrust_cmd"))
   {
     maxThrustCmd = _sdf->Get<double>("max_thrust_cmd");
@@ -233,21 +321,21 @@ void Thruster::Configure(
   {
     ignerr << "<max_thrust_cmd> must be greater than or equal to "
            << "<min_thrust_cmd>. Revert to using default values: "
-           << "min: " << this->dataPtr->cmdMin << ", "
-           << "max: " << this->dataPtr->cmdMax << std::endl;
+           << "min: " << thruster.cmdMin << ", "
+           << "max: " << thruster.cmdMax << std::endl;
   }
   else
   {
-    this->dataPtr->cmdMax = maxThrustCmd;
-    this->dataPtr->cmdMin = minThrustCmd;
+    thruster.cmdMax = maxThrustCmd;
+    thruster.cmdMin = minThrustCmd;
   }
 
   if (_sdf->HasElement("velocity_control"))
   {
-    this->dataPtr->velocityControl = _sdf->Get<bool>("velocity_control");
+    thruster.velocityControl = _sdf->Get<bool>("velocity_control");
   }
 
-  if (!this->dataPtr->velocityControl)
+  if (!thruster.velocityControl)
   {
     igndbg << "Using PID controller for propeller joint." << std::endl;
 
@@ -256,8 +344,8 @@ void Thruster::Configure(
     double d         =  0;
     double iMax      =  1;
     double iMin      = -1;
-    double cmdMax    = this->dataPtr->ThrustToAngularVec(this->dataPtr->cmdMax);
-    double cmdMin    = this->dataPtr->ThrustToAngularVec(this->dataPtr->cmdMin);
+    double cmdMax    = thruster.ThrustToAngularVec(thruster.cmdMax);
+    double cmdMin    = thruster.ThrustToAngularVec(thruster.cmdMin);
     double cmdOffset =  0;
 
     if (_sdf->HasElement("p_gain"))
@@ -273,7 +361,7 @@ void Thruster::Configure(
       d = _sdf->Get<double>("d_gain");
     }
 
-    this->dataPtr->propellerController.Init(
+    thruster.propellerController.Init(
       p,
       i,
       d,
@@ -287,22 +375,72 @@ void Thruster::Configure(
   {
     igndbg << "Using velocity control for propeller joint." << std::endl;
   }
+
+  // Subscribe once the thruster is set up, since callbacks may come right
+  // away
+  std::function<void(const msgs::Double &)> callback =
+      [this, _index](const msgs::Double &_msg)
+      {
+        this->OnCmdThrust(_index, _msg);
+      };
+
+  // Keeping cmd_pos for backwards compatibility
+  // TODO(chapulina) Deprecate cmd_pos, because the commands aren't positions
+  std::string thrusterTopicOld = ignition::transport::TopicUtils::AsValidTopic(
+    "/model/" + ns + "/joint/" + jointName + "/cmd_pos");
+
+  this->node.Subscribe(thrusterTopicOld, callback);
+
+  // Subscribe to force commands
+  std::string thrusterTopic = ignition::transport::TopicUtils::AsValidTopic(
+    "/model/" + ns + "/joint/" + jointName + "/cmd_thrust");
+
+  this->node.Subscribe(thrusterTopic, callback);
+
+  ignmsg << "Thruster listening to commands in [" << thrusterTopic << "]"
+         << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ThrusterPrivateData::FindModels(EntityComponentManager &_ecm)
+{
+  for (std::size_t i = 0; i < this->thrusters.size(); ++i)
+  {
+    auto &thruster = this->thrusters[i];
+    if (!thruster.sdf)
+      continue;
+
+    // Models may be spawned after the system is loaded
+    auto modelEntity = worldModelByName(_ecm, this->worldEntity,
+        thruster.modelName);
+    if (modelEntity == kNullEntity)
+      continue;
+
+    --this->pendingThrusters;
+    auto sdf = std::move(thruster.sdf);
+    thruster.modelEntity = modelEntity;
+    if (!this->LoadThruster(i, sdf, _ecm))
+      thruster.linkEntity = kNullEntity;
+  }
 }
 
 /////////////////////////////////////////////////
-void ThrusterPrivateData::OnCmdThrust(const msgs::Double &_msg)
+void ThrusterPrivateData::OnCmdThrust(std::size_t _index,
+    const msgs::Double &_msg)
 {
   std::lock_guard<std::mutex> lock(mtx);
-  this->thrust = math::clamp(math::fixnan(_msg.data()),
-    this->cmdMin, this->cmdMax);
+  auto &thruster = this->thrusters[_index];
+  thruster.thrust = math::clamp(math::fixnan(_msg.data()),
+    thruster.cmdMin, thruster.cmdMax);
 
   // Thrust is proportional to the Rotation Rate squared
   // See Thor I Fossen's  "Guidance and Control of ocean vehicles" p. 246
-  this->propellerAngVel = this->ThrustToAngularVec(this->thrust);
+  thruster.propellerAngVel = thruster.ThrustToAngularVec(thruster.thrust);
 }
 
 /////////////////////////////////////////////////
-double ThrusterPrivateData::ThrustToAngularVec(double _thrust)
+double ThrusterData::ThrustToAngularVec(double _thrust) const
 {
   // Thrust is proportional to the Rotation Rate squared
   // See Thor I Fossen's  "Guidance and Control of ocean vehicles" p. 246
@@ -317,101 +455,154 @@ double ThrusterPrivateData::ThrustToAngularVec(double _thrust)
 }
 
 /////////////////////////////////////////////////
-bool ThrusterPrivateData::HasSufficientBattery(
-  const EntityComponentManager &_ecm) const
+void ThrusterPrivateData::UpdateBatteries(const EntityComponentManager &_ecm)
 {
-  bool result = true;
+  std::unordered_set<Entity> drained;
   _ecm.Each<components::BatterySoC>([&](
     const Entity &_entity,
     const components::BatterySoC *_data
   ){
-    if(_ecm.ParentEntity(_entity) == this->modelEntity)
+    if(_data->Data() <= 0)
     {
-      if(_data->Data() <= 0)
-      {
-        result = false;
-      }
+      drained.insert(_ecm.ParentEntity(_entity));
     }
 
     return true;
   });
-  return result;
+
+  for (auto &thruster : this->thrusters)
+    thruster.enabled = drained.find(thruster.modelEntity) == drained.end();
 }
 
 /////////////////////////////////////////////////
-void Thruster::PreUpdate(
-  const ignition::gazebo::UpdateInfo &_info,
-  ignition::gazebo::EntityComponentManager &_ecm)
+void ThrusterPrivateData::ComputeWrench(ThrusterData &_thruster,
+    const EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_dt)
 {
-  if (_info.paused)
+  _thruster.apply = false;
+  if (!_thruster.enabled || _thruster.linkEntity == kNullEntity)
     return;
 
-  if (!this->dataPtr->enabled)
+  ignition::gazebo::Link link(_thruster.linkEntity);
+
+  // TODO(arjo129): add logic for custom coordinate frame
+  // Convert joint axis to the world frame
+  const auto linkWorldPose = worldPose(_thruster.linkEntity, _ecm);
+  auto jointWorldPose = linkWorldPose * _thruster.jointPose;
+  _thruster.unitVector =
+      jointWorldPose.Rot().RotateVector(_thruster.jointAxis).Normalize();
+
+  // PID control
+  _thruster.torque = 0.0;
+  if (!_thruster.velocityControl)
   {
-    return;
+    auto angularVelocity = link.WorldAngularVelocity(_ecm);
+    auto currentAngular = angularVelocity ?
+        angularVelocity->Dot(_thruster.unitVector) : 0.0;
+    auto angularError = currentAngular - _thruster.desiredPropellerAngVel;
+    if (abs(angularError) > 0.1)
+    {
+      _thruster.torque = _thruster.propellerController.Update(angularError,
+          _dt);
+    }
   }
+  _thruster.apply = true;
+}
 
-  ignition::gazebo::Link link(this->dataPtr->linkEntity);
+/////////////////////////////////////////////////
+void Thruster::PreUpdate(
+  const ignition::gazebo::UpdateInfo &_info,
+  ignition::gazebo::EntityComponentManager &_ecm)
+{
+  if (this->dataPtr->pendingThrusters > 0u)
+    this->dataPtr->FindModels(_ecm);
 
-  auto pose = worldPose(this->dataPtr->linkEntity, _ecm);
+  if (_info.paused)
+    return;
 
-  // TODO(arjo129): add logic for custom coordinate frame
-  // Convert joint axis to the world frame
-  const auto linkWorldPose = worldPose(this->dataPtr->linkEntity, _ecm);
-  auto jointWorldPose = linkWorldPose * this->dataPtr->jointPose;
-  auto unitVector =
-      jointWorldPose.Rot().RotateVector(this->dataPtr->jointAxis).Normalize();
+  auto &thrusters = this->dataPtr->thrusters;
 
-  double desiredThrust;
-  double desiredPropellerAngVel;
+  // Latest commands from transport
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mtx);
-    desiredThrust = this->dataPtr->thrust;
-    desiredPropellerAngVel = this->dataPtr->propellerAngVel;
+    for (auto &thruster : thrusters)
+    {
+      thruster.desiredThrust = thruster.thrust;
+      thruster.desiredPropellerAngVel = thruster.propellerAngVel;
+    }
   }
 
-  // PID control
-  double torque = 0.0;
-  if (!this->dataPtr->velocityControl)
+  // Commands in the models' Actuators components take precedence. The
+  // normalized value scales the maximum thrust when positive and the
+  // minimum thrust when negative.
+  for (auto &thruster : thrusters)
   {
-    auto currentAngular = (link.WorldAngularVelocity(_ecm))->Dot(unitVector);
-    auto angularError = currentAngular - desiredPropellerAngVel;
-    if (abs(angularError) > 0.1)
+    if (thruster.actuatorNumber < 0 || thruster.linkEntity == kNullEntity)
+      continue;
+
+    auto actuatorsComp =
+        _ecm.Component<components::Actuators>(thruster.modelEntity);
+    if (!actuatorsComp ||
+        actuatorsComp->Data().normalized_size() <= thruster.actuatorNumber)
     {
-      torque = this->dataPtr->propellerController.Update(angularError,
-          _info.dt);
+      continue;
     }
+
+    auto normalized = math::clamp(math::fixnan(
+        actuatorsComp->Data().normalized(thruster.actuatorNumber)), -1.0, 1.0);
+    thruster.desiredThrust = math::clamp(
+        normalized >= 0.0 ? normalized * thruster.cmdMax :
+        -normalized * thruster.cmdMin, thruster.cmdMin, thruster.cmdMax);
+    thruster.desiredPropellerAngVel =
+        thruster.ThrustToAngularVec(thruster.desiredThrust);
   }
-  // Velocity control
-  else
+
+  // Thrusters are independent of each other, so their wrenches are computed
+  // concurrently, and applied afterwards
+  _ecm.ParallelFor(thrusters.size(),
+      [&](std::size_t _begin, std::size_t _end)
   {
-    auto velocityComp =
-    _ecm.Component<ignition::gazebo::components::JointVelocityCmd>(
-      this->dataPtr->jointEntity);
-    if (velocityComp == nullptr)
-    {
-      _ecm.CreateComponent(this->dataPtr->jointEntity,
-        components::JointVelocityCmd({desiredPropellerAngVel}));
-    }
-    else
+    for (std::size_t i = _begin; i < _end; ++i)
+      ThrusterPrivateData::ComputeWrench(thrusters[i], _ecm, _info.dt);
+  }, 32u);
+
+  for (auto &thruster : thrusters)
+  {
+    if (!thruster.apply)
+      continue;
+
+    // Velocity control
+    if (thruster.velocityControl)
     {
-      velocityComp->Data()[0] = desiredPropellerAngVel;
+      auto velocityComp =
+      _ecm.Component<ignition::gazebo::components::JointVelocityCmd>(
+        thruster.jointEntity);
+      if (velocityComp == nullptr)
+      {
+        _ecm.CreateComponent(thruster.jointEntity,
+          components::JointVelocityCmd({thruster.desiredPropellerAngVel}));
+      }
+      else
+      {
+        velocityComp->Data()[0] = thruster.desiredPropellerAngVel;
+      }
     }
-  }
 
-  // Force: thrust
-  // Torque: propeller rotation, if using PID
-  link.AddWorldWrench(
-    _ecm,
-    unitVector * desiredThrust,
-    unitVector * torque);
+    // Force: thrust
+    // Torque: propeller rotation, if using PID
+    ignition::gazebo::Link link(thruster.linkEntity);
+    link.AddWorldWrench(
+      _ecm,
+      thruster.unitVector * thruster.desiredThrust,
+      thruster.unitVector * thruster.torque);
+  }
 }
 
 /////////////////////////////////////////////////
 void Thruster::PostUpdate(const UpdateInfo &/*unused*/,
   const EntityComponentManager &_ecm)
 {
-  this->dataPtr->enabled = this->dataPtr->HasSufficientBattery(_ecm);
+  this->dataPtr->UpdateBatteries(_ecm);
 }
 
 IGNITION_ADD_PLUGIN(
@@ -421,4 +612,3 @@ IGNITION_ADD_PLUGIN(
   Thruster::ISystemPostUpdate)
 
 IGNITION_ADD_PLUGIN_ALIAS(Thruster, "ignition::gazebo::systems::Thruster")
-
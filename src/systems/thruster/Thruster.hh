@@ -68,6 +68,35 @@ namespace systems
   ///                      defaults to 1000N]
   /// - <min_thrust_cmd> - Minimum thrust command. [Optional,
   ///                      defaults to -1000N]
+  /// - <actuator_number> - Index of the thruster's command in the model's
+  ///   ignition::gazebo::components::Actuators component. Its normalized value,
+  ///   between -1 and 1, scales <max_thrust_cmd> when positive and
+  ///   <min_thrust_cmd> when negative. When the model has the component, it
+  ///   takes precedence over the thrust topic. [Optional]
+  ///
+  /// ## Multiple thrusters
+  /// When attached to the world, the plugin handles one thruster for each
+  /// `<thruster>` element, which takes the parameters above and a
+  /// `<model_name>`, the name of the model which has the propeller joint.
+  /// The namespace defaults to the model's name. Models which are spawned
+  /// after the world is loaded are found once they appear. All thrusters are
+  /// then updated by a single system, which computes their wrenches
+  /// concurrently and checks the batteries of all models at once, instead of
+  /// having one system per thruster.
+  ///
+  /// ```
+  /// <plugin filename="ignition-gazebo-thruster-system"
+  ///     name="ignition::gazebo::systems::Thruster">
+  ///   <thruster>
+  ///     <model_name>sub</model_name>
+  ///     <joint_name>propeller_joint</joint_name>
+  ///   </thruster>
+  ///   <thruster>
+  ///     <model_name>sub2</model_name>
+  ///     <joint_name>propeller_joint</joint_name>
+  ///   </thruster>
+  /// </plugin>
+  /// ```
   ///
   /// ## Example
   /// An example configuration is installed with Gazebo. The example
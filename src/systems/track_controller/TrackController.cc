@@ -22,6 +22,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <ignition/msgs/double.pb.h>
 #include <ignition/msgs/marker.pb.h>
@@ -44,6 +45,10 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Id of the contact surface handlers registered by this system.
+static const char kContactSurfaceHandlerId[] =
+  "ignition::gazebo::systems::TrackController";
+
 class ignition::gazebo::systems::TrackControllerPrivate
 {
   public : ~TrackControllerPrivate() {}
@@ -66,8 +71,8 @@ class ignition::gazebo::systems::TrackControllerPrivate
   public: using P = physics::FeaturePolicy3d;
   public: using F = physics::SetContactPropertiesCallbackFeature;
 
-  /// \brief The callback for CollectContactSurfaceProperties - all the magic
-  /// happens here.
+  /// \brief The contact surface handler of the track collisions - all the
+  /// magic happens here.
   /// \param[in] _collision1 The first colliding body.
   /// \param[in] _collision2 The second colliding body.
   /// \param[in] _point The contact point (in world coords).
@@ -123,8 +128,9 @@ class ignition::gazebo::systems::TrackControllerPrivate
 
   /// \brief Event manager.
   public: EventManager* eventManager;
-  /// \brief Connection to CollectContactSurfaceProperties event.
-  public: common::ConnectionPtr eventConnection;
+  /// \brief Track collisions whose contact surface handler hasn't been
+  /// registered with the physics system yet.
+  public: std::vector<Entity> pendingHandlers;
   /// \brief Ignition transport node.
   public: transport::Node node;
 
@@ -137,6 +143,13 @@ class ignition::gazebo::systems::TrackControllerPrivate
 
   /// \brief World pose of the track's link.
   public: math::Pose3d linkWorldPose;
+  /// \brief World orientation of the track, updated once per step.
+  public: math::Quaterniond trackWorldRot;
+  /// \brief Y axis of the track in world coords, updated once per step.
+  public: math::Vector3d trackYAxisGlobal;
+  /// \brief Copy of centerOfRotation taken once per step, so that contacts
+  /// don't need to lock cmdMutex.
+  public: math::Vector3d stepCenterOfRotation;
   /// \brief World poses of all collision elements of the track's link.
   public: std::unordered_map<Entity, math::Pose3d> collisionsWorldPose;
 
@@ -180,6 +193,14 @@ TrackController::TrackController()
 //////////////////////////////////////////////////
 TrackController::~TrackController()
 {
+  if (nullptr == this->dataPtr->eventManager)
+    return;
+
+  for (const auto &collision : this->dataPtr->trackCollisions)
+  {
+    this->dataPtr->eventManager->Emit<events::RemoveContactSurfaceHandler>(
+      collision, kContactSurfaceHandlerId);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -206,26 +227,6 @@ void TrackController::Configure(const Entity &_entity,
   }
   this->dataPtr->linkName = _sdf->Get<std::string>("link");
 
-  using P = physics::FeaturePolicy3d;
-  using F = physics::SetContactPropertiesCallbackFeature;
-
-  this->dataPtr->eventConnection = this->dataPtr->eventManager->
-    Connect<events::CollectContactSurfaceProperties>(
-    [this](
-      const Entity& _collision1,
-      const Entity& _collision2,
-      const math::Vector3d& _point,
-      const std::optional<math::Vector3d> /* _force */,
-      const std::optional<math::Vector3d> _normal,
-      const std::optional<double> /* _depth */,
-      const size_t /*_numContactsOnCollision*/,
-      F::ContactSurfaceParams<P>& _params)
-    {
-      this->dataPtr->ComputeSurfaceProperties(_collision1, _collision2,
-        _point, _normal, _params);
-    }
-  );
-
   _ecm.Each<components::Collision, components::Name, components::ParentEntity>(
     [&](const Entity & _collisionEntity,
       const components::Collision */*_collision*/,
@@ -392,15 +393,47 @@ void TrackController::PreUpdate(
     return;
   }
 
+  // Hand the track collisions to the physics system, which then only calls
+  // this system for their contacts. This is done here rather than in
+  // Configure, because physics may not be configured yet at that point.
+  for (const auto &collision : this->dataPtr->pendingHandlers)
+  {
+    auto data = this->dataPtr.get();
+    this->dataPtr->eventManager->Emit<events::AddContactSurfaceHandler>(
+      collision, kContactSurfaceHandlerId,
+      [data](
+        const Entity& _collision1,
+        const Entity& _collision2,
+        const math::Vector3d& _point,
+        const std::optional<math::Vector3d> /* _force */,
+        const std::optional<math::Vector3d> _normal,
+        const std::optional<double> /* _depth */,
+        const size_t /*_numContactsOnCollision*/,
+        TrackControllerPrivate::F::ContactSurfaceParams<
+          TrackControllerPrivate::P>& _params)
+      {
+        data->ComputeSurfaceProperties(_collision1, _collision2,
+          _point, _normal, _params);
+      });
+  }
+  this->dataPtr->pendingHandlers.clear();
+
   // Cache poses
   this->dataPtr->linkWorldPose = worldPose(this->dataPtr->linkEntity, _ecm);
   for (auto& collisionEntity : this->dataPtr->trackCollisions)
     this->dataPtr->collisionsWorldPose[collisionEntity] =
       worldPose(collisionEntity, _ecm);
 
+  // Values shared by all contacts of this step
+  this->dataPtr->trackWorldRot =
+    this->dataPtr->linkWorldPose.Rot() * this->dataPtr->trackOrientation;
+  this->dataPtr->trackYAxisGlobal =
+    this->dataPtr->trackWorldRot.RotateVector(math::Vector3d::UnitY);
+
   std::chrono::steady_clock::duration lastCommandTimeCopy;
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->stepCenterOfRotation = this->dataPtr->centerOfRotation;
     if (this->dataPtr->hasNewCommand)
     {
       this->dataPtr->lastCommandTime = _info.simTime;
@@ -477,9 +510,8 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
   if (contactNormal.Dot(collisionPose.Pos() - _point) < 0)
     contactNormal = -contactNormal;
 
-  const auto trackWorldRot = this->linkWorldPose.Rot() * this->trackOrientation;
-  const auto trackYAxisGlobal =
-    trackWorldRot.RotateVector(math::Vector3d::UnitY);
+  const auto &trackWorldRot = this->trackWorldRot;
+  const auto &trackYAxisGlobal = this->trackYAxisGlobal;
 
   // Vector tangent to the belt pointing in the belt's movement direction
   // The belt's bottom moves backwards when the robot should move forward!
@@ -488,14 +520,8 @@ void TrackControllerPrivate::ComputeSurfaceProperties(
   if (this->limitedVelocity < 0)
     beltDirection = -beltDirection;
 
-  math::Vector3d cor;
-  {
-    std::lock_guard<std::mutex> lock(this->cmdMutex);
-    cor = this->centerOfRotation;
-  }
-
   const auto frictionDirection = this->ComputeFrictionDirection(
-    cor, _point, contactNormal, beltDirection);
+    this->stepCenterOfRotation, _point, contactNormal, beltDirection);
 
   _params.firstFrictionalDirection =
     convert(isCollision1Track ? frictionDirection : -frictionDirection);
@@ -591,7 +617,8 @@ void TrackControllerPrivate::RegisterCollision(EntityComponentManager& _ecm,
   if (_link != this->linkEntity)
     return;
 
-  this->trackCollisions.insert(_entity);
+  if (this->trackCollisions.insert(_entity).second)
+    this->pendingHandlers.push_back(_entity);
 
   _ecm.SetComponentData<components::EnableContactSurfaceCustomization>(
     _entity, true);
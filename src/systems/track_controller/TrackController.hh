@@ -54,6 +54,12 @@ namespace systems
   /// does not simulate the effect of grousers. The best way to achieve a
   /// similar effect is to set a very high `<mu1>` for the track links.
   ///
+  /// The track collisions are registered with the physics system through
+  /// events::AddContactSurfaceHandler, so the system is only called for the
+  /// contacts of its own collisions. Values shared by all contacts, like the
+  /// track orientation and the center of rotation, are computed once per
+  /// step.
+  ///
   /// # Examples
   ///
   /// See example usage in worlds example/conveyor.sdf and
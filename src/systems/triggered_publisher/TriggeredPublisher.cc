@@ -30,7 +30,11 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <ignition/common/Profiler.hh>
@@ -97,6 +101,9 @@ class systems::InputMatcher
   /// \brief State of the matcher
   protected: bool valid{false};
 
+  /// \brief Tolerance for float comparisons
+  protected: double tolerance{0.0};
+
   /// \brief Field comparator used by MessageDifferencer. This is where
   /// tolerance for float comparisons is set
   protected: google::protobuf::util::DefaultFieldComparator comparator;
@@ -190,6 +197,35 @@ class FieldMatcher : public InputMatcher
   /// \brief Field descriptor of the field compared by this matcher
   protected: std::vector<const google::protobuf::FieldDescriptor *>
                  fieldDescMatcher;
+
+  /// \brief Compile the comparison of singular scalar fields, so that they
+  /// are compared directly instead of through the MessageDifferencer.
+  /// \param[in] _matcherSubMsg Submessage holding the value to match.
+  protected: void CompileScalar(const transport::ProtoMsg &_matcherSubMsg);
+
+  /// \brief Compare a singular scalar field against the compiled value.
+  /// \param[in] _subMsgInput Input submessage holding the field.
+  /// \return True if the values are equal.
+  protected: bool MatchScalar(const transport::ProtoMsg &_subMsgInput) const;
+
+  /// \brief True if the field is a singular scalar compared with
+  /// MatchScalar.
+  protected: bool scalar{false};
+
+  /// \brief Value of a compiled boolean field.
+  protected: bool boolValue{false};
+
+  /// \brief Value of a compiled signed integer or enum field.
+  protected: int64_t intValue{0};
+
+  /// \brief Value of a compiled unsigned integer field.
+  protected: uint64_t uintValue{0u};
+
+  /// \brief Value of a compiled floating point field.
+  protected: double doubleValue{0.0};
+
+  /// \brief Value of a compiled string field.
+  protected: std::string stringValue;
 };
 
 //////////////////////////////////////////////////
@@ -214,6 +250,7 @@ bool InputMatcher::Match(const transport::ProtoMsg &_input) const
 
 void InputMatcher::SetTolerance(double _tol)
 {
+  this->tolerance = _tol;
   this->comparator.SetDefaultFractionAndMargin(
       std::numeric_limits<double>::min(), _tol);
 }
@@ -306,9 +343,96 @@ FieldMatcher::FieldMatcher(const std::string &_msgType, bool _logicType,
     return;
   }
 
+  this->CompileScalar(*matcherSubMsg);
   this->valid = true;
 }
 
+//////////////////////////////////////////////////
+void FieldMatcher::CompileScalar(const transport::ProtoMsg &_matcherSubMsg)
+{
+  using google::protobuf::FieldDescriptor;
+  const auto *field = this->fieldDescMatcher.back();
+  if (field->is_repeated())
+    return;
+
+  const auto *refl = _matcherSubMsg.GetReflection();
+  this->scalar = true;
+  switch (field->cpp_type())
+  {
+    case FieldDescriptor::CPPTYPE_BOOL:
+      this->boolValue = refl->GetBool(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_INT32:
+      this->intValue = refl->GetInt32(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      this->intValue = refl->GetInt64(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      this->intValue = refl->GetEnumValue(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      this->uintValue = refl->GetUInt32(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      this->uintValue = refl->GetUInt64(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      this->doubleValue = refl->GetFloat(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      this->doubleValue = refl->GetDouble(_matcherSubMsg, field);
+      break;
+    case FieldDescriptor::CPPTYPE_STRING:
+      this->stringValue = refl->GetString(_matcherSubMsg, field);
+      break;
+    default:
+      // Messages are compared by the MessageDifferencer
+      this->scalar = false;
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+bool FieldMatcher::MatchScalar(const transport::ProtoMsg &_subMsgInput) const
+{
+  using google::protobuf::FieldDescriptor;
+  const auto *field = this->fieldDescMatcher.back();
+  const auto *refl = _subMsgInput.GetReflection();
+
+  // Floats are compared the same way as the MessageDifferencer's
+  // approximate comparison
+  auto floatEqual = [this](double _input)
+  {
+    return _input == this->doubleValue ||
+        std::abs(_input - this->doubleValue) <= this->tolerance;
+  };
+
+  switch (field->cpp_type())
+  {
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return refl->GetBool(_subMsgInput, field) == this->boolValue;
+    case FieldDescriptor::CPPTYPE_INT32:
+      return refl->GetInt32(_subMsgInput, field) == this->intValue;
+    case FieldDescriptor::CPPTYPE_INT64:
+      return refl->GetInt64(_subMsgInput, field) == this->intValue;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return refl->GetEnumValue(_subMsgInput, field) == this->intValue;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return refl->GetUInt32(_subMsgInput, field) == this->uintValue;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return refl->GetUInt64(_subMsgInput, field) == this->uintValue;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return floatEqual(refl->GetFloat(_subMsgInput, field));
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return floatEqual(refl->GetDouble(_subMsgInput, field));
+    case FieldDescriptor::CPPTYPE_STRING:
+      return refl->GetString(_subMsgInput, field) == this->stringValue;
+    default:
+      return false;
+  }
+}
+
 //////////////////////////////////////////////////
 bool FieldMatcher::FindFieldSubMessage(
     transport::ProtoMsg *_msg, const std::string &_fieldName,
@@ -411,6 +535,9 @@ bool FieldMatcher::DoMatch(
     }
   }
 
+  if (this->scalar)
+    return this->logicType == this->MatchScalar(*subMsgInput);
+
   return this->logicType ==
          this->diff.CompareWithFields(*subMsgMatcher, *subMsgInput,
                                       {this->fieldDescMatcher.back()},
@@ -473,9 +600,119 @@ std::unique_ptr<InputMatcher> InputMatcher::Create(
   return matcher;
 }
 
+//////////////////////////////////////////////////
+/// \brief Triggered publishers listening to the same input topic and type.
+/// This is shared with the subscription callback, so that it outlives
+/// callbacks which are running while the subscription is removed.
+struct TriggerListeners
+{
+  /// \brief Mutex to protect publishers
+  std::mutex mutex;
+
+  /// \brief Publishers to dispatch input messages to
+  std::vector<TriggeredPublisher *> publishers;
+};
+
+/// \brief Subscription to an input topic, shared by all the triggered
+/// publishers listening to it.
+struct TriggerInput
+{
+  /// \brief Node holding the subscription
+  transport::Node node;
+
+  /// \brief Publishers listening to the input
+  std::shared_ptr<TriggerListeners> listeners;
+};
+
+/// \brief Mutex to protect triggerInputs
+static std::mutex triggerInputsMutex;
+
+/// \brief Shared input subscriptions, keyed by message type and topic
+static std::unordered_map<std::string, std::unique_ptr<TriggerInput>>
+    triggerInputs;
+
+/// \brief Key of an input in triggerInputs
+/// \param[in] _msgType Input message type
+/// \param[in] _topic Input topic
+/// \return Key
+static std::string triggerInputKey(const std::string &_msgType,
+    const std::string &_topic)
+{
+  return _msgType + "@" + _topic;
+}
+
+/// \brief Add a publisher to the listeners of an input topic, subscribing
+/// to the topic if it's the first.
+/// \param[in] _msgType Input message type
+/// \param[in] _topic Input topic
+/// \param[in] _publisher Publisher to add
+/// \return True if the publisher is listening to the topic
+static bool addTriggerListener(const std::string &_msgType,
+    const std::string &_topic, TriggeredPublisher *_publisher)
+{
+  std::lock_guard<std::mutex> lock(triggerInputsMutex);
+  auto &input = triggerInputs[triggerInputKey(_msgType, _topic)];
+  if (!input)
+  {
+    auto newInput = std::make_unique<TriggerInput>();
+    newInput->listeners = std::make_shared<TriggerListeners>();
+    auto msgCb = std::function<void(const transport::ProtoMsg &)>(
+        [listeners = newInput->listeners](const auto &_msg)
+        {
+          std::lock_guard<std::mutex> listenersLock(listeners->mutex);
+          for (auto *publisher : listeners->publishers)
+            publisher->OnInput(_msg);
+        });
+    if (!newInput->node.Subscribe(_topic, msgCb))
+    {
+      triggerInputs.erase(triggerInputKey(_msgType, _topic));
+      return false;
+    }
+    input = std::move(newInput);
+  }
+
+  std::lock_guard<std::mutex> listenersLock(input->listeners->mutex);
+  input->listeners->publishers.push_back(_publisher);
+  return true;
+}
+
+/// \brief Remove a publisher from the listeners of an input topic,
+/// unsubscribing from the topic if it was the last.
+/// \param[in] _msgType Input message type
+/// \param[in] _topic Input topic
+/// \param[in] _publisher Publisher to remove
+static void removeTriggerListener(const std::string &_msgType,
+    const std::string &_topic, TriggeredPublisher *_publisher)
+{
+  std::unique_ptr<TriggerInput> unused;
+  {
+    std::lock_guard<std::mutex> lock(triggerInputsMutex);
+    auto it = triggerInputs.find(triggerInputKey(_msgType, _topic));
+    if (it == triggerInputs.end())
+      return;
+
+    auto &listeners = *it->second->listeners;
+    std::lock_guard<std::mutex> listenersLock(listeners.mutex);
+    listeners.publishers.erase(std::remove(listeners.publishers.begin(),
+        listeners.publishers.end(), _publisher), listeners.publishers.end());
+    if (listeners.publishers.empty())
+    {
+      unused = std::move(it->second);
+      triggerInputs.erase(it);
+    }
+  }
+  // The subscription is removed outside of the locks, since it may wait for
+  // running callbacks
+}
+
 //////////////////////////////////////////////////
 TriggeredPublisher::~TriggeredPublisher()
 {
+  if (this->subscribed)
+  {
+    removeTriggerListener(this->inputMsgType, this->inputTopic, this);
+  }
+
   this->done = true;
   this->newMatchSignal.notify_one();
   if (this->workerThread.joinable())
@@ -601,35 +838,18 @@ void TriggeredPublisher::Configure(const Entity &,
     return;
   }
 
-  auto msgCb = std::function<void(const transport::ProtoMsg &)>(
-      [this](const auto &_msg)
-      {
-        if (this->MatchInput(_msg))
-        {
-          {
-            if (this->delay > 0ms)
-            {
-              std::lock_guard<std::mutex> lock(this->publishQueueMutex);
-              this->publishQueue.push_back(this->delay);
-            }
-            else
-            {
-              {
-                std::lock_guard<std::mutex> lock(this->publishCountMutex);
-                ++this->publishCount;
-              }
-              this->newMatchSignal.notify_one();
-            }
-          }
-        }
-      });
-  if (!this->node.Subscribe(this->inputTopic, msgCb))
+  // The worker thread must be running before inputs are received
+  this->workerThread =
+      std::thread(std::bind(&TriggeredPublisher::DoWork, this));
+
+  if (!addTriggerListener(this->inputMsgType, this->inputTopic, this))
   {
     ignerr << "Input subscriber could not be created for topic ["
            << this->inputTopic << "] with message type [" << this->inputMsgType
            << "]\n";
     return;
   }
+  this->subscribed = true;
 
   std::stringstream ss;
   ss << "TriggeredPublisher subscribed on " << this->inputTopic
@@ -640,9 +860,32 @@ void TriggeredPublisher::Configure(const Entity &,
     ss << info.topic << ", ";
   }
   igndbg << ss.str() << "\n";
+}
 
-  this->workerThread =
-      std::thread(std::bind(&TriggeredPublisher::DoWork, this));
+//////////////////////////////////////////////////
+void TriggeredPublisher::OnInput(const transport::ProtoMsg &_inputMsg)
+{
+  using namespace std::chrono_literals;
+  if (!this->MatchInput(_inputMsg))
+    return;
+
+  if (this->delay > 0ms)
+  {
+    std::lock_guard<std::mutex> lock(this->publishQueueMutex);
+    this->publishQueue.push_back(this->delay);
+    return;
+  }
+
+  // Only wake up the worker for the first pending publication. Inputs which
+  // arrive before it runs are published in the same batch.
+  bool notify{false};
+  {
+    std::lock_guard<std::mutex> lock(this->publishCountMutex);
+    notify = this->publishCount == 0;
+    ++this->publishCount;
+  }
+  if (notify)
+    this->newMatchSignal.notify_one();
 }
 
 //////////////////////////////////////////////////
@@ -154,6 +154,15 @@ namespace systems
   /// </plugin>
   /// \endcode
   ///
+  /// ### Performance
+  /// Field matchers on singular scalar fields, such as numbers, booleans,
+  /// enums and strings, parse their value at configuration and compare it
+  /// straight against the input field. Other matchers compare messages
+  /// through protobuf reflection. All the triggered publishers listening to
+  /// the same input topic and type share a single subscription, so each
+  /// input message is received and parsed once. Outputs triggered by a burst
+  /// of inputs are published together.
+  ///
   /// ### Limitations
   /// The current implementation of this system does not support specifying a
   /// subfield of a repeated field in the "field" attribute. i.e, if
@@ -187,6 +196,10 @@ namespace systems
     /// \return True if all of the matchers return true
     public: bool MatchInput(const transport::ProtoMsg &_inputMsg);
 
+    /// \brief Callback for messages received on the input topic.
+    /// \param[in] _inputMsg Input message
+    public: void OnInput(const transport::ProtoMsg &_inputMsg);
+
     /// \brief Input message type (eg. ignition.msgs.Boolean)
     private: std::string inputMsgType;
 
@@ -241,6 +254,9 @@ namespace systems
     /// \brief Queue of publication times.
     private: std::vector<std::chrono::steady_clock::duration> publishQueue;
 
+    /// \brief True if the system is listening to its input topic
+    private: bool subscribed{false};
+
     /// \brief Mutex to synchronize access to publishQueue
     private: std::mutex publishQueueMutex;
   };
@@ -34,14 +34,21 @@
 #include <ignition/msgs/pose.pb.h>
 #include <ignition/msgs/pose_v.pb.h>
 #include <ignition/msgs/physics.pb.h>
+#include <ignition/msgs/uint64.pb.h>
 #include <ignition/msgs/visual.pb.h>
 #include <ignition/msgs/wheel_slip_parameters_cmd.pb.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <unordered_set>
 #include <vector>
 
+#include <ignition/common/WorkerPool.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/msgs/Utility.hh>
 
@@ -188,6 +195,18 @@ class UserCommandBase
   /// \return True if command was properly executed.
   public: virtual bool Execute() = 0;
 
+  /// \brief Get a key identifying the state set by the command, for
+  /// commands which overwrite all of that state. Among the commands pending
+  /// execution with the same key, only the latest one is executed.
+  /// \return Key, or an empty string if the command must always be
+  /// executed.
+  public: virtual std::string CoalesceKey() const;
+
+  /// \brief Ticket of the asynchronous request which queued the command,
+  /// reported on the results topic once the command is done. Zero for
+  /// commands which weren't requested asynchronously.
+  public: uint64_t ticket{0u};
+
   /// \brief Message containing command.
   protected: google::protobuf::Message *msg{nullptr};
 
@@ -195,6 +214,51 @@ class UserCommandBase
   protected: const std::shared_ptr<UserCommandsInterface> iface{nullptr};
 };
 
+/// \brief Lock-free queue of commands pending execution. Any number of
+/// threads can push commands, while a single thread takes all of them at
+/// once.
+class PendingCommands
+{
+  /// \brief Destructor. Deletes commands which weren't taken.
+  public: ~PendingCommands();
+
+  /// \brief Add a command to the queue.
+  /// \param[in] _cmd Command to add.
+  public: void Push(std::unique_ptr<UserCommandBase> _cmd);
+
+  /// \brief Add several commands to the queue at once, so that they're
+  /// taken together.
+  /// \param[in] _cmds Commands to add, in execution order.
+  public: void Push(std::vector<std::unique_ptr<UserCommandBase>> &&_cmds);
+
+  /// \brief Take all the commands in the queue, in the order they were
+  /// pushed. Commands superseded by later commands with the same coalesce
+  /// key are dropped.
+  /// \param[out] _superseded Tickets of the dropped commands which have
+  /// one are appended to this.
+  /// \return Commands to execute.
+  public: std::vector<std::unique_ptr<UserCommandBase>> Take(
+      std::vector<uint64_t> &_superseded);
+
+  /// \brief Element of the queue.
+  private: struct Node
+  {
+    /// \brief Queued command.
+    std::unique_ptr<UserCommandBase> cmd;
+
+    /// \brief The node pushed before this one.
+    Node *next{nullptr};
+  };
+
+  /// \brief Link a chain of nodes in front of the queue.
+  /// \param[in] _first Newest node of the chain.
+  /// \param[in] _last Oldest node of the chain.
+  private: void Link(Node *_first, Node *_last);
+
+  /// \brief Newest node, from which nodes are linked from newest to oldest.
+  private: std::atomic<Node *> head{nullptr};
+};
+
 /// \brief Command to spawn an entity into simulation.
 class CreateCommand : public UserCommandBase
 {
@@ -206,6 +270,20 @@ class CreateCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  /// \brief Parse the SDF string or file of the factory message, if it has
+  /// one. This doesn't touch the ECM, so it can be called from any thread
+  /// ahead of Execute, which otherwise parses the SDF itself.
+  public: void Parse();
+
+  /// \brief Root loaded by Parse.
+  private: sdf::Root root;
+
+  /// \brief Errors found by Parse.
+  private: sdf::Errors errors;
+
+  /// \brief Whether Parse has been called.
+  private: bool parsed{false};
 };
 
 /// \brief Command to remove an entity from simulation.
@@ -343,6 +421,9 @@ class PoseCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  // Documentation inherited
+  public: std::string CoalesceKey() const final;
 };
 
 /// \brief Command to update an entity's pose transform.
@@ -356,6 +437,9 @@ class PoseVectorCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  // Documentation inherited
+  public: std::string CoalesceKey() const final;
 };
 
 /// \brief Command to modify the physics parameters of a simulation.
@@ -369,6 +453,9 @@ class PhysicsCommand : public UserCommandBase
 
   // Documentation inherited
   public: bool Execute() final;
+
+  // Documentation inherited
+  public: std::string CoalesceKey() const final;
 };
 
 /// \brief Command to modify the spherical coordinates of a simulation.
@@ -423,6 +510,9 @@ class VisualCommand : public UserCommandBase
   // Documentation inherited
   public: bool Execute() final;
 
+  // Documentation inherited
+  public: std::string CoalesceKey() const final;
+
   /// \brief Visual equality comparision function
   /// TODO(anyone) Currently only checks for material colors equality,
   /// need to extend to others
@@ -614,8 +704,43 @@ class ignition::gazebo::systems::UserCommandsPrivate
   public: bool WheelSlipService(
     const msgs::WheelSlipParametersCmd &_req, msgs::Boolean &_res);
 
+  /// \brief Callback for the asynchronous variant of a service. The
+  /// command is queued and the response carries its ticket, without
+  /// waiting for anything else. Entity descriptions of create requests are
+  /// parsed on a worker thread afterwards.
+  /// \param[in] _req Request, as for the synchronous service.
+  /// \param[out] _res Ticket which identifies the command on the results
+  /// topic.
+  /// \return True if successful.
+  /// \tparam CommandT Type of command to queue.
+  /// \tparam MsgT Type of request.
+  public: template <typename CommandT, typename MsgT>
+          bool AsyncService(const MsgT &_req, msgs::UInt64 &_res);
+
+  /// \brief Advertise the asynchronous variant of a service, on
+  /// `<service>/async`.
+  /// \param[in] _service Name of the synchronous service.
+  /// \tparam CommandT Type of command to queue.
+  /// \tparam MsgT Type of request.
+  public: template <typename CommandT, typename MsgT>
+          void AdvertiseAsync(const std::string &_service);
+
+  /// \brief Publish the result of an asynchronous request.
+  /// \param[in] _ticket Ticket of the request.
+  /// \param[in] _success Whether the command was executed successfully.
+  /// \param[in] _superseded Whether the command was dropped because a later
+  /// command overwrote the same state.
+  public: void PublishResult(uint64_t _ticket, bool _success,
+      bool _superseded);
+
   /// \brief Queue of commands pending execution.
-  public: std::vector<std::unique_ptr<UserCommandBase>> pendingCmds;
+  public: PendingCommands pendingCmds;
+
+  /// \brief Ticket for the next asynchronous request.
+  public: std::atomic<uint64_t> nextTicket{1u};
+
+  /// \brief Publisher of the results of asynchronous requests.
+  public: transport::Node::Publisher resultPub;
 
   /// \brief Ignition communication node.
   public: transport::Node node;
@@ -623,8 +748,14 @@ class ignition::gazebo::systems::UserCommandsPrivate
   /// \brief Object holding several interfaces that can be used by any command.
   public: std::shared_ptr<UserCommandsInterface> iface{nullptr};
 
-  /// \brief Mutex to protect pending queue.
-  public: std::mutex pendingMutex;
+  /// \brief Workers which parse the SDF of entities requested through the
+  /// multiple create service, so that the simulation thread only needs to
+  /// create them.
+  public: common::WorkerPool parsePool;
+
+  /// \brief Mutex to protect parsePool, since waiting for its results
+  /// waits for all the work in the pool.
+  public: std::mutex parseMutex;
 };
 
 /// \brief Pose3d equality comparison function.
@@ -639,6 +770,17 @@ bool pose3Eql(const math::Pose3d &_a, const math::Pose3d &_b)
     math::equal(_a.Rot().W(), _b.Rot().W(), 1e-6);
 }
 
+/// \brief Get a key identifying the entity targeted by a pose message, in
+/// the same way as updatePose.
+/// \param[in] _poseMsg Pose message
+/// \return The entity ID, or its name prefixed with '#' if there's no ID.
+std::string poseKey(const msgs::Pose &_poseMsg)
+{
+  if (_poseMsg.id() != kNullEntity && _poseMsg.id() != 0)
+    return std::to_string(_poseMsg.id());
+  return "#" + _poseMsg.name();
+}
+
 /// \brief Update pose for a specific pose message
 /// \param[in] _req Message containing new pose
 /// \param[in] _iface Pointer to user commands interface.
@@ -717,6 +859,8 @@ void UserCommands::Configure(const Entity &_entity,
   std::string createService{"/world/" + validWorldName + "/create"};
   this->dataPtr->node.Advertise(createService,
       &UserCommandsPrivate::CreateService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<CreateCommand,
+      msgs::EntityFactory>(createService);
 
   // Create service for EntityFactory_V
   std::string createServiceMultiple{"/world/" + validWorldName +
@@ -730,6 +874,7 @@ void UserCommands::Configure(const Entity &_entity,
   std::string removeService{"/world/" + validWorldName + "/remove"};
   this->dataPtr->node.Advertise(removeService,
       &UserCommandsPrivate::RemoveService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<RemoveCommand, msgs::Entity>(removeService);
 
   ignmsg << "Remove service on [" << removeService << "]" << std::endl;
 
@@ -737,6 +882,7 @@ void UserCommands::Configure(const Entity &_entity,
   std::string poseService{"/world/" + validWorldName + "/set_pose"};
   this->dataPtr->node.Advertise(poseService,
       &UserCommandsPrivate::PoseService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<PoseCommand, msgs::Pose>(poseService);
 
   ignmsg << "Pose service on [" << poseService << "]" << std::endl;
 
@@ -745,6 +891,8 @@ void UserCommands::Configure(const Entity &_entity,
     "/world/" + worldName + "/set_pose_vector"};
   this->dataPtr->node.Advertise(poseVectorService,
       &UserCommandsPrivate::PoseVectorService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<PoseVectorCommand,
+      msgs::Pose_V>(poseVectorService);
 
   ignmsg << "Pose service on [" << poseVectorService << "]" << std::endl;
 
@@ -752,6 +900,7 @@ void UserCommands::Configure(const Entity &_entity,
   std::string lightService{"/world/" + validWorldName + "/light_config"};
   this->dataPtr->node.Advertise(lightService,
       &UserCommandsPrivate::LightService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<LightCommand, msgs::Light>(lightService);
 
   ignmsg << "Light configuration service on [" << lightService << "]"
     << std::endl;
@@ -764,6 +913,7 @@ void UserCommands::Configure(const Entity &_entity,
   std::string physicsService{"/world/" + validWorldName + "/set_physics"};
   this->dataPtr->node.Advertise(physicsService,
       &UserCommandsPrivate::PhysicsService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<PhysicsCommand, msgs::Physics>(physicsService);
 
   ignmsg << "Physics service on [" << physicsService << "]" << std::endl;
 
@@ -772,6 +922,8 @@ void UserCommands::Configure(const Entity &_entity,
       "/set_spherical_coordinates"};
   this->dataPtr->node.Advertise(sphericalCoordinatesService,
       &UserCommandsPrivate::SphericalCoordinatesService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<SphericalCoordinatesCommand,
+      msgs::SphericalCoordinates>(sphericalCoordinatesService);
 
   ignmsg << "SphericalCoordinates service on [" << sphericalCoordinatesService
          << "]" << std::endl;
@@ -781,6 +933,8 @@ void UserCommands::Configure(const Entity &_entity,
     "/world/" + validWorldName + "/enable_collision"};
   this->dataPtr->node.Advertise(enableCollisionService,
       &UserCommandsPrivate::EnableCollisionService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<EnableCollisionCommand,
+      msgs::Entity>(enableCollisionService);
 
   ignmsg << "Enable collision service on [" << enableCollisionService << "]"
     << std::endl;
@@ -790,6 +944,8 @@ void UserCommands::Configure(const Entity &_entity,
     "/world/" + validWorldName + "/disable_collision"};
   this->dataPtr->node.Advertise(disableCollisionService,
       &UserCommandsPrivate::DisableCollisionService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<DisableCollisionCommand,
+      msgs::Entity>(disableCollisionService);
 
   ignmsg << "Disable collision service on [" << disableCollisionService << "]"
     << std::endl;
@@ -799,6 +955,7 @@ void UserCommands::Configure(const Entity &_entity,
       {"/world/" + worldName + "/visual_config"};
   this->dataPtr->node.Advertise(visualService,
       &UserCommandsPrivate::VisualService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<VisualCommand, msgs::Visual>(visualService);
 
   ignmsg << "Material service on [" << visualService << "]" << std::endl;
 
@@ -807,33 +964,48 @@ void UserCommands::Configure(const Entity &_entity,
       {"/world/" + validWorldName + "/wheel_slip"};
   this->dataPtr->node.Advertise(wheelSlipService,
       &UserCommandsPrivate::WheelSlipService, this->dataPtr.get());
+  this->dataPtr->AdvertiseAsync<WheelSlipCommand,
+      msgs::WheelSlipParametersCmd>(wheelSlipService);
 
   ignmsg << "Material service on [" << wheelSlipService << "]" << std::endl;
+
+  // Results of asynchronous requests
+  std::string resultTopic{"/world/" + validWorldName + "/command_result"};
+  this->dataPtr->resultPub =
+      this->dataPtr->node.Advertise<msgs::Boolean>(resultTopic);
+
+  ignmsg << "Asynchronous command results on [" << resultTopic << "]"
+         << std::endl;
 }
 
 //////////////////////////////////////////////////
 void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
-    EntityComponentManager &)
+    EntityComponentManager &_ecm)
 {
   IGN_PROFILE("UserCommands::PreUpdate");
   // make a copy the cmds so execution does not block receiving other
   // incoming cmds
-  std::vector<std::unique_ptr<UserCommandBase>> cmds;
-  {
-    std::lock_guard<std::mutex> lock(this->dataPtr->pendingMutex);
-    if (this->dataPtr->pendingCmds.empty())
-      return;
-    cmds = std::move(this->dataPtr->pendingCmds);
-    this->dataPtr->pendingCmds.clear();
-  }
+  std::vector<uint64_t> superseded;
+  auto cmds = this->dataPtr->pendingCmds.Take(superseded);
+  for (auto ticket : superseded)
+    this->dataPtr->PublishResult(ticket, true, true);
+  if (cmds.empty())
+    return;
 
   // TODO(louise) Record current world state for undo
 
+  // Entities created by all the commands are added to views in bulk once
+  // the batch ends, instead of once per entity
+  _ecm.BeginBatchCreation();
+
   // Execute pending commands
   for (auto &cmd : cmds)
   {
     // Execute
-    if (!cmd->Execute())
+    const bool success = cmd->Execute();
+    if (cmd->ticket != 0u)
+      this->dataPtr->PublishResult(cmd->ticket, success, false);
+    if (!success)
       continue;
 
     // TODO(louise) Update command with current world state
@@ -841,24 +1013,110 @@ void UserCommands::PreUpdate(const UpdateInfo &/*_info*/,
     // TODO(louise) Move to undo list
   }
 
+  _ecm.EndBatchCreation();
+
   // TODO(louise) Clear redo list
 }
 
+//////////////////////////////////////////////////
+template <typename CommandT, typename MsgT>
+bool UserCommandsPrivate::AsyncService(const MsgT &_req, msgs::UInt64 &_res)
+{
+  auto msg = _req.New();
+  msg->CopyFrom(_req);
+  auto cmd = std::make_unique<CommandT>(msg, this->iface);
+  cmd->ticket = this->nextTicket++;
+  _res.set_data(cmd->ticket);
+
+  if constexpr (std::is_same_v<CommandT, CreateCommand>)
+  {
+    // Parse on a worker, so the transport thread isn't held. The command is
+    // only queued once it's parsed.
+    auto cmdPtr = cmd.release();
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+    this->parsePool.AddWork([this, cmdPtr]()
+    {
+      cmdPtr->Parse();
+      this->pendingCmds.Push(std::unique_ptr<UserCommandBase>(cmdPtr));
+    });
+  }
+  else
+  {
+    this->pendingCmds.Push(std::move(cmd));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+template <typename CommandT, typename MsgT>
+void UserCommandsPrivate::AdvertiseAsync(const std::string &_service)
+{
+  std::string asyncService{_service + "/async"};
+  this->node.Advertise(asyncService,
+      &UserCommandsPrivate::AsyncService<CommandT, MsgT>, this);
+}
+
+//////////////////////////////////////////////////
+void UserCommandsPrivate::PublishResult(uint64_t _ticket, bool _success,
+    bool _superseded)
+{
+  msgs::Boolean msg;
+  msg.set_data(_success);
+  auto data = msg.mutable_header()->add_data();
+  data->set_key("ticket");
+  data->add_value(std::to_string(_ticket));
+  if (_superseded)
+  {
+    data = msg.mutable_header()->add_data();
+    data->set_key("superseded");
+    data->add_value("true");
+  }
+  this->resultPub.Publish(msg);
+}
+
 //////////////////////////////////////////////////
 bool UserCommandsPrivate::CreateServiceMultiple(
     const msgs::EntityFactory_V &_req, msgs::Boolean &_res)
 {
-  std::lock_guard<std::mutex> lock(this->pendingMutex);
+  std::vector<std::unique_ptr<CreateCommand>> cmds;
+  cmds.reserve(_req.data_size());
   for (int i = 0; i < _req.data_size(); ++i)
   {
     const msgs::EntityFactory &msg = _req.data(i);
-    // Create command and push it to queue
     auto msgCopy = msg.New();
     msgCopy->CopyFrom(msg);
-    auto cmd = std::make_unique<CreateCommand>(msgCopy, this->iface);
-    this->pendingCmds.push_back(std::move(cmd));
+    cmds.push_back(std::make_unique<CreateCommand>(msgCopy, this->iface));
+  }
+
+  // Parse SDF in parallel before queuing the commands, so that the
+  // simulation thread only needs to create the entities
+  if (cmds.size() > 1)
+  {
+    std::lock_guard<std::mutex> lock(this->parseMutex);
+    for (auto &cmd : cmds)
+    {
+      auto cmdPtr = cmd.get();
+      this->parsePool.AddWork([cmdPtr]()
+      {
+        cmdPtr->Parse();
+      });
+    }
+    this->parsePool.WaitForResults();
+  }
+  else
+  {
+    for (auto &cmd : cmds)
+      cmd->Parse();
   }
 
+  // Push commands to queue together, so they're executed in the same
+  // iteration
+  std::vector<std::unique_ptr<UserCommandBase>> pending;
+  pending.reserve(cmds.size());
+  for (auto &cmd : cmds)
+    pending.push_back(std::move(cmd));
+  this->pendingCmds.Push(std::move(pending));
+
   _res.set_data(true);
   return true;
 }
@@ -871,12 +1129,10 @@ bool UserCommandsPrivate::CreateService(const msgs::EntityFactory &_req,
   auto msg = _req.New();
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<CreateCommand>(msg, this->iface);
+  cmd->Parse();
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -892,10 +1148,7 @@ bool UserCommandsPrivate::RemoveService(const msgs::Entity &_req,
   auto cmd = std::make_unique<RemoveCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -911,10 +1164,7 @@ bool UserCommandsPrivate::LightService(const msgs::Light &_req,
   auto cmd = std::make_unique<LightCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -928,10 +1178,7 @@ void UserCommandsPrivate::OnCmdLight(const msgs::Light &_msg)
   auto cmd = std::make_unique<LightCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 }
 
 
@@ -945,10 +1192,7 @@ bool UserCommandsPrivate::PoseService(const msgs::Pose &_req,
   auto cmd = std::make_unique<PoseCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -964,10 +1208,7 @@ bool UserCommandsPrivate::PoseVectorService(const msgs::Pose_V &_req,
   auto cmd = std::make_unique<PoseVectorCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -983,10 +1224,7 @@ bool UserCommandsPrivate::EnableCollisionService(const msgs::Entity &_req,
   auto cmd = std::make_unique<EnableCollisionCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1002,10 +1240,7 @@ bool UserCommandsPrivate::DisableCollisionService(const msgs::Entity &_req,
   auto cmd = std::make_unique<DisableCollisionCommand>(msg, this->iface);
 
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1020,10 +1255,7 @@ bool UserCommandsPrivate::PhysicsService(const msgs::Physics &_req,
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<PhysicsCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1038,10 +1270,7 @@ bool UserCommandsPrivate::VisualService(const msgs::Visual &_req,
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<VisualCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1057,10 +1286,7 @@ bool UserCommandsPrivate::WheelSlipService(
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<WheelSlipCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1075,10 +1301,7 @@ bool UserCommandsPrivate::SphericalCoordinatesService(
   msg->CopyFrom(_req);
   auto cmd = std::make_unique<SphericalCoordinatesCommand>(msg, this->iface);
   // Push to pending
-  {
-    std::lock_guard<std::mutex> lock(this->pendingMutex);
-    this->pendingCmds.push_back(std::move(cmd));
-  }
+  this->pendingCmds.Push(std::move(cmd));
 
   _res.set_data(true);
   return true;
@@ -1099,6 +1322,94 @@ UserCommandBase::~UserCommandBase()
   this->msg = nullptr;
 }
 
+//////////////////////////////////////////////////
+std::string UserCommandBase::CoalesceKey() const
+{
+  return std::string();
+}
+
+//////////////////////////////////////////////////
+PendingCommands::~PendingCommands()
+{
+  auto node = this->head.exchange(nullptr, std::memory_order_acquire);
+  while (nullptr != node)
+  {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+//////////////////////////////////////////////////
+void PendingCommands::Push(std::unique_ptr<UserCommandBase> _cmd)
+{
+  auto node = new Node;
+  node->cmd = std::move(_cmd);
+  this->Link(node, node);
+}
+
+//////////////////////////////////////////////////
+void PendingCommands::Push(
+    std::vector<std::unique_ptr<UserCommandBase>> &&_cmds)
+{
+  if (_cmds.empty())
+    return;
+
+  // Chain the nodes from newest to oldest, like the queue itself
+  Node *first{nullptr};
+  Node *last{nullptr};
+  for (auto &cmd : _cmds)
+  {
+    auto node = new Node;
+    node->cmd = std::move(cmd);
+    node->next = first;
+    first = node;
+    if (nullptr == last)
+      last = node;
+  }
+  _cmds.clear();
+  this->Link(first, last);
+}
+
+//////////////////////////////////////////////////
+void PendingCommands::Link(Node *_first, Node *_last)
+{
+  _last->next = this->head.load(std::memory_order_relaxed);
+  while (!this->head.compare_exchange_weak(_last->next, _first,
+      std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
+//////////////////////////////////////////////////
+std::vector<std::unique_ptr<UserCommandBase>> PendingCommands::Take(
+    std::vector<uint64_t> &_superseded)
+{
+  std::vector<std::unique_ptr<UserCommandBase>> cmds;
+  auto node = this->head.exchange(nullptr, std::memory_order_acquire);
+  if (nullptr == node)
+    return cmds;
+
+  // Nodes go from newest to oldest, so the first command seen for each key
+  // is the one to keep
+  std::unordered_set<std::string> keys;
+  while (nullptr != node)
+  {
+    auto key = node->cmd->CoalesceKey();
+    if (key.empty() || keys.insert(std::move(key)).second)
+      cmds.push_back(std::move(node->cmd));
+    else if (node->cmd->ticket != 0u)
+      _superseded.push_back(node->cmd->ticket);
+
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+
+  std::reverse(cmds.begin(), cmds.end());
+  return cmds;
+}
+
 //////////////////////////////////////////////////
 CreateCommand::CreateCommand(msgs::EntityFactory *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
@@ -1106,6 +1417,23 @@ CreateCommand::CreateCommand(msgs::EntityFactory *_msg,
 {
 }
 
+//////////////////////////////////////////////////
+void CreateCommand::Parse()
+{
+  if (this->parsed)
+    return;
+  this->parsed = true;
+
+  auto createMsg = dynamic_cast<const msgs::EntityFactory *>(this->msg);
+  if (nullptr == createMsg)
+    return;
+
+  if (createMsg->from_case() == msgs::EntityFactory::kSdf)
+    this->errors = this->root.LoadSdfString(createMsg->sdf());
+  else if (createMsg->from_case() == msgs::EntityFactory::kSdfFilename)
+    this->errors = this->root.Load(createMsg->sdf_filename());
+}
+
 //////////////////////////////////////////////////
 bool CreateCommand::Execute()
 {
@@ -1116,20 +1444,17 @@ bool CreateCommand::Execute()
     return false;
   }
 
-  // Load SDF
-  sdf::Root root;
+  // Load SDF, unless it was parsed ahead of time
+  this->Parse();
+  const sdf::Root &root = this->root;
   sdf::Light lightSdf;
   sdf::Errors errors;
   switch (createMsg->from_case())
   {
     case msgs::EntityFactory::kSdf:
-    {
-      errors = root.LoadSdfString(createMsg->sdf());
-      break;
-    }
     case msgs::EntityFactory::kSdfFilename:
     {
-      errors = root.Load(createMsg->sdf_filename());
+      errors = this->errors;
       break;
     }
     case msgs::EntityFactory::kModel:
@@ -1562,6 +1887,16 @@ bool PoseCommand::Execute()
   return updatePose(*poseMsg, this->iface);
 }
 
+//////////////////////////////////////////////////
+std::string PoseCommand::CoalesceKey() const
+{
+  auto poseMsg = dynamic_cast<const msgs::Pose *>(this->msg);
+  if (nullptr == poseMsg)
+    return std::string();
+
+  return "pose/" + poseKey(*poseMsg);
+}
+
 //////////////////////////////////////////////////
 PoseVectorCommand::PoseVectorCommand(msgs::Pose_V *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
@@ -1590,6 +1925,20 @@ bool PoseVectorCommand::Execute()
   return true;
 }
 
+//////////////////////////////////////////////////
+std::string PoseVectorCommand::CoalesceKey() const
+{
+  auto poseVectorMsg = dynamic_cast<const msgs::Pose_V *>(this->msg);
+  if (nullptr == poseVectorMsg)
+    return std::string();
+
+  // Only superseded by a later message for the same entities
+  std::string key{"pose_v"};
+  for (int i = 0; i < poseVectorMsg->pose_size(); ++i)
+    key += "/" + poseKey(poseVectorMsg->pose(i));
+  return key;
+}
+
 //////////////////////////////////////////////////
 PhysicsCommand::PhysicsCommand(msgs::Physics *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
@@ -1624,6 +1973,12 @@ bool PhysicsCommand::Execute()
   return true;
 }
 
+//////////////////////////////////////////////////
+std::string PhysicsCommand::CoalesceKey() const
+{
+  return "physics";
+}
+
 //////////////////////////////////////////////////
 SphericalCoordinatesCommand::SphericalCoordinatesCommand(
     msgs::SphericalCoordinates *_msg,
@@ -1847,6 +2202,16 @@ bool VisualCommand::Execute()
   return true;
 }
 
+//////////////////////////////////////////////////
+std::string VisualCommand::CoalesceKey() const
+{
+  auto visualMsg = dynamic_cast<const msgs::Visual *>(this->msg);
+  if (nullptr == visualMsg || visualMsg->id() == kNullEntity)
+    return std::string();
+
+  return "visual/" + std::to_string(visualMsg->id());
+}
+
 //////////////////////////////////////////////////
 WheelSlipCommand::WheelSlipCommand(msgs::WheelSlipParametersCmd *_msg,
     std::shared_ptr<UserCommandsInterface> &_iface)
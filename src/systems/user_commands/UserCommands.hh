@@ -35,6 +35,11 @@ namespace systems
   /// \brief This system provides an Ignition Transport interface to execute
   /// commands while simulation is running.
   ///
+  /// Commands are executed on the next iteration after they're received.
+  /// Pose, pose vector, visual and physics commands overwrite the previous
+  /// state, so if several of them target the same entities before they're
+  /// executed, only the latest one is executed.
+  ///
   /// \todo(louise) In the future, an interface undo/redo commands will also
   /// be provided.
   ///
@@ -48,6 +53,9 @@ namespace systems
   ///
   /// This service can spawn multiple entities in the same iteration,
   /// thereby eliminating simulation steps between entity spawn times.
+  /// The SDF of all entities is parsed in parallel when the request is
+  /// received, so the simulation thread only needs to create them. The
+  /// service replies once parsing is done.
   ///
   /// * **Service**: `/world/<world name>/create_multiple`
   /// * **Request type*: ignition.msgs.EntityFactory_V
@@ -69,6 +77,25 @@ namespace systems
   /// * **Request type*: ignition.msgs.Pose_V
   /// * **Response type*: ignition.msgs.Boolean
   ///
+  /// # Asynchronous requests
+  ///
+  /// The synchronous services reply once a command is queued, so callers
+  /// can't tell when it's applied, and create requests are parsed before
+  /// replying. Each of the services above other than `create_multiple`, as
+  /// well as `remove`, `light_config`, `set_physics`,
+  /// `set_spherical_coordinates`, `enable_collision`, `disable_collision`,
+  /// `visual_config` and `wheel_slip`, has an asynchronous variant at
+  /// `<service>/async`. It takes the same request and replies right away
+  /// with an ignition.msgs.UInt64 ticket. Create requests are then parsed
+  /// on a worker thread before they're queued, so commands requested
+  /// afterwards may be queued before them.
+  ///
+  /// Once the command is executed, an ignition.msgs.Boolean is published on
+  /// `/world/<world name>/command_result`, telling whether it succeeded. Its
+  /// header has a `ticket` entry with the request's ticket, and a
+  /// `superseded` entry if the command was dropped because a later command
+  /// overwrote the same state.
+  ///
   /// Try some examples described on examples/worlds/empty.sdf
   class UserCommands:
     public System,
@@ -17,8 +17,11 @@
 
 #include "WheelSlip.hh"
 
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ignition/common/Profiler.hh>
@@ -70,6 +73,9 @@ class ignition::gazebo::systems::WheelSlipPrivate
 
   public: class LinkSurfaceParams
     {
+      /// \brief Wheel link.
+      public: Entity link;
+
       /// \brief Pointer to wheel spin joint.
       public: Entity joint;
 
@@ -95,10 +101,23 @@ class ignition::gazebo::systems::WheelSlipPrivate
       /// \brief Wheel radius extracted from collision shape if not
       /// specified as xml parameter.
       public: double wheelRadius = 0;
+
+      /// \brief Slip compliance last written to the collision's
+      /// SlipComplianceCmd, empty until it's first written.
+      public: std::vector<double> slipCmd;
     };
 
-  /// \brief The map relating links to their respective surface parameters.
-  public: std::map<Entity, LinkSurfaceParams> mapLinkSurfaceParams;
+  /// \brief Surface parameters of each wheel, packed so that the slip of
+  /// all wheels is computed in one pass.
+  public: std::vector<LinkSurfaceParams> linkSurfaceParams;
+
+  /// \brief Spin speed of each wheel on the current step, NaN for wheels
+  /// whose joint velocity isn't available.
+  public: std::vector<double> spinSpeeds;
+
+  /// \brief Lateral and longitudinal slip of each wheel on the current
+  /// step, interleaved.
+  public: std::vector<double> slips;
 
   /// \brief Vector2d equality comparison function.
   public: std::function<bool(const std::vector<double> &,
@@ -229,10 +248,19 @@ bool WheelSlipPrivate::Load(const EntityComponentManager &_ecm,
       continue;
     }
 
-    this->mapLinkSurfaceParams[link.Entity()] = params;
+    params.link = link.Entity();
+    auto existing = std::find_if(this->linkSurfaceParams.begin(),
+        this->linkSurfaceParams.end(), [&](const LinkSurfaceParams &_params)
+        {
+          return _params.link == params.link;
+        });
+    if (existing != this->linkSurfaceParams.end())
+      *existing = params;
+    else
+      this->linkSurfaceParams.push_back(params);
   }
 
-  if (this->mapLinkSurfaceParams.empty())
+  if (this->linkSurfaceParams.empty())
   {
     ignerr << "No links and surfaces found, plugin is disabled"
            << std::endl;
@@ -245,11 +273,16 @@ bool WheelSlipPrivate::Load(const EntityComponentManager &_ecm,
 /////////////////////////////////////////////////
 void WheelSlipPrivate::Update(EntityComponentManager &_ecm)
 {
-  for (auto &linkSurface : this->mapLinkSurfaceParams)
+  const std::size_t count = this->linkSurfaceParams.size();
+  this->spinSpeeds.resize(count);
+  this->slips.resize(2u * count);
+
+  // Gather the commands and spin speeds of all wheels
+  for (std::size_t i = 0; i < count; ++i)
   {
-    auto &params = linkSurface.second;
+    auto &params = this->linkSurfaceParams[i];
     const auto * wheelSlipCmdComp =
-      _ecm.Component<components::WheelSlipCmd>(linkSurface.first);
+      _ecm.Component<components::WheelSlipCmd>(params.link);
     if (wheelSlipCmdComp)
     {
       const auto & wheelSlipCmdParams = wheelSlipCmdComp->Data();
@@ -269,43 +302,58 @@ void WheelSlipPrivate::Update(EntityComponentManager &_ecm)
         params.slipComplianceLongitudinal =
           wheelSlipCmdParams.slip_compliance_longitudinal();
       }
-      _ecm.RemoveComponent<components::WheelSlipCmd>(linkSurface.first);
+      _ecm.RemoveComponent<components::WheelSlipCmd>(params.link);
     }
 
-    // get user-defined normal force constant
-    double force = params.wheelNormalForce;
-
-    auto joint = params.joint;
-
     auto spinAngularVelocityComp =
-        _ecm.Component<components::JointVelocity>(joint);
+        _ecm.Component<components::JointVelocity>(params.joint);
 
     if (!spinAngularVelocityComp || spinAngularVelocityComp->Data().empty())
+      this->spinSpeeds[i] = std::numeric_limits<double>::quiet_NaN();
+    else
+      this->spinSpeeds[i] = spinAngularVelocityComp->Data()[0];
+  }
+
+  // As discussed in WheelSlip.hh, the slip1 and slip2
+  // parameters have units of inverse viscous damping:
+  // [linear velocity / force] or [m / s / N].
+  // Since the slip compliance parameters supplied to the plugin
+  // are unitless, they must be scaled by a linear speed and force
+  // magnitude.
+  // The force is taken from a user-defined constant that should roughly
+  // match the steady-state normal force at the wheel.
+  // The linear speed is computed dynamically at each time step as
+  // radius * spin angular velocity.
+  // This choice of linear speed corresponds to the denominator of
+  // the slip ratio during acceleration (see equation (1) in
+  // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
+  // "Motion dynamics of a rover with slip-based traction model").
+  // The acceleration form is more well-behaved numerically at low-speed
+  // and when the vehicle is at rest than the braking form,
+  // so it is used for both slip directions.
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto &params = this->linkSurfaceParams[i];
+    const double speed = params.wheelRadius * std::abs(this->spinSpeeds[i]);
+    const double scale = speed / params.wheelNormalForce;
+    this->slips[2u * i] = scale * params.slipComplianceLateral;
+    this->slips[2u * i + 1u] = scale * params.slipComplianceLongitudinal;
+  }
+
+  // Only write the slip of wheels whose slip changed, so that physics only
+  // updates those
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (std::isnan(this->spinSpeeds[i]))
+      continue;
+
+    auto &params = this->linkSurfaceParams[i];
+    std::vector<double> slip{this->slips[2u * i], this->slips[2u * i + 1u]};
+    if (this->vecEql(slip, params.slipCmd))
       continue;
-    double spinAngularVelocity = spinAngularVelocityComp->Data()[0];
-
-    // As discussed in WheelSlip.hh, the slip1 and slip2
-    // parameters have units of inverse viscous damping:
-    // [linear velocity / force] or [m / s / N].
-    // Since the slip compliance parameters supplied to the plugin
-    // are unitless, they must be scaled by a linear speed and force
-    // magnitude.
-    // The force is taken from a user-defined constant that should roughly
-    // match the steady-state normal force at the wheel.
-    // The linear speed is computed dynamically at each time step as
-    // radius * spin angular velocity.
-    // This choice of linear speed corresponds to the denominator of
-    // the slip ratio during acceleration (see equation (1) in
-    // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
-    // "Motion dynamics of a rover with slip-based traction model").
-    // The acceleration form is more well-behaved numerically at low-speed
-    // and when the vehicle is at rest than the braking form,
-    // so it is used for both slip directions.
-    double speed = params.wheelRadius * std::abs(spinAngularVelocity);
-    double slip1 = speed / force * params.slipComplianceLateral;
-    double slip2 = speed / force * params.slipComplianceLongitudinal;
-
-    components::SlipComplianceCmd newSlipCmdComp({slip1, slip2});
+    params.slipCmd = slip;
+
+    components::SlipComplianceCmd newSlipCmdComp(std::move(slip));
 
     auto currSlipCmdComp =
         _ecm.Component<components::SlipComplianceCmd>(params.collision);
@@ -321,6 +369,7 @@ void WheelSlipPrivate::Update(EntityComponentManager &_ecm)
     }
   }
 }
+
 //////////////////////////////////////////////////
 WheelSlip::WheelSlip()
   : dataPtr(std::make_unique<WheelSlipPrivate>())
@@ -358,17 +407,16 @@ void WheelSlip::PreUpdate(const UpdateInfo &_info, EntityComponentManager &_ecm)
   {
     if (this->dataPtr->validConfig)
     {
-      for (const auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
+      for (const auto &linkSurface : this->dataPtr->linkSurfaceParams)
       {
         if (!_ecm.Component<components::WorldAngularVelocity>(
-                linkSurface.first))
+                linkSurface.link))
         {
-          _ecm.CreateComponent(linkSurface.first, components::JointVelocity());
+          _ecm.CreateComponent(linkSurface.link, components::JointVelocity());
         }
-        if (!_ecm.Component<components::JointVelocity>(
-                linkSurface.second.joint))
+        if (!_ecm.Component<components::JointVelocity>(linkSurface.joint))
         {
-          _ecm.CreateComponent(linkSurface.second.joint,
+          _ecm.CreateComponent(linkSurface.joint,
                                components::JointVelocity());
         }
       }
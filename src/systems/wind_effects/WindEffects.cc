@@ -30,7 +30,10 @@
 
 #include <ignition/msgs/boolean.pb.h>
 #include <ignition/msgs/entity_factory.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -58,6 +61,9 @@
 #include "ignition/gazebo/components/WindMode.hh"
 
 #include "ignition/gazebo/Link.hh"
+#include "ignition/gazebo/Util.hh"
+
+#include "WindField.hh"
 
 using namespace ignition;
 using namespace gazebo;
@@ -102,6 +108,14 @@ class ignition::gazebo::systems::WindEffectsPrivate
   /// \param[in] _msg msgs::Wind message.
   public: bool WindInfoService(msgs::Wind &_msg);
 
+  /// \brief Callback for topic for loading a new wind field.
+  /// \param[in] _msg Path to the wind field file.
+  public: void OnWindFieldMsg(const msgs::StringMsg &_msg);
+
+  /// \brief Load a wind field file and make it the current field.
+  /// \param[in] _path Path to the file.
+  public: void LoadWindField(const std::string &_path);
+
   /// \brief World entity to which this system is attached.
   public: Entity worldEntity;
 
@@ -171,6 +185,40 @@ class ignition::gazebo::systems::WindEffectsPrivate
   /// \brief Current wind velocity seed and global enable/disable state.
   /// This is set by a transport message.
   public: msgs::Wind currentWindInfo;
+
+  /// \brief Spatially varying wind added to the global wind velocity. Null
+  /// if there's no field. A new field is loaded apart and swapped in, so
+  /// that loading doesn't block the simulation.
+  public: std::shared_ptr<const WindField> windField;
+
+  /// \brief Mutex to protect windField
+  public: std::mutex windFieldMutex;
+
+  /// \brief Link affected by wind on the current iteration.
+  public: struct WindLink
+  {
+    /// \brief Link entity.
+    Entity entity;
+
+    /// \brief Mass of the link.
+    double mass;
+
+    /// \brief Velocity of the link in the world frame.
+    math::Vector3d velocity;
+
+    /// \brief Wind force, in the world frame.
+    math::Vector3d force;
+
+    /// \brief Torque about the link origin due to the wind force, in the
+    /// world frame.
+    math::Vector3d torque;
+
+    /// \brief Whether the wrench should be applied.
+    bool apply;
+  };
+
+  /// \brief Links affected by wind. Kept as a member to reuse its memory.
+  public: std::vector<WindLink> windLinks;
 };
 
 /////////////////////////////////////////////////
@@ -295,6 +343,16 @@ void WindEffectsPrivate::Load(EntityComponentManager &_ecm,
     this->forceApproximationScalingFactor = sdfForceApprox->Get<double>();
   }
 
+  if (_sdf->HasElement("wind_field"))
+  {
+    auto sdfField = _sdf->GetElementImpl("wind_field");
+    if (sdfField->HasElement("file"))
+    {
+      this->LoadWindField(asFullPath(sdfField->Get<std::string>("file"),
+          _sdf->FilePath()));
+    }
+  }
+
   // If the forceApproximationScalingFactor is very small don't update.
   // It doesn't make sense to be negative, that would be negative wind drag.
   if (std::fabs(this->forceApproximationScalingFactor) < 1e-6)
@@ -326,6 +384,10 @@ void WindEffectsPrivate::SetupTransport(const std::string &_worldName)
   // Wind info service
   this->node.Advertise("/world/" + validWorldName + "/wind_info",
                        &WindEffectsPrivate::WindInfoService, this);
+
+  // Wind field topic
+  this->node.Subscribe("/world/" + validWorldName + "/wind_field",
+                       &WindEffectsPrivate::OnWindFieldMsg, this);
 }
 
 //////////////////////////////////////////////////
@@ -419,8 +481,13 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
   if (!windVel)
     return;
 
-  Link link;
+  std::shared_ptr<const WindField> field;
+  {
+    std::lock_guard<std::mutex> lock(this->windFieldMutex);
+    field = this->windField;
+  }
 
+  this->windLinks.clear();
   _ecm.Each<components::Link, components::Inertial, components::WindMode,
             components::WorldLinearVelocity>(
       [&](const Entity &_entity,
@@ -435,19 +502,76 @@ void WindEffectsPrivate::ApplyWindForce(const UpdateInfo &,
           return true;
         }
 
-        link.ResetEntity(_entity);
+        WindLink windLink;
+        windLink.entity = _entity;
+        windLink.mass = _inertial->Data().MassMatrix().Mass();
+        windLink.velocity = _linkVel->Data();
+        windLink.apply = false;
+        this->windLinks.push_back(windLink);
+        return true;
+      });
 
-        math::Vector3d windForce = _inertial->Data().MassMatrix().Mass() *
-                                   this->forceApproximationScalingFactor *
-                                   (windVel->Data() - _linkVel->Data());
+  // Links are independent of each other, so their wind forces are computed
+  // concurrently, and applied afterwards
+  const EntityComponentManager &ecm = _ecm;
+  ecm.ParallelFor(this->windLinks.size(),
+      [&](std::size_t _begin, std::size_t _end)
+  {
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      auto &windLink = this->windLinks[i];
+      auto inertial = ecm.Component<components::Inertial>(windLink.entity);
+      auto worldPose = ecm.Component<components::WorldPose>(windLink.entity);
+
+      // Can't apply force if the inertial's pose is not found
+      if (!inertial || !worldPose)
+        continue;
+
+      math::Vector3d linkWindVel = windVel->Data();
+      if (field)
+        linkWindVel += field->Sample(worldPose->Data().Pos());
+
+      windLink.force = windLink.mass *
+          this->forceApproximationScalingFactor *
+          (linkWindVel - windLink.velocity);
+
+      // Apply force at center of mass, which results in a torque about the
+      // link origin
+      auto posComWorldCoord = worldPose->Data().Rot().RotateVector(
+          inertial->Data().Pose().Pos());
+      windLink.torque = posComWorldCoord.Cross(windLink.force);
+      windLink.apply = true;
+    }
+  }, 32u);
 
-        // Apply force at center of mass
-        link.AddWorldForce(_ecm, windForce);
+  Link link;
+  for (const auto &windLink : this->windLinks)
+  {
+    if (!windLink.apply)
+      continue;
 
-        return true;
-      });
+    link.ResetEntity(windLink.entity);
+    link.AddWorldWrench(_ecm, windLink.force, windLink.torque);
+  }
+}
+
+//////////////////////////////////////////////////
+void WindEffectsPrivate::OnWindFieldMsg(const msgs::StringMsg &_msg)
+{
+  this->LoadWindField(_msg.data());
 }
 
+//////////////////////////////////////////////////
+void WindEffectsPrivate::LoadWindField(const std::string &_path)
+{
+  auto field = std::make_shared<WindField>();
+  if (!field->Load(_path))
+    return;
+
+  igndbg << "Loaded wind field [" << _path << "]" << std::endl;
+  std::lock_guard<std::mutex> lock(this->windFieldMutex);
+  this->windField = field;
+}
 
 //////////////////////////////////////////////////
 void WindEffectsPrivate::OnWindMsg(const msgs::Wind &_msg)
@@ -86,6 +86,17 @@ namespace systems
   /// - `<vertical><noise>`
   /// Parameters for the noise that is added to the vertical wind velocity
   /// magnitude.
+  ///
+  /// - `<wind_field><file>`
+  /// Optional path to a file describing a spatially varying wind velocity
+  /// on a regular grid, which is added to the global wind velocity at each
+  /// link's position. See WindField for the file format. A new field can be
+  /// loaded at runtime by publishing its path to the
+  /// `/world/<world>/wind_field` topic. The file is loaded on the transport
+  /// thread and swapped in once ready.
+  ///
+  /// Wind forces of all links are computed in parallel, and applied
+  /// afterwards.
   class WindEffects:
     public System,
     public ISystemConfigure,
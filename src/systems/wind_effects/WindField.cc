@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "WindField.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+//////////////////////////////////////////////////
+bool WindField::Load(const std::string &_path)
+{
+  std::ifstream file(_path);
+  if (!file.is_open())
+  {
+    ignerr << "Failed to open wind field file [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  // Gather all values, without comments
+  std::stringstream values;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    auto comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+    values << line << '\n';
+  }
+
+  math::Vector3d newOrigin;
+  math::Vector3d newSpacing;
+  double newSize[3];
+  std::string originKey, spacingKey, sizeKey;
+  values >> originKey >> newOrigin
+         >> spacingKey >> newSpacing
+         >> sizeKey >> newSize[0] >> newSize[1] >> newSize[2];
+  if (!values || originKey != "origin" || spacingKey != "spacing" ||
+      sizeKey != "size")
+  {
+    ignerr << "Wind field file [" << _path << "] must start with the grid's "
+           << "[origin], [spacing] and [size]" << std::endl;
+    return false;
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (newSize[i] < 1 || std::floor(newSize[i]) != newSize[i] ||
+        newSpacing[i] <= 0)
+    {
+      ignerr << "Wind field file [" << _path << "] has an invalid size or "
+             << "spacing" << std::endl;
+      return false;
+    }
+  }
+
+  const auto count = static_cast<std::size_t>(newSize[0]) *
+      static_cast<std::size_t>(newSize[1]) *
+      static_cast<std::size_t>(newSize[2]);
+  std::vector<math::Vector3d> newVelocities(count);
+  for (auto &vel : newVelocities)
+    values >> vel;
+
+  if (!values)
+  {
+    ignerr << "Wind field file [" << _path << "] should have [" << count
+           << "] velocities" << std::endl;
+    return false;
+  }
+
+  this->origin = newOrigin;
+  this->spacing = newSpacing;
+  for (int i = 0; i < 3; ++i)
+    this->size[i] = static_cast<std::size_t>(newSize[i]);
+  this->velocities = std::move(newVelocities);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool WindField::Empty() const
+{
+  return this->velocities.empty();
+}
+
+//////////////////////////////////////////////////
+const math::Vector3d &WindField::At(std::size_t _x, std::size_t _y,
+    std::size_t _z) const
+{
+  return this->velocities[(_z * this->size[1] + _y) * this->size[0] + _x];
+}
+
+//////////////////////////////////////////////////
+math::Vector3d WindField::Sample(const math::Vector3d &_pos) const
+{
+  if (this->velocities.empty())
+    return math::Vector3d::Zero;
+
+  // Lower grid index and interpolation weight along each axis
+  std::size_t index[3];
+  double t[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double last = static_cast<double>(this->size[i] - 1u);
+    const double g = std::clamp(
+        (_pos[i] - this->origin[i]) / this->spacing[i], 0.0, last);
+    index[i] = std::min(static_cast<std::size_t>(g),
+        this->size[i] > 1u ? this->size[i] - 2u : 0u);
+    t[i] = g - static_cast<double>(index[i]);
+  }
+
+  // Upper grid index, which is the same as the lower one along axes with a
+  // single point
+  std::size_t next[3];
+  for (int i = 0; i < 3; ++i)
+    next[i] = std::min(index[i] + 1u, this->size[i] - 1u);
+
+  auto lerp = [](const math::Vector3d &_a, const math::Vector3d &_b, double _t)
+  {
+    return _a + (_b - _a) * _t;
+  };
+
+  const auto c00 = lerp(this->At(index[0], index[1], index[2]),
+      this->At(next[0], index[1], index[2]), t[0]);
+  const auto c10 = lerp(this->At(index[0], next[1], index[2]),
+      this->At(next[0], next[1], index[2]), t[0]);
+  const auto c01 = lerp(this->At(index[0], index[1], next[2]),
+      this->At(next[0], index[1], next[2]), t[0]);
+  const auto c11 = lerp(this->At(index[0], next[1], next[2]),
+      this->At(next[0], next[1], next[2]), t[0]);
+
+  return lerp(lerp(c00, c10, t[1]), lerp(c01, c11, t[1]), t[2]);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_SYSTEMS_WIND_EFFECTS_WINDFIELD_HH_
+#define IGNITION_GAZEBO_SYSTEMS_WIND_EFFECTS_WINDFIELD_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/wind-effects-system/Export.hh>
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  /// \brief Wind velocities sampled on a regular 3D grid, such as the output
+  /// of a CFD simulation of an urban area.
+  ///
+  /// The field is loaded from a text file. Anything after a `#` is a comment.
+  /// The file starts with three lines:
+  ///
+  ///     origin <x> <y> <z>
+  ///     spacing <dx> <dy> <dz>
+  ///     size <nx> <ny> <nz>
+  ///
+  /// where `origin` is the world position of the first grid point, `spacing`
+  /// the distance between grid points along each axis and `size` the number
+  /// of grid points along each axis. They're followed by `nx * ny * nz`
+  /// velocities, each as `<vx> <vy> <vz>` in the world frame, with the X
+  /// index varying fastest, then Y, then Z.
+  class IGNITION_GAZEBO_WIND_EFFECTS_SYSTEM_VISIBLE WindField
+  {
+    /// \brief Load a field from a file.
+    /// \param[in] _path Path to the file.
+    /// \return True if the file was loaded. Errors are printed otherwise, and
+    /// the field is left unchanged.
+    public: bool Load(const std::string &_path);
+
+    /// \brief Get the wind velocity at a position, trilinearly interpolated
+    /// from the surrounding grid points. Positions outside of the grid get
+    /// the velocity at the closest point on its boundary.
+    /// \param[in] _pos Position in the world frame.
+    /// \return Wind velocity in the world frame, or zero if the field is
+    /// empty.
+    public: math::Vector3d Sample(const math::Vector3d &_pos) const;
+
+    /// \brief Whether the field has no grid points.
+    /// \return True if no field was loaded.
+    public: bool Empty() const;
+
+    /// \brief Get the velocity at a grid point.
+    /// \param[in] _x X index.
+    /// \param[in] _y Y index.
+    /// \param[in] _z Z index.
+    /// \return Velocity.
+    private: const math::Vector3d &At(std::size_t _x, std::size_t _y,
+        std::size_t _z) const;
+
+    /// \brief World position of the first grid point.
+    private: math::Vector3d origin;
+
+    /// \brief Distance between grid points along each axis.
+    private: math::Vector3d spacing{1, 1, 1};
+
+    /// \brief Number of grid points along each axis.
+    private: std::size_t size[3]{0u, 0u, 0u};
+
+    /// \brief Velocities at the grid points, X index first.
+    private: std::vector<math::Vector3d> velocities;
+  };
+}
+}
+}
+}
+#endif
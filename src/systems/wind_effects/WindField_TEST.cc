@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "ignition/gazebo/test_config.hh"
+#include "WindField.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/////////////////////////////////////////////////
+/// \brief Write a wind field file.
+/// \param[in] _contents Contents of the file.
+/// \return Path to the file.
+std::string writeField(const std::string &_contents)
+{
+  const std::string path = common::joinPaths(PROJECT_BINARY_PATH,
+      "test_wind_field.txt");
+  std::ofstream out(path, std::ios::trunc);
+  out << _contents;
+  return path;
+}
+
+/////////////////////////////////////////////////
+TEST(WindField, Sample)
+{
+  WindField field;
+  EXPECT_TRUE(field.Empty());
+  EXPECT_EQ(math::Vector3d::Zero, field.Sample(math::Vector3d::Zero));
+
+  // 2 x 2 x 2 grid, where the velocity is the grid point's position
+  const auto path = writeField(
+      "# Test field\n"
+      "origin 1 2 3\n"
+      "spacing 2 2 2\n"
+      "size 2 2 2\n"
+      "1 2 3\n"
+      "3 2 3\n"
+      "1 4 3\n"
+      "3 4 3  # last point of the bottom layer\n"
+      "1 2 5\n"
+      "3 2 5\n"
+      "1 4 5\n"
+      "3 4 5\n");
+  ASSERT_TRUE(field.Load(path));
+  EXPECT_FALSE(field.Empty());
+
+  // Grid points
+  EXPECT_EQ(math::Vector3d(1, 2, 3), field.Sample({1, 2, 3}));
+  EXPECT_EQ(math::Vector3d(3, 4, 5), field.Sample({3, 4, 5}));
+
+  // Trilinear interpolation of a linear field is exact
+  EXPECT_EQ(math::Vector3d(2, 3, 4), field.Sample({2, 3, 4}));
+  EXPECT_EQ(math::Vector3d(1.5, 3.5, 4.25), field.Sample({1.5, 3.5, 4.25}));
+
+  // Outside of the grid, the closest boundary point is used
+  EXPECT_EQ(math::Vector3d(1, 2, 3), field.Sample({-10, -10, -10}));
+  EXPECT_EQ(math::Vector3d(3, 3, 5), field.Sample({10, 3, 10}));
+
+  common::removeFile(path);
+}
+
+/////////////////////////////////////////////////
+TEST(WindField, SinglePointAxis)
+{
+  // A single layer along Z
+  WindField field;
+  const auto path = writeField(
+      "origin 0 0 10\n"
+      "spacing 1 1 1\n"
+      "size 2 1 1\n"
+      "0 0 0\n"
+      "4 0 0\n");
+  ASSERT_TRUE(field.Load(path));
+  EXPECT_EQ(math::Vector3d(1, 0, 0), field.Sample({0.25, 5, 0}));
+  EXPECT_EQ(math::Vector3d(4, 0, 0), field.Sample({3, -5, 20}));
+
+  common::removeFile(path);
+}
+
+/////////////////////////////////////////////////
+TEST(WindField, Invalid)
+{
+  WindField field;
+  EXPECT_FALSE(field.Load("/not/a/file"));
+
+  // Missing header
+  auto path = writeField("1 2 3\n");
+  EXPECT_FALSE(field.Load(path));
+
+  // Zero spacing
+  path = writeField("origin 0 0 0\nspacing 0 1 1\nsize 1 1 1\n1 1 1\n");
+  EXPECT_FALSE(field.Load(path));
+
+  // Too few velocities
+  path = writeField("origin 0 0 0\nspacing 1 1 1\nsize 2 1 1\n1 1 1\n");
+  EXPECT_FALSE(field.Load(path));
+  EXPECT_TRUE(field.Empty());
+
+  common::removeFile(path);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../../src/Barrier.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Drive a pair of barriers the way the simulation runner drives its
+/// PostUpdate threads: workers wait on a start barrier, do no work, and
+/// wait on a stop barrier, so the benchmark measures the synchronization
+/// cost of one step.
+/// Arguments are the number of worker threads and the spin count.
+// NOLINTNEXTLINE
+void BM_BarrierStep(benchmark::State &_st)
+{
+  const auto workers = static_cast<unsigned int>(_st.range(0));
+  const auto spin = static_cast<unsigned int>(_st.range(1));
+
+  Barrier start(workers + 1, spin);
+  Barrier stop(workers + 1, spin);
+  std::atomic<bool> running{true};
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < workers; ++i)
+  {
+    threads.push_back(std::thread([&]()
+    {
+      while (running)
+      {
+        start.Wait();
+        stop.Wait();
+      }
+    }));
+  }
+
+  for (auto _ : _st)
+  {
+    start.Wait();
+    stop.Wait();
+  }
+
+  running = false;
+  start.Cancel();
+  stop.Cancel();
+  for (auto &thread : threads)
+    thread.join();
+
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+BENCHMARK(BM_BarrierStep)
+  ->ArgsProduct({{1, 4, 16}, {0, 1000, 100000}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <ignition/msgs/dataframe.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ignition/gazebo/comms/Broker.hh"
+#include "ignition/gazebo/comms/MsgManager.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Total rate at which the producers of BM_BrokerStep push messages.
+static constexpr double kMsgsPerSecond{100000.0};
+
+/// \brief Drain the outbound queues the way a comms model step does.
+/// \param[in] _broker Broker.
+/// \return Number of messages drained.
+static std::size_t step(comms::Broker &_broker)
+{
+  std::size_t count{0u};
+  _broker.Lock();
+  for (auto &[address, content] : _broker.DataManager().Data())
+  {
+    count += content.outboundMsgs.size();
+    content.outboundMsgs.clear();
+  }
+  _broker.Unlock();
+  return count;
+}
+
+/// \brief Push messages to the broker from several threads, the way
+/// transport threads do, measuring the throughput of OnMsg. Each thread
+/// drains the broker every 1000 messages, so that the queues don't grow
+/// unbounded.
+// NOLINTNEXTLINE
+void BM_BrokerOnMsg(benchmark::State &_st)
+{
+  static comms::Broker broker;
+
+  msgs::Dataframe msg;
+  msg.set_src_address("addr1");
+  msg.set_dst_address("addr0");
+  msg.set_data(std::string(64, 'x'));
+
+  int count{0};
+  for (auto _ : _st)
+  {
+    broker.OnMsg(msg);
+    if (++count % 1000 == 0)
+      step(broker);
+  }
+  step(broker);
+
+  _st.SetItemsProcessed(_st.iterations());
+}
+
+BENCHMARK(BM_BrokerOnMsg)
+  ->ThreadRange(1, 8)
+  ->UseRealTime();
+
+/// \brief Step the broker while producer threads push a total of 100k
+/// messages per second, measuring the time the step holds the broker.
+/// The argument is the number of producer threads.
+// NOLINTNEXTLINE
+void BM_BrokerStep(benchmark::State &_st)
+{
+  const auto producers = static_cast<int>(_st.range(0));
+  comms::Broker broker;
+  std::atomic<bool> running{true};
+
+  const auto period = std::chrono::duration<double>(producers /
+      kMsgsPerSecond);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+    {
+      msgs::Dataframe msg;
+      msg.set_src_address("addr" + std::to_string(i));
+      msg.set_dst_address("addr0");
+      msg.set_data(std::string(64, 'x'));
+
+      auto next = std::chrono::steady_clock::now();
+      while (running)
+      {
+        broker.OnMsg(msg);
+        next += std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(period);
+        std::this_thread::sleep_until(next);
+      }
+    }));
+  }
+
+  std::size_t drained{0u};
+  for (auto _ : _st)
+  {
+    drained += step(broker);
+
+    // Let messages accumulate as they would during a 1 ms step
+    _st.PauseTiming();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    _st.ResumeTiming();
+  }
+
+  running = false;
+  for (auto &thread : threads)
+    thread.join();
+
+  _st.SetItemsProcessed(drained);
+}
+
+BENCHMARK(BM_BrokerStep)
+  ->Arg(1)
+  ->Arg(4)
+  ->Arg(16)
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace components;
+
+/// \brief Exposes the step functions that the simulation runner calls.
+class ChurnManager : public EntityComponentManager
+{
+  public: using EntityComponentManager::ProcessRemoveEntityRequests;
+};
+
+/// \brief Create a swarm of models, and the views that a few typical
+/// systems would have cached for them.
+/// \param[in] _mgr Manager to populate.
+/// \param[in] _count Number of models.
+/// \return The models.
+static std::vector<Entity> populate(EntityComponentManager &_mgr,
+    int64_t _count)
+{
+  std::vector<Entity> models;
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    Entity entity = _mgr.CreateEntity();
+    _mgr.CreateComponent(entity, Model());
+    _mgr.CreateComponent(entity, components::Name("model"));
+    _mgr.CreateComponent(entity, Pose());
+    if (i % 2 == 0)
+      _mgr.CreateComponent(entity, LinearVelocity());
+    models.push_back(entity);
+  }
+
+  _mgr.Each<Model, Pose>([](const Entity &, const Model *, const Pose *)
+      {
+        return true;
+      });
+  _mgr.Each<Model, components::Name>(
+      [](const Entity &, const Model *, const components::Name *)
+      {
+        return true;
+      });
+  _mgr.Each<Pose, LinearVelocity>(
+      [](const Entity &, const Pose *, const LinearVelocity *)
+      {
+        return true;
+      });
+  return models;
+}
+
+/// \brief Remove a whole swarm of models with cached views in a single
+/// step. The slowest iteration is reported as the "worst_ms" counter,
+/// since spikes matter more than the average here.
+// NOLINTNEXTLINE
+void BM_RemoveSwarm(benchmark::State &_st)
+{
+  double worst{0.0};
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    ChurnManager mgr;
+    auto models = populate(mgr, _st.range(0));
+    _st.ResumeTiming();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const Entity entity : models)
+      mgr.RequestRemoveEntity(entity);
+    mgr.ProcessRemoveEntityRequests();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    worst = std::max(worst, elapsed.count());
+  }
+  _st.counters["worst_ms"] = worst;
+}
+
+/// \brief Apply the full state of a swarm of models, as a secondary or a
+/// GUI does, onto a manager which already has cached views. The slowest
+/// iteration is reported as the "worst_ms" counter.
+// NOLINTNEXTLINE
+void BM_ApplySwarmState(benchmark::State &_st)
+{
+  EntityComponentManager source;
+  populate(source, _st.range(0));
+  msgs::SerializedStateMap state;
+  source.State(state, {}, {}, true);
+
+  double worst{0.0};
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    EntityComponentManager mgr;
+    populate(mgr, 1);
+    _st.ResumeTiming();
+
+    const auto start = std::chrono::steady_clock::now();
+    mgr.SetState(state);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    worst = std::max(worst, elapsed.count());
+  }
+  _st.counters["worst_ms"] = worst;
+}
+
+BENCHMARK(BM_RemoveSwarm)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ApplySwarmState)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include "ignition/gazebo/Entity.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+
+#include "ignition/gazebo/components/LinearVelocity.hh"
+#include "ignition/gazebo/components/Link.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/World.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace components;
+
+/// \brief Number of calls timed by each iteration of the view benchmarks,
+/// which are too quick to time one by one.
+constexpr const int kViewIterations{100};
+
+/// \brief Exposes the step functions that the simulation runner calls.
+class BenchmarkManager : public EntityComponentManager
+{
+  public: using EntityComponentManager::ClearNewlyCreatedEntities;
+  public: using EntityComponentManager::ProcessRemoveEntityRequests;
+  public: using EntityComponentManager::SetAllComponentsUnchanged;
+};
+
+/// \brief Populate a world with models which have a single link each.
+/// \param[in] _mgr Manager to populate.
+/// \param[in] _count Number of models.
+/// \return The models.
+static std::vector<Entity> populate(EntityComponentManager &_mgr,
+    int64_t _count)
+{
+  Entity world = _mgr.CreateEntity();
+  _mgr.CreateComponent(world, World());
+  _mgr.CreateComponent(world, components::Name("world"));
+
+  std::vector<Entity> models;
+  models.reserve(_count);
+  for (int64_t i = 0; i < _count; ++i)
+  {
+    Entity model = _mgr.CreateEntity();
+    _mgr.CreateComponent(model, Model());
+    _mgr.CreateComponent(model, components::Name("model"));
+    _mgr.CreateComponent(model, Pose());
+    _mgr.CreateComponent(model, ParentEntity(world));
+
+    Entity link = _mgr.CreateEntity();
+    _mgr.CreateComponent(link, Link());
+    _mgr.CreateComponent(link, components::Name("link"));
+    _mgr.CreateComponent(link, Pose());
+    _mgr.CreateComponent(link, ParentEntity(model));
+
+    models.push_back(model);
+  }
+  return models;
+}
+
+/// \brief Cache the views that a few typical systems would use.
+/// \param[in] _mgr Manager to cache views on.
+static void cacheViews(EntityComponentManager &_mgr)
+{
+  _mgr.Each<Model, Pose>([](const Entity &, const Model *, const Pose *)
+      {
+        return true;
+      });
+  _mgr.Each<Link, Pose, ParentEntity>(
+      [](const Entity &, const Link *, const Pose *, const ParentEntity *)
+      {
+        return true;
+      });
+  _mgr.Each<Model, LinearVelocity>(
+      [](const Entity &, const Model *, const LinearVelocity *)
+      {
+        return true;
+      });
+}
+
+/// \brief Create all the entities and components of a world, with views
+/// already cached.
+// NOLINTNEXTLINE
+void BM_CreateEntities(benchmark::State &_st)
+{
+  std::unique_ptr<BenchmarkManager> mgr;
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    mgr = std::make_unique<BenchmarkManager>();
+    cacheViews(*mgr);
+    _st.ResumeTiming();
+
+    populate(*mgr, _st.range(0));
+
+    _st.PauseTiming();
+    mgr.reset();
+    _st.ResumeTiming();
+  }
+  _st.counters["num_entities"] = 2 * _st.range(0) + 1;
+}
+
+/// \brief Add a component to every model and remove it again, with cached
+/// views that need to be updated for both.
+// NOLINTNEXTLINE
+void BM_AddRemoveComponent(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  auto models = populate(mgr, _st.range(0));
+  cacheViews(mgr);
+
+  for (auto _ : _st)
+  {
+    for (const Entity model : models)
+      mgr.CreateComponent(model, LinearVelocity());
+    for (const Entity model : models)
+      mgr.RemoveComponent<LinearVelocity>(model);
+  }
+  _st.SetItemsProcessed(
+      static_cast<int64_t>(_st.iterations() * models.size()));
+}
+
+/// \brief Create a view over an existing world, which is what the first
+/// call to Each with a new set of components does.
+// NOLINTNEXTLINE
+void BM_CreateView(benchmark::State &_st)
+{
+  std::unique_ptr<BenchmarkManager> mgr;
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    mgr = std::make_unique<BenchmarkManager>();
+    populate(*mgr, _st.range(0));
+    _st.ResumeTiming();
+
+    cacheViews(*mgr);
+
+    _st.PauseTiming();
+    mgr.reset();
+    _st.ResumeTiming();
+  }
+}
+
+/// \brief Rebuild all cached views, as happens when they're invalidated.
+// NOLINTNEXTLINE
+void BM_RebuildViews(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  populate(mgr, _st.range(0));
+  cacheViews(mgr);
+
+  for (auto _ : _st)
+    mgr.RebuildViews();
+}
+
+/// \brief Apply the full state of a world onto a manager which already has
+/// all of its entities, as a GUI or secondary does on every update.
+// NOLINTNEXTLINE
+void BM_SetState(benchmark::State &_st)
+{
+  BenchmarkManager source;
+  populate(source, _st.range(0));
+  msgs::SerializedStateMap state;
+  source.State(state, {}, {}, true);
+
+  BenchmarkManager mgr;
+  mgr.SetState(state);
+  cacheViews(mgr);
+
+  for (auto _ : _st)
+    mgr.SetState(state);
+
+  _st.counters["serialized_size"] = state.ByteSizeLong();
+}
+
+/// \brief Serialize the changed state of a world where one model in ten
+/// moved.
+// NOLINTNEXTLINE
+void BM_ChangedState(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  auto models = populate(mgr, _st.range(0));
+  mgr.ClearNewlyCreatedEntities();
+  mgr.SetAllComponentsUnchanged();
+
+  size_t serializedSize{0u};
+  for (auto _ : _st)
+  {
+    _st.PauseTiming();
+    mgr.SetAllComponentsUnchanged();
+    for (size_t i = 0; i < models.size(); i += 10)
+    {
+      mgr.SetComponentData<Pose>(models[i],
+          math::Pose3d(static_cast<double>(_st.iterations()), 0, 0, 0, 0, 0));
+    }
+    _st.ResumeTiming();
+
+    msgs::SerializedStateMap state;
+    mgr.ChangedState(state);
+    serializedSize = state.ByteSizeLong();
+  }
+  _st.counters["serialized_size"] = serializedSize;
+}
+
+/// \brief Clone a model and its link into an existing world.
+// NOLINTNEXTLINE
+void BM_Clone(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  auto models = populate(mgr, _st.range(0));
+  cacheViews(mgr);
+  const Entity world = mgr.EntityByComponents(World());
+
+  for (auto _ : _st)
+  {
+    Entity clone = mgr.Clone(models.front(), world, "", true);
+
+    _st.PauseTiming();
+    mgr.RequestRemoveEntity(clone);
+    mgr.ProcessRemoveEntityRequests();
+    _st.ResumeTiming();
+  }
+}
+
+/// \brief Get all descendants of the world.
+// NOLINTNEXTLINE
+void BM_Descendants(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  populate(mgr, _st.range(0));
+  const Entity world = mgr.EntityByComponents(World());
+
+  size_t count{0u};
+  for (auto _ : _st)
+    count = mgr.Descendants(world).size();
+  _st.counters["num_descendants"] = count;
+}
+
+/// \brief Call EachNew on a step where nothing was created, which is what
+/// most systems do on most steps.
+// NOLINTNEXTLINE
+void BM_EachNewNothingNew(benchmark::State &_st)
+{
+  BenchmarkManager mgr;
+  populate(mgr, _st.range(0));
+  cacheViews(mgr);
+  mgr.ClearNewlyCreatedEntities();
+
+  int matched{0};
+  for (auto _ : _st)
+  {
+    for (int i = 0; i < kViewIterations; ++i)
+    {
+      mgr.EachNew<Model, Pose>(
+          [&](const Entity &, const Model *, const Pose *)
+          {
+            ++matched;
+            return true;
+          });
+    }
+  }
+
+  if (matched != 0)
+    _st.SkipWithError("EachNew matched entities which aren't new");
+}
+
+BENCHMARK(BM_CreateEntities)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_AddRemoveComponent)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_CreateView)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_RebuildViews)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SetState)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ChangedState)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_Clone)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_Descendants)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_EachNewNothingNew)
+  ->Arg(100)
+  ->Arg(1000)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
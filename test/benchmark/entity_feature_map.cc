@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <ignition/common/SystemPaths.hh>
+#include <ignition/physics/ConstructEmpty.hh>
+#include <ignition/physics/FeatureList.hh>
+#include <ignition/physics/FeaturePolicy.hh>
+#include <ignition/physics/FrameSemantics.hh>
+#include <ignition/physics/Link.hh>
+#include <ignition/physics/RequestEngine.hh>
+#include <ignition/physics/config.hh>
+#include <ignition/plugin/Loader.hh>
+
+#include "ignition/gazebo/Entity.hh"
+#include "../../src/systems/physics/EntityFeatureMap.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems::physics_system;
+
+struct MinimumFeatureList
+    : physics::FeatureList<physics::ConstructEmptyWorldFeature,
+                           physics::ConstructEmptyModelFeature,
+                           physics::ConstructEmptyLinkFeature>
+{
+};
+
+struct OptionalFeatureList
+    : physics::FeatureList<physics::LinkFrameSemantics>
+{
+};
+
+using EnginePtrType =
+    physics::EnginePtr<physics::FeaturePolicy3d, MinimumFeatureList>;
+
+using LinkPtrType = physics::EntityPtr<
+    physics::Link<physics::FeaturePolicy3d, MinimumFeatureList>>;
+
+using LinkMap = EntityFeatureMap3d<physics::Link, MinimumFeatureList,
+    OptionalFeatureList>;
+
+/// \brief Load the DART engine, or return nullptr if it can't be found.
+/// \return The engine.
+EnginePtrType LoadEngine()
+{
+  common::SystemPaths systemPaths;
+  systemPaths.AddPluginPaths({IGNITION_PHYSICS_ENGINE_INSTALL_DIR});
+  auto pathToLib = systemPaths.FindSharedLibrary(
+      "libignition-physics-dartsim-plugin.so");
+  if (pathToLib.empty())
+    return nullptr;
+
+  // The loader must outlive the engine
+  static plugin::Loader pluginLoader;
+  pluginLoader.LoadLib(pathToLib);
+  for (const auto &className : pluginLoader.AllPlugins())
+  {
+    auto plugin = pluginLoader.Instantiate(className);
+    auto engine = physics::RequestEngine<physics::FeaturePolicy3d,
+        MinimumFeatureList>::From(plugin);
+    if (engine)
+      return engine;
+  }
+  return nullptr;
+}
+
+/// \brief Maps a model with many links, with entities numbered the way the
+/// ECM numbers them. The first argument is the number of links, the second
+/// one is 1 for dense storage and 0 for hash maps.
+class EntityFeatureMapFixture : public benchmark::Fixture
+{
+  protected: void SetUp(const ::benchmark::State &_state) override
+  {
+    static EnginePtrType engine = LoadEngine();
+    if (nullptr == engine)
+      return;
+
+    auto world = engine->ConstructEmptyWorld("world");
+    auto model = world->ConstructEmptyModel("model");
+
+    this->map = LinkMap(_state.range(1) != 0);
+    for (int i = 0; i < _state.range(0); ++i)
+    {
+      auto link = model->ConstructEmptyLink("link" + std::to_string(i));
+      const Entity entity = static_cast<Entity>(i + 10);
+      this->map.AddEntity(entity, link);
+      this->entities.push_back(entity);
+      this->physicsIds.push_back(link->EntityID());
+    }
+  }
+
+  protected: void TearDown(const ::benchmark::State &) override
+  {
+    this->map = LinkMap();
+    this->entities.clear();
+    this->physicsIds.clear();
+  }
+
+  /// \brief Map under test.
+  protected: LinkMap map;
+
+  /// \brief Gazebo entities in the map.
+  protected: std::vector<Entity> entities;
+
+  /// \brief Physics entity IDs in the map.
+  protected: std::vector<std::size_t> physicsIds;
+};
+
+/// \brief Look up every link by Gazebo entity, as UpdatePhysics and
+/// UpdateSim do.
+BENCHMARK_DEFINE_F(EntityFeatureMapFixture, GetByEntity)
+(benchmark::State &_st)
+{
+  if (this->entities.empty())
+  {
+    _st.SkipWithError("Failed to load the physics engine");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    for (const auto entity : this->entities)
+      benchmark::DoNotOptimize(this->map.Get(entity));
+  }
+  _st.SetItemsProcessed(_st.iterations() * this->entities.size());
+}
+
+/// \brief Look up every link by physics entity ID, as ChangedLinks does
+/// when the engine reports the changed poses.
+BENCHMARK_DEFINE_F(EntityFeatureMapFixture, GetByPhysicsId)
+(benchmark::State &_st)
+{
+  if (this->entities.empty())
+  {
+    _st.SkipWithError("Failed to load the physics engine");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    for (const auto id : this->physicsIds)
+    {
+      benchmark::DoNotOptimize(this->map.GetPhysicsEntityPtr(id));
+      benchmark::DoNotOptimize(this->map.GetByPhysicsId(id));
+    }
+  }
+  _st.SetItemsProcessed(_st.iterations() * this->physicsIds.size());
+}
+
+/// \brief Cast every link to an optional feature list, which is cached
+/// after the first cast.
+BENCHMARK_DEFINE_F(EntityFeatureMapFixture, EntityCast)
+(benchmark::State &_st)
+{
+  if (this->entities.empty())
+  {
+    _st.SkipWithError("Failed to load the physics engine");
+    return;
+  }
+
+  for (auto _ : _st)
+  {
+    for (const auto entity : this->entities)
+    {
+      benchmark::DoNotOptimize(
+          this->map.EntityCast<OptionalFeatureList>(entity));
+    }
+  }
+  _st.SetItemsProcessed(_st.iterations() * this->entities.size());
+}
+
+BENCHMARK_REGISTER_F(EntityFeatureMapFixture, GetByEntity)
+  ->Args({100, 0})
+  ->Args({100, 1})
+  ->Args({1000, 0})
+  ->Args({1000, 1})
+  ->Args({10000, 0})
+  ->Args({10000, 1})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(EntityFeatureMapFixture, GetByPhysicsId)
+  ->Args({100, 0})
+  ->Args({100, 1})
+  ->Args({1000, 0})
+  ->Args({1000, 1})
+  ->Args({10000, 0})
+  ->Args({10000, 1})
+  ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(EntityFeatureMapFixture, EntityCast)
+  ->Args({100, 0})
+  ->Args({100, 1})
+  ->Args({1000, 0})
+  ->Args({1000, 1})
+  ->Args({10000, 0})
+  ->Args({10000, 1})
+  ->Unit(benchmark::kMicrosecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
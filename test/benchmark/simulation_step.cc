@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/System.hh"
+#include "ignition/gazebo/Util.hh"
+#include "ignition/gazebo/test_config.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Number of simulation steps taken by each benchmark iteration, so
+/// that the cost of starting a run is spread over many steps.
+constexpr const unsigned int kSteps{100u};
+
+/// \brief System which does nothing on PreUpdate and Update, so that only
+/// the cost of calling the systems in the simulation thread is measured.
+class EmptyUpdateSystem :
+  public System,
+  public ISystemPreUpdate,
+  public ISystemUpdate
+{
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &,
+                EntityComponentManager &) override {}
+
+  // Documentation inherited
+  public: void Update(const UpdateInfo &,
+                EntityComponentManager &) override {}
+};
+
+/// \brief System which does nothing on PostUpdate, so that only the cost of
+/// dispatching the PostUpdate threads and waiting for them is measured.
+class EmptyPostUpdateSystem :
+  public System,
+  public ISystemPostUpdate
+{
+  // Documentation inherited
+  public: void PostUpdate(const UpdateInfo &,
+                const EntityComponentManager &) override {}
+};
+
+/// \brief Generate a world with boxes. No physics system is loaded, so
+/// they're never simulated.
+/// \param[in] _name World name.
+/// \param[in] _models Number of models.
+/// \param[in] _plugins Plugin elements to add to the world.
+/// \return SDF string.
+static std::string worldSdf(const std::string &_name, int64_t _models,
+    const std::string &_plugins = "")
+{
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0'?><sdf version='1.6'>"
+      << "<world name='" << _name << "'>"
+      << "<physics name='1ms' type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "<real_time_factor>0</real_time_factor>"
+      << "</physics>"
+      << _plugins;
+  for (int64_t i = 0; i < _models; ++i)
+  {
+    sdf << "<model name='box_" << i << "'>"
+        << "<pose>" << i << " 0 0.5 0 0 0</pose>"
+        << "<link name='link'>"
+        << "<visual name='visual'><geometry><box><size>1 1 1</size></box>"
+        << "</geometry></visual>"
+        << "</link></model>";
+  }
+  sdf << "</world></sdf>";
+  return sdf.str();
+}
+
+/// \brief Step a world with a number of models and a number of systems
+/// which do nothing. The SDF world has no systems and the default ones
+/// aren't loaded, so this measures the overhead of the simulation runner
+/// itself.
+/// Arguments are the number of systems and the number of models.
+// NOLINTNEXTLINE
+template <class SystemT>
+void BM_StepEmptySystems(benchmark::State &_st)
+{
+  common::Console::SetVerbosity(0);
+
+  // Don't load the default systems
+  common::setenv(kServerConfigPathEnv, "");
+
+  ServerConfig config;
+  config.SetSdfString(worldSdf("step_benchmark", _st.range(1)));
+  Server server(config);
+  for (int64_t i = 0; i < _st.range(0); ++i)
+    server.AddSystem(std::make_shared<SystemT>());
+
+  // Warm up, so that views are created
+  server.Run(true, 1u, false);
+
+  for (auto _ : _st)
+    server.Run(true, kSteps, false);
+
+  _st.SetItemsProcessed(_st.iterations() * kSteps);
+}
+
+/// \brief Step a world whose scene broadcaster has a subscriber for dynamic
+/// poses, so it builds and publishes a pose message on every step.
+/// The argument is the number of models.
+// NOLINTNEXTLINE
+void BM_ScenePoseUpdate(benchmark::State &_st)
+{
+  common::Console::SetVerbosity(0);
+  common::setenv("IGN_GAZEBO_SYSTEM_PLUGIN_PATH",
+      common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib").c_str());
+
+  const std::string plugin =
+      "<plugin filename='ignition-gazebo-scene-broadcaster-system'"
+      " name='ignition::gazebo::systems::SceneBroadcaster'>"
+      "<dynamic_pose_hertz>1000000</dynamic_pose_hertz>"
+      "</plugin>";
+
+  ServerConfig config;
+  config.SetSdfString(worldSdf("scene_pose_benchmark", _st.range(0),
+      plugin));
+  Server server(config);
+
+  std::atomic<int> received{0};
+  transport::Node node;
+  std::function<void(const msgs::Pose_V &)> cb =
+      [&](const msgs::Pose_V &)
+      {
+        ++received;
+      };
+  node.Subscribe("/world/scene_pose_benchmark/dynamic_pose/info", cb);
+
+  // Wait for the broadcaster to see the subscriber
+  for (int i = 0; i < 100 && received == 0; ++i)
+  {
+    server.Run(true, 1u, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  if (received == 0)
+  {
+    _st.SkipWithError("No pose messages received");
+    return;
+  }
+
+  for (auto _ : _st)
+    server.Run(true, kSteps, false);
+
+  _st.SetItemsProcessed(_st.iterations() * kSteps);
+}
+
+BENCHMARK_TEMPLATE(BM_StepEmptySystems, EmptyUpdateSystem)
+  ->ArgsProduct({{0, 1, 8, 32}, {10, 1000}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_StepEmptySystems, EmptyPostUpdateSystem)
+  ->ArgsProduct({{1, 8, 32}, {10, 1000}})
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_ScenePoseUpdate)
+  ->Arg(10)
+  ->Arg(100)
+  ->Arg(1000)
+  ->UseRealTime()
+  ->Unit(benchmark::kMillisecond);
+
+// OSX needs the semicolon, Ubuntu complains that there's an extra ';'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+BENCHMARK_MAIN();
+#pragma GCC diagnostic pop
@@ -242,3 +242,62 @@ TEST_F(BatteryPluginTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(PowerDrainTopic))
   // draining.
   EXPECT_LT(batComp->Data(), 1.0);
 }
+
+/////////////////////////////////////////////////
+// Batteries of several models simulated by a single world level system
+TEST_F(BatteryPluginTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(FleetMode))
+{
+  const auto sdfPath = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+    "test", "worlds", "battery_fleet.sdf");
+  sdf::Root root;
+  EXPECT_EQ(root.Load(sdfPath).size(), 0lu);
+  EXPECT_GT(root.WorldCount(), 0lu);
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(sdfPath);
+
+  // A pointer to the ecm. This will be valid once we run the mock system
+  gazebo::EntityComponentManager *ecm = nullptr;
+  this->mockSystem->preUpdateCallback =
+    [&ecm](const gazebo::UpdateInfo &, gazebo::EntityComponentManager &_ecm)
+    {
+      ecm = &_ecm;
+    };
+
+  // Start server
+  Server server(serverConfig);
+  server.AddSystem(this->systemPtr);
+  server.Run(true, 100, false);
+  ASSERT_NE(nullptr, ecm);
+
+  // Both batteries were loaded once their models were found
+  Entity perStepEntity = ecm->EntityByComponents(components::Name(
+    "per_step_battery"));
+  ASSERT_NE(kNullEntity, perStepEntity);
+  Entity lowRateEntity = ecm->EntityByComponents(components::Name(
+    "low_rate_battery"));
+  ASSERT_NE(kNullEntity, lowRateEntity);
+
+  auto perStepComp = ecm->Component<components::BatterySoC>(perStepEntity);
+  ASSERT_NE(nullptr, perStepComp);
+  auto lowRateComp = ecm->Component<components::BatterySoC>(lowRateEntity);
+  ASSERT_NE(nullptr, lowRateComp);
+  EXPECT_DOUBLE_EQ(perStepComp->Data(), 1.0);
+  EXPECT_DOUBLE_EQ(lowRateComp->Data(), 1.0);
+
+  // Start draining both batteries
+  ignition::transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/battery_fleet/discharge");
+  msgs::StringMsg msg;
+  pub.Publish(msg);
+
+  server.Run(true, 1000, false);
+
+  EXPECT_LT(perStepComp->Data(), 1.0);
+  EXPECT_LT(lowRateComp->Data(), 1.0);
+
+  // Integrating analytically at a lower rate gives nearly the same charge
+  // as integrating on every iteration. Up to one update period of draining
+  // may not have been integrated yet, if draining didn't start right away.
+  EXPECT_NEAR(perStepComp->Data(), lowRateComp->Data(), 5e-4);
+}
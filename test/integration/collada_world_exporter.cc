@@ -112,6 +112,51 @@ TEST_F(ColladaWorldExporterFixture,
   common::removeAll(outputPath);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ColladaWorldExporterFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(ExportWorldIntoSeveralFiles))
+{
+  std::string world_path =
+    ignition::common::joinPaths(PROJECT_SOURCE_PATH, "test", "worlds");
+  ignition::common::setenv("IGN_GAZEBO_RESOURCE_PATH",
+    (world_path + ":" +
+    ignition::common::joinPaths(world_path, "models")).c_str());
+
+  this->LoadWorld(common::joinPaths("test", "worlds",
+        "collada_world_exporter_split.sdf"));
+
+  const std::string name = "collada_world_exporter_split_test";
+  const std::string outputPath0 = "./" + name + "_0";
+  const std::string outputPath1 = "./" + name + "_1";
+
+  // Cleanup
+  common::removeAll(outputPath0);
+  common::removeAll(outputPath1);
+
+  // Run one iteration which should export the world.
+  server->Run(true, 1, false);
+
+  // The 3 submeshes are split into files of at most 2 submeshes
+  EXPECT_FALSE(common::exists("./" + name));
+  ASSERT_TRUE(common::exists(outputPath0));
+  ASSERT_TRUE(common::exists(outputPath1));
+
+  common::ColladaLoader loader;
+  const common::Mesh *meshExported0 = loader.Load(common::joinPaths(
+      outputPath0, "meshes", name + "_0.dae"));
+  ASSERT_NE(nullptr, meshExported0);
+  EXPECT_EQ(2u, meshExported0->SubMeshCount());
+
+  const common::Mesh *meshExported1 = loader.Load(common::joinPaths(
+      outputPath1, "meshes", name + "_1.dae"));
+  ASSERT_NE(nullptr, meshExported1);
+  EXPECT_EQ(1u, meshExported1->SubMeshCount());
+
+  // Cleanup
+  common::removeAll(outputPath0);
+  common::removeAll(outputPath1);
+}
+
 TEST_F(ColladaWorldExporterFixture,
        IGN_UTILS_TEST_DISABLED_ON_WIN32(ExportWorldMadeFromObj))
 {
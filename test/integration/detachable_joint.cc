@@ -16,6 +16,9 @@
  */
 
 #include <gtest/gtest.h>
+
+#include <set>
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
 #include <ignition/msgs/Utility.hh>
@@ -27,6 +30,7 @@
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/test_config.hh"
 
+#include "ignition/gazebo/components/DetachableJoint.hh"
 #include "ignition/gazebo/components/LinearAcceleration.hh"
 #include "ignition/gazebo/components/LinearVelocity.hh"
 #include "ignition/gazebo/components/Link.hh"
@@ -213,3 +217,77 @@ TEST_F(DetachableJointTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LinksInSameModel))
   // the expected distance.
   EXPECT_GT(b2Poses.front().Pos().Z() - b2Poses.back().Pos().Z(), expDist);
 }
+
+/////////////////////////////////////////////////
+TEST_F(DetachableJointTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(PersistentJoint))
+{
+  using namespace std::chrono_literals;
+
+  this->StartServer("/test/worlds/detachable_joint_persistent.sdf");
+
+  std::vector<math::Pose3d> m2Poses;
+  std::size_t jointCount{0u};
+  std::set<Entity> jointEntities;
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        auto m2 = _ecm.EntityByComponents(components::Model(),
+            components::Name("M2"));
+        auto pose = _ecm.Component<components::Pose>(m2);
+        ASSERT_NE(nullptr, pose);
+        m2Poses.push_back(pose->Data());
+
+        jointCount = 0u;
+        _ecm.Each<components::DetachableJoint>(
+            [&](const Entity &_entity,
+                const components::DetachableJoint *) -> bool
+            {
+              ++jointCount;
+              jointEntities.insert(_entity);
+              return true;
+            });
+      });
+  this->server->AddSystem(testSystem.systemPtr);
+
+  const std::size_t nIters{20};
+  this->server->Run(true, nIters, false);
+
+  // Model2 is rigidly connected to Model1, which is on the ground
+  ASSERT_EQ(nIters, m2Poses.size());
+  EXPECT_EQ(m2Poses.front(), m2Poses.back());
+  m2Poses.clear();
+
+  transport::Node node;
+  auto detachPub =
+      node.Advertise<msgs::Empty>("/model/M1/detachable_joint/detach");
+  detachPub.Publish(msgs::Empty());
+  std::this_thread::sleep_for(250ms);
+
+  const std::size_t nItersAfterDetach{100};
+  this->server->Run(true, nItersAfterDetach, false);
+
+  // Model2 is now detached. It should be falling
+  ASSERT_EQ(nItersAfterDetach, m2Poses.size());
+  const double expDist =
+      0.5 * 9.8 * pow(static_cast<double>(nItersAfterDetach-1) / 1000, 2);
+  EXPECT_GT(m2Poses.front().Pos().Z() - m2Poses.back().Pos().Z(), expDist);
+  m2Poses.clear();
+
+  auto attachPub =
+      node.Advertise<msgs::Empty>("/model/M1/detachable_joint/attach");
+  attachPub.Publish(msgs::Empty());
+  std::this_thread::sleep_for(250ms);
+
+  // Let the attachment be processed, then check that Model2 is held again
+  this->server->Run(true, 2, false);
+  m2Poses.clear();
+  this->server->Run(true, nIters, false);
+  ASSERT_EQ(nIters, m2Poses.size());
+  EXPECT_NEAR(m2Poses.front().Pos().Z(), m2Poses.back().Pos().Z(), 1e-6);
+
+  // The same joint entity was kept all along
+  EXPECT_EQ(1u, jointCount);
+  EXPECT_EQ(1u, jointEntities.size());
+}
@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 
 #include <ignition/msgs/double.pb.h>
+#include <ignition/msgs/double_v.pb.h>
+#include <functional>
 #include <mutex>
 
 #include <ignition/common/Console.hh>
@@ -95,3 +97,55 @@ TEST_F(KineticEnergyMonitorTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(ModelFalling))
   mutex.unlock();
   EXPECT_GT(firstMsg.data(), 2);
 }
+
+/////////////////////////////////////////////////
+TEST_F(KineticEnergyMonitorTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(WorldPlugin))
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/kinetic_energy_monitor_world.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+
+  // subscribe to the aggregated kinetic energy topic
+  std::mutex vecMutex;
+  std::vector<msgs::Double_V> vecMsgs;
+  std::function<void(const msgs::Double_V &)> vecCb =
+      [&](const msgs::Double_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(vecMutex);
+        vecMsgs.push_back(_msg);
+      };
+  transport::Node node;
+  node.Subscribe("/world/kinetic_energy/kinetic_energy", vecCb);
+
+  // Run server
+  size_t iters = 1000u;
+  server.Run(true, iters, false);
+
+  // Wait for messages to be received
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::lock_guard<std::mutex> lock(vecMutex);
+    if (!vecMsgs.empty())
+      break;
+  }
+
+  // Only the falling model crosses the threshold, once
+  std::lock_guard<std::mutex> lock(vecMutex);
+  ASSERT_EQ(1u, vecMsgs.size());
+  const auto &msg = vecMsgs.front();
+  ASSERT_EQ(1, msg.data_size());
+  EXPECT_GT(msg.data(0), 2);
+  ASSERT_EQ(2, msg.header().data_size());
+  EXPECT_EQ("model", msg.header().data(0).key());
+  EXPECT_EQ("altimeter_model", msg.header().data(0).value(0));
+  EXPECT_EQ("link", msg.header().data(1).key());
+  EXPECT_EQ("link", msg.header().data(1).value(0));
+}
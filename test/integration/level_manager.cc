@@ -18,7 +18,9 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
 #include <optional>
+#include <set>
 #include <vector>
 
 #include <ignition/common/Console.hh>
@@ -274,6 +276,50 @@ TEST_F(LevelManagerFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(LevelLoadUnload))
                           this->unloadedModels.end(), "tile_1"));
 }
 
+///////////////////////////////////////////////
+/// Check that entities of a level which is loaded again are restored with
+/// the same ids and components
+TEST_F(LevelManagerFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(LevelReload))
+{
+  ModelMover perf1(*this->server->EntityByName("sphere"));
+  this->server->AddSystem(perf1.systemPtr);
+
+  // Entities of tile_1 and their component types
+  std::map<Entity, std::set<ComponentTypeId>> tileEntities;
+  test::Relay recorder;
+  recorder.OnPostUpdate([&](const gazebo::UpdateInfo &,
+                            const gazebo::EntityComponentManager &_ecm)
+  {
+    tileEntities.clear();
+    auto tile = _ecm.EntityByComponents(components::Model(),
+        components::Name("tile_1"));
+    if (kNullEntity == tile)
+      return;
+    for (const auto &entity : _ecm.Descendants(tile))
+    {
+      auto types = _ecm.ComponentTypes(entity);
+      tileEntities[entity] = std::set<ComponentTypeId>(types.begin(),
+          types.end());
+    }
+  });
+  this->server->AddSystem(recorder.systemPtr);
+
+  perf1.SetPose({40, 0, 0, 0, 0, 0});
+  this->RunServer();
+  ASSERT_FALSE(tileEntities.empty());
+  const auto loadedEntities = tileEntities;
+
+  perf1.SetPose({0, 0, 0, 0, 0, 0});
+  this->RunServer();
+  EXPECT_TRUE(tileEntities.empty());
+
+  perf1.SetPose({40, 0, 0, 0, 0, 0});
+  this->RunServer();
+  EXPECT_EQ(1, std::count(this->loadedModels.begin(), this->loadedModels.end(),
+                          "tile_1"));
+  EXPECT_EQ(loadedEntities, tileEntities);
+}
+
 ///////////////////////////////////////////////
 /// Check behaviour of level buffers
 TEST_F(LevelManagerFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(LevelBuffers))
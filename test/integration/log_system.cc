@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <ignition/msgs/bytes.pb.h>
 #include <ignition/msgs/pose_v.pb.h>
 
 #include <algorithm>
@@ -25,6 +26,7 @@
 #endif
 #include <numeric>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
@@ -42,10 +44,13 @@
 #include <sdf/Root.hh>
 #include <sdf/World.hh>
 #include <sdf/Element.hh>
+#include <sdf/Plugin.hh>
 
 #include "ignition/gazebo/components/Name.hh"
 #include "ignition/gazebo/components/LogPlaybackStatistics.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/World.hh"
+#include "ignition/gazebo/PoseStreamCodec.hh"
 #include "ignition/gazebo/Server.hh"
 #include "ignition/gazebo/ServerConfig.hh"
 #include "ignition/gazebo/SystemLoader.hh"
@@ -841,6 +846,146 @@ TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RecordAndPlayback))
   this->RemoveLogsDir();
 }
 
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(RecordPoseStream))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  int numIterations = 500;
+  // Record
+  {
+    // World with moving entities
+    const auto recordSdfPath = common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "worlds",
+      "log_record_dbl_pendulum.sdf");
+
+    // Record poses on the pose stream to the build directory
+    sdf::Root recordSdfRoot;
+    EXPECT_TRUE(recordSdfRoot.Load(recordSdfPath).empty());
+    ASSERT_EQ(1u, recordSdfRoot.WorldCount());
+    sdf::ElementPtr pluginElt =
+        recordSdfRoot.WorldByIndex(0)->Element()->GetElement("plugin");
+    while (pluginElt != nullptr &&
+        pluginElt->GetAttribute("name")->GetAsString().find("LogRecord") ==
+        std::string::npos)
+    {
+      pluginElt = pluginElt->GetNextElement("plugin");
+    }
+    ASSERT_NE(nullptr, pluginElt);
+
+    auto pathElt = std::make_shared<sdf::Element>();
+    pathElt->SetName("record_path");
+    pathElt->AddValue("string", "", false, "");
+    pathElt->Set<std::string>(this->logDir);
+    pluginElt->InsertElement(pathElt);
+
+    auto poseStreamElt = std::make_shared<sdf::Element>();
+    poseStreamElt->SetName("pose_stream");
+    pluginElt->InsertElement(poseStreamElt);
+
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfString(recordSdfRoot.Element()->ToString(""));
+
+    Server recordServer(recordServerConfig);
+    recordServer.Run(true, numIterations, false);
+  }
+
+  auto logFile = common::joinPaths(this->logDir, "state.tlog");
+  EXPECT_TRUE(common::exists(logFile));
+
+  // Path to log file for playback
+  std::string logPlaybackDir =
+      common::joinPaths(this->logsDir, "test_logs_playback");
+  common::createDirectories(logPlaybackDir);
+  auto logPlaybackFile = common::joinPaths(logPlaybackDir, "state.tlog");
+  common::moveFile(logFile, logPlaybackFile);
+  EXPECT_TRUE(common::exists(logPlaybackFile));
+
+  transport::log::Log log;
+  log.Open(logPlaybackFile);
+
+  // Only the first changed state, which creates the entities, holds poses
+  auto stateBatch = log.QueryMessages(transport::log::TopicPattern(
+      std::regex(".*/changed_state")));
+  int stateCount{0};
+  for (const auto &stateIt : stateBatch)
+  {
+    msgs::SerializedStateMap stateMsg;
+    stateMsg.ParseFromString(stateIt.Data());
+    bool hasPose{false};
+    for (const auto &entityIt : stateMsg.entities())
+    {
+      hasPose = hasPose || entityIt.second.components().count(
+          components::Pose::typeId) > 0;
+    }
+    EXPECT_EQ(stateCount == 0, hasPose) << stateCount;
+    ++stateCount;
+  }
+  EXPECT_GT(stateCount, 0);
+
+  // Every iteration has a frame of the stream
+  auto batch = log.QueryMessages(transport::log::TopicPattern(
+      std::regex(".*/pose_stream")));
+  PoseStreamDecoder decoder;
+  std::vector<std::vector<EntityPose>> frames;
+  for (const auto &frameIt : batch)
+  {
+    EXPECT_EQ("ignition.msgs.Bytes", frameIt.Type());
+    EXPECT_EQ("/world/log_pendulum/pose_stream", frameIt.Topic());
+
+    msgs::Bytes frameMsg;
+    frameMsg.ParseFromString(frameIt.Data());
+    std::chrono::steady_clock::duration frameTime;
+    frames.emplace_back();
+    EXPECT_TRUE(decoder.Decode(frameMsg.data(), frameTime, frames.back()));
+    EXPECT_FALSE(frames.back().empty());
+  }
+  EXPECT_EQ(static_cast<std::size_t>(numIterations), frames.size());
+
+  // Playback config
+  ServerConfig playServerConfig;
+  playServerConfig.SetLogPlaybackPath(logPlaybackDir);
+  Server playServer(playServerConfig);
+
+  // Compare the poses played back with the poses of each frame
+  std::size_t frameIndex{0u};
+  test::Relay playbackPoseTester;
+  playbackPoseTester.OnPostUpdate(
+      [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+      {
+        if (frameIndex >= frames.size())
+          return;
+
+        for (const auto &[entity, poseRecorded] : frames[frameIndex])
+        {
+          auto poseComp = _ecm.Component<components::Pose>(entity);
+          ASSERT_NE(nullptr, poseComp) << entity;
+          const math::Pose3d &posePlayed = poseComp->Data();
+
+          EXPECT_NEAR(posePlayed.Pos().X(), poseRecorded.Pos().X(), 0.1)
+            << entity;
+          EXPECT_NEAR(posePlayed.Pos().Y(), poseRecorded.Pos().Y(), 0.1)
+            << entity;
+          EXPECT_NEAR(posePlayed.Pos().Z(), poseRecorded.Pos().Z(), 0.1)
+            << entity;
+          EXPECT_NEAR(posePlayed.Rot().Roll(),
+                      poseRecorded.Rot().Roll(), 0.1) << entity;
+          EXPECT_NEAR(posePlayed.Rot().Pitch(),
+                      poseRecorded.Rot().Pitch(), 0.1) << entity;
+          EXPECT_NEAR(posePlayed.Rot().Yaw(),
+                      poseRecorded.Rot().Yaw(), 0.1) << entity;
+        }
+        ++frameIndex;
+      });
+  playServer.AddSystem(playbackPoseTester.systemPtr);
+
+  playServer.Run(true, 250, false);
+  EXPECT_EQ(250u, frameIndex);
+
+  this->RemoveLogsDir();
+}
+
 /////////////////////////////////////////////////
 TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LogControl))
 {
@@ -1355,6 +1500,83 @@ TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LogCompress))
   this->RemoveLogsDir();
 }
 
+/////////////////////////////////////////////////
+TEST_F(LogSystemTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(LogCompressLazyExtraction))
+{
+  // Create temp directory to store log
+  this->CreateLogsDir();
+
+  const std::string recordPath = this->logDir;
+  const std::string cmpPath = this->AppendExtension(recordPath, ".zip");
+
+  // Record and compress
+  {
+    ServerConfig recordServerConfig;
+    recordServerConfig.SetSdfFile(common::joinPaths(
+        std::string(PROJECT_SOURCE_PATH), "test", "worlds",
+        "log_record_dbl_pendulum.sdf"));
+    recordServerConfig.SetLogRecordPath(recordPath);
+    recordServerConfig.SetLogRecordCompressPath(cmpPath);
+    recordServerConfig.SetUseLogRecord(true);
+
+    Server recordServer(recordServerConfig);
+    recordServer.Run(true, 100, false);
+  }
+  ASSERT_TRUE(common::exists(cmpPath));
+
+  // Only the compressed file is played back
+  common::removeAll(recordPath);
+
+  // Play back, only extracting the state at start
+  sdf::Plugin plugin;
+  plugin.SetName("ignition::gazebo::systems::LogPlayback");
+  plugin.SetFilename("ignition-gazebo-log-system");
+
+  sdf::ElementPtr pathElem = std::make_shared<sdf::Element>();
+  pathElem->SetName("playback_path");
+  pathElem->AddValue("string", "", false, "");
+  pathElem->Set<std::string>(cmpPath);
+  plugin.InsertContent(pathElem);
+
+  sdf::ElementPtr lazyElem = std::make_shared<sdf::Element>();
+  lazyElem->SetName("lazy_extraction");
+  lazyElem->AddValue("bool", "false", false, "");
+  lazyElem->Set<bool>(true);
+  plugin.InsertContent(lazyElem);
+
+  const std::string extPath = common::joinPaths(this->logsDir,
+      "test_logs_record_extracted");
+  {
+    ServerConfig playServerConfig;
+    playServerConfig.AddPlugin(
+        ServerConfig::PluginInfo("*", "world", plugin));
+
+    Server playServer(playServerConfig);
+
+    bool started{false};
+    test::Relay testSystem;
+    testSystem.OnPostUpdate(
+        [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+        {
+          auto world = _ecm.EntityByComponents(components::World());
+          started = nullptr !=
+              _ecm.Component<components::LogPlaybackStatistics>(world);
+        });
+    playServer.AddSystem(testSystem.systemPtr);
+    playServer.Run(true, 50, false);
+
+    EXPECT_TRUE(started);
+    EXPECT_TRUE(common::exists(common::joinPaths(extPath, "test_logs_record",
+        "state.tlog")));
+  }
+
+  // Extracted files are removed with the playback
+  EXPECT_FALSE(common::exists(extPath));
+
+  this->RemoveLogsDir();
+}
+
 /////////////////////////////////////////////////
 TEST_F(LogSystemTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(LogCompressOverwrite))
 {
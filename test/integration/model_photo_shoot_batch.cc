@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
+#include <ignition/utils/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/test_config.hh"
+
+#include "helpers/EnvTestFixture.hh"
+#include "helpers/UniqueTestDirectoryEnv.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/// \brief Test the batch mode of the ModelPhotoShoot system.
+class ModelPhotoShootBatchTest : public InternalFixture<::testing::Test>
+{
+  protected: void SetUp() override
+  {
+    EXPECT_TRUE(common::chdir(test::UniqueTestDirectoryEnv::Path()));
+    InternalFixture<::testing::Test>::SetUp();
+  }
+};
+
+// Take pictures of a batch of models in a single server.
+TEST_F(ModelPhotoShootBatchTest,
+       IGN_UTILS_TEST_ENABLED_ONLY_ON_LINUX(BatchOfModels))
+{
+  const std::string worldsPath =
+      common::joinPaths(PROJECT_SOURCE_PATH, "test", "worlds");
+  common::setenv("IGN_GAZEBO_RESOURCE_PATH",
+      worldsPath + ":" + common::joinPaths(worldsPath, "models"));
+
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(
+      common::joinPaths(worldsPath, "model_photo_shoot_batch.sdf"));
+  Server server(serverConfig);
+  server.SetUpdatePeriod(1ns);
+
+  // Each model's pictures go to a directory named after its position in
+  // the batch and its name
+  const std::vector<std::string> dirs{
+      common::joinPaths("photos", "0_sphere"),
+      common::joinPaths("photos", "1_scheme_resource_uri")};
+
+  auto allPictures = [&dirs]()
+  {
+    for (const auto &dir : dirs)
+    {
+      for (int i = 1; i <= 5; ++i)
+      {
+        if (!common::exists(
+            common::joinPaths(dir, std::to_string(i) + ".png")))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  const auto endTime = std::chrono::steady_clock::now() + 30s;
+  while (!allPictures() && std::chrono::steady_clock::now() < endTime)
+  {
+    server.Run(true, 10, false);
+    std::this_thread::sleep_for(10ms);
+  }
+
+  for (const auto &dir : dirs)
+  {
+    for (int i = 1; i <= 5; ++i)
+    {
+      EXPECT_TRUE(common::exists(
+          common::joinPaths(dir, std::to_string(i) + ".png"))) << dir;
+    }
+    EXPECT_TRUE(common::exists(common::joinPaths(dir, "poses.txt"))) << dir;
+  }
+
+  common::removeAll("photos");
+}
+
+int main(int _argc, char **_argv)
+{
+  ::testing::InitGoogleTest(&_argc, _argv);
+  ::testing::AddGlobalTestEnvironment(
+      new test::UniqueTestDirectoryEnv("model_photo_shoot_batch_test"));
+  return RUN_ALL_TESTS();
+}
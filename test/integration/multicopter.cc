@@ -134,6 +134,75 @@ TEST_F(MulticopterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(CommandedMotorSpeed))
   server->Run(true, iterTestStart + nIters, false);
 }
 
+/////////////////////////////////////////////////
+// Test that commanded motor speed is applied when a single plugin models
+// all the rotors
+TEST_F(MulticopterTest,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(CommandedMotorSpeedBatchedRotors))
+{
+  // Start server
+  auto server = this->StartServer("/test/worlds/quadcopter_rotors.sdf");
+
+  test::Relay testSystem;
+  transport::Node node;
+  auto cmdMotorSpeed =
+      node.Advertise<msgs::Actuators>("/X3/gazebo/command/motor_speed");
+
+  const std::size_t iterTestStart{100};
+  const std::size_t nIters{500};
+  testSystem.OnPreUpdate(
+      [&](const gazebo::UpdateInfo &_info, gazebo::EntityComponentManager &_ecm)
+      {
+        // Create components, if the don't exist, on the first iteration
+        if (_info.iterations == 1)
+        {
+          for (const auto &e : _ecm.EntitiesByComponents(components::Joint()))
+          {
+            if (!_ecm.Component<components::JointVelocity>(e))
+            {
+              _ecm.CreateComponent(e, components::JointVelocity());
+            }
+          }
+        }
+      });
+
+  testSystem.OnPostUpdate(
+      [&](const gazebo::UpdateInfo &_info,
+          const gazebo::EntityComponentManager &_ecm)
+      {
+        // Command a motor speed
+        // After nIters iterations, check angular velocity of each of the rotors
+        const double cmdSpeed{100};
+        if (_info.iterations == iterTestStart)
+        {
+          msgs::Actuators msg;
+          msg.mutable_velocity()->Resize(4, cmdSpeed);
+          cmdMotorSpeed.Publish(msg);
+        }
+        else if (_info.iterations == iterTestStart + nIters)
+        {
+          int count = 0;
+          // Check that each rotor's velocity matches the commanded value
+          for (const auto &e : _ecm.EntitiesByComponents(components::Joint()))
+          {
+            auto *jointVel = _ecm.Component<components::JointVelocity>(e);
+            EXPECT_NE(nullptr, jointVel);
+            EXPECT_FALSE(jointVel->Data().empty());
+            if (jointVel->Data().size() > 0)
+            {
+              ++count;
+              EXPECT_NEAR(cmdSpeed, std::abs(jointVel->Data()[0]), 1e-2);
+            }
+          }
+
+          EXPECT_EQ(4, count);
+        }
+      });
+
+  server->AddSystem(testSystem.systemPtr);
+  server->Run(true, iterTestStart + nIters, false);
+}
+
 /////////////////////////////////////////////////
 TEST_F(MulticopterTest,
        IGN_UTILS_TEST_DISABLED_ON_WIN32(MulticopterVelocityControl))
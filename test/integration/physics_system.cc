@@ -185,6 +185,59 @@ TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(FallingObject))
   EXPECT_NEAR(spherePoses.back().Pos().Z(), zStopped, 5e-2);
 }
 
+/////////////////////////////////////////////////
+// Substeps split each iteration in several physics steps, but systems still
+// see a single update per iteration
+TEST_F(PhysicsSystemFixture,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(FallingObjectSubsteps))
+{
+  ignition::gazebo::ServerConfig serverConfig;
+
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/falling_substeps.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  sdf::Root root;
+  root.Load(sdfFile);
+  const sdf::World *world = root.WorldByIndex(0);
+  const sdf::Model *model = world->ModelByIndex(0);
+
+  gazebo::Server server(serverConfig);
+
+  server.SetUpdatePeriod(1us);
+
+  const std::string modelName = "sphere";
+  std::vector<ignition::math::Pose3d> spherePoses;
+
+  test::Relay testSystem;
+  testSystem.OnPostUpdate(
+    [modelName, &spherePoses](const gazebo::UpdateInfo &,
+    const gazebo::EntityComponentManager &_ecm)
+    {
+      _ecm.Each<components::Model, components::Name, components::Pose>(
+        [&](const ignition::gazebo::Entity &, const components::Model *,
+        const components::Name *_name, const components::Pose *_pose)->bool
+        {
+          if (_name->Data() == modelName) {
+            spherePoses.push_back(_pose->Data());
+          }
+          return true;
+        });
+    });
+
+  server.AddSystem(testSystem.systemPtr);
+  const size_t iters = 10;
+  server.Run(true, iters, false);
+  ASSERT_EQ(iters, spherePoses.size());
+
+  // The sphere falls for the same simulated time as without substeps
+  const double dt = 0.001;
+  const double grav = world->Gravity().Z();
+  const double zInit = model->RawPose().Pos().Z();
+  const double zExpected = zInit + 0.5 * grav * pow(iters * dt, 2);
+  EXPECT_NEAR(spherePoses.back().Pos().Z(), zExpected, 2e-4);
+}
+
 /////////////////////////////////////////////////
 // This tests whether links with fixed joints keep their relative transforms
 // after physics. For that to work properly, the canonical link implementation
@@ -394,6 +447,77 @@ TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(RevoluteJoint))
   EXPECT_NEAR(expMaxDist, *minmax.second, 1e-3);
 }
 
+/////////////////////////////////////////////////
+// Joint state components created or removed while simulation runs are
+// picked up by the physics readback
+TEST_F(PhysicsSystemFixture,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(JointStateComponentsAtRuntime))
+{
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/revolute_joint.sdf");
+
+  gazebo::Server server(serverConfig);
+  server.SetUpdatePeriod(1us);
+
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &_info,
+      gazebo::EntityComponentManager &_ecm)
+  {
+    auto joint = _ecm.EntityByComponents(components::Joint(),
+        components::Name("j2"));
+    ASSERT_NE(kNullEntity, joint);
+
+    if (_info.iterations == 100u)
+    {
+      _ecm.CreateComponent(joint, components::JointPosition());
+      _ecm.CreateComponent(joint, components::JointVelocity());
+    }
+    else if (_info.iterations == 200u)
+    {
+      _ecm.RemoveComponent<components::JointVelocity>(joint);
+    }
+  });
+
+  std::vector<double> positions;
+  std::size_t velocityCount{0u};
+  testSystem.OnPostUpdate([&](const gazebo::UpdateInfo &_info,
+      const gazebo::EntityComponentManager &_ecm)
+  {
+    auto joint = _ecm.EntityByComponents(components::Joint(),
+        components::Name("j2"));
+    auto position = _ecm.Component<components::JointPosition>(joint);
+    auto velocity = _ecm.Component<components::JointVelocity>(joint);
+
+    if (_info.iterations < 100u)
+    {
+      EXPECT_EQ(nullptr, position);
+      return;
+    }
+
+    ASSERT_NE(nullptr, position);
+    ASSERT_EQ(1u, position->Data().size());
+    positions.push_back(position->Data()[0]);
+
+    if (_info.iterations < 200u)
+    {
+      ASSERT_NE(nullptr, velocity);
+      ASSERT_EQ(1u, velocity->Data().size());
+      ++velocityCount;
+    }
+  });
+
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 300, false);
+
+  EXPECT_EQ(100u, velocityCount);
+  ASSERT_EQ(201u, positions.size());
+
+  // The arm keeps swinging after the velocity is removed
+  EXPECT_NE(positions[0], positions[100]);
+  EXPECT_NE(positions[100], positions[200]);
+}
+
 /////////////////////////////////////////////////
 TEST_F(PhysicsSystemFixture, IGN_UTILS_TEST_DISABLED_ON_WIN32(CreateRuntime))
 {
@@ -28,13 +28,21 @@
 #pragma warning(pop)
 #endif
 
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
 #include <thread>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
+#include <ignition/msgs/Utility.hh>
+#include "ignition/gazebo/components/Material.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/ParentEntity.hh"
 #include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/components/Visual.hh"
 #include <ignition/transport/Node.hh>
 #include <ignition/utilities/ExtraTestMacros.hh>
 
@@ -149,6 +157,64 @@ TEST_P(SceneBroadcasterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(SceneInfo))
   EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(res, res2));
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(SceneInfoComponentChanges))
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+
+  // Turn the box red after a few iterations
+  const math::Color red(1, 0, 0, 1);
+  ignition::gazebo::test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &_info,
+    gazebo::EntityComponentManager &_ecm)
+    {
+      if (_info.iterations != 5)
+        return;
+
+      auto visual = _ecm.EntityByComponents(
+          gazebo::components::Name("box_visual"),
+          gazebo::components::Visual());
+      auto materialComp = _ecm.Component<gazebo::components::Material>(visual);
+      ASSERT_NE(nullptr, materialComp);
+      materialComp->Data().SetDiffuse(red);
+      _ecm.SetChanged(visual, gazebo::components::Material::typeId,
+          gazebo::ComponentState::OneTimeChange);
+    });
+  server.AddSystem(testSystem.systemPtr);
+
+  transport::Node node;
+  bool result{false};
+  unsigned int timeout{5000};
+  auto boxDiffuse = [&]()
+  {
+    ignition::msgs::Scene res;
+    EXPECT_TRUE(node.Request("/world/default/scene/info", timeout, res,
+        result));
+    EXPECT_TRUE(result);
+    for (auto m = 0; m < res.model_size(); ++m)
+    {
+      if (res.model(m).name() != "box")
+        continue;
+      const auto &visual = res.model(m).link(0).visual(0);
+      return msgs::Convert(visual.material().diffuse());
+    }
+    return math::Color::Black;
+  };
+
+  server.Run(true, 1, false);
+  EXPECT_NE(red, boxDiffuse());
+
+  // The cached message is updated with the new material
+  server.Run(true, 10, false);
+  EXPECT_EQ(red, boxDiffuse());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneBroadcasterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(SceneGraph))
 {
@@ -526,6 +592,69 @@ TEST_P(SceneBroadcasterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(State))
   EXPECT_TRUE(received);
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(StateChunked))
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+  EXPECT_EQ(24u, *server.EntityCount());
+  transport::Node node;
+
+  // Run server
+  server.Run(true, 1, false);
+
+  std::mutex mutex;
+  std::set<uint64_t> entities;
+  std::set<std::string> chunks;
+  std::string chunkCount;
+  std::function<void(const msgs::SerializedStepMap &)> cb =
+      [&](const msgs::SerializedStepMap &_res)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_TRUE(_res.has_stats());
+    for (const auto &data : _res.header().data())
+    {
+      ASSERT_EQ(1, data.value_size());
+      if (data.key() == "chunk")
+        chunks.insert(data.value(0));
+      else if (data.key() == "chunk_count")
+        chunkCount = data.value(0);
+    }
+    for (const auto &entity : _res.state().entities())
+    {
+      EXPECT_LT(0, entity.second.components_size());
+      entities.insert(entity.first);
+    }
+  };
+
+  std::string reqSrv = "/state_chunked_callback_test";
+  node.Advertise(reqSrv, cb);
+
+  ignition::msgs::StringMsg req;
+  req.set_data(reqSrv);
+  node.Request("/world/default/state_chunked", req);
+
+  // Chunks are sent off the simulation thread, once an iteration has been
+  // run
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    server.Run(true, 1, false);
+    IGN_SLEEP_MS(100);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!chunkCount.empty() && chunks.size() == std::stoul(chunkCount))
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ("1", chunkCount);
+  EXPECT_EQ(1u, chunks.size());
+  EXPECT_EQ(24u, entities.size());
+}
+
 /////////////////////////////////////////////////
 TEST_P(SceneBroadcasterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(StateStatic))
 {
@@ -1019,6 +1148,394 @@ TEST_P(SceneBroadcasterTest,
   EXPECT_EQ(1, count);
 }
 
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(PoseInfoWithoutNames))
+{
+  std::string sdfStr = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <plugin
+      filename="ignition-gazebo-scene-broadcaster-system"
+      name="ignition::gazebo::systems::SceneBroadcaster">
+      <pose_names>false</pose_names>
+    </plugin>
+    <model name="static_box">
+      <static>true</static>
+      <link name="link"/>
+    </model>
+    <model name="box">
+      <pose>1 2 3 0 0 0</pose>
+      <link name="link"/>
+    </model>
+  </world>
+</sdf>)";
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfStr);
+
+  gazebo::Server server(serverConfig);
+
+  // Create pose subscribers
+  transport::Node node;
+
+  std::mutex mutex;
+  std::vector<msgs::Pose_V> dyPoseMsgs;
+  std::function<void(const msgs::Pose_V &)> dyCb =
+      [&](const msgs::Pose_V &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    dyPoseMsgs.push_back(_msg);
+  };
+  EXPECT_TRUE(node.Subscribe("/world/default/dynamic_pose/info", dyCb));
+
+  std::vector<msgs::Pose_V> poseMsgs;
+  std::function<void(const msgs::Pose_V &)> cb =
+      [&](const msgs::Pose_V &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    poseMsgs.push_back(_msg);
+  };
+  EXPECT_TRUE(node.Subscribe("/world/default/pose/info", cb));
+
+  // Run server for a few publications
+  for (int i = 0; i < 10; ++i)
+  {
+    server.Run(true, 1, false);
+    IGN_SLEEP_MS(20);
+  }
+
+  for (unsigned int sleep = 0u; sleep < 30u; ++sleep)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (dyPoseMsgs.size() >= 2u && poseMsgs.size() >= 2u)
+      break;
+    IGN_SLEEP_MS(100);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(dyPoseMsgs.size(), 2u);
+  ASSERT_GE(poseMsgs.size(), 2u);
+
+  // The dynamic model and its link, without names, laid out the same way on
+  // every publication
+  for (const auto &msg : dyPoseMsgs)
+  {
+    ASSERT_EQ(2, msg.pose_size());
+    for (const auto &pose : msg.pose())
+    {
+      EXPECT_NE(0u, pose.id());
+      EXPECT_TRUE(pose.name().empty());
+    }
+    EXPECT_EQ(dyPoseMsgs.front().pose(0).id(), msg.pose(0).id());
+    EXPECT_EQ(dyPoseMsgs.front().pose(1).id(), msg.pose(1).id());
+    EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), msgs::Convert(msg.pose(0)));
+  }
+
+  // Both models and both links
+  for (const auto &msg : poseMsgs)
+  {
+    EXPECT_EQ(4, msg.pose_size());
+    for (const auto &pose : msg.pose())
+      EXPECT_TRUE(pose.name().empty());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(StateInterest))
+{
+  std::string sdfStr = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <plugin
+      filename="ignition-gazebo-scene-broadcaster-system"
+      name="ignition::gazebo::systems::SceneBroadcaster">
+    </plugin>
+    <model name="near">
+      <link name="link"/>
+    </model>
+    <model name="far">
+      <pose>10 0 0 0 0 0</pose>
+      <link name="link"/>
+    </model>
+    <model name="followed">
+      <pose>20 0 0 0 0 0</pose>
+      <link name="link"/>
+    </model>
+  </world>
+</sdf>)";
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfStr);
+
+  gazebo::Server server(serverConfig);
+
+  // Find the models, and move the near one out of the region of interest
+  // after a while
+  std::map<std::string, gazebo::Entity> models;
+  gazebo::Entity nearLink{gazebo::kNullEntity};
+  ignition::gazebo::test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &_info,
+    gazebo::EntityComponentManager &_ecm)
+    {
+      for (const auto &name : {"near", "far", "followed"})
+      {
+        models[name] = _ecm.EntityByComponents(
+            gazebo::components::Name(name), gazebo::components::Model());
+      }
+      nearLink = _ecm.EntityByComponents(gazebo::components::Name("link"),
+          gazebo::components::ParentEntity(models["near"]));
+
+      if (_info.iterations == 10)
+      {
+        _ecm.SetComponentData<gazebo::components::Pose>(models["near"],
+            math::Pose3d(5, 0, 0, 0, 0, 0));
+        _ecm.SetChanged(models["near"], gazebo::components::Pose::typeId,
+            gazebo::ComponentState::OneTimeChange);
+      }
+    });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(gazebo::kNullEntity, models["near"]);
+  ASSERT_NE(gazebo::kNullEntity, models["far"]);
+  ASSERT_NE(gazebo::kNullEntity, models["followed"]);
+  ASSERT_NE(gazebo::kNullEntity, nearLink);
+
+  // Register interest in a region around the near model, and in the
+  // followed model
+  transport::Node node;
+  msgs::Param req;
+  (*req.mutable_params())["name"].set_string_value("operator");
+  msgs::Set((*req.mutable_params())["min"].mutable_vector3d_value(),
+      math::Vector3d(-1, -1, -1));
+  msgs::Set((*req.mutable_params())["max"].mutable_vector3d_value(),
+      math::Vector3d(1, 1, 1));
+  (*req.mutable_params())["hertz"].set_double_value(1000.0);
+  (*req.add_children()->mutable_params())["entity"].set_int_value(
+      static_cast<int>(models["followed"]));
+
+  msgs::StringMsg res;
+  bool result{false};
+  unsigned int timeout{5000};
+  EXPECT_TRUE(node.Request("/world/default/state/interest", req, timeout,
+      res, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ("/world/default/state/interest/operator", res.data());
+
+  // Keep track of the entities the stream holds
+  std::mutex mutex;
+  std::set<gazebo::Entity> entities;
+  uint64_t lastIteration{0u};
+  std::function<void(const msgs::SerializedStepMap &)> cb =
+      [&](const msgs::SerializedStepMap &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &entity : _msg.state().entities())
+    {
+      if (entity.second.remove())
+        entities.erase(entity.first);
+      else
+        entities.insert(entity.first);
+    }
+    lastIteration = _msg.stats().iterations();
+  };
+  EXPECT_TRUE(node.Subscribe(res.data(), cb));
+
+  auto runUntil = [&](uint64_t _iteration)
+  {
+    for (unsigned int i = 0u; i < 100u; ++i)
+    {
+      server.Run(true, 1, false);
+      IGN_SLEEP_MS(5);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (lastIteration >= _iteration)
+        break;
+    }
+  };
+
+  // The near and followed models are sent, with their links
+  runUntil(5u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GE(lastIteration, 5u);
+    EXPECT_EQ(1u, entities.count(models["near"]));
+    EXPECT_EQ(1u, entities.count(nearLink));
+    EXPECT_EQ(1u, entities.count(models["followed"]));
+    EXPECT_EQ(0u, entities.count(models["far"]));
+    EXPECT_EQ(4u, entities.size());
+  }
+
+  // The near model leaves the region and is dropped
+  runUntil(15u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GE(lastIteration, 15u);
+    EXPECT_EQ(0u, entities.count(models["near"]));
+    EXPECT_EQ(0u, entities.count(nearLink));
+    EXPECT_EQ(1u, entities.count(models["followed"]));
+    EXPECT_EQ(2u, entities.size());
+  }
+
+  // Removing the interest
+  msgs::Param removeReq;
+  (*removeReq.mutable_params())["name"].set_string_value("operator");
+  EXPECT_TRUE(node.Request("/world/default/state/interest", removeReq,
+      timeout, res, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(res.data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(StateInterestComponentTypes))
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+  server.Run(true, 1, false);
+
+  // Only names and poses, for all entities
+  transport::Node node;
+  msgs::Param req;
+  (*req.mutable_params())["name"].set_string_value("names_poses");
+  (*req.mutable_params())["hertz"].set_double_value(1000.0);
+  (*req.add_children()->mutable_params())["component"].set_string_value(
+      "ign_gazebo_components.Name");
+  (*req.add_children()->mutable_params())["component"].set_string_value(
+      "ign_gazebo_components.Pose");
+
+  msgs::StringMsg res;
+  bool result{false};
+  unsigned int timeout{5000};
+  EXPECT_TRUE(node.Request("/world/default/state/interest", req, timeout,
+      res, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ("/world/default/state/interest/names_poses", res.data());
+
+  std::mutex mutex;
+  std::set<gazebo::Entity> entities;
+  std::set<gazebo::ComponentTypeId> types;
+  std::function<void(const msgs::SerializedStepMap &)> cb =
+      [&](const msgs::SerializedStepMap &_msg)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &entity : _msg.state().entities())
+    {
+      entities.insert(entity.first);
+      for (const auto &comp : entity.second.components())
+        types.insert(comp.second.type());
+    }
+  };
+  EXPECT_TRUE(node.Subscribe(res.data(), cb));
+
+  for (unsigned int i = 0u; i < 100u; ++i)
+  {
+    server.Run(true, 1, false);
+    IGN_SLEEP_MS(5);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!entities.empty())
+      break;
+  }
+
+  // All entities are sent, with only the requested components
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_LT(10u, entities.size());
+    EXPECT_EQ(2u, types.size());
+    EXPECT_EQ(1u, types.count(gazebo::components::Name::typeId));
+    EXPECT_EQ(1u, types.count(gazebo::components::Pose::typeId));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(SceneBroadcasterTest,
+       IGN_UTILS_TEST_DISABLED_ON_WIN32(FilteredState))
+{
+  // Start server
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+      "/test/worlds/shapes.sdf");
+
+  gazebo::Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+
+  // Requests are served on the next iteration, which also runs while paused
+  server.Run(false, 0, true);
+
+  transport::Node node;
+  auto request = [&](const msgs::Param &_req, msgs::SerializedStepMap &_res)
+  {
+    bool result{false};
+    return node.Request("/world/default/state/filtered", _req, 5000u, _res,
+        result) && result;
+  };
+
+  // The box model and all its descendants, with all their components
+  msgs::Param req;
+  (*req.add_children()->mutable_params())["name"].set_string_value("box");
+
+  msgs::SerializedStepMap res;
+  EXPECT_TRUE(request(req, res));
+  ASSERT_TRUE(res.has_state());
+  EXPECT_EQ(4, res.state().entities_size());
+
+  std::set<std::string> names;
+  for (const auto &entity : res.state().entities())
+  {
+    auto nameIt = entity.second.components().find(
+        gazebo::components::Name::typeId);
+    ASSERT_NE(nameIt, entity.second.components().end());
+    gazebo::components::Name name;
+    std::istringstream istr(nameIt->second.component());
+    name.Deserialize(istr);
+    names.insert(name.Data());
+  }
+  EXPECT_EQ(1u, names.count("box"));
+  EXPECT_EQ(1u, names.count("box_link"));
+  EXPECT_EQ(1u, names.count("box_collision"));
+  EXPECT_EQ(1u, names.count("box_visual"));
+
+  // Only the pose of the box model itself
+  req.Clear();
+  auto scope = req.add_children()->mutable_params();
+  (*scope)["name"].set_string_value("box");
+  (*scope)["descendants"].set_bool_value(false);
+  (*req.add_children()->mutable_params())["component"].set_string_value(
+      "ign_gazebo_components.Pose");
+
+  EXPECT_TRUE(request(req, res));
+  ASSERT_EQ(1, res.state().entities_size());
+  const auto &components = res.state().entities().begin()->second.components();
+  ASSERT_EQ(1u, components.size());
+  gazebo::ComponentTypeId type = components.begin()->second.type();
+  EXPECT_EQ(gazebo::components::Pose::typeId, type);
+
+  // Unknown entities give an empty state instead of the full state
+  req.Clear();
+  (*req.add_children()->mutable_params())["name"].set_string_value(
+      "not_a_model");
+
+  EXPECT_TRUE(request(req, res));
+  EXPECT_EQ(0, res.state().entities_size());
+
+  // Unknown component types are rejected
+  req.Clear();
+  (*req.add_children()->mutable_params())["component"].set_string_value(
+      "not_a_component");
+
+  bool result{true};
+  EXPECT_TRUE(node.Request("/world/default/state/filtered", req, 5000u,
+      res, result));
+  EXPECT_FALSE(result);
+}
+
 // Run multiple times
 INSTANTIATE_TEST_SUITE_P(ServerRepeat, SceneBroadcasterTest,
     ::testing::Range(1, 2));
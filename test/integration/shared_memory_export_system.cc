@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/test_config.hh"
+#include "../helpers/EnvTestFixture.hh"
+#include "../src/systems/shared_memory_export/SharedMemoryExportLayout.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief Test SharedMemoryExport system
+class SharedMemoryExportTest : public InternalFixture<::testing::Test>
+{
+};
+
+/// \brief Name of the region, set in the world.
+static const char kRegionName[] = "/ign_gazebo_shared_memory_export_test";
+
+/// \brief Copy of the region.
+struct Snapshot
+{
+  /// \brief Iteration of the state.
+  uint64_t iterations{0u};
+
+  /// \brief Values of each entity, for each table.
+  std::map<std::string, std::map<uint64_t, std::vector<double>>> tables;
+};
+
+#ifndef _WIN32
+/////////////////////////////////////////////////
+/// \brief Map the region read only and copy it.
+/// \param[out] _snapshot Copy of the region.
+/// \return True if successful.
+static bool readRegion(Snapshot &_snapshot)
+{
+  int fd = shm_open(kRegionName, O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  fstat(fd, &info);
+  const auto size = static_cast<std::size_t>(info.st_size);
+  void *region = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (MAP_FAILED == region)
+    return false;
+
+  const bool result = readSharedMemoryExport(region,
+      [&](const SharedMemoryExportHeader &_header)
+      {
+        _snapshot = Snapshot();
+        _snapshot.iterations = _header.iterations;
+        auto tables = reinterpret_cast<const SharedMemoryExportTable *>(
+            &_header + 1);
+        for (uint32_t t = 0u; t < _header.tableCount; ++t)
+        {
+          auto &values = _snapshot.tables[tables[t].name];
+          auto record = static_cast<const char *>(region) + tables[t].offset;
+          for (uint32_t i = 0u; i < tables[t].count; ++i)
+          {
+            uint64_t entity;
+            std::memcpy(&entity, record, sizeof(entity));
+            auto &entityValues = values[entity];
+            entityValues.resize(tables[t].valueCount);
+            std::memcpy(entityValues.data(), record + sizeof(entity),
+                tables[t].valueCount * sizeof(double));
+            record += sizeof(entity) + tables[t].valueCount * sizeof(double);
+          }
+        }
+      });
+
+  munmap(region, size);
+  return result;
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryExportTest,
+    IGN_UTILS_TEST_DISABLED_ON_WIN32(ExportState))
+{
+#ifndef _WIN32
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shared_memory_export.sdf");
+
+  auto server = std::make_unique<Server>(serverConfig);
+  server->Run(true, 1, false);
+
+  Snapshot first;
+  ASSERT_TRUE(readRegion(first));
+  EXPECT_EQ(1u, first.iterations);
+  ASSERT_EQ(3u, first.tables.size());
+
+  // 3 models and 4 links
+  EXPECT_EQ(7u, first.tables["pose"].size());
+  EXPECT_EQ(4u, first.tables["world_pose"].size());
+  EXPECT_EQ(1u, first.tables["joint_position"].size());
+
+  // Find the falling link
+  uint64_t falling{0u};
+  for (const auto &[entity, values] : first.tables["world_pose"])
+  {
+    ASSERT_EQ(7u, values.size());
+    if (values[2] > 4.9)
+      falling = entity;
+  }
+  ASSERT_NE(0u, falling);
+
+  server->Run(true, 100, false);
+
+  Snapshot second;
+  ASSERT_TRUE(readRegion(second));
+  EXPECT_EQ(101u, second.iterations);
+  EXPECT_LT(second.tables["world_pose"][falling][2],
+      first.tables["world_pose"][falling][2]);
+
+  // Revolute joint, with one axis
+  ASSERT_EQ(1u, second.tables["joint_position"].size());
+  const auto &joint = second.tables["joint_position"].begin()->second;
+  ASSERT_EQ(3u, joint.size());
+  EXPECT_DOUBLE_EQ(1.0, joint[0]);
+
+  // The region is removed with the system
+  server.reset();
+  EXPECT_FALSE(readRegion(second));
+#endif
+}
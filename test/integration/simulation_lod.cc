@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/utilities/ExtraTestMacros.hh>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/test_config.hh"
+#include "ignition/gazebo/components/Dormant.hh"
+#include "ignition/gazebo/components/Model.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/components/Pose.hh"
+
+#include "../helpers/Relay.hh"
+#include "../helpers/EnvTestFixture.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Test the simulation level of detail policy
+class SimulationLodTest : public InternalFixture<::testing::Test>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(SimulationLodTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(DormantModels))
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfFile(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/simulation_lod.sdf");
+
+  Server server(serverConfig);
+
+  // Moves the performer, which is static, so physics doesn't move it back
+  std::optional<math::Pose3d> robotPose;
+  std::map<std::string, bool> dormant;
+  std::map<std::string, math::Pose3d> poses;
+  test::Relay testSystem;
+  testSystem.OnPreUpdate(
+      [&](const UpdateInfo &, EntityComponentManager &_ecm)
+      {
+        if (!robotPose)
+          return;
+        auto robot = _ecm.EntityByComponents(components::Model(),
+            components::Name("robot"));
+        _ecm.SetComponentData<components::Pose>(robot, *robotPose);
+        robotPose.reset();
+      });
+  testSystem.OnPostUpdate(
+      [&](const UpdateInfo &, const EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Model, components::Name, components::Pose>(
+            [&](const Entity &_entity, const components::Model *,
+                const components::Name *_name,
+                const components::Pose *_pose) -> bool
+            {
+              auto dormantComp = _ecm.Component<components::Dormant>(_entity);
+              dormant[_name->Data()] = nullptr != dormantComp;
+              if (nullptr != dormantComp)
+                EXPECT_TRUE(dormantComp->Data());
+              poses[_name->Data()] = _pose->Data();
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  server.Run(true, 100, false);
+
+  // Only the model beyond the dormant distance is dormant, and it's frozen
+  // while the others fall
+  EXPECT_FALSE(dormant["robot"]);
+  EXPECT_FALSE(dormant["near"]);
+  EXPECT_FALSE(dormant["border"]);
+  EXPECT_TRUE(dormant["far"]);
+  EXPECT_LT(poses["near"].Pos().Z(), -0.04);
+  EXPECT_LT(poses["border"].Pos().Z(), -0.04);
+  EXPECT_NEAR(0.0, poses["far"].Pos().Z(), 1e-3);
+
+  // Approaching the far model wakes it up, and puts the other models to
+  // sleep where they are
+  robotPose = math::Pose3d(95, 0, 0, 0, 0, 0);
+  server.Run(true, 2, false);
+  EXPECT_TRUE(dormant["near"]);
+  EXPECT_TRUE(dormant["border"]);
+  EXPECT_FALSE(dormant["far"]);
+
+  const double nearZ = poses["near"].Pos().Z();
+  server.Run(true, 100, false);
+  EXPECT_TRUE(dormant["near"]);
+  EXPECT_FALSE(dormant["far"]);
+  EXPECT_NEAR(nearZ, poses["near"].Pos().Z(), 1e-3);
+  EXPECT_LT(poses["far"].Pos().Z(), -0.04);
+
+  // Coming back within the wake distance of the border model, but not
+  // within the one of the near model
+  robotPose = math::Pose3d(0, 80, 0, 0, 0, 0);
+  server.Run(true, 2, false);
+  EXPECT_FALSE(dormant["border"]);
+  EXPECT_TRUE(dormant["near"]);
+  EXPECT_TRUE(dormant["far"]);
+}
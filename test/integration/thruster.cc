@@ -262,3 +262,13 @@ TEST_F(ThrusterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(BatteryIntegration))
   this->TestWorld(world, "lowbattery", 0.005, 950, 0.25, 1e-2);
 }
 
+
+/////////////////////////////////////////////////
+TEST_F(ThrusterTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(WorldPlugin))
+{
+  auto world = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "test", "worlds", "thruster_batch.sdf");
+
+  // Same thruster as the PIDControl test, handled by a world plugin
+  this->TestWorld(world, "sub", 0.004, 1000, 0.2, 1e-4);
+}
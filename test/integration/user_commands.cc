@@ -20,6 +20,14 @@
 #include <ignition/msgs/entity_factory.pb.h>
 #include <ignition/msgs/light.pb.h>
 #include <ignition/msgs/physics.pb.h>
+#include <ignition/msgs/uint64.pb.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Util.hh>
@@ -1206,3 +1214,114 @@ TEST_F(UserCommandsTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(WheelSlip))
   // and processed.
   // The second one is just to check everything went fine.
   server.Run(true, 3, false);}
+
+/////////////////////////////////////////////////
+TEST_F(UserCommandsTest, IGN_UTILS_TEST_DISABLED_ON_WIN32(Async))
+{
+  // Start server
+  ServerConfig serverConfig;
+  const auto sdfFile = std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/shapes.sdf";
+  serverConfig.SetSdfFile(sdfFile);
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+  EXPECT_FALSE(*server.Running(0));
+
+  EntityComponentManager *ecm{nullptr};
+  test::Relay testSystem;
+  testSystem.OnPreUpdate([&](const gazebo::UpdateInfo &,
+                             gazebo::EntityComponentManager &_ecm)
+      {
+        ecm = &_ecm;
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+  ASSERT_NE(nullptr, ecm);
+
+  // Results, keyed by ticket. Superseded commands have a negative result.
+  std::mutex mutex;
+  std::map<uint64_t, int> results;
+  std::function<void(const msgs::Boolean &)> cb =
+      [&](const msgs::Boolean &_msg)
+      {
+        uint64_t ticket{0u};
+        bool superseded{false};
+        for (const auto &data : _msg.header().data())
+        {
+          if (data.key() == "ticket")
+            ticket = std::stoull(data.value(0));
+          else if (data.key() == "superseded")
+            superseded = true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        results[ticket] = superseded ? -1 : static_cast<int>(_msg.data());
+      };
+  transport::Node node;
+  node.Subscribe("/world/default/command_result", cb);
+
+  auto waitForResults = [&](std::size_t _count)
+  {
+    for (int sleep = 0; sleep < 50; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (results.size() >= _count)
+          return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+
+  // Tickets are returned right away, before the commands are executed
+  msgs::Entity removeReq;
+  removeReq.set_name("box");
+  removeReq.set_type(msgs::Entity::MODEL);
+
+  msgs::UInt64 res;
+  bool result;
+  unsigned int timeout = 5000;
+  EXPECT_TRUE(node.Request("/world/default/remove/async", removeReq, timeout,
+      res, result));
+  EXPECT_TRUE(result);
+  const uint64_t removeTicket = res.data();
+  EXPECT_NE(0u, removeTicket);
+
+  // Removing the same model again fails
+  EXPECT_TRUE(node.Request("/world/default/remove/async", removeReq, timeout,
+      res, result));
+  const uint64_t failTicket = res.data();
+  EXPECT_NE(removeTicket, failTicket);
+
+  // The first of two poses for the same model is superseded
+  msgs::Pose poseReq;
+  poseReq.set_name("sphere");
+  msgs::Set(poseReq.mutable_position(), math::Vector3d(1, 2, 3));
+  EXPECT_TRUE(node.Request("/world/default/set_pose/async", poseReq, timeout,
+      res, result));
+  const uint64_t supersededTicket = res.data();
+  msgs::Set(poseReq.mutable_position(), math::Vector3d(4, 5, 6));
+  EXPECT_TRUE(node.Request("/world/default/set_pose/async", poseReq, timeout,
+      res, result));
+  const uint64_t poseTicket = res.data();
+
+  EXPECT_NE(kNullEntity, ecm->EntityByComponents(components::Model(),
+      components::Name("box")));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_TRUE(results.empty());
+  }
+
+  // Results are published once the commands are executed
+  server.Run(true, 1, false);
+  EXPECT_EQ(kNullEntity, ecm->EntityByComponents(components::Model(),
+      components::Name("box")));
+  ASSERT_TRUE(waitForResults(4u));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(1, results[removeTicket]);
+  EXPECT_EQ(0, results[failTicket]);
+  EXPECT_EQ(-1, results[supersededTicket]);
+  EXPECT_EQ(1, results[poseTicket]);
+}
@@ -4,8 +4,6 @@ import argparse
 import numpy as np
 import csv
 
-import matplotlib.pyplot as plt
-
 def read_data(filename):
     header = []
     entries = []
@@ -19,6 +17,14 @@ def read_data(filename):
                 entries.append([float(r) for r in row])
     return (header, np.array(entries))
 
+def header_value(header, key):
+    # Header rows look like "# Key: value"
+    prefix = '# ' + key + ':'
+    for row in header:
+        if row[0].startswith(prefix):
+            return row[0][len(prefix):].strip()
+    return None
+
 def compute_rtfs(real_time, sim_time):
     # Compute time deltas
     real_dt = np.diff(real_time)
@@ -69,6 +75,16 @@ if __name__ == '__main__':
         print(f'  Sim Time:  {mx_sim:0.5f}')
         print(f'  Real Time: {mx_real:0.5f}')
 
+        startup = header_value(header, 'Startup s')
+        if startup is not None:
+            print(f'Startup:    {float(startup):0.5f} s')
+        peak_rss = header_value(header, 'Peak RSS kB')
+        if peak_rss is not None:
+            print(f'Peak RSS:   {int(peak_rss) / 1024:0.1f} MB')
+
+    if args.plot or args.hist:
+        import matplotlib.pyplot as plt
+
     if args.plot:
         plt.figure()
         plt.plot(sim_time[:-1], rtfs)
@@ -85,5 +101,5 @@ if __name__ == '__main__':
         plt.ylabel('Iteration Count')
         plt.grid(True)
 
-
-    plt.show()
+    if args.plot or args.hist:
+        plt.show()
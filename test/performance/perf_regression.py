@@ -0,0 +1,397 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2026 Open Source Robotics Foundation
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#       http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Runs a set of reference worlds with sdf_runner, collects performance
+# metrics over several runs and compares them with a stored baseline.
+
+import argparse
+import datetime
+import json
+import math
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+
+from ign_perf import compute_rtfs, header_value, read_data
+
+SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
+WORLDS_DIR = os.path.join(SCRIPT_DIR, '..', 'worlds')
+
+# Whether a higher value is better, for each metric
+METRICS = {
+    'rtf': True,
+    'step_p50_ms': False,
+    'step_p90_ms': False,
+    'step_p99_ms': False,
+    'peak_rss_mb': False,
+    'startup_s': False,
+}
+
+# Two sided 95% critical values of Student's t distribution, by degrees of
+# freedom
+T_TABLE = [(1, 12.706), (2, 4.303), (3, 3.182), (4, 2.776), (5, 2.571),
+           (6, 2.447), (7, 2.365), (8, 2.306), (9, 2.262), (10, 2.228),
+           (12, 2.179), (15, 2.131), (20, 2.086), (30, 2.042), (60, 2.000),
+           (120, 1.980)]
+
+
+def t_critical(dof):
+    # Round the degrees of freedom down, which is conservative
+    if dof > T_TABLE[-1][0]:
+        return 1.960
+    value = T_TABLE[0][1]
+    for table_dof, table_value in T_TABLE:
+        if dof >= table_dof:
+            value = table_value
+    return value
+
+
+def cubes_world(count):
+    models = []
+    side = int(math.ceil(math.sqrt(count)))
+    for i in range(count):
+        x = (i % side) * 1.5
+        y = (i // side) * 1.5
+        models.append(f'''
+    <model name="cube_{i}">
+      <pose>{x} {y} 0.5 0 0 0</pose>
+      <link name="link">
+        <inertial><mass>1</mass></inertial>
+        <collision name="collision">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </collision>
+        <visual name="visual">
+          <geometry><box><size>1 1 1</size></box></geometry>
+        </visual>
+      </link>
+    </model>''')
+    return f'''<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>
+    <model name="ground_plane">
+      <static>true</static>
+      <link name="link">
+        <collision name="collision">
+          <geometry><plane><normal>0 0 1</normal></plane></geometry>
+        </collision>
+      </link>
+    </model>{''.join(models)}
+  </world>
+</sdf>
+'''
+
+
+def sensors_world(count):
+    systems = [('physics', 'Physics'), ('imu', 'Imu'),
+               ('altimeter', 'Altimeter'), ('magnetometer', 'Magnetometer'),
+               ('air-pressure', 'AirPressure'),
+               ('scene-broadcaster', 'SceneBroadcaster')]
+    plugins = ''.join(f'''
+    <plugin filename="ignition-gazebo-{f}-system"
+            name="ignition::gazebo::systems::{n}"/>''' for f, n in systems)
+    sensors = ''.join(f'''
+        <sensor name="{t}" type="{t}">
+          <always_on>1</always_on>
+          <update_rate>100</update_rate>
+        </sensor>''' for t in ['imu', 'altimeter', 'magnetometer',
+                              'air_pressure'])
+    models = ''.join(f'''
+    <model name="sensors_{i}">
+      <pose>{i * 2.0} 0 1 0 0 0</pose>
+      <link name="link">
+        <inertial><mass>1</mass></inertial>{sensors}
+      </link>
+    </model>''' for i in range(count))
+    return f'''<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <physics name="1ms" type="ode">
+      <max_step_size>0.001</max_step_size>
+      <real_time_factor>0</real_time_factor>
+    </physics>{plugins}
+    <gravity>0 0 0</gravity>{models}
+  </world>
+</sdf>
+'''
+
+
+# Reference worlds. Generated worlds are written to the work directory.
+SUITES = {
+    'cubes': {
+        'generate': lambda: cubes_world(500),
+    },
+    'levels': {
+        'world': os.path.join(WORLDS_DIR, 'level_performance.sdf'),
+        'args': ['--levels'],
+    },
+    'sensors': {
+        'generate': lambda: sensors_world(100),
+    },
+    'distributed': {
+        'world': os.path.join(WORLDS_DIR, 'level_performance.sdf'),
+        'args': ['--levels', '--network-role=primary',
+                 '--network-secondaries=2'],
+        'secondaries': 2,
+        'secondary_args': ['--levels', '--network-role=secondary'],
+    },
+}
+
+
+def run_once(runner, suite, world, iterations, rate, work_dir, timeout):
+    os.makedirs(work_dir)
+    secondaries = []
+    try:
+        for i in range(suite.get('secondaries', 0)):
+            secondary_dir = os.path.join(work_dir, f'secondary_{i}')
+            os.makedirs(secondary_dir)
+            secondaries.append(subprocess.Popen(
+                [runner, world, str(iterations), str(rate)] +
+                suite['secondary_args'], cwd=secondary_dir,
+                stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL))
+
+        subprocess.run([runner, world, str(iterations), str(rate)] +
+                       suite.get('args', []), cwd=work_dir, check=True,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+                       timeout=timeout)
+    finally:
+        # Secondaries stop once the primary is gone
+        for secondary in secondaries:
+            try:
+                secondary.wait(timeout=10)
+            except subprocess.TimeoutExpired:
+                secondary.kill()
+                secondary.wait()
+
+    (header, data) = read_data(os.path.join(work_dir, 'data.csv'))
+    real_time = data[:, 0] + 1e-9 * data[:, 1]
+    sim_time = data[:, 2] + 1e-9 * data[:, 3]
+
+    # Overall RTF, instead of the mean of each message's RTF, so that
+    # dropped clock messages don't skew it
+    rtf = (sim_time[-1] - sim_time[0]) / (real_time[-1] - real_time[0])
+
+    step_ns = np.loadtxt(os.path.join(work_dir, 'step_times.csv'),
+                         comments='#', ndmin=1)
+    p50, p90, p99 = np.percentile(step_ns * 1e-6, [50, 90, 99])
+
+    return {
+        'rtf': float(rtf),
+        'step_p50_ms': float(p50),
+        'step_p90_ms': float(p90),
+        'step_p99_ms': float(p99),
+        'peak_rss_mb': int(header_value(header, 'Peak RSS kB')) / 1024.0,
+        'startup_s': float(header_value(header, 'Startup s')),
+    }
+
+
+def summarize(runs):
+    summary = {}
+    for metric in METRICS:
+        values = np.array([run[metric] for run in runs])
+        n = len(values)
+        stdev = float(np.std(values, ddof=1)) if n > 1 else 0.0
+        ci95 = t_critical(n - 1) * stdev / math.sqrt(n) if n > 1 else 0.0
+        summary[metric] = {
+            'mean': float(np.mean(values)),
+            'stdev': stdev,
+            'ci95': ci95,
+            'n': n,
+        }
+    return summary
+
+
+def compare(current, baseline, tolerance):
+    # Welch's t interval on the difference of means. A metric regresses if
+    # the whole interval is on the worse side and the mean changed by more
+    # than the tolerance.
+    result = {}
+    for metric, higher_is_better in METRICS.items():
+        if metric not in baseline:
+            continue
+        cur = current[metric]
+        base = baseline[metric]
+        diff = cur['mean'] - base['mean']
+        var_cur = cur['stdev'] ** 2 / cur['n']
+        var_base = base['stdev'] ** 2 / base['n']
+        err = math.sqrt(var_cur + var_base)
+        if err > 0.0:
+            dof_den = 0.0
+            if cur['n'] > 1:
+                dof_den += var_cur ** 2 / (cur['n'] - 1)
+            if base['n'] > 1:
+                dof_den += var_base ** 2 / (base['n'] - 1)
+            dof = (var_cur + var_base) ** 2 / dof_den if dof_den > 0 else 1
+            half_width = t_critical(dof) * err
+        else:
+            half_width = 0.0
+
+        change = diff / base['mean'] if base['mean'] != 0.0 else 0.0
+        worse = -diff if higher_is_better else diff
+        status = 'ok'
+        if abs(change) > tolerance:
+            if worse - half_width > 0.0:
+                status = 'regression'
+            elif worse + half_width < 0.0:
+                status = 'improvement'
+
+        result[metric] = {
+            'baseline': base['mean'],
+            'current': cur['mean'],
+            'change': change,
+            'diff_ci95': [diff - half_width, diff + half_width],
+            'status': status,
+        }
+    return result
+
+
+def default_plugin_path(runner):
+    # When running from a build directory, systems are next to the binaries
+    lib_dir = os.path.join(os.path.dirname(os.path.abspath(runner)), '..',
+                           'lib')
+    return os.path.realpath(lib_dir) if os.path.isdir(lib_dir) else None
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Run the reference worlds and check for regressions.')
+    parser.add_argument('--runner', default='./bin/PERFORMANCE_sdf_runner',
+                        help='Path to the sdf_runner executable')
+    parser.add_argument('--suites', nargs='+', choices=list(SUITES),
+                        default=list(SUITES), help='Suites to run')
+    parser.add_argument('--runs', type=int, default=5,
+                        help='Number of runs of each suite')
+    parser.add_argument('--iterations', type=int, default=5000,
+                        help='Iterations of each run')
+    parser.add_argument('--rate', type=int, default=1000000,
+                        help='Update rate in Hz, high to run unthrottled')
+    parser.add_argument('--timeout', type=float, default=600,
+                        help='Timeout of each run in seconds')
+    parser.add_argument('--output', default='perf_results.json',
+                        help='File to write the results to')
+    parser.add_argument('--baseline',
+                        help='Results of a previous run to compare against')
+    parser.add_argument('--save-baseline',
+                        help='Also write the results to this baseline file')
+    parser.add_argument('--history',
+                        help='File to append a line of results to')
+    parser.add_argument('--tolerance', type=float, default=0.05,
+                        help='Relative change below which differences are '
+                             'ignored')
+    parser.add_argument('--keep', action='store_true',
+                        help='Keep the work directory')
+    args = parser.parse_args()
+
+    if 'IGN_GAZEBO_SYSTEM_PLUGIN_PATH' not in os.environ:
+        plugin_path = default_plugin_path(args.runner)
+        if plugin_path:
+            os.environ['IGN_GAZEBO_SYSTEM_PLUGIN_PATH'] = plugin_path
+
+    work_root = tempfile.mkdtemp(prefix='ign_perf_')
+    results = {
+        'version': 1,
+        'timestamp': datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        'host': platform.node(),
+        'iterations': args.iterations,
+        'rate': args.rate,
+        'suites': {},
+    }
+
+    failed = False
+    for name in args.suites:
+        suite = SUITES[name]
+        world = suite.get('world')
+        if 'generate' in suite:
+            world = os.path.join(work_root, f'{name}.sdf')
+            with open(world, 'w') as f:
+                f.write(suite['generate']())
+
+        runs = []
+        for i in range(args.runs):
+            print(f'{name}: run {i + 1} of {args.runs}', flush=True)
+            try:
+                runs.append(run_once(
+                    args.runner, suite, world, args.iterations, args.rate,
+                    os.path.join(work_root, name, str(i)), args.timeout))
+            except (subprocess.SubprocessError, OSError, ValueError) as e:
+                print(f'{name}: run {i + 1} failed: {e}', file=sys.stderr)
+                failed = True
+
+        if not runs:
+            continue
+        results['suites'][name] = {
+            'runs': runs,
+            'summary': summarize(runs),
+        }
+
+    regressions = []
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        for name, suite in results['suites'].items():
+            if name not in baseline.get('suites', {}):
+                continue
+            comparison = compare(suite['summary'],
+                                 baseline['suites'][name]['summary'],
+                                 args.tolerance)
+            suite['comparison'] = comparison
+            for metric, result in comparison.items():
+                if result['status'] == 'regression':
+                    regressions.append((name, metric, result))
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+    if args.save_baseline:
+        with open(args.save_baseline, 'w') as f:
+            json.dump(results, f, indent=2)
+    if args.history:
+        line = {
+            'timestamp': results['timestamp'],
+            'host': results['host'],
+            'suites': {name: suite['summary']
+                       for name, suite in results['suites'].items()},
+        }
+        with open(args.history, 'a') as f:
+            f.write(json.dumps(line) + '\n')
+
+    for name, suite in results['suites'].items():
+        print(f'{name}:')
+        for metric, stats in suite['summary'].items():
+            line = (f'  {metric:12} {stats["mean"]:12.4f} '
+                    f'+/- {stats["ci95"]:.4f}')
+            if metric in suite.get('comparison', {}):
+                result = suite['comparison'][metric]
+                line += f'  {result["change"]:+8.2%}  {result["status"]}'
+            print(line)
+
+    if not args.keep:
+        shutil.rmtree(work_root, ignore_errors=True)
+    else:
+        print(f'Work directory: {work_root}')
+
+    if regressions:
+        print(f'{len(regressions)} regression(s) found', file=sys.stderr)
+        sys.exit(1)
+    if failed:
+        sys.exit(2)
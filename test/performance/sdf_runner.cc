@@ -16,6 +16,16 @@
  */
 
 #include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 #include <ignition/msgs.hh>
 #include <ignition/math/Stopwatch.hh>
@@ -24,35 +34,111 @@
 #include "ignition/transport/Node.hh"
 
 #include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/System.hh"
 #include "ignition/gazebo/SystemLoader.hh"
 #include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
 
 using namespace ignition;
 using namespace gazebo;
 
+/// \brief System which records the wall time between consecutive
+/// PreUpdates, which is the duration of every step, including the time
+/// spent waiting to keep the update rate.
+class StepTimer :
+  public System,
+  public ISystemPreUpdate
+{
+  /// \brief Constructor
+  /// \param[in] _iterations Expected number of iterations.
+  public: explicit StepTimer(unsigned int _iterations)
+  {
+    this->stepTimes.reserve(_iterations);
+  }
+
+  // Documentation inherited
+  public: void PreUpdate(const UpdateInfo &,
+                EntityComponentManager &) override
+  {
+    auto now = std::chrono::steady_clock::now();
+    if (this->started)
+      this->stepTimes.push_back(now - this->last);
+    this->last = now;
+    this->started = true;
+  }
+
+  /// \brief Duration of each step.
+  public: std::vector<std::chrono::steady_clock::duration> stepTimes;
+
+  /// \brief Time of the last PreUpdate.
+  public: std::chrono::steady_clock::time_point last;
+
+  /// \brief Whether PreUpdate has been called.
+  public: bool started{false};
+};
+
+/// \brief Get the peak resident set size of the process.
+/// \return Peak RSS in kilobytes, or zero if it isn't available.
+static uint64_t peakRssKb()
+{
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0u;
+#ifdef __APPLE__
+  // Reported in bytes on macOS
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024u;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#else
+  return 0u;
+#endif
+}
+
 //////////////////////////////////////////////////
 int main(int _argc, char** _argv)
 {
   ignition::common::Console::SetVerbosity(4);
 
+  // Options can be anywhere, everything else is positional
+  std::vector<std::string> args;
+  bool levels{false};
+  std::string networkRole;
+  unsigned int networkSecondaries{0};
+  for (int i = 1; i < _argc; ++i)
+  {
+    std::string arg{_argv[i]};
+    if (arg == "--levels")
+      levels = true;
+    else if (arg.rfind("--network-role=", 0) == 0)
+      networkRole = arg.substr(std::strlen("--network-role="));
+    else if (arg.rfind("--network-secondaries=", 0) == 0)
+    {
+      networkSecondaries = atoi(
+          arg.substr(std::strlen("--network-secondaries=")).c_str());
+    }
+    else
+      args.push_back(arg);
+  }
+
   std::string sdfFile{""};
-  if (_argc >= 2)
+  if (args.size() >= 1)
   {
-    sdfFile = _argv[1];
+    sdfFile = args[0];
   }
   igndbg << "SDF file: " << sdfFile << std::endl;
 
   unsigned int iterations{10000};
-  if (_argc >= 3)
+  if (args.size() >= 2)
   {
-    iterations = atoi(_argv[2]);
+    iterations = atoi(args[1].c_str());
   }
   igndbg << "Iterations: " << iterations << std::endl;
 
   double updateRate{-1};
-  if (_argc >= 4)
+  if (args.size() >= 3)
   {
-    updateRate = atoi(_argv[3]);
+    updateRate = atoi(args[2].c_str());
   }
   igndbg << "Update rate: " << updateRate << std::endl;
 
@@ -67,8 +153,21 @@ int main(int _argc, char** _argv)
   if (updateRate > 0.0)
     serverConfig.SetUpdateRate(updateRate);
 
+  serverConfig.SetUseLevels(levels);
+  if (!networkRole.empty())
+  {
+    serverConfig.SetNetworkRole(networkRole);
+    serverConfig.SetNetworkSecondaries(networkSecondaries);
+  }
+
   // Create the Gazebo server
+  auto startupStart = std::chrono::steady_clock::now();
   ignition::gazebo::Server server(serverConfig);
+  std::chrono::duration<double> startupTime =
+      std::chrono::steady_clock::now() - startupStart;
+
+  auto stepTimer = std::make_shared<StepTimer>(iterations);
+  server.AddSystem(stepTimer);
 
   ignition::transport::Node node;
 
@@ -106,6 +205,8 @@ int main(int _argc, char** _argv)
   ofs << "# Filename: " << sdfFile << std::endl;
   ofs << "# Iterations: " << iterations << std::endl;
   ofs << "# Rate: " << updateRate << std::endl;
+  ofs << "# Startup s: " << startupTime.count() << std::endl;
+  ofs << "# Peak RSS kB: " << peakRssKb() << std::endl;
   ofs << "# Real s, Real ns, sim s, sim ns" << std::endl;
 
   for (auto &msg : msgs)
@@ -114,5 +215,14 @@ int main(int _argc, char** _argv)
         << msg.sim().sec() << ", " << msg.sim().nsec() << std::endl;
   }
 
+  std::ofstream stepsOfs("step_times.csv", std::ofstream::out);
+  stepsOfs << "# Filename: " << sdfFile << std::endl;
+  stepsOfs << "# Step ns" << std::endl;
+  for (const auto &stepTime : stepTimer->stepTimes)
+  {
+    stepsOfs << std::chrono::duration_cast<std::chrono::nanoseconds>(
+        stepTime).count() << std::endl;
+  }
+
   return 0;
 }